@@ -0,0 +1 @@
+#include "../../src/Core/source/HeadlessTreeItem.h"
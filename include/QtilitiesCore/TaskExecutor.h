@@ -0,0 +1 @@
+#include "../../src/Core/source/TaskExecutor.h"
@@ -0,0 +1 @@
+#include "../../src/CoreGui/source/LogMessageStorage.h"
@@ -0,0 +1 @@
+#include "../../src/CoreGui/source/MessagesListViewTab.h"
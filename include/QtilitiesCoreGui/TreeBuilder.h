@@ -0,0 +1 @@
+#include "../../src/CoreGui/source/TreeBuilder.h"
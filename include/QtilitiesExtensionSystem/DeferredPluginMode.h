@@ -0,0 +1 @@
+#include "../../src/ExtensionSystem/source/DeferredPluginMode.h"
@@ -0,0 +1 @@
+#include "../../src/Logging/source/PerformanceCounters.h"
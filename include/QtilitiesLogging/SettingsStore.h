@@ -0,0 +1 @@
+#include "../../src/Logging/source/SettingsStore.h"
@@ -0,0 +1 @@
+#include "../../src/Testing/source/TestDeferredPluginMode.h"
@@ -0,0 +1 @@
+#include "../../src/Testing/source/TestLargeTextFile.h"
@@ -0,0 +1 @@
+#include "../../src/Testing/source/TestZipper.h"
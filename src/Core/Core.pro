@@ -34,16 +34,24 @@ HEADERS += \
     ../Common/Qtilities.h \
     source/AbstractSubjectFilter.h \
     source/ActivityPolicyFilter.h \
+    source/CborStream.h \
+    source/CompactBinaryFormat.h \
+    source/CompressedDevice.h \
     source/ContextManager.h \
+    source/ExportTask.h \
     source/Factory.h \
     source/FileLocker.h \
     source/FileSetInfo.h \
+    source/FileWatchService_p.h \
     source/FileUtils.h \
+    source/HeadlessTreeItem.h \
+    source/HeadlessTreeNode.h \
     source/GenericProperty.h \
     source/GenericPropertyManager.h \
     source/IAvailablePropertyProvider.h \
     source/IContext.h \
     source/IContextManager.h \
+    source/IdleScheduler.h \
     source/IExportableFormatting.h \
     source/IExportable.h \
     source/IExportableObserver.h \
@@ -55,6 +63,8 @@ HEADERS += \
     source/IObjectManager.h \
     source/ITaskContainer.h \
     source/ITask.h \
+    source/MemoryUsageReport.h \
+    source/ObjectHandle.h \
     source/ObjectManager.h \
     source/ObserverData.h \
     source/ObserverDotWriter.h \
@@ -62,6 +72,11 @@ HEADERS += \
     source/ObserverHints.h \
     source/ObserverMimeData.h \
     source/ObserverRelationalTable.h \
+    source/ObserverSnapshot.h \
+    source/ObserverSnapshot_p.h \
+    source/ObserverTreeDiff.h \
+    source/ObserverUndoStack.h \
+    source/PagedSubjectStore.h \
     source/PointerList.h \
     source/QtilitiesCategory.h \
     source/QtilitiesCoreApplication.h \
@@ -70,13 +85,20 @@ HEADERS += \
     source/QtilitiesCore_global.h \
     source/QtilitiesFileInfo.h \
     source/QtilitiesProcess.h \
+    source/QtilitiesProcess_p.h \
+    source/QtilitiesProcessPool.h \
     source/QtilitiesPropertyChangeEvent.h \
     source/QtilitiesProperty.h \
+    source/StartupProfiler.h \
     source/SubjectFilterTemplate.h \
     source/SubjectIterator.h \
     source/SubjectTypeFilter.h \
     source/Task.h \
+    source/TaskExecutor.h \
+    source/TaskGraph.h \
     source/TaskManager.h \
+    source/TaskMessageRing.h \
+    source/TraceEventWriter_p.h \
     source/TreeIterator.h \
     source/VersionInformation.h \
     source/Zipper.h \
@@ -84,33 +106,54 @@ HEADERS += \
 
 SOURCES += \
     source/ActivityPolicyFilter.cpp \
+    source/CborStream.cpp \
+    source/CompactBinaryFormat.cpp \
+    source/CompressedDevice.cpp \
     source/ContextManager.cpp \
+    source/ExportTask.cpp \
     source/FileLocker.cpp \
     source/FileSetInfo.cpp \
+    source/FileWatchService_p.cpp \
     source/FileUtils.cpp \
     source/GenericProperty.cpp \
     source/GenericPropertyManager.cpp \
+    source/HeadlessTreeItem.cpp \
+    source/HeadlessTreeNode.cpp \
+    source/IdleScheduler.cpp \
     source/IExportable.cpp \
     source/InstanceFactoryInfo.cpp \
     source/ITaskContainer.cpp \
+    source/MemoryUsageReport.cpp \
+    source/ObjectHandle.cpp \
     source/ObjectManager.cpp \
     source/Observer.cpp \
     source/ObserverData.cpp \
     source/ObserverDotWriter.cpp \
     source/ObserverHints.cpp \
+    source/ObserverMimeData.cpp \
     source/ObserverRelationalTable.cpp \
+    source/ObserverSnapshot.cpp \
+    source/ObserverTreeDiff.cpp \
+    source/ObserverUndoStack.cpp \
+    source/PagedSubjectStore.cpp \
     source/PointerList.cpp \
     source/QtilitiesCategory.cpp \
     source/QtilitiesCoreApplication.cpp \
     source/QtilitiesCoreApplication_p.cpp \
     source/QtilitiesFileInfo.cpp \
     source/QtilitiesProcess.cpp \
+    source/QtilitiesProcessPool.cpp \
     source/QtilitiesPropertyChangeEvent.cpp \
     source/QtilitiesProperty.cpp \
+    source/StartupProfiler.cpp \
     source/SubjectFilterTemplate.cpp \
     source/SubjectTypeFilter.cpp \
     source/Task.cpp \
+    source/TaskExecutor.cpp \
+    source/TaskGraph.cpp \
     source/TaskManager.cpp \
+    source/TaskMessageRing.cpp \
+    source/TraceEventWriter_p.cpp \
     source/VersionInformation.cpp \
     source/Zipper.cpp \
 
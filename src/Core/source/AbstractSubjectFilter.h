@@ -130,6 +130,34 @@ namespace Qtilities {
                 Q_UNUSED(attachment_successful)
                 Q_UNUSED(import_cycle)
             }
+            //! Indicates that a list of objects is about to be attached to the filter's observer context using Observer::attachSubjects().
+            /*!
+                Every object in the list will still go through initializeAttachment() and finalizeAttachment(). Filters can use this function,
+                together with finalizeBulkAttachment(), to do work which depends on all the subjects in the context only once for the whole list instead
+                of once for every attached object.
+
+                \param objects The objects which will be attached.
+
+                \note By default does nothing in the base class.
+
+                <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual void initializeBulkAttachment(const QList<QObject*>& objects) {
+                Q_UNUSED(objects)
+            }
+            //! Indicates that the attachment of a list of objects started with initializeBulkAttachment() is done.
+            /*!
+                \param attached_objects The objects which were successfully attached.
+                \param import_cycle Indicates if the attachment call was made during an observer import cycle.
+
+                \note By default does nothing in the base class.
+
+                <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual void finalizeBulkAttachment(const QList<QPointer<QObject> >& attached_objects, bool import_cycle = false) {
+                Q_UNUSED(attached_objects)
+                Q_UNUSED(import_cycle)
+            }
 
             //! Evaluates the detachment of a subject from the filter's observer context. Use this function to check how an detachment will be handled.
             /*!
@@ -249,6 +277,19 @@ namespace Qtilities {
                 return observer;
             }
 
+            //! Returns the estimated number of bytes used by the state which this subject filter keeps about the subjects in its observer context.
+            /*!
+                Subject filters which keep indexes or caches of their subjects should reimplement this function, thus their state is accounted for
+                in the memory usage reports returned by Observer::memoryUsage(). The memory of the filter object itself is accounted for by the observer.
+
+                \note By default 0 is returned by the base class.
+
+                <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual qint64 estimatedStateBytes() const {
+                return 0;
+            }
+
         signals:
             //! A signal which is emitted as soon as a monitored property of the observer or any of the installed subject filters changed.
             /*!
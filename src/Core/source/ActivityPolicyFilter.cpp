@@ -13,12 +13,15 @@
 #include "QtilitiesCoreConstants.h"
 #include "Observer.h"
 #include "QtilitiesPropertyChangeEvent.h"
+#include "QtilitiesCoreApplication.h"
+#include "MemoryUsageReport.h"
 
 #include <Logger.h>
 
 #include <QVariant>
 #include <QCoreApplication>
 #include <QDomElement>
+#include <QSet>
 
 using namespace Qtilities::Core::Properties;
 using namespace Qtilities::Core::Constants;
@@ -33,7 +36,9 @@ struct Qtilities::Core::ActivityPolicyFilterPrivateData {
     ActivityPolicyFilterPrivateData() : is_modified(false),
         enforce_activity_policy(true),
         ignore_parent_tracking_changes(false),
-        ignore_subject_tracking_changes(false) { }
+        ignore_subject_tracking_changes(false),
+        bulk_attachment_active(false),
+        tracked_active_subjects_valid(false) { }
 
     bool                                            is_modified;
     bool                                            enforce_activity_policy;
@@ -44,6 +49,13 @@ struct Qtilities::Core::ActivityPolicyFilterPrivateData {
     ActivityPolicyFilter::NewSubjectActivityPolicy  new_subject_activity_policy;
     ActivityPolicyFilter::ParentTrackingPolicy      parent_tracking_policy;
     QList<QPointer<QObject> >                       processing_cycle_start_active_subjects;
+    //! Set during Observer::attachSubjects(), in which case UniqueActivity is enforced once in finalizeBulkAttachment().
+    bool                                            bulk_attachment_active;
+    //! The last subject which was set active during a bulk attachment.
+    QPointer<QObject>                               bulk_attachment_active_subject;
+    //! The active subjects in the observer context. Only valid when tracked_active_subjects_valid is true, see trackedActiveSubjects().
+    QSet<const QObject*>                            tracked_active_subjects;
+    bool                                            tracked_active_subjects_valid;
 };
 
 Qtilities::Core::ActivityPolicyFilter::ActivityPolicyFilter(QObject* parent) : AbstractSubjectFilter(parent) {
@@ -217,7 +229,7 @@ Qtilities::Core::ActivityPolicyFilter::NewSubjectActivityPolicy Qtilities::Core:
 }
 
 int Qtilities::Core::ActivityPolicyFilter::numActiveSubjects() const {
-    return activeSubjects().count();
+    return trackedActiveSubjects().count();
 }
 
 QList<QObject*> Qtilities::Core::ActivityPolicyFilter::activeSubjects() const {
@@ -275,7 +287,7 @@ void Qtilities::Core::ActivityPolicyFilter::setModificationState(bool new_state,
 
 bool Qtilities::Core::ActivityPolicyFilter::setActiveSubjects(QList<QObject*> objects, bool broadcast) {
     if (!observer) {
-        LOG_TRACE("Cannot set active objects in an activity subject filter without an observer context.");
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Cannot set active objects in an activity subject filter without an observer context.");
         return false;
     }
 
@@ -288,12 +300,12 @@ bool Qtilities::Core::ActivityPolicyFilter::setActiveSubjects(QList<QObject*> ob
     // Skip this, we are taking very long in here...
 //    for (int i = 0; i < objects.count(); ++i) {
 //        if (!objects.at(i)) {
-//            LOG_TRACE(QString("Invalid objects in list sent to setActiveSubjects(). Null pointer to object detected at list position %1.").arg(i));
+//            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Invalid objects in list sent to setActiveSubjects(). Null pointer to object detected at list position %1.").arg(i));
 //            return false;
 //        }
 
 //        if (!observer->contains(objects.at(i)) && objects.at(i)) {
-//            LOG_TRACE(QString("Invalid objects in list sent to setActiveSubjects(). Object %1 is not observed in this context (%2).").arg(objects.at(i)->objectName()).arg(observer->observerName()));
+//            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Invalid objects in list sent to setActiveSubjects(). Object %1 is not observed in this context (%2).").arg(objects.at(i)->objectName()).arg(observer->observerName()));
 //            return false;
 //        }
 //    }
@@ -315,48 +327,65 @@ bool Qtilities::Core::ActivityPolicyFilter::setActiveSubjects(QList<QObject*> ob
 
     // Now we know that the list is valid, lock the mutex so that property changes will be blocked.
     filter_mutex.tryLock();
-    // Set all objects as inactive
-    int subject_count = observer->subjectCount();
-    for (int i = 0; i < subject_count; ++i)
-        observer->setMultiContextPropertyValue(observer->subjectAt(i),qti_prop_ACTIVITY_MAP,QVariant(false));
-
-    // Set objects in the list as active
+    // Only subjects of which the activity changes are written to, thus property change events are only
+    // generated for those subjects. The new active and inactive lists are collected in the same pass:
+    QSet<QObject*> new_active_subjects;
     int objects_count = objects.count();
     for (int i = 0; i < objects_count; ++i)
-        observer->setMultiContextPropertyValue(objects.at(i),qti_prop_ACTIVITY_MAP,QVariant(true));
+        new_active_subjects.insert(objects.at(i));
+
+    QList<QObject*> changed_objects;
+    QList<QObject*> active_subjects;
+    QList<QObject*> inactive_subjects;
+    int subject_count = observer->subjectCount();
+    for (int i = 0; i < subject_count; ++i) {
+        QObject* obj = observer->subjectAt(i);
+        bool is_active = new_active_subjects.contains(obj);
+        QVariant current_activity = observer->getMultiContextPropertyValue(obj,qti_prop_ACTIVITY_MAP);
+        if (!current_activity.isValid() || current_activity.toBool() != is_active) {
+            observer->setMultiContextPropertyValue(obj,qti_prop_ACTIVITY_MAP,QVariant(is_active));
+            changed_objects << obj;
+        }
+
+        if (is_active)
+            active_subjects << obj;
+        else
+            inactive_subjects << obj;
+    }
 
     filter_mutex.unlock();
 
+    d->tracked_active_subjects.clear();
+    for (int i = 0; i < active_subjects.count(); ++i)
+        d->tracked_active_subjects.insert(active_subjects.at(i));
+    d->tracked_active_subjects_valid = true;
+
     // We need to do some things here:
     // - If enabled, post the QtilitiesPropertyChangeEvent:
     if (observer->qtilitiesPropertyChangeEventsEnabled()) {
-        for (int i = 0; i < subject_count; ++i) {
-            if (observer->subjectAt(i)->thread() == thread()) {
+        for (int i = 0; i < changed_objects.count(); ++i) {
+            QObject* obj = changed_objects.at(i);
+            if (obj->thread() == thread()) {
                 QByteArray property_name_byte_array = QByteArray(qti_prop_ACTIVITY_MAP);
                 QtilitiesPropertyChangeEvent* user_event = new QtilitiesPropertyChangeEvent(property_name_byte_array,observer->observerID());
-                QCoreApplication::postEvent(observer->subjectAt(i),user_event);
+                QCoreApplication::postEvent(obj,user_event);
                 #ifndef QT_NO_DEBUG
-                    // Get activity of object for debugging purposes
-                    QVariant activity = observer->getMultiContextPropertyValue(observer->subjectAt(i),qti_prop_ACTIVITY_MAP);
-                    if (activity.isValid()) {
-                        if (activity.toBool())
-                            LOG_TRACE(QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2) with activity true").arg(qti_prop_ACTIVITY_MAP).arg(observer->subjectAt(i)->objectName()));
-                        else
-                            LOG_TRACE(QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2) with activity false").arg(qti_prop_ACTIVITY_MAP).arg(observer->subjectAt(i)->objectName()));
-                    }
+                    if (new_active_subjects.contains(obj))
+                        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2) with activity true").arg(qti_prop_ACTIVITY_MAP).arg(obj->objectName()));
+                    else
+                        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2) with activity false").arg(qti_prop_ACTIVITY_MAP).arg(obj->objectName()));
                 #endif
             }
         }
     }
 
-    // - Emit the monitoredPropertyChanged() signal:
-    QList<QObject*> changed_objects;
-    changed_objects << observer->subjectReferences();
-    emit monitoredPropertyChanged(qti_prop_ACTIVITY_MAP,changed_objects); 
+    // - Emit the monitoredPropertyChanged() signal for the subjects which changed:
+    if (!changed_objects.isEmpty())
+        emit monitoredPropertyChanged(qti_prop_ACTIVITY_MAP,changed_objects);
 
     if (broadcast && !observer->isProcessingCycleActive()) {
         // - Emit the activeSubjectsChanged() signal:
-        emit activeSubjectsChanged(activeSubjects(),inactiveSubjects());
+        emit activeSubjectsChanged(active_subjects,inactive_subjects);
 
         // - Change the modification state of the filter:
         setModificationState(true);
@@ -366,6 +395,9 @@ bool Qtilities::Core::ActivityPolicyFilter::setActiveSubjects(QList<QObject*> ob
     } else
         setModificationState(true,IModificationNotifier::NotifyNone);
 
+    if (!changed_objects.isEmpty())
+        updateParentActivity();
+
     return true;
 }
 
@@ -502,7 +534,7 @@ bool Qtilities::Core::ActivityPolicyFilter::initializeAttachment(QObject* obj, Q
     if (!observer) {
         if (rejectMsg)
             *rejectMsg = QString(tr("Actvity Policy Filter: Cannot evaluate an attachment in a subject filter without an observer context."));
-        LOG_TRACE(QString(tr("Cannot evaluate an attachment in a subject filter without an observer context.")));
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString(tr("Cannot evaluate an attachment in a subject filter without an observer context.")));
         return false;
     } else
         return true;
@@ -518,7 +550,7 @@ void Qtilities::Core::ActivityPolicyFilter::finalizeAttachment(QObject* obj, boo
     #endif
 
     if (!observer) {
-        LOG_TRACE(QString(tr("Cannot evaluate an attachment in a subject filter without an observer context.")));
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString(tr("Cannot evaluate an attachment in a subject filter without an observer context.")));
         return;
     }
 
@@ -542,12 +574,16 @@ void Qtilities::Core::ActivityPolicyFilter::finalizeAttachment(QObject* obj, boo
             }
         } else {
             if (d->new_subject_activity_policy == ActivityPolicyFilter::SetNewActive) {
-                if (d->activity_policy == ActivityPolicyFilter::UniqueActivity && d->enforce_activity_policy) {
+                if (d->activity_policy == ActivityPolicyFilter::UniqueActivity && d->enforce_activity_policy && d->bulk_attachment_active) {
+                    // Only the last new subject will stay active, thus we deactivate the other subjects once in finalizeBulkAttachment():
+                    d->bulk_attachment_active_subject = obj;
+                } else if (d->activity_policy == ActivityPolicyFilter::UniqueActivity && d->enforce_activity_policy) {
                     for (int i = 0; i < subject_count; ++i) {
                         QObject* obj_at = observer->subjectAt(i);
                         if (obj_at != obj)
                             observer->setMultiContextPropertyValue(obj_at,qti_prop_ACTIVITY_MAP,QVariant(false));
                     }
+                    d->tracked_active_subjects.clear();
                 }
                 new_activity = true;
             } else {
@@ -570,6 +606,7 @@ void Qtilities::Core::ActivityPolicyFilter::finalizeAttachment(QObject* obj, boo
             ObjectManager::setMultiContextProperty(obj,new_subject_activity_property);
         }
         observer->toggleSubjectEventFiltering(current_subject_event_filter);
+        trackSubjectActivity(obj,new_activity);
 
         // When tracking parent activity, we need to listen to activity changes on the subjects
         // in order to make parent partially checked if needed to:
@@ -587,9 +624,9 @@ void Qtilities::Core::ActivityPolicyFilter::finalizeAttachment(QObject* obj, boo
                     QCoreApplication::postEvent(obj,user_event);
                     #ifndef QT_NO_DEBUG
                         if (new_activity)
-                            LOG_TRACE(QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2) with activity true").arg(qti_prop_ACTIVITY_MAP).arg(obj->objectName()));
+                            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2) with activity true").arg(qti_prop_ACTIVITY_MAP).arg(obj->objectName()));
                         else
-                            LOG_TRACE(QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2) with activity false").arg(qti_prop_ACTIVITY_MAP).arg(obj->objectName()));
+                            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2) with activity false").arg(qti_prop_ACTIVITY_MAP).arg(obj->objectName()));
                     #endif
                 }
             }
@@ -617,9 +654,43 @@ void Qtilities::Core::ActivityPolicyFilter::finalizeAttachment(QObject* obj, boo
         }
 
         filter_mutex.unlock();
+        if (new_activity)
+            updateParentActivity();
+    } else {
+        // Imported subjects bring their activity with them:
+        invalidateTrackedActiveSubjects();
     }
 }
 
+void Qtilities::Core::ActivityPolicyFilter::initializeBulkAttachment(const QList<QObject*>& objects) {
+    Q_UNUSED(objects)
+
+    d->bulk_attachment_active = true;
+    d->bulk_attachment_active_subject = 0;
+}
+
+void Qtilities::Core::ActivityPolicyFilter::finalizeBulkAttachment(const QList<QPointer<QObject> >& attached_objects, bool import_cycle) {
+    Q_UNUSED(attached_objects)
+    Q_UNUSED(import_cycle)
+
+    d->bulk_attachment_active = false;
+    if (!observer || !d->bulk_attachment_active_subject)
+        return;
+
+    // Deactivate all subjects except the last subject which was set active, in one pass:
+    filter_mutex.tryLock();
+    const int subject_count = observer->subjectCount();
+    for (int i = 0; i < subject_count; ++i) {
+        QObject* obj_at = observer->subjectAt(i);
+        if (obj_at != d->bulk_attachment_active_subject && observer->getMultiContextPropertyValue(obj_at,qti_prop_ACTIVITY_MAP).toBool())
+            observer->setMultiContextPropertyValue(obj_at,qti_prop_ACTIVITY_MAP,QVariant(false));
+    }
+    filter_mutex.unlock();
+    d->tracked_active_subjects.clear();
+    trackSubjectActivity(d->bulk_attachment_active_subject,true);
+    d->bulk_attachment_active_subject = 0;
+}
+
 void Qtilities::Core::ActivityPolicyFilter::finalizeDetachment(QObject* obj, bool detachment_successful, bool subject_deleted) {
     #ifndef QT_NO_DEBUG
         Q_ASSERT(observer != 0);
@@ -632,6 +703,14 @@ void Qtilities::Core::ActivityPolicyFilter::finalizeDetachment(QObject* obj, boo
     if (!detachment_successful && !subject_deleted)
         return;
 
+    // The subject is no longer in the observer context, thus its activity is checked directly when the active subjects are not tracked:
+    bool was_active;
+    if (d->tracked_active_subjects_valid)
+        was_active = d->tracked_active_subjects.contains(obj);
+    else
+        was_active = observer->getMultiContextPropertyValue(obj,qti_prop_ACTIVITY_MAP).toBool();
+    trackSubjectActivity(obj,false);
+
     // Ensure that property changes are not handled by the QDynamicPropertyChangeEvent handler.
     filter_mutex.tryLock();
     bool set_0_index_active = false;
@@ -639,8 +718,7 @@ void Qtilities::Core::ActivityPolicyFilter::finalizeDetachment(QObject* obj, boo
     if (subject_count >= 1) {
         if (d->minimum_activity_policy == ActivityPolicyFilter::ProhibitNoneActive) {
             // Check if this subject was active.
-            bool is_active = observer->getMultiContextPropertyValue(obj,qti_prop_ACTIVITY_MAP).toBool();
-            if (is_active && (numActiveSubjects() == 0)) {
+            if (was_active && (numActiveSubjects() == 0)) {
                 // We need to set a different subject to be active.
                 // Important bug fixed: In the case where a naming policy filter overwrites a conflicting
                 // object during attachment, we might get here before the activity on the new object
@@ -669,6 +747,9 @@ void Qtilities::Core::ActivityPolicyFilter::finalizeDetachment(QObject* obj, boo
          setModificationState(true);
     } else
         setModificationState(true,IModificationNotifier::NotifyNone);
+
+    if (was_active && !set_0_index_active)
+        updateParentActivity();
 }
 
 QStringList Qtilities::Core::ActivityPolicyFilter::monitoredProperties() const {
@@ -677,14 +758,21 @@ QStringList Qtilities::Core::ActivityPolicyFilter::monitoredProperties() const {
     return reserved_properties;
 }
 
+qint64 Qtilities::Core::ActivityPolicyFilter::estimatedStateBytes() const {
+    return MemoryUsageReport::estimatedHashBytes(d->tracked_active_subjects.count(),sizeof(void*))
+            + MemoryUsageReport::estimatedListBytes(d->processing_cycle_start_active_subjects.count(),sizeof(QPointer<QObject>));
+}
+
 bool Qtilities::Core::ActivityPolicyFilter::handleMonitoredPropertyChange(QObject* obj, const char* property_name, QDynamicPropertyChangeEvent* propertyChangeEvent) {
     Q_UNUSED(property_name)
 
     QTime time;
     time.start();
 
-    if (!d->enforce_activity_policy)
+    if (!d->enforce_activity_policy) {
+        invalidateTrackedActiveSubjects();
         return true;
+    }
 
     if (!filter_mutex.tryLock())
         return false;
@@ -700,11 +788,15 @@ bool Qtilities::Core::ActivityPolicyFilter::handleMonitoredPropertyChange(QObjec
                 if (current_obj != obj)
                     observer->setMultiContextPropertyValue(current_obj,qti_prop_ACTIVITY_MAP, QVariant(false));
             }
+            d->tracked_active_subjects.clear();
         }
+        trackSubjectActivity(obj,true);
     } else {
+        trackSubjectActivity(obj,false);
         if (d->minimum_activity_policy == ActivityPolicyFilter::ProhibitNoneActive && (numActiveSubjects() == 0)) {
             // In this case, we allow the change to go through but we change the value here.
             observer->setMultiContextPropertyValue(obj,qti_prop_ACTIVITY_MAP, QVariant(true));
+            trackSubjectActivity(obj,true);
         }
     }
 
@@ -716,12 +808,12 @@ bool Qtilities::Core::ActivityPolicyFilter::handleMonitoredPropertyChange(QObjec
             if (single_object_change_only) {
                 QtilitiesPropertyChangeEvent* user_event = new QtilitiesPropertyChangeEvent(property_name_byte_array,observer->observerID());
                 QCoreApplication::postEvent(obj,user_event);
-                LOG_TRACE(QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(obj->objectName()));
+                LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(obj->objectName()));
             } else {
                 for (int i = 0; i < subject_count; ++i)    {
                     QtilitiesPropertyChangeEvent* user_event = new QtilitiesPropertyChangeEvent(property_name_byte_array,observer->observerID());
                     QCoreApplication::postEvent(observer->subjectAt(i),user_event);
-                    LOG_TRACE(QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(observer->subjectAt(i)->objectName()));
+                    LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(observer->subjectAt(i)->objectName()));
                 }
             }
         }
@@ -752,6 +844,9 @@ bool Qtilities::Core::ActivityPolicyFilter::handleMonitoredPropertyChange(QObjec
     }
 
     filter_mutex.unlock();
+
+    // 6. Update the activity of the observer context in its parent:
+    updateParentActivity();
     return false;
 }
 
@@ -859,8 +954,12 @@ bool Qtilities::Core::ActivityPolicyFilter::eventFilter(QObject *object, QEvent
                     if (Observer::parentCount(observer) == 1) {
                         MultiContextProperty observer_property = ObjectManager::getMultiContextProperty(observer,qti_prop_ACTIVITY_MAP);
                         if (observer_property.isValid()) {
-                            if (observer_property.contextMap().count() > 0) {
-                                bool activity = observer_property.contextMap().values().at(0).toBool();
+                            if (observer_property.contextCount() > 0) {
+                                bool activity = observer_property.value(observer_property.contextIds().at(0)).toBool();
+                                // When the activity of the observer agrees with the activity of its subjects, the change came from the
+                                // subjects through updateParentActivity() or it was already applied, thus the subjects must not change:
+                                if (activity == (numActiveSubjects() > 0))
+                                    return false;
 
                                 d->ignore_subject_tracking_changes = true;
                                 //qDebug() << "setting activity on subjects" << observer;
@@ -887,7 +986,7 @@ bool Qtilities::Core::ActivityPolicyFilter::eventFilter(QObject *object, QEvent
                         MultiContextProperty observer_property = ObjectManager::getMultiContextProperty(object,qti_prop_ACTIVITY_MAP);
                         if (observer_property.isValid()) {
                             //qDebug() << "## 2";
-                            if (observer_property.contextMap().count() > 0) {
+                            if (observer_property.contextCount() > 0) {
                                // qDebug() << "## 3";
                                 bool activity = observer_property.value(observer->observerID()).toBool();
                                 // Only when its inactive we must set the parent to be partially active.
@@ -911,6 +1010,7 @@ bool Qtilities::Core::ActivityPolicyFilter::eventFilter(QObject *object, QEvent
 bool Qtilities::Core::ActivityPolicyFilter::setObserverContext(Observer* observer_context) {
     if (observerContext())
         observerContext()->disconnect(this);
+    invalidateTrackedActiveSubjects();
 
     if (AbstractSubjectFilter::setObserverContext(observer_context)) {
         observer_context->installEventFilter(this);
@@ -929,6 +1029,59 @@ void Qtilities::Core::ActivityPolicyFilter::enableActivityPolicyEnforcement() {
     d->enforce_activity_policy = true;
 }
 
+const QSet<const QObject*>& Qtilities::Core::ActivityPolicyFilter::trackedActiveSubjects() const {
+    if (!d->tracked_active_subjects_valid) {
+        d->tracked_active_subjects.clear();
+        if (observer) {
+            int count = observer->subjectCount();
+            for (int i = 0; i < count; ++i) {
+                QObject* obj = observer->subjectAt(i);
+                if (observer->getMultiContextPropertyValue(obj,qti_prop_ACTIVITY_MAP).toBool())
+                    d->tracked_active_subjects.insert(obj);
+            }
+        }
+        d->tracked_active_subjects_valid = true;
+    }
+    return d->tracked_active_subjects;
+}
+
+void Qtilities::Core::ActivityPolicyFilter::invalidateTrackedActiveSubjects() {
+    d->tracked_active_subjects.clear();
+    d->tracked_active_subjects_valid = false;
+}
+
+void Qtilities::Core::ActivityPolicyFilter::trackSubjectActivity(const QObject* obj, bool is_active) {
+    // While the active subjects are not tracked they are collected from scratch when needed, thus there is nothing to update:
+    if (!d->tracked_active_subjects_valid || !obj)
+        return;
+
+    if (is_active)
+        d->tracked_active_subjects.insert(obj);
+    else
+        d->tracked_active_subjects.remove(obj);
+}
+
+void Qtilities::Core::ActivityPolicyFilter::updateParentActivity() {
+    if (!observer || d->parent_tracking_policy != ActivityPolicyFilter::ParentFollowActivity || d->activity_policy == ActivityPolicyFilter::UniqueActivity)
+        return;
+    if (Observer::parentCount(observer) != 1)
+        return;
+
+    MultiContextProperty observer_property = ObjectManager::getMultiContextProperty(observer,qti_prop_ACTIVITY_MAP);
+    if (!observer_property.isValid() || observer_property.contextCount() == 0)
+        return;
+
+    // Propagation stops as soon as the activity of an observer does not change:
+    int parent_id = observer_property.contextIds().at(0);
+    bool has_active_subjects = numActiveSubjects() > 0;
+    if (observer_property.value(parent_id).toBool() == has_active_subjects)
+        return;
+
+    Observer* parent = OBJECT_MANAGER->observerReference(parent_id);
+    if (parent)
+        parent->setMultiContextPropertyValue(observer,qti_prop_ACTIVITY_MAP,QVariant(has_active_subjects));
+}
+
 QDataStream & operator<< (QDataStream& stream, const Qtilities::Core::ActivityPolicyFilter& stream_obj) {
     stream_obj.exportBinary(stream);
     return stream;
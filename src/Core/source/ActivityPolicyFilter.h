@@ -17,6 +17,8 @@
 #include "Factory.h"
 #include "QtilitiesCoreConstants.h"
 
+#include <QSet>
+
 namespace Qtilities {
     namespace Core {
         using namespace Qtilities::Core::Interfaces;
@@ -109,6 +111,12 @@ ActivityPolicyFilter* activity_filter = tree_node->enableActivityControl(Observe
 
               For an example of this behaviour see the <b>Parent Tracking Activity</b> tab in the \p BuildingTreesExample.
 
+              The observer parent follows the activity of its subjects as well: it is active when any of its subjects are active and inactive
+              when none of them are. Each filter tracks its active subjects incrementally, thus a change travels up the tree one observer at
+              a time and stops at the first observer of which the activity does not change. Activity changes which reach the observer in this
+              way are not applied to its subjects again, only changes to the activity of the observer itself are applied to all its subjects.
+              <i>Tracking subject activity in the observer parent was added in %Qtilities v1.5.</i>
+
               \note To track the activity of the observer parent, the observer parent must have only one parent itself (othwerise
               it won't be possible to know in which context the activity must be tracked) and the parent must have an activity
               policy filter installed.
@@ -216,6 +224,9 @@ ActivityPolicyFilter* activity_filter = tree_node->enableActivityControl(Observe
             ActivityPolicyFilter::NewSubjectActivityPolicy newSubjectActivityPolicy() const;
 
             //! Gets the number of active subjects in the current observer context.
+            /*!
+              The active subjects are tracked incrementally as their activity changes, thus this function does not have to check all subjects.
+              */
             int numActiveSubjects() const;
             //! Returns a list with references to all the active subjects in the current observer context.
             QList<QObject*> activeSubjects() const;
@@ -231,9 +242,12 @@ ActivityPolicyFilter* activity_filter = tree_node->enableActivityControl(Observe
             // --------------------------------
             bool initializeAttachment(QObject* obj, QString* rejectMsg = 0, bool import_cycle = false);
             void finalizeAttachment(QObject* obj, bool attachment_successful, bool import_cycle = false);
+            void initializeBulkAttachment(const QList<QObject*>& objects);
+            void finalizeBulkAttachment(const QList<QPointer<QObject> >& attached_objects, bool import_cycle = false);
             void finalizeDetachment(QObject* obj, bool detachment_successful, bool subject_deleted = false);
             QString filterName() const { return qti_def_FACTORY_TAG_ACTIVITY_FILTER; }
             QStringList monitoredProperties() const;
+            qint64 estimatedStateBytes() const;
         protected:
             bool handleMonitoredPropertyChange(QObject* obj, const char* property_name, QDynamicPropertyChangeEvent* propertyChangeEvent);
 
@@ -370,6 +384,29 @@ ActivityPolicyFilter* activity_filter = tree_node->enableActivityControl(Observe
             void activeSubjectsChanged(QList<QObject*> active_objects, QList<QObject*> inactive_objects);
 
         private:
+            //! Returns the tracked active subjects, checking the activity of all subjects when they are not tracked at present.
+            /*!
+             *<i>This function was added in %Qtilities v1.5.</i>
+             */
+            const QSet<const QObject*>& trackedActiveSubjects() const;
+            //! Stops tracking the active subjects incrementally. They are collected again the next time they are needed.
+            /*!
+             *<i>This function was added in %Qtilities v1.5.</i>
+             */
+            void invalidateTrackedActiveSubjects();
+            //! Updates the tracked activity of \p obj.
+            /*!
+             *<i>This function was added in %Qtilities v1.5.</i>
+             */
+            void trackSubjectActivity(const QObject* obj, bool is_active);
+            //! When parentTrackingPolicy() is ParentFollowActivity, makes the observer context active in its parent when any of its subjects are active and inactive otherwise.
+            /*!
+             *The parent's filter updates its own parent in turn, thus a change travels up the tree until the activity of an observer does not change.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             */
+            void updateParentActivity();
+
             ActivityPolicyFilterPrivateData* d;
         };
     }
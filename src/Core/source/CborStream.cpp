@@ -0,0 +1,577 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "CborStream.h"
+
+#include <QIODevice>
+#include <QVector>
+
+#include <limits>
+#include <math.h>
+#include <string.h>
+
+namespace {
+    // CBOR major types:
+    const quint8 qti_private_CborUnsigned   = 0;
+    const quint8 qti_private_CborNegative   = 1;
+    const quint8 qti_private_CborBytes      = 2;
+    const quint8 qti_private_CborText       = 3;
+    const quint8 qti_private_CborArray      = 4;
+    const quint8 qti_private_CborMap        = 5;
+    const quint8 qti_private_CborTag        = 6;
+    const quint8 qti_private_CborSimple     = 7;
+
+    // The additional information which marks indefinite lengths, and the break which ends them:
+    const quint8 qti_private_CborIndefinite = 31;
+    const char qti_private_CborBreak        = (char) 0xff;
+
+    // Set on the container types kept by the writer when a container has an indefinite length:
+    const quint8 qti_private_CborIndefiniteContainer = 0x80;
+
+    double qti_private_DecodeHalf(quint16 half) {
+        int exponent = (half >> 10) & 0x1f;
+        int mantissa = half & 0x3ff;
+        double value;
+        if (exponent == 0)
+            value = ldexp((double) mantissa,-24);
+        else if (exponent != 31)
+            value = ldexp((double) (mantissa + 1024),exponent - 25);
+        else if (mantissa == 0)
+            value = std::numeric_limits<double>::infinity();
+        else
+            value = std::numeric_limits<double>::quiet_NaN();
+        return (half & 0x8000) ? -value : value;
+    }
+}
+
+// -----------------------------------------
+// CborStreamWriter
+// -----------------------------------------
+
+struct Qtilities::Core::CborStreamWriterPrivateData {
+    CborStreamWriterPrivateData() : device(0),
+        error(false) { }
+
+    QIODevice*      device;
+    //! The major type of every open container, including qti_private_CborIndefiniteContainer when its length is indefinite.
+    QVector<quint8> containers;
+    bool            error;
+};
+
+Qtilities::Core::CborStreamWriter::CborStreamWriter(QIODevice* device) {
+    d = new CborStreamWriterPrivateData;
+    d->device = device;
+    if (!device)
+        d->error = true;
+}
+
+Qtilities::Core::CborStreamWriter::~CborStreamWriter() {
+    delete d;
+}
+
+QIODevice* Qtilities::Core::CborStreamWriter::device() const {
+    return d->device;
+}
+
+bool Qtilities::Core::CborStreamWriter::hasError() const {
+    return d->error;
+}
+
+void Qtilities::Core::CborStreamWriter::writeUnsignedInteger(quint64 value) {
+    writeHead(qti_private_CborUnsigned,value);
+}
+
+void Qtilities::Core::CborStreamWriter::writeInteger(qint64 value) {
+    if (value >= 0)
+        writeHead(qti_private_CborUnsigned,(quint64) value);
+    else
+        writeHead(qti_private_CborNegative,(quint64) (-1 - value));
+}
+
+void Qtilities::Core::CborStreamWriter::writeBool(bool value) {
+    if (d->error)
+        return;
+    if (!d->device->putChar(value ? (char) 0xf5 : (char) 0xf4))
+        d->error = true;
+}
+
+void Qtilities::Core::CborStreamWriter::writeNull() {
+    if (d->error)
+        return;
+    if (!d->device->putChar((char) 0xf6))
+        d->error = true;
+}
+
+void Qtilities::Core::CborStreamWriter::writeDouble(double value) {
+    if (d->error)
+        return;
+
+    quint64 bits;
+    memcpy(&bits,&value,sizeof(bits));
+    char buffer[9];
+    buffer[0] = (char) 0xfb;
+    for (int i = 0; i < 8; ++i)
+        buffer[8 - i] = (char) ((bits >> (8 * i)) & 0xff);
+    if (d->device->write(buffer,9) != 9)
+        d->error = true;
+}
+
+void Qtilities::Core::CborStreamWriter::writeString(const QString& string) {
+    QByteArray utf8 = string.toUtf8();
+    writeHead(qti_private_CborText,(quint64) utf8.size());
+    if (!d->error && d->device->write(utf8) != utf8.size())
+        d->error = true;
+}
+
+void Qtilities::Core::CborStreamWriter::writeByteArray(const QByteArray& data) {
+    writeHead(qti_private_CborBytes,(quint64) data.size());
+    if (!d->error && d->device->write(data) != data.size())
+        d->error = true;
+}
+
+void Qtilities::Core::CborStreamWriter::writeTag(quint64 tag) {
+    writeHead(qti_private_CborTag,tag);
+}
+
+void Qtilities::Core::CborStreamWriter::startArray() {
+    if (!d->error && !d->device->putChar((char) ((qti_private_CborArray << 5) | qti_private_CborIndefinite)))
+        d->error = true;
+    d->containers.append(qti_private_CborArray | qti_private_CborIndefiniteContainer);
+}
+
+void Qtilities::Core::CborStreamWriter::startArray(quint64 count) {
+    writeHead(qti_private_CborArray,count);
+    d->containers.append(qti_private_CborArray);
+}
+
+bool Qtilities::Core::CborStreamWriter::endArray() {
+    return endContainer(qti_private_CborArray);
+}
+
+void Qtilities::Core::CborStreamWriter::startMap() {
+    if (!d->error && !d->device->putChar((char) ((qti_private_CborMap << 5) | qti_private_CborIndefinite)))
+        d->error = true;
+    d->containers.append(qti_private_CborMap | qti_private_CborIndefiniteContainer);
+}
+
+void Qtilities::Core::CborStreamWriter::startMap(quint64 count) {
+    writeHead(qti_private_CborMap,count);
+    d->containers.append(qti_private_CborMap);
+}
+
+bool Qtilities::Core::CborStreamWriter::endMap() {
+    return endContainer(qti_private_CborMap);
+}
+
+void Qtilities::Core::CborStreamWriter::writeHead(quint8 major_type, quint64 value) {
+    if (d->error)
+        return;
+
+    char buffer[9];
+    int size;
+    if (value < 24) {
+        buffer[0] = (char) ((major_type << 5) | value);
+        size = 1;
+    } else if (value <= 0xff) {
+        buffer[0] = (char) ((major_type << 5) | 24);
+        size = 2;
+    } else if (value <= 0xffff) {
+        buffer[0] = (char) ((major_type << 5) | 25);
+        size = 3;
+    } else if (value <= 0xffffffffULL) {
+        buffer[0] = (char) ((major_type << 5) | 26);
+        size = 5;
+    } else {
+        buffer[0] = (char) ((major_type << 5) | 27);
+        size = 9;
+    }
+    // The argument follows the initial byte in network byte order:
+    for (int i = 1; i < size; ++i)
+        buffer[i] = (char) ((value >> (8 * (size - 1 - i))) & 0xff);
+
+    if (d->device->write(buffer,size) != size)
+        d->error = true;
+}
+
+bool Qtilities::Core::CborStreamWriter::endContainer(quint8 major_type) {
+    if (d->containers.isEmpty() || (d->containers.last() & ~qti_private_CborIndefiniteContainer) != major_type) {
+        d->error = true;
+        return false;
+    }
+
+    if ((d->containers.last() & qti_private_CborIndefiniteContainer) && !d->error) {
+        if (!d->device->putChar(qti_private_CborBreak))
+            d->error = true;
+    }
+    d->containers.remove(d->containers.count() - 1);
+    return true;
+}
+
+// -----------------------------------------
+// CborStreamReader
+// -----------------------------------------
+
+struct Qtilities::Core::CborStreamReaderPrivateData {
+    CborStreamReaderPrivateData() : device(0),
+        type(CborStreamReader::Invalid),
+        major_type(0),
+        info(0),
+        value(0),
+        at_break(false),
+        error(false) { }
+
+    QIODevice*                  device;
+    CborStreamReader::Type      type;
+    quint8                      major_type;
+    quint8                      info;
+    //! The argument of the current item, thus its value, length or raw floating point bits.
+    quint64                     value;
+    //! The number of items left in every open container, or -1 when its length is indefinite.
+    QVector<qint64>             containers;
+    //! Indicates that the break which ends the current indefinite length container was read.
+    bool                        at_break;
+    bool                        error;
+    QString                     error_string;
+};
+
+Qtilities::Core::CborStreamReader::CborStreamReader(QIODevice* device) {
+    d = new CborStreamReaderPrivateData;
+    d->device = device;
+    if (!device)
+        setError("No device to read from.");
+    else
+        preparse();
+}
+
+Qtilities::Core::CborStreamReader::~CborStreamReader() {
+    delete d;
+}
+
+QIODevice* Qtilities::Core::CborStreamReader::device() const {
+    return d->device;
+}
+
+bool Qtilities::Core::CborStreamReader::hasError() const {
+    return d->error;
+}
+
+QString Qtilities::Core::CborStreamReader::errorString() const {
+    return d->error_string;
+}
+
+Qtilities::Core::CborStreamReader::Type Qtilities::Core::CborStreamReader::type() const {
+    return d->type;
+}
+
+bool Qtilities::Core::CborStreamReader::isLengthKnown() const {
+    return d->info != qti_private_CborIndefinite;
+}
+
+quint64 Qtilities::Core::CborStreamReader::length() const {
+    if (d->type != ByteArray && d->type != String && d->type != Array && d->type != Map)
+        return 0;
+    return isLengthKnown() ? d->value : 0;
+}
+
+quint64 Qtilities::Core::CborStreamReader::toUnsignedInteger() const {
+    return d->type == UnsignedInteger ? d->value : 0;
+}
+
+qint64 Qtilities::Core::CborStreamReader::toInteger() const {
+    if (d->type == UnsignedInteger)
+        return (qint64) d->value;
+    else if (d->type == NegativeInteger)
+        return -1 - (qint64) d->value;
+    return 0;
+}
+
+bool Qtilities::Core::CborStreamReader::toBool() const {
+    return d->type == Bool && d->info == 21;
+}
+
+double Qtilities::Core::CborStreamReader::toDouble() const {
+    if (isInteger())
+        return (double) toInteger();
+    if (d->type != Double)
+        return 0;
+
+    if (d->info == 25) {
+        return qti_private_DecodeHalf((quint16) d->value);
+    } else if (d->info == 26) {
+        quint32 bits = (quint32) d->value;
+        float value;
+        memcpy(&value,&bits,sizeof(value));
+        return value;
+    } else {
+        double value;
+        memcpy(&value,&d->value,sizeof(value));
+        return value;
+    }
+}
+
+quint64 Qtilities::Core::CborStreamReader::readTag() {
+    if (d->type != Tag) {
+        setError("Expected a tag.");
+        return 0;
+    }
+
+    quint64 tag = d->value;
+    // The tag and the item it applies to count as a single item in their container:
+    advance(false);
+    return tag;
+}
+
+QString Qtilities::Core::CborStreamReader::readString() {
+    if (d->type != String) {
+        setError("Expected a text string.");
+        return QString();
+    }
+
+    QByteArray data;
+    if (!readStringData(&data))
+        return QString();
+    advance(true);
+    return QString::fromUtf8(data.constData(),data.size());
+}
+
+QByteArray Qtilities::Core::CborStreamReader::readByteArray() {
+    if (d->type != ByteArray) {
+        setError("Expected a byte string.");
+        return QByteArray();
+    }
+
+    QByteArray data;
+    if (!readStringData(&data))
+        return QByteArray();
+    advance(true);
+    return data;
+}
+
+bool Qtilities::Core::CborStreamReader::hasNext() const {
+    return !d->error && d->type != Invalid;
+}
+
+bool Qtilities::Core::CborStreamReader::next() {
+    if (!hasNext())
+        return false;
+
+    if (d->type == Array || d->type == Map) {
+        if (!enterContainer())
+            return false;
+        while (hasNext())
+            next();
+        return leaveContainer();
+    } else if (d->type == String || d->type == ByteArray) {
+        QByteArray data;
+        if (!readStringData(&data))
+            return false;
+        advance(true);
+    } else if (d->type == Tag) {
+        advance(false);
+        return next();
+    } else
+        advance(true);
+
+    return !d->error;
+}
+
+bool Qtilities::Core::CborStreamReader::enterContainer() {
+    if (d->error || (d->type != Array && d->type != Map))
+        return false;
+
+    qint64 count = -1;
+    if (isLengthKnown()) {
+        if (d->value > (quint64) (std::numeric_limits<qint64>::max() / 2)) {
+            setError("Container length is too large.");
+            return false;
+        }
+        count = d->type == Map ? 2 * (qint64) d->value : (qint64) d->value;
+    }
+    d->containers.append(count);
+    preparse();
+    return !d->error;
+}
+
+bool Qtilities::Core::CborStreamReader::leaveContainer() {
+    if (d->error || d->containers.isEmpty())
+        return false;
+
+    while (hasNext())
+        next();
+    if (d->error)
+        return false;
+
+    d->containers.remove(d->containers.count() - 1);
+    advance(true);
+    return !d->error;
+}
+
+void Qtilities::Core::CborStreamReader::preparse() {
+    d->type = Invalid;
+    d->at_break = false;
+    if (d->error)
+        return;
+
+    // The end of a container with a known length, or the end of the data at the top level:
+    if (!d->containers.isEmpty() && d->containers.last() == 0)
+        return;
+    if (d->containers.isEmpty() && d->device->atEnd())
+        return;
+
+    quint8 major_type;
+    quint8 info;
+    quint64 value;
+    if (!readHead(&major_type,&info,&value))
+        return;
+
+    if (major_type == qti_private_CborSimple && info == qti_private_CborIndefinite) {
+        if (d->containers.isEmpty() || d->containers.last() != -1) {
+            setError("Unexpected break.");
+            return;
+        }
+        d->at_break = true;
+        return;
+    }
+
+    if (info == qti_private_CborIndefinite && major_type != qti_private_CborBytes && major_type != qti_private_CborText &&
+            major_type != qti_private_CborArray && major_type != qti_private_CborMap) {
+        setError("Invalid indefinite length item.");
+        return;
+    }
+
+    d->major_type = major_type;
+    d->info = info;
+    d->value = value;
+    switch (major_type) {
+    case qti_private_CborUnsigned:
+        d->type = UnsignedInteger;
+        break;
+    case qti_private_CborNegative:
+        d->type = NegativeInteger;
+        break;
+    case qti_private_CborBytes:
+        d->type = ByteArray;
+        break;
+    case qti_private_CborText:
+        d->type = String;
+        break;
+    case qti_private_CborArray:
+        d->type = Array;
+        break;
+    case qti_private_CborMap:
+        d->type = Map;
+        break;
+    case qti_private_CborTag:
+        d->type = Tag;
+        break;
+    default:
+        if (info == 20 || info == 21)
+            d->type = Bool;
+        else if (info == 22)
+            d->type = Null;
+        else if (info == 23)
+            d->type = Undefined;
+        else if (info >= 25 && info <= 27)
+            d->type = Double;
+        else
+            d->type = SimpleType;
+        break;
+    }
+}
+
+void Qtilities::Core::CborStreamReader::advance(bool count_item) {
+    if (count_item && !d->containers.isEmpty() && d->containers.last() > 0)
+        --d->containers.last();
+    preparse();
+}
+
+bool Qtilities::Core::CborStreamReader::readHead(quint8* major_type, quint8* info, quint64* value) {
+    char initial_byte;
+    if (!d->device->getChar(&initial_byte)) {
+        setError("Unexpected end of data.");
+        return false;
+    }
+
+    *major_type = ((quint8) initial_byte) >> 5;
+    *info = ((quint8) initial_byte) & 0x1f;
+    *value = 0;
+    if (*info < 24) {
+        *value = *info;
+        return true;
+    } else if (*info == qti_private_CborIndefinite) {
+        return true;
+    } else if (*info > 27) {
+        setError("Invalid additional information in item head.");
+        return false;
+    }
+
+    int size = 1 << (*info - 24);
+    char buffer[8];
+    if (d->device->read(buffer,size) != size) {
+        setError("Unexpected end of data.");
+        return false;
+    }
+    for (int i = 0; i < size; ++i)
+        *value = (*value << 8) | (quint8) buffer[i];
+    return true;
+}
+
+bool Qtilities::Core::CborStreamReader::readStringData(QByteArray* data) {
+    if (isLengthKnown())
+        return readData(data,d->value);
+
+    // Indefinite length strings are written as chunks of the same type, ended by a break:
+    data->clear();
+    forever {
+        quint8 major_type;
+        quint8 info;
+        quint64 value;
+        if (!readHead(&major_type,&info,&value))
+            return false;
+        if (major_type == qti_private_CborSimple && info == qti_private_CborIndefinite)
+            return true;
+        if (major_type != d->major_type || info == qti_private_CborIndefinite) {
+            setError("Invalid chunk in indefinite length string.");
+            return false;
+        }
+        QByteArray chunk;
+        if (!readData(&chunk,value))
+            return false;
+        data->append(chunk);
+    }
+}
+
+bool Qtilities::Core::CborStreamReader::readData(QByteArray* data, quint64 length) {
+    data->clear();
+    if (length > (quint64) std::numeric_limits<int>::max()) {
+        setError("String length is too large.");
+        return false;
+    }
+
+    // The data is read in blocks, thus a corrupt length does not allocate more memory than the data which is available:
+    while ((quint64) data->size() < length) {
+        qint64 block_size = qMin(length - (quint64) data->size(),(quint64) 65536);
+        QByteArray block = d->device->read(block_size);
+        if (block.isEmpty()) {
+            setError("Unexpected end of data.");
+            return false;
+        }
+        data->append(block);
+    }
+    return true;
+}
+
+void Qtilities::Core::CborStreamReader::setError(const QString& error_string) {
+    if (!d->error)
+        d->error_string = error_string;
+    d->error = true;
+    d->type = Invalid;
+}
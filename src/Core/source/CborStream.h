@@ -0,0 +1,236 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef CBOR_STREAM_H
+#define CBOR_STREAM_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QByteArray>
+#include <QString>
+
+class QIODevice;
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \struct CborStreamWriterPrivateData
+        \brief Structure used by CborStreamWriter to store private data.
+          */
+        struct CborStreamWriterPrivateData;
+
+        /*!
+        \class CborStreamWriter
+        \brief The CborStreamWriter class writes CBOR (RFC 7049) items directly to a QIODevice.
+
+        Items are written as soon as they are appended, thus nothing but the nesting of the open containers is kept in memory. Containers are
+        started with startArray() or startMap() and ended with endArray() or endMap(). When the number of items in a container is not known when
+        it is started, the container is written with an indefinite length. Map keys and values are written as two consecutive items:
+
+\code
+QFile file("tree.cbor");
+file.open(QIODevice::WriteOnly);
+CborStreamWriter writer(&file);
+writer.writeTag(CborStreamWriter::SelfDescribeTag);
+writer.startMap();
+writer.writeString("name");
+writer.writeString("Root");
+writer.writeString("children");
+writer.startArray();
+for (int i = 0; i < observer->subjectCount(); ++i)
+    writer.writeString(observer->subjectNameInContext(observer->subjectAt(i)));
+writer.endArray();
+writer.endMap();
+\endcode
+
+        The writer does not check the structure of what is written, only that containers are ended in the order in which they were started.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT CborStreamWriter {
+        public:
+            //! The tag which identifies the data following it as CBOR, written at the start of CBOR files.
+            static const quint64 SelfDescribeTag = 55799;
+
+            CborStreamWriter(QIODevice* device);
+            ~CborStreamWriter();
+
+            //! The device to which items are written.
+            QIODevice* device() const;
+            //! Indicates if writing to the device failed, or if containers were not ended properly.
+            bool hasError() const;
+
+            //! Writes an unsigned integer.
+            void writeUnsignedInteger(quint64 value);
+            //! Writes a signed integer, which is written as an unsigned integer when it is not negative.
+            void writeInteger(qint64 value);
+            //! Writes a boolean.
+            void writeBool(bool value);
+            //! Writes null.
+            void writeNull();
+            //! Writes a double precision floating point number.
+            void writeDouble(double value);
+            //! Writes a text string, which is encoded as UTF-8.
+            void writeString(const QString& string);
+            //! Writes a byte string.
+            void writeByteArray(const QByteArray& data);
+            //! Writes a tag, which applies to the item written after it.
+            void writeTag(quint64 tag);
+
+            //! Starts an array of which the number of items is not known.
+            void startArray();
+            //! Starts an array of \p count items.
+            void startArray(quint64 count);
+            //! Ends the array which was started last.
+            /*!
+              \returns False when the container which was started last is not an array.
+              */
+            bool endArray();
+            //! Starts a map of which the number of key and value pairs is not known.
+            void startMap();
+            //! Starts a map of \p count key and value pairs.
+            void startMap(quint64 count);
+            //! Ends the map which was started last.
+            /*!
+              \returns False when the container which was started last is not a map.
+              */
+            bool endMap();
+
+        private:
+            Q_DISABLE_COPY(CborStreamWriter)
+            void writeHead(quint8 major_type, quint64 value);
+            bool endContainer(quint8 major_type);
+
+            CborStreamWriterPrivateData* d;
+        };
+
+        /*!
+        \struct CborStreamReaderPrivateData
+        \brief Structure used by CborStreamReader to store private data.
+          */
+        struct CborStreamReaderPrivateData;
+
+        /*!
+        \class CborStreamReader
+        \brief The CborStreamReader class reads CBOR (RFC 7049) items directly from a QIODevice.
+
+        The reader is a pull parser which is positioned on one item at a time, of which the type is returned by type(). The values of integers,
+        booleans and floating point numbers are returned by the \p to functions, after which next() moves on to the next item. Strings are read
+        using readString() and readByteArray(), which also move on to the next item. Containers are entered using enterContainer(), after which
+        their items are read until hasNext() returns false, and left using leaveContainer(). Items which are not needed are skipped with next(),
+        which skips the complete content of containers:
+
+\code
+CborStreamReader reader(&file);
+if (reader.type() == CborStreamReader::Tag)
+    reader.readTag();
+reader.enterContainer();
+while (reader.hasNext()) {
+    QString key = reader.readString();
+    if (key == "name")
+        qDebug() << reader.readString();
+    else
+        reader.next();
+}
+reader.leaveContainer();
+\endcode
+
+        A tag is returned as an item of its own. readTag() returns its value and moves on to the item it applies to, while next() skips the tag
+        together with that item. When the data is not valid CBOR, or when readString() or readByteArray() is called on another type, hasError()
+        returns true and the reader stops. Thus, loops which check hasNext() always end.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT CborStreamReader {
+        public:
+            //! The types of CBOR items.
+            enum Type {
+                Invalid,            /*!< Not positioned on an item: At the end of a container, at the end of the data, or after an error. */
+                UnsignedInteger,    /*!< An unsigned integer. */
+                NegativeInteger,    /*!< A negative integer. */
+                ByteArray,          /*!< A byte string. */
+                String,             /*!< A text string. */
+                Array,              /*!< An array. */
+                Map,                /*!< A map. */
+                Tag,                /*!< A tag, which applies to the next item. */
+                Bool,               /*!< A boolean. */
+                Null,               /*!< Null. */
+                Undefined,          /*!< Undefined. */
+                Double,             /*!< A half, single or double precision floating point number. */
+                SimpleType          /*!< Another simple value. */
+            };
+
+            //! Constructs a reader which is positioned on the first item in \p device.
+            CborStreamReader(QIODevice* device);
+            ~CborStreamReader();
+
+            //! The device from which items are read.
+            QIODevice* device() const;
+            //! Indicates if the data could not be read.
+            bool hasError() const;
+            //! The reason why the data could not be read.
+            QString errorString() const;
+
+            //! The type of the current item.
+            Type type() const;
+            inline bool isUnsignedInteger() const { return type() == UnsignedInteger; }
+            inline bool isInteger() const { return type() == UnsignedInteger || type() == NegativeInteger; }
+            inline bool isString() const { return type() == String; }
+            inline bool isByteArray() const { return type() == ByteArray; }
+            inline bool isArray() const { return type() == Array; }
+            inline bool isMap() const { return type() == Map; }
+            inline bool isBool() const { return type() == Bool; }
+            inline bool isNull() const { return type() == Null; }
+            //! Indicates if the length of the current string or container is known. Indefinite length items return false.
+            bool isLengthKnown() const;
+            //! The length of the current string, or the number of items in the current array, or the number of pairs in the current map.
+            quint64 length() const;
+
+            //! Returns the value of the current unsigned integer.
+            quint64 toUnsignedInteger() const;
+            //! Returns the value of the current integer, unsigned integers larger than the maximum qint64 are not supported.
+            qint64 toInteger() const;
+            //! Returns the value of the current boolean.
+            bool toBool() const;
+            //! Returns the value of the current floating point number.
+            double toDouble() const;
+
+            //! Reads the current tag and moves on to the item it applies to.
+            quint64 readTag();
+            //! Reads the current text string and moves on to the next item.
+            QString readString();
+            //! Reads the current byte string and moves on to the next item.
+            QByteArray readByteArray();
+
+            //! Indicates if the container which is being read has more items. At the top level, indicates if the device has more data.
+            bool hasNext() const;
+            //! Moves on to the next item, skipping the content of the current item.
+            bool next();
+            //! Enters the current array or map, after which the reader is positioned on its first item.
+            bool enterContainer();
+            //! Skips the remaining items in the container which is being read and moves on to the item after it.
+            bool leaveContainer();
+
+        private:
+            Q_DISABLE_COPY(CborStreamReader)
+            void preparse();
+            void advance(bool count_item);
+            bool readHead(quint8* major_type, quint8* info, quint64* value);
+            bool readStringData(QByteArray* data);
+            bool readData(QByteArray* data, quint64 length);
+            void setError(const QString& error_string);
+
+            CborStreamReaderPrivateData* d;
+        };
+    }
+}
+
+#endif // CBOR_STREAM_H
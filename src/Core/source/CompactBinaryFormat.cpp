@@ -0,0 +1,351 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "CompactBinaryFormat.h"
+
+#include <QHash>
+#include <QIODevice>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
+
+#include <limits.h>
+
+struct Qtilities::Core::CompactBinaryStringTable {
+    //! The index of each string in strings, only used while writing.
+    QHash<QString,quint32>  indexes;
+    QStringList             strings;
+};
+
+namespace {
+    struct CompactBinaryDeferredImportSource {
+        QByteArray              data;
+        QSharedPointer<QObject> owner;
+    };
+
+    //! The string tables and deferred import sources which are active, using the streams they are active on as keys.
+    /*!
+      Streams are exported in different threads during parallel observer exports, thus access to the tables is protected by a mutex.
+      */
+    struct CompactBinaryStreams {
+        QMutex                                                              mutex;
+        QHash<const QDataStream*,Qtilities::Core::CompactBinaryStringTable*> tables;
+        QHash<const QDataStream*,CompactBinaryDeferredImportSource>          sources;
+    };
+}
+
+Q_GLOBAL_STATIC(CompactBinaryStreams,compactBinaryStreams)
+
+bool Qtilities::Core::CompactBinaryFormat::isActive(const QDataStream& stream) {
+    return stringTable(stream) != 0;
+}
+
+void Qtilities::Core::CompactBinaryFormat::writeVarUInt(QDataStream& stream, quint64 value) {
+    while (value >= 0x80) {
+        stream << (quint8) ((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    stream << (quint8) value;
+}
+
+quint64 Qtilities::Core::CompactBinaryFormat::readVarUInt(QDataStream& stream) {
+    quint64 value = 0;
+    // A quint64 never needs more than 10 bytes:
+    for (int shift = 0; shift < 70; shift += 7) {
+        quint8 byte = 0;
+        stream >> byte;
+        if (stream.status() != QDataStream::Ok)
+            return 0;
+        value |= ((quint64) (byte & 0x7F)) << shift;
+        if (!(byte & 0x80))
+            return value;
+    }
+
+    stream.setStatus(QDataStream::ReadCorruptData);
+    return 0;
+}
+
+void Qtilities::Core::CompactBinaryFormat::writeVarInt(QDataStream& stream, qint64 value) {
+    writeVarUInt(stream,((quint64) value << 1) ^ (quint64) (value >> 63));
+}
+
+qint64 Qtilities::Core::CompactBinaryFormat::readVarInt(QDataStream& stream) {
+    quint64 value = readVarUInt(stream);
+    return (qint64) (value >> 1) ^ -((qint64) (value & 1));
+}
+
+void Qtilities::Core::CompactBinaryFormat::writeString(QDataStream& stream, const QString& string) {
+    CompactBinaryStringTable* table = stringTable(stream);
+    if (!table) {
+        // Index 0 indicates that the string itself follows:
+        writeVarUInt(stream,0);
+        writeLiteral(stream,string);
+        return;
+    }
+
+    // Null strings are not added to the table since QHash does not distinguish them from empty strings:
+    if (string.isNull()) {
+        writeVarUInt(stream,0);
+        writeLiteral(stream,string);
+        return;
+    }
+
+    QHash<QString,quint32>::const_iterator itr = table->indexes.constFind(string);
+    quint32 index;
+    if (itr == table->indexes.constEnd()) {
+        index = table->strings.count();
+        table->indexes.insert(string,index);
+        table->strings << string;
+    } else
+        index = itr.value();
+    writeVarUInt(stream,(quint64) index + 1);
+}
+
+QString Qtilities::Core::CompactBinaryFormat::readString(QDataStream& stream) {
+    quint64 index = readVarUInt(stream);
+    if (stream.status() != QDataStream::Ok)
+        return QString();
+    if (index == 0)
+        return readLiteral(stream);
+
+    CompactBinaryStringTable* table = stringTable(stream);
+    if (!table || index > (quint64) table->strings.count()) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return QString();
+    }
+    return table->strings.at((int) (index - 1));
+}
+
+qint64 Qtilities::Core::CompactBinaryFormat::beginSection(QDataStream& stream) {
+    Q_ASSERT(isActive(stream) && stream.device() && !stream.device()->isSequential());
+
+    qint64 section_position = stream.device()->pos();
+    // Reserve space for the length, it is written in endSection():
+    stream << (quint32) 0;
+    return section_position;
+}
+
+void Qtilities::Core::CompactBinaryFormat::endSection(QDataStream& stream, qint64 section_position) {
+    QIODevice* device = stream.device();
+    Q_ASSERT(device && !device->isSequential());
+
+    qint64 end_position = device->pos();
+    device->seek(section_position);
+    stream << (quint32) (end_position - section_position - (qint64) sizeof(quint32));
+    device->seek(end_position);
+}
+
+quint32 Qtilities::Core::CompactBinaryFormat::readSectionLength(QDataStream& stream) {
+    quint32 section_length = 0;
+    stream >> section_length;
+    return section_length;
+}
+
+bool Qtilities::Core::CompactBinaryFormat::skipSection(QDataStream& stream, quint32 section_length) {
+    if (section_length == 0)
+        return true;
+    return stream.skipRawData((int) section_length) == (int) section_length;
+}
+
+QStringList Qtilities::Core::CompactBinaryFormat::stringTableEntries(const QDataStream& stream) {
+    CompactBinaryStringTable* table = stringTable(stream);
+    if (table)
+        return table->strings;
+    else
+        return QStringList();
+}
+
+void Qtilities::Core::CompactBinaryFormat::setDeferredImportSource(const QDataStream& stream, const QByteArray& data, QSharedPointer<QObject> owner) {
+    CompactBinaryDeferredImportSource source;
+    source.data = data;
+    source.owner = owner;
+
+    CompactBinaryStreams* streams = compactBinaryStreams();
+    QMutexLocker locker(&streams->mutex);
+    streams->sources[&stream] = source;
+}
+
+void Qtilities::Core::CompactBinaryFormat::clearDeferredImportSource(const QDataStream& stream) {
+    CompactBinaryStreams* streams = compactBinaryStreams();
+    QMutexLocker locker(&streams->mutex);
+    streams->sources.remove(&stream);
+}
+
+bool Qtilities::Core::CompactBinaryFormat::deferredImportSource(const QDataStream& stream, QByteArray* data, QSharedPointer<QObject>* owner) {
+    CompactBinaryStreams* streams = compactBinaryStreams();
+    QMutexLocker locker(&streams->mutex);
+    QHash<const QDataStream*,CompactBinaryDeferredImportSource>::const_iterator itr = streams->sources.constFind(&stream);
+    if (itr == streams->sources.constEnd())
+        return false;
+
+    if (data)
+        *data = itr.value().data;
+    if (owner)
+        *owner = itr.value().owner;
+    return true;
+}
+
+void Qtilities::Core::CompactBinaryFormat::writeLiteral(QDataStream& stream, const QString& string) {
+    // The length is stored plus one, thus 0 indicates a null string:
+    if (string.isNull()) {
+        writeVarUInt(stream,0);
+        return;
+    }
+
+    QByteArray utf8 = string.toUtf8();
+    writeVarUInt(stream,(quint64) utf8.size() + 1);
+    stream.writeRawData(utf8.constData(),utf8.size());
+}
+
+QString Qtilities::Core::CompactBinaryFormat::readLiteral(QDataStream& stream) {
+    quint64 length = readVarUInt(stream);
+    if (stream.status() != QDataStream::Ok || length == 0)
+        return QString();
+    --length;
+
+    // Don't allocate more than what is left on the device when reading corrupt data:
+    QIODevice* device = stream.device();
+    if (length > (quint64) INT_MAX || (device && !device->isSequential() && (qint64) length > device->bytesAvailable())) {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return QString();
+    }
+
+    QByteArray utf8;
+    utf8.resize((int) length);
+    if (stream.readRawData(utf8.data(),(int) length) != (int) length) {
+        stream.setStatus(QDataStream::ReadPastEnd);
+        return QString();
+    }
+    return QString::fromUtf8(utf8.constData(),utf8.size());
+}
+
+Qtilities::Core::CompactBinaryStringTable* Qtilities::Core::CompactBinaryFormat::stringTable(const QDataStream& stream) {
+    CompactBinaryStreams* streams = compactBinaryStreams();
+    QMutexLocker locker(&streams->mutex);
+    return streams->tables.value(&stream,0);
+}
+
+void Qtilities::Core::CompactBinaryFormat::setStringTable(const QDataStream& stream, CompactBinaryStringTable* table) {
+    CompactBinaryStreams* streams = compactBinaryStreams();
+    QMutexLocker locker(&streams->mutex);
+    if (table)
+        streams->tables[&stream] = table;
+    else
+        streams->tables.remove(&stream);
+}
+
+// -----------------------------------------
+// CompactBinaryFormat::WriteScope
+// -----------------------------------------
+Qtilities::Core::CompactBinaryFormat::WriteScope::WriteScope(QDataStream& stream) : d_target(stream) {
+    d_stream = 0;
+    d_table = 0;
+
+    if (CompactBinaryFormat::isActive(stream)) {
+        // 0 indicates that the data which follows uses the table which is already active:
+        CompactBinaryFormat::writeVarUInt(stream,0);
+    } else {
+        d_stream = new QDataStream(&d_buffer,QIODevice::WriteOnly);
+        d_stream->setVersion(stream.version());
+        d_stream->setByteOrder(stream.byteOrder());
+        d_table = new CompactBinaryStringTable;
+        CompactBinaryFormat::setStringTable(*d_stream,d_table);
+    }
+}
+
+Qtilities::Core::CompactBinaryFormat::WriteScope::~WriteScope() {
+    if (d_stream) {
+        CompactBinaryFormat::setStringTable(*d_stream,0);
+        delete d_stream;
+    }
+    delete d_table;
+}
+
+QDataStream& Qtilities::Core::CompactBinaryFormat::WriteScope::stream() {
+    if (d_stream)
+        return *d_stream;
+    else
+        return d_target;
+}
+
+void Qtilities::Core::CompactBinaryFormat::WriteScope::finish() {
+    if (!d_stream)
+        return;
+
+    CompactBinaryFormat::setStringTable(*d_stream,0);
+    delete d_stream;
+    d_stream = 0;
+
+    // 1 indicates that a new string table follows:
+    CompactBinaryFormat::writeVarUInt(d_target,1);
+    CompactBinaryFormat::writeVarUInt(d_target,d_table->strings.count());
+    for (int i = 0; i < d_table->strings.count(); ++i)
+        CompactBinaryFormat::writeLiteral(d_target,d_table->strings.at(i));
+    d_target.writeRawData(d_buffer.constData(),d_buffer.size());
+
+    d_buffer.clear();
+    delete d_table;
+    d_table = 0;
+}
+
+// -----------------------------------------
+// CompactBinaryFormat::ReadScope
+// -----------------------------------------
+Qtilities::Core::CompactBinaryFormat::ReadScope::ReadScope(QDataStream& stream) : d_stream(stream) {
+    d_table = 0;
+    d_previous_table = CompactBinaryFormat::stringTable(stream);
+    d_valid = false;
+
+    quint64 has_table = CompactBinaryFormat::readVarUInt(stream);
+    if (stream.status() != QDataStream::Ok)
+        return;
+
+    if (has_table == 0) {
+        // The data uses the table which is already active on the stream:
+        d_valid = (d_previous_table != 0);
+        return;
+    } else if (has_table != 1)
+        return;
+
+    quint64 count = CompactBinaryFormat::readVarUInt(stream);
+    if (stream.status() != QDataStream::Ok || count > (quint64) INT_MAX)
+        return;
+
+    d_table = new CompactBinaryStringTable;
+    for (quint64 i = 0; i < count; ++i) {
+        d_table->strings << CompactBinaryFormat::readLiteral(stream);
+        if (stream.status() != QDataStream::Ok)
+            return;
+    }
+
+    CompactBinaryFormat::setStringTable(stream,d_table);
+    d_valid = true;
+}
+
+Qtilities::Core::CompactBinaryFormat::ReadScope::ReadScope(QDataStream& stream, const QStringList& strings) : d_stream(stream) {
+    d_previous_table = CompactBinaryFormat::stringTable(stream);
+    d_table = new CompactBinaryStringTable;
+    d_table->strings = strings;
+    CompactBinaryFormat::setStringTable(stream,d_table);
+    d_valid = true;
+}
+
+Qtilities::Core::CompactBinaryFormat::ReadScope::~ReadScope() {
+    if (d_table) {
+        if (d_valid)
+            CompactBinaryFormat::setStringTable(d_stream,d_previous_table);
+        delete d_table;
+    }
+}
+
+bool Qtilities::Core::CompactBinaryFormat::ReadScope::isValid() const {
+    return d_valid;
+}
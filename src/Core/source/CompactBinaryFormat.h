@@ -0,0 +1,179 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef COMPACT_BINARY_FORMAT_H
+#define COMPACT_BINARY_FORMAT_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \struct CompactBinaryStringTable
+        \brief The CompactBinaryStringTable struct stores the string table of a stream used by CompactBinaryFormat.
+          */
+        struct CompactBinaryStringTable;
+
+        /*!
+        \class CompactBinaryFormat
+        \brief The CompactBinaryFormat class provides the encoding functions used by the compact binary format of Qtilities::Qtilities_1_5.
+
+        Observer binary exports using Qtilities::Qtilities_1_5 and later do not write every string and integer in full. Instead, the strings written during
+        the export of a tree are collected in a string table which is written in front of the tree, after which every string is written as a small index
+        into the table. Integers are written as variable length integers (varints) which only use a single byte for values below 128. Finally, every subject's
+        data is written as a section which starts with its length, thus a reader is able to skip subjects which it cannot construct.
+
+        The string table of a stream is active while a WriteScope or ReadScope exists for it, which can be checked using isActive(). Classes which
+        support the compact format only change their encoding when the stream they are written to has an active string table. Thus, the encoding used by
+        their stream operators outside of an observer export never changes.
+
+        When no string table is active, writeString() and readString() simply write and read the string itself.
+
+        Since subjects are written in sections, an importer is able to defer the import of an observer's subjects until they are needed. This is only
+        done when the data being read stays available after the import, which is indicated using setDeferredImportSource(). See
+        Qtilities::ProjectManagement::ProjectManager::setLazyProjectLoading() for an example.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT CompactBinaryFormat {
+        public:
+            //! Indicates if \p stream has an active string table, thus if the compact encoding must be used on it.
+            static bool isActive(const QDataStream& stream);
+
+            //! Writes an unsigned integer as a varint, using 7 bits of each byte.
+            static void writeVarUInt(QDataStream& stream, quint64 value);
+            //! Reads an unsigned integer written using writeVarUInt().
+            static quint64 readVarUInt(QDataStream& stream);
+            //! Writes a signed integer as a zigzag encoded varint, thus small negative values like -1 also use a single byte.
+            static void writeVarInt(QDataStream& stream, qint64 value);
+            //! Reads a signed integer written using writeVarInt().
+            static qint64 readVarInt(QDataStream& stream);
+
+            //! Writes a string using the string table of \p stream.
+            /*!
+              When the string is not in the table yet, it is added to the table. When \p stream does not have an active string table, the string itself is written.
+              */
+            static void writeString(QDataStream& stream, const QString& string);
+            //! Reads a string written using writeString().
+            /*!
+              When the string refers to an entry which does not exist in the string table of \p stream, the status of \p stream is set to QDataStream::ReadCorruptData.
+              */
+            static QString readString(QDataStream& stream);
+
+            //! Starts a section of which the length is written in front of its data.
+            /*!
+              Sections can only be started on a stream which has an active string table, since the stream written to by a WriteScope is always seekable.
+
+              \returns The position of the section, which must be passed to endSection().
+              */
+            static qint64 beginSection(QDataStream& stream);
+            //! Ends a section started using beginSection() by writing its length.
+            static void endSection(QDataStream& stream, qint64 section_position);
+            //! Reads the length of a section written using beginSection() and endSection().
+            static quint32 readSectionLength(QDataStream& stream);
+            //! Skips the data of a section of which the length was read using readSectionLength().
+            static bool skipSection(QDataStream& stream, quint32 section_length);
+
+            //! Returns the strings in the active string table of \p stream.
+            /*!
+              Used to read data of which the import was deferred using a ReadScope which activates the same strings.
+              */
+            static QStringList stringTableEntries(const QDataStream& stream);
+
+            //! Indicates that \p stream reads \p data from its start, and that \p data stays valid while \p owner exists.
+            /*!
+              When a deferred import source is set on a stream, observers read from it can defer the import of their subjects until they are accessed.
+              Deferred imports keep a reference to \p owner, for example a memory mapped QFile, until they are completed. When \p data owns its contents,
+              \p owner can be null.
+
+              The source must be cleared using clearDeferredImportSource() before \p stream is destroyed.
+              */
+            static void setDeferredImportSource(const QDataStream& stream, const QByteArray& data, QSharedPointer<QObject> owner = QSharedPointer<QObject>());
+            //! Clears the deferred import source set using setDeferredImportSource().
+            static void clearDeferredImportSource(const QDataStream& stream);
+            //! Gets the deferred import source of \p stream.
+            /*!
+              \returns True when \p stream has a deferred import source, false otherwise.
+              */
+            static bool deferredImportSource(const QDataStream& stream, QByteArray* data, QSharedPointer<QObject>* owner);
+
+            /*!
+            \class WriteScope
+            \brief The WriteScope class activates a string table while data is written to a stream.
+
+            When the stream passed to the constructor does not have an active string table yet, data must be written to stream() instead of the
+            original stream. When finish() is called, the string table is written to the original stream, followed by the data written to stream(). When the
+            stream already has an active string table, for example when a child observer is exported as part of its parent, stream() returns the original stream
+            and the strings are added to the existing table.
+
+            <i>This class was added in %Qtilities v1.5.</i>
+              */
+            class QTILIITES_CORE_SHARED_EXPORT WriteScope {
+            public:
+                WriteScope(QDataStream& stream);
+                ~WriteScope();
+
+                //! The stream to which data must be written while the scope exists.
+                QDataStream& stream();
+                //! Writes the string table and the data written to stream() to the original stream.
+                void finish();
+
+            private:
+                Q_DISABLE_COPY(WriteScope)
+                QDataStream&                d_target;
+                QByteArray                  d_buffer;
+                QDataStream*                d_stream;
+                CompactBinaryStringTable*   d_table;
+            };
+
+            /*!
+            \class ReadScope
+            \brief The ReadScope class reads and activates the string table written by a WriteScope.
+
+            The string table stays active on the stream until the scope is destroyed, after which the table which was active before the scope was
+            constructed, if any, is restored.
+
+            <i>This class was added in %Qtilities v1.5.</i>
+              */
+            class QTILIITES_CORE_SHARED_EXPORT ReadScope {
+            public:
+                ReadScope(QDataStream& stream);
+                //! Activates \p strings as the string table of \p stream, used to read data of which the import was deferred.
+                ReadScope(QDataStream& stream, const QStringList& strings);
+                ~ReadScope();
+
+                //! Indicates if the string table was read successfully.
+                bool isValid() const;
+
+            private:
+                Q_DISABLE_COPY(ReadScope)
+                QDataStream&                d_stream;
+                CompactBinaryStringTable*   d_table;
+                CompactBinaryStringTable*   d_previous_table;
+                bool                        d_valid;
+            };
+
+        private:
+            static void writeLiteral(QDataStream& stream, const QString& string);
+            static QString readLiteral(QDataStream& stream);
+            static CompactBinaryStringTable* stringTable(const QDataStream& stream);
+            static void setStringTable(const QDataStream& stream, CompactBinaryStringTable* table);
+        };
+    }
+}
+
+#endif // COMPACT_BINARY_FORMAT_H
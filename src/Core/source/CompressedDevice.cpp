@@ -0,0 +1,256 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "CompressedDevice.h"
+
+#include <QByteArray>
+
+#include <string.h>
+
+namespace {
+    const char  COMPRESSED_DEVICE_SIGNATURE[] = "QTZ1";
+    const int   COMPRESSED_DEVICE_SIGNATURE_SIZE = 4;
+    //! Blocks with a larger compressed size can only be the result of corrupt data, thus they are rejected before anything is allocated.
+    const quint32 COMPRESSED_DEVICE_MAX_BLOCK = 64 * 1024 * 1024;
+
+    void writeBlockLength(char* data, quint32 length) {
+        data[0] = (char) ((length >> 24) & 0xFF);
+        data[1] = (char) ((length >> 16) & 0xFF);
+        data[2] = (char) ((length >> 8) & 0xFF);
+        data[3] = (char) (length & 0xFF);
+    }
+
+    quint32 readBlockLength(const char* data) {
+        const uchar* bytes = (const uchar*) data;
+        return ((quint32) bytes[0] << 24) | ((quint32) bytes[1] << 16) | ((quint32) bytes[2] << 8) | (quint32) bytes[3];
+    }
+}
+
+struct Qtilities::Core::CompressedDevicePrivateData {
+    CompressedDevicePrivateData() : device(0),
+        block_size(256 * 1024),
+        compression_level(-1),
+        buffer_position(0),
+        finished(false) {}
+
+    QIODevice*  device;
+    int         block_size;
+    int         compression_level;
+    //! When writing, the uncompressed data not compressed yet. When reading, the uncompressed data of the current block.
+    QByteArray  buffer;
+    int         buffer_position;
+    //! Indicates that the end of the compressed data was read.
+    bool        finished;
+};
+
+Qtilities::Core::CompressedDevice::CompressedDevice(QIODevice* device, QObject* parent) : QIODevice(parent) {
+    d = new CompressedDevicePrivateData;
+    d->device = device;
+}
+
+Qtilities::Core::CompressedDevice::~CompressedDevice() {
+    if (isOpen())
+        close();
+    delete d;
+}
+
+bool Qtilities::Core::CompressedDevice::open(OpenMode mode) {
+    if (isOpen() || !d->device)
+        return false;
+
+    OpenMode access_mode = mode & ReadWrite;
+    if (access_mode == ReadWrite || access_mode == NotOpen || (mode & (Append | Truncate | Text))) {
+        setErrorString(tr("A compressed device can only be opened for reading or for writing."));
+        return false;
+    }
+    if ((access_mode == ReadOnly && !d->device->isReadable()) || (access_mode == WriteOnly && !d->device->isWritable())) {
+        setErrorString(tr("The device wrapped by the compressed device is not open in the requested mode."));
+        return false;
+    }
+
+    d->buffer.clear();
+    d->buffer_position = 0;
+    d->finished = false;
+
+    if (access_mode == WriteOnly) {
+        if (d->device->write(COMPRESSED_DEVICE_SIGNATURE,COMPRESSED_DEVICE_SIGNATURE_SIZE) != COMPRESSED_DEVICE_SIGNATURE_SIZE) {
+            setErrorString(d->device->errorString());
+            return false;
+        }
+        d->buffer.reserve(d->block_size);
+    } else {
+        char signature[COMPRESSED_DEVICE_SIGNATURE_SIZE];
+        if (!readFromDevice(signature,COMPRESSED_DEVICE_SIGNATURE_SIZE) || memcmp(signature,COMPRESSED_DEVICE_SIGNATURE,COMPRESSED_DEVICE_SIGNATURE_SIZE) != 0) {
+            setErrorString(tr("The data is not compressed by a compressed device."));
+            return false;
+        }
+    }
+
+    return QIODevice::open(mode | Unbuffered);
+}
+
+void Qtilities::Core::CompressedDevice::close() {
+    if (!isOpen())
+        return;
+
+    if (openMode() & WriteOnly) {
+        // A zero length marks the end of the compressed data:
+        char terminator[4];
+        writeBlockLength(terminator,0);
+        if (writeBlock())
+            d->device->write(terminator,sizeof(terminator));
+    }
+
+    QIODevice::close();
+    d->buffer.clear();
+    d->buffer_position = 0;
+}
+
+bool Qtilities::Core::CompressedDevice::isSequential() const {
+    return true;
+}
+
+qint64 Qtilities::Core::CompressedDevice::bytesAvailable() const {
+    if (!(openMode() & ReadOnly))
+        return 0;
+
+    qint64 available = d->buffer.size() - d->buffer_position;
+    // Signal that more data follows when the current block is exhausted, the next block is only read when needed:
+    if (available == 0 && !d->finished)
+        available = 1;
+    return available + QIODevice::bytesAvailable();
+}
+
+void Qtilities::Core::CompressedDevice::setBlockSize(int block_size) {
+    if (!isOpen() && block_size > 0)
+        d->block_size = block_size;
+}
+
+int Qtilities::Core::CompressedDevice::blockSize() const {
+    return d->block_size;
+}
+
+void Qtilities::Core::CompressedDevice::setCompressionLevel(int compression_level) {
+    if (!isOpen() && compression_level >= -1 && compression_level <= 9)
+        d->compression_level = compression_level;
+}
+
+int Qtilities::Core::CompressedDevice::compressionLevel() const {
+    return d->compression_level;
+}
+
+bool Qtilities::Core::CompressedDevice::isCompressed(QIODevice* device) {
+    if (!device || !device->isReadable())
+        return false;
+
+    QByteArray signature = device->peek(COMPRESSED_DEVICE_SIGNATURE_SIZE);
+    return signature.size() == COMPRESSED_DEVICE_SIGNATURE_SIZE && memcmp(signature.constData(),COMPRESSED_DEVICE_SIGNATURE,COMPRESSED_DEVICE_SIGNATURE_SIZE) == 0;
+}
+
+qint64 Qtilities::Core::CompressedDevice::readData(char* data, qint64 max_size) {
+    qint64 total = 0;
+    while (total < max_size) {
+        if (d->buffer_position >= d->buffer.size()) {
+            if (d->finished)
+                break;
+            if (!readBlock())
+                return total > 0 ? total : -1;
+            continue;
+        }
+
+        qint64 count = qMin(max_size - total,(qint64) (d->buffer.size() - d->buffer_position));
+        memcpy(data + total,d->buffer.constData() + d->buffer_position,(size_t) count);
+        d->buffer_position += (int) count;
+        total += count;
+    }
+
+    if (total == 0 && d->finished)
+        return -1;
+    return total;
+}
+
+qint64 Qtilities::Core::CompressedDevice::writeData(const char* data, qint64 max_size) {
+    qint64 total = 0;
+    while (total < max_size) {
+        qint64 count = qMin(max_size - total,(qint64) (d->block_size - d->buffer.size()));
+        d->buffer.append(data + total,(int) count);
+        total += count;
+
+        if (d->buffer.size() >= d->block_size && !writeBlock())
+            return total - count > 0 ? total - count : -1;
+    }
+    return total;
+}
+
+bool Qtilities::Core::CompressedDevice::writeBlock() {
+    if (d->buffer.isEmpty())
+        return true;
+
+    QByteArray compressed = qCompress(d->buffer,d->compression_level);
+    char length[4];
+    writeBlockLength(length,(quint32) compressed.size());
+    if (d->device->write(length,sizeof(length)) != sizeof(length) || d->device->write(compressed) != compressed.size()) {
+        setErrorString(d->device->errorString());
+        return false;
+    }
+
+    d->buffer.resize(0);
+    return true;
+}
+
+bool Qtilities::Core::CompressedDevice::readBlock() {
+    char length_data[4];
+    if (!readFromDevice(length_data,sizeof(length_data))) {
+        setErrorString(tr("The compressed data ended unexpectedly."));
+        return false;
+    }
+
+    quint32 length = readBlockLength(length_data);
+    d->buffer.clear();
+    d->buffer_position = 0;
+    if (length == 0) {
+        d->finished = true;
+        return true;
+    }
+    if (length > COMPRESSED_DEVICE_MAX_BLOCK) {
+        setErrorString(tr("The compressed data is corrupt."));
+        return false;
+    }
+
+    QByteArray compressed;
+    compressed.resize((int) length);
+    if (!readFromDevice(compressed.data(),length)) {
+        setErrorString(tr("The compressed data ended unexpectedly."));
+        return false;
+    }
+
+    d->buffer = qUncompress(compressed);
+    if (d->buffer.isEmpty()) {
+        setErrorString(tr("The compressed data is corrupt."));
+        return false;
+    }
+    return true;
+}
+
+bool Qtilities::Core::CompressedDevice::readFromDevice(char* data, qint64 size) {
+    qint64 total = 0;
+    while (total < size) {
+        qint64 count = d->device->read(data + total,size - total);
+        if (count <= 0) {
+            // Sequential devices, like sockets, might only have part of the data available:
+            if (count == 0 && d->device->isSequential() && d->device->waitForReadyRead(30000))
+                continue;
+            return false;
+        }
+        total += count;
+    }
+    return true;
+}
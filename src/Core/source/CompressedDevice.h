@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef COMPRESSED_DEVICE_H
+#define COMPRESSED_DEVICE_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QIODevice>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \struct CompressedDevicePrivateData
+        \brief The CompressedDevicePrivateData struct stores private data used by the CompressedDevice class.
+          */
+        struct CompressedDevicePrivateData;
+
+        /*!
+        \class CompressedDevice
+        \brief The CompressedDevice class compresses data written to another device, and decompresses data read from it.
+
+        CompressedDevice wraps an open device and compresses the data written to it in blocks using deflate, through qCompress(). Since only a single
+        block is kept in memory, large streams like the binary export of an observer tree can be compressed while they are written, without buffering the
+        complete uncompressed data first:
+
+\code
+QFile file("project.prj");
+file.open(QIODevice::WriteOnly);
+CompressedDevice compressed(&file);
+compressed.open(QIODevice::WriteOnly);
+QDataStream stream(&compressed);
+// Write to stream..
+compressed.close();
+\endcode
+
+        The compressed data starts with a short signature, which can be checked using isCompressed() to decide if a file must be read through a
+        CompressedDevice. The device is sequential, both when writing and reading, and it can only be opened in QIODevice::ReadOnly or QIODevice::WriteOnly
+        mode. The wrapped device must already be open in the same mode, and it is not closed when the compressed device is closed. When writing, close()
+        must be called to write the last block.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT CompressedDevice : public QIODevice {
+            Q_OBJECT
+
+        public:
+            //! Constructs a compressed device which reads from and writes to \p device. The device does not take ownership of \p device.
+            CompressedDevice(QIODevice* device, QObject* parent = 0);
+            ~CompressedDevice();
+
+            //! Opens the device in QIODevice::ReadOnly or QIODevice::WriteOnly mode.
+            /*!
+              When opened for writing, the signature is written to the wrapped device. When opened for reading, the signature is read from the wrapped device
+              and the open call fails when it does not match.
+              */
+            bool open(OpenMode mode);
+            //! Closes the device. When writing, the data which is still buffered is compressed and the end of the compressed data is written.
+            void close();
+            bool isSequential() const;
+            qint64 bytesAvailable() const;
+
+            //! Sets the number of uncompressed bytes compressed in each block. Must be called before the device is opened, the default is 256KB.
+            void setBlockSize(int block_size);
+            //! Gets the number of uncompressed bytes compressed in each block.
+            int blockSize() const;
+            //! Sets the compression level passed to qCompress(), from 0 to 9. Must be called before the device is opened, the default is -1 which uses the zlib default.
+            void setCompressionLevel(int compression_level);
+            //! Gets the compression level passed to qCompress().
+            int compressionLevel() const;
+
+            //! Checks if the data at the current position of \p device starts with the signature written by a CompressedDevice.
+            /*!
+              The data is only peeked, thus the position of \p device does not change.
+              */
+            static bool isCompressed(QIODevice* device);
+
+        protected:
+            qint64 readData(char* data, qint64 max_size);
+            qint64 writeData(const char* data, qint64 max_size);
+
+        private:
+            bool writeBlock();
+            bool readBlock();
+            bool readFromDevice(char* data, qint64 size);
+
+            CompressedDevicePrivateData* d;
+        };
+    }
+}
+
+#endif // COMPRESSED_DEVICE_H
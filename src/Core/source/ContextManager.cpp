@@ -19,9 +19,17 @@
 #include <QtDebug>
 #include <QPointer>
 #include <QCoreApplication>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QSet>
 
 using namespace Qtilities::Core::Constants;
 
+namespace {
+    //! The number of 32 bit words in ContextManagerPrivateData::active_context_bits.
+    const int qti_private_ACTIVE_CONTEXT_WORDS = 16;
+}
+
 struct Qtilities::Core::ContextManagerPrivateData {
     ContextManagerPrivateData() : id_counter(-1) { }
 
@@ -29,8 +37,14 @@ struct Qtilities::Core::ContextManagerPrivateData {
     QMap<QString, int> string_id_map;
     QMap<QString, QString> string_help_id_map;
 
+    //! The active contexts in the order in which they were activated. Only used in the thread of the context manager.
     QList<int> active_contexts;
     QList<int> contexts;
+    //! The active state of the first 32 * qti_private_ACTIVE_CONTEXT_WORDS context IDs, read by isContextActive() from any thread.
+    QAtomicInt active_context_bits[qti_private_ACTIVE_CONTEXT_WORDS];
+    //! Active context IDs which do not fit into active_context_bits.
+    QSet<int> active_overflow_contexts;
+    mutable QMutex active_overflow_mutex;
 };
 
 Qtilities::Core::ContextManager::ContextManager(QObject* parent) : IContextManager(parent)
@@ -52,9 +66,9 @@ int Qtilities::Core::ContextManager::registerContext(const QString& context, con
         d->contexts.push_front(id);
         d->string_help_id_map[context] = context_help_id;
         if (context_help_id.isEmpty())
-            LOG_TRACE("Context Manager: Registering new context: " + context + " with ID " + QString::number(id) + ".");
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreLogTag,"Context Manager: Registering new context: " + context + " with ID " + QString::number(id) + ".");
         else
-            LOG_TRACE("Context Manager: Registering new context: " + context + " with ID " + QString::number(id) + " and Help ID: " + context_help_id);
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreLogTag,"Context Manager: Registering new context: " + context + " with ID " + QString::number(id) + " and Help ID: " + context_help_id);
         return id;
     } else
         return id;
@@ -68,7 +82,7 @@ bool Qtilities::Core::ContextManager::unregisterContext(int context_id, bool not
         emit aboutToUnregisterContext(context_id);
 
     // Check if its an active context:
-    if (activeContexts().contains(context_id))
+    if (isContextActive(context_id))
         removeContext(context_id,notify);
 
     // Now remove it:
@@ -117,12 +131,8 @@ bool Qtilities::Core::ContextManager::hasContext(const QString& context_string)
 }
 
 void Qtilities::Core::ContextManager::setNewContext(int context, bool notify) {
-    if (d->active_contexts.contains(context) && !notify) {
-        LOG_TRACE("Context already active, the following contexts are currently active:");
-        for (int i = 0; i < activeContexts().size(); ++i) {
-            QString debug_string = QString("- %1 - ID: %2, Name: %3").arg(i).arg(activeContexts().at(i)).arg(contextName(activeContexts().at(i)));
-            LOG_TRACE(debug_string);
-        }
+    if (!notify && isContextActive(context)) {
+        logActiveContexts("Context already active, the following contexts are currently active:");
         return;
     }
 
@@ -130,66 +140,50 @@ void Qtilities::Core::ContextManager::setNewContext(int context, bool notify) {
         emit aboutToSetNewContext(context);
 
     // Clear contexts, and add standard.
+    for (int i = 0; i < d->active_contexts.count(); ++i)
+        setContextActiveState(d->active_contexts.at(i),false);
     d->active_contexts.clear();
-    if (context != 0)
+    if (context != 0) {
         d->active_contexts.append(0);
+        setContextActiveState(0,true);
+    }
 
     // If a valid context is not sent, we just set the context to the standard context.
     if (d->contexts.contains(context)) {
         d->active_contexts.append(context);
-        LOG_TRACE("Context set to new, the following contexts are currently active:");
-        for (int i = 0; i < activeContexts().size(); ++i) {
-            QString debug_string = QString("- %1 - ID: %2, Name: %3").arg(i).arg(activeContexts().at(i)).arg(contextName(activeContexts().at(i)));
-            LOG_TRACE(debug_string);
-        }
+        setContextActiveState(context,true);
+        logActiveContexts("Context set to new, the following contexts are currently active:");
     } else
-        LOG_WARNING(tr("Attempting to set new unregistered context in function setNewContext with ID: ") + context);
+        LOG_WARNING(tr("Attempting to set new unregistered context in function setNewContext with ID: ") + QString::number(context));
 
     if (notify) {
         emit finishedSetNewContext(context);
         emit contextChanged(activeContexts());
     }
-
-//    qDebug() << "setNewContext";
-//    foreach (int id, activeContexts())
-//        qDebug() << id << contextName(id);
 }
 
 void Qtilities::Core::ContextManager::appendContext(int context, bool notify) {
     if (d->contexts.contains(context)) {
-        if (d->active_contexts.contains(context)) {
-            LOG_TRACE("Context already active, the following contexts are currently active:");
-            for (int i = 0; i < activeContexts().size(); ++i) {
-                QString debug_string = QString("- %1 - ID: %2, Name: %3").arg(i).arg(activeContexts().at(i)).arg(contextName(activeContexts().at(i)));
-                LOG_TRACE(debug_string);
-            }
+        if (isContextActive(context)) {
+            logActiveContexts("Context already active, the following contexts are currently active:");
             return;
         }
 
         if (notify)
             emit aboutToAppendContext(context);
         d->active_contexts.append(context);
+        setContextActiveState(context,true);
 
         if (notify)
             emit contextChanged(activeContexts());
 
-        #ifndef QT_NO_DEBUG
-        LOG_TRACE("Context appended, the following contexts are currently active:");
-        for (int i = 0; i < activeContexts().size(); ++i) {
-            QString debug_string = QString("%1 - ID: %2, Name: %3").arg(i).arg(activeContexts().at(i)).arg(contextName(activeContexts().at(i)));
-            LOG_TRACE(debug_string);
-        }
-        #endif
+        logActiveContexts("Context appended, the following contexts are currently active:");
 
         if (notify)
             emit finishedAppendContext(context);
     } else {
-        LOG_ERROR(tr("Attempting to append unregistered context in function appendContext with ID: ") + context);
+        LOG_ERROR(tr("Attempting to append unregistered context in function appendContext with ID: ") + QString::number(context));
     }
-
-//    qDebug() << "appendContext";
-//    foreach (int id, activeContexts())
-//        qDebug() << id << contextName(id);
 }
 
 void Qtilities::Core::ContextManager::removeContext(int context, bool notify) {
@@ -197,39 +191,37 @@ void Qtilities::Core::ContextManager::removeContext(int context, bool notify) {
     if (context == contextID(qti_def_CONTEXT_STANDARD))
         return;
 
-    for (int i = 0; i < d->active_contexts.count(); ++i) {
-        if (d->active_contexts.at(i) == context) {
-            emit aboutToRemoveContext(context);
-            d->active_contexts.removeAt(i);
-
-            #ifndef QT_NO_DEBUG
-            LOG_TRACE("Context removed, the following contexts are currently active:");
-            for (int i = 0; i < activeContexts().size(); ++i) {
-                QString debug_string = QString("- %1 - ID: %2, Name: %3").arg(i).arg(activeContexts().at(i)).arg(contextName(activeContexts().at(i)));
-                LOG_TRACE(debug_string);
-            }
-            #endif
-
-            if (notify) {
-                emit finishedRemoveContext(context);
-                emit contextChanged(activeContexts());
-            }
-        }
+    if (!isContextActive(context))
+        return;
+
+    int index = d->active_contexts.indexOf(context);
+    if (index == -1)
+        return;
+
+    emit aboutToRemoveContext(context);
+    d->active_contexts.removeAt(index);
+    setContextActiveState(context,false);
+
+    logActiveContexts("Context removed, the following contexts are currently active:");
+
+    if (notify) {
+        emit finishedRemoveContext(context);
+        emit contextChanged(activeContexts());
     }
 }
 
 void Qtilities::Core::ContextManager::setNewContext(const QString& context_string, bool notify) {
-    LOG_TRACE("Clearing all contexts. New active context: " + context_string);
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreLogTag,"Clearing all contexts. New active context: " + context_string);
     setNewContext(contextID(context_string),notify);
 }
 
 void Qtilities::Core::ContextManager::appendContext(const QString& context_string, bool notify) {
-    LOG_DEBUG("Appending context: " + context_string);
+    LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreLogTag,"Appending context: " + context_string);
     appendContext(contextID(context_string),notify);
 }
 
 void Qtilities::Core::ContextManager::removeContext(const QString& context_string, bool notify) {
-    LOG_DEBUG("Removing context: " + context_string);
+    LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreLogTag,"Removing context: " + context_string);
     removeContext(contextID(context_string),notify);
 }
 
@@ -237,6 +229,69 @@ QList<int> Qtilities::Core::ContextManager::activeContexts() const {
     return d->active_contexts;
 }
 
+bool Qtilities::Core::ContextManager::isContextActive(int context_id) const {
+    if (context_id < 0)
+        return false;
+
+    if (context_id < 32 * qti_private_ACTIVE_CONTEXT_WORDS) {
+        #if QT_VERSION >= 0x050000
+        int word = d->active_context_bits[context_id / 32].loadAcquire();
+        #else
+        int word = d->active_context_bits[context_id / 32];
+        #endif
+        return word & (1 << (context_id % 32));
+    }
+
+    QMutexLocker locker(&d->active_overflow_mutex);
+    return d->active_overflow_contexts.contains(context_id);
+}
+
+void Qtilities::Core::ContextManager::setContextActiveState(int context_id, bool active) {
+    if (context_id < 0)
+        return;
+
+    if (context_id < 32 * qti_private_ACTIVE_CONTEXT_WORDS) {
+        // Only the thread of the context manager changes the bits, thus a plain store is enough:
+        QAtomicInt& bits = d->active_context_bits[context_id / 32];
+        #if QT_VERSION >= 0x050000
+        int word = bits.loadAcquire();
+        #else
+        int word = bits;
+        #endif
+        if (active)
+            word |= (1 << (context_id % 32));
+        else
+            word &= ~(1 << (context_id % 32));
+        #if QT_VERSION >= 0x050000
+        bits.storeRelease(word);
+        #else
+        bits.fetchAndStoreOrdered(word);
+        #endif
+        return;
+    }
+
+    QMutexLocker locker(&d->active_overflow_mutex);
+    if (active)
+        d->active_overflow_contexts.insert(context_id);
+    else
+        d->active_overflow_contexts.remove(context_id);
+}
+
+void Qtilities::Core::ContextManager::logActiveContexts(const char* heading) const {
+    #ifndef QT_NO_DEBUG
+    if (!LOG_IS_LOGGED(Qtilities::Logging::Logger::Trace,Qtilities::Logging::Logger::SystemWideMessages))
+        return;
+
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreLogTag,QLatin1String(heading));
+    for (int i = 0; i < d->active_contexts.count(); ++i) {
+        QString debug_string = QString("- %1 - ID: %2, Name: %3").arg(i).arg(d->active_contexts.at(i)).arg(contextName(d->active_contexts.at(i)));
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreLogTag,debug_string);
+    }
+    #else
+    Q_UNUSED(heading)
+    #endif
+}
+
 int Qtilities::Core::ContextManager::contextID(const QString& context_string) {
     if (context_string.isEmpty())
         return -1;
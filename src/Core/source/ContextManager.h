@@ -57,6 +57,7 @@ namespace Qtilities {
             bool hasContext(int context) const;
             bool hasContext(const QString& context_string) const;
             QList<int> activeContexts() const;
+            bool isContextActive(int context_id) const;
             int contextID(const QString& context_string);
             QString contextString(int context_id) const;
             QString contextHelpID(int context_id) const;
@@ -74,6 +75,10 @@ namespace Qtilities {
 
         private:
             QString contextName(int id) const;
+            //! Updates the state of \p context_id read by isContextActive(). Does not change d->active_contexts.
+            void setContextActiveState(int context_id, bool active);
+            //! Logs the active contexts as trace messages. Nothing is formatted when trace messages are not logged.
+            void logActiveContexts(const char* heading) const;
             ContextManagerPrivateData* d;
         };
     }
@@ -0,0 +1,266 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ExportTask.h"
+#include "CborStream.h"
+#include "Observer.h"
+#include "QtilitiesCoreApplication.h"
+
+#include <QAtomicInt>
+#include <QDataStream>
+#include <QIODevice>
+#include <QThread>
+#include <QXmlStreamWriter>
+
+namespace Qtilities {
+    namespace Core {
+        //! The worker thread of an ExportTask. Exports which run in it find their task through QThread::currentThread().
+        class ExportTaskThread : public QThread
+        {
+        public:
+            ExportTaskThread(ExportTask* task) : QThread(), task(task), depth(0), result(IExportable::Failed) {}
+
+            void run() {
+                depth = 0;
+                result = task->runExport();
+            }
+
+            static ExportTaskThread* current() {
+                return dynamic_cast<ExportTaskThread*> (QThread::currentThread());
+            }
+
+            ExportTask*                     task;
+            //! Only used in the worker thread.
+            int                             depth;
+            IExportable::ExportResultFlags  result;
+        };
+    }
+}
+
+struct Qtilities::Core::ExportTaskPrivateData {
+    ExportTaskPrivateData() : exportable(0),
+        device(0),
+        export_mode(IExportable::Binary),
+        stream_version(QDataStream::Qt_4_7),
+        xml_element_name("QtilitiesXMLExport"),
+        thread(0),
+        cancel_requested(0),
+        busy(false),
+        export_result(IExportable::Failed) {}
+
+    IExportable*                    exportable;
+    QIODevice*                      device;
+    IExportable::ExportMode         export_mode;
+    int                             stream_version;
+    QString                         xml_element_name;
+    ExportTaskThread*               thread;
+    //! Set from the GUI thread and read in the worker thread.
+    QAtomicInt                      cancel_requested;
+    bool                            busy;
+    IExportable::ExportResultFlags  export_result;
+};
+
+Qtilities::Core::ExportTask::ExportTask(const QString& task_name, IExportable* exportable, QIODevice* device, IExportable::ExportMode export_mode, QObject* parent) : Task(task_name,true,parent) {
+    d = new ExportTaskPrivateData;
+    d->exportable = exportable;
+    d->device = device;
+    d->export_mode = export_mode;
+    d->thread = new ExportTaskThread(this);
+    connect(d->thread,SIGNAL(finished()),SLOT(handleExportFinished()));
+    connect(this,SIGNAL(stopTaskRequest()),SLOT(handleStopRequest()));
+}
+
+Qtilities::Core::ExportTask::~ExportTask() {
+    if (d->thread->isRunning()) {
+        d->cancel_requested.fetchAndStoreOrdered(1);
+        d->thread->wait();
+    }
+    delete d->thread;
+    delete d;
+}
+
+Qtilities::Core::Interfaces::IExportable* Qtilities::Core::ExportTask::exportable() const {
+    return d->exportable;
+}
+
+QIODevice* Qtilities::Core::ExportTask::device() const {
+    return d->device;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportMode Qtilities::Core::ExportTask::exportMode() const {
+    return d->export_mode;
+}
+
+void Qtilities::Core::ExportTask::setStreamVersion(int version) {
+    d->stream_version = version;
+}
+
+int Qtilities::Core::ExportTask::streamVersion() const {
+    return d->stream_version;
+}
+
+void Qtilities::Core::ExportTask::setXmlElementName(const QString& element_name) {
+    d->xml_element_name = element_name;
+}
+
+QString Qtilities::Core::ExportTask::xmlElementName() const {
+    return d->xml_element_name;
+}
+
+bool Qtilities::Core::ExportTask::startExport(int expected_subtasks) {
+    if (d->busy || !d->exportable || !d->device || !d->device->isWritable())
+        return false;
+    if (d->export_mode != IExportable::Binary && d->export_mode != IExportable::XML && d->export_mode != IExportable::Cbor)
+        return false;
+
+    if (expected_subtasks == -1) {
+        Observer* obs = qobject_cast<Observer*> (d->exportable->objectBase());
+        if (obs)
+            expected_subtasks = obs->subjectCount();
+    }
+
+    // Tasks can only be used in their own thread, thus the exported object must not log to a task during the export:
+    d->exportable->clearExportTask();
+    d->cancel_requested.fetchAndStoreOrdered(0);
+    d->export_result = IExportable::Failed;
+    d->busy = true;
+
+    setCanStop(true);
+    startTask(expected_subtasks,tr("Starting export..."));
+    d->thread->start();
+    return true;
+}
+
+bool Qtilities::Core::ExportTask::isExportBusy() const {
+    return d->busy;
+}
+
+bool Qtilities::Core::ExportTask::waitForExport(unsigned long msecs) {
+    if (!d->busy)
+        return true;
+    if (!d->thread->wait(msecs))
+        return false;
+
+    // The queued finished() notification is delivered later, the task is completed here already:
+    handleExportFinished();
+    return true;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ExportTask::exportResult() const {
+    return d->export_result;
+}
+
+Qtilities::Core::ExportTask* Qtilities::Core::ExportTask::exportInBackground(IExportable* exportable, QIODevice* device, IExportable::ExportMode export_mode, const QString& task_name) {
+    ExportTask* task = new ExportTask(task_name,exportable,device,export_mode);
+    task->setTaskType(ITask::TaskGlobal);
+    task->setTaskLifeTimeFlags(Task::LifeTimeDestroyWhenCompleted);
+    task->setObjectName(task_name);
+    OBJECT_MANAGER->registerObject(task,QtilitiesCategory("Tasks"));
+
+    if (!task->startExport()) {
+        task->deleteLater();
+        return 0;
+    }
+    return task;
+}
+
+bool Qtilities::Core::ExportTask::isExportCancelled() {
+    ExportTaskThread* thread = ExportTaskThread::current();
+    if (!thread)
+        return false;
+    return thread->task->d->cancel_requested.fetchAndAddOrdered(0) != 0;
+}
+
+int Qtilities::Core::ExportTask::beginObserverExport() {
+    ExportTaskThread* thread = ExportTaskThread::current();
+    if (!thread)
+        return 0;
+    return ++thread->depth;
+}
+
+void Qtilities::Core::ExportTask::endObserverExport() {
+    ExportTaskThread* thread = ExportTaskThread::current();
+    if (thread && thread->depth > 0)
+        --thread->depth;
+}
+
+void Qtilities::Core::ExportTask::reportSubtreeExported(const QString& subject_name) {
+    ExportTaskThread* thread = ExportTaskThread::current();
+    if (!thread)
+        return;
+    QMetaObject::invokeMethod(thread->task,"handleSubtreeExported",Qt::QueuedConnection,Q_ARG(QString,subject_name));
+}
+
+void Qtilities::Core::ExportTask::handleStopRequest() {
+    if (d->busy) {
+        d->cancel_requested.fetchAndStoreOrdered(1);
+        logMessage(tr("Stopping export after the current subtree..."));
+    }
+}
+
+void Qtilities::Core::ExportTask::handleSubtreeExported(const QString& subject_name) {
+    // Notifications can still be queued after waitForExport() completed the task:
+    if (!d->busy)
+        return;
+    addCompletedSubTasks(1,tr("Exported ") + subject_name,Logger::Trace);
+}
+
+void Qtilities::Core::ExportTask::handleExportFinished() {
+    if (!d->busy)
+        return;
+
+    d->busy = false;
+    d->export_result = d->thread->result;
+    setCanStop(false);
+
+    if (d->cancel_requested.fetchAndAddOrdered(0) != 0) {
+        d->export_result = IExportable::Failed;
+        stopTask(tr("Export stopped."),Logger::Warning);
+    } else if (d->export_result == IExportable::Complete)
+        completeTask(ITask::TaskSuccessful,tr("Export completed successfully."));
+    else if (d->export_result == IExportable::Incomplete)
+        completeTask(ITask::TaskSuccessfulWithWarnings,tr("Export completed, however it is incomplete."),Logger::Warning);
+    else
+        completeTask(ITask::TaskFailed,tr("Export failed."),Logger::Error);
+
+    emit exportFinished(d->export_result);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ExportTask::runExport() {
+    IExportable::ExportResultFlags result;
+    if (d->export_mode == IExportable::Binary) {
+        QDataStream stream(d->device);
+        stream.setVersion(d->stream_version);
+        result = d->exportable->exportBinary(stream);
+        if (stream.status() != QDataStream::Ok)
+            result = IExportable::Failed;
+    } else if (d->export_mode == IExportable::Cbor) {
+        CborStreamWriter writer(d->device);
+        writer.writeTag(CborStreamWriter::SelfDescribeTag);
+        result = d->exportable->exportCbor(&writer);
+        if (writer.hasError())
+            result = IExportable::Failed;
+    } else {
+        QXmlStreamWriter writer(d->device);
+        writer.setAutoFormatting(true);
+        writer.writeStartDocument();
+        writer.writeStartElement(d->xml_element_name);
+        result = d->exportable->exportXmlStream(&writer);
+        writer.writeEndElement();
+        writer.writeEndDocument();
+        if (writer.hasError())
+            result = IExportable::Failed;
+    }
+
+    if (isExportCancelled())
+        return IExportable::Failed;
+    return result;
+}
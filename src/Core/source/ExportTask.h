@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef EXPORT_TASK_H
+#define EXPORT_TASK_H
+
+#include "QtilitiesCore_global.h"
+#include "Task.h"
+#include "IExportable.h"
+
+#include <limits.h>
+
+class QIODevice;
+
+namespace Qtilities {
+    namespace Core {
+        using namespace Qtilities::Core::Interfaces;
+
+        /*!
+        \struct ExportTaskPrivateData
+        \brief Structure used by ExportTask to store private data.
+          */
+        struct ExportTaskPrivateData;
+
+        /*!
+        \class ExportTask
+        \brief The ExportTask class exports an IExportable to a device on a worker thread.
+
+        Exports of large observer trees can take a long time, and when they are done on the GUI thread the application does not respond during the export.
+        ExportTask runs the export on a worker thread instead, while the task reports its progress. When the task is registered in the object manager, for
+        example using exportInBackground(), its progress is shown in Qtilities::CoreGui::TaskSummaryWidget:
+
+\code
+QFile* file = new QFile("tree.bin");
+file->open(QIODevice::WriteOnly);
+ExportTask* task = ExportTask::exportInBackground(observer,file,IExportable::Binary,"Exporting Tree");
+connect(task,SIGNAL(exportFinished(Qtilities::Core::Interfaces::IExportable::ExportResultFlags)),SLOT(handleExportFinished()));
+\endcode
+
+        When the exported object is a Qtilities::Core::Observer, a sub task is completed every time one of its subjects (and the subtree under it) was
+        exported. The task can be stopped, in which case the export stops after the subtree being exported and the result of the export is
+        IExportable::Failed. What happens to the task itself after it was stopped is determined by its ITask::TaskStopAction.
+
+        The export runs against the live objects, not against a copy of them. Thus the exported objects must not be changed or deleted while the task is
+        busy, and they must support being exported from a thread other than the one they live in, the same as for Qtilities::Core::ObserverData::ExportParallel.
+        Messages logged during the export are not logged to the task, since tasks can only be used on the thread they live in.
+
+        Imports are not supported since the objects constructed during an import must be created on the thread they will live in.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT ExportTask : public Task
+        {
+            Q_OBJECT
+
+        public:
+            //! Constructs an export task which exports \p exportable to \p device, which must be open for writing.
+            /*!
+              The task does not take ownership of \p exportable or \p device, and both must exist until the export finished.
+              */
+            ExportTask(const QString& task_name, IExportable* exportable, QIODevice* device, IExportable::ExportMode export_mode = IExportable::Binary, QObject* parent = 0);
+            //! Destructor. When the export is still busy, it is stopped and the destructor waits until the worker thread finished.
+            ~ExportTask();
+
+            //! The object which is exported.
+            IExportable* exportable() const;
+            //! The device to which the object is exported.
+            QIODevice* device() const;
+            //! The export mode used, IExportable::Binary, IExportable::XML or IExportable::Cbor.
+            /*!
+              CBOR exports start with the CBOR self describe tag, followed by the item written by IExportable::exportCbor().
+              */
+            IExportable::ExportMode exportMode() const;
+
+            //! Sets the QDataStream version used for binary exports. Default is QDataStream::Qt_4_7.
+            void setStreamVersion(int version);
+            //! Gets the QDataStream version used for binary exports.
+            int streamVersion() const;
+            //! Sets the name of the root element written around the object during XML exports. Default is "QtilitiesXMLExport".
+            void setXmlElementName(const QString& element_name);
+            //! Gets the name of the root element written around the object during XML exports.
+            QString xmlElementName() const;
+
+            //! Starts the export on a worker thread.
+            /*!
+              \param expected_subtasks The number of sub tasks expected. When -1, the number of subjects of the exported object is used when it is an observer.
+              \returns True when the export was started, false when it is already busy.
+              */
+            bool startExport(int expected_subtasks = -1);
+            //! Indicates if the export is busy.
+            bool isExportBusy() const;
+            //! Blocks until the export finished, or until \p msecs milliseconds passed.
+            /*!
+              When the export finished, the task is completed before this function returns.
+
+              \returns True when the export finished, false when it timed out.
+              */
+            bool waitForExport(unsigned long msecs = ULONG_MAX);
+            //! The result of the last export. IExportable::Failed when the export was stopped.
+            IExportable::ExportResultFlags exportResult() const;
+
+            //! Creates, registers and starts an export task.
+            /*!
+              The task is a ITask::TaskGlobal task which is registered in the object manager, thus it is shown in Qtilities::CoreGui::TaskSummaryWidget. The task
+              is deleted when it completed. Use exportFinished() to get the result.
+              */
+            static ExportTask* exportInBackground(IExportable* exportable, QIODevice* device, IExportable::ExportMode export_mode, const QString& task_name);
+
+            // --------------------------------
+            // Used by exports which run in an ExportTask
+            // --------------------------------
+            //! Indicates if the export running in the current thread was stopped. Always false when the current thread is not the worker thread of an export task.
+            static bool isExportCancelled();
+            //! Called when an observer export starts in the current thread.
+            /*!
+              \returns The depth of the observer export, where 1 is the outermost observer. 0 when the current thread is not the worker thread of an export task.
+              */
+            static int beginObserverExport();
+            //! Called when an observer export started using beginObserverExport() ends.
+            static void endObserverExport();
+            //! Reports that a subtree of the outermost observer was exported, which completes a sub task of the export task of the current thread.
+            static void reportSubtreeExported(const QString& subject_name);
+
+        signals:
+            //! Emitted when the export finished, after the task was completed or stopped.
+            void exportFinished(Qtilities::Core::Interfaces::IExportable::ExportResultFlags result);
+
+        private slots:
+            void handleStopRequest();
+            void handleSubtreeExported(const QString& subject_name);
+            void handleExportFinished();
+
+        private:
+            friend class ExportTaskThread;
+            //! Runs the export, called in the worker thread.
+            IExportable::ExportResultFlags runExport();
+
+            ExportTaskPrivateData* d;
+        };
+    }
+}
+
+#endif // EXPORT_TASK_H
@@ -17,6 +17,7 @@
 #include <QString>
 #include <QStringList>
 #include <QMap>
+#include <QVector>
 
 namespace Qtilities {
     namespace Core {
@@ -36,6 +37,17 @@ namespace Qtilities {
               FactoryInterface() {}
               virtual ~FactoryInterface() {}
               virtual BaseClass *createInstance() = 0;
+              //! Creates \p count instances. The default implementation calls createInstance() \p count times.
+              /*!
+                <i>This function was added in %Qtilities v1.5.</i>
+                */
+              virtual QList<BaseClass*> createInstances(int count) {
+                  QList<BaseClass*> instances;
+                  instances.reserve(qMax(0,count));
+                  for (int i = 0; i < count; ++i)
+                      instances << createInstance();
+                  return instances;
+              }
            };
 
         //! Factory item class which is used inside classes which can register themselves as items in factories.
@@ -127,6 +139,8 @@ namespace Qtilities {
                       if (!reg_ifaces.contains(iface_data.tag)) {
                           reg_ifaces[iface_data.tag] = factory_interface;
                           data_ifaces[iface_data.tag] = iface_data;
+                          tag_ids[iface_data.tag] = id_ifaces.count();
+                          id_ifaces << factory_interface;
                           return true;
                       } else
                           return false;
@@ -139,6 +153,12 @@ namespace Qtilities {
               inline void unregisterFactoryInterface(const QString& tag) {
                   reg_ifaces.remove(tag);
                   data_ifaces.remove(tag);
+                  // IDs are not reused, thus IDs resolved before remain invalid even when the tag is registered again:
+                  int tag_id = tag_ids.value(tag,-1);
+                  if (tag_id != -1) {
+                      id_ifaces[tag_id] = 0;
+                      tag_ids.remove(tag);
+                  }
               }
               //! Returns a list of registered tags for a given context. By default all contexts are returned.
               /*!
@@ -148,21 +168,19 @@ namespace Qtilities {
                 */
               QStringList tags(const QtilitiesCategory& category_filter = QtilitiesCategory()) const {
                     QStringList tags;
-                    for (int i = 0; i < data_ifaces.count(); i++) {
-                        if (category_filter.isValid()) {
-                            if (data_ifaces.values().at(i).category == category_filter)
-                                tags << data_ifaces.values().at(i).tag;
-                        } else
-                            tags << data_ifaces.values().at(i).tag;
+                    typename QMap<QString,FactoryItemID>::const_iterator itr;
+                    for (itr = data_ifaces.constBegin(); itr != data_ifaces.constEnd(); ++itr) {
+                        if (!category_filter.isValid() || itr.value().category == category_filter)
+                            tags << itr.value().tag;
                     }
                     return tags;
               }             
               //! Returns a tag-category map of registered tags.
               QMap<QString, QtilitiesCategory> tagCategoryMap() const {
                     QMap<QString, QtilitiesCategory> tag_category_map;
-                    for (int i = 0; i < data_ifaces.count(); i++) {
-                        tag_category_map[data_ifaces.values().at(i).tag] = data_ifaces.values().at(i).category;
-                    }
+                    typename QMap<QString,FactoryItemID>::const_iterator itr;
+                    for (itr = data_ifaces.constBegin(); itr != data_ifaces.constEnd(); ++itr)
+                        tag_category_map[itr.value().tag] = itr.value().category;
                     return tag_category_map;
               }
               //! Function which verifies the validity of a new tag. If the tag is already present, false is returned.
@@ -182,17 +200,62 @@ namespace Qtilities {
               }
               //! Creates an instance of the factory interface implementation registered with the specified tag. If an invalid tag is specified, null will be returned.
               BaseClass* createInstance(const QString& tag) {
-                  for (int i = 0; i < data_ifaces.count(); i++) {
-                      if (tag == data_ifaces.values().at(i).tag)
-                          return reg_ifaces.values().at(i)->createInstance();
-                  }
-                  Q_ASSERT(!isTagValid(tag));
+                  FactoryInterface<BaseClass>* factory_interface = reg_ifaces.value(tag);
+                  if (factory_interface)
+                      return factory_interface->createInstance();
                   return 0;
               }
+              //! Resolves \p tag to an ID which can be used to create instances without looking up the tag every time.
+              /*!
+                Use this when creating many instances of the same tags, for example during imports:
+
+\code
+int tree_item_id = factory.tagID("Tree Item");
+for (int i = 0; i < item_count; ++i)
+    items << factory.createInstance(tree_item_id);
+\endcode
+
+                An ID remains valid until its tag is unregistered, IDs are never reused.
+
+                \returns The ID of the tag, or -1 when \p tag is not registered.
+
+                <i>This function was added in %Qtilities v1.5.</i>
+                */
+              inline int tagID(const QString& tag) const {
+                  return tag_ids.value(tag,-1);
+              }
+              //! Creates an instance of the factory interface implementation registered with the tag resolved to \p tag_id using tagID(). If an invalid ID is specified, null will be returned.
+              /*!
+                <i>This function was added in %Qtilities v1.5.</i>
+                */
+              inline BaseClass* createInstance(int tag_id) {
+                  if (tag_id < 0 || tag_id >= id_ifaces.count() || !id_ifaces.at(tag_id))
+                      return 0;
+                  return id_ifaces.at(tag_id)->createInstance();
+              }
+              //! Creates \p count instances of the factory interface implementation registered with the specified tag. If an invalid tag is specified, an empty list will be returned.
+              /*!
+                <i>This function was added in %Qtilities v1.5.</i>
+                */
+              QList<BaseClass*> createInstances(const QString& tag, int count) {
+                  return createInstances(tagID(tag),count);
+              }
+              //! Creates \p count instances of the factory interface implementation registered with the tag resolved to \p tag_id using tagID(). If an invalid ID is specified, an empty list will be returned.
+              /*!
+                <i>This function was added in %Qtilities v1.5.</i>
+                */
+              QList<BaseClass*> createInstances(int tag_id, int count) {
+                  if (tag_id < 0 || tag_id >= id_ifaces.count() || !id_ifaces.at(tag_id) || count <= 0)
+                      return QList<BaseClass*>();
+                  return id_ifaces.at(tag_id)->createInstances(count);
+              }
 
            private:
               QMap<QString,FactoryInterface<BaseClass>* > reg_ifaces;
               QMap<QString,FactoryItemID> data_ifaces;
+              QMap<QString,int> tag_ids;
+              //! The interfaces indexed by their tag IDs, unregistered interfaces are null.
+              QVector<FactoryInterface<BaseClass>* > id_ifaces;
            };
     }
 }
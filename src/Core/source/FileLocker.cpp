@@ -12,25 +12,120 @@
 #include "QtilitiesCoreConstants.h"
 
 #include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QVector>
 
 using namespace Qtilities::Core;
 
+namespace {
+    //! The time in milliseconds for which lock information is reused without checking the lock file.
+    const int qti_private_LOCK_INFO_CACHE_TIMEOUT = 2000;
+    //! The maximum number of files queried at the same time by FileLocker::lockInfoForFiles(). Queries wait on the file system, not the CPU.
+    const int qti_private_MAX_PARALLEL_LOCK_QUERIES = 16;
+    //! The number of cached lock information entries after which the cache is cleared.
+    const int qti_private_MAX_CACHED_LOCK_INFOS = 1024;
+
+    struct qti_private_LockInfoCacheEntry {
+        FileLocker::LockInfo    info;
+        qint64                  cached_at;
+    };
+
+    QMutex                                          qti_private_lock_info_cache_mutex;
+    QHash<QString,qti_private_LockInfoCacheEntry>   qti_private_lock_info_cache;
+
+    QString qti_private_LockFilePath(const QFileInfo& fi, const QString& lock_extension) {
+        QString lock_file_path = fi.path();
+        lock_file_path.append(QDir::separator());
+        lock_file_path.append(fi.baseName());
+        lock_file_path.append("." + lock_extension);
+        return lock_file_path;
+    }
+
+    QString qti_private_LockInfoCacheKey(const QString& file_path, const QString& lock_extension) {
+        return lock_extension + QLatin1Char('|') + file_path;
+    }
+
+    //! Reads the lock information of a file. The lock file is only parsed when it changed since \p previous was read.
+    FileLocker::LockInfo qti_private_ReadLockInfo(const QString& file_path, const QString& lock_extension, const FileLocker::LockInfo* previous) {
+        FileLocker::LockInfo info;
+        info.file_path = file_path;
+
+        QFileInfo fi(file_path);
+        if (!fi.exists())
+            return info;
+
+        QFileInfo lock_fi(qti_private_LockFilePath(fi,lock_extension));
+        if (!lock_fi.exists())
+            return info;
+
+        info.is_locked = true;
+        info.lock_file_path = lock_fi.filePath();
+        info.lock_file_modified = lock_fi.lastModified();
+        if (previous && previous->is_locked && previous->lock_file_path == info.lock_file_path
+                && previous->lock_file_modified == info.lock_file_modified && previous->error_message.isEmpty())
+            return *previous;
+
+        QFile lock_file(info.lock_file_path);
+        if (!lock_file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            info.error_message = QString("Cannot open lock file for reading at: " + info.lock_file_path);
+            return info;
+        }
+
+        // The lock file contains the application, host name and date time on separate lines, see FileLocker::lockFile():
+        QStringList lines = QString::fromUtf8(lock_file.readAll()).split("\n");
+        if (lines.count() > 0) {
+            info.application_name = lines.at(0).trimmed();
+            if (info.application_name.startsWith("Lock file created by "))
+                info.application_name.remove(0,21);
+        }
+        if (lines.count() > 1)
+            info.host_name = lines.at(1).trimmed();
+        if (lines.count() > 2)
+            info.date_time = lines.at(2).trimmed();
+        return info;
+    }
+
+    //! Reads the lock information of a single file for FileLocker::lockInfoForFiles().
+    class qti_private_LockInfoWorker : public QRunnable {
+    public:
+        qti_private_LockInfoWorker(const QString& file_path, const QString& lock_extension, const FileLocker::LockInfo* previous) :
+            file_path(file_path), lock_extension(lock_extension), has_previous(previous != 0) {
+            if (previous)
+                this->previous = *previous;
+            setAutoDelete(false);
+        }
+
+        void run() {
+            info = qti_private_ReadLockInfo(file_path,lock_extension,has_previous ? &previous : 0);
+        }
+
+        QString                 file_path;
+        QString                 lock_extension;
+        bool                    has_previous;
+        FileLocker::LockInfo    previous;
+        FileLocker::LockInfo    info;
+    };
+}
+
 
 FileLocker::FileLocker(const QString &lock_extension) {
     d_lock_extension = lock_extension;
 }
 
 bool FileLocker::isFileLocked(const QString &file_path) const {
-    QFileInfo fi(file_path);
-    if (!fi.exists())
-        return false;
-
-    // Check if a lock file exists:
-    QFileInfo lock_fi(lockFilePathForFile(file_path));
-    return lock_fi.exists();
+    return lockInfo(file_path).is_locked;
 }
 
 bool FileLocker::lockFile(const QString &file_path, QString *errorMsg) {
+    // Other hosts might have changed the lock since it was cached:
+    invalidateLockInfo(file_path);
     if (isFileLocked(file_path)) {
         if (errorMsg)
             *errorMsg = QString("Cannot lock file that is already locked: " + file_path);
@@ -39,6 +134,7 @@ bool FileLocker::lockFile(const QString &file_path, QString *errorMsg) {
 
     QString lock_file_path = lockFilePathForFile(file_path);
     QFile lock_file(lock_file_path);
+    invalidateLockInfo(file_path);
     if(!lock_file.open(QFile::WriteOnly | QIODevice::Text)) {
         if (errorMsg)
             *errorMsg = QString("Cannot open lock file for writing at: " + file_path);
@@ -80,6 +176,7 @@ bool FileLocker::lockFile(const QString &file_path, QString *errorMsg) {
 }
 
 bool FileLocker::unlockFile(const QString &file_path, QString *errorMsg) {
+    invalidateLockInfo(file_path);
     if (!isFileLocked(file_path)) {
         if (errorMsg)
             *errorMsg = QString("Cannot unlock file that is not locked: " + file_path);
@@ -89,6 +186,7 @@ bool FileLocker::unlockFile(const QString &file_path, QString *errorMsg) {
     // Check if a lock file exists:
     QString lock_file_pat = lockFilePathForFile(file_path);
     QFile lock_file(lock_file_pat);
+    invalidateLockInfo(file_path);
     if (lock_file.remove())
         return true;
     else {
@@ -99,89 +197,120 @@ bool FileLocker::unlockFile(const QString &file_path, QString *errorMsg) {
 }
 
 QString FileLocker::lastLockHostName(QString file_path, QString *errorMsg) const {
-    if (!isFileLocked(file_path)) {
+    LockInfo info = lockInfo(file_path);
+    if (!info.is_locked) {
         if (errorMsg)
             *errorMsg = QString("Cannot unlock file that is not locked: " + file_path);
         return QString();
     }
+    if (!info.error_message.isEmpty() && errorMsg)
+        *errorMsg = info.error_message;
 
-    file_path = lockFilePathForFile(file_path);
+    return info.host_name;
+}
 
-    QFile lock_file(file_path);
-    if (!lock_file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+QString FileLocker::lastLockDateTime(QString file_path, QString *errorMsg) const {
+    LockInfo info = lockInfo(file_path);
+    if (!info.is_locked) {
         if (errorMsg)
-            *errorMsg = QString("Cannot open lock file for reading at: " + file_path);
+            *errorMsg = QString("Cannot unlock file that is not locked: " + file_path);
         return QString();
     }
+    if (!info.error_message.isEmpty() && errorMsg)
+        *errorMsg = info.error_message;
 
-    int line_count = 0;
-    QString host_name;
-    while (!lock_file.atEnd()) {
-        QString line = lock_file.readLine();
-        if (line_count == 1) {
-            host_name = line;
-            break;
-        }
-        ++line_count;
-    }
-
-    return host_name;
+    return info.date_time;
 }
 
-QString FileLocker::lastLockDateTime(QString file_path, QString *errorMsg) const {
-    if (!isFileLocked(file_path)) {
+QString FileLocker::lastLockSummary(QString file_path, const QString &line_break_char, QString *errorMsg) const {
+    LockInfo info = lockInfo(file_path);
+    if (!info.is_locked) {
         if (errorMsg)
-            *errorMsg = QString("Cannot unlock file that is not locked: " + file_path);
+            *errorMsg = "Cannot unlock file that is not locked: " + file_path;
         return QString();
     }
+    if (!info.error_message.isEmpty() && errorMsg)
+        *errorMsg = info.error_message;
 
-    file_path = lockFilePathForFile(file_path);
+    return lockSummary(info,line_break_char);
+}
 
-    QFile lock_file(file_path);
-    if (!lock_file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        if (errorMsg)
-            *errorMsg = QString("Cannot open lock file for reading at: " + file_path);
-        return QString();
+FileLocker::LockInfo FileLocker::lockInfo(const QString &file_path) const {
+    return lockInfoForFiles(QStringList(file_path)).front();
+}
+
+QList<FileLocker::LockInfo> FileLocker::lockInfoForFiles(const QStringList &file_paths) const {
+    QVector<LockInfo> infos(file_paths.count());
+    QList<int> stale_indexes;
+    QList<qti_private_LockInfoWorker*> workers;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    {
+        QMutexLocker locker(&qti_private_lock_info_cache_mutex);
+        for (int i = 0; i < file_paths.count(); ++i) {
+            QHash<QString,qti_private_LockInfoCacheEntry>::const_iterator itr = qti_private_lock_info_cache.constFind(qti_private_LockInfoCacheKey(file_paths.at(i),d_lock_extension));
+            if (itr != qti_private_lock_info_cache.constEnd() && now - itr.value().cached_at < qti_private_LOCK_INFO_CACHE_TIMEOUT) {
+                infos[i] = itr.value().info;
+                continue;
+            }
+
+            stale_indexes << i;
+            workers << new qti_private_LockInfoWorker(file_paths.at(i),d_lock_extension,itr != qti_private_lock_info_cache.constEnd() ? &itr.value().info : 0);
+        }
     }
 
-    int line_count = 0;
-    QString date_time;
-    while (!lock_file.atEnd()) {
-        QString line = lock_file.readLine();
-        if (line_count == 2) {
-            date_time = line;
-            break;
+    if (workers.count() == 1) {
+        // Not worth a thread:
+        workers.front()->run();
+    } else if (workers.count() > 1) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(qMin(workers.count(),qti_private_MAX_PARALLEL_LOCK_QUERIES));
+        for (int i = 0; i < workers.count(); ++i)
+            pool.start(workers.at(i));
+        pool.waitForDone();
+    }
+
+    if (!workers.isEmpty()) {
+        QMutexLocker locker(&qti_private_lock_info_cache_mutex);
+        if (qti_private_lock_info_cache.count() + workers.count() > qti_private_MAX_CACHED_LOCK_INFOS)
+            qti_private_lock_info_cache.clear();
+        const qint64 cached_at = QDateTime::currentMSecsSinceEpoch();
+        for (int i = 0; i < workers.count(); ++i) {
+            qti_private_LockInfoCacheEntry entry;
+            entry.info = workers.at(i)->info;
+            entry.cached_at = cached_at;
+            qti_private_lock_info_cache[qti_private_LockInfoCacheKey(workers.at(i)->file_path,d_lock_extension)] = entry;
+            infos[stale_indexes.at(i)] = entry.info;
         }
-        ++line_count;
+        qDeleteAll(workers);
     }
 
-    return date_time;
+    return infos.toList();
 }
 
-QString FileLocker::lastLockSummary(QString file_path, const QString &line_break_char, QString *errorMsg) const {
-    if (!isFileLocked(file_path)) {
-        if (errorMsg)
-            *errorMsg = "Cannot unlock file that is not locked: " + file_path;
+QString FileLocker::lockSummary(const LockInfo &lock_info, const QString &line_break_char) {
+    if (!lock_info.is_locked)
         return QString();
-    }
-
-    file_path = lockFilePathForFile(file_path);
 
     QString summary;
-    summary.append("Locked on host: " + lastLockHostName(file_path) + line_break_char);
-    summary.append("Locked at: " + lastLockDateTime(file_path));
+    summary.append("Locked on host: " + lock_info.host_name + line_break_char);
+    summary.append("Locked at: " + lock_info.date_time);
     return summary;
 }
 
+int FileLocker::lockInfoCacheTimeout() {
+    return qti_private_LOCK_INFO_CACHE_TIMEOUT;
+}
+
 QString FileLocker::lockFilePathForFile(const QString &file_path) const {
     QFileInfo fi(file_path);
     if (!fi.exists())
         return QString();
 
-    QString lock_file_path = fi.path();
-    lock_file_path.append(QDir::separator());
-    lock_file_path.append(fi.baseName());
-    lock_file_path.append("." + QString(d_lock_extension));
+    return qti_private_LockFilePath(fi,d_lock_extension);
+}
 
-    return lock_file_path;
+void FileLocker::invalidateLockInfo(const QString &file_path) const {
+    QMutexLocker locker(&qti_private_lock_info_cache_mutex);
+    qti_private_lock_info_cache.remove(qti_private_LockInfoCacheKey(file_path,d_lock_extension));
 }
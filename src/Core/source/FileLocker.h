@@ -15,6 +15,7 @@
 #include "QtilitiesCore_global.h"
 
 #include <QDateTime>
+#include <QStringList>
 
 namespace Qtilities {
     namespace Core {
@@ -25,11 +26,40 @@ namespace Qtilities {
         The .lck file created when locking a file will contain the date and time that the lock was created,
         as well as the hostname of the computer used to lock the file.
 
+        Lock files are parsed once into a LockInfo record which is cached for a short time, see lockInfo(). When the
+        lock states of many files are needed, for example to show a list of projects which might be on a network share,
+        use lockInfoForFiles() which queries the files which are not cached in parallel.
+
         <i>This class was added in %Qtilities v1.2.</i>
           */
         class QTILIITES_CORE_SHARED_EXPORT FileLocker {
 
         public:
+            //! Structure describing the lock on a file.
+            /*!
+              <i>This struct was added in %Qtilities v1.5.</i>
+              */
+            struct LockInfo {
+                LockInfo() : is_locked(false) {}
+
+                //! The path of the file which was queried, not the lock file itself.
+                QString file_path;
+                //! Indicates if the file is locked.
+                bool is_locked;
+                //! The path of the lock file when the file is locked.
+                QString lock_file_path;
+                //! The name of the application which created the lock.
+                QString application_name;
+                //! The host name that was used to lock the file.
+                QString host_name;
+                //! The date and time when the lock was created, as written in the lock file.
+                QString date_time;
+                //! The time at which the lock file was last modified.
+                QDateTime lock_file_modified;
+                //! Set when the file is locked but its lock file could not be read.
+                QString error_message;
+            };
+
             //! Default constructor.
             /*!
              * \param lock_extension The file extension to use for lock files.
@@ -93,10 +123,41 @@ namespace Qtilities {
              * \return The last lock summary.
              */
             virtual QString lastLockSummary(QString file_path, const QString& line_break_char = "\n", QString *errorMsg = 0) const;
+            //! Gets the lock information for a file, parsing its lock file once.
+            /*!
+             * Results are cached for lockInfoCacheTimeout() milliseconds. Older results are reused without reading the lock file again
+             * when the modification time of the lock file did not change.
+             *
+             * \param file_path The path of the file that is locked, not the lock file itself.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            LockInfo lockInfo(const QString& file_path) const;
+            //! Gets the lock information for a list of files.
+            /*!
+             * The files which are not cached are queried in parallel, thus the round trips to network shares overlap.
+             *
+             * \return The lock information for each file in \p file_paths, in the same order.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            QList<LockInfo> lockInfoForFiles(const QStringList& file_paths) const;
+            //! Provides a lock summary string for lock information returned by lockInfo().
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            static QString lockSummary(const LockInfo& lock_info, const QString& line_break_char = "\n");
+            //! The time in milliseconds for which lock information is reused without checking the lock file.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            static int lockInfoCacheTimeout();
 
         private:
             //! Returns the expected lock file path for a given file path.
             QString lockFilePathForFile(const QString& file_path) const;
+            //! Drops the cached lock information of a file after this locker changed its lock.
+            void invalidateLockInfo(const QString& file_path) const;
 
             //! The extension used for the lock file.
             QString d_lock_extension;
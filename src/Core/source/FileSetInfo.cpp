@@ -11,6 +11,7 @@
 
 #include "FileSetInfo.h"
 #include "FileUtils.h"
+#include "FileWatchService_p.h"
 #include "QtilitiesCoreConstants.h"
 
 #include <QDir>
@@ -21,21 +22,41 @@
 #include <QtDebug>
 #include <QCoreApplication>
 #include <QDomDocument>
+#include <QTimer>
 
 using namespace Qtilities::Core::Interfaces;
 using namespace Qtilities::Core::Constants;
 
 struct Qtilities::Core::FileSetInfoPrivateData {
     FileSetInfoPrivateData() : files_hash(-1),
-        file_watching_enabled(true) { }
+        file_watching_enabled(true),
+        change_notification_delay(100) { }
 
     QList<QtilitiesFileInfo>    files;
     int                         files_hash;
-    QFileSystemWatcher          watcher;
 
     bool                        file_watching_enabled;
+    //! The files registered with the FileWatchService, keys are in the form of FileWatchService::watchKey(), values are the actual file paths.
+    QHash<QString,QString>      watched_files;
+    //! The number of files in the set using each watched file, files with different relative paths can point to the same file.
+    QHash<QString,int>          watch_counts;
+    //! Changed files which are reported when change_timer times out.
+    QStringList                 pending_changes;
+    QTimer                      change_timer;
+    int                         change_notification_delay;
 };
 
+namespace {
+    // The watch service lives in the application thread, thus calls are queued when made from other threads:
+    void qti_private_WatchFile(const QString& path) {
+        QMetaObject::invokeMethod(Qtilities::Core::FileWatchService::instance(),"watchFile",Qt::AutoConnection,Q_ARG(QString,path));
+    }
+
+    void qti_private_UnwatchFile(const QString& path) {
+        QMetaObject::invokeMethod(Qtilities::Core::FileWatchService::instance(),"unwatchFile",Qt::AutoConnection,Q_ARG(QString,path));
+    }
+}
+
 namespace Qtilities {
     namespace Core {
         FactoryItem<QObject, FileSetInfo> FileSetInfo::factory;
@@ -46,19 +67,15 @@ using namespace Qtilities::Core;
 
 Qtilities::Core::FileSetInfo::FileSetInfo(QObject* parent) : QObject(parent) {
     d = new FileSetInfoPrivateData;
-    connect(&d->watcher,SIGNAL(fileChanged(QString)),SIGNAL(fileChanged(QString)));
-    connect(&d->watcher,SIGNAL(fileChanged(QString)),SIGNAL(setChanged()));
+    initializeFileWatching();
 }
 
 FileSetInfo::FileSetInfo(const FileSetInfo &other) : QObject(other.parent()) {
     d = new FileSetInfoPrivateData;
-    connect(&d->watcher,SIGNAL(fileChanged(QString)),SIGNAL(fileChanged(QString)));
-    connect(&d->watcher,SIGNAL(fileChanged(QString)),SIGNAL(setChanged()));
+    initializeFileWatching();
 
-    d->watcher.removePaths(d->watcher.files());
     d->files = other.files();
-    if (d->files.count() > 0)
-        d->watcher.addPaths(filePaths());
+    updateFileWatches();
 
     emit setChanged();
 }
@@ -66,10 +83,8 @@ FileSetInfo::FileSetInfo(const FileSetInfo &other) : QObject(other.parent()) {
 FileSetInfo& Qtilities::Core::FileSetInfo::operator=(const FileSetInfo& other) {
     if (this==&other) return *this;
 
-    d->watcher.removePaths(d->watcher.files());
     d->files = other.files();
-    if (d->files.count() > 0)
-        d->watcher.addPaths(filePaths());
+    updateFileWatches();
 
     emit setChanged();
 
@@ -77,6 +92,8 @@ FileSetInfo& Qtilities::Core::FileSetInfo::operator=(const FileSetInfo& other) {
 }
 
 Qtilities::Core::FileSetInfo::~FileSetInfo() {
+    foreach (const QString& key, d->watched_files.keys())
+        qti_private_UnwatchFile(key);
     delete d;
 }
 
@@ -89,11 +106,8 @@ bool FileSetInfo::addFile(const QString &file_path) {
 
     QtilitiesFileInfo fi(file_path);
     if (!d->files.contains(fi)) {
-        if (d->file_watching_enabled) {
-            if (fi.exists())
-                d->watcher.addPath(fi.actualFilePath());
-        }
         d->files << fi;
+        addFileWatch(fi.actualFilePath());
         emit setChanged();
         return true;
     }
@@ -103,11 +117,8 @@ bool FileSetInfo::addFile(const QString &file_path) {
 
 bool FileSetInfo::addFile(QtilitiesFileInfo file_info) {
     if (!d->files.contains(file_info)) {
-        if (d->file_watching_enabled) {
-            if (file_info.exists())
-                d->watcher.addPath(file_info.actualFilePath());
-        }
         d->files << file_info;
+        addFileWatch(file_info.actualFilePath());
         emit setChanged();
         return true;
     }
@@ -117,9 +128,8 @@ bool FileSetInfo::addFile(QtilitiesFileInfo file_info) {
 
 bool FileSetInfo::removeFile(const QString &file_path) {
     QtilitiesFileInfo fi(file_path);
-    if (!d->files.contains(fi)) {
-        d->watcher.removePath(fi.actualFilePath());
-        d->files.removeOne(fi);
+    if (d->files.removeOne(fi)) {
+        removeFileWatch(fi.actualFilePath());
         emit setChanged();
         return true;
     }
@@ -128,9 +138,8 @@ bool FileSetInfo::removeFile(const QString &file_path) {
 }
 
 bool FileSetInfo::removeFile(QtilitiesFileInfo file_info) {
-    if (!d->files.contains(file_info)) {
-        d->watcher.removePath(file_info.actualFilePath());
-        d->files.removeOne(file_info);
+    if (d->files.removeOne(file_info)) {
+        removeFileWatch(file_info.actualFilePath());
         emit setChanged();
         return true;
     }
@@ -164,24 +173,35 @@ int FileSetInfo::count() const {
 }
 
 void FileSetInfo::clear() {
-    if (d->watcher.files().count() > 0)
-        d->watcher.removePaths(d->watcher.files());
     d->files.clear();
+    updateFileWatches();
     emit setChanged();
 }
 
 void FileSetInfo::updateRelativeToPaths(const QString &search_string, const QString &replace_string, ITask *task) {
     QList<QtilitiesFileInfo> local_list = files();
+
+    // The search and replace strings are normalized once, thus only the file paths are normalized in the loop:
+    #ifdef Q_OS_WIN
+    const Qt::CaseSensitivity cs = Qt::CaseInsensitive;
+    #else
+    const Qt::CaseSensitivity cs = Qt::CaseSensitive;
+    #endif
+    const QString normalized_search = FileUtils::normalizePath(search_string);
+    const QString normalized_replace = FileUtils::normalizePath(replace_string);
+    const bool replace_starts_with_search = normalized_replace.startsWith(normalized_search,cs);
+
     for (int i = 0; i < local_list.count(); ++i) {
         QString actual_file_path = local_list.at(i).actualFilePath();
+        const QString normalized_file_path = FileUtils::normalizePath(actual_file_path);
 
         bool do_replacement = false;
-        if (FileUtils::pathStartsWith(replace_string,search_string)) {
+        if (replace_starts_with_search) {
             // Do check 1:
-            do_replacement = (FileUtils::pathStartsWith(actual_file_path,search_string) && !FileUtils::pathStartsWith(actual_file_path,replace_string));
+            do_replacement = (normalized_file_path.startsWith(normalized_search,cs) && !normalized_file_path.startsWith(normalized_replace,cs));
         } else {
             // Do check 2:
-            do_replacement = (FileUtils::pathStartsWith(actual_file_path,search_string));
+            do_replacement = (normalized_file_path.startsWith(normalized_search,cs));
         }
 
         if (do_replacement) {
@@ -204,17 +224,19 @@ int FileSetInfo::fileSetHash(bool update_previous_hash_storage) const {
     if (d->files.isEmpty())
         return -1;
 
-    // We store the file with its corresponding hash code in a map in order
-    // to always sort the hash code order according to the file name:
-    QMap<QString,int> sorted_hash_codes;
+    // The files are hashed concurrently. The returned map sorts the hashes according to the
+    // file names, thus the order of the files in the set does not affect the hash. Files
+    // which did not change since they were last hashed are not read again:
+    QMap<QString,QByteArray> sorted_hashes = FileUtils::fileHashes(filePaths());
 
     QString hash_string = "";
-    foreach (const QString& file, filePaths())
-        sorted_hash_codes[file] = FileUtils::fileHashCode(file);
-
-    for (int i = 0 ; i < sorted_hash_codes.count(); ++i) {
-        //qDebug() << "TEST" << i << sorted_hash_codes.values().at(i) << sorted_hash_codes.keys().at(i);
-        hash_string.append(QString::number(sorted_hash_codes.values().at(i)));
+    QMap<QString,QByteArray>::const_iterator itr;
+    for (itr = sorted_hashes.constBegin(); itr != sorted_hashes.constEnd(); ++itr) {
+        // Files which could not be read are included as -1, like fileHashCode() does:
+        if (itr.value().isEmpty())
+            hash_string.append("-1");
+        else
+            hash_string.append(QString::fromLatin1(itr.value().toHex()));
     }
 
     //qDebug() << "Combined hash string" << hash_string << qHash(hash_string);
@@ -244,17 +266,17 @@ bool FileSetInfo::allFilesExists() const {
 
 void FileSetInfo::disableFileWatching() {
     if (d->file_watching_enabled) {
-        if (d->watcher.files().count() > 0)
-            d->watcher.removePaths(d->watcher.files());
         d->file_watching_enabled = false;
+        updateFileWatches();
+        d->change_timer.stop();
+        d->pending_changes.clear();
     }
 }
 
 void FileSetInfo::enableFileWatching() {
     if (!d->file_watching_enabled) {
-        if (d->files.count() > 0)
-            d->watcher.addPaths(filePaths());
         d->file_watching_enabled = true;
+        updateFileWatches();
     }
 }
 
@@ -271,6 +293,100 @@ bool FileSetInfo::fileWatchingEnabled() const {
     return d->file_watching_enabled;
 }
 
+int FileSetInfo::changeNotificationDelay() const {
+    return d->change_notification_delay;
+}
+
+void FileSetInfo::setChangeNotificationDelay(int msecs) {
+    d->change_notification_delay = qMax(0,msecs);
+    d->change_timer.setInterval(d->change_notification_delay);
+}
+
+void FileSetInfo::initializeFileWatching() {
+    d->change_timer.setSingleShot(true);
+    d->change_timer.setInterval(d->change_notification_delay);
+    connect(&d->change_timer,SIGNAL(timeout()),SLOT(emitPendingChanges()));
+    connect(FileWatchService::instance(),SIGNAL(fileChanged(QString)),SLOT(handleWatchedFileChanged(QString)));
+}
+
+void FileSetInfo::updateFileWatches() {
+    // Only the differences are sent to the watch service, thus files which stay in the set keep their watches:
+    QHash<QString,QString> watched_files;
+    QHash<QString,int> watch_counts;
+    if (d->file_watching_enabled) {
+        foreach (const QtilitiesFileInfo& fi, d->files) {
+            QString actual_file_path = fi.actualFilePath();
+            QString key = FileWatchService::watchKey(actual_file_path);
+            watched_files[key] = actual_file_path;
+            ++watch_counts[key];
+        }
+    }
+
+    QHash<QString,QString>::const_iterator itr;
+    for (itr = d->watched_files.constBegin(); itr != d->watched_files.constEnd(); ++itr) {
+        if (!watched_files.contains(itr.key())) {
+            d->pending_changes.removeAll(itr.value());
+            qti_private_UnwatchFile(itr.key());
+        }
+    }
+    for (itr = watched_files.constBegin(); itr != watched_files.constEnd(); ++itr) {
+        if (!d->watched_files.contains(itr.key()))
+            qti_private_WatchFile(itr.key());
+    }
+    d->watched_files = watched_files;
+    d->watch_counts = watch_counts;
+}
+
+void FileSetInfo::addFileWatch(const QString& actual_file_path) {
+    if (!d->file_watching_enabled)
+        return;
+
+    QString key = FileWatchService::watchKey(actual_file_path);
+    if (++d->watch_counts[key] == 1) {
+        d->watched_files[key] = actual_file_path;
+        qti_private_WatchFile(key);
+    }
+}
+
+void FileSetInfo::removeFileWatch(const QString& actual_file_path) {
+    QString key = FileWatchService::watchKey(actual_file_path);
+    QHash<QString,int>::iterator itr = d->watch_counts.find(key);
+    if (itr == d->watch_counts.end())
+        return;
+
+    if (--itr.value() == 0) {
+        d->watch_counts.erase(itr);
+        d->watched_files.remove(key);
+        d->pending_changes.removeAll(actual_file_path);
+        qti_private_UnwatchFile(key);
+    }
+}
+
+void FileSetInfo::handleWatchedFileChanged(const QString& path) {
+    QHash<QString,QString>::const_iterator itr = d->watched_files.constFind(path);
+    if (itr == d->watched_files.constEnd())
+        return;
+
+    if (!d->pending_changes.contains(itr.value()))
+        d->pending_changes << itr.value();
+    // Changes are reported at the end of the window which started with the first change, thus bursts are reported together:
+    if (!d->change_timer.isActive())
+        d->change_timer.start();
+}
+
+void FileSetInfo::emitPendingChanges() {
+    if (d->pending_changes.isEmpty())
+        return;
+
+    QStringList changed_files = d->pending_changes;
+    d->pending_changes.clear();
+    changed_files.sort();
+    foreach (const QString& file, changed_files)
+        emit fileChanged(file);
+    emit filesChanged(changed_files);
+    emit setChanged();
+}
+
 // --------------------------------
 // IExportable Implementation
 // --------------------------------
@@ -188,6 +188,24 @@ namespace Qtilities {
              *\sa disableFileWatching(), enableFileWatching(), setFileWatchingEnabled()
              */
             bool fileWatchingEnabled() const;
+            //! Returns the window in milliseconds over which file changes are collected before they are reported.
+            /*!
+             *\sa setChangeNotificationDelay(), filesChanged()
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             */
+            int changeNotificationDelay() const;
+            //! Sets the window in milliseconds over which file changes are collected before they are reported.
+            /*!
+             *When a file in the set changes, further changes are collected until the window expires, after which fileChanged() is emitted for
+             *each changed file, followed by filesChanged() and a single setChanged(). Editors and build tools often touch a file several times
+             *when saving it, or change many files at once, thus this avoids reacting to every individual change.
+             *
+             *Default is 100 milliseconds. When 0, changes are reported as soon as control returns to the event loop.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setChangeNotificationDelay(int msecs);
 
             // --------------------------------
             // Factory Interface Implementation
@@ -217,10 +235,18 @@ namespace Qtilities {
              * \brief fileChanged Emitted when the contents of any monitored file in the set is changed, renamed or removed.
              * \param path The path of the file that changed.
              *
-             *Internally this class uses QFileSystemWatcher to monitor changes to file contents and this signal
-             *is basically connected to the same signal on the internal file system watcher.
+             *Internally this class uses a QFileSystemWatcher shared by all file sets to monitor changes to file contents.
+             *Changes are reported at the end of the change notification window, see setChangeNotificationDelay().
              */
             void fileChanged(const QString & path);
+            //! Emitted when files in the set changed.
+            /*!
+             *\param paths The paths of all files which changed during the last change notification window, see setChangeNotificationDelay().
+             *Callers which hash the files in the set only need to hash these files again.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             */
+            void filesChanged(const QStringList& paths);
 
             //! Emitted when the file set changed.
             /*!
@@ -234,7 +260,20 @@ namespace Qtilities {
              */
             void setChanged();
 
+        private slots:
+            void handleWatchedFileChanged(const QString& path);
+            void emitPendingChanges();
+
         private:
+            //! Sets up the change notification timer and the connection to the shared watch service.
+            void initializeFileWatching();
+            //! Brings the watches registered by this set in line with its files, only the differences are registered or removed.
+            void updateFileWatches();
+            //! Adds a watch for a file which was added to the set.
+            void addFileWatch(const QString& actual_file_path);
+            //! Removes the watch for a file which was removed from the set.
+            void removeFileWatch(const QString& actual_file_path);
+
             FileSetInfoPrivateData* d;
         };
     }
@@ -22,6 +22,16 @@
 #include <QHash>
 #include <QtDebug>
 #include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QtEndian>
+
+#include <string.h>
 
 using namespace Qtilities::Core::Interfaces;
 
@@ -38,6 +48,183 @@ struct Qtilities::Core::FileUtilsPrivateData {
     QFileInfoList       find_files_under_dir_list;
 };
 
+namespace {
+    //! The size of the chunks in which files are read when they are hashed.
+    const qint64 FILE_HASH_CHUNK_SIZE = 1024 * 1024;
+
+    const quint64 PRIME_1 = Q_UINT64_C(11400714785074694791);
+    const quint64 PRIME_2 = Q_UINT64_C(14029467366897019727);
+    const quint64 PRIME_3 = Q_UINT64_C(1609587929392839161);
+    const quint64 PRIME_4 = Q_UINT64_C(9650029242287828579);
+    const quint64 PRIME_5 = Q_UINT64_C(2870177450012600261);
+
+    //! Streaming implementation of the XXH64 hash algorithm.
+    class XxHash64 {
+    public:
+        XxHash64() : total_length(0), buffer_size(0) {
+            v[0] = PRIME_1 + PRIME_2;
+            v[1] = PRIME_2;
+            v[2] = 0;
+            v[3] = 0 - PRIME_1;
+        }
+
+        void update(const char* data, qint64 length) {
+            const uchar* input = (const uchar*) data;
+            total_length += (quint64) length;
+
+            // Complete the stripe which was started by the previous update:
+            if (buffer_size > 0) {
+                qint64 count = qMin(length,(qint64) (32 - buffer_size));
+                memcpy(buffer + buffer_size,input,(size_t) count);
+                buffer_size += (int) count;
+                input += count;
+                length -= count;
+                if (buffer_size < 32)
+                    return;
+                processStripe(buffer);
+                buffer_size = 0;
+            }
+
+            while (length >= 32) {
+                processStripe(input);
+                input += 32;
+                length -= 32;
+            }
+
+            if (length > 0) {
+                memcpy(buffer,input,(size_t) length);
+                buffer_size = (int) length;
+            }
+        }
+
+        //! Returns the hash in its canonical big endian representation.
+        QByteArray digest() const {
+            quint64 h;
+            if (total_length >= 32) {
+                h = rotateLeft(v[0],1) + rotateLeft(v[1],7) + rotateLeft(v[2],12) + rotateLeft(v[3],18);
+                for (int i = 0; i < 4; ++i) {
+                    h ^= round(0,v[i]);
+                    h = h * PRIME_1 + PRIME_4;
+                }
+            } else
+                h = PRIME_5;
+            h += total_length;
+
+            const uchar* input = buffer;
+            int remaining = buffer_size;
+            while (remaining >= 8) {
+                h ^= round(0,qFromLittleEndian<quint64>(input));
+                h = rotateLeft(h,27) * PRIME_1 + PRIME_4;
+                input += 8;
+                remaining -= 8;
+            }
+            if (remaining >= 4) {
+                h ^= (quint64) qFromLittleEndian<quint32>(input) * PRIME_1;
+                h = rotateLeft(h,23) * PRIME_2 + PRIME_3;
+                input += 4;
+                remaining -= 4;
+            }
+            while (remaining > 0) {
+                h ^= (quint64) *input * PRIME_5;
+                h = rotateLeft(h,11) * PRIME_1;
+                ++input;
+                --remaining;
+            }
+
+            h ^= h >> 33;
+            h *= PRIME_2;
+            h ^= h >> 29;
+            h *= PRIME_3;
+            h ^= h >> 32;
+
+            QByteArray result;
+            result.resize(8);
+            qToBigEndian<quint64>(h,(uchar*) result.data());
+            return result;
+        }
+
+    private:
+        static quint64 rotateLeft(quint64 value, int bits) {
+            return (value << bits) | (value >> (64 - bits));
+        }
+        static quint64 round(quint64 accumulator, quint64 lane) {
+            accumulator += lane * PRIME_2;
+            accumulator = rotateLeft(accumulator,31);
+            return accumulator * PRIME_1;
+        }
+        void processStripe(const uchar* stripe) {
+            for (int i = 0; i < 4; ++i)
+                v[i] = round(v[i],qFromLittleEndian<quint64>(stripe + i * 8));
+        }
+
+        quint64 v[4];
+        quint64 total_length;
+        uchar   buffer[32];
+        int     buffer_size;
+    };
+
+    struct FileHashCacheEntry {
+        qint64      size;
+        QDateTime   modified;
+        QByteArray  hash;
+    };
+
+    //! Hashes calculated by FileUtils::fileHash(), files are hashed in different threads by FileUtils::fileHashes(), thus access is protected by a mutex.
+    struct FileHashCache {
+        QMutex                              mutex;
+        QHash<QString,FileHashCacheEntry>   entries;
+    };
+
+    QByteArray calculateFileHash(QFile* file, Qtilities::Core::FileUtils::HashAlgorithm algorithm, bool* ok) {
+        *ok = false;
+        QByteArray chunk;
+        chunk.resize((int) FILE_HASH_CHUNK_SIZE);
+
+        if (algorithm == Qtilities::Core::FileUtils::FastHash) {
+            XxHash64 hash;
+            qint64 count;
+            while ((count = file->read(chunk.data(),FILE_HASH_CHUNK_SIZE)) > 0)
+                hash.update(chunk.constData(),count);
+            if (count < 0)
+                return QByteArray();
+            *ok = true;
+            return hash.digest();
+        }
+
+        #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+        if (algorithm == Qtilities::Core::FileUtils::Sha256Hash) {
+            QCryptographicHash hash(QCryptographicHash::Sha256);
+            qint64 count;
+            while ((count = file->read(chunk.data(),FILE_HASH_CHUNK_SIZE)) > 0)
+                hash.addData(chunk.constData(),(int) count);
+            if (count < 0)
+                return QByteArray();
+            *ok = true;
+            return hash.result();
+        }
+        #endif
+
+        return QByteArray();
+    }
+
+    class FileHashWorker : public QRunnable {
+    public:
+        FileHashWorker(const QString& file, Qtilities::Core::FileUtils::HashAlgorithm algorithm) : d_file(file), d_algorithm(algorithm) {
+            setAutoDelete(false);
+        }
+
+        void run() {
+            d_hash = Qtilities::Core::FileUtils::fileHash(d_file,d_algorithm);
+        }
+
+        QString                                     d_file;
+        Qtilities::Core::FileUtils::HashAlgorithm   d_algorithm;
+        QByteArray                                  d_hash;
+    };
+}
+
+Q_GLOBAL_STATIC(FileHashCache,fileHashCache)
+
 Qtilities::Core::FileUtils::FileUtils(bool enable_tasking, QObject* parent) : QObject(parent) {
     d = new FileUtilsPrivateData;
 
@@ -136,7 +323,7 @@ QFileInfoList Qtilities::Core::FileUtils::findFilesUnderDir(const QString &dirNa
     }
 
     foreach (const QFileInfo& info, dir.entryInfoList(final_filters | QDir::AllDirs,sort)) {
-        QCoreApplication::processEvents();
+        IDLE_SCHEDULER->yieldToEventLoop();
         // Check if this entry must be ignored:
         bool not_ignored = true;
         if (!ignore_list.isEmpty()) {
@@ -232,7 +419,7 @@ bool Qtilities::Core::FileUtils::removeDir(const QString& dirName) {
     if (dir.exists(dirName)) {
         foreach (const QFileInfo& info, dir.entryInfoList(QDir::NoDotAndDotDot | QDir::System | QDir::Hidden  | QDir::AllDirs | QDir::Files, QDir::DirsFirst)) {
             if (info.isDir()) {
-                QCoreApplication::processEvents();
+                IDLE_SCHEDULER->yieldToEventLoop();
                 result = removeDir(info.absoluteFilePath());
             } else
                 result = QFile::remove(info.absoluteFilePath());
@@ -269,57 +456,154 @@ QString Qtilities::Core::FileUtils::removeFromFileName(const QString &fullFileNa
 }
 
 int Qtilities::Core::FileUtils::fileHashCode(const QString& file_name) {
+    bool ok;
+    QByteArray hash = fileHash(file_name,FastHash,&ok);
+    if (!ok)
+        return -1;
+
+    // Fold the 64 bit hash, without ever returning the -1 error code:
+    quint64 value = qFromBigEndian<quint64>((const uchar*) hash.constData());
+    return (int) ((value ^ (value >> 32)) & 0x7FFFFFFF);
+}
+
+QByteArray Qtilities::Core::FileUtils::fileHash(const QString& file_name, HashAlgorithm algorithm, bool* ok) {
+    if (ok)
+        *ok = false;
+
+    QFileInfo file_info(file_name);
+    if (!file_info.exists() || file_info.isDir())
+        return QByteArray();
+
+    const QString cache_key = QString::number((int) algorithm) + ":" + file_info.absoluteFilePath();
+    const qint64 size = file_info.size();
+    const QDateTime modified = file_info.lastModified();
+    FileHashCache* cache = fileHashCache();
+    {
+        QMutexLocker locker(&cache->mutex);
+        QHash<QString,FileHashCacheEntry>::const_iterator itr = cache->entries.constFind(cache_key);
+        if (itr != cache->entries.constEnd() && itr.value().size == size && itr.value().modified == modified) {
+            if (ok)
+                *ok = true;
+            return itr.value().hash;
+        }
+    }
+
+    // The file is hashed without holding the lock, thus other files are hashed concurrently:
     QFile file(file_name);
     if (!file.open(QIODevice::ReadOnly))
-        return -1;
-    QByteArray file_contents = file.readAll();
-    //qDebug() << "textFileHashCode" << file_name << qHash(file_contents);
+        return QByteArray();
+    bool hashed;
+    QByteArray hash = calculateFileHash(&file,algorithm,&hashed);
     file.close();
-    return qHash(file_contents);
+    if (!hashed)
+        return QByteArray();
+
+    FileHashCacheEntry entry;
+    entry.size = size;
+    entry.modified = modified;
+    entry.hash = hash;
+    {
+        QMutexLocker locker(&cache->mutex);
+        cache->entries[cache_key] = entry;
+    }
+
+    if (ok)
+        *ok = true;
+    return hash;
+}
+
+QMap<QString,QByteArray> Qtilities::Core::FileUtils::fileHashes(const QStringList& files, HashAlgorithm algorithm) {
+    QMap<QString,QByteArray> hashes;
+    if (files.count() < 2 || QThread::idealThreadCount() < 2) {
+        foreach (const QString& file, files)
+            hashes[file] = fileHash(file,algorithm);
+        return hashes;
+    }
+
+    QList<FileHashWorker*> workers;
+    QThreadPool pool;
+    pool.setMaxThreadCount(QThread::idealThreadCount());
+    foreach (const QString& file, files) {
+        FileHashWorker* worker = new FileHashWorker(file,algorithm);
+        workers << worker;
+        pool.start(worker);
+    }
+    pool.waitForDone();
+
+    for (int i = 0; i < workers.count(); ++i) {
+        hashes[workers.at(i)->d_file] = workers.at(i)->d_hash;
+        delete workers.at(i);
+    }
+    return hashes;
+}
+
+void Qtilities::Core::FileUtils::clearFileHashCache() {
+    FileHashCache* cache = fileHashCache();
+    QMutexLocker locker(&cache->mutex);
+    cache->entries.clear();
 }
 
 bool Qtilities::Core::FileUtils::compareFiles(const QString& file1, const QString& file2) {
-    int original = FileUtils::fileHashCode(file1);
-    int readback = FileUtils::fileHashCode(file2);
-    if (original == -1 || readback == -1)
+    // Files with different sizes can never be the same, thus they are not read:
+    QFileInfo file_info1(file1);
+    QFileInfo file_info2(file2);
+    if (!file_info1.exists() || !file_info2.exists() || file_info1.size() != file_info2.size())
+        return false;
+
+    // The contents are compared directly in chunks, thus the comparison stops at the first difference and does not depend on cached hashes:
+    QFile original(file1);
+    QFile readback(file2);
+    if (!original.open(QIODevice::ReadOnly) || !readback.open(QIODevice::ReadOnly))
         return false;
-    return (original == readback);
+
+    QByteArray original_chunk;
+    QByteArray readback_chunk;
+    original_chunk.resize((int) FILE_HASH_CHUNK_SIZE);
+    readback_chunk.resize((int) FILE_HASH_CHUNK_SIZE);
+    forever {
+        qint64 original_count = original.read(original_chunk.data(),FILE_HASH_CHUNK_SIZE);
+        qint64 readback_count = readback.read(readback_chunk.data(),FILE_HASH_CHUNK_SIZE);
+        if (original_count < 0 || original_count != readback_count)
+            return false;
+        if (original_count == 0)
+            return true;
+        if (memcmp(original_chunk.constData(),readback_chunk.constData(),(size_t) original_count) != 0)
+            return false;
+    }
 }
 
-bool FileUtils::comparePaths(const QString &path1, const QString &path2, Qt::CaseSensitivity cs) {
-    QFileInfo fi1(path1);
-    QFileInfo fi2(path2);
-    bool do_easy_compare = true;
+bool FileUtils::comparePaths(const QString &path1, const QString &path2, Qt::CaseSensitivity cs, bool check_file_system) {
+    #ifndef Q_OS_WIN
+    cs = Qt::CaseSensitive;
+    #endif
+
+    // Equal normalized paths are the same path, which is checked without touching the file system:
+    if (normalizePath(path1).compare(normalizePath(path2),cs) == 0)
+        return true;
+    if (!check_file_system)
+        return false;
+
     #ifdef Q_OS_WIN
+    // QFileInfo's == operator is case insensitive on Windows:
     if (cs == Qt::CaseSensitive)
-        do_easy_compare = false;
-    #else
-    Q_UNUSED(cs)
+        return false;
     #endif
 
-    if (fi1.exists() && fi2.exists() && do_easy_compare)
-        return fi1 == fi2;
-    else {
-        QString cleaned_1 = QDir::cleanPath(path1);
-        QString cleaned_2 = QDir::cleanPath(path2);
-        if (cleaned_1.size() == cleaned_2.size()) {
-            #ifdef Q_OS_WIN
-            return (FileUtils::toNativeSeparators(cleaned_1).compare(FileUtils::toNativeSeparators(cleaned_2),cs) == 0);
-            #else
-            return (FileUtils::toNativeSeparators(cleaned_1).compare(FileUtils::toNativeSeparators(cleaned_2),Qt::CaseSensitive) == 0);
-            #endif
-        } else
-            return false;
-    }
+    // Different paths can still refer to the same file, for example through symbolic links:
+    QFileInfo fi1(path1);
+    QFileInfo fi2(path2);
+    return fi1.exists() && fi2.exists() && fi1 == fi2;
 }
 
 bool FileUtils::pathStartsWith(const QString &child_path, const QString &parent_path, Qt::CaseSensitivity cs) {
-    #ifdef Q_OS_WIN
-    return toNativeSeparators(QDir::cleanPath(child_path)).startsWith(toNativeSeparators(QDir::cleanPath(parent_path)),cs);
-    #else
-    Q_UNUSED(cs)
-    return toNativeSeparators(QDir::cleanPath(child_path)).startsWith(toNativeSeparators(QDir::cleanPath(parent_path)),Qt::CaseSensitive);
+    #ifndef Q_OS_WIN
+    cs = Qt::CaseSensitive;
     #endif
+    return normalizePath(child_path).startsWith(normalizePath(parent_path),cs);
+}
+
+QString FileUtils::normalizePath(const QString &path) {
+    return toNativeSeparators(QDir::cleanPath(path));
 }
 
 QString FileUtils::toNativeSeparators(QString path) {
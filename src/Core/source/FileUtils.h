@@ -17,6 +17,8 @@
 #include "Task.h"
 
 #include <QList>
+#include <QMap>
+#include <QStringList>
 #include <QUrl>
 #include <QDir>
 #include <QObject>
@@ -54,6 +56,15 @@ namespace Qtilities {
                 return "";
             }
 
+            //! The algorithms which can be used to hash the contents of files using fileHash().
+            /*!
+              <i>This enum was added in %Qtilities v1.5.</i>
+              */
+            enum HashAlgorithm {
+                FastHash    = 0,    /*!< A fast 64 bit non-cryptographic hash (XXH64). Suitable to detect changes to files. */
+                Sha256Hash  = 1     /*!< A SHA-256 hash. Only available when %Qtilities is built against Qt 5. */
+            };
+
             FileUtils(bool enable_tasking = true, QObject* parent = 0);
             virtual ~FileUtils();
 
@@ -135,29 +146,68 @@ QFileInfoList files = fu.findFilesUnderDir("/my_path","*.txt");
             //! Calculates a hash code for a text file.
             /*!
               If something went wrong (for example if the file does not exist), -1 is returned as an error code.
+
+              \note From %Qtilities v1.5 onwards, the hash code is derived from the FastHash returned by fileHash(). Thus the file is not loaded into
+              memory anymore, but the hash codes differ from the ones calculated by previous versions.
               */
             static int fileHashCode(const QString& file);
+            //! Calculates the hash of the contents of a file.
+            /*!
+              The file is read in fixed size chunks, thus files of any size can be hashed without loading them into memory. Hashes are cached using the
+              path, size and modification time of the file, thus hashing a file which did not change since it was last hashed does not read it again.
+
+              \param file The path of the file.
+              \param algorithm The hash algorithm to use.
+              \param ok When specified, is set to false when the file could not be read or when the algorithm is not available.
+              \returns The hash of the file, an empty QByteArray when something went wrong.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa fileHashes(), clearFileHashCache()
+              */
+            static QByteArray fileHash(const QString& file, HashAlgorithm algorithm = FastHash, bool* ok = 0);
+            //! Calculates the hashes of the contents of multiple files concurrently.
+            /*!
+              The files are hashed by a thread pool using fileHash(). Files which could not be hashed are mapped to an empty QByteArray.
+
+              \returns A map with the paths in \p files as keys and their hashes as values.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static QMap<QString,QByteArray> fileHashes(const QStringList& files, HashAlgorithm algorithm = FastHash);
+            //! Clears the cache of file hashes calculated by fileHash().
+            /*!
+              Since cached hashes are only used while the size and modification time of a file do not change, this is only needed when a file might be
+              changed without changing either of them.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static void clearFileHashCache();
             //! Compares two files and returns true if they are exactly the same, false otherwise.
+            /*!
+              \note From %Qtilities v1.5 onwards, files with different sizes are never read, and the contents of other files are compared in chunks
+              instead of loading both files into memory.
+              */
             static bool compareFiles(const QString& file1, const QString& file2);
             //! Compares two paths in a system independant way.
             /*!
               This function takes two paths and checks if they are the same. The function does the following:
-              - If both paths exists, QFileInfo's == operator overload is used.
-
-              If both files does not exist, the following check is done:
-              - Does a case insensitive check.
-              - Removes any unwanted things in the path through QDir::cleanPath().
-              - Does an environment independent check by converting both paths to the native characters of the OS on which this function is called.
+              - Normalizes both paths using normalizePath() and compares the results.
+              - If the normalized paths differ and \p check_file_system is true, QFileInfo's == operator overload is used when both paths exist.
 
               \param path1 The first path to check.
               \param path2 The second path to check against path1.
               \param cs The case sensitivity of the check. This only applies to Windows. Only Unix based systems Qt::CaseSensitive is always used.
+              \param check_file_system When true, paths which are different strings are compared on the file system, thus paths which refer to the same
+              file through symbolic links are considered the same.
 
               \return True when the paths are the same, false otherwise.
 
+              \note Before %Qtilities v1.5 the file system was always checked first. From %Qtilities v1.5 onwards the file system is only touched when \p check_file_system is true.
+
               <i>This function was added in %Qtilities v1.1.</i>
               */
-            static bool comparePaths(const QString& path1, const QString& path2, Qt::CaseSensitivity cs = Qt::CaseInsensitive);
+            static bool comparePaths(const QString& path1, const QString& path2, Qt::CaseSensitivity cs = Qt::CaseInsensitive, bool check_file_system = false);
             //! Check if one path starts with another path (does it checks if the one path is a parent of another path).
             /*!
               \param child_path The child path.
@@ -169,6 +219,14 @@ QFileInfoList files = fu.findFilesUnderDir("/my_path","*.txt");
               <i>This function was added in %Qtilities v1.2.</i>
               */
             static bool pathStartsWith(const QString& child_path, const QString& parent_path, Qt::CaseSensitivity cs = Qt::CaseInsensitive);
+            //! Normalizes a path by removing redundant separators and "." and ".." parts using QDir::cleanPath(), and converting it using toNativeSeparators().
+            /*!
+              This function only works on the string, the file system is never accessed. Normalized paths can be compared directly,
+              thus when comparing many paths against the same path, normalize that path once.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static QString normalizePath(const QString& path);
             //! Converts a path to the native format of the underlying OS.
             /*!
               This function is similar to QDir::toNativeSeparators(), but it supports linux as well.
@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "FileWatchService_p.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+
+Qtilities::Core::FileWatchService* Qtilities::Core::FileWatchService::instance() {
+    static QMutex mutex;
+    static FileWatchService* m_Instance = 0;
+    QMutexLocker locker(&mutex);
+    if (!m_Instance) {
+        m_Instance = new FileWatchService;
+        if (QCoreApplication::instance())
+            m_Instance->moveToThread(QCoreApplication::instance()->thread());
+    }
+    return m_Instance;
+}
+
+QString Qtilities::Core::FileWatchService::watchKey(const QString& path) {
+    return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+}
+
+Qtilities::Core::FileWatchService::FileWatchService() : QObject() {
+    d_watcher.setParent(this);
+    connect(&d_watcher,SIGNAL(fileChanged(QString)),SLOT(handleFileChanged(QString)));
+    connect(&d_watcher,SIGNAL(directoryChanged(QString)),SLOT(handleDirectoryChanged(QString)));
+}
+
+void Qtilities::Core::FileWatchService::watchFile(const QString& path) {
+    if (path.isEmpty())
+        return;
+
+    QString key = watchKey(path);
+    if (d_file_references[key]++ > 0)
+        return;
+
+    QFileInfo file_info(key);
+    if (file_info.exists()) {
+        d_watcher.addPath(key);
+        d_watched_files.insert(key);
+    }
+
+    QString directory = file_info.absolutePath();
+    QSet<QString>& directory_files = d_directory_files[directory];
+    if (directory_files.isEmpty() && QFileInfo(directory).isDir())
+        d_watcher.addPath(directory);
+    directory_files.insert(key);
+}
+
+void Qtilities::Core::FileWatchService::unwatchFile(const QString& path) {
+    if (path.isEmpty())
+        return;
+
+    QString key = watchKey(path);
+    QHash<QString,int>::iterator itr = d_file_references.find(key);
+    if (itr == d_file_references.end())
+        return;
+    if (--itr.value() > 0)
+        return;
+    d_file_references.erase(itr);
+
+    if (d_watched_files.remove(key))
+        d_watcher.removePath(key);
+
+    QString directory = QFileInfo(key).absolutePath();
+    QHash<QString,QSet<QString> >::iterator dir_itr = d_directory_files.find(directory);
+    if (dir_itr != d_directory_files.end()) {
+        dir_itr.value().remove(key);
+        if (dir_itr.value().isEmpty()) {
+            d_directory_files.erase(dir_itr);
+            d_watcher.removePath(directory);
+        }
+    }
+}
+
+void Qtilities::Core::FileWatchService::handleFileChanged(const QString& path) {
+    // Removed files lose their watch, the directory watch picks them up when they are created again:
+    if (!QFileInfo(path).exists() && d_watched_files.remove(path))
+        d_watcher.removePath(path);
+    emit fileChanged(path);
+}
+
+void Qtilities::Core::FileWatchService::handleDirectoryChanged(const QString& path) {
+    QString directory = QDir::cleanPath(path);
+    foreach (const QString& key, d_directory_files.value(directory)) {
+        bool exists = QFileInfo(key).exists();
+        if (exists && !d_watched_files.contains(key)) {
+            // The file was created, or replaced after its watch was dropped:
+            d_watcher.addPath(key);
+            d_watched_files.insert(key);
+            emit fileChanged(key);
+        } else if (!exists && d_watched_files.remove(key)) {
+            d_watcher.removePath(key);
+            emit fileChanged(key);
+        }
+    }
+}
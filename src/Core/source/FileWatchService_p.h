@@ -0,0 +1,71 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef FILE_WATCH_SERVICE_P_H
+#define FILE_WATCH_SERVICE_P_H
+
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+          \class FileWatchService
+          \brief The FileWatchService class shares a single QFileSystemWatcher between all FileSetInfo instances in the process.
+
+          Watches are reference counted, thus files which are part of many file sets are only watched once and adding or removing a file
+          from a set never registers the other files again. The directories containing watched files are watched as well, with one watch
+          per directory. This allows the service to pick up files which are created after they were added, and files which are replaced
+          by editors which save through a temporary file, which both lose their file level watch.
+
+          The service lives in the thread of the application object. watchFile() and unwatchFile() must be invoked through
+          QMetaObject::invokeMethod() when used from other threads.
+         */
+        class FileWatchService : public QObject {
+            Q_OBJECT
+
+        public:
+            static FileWatchService* instance();
+            //! Returns the key under which \p path is watched, fileChanged() reports paths in this form.
+            static QString watchKey(const QString& path);
+
+        public slots:
+            //! Adds a reference to the watch on \p path, the file does not need to exist.
+            void watchFile(const QString& path);
+            //! Removes a reference to the watch on \p path, the watch is removed with its last reference.
+            void unwatchFile(const QString& path);
+
+        signals:
+            //! Emitted when a watched file was changed, removed, or created. \p path is in the form returned by watchKey().
+            void fileChanged(const QString& path);
+
+        private slots:
+            void handleFileChanged(const QString& path);
+            void handleDirectoryChanged(const QString& path);
+
+        private:
+            FileWatchService();
+
+            QFileSystemWatcher              d_watcher;
+            //! The number of references to each watched file.
+            QHash<QString,int>              d_file_references;
+            //! The files which currently have a file level watch.
+            QSet<QString>                   d_watched_files;
+            //! The watched files in each watched directory.
+            QHash<QString,QSet<QString> >   d_directory_files;
+        };
+    }
+}
+
+#endif // FILE_WATCH_SERVICE_P_H
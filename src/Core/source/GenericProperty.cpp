@@ -12,6 +12,9 @@ using namespace Qtilities::Core::Constants;
 
 #include <ObjectManager>
 #include <QDomDocument>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 
 #include "limits.h"
 #include "float.h"
@@ -19,6 +22,28 @@ using namespace Qtilities::Core::Constants;
 namespace Qtilities {
 namespace Core {
 
+namespace {
+    //! Returns a shared QRegExp for the given pattern, definition files typically use a handful of patterns for thousands of properties.
+    QRegExp qti_private_InternedRegExp(const QString& pattern, QRegExp::PatternSyntax syntax, Qt::CaseSensitivity cs) {
+        static QMutex mutex;
+        static QHash<QString,QRegExp> interned_reg_exps;
+
+        QString key = QString("%1:%2:%3").arg((int) syntax).arg((int) cs).arg(pattern);
+        QMutexLocker locker(&mutex);
+        QHash<QString,QRegExp>::const_iterator itr = interned_reg_exps.constFind(key);
+        if (itr != interned_reg_exps.constEnd())
+            return itr.value();
+
+        // Keeps the cache bounded when patterns are generated:
+        if (interned_reg_exps.count() >= 256)
+            interned_reg_exps.clear();
+
+        QRegExp reg_exp(pattern,cs,syntax);
+        interned_reg_exps[key] = reg_exp;
+        return reg_exp;
+    }
+}
+
 struct GenericPropertyData {
     GenericPropertyData() : is_modified(false),
         type(GenericProperty::TypeString),
@@ -136,6 +161,8 @@ GenericProperty::GenericProperty(const GenericProperty& ref) : QObject(ref.paren
 GenericProperty& GenericProperty::operator=(const GenericProperty& ref) {
     if (this==&ref) return *this;
 
+    const bool name_changed = d->name != ref.propertyName() || d->aliases != ref.aliases();
+    const bool category_changed = d->category != ref.category();
     d->name = ref.propertyName();
     d->aliases = ref.aliases();
     d->type = ref.type();
@@ -165,6 +192,10 @@ GenericProperty& GenericProperty::operator=(const GenericProperty& ref) {
     setIsExportable(ref.isExportable());
 
     setModificationState(true);
+    if (name_changed)
+        emit propertyNameChanged(this);
+    if (category_changed)
+        emit categoryChanged(this);
 
     return *this;
 }
@@ -237,8 +268,11 @@ QString GenericProperty::propertyName() const {
 }
 
 void GenericProperty::setPropertyName(const QString &property_name) {
+    const bool name_changed = d->name != property_name;
     d->name = property_name;
     setObjectName(property_name);
+    if (name_changed)
+        emit propertyNameChanged(this);
 }
 
 QMap<QString, PropertyAlias> GenericProperty::aliases() const {
@@ -306,6 +340,7 @@ void GenericProperty::setCategory(QtilitiesCategory category) {
     if (d->category != category) {
         d->category = category;
         // TODO: Get a way to refresh the property browser from here.
+        emit categoryChanged(this);
     }
 }
 
@@ -1007,6 +1042,7 @@ bool GenericProperty::fromCsvString(const QString &csv_string) {
     if (csv_list.count() < 2)
         return false;
 
+    bool aliases_changed = false;
     QStringList aliases = csv_list[1].split(d->list_storage_separator);
     foreach (const QString& alias, aliases) {
         QStringList alias_split = alias.split("::");
@@ -1024,8 +1060,11 @@ bool GenericProperty::fromCsvString(const QString &csv_string) {
                 property_alias.d_inverted = false;
             }
             d->aliases[property_alias.d_name] = property_alias;
+            aliases_changed = true;
         }
     }
+    if (aliases_changed)
+        emit propertyNameChanged(this);
 
     if (csv_list.count() < 3)
         return false;
@@ -1055,7 +1094,7 @@ bool GenericProperty::fromCsvString(const QString &csv_string) {
     if (csv_list.count() < 7)
         return false;
 
-    d->category = QtilitiesCategory(csv_list[6],d->list_storage_separator);
+    setCategory(QtilitiesCategory(csv_list[6],d->list_storage_separator));
 
     if (csv_list.count() < 8)
         return false;
@@ -1121,22 +1160,20 @@ bool GenericProperty::fromCsvString(const QString &csv_string) {
     if (csv_list.count() < 17)
         return false;
 
-    QRegExp reg_exp;
-    reg_exp.setPattern(csv_list[16].simplified());
+    QString reg_exp_pattern = csv_list[16].simplified();
 
     if (csv_list.count() < 18)
         return false;
 
-    reg_exp.setPatternSyntax((QRegExp::PatternSyntax) csv_list[17].toInt());
+    QRegExp::PatternSyntax reg_exp_syntax = (QRegExp::PatternSyntax) csv_list[17].toInt();
 
     if (csv_list.count() < 19)
         return false;
 
+    Qt::CaseSensitivity reg_exp_cs = Qt::CaseInsensitive;
     if (csv_list[18].simplified().compare("true",Qt::CaseInsensitive) == 0)
-        reg_exp.setCaseSensitivity(Qt::CaseSensitive);
-    else
-        reg_exp.setCaseSensitivity(Qt::CaseInsensitive);
-    d->string_reg_exp = reg_exp;
+        reg_exp_cs = Qt::CaseSensitive;
+    d->string_reg_exp = qti_private_InternedRegExp(reg_exp_pattern,reg_exp_syntax,reg_exp_cs);
 
     if (csv_list.count() < 20)
         return false;
@@ -1170,7 +1207,7 @@ bool GenericProperty::fromCsvString(const QString &csv_string) {
 }
 
 Qtilities::Core::Interfaces::IExportable::ExportModeFlags GenericProperty::supportedFormats() const {
-    return IExportable::XML;
+    return IExportable::XML | IExportable::Binary;
 }
 
 Qtilities::Core::InstanceFactoryInfo GenericProperty::staticInstanceFactoryInfo() {
@@ -1286,9 +1323,152 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags GenericProperty::imp
         return IExportable::Incomplete;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags GenericProperty::exportBinary(QDataStream& stream) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    stream << d->name;
+    stream << (quint32) d->aliases.count();
+    foreach (const PropertyAlias& alias, d->aliases) {
+        stream << alias.d_name;
+        stream << alias.d_environment;
+        stream << alias.d_inverted;
+    }
+    stream << (quint32) d->type;
+    QtilitiesCategory category = d->category;
+    category.setExportVersion(exportVersion());
+    if (category.exportBinary(stream) != IExportable::Complete)
+        return IExportable::Failed;
+    stream << d->value;
+    stream << d->default_value;
+    stream << d->default_value_set;
+    stream << d->switch_name;
+    stream << d->description;
+    stream << d->help_id;
+    stream << d->note;
+    stream << d->list_backend_separator;
+    stream << d->list_storage_separator;
+    stream << (quint32) d->level;
+    stream << d->editable;
+    stream << d->default_editable;
+    stream << d->state_dependent;
+    stream << d->context_dependent;
+    stream << d->is_internal;
+    stream << d->property_filter_string;
+    stream << d->visible;
+    stream << d->default_visible;
+    stream << (qint32) d->int_max;
+    stream << (qint32) d->int_min;
+    stream << (qint32) d->int_step;
+    stream << (qint32) d->double_max;
+    stream << (qint32) d->double_min;
+    stream << (qint32) d->double_step;
+    stream << d->enum_possible_values_displayed;
+    stream << d->enum_possible_values_command_line;
+    stream << d->string_reg_exp;
+    stream << d->variant_value;
+    stream << d->file_name_filter;
+    stream << (quint32) d->macro_mode;
+    stream << d->is_macro;
+    stream << isExportable();
+
+    if (stream.status() == QDataStream::Ok)
+        return IExportable::Complete;
+    else
+        return IExportable::Failed;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags GenericProperty::importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list) {
+    Q_UNUSED(import_list)
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    QString name;
+    stream >> name;
+    quint32 alias_count;
+    stream >> alias_count;
+    QMap<QString,PropertyAlias> aliases;
+    for (quint32 i = 0; i < alias_count && stream.status() == QDataStream::Ok; ++i) {
+        PropertyAlias alias;
+        stream >> alias.d_name;
+        stream >> alias.d_environment;
+        stream >> alias.d_inverted;
+        aliases[alias.d_name] = alias;
+    }
+    quint32 ui32;
+    stream >> ui32;
+    d->type = (PropertyType) ui32;
+    QtilitiesCategory category;
+    category.setExportVersion(exportVersion());
+    if (category.importBinary(stream,import_list) != IExportable::Complete)
+        return IExportable::Failed;
+    stream >> d->value;
+    stream >> d->default_value;
+    stream >> d->default_value_set;
+    stream >> d->switch_name;
+    stream >> d->description;
+    stream >> d->help_id;
+    stream >> d->note;
+    stream >> d->list_backend_separator;
+    stream >> d->list_storage_separator;
+    stream >> ui32;
+    d->level = (PropertyLevel) ui32;
+    stream >> d->editable;
+    stream >> d->default_editable;
+    stream >> d->state_dependent;
+    stream >> d->context_dependent;
+    stream >> d->is_internal;
+    stream >> d->property_filter_string;
+    stream >> d->visible;
+    stream >> d->default_visible;
+    qint32 i32;
+    stream >> i32;
+    d->int_max = i32;
+    stream >> i32;
+    d->int_min = i32;
+    stream >> i32;
+    d->int_step = i32;
+    stream >> i32;
+    d->double_max = i32;
+    stream >> i32;
+    d->double_min = i32;
+    stream >> i32;
+    d->double_step = i32;
+    stream >> d->enum_possible_values_displayed;
+    stream >> d->enum_possible_values_command_line;
+    QRegExp reg_exp;
+    stream >> reg_exp;
+    d->string_reg_exp = qti_private_InternedRegExp(reg_exp.pattern(),reg_exp.patternSyntax(),reg_exp.caseSensitivity());
+    stream >> d->variant_value;
+    stream >> d->file_name_filter;
+    stream >> ui32;
+    d->macro_mode = (MacroMode) ui32;
+    stream >> d->is_macro;
+    bool is_exportable;
+    stream >> is_exportable;
+    setIsExportable(is_exportable);
+
+    if (stream.status() != QDataStream::Ok)
+        return IExportable::Failed;
+
+    const bool aliases_changed = d->aliases != aliases;
+    d->aliases = aliases;
+    setPropertyName(name);
+    if (aliases_changed)
+        emit propertyNameChanged(this);
+    setCategory(category);
+    return IExportable::Complete;
+}
+
 
 void GenericProperty::setMacroMode(GenericProperty::MacroMode macro_mode) {
-    d->macro_mode = macro_mode;
+    if (d->macro_mode != macro_mode) {
+        d->macro_mode = macro_mode;
+        emit macroModeChanged(this);
+    }
 }
 
 GenericProperty::MacroMode GenericProperty::macroMode() const {
@@ -1296,6 +1476,7 @@ GenericProperty::MacroMode GenericProperty::macroMode() const {
 }
 
 void GenericProperty::setIsMacro(bool is_macro) {
+    const bool macro_changed = d->is_macro != is_macro;
     d->is_macro = is_macro;
 
     // Set the value and default value to the property name:
@@ -1304,6 +1485,9 @@ void GenericProperty::setIsMacro(bool is_macro) {
     setCategory(QtilitiesCategory(qti_def_GENERIC_PROPERTY_CATEGORY_MACROS));
     setEditable(false);
     setType(TypeString);
+
+    if (macro_changed)
+        emit macroModeChanged(this);
 }
 
 bool GenericProperty::isMacro() const {
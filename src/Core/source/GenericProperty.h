@@ -453,6 +453,21 @@ namespace Qtilities {
             void defaultValueChanged(GenericProperty* property);
             //! Emitted when the note message of the property changed.
             void noteChanged(GenericProperty* property);
+            //! Emitted when the name or the aliases of the property changed.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void propertyNameChanged(GenericProperty* property);
+            //! Emitted when the category of the property changed.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void categoryChanged(GenericProperty* property);
+            //! Emitted when the property became a macro, stopped being a macro, or when its macro mode changed.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void macroModeChanged(GenericProperty* property);
 
             // --------------------------------
             // Limits and Possible Values
@@ -593,6 +608,19 @@ namespace Qtilities {
             virtual InstanceFactoryInfo instanceFactoryInfo() const;
             virtual IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
             virtual IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            //! Exports the complete definition of the property, including its current value.
+            /*!
+              Unlike exportXml(), which only exports the state of the property, the binary format contains everything needed to
+              recreate the property. It is used by GenericPropertyManager::saveDefaultPropertiesBinary().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual IExportable::ExportResultFlags exportBinary(QDataStream& stream) const;
+            //! Imports the complete definition of the property, see exportBinary().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
 
             // --------------------------------
             // IModificationNotifier Implementation
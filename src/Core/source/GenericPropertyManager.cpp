@@ -16,18 +16,93 @@
 #include <ObserverHints>
 
 #include <QDomDocument>
+#include <QDataStream>
+#include <QFile>
+
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QVector>
 
 using namespace Qtilities::Core;
 
 namespace Qtilities {
 namespace Core {
 
+typedef QList<QPointer<GenericProperty> > qti_private_GenericPropertyList;
+
+namespace {
+    // Maps the lower case names of the properties in an observer to the position of the first property with each name, which is
+    // the property found by GenericPropertyManager::containsProperty():
+    QHash<QString,int> qti_private_PropertyNamePositions(const Observer* properties_observer) {
+        QHash<QString,int> name_positions;
+        const int count = properties_observer->subjectCount();
+        name_positions.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            GenericProperty* prop = qobject_cast<GenericProperty*> (properties_observer->subjectAt(i));
+            if (!prop)
+                continue;
+
+            const QString name = prop->propertyName().toLower();
+            if (!name_positions.contains(name))
+                name_positions.insert(name,i);
+        }
+        return name_positions;
+    }
+
+    //! Marker written at the start of binary default property files, see GenericPropertyManager::saveDefaultPropertiesBinary().
+    const quint32 qti_private_DEFAULT_PROPERTIES_BINARY_MARKER = 0x51475044;
+
+    bool qti_private_IsDefaultPropertiesBinary(const QByteArray& file_data) {
+        if (file_data.size() < (int) sizeof(quint32))
+            return false;
+
+        QDataStream stream(file_data);
+        stream.setVersion(QDataStream::Qt_4_7);
+        quint32 marker;
+        stream >> marker;
+        return marker == qti_private_DEFAULT_PROPERTIES_BINARY_MARKER;
+    }
+
+    IExportable::ExportResultFlags qti_private_LoadDefaultPropertiesBinary(const QByteArray& file_data, QList<GenericProperty*>& properties, ITask* task_ref) {
+        QDataStream stream(file_data);
+        stream.setVersion(QDataStream::Qt_4_7);
+        quint32 marker;
+        quint32 export_version;
+        quint32 count;
+        stream >> marker;
+        stream >> export_version;
+        stream >> count;
+        if (stream.status() != QDataStream::Ok || export_version > (quint32) Qtilities::Qtilities_Latest) {
+            LOG_TASK_ERROR("Binary property file was created by a newer version of this application, or is corrupt.",task_ref);
+            return IExportable::Failed;
+        }
+
+        for (quint32 i = 0; i < count; ++i) {
+            GenericProperty* prop = new GenericProperty;
+            QList<QPointer<QObject> > import_list;
+            prop->setExportVersion((Qtilities::ExportVersion) export_version);
+            if (prop->importBinary(stream,import_list) != IExportable::Complete) {
+                delete prop;
+                return IExportable::Incomplete;
+            }
+            properties << prop;
+        }
+
+        return IExportable::Complete;
+    }
+}
 
 struct GenericPropertyManagerData {
     GenericPropertyManagerData() : properties_observer("Generic Properties"),
         show_advanced_settings(false),
         show_switch_names(false),
-        task_base(0) { }
+        task_base(0),
+        index_valid(false),
+        indexed_count(0),
+        macro_table_valid(false),
+        update_depth(0),
+        refresh_pending(false) { }
 
     Observer            properties_observer;
     bool                show_advanced_settings;
@@ -36,6 +111,35 @@ struct GenericPropertyManagerData {
 
     QPointer<QObject>   task_base;
     ITask*              task;
+
+    //! Indicates if the lookup indexes below contain all properties in properties_observer.
+    bool                index_valid;
+    //! The number of subjects in properties_observer which are covered by the lookup indexes.
+    int                 indexed_count;
+    //! Properties indexed by their lower case names and aliases. Entries are validated on lookup, thus stale entries are ignored.
+    QHash<QString,qti_private_GenericPropertyList> name_index;
+    //! Properties indexed by their categories. Entries are validated on lookup, thus stale entries are ignored.
+    QHash<QtilitiesCategory,qti_private_GenericPropertyList> category_index;
+
+    //! Indicates if expanded_macros and the macro caches below are up to date.
+    bool                macro_table_valid;
+    //! The macros which are expanded, by name.
+    QHash<QString,QPointer<GenericProperty> > expanded_macros;
+    //! Cached results of macroValues(), by macro mode.
+    QHash<int,QHash<QString,QString> > macro_values;
+    //! Cached expanded values, by property.
+    QHash<const GenericProperty*,QString> expanded_values;
+    //! The macros used by each cached expanded value, including macros referenced through other macros.
+    QHash<const GenericProperty*,QStringList> expanded_value_macros;
+    //! The properties with cached expanded values which use each macro.
+    QHash<QString,QSet<const GenericProperty*> > macro_dependents;
+
+    //! The number of nested batches in progress, see beginUpdate().
+    int                 update_depth;
+    //! Indicates if a refresh was requested during the batch in progress.
+    bool                refresh_pending;
+    //! The changes made during the batch in progress. The safe pointers are used to skip properties which were deleted during the batch.
+    QHash<GenericProperty*,QPair<QPointer<GenericProperty>,GenericPropertyManager::PropertyChanges> > pending_changes;
 };
 
 GenericPropertyManager::GenericPropertyManager(QObject *parent):
@@ -43,6 +147,9 @@ GenericPropertyManager::GenericPropertyManager(QObject *parent):
 {
     d = new GenericPropertyManagerData;
     connect(&d->properties_observer,SIGNAL(modificationStateChanged(bool)),SIGNAL(modificationStateChanged(bool)));
+    connect(&d->properties_observer,SIGNAL(subjectsInserted(int,int)),SLOT(handlePropertiesInserted(int,int)));
+    connect(&d->properties_observer,SIGNAL(subjectsRemoved(int,int)),SLOT(handlePropertiesRemoved(int,int)));
+    connect(&d->properties_observer,SIGNAL(subjectsReset()),SLOT(invalidatePropertyIndex()));
 }
 
 GenericPropertyManager::~GenericPropertyManager() {
@@ -67,7 +174,7 @@ void GenericPropertyManager::clear() {
     }
 
     qDeleteAll(props_to_delete);
-    refresh();
+    requestRefresh();
 }
 
 Observer *GenericPropertyManager::propertiesObserver() const {
@@ -122,6 +229,26 @@ bool GenericPropertyManager::hasModifiedProperties(QStringList* modified_propert
 }
 
 GenericProperty *GenericPropertyManager::containsProperty(const QString &property_name, bool search_aliases, const QString &alias_environment) const {
+    if (ensurePropertyIndex()) {
+        // Names and aliases are matched case insensitive, see GenericProperty::matchesPropertyName():
+        qti_private_GenericPropertyList candidates = d->name_index.value(property_name.toLower());
+        GenericProperty* match = 0;
+        int match_position = -1;
+        for (int i = 0; i < candidates.count(); ++i) {
+            GenericProperty* prop = candidates.at(i);
+            if (!prop || !prop->matchesPropertyName(property_name,search_aliases,alias_environment))
+                continue;
+
+            // The first matching property in the observer wins, as when searching all properties:
+            int position = d->properties_observer.subjectPosition(prop);
+            if (position != -1 && (match_position == -1 || position < match_position)) {
+                match = prop;
+                match_position = position;
+            }
+        }
+        return match;
+    }
+
     // Search each property:
     for (int i = 0; i < d->properties_observer.subjectCount(); ++i) {
         GenericProperty* prop = qobject_cast<GenericProperty*> (d->properties_observer.subjectAt(i));
@@ -157,6 +284,21 @@ QList<GenericProperty *> GenericPropertyManager::allProperties(bool only_editabl
 }
 
 QList<GenericProperty *> GenericPropertyManager::allProperties(const QtilitiesCategory &filter_category, bool invert_filter) const {
+    if (!invert_filter && ensurePropertyIndex()) {
+        QMap<int,GenericProperty*> sorted_properties;
+        qti_private_GenericPropertyList candidates = d->category_index.value(filter_category);
+        for (int i = 0; i < candidates.count(); ++i) {
+            GenericProperty* prop = candidates.at(i);
+            if (!prop || filter_category != prop->category())
+                continue;
+
+            int position = d->properties_observer.subjectPosition(prop);
+            if (position != -1)
+                sorted_properties[position] = prop;
+        }
+        return sorted_properties.values();
+    }
+
     QList<GenericProperty*> properties;
     for (int i = 0; i < d->properties_observer.subjectCount(); ++i) {
         GenericProperty* prop = qobject_cast<GenericProperty*> (d->properties_observer.subjectAt(i));
@@ -198,7 +340,7 @@ GenericProperty *GenericPropertyManager::addProperty(const QString &property_nam
             }
 
             if (refresh_browser)
-                emit refresh();
+                requestRefresh();
             return prop;
         } else {
             LOG_ERROR(error_msg);
@@ -220,7 +362,7 @@ bool GenericPropertyManager::addProperty(GenericProperty *property, bool refresh
         if (d->properties_observer.attachSubject(property,Observer::SpecificObserverOwnership,&error_msg)) {
             connectToProperty(property);
             if (refresh_browser)
-                emit refresh();
+                requestRefresh();
             return true;
         } else {
             LOG_ERROR(error_msg);
@@ -236,7 +378,7 @@ void GenericPropertyManager::addProperties(QList<GenericProperty *> properties)
             do_refresh = true;
     }
     if (do_refresh)
-        refresh();
+        requestRefresh();
 }
 
 void GenericPropertyManager::addProperties(QList<QPointer<GenericProperty> > properties) {
@@ -246,7 +388,7 @@ void GenericPropertyManager::addProperties(QList<QPointer<GenericProperty> > pro
             do_refresh = true;
     }
     if (do_refresh)
-        refresh();
+        requestRefresh();
 }
 
 bool GenericPropertyManager::removeProperty(const QString &property_name, bool refresh_browser) {
@@ -255,7 +397,7 @@ bool GenericPropertyManager::removeProperty(const QString &property_name, bool r
         // SpecificObserverOwnership, thus will be removed from observer.
         delete prop;
         if (refresh_browser)
-            refresh();
+            requestRefresh();
         return true;
     } else {
         return false;
@@ -306,47 +448,81 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags GenericPropertyManag
         return IExportable::Failed;
     }
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    if (!file.open(QIODevice::ReadOnly))
         return IExportable::Failed;
 
+    // The complete file is mapped, or read in a single call when it can't be mapped:
+    QByteArray file_data;
+    uchar* mapped_data = 0;
+    if (file.size() > 0)
+        mapped_data = file.map(0,file.size());
+    if (mapped_data)
+        file_data = QByteArray::fromRawData((const char*) mapped_data,(int) file.size());
+    else
+        file_data = file.readAll();
+
     d->properties_observer.startProcessingCycle();
     clear();
 
     Qtilities::Core::Interfaces::IExportable::ExportResultFlags result = IExportable::Complete;
+    QList<GenericProperty*> properties;
+    if (qti_private_IsDefaultPropertiesBinary(file_data)) {
+        result = qti_private_LoadDefaultPropertiesBinary(file_data,properties,task_ref);
+    } else {
+        // We ignore the first line always since it contains the headers.
+        int line_start = file_data.indexOf('\n');
+        if (line_start == -1)
+            line_start = file_data.size();
+        else
+            ++line_start;
+
+        const int data_size = file_data.size();
+        const char* data = file_data.constData();
+        while (line_start < data_size) {
+            int line_end = file_data.indexOf('\n',line_start);
+            if (line_end == -1)
+                line_end = data_size;
+            else
+                ++line_end;
+
+            // Lines keep their terminating newline, as they did when they were read using QIODevice::Text:
+            int line_length = line_end - line_start;
+            QByteArray line_data;
+            if (line_length >= 2 && data[line_end - 1] == '\n' && data[line_end - 2] == '\r')
+                line_data = QByteArray(data + line_start,line_length - 2) + '\n';
+            else
+                line_data = QByteArray::fromRawData(data + line_start,line_length);
+            line_start = line_end;
+
+            // Construct a new property:
+            GenericProperty* prop = new GenericProperty;
+            if (prop->fromCsvString(QString(line_data)))
+                properties << prop;
+            else {
+                result = IExportable::Incomplete;
+                delete prop;
+            }
+        }
+    }
 
-    // We ignore the first line always since it contains the headers.
-    int count = 0;
-    while (!file.atEnd()) {
-        QString line = file.readLine();
-        ++count;
-        if (count == 1)
-            continue;
-
-        // Construct a new property:
-        GenericProperty* prop = new GenericProperty;
-        if (!prop->fromCsvString(line)) {
-            result = IExportable::Incomplete;
+    foreach (GenericProperty* prop, properties) {
+        QString error_msg;
+        if (!d->properties_observer.attachSubject(prop,Observer::SpecificObserverOwnership,&error_msg)) {
+            LOG_TASK_ERROR(error_msg,task_ref);
             delete prop;
         } else {
-            QString error_msg;
-            if (!d->properties_observer.attachSubject(prop,Observer::SpecificObserverOwnership,&error_msg)) {
-                LOG_TASK_ERROR(error_msg,task_ref);
-                delete prop;
-            } else {
-                connect(prop,SIGNAL(valueChanged(GenericProperty*)),SIGNAL(propertyValueChanged(GenericProperty*)));
-                connect(prop,SIGNAL(editableChanged(GenericProperty*)),SIGNAL(propertyEditableChanged(GenericProperty*)));
-                connect(prop,SIGNAL(contextDependentChanged(GenericProperty*)),SIGNAL(propertyContextDependentChanged(GenericProperty*)));
-                connect(prop,SIGNAL(possibleValuesDisplayedChanged(GenericProperty*)),SIGNAL(propertyPossibleValuesChanged(GenericProperty*)));
-                connect(prop,SIGNAL(defaultValueChanged(GenericProperty*)),SIGNAL(propertyDefaultValueChanged(GenericProperty*)));
-                connect(prop,SIGNAL(noteChanged(GenericProperty*)),SIGNAL(propertyNoteChanged(GenericProperty*)));
-
-                MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
-                category_property.setValue(qVariantFromValue(prop->category()),d->properties_observer.observerID());
-                ObjectManager::setMultiContextProperty(prop,category_property);
-            }
+            connectToProperty(prop);
+
+            MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
+            category_property.setValue(qVariantFromValue(prop->category()),d->properties_observer.observerID());
+            ObjectManager::setMultiContextProperty(prop,category_property);
         }
     }
 
+    file_data.clear();
+    if (mapped_data)
+        file.unmap(mapped_data);
+
     d->properties_file = file_name;
 
     // The properties file property:
@@ -373,10 +549,40 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags GenericPropertyManag
 
     d->properties_observer.endProcessingCycle();
 
-    emit refresh();
+    requestRefresh();
     return result;
 }
 
+IExportable::ExportResultFlags GenericPropertyManager::saveDefaultPropertiesBinary(const QString& file_name, ITask* task_ref) const {
+    QList<GenericProperty*> properties;
+    foreach (GenericProperty* prop, allProperties()) {
+        if (prop->isExportable())
+            properties << prop;
+    }
+
+    QByteArray file_data;
+    QDataStream stream(&file_data,QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_4_7);
+    stream << qti_private_DEFAULT_PROPERTIES_BINARY_MARKER;
+    stream << (quint32) Qtilities::Qtilities_Latest;
+    stream << (quint32) properties.count();
+    foreach (GenericProperty* prop, properties) {
+        prop->setExportVersion(Qtilities::Qtilities_Latest);
+        if (prop->exportBinary(stream) != IExportable::Complete) {
+            LOG_TASK_ERROR("Failed to export property \"" + prop->propertyName() + "\" to binary property file: " + file_name,task_ref);
+            return IExportable::Failed;
+        }
+    }
+
+    QFile file(file_name);
+    if (!file.open(QIODevice::WriteOnly) || file.write(file_data) != file_data.size()) {
+        LOG_TASK_ERROR("Failed to write binary property file: " + file_name,task_ref);
+        return IExportable::Failed;
+    }
+
+    return IExportable::Complete;
+}
+
 IExportable::ExportResultFlags GenericPropertyManager::loadNewPropertiesFile(const QString &file_name, ITask *task_ref) {
     QFile file(file_name);
 
@@ -396,9 +602,13 @@ IExportable::ExportResultFlags GenericPropertyManager::loadNewPropertiesFile(con
         return IExportable::Failed;
     }
 
+    // All changes are shown in property browsers in one go when the properties were matched:
+    beginUpdate();
+
     // Now call loadDefaultProperties() with the file to construct a new clean baseline:
     // clear() happens in here:
     if (loadDefaultProperties(file_name,task_ref) != IExportable::Complete) {
+        endUpdate();
         return IExportable::Failed;
     }
 
@@ -432,7 +642,8 @@ IExportable::ExportResultFlags GenericPropertyManager::loadNewPropertiesFile(con
         }
     }
 
-    emit refresh();
+    requestRefresh();
+    endUpdate();
     return result;
 }
 
@@ -488,6 +699,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags GenericPropertyManag
     IExportable::ExportResultFlags result = IExportable::Complete;
     QList<QPointer<QObject> > import_list;
     QDomNodeList itemNodes = object_node->childNodes();
+    beginUpdate();
     for(int i = 0; i < itemNodes.count(); ++i) {
         QDomNode itemNode = itemNodes.item(i);
         QDomElement item = itemNode.toElement();
@@ -518,6 +730,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags GenericPropertyManag
                 result = IExportable::Incomplete;
         }
     }
+    endUpdate();
 
     return result;
 }
@@ -554,6 +767,7 @@ IExportable::ExportResultFlags GenericPropertyManager::importMacros(GenericPrope
     IExportable::ExportResultFlags result = IExportable::Complete;
     QList<QPointer<QObject> > import_list;
     QDomNodeList itemNodes = object_node->childNodes();
+    beginUpdate();
     for(int i = 0; i < itemNodes.count(); ++i) {
         QDomNode itemNode = itemNodes.item(i);
         QDomElement item = itemNode.toElement();
@@ -581,15 +795,22 @@ IExportable::ExportResultFlags GenericPropertyManager::importMacros(GenericPrope
                 result = IExportable::Incomplete;
         }
     }
+    endUpdate();
 
     return result;
 }
 
 QHash<QString, QString> GenericPropertyManager::macroValues(GenericProperty::MacroMode macro_mode) {
+    const bool cacheable = ensureMacroTable();
+    if (cacheable && d->macro_values.contains(macro_mode))
+        return d->macro_values.value(macro_mode);
+
     QList<GenericProperty*> macros = macroProperties(macro_mode);
     QHash<QString,QString> values_hash;
     foreach (GenericProperty* prop, macros)
         values_hash[prop->propertyName()] = prop->valueString();
+    if (cacheable)
+        d->macro_values[macro_mode] = values_hash;
     return values_hash;
 }
 
@@ -603,15 +824,170 @@ QList<GenericProperty *> GenericPropertyManager::macroProperties(GenericProperty
     return macros;
 }
 
+QString GenericPropertyManager::expandedValueString(GenericProperty* property, QString* errorMsg) {
+    if (!property)
+        return QString();
+
+    QStringList used_macros;
+    QStringList expansion_stack;
+    QStringList cycles;
+    QString expanded_value = expandPropertyValue(property,used_macros,expansion_stack,cycles);
+    if (errorMsg && !cycles.isEmpty())
+        *errorMsg = QString("Cyclic macro references could not be expanded: %1").arg(cycles.join(", "));
+    return expanded_value;
+}
+
+QString GenericPropertyManager::expandMacros(const QString& value, QString* errorMsg) {
+    ensureMacroTable();
+
+    QStringList used_macros;
+    QStringList expansion_stack;
+    QStringList cycles;
+    QString expanded_value = expandMacroReferences(value,used_macros,expansion_stack,cycles);
+    if (errorMsg && !cycles.isEmpty())
+        *errorMsg = QString("Cyclic macro references could not be expanded: %1").arg(cycles.join(", "));
+    return expanded_value;
+}
+
+QStringList GenericPropertyManager::referencedMacros(GenericProperty* property) {
+    if (!property)
+        return QStringList();
+
+    QStringList used_macros;
+    QStringList expansion_stack;
+    QStringList cycles;
+    expandPropertyValue(property,used_macros,expansion_stack,cycles);
+    return used_macros;
+}
+
+bool GenericPropertyManager::ensureMacroTable() {
+    if (d->macro_table_valid)
+        return true;
+
+    d->expanded_macros.clear();
+    d->macro_values.clear();
+    d->expanded_values.clear();
+    d->expanded_value_macros.clear();
+    d->macro_dependents.clear();
+
+    QList<GenericProperty*> properties = allProperties();
+    foreach (GenericProperty* prop, properties) {
+        // Any property can become a macro, thus all of them are monitored:
+        connect(prop,SIGNAL(macroModeChanged(GenericProperty*)),SLOT(clearMacroCache()),Qt::UniqueConnection);
+        connect(prop,SIGNAL(propertyNameChanged(GenericProperty*)),SLOT(handleMacroNameChanged(GenericProperty*)),Qt::UniqueConnection);
+        connect(prop,SIGNAL(valueChanged(GenericProperty*)),SLOT(handleExpansionValueChanged(GenericProperty*)),Qt::UniqueConnection);
+        if (prop->isMacro() && (prop->macroMode() & GenericProperty::MacroExpandedAll) && !d->expanded_macros.contains(prop->propertyName()))
+            d->expanded_macros[prop->propertyName()] = prop;
+    }
+
+    // Subjects attached during processing cycles are only reported when the cycle ends:
+    d->macro_table_valid = !d->properties_observer.isProcessingCycleActive();
+    return d->macro_table_valid;
+}
+
+QString GenericPropertyManager::expandPropertyValue(GenericProperty* property, QStringList& used_macros, QStringList& expansion_stack, QStringList& cycles) {
+    const bool cacheable = ensureMacroTable();
+    if (cacheable && d->expanded_values.contains(property)) {
+        foreach (const QString& macro_name, d->expanded_value_macros.value(property)) {
+            if (!used_macros.contains(macro_name))
+                used_macros << macro_name;
+        }
+        return d->expanded_values.value(property);
+    }
+
+    QStringList property_macros;
+    const int cycle_count = cycles.count();
+    const bool is_expanded_macro = (d->expanded_macros.value(property->propertyName()) == property);
+    if (is_expanded_macro)
+        expansion_stack.push_back(property->propertyName());
+    QString expanded_value = expandMacroReferences(property->valueString(),property_macros,expansion_stack,cycles);
+    if (is_expanded_macro)
+        expansion_stack.pop_back();
+
+    // Values which are part of a cycle depend on where the expansion started, thus they are not cached:
+    if (cacheable && cycles.count() == cycle_count) {
+        d->expanded_values[property] = expanded_value;
+        d->expanded_value_macros[property] = property_macros;
+        foreach (const QString& macro_name, property_macros)
+            d->macro_dependents[macro_name].insert(property);
+    }
+
+    foreach (const QString& macro_name, property_macros) {
+        if (!used_macros.contains(macro_name))
+            used_macros << macro_name;
+    }
+    return expanded_value;
+}
+
+QString GenericPropertyManager::expandMacroReferences(const QString& value, QStringList& used_macros, QStringList& expansion_stack, QStringList& cycles) {
+    if (!value.contains("%{"))
+        return value;
+
+    QString expanded_value;
+    int position = 0;
+    while (position < value.length()) {
+        int start = value.indexOf("%{",position);
+        if (start == -1)
+            break;
+        int end = value.indexOf(QLatin1Char('}'),start + 2);
+        if (end == -1)
+            break;
+
+        expanded_value.append(value.mid(position,start - position));
+        position = end + 1;
+
+        QString macro_name = value.mid(start + 2,end - start - 2);
+        GenericProperty* macro = d->expanded_macros.value(macro_name);
+        if (!macro) {
+            expanded_value.append(value.mid(start,end - start + 1));
+            continue;
+        }
+
+        if (!used_macros.contains(macro_name))
+            used_macros << macro_name;
+        if (expansion_stack.contains(macro_name)) {
+            QString cycle = QStringList(expansion_stack.mid(expansion_stack.indexOf(macro_name))).join(" -> ") + " -> " + macro_name;
+            if (!cycles.contains(cycle))
+                cycles << cycle;
+            expanded_value.append(value.mid(start,end - start + 1));
+            continue;
+        }
+
+        expanded_value.append(expandPropertyValue(macro,used_macros,expansion_stack,cycles));
+    }
+    expanded_value.append(value.mid(position));
+    return expanded_value;
+}
+
+void GenericPropertyManager::handleExpansionValueChanged(GenericProperty* property) {
+    d->expanded_values.remove(property);
+    d->expanded_value_macros.remove(property);
+    if (!property || !property->isMacro())
+        return;
+
+    // Dependents are recorded for all macros used by an expanded value, thus chains of macros are invalidated here as well:
+    d->macro_values.clear();
+    foreach (const GenericProperty* dependent, d->macro_dependents.take(property->propertyName())) {
+        d->expanded_values.remove(dependent);
+        d->expanded_value_macros.remove(dependent);
+    }
+}
+
+void GenericPropertyManager::handleMacroNameChanged(GenericProperty* property) {
+    if (property && property->isMacro())
+        clearMacroCache();
+}
+
+void GenericPropertyManager::clearMacroCache() {
+    d->macro_table_valid = false;
+}
+
 void GenericPropertyManager::clone(GenericPropertyManager *property_manager, bool only_state_dependent_properties) {
     Q_ASSERT(property_manager);
     if (!property_manager)
         return;
 
-    d->properties_observer.startProcessingCycle();
-    // Don't use normal clear() here since it does not remove all properties.
-    d->properties_observer.deleteAll();
-
+    QList<GenericProperty*> source_properties;
     for (int i = 0; i < property_manager->propertiesObserver()->subjectCount(); ++i) {
         GenericProperty* prop = qobject_cast<GenericProperty*> (property_manager->propertiesObserver()->subjectAt(i));
         Q_ASSERT(prop);
@@ -622,9 +998,61 @@ void GenericPropertyManager::clone(GenericPropertyManager *property_manager, boo
             if (!prop->stateDependent() || (prop->category().toString() == qti_def_GENERIC_PROPERTY_CATEGORY_INTERNAL))
                 continue;
         }
+        source_properties << prop;
+    }
 
-        GenericProperty* duplicate = new GenericProperty(*prop);
-        d->properties_observer.attachSubject(duplicate);
+    // Match the source properties to our properties by name. Our properties are only reused when the matches are in the order of
+    // the source properties and new properties come after all matches, thus the resulting order is the same as when rebuilding:
+    const QHash<QString,int> name_positions = qti_private_PropertyNamePositions(&d->properties_observer);
+    QVector<GenericProperty*> matches(source_properties.count(),0);
+    QSet<int> matched_positions;
+    bool merge = true;
+    bool appending = false;
+    int last_position = -1;
+    for (int i = 0; i < source_properties.count() && merge; ++i) {
+        QHash<QString,int>::const_iterator itr = name_positions.constFind(source_properties.at(i)->propertyName().toLower());
+        if (itr == name_positions.constEnd() || matched_positions.contains(itr.value())) {
+            appending = true;
+            continue;
+        }
+
+        if (appending || itr.value() < last_position)
+            merge = false;
+        else {
+            last_position = itr.value();
+            matched_positions.insert(itr.value());
+            matches[i] = qobject_cast<GenericProperty*> (d->properties_observer.subjectAt(itr.value()));
+        }
+    }
+
+    d->properties_observer.startProcessingCycle();
+    if (merge) {
+        // Delete the properties which are not in the source:
+        QList<GenericProperty*> unmatched_properties;
+        for (int i = 0; i < d->properties_observer.subjectCount(); ++i) {
+            if (!matched_positions.contains(i))
+                unmatched_properties << qobject_cast<GenericProperty*> (d->properties_observer.subjectAt(i));
+        }
+        qDeleteAll(unmatched_properties);
+
+        for (int i = 0; i < source_properties.count(); ++i) {
+            GenericProperty* prop = source_properties.at(i);
+            if (matches.at(i)) {
+                if (*matches.at(i) != *prop)
+                    *matches.at(i) = *prop;
+            } else {
+                GenericProperty* duplicate = new GenericProperty(*prop);
+                d->properties_observer.attachSubject(duplicate);
+            }
+        }
+    } else {
+        // Don't use normal clear() here since it does not remove all properties.
+        d->properties_observer.deleteAll();
+
+        for (int i = 0; i < source_properties.count(); ++i) {
+            GenericProperty* duplicate = new GenericProperty(*source_properties.at(i));
+            d->properties_observer.attachSubject(duplicate);
+        }
     }
     d->properties_observer.endProcessingCycle();
 }
@@ -633,14 +1061,35 @@ bool GenericPropertyManager::compare(GenericPropertyManager *property_manager,
                                        PropertyDiffInfo *property_diff_info,
                                        bool state_independent_properties,
                                        bool context_dependent_properties) const {
+    return compareProperties(property_manager,property_diff_info,0,state_independent_properties,context_dependent_properties);
+}
+
+bool GenericPropertyManager::compare(GenericPropertyManager *property_manager,
+                                       GenericPropertyDiff &property_diff,
+                                       bool state_independent_properties,
+                                       bool context_dependent_properties) const {
+    return compareProperties(property_manager,0,&property_diff,state_independent_properties,context_dependent_properties);
+}
+
+bool GenericPropertyManager::compareProperties(GenericPropertyManager *property_manager,
+                                                 PropertyDiffInfo *property_diff_info,
+                                                 GenericPropertyDiff *property_diff,
+                                                 bool state_independent_properties,
+                                                 bool context_dependent_properties) const {
     if (!property_manager)
         return false;
 
+    const bool collect_diff = property_diff_info || property_diff;
     bool identical = true;
 
+    // Properties are matched through the names of both managers, instead of searching the other manager for every property:
+    const Observer* ref_observer = property_manager->propertiesObserver();
+    const QHash<QString,int> name_positions = qti_private_PropertyNamePositions(&d->properties_observer);
+    const QHash<QString,int> ref_name_positions = qti_private_PropertyNamePositions(ref_observer);
+
     // Check for removed & changed properties:
     for (int i = 0; i < d->properties_observer.subjectCount(); ++i) {
-        if (!property_diff_info && !identical)
+        if (!collect_diff && !identical)
             return false;
 
         GenericProperty* prop = qobject_cast<GenericProperty*> (d->properties_observer.subjectAt(i));
@@ -661,27 +1110,40 @@ bool GenericPropertyManager::compare(GenericPropertyManager *property_manager,
             continue;
 
         // Find the corresponding property:
-        GenericProperty* ref_prop = property_manager->containsProperty(prop->propertyName());
+        QHash<QString,int>::const_iterator ref_itr = ref_name_positions.constFind(prop->propertyName().toLower());
+        GenericProperty* ref_prop = 0;
+        if (ref_itr != ref_name_positions.constEnd())
+            ref_prop = qobject_cast<GenericProperty*> (ref_observer->subjectAt(ref_itr.value()));
         if (ref_prop) {
             if (!prop->compareValue(ref_prop)) {
                 identical = false;
                 if (property_diff_info) {
                     property_diff_info->d_changed_properties[prop->propertyName()] = prop->valueString() + "," + ref_prop->valueString();
                 }
+                if (property_diff) {
+                    GenericPropertyDiff::Entry entry(prop,ref_prop);
+                    entry.property_name = prop->propertyName();
+                    property_diff->changed_properties << entry;
+                }
             }
         } else {
             identical = false;
             if (property_diff_info)
                 property_diff_info->d_removed_properties[prop->propertyName()] = prop->valueString();
+            if (property_diff) {
+                GenericPropertyDiff::Entry entry(prop,0);
+                entry.property_name = prop->propertyName();
+                property_diff->removed_properties << entry;
+            }
         }
     }
 
     // Check for added properties:
-    for (int i = 0; i < property_manager->propertiesObserver()->subjectCount(); ++i) {
-        if (!property_diff_info && !identical)
+    for (int i = 0; i < ref_observer->subjectCount(); ++i) {
+        if (!collect_diff && !identical)
             return false;
 
-        GenericProperty* ref_prop = qobject_cast<GenericProperty*> (property_manager->propertiesObserver()->subjectAt(i));
+        GenericProperty* ref_prop = qobject_cast<GenericProperty*> (ref_observer->subjectAt(i));
         Q_ASSERT(ref_prop);
         if (!ref_prop)
             continue;
@@ -693,11 +1155,15 @@ bool GenericPropertyManager::compare(GenericPropertyManager *property_manager,
             continue;
 
         // Find the corresponding property:
-        GenericProperty* prop = containsProperty(ref_prop->propertyName());
-        if (!prop) {
+        if (!name_positions.contains(ref_prop->propertyName().toLower())) {
             identical = false;
             if (property_diff_info)
                 property_diff_info->d_added_properties[ref_prop->propertyName()] = ref_prop->valueString();
+            if (property_diff) {
+                GenericPropertyDiff::Entry entry(0,ref_prop);
+                entry.property_name = ref_prop->propertyName();
+                property_diff->added_properties << entry;
+            }
         }
     }
 
@@ -741,16 +1207,190 @@ void GenericPropertyManager::setModificationState(bool new_state, IModificationN
     }
 }
 
+bool GenericPropertyManager::ensurePropertyIndex() const {
+    // Subjects attached during processing cycles are only reported when the cycle ends:
+    if (d->properties_observer.isProcessingCycleActive())
+        return false;
+
+    if (d->index_valid && d->indexed_count == d->properties_observer.subjectCount())
+        return true;
+
+    d->name_index.clear();
+    d->category_index.clear();
+    d->indexed_count = 0;
+    d->index_valid = true;
+    const int count = d->properties_observer.subjectCount();
+    for (int i = 0; i < count; ++i)
+        indexProperty(qobject_cast<GenericProperty*> (d->properties_observer.subjectAt(i)));
+    d->indexed_count = count;
+    return true;
+}
+
+void GenericPropertyManager::indexProperty(GenericProperty* property) const {
+    if (!property)
+        return;
+
+    QStringList keys;
+    keys << property->propertyName().toLower();
+    foreach (const QString& alias, property->aliasNames())
+        keys << alias.toLower();
+    foreach (const QString& key, keys) {
+        qti_private_GenericPropertyList& properties = d->name_index[key];
+        if (!properties.contains(property))
+            properties << property;
+    }
+
+    qti_private_GenericPropertyList& category_properties = d->category_index[property->category()];
+    if (!category_properties.contains(property))
+        category_properties << property;
+
+    // Old entries are left in place when the property changes, they are ignored during lookups:
+    connect(property,SIGNAL(propertyNameChanged(GenericProperty*)),SLOT(handlePropertyLookupChanged(GenericProperty*)),Qt::UniqueConnection);
+    connect(property,SIGNAL(categoryChanged(GenericProperty*)),SLOT(handlePropertyLookupChanged(GenericProperty*)),Qt::UniqueConnection);
+}
+
+void GenericPropertyManager::handlePropertiesInserted(int first, int last) {
+    clearMacroCache();
+    if (!d->index_valid)
+        return;
+
+    // Ranges reported at the end of processing cycles might not match the current positions:
+    if (d->properties_observer.isProcessingCycleActive()) {
+        invalidatePropertyIndex();
+        return;
+    }
+
+    for (int i = first; i <= last; ++i)
+        indexProperty(qobject_cast<GenericProperty*> (d->properties_observer.subjectAt(i)));
+    d->indexed_count += last - first + 1;
+}
+
+void GenericPropertyManager::handlePropertiesRemoved(int first, int last) {
+    clearMacroCache();
+    // Removed properties are ignored during lookups, thus only the count needs to be updated:
+    if (d->index_valid)
+        d->indexed_count -= last - first + 1;
+}
+
+void GenericPropertyManager::invalidatePropertyIndex() {
+    d->index_valid = false;
+    clearMacroCache();
+}
+
+void GenericPropertyManager::handlePropertyLookupChanged(GenericProperty* property) {
+    if (d->index_valid && d->properties_observer.contains(property))
+        indexProperty(property);
+}
+
 void GenericPropertyManager::connectToProperty(GenericProperty *property) {
     if (!property)
         return;
 
-    connect(property,SIGNAL(valueChanged(GenericProperty*)),SIGNAL(propertyValueChanged(GenericProperty*)));
-    connect(property,SIGNAL(editableChanged(GenericProperty*)),SIGNAL(propertyEditableChanged(GenericProperty*)));
-    connect(property,SIGNAL(contextDependentChanged(GenericProperty*)),SIGNAL(propertyContextDependentChanged(GenericProperty*)));
-    connect(property,SIGNAL(possibleValuesDisplayedChanged(GenericProperty*)),SIGNAL(propertyPossibleValuesChanged(GenericProperty*)));
-    connect(property,SIGNAL(defaultValueChanged(GenericProperty*)),SIGNAL(propertyDefaultValueChanged(GenericProperty*)));
-    connect(property,SIGNAL(noteChanged(GenericProperty*)),SIGNAL(propertyNoteChanged(GenericProperty*)));
+    // The signals are forwarded through slots so that they can be aggregated while a batch is in progress:
+    connect(property,SIGNAL(valueChanged(GenericProperty*)),SLOT(handlePropertyValueChanged(GenericProperty*)),Qt::UniqueConnection);
+    connect(property,SIGNAL(editableChanged(GenericProperty*)),SLOT(handlePropertyEditableChanged(GenericProperty*)),Qt::UniqueConnection);
+    connect(property,SIGNAL(contextDependentChanged(GenericProperty*)),SLOT(handlePropertyContextDependentChanged(GenericProperty*)),Qt::UniqueConnection);
+    connect(property,SIGNAL(possibleValuesDisplayedChanged(GenericProperty*)),SLOT(handlePropertyPossibleValuesChanged(GenericProperty*)),Qt::UniqueConnection);
+    connect(property,SIGNAL(defaultValueChanged(GenericProperty*)),SLOT(handlePropertyDefaultValueChanged(GenericProperty*)),Qt::UniqueConnection);
+    connect(property,SIGNAL(noteChanged(GenericProperty*)),SLOT(handlePropertyNoteChanged(GenericProperty*)),Qt::UniqueConnection);
+}
+
+void GenericPropertyManager::beginUpdate() {
+    ++d->update_depth;
+}
+
+void GenericPropertyManager::endUpdate() {
+    if (d->update_depth == 0)
+        return;
+    if (--d->update_depth > 0)
+        return;
+
+    // A refresh covers all changes made during the batch:
+    if (d->refresh_pending) {
+        d->refresh_pending = false;
+        d->pending_changes.clear();
+        emit refresh();
+        return;
+    }
+
+    if (d->pending_changes.isEmpty())
+        return;
+
+    PropertyChangeSet changes;
+    changes.reserve(d->pending_changes.count());
+    QHash<GenericProperty*,QPair<QPointer<GenericProperty>,PropertyChanges> >::const_iterator itr = d->pending_changes.constBegin();
+    while (itr != d->pending_changes.constEnd()) {
+        if (itr.value().first)
+            changes[itr.key()] = itr.value().second;
+        ++itr;
+    }
+    d->pending_changes.clear();
+
+    if (!changes.isEmpty())
+        emit propertiesChanged(changes);
+}
+
+bool GenericPropertyManager::isUpdating() const {
+    return d->update_depth > 0;
+}
+
+void GenericPropertyManager::recordPropertyChange(GenericProperty* property, PropertyChange change) {
+    QPair<QPointer<GenericProperty>,PropertyChanges>& pending_change = d->pending_changes[property];
+    // Entries of deleted properties are replaced when a new property gets the same address:
+    if (!pending_change.first) {
+        pending_change.first = property;
+        pending_change.second = NoPropertyChange;
+    }
+    pending_change.second |= change;
+}
+
+void GenericPropertyManager::requestRefresh() {
+    if (d->update_depth > 0)
+        d->refresh_pending = true;
+    else
+        emit refresh();
+}
+
+void GenericPropertyManager::handlePropertyValueChanged(GenericProperty* property) {
+    if (d->update_depth > 0)
+        recordPropertyChange(property,PropertyValueChange);
+    else
+        emit propertyValueChanged(property);
+}
+
+void GenericPropertyManager::handlePropertyEditableChanged(GenericProperty* property) {
+    if (d->update_depth > 0)
+        recordPropertyChange(property,PropertyEditableChange);
+    else
+        emit propertyEditableChanged(property);
+}
+
+void GenericPropertyManager::handlePropertyContextDependentChanged(GenericProperty* property) {
+    if (d->update_depth > 0)
+        recordPropertyChange(property,PropertyContextDependentChange);
+    else
+        emit propertyContextDependentChanged(property);
+}
+
+void GenericPropertyManager::handlePropertyPossibleValuesChanged(GenericProperty* property) {
+    if (d->update_depth > 0)
+        recordPropertyChange(property,PropertyPossibleValuesChange);
+    else
+        emit propertyPossibleValuesChanged(property);
+}
+
+void GenericPropertyManager::handlePropertyDefaultValueChanged(GenericProperty* property) {
+    if (d->update_depth > 0)
+        recordPropertyChange(property,PropertyDefaultValueChange);
+    else
+        emit propertyDefaultValueChanged(property);
+}
+
+void GenericPropertyManager::handlePropertyNoteChanged(GenericProperty* property) {
+    if (d->update_depth > 0)
+        recordPropertyChange(property,PropertyNoteChange);
+    else
+        emit propertyNoteChanged(property);
 }
 
 }
@@ -13,6 +13,8 @@
 #define GENERIC_PROPERTY_MANAGER_H
 
 #include <QObject>
+#include <QHash>
+#include <QPointer>
 
 #include "QtilitiesCore_global.h"
 
@@ -34,18 +36,88 @@ namespace Qtilities {
           */
         struct GenericPropertyManagerData;
 
+        /*!
+        \struct GenericPropertyDiff
+        \brief The differences between the properties of two property managers, as found by GenericPropertyManager::compare().
+
+        Unlike PropertyDiffInfo, which describes the differences using value strings, the entries refer to the properties themselves.
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct QTILIITES_CORE_SHARED_EXPORT GenericPropertyDiff {
+            //! A property which was added, removed or changed.
+            struct Entry {
+                Entry(GenericProperty* entry_property = 0, GenericProperty* entry_other_property = 0) :
+                    property(entry_property),
+                    other_property(entry_other_property) {}
+
+                //! The name of the property.
+                QString property_name;
+                //! The property in the manager on which compare() was called, null for added properties.
+                QPointer<GenericProperty> property;
+                //! The property in the manager which was compared against, null for removed properties.
+                QPointer<GenericProperty> other_property;
+            };
+
+            //! Indicates if any differences were found.
+            bool hasChanges() const {
+                return !added_properties.isEmpty() || !removed_properties.isEmpty() || !changed_properties.isEmpty();
+            }
+            //! Removes all entries.
+            void clear() {
+                added_properties.clear();
+                removed_properties.clear();
+                changed_properties.clear();
+            }
+
+            //! Properties which are only in the manager which was compared against.
+            QList<Entry> added_properties;
+            //! Properties which are only in the manager on which compare() was called.
+            QList<Entry> removed_properties;
+            //! Properties which are in both managers with different values.
+            QList<Entry> changed_properties;
+        };
+
         /*!
         \class GenericPropertyManager
         \brief A class that manages a set of GenericProperty properties.
 
+        Changes to many properties, for example when loading a configuration, can be grouped in a batch using beginUpdate() and endUpdate().
+        Listeners then receive a single propertiesChanged() signal with the aggregated changes when the batch ends, instead of a signal for every change:
+
+\code
+property_manager->beginUpdate();
+foreach (const QString& name, values.keys())
+    property_manager->setPropertyValueString(name,values[name]);
+property_manager->endUpdate();
+\endcode
+
         <i>This class was added in %Qtilities v1.5.</i>
           */
         class QTILIITES_CORE_SHARED_EXPORT GenericPropertyManager : public QObject, public IModificationNotifier
         {
             Q_OBJECT
             Q_INTERFACES(Qtilities::Core::Interfaces::IModificationNotifier)
+            Q_FLAGS(PropertyChanges)
 
         public:
+            //! The kinds of changes which can be made to a property, used to describe the changes in a batch. See beginUpdate().
+            /*!
+              <i>This enumeration was added in %Qtilities v1.5.</i>
+              */
+            enum PropertyChange {
+                NoPropertyChange                = 0,    /*!< No changes. */
+                PropertyValueChange             = 1,    /*!< The value changed, see propertyValueChanged(). */
+                PropertyEditableChange          = 2,    /*!< The editability changed, see propertyEditableChanged(). */
+                PropertyContextDependentChange  = 4,    /*!< The context dependency changed, see propertyContextDependentChanged(). */
+                PropertyPossibleValuesChange    = 8,    /*!< The possible values changed, see propertyPossibleValuesChanged(). */
+                PropertyDefaultValueChange      = 16,   /*!< The default value changed, see propertyDefaultValueChanged(). */
+                PropertyNoteChange              = 32    /*!< The note changed, see propertyNoteChanged(). */
+            };
+            Q_DECLARE_FLAGS(PropertyChanges, PropertyChange)
+            //! The changes made to each property during a batch of changes.
+            typedef QHash<GenericProperty*,PropertyChanges> PropertyChangeSet;
+
             //! Constructs a GenericPropertyManager object.
             explicit GenericPropertyManager(QObject *parent = 0);
             ~GenericPropertyManager();
@@ -101,6 +173,33 @@ namespace Qtilities {
               */
             bool hasModifiedProperties(QStringList* modified_property_list = 0) const;
 
+            //! Starts a batch of changes.
+            /*!
+              While a batch is in progress the per property change signals, for example propertyValueChanged(), are not emitted. The changes are aggregated
+              per property instead and emitted in a single propertiesChanged() signal by the endUpdate() call which ends the batch. Requests to refresh property browsers,
+              for example when properties are added, are emitted once as a single refresh() signal when the batch ends.
+
+              Batches can be nested, only the outer batch emits the changes.
+
+              \sa endUpdate(), isUpdating()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void beginUpdate();
+            //! Ends a batch of changes started with beginUpdate().
+            /*!
+              When the outer batch ends, refresh() is emitted if a refresh was requested during the batch. Otherwise propertiesChanged() is emitted with the
+              changes made during the batch, if any. Properties which were deleted during the batch are not part of the changes.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void endUpdate();
+            //! Indicates if a batch of changes is in progress. See beginUpdate().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool isUpdating() const;
+
         signals:
             //! Signal which is emitted when showing/hiding advanced settings is changed/toggled.
             void toggleAdvancedSettings(bool show);
@@ -120,6 +219,11 @@ namespace Qtilities {
             void propertyNoteChanged(GenericProperty* property);
             //! Requests a full refresh in any property browsers showing this manager.
             void refresh();
+            //! Emitted when a batch of changes ends, with the changes made to each property during the batch. See beginUpdate().
+            /*!
+              <i>This signal was added in %Qtilities v1.5.</i>
+              */
+            void propertiesChanged(const GenericPropertyManager::PropertyChangeSet& changes);
 
         public:
             //! Adds a property. If a property with the same name already exists, this function returns the existing property.
@@ -175,7 +279,20 @@ namespace Qtilities {
             // Saving and Loading
             // --------------------------------
             //! Loads the default set of properties from the given file.
+            /*!
+              The file can either be a CSV definition file, see GenericProperty::fromCsvString(), or a binary file created using saveDefaultPropertiesBinary().
+              The format is detected automatically.
+              */
             Qtilities::Core::Interfaces::IExportable::ExportResultFlags loadDefaultProperties(const QString& file_name, ITask* task_ref = 0, bool add_property_file_property = false);
+            //! Saves the current set of properties to a binary file which can be loaded using loadDefaultProperties().
+            /*!
+              Loading the binary form of a large set of properties is much faster than parsing its CSV definition file, thus applications can
+              precompile their definition files by calling this function directly after loadDefaultProperties(). Properties which are not exportable,
+              like the properties file property, are not saved.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            Qtilities::Core::Interfaces::IExportable::ExportResultFlags saveDefaultPropertiesBinary(const QString& file_name, ITask* task_ref = 0) const;
             //! Loads properties from a new file and updates all existing properties to match them.
             /*!
               This function will:
@@ -217,11 +334,42 @@ namespace Qtilities {
             QHash<QString,QString> macroValues(GenericProperty::MacroMode macro_mode = GenericProperty::MacrosAll);
             //! Returns a list with all macro properties.
             QList<GenericProperty*> macroProperties(GenericProperty::MacroMode macro_mode = GenericProperty::MacrosAll);
+            //! Returns the value of a property with all references to expanded macros replaced by the values of those macros.
+            /*!
+              Macros are referenced using %{macro_name}, see GenericProperty::macroValueString(). Only macros with a macro mode in GenericProperty::MacroExpandedAll
+              are expanded, references to other macros and to unknown macros are left as they are. Macros which reference other macros are expanded recursively.
+
+              Expanded values are cached. When the value of a macro changes, only the properties which reference the macro, directly or through other macros, are expanded again.
+
+              \param property The property which must be expanded.
+              \param errorMsg When a macro references itself, directly or through other macros, the reference is left unexpanded and this message describes the cycle.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString expandedValueString(GenericProperty* property, QString* errorMsg = 0);
+            //! Replaces all references to expanded macros in \p value with the values of those macros.
+            /*!
+              See expandedValueString() for details. The result is not cached, but the values of the macros used are.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString expandMacros(const QString& value, QString* errorMsg = 0);
+            //! Returns the names of the expanded macros referenced by a property, including macros referenced through other macros.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QStringList referencedMacros(GenericProperty* property);
 
             // --------------------------------
             // Interaction between different property managers:
             // --------------------------------
             //! Clones properties from a different property manager.
+            /*!
+              Properties are matched by name. Properties which exist in both managers are updated in place when they differ, properties
+              which only exist in \p property_manager are duplicated and properties which no longer exist are deleted. Thus cloning a manager
+              which holds the same properties only touches the properties which changed. When the properties can't be matched in the order
+              of \p property_manager, all properties are rebuilt as was done before %Qtilities v1.5.
+              */
             virtual void clone(GenericPropertyManager* property_manager, bool only_state_dependent_properties = true);
             //! Compares the properties in this manager with the properties in a different manager.
             /*!
@@ -234,6 +382,16 @@ namespace Qtilities {
                                  PropertyDiffInfo* property_diff_info = 0,
                                  bool state_independent_properties = false,
                                  bool context_dependent_properties = true) const;
+            //! Compares the properties in this manager with the properties in a different manager, and returns the differences in \p property_diff.
+            /*!
+              The same properties are compared as in the compare() overload which takes a PropertyDiffInfo. Entries are appended to \p property_diff.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool compare(GenericPropertyManager* property_manager,
+                         GenericPropertyDiff& property_diff,
+                         bool state_independent_properties = false,
+                         bool context_dependent_properties = true) const;
 
             //----------------------------
             // Tasking
@@ -274,12 +432,49 @@ namespace Qtilities {
             //! A request that GenericPropertyBrowsers showing properties for this property manager must reload themselves.
             void reloadPropertyBrowsersRequest();
 
+        private slots:
+            void handlePropertiesInserted(int first, int last);
+            void handlePropertiesRemoved(int first, int last);
+            void invalidatePropertyIndex();
+            void handlePropertyLookupChanged(GenericProperty* property);
+            void handleExpansionValueChanged(GenericProperty* property);
+            void handleMacroNameChanged(GenericProperty* property);
+            void clearMacroCache();
+            void handlePropertyValueChanged(GenericProperty* property);
+            void handlePropertyEditableChanged(GenericProperty* property);
+            void handlePropertyContextDependentChanged(GenericProperty* property);
+            void handlePropertyPossibleValuesChanged(GenericProperty* property);
+            void handlePropertyDefaultValueChanged(GenericProperty* property);
+            void handlePropertyNoteChanged(GenericProperty* property);
+
         private:
+            //! Records a change to a property in the batch in progress.
+            void recordPropertyChange(GenericProperty* property, PropertyChange change);
+            //! Emits refresh(), or defers it to the end of the batch in progress.
+            void requestRefresh();
             //! Connects to a property.
             void connectToProperty(GenericProperty* property);
+            //! Does the comparison for both compare() overloads. When neither diff is given, it returns as soon as a difference is found.
+            bool compareProperties(GenericPropertyManager* property_manager,
+                                   PropertyDiffInfo* property_diff_info,
+                                   GenericPropertyDiff* property_diff,
+                                   bool state_independent_properties,
+                                   bool context_dependent_properties) const;
+            //! Makes sure the name and category indexes are up to date, returns false when they can't be used.
+            bool ensurePropertyIndex() const;
+            //! Adds a property to the name and category indexes.
+            void indexProperty(GenericProperty* property) const;
+            //! Makes sure the table of expanded macros is up to date, returns false when the table can't be cached.
+            bool ensureMacroTable();
+            //! Expands the value of a property, using and updating the cache of expanded values.
+            QString expandPropertyValue(GenericProperty* property, QStringList& used_macros, QStringList& expansion_stack, QStringList& cycles);
+            //! Expands the macro references in a value.
+            QString expandMacroReferences(const QString& value, QStringList& used_macros, QStringList& expansion_stack, QStringList& cycles);
 
             GenericPropertyManagerData* d;
         };
+
+        Q_DECLARE_OPERATORS_FOR_FLAGS(GenericPropertyManager::PropertyChanges)
     }
 }
 
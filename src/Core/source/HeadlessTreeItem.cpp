@@ -0,0 +1,214 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "HeadlessTreeItem.h"
+#include "QtilitiesCoreConstants.h"
+
+#include <QDomDocument>
+#include <QDomElement>
+#include <QDomNamedNodeMap>
+
+using namespace Qtilities::Core::Constants;
+
+namespace Qtilities {
+    namespace Core {
+        FactoryItem<QObject, HeadlessTreeItem> HeadlessTreeItem::factory;
+    }
+}
+
+// --------------------------------
+// HeadlessTreeFormatting
+// --------------------------------
+
+bool Qtilities::Core::HeadlessTreeFormatting::isEmpty() const {
+    return d_attributes.isEmpty() && d_elements.isEmpty();
+}
+
+void Qtilities::Core::HeadlessTreeFormatting::clear() {
+    d_attributes.clear();
+    d_elements.clear();
+}
+
+QString Qtilities::Core::HeadlessTreeFormatting::attribute(const QString& name) const {
+    return d_attributes.value(name);
+}
+
+void Qtilities::Core::HeadlessTreeFormatting::setAttribute(const QString& name, const QString& value) {
+    if (value.isEmpty())
+        d_attributes.remove(name);
+    else
+        d_attributes[name] = value;
+}
+
+QStringList Qtilities::Core::HeadlessTreeFormatting::attributeNames() const {
+    return d_attributes.keys();
+}
+
+QMap<QString,QString> Qtilities::Core::HeadlessTreeFormatting::element(const QString& tag_name) const {
+    return d_elements.value(tag_name);
+}
+
+void Qtilities::Core::HeadlessTreeFormatting::setElement(const QString& tag_name, const QMap<QString,QString>& attributes) {
+    if (attributes.isEmpty())
+        d_elements.remove(tag_name);
+    else
+        d_elements[tag_name] = attributes;
+}
+
+void Qtilities::Core::HeadlessTreeFormatting::exportXml(QDomDocument* doc, QDomElement* object_node) const {
+    if (isEmpty())
+        return;
+
+    QDomElement formatting_data = doc->createElement("Formatting");
+    QMap<QString,QString>::const_iterator attribute_itr = d_attributes.constBegin();
+    for (; attribute_itr != d_attributes.constEnd(); ++attribute_itr)
+        formatting_data.setAttribute(attribute_itr.key(),attribute_itr.value());
+
+    QMap<QString,QMap<QString,QString> >::const_iterator element_itr = d_elements.constBegin();
+    for (; element_itr != d_elements.constEnd(); ++element_itr) {
+        QDomElement element_data = doc->createElement(element_itr.key());
+        QMap<QString,QString>::const_iterator itr = element_itr.value().constBegin();
+        for (; itr != element_itr.value().constEnd(); ++itr)
+            element_data.setAttribute(itr.key(),itr.value());
+        formatting_data.appendChild(element_data);
+    }
+
+    object_node->appendChild(formatting_data);
+}
+
+void Qtilities::Core::HeadlessTreeFormatting::importXml(const QDomElement& formatting_node) {
+    clear();
+
+    QDomNamedNodeMap attributes = formatting_node.attributes();
+    for (int i = 0; i < attributes.count(); ++i) {
+        QDomAttr attribute = attributes.item(i).toAttr();
+        if (!attribute.isNull())
+            setAttribute(attribute.name(),attribute.value());
+    }
+
+    QDomNodeList childNodes = formatting_node.childNodes();
+    for (int i = 0; i < childNodes.count(); ++i) {
+        QDomElement child = childNodes.item(i).toElement();
+        if (child.isNull())
+            continue;
+
+        QMap<QString,QString> element_attributes;
+        QDomNamedNodeMap child_attributes = child.attributes();
+        for (int a = 0; a < child_attributes.count(); ++a) {
+            QDomAttr attribute = child_attributes.item(a).toAttr();
+            if (!attribute.isNull())
+                element_attributes[attribute.name()] = attribute.value();
+        }
+        setElement(child.tagName(),element_attributes);
+    }
+}
+
+// --------------------------------
+// HeadlessTreeItem
+// --------------------------------
+
+struct Qtilities::Core::HeadlessTreeItemPrivateData {
+    HeadlessTreeItemPrivateData() : is_modified(false) { }
+
+    bool                    is_modified;
+    HeadlessTreeFormatting  formatting;
+};
+
+Qtilities::Core::HeadlessTreeItem::HeadlessTreeItem(const QString& name, QObject* parent) : QObject(parent) {
+    d = new HeadlessTreeItemPrivateData;
+    setObjectName(name);
+}
+
+Qtilities::Core::HeadlessTreeItem::~HeadlessTreeItem() {
+    delete d;
+}
+
+Qtilities::Core::HeadlessTreeFormatting Qtilities::Core::HeadlessTreeItem::formatting() const {
+    return d->formatting;
+}
+
+void Qtilities::Core::HeadlessTreeItem::setFormatting(const HeadlessTreeFormatting& formatting) {
+    d->formatting = formatting;
+    setModificationState(true);
+}
+
+Qtilities::Core::InstanceFactoryInfo Qtilities::Core::HeadlessTreeItem::instanceFactoryInfo() const {
+    InstanceFactoryInfo instanceFactoryInfo(qti_def_FACTORY_QTILITIES,qti_def_FACTORY_TAG_TREE_ITEM,objectName());
+    return instanceFactoryInfo;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportModeFlags Qtilities::Core::HeadlessTreeItem::supportedFormats() const {
+    IExportable::ExportModeFlags flags = 0;
+    flags |= IExportable::Binary;
+    flags |= IExportable::XML;
+    return flags;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::HeadlessTreeItem::exportBinary(QDataStream& stream) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    // Tree items do not add anything to binary exports:
+    Q_UNUSED(stream)
+
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::HeadlessTreeItem::importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list) {
+    Q_UNUSED(stream)
+    Q_UNUSED(import_list)
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::HeadlessTreeItem::exportXml(QDomDocument* doc, QDomElement* object_node) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    d->formatting.exportXml(doc,object_node);
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::HeadlessTreeItem::importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list) {
+    Q_UNUSED(doc)
+    Q_UNUSED(import_list)
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    QDomNodeList dataNodes = object_node->childNodes();
+    for(int i = 0; i < dataNodes.count(); ++i) {
+        QDomElement data = dataNodes.item(i).toElement();
+        if (!data.isNull() && data.tagName() == QLatin1String("Formatting"))
+            d->formatting.importXml(data);
+    }
+
+    return IExportable::Complete;
+}
+
+bool Qtilities::Core::HeadlessTreeItem::isModified() const {
+    return d->is_modified;
+}
+
+void Qtilities::Core::HeadlessTreeItem::setModificationState(bool new_state, IModificationNotifier::NotificationTargets notification_targets, bool force_notifications) {
+    Q_UNUSED(force_notifications)
+
+    d->is_modified = new_state;
+    if (notification_targets & IModificationNotifier::NotifyListeners)
+        emit modificationStateChanged(new_state);
+}
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef HEADLESS_TREE_ITEM_H
+#define HEADLESS_TREE_ITEM_H
+
+#include "QtilitiesCore_global.h"
+#include "IExportable.h"
+#include "IModificationNotifier.h"
+#include "Factory.h"
+
+#include <QObject>
+#include <QMap>
+#include <QStringList>
+
+class QDomDocument;
+class QDomElement;
+
+namespace Qtilities {
+    namespace Core {
+        using namespace Qtilities::Core::Interfaces;
+
+        /*!
+        \class HeadlessTreeFormatting
+        \brief The HeadlessTreeFormatting class stores the formatting of headless tree items and nodes without interpreting it.
+
+        Qtilities::CoreGui::TreeItem and Qtilities::CoreGui::TreeNode export their formatting roles as attributes and child elements of a
+        \p Formatting element, for example the \p ToolTip and \p BackgroundColor attributes and the \p Font and \p Size elements. This class keeps
+        these values as the strings found in the export, thus formatting survives an import and export round trip through HeadlessTreeItem and
+        HeadlessTreeNode without using QtGui. The values are only turned into colors, fonts and sizes when the tree is loaded by a GUI application.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT HeadlessTreeFormatting
+        {
+        public:
+            //! Returns true when no formatting is stored.
+            bool isEmpty() const;
+            //! Removes all stored formatting.
+            void clear();
+
+            //! Returns the value of the formatting attribute \p name, for example \p "ToolTip", or QString() if it is not set.
+            QString attribute(const QString& name) const;
+            //! Sets the value of the formatting attribute \p name. Setting an empty value removes the attribute.
+            void setAttribute(const QString& name, const QString& value);
+            //! Returns the names of all formatting attributes which are set.
+            QStringList attributeNames() const;
+
+            //! Returns the attributes of the formatting element \p tag_name, for example \p "Font", or an empty map if the element is not set.
+            QMap<QString,QString> element(const QString& tag_name) const;
+            //! Sets the attributes of the formatting element \p tag_name. Setting an empty map removes the element.
+            void setElement(const QString& tag_name, const QMap<QString,QString>& attributes);
+
+            //! Appends a \p Formatting element with the stored formatting to \p object_node, unless no formatting is stored.
+            void exportXml(QDomDocument* doc, QDomElement* object_node) const;
+            //! Replaces the stored formatting with the formatting in \p formatting_node, which must be a \p Formatting element.
+            void importXml(const QDomElement& formatting_node);
+
+        private:
+            QMap<QString,QString> d_attributes;
+            QMap<QString,QMap<QString,QString> > d_elements;
+        };
+
+        /*!
+        \struct HeadlessTreeItemPrivateData
+        \brief Structure used by HeadlessTreeItem to store private data.
+          */
+        struct HeadlessTreeItemPrivateData;
+
+        /*!
+          \class HeadlessTreeItem
+          \brief The HeadlessTreeItem class is an item in a tree which does not depend on QtGui. It can be attached to a HeadlessTreeNode.
+
+          Headless tree items allow applications which do not use QtGui, for example batch services which build and export large trees,
+          to use trees without linking and initializing the GUI libraries. A HeadlessTreeItem is exported in the same format as a
+          Qtilities::CoreGui::TreeItem, thus trees exported by headless applications are loaded as TreeItem instances by GUI applications
+          and the other way around. Formatting is kept as opaque data in formatting(), see HeadlessTreeFormatting.
+
+          The factory of this class is registered under the Qtilities::Core::Constants::qti_def_FACTORY_TAG_TREE_ITEM tag by QtilitiesCoreApplication.
+          Qtilities::CoreGui::QtilitiesApplication registers Qtilities::CoreGui::TreeItem under the same tag instead.
+
+          <i>This class was added in %Qtilities v1.5.</i>
+        */
+        class QTILIITES_CORE_SHARED_EXPORT HeadlessTreeItem : public QObject, public IExportable, public IModificationNotifier
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Core::Interfaces::IExportable)
+            Q_INTERFACES(Qtilities::Core::Interfaces::IModificationNotifier)
+
+        public:
+            HeadlessTreeItem(const QString& name = QString(), QObject* parent = 0);
+            virtual ~HeadlessTreeItem();
+
+            //! Returns the formatting of the item.
+            HeadlessTreeFormatting formatting() const;
+            //! Sets the formatting of the item.
+            void setFormatting(const HeadlessTreeFormatting& formatting);
+
+            // --------------------------------
+            // Factory Interface Implementation
+            // --------------------------------
+            static FactoryItem<QObject, HeadlessTreeItem> factory;
+
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // IExportable Implementation
+            // --------------------------------
+            ExportModeFlags supportedFormats() const;
+            InstanceFactoryInfo instanceFactoryInfo() const;
+            IExportable::ExportResultFlags exportBinary(QDataStream& stream ) const;
+            IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
+            IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+
+            // --------------------------------
+            // IModificationNotifier Implementation
+            // --------------------------------
+            bool isModified() const;
+        public slots:
+            void setModificationState(bool new_state, IModificationNotifier::NotificationTargets notification_targets = IModificationNotifier::NotifyListeners, bool force_notifications = false);
+        signals:
+            void modificationStateChanged(bool is_modified) const;
+
+        private:
+            HeadlessTreeItemPrivateData* d;
+        };
+    }
+}
+
+#endif // HEADLESS_TREE_ITEM_H
@@ -0,0 +1,194 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "HeadlessTreeNode.h"
+#include "QtilitiesCoreConstants.h"
+#include "ObjectManager.h"
+
+#include <QDomDocument>
+#include <QDomElement>
+
+using namespace Qtilities::Core::Constants;
+
+namespace Qtilities {
+    namespace Core {
+        FactoryItem<QObject, HeadlessTreeNode> HeadlessTreeNode::factory;
+    }
+}
+
+struct Qtilities::Core::HeadlessTreeNodePrivateData {
+    HeadlessTreeNodePrivateData() { }
+
+    HeadlessTreeFormatting  formatting;
+    //! The value items under the node, see HeadlessTreeNode::addValueItem().
+    QStringList             value_items;
+};
+
+Qtilities::Core::HeadlessTreeNode::HeadlessTreeNode(const QString& name, QObject* parent) : Observer(name,QString(),parent) {
+    nodeData = new HeadlessTreeNodePrivateData;
+    setObjectName(name);
+
+    // Headless nodes are exported as tree nodes:
+    InstanceFactoryInfo instanceFactoryInfo(qti_def_FACTORY_QTILITIES,qti_def_FACTORY_TAG_TREE_NODE,objectName());
+    setFactoryData(instanceFactoryInfo);
+
+    // Tree nodes always use display hints:
+    useDisplayHints();
+}
+
+Qtilities::Core::HeadlessTreeNode::~HeadlessTreeNode() {
+    delete nodeData;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::HeadlessTreeNode::exportFormattingXML(QDomDocument* doc, QDomElement* object_node, Qtilities::ExportVersion version) const {
+    Q_UNUSED(version)
+
+    nodeData->formatting.exportXml(doc,object_node);
+    if (nodeData->value_items.isEmpty())
+        return IExportable::Complete;
+
+    // Value items are exported next to the formatting of the node:
+    QDomElement value_items_data = doc->createElement("ValueItems");
+    for (int i = 0; i < nodeData->value_items.count(); ++i) {
+        QDomElement value_item = doc->createElement("ValueItem");
+        value_item.setAttribute("Name",nodeData->value_items.at(i));
+        value_items_data.appendChild(value_item);
+    }
+    object_node->appendChild(value_items_data);
+
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::HeadlessTreeNode::importFormattingXML(QDomDocument* doc, QDomElement* object_node, Qtilities::ExportVersion version) {
+    Q_UNUSED(doc)
+    Q_UNUSED(version)
+
+    if (object_node->tagName() == QLatin1String("ValueItems")) {
+        QStringList names;
+        QDomNodeList value_item_nodes = object_node->childNodes();
+        for (int i = 0; i < value_item_nodes.count(); ++i) {
+            QDomElement value_item = value_item_nodes.item(i).toElement();
+            if (!value_item.isNull() && value_item.tagName() == QLatin1String("ValueItem"))
+                names << value_item.attribute("Name");
+        }
+        addValueItems(names);
+    } else if (object_node->tagName() == QLatin1String("Formatting")) {
+        nodeData->formatting.importXml(*object_node);
+    }
+
+    return IExportable::Complete;
+}
+
+Qtilities::Core::HeadlessTreeFormatting Qtilities::Core::HeadlessTreeNode::formatting() const {
+    return nodeData->formatting;
+}
+
+void Qtilities::Core::HeadlessTreeNode::setFormatting(const HeadlessTreeFormatting& formatting) {
+    nodeData->formatting = formatting;
+    setModificationState(true);
+}
+
+Qtilities::Core::HeadlessTreeItem* Qtilities::Core::HeadlessTreeNode::addItem(const QString& name, const QtilitiesCategory& category) {
+    HeadlessTreeItem* new_item = new HeadlessTreeItem(name);
+    if (attachSubject(new_item,Observer::SpecificObserverOwnership)) {
+        setSubjectCategory(new_item,category);
+        new_item->setModificationState(false);
+        return new_item;
+    } else {
+        delete new_item;
+        return 0;
+    }
+}
+
+void Qtilities::Core::HeadlessTreeNode::addItems(const QStringList& items, const QtilitiesCategory& category) {
+    startProcessingCycle();
+    foreach (const QString& item, items)
+        addItem(item,category);
+    endProcessingCycle();
+}
+
+Qtilities::Core::HeadlessTreeNode* Qtilities::Core::HeadlessTreeNode::addNode(const QString& name, const QtilitiesCategory& category) {
+    HeadlessTreeNode* new_node = new HeadlessTreeNode(name);
+    if (attachSubject(new_node,Observer::SpecificObserverOwnership)) {
+        setSubjectCategory(new_node,category);
+        new_node->setModificationState(false);
+        return new_node;
+    } else {
+        delete new_node;
+        return 0;
+    }
+}
+
+bool Qtilities::Core::HeadlessTreeNode::addItem(HeadlessTreeItem* item, const QtilitiesCategory& category) {
+    if (!item)
+        return false;
+    bool attach_success = attachSubject(item,Observer::ObserverScopeOwnership);
+    setSubjectCategory(item,category);
+    return attach_success;
+}
+
+bool Qtilities::Core::HeadlessTreeNode::addNode(HeadlessTreeNode* node, const QtilitiesCategory& category) {
+    if (!node)
+        return false;
+    bool attach_success = attachSubject(node,Observer::ObserverScopeOwnership);
+    setSubjectCategory(node,category);
+    return attach_success;
+}
+
+bool Qtilities::Core::HeadlessTreeNode::setSubjectCategory(QObject* subject, const QtilitiesCategory& category) {
+    if (!category.isValid() || !subject || !contains(subject))
+        return false;
+
+    // Setting the same category again would trigger a view refresh:
+    if (subjectCategoryInContext(subject) == category)
+        return true;
+
+    MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
+    if (ObjectManager::propertyExists(subject,qti_prop_CATEGORY_MAP))
+        category_property = ObjectManager::getMultiContextProperty(subject,qti_prop_CATEGORY_MAP);
+    category_property.setValue(qVariantFromValue(category),observerID());
+    return ObjectManager::setMultiContextProperty(subject,category_property);
+}
+
+void Qtilities::Core::HeadlessTreeNode::addValueItem(const QString& name) {
+    nodeData->value_items << name;
+    setModificationState(true);
+}
+
+void Qtilities::Core::HeadlessTreeNode::addValueItems(const QStringList& names) {
+    if (names.isEmpty())
+        return;
+
+    nodeData->value_items << names;
+    setModificationState(true);
+}
+
+QStringList Qtilities::Core::HeadlessTreeNode::valueItems() const {
+    return nodeData->value_items;
+}
+
+void Qtilities::Core::HeadlessTreeNode::initializeClone(const Observer* source) {
+    Observer::initializeClone(source);
+
+    const HeadlessTreeNode* source_node = qobject_cast<const HeadlessTreeNode*> (source);
+    if (source_node) {
+        nodeData->formatting = source_node->nodeData->formatting;
+        nodeData->value_items = source_node->nodeData->value_items;
+    }
+}
+
+void Qtilities::Core::HeadlessTreeNode::clearValueItems() {
+    if (nodeData->value_items.isEmpty())
+        return;
+
+    nodeData->value_items.clear();
+    setModificationState(true);
+}
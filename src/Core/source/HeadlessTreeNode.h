@@ -0,0 +1,127 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef HEADLESS_TREE_NODE_H
+#define HEADLESS_TREE_NODE_H
+
+#include "QtilitiesCore_global.h"
+#include "Observer.h"
+#include "IExportableFormatting.h"
+#include "HeadlessTreeItem.h"
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \struct HeadlessTreeNodePrivateData
+        \brief Structure used by HeadlessTreeNode to store private data.
+          */
+        struct HeadlessTreeNodePrivateData;
+
+        /*!
+          \class HeadlessTreeNode
+          \brief The HeadlessTreeNode class is a node in a tree which does not depend on QtGui.
+
+          Headless tree nodes allow applications which do not use QtGui, for example batch services which build and export large trees,
+          to build trees of HeadlessTreeItem and HeadlessTreeNode instances without linking and initializing the GUI libraries:
+
+\code
+HeadlessTreeNode* root = new HeadlessTreeNode("Root");
+HeadlessTreeNode* node = root->addNode("Node");
+node->addItem("Item 1");
+node->addItem("Item 2",QtilitiesCategory("Category"));
+
+QDomDocument doc("QtilitiesTreeExport");
+QDomElement root_element = doc.createElement("Root");
+doc.appendChild(root_element);
+root->exportXmlExt(&doc,&root_element);
+\endcode
+
+          A HeadlessTreeNode is an Observer with the same observer semantics as Qtilities::CoreGui::TreeNode: subjects are attached using
+          Observer::SpecificObserverOwnership by the addItem() and addNode() functions which construct them, display hints are always used,
+          and the node is exported in the same format as a TreeNode. Thus trees exported by headless applications are loaded as TreeNode
+          instances by GUI applications and the other way around. Formatting is kept as opaque data in formatting(), see HeadlessTreeFormatting,
+          and value items are exported next to it like the value items of a TreeNode.
+
+          The factory of this class is registered under the Qtilities::Core::Constants::qti_def_FACTORY_TAG_TREE_NODE tag by QtilitiesCoreApplication.
+          Qtilities::CoreGui::QtilitiesApplication registers Qtilities::CoreGui::TreeNode under the same tag instead.
+
+          <i>This class was added in %Qtilities v1.5.</i>
+        */
+        class QTILIITES_CORE_SHARED_EXPORT HeadlessTreeNode : public Observer, public IExportableFormatting
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Core::Interfaces::IExportableFormatting)
+
+        public:
+            HeadlessTreeNode(const QString& name = QString(), QObject* parent = 0);
+            virtual ~HeadlessTreeNode();
+
+            // --------------------------------
+            // IExportableFormatting Implementation
+            // --------------------------------
+            IExportable::ExportResultFlags exportFormattingXML(QDomDocument* doc, QDomElement* object_node, Qtilities::ExportVersion version) const;
+            IExportable::ExportResultFlags importFormattingXML(QDomDocument* doc, QDomElement* object_node, Qtilities::ExportVersion version);
+
+            // --------------------------------
+            // HeadlessTreeNode Implementation
+            // --------------------------------
+            //! Returns the formatting of the node.
+            HeadlessTreeFormatting formatting() const;
+            //! Sets the formatting of the node.
+            void setFormatting(const HeadlessTreeFormatting& formatting);
+
+            //! Creates a new item with the given name and attaches it to this node using Observer::SpecificObserverOwnership.
+            /*!
+              \returns The new item, or 0 if it could not be attached.
+              */
+            HeadlessTreeItem* addItem(const QString& name, const QtilitiesCategory& category = QtilitiesCategory());
+            //! Creates new items with the given names and attaches them to this node in a single processing cycle.
+            void addItems(const QStringList& items, const QtilitiesCategory& category = QtilitiesCategory());
+            //! Creates a new node with the given name and attaches it to this node using Observer::SpecificObserverOwnership.
+            /*!
+              \returns The new node, or 0 if it could not be attached.
+              */
+            HeadlessTreeNode* addNode(const QString& name, const QtilitiesCategory& category = QtilitiesCategory());
+            //! Attaches an existing item to this node using Observer::ObserverScopeOwnership.
+            bool addItem(HeadlessTreeItem* item, const QtilitiesCategory& category = QtilitiesCategory());
+            //! Attaches an existing node to this node using Observer::ObserverScopeOwnership.
+            bool addNode(HeadlessTreeNode* node, const QtilitiesCategory& category = QtilitiesCategory());
+            //! Sets the category of \p subject in this node.
+            /*!
+              \returns True if the category was set or did not change, false when \p subject is not attached to this node or \p category is not valid.
+              */
+            bool setSubjectCategory(QObject* subject, const QtilitiesCategory& category);
+
+            //! Adds a value item to this node, see Qtilities::CoreGui::TreeNode::addValueItem().
+            void addValueItem(const QString& name);
+            //! Adds multiple value items to this node.
+            void addValueItems(const QStringList& names);
+            //! Returns the value items of this node.
+            QStringList valueItems() const;
+            //! Removes all value items from this node.
+            void clearValueItems();
+
+            // --------------------------------
+            // Factory Interface Implementation
+            // --------------------------------
+            static FactoryItem<QObject, HeadlessTreeNode> factory;
+
+        protected:
+            //! Copies the formatting and value items of \p source when it is a headless tree node, see Observer::initializeClone().
+            void initializeClone(const Observer* source);
+
+        private:
+            HeadlessTreeNodePrivateData* nodeData;
+        };
+    }
+}
+
+#endif // HEADLESS_TREE_NODE_H
@@ -90,6 +90,14 @@ namespace Qtilities {
                 virtual void removeContext(const QString& context_string, bool notify = true) = 0;
                 //! Gets the current context.
                 virtual QList<int> activeContexts() const = 0;
+                //! Returns true if \p context_id is one of the active contexts.
+                /*!
+                  Unlike activeContexts(), this function may be called from any thread. It does not allocate memory or take a lock
+                  for the first 512 registered contexts.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual bool isContextActive(int context_id) const = 0;
                 //! Returns an unique context ID for the given context string. Contexts are stored and identified using integer ID values throughout the library.
                 virtual int contextID(const QString& context_string) = 0;
                 //! Returns the string which was used to register a context id. If the context id does not exist, QString() is returned.
@@ -10,9 +10,76 @@
 ****************************************************************************/
 
 #include "IExportable.h"
+#include "CborStream.h"
 #include "QtilitiesCoreApplication.h"
 
 #include <QDomElement>
+#include <QPair>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+namespace {
+    // Reads an element map written by IExportable::writeCborElement(), or a CDATA section written as a map with a single cdata key.
+    QDomNode qti_private_ReadCborNode(Qtilities::Core::CborStreamReader* reader, QDomDocument* doc) {
+        if (!reader->isMap()) {
+            reader->next();
+            return QDomNode();
+        }
+
+        QString tag_name;
+        QString cdata;
+        bool is_cdata = false;
+        QList<QPair<QString,QString> > attributes;
+        QList<QDomNode> child_nodes;
+
+        // Keys which are not known are skipped, thus keys can be added to the format later:
+        reader->enterContainer();
+        while (reader->hasNext()) {
+            QString key = reader->readString();
+            if (key == QLatin1String("tag") && reader->isString()) {
+                tag_name = reader->readString();
+            } else if (key == QLatin1String("cdata") && reader->isString()) {
+                cdata = reader->readString();
+                is_cdata = true;
+            } else if (key == QLatin1String("attributes") && reader->isMap()) {
+                reader->enterContainer();
+                while (reader->hasNext()) {
+                    QString name = reader->readString();
+                    attributes << qMakePair(name,reader->readString());
+                }
+                reader->leaveContainer();
+            } else if (key == QLatin1String("children") && reader->isArray()) {
+                reader->enterContainer();
+                while (reader->hasNext()) {
+                    if (reader->isString()) {
+                        child_nodes << doc->createTextNode(reader->readString());
+                    } else {
+                        QDomNode child = qti_private_ReadCborNode(reader,doc);
+                        if (!child.isNull())
+                            child_nodes << child;
+                    }
+                }
+                reader->leaveContainer();
+            } else
+                reader->next();
+        }
+        reader->leaveContainer();
+
+        if (reader->hasError())
+            return QDomNode();
+        if (is_cdata && tag_name.isEmpty())
+            return doc->createCDATASection(cdata);
+        if (tag_name.isEmpty())
+            return QDomNode();
+
+        QDomElement element = doc->createElement(tag_name);
+        for (int i = 0; i < attributes.count(); ++i)
+            element.setAttribute(attributes.at(i).first,attributes.at(i).second);
+        for (int i = 0; i < child_nodes.count(); ++i)
+            element.appendChild(child_nodes.at(i));
+        return element;
+    }
+}
 
 Qtilities::Core::Interfaces::IExportable::IExportable() {
     d_export_version = Qtilities::Qtilities_Latest;
@@ -192,6 +259,8 @@ QString Qtilities::Core::Interfaces::IExportable::exportModeToString(ExportMode
         return "Binary";
     } else if (export_mode == XML) {
         return "XML";
+    } else if (export_mode == Cbor) {
+        return "Cbor";
     }
 
     return QString();
@@ -204,12 +273,165 @@ Qtilities::Core::Interfaces::IExportable::ExportMode Qtilities::Core::Interfaces
         return Binary;
     } else if (export_mode_string == QLatin1String("XML")) {
         return XML;
+    } else if (export_mode_string == QLatin1String("Cbor")) {
+        return Cbor;
     }
 
     Q_ASSERT(0);
     return None;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Interfaces::IExportable::exportXmlStream(QXmlStreamWriter* writer) const {
+    if (!writer)
+        return IExportable::Failed;
+
+    // Only the element of this object is built in memory:
+    QDomDocument doc;
+    QDomElement object_node = doc.createElement("Object");
+    doc.appendChild(object_node);
+    ExportResultFlags result = exportXml(&doc,&object_node);
+
+    writeDomAttributes(writer,object_node);
+    writeDomChildNodes(writer,object_node);
+    return result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Interfaces::IExportable::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    if (!reader || !reader->isStartElement())
+        return IExportable::Failed;
+
+    QDomDocument doc;
+    QDomElement object_node = readDomElement(reader,&doc);
+    if (reader->hasError())
+        return IExportable::Failed;
+    doc.appendChild(object_node);
+
+    return importXml(&doc,&object_node,import_list);
+}
+
+void Qtilities::Core::Interfaces::IExportable::writeDomAttributes(QXmlStreamWriter* writer, const QDomElement& element) {
+    QDomNamedNodeMap attributes = element.attributes();
+    int count = attributes.count();
+    for (int i = 0; i < count; ++i) {
+        QDomAttr attribute = attributes.item(i).toAttr();
+        writer->writeAttribute(attribute.name(),attribute.value());
+    }
+}
+
+void Qtilities::Core::Interfaces::IExportable::writeDomChildNodes(QXmlStreamWriter* writer, const QDomElement& element) {
+    for (QDomNode node = element.firstChild(); !node.isNull(); node = node.nextSibling()) {
+        if (node.isElement()) {
+            QDomElement child = node.toElement();
+            writer->writeStartElement(child.tagName());
+            writeDomAttributes(writer,child);
+            writeDomChildNodes(writer,child);
+            writer->writeEndElement();
+        } else if (node.isCDATASection()) {
+            writer->writeCDATA(node.toCDATASection().data());
+        } else if (node.isText()) {
+            writer->writeCharacters(node.toText().data());
+        } else if (node.isComment()) {
+            writer->writeComment(node.toComment().data());
+        }
+    }
+}
+
+QDomElement Qtilities::Core::Interfaces::IExportable::readDomElement(QXmlStreamReader* reader, QDomDocument* doc) {
+    QDomElement element = doc->createElement(reader->name().toString());
+    QXmlStreamAttributes attributes = reader->attributes();
+    for (int i = 0; i < attributes.count(); ++i)
+        element.setAttribute(attributes.at(i).name().toString(),attributes.at(i).value().toString());
+
+    while (!reader->atEnd()) {
+        QXmlStreamReader::TokenType token = reader->readNext();
+        if (token == QXmlStreamReader::StartElement) {
+            element.appendChild(readDomElement(reader,doc));
+        } else if (token == QXmlStreamReader::EndElement) {
+            break;
+        } else if (token == QXmlStreamReader::Characters) {
+            if (reader->isCDATA())
+                element.appendChild(doc->createCDATASection(reader->text().toString()));
+            else if (!reader->isWhitespace())
+                element.appendChild(doc->createTextNode(reader->text().toString()));
+        }
+    }
+
+    return element;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Interfaces::IExportable::exportCbor(CborStreamWriter* writer) const {
+    if (!writer)
+        return IExportable::Failed;
+
+    // Only the element of this object is built in memory:
+    QDomDocument doc;
+    QDomElement object_node = doc.createElement("Object");
+    doc.appendChild(object_node);
+    ExportResultFlags result = exportXml(&doc,&object_node);
+
+    writeCborElement(writer,object_node);
+    if (writer->hasError())
+        return IExportable::Failed;
+    return result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Interfaces::IExportable::importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    if (!reader)
+        return IExportable::Failed;
+
+    QDomDocument doc;
+    QDomElement object_node = readCborElement(reader,&doc);
+    if (reader->hasError() || object_node.isNull())
+        return IExportable::Failed;
+    doc.appendChild(object_node);
+
+    return importXml(&doc,&object_node,import_list);
+}
+
+void Qtilities::Core::Interfaces::IExportable::writeCborElement(CborStreamWriter* writer, const QDomElement& element) {
+    QDomNamedNodeMap attributes = element.attributes();
+    QDomNodeList child_nodes = element.childNodes();
+
+    writer->startMap();
+    writer->writeString("tag");
+    writer->writeString(element.tagName());
+
+    if (attributes.count() > 0) {
+        writer->writeString("attributes");
+        writer->startMap(attributes.count());
+        for (int i = 0; i < attributes.count(); ++i) {
+            QDomAttr attribute = attributes.item(i).toAttr();
+            writer->writeString(attribute.name());
+            writer->writeString(attribute.value());
+        }
+        writer->endMap();
+    }
+
+    if (child_nodes.count() > 0) {
+        writer->writeString("children");
+        writer->startArray();
+        for (QDomNode node = element.firstChild(); !node.isNull(); node = node.nextSibling()) {
+            if (node.isElement()) {
+                writeCborElement(writer,node.toElement());
+            } else if (node.isCDATASection()) {
+                writer->startMap(1);
+                writer->writeString("cdata");
+                writer->writeString(node.toCDATASection().data());
+                writer->endMap();
+            } else if (node.isText()) {
+                writer->writeString(node.toText().data());
+            }
+        }
+        writer->endArray();
+    }
+
+    writer->endMap();
+}
+
+QDomElement Qtilities::Core::Interfaces::IExportable::readCborElement(CborStreamReader* reader, QDomDocument* doc) {
+    return qti_private_ReadCborNode(reader,doc).toElement();
+}
+
 void Qtilities::Core::Interfaces::IExportable::setExportTask(ITask* task) {
     if (!task) {
         d_task_base = 0;
@@ -26,9 +26,14 @@
 
 class QDomDocument;
 class QDomElement;
+class QXmlStreamReader;
+class QXmlStreamWriter;
 
 namespace Qtilities {
     namespace Core {
+        class CborStreamReader;
+        class CborStreamWriter;
+
         namespace Interfaces {
             using namespace Qtilities::Core;
             using namespace Qtilities::Logging;
@@ -37,9 +42,10 @@ namespace Qtilities {
             \class IExportable
             \brief Objects can implement this interface if they are able to export and reconstruct themselves.
 
-            IExportable is an interface used throughout %Qtilities by classes in order to stream their data. At present two export options are supported:
+            IExportable is an interface used throughout %Qtilities by classes in order to stream their data. At present three export options are supported:
             - Serialized binary streaming
             - QDomDocument construction
+            - Streaming CBOR interchange
 
             Any object that implements this interface can specify which of the above export formats it supports through the supportedFormats() function. The interface also allows you to provide the needed information about reconstructing your object through the instanceFactoryInfo() function. In short, this allows your object to specify the factory that should be used to reconstruct it as well as the factory tag to use in that factory. For a detailed overview of the factory architecture used in %Qtilities, please refer to \ref page_factories.
 
@@ -59,6 +65,28 @@ namespace Qtilities {
 
             See the \ref iexportable_comparison section of this page for a comparison between Binary and XML exports.
 
+            \section iexportable_xml_streams Streaming XML Exports
+
+            For large exports, building the complete QDomDocument in memory before it is written to a file can use a lot of memory. The exportXmlStream() and
+            importXmlStream() functions write an object's element directly to a QXmlStreamWriter and read it from a QXmlStreamReader. The format written
+            is the same as the format written by exportXml(), thus files written by either function can be read by importXml() and importXmlStream().
+
+            By default exportXmlStream() and importXmlStream() are adapters around exportXml() and importXml(), which only build the document for the object
+            being streamed. Thus all existing implementations support streaming. Objects which contain large amounts of data, like Qtilities::Core::Observer,
+            reimplement the streaming functions in order to stream their data directly.
+
+            \section iexportable_cbor CBOR Exporting
+
+            CBOR (Concise Binary Object Representation, RFC 7049) exports are written using the exportCbor() and importCbor() functions, which write to a
+            Qtilities::Core::CborStreamWriter and read from a Qtilities::Core::CborStreamReader. Like binary exports, CBOR is compact and fast to parse. Unlike
+            binary exports, the items in CBOR describe their own types and maps are keyed by name, thus tools written in other languages are able to read
+            the exported data without knowing anything about QDataStream, and readers skip keys they do not know. Data is written and read as a stream,
+            thus no document is built in memory.
+
+            By default exportCbor() and importCbor() are adapters around exportXml() and importXml(), which encode the element of the object as a generic
+            element map using writeCborElement() and readCborElement(). Thus, all objects which support IExportable::XML support CBOR exports as well.
+            Qtilities::Core::Observer, Qtilities::Core::QtilitiesCategory and Qtilities::Core::ObserverRelationalTable write their data using native CBOR maps.
+
             \section iexportable_comparison Binary vs. XML Exports
 
             Both binary and XML imports have their advantages and disadvantages and when using %Qtilities projects, observers or export functions on the object manager, additional advantages and disadvantages applies.
@@ -275,7 +303,8 @@ int main(int argc, char *argv[])
                 enum ExportMode {
                     None = 0,      /*!< Does not support any export modes. */
                     Binary = 1,    /*!< Binary exporting using QDataStream. \sa exportBinary(), importBinary() */
-                    XML = 2        /*!< XML exporting using QDomDocument. \sa exportXml(), importXml() */
+                    XML = 2,       /*!< XML exporting using QDomDocument. \sa exportXml(), importXml() */
+                    Cbor = 4       /*!< Streaming CBOR exporting using CborStreamWriter. \sa exportCbor(), importCbor(). <i>This export mode was added in %Qtilities v1.5.</i> */
                 };
                 Q_DECLARE_FLAGS(ExportModeFlags, ExportMode)
                 Q_FLAGS(ExportModeFlags)
@@ -494,6 +523,96 @@ TreeNode* duplicated_node = IExportable::duplicateInstance<TreeNode>(&node);
                     See \ref page_serializing_overview for more information about the expected output format.
                   */
                 virtual ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+                //! Allows exporting directly to a QXmlStreamWriter.
+                /*!
+                    The element representing the object was started by the caller using QXmlStreamWriter::writeStartElement(), and the caller will also end it. The
+                    implementation writes the attributes of the element first, followed by its child elements. The output must be the same as the element constructed by exportXml().
+
+                    The default implementation exports the object to a temporary QDomDocument using exportXml() and writes the result to \p writer.
+
+                    See \ref iexportable_xml_streams for more information.
+
+                    <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+                //! Allows importing and reconstruction of data directly from a QXmlStreamReader.
+                /*!
+                    When called, \p reader is positioned on the start element of the element representing the object. The implementation must read up to and including
+                    the end element of this element.
+
+                    The default implementation reads the element into a temporary QDomDocument and imports it using importXml().
+
+                    See \ref iexportable_xml_streams for more information.
+
+                    <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
+
+                //! Writes the attributes of \p element to the current element of \p writer.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                static void writeDomAttributes(QXmlStreamWriter* writer, const QDomElement& element);
+                //! Writes the child nodes of \p element to \p writer.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                static void writeDomChildNodes(QXmlStreamWriter* writer, const QDomElement& element);
+                //! Reads the element on which \p reader is positioned into an element created in \p doc.
+                /*!
+                  The element is not appended to \p doc. When the function returns, \p reader is positioned on the end element of the element that was read.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                static QDomElement readDomElement(QXmlStreamReader* reader, QDomDocument* doc);
+
+                //----------------------------
+                // CBOR Exporting
+                //----------------------------
+                //! Allows exporting to a CBOR stream.
+                /*!
+                    The implementation writes exactly one item to \p writer, which is normally a map containing the object's data.
+
+                    The default implementation exports the object to a temporary QDomDocument using exportXml() and writes the element of the object to
+                    \p writer using writeCborElement().
+
+                    See \ref iexportable_cbor for more information.
+
+                    <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual ExportResultFlags exportCbor(CborStreamWriter* writer) const;
+                //! Allows importing and reconstruction of data from a CBOR stream.
+                /*!
+                    When called, \p reader is positioned on the item written by exportCbor(). The implementation must read this item completely, thus
+                    \p reader must be positioned on the next item when the function returns.
+
+                    The default implementation reads the element written by the default exportCbor() implementation using readCborElement() and imports it using importXml().
+
+                    See \ref iexportable_cbor for more information.
+
+                    <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual ExportResultFlags importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list);
+
+                //! Writes \p element, including its attributes and child nodes, to \p writer as a generic element map.
+                /*!
+                  The element is written as a map with the following keys, of which \p attributes and \p children are only written when the element has any:
+                  - \p tag: The tag name of the element.
+                  - \p attributes: A map of attribute names to their values.
+                  - \p children: An array of the child nodes of the element. Child elements are written as element maps, text nodes as text strings and
+                    CDATA sections as maps with a single \p cdata key.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                static void writeCborElement(CborStreamWriter* writer, const QDomElement& element);
+                //! Reads the element map on which \p reader is positioned into an element created in \p doc.
+                /*!
+                  The element is not appended to \p doc. When the function returns, \p reader is positioned on the item after the element map. When
+                  \p reader is not positioned on an element map, the item is skipped and a null element is returned.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                static QDomElement readCborElement(CborStreamReader* reader, QDomDocument* doc);
 
                 //----------------------------
                 // Enum <-> String Functions
@@ -18,6 +18,8 @@
 
 class QDomDocument;
 class QDomElement;
+class QXmlStreamReader;
+class QXmlStreamWriter;
 
 namespace Qtilities {
     namespace Core {
@@ -43,6 +45,50 @@ namespace Qtilities {
                     Q_UNUSED(object_node)
                     Q_UNUSED(export_flags)
 
+                    return IExportable::Complete;
+                }
+                //! Extended streaming XML export function.
+                /*!
+                  Works the same as IExportable::exportXmlStream(), with the following extensions:
+                  \param export_flags The items to export, see ObserverData::ExportItemFlags.
+                  \param leading_elements When not 0, the child nodes of this element are written as the first child elements of the observer's element, directly after its attributes.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual IExportable::ExportResultFlags exportXmlStreamExt(QXmlStreamWriter* writer, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData, const QDomElement* leading_elements = 0) const {
+                    Q_UNUSED(writer)
+                    Q_UNUSED(export_flags)
+                    Q_UNUSED(leading_elements)
+
+                    return IExportable::Complete;
+                }
+                //! Extended streaming XML import function.
+                /*!
+                  Works the same as IExportable::importXmlStream(), with the following extension:
+                  \param other_elements When not 0, child elements of the observer's element which are not used by the observer are appended to this element. Otherwise they are skipped.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual IExportable::ExportResultFlags importXmlStreamExt(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list, QDomElement* other_elements = 0) {
+                    Q_UNUSED(reader)
+                    Q_UNUSED(import_list)
+                    Q_UNUSED(other_elements)
+
+                    return IExportable::Complete;
+                }
+                //! Extended CBOR export function.
+                /*!
+                  Works the same as IExportable::exportCbor(), with the following extension:
+                  \param export_flags The items to export, see ObserverData::ExportItemFlags.
+
+                  The export flags are written into the observer's map, thus IExportable::importCbor() does not need an extended version.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual IExportable::ExportResultFlags exportCborExt(CborStreamWriter* writer, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData) const {
+                    Q_UNUSED(writer)
+                    Q_UNUSED(export_flags)
+
                     return IExportable::Complete;
                 }
             };
@@ -17,6 +17,8 @@
 #include "QtilitiesCategory.h"
 #include "Factory.h"
 #include "QtilitiesProperty.h"
+#include "MemoryUsageReport.h"
+#include "ObjectHandle.h"
 
 #include <QList>
 #include <QMap>
@@ -77,10 +79,14 @@ namespace Qtilities {
                 virtual Observer* objectPool() = 0;
                 //! A function which moves a list of objects from one observer to another observer.
                 /*!
-                  This function will attempt to move subjects from one observer context to another. If any of the subjects
-                  cannot be attached, it will be skipped and attempt to move the next subject in the list. If any of the
-                  subjects could not be attached, the function will return false. If all subjects was moved successfully the
-                  function will return true.
+                  This function will attempt to move subjects from one observer context to another. If all subjects was moved
+                  successfully the function will return true, otherwise it will return false.
+
+                  Since %Qtilities v1.5 the move is done as a single operation: The attachment and detachment of all subjects
+                  are validated before any of them are moved, thus when any subject is rejected none of the subjects are moved.
+                  The subjects are then moved in bulk inside processing cycles on both observers, thus each observer reports
+                  the move in a single change set. When the move fails part way through, the subjects which were already
+                  moved are moved back to the source observer.
 
                   \param objects The objects which must be moved.
                   \param source_observer_id The source observer ID.
@@ -92,10 +98,7 @@ namespace Qtilities {
                 virtual bool moveSubjects(QList<QObject*> objects, int source_observer_id, int destination_observer_id, QString* error_msg = 0,bool silent = false) = 0;
                 //! Move subjects by providing the objects as a list with smart pointers.
                 /*!
-                  This function will attempt to move subjects from one observer context to another. If any of the subjects
-                  cannot be attached, it will be skipped and attempt to move the next subject in the list. If any of the
-                  subjects could not be attached, the function will return false. If all subjects was moved successfully the
-                  function will return true.
+                  See moveSubjects(QList<QObject*>,int,int,QString*,bool) for details.
 
                   \param objects The objects which must be moved.
                   \param source_observer_id The source observer ID.
@@ -140,6 +143,94 @@ for (int i = 0; i < projectItemObjects.count(); i++) {
 \endcode
                   */
                 virtual QList<QObject*> registeredInterfaces(const QString& iface) const = 0;
+                //! Returns all objects in the global object pool which implements the interface \p T, cast to \p T.
+                /*!
+                  \p T must be an interface declared using Q_DECLARE_INTERFACE(). The example in registeredInterfaces() becomes:
+
+\code
+QList<IProjectItem*> projectItems = OBJECT_MANAGER->registeredInterfaces<IProjectItem>();
+\endcode
+
+                  The objects implementing an interface are indexed the first time the interface is queried, after which the index is kept
+                  up to date as objects are registered and removed. Thus repeated calls do not search the object pool.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                template <class T>
+                QList<T*> registeredInterfaces() const {
+                    QList<T*> interfaces;
+                    const QList<QObject*> objects = registeredInterfaces(QString::fromLatin1(qobject_interface_iid<T*>()));
+                    for (int i = 0; i < objects.count(); ++i) {
+                        T* iface = qobject_cast<T*> (objects.at(i));
+                        if (iface)
+                            interfaces << iface;
+                    }
+                    return interfaces;
+                }
+                //! Subscribes \p receiver to the registration and removal of objects implementing \p iface in the global object pool.
+                /*!
+                  Unlike newObjectAdded() and objectRemoved(), which are emitted for every object, subscribers are only notified about objects
+                  implementing the interface they subscribed to:
+
+\code
+OBJECT_MANAGER->subscribeToInterface<IProjectItem>(this,SLOT(handleProjectItemsAdded(QList<QObject*>)),SLOT(handleProjectItemsRemoved(QList<QObject*>)));
+\endcode
+
+                  \param iface The interface ID, as used in registeredInterfaces().
+                  \param receiver The object to notify. The subscription ends when the receiver is destroyed.
+                  \param added_method The method called when objects implementing \p iface are registered, using SLOT() or a plain signature.
+                  It must take either a QList<QObject*>, in which case it is called once for every batch of objects, or a QObject*, in which
+                  case it is called for every object.
+                  \param removed_method The method called when objects implementing \p iface are removed or deleted, taking the same arguments as
+                  \p added_method. Deleted objects are passed while they are being destroyed, thus only their addresses can be used. Can be null.
+                  \param batched When true, objects registered between startNotificationBatch() and endNotificationBatch() are delivered when the
+                  batch ends. When false, subscribers are notified immediately.
+
+                  Existing objects implementing the interface are not reported, use registeredInterfaces() to get them. Subscribing a receiver
+                  to an interface it is subscribed to already replaces its previous subscription.
+
+                  \returns False when \p receiver is null, or when it does not have the methods given.
+                  \sa unsubscribeFromInterface()
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual bool subscribeToInterface(const QString& iface, QObject* receiver, const char* added_method, const char* removed_method = 0, bool batched = true) = 0;
+                //! Subscribes \p receiver to the registration and removal of objects implementing the interface \p T.
+                /*!
+                  \p T must be an interface declared using Q_DECLARE_INTERFACE(). See the subscribeToInterface() overload taking the interface ID for
+                  more information.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                template <class T>
+                bool subscribeToInterface(QObject* receiver, const char* added_method, const char* removed_method = 0, bool batched = true) {
+                    return subscribeToInterface(QString::fromLatin1(qobject_interface_iid<T*>()),receiver,added_method,removed_method,batched);
+                }
+                //! Ends the subscription of \p receiver to \p iface.
+                /*!
+                  Notifications which are pending in a batch are not delivered to the receiver.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual void unsubscribeFromInterface(const QString& iface, QObject* receiver) = 0;
+                //! Starts a notification batch, during which batched interface subscribers are not notified.
+                /*!
+                  Batches can be nested, subscribers are notified when the outer batch ends. The extension system uses a batch while it loads and
+                  initializes plugins, thus a batched subscriber is notified once about all the objects registered by plugins.
+
+                  \sa endNotificationBatch(), subscribeToInterface()
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual void startNotificationBatch() = 0;
+                //! Ends a notification batch started with startNotificationBatch().
+                /*!
+                  When the outer batch ends, batched subscribers are notified about the objects which were registered and removed during the batch.
+                  Objects which were registered and removed again during the batch are not reported.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual void endNotificationBatch() = 0;
 
                 // ---------------------------------
                 // Qtilities Factory Related Functionality
@@ -192,10 +283,122 @@ for (int i = 0; i < projectItemObjects.count(); i++) {
                   \sa setMetaTypeActiveObjects(), metaTypeActiveObjectsChanged()
                   */
                 virtual QList<QPointer<QObject> > metaTypeActiveObjects(const QString& meta_type) const = 0;
+                //! Updates the active object(s) for a specific meta type using a list of object handles.
+                /*!
+                  This is the cheapest way to set active objects: the list is stored and passed to listeners of metaTypeActiveObjectHandlesChanged()
+                  without being copied. The other overloads convert their lists to an ObjectHandleList and call this function.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual void setMetaTypeActiveObjects(const ObjectHandleList& objects, const QString& meta_type) = 0;
+                //! Returns handles to the active object(s) for a specific meta type. If the meta type does not exist, an empty list is returned.
+                /*!
+                  Handles to active objects which were destroyed resolve to null.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual ObjectHandleList metaTypeActiveObjectHandles(const QString& meta_type) const = 0;
+                //! Subscribes \p receiver to changes of the active objects of \p meta_type, delivering changes at most once every \p throttle_msecs milliseconds.
+                /*!
+                  Selection changes can happen on every step when a user moves through a large list. Listeners which do expensive work for every
+                  change, like property browsers, can subscribe using a throttle interval instead of connecting to metaTypeActiveObjectsChanged():
+
+\code
+OBJECT_MANAGER->subscribeToMetaTypeActiveObjects("Example Observer",property_browser,SLOT(setObject(QList<QPointer<QObject> >)),100);
+\endcode
+
+                  The first change is delivered immediately. Changes made during the following \p throttle_msecs milliseconds are delivered once
+                  when the interval elapsed, passing the active objects at that time. When \p throttle_msecs is 0, every change is delivered
+                  immediately.
+
+                  \param meta_type The meta type to subscribe to.
+                  \param receiver The object to notify. The subscription ends when the receiver is destroyed.
+                  \param method The method to call, using SLOT() or a plain signature. It must take a QList<QPointer<QObject> > or, since it avoids a conversion, an ObjectHandleList.
+                  \param throttle_msecs The minimum interval between deliveries.
+
+                  Subscribing a receiver to a meta type it is subscribed to already replaces its previous subscription.
+
+                  \returns False when \p receiver is null, or when it does not have the method given.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual bool subscribeToMetaTypeActiveObjects(const QString& meta_type, QObject* receiver, const char* method, int throttle_msecs = 0) = 0;
+                //! Ends the subscription of \p receiver to the active objects of \p meta_type. Pending throttled changes are not delivered.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual void unsubscribeFromMetaTypeActiveObjects(const QString& meta_type, QObject* receiver) = 0;
+
+                // --------------------------------
+                // Object Handles
+                // --------------------------------
+                //! Returns the handle of \p obj, registering \p obj in the object handle table when it does not have a handle yet.
+                /*!
+                  The object handle table has a slot for every object which has a handle. The slot of an object is released when the
+                  object is destroyed and it gets a new generation, thus handles to destroyed objects never resolve to new objects using the same slot.
+                  All object handle functions are thread-safe. Usually you would construct an ObjectHandle or ObjectHandleList instead of calling this function directly.
+
+                  \returns The handle of \p obj, or a null handle when \p obj is null.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual ObjectHandle objectHandle(QObject* obj) = 0;
+                //! Returns the handles of \p objects, registering objects without handles. All objects are handled in one call to the object handle table.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual QVector<ObjectHandle> objectHandles(const QList<QObject*>& objects) = 0;
+                //! Returns the handle of \p obj without registering it. When \p obj does not have a handle, a null handle is returned.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual ObjectHandle findObjectHandle(const QObject* obj) const = 0;
+                //! Returns the object referred to by \p handle, or null when the object was destroyed or \p handle is a null handle.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual QObject* handleObject(const ObjectHandle& handle) const = 0;
+                //! Returns the objects referred to by \p handles in the same order, with null for objects which were destroyed. All handles are resolved in one call to the object handle table.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual QList<QObject*> handleObjects(const QVector<ObjectHandle>& handles) const = 0;
+
+                // --------------------------------
+                // Memory Accounting
+                // --------------------------------
+                //! Returns an estimate of the memory used by the global object pool and by the object manager itself.
+                /*!
+                  The report of the object pool is created using Observer::memoryUsage(), thus when \p recursive is true the trees underneath
+                  observers in the object pool are included. The bookkeeping of the object manager is reported in MemoryUsageReport::ObserverMemory.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual MemoryUsageReport memoryUsage(bool recursive = true) const = 0;
 
             signals:
                 //! Signal which is emitted when the setMetaTypeActiveObjects() is finished.
+                /*!
+                  Since %Qtilities v1.5 this signal is not emitted when the active objects set are the same as the current active objects of the meta type.
+                  */
                 void metaTypeActiveObjectsChanged(QList<QPointer<QObject> > objects, const QString& meta_type);
+                //! Signal which is emitted when the active objects of \p meta_type changed, with handles to the new active objects.
+                /*!
+                  This signal is emitted along with metaTypeActiveObjectsChanged(). Connect to this signal instead of metaTypeActiveObjectsChanged() when you
+                  handle large selections: the list is shared with the object manager, while metaTypeActiveObjectsChanged() is only emitted with a new list of
+                  guarded pointers when it has receivers.
+
+                  <i>This signal was added in %Qtilities v1.5.</i>
+                  */
+                void metaTypeActiveObjectHandlesChanged(const ObjectHandleList& objects, const QString& meta_type);
+                //! Signal which is emitted with the objects which became active and inactive when the active objects of \p meta_type changed.
+                /*!
+                  Listeners which keep state per active object can update only the objects in \p added and \p removed, instead of rebuilding
+                  their state from the full list passed by metaTypeActiveObjectsChanged(). Removed objects which were deleted are null.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                void metaTypeActiveObjectsDelta(QList<QPointer<QObject> > added, QList<QPointer<QObject> > removed, const QString& meta_type);
                 //! Signal which is emitted when a new object is added to the global object pool.
                 void newObjectAdded(QObject* obj);
                 //! Signal which is emitted when an object is removed from the global object pool.
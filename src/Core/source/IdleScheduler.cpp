@@ -0,0 +1,324 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "IdleScheduler.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QPointer>
+#include <QThread>
+#include <QTimer>
+
+using namespace Qtilities::Core;
+
+namespace {
+    typedef QPair<const QObject*,QByteArray> qti_private_InvokeKey;
+}
+
+struct Qtilities::Core::IdleSchedulerPrivateData {
+    IdleSchedulerPrivateData() : slice_timer(0),
+        frame_budget(16),
+        slice_pending(false),
+        current_job(0),
+        current_job_cancelled(false),
+        running(false),
+        yielding(false),
+        slice_deferred(false) { }
+
+    QTimer*                                     slice_timer;
+    int                                         frame_budget;
+
+    //! Protects the members below, up to current_job_cancelled.
+    QMutex                                      mutex;
+    //! The scheduled jobs in the order in which they take turns, per priority.
+    QList<IdleJob*>                             queues[IdleScheduler::LowPriority + 1];
+    QHash<IdleJob*,int>                         job_priorities;
+    //! The jobs of pending scheduleInvoke() calls.
+    QHash<qti_private_InvokeKey,IdleJob*>       invokes;
+    bool                                        slice_pending;
+    //! The job of which a step is running. It is not in the queues while its step runs.
+    IdleJob*                                    current_job;
+    bool                                        current_job_cancelled;
+
+    bool                                        running;
+    bool                                        yielding;
+    bool                                        slice_deferred;
+    QElapsedTimer                               last_yield;
+};
+
+namespace {
+    // Calls a method on a receiver once.
+    class qti_private_InvokeJob : public IdleJob {
+    public:
+        qti_private_InvokeJob(IdleSchedulerPrivateData* scheduler_data, QObject* receiver, const QByteArray& member) :
+            d(scheduler_data),
+            d_receiver(receiver),
+            d_key(receiver,member) {}
+
+        bool runStep() {
+            // The call is no longer pending once it starts, thus the receiver can schedule it again:
+            d->mutex.lock();
+            d->invokes.remove(d_key);
+            d->mutex.unlock();
+
+            if (d_receiver)
+                QMetaObject::invokeMethod(d_receiver,d_key.second.constData(),Qt::AutoConnection);
+            return false;
+        }
+
+    private:
+        IdleSchedulerPrivateData*   d;
+        QPointer<QObject>           d_receiver;
+        qti_private_InvokeKey       d_key;
+    };
+}
+
+Qtilities::Core::IdleScheduler::IdleScheduler(QObject* parent) : QObject(parent) {
+    d = new IdleSchedulerPrivateData;
+    d->slice_timer = new QTimer(this);
+    d->slice_timer->setSingleShot(true);
+    d->slice_timer->setInterval(0);
+    connect(d->slice_timer,SIGNAL(timeout()),SLOT(runSlice()));
+}
+
+Qtilities::Core::IdleScheduler::~IdleScheduler() {
+    for (int p = HighPriority; p <= LowPriority; ++p) {
+        for (int i = 0; i < d->queues[p].count(); ++i) {
+            if (d->queues[p].at(i)->autoDelete())
+                delete d->queues[p].at(i);
+        }
+    }
+    delete d;
+}
+
+void Qtilities::Core::IdleScheduler::schedule(IdleJob* job, JobPriority priority) {
+    if (!job)
+        return;
+
+    bool start_slice = false;
+    d->mutex.lock();
+    QHash<IdleJob*,int>::iterator itr = d->job_priorities.find(job);
+    if (itr == d->job_priorities.end()) {
+        d->job_priorities[job] = priority;
+        if (job != d->current_job)
+            d->queues[priority].append(job);
+    } else if (itr.value() != priority) {
+        // The job of the running step is queued again with its new priority when the step returns:
+        if (job != d->current_job) {
+            d->queues[itr.value()].removeOne(job);
+            d->queues[priority].append(job);
+        }
+        itr.value() = priority;
+    }
+    if (!d->slice_pending) {
+        d->slice_pending = true;
+        start_slice = true;
+    }
+    d->mutex.unlock();
+
+    if (start_slice) {
+        if (QThread::currentThread() == thread())
+            startSliceTimer();
+        else
+            QMetaObject::invokeMethod(this,"startSliceTimer",Qt::QueuedConnection);
+    }
+}
+
+bool Qtilities::Core::IdleScheduler::scheduleInvoke(QObject* receiver, const char* member, JobPriority priority) {
+    if (!receiver || !member)
+        return false;
+
+    qti_private_InvokeKey key(receiver,QByteArray(member));
+    d->mutex.lock();
+    if (d->invokes.contains(key)) {
+        d->mutex.unlock();
+        return false;
+    }
+    qti_private_InvokeJob* job = new qti_private_InvokeJob(d,receiver,key.second);
+    d->invokes[key] = job;
+    d->mutex.unlock();
+
+    schedule(job,priority);
+    return true;
+}
+
+bool Qtilities::Core::IdleScheduler::cancel(IdleJob* job) {
+    if (!job)
+        return false;
+
+    QMutexLocker locker(&d->mutex);
+    QHash<IdleJob*,int>::iterator itr = d->job_priorities.find(job);
+    if (itr == d->job_priorities.end())
+        return false;
+
+    if (job == d->current_job) {
+        // Deleted once its step returns:
+        d->current_job_cancelled = true;
+        d->job_priorities.erase(itr);
+        return true;
+    }
+
+    d->queues[itr.value()].removeOne(job);
+    d->job_priorities.erase(itr);
+    locker.unlock();
+
+    if (job->autoDelete())
+        delete job;
+    return true;
+}
+
+void Qtilities::Core::IdleScheduler::cancelInvokes(QObject* receiver) {
+    if (!receiver)
+        return;
+
+    QList<IdleJob*> jobs;
+    d->mutex.lock();
+    QHash<qti_private_InvokeKey,IdleJob*>::iterator itr = d->invokes.begin();
+    while (itr != d->invokes.end()) {
+        if (itr.key().first == receiver) {
+            jobs << itr.value();
+            itr = d->invokes.erase(itr);
+        } else
+            ++itr;
+    }
+    d->mutex.unlock();
+
+    for (int i = 0; i < jobs.count(); ++i)
+        cancel(jobs.at(i));
+}
+
+bool Qtilities::Core::IdleScheduler::isScheduled(IdleJob* job) const {
+    QMutexLocker locker(&d->mutex);
+    return d->job_priorities.contains(job);
+}
+
+int Qtilities::Core::IdleScheduler::pendingJobCount() const {
+    QMutexLocker locker(&d->mutex);
+    return d->job_priorities.count();
+}
+
+void Qtilities::Core::IdleScheduler::runPendingJobs() {
+    if (d->running)
+        return;
+
+    d->running = true;
+    runSteps(-1);
+    d->running = false;
+}
+
+void Qtilities::Core::IdleScheduler::setFrameBudget(int msec) {
+    d->frame_budget = qMax(1,msec);
+}
+
+int Qtilities::Core::IdleScheduler::frameBudget() const {
+    return d->frame_budget;
+}
+
+bool Qtilities::Core::IdleScheduler::yieldToEventLoop(QEventLoop::ProcessEventsFlags flags) {
+    if (!QCoreApplication::instance() || QThread::currentThread() != thread())
+        return false;
+    if (d->yielding)
+        return false;
+    if (d->last_yield.isValid() && d->last_yield.elapsed() < d->frame_budget)
+        return false;
+
+    d->yielding = true;
+    QCoreApplication::processEvents(flags);
+    d->yielding = false;
+    d->last_yield.start();
+
+    // Slices which were due while events were processed run once control returns to the event loop:
+    if (d->slice_deferred) {
+        d->slice_deferred = false;
+        startSliceTimer();
+    }
+    return true;
+}
+
+bool Qtilities::Core::IdleScheduler::isYielding() const {
+    return d->yielding;
+}
+
+void Qtilities::Core::IdleScheduler::runSlice() {
+    // Jobs never run inside a yield, or inside the step of another job which processes events itself:
+    if (d->yielding || d->running) {
+        d->slice_deferred = true;
+        return;
+    }
+
+    d->mutex.lock();
+    d->slice_pending = false;
+    d->mutex.unlock();
+
+    d->running = true;
+    bool jobs_left = runSteps(d->frame_budget);
+    d->running = false;
+
+    if (jobs_left || d->slice_deferred) {
+        d->slice_deferred = false;
+        d->mutex.lock();
+        d->slice_pending = true;
+        d->mutex.unlock();
+        startSliceTimer();
+    }
+}
+
+void Qtilities::Core::IdleScheduler::startSliceTimer() {
+    d->slice_timer->start();
+}
+
+bool Qtilities::Core::IdleScheduler::runSteps(int budget) {
+    QElapsedTimer slice_timer;
+    slice_timer.start();
+
+    forever {
+        d->mutex.lock();
+        IdleJob* job = 0;
+        for (int p = HighPriority; p <= LowPriority && !job; ++p) {
+            if (!d->queues[p].isEmpty())
+                job = d->queues[p].takeFirst();
+        }
+        if (!job) {
+            d->mutex.unlock();
+            return false;
+        }
+        d->current_job = job;
+        d->current_job_cancelled = false;
+        d->mutex.unlock();
+
+        bool has_more_work = job->runStep();
+
+        bool delete_job = false;
+        d->mutex.lock();
+        d->current_job = 0;
+        if (d->current_job_cancelled) {
+            delete_job = job->autoDelete();
+        } else if (!has_more_work) {
+            d->job_priorities.remove(job);
+            delete_job = job->autoDelete();
+        } else {
+            // Jobs with the same priority take turns:
+            d->queues[d->job_priorities.value(job,NormalPriority)].append(job);
+        }
+        d->mutex.unlock();
+
+        if (delete_job)
+            delete job;
+
+        if (budget >= 0 && slice_timer.elapsed() >= budget) {
+            QMutexLocker locker(&d->mutex);
+            return !d->job_priorities.isEmpty();
+        }
+    }
+}
@@ -0,0 +1,187 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef IDLE_SCHEDULER_H
+#define IDLE_SCHEDULER_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QEventLoop>
+#include <QObject>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \class IdleJob
+        \brief A job which is split into small steps which are run by the IdleScheduler when the application is idle.
+
+        Implement runStep() to do the next small piece of work, and return true as long as there is work left:
+
+\code
+class RecountJob : public IdleJob {
+public:
+    RecountJob(Observer* observer) : d_observer(observer), d_index(0), d_count(0) {}
+
+    bool runStep() {
+        if (!d_observer || d_index >= d_observer->subjectCount())
+            return false;
+        if (d_observer->subjectAt(d_index++)->inherits("TreeItem"))
+            ++d_count;
+        return true;
+    }
+
+private:
+    QPointer<Observer> d_observer;
+    int d_index;
+    int d_count;
+};
+
+IDLE_SCHEDULER->schedule(new RecountJob(my_observer),IdleScheduler::LowPriority);
+\endcode
+
+        Jobs are deleted by the scheduler when they are finished or cancelled, unless setAutoDelete(false) was called.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT IdleJob
+        {
+        public:
+            IdleJob() : d_auto_delete(true) {}
+            virtual ~IdleJob() {}
+
+            //! Does the next step of the job.
+            /*!
+              Steps should be short, the scheduler checks its frame budget between steps.
+
+              \returns True when the job has more work to do, false when it is finished.
+              */
+            virtual bool runStep() = 0;
+
+            //! Indicates if the scheduler deletes the job when it is finished or cancelled. True by default.
+            inline bool autoDelete() const { return d_auto_delete; }
+            //! Sets if the scheduler deletes the job when it is finished or cancelled.
+            inline void setAutoDelete(bool auto_delete) { d_auto_delete = auto_delete; }
+
+        private:
+            bool d_auto_delete;
+        };
+
+        /*!
+        \struct IdleSchedulerPrivateData
+        \brief Structure used by IdleScheduler to store private data.
+          */
+        struct IdleSchedulerPrivateData;
+
+        /*!
+        \class IdleScheduler
+        \brief A cooperative scheduler which runs time sliced jobs when the application is idle.
+
+        Long loops in the GUI thread traditionally stay responsive by calling QCoreApplication::processEvents(). Doing so re-enters the
+        event loop at arbitrary points: slots run in the middle of the loop, views rebuild while their models are half updated and the
+        latency of the loop depends on the events which happen to be pending. The idle scheduler provides two alternatives:
+
+        - Work which does not have to complete before the caller returns is split into steps using IdleJob, or into repeated calls to a
+          slot using scheduleInvoke(). The scheduler runs the steps of the jobs in the order of their priorities once all pending events
+          were processed, for at most frameBudget() milliseconds at a time before it returns to the event loop.
+        - Loops which must complete before the caller returns call yieldToEventLoop() instead of QCoreApplication::processEvents().
+          Events are processed at most once every frameBudget() milliseconds, and never while another yieldToEventLoop() call is already
+          processing events, thus nested loops do not re-enter each other. Scheduled jobs do not run while events are processed in a yield.
+
+        The scheduler of the application is available through Qtilities::Core::QtilitiesCoreApplication::idleScheduler() or the
+        \p IDLE_SCHEDULER macro. Jobs run in the thread of the scheduler, which is the main thread. schedule() and scheduleInvoke()
+        can be called from any thread, all other functions must be called in the thread of the scheduler.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT IdleScheduler : public QObject
+        {
+            Q_OBJECT
+            Q_ENUMS(JobPriority)
+
+        public:
+            //! The priorities of scheduled jobs.
+            /*!
+              Jobs with a higher priority run before all jobs with a lower priority. Jobs with the same priority take turns step by step.
+              */
+            enum JobPriority {
+                HighPriority    = 0,    /*!< Work the user is waiting for, for example showing the output of a process. */
+                NormalPriority  = 1,    /*!< Default priority. */
+                LowPriority     = 2     /*!< Background work, for example refreshing caches. */
+            };
+
+            IdleScheduler(QObject* parent = 0);
+            ~IdleScheduler();
+
+            //! Schedules \p job to run with \p priority.
+            /*!
+              Scheduling a job which is already scheduled changes its priority.
+              */
+            void schedule(IdleJob* job, JobPriority priority = NormalPriority);
+            //! Schedules a call to \p member on \p receiver, which is a slot or invokable method without arguments.
+            /*!
+              Calls to the same \p member on the same \p receiver are coalesced while the call is pending, thus this can be called every time
+              the receiver has new work. The call is dropped when \p receiver is destroyed before it runs. When \p receiver lives in another thread,
+              the call is queued to that thread.
+
+              \param member The name of the method without its signature, for example \p "readStandardOutput".
+              \returns True when the call was scheduled, false when the same call was already pending.
+              */
+            bool scheduleInvoke(QObject* receiver, const char* member, JobPriority priority = NormalPriority);
+            //! Removes \p job from the scheduler. The job is deleted when its autoDelete() is true.
+            /*!
+              \returns True when \p job was scheduled.
+              */
+            bool cancel(IdleJob* job);
+            //! Removes all pending calls on \p receiver which were scheduled using scheduleInvoke().
+            void cancelInvokes(QObject* receiver);
+            //! Indicates if \p job is scheduled.
+            bool isScheduled(IdleJob* job) const;
+            //! Returns the number of scheduled jobs and pending calls.
+            int pendingJobCount() const;
+            //! Runs all scheduled jobs, and jobs which they schedule, until none are left without returning to the event loop.
+            /*!
+              This is useful before the application exits, or in tests.
+              */
+            void runPendingJobs();
+
+            //! Sets the maximum time in milliseconds for which jobs run before control returns to the event loop.
+            /*!
+              This is also the minimum time between event processing done by yieldToEventLoop(). Default is 16 milliseconds, thus one frame at 60 Hz.
+              */
+            void setFrameBudget(int msec);
+            //! Gets the maximum time in milliseconds for which jobs run before control returns to the event loop.
+            int frameBudget() const;
+
+            //! Processes pending events when frameBudget() milliseconds passed since events were last processed by a yield.
+            /*!
+              Use this instead of QCoreApplication::processEvents() in loops which must complete before they return.
+
+              \returns True when events were processed, false when the budget did not pass yet, when another yield is already processing
+              events, or when this is not called in the thread of the scheduler.
+              */
+            bool yieldToEventLoop(QEventLoop::ProcessEventsFlags flags = QEventLoop::AllEvents);
+            //! Indicates if yieldToEventLoop() is busy processing events.
+            bool isYielding() const;
+
+        private slots:
+            void runSlice();
+            void startSliceTimer();
+
+        private:
+            //! Runs steps until the budget is used or no jobs are left. Returns true when jobs are left.
+            bool runSteps(int budget);
+
+            IdleSchedulerPrivateData* d;
+        };
+    }
+}
+
+#endif // IDLE_SCHEDULER_H
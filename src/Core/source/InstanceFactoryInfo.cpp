@@ -11,6 +11,7 @@
 
 #include "IFactoryProvider.h"
 #include "QtilitiesCoreConstants.h"
+#include "CompactBinaryFormat.h"
 
 #include <QtXml>
 
@@ -33,6 +34,14 @@ quint32 MARKER_IFI_CLASS_SECTION = 0xBAADF00D;
 bool Qtilities::Core::InstanceFactoryInfo::exportBinary(QDataStream& stream, Qtilities::ExportVersion version) const {
     Q_UNUSED(version)
 
+    // Within compact observer exports the tags are repeated for almost every subject, thus they are written through the string table:
+    if (CompactBinaryFormat::isActive(stream)) {
+        CompactBinaryFormat::writeString(stream,d_factory_tag);
+        CompactBinaryFormat::writeString(stream,d_instance_tag);
+        CompactBinaryFormat::writeString(stream,d_instance_name);
+        return true;
+    }
+
     stream << MARKER_IFI_CLASS_SECTION;
     stream << d_factory_tag;
     stream << d_instance_tag;
@@ -46,6 +55,17 @@ bool Qtilities::Core::InstanceFactoryInfo::importBinary(QDataStream& stream, Qti
 
     // We don't do a version check here. Observer will do it for us.
 
+    if (CompactBinaryFormat::isActive(stream)) {
+        d_factory_tag = CompactBinaryFormat::readString(stream);
+        d_instance_tag = CompactBinaryFormat::readString(stream);
+        d_instance_name = CompactBinaryFormat::readString(stream);
+        if (stream.status() != QDataStream::Ok) {
+            LOG_ERROR("InstanceFactoryInfo binary import failed to read compact factory data. Import will fail: " + QString(Q_FUNC_INFO));
+            return false;
+        }
+        return true;
+    }
+
     quint32 ui32;
     stream >> ui32;
     if (ui32 != MARKER_IFI_CLASS_SECTION) {
@@ -96,3 +116,38 @@ bool Qtilities::Core::InstanceFactoryInfo::importXml(QDomDocument* doc, QDomElem
 
     return true;
 }
+
+bool Qtilities::Core::InstanceFactoryInfo::exportXmlStream(QXmlStreamWriter* writer, Qtilities::ExportVersion version) const {
+    Q_UNUSED(version)
+
+    if (!writer)
+        return false;
+
+    if (d_factory_tag != QString(qti_def_FACTORY_QTILITIES))
+        writer->writeAttribute("FactoryTag", d_factory_tag);
+    writer->writeAttribute("InstanceFactoryInfo", d_instance_tag);
+    if (d_instance_tag != d_instance_name)
+        writer->writeAttribute("Name", d_instance_name);
+
+    return true;
+}
+
+bool Qtilities::Core::InstanceFactoryInfo::importXmlStream(const QXmlStreamAttributes& attributes, Qtilities::ExportVersion version) {
+    Q_UNUSED(version)
+
+    // We don't do a version check here. Observer will do it for us.
+
+    if (attributes.hasAttribute("FactoryTag"))
+        d_factory_tag = attributes.value("FactoryTag").toString();
+    else
+        d_factory_tag = QString(qti_def_FACTORY_QTILITIES);
+
+    d_instance_tag = attributes.value("InstanceFactoryInfo").toString();
+
+    if (!attributes.hasAttribute("Name"))
+        d_instance_name = d_instance_tag;
+    else
+        d_instance_name = attributes.value("Name").toString();
+
+    return true;
+}
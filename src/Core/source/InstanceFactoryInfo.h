@@ -17,6 +17,8 @@
 
 class QDomDocument;
 class QDomElement;
+class QXmlStreamAttributes;
+class QXmlStreamWriter;
 
 namespace Qtilities {
     namespace Core {
@@ -116,6 +118,16 @@ namespace Qtilities {
               the %Qtilities factory tag is used by default.
               */
             virtual bool importXml(QDomDocument* doc, QDomElement* object_node, Qtilities::ExportVersion version);
+            //! Writes the same attributes as exportXml() to the current element of \p writer.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual bool exportXmlStream(QXmlStreamWriter* writer, Qtilities::ExportVersion version) const;
+            //! Reads the attributes written by exportXml() or exportXmlStream() from \p attributes.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual bool importXmlStream(const QXmlStreamAttributes& attributes, Qtilities::ExportVersion version);
 
             //! The name of the factory which must be used to create the instance.
             QString d_factory_tag;
@@ -0,0 +1,230 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "MemoryUsageReport.h"
+#include "QtilitiesProperty.h"
+
+#include <QObject>
+#include <QStringList>
+#include <QTextStream>
+
+using namespace Qtilities::Core;
+
+namespace {
+    //! The estimated size of the private data of a QObject, which holds its object name, children, connections and dynamic properties.
+    const int qti_private_OBJECT_PRIVATE_BYTES = 14 * sizeof(void*);
+    //! The estimated size of the header of implicitly shared containers and strings.
+    const int qti_private_SHARED_HEADER_BYTES = 3 * sizeof(void*);
+    //! The estimated overhead of a node in a QHash or QMap, excluding its key and value.
+    const int qti_private_HASH_NODE_BYTES = 3 * sizeof(void*);
+
+    //! Used to sort entry names by bytes.
+    struct qti_private_MemoryUsageName {
+        qti_private_MemoryUsageName() : bytes(0) {}
+        qti_private_MemoryUsageName(const QString& name, qint64 bytes) : name(name), bytes(bytes) {}
+
+        QString name;
+        qint64  bytes;
+
+        bool operator<(const qti_private_MemoryUsageName& other) const {
+            if (bytes != other.bytes)
+                return bytes > other.bytes;
+            return name < other.name;
+        }
+    };
+}
+
+QString Qtilities::Core::MemoryUsageReport::memoryCategoryToString(MemoryCategory category) {
+    if (category == ObjectMemory)
+        return "Objects";
+    else if (category == PropertyMemory)
+        return "Dynamic Properties";
+    else if (category == ObserverMemory)
+        return "Observers";
+    else if (category == FilterMemory)
+        return "Subject Filters";
+    else if (category == HintsMemory)
+        return "Observer Hints";
+    else if (category == ModelItemMemory)
+        return "Model Items";
+    return QString();
+}
+
+Qtilities::Core::MemoryUsageReport::MemoryUsageReport() {
+
+}
+
+void Qtilities::Core::MemoryUsageReport::addBytes(MemoryCategory category, const QString& name, qint64 bytes, int count) {
+    MemoryUsageEntry& entry = d_entries[category][name];
+    entry.bytes += bytes;
+    entry.count += count;
+}
+
+bool Qtilities::Core::MemoryUsageReport::addObject(const QObject* obj, MemoryCategory category) {
+    if (!obj || d_counted_objects.contains(obj))
+        return false;
+    d_counted_objects.insert(obj);
+
+    qint64 object_bytes = sizeof(QObject) + qti_private_OBJECT_PRIVATE_BYTES;
+    if (!obj->objectName().isEmpty())
+        object_bytes += estimatedStringBytes(obj->objectName());
+    if (!obj->children().isEmpty())
+        object_bytes += estimatedListBytes(obj->children().count(),sizeof(void*));
+    addBytes(category,QString::fromLatin1(obj->metaObject()->className()),object_bytes);
+
+    const QList<QByteArray> property_names = obj->dynamicPropertyNames();
+    for (int i = 0; i < property_names.count(); ++i) {
+        const QByteArray& property_name = property_names.at(i);
+        qint64 property_bytes = qti_private_SHARED_HEADER_BYTES + property_name.size();
+        property_bytes += estimatedVariantBytes(obj->property(property_name.constData()));
+        addBytes(PropertyMemory,QString::fromLatin1(property_name),property_bytes);
+    }
+
+    return true;
+}
+
+bool Qtilities::Core::MemoryUsageReport::containsObject(const QObject* obj) const {
+    return d_counted_objects.contains(obj);
+}
+
+void Qtilities::Core::MemoryUsageReport::merge(const MemoryUsageReport& other) {
+    QMap<int,QMap<QString,MemoryUsageEntry> >::const_iterator category_itr = other.d_entries.constBegin();
+    while (category_itr != other.d_entries.constEnd()) {
+        QMap<QString,MemoryUsageEntry>::const_iterator entry_itr = category_itr.value().constBegin();
+        while (entry_itr != category_itr.value().constEnd()) {
+            addBytes((MemoryCategory) category_itr.key(),entry_itr.key(),entry_itr.value().bytes,entry_itr.value().count);
+            ++entry_itr;
+        }
+        ++category_itr;
+    }
+    d_counted_objects.unite(other.d_counted_objects);
+}
+
+void Qtilities::Core::MemoryUsageReport::clear() {
+    d_entries.clear();
+    d_counted_objects.clear();
+}
+
+qint64 Qtilities::Core::MemoryUsageReport::totalBytes() const {
+    qint64 total = 0;
+    QMap<int,QMap<QString,MemoryUsageEntry> >::const_iterator category_itr = d_entries.constBegin();
+    while (category_itr != d_entries.constEnd()) {
+        total += bytes((MemoryCategory) category_itr.key());
+        ++category_itr;
+    }
+    return total;
+}
+
+qint64 Qtilities::Core::MemoryUsageReport::bytes(MemoryCategory category) const {
+    qint64 total = 0;
+    const QMap<QString,MemoryUsageEntry> entries = d_entries.value(category);
+    QMap<QString,MemoryUsageEntry>::const_iterator itr = entries.constBegin();
+    while (itr != entries.constEnd()) {
+        total += itr.value().bytes;
+        ++itr;
+    }
+    return total;
+}
+
+qint64 Qtilities::Core::MemoryUsageReport::bytes(MemoryCategory category, const QString& name) const {
+    return d_entries.value(category).value(name).bytes;
+}
+
+int Qtilities::Core::MemoryUsageReport::count(MemoryCategory category, const QString& name) const {
+    return d_entries.value(category).value(name).count;
+}
+
+QStringList Qtilities::Core::MemoryUsageReport::names(MemoryCategory category) const {
+    QList<qti_private_MemoryUsageName> sorted_names;
+    const QMap<QString,MemoryUsageEntry> entries = d_entries.value(category);
+    QMap<QString,MemoryUsageEntry>::const_iterator itr = entries.constBegin();
+    while (itr != entries.constEnd()) {
+        sorted_names << qti_private_MemoryUsageName(itr.key(),itr.value().bytes);
+        ++itr;
+    }
+    qSort(sorted_names);
+
+    QStringList names;
+    for (int i = 0; i < sorted_names.count(); ++i)
+        names << sorted_names.at(i).name;
+    return names;
+}
+
+int Qtilities::Core::MemoryUsageReport::objectCount() const {
+    return d_counted_objects.count();
+}
+
+QString Qtilities::Core::MemoryUsageReport::toString() const {
+    QString report_string;
+    QTextStream out(&report_string);
+    out << "Estimated memory usage: " << totalBytes() << " bytes\n";
+    for (int category = ObjectMemory; category <= ModelItemMemory; ++category) {
+        QStringList category_names = names((MemoryCategory) category);
+        if (category_names.isEmpty())
+            continue;
+
+        out << memoryCategoryToString((MemoryCategory) category) << ": " << bytes((MemoryCategory) category) << " bytes\n";
+        for (int i = 0; i < category_names.count(); ++i)
+            out << "    " << category_names.at(i) << ": " << bytes((MemoryCategory) category,category_names.at(i))
+                << " bytes (" << count((MemoryCategory) category,category_names.at(i)) << ")\n";
+    }
+    out.flush();
+    return report_string;
+}
+
+qint64 Qtilities::Core::MemoryUsageReport::estimatedStringBytes(const QString& string) {
+    return qti_private_SHARED_HEADER_BYTES + (string.capacity() + 1) * sizeof(QChar);
+}
+
+qint64 Qtilities::Core::MemoryUsageReport::estimatedVariantBytes(const QVariant& variant) {
+    qint64 variant_bytes = sizeof(QVariant);
+    if (!variant.isValid())
+        return variant_bytes;
+
+    if (variant.userType() == qMetaTypeId<MultiContextProperty>()) {
+        MultiContextProperty property = variant.value<MultiContextProperty>();
+        const QList<quint32> context_ids = property.contextIds();
+        variant_bytes += sizeof(MultiContextProperty) + estimatedHashBytes(context_ids.count(),sizeof(quint32));
+        for (int i = 0; i < context_ids.count(); ++i)
+            variant_bytes += estimatedVariantBytes(property.value(context_ids.at(i)));
+    } else if (variant.userType() == qMetaTypeId<SharedProperty>()) {
+        SharedProperty property = variant.value<SharedProperty>();
+        variant_bytes += sizeof(SharedProperty) + estimatedVariantBytes(property.value());
+    } else if (variant.type() == QVariant::String) {
+        variant_bytes += estimatedStringBytes(variant.toString());
+    } else if (variant.type() == QVariant::ByteArray) {
+        variant_bytes += qti_private_SHARED_HEADER_BYTES + variant.toByteArray().capacity();
+    } else if (variant.type() == QVariant::StringList) {
+        const QStringList strings = variant.toStringList();
+        variant_bytes += estimatedListBytes(strings.count(),sizeof(void*));
+        for (int i = 0; i < strings.count(); ++i)
+            variant_bytes += estimatedStringBytes(strings.at(i));
+    } else if (variant.type() == QVariant::List) {
+        const QList<QVariant> values = variant.toList();
+        variant_bytes += estimatedListBytes(values.count(),sizeof(void*));
+        for (int i = 0; i < values.count(); ++i)
+            variant_bytes += estimatedVariantBytes(values.at(i));
+    }
+    return variant_bytes;
+}
+
+qint64 Qtilities::Core::MemoryUsageReport::estimatedHashBytes(int count, int entry_bytes) {
+    if (count <= 0)
+        return 0;
+    // Every entry is a node, and the bucket array holds a pointer per entry:
+    return qti_private_SHARED_HEADER_BYTES + (qint64) count * (entry_bytes + qti_private_HASH_NODE_BYTES + sizeof(void*));
+}
+
+qint64 Qtilities::Core::MemoryUsageReport::estimatedListBytes(int count, int item_bytes) {
+    if (count <= 0)
+        return 0;
+    return qti_private_SHARED_HEADER_BYTES + (qint64) count * item_bytes;
+}
@@ -0,0 +1,133 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef MEMORY_USAGE_REPORT_H
+#define MEMORY_USAGE_REPORT_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \class MemoryUsageReport
+        \brief The MemoryUsageReport class holds an estimate of the memory used by a part of an application, broken down by category.
+
+        Reports are created by Observer::memoryUsage() for the tree underneath an observer, by IObjectManager::memoryUsage() for the global object
+        pool and by models showing trees, for example Qtilities::CoreGui::ObserverTreeModel::memoryUsage(). Reports can be combined using merge():
+
+\code
+MemoryUsageReport report = my_observer->memoryUsage();
+report.merge(my_tree_model->memoryUsage());
+
+qDebug() << report.toString();
+if (report.bytes(MemoryUsageReport::PropertyMemory) > property_quota)
+    qDebug() << "The most expensive property is" << report.names(MemoryUsageReport::PropertyMemory).front();
+\endcode
+
+        Every category contains named entries. The meaning of the names depends on the category, see MemoryCategory. Each entry holds the estimated
+        number of bytes and the number of instances which were counted for it.
+
+        \note The numbers are estimates which are based on the sizes of the data structures used by Qt and %Qtilities on the platform. They do not
+        include allocator overhead and memory fragmentation, thus they are meant to compare the parts of an application and to find where memory goes,
+        not to predict the memory used by the process.
+
+        The debug plugin shows memory usage reports of the global object pool and of the objects in it.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT MemoryUsageReport
+        {
+        public:
+            //! The categories in which memory is reported.
+            enum MemoryCategory {
+                ObjectMemory        = 0,    /*!< QObjects and their object names. Entries are named by class name. */
+                PropertyMemory      = 1,    /*!< Dynamic properties, including the values of MultiContextProperty and SharedProperty properties. Entries are named by property name. */
+                ObserverMemory      = 2,    /*!< The bookkeeping of observers, for example their subject lists, indexes, caches and the connections to their subjects. Entries are named by data structure. */
+                FilterMemory        = 3,    /*!< Subject filters. The filter objects are named by class name, the state they keep about their subjects (see AbstractSubjectFilter::estimatedStateBytes()) by filter name. */
+                HintsMemory         = 4,    /*!< Observer hints. Entries are named by class name. */
+                ModelItemMemory     = 5     /*!< The items of models showing trees. Entries are named by item class. */
+            };
+            //! Returns a string representation of \p category.
+            static QString memoryCategoryToString(MemoryCategory category);
+
+            MemoryUsageReport();
+
+            //! Adds \p bytes used by \p count instances to the entry named \p name in \p category.
+            void addBytes(MemoryCategory category, const QString& name, qint64 bytes, int count = 1);
+            //! Adds the estimated memory used by \p obj and its dynamic properties.
+            /*!
+              The object itself is counted in \p category under its class name, its dynamic properties in PropertyMemory under their names.
+              Objects are counted once per report, thus objects which are attached to multiple observers in a tree are not counted twice.
+
+              \returns False when \p obj is null or when it was counted in this report already.
+              */
+            bool addObject(const QObject* obj, MemoryCategory category = ObjectMemory);
+            //! Indicates if \p obj was counted in this report using addObject().
+            bool containsObject(const QObject* obj) const;
+            //! Adds the entries of \p other to this report.
+            /*!
+              Objects counted in both reports are only counted once when this report is merged with reports created after the merge.
+              The entries which were counted in both reports before the merge are added together.
+              */
+            void merge(const MemoryUsageReport& other);
+            //! Removes all entries from the report.
+            void clear();
+
+            //! Returns the estimated number of bytes in all categories.
+            qint64 totalBytes() const;
+            //! Returns the estimated number of bytes in \p category.
+            qint64 bytes(MemoryCategory category) const;
+            //! Returns the estimated number of bytes of the entry named \p name in \p category.
+            qint64 bytes(MemoryCategory category, const QString& name) const;
+            //! Returns the number of instances counted for the entry named \p name in \p category.
+            int count(MemoryCategory category, const QString& name) const;
+            //! Returns the names of the entries in \p category, sorted from the largest to the smallest number of bytes.
+            QStringList names(MemoryCategory category) const;
+            //! Returns the number of objects counted using addObject().
+            int objectCount() const;
+
+            //! Returns a text representation of the report with one line per entry, grouped by category.
+            QString toString() const;
+
+            //! Returns the estimated number of bytes used by \p string, including its header.
+            static qint64 estimatedStringBytes(const QString& string);
+            //! Returns the estimated number of bytes used by \p variant, including the data it refers to.
+            /*!
+              The contexts and values of MultiContextProperty values, and the values of SharedProperty values are included.
+              */
+            static qint64 estimatedVariantBytes(const QVariant& variant);
+            //! Returns the estimated number of bytes used by a QHash, QSet or QMap with \p count entries of \p entry_bytes each.
+            static qint64 estimatedHashBytes(int count, int entry_bytes);
+            //! Returns the estimated number of bytes used by a QList or QVector with \p count items of \p item_bytes each.
+            static qint64 estimatedListBytes(int count, int item_bytes);
+
+        private:
+            //! An entry in a category.
+            struct MemoryUsageEntry {
+                MemoryUsageEntry() : bytes(0), count(0) {}
+
+                qint64  bytes;
+                int     count;
+            };
+
+            QMap<int,QMap<QString,MemoryUsageEntry> >   d_entries;
+            QSet<const QObject*>                        d_counted_objects;
+        };
+    }
+}
+
+#endif // MEMORY_USAGE_REPORT_H
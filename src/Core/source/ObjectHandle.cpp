@@ -0,0 +1,72 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ObjectHandle.h"
+#include "QtilitiesCoreApplication.h"
+
+Qtilities::Core::ObjectHandle::ObjectHandle(QObject* obj) : d_id(0), d_generation(0) {
+    if (obj)
+        *this = OBJECT_MANAGER->objectHandle(obj);
+}
+
+QObject* Qtilities::Core::ObjectHandle::object() const {
+    if (isNull())
+        return 0;
+    return OBJECT_MANAGER->handleObject(*this);
+}
+
+Qtilities::Core::ObjectHandleList::ObjectHandleList(const QList<QObject*>& objects) {
+    if (!objects.isEmpty())
+        d_handles = OBJECT_MANAGER->objectHandles(objects);
+}
+
+Qtilities::Core::ObjectHandleList::ObjectHandleList(const QList<QPointer<QObject> >& objects) {
+    if (objects.isEmpty())
+        return;
+
+    QList<QObject*> normal_objects;
+    normal_objects.reserve(objects.count());
+    for (int i = 0; i < objects.count(); ++i)
+        normal_objects << objects.at(i);
+    d_handles = OBJECT_MANAGER->objectHandles(normal_objects);
+}
+
+int Qtilities::Core::ObjectHandleList::indexOf(const QObject* obj) const {
+    if (!obj || d_handles.isEmpty())
+        return -1;
+
+    // Objects without a handle can't be in the list:
+    ObjectHandle handle = OBJECT_MANAGER->findObjectHandle(obj);
+    if (handle.isNull())
+        return -1;
+    return d_handles.indexOf(handle);
+}
+
+QList<QObject*> Qtilities::Core::ObjectHandleList::objects() const {
+    if (d_handles.isEmpty())
+        return QList<QObject*>();
+
+    QList<QObject*> objects = OBJECT_MANAGER->handleObjects(d_handles);
+    objects.removeAll(0);
+    return objects;
+}
+
+QList<QPointer<QObject> > Qtilities::Core::ObjectHandleList::toSafeList() const {
+    QList<QPointer<QObject> > safe_objects;
+    if (d_handles.isEmpty())
+        return safe_objects;
+
+    const QList<QObject*> objects = OBJECT_MANAGER->handleObjects(d_handles);
+    safe_objects.reserve(objects.count());
+    for (int i = 0; i < objects.count(); ++i)
+        safe_objects << objects.at(i);
+    return safe_objects;
+}
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef OBJECT_HANDLE_H
+#define OBJECT_HANDLE_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QList>
+#include <QMetaType>
+#include <QPointer>
+#include <QVector>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+          \class ObjectHandle
+          \brief The ObjectHandle class is a weak reference to a QObject which is cheap to copy.
+
+          A QPointer registers itself with Qt every time it is created or copied. Lists of QPointer objects are passed around for selections
+          and active objects, thus every copy of a large selection registers and unregisters every pointer in it. An ObjectHandle consists
+          of a slot ID and a generation in the object handle table of the object manager (see Qtilities::Core::Interfaces::IObjectManager::objectHandle()).
+          Only the first handle created for an object registers it, all other handles for the object are plain values which are copied
+          without any bookkeeping.
+
+\code
+QObject* obj = new QObject;
+ObjectHandle handle(obj);
+Q_ASSERT(handle.object() == obj);
+
+delete obj;
+Q_ASSERT(handle.object() == 0);
+Q_ASSERT(!handle.isNull());
+\endcode
+
+          When an object is destroyed its slot gets a new generation, thus handles to destroyed objects resolve to null even when the slot
+          is used by a new object. Handles can be created and resolved in any thread.
+
+          \sa ObjectHandleList
+
+          <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT ObjectHandle
+        {
+        public:
+            //! Constructs a null handle.
+            ObjectHandle() : d_id(0), d_generation(0) {}
+            //! Constructs a handle to \p obj. When \p obj is null, a null handle is constructed.
+            ObjectHandle(QObject* obj);
+            //! Constructs a handle from a slot ID and generation, as returned by id() and generation().
+            ObjectHandle(quint32 id, quint32 generation) : d_id(id), d_generation(generation) {}
+
+            //! Indicates if this is a null handle, thus a handle which was never assigned an object.
+            /*!
+              \note A handle to an object which was destroyed is not null, use object() to check if the object still exists.
+              */
+            inline bool isNull() const { return d_id == 0; }
+            //! Returns the object this handle refers to, or null when the object was destroyed or when this is a null handle.
+            QObject* object() const;
+            //! Returns the slot ID of the handle, 0 for null handles.
+            inline quint32 id() const { return d_id; }
+            //! Returns the generation of the slot when the handle was created.
+            inline quint32 generation() const { return d_generation; }
+
+            inline bool operator==(const ObjectHandle& other) const {
+                return d_id == other.d_id && d_generation == other.d_generation;
+            }
+            inline bool operator!=(const ObjectHandle& other) const {
+                return !(*this==other);
+            }
+
+        private:
+            quint32 d_id;
+            quint32 d_generation;
+        };
+
+        //! Allows ObjectHandle to be used as a key in QHash and QSet.
+        inline uint qHash(const ObjectHandle& handle) {
+            return handle.id() ^ (handle.generation() << 16);
+        }
+    }
+}
+
+Q_DECLARE_TYPEINFO(Qtilities::Core::ObjectHandle, Q_PRIMITIVE_TYPE);
+Q_DECLARE_METATYPE(Qtilities::Core::ObjectHandle)
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+          \class ObjectHandleList
+          \brief The ObjectHandleList class is an immutable list of object handles which is cheap to copy.
+
+          ObjectHandleList is the handle based counterpart of QList<QPointer<QObject> > and is used for selections and active objects.
+          The list is implicitly shared and cannot be changed after construction, thus copies only increase a reference count, regardless
+          of the number of objects in the list. Resolve the objects in the list using objects() or object().
+
+          Lists can be constructed from and converted to QList<QObject*> and QList<QPointer<QObject> >:
+
+\code
+ObjectHandleList selection(observer->subjectReferences());
+QList<QPointer<QObject> > safe_selection = selection.toSafeList();
+\endcode
+
+          <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT ObjectHandleList
+        {
+        public:
+            //! Constructs an empty list.
+            ObjectHandleList() {}
+            //! Constructs a list with handles to \p objects. Null objects get null handles.
+            ObjectHandleList(const QList<QObject*>& objects);
+            //! Constructs a list with handles to \p objects. Null pointers get null handles.
+            ObjectHandleList(const QList<QPointer<QObject> >& objects);
+            //! Constructs a list from \p handles.
+            ObjectHandleList(const QVector<ObjectHandle>& handles) : d_handles(handles) {}
+
+            //! Returns the number of handles in the list.
+            inline int count() const { return d_handles.count(); }
+            //! Indicates if the list is empty.
+            inline bool isEmpty() const { return d_handles.isEmpty(); }
+            //! Returns the handle at \p index, which must be a valid index.
+            inline const ObjectHandle& at(int index) const { return d_handles.at(index); }
+            //! Returns the object at \p index, or null when it was destroyed. The index must be valid.
+            inline QObject* object(int index) const { return d_handles.at(index).object(); }
+            //! Returns the index of the handle to \p obj, or -1 when the list does not contain a handle to \p obj.
+            int indexOf(const QObject* obj) const;
+            //! Indicates if the list contains a handle to \p obj.
+            inline bool contains(const QObject* obj) const { return indexOf(obj) != -1; }
+            //! Returns the handles in the list.
+            inline const QVector<ObjectHandle>& handles() const { return d_handles; }
+
+            //! Returns the objects in the list which still exist, in the order of the list.
+            QList<QObject*> objects() const;
+            //! Returns the objects in the list as guarded pointers, for use with APIs taking QList<QPointer<QObject> >. Destroyed objects are null.
+            QList<QPointer<QObject> > toSafeList() const;
+
+            inline bool operator==(const ObjectHandleList& other) const {
+                return d_handles == other.d_handles;
+            }
+            inline bool operator!=(const ObjectHandleList& other) const {
+                return !(*this==other);
+            }
+
+        private:
+            QVector<ObjectHandle> d_handles;
+        };
+    }
+}
+
+Q_DECLARE_METATYPE(Qtilities::Core::ObjectHandleList)
+
+#endif // OBJECT_HANDLE_H
@@ -30,6 +30,192 @@
 #include <QtCore>
 #include <QDomDocument>
 
+namespace {
+    struct InterfaceSubscription {
+        InterfaceSubscription() : added_takes_list(false), removed_takes_list(false), batched(true) {}
+
+        QPointer<QObject>   receiver;
+        QByteArray          added_method;
+        bool                added_takes_list;
+        QByteArray          removed_method;
+        bool                removed_takes_list;
+        bool                batched;
+    };
+
+    //! Resolves \p method on \p receiver, which is given using SLOT() or as a plain signature. Returns false when the method does not exist or does not take a QList<QObject*> or a QObject*.
+    bool resolveSubscriptionMethod(QObject* receiver, const char* method, QByteArray* method_name, bool* takes_list) {
+        QByteArray signature(method);
+        // SLOT() and SIGNAL() prefix the signature with a code:
+        if (!signature.isEmpty() && signature.at(0) >= '0' && signature.at(0) <= '9')
+            signature = signature.mid(1);
+        signature = QMetaObject::normalizedSignature(signature.constData());
+
+        int index = receiver->metaObject()->indexOfMethod(signature.constData());
+        if (index == -1)
+            return false;
+        QList<QByteArray> parameter_types = receiver->metaObject()->method(index).parameterTypes();
+        if (parameter_types.count() != 1)
+            return false;
+        if (parameter_types.front() == "QList<QObject*>")
+            *takes_list = true;
+        else if (parameter_types.front() == "QObject*")
+            *takes_list = false;
+        else
+            return false;
+
+        *method_name = signature.left(signature.indexOf('('));
+        return true;
+    }
+
+    struct MetaTypeSubscription {
+        MetaTypeSubscription() : throttle_msecs(0), timer_id(0), pending(false) {}
+
+        QPointer<QObject>   receiver;
+        QByteArray          method;
+        //! The parameter type of the method as it was declared when it takes an ObjectHandleList, empty when it takes a QList<QPointer<QObject> >.
+        QByteArray          handles_type_name;
+        int                 throttle_msecs;
+        //! The timer running while changes are throttled, 0 when no timer is running.
+        int                 timer_id;
+        //! Indicates if a change happened since the last delivery, while the timer is running.
+        bool                pending;
+    };
+
+    //! A slot in the object handle table of the object manager.
+    struct ObjectHandleSlot {
+        ObjectHandleSlot() : object(0), generation(1) {}
+
+        //! The object using the slot, null when the slot is free.
+        QObject*    object;
+        //! The generation of the slot, which changes every time its object is destroyed.
+        quint32     generation;
+    };
+
+    //! Notifies the subscriptions in \p subscriptions about \p objects, which were either added or removed.
+    void notifySubscriptions(const QList<InterfaceSubscription>& subscriptions, const QList<QObject*>& objects, bool added, bool notify_immediate, bool notify_batched) {
+        for (int i = 0; i < subscriptions.count(); ++i) {
+            const InterfaceSubscription& subscription = subscriptions.at(i);
+            if ((subscription.batched && !notify_batched) || (!subscription.batched && !notify_immediate))
+                continue;
+
+            const QByteArray& method_name = added ? subscription.added_method : subscription.removed_method;
+            if (method_name.isEmpty())
+                continue;
+
+            if (added ? subscription.added_takes_list : subscription.removed_takes_list) {
+                if (subscription.receiver)
+                    QMetaObject::invokeMethod(subscription.receiver,method_name.constData(),Qt::DirectConnection,Q_ARG(QList<QObject*>,objects));
+            } else {
+                // The receiver might be destroyed by one of the calls:
+                for (int o = 0; o < objects.count() && subscription.receiver; ++o)
+                    QMetaObject::invokeMethod(subscription.receiver,method_name.constData(),Qt::DirectConnection,Q_ARG(QObject*,objects.at(o)));
+            }
+        }
+    }
+
+    //! Collects the dynamic properties of \p obj which match \p property_types and are not in \p ignore_list, keyed by their names.
+    QMap<QByteArray,QVariant> collectDynamicProperties(const QObject* obj, Qtilities::Core::ObjectManager::PropertyTypeFlags property_types, const QStringList& ignore_list = QStringList()) {
+        QMap<QByteArray,QVariant> properties;
+        const int shared_type = qMetaTypeId<Qtilities::Core::SharedProperty>();
+        const int multi_context_type = qMetaTypeId<Qtilities::Core::MultiContextProperty>();
+
+        const QList<QByteArray> property_names = obj->dynamicPropertyNames();
+        for (int i = 0; i < property_names.count(); ++i) {
+            const QByteArray& property_name = property_names.at(i);
+
+            // Check if its a Qtilities property:
+            if (!(property_types & Qtilities::Core::ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
+                continue;
+
+            // Check if the property is in the ignore list:
+            if (!ignore_list.isEmpty() && ignore_list.contains(QString(property_name.constData())))
+                continue;
+
+            // Now check the property types:
+            QVariant prop = obj->property(property_name.constData());
+            if (!prop.isValid())
+                continue;
+            const int type = prop.userType();
+            if (type == shared_type) {
+                if (!(property_types & Qtilities::Core::ObjectManager::SharedProperties))
+                    continue;
+            } else if (type == multi_context_type) {
+                if (!(property_types & Qtilities::Core::ObjectManager::MultiContextProperties))
+                    continue;
+            } else if (!(property_types & Qtilities::Core::ObjectManager::NonQtilitiesProperties)) {
+                continue;
+            }
+
+            properties.insert(property_name,prop);
+        }
+
+        return properties;
+    }
+
+    //! Compares two dynamic property values. Shared and multi context properties are compared in place, without copying them out of the variants.
+    bool dynamicPropertiesEqual(const QVariant& prop1, const QVariant& prop2) {
+        const int type = prop1.userType();
+        if (type != prop2.userType())
+            return false;
+
+        if (type == qMetaTypeId<Qtilities::Core::SharedProperty>())
+            return *static_cast<const Qtilities::Core::SharedProperty*> (prop1.constData()) == *static_cast<const Qtilities::Core::SharedProperty*> (prop2.constData());
+        else if (type == qMetaTypeId<Qtilities::Core::MultiContextProperty>())
+            return *static_cast<const Qtilities::Core::MultiContextProperty*> (prop1.constData()) == *static_cast<const Qtilities::Core::MultiContextProperty*> (prop2.constData());
+
+        return prop1 == prop2;
+    }
+
+    //! Returns the string used to describe \p prop in a PropertyDiffInfo.
+    QString dynamicPropertyDiffString(const QVariant& prop) {
+        if (prop.userType() == qMetaTypeId<Qtilities::Core::MultiContextProperty>())
+            return "(" + static_cast<const Qtilities::Core::MultiContextProperty*> (prop.constData())->valueString() + ")";
+
+        QVariant value = prop;
+        if (prop.userType() == qMetaTypeId<Qtilities::Core::SharedProperty>())
+            value = static_cast<const Qtilities::Core::SharedProperty*> (prop.constData())->value();
+
+        if (!Qtilities::Core::QtilitiesProperty::isExportableVariant(value))
+            return "Non-exportable variant";
+        return value.toString();
+    }
+
+    //! Adds the differences between \p properties1 and \p properties2, which contain properties of one type, to \p property_diff_info.
+    /*!
+      Changed properties are only reported when no properties of this type were added or removed.
+      */
+    void appendDynamicPropertyDiffs(const QMap<QByteArray,QVariant>& properties1, const QMap<QByteArray,QVariant>& properties2, Qtilities::Core::PropertyDiffInfo* property_diff_info) {
+        bool is_changed = true;
+        // Check for added properties:
+        for (QMap<QByteArray,QVariant>::const_iterator itr = properties1.constBegin(); itr != properties1.constEnd(); ++itr) {
+            if (!properties2.contains(itr.key())) {
+                property_diff_info->d_added_properties[QString(itr.key().constData())] = dynamicPropertyDiffString(itr.value());
+                is_changed = false;
+            }
+        }
+        // Check for removed properties:
+        for (QMap<QByteArray,QVariant>::const_iterator itr = properties2.constBegin(); itr != properties2.constEnd(); ++itr) {
+            if (!properties1.contains(itr.key())) {
+                property_diff_info->d_removed_properties[QString(itr.key().constData())] = dynamicPropertyDiffString(itr.value());
+                is_changed = false;
+            }
+        }
+        // Check for changed properties:
+        if (is_changed) {
+            for (QMap<QByteArray,QVariant>::const_iterator itr = properties1.constBegin(); itr != properties1.constEnd(); ++itr) {
+                QMap<QByteArray,QVariant>::const_iterator itr2 = properties2.constFind(itr.key());
+                if (itr2 == properties2.constEnd() || dynamicPropertiesEqual(itr.value(),itr2.value()))
+                    continue;
+
+                QString value1_string = dynamicPropertyDiffString(itr.value());
+                QString value2_string = dynamicPropertyDiffString(itr2.value());
+                if (value2_string != value1_string)
+                    property_diff_info->d_changed_properties[QString(itr.key().constData())] = value2_string + "," + value1_string;
+            }
+        }
+    }
+}
+
 using namespace Qtilities::Core::Constants;
 using namespace Qtilities::Core::Properties;
 using namespace Qtilities::Core::Interfaces;
@@ -37,22 +223,49 @@ using namespace Qtilities::Core::Interfaces;
 struct Qtilities::Core::ObjectManagerPrivateData {
     ObjectManagerPrivateData() : object_pool(qti_def_GLOBAL_OBJECT_POOL,QObject::tr("Pool of exposed global objects.")),
       id(1),
-      itr_id(1) { }
-
-    QHash<int,QPointer<Observer> >              context_map;
+      itr_id(1),
+      notification_batch_count(0) { }
+
+    //! The observers registered with the object manager, indexed by observer ID.
+    /*!
+      Observer IDs are handed out in increasing order and are never reused, thus IDs are resolved with a
+      single array access and the ID of a deleted observer can never resolve to another observer.
+      Index 0 is the global object pool.
+      */
+    QVector<QPointer<Observer> >                observer_table;
     QMap<QString, IFactoryProvider*>            factory_map;
-    QMap<QString, QList<QPointer<QObject> > >   meta_type_map;
+    QMap<QString,ObjectHandleList>              meta_type_map;
     Observer                                    object_pool;
     int                                         id;
     int                                         itr_id;
     Factory<QObject>                            qtilities_factory;
+    //! The interface subscriptions, keyed by interface ID.
+    QHash<QByteArray,QList<InterfaceSubscription> > interface_subscriptions;
+    //! The objects in the pool implementing each subscribed interface, used to find the subscribers of objects which are being destroyed.
+    QHash<QByteArray,QSet<QObject*> >           interface_objects;
+    int                                         notification_batch_count;
+    QHash<QByteArray,QList<QObject*> >          batched_added;
+    QHash<QByteArray,QList<QObject*> >          batched_removed;
+    QHash<QString,QList<MetaTypeSubscription> > meta_type_subscriptions;
+    //! The meta types of the running throttle timers, keyed by timer ID.
+    QHash<int,QString>                          meta_type_timers;
+    //! The object handle table. The ID of a handle is its slot index plus one, thus 0 is never used.
+    QVector<ObjectHandleSlot>                   handle_slots;
+    //! The indexes of the free slots in handle_slots.
+    QVector<int>                                free_handle_slots;
+    //! The handle IDs of objects in the object handle table.
+    QHash<const QObject*,quint32>               handle_ids;
+    //! Protects the object handle table, since handles are used in all threads.
+    mutable QMutex                              handle_mutex;
 };
 
 Qtilities::Core::ObjectManager::ObjectManager(QObject* parent) : IObjectManager(parent)
 {
     d = new ObjectManagerPrivateData;
+    d->observer_table.append(QPointer<Observer>(&d->object_pool));
     d->object_pool.startProcessingCycle();
     connect(&d->object_pool,SIGNAL(subjectDeleted(QObject*)),SIGNAL(objectRemoved(QObject*)));
+    connect(&d->object_pool,SIGNAL(subjectDeleted(QObject*)),SLOT(handleObjectRemoved(QObject*)));
 
     setObjectName(tr("Object Manager"));
 
@@ -72,6 +285,9 @@ Qtilities::Core::ObjectManager::ObjectManager(QObject* parent) : IObjectManager(
 
     // Register some meta types:
     qRegisterMetaType<Qtilities::Core::QtilitiesCategory>("Qtilities::Core::QtilitiesCategory");
+    qRegisterMetaType<Qtilities::Core::ObjectHandle>("Qtilities::Core::ObjectHandle");
+    qRegisterMetaType<Qtilities::Core::ObjectHandleList>("Qtilities::Core::ObjectHandleList");
+    qRegisterMetaType<Qtilities::Core::ObjectHandleList>("ObjectHandleList");
 
     // Register some stream operators:
     qRegisterMetaTypeStreamOperators<Qtilities::Core::QtilitiesCategory>("Qtilities::Core::QtilitiesCategory");
@@ -87,8 +303,8 @@ Qtilities::Core::ObjectManager::~ObjectManager()
 
 int Qtilities::Core::ObjectManager::registerObserver(Observer* observer) {
     if (observer) {
-        QPointer<Observer> q_pointer = observer;
-        d->context_map[d->id] = q_pointer;
+        Q_ASSERT(d->observer_table.count() == d->id);
+        d->observer_table.append(QPointer<Observer>(observer));
         d->id = d->id + 1;
         return d->id-1;
     }
@@ -153,7 +369,7 @@ QMap<QString, QtilitiesCategory> ObjectManager::tagCategoryMap(const QString &fa
 }
 
 QObject* Qtilities::Core::ObjectManager::createInstance(const InstanceFactoryInfo& ifactory_data) {
-    if (ifactory_data.d_factory_tag == QString(qti_def_FACTORY_QTILITIES)) {
+    if (ifactory_data.d_factory_tag == QLatin1String(qti_def_FACTORY_QTILITIES)) {
         QObject* obj = d->qtilities_factory.createInstance(ifactory_data.d_instance_tag);
         if (obj) {
             return obj;
@@ -163,11 +379,9 @@ QObject* Qtilities::Core::ObjectManager::createInstance(const InstanceFactoryInf
 }
 
 Qtilities::Core::Observer* Qtilities::Core::ObjectManager::observerReference(int id) const {
-    if (d->context_map.contains(id)) {
-        return d->context_map.value(id);
-    } else if (id == 0) {
-        return &d->object_pool;
-    } else
+    if (id >= 0 && id < d->observer_table.count())
+        return d->observer_table.at(id);
+    else
         return 0;
 }
 
@@ -183,78 +397,97 @@ bool Qtilities::Core::ObjectManager::moveSubjects(QList<QObject*> objects, int s
     if (!source_observer || !destination_observer)
         return false;
 
-    bool none_failed = true;
-
-    // For now we discard objects that cause problems during attachment and detachment
+    // Validate the complete move before changing anything, thus a rejected object leaves both observers untouched:
+    QList<QObject*> valid_objects;
     for (int i = 0; i < objects.count(); ++i) {
-        // Check if the destination observer will accept it
-        Observer::EvaluationResult result = destination_observer->canAttach(objects.at(i),Observer::ManualOwnership,error_msg,silent);
-        if (result == Observer::Rejected) {           
-            break;
-        } else {
-            // Detach from source
-            result = source_observer->canDetach(objects.at(i));
-            if (result == Observer::Rejected) {
-                QString error_msg_int = "The move operation could not be completed. Detachment of the object(s) you are trying to move was rejected by the destination observer. Check the session log for more details.";
-                LOG_ERROR(error_msg_int);
-                if (error_msg)
-                    *error_msg = error_msg_int;
-                none_failed = false;
-                break;
-            } else if (result == Observer::IsParentObserver) {              
-                QString error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer which is defined to be their owner.\n\nTry to share with (copy to) the destination observer instead.";
-                LOG_ERROR(error_msg_int);
-                if (error_msg)
-                    *error_msg = error_msg_int;
-                none_failed = false;
-                break;
-            } else if (result == Observer::LastScopedObserver) {
-                destination_observer->setMultiContextPropertyValue(objects.at(i),qti_prop_OWNERSHIP,QVariant(Observer::ManualOwnership));
-                if (!source_observer->detachSubject(objects.at(i))) {
-                    QString error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer where LastScopedObserver was detected. Check the session log for more details.";
-                    LOG_ERROR(error_msg_int);
-                    if (error_msg)
-                        *error_msg = error_msg_int;
-                    destination_observer->setMultiContextPropertyValue(objects.at(i),qti_prop_OWNERSHIP,QVariant(Observer::ObserverScopeOwnership));
-                    none_failed = false;
-                    break;
-                } else {
-                    if (!destination_observer->attachSubject(objects.at(i),Observer::ObserverScopeOwnership)) {
-                        source_observer->attachSubject(objects.at(i),Observer::ObserverScopeOwnership,error_msg);
-                        QString error_msg_int;
-                        if (error_msg)
-                            error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Error message: " + *error_msg;
-                        else
-                            error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Calling ObjectManager::moveSubjects() with a valid error message argument will add an error message to this message.";
-                        LOG_ERROR(error_msg_int);
-                        if (error_msg)
-                            *error_msg = error_msg_int;
-                    }
-                }
-            } else {
-                if (!source_observer->detachSubject(objects.at(i))) {
-                    QString error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer. Check the session log for more details.";
-                    LOG_ERROR(error_msg_int);
-                    if (error_msg)
-                        *error_msg = error_msg_int;
-                    none_failed = false;
-                    break;
-                } else {
-                    if (!destination_observer->attachSubject(objects.at(i))) {
-                        source_observer->attachSubject(objects.at(i));
-                        QString error_msg_int;
-                        if (error_msg)
-                            error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Error message: " + *error_msg;
-                        else
-                            error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Calling ObjectManager::moveSubjects() with a valid error message argument will add an error message to this message.";
-                        LOG_ERROR(error_msg_int);
-                    }
-                }
+        QObject* obj = objects.at(i);
+        if (!obj || valid_objects.contains(obj))
+            continue;
+
+        QString reject_msg;
+        if (destination_observer->canAttach(obj,Observer::ManualOwnership,&reject_msg,silent) == Observer::Rejected) {
+            QString error_msg_int = QString("The move operation could not be completed. The destination observer rejected object \"%1\". Error message: %2").arg(obj->objectName()).arg(reject_msg);
+            LOG_ERROR(error_msg_int);
+            if (error_msg)
+                *error_msg = error_msg_int;
+            return false;
+        }
+
+        Observer::EvaluationResult result = source_observer->canDetach(obj,&reject_msg);
+        if (result == Observer::Rejected) {
+            QString error_msg_int = "The move operation could not be completed. Detachment of the object(s) you are trying to move was rejected by the source observer. Check the session log for more details.";
+            LOG_ERROR(error_msg_int);
+            if (error_msg)
+                *error_msg = error_msg_int;
+            return false;
+        } else if (result == Observer::IsParentObserver) {
+            QString error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer which is defined to be their owner.\n\nTry to share with (copy to) the destination observer instead.";
+            LOG_ERROR(error_msg_int);
+            if (error_msg)
+                *error_msg = error_msg_int;
+            return false;
+        }
+
+        valid_objects << obj;
+    }
+
+    if (valid_objects.isEmpty())
+        return true;
+
+    // Both observers report the complete move as a single change set when their processing cycles end:
+    source_observer->startProcessingCycle();
+    destination_observer->startProcessingCycle();
+
+    // The objects are attached to the destination before they are detached from the source. While they are attached to
+    // both observers, objects using Observer::ObserverScopeOwnership are not the last scoped subjects of the source and
+    // will not be deleted when they are detached. Attaching them using Observer::ManualOwnership keeps their current ownership.
+    QString attach_msg;
+    QList<QPointer<QObject> > attached_objects = destination_observer->attachSubjects(valid_objects,Observer::ManualOwnership,&attach_msg);
+
+    bool success = (attached_objects.count() == valid_objects.count());
+    QString error_msg_int;
+    if (success) {
+        QString detach_msg;
+        QList<QObject*> objects_to_detach;
+        for (int i = 0; i < attached_objects.count(); ++i) {
+            if (attached_objects.at(i))
+                objects_to_detach << attached_objects.at(i);
+        }
+        QList<QPointer<QObject> > detached_objects = source_observer->detachSubjects(objects_to_detach,&detach_msg);
+        if (detached_objects.count() != objects_to_detach.count()) {
+            success = false;
+            error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be removed from the source observer. Error message: " + detach_msg;
+
+            // Roll back: Attach the objects which were detached to the source again.
+            QList<QObject*> objects_to_restore;
+            for (int i = 0; i < detached_objects.count(); ++i) {
+                if (detached_objects.at(i))
+                    objects_to_restore << detached_objects.at(i);
             }
+            source_observer->attachSubjects(objects_to_restore,Observer::ManualOwnership);
+        }
+    } else {
+        error_msg_int = "The move operation could not be completed. The object(s) you are trying to move cannot be attached to the destination observer. Error message: " + attach_msg;
+    }
+
+    if (!success) {
+        // Roll back: Detach the objects which were attached to the destination. They are still attached to the source, thus they won't be deleted.
+        QList<QObject*> objects_to_remove;
+        for (int i = 0; i < attached_objects.count(); ++i) {
+            if (attached_objects.at(i))
+                objects_to_remove << attached_objects.at(i);
         }
+        destination_observer->detachSubjects(objects_to_remove);
+
+        LOG_ERROR(error_msg_int);
+        if (error_msg)
+            *error_msg = error_msg_int;
     }
 
-    return none_failed;
+    destination_observer->endProcessingCycle();
+    source_observer->endProcessingCycle();
+
+    return success;
 }
 
 bool Qtilities::Core::ObjectManager::moveSubjects(QList<QPointer<QObject> > objects, int source_observer_id, int destination_observer_id, QString* error_msg, bool silent) {
@@ -278,13 +511,17 @@ void Qtilities::Core::ObjectManager::registerObject(QObject* obj, QtilitiesCateg
             }
         }
     }
-    if (d->object_pool.attachSubject(obj))
+    if (d->object_pool.attachSubject(obj)) {
         emit newObjectAdded(obj);
+        notifyObjectAdded(obj);
+    }
 }
 
 void Qtilities::Core::ObjectManager::removeObject(QObject* obj) {
-    if (d->object_pool.detachSubject(obj))
+    if (d->object_pool.detachSubject(obj)) {
         emit objectRemoved(obj);
+        handleObjectRemoved(obj);
+    }
 }
 
 void Qtilities::Core::ObjectManager::registerFactoryInterface(FactoryInterface<QObject>* factory_interface, FactoryItemID iface_tag) {
@@ -355,22 +592,450 @@ QList<QObject*> Qtilities::Core::ObjectManager::registeredInterfaces(const QStri
     return d->object_pool.subjectReferences(iface);
 }
 
-void Qtilities::Core::ObjectManager::setMetaTypeActiveObjects(QList<QObject*> objects, const QString& meta_type) {
-    QList<QPointer<QObject> > smart_objects;
-    for (int i = 0; i < objects.count(); ++i)
-        smart_objects << objects.at(i);
+bool Qtilities::Core::ObjectManager::subscribeToInterface(const QString& iface, QObject* receiver, const char* added_method, const char* removed_method, bool batched) {
+    if (!receiver || iface.isEmpty() || (!added_method && !removed_method))
+        return false;
+
+    InterfaceSubscription subscription;
+    subscription.receiver = receiver;
+    subscription.batched = batched;
+    if (added_method && !resolveSubscriptionMethod(receiver,added_method,&subscription.added_method,&subscription.added_takes_list)) {
+        LOG_ERROR(QString(tr("Failed to subscribe \"%1\" to interface \"%2\": Method \"%3\" does not exist or does not take a QList<QObject*> or a QObject*.")).arg(receiver->objectName()).arg(iface).arg(QString(added_method)));
+        return false;
+    }
+    if (removed_method && !resolveSubscriptionMethod(receiver,removed_method,&subscription.removed_method,&subscription.removed_takes_list)) {
+        LOG_ERROR(QString(tr("Failed to subscribe \"%1\" to interface \"%2\": Method \"%3\" does not exist or does not take a QList<QObject*> or a QObject*.")).arg(receiver->objectName()).arg(iface).arg(QString(removed_method)));
+        return false;
+    }
+
+    const QByteArray iface_id = iface.toUtf8();
+    QList<InterfaceSubscription>& subscriptions = d->interface_subscriptions[iface_id];
+    for (int i = subscriptions.count() - 1; i >= 0; --i) {
+        if (!subscriptions.at(i).receiver || subscriptions.at(i).receiver == receiver)
+            subscriptions.removeAt(i);
+    }
+    subscriptions << subscription;
+
+    if (!d->interface_objects.contains(iface_id))
+        d->interface_objects[iface_id] = registeredInterfaces(iface).toSet();
+    return true;
+}
+
+void Qtilities::Core::ObjectManager::unsubscribeFromInterface(const QString& iface, QObject* receiver) {
+    const QByteArray iface_id = iface.toUtf8();
+    if (!d->interface_subscriptions.contains(iface_id))
+        return;
+
+    QList<InterfaceSubscription>& subscriptions = d->interface_subscriptions[iface_id];
+    for (int i = subscriptions.count() - 1; i >= 0; --i) {
+        if (!subscriptions.at(i).receiver || subscriptions.at(i).receiver == receiver)
+            subscriptions.removeAt(i);
+    }
+
+    if (subscriptions.isEmpty()) {
+        d->interface_subscriptions.remove(iface_id);
+        d->interface_objects.remove(iface_id);
+        d->batched_added.remove(iface_id);
+        d->batched_removed.remove(iface_id);
+    }
+}
+
+void Qtilities::Core::ObjectManager::startNotificationBatch() {
+    ++d->notification_batch_count;
+}
+
+void Qtilities::Core::ObjectManager::endNotificationBatch() {
+    if (d->notification_batch_count == 0) {
+        LOG_WARNING(tr("ObjectManager::endNotificationBatch() called without a matching call to startNotificationBatch()."));
+        return;
+    }
+
+    if (--d->notification_batch_count == 0)
+        deliverBatchedNotifications();
+}
+
+void Qtilities::Core::ObjectManager::notifyObjectAdded(QObject* obj) {
+    if (!obj || d->interface_subscriptions.isEmpty())
+        return;
+
+    // Subscribers might subscribe or unsubscribe while they are notified, thus find the interfaces first:
+    QList<QByteArray> iface_ids;
+    QHash<QByteArray,QList<InterfaceSubscription> >::const_iterator itr;
+    for (itr = d->interface_subscriptions.constBegin(); itr != d->interface_subscriptions.constEnd(); ++itr) {
+        if (obj->inherits(itr.key().constData()))
+            iface_ids << itr.key();
+    }
+
+    for (int i = 0; i < iface_ids.count(); ++i) {
+        const QByteArray& iface_id = iface_ids.at(i);
+        d->interface_objects[iface_id].insert(obj);
+        bool batching = d->notification_batch_count > 0;
+        if (batching)
+            d->batched_added[iface_id] << obj;
+        notifySubscriptions(d->interface_subscriptions.value(iface_id),QList<QObject*>() << obj,true,true,!batching);
+    }
+}
 
-    d->meta_type_map[meta_type] = smart_objects;
-    emit metaTypeActiveObjectsChanged(smart_objects,meta_type);
+void Qtilities::Core::ObjectManager::handleObjectRemoved(QObject* obj) {
+    if (!obj || d->interface_objects.isEmpty())
+        return;
+
+    // Objects being destroyed no longer implement their interfaces, thus use interface_objects to find them:
+    QList<QByteArray> iface_ids;
+    QHash<QByteArray,QSet<QObject*> >::iterator itr;
+    for (itr = d->interface_objects.begin(); itr != d->interface_objects.end(); ++itr) {
+        if (itr.value().remove(obj))
+            iface_ids << itr.key();
+    }
+
+    for (int i = 0; i < iface_ids.count(); ++i) {
+        const QByteArray& iface_id = iface_ids.at(i);
+        bool batching = d->notification_batch_count > 0;
+        // Objects which were registered during the batch are not reported to batched subscribers at all:
+        if (batching && !d->batched_added[iface_id].removeOne(obj))
+            d->batched_removed[iface_id] << obj;
+        notifySubscriptions(d->interface_subscriptions.value(iface_id),QList<QObject*>() << obj,false,true,!batching);
+    }
+}
+
+void Qtilities::Core::ObjectManager::deliverBatchedNotifications() {
+    QHash<QByteArray,QList<QObject*> > batched_removed = d->batched_removed;
+    QHash<QByteArray,QList<QObject*> > batched_added = d->batched_added;
+    d->batched_removed.clear();
+    d->batched_added.clear();
+
+    QHash<QByteArray,QList<QObject*> >::const_iterator itr;
+    for (itr = batched_removed.constBegin(); itr != batched_removed.constEnd(); ++itr) {
+        if (!itr.value().isEmpty())
+            notifySubscriptions(d->interface_subscriptions.value(itr.key()),itr.value(),false,false,true);
+    }
+    for (itr = batched_added.constBegin(); itr != batched_added.constEnd(); ++itr) {
+        if (!itr.value().isEmpty())
+            notifySubscriptions(d->interface_subscriptions.value(itr.key()),itr.value(),true,false,true);
+    }
+}
+
+void Qtilities::Core::ObjectManager::setMetaTypeActiveObjects(QList<QObject*> objects, const QString& meta_type) {
+    setMetaTypeActiveObjects(ObjectHandleList(objects),meta_type);
 }
 
 void Qtilities::Core::ObjectManager::setMetaTypeActiveObjects(QList<QPointer<QObject> > objects, const QString& meta_type) {
+    setMetaTypeActiveObjects(ObjectHandleList(objects),meta_type);
+}
+
+void Qtilities::Core::ObjectManager::setMetaTypeActiveObjects(const ObjectHandleList& objects, const QString& meta_type) {
+    // Views set the same selection repeatedly, there is no need to notify listeners about it:
+    QMap<QString,ObjectHandleList>::iterator itr = d->meta_type_map.find(meta_type);
+    if (itr != d->meta_type_map.end() && itr.value() == objects)
+        return;
+
+    ObjectHandleList previous_objects;
+    if (itr != d->meta_type_map.end())
+        previous_objects = itr.value();
     d->meta_type_map[meta_type] = objects;
-    emit metaTypeActiveObjectsChanged(objects,meta_type);
+    emit metaTypeActiveObjectHandlesChanged(objects,meta_type);
+    // Guarded pointer lists are only created for listeners which use them:
+    if (receivers(SIGNAL(metaTypeActiveObjectsChanged(QList<QPointer<QObject> >,QString))) > 0)
+        emit metaTypeActiveObjectsChanged(objects.toSafeList(),meta_type);
+
+    if (receivers(SIGNAL(metaTypeActiveObjectsDelta(QList<QPointer<QObject> >,QList<QPointer<QObject> >,QString))) > 0) {
+        const QVector<ObjectHandle>& previous_handles = previous_objects.handles();
+        const QVector<ObjectHandle>& current_handles = objects.handles();
+        QSet<ObjectHandle> previous_set;
+        for (int i = 0; i < previous_handles.count(); ++i)
+            previous_set.insert(previous_handles.at(i));
+        QSet<ObjectHandle> current_set;
+        for (int i = 0; i < current_handles.count(); ++i)
+            current_set.insert(current_handles.at(i));
+
+        QVector<ObjectHandle> added;
+        for (int i = 0; i < current_handles.count(); ++i) {
+            if (!previous_set.contains(current_handles.at(i)))
+                added << current_handles.at(i);
+        }
+        QVector<ObjectHandle> removed;
+        for (int i = 0; i < previous_handles.count(); ++i) {
+            if (!current_set.contains(previous_handles.at(i)))
+                removed << previous_handles.at(i);
+        }
+        if (!added.isEmpty() || !removed.isEmpty())
+            emit metaTypeActiveObjectsDelta(ObjectHandleList(added).toSafeList(),ObjectHandleList(removed).toSafeList(),meta_type);
+    }
+
+    notifyMetaTypeSubscribers(meta_type);
+}
+
+bool Qtilities::Core::ObjectManager::subscribeToMetaTypeActiveObjects(const QString& meta_type, QObject* receiver, const char* method, int throttle_msecs) {
+    if (!receiver || !method)
+        return false;
+
+    QByteArray signature(method);
+    // SLOT() prefixes the signature with a code:
+    if (!signature.isEmpty() && signature.at(0) >= '0' && signature.at(0) <= '9')
+        signature = signature.mid(1);
+    signature = QMetaObject::normalizedSignature(signature.constData());
+    int index = receiver->metaObject()->indexOfMethod(signature.constData());
+    QList<QByteArray> parameter_types;
+    if (index != -1)
+        parameter_types = receiver->metaObject()->method(index).parameterTypes();
+    QByteArray handles_type_name;
+    if (parameter_types.count() == 1 && QMetaType::type(parameter_types.front().constData()) == qMetaTypeId<ObjectHandleList>())
+        handles_type_name = parameter_types.front();
+    if (handles_type_name.isEmpty() && (parameter_types.count() != 1 || parameter_types.front() != QMetaObject::normalizedType("QList<QPointer<QObject> >"))) {
+        LOG_ERROR(QString(tr("Failed to subscribe \"%1\" to meta type \"%2\": Method \"%3\" does not exist or does not take a QList<QPointer<QObject> > or an ObjectHandleList.")).arg(receiver->objectName()).arg(meta_type).arg(QString(method)));
+        return false;
+    }
+
+    unsubscribeFromMetaTypeActiveObjects(meta_type,receiver);
+
+    MetaTypeSubscription subscription;
+    subscription.receiver = receiver;
+    subscription.method = signature.left(signature.indexOf('('));
+    subscription.handles_type_name = handles_type_name;
+    subscription.throttle_msecs = qMax(0,throttle_msecs);
+    d->meta_type_subscriptions[meta_type] << subscription;
+    return true;
+}
+
+void Qtilities::Core::ObjectManager::unsubscribeFromMetaTypeActiveObjects(const QString& meta_type, QObject* receiver) {
+    if (!d->meta_type_subscriptions.contains(meta_type))
+        return;
+
+    QList<MetaTypeSubscription>& subscriptions = d->meta_type_subscriptions[meta_type];
+    for (int i = subscriptions.count() - 1; i >= 0; --i) {
+        if (!subscriptions.at(i).receiver || subscriptions.at(i).receiver == receiver) {
+            if (subscriptions.at(i).timer_id != 0) {
+                killTimer(subscriptions.at(i).timer_id);
+                d->meta_type_timers.remove(subscriptions.at(i).timer_id);
+            }
+            subscriptions.removeAt(i);
+        }
+    }
+    if (subscriptions.isEmpty())
+        d->meta_type_subscriptions.remove(meta_type);
+}
+
+Qtilities::Core::MemoryUsageReport Qtilities::Core::ObjectManager::memoryUsage(bool recursive) const {
+    MemoryUsageReport report = d->object_pool.memoryUsage(recursive);
+
+    report.addBytes(MemoryUsageReport::ObserverMemory,"Object manager: Observer table",MemoryUsageReport::estimatedListBytes(d->observer_table.count(),sizeof(QPointer<Observer>)),d->observer_table.count());
+
+    int interface_object_count = 0;
+    QHash<QByteArray,QSet<QObject*> >::const_iterator iface_itr = d->interface_objects.constBegin();
+    while (iface_itr != d->interface_objects.constEnd()) {
+        interface_object_count += iface_itr.value().count();
+        ++iface_itr;
+    }
+    report.addBytes(MemoryUsageReport::ObserverMemory,"Object manager: Interface index",MemoryUsageReport::estimatedHashBytes(d->interface_objects.count(),sizeof(QByteArray) + sizeof(QSet<QObject*>))
+                    + MemoryUsageReport::estimatedHashBytes(interface_object_count,sizeof(void*)),interface_object_count);
+
+    int subscription_count = 0;
+    QHash<QByteArray,QList<InterfaceSubscription> >::const_iterator subscription_itr = d->interface_subscriptions.constBegin();
+    while (subscription_itr != d->interface_subscriptions.constEnd()) {
+        subscription_count += subscription_itr.value().count();
+        ++subscription_itr;
+    }
+    QHash<QString,QList<MetaTypeSubscription> >::const_iterator meta_type_subscription_itr = d->meta_type_subscriptions.constBegin();
+    while (meta_type_subscription_itr != d->meta_type_subscriptions.constEnd()) {
+        subscription_count += meta_type_subscription_itr.value().count();
+        ++meta_type_subscription_itr;
+    }
+    report.addBytes(MemoryUsageReport::ObserverMemory,"Object manager: Subscriptions",(qint64) subscription_count * (sizeof(InterfaceSubscription) + sizeof(void*)),subscription_count);
+
+    int meta_type_object_count = 0;
+    QMap<QString,ObjectHandleList>::const_iterator meta_type_itr = d->meta_type_map.constBegin();
+    while (meta_type_itr != d->meta_type_map.constEnd()) {
+        meta_type_object_count += meta_type_itr.value().count();
+        ++meta_type_itr;
+    }
+    report.addBytes(MemoryUsageReport::ObserverMemory,"Object manager: Meta type active objects",MemoryUsageReport::estimatedHashBytes(d->meta_type_map.count(),sizeof(QString) + sizeof(ObjectHandleList))
+                    + MemoryUsageReport::estimatedListBytes(meta_type_object_count,sizeof(ObjectHandle)),meta_type_object_count);
+
+    QMutexLocker locker(&d->handle_mutex);
+    report.addBytes(MemoryUsageReport::ObserverMemory,"Object manager: Object handle table",MemoryUsageReport::estimatedListBytes(d->handle_slots.capacity(),sizeof(ObjectHandleSlot))
+                    + MemoryUsageReport::estimatedListBytes(d->free_handle_slots.capacity(),sizeof(int))
+                    + MemoryUsageReport::estimatedHashBytes(d->handle_ids.count(),sizeof(void*) + sizeof(quint32)),d->handle_ids.count());
+
+    return report;
+}
+
+void Qtilities::Core::ObjectManager::notifyMetaTypeSubscribers(const QString& meta_type) {
+    if (!d->meta_type_subscriptions.contains(meta_type))
+        return;
+
+    // Receivers might subscribe or unsubscribe while they are notified, thus notify a copy:
+    QList<MetaTypeSubscription> subscriptions = d->meta_type_subscriptions.value(meta_type);
+    for (int i = 0; i < subscriptions.count(); ++i) {
+        if (!subscriptions.at(i).receiver)
+            continue;
+
+        if (subscriptions.at(i).throttle_msecs > 0) {
+            QList<MetaTypeSubscription>& current_subscriptions = d->meta_type_subscriptions[meta_type];
+            MetaTypeSubscription* subscription = 0;
+            for (int s = 0; s < current_subscriptions.count(); ++s) {
+                if (current_subscriptions.at(s).receiver == subscriptions.at(i).receiver) {
+                    subscription = &current_subscriptions[s];
+                    break;
+                }
+            }
+            if (!subscription)
+                continue;
+
+            // Changes during the throttle interval are delivered when it elapsed:
+            if (subscription->timer_id != 0) {
+                subscription->pending = true;
+                continue;
+            }
+            subscription->timer_id = startTimer(subscription->throttle_msecs);
+            d->meta_type_timers[subscription->timer_id] = meta_type;
+        }
+
+        deliverMetaTypeActiveObjects(subscriptions.at(i).receiver,subscriptions.at(i).method,subscriptions.at(i).handles_type_name,d->meta_type_map.value(meta_type));
+    }
+}
+
+void Qtilities::Core::ObjectManager::deliverMetaTypeActiveObjects(QObject* receiver, const QByteArray& method, const QByteArray& handles_type_name, const ObjectHandleList& objects) {
+    // The type name must match the declaration of the method, which can be with or without the namespace:
+    if (!handles_type_name.isEmpty())
+        QMetaObject::invokeMethod(receiver,method.constData(),Qt::DirectConnection,QArgument<ObjectHandleList>(handles_type_name.constData(),objects));
+    else
+        QMetaObject::invokeMethod(receiver,method.constData(),Qt::DirectConnection,Q_ARG(QList<QPointer<QObject> >,objects.toSafeList()));
+}
+
+void Qtilities::Core::ObjectManager::timerEvent(QTimerEvent* event) {
+    if (!d->meta_type_timers.contains(event->timerId())) {
+        IObjectManager::timerEvent(event);
+        return;
+    }
+
+    const QString meta_type = d->meta_type_timers.value(event->timerId());
+    QList<MetaTypeSubscription> no_subscriptions;
+    QList<MetaTypeSubscription>& subscriptions = d->meta_type_subscriptions.contains(meta_type) ? d->meta_type_subscriptions[meta_type] : no_subscriptions;
+    for (int i = 0; i < subscriptions.count(); ++i) {
+        MetaTypeSubscription& subscription = subscriptions[i];
+        if (subscription.timer_id != event->timerId())
+            continue;
+
+        if (subscription.pending && subscription.receiver) {
+            // Keep the timer running, thus changes caused by the delivery are throttled as well:
+            subscription.pending = false;
+            QPointer<QObject> receiver = subscription.receiver;
+            QByteArray method = subscription.method;
+            QByteArray handles_type_name = subscription.handles_type_name;
+            deliverMetaTypeActiveObjects(receiver,method,handles_type_name,d->meta_type_map.value(meta_type));
+        } else {
+            killTimer(subscription.timer_id);
+            d->meta_type_timers.remove(subscription.timer_id);
+            subscription.timer_id = 0;
+            subscription.pending = false;
+        }
+        return;
+    }
+
+    // The subscription ended:
+    killTimer(event->timerId());
+    d->meta_type_timers.remove(event->timerId());
 }
 
 QList<QPointer<QObject> > Qtilities::Core::ObjectManager::metaTypeActiveObjects(const QString& meta_type) const {
-    return d->meta_type_map[meta_type];
+    return d->meta_type_map.value(meta_type).toSafeList();
+}
+
+Qtilities::Core::ObjectHandleList Qtilities::Core::ObjectManager::metaTypeActiveObjectHandles(const QString& meta_type) const {
+    return d->meta_type_map.value(meta_type);
+}
+
+// --------------------------------
+// Object Handles
+// --------------------------------
+Qtilities::Core::ObjectHandle Qtilities::Core::ObjectManager::objectHandle(QObject* obj) {
+    if (!obj)
+        return ObjectHandle();
+
+    QMutexLocker locker(&d->handle_mutex);
+    return lockedObjectHandle(obj);
+}
+
+QVector<Qtilities::Core::ObjectHandle> Qtilities::Core::ObjectManager::objectHandles(const QList<QObject*>& objects) {
+    QVector<ObjectHandle> handles(objects.count());
+    QMutexLocker locker(&d->handle_mutex);
+    for (int i = 0; i < objects.count(); ++i) {
+        if (objects.at(i))
+            handles[i] = lockedObjectHandle(objects.at(i));
+    }
+    return handles;
+}
+
+Qtilities::Core::ObjectHandle Qtilities::Core::ObjectManager::findObjectHandle(const QObject* obj) const {
+    if (!obj)
+        return ObjectHandle();
+
+    QMutexLocker locker(&d->handle_mutex);
+    quint32 id = d->handle_ids.value(obj,0);
+    if (id == 0)
+        return ObjectHandle();
+    return ObjectHandle(id,d->handle_slots.at(id - 1).generation);
+}
+
+QObject* Qtilities::Core::ObjectManager::handleObject(const ObjectHandle& handle) const {
+    if (handle.isNull())
+        return 0;
+
+    QMutexLocker locker(&d->handle_mutex);
+    if ((int) handle.id() > d->handle_slots.count())
+        return 0;
+    const ObjectHandleSlot& slot = d->handle_slots.at(handle.id() - 1);
+    return slot.generation == handle.generation() ? slot.object : 0;
+}
+
+QList<QObject*> Qtilities::Core::ObjectManager::handleObjects(const QVector<ObjectHandle>& handles) const {
+    QList<QObject*> objects;
+    objects.reserve(handles.count());
+    QMutexLocker locker(&d->handle_mutex);
+    for (int i = 0; i < handles.count(); ++i) {
+        const ObjectHandle& handle = handles.at(i);
+        QObject* obj = 0;
+        if (!handle.isNull() && (int) handle.id() <= d->handle_slots.count()) {
+            const ObjectHandleSlot& slot = d->handle_slots.at(handle.id() - 1);
+            if (slot.generation == handle.generation())
+                obj = slot.object;
+        }
+        objects << obj;
+    }
+    return objects;
+}
+
+Qtilities::Core::ObjectHandle Qtilities::Core::ObjectManager::lockedObjectHandle(QObject* obj) {
+    quint32 id = d->handle_ids.value(obj,0);
+    if (id == 0) {
+        int slot_index;
+        if (d->free_handle_slots.isEmpty()) {
+            slot_index = d->handle_slots.count();
+            d->handle_slots.append(ObjectHandleSlot());
+        } else {
+            slot_index = d->free_handle_slots.last();
+            d->free_handle_slots.remove(d->free_handle_slots.count() - 1);
+        }
+        d->handle_slots[slot_index].object = obj;
+        id = slot_index + 1;
+        d->handle_ids[obj] = id;
+        // Direct connection, since objects can be destroyed in any thread:
+        connect(obj,SIGNAL(destroyed(QObject*)),SLOT(handleHandleObjectDestroyed(QObject*)),Qt::DirectConnection);
+    }
+    return ObjectHandle(id,d->handle_slots.at(id - 1).generation);
+}
+
+void Qtilities::Core::ObjectManager::handleHandleObjectDestroyed(QObject* obj) {
+    QMutexLocker locker(&d->handle_mutex);
+    quint32 id = d->handle_ids.take(obj);
+    if (id == 0)
+        return;
+
+    ObjectHandleSlot& slot = d->handle_slots[id - 1];
+    slot.object = 0;
+    // Handles to the destroyed object must not resolve to the next object using the slot:
+    ++slot.generation;
+    d->free_handle_slots << id - 1;
 }
 
 // --------------------------------
@@ -732,41 +1397,30 @@ bool Qtilities::Core::ObjectManager::cloneObjectProperties(const QObject* source
         return false;
 
     // Get all properties from source_obj:
-    QList<SharedProperty> shared_properties;
-    QList<MultiContextProperty> multi_context_properties;
-    QMap<QString,QVariant> non_qtilities_properties;
-
-    for (int i = 0; i < source_obj->dynamicPropertyNames().count(); ++i) {
-        QString property_name = QString(source_obj->dynamicPropertyNames().at(i).constData());
-        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
-            continue;
-
-        // Now check the property types:
-        QVariant prop = source_obj->property(source_obj->dynamicPropertyNames().at(i).constData());
-        if (prop.isValid() && prop.canConvert<SharedProperty>() && (property_types & ObjectManager::SharedProperties))
-            shared_properties << prop.value<SharedProperty>();
-        else if (prop.isValid() && prop.canConvert<MultiContextProperty>() && (property_types & ObjectManager::MultiContextProperties))
-            multi_context_properties << prop.value<MultiContextProperty>();
-        else if (prop.isValid() && !prop.canConvert<SharedProperty>() && !prop.canConvert<MultiContextProperty>() && property_types & ObjectManager::NonQtilitiesProperties) {
-            non_qtilities_properties[property_name] = prop;
-        }
-    }
+    QMap<QByteArray,QVariant> properties = collectDynamicProperties(source_obj,property_types);
 
     // Now that we have all the properties, we add them to the target obj:
-    for (int i = 0; i < shared_properties.count(); ++i) {
-        ObjectManager::setSharedProperty(target_obj,shared_properties.at(i));
-    }
-    LOG_TRACE(QString("Cloning %1 shared properties from object %2 to object %3.").arg(shared_properties.count()).arg(source_obj->objectName()).arg(target_obj->objectName()));
-
-    for (int i = 0; i < multi_context_properties.count(); ++i) {
-        ObjectManager::setMultiContextProperty(target_obj,multi_context_properties.at(i));
-    }
-    LOG_TRACE(QString("Cloning %1 multi context properties from object %2 to object %3.").arg(multi_context_properties.count()).arg(source_obj->objectName()).arg(target_obj->objectName()));
-
-    for (int i = 0; i < non_qtilities_properties.count(); ++i) {
-        target_obj->setProperty(non_qtilities_properties.keys().at(i).toUtf8().data(),non_qtilities_properties.values().at(i));
+    const int shared_type = qMetaTypeId<SharedProperty>();
+    const int multi_context_type = qMetaTypeId<MultiContextProperty>();
+    int shared_count = 0;
+    int multi_context_count = 0;
+    int non_qtilities_count = 0;
+    for (QMap<QByteArray,QVariant>::const_iterator itr = properties.constBegin(); itr != properties.constEnd(); ++itr) {
+        const int type = itr.value().userType();
+        if (type == shared_type) {
+            ObjectManager::setSharedProperty(target_obj,*static_cast<const SharedProperty*> (itr.value().constData()));
+            ++shared_count;
+        } else if (type == multi_context_type) {
+            ObjectManager::setMultiContextProperty(target_obj,*static_cast<const MultiContextProperty*> (itr.value().constData()));
+            ++multi_context_count;
+        } else {
+            target_obj->setProperty(itr.key().constData(),itr.value());
+            ++non_qtilities_count;
+        }
     }
-    LOG_TRACE(QString("Cloning %1 non-qtilities properties from object %2 to object %3").arg(non_qtilities_properties.count()).arg(source_obj->objectName()).arg(target_obj->objectName()));
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreLogTag,QString("Cloning %1 shared properties from object %2 to object %3.").arg(shared_count).arg(source_obj->objectName()).arg(target_obj->objectName()));
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreLogTag,QString("Cloning %1 multi context properties from object %2 to object %3.").arg(multi_context_count).arg(source_obj->objectName()).arg(target_obj->objectName()));
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreLogTag,QString("Cloning %1 non-qtilities properties from object %2 to object %3").arg(non_qtilities_count).arg(source_obj->objectName()).arg(target_obj->objectName()));
 
     return true;
 }
@@ -807,7 +1461,41 @@ bool Qtilities::Core::ObjectManager::setMultiContextProperty(QObject* obj, Multi
     }
 
     QVariant property = qVariantFromValue(multi_context_property);
-    return !obj->setProperty(multi_context_property.propertyNameString().toUtf8().data(),property);
+    QByteArray property_name = multi_context_property.propertyNameString().toUtf8();
+    bool result = !obj->setProperty(property_name.constData(),property);
+    Observer::updateSubjectMetadataInParents(obj,property_name.constData());
+    return result;
+}
+
+QVariant Qtilities::Core::ObjectManager::getMultiContextPropertyValue(const QObject* obj, const char* property_name, int context_id) {
+    if (!obj)
+        return QVariant();
+
+    QVariant prop = obj->property(property_name);
+    if (prop.userType() == qMetaTypeId<SharedProperty>())
+        return static_cast<const SharedProperty*> (prop.constData())->value();
+    else if (prop.userType() == qMetaTypeId<MultiContextProperty>())
+        return static_cast<const MultiContextProperty*> (prop.constData())->value(context_id);
+    else
+        return QVariant();
+}
+
+bool Qtilities::Core::ObjectManager::setMultiContextPropertyValue(QObject* obj, const char* property_name, const QVariant& new_value, int context_id) {
+    if (!obj)
+        return false;
+
+    // The property is changed inside the variant, thus it does not have to be boxed again:
+    QVariant prop = obj->property(property_name);
+    if (prop.userType() == qMetaTypeId<SharedProperty>())
+        static_cast<SharedProperty*> (prop.data())->setValue(new_value);
+    else if (prop.userType() == qMetaTypeId<MultiContextProperty>())
+        static_cast<MultiContextProperty*> (prop.data())->setValue(new_value,context_id);
+    else
+        return false;
+
+    obj->setProperty(property_name,prop);
+    Observer::updateSubjectMetadataInParents(obj,property_name);
+    return true;
 }
 
 Qtilities::Core::SharedProperty Qtilities::Core::ObjectManager::getSharedProperty(const QObject* obj, const char* property_name) {
@@ -846,7 +1534,10 @@ bool Qtilities::Core::ObjectManager::setSharedProperty(QObject* obj, SharedPrope
     }
 
     QVariant property = qVariantFromValue(shared_property);
-    return !obj->setProperty(shared_property.propertyNameString().toUtf8().data(),property);
+    QByteArray property_name = shared_property.propertyNameString().toUtf8();
+    bool result = !obj->setProperty(property_name.constData(),property);
+    Observer::updateSubjectMetadataInParents(obj,property_name.constData());
+    return result;
 }
 
 bool Qtilities::Core::ObjectManager::setSharedProperty(QObject* obj, const char* property_name, QVariant property_value) {
@@ -895,7 +1586,7 @@ bool Qtilities::Core::ObjectManager::removeDynamicProperties(QObject* obj, Prope
         }
     }
 
-    LOG_TRACE(QString("Removing %1 dynamic properties from object %2.").arg(to_be_removed.count()).arg(obj->objectName()));
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreLogTag,QString("Removing %1 dynamic properties from object %2.").arg(to_be_removed.count()).arg(obj->objectName()));
 
     foreach (const QString& prop_name, to_be_removed)
         obj->setProperty(prop_name.toUtf8().constData(),QVariant());
@@ -907,222 +1598,63 @@ bool Qtilities::Core::ObjectManager::compareDynamicProperties(const QObject* obj
     if (!obj1 || !obj2)
         return false;
 
-    // Get a list of properties on obj1 which must be used in comparison:
-    QMap<QString, QVariant> to_be_compared_normal1;
-    QMap<QString, SharedProperty> to_be_compared_shared1;
-    QMap<QString, MultiContextProperty> to_be_compared_multi1;
-    for (int i = 0; i < obj1->dynamicPropertyNames().count(); ++i) {
-        QString property_name = QString(obj1->dynamicPropertyNames().at(i).constData());
-
-        // Check if the property is in the ignore list:
-        if (ignore_list.contains(property_name))
-            continue;
-
-        // Check if its a Qtilities property:
-        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
-            continue;
-
-        // Now check the property types:
-        QVariant prop = obj1->property(obj1->dynamicPropertyNames().at(i).constData());
-        if (prop.isValid() && prop.canConvert<SharedProperty>() && (property_types & ObjectManager::SharedProperties))
-            to_be_compared_shared1[QString(obj1->dynamicPropertyNames().at(i).constData())] = prop.value<SharedProperty>();
-        else if (prop.isValid() && prop.canConvert<MultiContextProperty>() && (property_types & ObjectManager::MultiContextProperties))
-            to_be_compared_multi1[QString(obj1->dynamicPropertyNames().at(i).constData())] = prop.value<MultiContextProperty>();
-        else if (prop.isValid() && !prop.canConvert<SharedProperty>() && !prop.canConvert<MultiContextProperty>() && property_types & ObjectManager::NonQtilitiesProperties) {
-            to_be_compared_normal1[QString(obj1->dynamicPropertyNames().at(i).constData())] = prop;
+    // Get the properties on both objects which must be used in comparison:
+    QMap<QByteArray,QVariant> properties1 = collectDynamicProperties(obj1,property_types,ignore_list);
+    QMap<QByteArray,QVariant> properties2 = collectDynamicProperties(obj2,property_types,ignore_list);
+
+    // Both maps are sorted by name, thus they can be compared in a single pass:
+    bool is_equal = (properties1.count() == properties2.count());
+    if (is_equal) {
+        QMap<QByteArray,QVariant>::const_iterator itr1 = properties1.constBegin();
+        QMap<QByteArray,QVariant>::const_iterator itr2 = properties2.constBegin();
+        for (; itr1 != properties1.constEnd(); ++itr1, ++itr2) {
+            if (itr1.key() != itr2.key() || !dynamicPropertiesEqual(itr1.value(),itr2.value())) {
+                is_equal = false;
+                break;
+            }
         }
     }
 
-    // Get a list of properties on obj2 which must be used in comparison:
-    QMap<QString, QVariant> to_be_compared_normal2;
-    QMap<QString, SharedProperty> to_be_compared_shared2;
-    QMap<QString, MultiContextProperty> to_be_compared_multi2;
-    for (int i = 0; i < obj2->dynamicPropertyNames().count(); ++i) {
-        QString property_name = QString(obj2->dynamicPropertyNames().at(i).constData());
+    if (is_equal)
+        return true;
 
-        // Check if the property is in the ignore list:
-        if (ignore_list.contains(property_name))
-            continue;
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreLogTag,QString("Comparing dynamic properties on object %1 with object %2. Comparison found that the properties differ.").arg(obj1->objectName()).arg(obj2->objectName()));
 
-        // Check if its a Qtilities property:
-        if (!(property_types & ObjectManager::QtilitiesInternalProperties) && property_name.startsWith("qti."))
-            continue;
-
-        // Now check the property types:
-        QVariant prop = obj2->property(obj2->dynamicPropertyNames().at(i).constData());
-        if (prop.isValid() && prop.canConvert<SharedProperty>() && (property_types & ObjectManager::SharedProperties))
-            to_be_compared_shared2[QString(obj2->dynamicPropertyNames().at(i).constData())] = prop.value<SharedProperty>();
-        else if (prop.isValid() && prop.canConvert<MultiContextProperty>() && (property_types & ObjectManager::MultiContextProperties))
-            to_be_compared_multi2[QString(obj2->dynamicPropertyNames().at(i).constData())] = prop.value<MultiContextProperty>();
-        else if (prop.isValid() && !prop.canConvert<SharedProperty>() && !prop.canConvert<MultiContextProperty>() && property_types & ObjectManager::NonQtilitiesProperties) {
-            to_be_compared_normal2[QString(obj2->dynamicPropertyNames().at(i).constData())] = prop;
-        }
-    }
+    // The values are only converted to strings when the differences are requested:
+    if (!property_diff_info)
+        return false;
 
-    bool is_equal = true;
-    // Compare lists of objects to compare:
-    if (to_be_compared_normal1 != to_be_compared_normal2) {
-        LOG_TRACE(QString("Comparing dynamic properties on object %1 with object %2. Comparison found that normal QVariant properties differ.").arg(obj1->objectName()).arg(obj2->objectName()));
-        is_equal = false;
-    }
-    if (to_be_compared_shared1 != to_be_compared_shared2) {
-        LOG_TRACE(QString("Comparing dynamic properties on object %1 with object %2. Comparison found that shared properties differ.").arg(obj1->objectName()).arg(obj2->objectName()));
-        is_equal = false;
+    property_diff_info->clear();
+
+    // Split the properties by type, since differences are reported for each type separately:
+    const int shared_type = qMetaTypeId<SharedProperty>();
+    const int multi_context_type = qMetaTypeId<MultiContextProperty>();
+    QMap<QByteArray,QVariant> normal1, shared1, multi1;
+    QMap<QByteArray,QVariant> normal2, shared2, multi2;
+    for (QMap<QByteArray,QVariant>::const_iterator itr = properties1.constBegin(); itr != properties1.constEnd(); ++itr) {
+        const int type = itr.value().userType();
+        if (type == shared_type)
+            shared1.insert(itr.key(),itr.value());
+        else if (type == multi_context_type)
+            multi1.insert(itr.key(),itr.value());
+        else
+            normal1.insert(itr.key(),itr.value());
     }
-    if (to_be_compared_multi1 != to_be_compared_multi2) {
-        LOG_TRACE(QString("Comparing dynamic properties on object %1 with object %2. Comparison found that multi context properties differ.").arg(obj1->objectName()).arg(obj2->objectName()));
-        is_equal = false;
+    for (QMap<QByteArray,QVariant>::const_iterator itr = properties2.constBegin(); itr != properties2.constEnd(); ++itr) {
+        const int type = itr.value().userType();
+        if (type == shared_type)
+            shared2.insert(itr.key(),itr.value());
+        else if (type == multi_context_type)
+            multi2.insert(itr.key(),itr.value());
+        else
+            normal2.insert(itr.key(),itr.value());
     }
 
-    if (!is_equal && property_diff_info) {
-        property_diff_info->clear();
-
-        // Get the differences in normal properties:
-        if (property_types & NonQtilitiesProperties) {
-            bool is_changed = true;
-            // Check for added properties:
-            for (int i = 0; i < to_be_compared_normal1.count(); ++i) {
-                QString name1 = to_be_compared_normal1.keys().at(i);
-
-                if (!to_be_compared_normal2.contains(name1)) {
-                    if (!QtilitiesProperty::isExportableVariant(to_be_compared_normal1[name1]))
-                        property_diff_info->d_added_properties[name1] = "Non-exportable variant";
-                    else
-                        property_diff_info->d_added_properties[name1] = to_be_compared_normal1[name1].toString();
-                    is_changed = false;
-                }
-            }
-            // Check for removed properties:
-            for (int i = 0; i < to_be_compared_normal2.count(); ++i) {
-                QString name2 = to_be_compared_normal2.keys().at(i);
-
-                if (!to_be_compared_normal1.contains(name2)) {
-                    if (!QtilitiesProperty::isExportableVariant(to_be_compared_normal2[name2]))
-                        property_diff_info->d_removed_properties[name2] = "Non-exportable variant";
-                    else
-                        property_diff_info->d_removed_properties[name2] = to_be_compared_normal2[name2].toString();
-                    is_changed = false;
-                }
-            }
-            // Check for changed properties:
-            if (is_changed) {
-                for (int i = 0; i < to_be_compared_normal1.count(); ++i) {
-                    QString name = to_be_compared_normal1.keys().at(i);
-                    if (to_be_compared_normal2.contains(name)) {
-                        QVariant value1 = to_be_compared_normal1[name];
-                        QVariant value2 = to_be_compared_normal2[name];
-
-                        QString value1_string;
-                        QString value2_string;
-
-                        if (!QtilitiesProperty::isExportableVariant(value1))
-                            value1_string = "Non-exportable variant";
-                        else
-                            value1_string = value1.toString();
-                        if (!QtilitiesProperty::isExportableVariant(value2))
-                            value2_string = "Non-exportable variant";
-                        else
-                            value2_string = value2.toString();
-
-                        if (value2_string != value1_string)
-                            property_diff_info->d_changed_properties[name] = value2_string + "," + value1_string;
-                    }
-                }
-            }
-        }
-
-        if (property_types & SharedProperties) {
-            bool is_changed = true;
-            // Check for added properties:
-            for (int i = 0; i < to_be_compared_shared1.count(); ++i) {
-                QString name1 = to_be_compared_shared1.keys().at(i);
-
-                if (!to_be_compared_shared2.contains(name1)) {
-                    if (!QtilitiesProperty::isExportableVariant(to_be_compared_shared1[name1].value()))
-                        property_diff_info->d_added_properties[name1] = "Non-exportable variant";
-                    else
-                        property_diff_info->d_added_properties[name1] = to_be_compared_shared1[name1].value().toString();
-                    is_changed = false;
-                }
-            }
-            // Check for removed properties:
-            for (int i = 0; i < to_be_compared_shared2.count(); ++i) {
-                QString name2 = to_be_compared_shared2.keys().at(i);
-
-                if (!to_be_compared_shared1.contains(name2)) {
-                    if (!QtilitiesProperty::isExportableVariant(to_be_compared_shared2[name2].value()))
-                        property_diff_info->d_removed_properties[name2] = "Non-exportable variant";
-                    else
-                        property_diff_info->d_removed_properties[name2] = to_be_compared_shared2[name2].value().toString();
-                    is_changed = false;
-                }
-            }
-            // Check for changed properties:
-            if (is_changed) {
-                for (int i = 0; i < to_be_compared_shared1.count(); ++i) {
-                    QString name = to_be_compared_shared1.keys().at(i);
-                    if (to_be_compared_shared2.contains(name)) {
-                        QVariant value1 = to_be_compared_shared1[name].value();
-                        QVariant value2 = to_be_compared_shared2[name].value();
-
-                        QString value1_string;
-                        QString value2_string;
-
-                        if (!QtilitiesProperty::isExportableVariant(value1))
-                            value1_string = "Non-exportable variant";
-                        else
-                            value1_string = value1.toString();
-                        if (!QtilitiesProperty::isExportableVariant(value2))
-                            value2_string = "Non-exportable variant";
-                        else
-                            value2_string = value2.toString();
-
-                        if (value2_string != value1_string)
-                            property_diff_info->d_changed_properties[name] = value2_string + "," + value1_string;
-                    }
-                }
-            }
-        }
-
-        if (property_types & MultiContextProperties) {
-            bool is_changed = true;
-            // Check for added properties:
-            QList<QString> to_be_compared_multi1_keys = to_be_compared_multi1.keys();
-            for (int i = 0; i < to_be_compared_multi1.count(); ++i) {
-                QString name1 = to_be_compared_multi1_keys.at(i);
+    appendDynamicPropertyDiffs(normal1,normal2,property_diff_info);
+    appendDynamicPropertyDiffs(shared1,shared2,property_diff_info);
+    appendDynamicPropertyDiffs(multi1,multi2,property_diff_info);
 
-                if (!to_be_compared_multi2.contains(name1)) {
-                    property_diff_info->d_added_properties[name1] = "(" + to_be_compared_multi1[name1].valueString() + ")";
-                    is_changed = false;
-                }
-            }
-            // Check for removed properties:
-            QList<QString> to_be_compared_multi2_keys = to_be_compared_multi2.keys();
-            for (int i = 0; i < to_be_compared_multi2.count(); ++i) {
-                QString name2 = to_be_compared_multi2_keys.at(i);
-
-                if (!to_be_compared_multi1.contains(name2)) {
-                    property_diff_info->d_removed_properties[name2] = "(" + to_be_compared_multi2[name2].valueString() + ")";
-                    is_changed = false;
-                }
-            }
-            // Check for changed properties:
-            if (is_changed) {
-                for (int i = 0; i < to_be_compared_multi1.count(); ++i) {
-                    QString name = to_be_compared_multi1_keys.at(i);
-                    if (to_be_compared_multi2.contains(name)) {
-                        QString value1_string = to_be_compared_multi1[name].valueString();
-                        QString value2_string = to_be_compared_multi2[name].valueString();
-
-                        if (value2_string != value1_string)
-                            property_diff_info->d_changed_properties[name] = "(" + value2_string + "),(" + value1_string + ")";
-                    }
-                }
-            }
-        }
-    }
-
-    return is_equal;
+    return false;
 }
 
 bool ObjectManager::constructDefaultPropertiesOnObject(QObject *obj, QString* errorMsg) {
@@ -1132,17 +1664,8 @@ bool ObjectManager::constructDefaultPropertiesOnObject(QObject *obj, QString* er
         return false;
     }
 
-    // Find all IAvailablePropertyProvider interfaces:
-    QList<IAvailablePropertyProvider*> property_providers;
-
-    // Get a list of all the property providers in the system:
-    QList<QObject*> propertyProviderObjects = OBJECT_MANAGER->registeredInterfaces("com.Qtilities.Core.IAvailablePropertyProvider/1.0");
-    // Check all items
-    for (int i = 0; i < propertyProviderObjects.count(); ++i) {
-        IAvailablePropertyProvider* provider = qobject_cast<IAvailablePropertyProvider*> (propertyProviderObjects.at(i));
-        if (provider)
-            property_providers << provider;
-    }
+    // Find all IAvailablePropertyProvider interfaces in the system:
+    QList<IAvailablePropertyProvider*> property_providers = OBJECT_MANAGER->registeredInterfaces<IAvailablePropertyProvider>();
 
     // Now find all available properties that must be added during construction:
     QList<PropertySpecification> all_properties;
@@ -174,9 +174,25 @@ namespace Qtilities {
             QStringList allFactoryNames() const;
             QStringList tagsForFactory(const QString& factory_name) const;
             QList<QObject*> registeredInterfaces(const QString& iface) const;
+            using IObjectManager::registeredInterfaces;
+            bool subscribeToInterface(const QString& iface, QObject* receiver, const char* added_method, const char* removed_method = 0, bool batched = true);
+            using IObjectManager::subscribeToInterface;
+            void unsubscribeFromInterface(const QString& iface, QObject* receiver);
+            void startNotificationBatch();
+            void endNotificationBatch();
             QList<QPointer<QObject> > metaTypeActiveObjects(const QString& meta_type) const;
             void setMetaTypeActiveObjects(QList<QObject*> objects, const QString& meta_type);
             void setMetaTypeActiveObjects(QList<QPointer<QObject> > objects, const QString& meta_type);
+            void setMetaTypeActiveObjects(const ObjectHandleList& objects, const QString& meta_type);
+            ObjectHandleList metaTypeActiveObjectHandles(const QString& meta_type) const;
+            bool subscribeToMetaTypeActiveObjects(const QString& meta_type, QObject* receiver, const char* method, int throttle_msecs = 0);
+            void unsubscribeFromMetaTypeActiveObjects(const QString& meta_type, QObject* receiver);
+            ObjectHandle objectHandle(QObject* obj);
+            QVector<ObjectHandle> objectHandles(const QList<QObject*>& objects);
+            ObjectHandle findObjectHandle(const QObject* obj) const;
+            QObject* handleObject(const ObjectHandle& handle) const;
+            QList<QObject*> handleObjects(const QVector<ObjectHandle>& handles) const;
+            MemoryUsageReport memoryUsage(bool recursive = true) const;
 
             // --------------------------------
             // Conversion Functions
@@ -274,6 +290,29 @@ if (ObjectManager::propertyExists(iface->objectBase(),qti_prop_CATEGORY_MAP)) {
               This function was added in %Qtilities v1.2.
               */
             static bool setSharedProperty(QObject* obj, PropertySpecification property_specification);
+            //! Returns the value of a SharedProperty, or the value of a MultiContextProperty in the given context, on the specified object.
+            /*!
+              The value is read directly from the property stored on the object, thus the property is not copied.
+
+              \returns The value of the property, or an invalid QVariant when the object does not have a SharedProperty or MultiContextProperty with the given name.
+
+              \sa setMultiContextPropertyValue()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static QVariant getMultiContextPropertyValue(const QObject* obj, const char* property_name, int context_id);
+            //! Sets the value of a SharedProperty, or the value of a MultiContextProperty in the given context, on the specified object.
+            /*!
+              The property stored on the object is changed and set again using QObject::setProperty(), thus a QDynamicPropertyChangeEvent
+              is delivered to the object. Unlike getting, changing and setting the property, the property is only copied once.
+
+              \returns False when the object does not have a SharedProperty or MultiContextProperty with the given name, true otherwise.
+
+              \sa getMultiContextPropertyValue()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static bool setMultiContextPropertyValue(QObject* obj, const char* property_name, const QVariant& new_value, int context_id);
             //! Convenience function to check if a dynamic property exists on a object.
             static bool propertyExists(const QObject* obj, const char* property_name);
             //! Convenience function to remove all properties that match the PropertyTypeFlags from an object.
@@ -281,6 +320,10 @@ if (ObjectManager::propertyExists(iface->objectBase(),qti_prop_CATEGORY_MAP)) {
             //! Convenience function to compare all properties that match the PropertyTypeFlags on two objects.
             /*!
               This function checks each property using the == overload of the QVariant property type and returns true if they match exactly, false otherwise.
+              Shared and multi context properties are compared using their own == overloads.
+
+              Since %Qtilities v1.5 the comparison stops at the first difference when \p property_diff_info is not given, and property values are only converted
+              to strings when the differences are reported.
 
               \param obj1 The first object to use in the comparison. The results will be relative to this object, for example if a property exists on \p obj1 and not on \p obj2, the diff result will show that the property was added. Also, when a property exists on both objects and the value changed, the old value will be the value on \p obj2 and the new value the value on \p obj1.
               \param obj2 The second object to use in the comparison.
@@ -333,7 +376,28 @@ if (ObjectManager::propertyExists(iface->objectBase(),qti_prop_CATEGORY_MAP)) {
             QObject* objectBase() { return this; }
             const QObject* objectBase() const { return this; }
 
+        protected:
+            //! Delivers throttled meta type active object changes.
+            void timerEvent(QTimerEvent* event);
+
+        private slots:
+            //! Notifies the subscribers of the interfaces implemented by \p obj that it was removed.
+            void handleObjectRemoved(QObject* obj);
+            //! Releases the object handle table slot of \p obj when it is destroyed.
+            void handleHandleObjectDestroyed(QObject* obj);
+
         private:
+            //! Notifies the subscribers of \p meta_type that its active objects changed.
+            void notifyMetaTypeSubscribers(const QString& meta_type);
+            //! Calls \p method on \p receiver with \p objects, as an ObjectHandleList when \p handles_type_name is not empty and as a QList<QPointer<QObject> > otherwise.
+            void deliverMetaTypeActiveObjects(QObject* receiver, const QByteArray& method, const QByteArray& handles_type_name, const ObjectHandleList& objects);
+            //! Notifies the subscribers of the interfaces implemented by \p obj that it was registered.
+            void notifyObjectAdded(QObject* obj);
+            //! Delivers the notifications which were batched.
+            void deliverBatchedNotifications();
+            //! Returns the handle of \p obj, registering it when needed. The object handle mutex must be locked.
+            ObjectHandle lockedObjectHandle(QObject* obj);
+
             ObjectManagerPrivateData* d;
         };
     }
@@ -20,14 +20,18 @@
 #include "IExportableFormatting.h"
 
 #include <Logger>
+#include <PerformanceCounters>
 
 #include <QMap>
+#include <QPair>
 #include <QVariant>
 #include <QMetaType>
 #include <QEvent>
 #include <QDynamicPropertyChangeEvent>
 #include <QCoreApplication>
 #include <QMutableListIterator>
+#include <QPointer>
+#include <QThread>
 #include <QDomElement>
 #include <QDomDocument>
 
@@ -35,6 +39,26 @@ using namespace Qtilities::Core::Constants;
 using namespace Qtilities::Core::Interfaces;
 using namespace Qtilities::Core::Properties;
 
+namespace {
+    //! The estimated size of a signal slot connection, which is referenced by both the sender and the receiver.
+    const int qti_private_CONNECTION_BYTES = 12 * sizeof(void*);
+
+    //! Moves \p obj to \p target_thread when it lives in the calling thread and has no parent, together with the subjects of observers, recursively.
+    void qti_private_moveSubjectTreeToThread(QObject* obj, QThread* target_thread) {
+        if (!obj || obj->thread() == target_thread || obj->thread() != QThread::currentThread() || obj->parent())
+            return;
+
+        // The subjects of an observer are not its children, thus they do not move with it:
+        Qtilities::Core::Observer* obs = qobject_cast<Qtilities::Core::Observer*> (obj);
+        obj->moveToThread(target_thread);
+        if (obs) {
+            QList<QObject*> subjects = obs->subjectReferences();
+            for (int i = 0; i < subjects.count(); ++i)
+                qti_private_moveSubjectTreeToThread(subjects.at(i),target_thread);
+        }
+    }
+}
+
 namespace Qtilities {
     namespace Core {
         FactoryItem<QObject, Observer> Observer::factory;
@@ -65,6 +89,7 @@ Qtilities::Core::Observer::Observer(const QString& observer_name, const QString&
 
 Qtilities::Core::Observer::Observer(const Observer &other) : QObject(other.parent()) {
     // Initialize observer data
+    other.observerData->completeDeferredImport();
     observerData = new ObserverData(*other.observerData);
     setObjectName(other.objectName());
 
@@ -92,13 +117,19 @@ Qtilities::Core::Observer::~Observer() {
         QVariant subject_ownership_variant;
         QVariant parent_observer_variant;
 
-        LOG_TRACE(QString("Starting destruction of observer \"%1\":").arg(objectName()));
-        LOG_TRACE("Deleting necessary children:");
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Starting destruction of observer \"%1\":").arg(objectName()));
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Deleting necessary children:");
 
-        QMutableListIterator<QObject*> i = observerData->subject_list.iterator();
+        // Deleting or detaching subjects removes them from the subject list, thus a guarded snapshot is iterated:
+        QList<QPointer<QObject> > subjects;
+        foreach (QObject* subject, observerData->subject_list.toQList())
+            subjects << subject;
+        QListIterator<QPointer<QObject> > i(subjects);
         while (i.hasNext()) {
-            QCoreApplication::processEvents();
+            IDLE_SCHEDULER->yieldToEventLoop();
             QObject* obj = i.next();
+            if (!obj)
+                continue;
             // If it is an observer we start a processing cycle on it:
             Observer* obs = qobject_cast<Observer*> (obj);
             if (obs)
@@ -108,7 +139,7 @@ Qtilities::Core::Observer::~Observer() {
             parent_observer_variant = getMultiContextPropertyValue(obj,qti_prop_PARENT_ID);
             if ((subject_ownership_variant.toInt() == SpecificObserverOwnership) && (observerData->observer_id == parent_observer_variant.toInt())) {
                 // Subjects with SpecificObserverOwnership must be deleted as soon as this observer is deleted if this observer is their parent.
-               LOG_TRACE(QString("Object \"%1\" (aliased as %2 in this context) is owned by this observer, it will be deleted.").arg(obj->objectName()).arg(subjectNameInContext(obj)));
+               LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Object \"%1\" (aliased as %2 in this context) is owned by this observer, it will be deleted.").arg(obj->objectName()).arg(subjectNameInContext(obj)));
                if (!i.hasNext()) {
                    deleteObject(obj);
                    //QCoreApplication::processEvents();
@@ -118,7 +149,7 @@ Qtilities::Core::Observer::~Observer() {
                    //QCoreApplication::processEvents();
                }
             } else if ((subject_ownership_variant.toInt() == ObserverScopeOwnership) && (parentCount(obj) == 1)) {
-                LOG_TRACE(QString("Object \"%1\" (aliased as %2 in this context) with ObserverScopeOwnership went out of scope, it will be deleted.").arg(obj->objectName()).arg(subjectNameInContext(obj)));
+                LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Object \"%1\" (aliased as %2 in this context) with ObserverScopeOwnership went out of scope, it will be deleted.").arg(obj->objectName()).arg(subjectNameInContext(obj)));
                 if (!i.hasNext()) {
                     deleteObject(obj);
                     //QCoreApplication::processEvents();
@@ -128,7 +159,7 @@ Qtilities::Core::Observer::~Observer() {
                     //QCoreApplication::processEvents();
                 }
            } else if ((subject_ownership_variant.toInt() == OwnedBySubjectOwnership) && (parentCount(obj) == 1)) {
-                LOG_TRACE(QString("Object \"%1\" (aliased as %2 in this context) with OwnedBySubjectOwnership went out of scope, it will be deleted.").arg(obj->objectName()).arg(subjectNameInContext(obj)));
+                LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Object \"%1\" (aliased as %2 in this context) with OwnedBySubjectOwnership went out of scope, it will be deleted.").arg(obj->objectName()).arg(subjectNameInContext(obj)));
                 if (!i.hasNext()) {
                     deleteObject(obj);
                     //QCoreApplication::processEvents();
@@ -144,15 +175,16 @@ Qtilities::Core::Observer::~Observer() {
     }
 
     // Delete subject filters
-    LOG_TRACE("Deleting subject filters.");
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Deleting subject filters.");
     int filter_count = observerData->subject_filters.count();
     for (int i = 0; i < filter_count; ++i)
         delete observerData->subject_filters.at(i);
 
     observerData->subject_filters.clear();
+    observerData->invalidatePropertyRoutes();
 
     if (objectName() != QLatin1String(qti_def_GLOBAL_OBJECT_POOL)) {
-        LOG_TRACE("Removing any trace of this observer from remaining children.");
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Removing any trace of this observer from remaining children.");
         int count = observerData->subject_list.count();
         for (int i = 0; i < count; ++i) {
             // In this case we need to remove any trace of this observer from the obj
@@ -164,7 +196,7 @@ Qtilities::Core::Observer::~Observer() {
     if (observerData->display_hints)
         delete observerData->display_hints;
     delete observerData;
-    LOG_TRACE(QString("Done with destruction of observer \"%1\".").arg(objectName()));
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Done with destruction of observer \"%1\".").arg(objectName()));
 }
 
 QStringList Qtilities::Core::Observer::monitoredProperties() const {
@@ -181,6 +213,7 @@ QStringList Qtilities::Core::Observer::monitoredProperties() const {
     properties.append(QString(qti_prop_SIZE_HINT));
     properties.append(QString(qti_prop_STATUSTIP));
     properties.append(QString(qti_prop_WHATS_THIS));
+    properties.append(QString(qti_prop_STYLE));
 
     for (int i = 0; i < observerData->subject_filters.count(); ++i) {
         properties << observerData->subject_filters.at(i)->monitoredProperties();
@@ -223,6 +256,16 @@ bool Qtilities::Core::Observer::broadcastModificationStateChangesEnabled() const
     return observerData->broadcast_modification_state_changes;
 }
 
+void Qtilities::Core::Observer::toggleViewRefreshCoalescing(bool toggle) {
+    observerData->coalesce_view_refreshes = toggle;
+    if (!toggle && !observerData->process_cycle_active)
+        deliverViewRefreshes();
+}
+
+bool Qtilities::Core::Observer::viewRefreshCoalescingEnabled() const {
+    return observerData->coalesce_view_refreshes;
+}
+
 Qtilities::Core::InstanceFactoryInfo Qtilities::Core::Observer::instanceFactoryInfo() const {
     InstanceFactoryInfo factory_data = observerData->factory_data;
     factory_data.d_instance_name = observerName();
@@ -233,6 +276,7 @@ Qtilities::Core::Interfaces::IExportable::ExportModeFlags Qtilities::Core::Obser
     IExportable::ExportModeFlags flags = 0;
     flags |= IExportable::Binary;
     flags |= IExportable::XML;
+    flags |= IExportable::Cbor;
     return flags;
 }
 
@@ -280,6 +324,34 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     return observerData->exportXmlExt(doc,object_node,export_flags);
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::exportXmlStream(QXmlStreamWriter* writer) const {
+    return observerData->exportXmlStream(writer);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    return observerData->importXmlStream(reader,import_list);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::exportXmlStreamExt(QXmlStreamWriter* writer, ObserverData::ExportItemFlags export_flags, const QDomElement* leading_elements) const {
+    return observerData->exportXmlStreamExt(writer,export_flags,leading_elements);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::importXmlStreamExt(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list, QDomElement* other_elements) {
+    return observerData->importXmlStreamExt(reader,import_list,other_elements);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::exportCbor(CborStreamWriter* writer) const {
+    return observerData->exportCbor(writer);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    return observerData->importCbor(reader,import_list);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Observer::exportCborExt(CborStreamWriter* writer, ObserverData::ExportItemFlags export_flags) const {
+    return observerData->exportCborExt(writer,export_flags);
+}
+
 bool Observer::setMonitorSubjectModificationState(QObject *obj, bool monitor) {
     if (!contains(obj))
         return false;
@@ -289,10 +361,14 @@ bool Observer::setMonitorSubjectModificationState(QObject *obj, bool monitor) {
     if (!mod_iface)
         return false;
 
-    if (monitor)
-        connect(obj,SIGNAL(modificationStateChanged(bool)),this,SLOT(setModificationState(bool)),Qt::UniqueConnection);
-    else
-        disconnect(obj,SIGNAL(modificationStateChanged(bool)),this,SLOT(setModificationState(bool)));
+    if (monitor) {
+        connect(obj,SIGNAL(modificationStateChanged(bool)),this,SLOT(handleSubjectModificationStateChanged(bool)),Qt::UniqueConnection);
+        if (mod_iface->isModified())
+            observerData->modified_subjects.insert(obj);
+    } else {
+        disconnect(obj,SIGNAL(modificationStateChanged(bool)),this,SLOT(handleSubjectModificationStateChanged(bool)));
+        observerData->modified_subjects.remove(obj);
+    }
 
     MultiContextProperty ignore_modification_state_prop = ObjectManager::getMultiContextProperty(obj,qti_prop_SUBJECT_IGNORE_MODIFICATION_STATE);
     if (ignore_modification_state_prop.isValid()) {
@@ -332,24 +408,10 @@ bool Qtilities::Core::Observer::isModified() const {
     if (observerData->is_modified)
         return true;
 
-    // Check if any subjects are modified.
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (observerData->subject_list.at(i));
-        if (mod_iface) {
-            // Check if this subject must be monitored:
-            MultiContextProperty ignore_modification_state_prop = ObjectManager::getMultiContextProperty(observerData->subject_list.at(i),qti_prop_SUBJECT_IGNORE_MODIFICATION_STATE);
-            if (ignore_modification_state_prop.isValid()) {
-                if (ignore_modification_state_prop.hasContext(observerID())) {
-                    if (ignore_modification_state_prop.value(observerID()).toBool())
-                        continue;
-                }
-            }
-
-            if (mod_iface->isModified())
-                return true;
-        }
-    }
+    // Check if any monitored subjects are modified. Their states are tracked in handleSubjectModificationStateChanged(),
+    // thus subjects don't have to be asked one by one:
+    if (!observerData->modified_subjects.isEmpty())
+        return true;
 
     // Check if any subject filters were modified.
     for (int i = 0; i < observerData->subject_filters.count(); ++i) {
@@ -394,31 +456,172 @@ void Qtilities::Core::Observer::setModificationState(bool new_state, IModificati
         if (observerData->display_hints) {
             observerData->display_hints->setModificationState(new_state,notification_targets);
         }
+
+        // Subjects which don't broadcast their changes are not tracked yet, thus sync the tracked states:
+        observerData->modified_subjects.clear();
+        if (new_state) {
+            for (int i = 0; i < count; ++i) {
+                QObject* obj = observerData->subject_list.at(i);
+                IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (obj);
+                if (mod_iface && mod_iface->isModified() && monitorSubjectModificationState(obj))
+                    observerData->modified_subjects.insert(obj);
+            }
+        }
     }
 
-    // For observers we only notify targets if the actual state changed:
-    if (observerData->is_modified != new_state || force_notifications) {
-        observerData->is_modified = new_state;
-        if (!observerData->process_cycle_active) {
-            if (notification_targets & IModificationNotifier::NotifyListeners)
-                emit modificationStateChanged(new_state);
+    // For observers we only notify targets if the combined state changed:
+    bool state_changed = (observerData->is_modified != new_state);
+    observerData->is_modified = new_state;
+    if (observerData->process_cycle_active)
+        return;
 
-            if (observerData->display_hints) {
-                if (observerData->display_hints->modificationStateDisplayHint() != ObserverHints::NoModificationStateDisplayHint)
-                    refreshViewsData(); // Processing cycle checked inside refreshViewsData():
-            }
+    bool is_modified = isModified();
+    bool notify = (is_modified != observerData->notified_modification_state || force_notifications);
+    if (notify && (notification_targets & IModificationNotifier::NotifyListeners)) {
+        observerData->notified_modification_state = is_modified;
+        emit modificationStateChanged(is_modified);
+    }
+
+    if (state_changed || notify) {
+        if (observerData->display_hints) {
+            if (observerData->display_hints->modificationStateDisplayHint() != ObserverHints::NoModificationStateDisplayHint)
+                refreshViewsData(); // Processing cycle checked inside refreshViewsData():
         }
     }
 }
 
+void Qtilities::Core::Observer::handleSubjectModificationStateChanged(bool is_modified) {
+    QObject* obj = sender();
+    if (!obj || !observerData->containsSubject(obj))
+        return;
+
+    if (is_modified)
+        observerData->modified_subjects.insert(obj);
+    else
+        observerData->modified_subjects.remove(obj);
+
+    // Changes during processing cycles are reported in endProcessingCycle():
+    if (!observerData->broadcast_modification_state_changes || observerData->process_cycle_active)
+        return;
+
+    bool observer_modified = isModified();
+    if (observer_modified == observerData->notified_modification_state)
+        return;
+
+    observerData->notified_modification_state = observer_modified;
+    emit modificationStateChanged(observer_modified);
+    if (observerData->display_hints) {
+        if (observerData->display_hints->modificationStateDisplayHint() != ObserverHints::NoModificationStateDisplayHint)
+            refreshViewsData();
+    }
+}
+
 void Qtilities::Core::Observer::refreshViewsLayout(QList<QPointer<QObject> > new_selection, bool force) {
-    if (!observerData->process_cycle_active || force)
-        emit layoutChanged(new_selection);
+    if (observerData->process_cycle_active && !force)
+        return;
+
+    observerData->pending_refresh_layout = true;
+    if (observerData->pending_refresh_selection.isEmpty()) {
+        observerData->pending_refresh_selection = new_selection;
+    } else {
+        for (int i = 0; i < new_selection.count(); ++i) {
+            if (new_selection.at(i) && !observerData->pending_refresh_selection.contains(new_selection.at(i)))
+                observerData->pending_refresh_selection << new_selection.at(i);
+        }
+    }
+
+    if (observerData->coalesce_view_refreshes && !force)
+        queueViewRefreshes();
+    else
+        deliverViewRefreshes();
 }
 
 void Qtilities::Core::Observer::refreshViewsData(bool force) {
+    if (observerData->process_cycle_active && !force)
+        return;
+
+    observerData->pending_refresh_data = true;
+    if (observerData->coalesce_view_refreshes && !force)
+        queueViewRefreshes();
+    else
+        deliverViewRefreshes();
+}
+
+void Qtilities::Core::Observer::refreshViewsSubjectData(QObject* subject, bool force) {
+    if (!subject)
+        return;
+
     if (!observerData->process_cycle_active || force)
+        emit subjectDataChanged(this,subject);
+    else
+        observerData->recordSubjectDataChange(subject);
+}
+
+void Qtilities::Core::Observer::broadcastSubjectChanges() {
+    // Take the pending changes before emitting anything, slots might change this observer again:
+    const bool subjects_reset = observerData->pending_subjects_reset;
+    const QList<ObserverData::SubjectChangeRange> subject_changes = observerData->pending_subject_changes;
+    const bool data_changed_all = observerData->pending_data_changed_all;
+    const QList<QPointer<QObject> > data_changed_subjects = observerData->pending_data_changed_subjects;
+    observerData->clearSubjectChanges();
+
+    if (subjects_reset) {
+        emit subjectsReset();
+    } else {
+        for (int i = 0; i < subject_changes.count(); ++i) {
+            const ObserverData::SubjectChangeRange& range = subject_changes.at(i);
+            if (range.change == ObserverData::SubjectsInserted)
+                emit subjectsInserted(range.first,range.last);
+            else
+                emit subjectsRemoved(range.first,range.last);
+        }
+    }
+
+    if (data_changed_all) {
         emit dataChanged(this);
+    } else {
+        for (int i = 0; i < data_changed_subjects.count(); ++i) {
+            if (data_changed_subjects.at(i))
+                emit subjectDataChanged(this,data_changed_subjects.at(i));
+        }
+    }
+}
+
+void Qtilities::Core::Observer::queueViewRefreshes() {
+    // All refreshes requested before the next event loop iteration are delivered together:
+    if (observerData->refresh_delivery_queued)
+        return;
+
+    observerData->refresh_delivery_queued = true;
+    QMetaObject::invokeMethod(this,"handleQueuedViewRefreshes",Qt::QueuedConnection);
+}
+
+void Qtilities::Core::Observer::deliverViewRefreshes() {
+    // Take the pending refreshes before emitting anything, slots might refresh this observer again:
+    const bool refresh_layout = observerData->pending_refresh_layout;
+    const bool refresh_data = observerData->pending_refresh_data;
+    const QList<QPointer<QObject> > selection = observerData->pending_refresh_selection;
+    observerData->pending_refresh_layout = false;
+    observerData->pending_refresh_data = false;
+    observerData->pending_refresh_selection.clear();
+
+    if (refresh_layout) {
+        QList<QPointer<QObject> > new_selection;
+        for (int i = 0; i < selection.count(); ++i) {
+            if (selection.at(i))
+                new_selection << selection.at(i);
+        }
+        emit layoutChanged(new_selection);
+    }
+    if (refresh_data)
+        emit dataChanged(this);
+}
+
+void Qtilities::Core::Observer::handleQueuedViewRefreshes() {
+    observerData->refresh_delivery_queued = false;
+    // When a processing cycle was started in the meantime, the refreshes are delivered when it ends:
+    if (!observerData->process_cycle_active)
+        deliverViewRefreshes();
 }
 
 void Qtilities::Core::Observer::startProcessingCycle() {
@@ -431,6 +634,7 @@ void Qtilities::Core::Observer::startProcessingCycle() {
 
     if (previous_start_processing_cycle_count == 0 && observerData->start_processing_cycle_count == 1) {
         observerData->number_of_subjects_start_of_proc_cycle = observerData->subject_list.count();
+        observerData->freezeSubjectSnapshot();
         observerData->process_cycle_active = true;
         observerData->modification_state_start_of_proc_cycle = isModified();
         emit processingCycleStarted();
@@ -452,8 +656,10 @@ void Qtilities::Core::Observer::endProcessingCycle(bool broadcast) {
         // observerData->number_of_subjects_start_of_proc_cycle set to -1 in destructor.
         if (broadcast && (observerData->number_of_subjects_start_of_proc_cycle != -1)) {
             bool is_modified = isModified();
-            if (is_modified != observerData->modification_state_start_of_proc_cycle)
+            if (is_modified != observerData->modification_state_start_of_proc_cycle || is_modified != observerData->notified_modification_state) {
+                observerData->notified_modification_state = is_modified;
                 emit modificationStateChanged(is_modified);
+            }
 
             // Note that it is possible to get in here without the number of subjects changing under this observer when
             // a processing cycle is ended on a tree and this observer is not the top level observer.
@@ -461,15 +667,65 @@ void Qtilities::Core::Observer::endProcessingCycle(bool broadcast) {
             // observer will still be the same. However we must still emit the layoutChanged() signal
             // since ObserverWidget in TreeView mode only listens to the layoutChanged() signal on the
             // top level observer.
-            if (observerData->number_of_subjects_start_of_proc_cycle > observerData->subject_list.count())
+            // Report the changes to subjects which happened during the processing cycle to models:
+            broadcastSubjectChanges();
+
+            // When subjects were attached or detached using attachSubjects() or detachSubjects(), the change set is reported
+            // with the signals. Otherwise only the change in the number of subjects is known:
+            QList<QPointer<QObject> > attached_subjects;
+            QList<QPointer<QObject> > detached_subjects;
+            for (int i = 0; i < observerData->proc_cycle_attached_subjects.count(); ++i) {
+                if (observerData->proc_cycle_attached_subjects.at(i))
+                    attached_subjects << observerData->proc_cycle_attached_subjects.at(i);
+            }
+            for (int i = 0; i < observerData->proc_cycle_detached_subjects.count(); ++i) {
+                if (observerData->proc_cycle_detached_subjects.at(i))
+                    detached_subjects << observerData->proc_cycle_detached_subjects.at(i);
+            }
+            observerData->proc_cycle_attached_subjects.clear();
+            observerData->proc_cycle_detached_subjects.clear();
+
+            if (!attached_subjects.isEmpty() || !detached_subjects.isEmpty()) {
+                if (!detached_subjects.isEmpty())
+                    emit numberOfSubjectsChanged(Observer::SubjectRemoved,detached_subjects);
+                if (!attached_subjects.isEmpty())
+                    emit numberOfSubjectsChanged(Observer::SubjectAdded,attached_subjects);
+            } else if (observerData->number_of_subjects_start_of_proc_cycle > observerData->subject_list.count())
                 emit numberOfSubjectsChanged(Observer::SubjectRemoved);
             else if (observerData->number_of_subjects_start_of_proc_cycle < observerData->subject_list.count())
                 emit numberOfSubjectsChanged(Observer::SubjectAdded);
-            emit layoutChanged();
+
+            // Refreshes which were requested before the processing cycle started are delivered with the layout change of the cycle:
+            observerData->pending_refresh_layout = true;
+            deliverViewRefreshes();
+        } else {
+            observerData->proc_cycle_attached_subjects.clear();
+            observerData->proc_cycle_detached_subjects.clear();
+            if (observerData->pending_refresh_layout || observerData->pending_refresh_data)
+                queueViewRefreshes();
+            // Models can't apply the changes later on, thus they must reset when the number of subjects changed:
+            const bool subjects_changed = observerData->pending_subjects_reset || !observerData->pending_subject_changes.isEmpty();
+            observerData->clearSubjectChanges();
+            if (subjects_changed && observerData->number_of_subjects_start_of_proc_cycle != -1)
+                emit subjectsReset();
         }
 
         // TODO: Send processing cycle end to subject filters in order for activity filter to emit the active subjects after the processing cycle if they changed. Note that TreeNode does this already.
         observerData->process_cycle_active = false;
+        // Readers on other threads see the changes made during the cycle from now on:
+        observerData->invalidateSubjectSnapshot();
+
+        // Post the QtilitiesPropertyChangeEvent events of the cycle, once per subject and property:
+        if (!observerData->queued_property_change_events.isEmpty()) {
+            QList<QPair<QPointer<QObject>,QByteArray> > queued_events = observerData->queued_property_change_events;
+            observerData->queued_property_change_events.clear();
+            observerData->queued_property_change_event_keys.clear();
+            for (int i = 0; i < queued_events.count(); ++i) {
+                QObject* obj = queued_events.at(i).first;
+                if (obj && obj->thread() == thread())
+                    QCoreApplication::postEvent(obj,new QtilitiesPropertyChangeEvent(queued_events.at(i).second,observerID()));
+            }
+        }
         emit processingCycleEnded();
     }
 }
@@ -488,9 +744,9 @@ bool Qtilities::Core::Observer::isProcessingCycleActive() const {
 }
 
 void Qtilities::Core::Observer::startTreeProcessingCycle() {
-    QList<QObject*> obj_list = treeChildren();
-    for (int i = 0; i < obj_list.count(); ++i) {
-        Observer* obs = qobject_cast<Observer*> (obj_list.at(i));
+    TreeIterator itr(this,TreeIterator::StackIteration);
+    while (QObject* obj = itr.next()) {
+        Observer* obs = qobject_cast<Observer*> (obj);
         if (obs)
             obs->startProcessingCycle();
     }
@@ -499,9 +755,9 @@ void Qtilities::Core::Observer::startTreeProcessingCycle() {
 }
 
 void Qtilities::Core::Observer::endTreeProcessingCycle(bool broadcast) {
-    QList<QObject*> obj_list = treeChildren();
-    for (int i = 0; i < obj_list.count(); ++i) {
-        Observer* obs = qobject_cast<Observer*> (obj_list.at(i));
+    TreeIterator itr(this,TreeIterator::StackIteration);
+    while (QObject* obj = itr.next()) {
+        Observer* obs = qobject_cast<Observer*> (obj);
         if (obs)
             obs->endProcessingCycle(false);
     }
@@ -514,7 +770,12 @@ void Qtilities::Core::Observer::setFactoryData(Qtilities::Core::InstanceFactoryI
         observerData->factory_data = factory_data;
 }
 
+void Qtilities::Core::Observer::initializeClone(const Observer* source) {
+    Q_UNUSED(source)
+}
+
 bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwnership object_ownership, QString* rejectMsg, bool import_cycle) {
+    observerData->completeDeferredImport();
     #ifndef QT_NO_DEBUG
     Q_ASSERT(obj != 0);
     #endif
@@ -549,7 +810,7 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
             return false;
 
         // Don't set change rejectMsg here, it will be set in initializeAttachment() above:
-        LOG_DEBUG(QString("Observer (%1): Object (%2) attachment failed, attachment was rejected by one or more subject filter.").arg(objectName()).arg(obj->objectName()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1): Object (%2) attachment failed, attachment was rejected by one or more subject filter.").arg(objectName()).arg(obj->objectName()));
         for (int i = 0; i < observerData->subject_filters.count(); ++i) {
             observerData->subject_filters.at(i)->finalizeAttachment(obj,false,import_cycle);
         }
@@ -576,10 +837,12 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
             new_subject_id_property.addContext(QVariant(observerData->subject_id_counter),observerData->observer_id);
             ObjectManager::setMultiContextProperty(obj,new_subject_id_property);
         }
+        const int subject_id = observerData->subject_id_counter;
         observerData->subject_id_counter += 1;
 
         // Now that the object has the properties needed, we add it:
-        observerData->subject_list.append(obj);
+        observerData->appendSubject(obj,subject_id);
+        observerData->updateSubjectMetadata(obj);
 
         // Handle object ownership
         #ifndef QT_NO_DEBUG
@@ -727,8 +990,11 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
         Observer* obs = qobject_cast<Observer*> (obj);
         if (obs) {
             has_mod_iface = true;
-            connect(obs,SIGNAL(modificationStateChanged(bool)),SLOT(setModificationState(bool)));
+            connect(obs,SIGNAL(modificationStateChanged(bool)),SLOT(handleSubjectModificationStateChanged(bool)));
+            if (obs->isModified())
+                observerData->modified_subjects.insert(obj);
             connect(obs,SIGNAL(dataChanged(Observer*)),SIGNAL(dataChanged(Observer*)));
+            connect(obs,SIGNAL(subjectDataChanged(Observer*,QObject*)),SIGNAL(subjectDataChanged(Observer*,QObject*)));
             connect(obs,SIGNAL(layoutChanged(QList<QPointer<QObject> >)),SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
 
             observerData->subject_observer_list.append(obj);
@@ -738,7 +1004,9 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
             IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (obj);
             if (mod_iface) {
                 if (mod_iface->objectBase()) {
-                    connect(mod_iface->objectBase(),SIGNAL(modificationStateChanged(bool)),SLOT(setModificationState(bool)));
+                    connect(mod_iface->objectBase(),SIGNAL(modificationStateChanged(bool)),SLOT(handleSubjectModificationStateChanged(bool)));
+                    if (mod_iface->isModified())
+                        observerData->modified_subjects.insert(obj);
                     has_mod_iface = true;
                 }
             }
@@ -750,14 +1018,16 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
         #ifndef QT_NO_DEBUG
         if (!observerData->process_cycle_active) {
             if (has_mod_iface)
-                LOG_TRACE(QString("Observer (%1): Now observing object \"%2\" with management policy: %3. This object's modification state is now monitored by this observer.").arg(objectName()).arg(obj->objectName()).arg(management_policy_string));
+                LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1): Now observing object \"%2\" with management policy: %3. This object's modification state is now monitored by this observer.").arg(objectName()).arg(obj->objectName()).arg(management_policy_string));
             else
-                LOG_TRACE(QString("Observer (%1): Now observing object \"%2\" with management policy: %3.").arg(objectName()).arg(obj->objectName()).arg(management_policy_string));
+                LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1): Now observing object \"%2\" with management policy: %3.").arg(objectName()).arg(obj->objectName()).arg(management_policy_string));
         }
         #endif
     } else {
         // If it is the global object manager it will get here.
-        observerData->subject_list.append(obj);
+        observerData->appendSubject(obj);
+        if (!observerData->process_cycle_active)
+            broadcastSubjectChanges();
 
         Observer* obs = qobject_cast<Observer*> (obj);
         if (obs)
@@ -776,7 +1046,7 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
 //            emit layoutChanged(objects);
 //        }
 
-        LOG_TRACE(QString("Object \"%1\" is now visible in the global object pool.").arg(obj->objectName()));
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Object \"%1\" is now visible in the global object pool.").arg(obj->objectName()));
     }
 
     observerData->observer_mutex.tryLock();
@@ -786,6 +1056,10 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
     }
     observerData->observer_mutex.unlock();
 
+    // Subject filters might have changed properties directly on the object, for example the NamingPolicyFilter's alias:
+    if (safe_obj && objectName() != QString(qti_def_GLOBAL_OBJECT_POOL))
+        observerData->updateSubjectMetadata(obj);
+
     if (objectName() != QString(qti_def_GLOBAL_OBJECT_POOL)) {
         QList<QPointer<QObject> > objects;
         objects << safe_obj;
@@ -793,6 +1067,7 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
         // Change layout only after finalzeAttachment() in all filters since they might add properties
         // used by views (activity policy filter for example)
         if (!observerData->process_cycle_active) {
+            broadcastSubjectChanges();
             emit numberOfSubjectsChanged(Observer::SubjectAdded, objects);
             emit layoutChanged(objects);
         }
@@ -802,29 +1077,36 @@ bool Qtilities::Core::Observer::attachSubject(QObject* obj, Observer::ObjectOwne
 }
 
 QList<QPointer<QObject> > Qtilities::Core::Observer::attachSubjects(QList<QObject*> objects, Observer::ObjectOwnership ownership, QString* rejectMsg, bool import_cycle) {
+    observerData->completeDeferredImport();
     QList<QPointer<QObject> > success_list;
+    if (objects.isEmpty())
+        return success_list;
+
     startProcessingCycle();
+    observerData->reserveSubjects(observerData->subject_list.count() + objects.count());
+    for (int i = 0; i < observerData->subject_filters.count(); ++i)
+        observerData->subject_filters.at(i)->initializeBulkAttachment(objects);
+
     for (int i = 0; i < objects.count(); ++i) {
         if (attachSubject(objects.at(i), ownership, rejectMsg, import_cycle))
             success_list << objects.at(i);
     }
+
+    for (int i = 0; i < observerData->subject_filters.count(); ++i)
+        observerData->subject_filters.at(i)->finalizeBulkAttachment(success_list,import_cycle);
+
+    // The attached subjects are reported in a single numberOfSubjectsChanged() signal when the processing cycle ends:
+    observerData->proc_cycle_attached_subjects << success_list;
     endProcessingCycle(true);
     return success_list;
 }
 
 QList<QPointer<QObject> > Qtilities::Core::Observer::attachSubjects(ObserverMimeData* mime_data_object, Observer::ObjectOwnership ownership, QString* rejectMsg, bool import_cycle) {
-    QList<QPointer<QObject> > success_list;
-    startProcessingCycle();
-    for (int i = 0; i < mime_data_object->subjectList().count(); ++i) {
-        if (attachSubject(mime_data_object->subjectList().at(i), ownership, rejectMsg, import_cycle)) {
-            success_list << mime_data_object->subjectList().at(i);
-        }
-    }
-    endProcessingCycle(true);
-    return success_list;
+    return attachSubjects(ObjectManager::convSafeObjectsToNormal(mime_data_object->subjectList()),ownership,rejectMsg,import_cycle);
 }
 
 Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach(QObject* obj, Observer::ObjectOwnership, QString* rejectMsg, bool silent) const {
+    observerData->completeDeferredImport();
     if (!obj) {
         if (rejectMsg)
             *rejectMsg = "Invalid object reference received. Attachment cannot be done.";
@@ -835,7 +1117,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
     QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
     if (isConst(category)) {
         QString reject_string = QString("Attaching object \"%1\" to observer \"%2\" is not allowed. This observer is const for the recieved object.").arg(obj->objectName()).arg(objectName());
-        LOG_DEBUG(reject_string);
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
         if (rejectMsg)
             *rejectMsg = reject_string;
         return Observer::Rejected;
@@ -846,7 +1128,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
     if (observer_cast) {
         if (isParentInHierarchy(observer_cast,this)) {
             QString reject_string = QString("Attaching observer \"%1\" to observer \"%2\" will result in a circular dependancy.").arg(obj->objectName()).arg(objectName());
-            LOG_DEBUG(reject_string);
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
             if (rejectMsg)
                 *rejectMsg = reject_string;
             return Observer::Rejected;
@@ -856,7 +1138,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
     // First evaluate new subject from Observer side:
     if (observerData->subject_limit == observerData->subject_list.count()) {
         QString reject_string = QString("Observer (%1): Object (%2) attachment failed, subject limit reached.").arg(objectName()).arg(obj->objectName());
-        LOG_DEBUG(reject_string);
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
         if (rejectMsg)
             *rejectMsg = reject_string;
         return Observer::Rejected;
@@ -865,15 +1147,12 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
     if (objectName() != QString(qti_def_GLOBAL_OBJECT_POOL)) {
         // Check if this subject is already monitored by this observer, if so abort.
         // This will ensure that no subject filters need to check for this, thus subject filters can assume that new attachments are actually new.
-        MultiContextProperty observer_list = ObjectManager::getMultiContextProperty(obj,qti_prop_OBSERVER_MAP);
-        if (observer_list.isValid()) {
-            if (observer_list.hasContext(observerData->observer_id)) {
-                QString reject_string = QString("Observer (%1): Object (%2) attachment failed, object is already observed by this observer.").arg(objectName()).arg(obj->objectName());
-                LOG_DEBUG(reject_string);
-                if (rejectMsg)
-                    *rejectMsg = reject_string;
-                return Observer::Rejected;
-            }
+        if (observerData->containsSubject(obj)) {
+            QString reject_string = QString("Observer (%1): Object (%2) attachment failed, object is already observed by this observer.").arg(objectName()).arg(obj->objectName());
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
+            if (rejectMsg)
+                *rejectMsg = reject_string;
+            return Observer::Rejected;
         }
 
         // Evaluate dynamic properties on the object:
@@ -892,7 +1171,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
                 // No count yet, check if the limit is > 0
                 if ((observer_limit < 1) && (observer_limit != -1)){
                     QString reject_string = QString("Observer (%1): Object (%2) attachment failed, observer limit (%3) reached.").arg(objectName()).arg(obj->objectName()).arg(observer_limit);
-                    LOG_DEBUG(reject_string);
+                    LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
                     if (rejectMsg)
                         *rejectMsg = reject_string;
                     return Observer::Rejected;
@@ -900,7 +1179,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
             } else {
                 if (observer_count >= observer_limit) {
                     QString reject_string = QString("Observer (%1): Object (%2) attachment failed, observer limit (%3) reached.").arg(objectName()).arg(obj->objectName()).arg(observer_limit);
-                    LOG_DEBUG(reject_string);
+                    LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
                     if (rejectMsg)
                         *rejectMsg = reject_string;
                     return Observer::Rejected;
@@ -940,8 +1219,9 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
 
     bool success = true;
     int not_allowed_count = 0;
-    for (int i = 0; i < mime_data_object->subjectList().count(); ++i) {
-        if (canAttach(mime_data_object->subjectList().at(i),Observer::ManualOwnership,rejectMsg,silent) == Observer::Rejected) {
+    const QList<QPointer<QObject> > subject_list = mime_data_object->subjectList();
+    for (int i = 0; i < subject_list.count(); ++i) {
+        if (canAttach(subject_list.at(i),Observer::ManualOwnership,rejectMsg,silent) == Observer::Rejected) {
             success = false;
             ++not_allowed_count;
         }
@@ -950,7 +1230,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canAttach
     if (success)
         return Observer::Allowed;
     else {
-        if (not_allowed_count != mime_data_object->subjectList().count())
+        if (not_allowed_count != subject_list.count())
             return Observer::Conditional;
         else
             return Observer::Rejected;
@@ -966,6 +1246,9 @@ void Qtilities::Core::Observer::handle_deletedSubject(QObject* obj) {
             return;
     #endif
 
+    // The subject was already removed from subject_list, we only need to update the subject index:
+    observerData->removeSubjectFromIndex(obj);
+
     if (!observerData->observer_mutex.tryLock())
         return;
 
@@ -976,20 +1259,21 @@ void Qtilities::Core::Observer::handle_deletedSubject(QObject* obj) {
     }
 
     if (!passed_filters) {
-        LOG_DEBUG(QString("Observer (%1): Error: Subject filter rejected detachment of deleted object (%2).").arg(objectName()).arg(obj->objectName()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1): Error: Subject filter rejected detachment of deleted object (%2).").arg(objectName()).arg(obj->objectName()));
     }
 
     for (int i = 0; i < observerData->subject_filters.count(); ++i) {
         observerData->subject_filters.at(i)->finalizeDetachment(obj,passed_filters,true);
     }
 
-    LOG_TRACE(QString("Observer (%1) detected deletion of object (%2), updated observer context accordingly.").arg(objectName()).arg(obj->objectName()));
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1) detected deletion of object (%2), updated observer context accordingly.").arg(objectName()).arg(obj->objectName()));
 
     emit subjectDeleted(obj);
 
     // Emit neccesarry signals
     setModificationState(true);
     if (!observerData->process_cycle_active) {
+        broadcastSubjectChanges();
         emit numberOfSubjectsChanged(SubjectRemoved, QList<QPointer<QObject> >());
         emit layoutChanged(QList<QPointer<QObject> >());
     }
@@ -998,13 +1282,14 @@ void Qtilities::Core::Observer::handle_deletedSubject(QObject* obj) {
 }
 
 bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg) {
+    observerData->completeDeferredImport();
     #ifndef QT_NO_DEBUG
         Q_ASSERT(obj != 0);
     #endif
     #ifdef QT_NO_DEBUG
         if (!obj) {
             QString reject_string = QString("Observer (%1): Object detachment failed, invalid object reference received.").arg(objectName());
-            LOG_TRACE(reject_string);
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
             if (rejectMsg)
                 *rejectMsg = reject_string;
             return false;
@@ -1027,7 +1312,7 @@ bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg)
 
     if (!passed_filters) {
         QString reject_string = QString("Observer (%1): Object (%2) detachment failed, detachment was rejected by one or more subject filters.").arg(objectName()).arg(obj->objectName());
-        LOG_DEBUG(reject_string);
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
         if (rejectMsg)
             *rejectMsg = reject_string;
         for (int i = 0; i < observerData->subject_filters.count(); ++i)
@@ -1052,14 +1337,14 @@ bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg)
         QVariant ownership_variant = getMultiContextPropertyValue(obj,qti_prop_OWNERSHIP);
         if (ownership_variant.isValid() && ((ObjectOwnership) ownership_variant.toInt() == ObserverScopeOwnership)) {
             if ((parentCount(obj) == 1) && obj) {
-                LOG_DEBUG(QString("Object (%1) went out of scope, it will be deleted.").arg(obj->objectName()));
+                LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Object (%1) went out of scope, it will be deleted.").arg(obj->objectName()));
                 deleteObject(obj);
                 obj = 0;
-                QCoreApplication::processEvents();
+                IDLE_SCHEDULER->yieldToEventLoop();
                 lost_scope = true;
             } else {
                 removeQtilitiesProperties(obj);
-                observerData->subject_list.removeOne(obj);
+                observerData->removeSubject(obj);
                 observerData->subject_observer_list.removeOne(obj);
             }
         } else if (ownership_variant.isValid() && ((ObjectOwnership) ownership_variant.toInt() == SpecificObserverOwnership)) {
@@ -1067,21 +1352,21 @@ bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg)
             if (observer_parent.isValid() && (observer_parent.toInt() == observerID()) && obj) {
                 deleteObject(obj);
                 obj = 0;
-                QCoreApplication::processEvents();
+                IDLE_SCHEDULER->yieldToEventLoop();
                 lost_scope = true;
             } else {
                 removeQtilitiesProperties(obj);
-                observerData->subject_list.removeOne(obj);
+                observerData->removeSubject(obj);
                 observerData->subject_observer_list.removeOne(obj);
             }
         } else {
             removeQtilitiesProperties(obj);
-            observerData->subject_list.removeOne(obj);
+            observerData->removeSubject(obj);
             observerData->subject_observer_list.removeOne(obj);
         }
 
         #ifndef QT_NO_DEBUG
-        LOG_DEBUG(QString("Observer (%1): Not observing object (%2) anymore.").arg(objectName()).arg(debug_name));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1): Not observing object (%2) anymore.").arg(objectName()).arg(debug_name));
         #endif
     }
 
@@ -1094,6 +1379,7 @@ bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg)
     // Broadcast if neccesarry:
     setModificationState(true);
     if (!observerData->process_cycle_active) {
+        broadcastSubjectChanges();
         QList<QPointer<QObject> > objects;
         if (!lost_scope)
             objects << obj;
@@ -1106,6 +1392,7 @@ bool Qtilities::Core::Observer::detachSubject(QObject* obj, QString* rejectMsg)
 }
 
 QList<QPointer<QObject> > Qtilities::Core::Observer::detachSubjects(QList<QObject*> objects, QString* rejectMsg) {
+    observerData->completeDeferredImport();
     QList<QPointer<QObject> > success_list;
     startProcessingCycle();
 
@@ -1128,18 +1415,20 @@ QList<QPointer<QObject> > Qtilities::Core::Observer::detachSubjects(QList<QObjec
         }
     }
 
+    observerData->proc_cycle_detached_subjects << success_list;
     endProcessingCycle();
     return success_list;
 }
 
 Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canDetach(QObject* obj, QString* rejectMsg) const {
+    observerData->completeDeferredImport();
     if (objectName() != QString(qti_def_GLOBAL_OBJECT_POOL)) {
         // Check if this subject is observed by this observer. If its not observed by this observer, we can't detach it.
         MultiContextProperty observer_list_variant = ObjectManager::getMultiContextProperty(obj,qti_prop_OBSERVER_MAP);
         if (observer_list_variant.isValid()) {
             if (!observer_list_variant.hasContext(observerData->observer_id)) {
                 QString reject_string = QString("Observer (%1): Object (%2) detachment is not allowed, object is not observed by this observer.").arg(observerData->observer_id).arg(obj->objectName());
-                LOG_DEBUG(reject_string);
+                LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
                 if (rejectMsg)
                     *rejectMsg = reject_string;
                 return Observer::Rejected;
@@ -1154,7 +1443,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canDetach
         QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
         if (isConst(category)) {
             QString reject_string = QString("Detaching object \"%1\" from observer \"%2\" is not allowed. This observer is const for the recieved object.").arg(obj->objectName()).arg(objectName());
-            LOG_DEBUG(reject_string);
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
             if (rejectMsg)
                 *rejectMsg = reject_string;
             return Observer::Rejected;
@@ -1172,7 +1461,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canDetach
             }
         } else if (ownership_variant.isValid() && (ownership_variant.toInt() == OwnedBySubjectOwnership)) {
             QString reject_string = QString("Detaching object \"%1\" from observer \"%2\" is not allowed. This observer is dependant on this subject. To remove the subject permanently, delete it.").arg(obj->objectName()).arg(objectName());
-            LOG_DEBUG(reject_string);
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,reject_string);
             if (rejectMsg)
                 *rejectMsg = reject_string;
             return Observer::Rejected;
@@ -1201,6 +1490,7 @@ Qtilities::Core::Observer::EvaluationResult Qtilities::Core::Observer::canDetach
 }
 
 void Qtilities::Core::Observer::detachAll() {
+    observerData->completeDeferredImport();
     emit allSubjectsAboutToBeDetached();
 
     int start_count = observerData->subject_list.count();
@@ -1220,6 +1510,7 @@ void Qtilities::Core::Observer::detachAll() {
 }
 
 void Qtilities::Core::Observer::deleteAll(const QString& base_class_name, bool refresh_views) {
+    observerData->completeDeferredImport();
     int total = observerData->subject_list.count();
     if (total == 0)
         return;
@@ -1231,8 +1522,9 @@ void Qtilities::Core::Observer::deleteAll(const QString& base_class_name, bool r
 
     startProcessingCycle();
     QList<QObject*> objects_to_delete;
+    QByteArray base_class_name_bytes = base_class_name.toUtf8();
     for (int i = 0; i < total; ++i) {
-        if (observerData->subject_list.at(i)->inherits(base_class_name.toUtf8().data())) {
+        if (observerData->subject_list.at(i)->inherits(base_class_name_bytes.constData())) {
             // Validate operation against access mode if access mode scope is category:
             QVariant category_variant = getMultiContextPropertyValue(observerData->subject_list.at(i),qti_prop_CATEGORY_MAP);
             QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
@@ -1240,10 +1532,43 @@ void Qtilities::Core::Observer::deleteAll(const QString& base_class_name, bool r
                 objects_to_delete << observerData->subject_list.at(i);
         }
     }
-    for (int i = 0; i < objects_to_delete.count(); i++)
-        deleteObject(objects_to_delete.at(i));
+    if ((ObjectDeletionPolicy) observerData->object_deletion_policy == DeleteImmediately && objects_to_delete.count() > 1) {
+        // The subjects are detached from the subject filters and from this observer in a batch before they are deleted, thus
+        // their destruction does not have to be handled one subject at a time by handle_deletedSubject():
+        for (int f = 0; f < observerData->subject_filters.count(); ++f) {
+            AbstractSubjectFilter* subject_filter = observerData->subject_filters.at(f);
+            for (int i = 0; i < objects_to_delete.count(); ++i) {
+                if (!subject_filter->initializeDetachment(objects_to_delete.at(i),0,true))
+                    LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1): Error: Subject filter rejected detachment of deleted object (%2).").arg(objectName()).arg(objects_to_delete.at(i)->objectName()));
+            }
+        }
+        for (int f = 0; f < observerData->subject_filters.count(); ++f) {
+            AbstractSubjectFilter* subject_filter = observerData->subject_filters.at(f);
+            for (int i = 0; i < objects_to_delete.count(); ++i)
+                subject_filter->finalizeDetachment(objects_to_delete.at(i),true,true);
+        }
+
+        observerData->removeSubjects(objects_to_delete);
+        QList<QPointer<QObject> > guarded_objects;
+        for (int i = 0; i < objects_to_delete.count(); ++i) {
+            QObject* obj = objects_to_delete.at(i);
+            observerData->subject_observer_list.removeOne(obj);
+            obj->disconnect(this);
+            obj->removeEventFilter(this);
+            guarded_objects << obj;
+        }
 
-    QCoreApplication::processEvents();
+        // Deleting a subject might delete other subjects in the list, for example its children:
+        for (int i = 0; i < guarded_objects.count(); ++i)
+            delete guarded_objects.at(i);
+        for (int i = 0; i < objects_to_delete.count(); ++i)
+            emit subjectDeleted(objects_to_delete.at(i));
+    } else {
+        for (int i = 0; i < objects_to_delete.count(); i++)
+            deleteObject(objects_to_delete.at(i));
+    }
+
+    IDLE_SCHEDULER->yieldToEventLoop();
     toggleBroadcastModificationStateChanges(current_broadcast);
 
     int end_count = observerData->subject_list.count();
@@ -1265,21 +1590,7 @@ QVariant Qtilities::Core::Observer::getMultiContextPropertyValue(const QObject*
             return QVariant();
     #endif
 
-    QVariant prop;
-    prop = obj->property(property_name);
-
-    if (prop.isValid() && prop.canConvert<SharedProperty>()) {
-        // This is a shared property
-        return (prop.value<SharedProperty>()).value();
-    } else if (prop.isValid() && prop.canConvert<MultiContextProperty>()) {
-        // This is a normal multi context property (not shared)
-        return (prop.value<MultiContextProperty>()).value(observerData->observer_id);
-    } else if (!prop.isValid()) {
-        return QVariant();
-    } else {
-        LOG_TRACE(QString("Observer (%1): Getting of property (%2) failed, property not recognized as a qtilities property type.").arg(objectName()).arg(property_name));
-        return QVariant();
-    }
+    return ObjectManager::getMultiContextPropertyValue(obj,property_name,observerData->observer_id);
 }
 
 bool Qtilities::Core::Observer::setMultiContextPropertyValue(QObject* obj, const char* property_name, const QVariant& new_value) const {
@@ -1293,26 +1604,13 @@ bool Qtilities::Core::Observer::setMultiContextPropertyValue(QObject* obj, const
             return false;
     #endif
 
-    QVariant prop;
-    prop = obj->property(property_name);
-
-    // Important, we do not just use the setValue() functions on the ObserverProperties, we call
+    // Important, we do not just use the setValue() functions on the ObserverProperties, setMultiContextPropertyValue() calls
     // obj->setProperty to make sure the QDynamicPropertyChangeEvent event is triggered.
-    if (prop.isValid() && prop.canConvert<SharedProperty>()) {
-        // This is a shared property
-        SharedProperty shared_property = prop.value<SharedProperty>();
-        shared_property.setValue(new_value);
-        ObjectManager::setSharedProperty(obj,shared_property);
-        return true;
-    } else if (prop.isValid() && prop.canConvert<MultiContextProperty>()) {
-        // This is a normal multi context property (not shared)
-        MultiContextProperty observer_property = prop.value<MultiContextProperty>();
-        observer_property.setValue(new_value,observerData->observer_id);
-        ObjectManager::setMultiContextProperty(obj,observer_property);
+    if (ObjectManager::setMultiContextPropertyValue(obj,property_name,new_value,observerData->observer_id)) {
         return true;
     } else {
         QString error_str = QString("Observer (%1): Setting the value of property (%2) failed. This property is not yet set as an MultiContextProperty type class.").arg(objectName()).arg(property_name);
-        LOG_DEBUG(error_str);
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,error_str);
         qDebug() << error_str;
         // Assert here, otherwise you will think that the property is being set and you won't understand why something else does not work.
         // If you get here, you need to create the property you need, and then set it using the setMultiContextProperty() or setSharedProperty() calls.
@@ -1374,7 +1672,7 @@ bool Qtilities::Core::Observer::isParentInHierarchy(const Observer* obj_to_check
     bool is_parent = false;
 
     if (context_map_prop.isValid()) {
-        QList<quint32> keys = context_map_prop.contextMap().keys();
+        QList<quint32> keys = context_map_prop.contextIds();
         map_count = keys.count();
         // Check all direct parents:
         for (int i = 0; i < map_count; ++i) {
@@ -1392,7 +1690,7 @@ bool Qtilities::Core::Observer::isParentInHierarchy(const Observer* obj_to_check
             MultiContextProperty parent_context_map_prop = ObjectManager::getMultiContextProperty(observer->parent(), qti_prop_OBSERVER_MAP);
             QList<quint32> keys;
             if (parent_context_map_prop.isValid()) {
-                keys = context_map_prop.contextMap().keys();
+                keys = context_map_prop.contextIds();
                 map_count = keys.count();
             } else
                 return false;
@@ -1414,32 +1712,31 @@ bool Qtilities::Core::Observer::isParentInHierarchy(const Observer* obj_to_check
 }
 
 bool Qtilities::Core::Observer::isConst(const QtilitiesCategory& category) const {
-    AccessMode mode;
-    if (category.isEmpty() || (observerData->access_mode_scope == GlobalScope)) {
-        mode = (AccessMode) observerData->access_mode;
-    } else {
-        if (hasCategory(category)) {
-            mode = categoryAccessMode(category);
-        } else {
-            mode = (AccessMode) observerData->access_mode;
-        }
-    }
+    const bool observer_const = (observerData->access_mode == LockedAccess || observerData->access_mode == ReadOnlyAccess);
+    if (category.isEmpty() || (observerData->access_mode_scope == GlobalScope))
+        return observer_const;
 
-    if (mode == LockedAccess || mode == ReadOnlyAccess)
-        return true;
-    else
-        return false;
+    // Categories in this context without a defined access mode are not const, categories which are
+    // not in this context use the access mode of the observer. The category only needs to be looked up
+    // when these two answers differ:
+    const int category_mode = observerData->definedCategoryAccessMode(category);
+    const bool category_const = (category_mode == LockedAccess || category_mode == ReadOnlyAccess);
+    if (category_const == observer_const)
+        return observer_const;
+
+    return hasCategory(category) ? category_const : observer_const;
 }
 
 bool Qtilities::Core::Observer::setSubjectLimit(int subject_limit) {
+    observerData->completeDeferredImport();
     // Check if this observer is read only
     if ((observerData->access_mode == ReadOnlyAccess || observerData->access_mode == LockedAccess) && observerData->access_mode_scope == GlobalScope) {
-        LOG_DEBUG(QString("Setting the subject limit for observer \"%1\" failed. This observer is read only / locked.").arg(objectName()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Setting the subject limit for observer \"%1\" failed. This observer is read only / locked.").arg(objectName()));
         return false;
     }
 
     if ((subject_limit < observerData->subject_list.count()) && (subject_limit != -1)) {
-        LOG_DEBUG(QString("Setting the subject limit for observer \"%1\" failed, this observer is currently observing more subjects than the desired new limit.").arg(objectName()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Setting the subject limit for observer \"%1\" failed, this observer is currently observing more subjects than the desired new limit.").arg(objectName()));
         return false;
     } else {
         observerData->subject_limit = subject_limit;
@@ -1451,7 +1748,7 @@ bool Qtilities::Core::Observer::setSubjectLimit(int subject_limit) {
 void Qtilities::Core::Observer::setAccessMode(AccessMode mode, QtilitiesCategory category) {
     // Check if this observer is read only
     if ((observerData->access_mode == ReadOnlyAccess || observerData->access_mode == LockedAccess) && observerData->access_mode_scope == GlobalScope) {
-        LOG_DEBUG(QString("Setting the access mode for observer \"%1\" failed. This observer is read only / locked.").arg(objectName()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Setting the access mode for observer \"%1\" failed. This observer is read only / locked.").arg(objectName()));
         return;
     }
 
@@ -1460,7 +1757,7 @@ void Qtilities::Core::Observer::setAccessMode(AccessMode mode, QtilitiesCategory
     else {
         // Check if this category exists in this observer context:
         if (!hasCategory(category)) {
-            LOG_DEBUG(QString("Observer \"%1\" does not have category \"%2\", access mode cannot be set.").arg(objectName()).arg(category.toString(",")));
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer \"%1\" does not have category \"%2\", access mode cannot be set.").arg(objectName()).arg(category.toString(",")));
             return;
         }
 
@@ -1474,6 +1771,7 @@ void Qtilities::Core::Observer::setAccessMode(AccessMode mode, QtilitiesCategory
 
         category.setAccessMode((int) mode);
         observerData->categories.push_back(category);
+        observerData->invalidateCategoryAccessModes();
     }
 
     emit layoutChanged(QList<QPointer<QObject> >());
@@ -1483,16 +1781,11 @@ void Qtilities::Core::Observer::setAccessMode(AccessMode mode, QtilitiesCategory
 Qtilities::Core::Observer::AccessMode Qtilities::Core::Observer::accessMode(QtilitiesCategory category) const {
     if (category.isEmpty())
         return (AccessMode) observerData->access_mode;
-    else {
-        // Loop through the categories list until we find the category:
-        for (int i = 0; i < observerData->categories.count(); ++i) {
-            if (observerData->categories.at(i) == category) {
-                return (AccessMode) observerData->categories.at(i).accessMode();
-            }
-        }
-    }
 
-    return Observer::InvalidAccess;
+    const int category_mode = observerData->definedCategoryAccessMode(category);
+    if (category_mode == -1)
+        return Observer::InvalidAccess;
+    return (AccessMode) category_mode;
 }
 
 void Qtilities::Core::Observer::setObjectDeletionPolicy(ObjectDeletionPolicy object_deletion_policy) {
@@ -1533,6 +1826,14 @@ QString Qtilities::Core::Observer::subjectNameInContext(const QObject* obj) cons
     if (!obj)
         return QString();
 
+    // Subjects have their alias in the subject index:
+    if (const ObserverData::SubjectIndexEntry* entry = observerData->subjectMetadata(obj)) {
+        if (entry->flags & ObserverData::HasAlias)
+            return entry->alias;
+        else
+            return obj->objectName();
+    }
+
     // We need to check if a subject has an instance name in this context. If so, we use the instance name, not the objectName().
     QVariant instance_name = getMultiContextPropertyValue(obj,qti_prop_ALIAS_MAP);
     if (instance_name.isValid())
@@ -1545,6 +1846,13 @@ Qtilities::Core::QtilitiesCategory Qtilities::Core::Observer::subjectCategoryInC
     if (!obj)
         return QtilitiesCategory();
 
+    if (const ObserverData::SubjectIndexEntry* entry = observerData->subjectMetadata(obj)) {
+        if (entry->category_index >= 0)
+            return observerData->subject_categories.at(entry->category_index);
+        else
+            return QtilitiesCategory();
+    }
+
     // Check if the object is in this context:
     if (contains(obj) || contains(obj->parent())) {
         // We need to check if a subject has a category name in this context. If so, we use the instance name, not the objectName().
@@ -1588,6 +1896,9 @@ Qtilities::Core::Observer::ObjectOwnership Qtilities::Core::Observer::subjectOwn
     if (!obj)
         return ManualOwnership;
 
+    if (const ObserverData::SubjectIndexEntry* entry = observerData->subjectMetadata(obj))
+        return (Observer::ObjectOwnership) entry->ownership;
+
     // Check if the object is in this context:
     if (contains(obj) || contains(obj->parent())) {
         QVariant current_ownership = getMultiContextPropertyValue(obj,qti_prop_OWNERSHIP);
@@ -1599,16 +1910,22 @@ Qtilities::Core::Observer::ObjectOwnership Qtilities::Core::Observer::subjectOwn
 }
 
 int Qtilities::Core::Observer::treeCount(const QString& base_class_name) {
+    observerData->completeDeferredImport();
     #ifdef QTILITIES_BENCHMARKING
     QTime time;
     time.start();
     #endif
 
-    int count = subjectCount(base_class_name);
-    QList<QPointer<Observer> > observers = subjectObserverReferences();
-    for (int i = 0; i < observers.count(); ++i) {
-        if (observers.at(i))
-            count += observers.at(i)->treeCount(base_class_name);
+    int count = 0;
+    if (base_class_name.isEmpty()) {
+        count = observerData->treeSize();
+    } else {
+        QByteArray base_class_name_bytes = base_class_name.toUtf8();
+        TreeIterator itr(this,TreeIterator::StackIteration);
+        while (QObject* obj = itr.next()) {
+            if (obj->inherits(base_class_name_bytes.constData()))
+                ++count;
+        }
     }
 
     #ifdef QTILITIES_BENCHMARKING
@@ -1621,21 +1938,111 @@ int Qtilities::Core::Observer::treeCount(const QString& base_class_name) {
 }
 
 int Qtilities::Core::Observer::subjectCount(const QString& base_class_name) const {
+    if (base_class_name.isEmpty() && QThread::currentThread() != thread())
+        return observerData->subjectSnapshot().count();
+
+    observerData->completeDeferredImport();
     if (base_class_name.isEmpty())
         return observerData->subject_list.count();
     else
         return subjectReferences(base_class_name).count();
 }
 
+Qtilities::Core::ObserverSnapshot Qtilities::Core::Observer::treeSnapshot() const {
+    return observerData->treeSnapshot();
+}
+
+Qtilities::Core::MemoryUsageReport Qtilities::Core::Observer::memoryUsage(bool recursive) const {
+    MemoryUsageReport report;
+    addMemoryUsage(&report,recursive);
+    return report;
+}
+
+void Qtilities::Core::Observer::addMemoryUsage(MemoryUsageReport* report, bool recursive) const {
+    // Observers which are reached through multiple parents are counted once:
+    if (!report->addObject(this))
+        return;
+
+    const int subject_count = observerData->subject_list.count();
+    report->addBytes(MemoryUsageReport::ObserverMemory,"Observer data",sizeof(ObserverData) + sizeof(PointerList) * 2);
+    report->addBytes(MemoryUsageReport::ObserverMemory,"Subject lists",MemoryUsageReport::estimatedListBytes(subject_count,sizeof(void*))
+                     + MemoryUsageReport::estimatedListBytes(observerData->subject_observer_list.count(),sizeof(void*)),subject_count);
+    // The subject lists connect to the destroyed() signal of every subject:
+    report->addBytes(MemoryUsageReport::ObserverMemory,"Subject connections",(qint64) (subject_count + observerData->subject_observer_list.count()) * qti_private_CONNECTION_BYTES,
+                     subject_count + observerData->subject_observer_list.count());
+    report->addBytes(MemoryUsageReport::ObserverMemory,"Subject indexes",
+                     MemoryUsageReport::estimatedHashBytes(observerData->subject_index.count(),sizeof(void*) + sizeof(ObserverData::SubjectIndexEntry))
+                     + MemoryUsageReport::estimatedHashBytes(observerData->subject_id_index.count(),sizeof(int) + sizeof(void*)),
+                     observerData->subject_index.count());
+    int categorized_count = 0;
+    for (int i = 0; i < observerData->category_subjects.count(); ++i)
+        categorized_count += observerData->category_subjects.at(i).count();
+    report->addBytes(MemoryUsageReport::ObserverMemory,"Category indexes",
+                     MemoryUsageReport::estimatedListBytes(observerData->subject_categories.count(),sizeof(QtilitiesCategory))
+                     + MemoryUsageReport::estimatedHashBytes(observerData->subject_category_positions.count(),sizeof(int) * 2)
+                     + MemoryUsageReport::estimatedHashBytes(categorized_count,sizeof(void*))
+                     + MemoryUsageReport::estimatedHashBytes(observerData->uncategorized_subjects.count(),sizeof(void*)),
+                     observerData->subject_categories.count());
+    qint64 type_cache_bytes = 0;
+    QHash<QByteArray,QList<QObject*> >::const_iterator type_itr = observerData->subject_type_cache.constBegin();
+    while (type_itr != observerData->subject_type_cache.constEnd()) {
+        type_cache_bytes += type_itr.key().size() + MemoryUsageReport::estimatedListBytes(type_itr.value().count(),sizeof(void*));
+        ++type_itr;
+    }
+    type_cache_bytes += MemoryUsageReport::estimatedHashBytes(observerData->subject_type_cache.count(),sizeof(QByteArray) + sizeof(QList<QObject*>));
+    report->addBytes(MemoryUsageReport::ObserverMemory,"Subject type cache",type_cache_bytes,observerData->subject_type_cache.count());
+    report->addBytes(MemoryUsageReport::ObserverMemory,"Subject snapshot",MemoryUsageReport::estimatedListBytes(observerData->subject_snapshot.count(),sizeof(void*)));
+
+    // Subject filters and hints:
+    for (int i = 0; i < observerData->subject_filters.count(); ++i) {
+        AbstractSubjectFilter* filter = observerData->subject_filters.at(i);
+        report->addObject(filter,MemoryUsageReport::FilterMemory);
+        report->addBytes(MemoryUsageReport::FilterMemory,filter->filterName(),filter->estimatedStateBytes());
+    }
+    if (observerData->display_hints)
+        report->addObject(observerData->display_hints,MemoryUsageReport::HintsMemory);
+
+    // Subjects:
+    for (int i = 0; i < subject_count; ++i) {
+        QObject* obj = observerData->subject_list.at(i);
+        const Observer* obs = recursive ? qobject_cast<const Observer*> (obj) : 0;
+        if (obs)
+            obs->addMemoryUsage(report,true);
+        else
+            report->addObject(obj);
+    }
+}
+
 QObject* Qtilities::Core::Observer::treeAt(int i) const {
+    observerData->completeDeferredImport();
     if (i < 0)
         return 0;
 
-    QList<QObject*> list = treeChildren(QString(),i);
-    if (i >= list.count())
-        return 0;
+    // Items are ordered the same way TreeIterator visits them: each subject is followed by the tree underneath it.
+    const Observer* obs = this;
+    while (obs) {
+        const Observer* next_obs = 0;
+        int count = obs->observerData->subject_list.count();
+        for (int s = 0; s < count; ++s) {
+            QObject* obj = obs->observerData->subject_list.at(s);
+            if (i == 0)
+                return obj;
+            --i;
 
-    return list.at(i);
+            Observer* child_obs = qobject_cast<Observer*> (obj);
+            if (child_obs) {
+                int child_tree_size = child_obs->observerData->treeSize();
+                if (i < child_tree_size) {
+                    next_obs = child_obs;
+                    break;
+                }
+                i -= child_tree_size;
+            }
+        }
+        obs = next_obs;
+    }
+
+    return 0;
 }
 
 bool Qtilities::Core::Observer::treeContains(QObject* tree_item) const {
@@ -1643,13 +2050,18 @@ bool Qtilities::Core::Observer::treeContains(QObject* tree_item) const {
 }
 
 QList<QObject*> Qtilities::Core::Observer::treeChildren(const QString& iface, int limit, int iterator_id) const {
+    observerData->completeDeferredImport();
     QList<QObject*> children;
     int count = 0;
-
-    TreeIterator itr(this,iterator_id);
-    while (itr.hasNext()) {
-        QObject* obj = itr.next();
-        if (iface.isEmpty()) {
+    // All objects inherit QObject, thus we don't need to check it:
+    const bool match_all = iface.isEmpty() || iface == QLatin1String("QObject");
+    const QByteArray iface_bytes = iface.toUtf8();
+
+    // When an iterator ID is specified the caller relies on the qti_prop_TREE_ITERATOR_SOURCE_OBS properties set for that
+    // iterator, otherwise we use stack iteration which does not set any properties on the subjects in the tree:
+    TreeIterator itr(this,iterator_id,iterator_id == -1 ? TreeIterator::StackIteration : TreeIterator::PropertyTrackedIteration);
+    while (QObject* obj = itr.next()) {
+        if (match_all) {
             children << obj;
             if (limit != -1) {
                 ++count;
@@ -1657,7 +2069,7 @@ QList<QObject*> Qtilities::Core::Observer::treeChildren(const QString& iface, in
                     break;
             }
         } else {
-            if (obj->inherits(iface.toUtf8().data())) {
+            if (obj->inherits(iface_bytes.constData())) {
                 children << obj;
                 if (limit != -1) {
                     ++count;
@@ -1673,17 +2085,22 @@ QList<QObject*> Qtilities::Core::Observer::treeChildren(const QString& iface, in
 
 QStringList Qtilities::Core::Observer::subjectNames(const QString& iface) const {
     QStringList subject_names;
-
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        QObject* obj = observerData->subject_list.at(i);
-        if (obj->inherits(iface.toUtf8().data()) || iface.isEmpty())
-            subject_names << subjectNameInContext(obj);
+    if (iface.isEmpty() && QThread::currentThread() != thread()) {
+        const QList<QObject*> subjects = observerData->subjectSnapshot();
+        for (int i = 0; i < subjects.count(); ++i)
+            subject_names << subjectNameInContext(subjects.at(i));
+        return subject_names;
     }
+
+    const QList<QObject*> subjects = subjectReferences(iface == QLatin1String("QObject") ? QString() : iface);
+    int count = subjects.count();
+    for (int i = 0; i < count; ++i)
+        subject_names << subjectNameInContext(subjects.at(i));
     return subject_names;
 }
 
 QStringList Qtilities::Core::Observer::subjectDisplayedNames(const QString& iface) const {
+    observerData->completeDeferredImport();
     QStringList subject_names;
 
     int count = observerData->subject_list.count();
@@ -1691,7 +2108,7 @@ QStringList Qtilities::Core::Observer::subjectDisplayedNames(const QString& ifac
         QObject* object = observerData->subject_list.at(i);
         subject_names << object->objectName();
         continue;
-        if (object->inherits(iface.toUtf8().data()) || iface.isEmpty()) {
+        if (iface.isEmpty() || object->inherits(iface.toUtf8().constData())) {
             // We need to check if a subject has an instance name in this context. If so, we use the instance name, not the objectName().
             QVariant instance_name = getMultiContextPropertyValue(object,qti_prop_DISPLAYED_ALIAS_MAP);
             if (instance_name.isValid())
@@ -1710,8 +2127,15 @@ QStringList Qtilities::Core::Observer::subjectDisplayedNames(const QString& ifac
 }
 
 QStringList Qtilities::Core::Observer::subjectNamesByCategory(const QtilitiesCategory& category) const {
+    observerData->completeDeferredImport();
     QStringList subject_names;
 
+    if (observerData->isCategoryIndexComplete()) {
+        foreach (QObject* obj, observerData->subjectsInCategory(category))
+            subject_names << subjectNameInContext(obj);
+        return subject_names;
+    }
+
     int count = observerData->subject_list.count();
     for (int i = 0; i < count; ++i) {
         QObject* obj = observerData->subject_list.at(i);
@@ -1745,6 +2169,12 @@ QStringList Qtilities::Core::Observer::subjectNamesByCategory(const QtilitiesCat
 }
 
 bool Qtilities::Core::Observer::hasCategory(const QtilitiesCategory& category) const {
+    observerData->completeDeferredImport();
+    if (observerData->isCategoryIndexComplete()) {
+        int category_position = observerData->subjectCategoryPosition(category);
+        return category_position != -1 && !observerData->category_subjects.at(category_position).isEmpty();
+    }
+
     int count = observerData->subject_list.count();
     for (int i = 0; i < count; ++i) {
         QVariant category_variant = getMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP);
@@ -1760,54 +2190,114 @@ bool Qtilities::Core::Observer::hasCategory(const QtilitiesCategory& category) c
 }
 
 QList<QPointer<QObject> > Qtilities::Core::Observer::renameCategory(const QtilitiesCategory& old_category,const QtilitiesCategory& new_category, bool match_exactly) {
+    observerData->completeDeferredImport();
     QList<QPointer<QObject> > renamed_list;
 
     startProcessingCycle();
-    // Check the category on all subjects:
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        QVariant category_variant = getMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP);
-        // Check if a category property exists:
-        if (category_variant.isValid()) {
-            QtilitiesCategory current_category = category_variant.value<QtilitiesCategory>();
+    if (observerData->isCategoryIndexComplete()) {
+        // Only the categories used by subjects are checked, and only the subjects in matching categories are updated.
+        // The list of categories is copied since renaming subjects appends new categories to it:
+        const QList<QtilitiesCategory> used_categories = observerData->subject_categories;
+        const QStringList old_category_list = old_category.toStringList();
+        QList<QPair<int,QObject*> > renamed_positions;
+        for (int c = 0; c < used_categories.count(); ++c) {
+            if (observerData->category_subjects.at(c).isEmpty())
+                continue;
+
+            const QtilitiesCategory& current_category = used_categories.at(c);
             // Skip if current category is same as new category:
             if (current_category == new_category)
                 continue;
 
             // Check if we match exactly. In that case, the depths must match:
-            if (match_exactly) {
-                if (current_category.categoryDepth() != old_category.categoryDepth())
-                    continue;
-            }
+            if (match_exactly && current_category.categoryDepth() != old_category.categoryDepth())
+                continue;
 
-            QStringList subject_cat_list = current_category.toStringList(old_category.categoryDepth());
+            if (current_category.toStringList(old_category.categoryDepth()) != old_category_list)
+                continue;
 
-            // Check if we must update it:
-            if (subject_cat_list == old_category.toStringList()) {
-                // Construct the renamed category:
-                QString new_cat_string = current_category.toString();
-                new_cat_string.replace(old_category.toString(),new_category.toString());
-                QtilitiesCategory renamed_category(new_cat_string,QString("::"));
+            // Construct the renamed category:
+            QString new_cat_string = current_category.toString();
+            new_cat_string.replace(old_category.toString(),new_category.toString());
+            QtilitiesCategory renamed_category(new_cat_string,QString("::"));
 
-                // Skip if renamed category is same as current category:
-                if (renamed_category == current_category)
+            // Skip if renamed category is same as current category:
+            if (renamed_category == current_category)
+                continue;
+
+            // We need to update the access mode settings:
+            for (int a = 0; a < observerData->categories.count(); a++) {
+                if (observerData->categories.at(a) == current_category) {
+                    observerData->categories.takeAt(a);
+                    observerData->categories << renamed_category;
+                    observerData->invalidateCategoryAccessModes();
+                    break;
+                }
+            }
+
+            // Update the property on the subjects in this category. The set is copied since updating the
+            // property moves subjects out of it:
+            const QSet<const QObject*> category_subjects = observerData->category_subjects.at(c);
+            foreach (const QObject* subject, category_subjects) {
+                QObject* obj = const_cast<QObject*> (subject);
+                setMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP,qVariantFromValue(renamed_category));
+                renamed_positions << qMakePair(observerData->subjectPosition(obj),obj);
+            }
+        }
+
+        // Report the renamed subjects in the order they appear in the observer:
+        qSort(renamed_positions);
+        for (int i = 0; i < renamed_positions.count(); ++i)
+            renamed_list << renamed_positions.at(i).second;
+    } else {
+        // Check the category on all subjects:
+        int count = observerData->subject_list.count();
+        for (int i = 0; i < count; ++i) {
+            QVariant category_variant = getMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP);
+            // Check if a category property exists:
+            if (category_variant.isValid()) {
+                QtilitiesCategory current_category = category_variant.value<QtilitiesCategory>();
+                // Skip if current category is same as new category:
+                if (current_category == new_category)
                     continue;
 
-                // We need to update the access mode settings:
-                bool took_cat = false;
-                for (int c = 0; c < observerData->categories.count(); c++) {
-                    if (observerData->categories.at(c) == current_category) {
-                        observerData->categories.takeAt(c);
-                        took_cat = true;
-                        break;
-                    }
+                // Check if we match exactly. In that case, the depths must match:
+                if (match_exactly) {
+                    if (current_category.categoryDepth() != old_category.categoryDepth())
+                        continue;
                 }
-                if (took_cat)
-                    observerData->categories << renamed_category;
 
-                // Update the property on the current subject:
-                setMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP,qVariantFromValue(renamed_category));
-                renamed_list << subjectAt(i);
+                QStringList subject_cat_list = current_category.toStringList(old_category.categoryDepth());
+
+                // Check if we must update it:
+                if (subject_cat_list == old_category.toStringList()) {
+                    // Construct the renamed category:
+                    QString new_cat_string = current_category.toString();
+                    new_cat_string.replace(old_category.toString(),new_category.toString());
+                    QtilitiesCategory renamed_category(new_cat_string,QString("::"));
+
+                    // Skip if renamed category is same as current category:
+                    if (renamed_category == current_category)
+                        continue;
+
+                    // We need to update the access mode settings:
+                    bool took_cat = false;
+                    for (int c = 0; c < observerData->categories.count(); c++) {
+                        if (observerData->categories.at(c) == current_category) {
+                            observerData->categories.takeAt(c);
+                            took_cat = true;
+                            break;
+                        }
+                    }
+                    if (took_cat) {
+                        observerData->categories << renamed_category;
+                        observerData->invalidateCategoryAccessModes();
+                    }
+
+                    // Update the property on the current subject:
+                    setMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP,qVariantFromValue(renamed_category));
+                    renamed_list << subjectAt(i);
+                }
             }
         }
     }
@@ -1823,23 +2313,31 @@ QList<QPointer<QObject> > Qtilities::Core::Observer::renameCategory(const Qtilit
 Qtilities::Core::Observer::AccessMode Qtilities::Core::Observer::categoryAccessMode(const QtilitiesCategory& category) const {
     // Check if this category exists in this observer context:
     if (!hasCategory(category)) {
-        LOG_DEBUG(QString("Observer \"%1\" does not have category \"%2\", access mode cannot be set.").arg(objectName()).arg(category.toString(",")));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer \"%1\" does not have category \"%2\", access mode cannot be set.").arg(objectName()).arg(category.toString(",")));
         return InvalidAccess;
     }
 
-    // Loop through the categories list until we find the category:
-    for (int i = 0; i < observerData->categories.count(); ++i) {
-        if (observerData->categories.at(i) == category) {
-            return (AccessMode) observerData->categories.at(i).accessMode();
-        }
-    }
-
-    return InvalidAccess;
+    const int category_mode = observerData->definedCategoryAccessMode(category);
+    if (category_mode == -1)
+        return InvalidAccess;
+    return (AccessMode) category_mode;
 }
 
 QList<Qtilities::Core::QtilitiesCategory> Qtilities::Core::Observer::subjectCategories() const {
+    observerData->completeDeferredImport();
     QList<QtilitiesCategory> subject_categories;
 
+    if (observerData->isCategoryIndexComplete()) {
+        for (int c = 0; c < observerData->subject_categories.count(); ++c) {
+            if (!observerData->category_subjects.at(c).isEmpty())
+                subject_categories << observerData->subject_categories.at(c);
+        }
+        if (!observerData->uncategorized_subjects.isEmpty() && !subject_categories.contains(QtilitiesCategory()))
+            subject_categories << QtilitiesCategory();
+        qSort(subject_categories);
+        return subject_categories;
+    }
+
     int count = observerData->subject_list.count();
     for (int i = 0; i < count; ++i) {
         QVariant category_variant = getMultiContextPropertyValue(subjectAt(i),qti_prop_CATEGORY_MAP);
@@ -1859,10 +2357,23 @@ QList<Qtilities::Core::QtilitiesCategory> Qtilities::Core::Observer::subjectCate
 }
 
 QObject* Qtilities::Core::Observer::subjectAt(int i) const {
+    if (QThread::currentThread() != thread())
+        return observerData->subjectSnapshot().at(i);
+
+    observerData->completeDeferredImport();
     return observerData->subject_list.at(i);
 }
 
+int Qtilities::Core::Observer::subjectPosition(const QObject* obj) const {
+    observerData->completeDeferredImport();
+    if (!obj)
+        return -1;
+
+    return observerData->subjectPosition(obj);
+}
+
 int Qtilities::Core::Observer::subjectID(int i) const {
+    observerData->completeDeferredImport();
     if (i < observerData->subject_list.count()) {
         QVariant prop = getMultiContextPropertyValue(observerData->subject_list.at(i),qti_prop_OBSERVER_MAP);
         return prop.toInt();
@@ -1871,14 +2382,16 @@ int Qtilities::Core::Observer::subjectID(int i) const {
 }
 
 int Qtilities::Core::Observer::subjectID(const QString& subject_name, Qt::CaseSensitivity cs) const {
-    if (containsSubjectWithName(subject_name,cs)) {
-        QVariant prop = getMultiContextPropertyValue(subjectReference(subject_name,cs),qti_prop_OBSERVER_MAP);
+    QObject* obj = subjectReference(subject_name,cs);
+    if (obj) {
+        QVariant prop = getMultiContextPropertyValue(obj,qti_prop_OBSERVER_MAP);
         return prop.toInt();
     } else
         return -1;
 }
 
 QList<int> Qtilities::Core::Observer::subjectIDs() const {
+    observerData->completeDeferredImport();
     QList<int> subject_ids;
     int count = observerData->subject_list.count();
     for (int i = 0; i < count; ++i)
@@ -1887,20 +2400,30 @@ QList<int> Qtilities::Core::Observer::subjectIDs() const {
 }
 
 QList<QObject*> Qtilities::Core::Observer::subjectReferences(const QString& iface) const {
+    if (iface.isEmpty() && QThread::currentThread() != thread())
+        return observerData->subjectSnapshot();
+
+    observerData->completeDeferredImport();
     if (iface.isEmpty())
         return observerData->subject_list.toQList();
 
-    QList<QObject*> subjects;
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        if (observerData->subject_list.at(i)->inherits(iface.toUtf8().data()))
-            subjects << observerData->subject_list.at(i);
-    }
-    return subjects;
+    return observerData->subjectsInheriting(iface.toUtf8());
+}
+
+QList<QObject*> Qtilities::Core::Observer::subjectReferences(const QMetaObject* meta_object) const {
+    observerData->completeDeferredImport();
+    if (!meta_object)
+        return observerData->subject_list.toQList();
+
+    return observerData->subjectsInheriting(QByteArray(meta_object->className()));
 }
 
 QList<QObject*> Qtilities::Core::Observer::subjectReferencesByCategory(const QtilitiesCategory& category) const {
+    observerData->completeDeferredImport();
     // Get all subjects which has the qti_prop_CATEGORY_MAP property set to category.
+    if (observerData->isCategoryIndexComplete())
+        return observerData->subjectsInCategory(category);
+
     QList<QObject*> list;
 
     int count = observerData->subject_list.count();
@@ -1921,6 +2444,7 @@ QList<QObject*> Qtilities::Core::Observer::subjectReferencesByCategory(const Qti
 }
 
 QMap<QPointer<QObject>, QString> Observer::subjectReferenceCategoryMap() const {
+    observerData->completeDeferredImport();
     QMap<QPointer<QObject>, QString> map;
 
     int count = observerData->subject_list.count();
@@ -1937,6 +2461,7 @@ QMap<QPointer<QObject>, QString> Observer::subjectReferenceCategoryMap() const {
 }
 
 QMap<QPointer<QObject>, QString> Qtilities::Core::Observer::subjectMap() {
+    observerData->completeDeferredImport();
     QMap<QPointer<QObject>, QString> subject_map;
     int count = observerData->subject_list.count();
     for (int i = 0; i < count; ++i) {
@@ -1947,6 +2472,7 @@ QMap<QPointer<QObject>, QString> Qtilities::Core::Observer::subjectMap() {
 }
 
 QList<QPointer<Observer> > Observer::subjectObserverReferences() const {
+    observerData->completeDeferredImport();
     QList<QPointer<Observer> > obs_list;
     for (int i = 0; i < observerData->subject_observer_list.count(); ++i)
         obs_list << qobject_cast<Observer*> (observerData->subject_observer_list.at(i));
@@ -1954,21 +2480,12 @@ QList<QPointer<Observer> > Observer::subjectObserverReferences() const {
 }
 
 QObject* Qtilities::Core::Observer::subjectReference(int ID) const {
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        QObject* obj = observerData->subject_list.at(i);
-        QVariant prop = getMultiContextPropertyValue(obj,qti_prop_OBSERVER_MAP);
-        if (!prop.isValid()) {
-            LOG_TRACE(QString("Observer (%1): Looking for subject ID (%2) failed, property 'Subject ID' contains invalid variant for this context.").arg(objectName()).arg(ID));
-            return 0;
-        }
-        if (prop.toInt() == ID)
-            return obj;
-    }
-    return 0;
+    observerData->completeDeferredImport();
+    return observerData->subjectWithID(ID);
 }
 
 QObject* Qtilities::Core::Observer::subjectReference(const QString& subject_name, Qt::CaseSensitivity cs) const {
+    observerData->completeDeferredImport();
     int count = observerData->subject_list.count();
     for (int i = 0; i < count; ++i) {
         QObject* obj = observerData->subject_list.at(i);
@@ -1985,13 +2502,8 @@ QObject* Qtilities::Core::Observer::subjectReference(const QString& subject_name
 }
 
 bool Qtilities::Core::Observer::contains(const QObject* object) const {
-    int count = observerData->subject_list.count();
-    for (int i = 0; i < count; ++i) {
-        if (observerData->subject_list.at(i) == object)
-            return true;
-    }
-
-    return false;
+    observerData->completeDeferredImport();
+    return observerData->containsSubject(object);
 }
 
 bool Qtilities::Core::Observer::containsSubjectWithName(const QString& subject_name, Qt::CaseSensitivity cs) const {
@@ -2004,9 +2516,10 @@ bool Qtilities::Core::Observer::containsSubjectWithName(const QString& subject_n
 bool Qtilities::Core::Observer::installSubjectFilter(AbstractSubjectFilter* subject_filter) {
     if (!subject_filter)
         return false;
+    observerData->completeDeferredImport();
 
     if (observerData->subject_list.count() > 0) {
-        LOG_DEBUG(QString("Observer (%1): Subject filter installation failed. Can't install subject filters if subjects is already attached to an observer.").arg(objectName()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1): Subject filter installation failed. Can't install subject filters if subjects is already attached to an observer.").arg(objectName()));
         return false;
     }
 
@@ -2014,10 +2527,11 @@ bool Qtilities::Core::Observer::installSubjectFilter(AbstractSubjectFilter* subj
         return false;
 
     observerData->subject_filters.append(subject_filter);
+    observerData->invalidatePropertyRoutes();
 
     // Set the observer context of the filter
     if (!subject_filter->setObserverContext(this)) {
-        LOG_DEBUG(QString("Observer (%1): Subject filter installation failed. Setting the observer context on the subject filter failed.").arg(objectName()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1): Subject filter installation failed. Setting the observer context on the subject filter failed.").arg(objectName()));
         return false;
     }
 
@@ -2042,11 +2556,12 @@ bool Qtilities::Core::Observer::installSubjectFilter(AbstractSubjectFilter* subj
 
 bool Qtilities::Core::Observer::uninstallSubjectFilter(AbstractSubjectFilter* subject_filter) {
     if (observerData->subject_list.count() > 0) {
-        LOG_DEBUG(QString("Observer (%1): Subject filter uninstall failed. Can't uninstall subject filters if subjects is already attached to an observer.").arg(objectName()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1): Subject filter uninstall failed. Can't uninstall subject filters if subjects is already attached to an observer.").arg(objectName()));
         return false;
     }
 
     observerData->subject_filters.removeOne(subject_filter);
+    observerData->invalidatePropertyRoutes();
     subject_filter->disconnect(this);
     delete subject_filter;
     subject_filter = 0;
@@ -2098,12 +2613,23 @@ Qtilities::Core::ObserverHints* Qtilities::Core::Observer::useDisplayHints() {
 bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
 //    if (observerName() != "qti.def.ObjectPool")
 //        qDebug() << "Observer::eventFilter(): " << observerName() << ", filter subject events enabled: " << observerData->filter_subject_events_enabled;
+    // Properties set directly on subjects must update the subject index, even when the change is filtered below.
+    // Filtering a QDynamicPropertyChangeEvent does not undo the change of the property:
+    if (event->type() == QEvent::DynamicPropertyChange)
+        observerData->updateSubjectMetadata(object,static_cast<QDynamicPropertyChangeEvent *>(event)->propertyName().constData());
+
     if ((event->type() == QEvent::DynamicPropertyChange) && observerData->filter_subject_events_enabled) {
         // Get the event in the correct format
         QDynamicPropertyChangeEvent* propertyChangeEvent = static_cast<QDynamicPropertyChangeEvent *>(event);
 
+        // Events for properties which we do not reserve or monitor are rejected with a single lookup:
+        const ObserverData::PropertyRoute route = observerData->propertyRoute(propertyChangeEvent->propertyName());
+        if (route.flags == 0)
+            return false;
+        QTI_PERFORMANCE_COUNT("Observer: Property Change Events");
+
         // First check is to see if it is a reserved property. In that case we filter it directly.
-        if (reservedProperties().contains(QString(propertyChangeEvent->propertyName().data()))) {
+        if (route.flags & ObserverData::PropertyReserved) {
             QList<QObject*> filtered_list;
             filtered_list << object;
             emit propertyChangeFiltered(propertyChangeEvent->propertyName().data(),filtered_list);
@@ -2111,7 +2637,7 @@ bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
         }
 
         // Next check if it is a monitored property.
-        if (monitoredProperties().contains(QString(propertyChangeEvent->propertyName().data()))) {
+        if (route.flags & ObserverData::PropertyMonitored) {
             // Handle changes from different threads:
             if (!observerData->filter_subject_events_enabled) {
                 QList<QObject*> filtered_list;
@@ -2122,25 +2648,18 @@ bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
 
             observerData->filter_subject_events_enabled = false;
 
-            // We now route the event that changed to the subject filter responsible for this property to validate the change.
+            // We now route the event that changed to the subject filters responsible for this property to validate the change.
             // If no subject filter is responsible, the observer needs to handle it itself.
             QPointer<QObject> safe_object = object;
             bool filter_event = false;
-            for (int i = 0; i < observerData->subject_filters.count(); ++i) {
-                if (observerData->subject_filters.at(i)) {
-                    if (observerData->subject_filters.at(i)->monitoredProperties().contains(QString(propertyChangeEvent->propertyName().data()))) {
-                        bool int_filter_event = observerData->subject_filters.at(i)->handleMonitoredPropertyChange(object, propertyChangeEvent->propertyName().data(),propertyChangeEvent);
-                        if (!filter_event && int_filter_event)
-                            filter_event = true;
-                    }
-                }
+            for (int i = 0; i < route.filters.count(); ++i) {
+                bool int_filter_event = route.filters.at(i)->handleMonitoredPropertyChange(object, propertyChangeEvent->propertyName().data(),propertyChangeEvent);
+                if (!filter_event && int_filter_event)
+                    filter_event = true;
             }
             if (!safe_object)
                 return true;
 
-            // Check if internal properties added by the Observer is being changed:
-            // Todo - Check if this is done in above mutex check?
-
             // If the event should not be filtered, we need to post a user event on the object which will indicate
             // that the property change was valid and succesfull.
             // Note that subject filters must do the following themselves. Although this makes implementation
@@ -2152,14 +2671,17 @@ bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
                 // First check if this object is in the same thread as this observer:
                 if (object->thread() == thread()) {
                     if (observerData->deliver_qtilities_property_changed_events) {
-                        QByteArray property_name_byte_array = QByteArray(propertyChangeEvent->propertyName().data());
-                        QtilitiesPropertyChangeEvent* user_event = new QtilitiesPropertyChangeEvent(property_name_byte_array,observerID());
-                        QCoreApplication::postEvent(object,user_event);
-                        //qDebug() << QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(object->objectName());
-                        LOG_TRACE(QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(object->objectName()));
+                        // During processing cycles the events are posted once per subject and property when the cycle ends:
+                        if (observerData->process_cycle_active) {
+                            observerData->queuePropertyChangeEvent(object,propertyChangeEvent->propertyName());
+                        } else {
+                            QtilitiesPropertyChangeEvent* user_event = new QtilitiesPropertyChangeEvent(propertyChangeEvent->propertyName(),observerID());
+                            QCoreApplication::postEvent(object,user_event);
+                            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(object->objectName()));
+                        }
                     }
                 } else {
-                    LOG_TRACE(QString("Failed to post QtilitiesPropertyChangeEvent (property: %1) to object (%2). The object is not in the same thread.").arg(QString(propertyChangeEvent->propertyName().data())).arg(object->objectName()));
+                    LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Failed to post QtilitiesPropertyChangeEvent (property: %1) to object (%2). The object is not in the same thread.").arg(QString(propertyChangeEvent->propertyName().data())).arg(object->objectName()));
                 }
 
                 // 2. Emit the monitoredPropertyChanged() signal:
@@ -2168,18 +2690,11 @@ bool Qtilities::Core::Observer::eventFilter(QObject *object, QEvent *event) {
                 emit monitoredPropertyChanged(propertyChangeEvent->propertyName(),changed_objects);
 
                 // 3. For specific role properties, we need to notify views that the data changed:
-                if ((!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_DECORATION)) ||
-                    (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_FOREGROUND)) ||
-                    (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_BACKGROUND)) ||
-                    (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_TEXT_ALIGNMENT)) ||
-                    (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_FONT)) ||
-                    (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_SIZE_HINT))) {
-
-                    refreshViewsData();
-                }
+                if (route.flags & ObserverData::PropertyRefreshesData)
+                    refreshViewsSubjectData(object);
 
                 // 4. For specific role properties, we need to notify views that layout changed:
-                if (!qstrcmp(propertyChangeEvent->propertyName().data(),qti_prop_CATEGORY_MAP)) {
+                if (route.flags & ObserverData::PropertyRefreshesLayout) {
                     // Get the property and check its last changed context:
                     MultiContextProperty prop = ObjectManager::getMultiContextProperty(object,qti_prop_CATEGORY_MAP);
                     if (prop.isValid()) {
@@ -2318,7 +2833,7 @@ int Qtilities::Core::Observer::parentCount(const QObject* obj) {
 
     MultiContextProperty prop = ObjectManager::getMultiContextProperty(obj, Qtilities::Core::Properties::qti_prop_OBSERVER_MAP);
     if (prop.isValid()) {
-        return prop.contextMap().count();
+        return prop.contextCount();
     }
 
     return 0;
@@ -2331,8 +2846,8 @@ QList<Qtilities::Core::Observer*> Qtilities::Core::Observer::parentReferences(co
 
     MultiContextProperty prop = ObjectManager::getMultiContextProperty(obj, Qtilities::Core::Properties::qti_prop_OBSERVER_MAP);
     if (prop.isValid()) {
-        int count = prop.contextMap().count();
-        QList<quint32> parent_ids = prop.contextMap().keys();
+        int count = prop.contextCount();
+        QList<quint32> parent_ids = prop.contextIds();
         for (int i = 0; i < count; ++i) {
             Observer* obs = OBJECT_MANAGER->observerReference(parent_ids.at(i));
             if (obs)
@@ -2343,6 +2858,29 @@ QList<Qtilities::Core::Observer*> Qtilities::Core::Observer::parentReferences(co
     return parents;
 }
 
+void Qtilities::Core::Observer::updateSubjectMetadataInParents(const QObject* obj, const char* property_name) {
+    if (!obj)
+        return;
+
+    // Names are not part of the subject metadata, but they are part of the tree snapshots of the parents:
+    if (property_name && !qstrcmp(property_name,qti_prop_NAME)) {
+        const Observer* obs = qobject_cast<const Observer*> (obj);
+        if (obs)
+            obs->observerData->invalidateTreeSnapshot();
+        QList<Observer*> parents = parentReferences(obj);
+        for (int i = 0; i < parents.count(); ++i)
+            parents.at(i)->observerData->invalidateTreeSnapshot();
+        return;
+    }
+
+    if (!ObserverData::isSubjectMetadataProperty(property_name))
+        return;
+
+    QList<Observer*> parents = parentReferences(obj);
+    for (int i = 0; i < parents.count(); ++i)
+        parents.at(i)->observerData->updateSubjectMetadata(obj,property_name);
+}
+
 bool Qtilities::Core::Observer::isSupportedType(const QString& meta_type, Observer* observer) {
     if (!observer)
         return false;
@@ -2369,7 +2907,7 @@ void Qtilities::Core::Observer::deleteObject(QObject* object) {
     object->removeEventFilter(this);
 
     if ((ObjectDeletionPolicy) observerData->object_deletion_policy == DeleteLater) {
-        observerData->subject_list.removeOne(object);
+        observerData->removeSubject(object);
         observerData->subject_observer_list.removeOne(object);
         object->deleteLater();
     } else if ((ObjectDeletionPolicy) observerData->object_deletion_policy == DeleteImmediately) {
@@ -2377,3 +2915,134 @@ void Qtilities::Core::Observer::deleteObject(QObject* object) {
         delete object;
     }
 }
+
+void Qtilities::Core::Observer::postAttachSubjects(QList<QObject*> objects, Observer::ObjectOwnership ownership) {
+    QList<ObserverData::PostedOperation> operations;
+    operations.reserve(objects.count());
+    for (int i = 0; i < objects.count(); ++i) {
+        QObject* obj = objects.at(i);
+        if (!obj)
+            continue;
+
+        qti_private_moveSubjectTreeToThread(obj,thread());
+        if (obj->thread() != thread())
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Observer (%1): Object \"%2\" posted for attachment lives in a different thread than the observer.").arg(objectName()).arg(obj->objectName()));
+        operations << ObserverData::PostedOperation(ObserverData::PostedAttach,obj,(int) ownership);
+    }
+    postOperations(operations);
+}
+
+void Qtilities::Core::Observer::postAttachSubject(QObject* obj, Observer::ObjectOwnership ownership) {
+    QList<QObject*> objects;
+    objects << obj;
+    postAttachSubjects(objects,ownership);
+}
+
+void Qtilities::Core::Observer::postDetachSubjects(QList<QObject*> objects) {
+    QList<ObserverData::PostedOperation> operations;
+    operations.reserve(objects.count());
+    for (int i = 0; i < objects.count(); ++i) {
+        if (objects.at(i))
+            operations << ObserverData::PostedOperation(ObserverData::PostedDetach,objects.at(i));
+    }
+    postOperations(operations);
+}
+
+void Qtilities::Core::Observer::postSubjectProperty(QObject* obj, const char* property_name, const QVariant& value) {
+    if (!obj || !property_name)
+        return;
+
+    ObserverData::PostedOperation operation(ObserverData::PostedSetProperty,obj);
+    operation.property_name = QByteArray(property_name);
+    operation.property_value = value;
+    QList<ObserverData::PostedOperation> operations;
+    operations << operation;
+    postOperations(operations);
+}
+
+int Qtilities::Core::Observer::postedOperationCount() const {
+    QMutexLocker locker(&observerData->posted_operations_mutex);
+    return observerData->posted_operations.count();
+}
+
+Qtilities::Core::Observer* Qtilities::Core::Observer::cloneTree(bool* complete) const {
+    return observerData->cloneTree(complete);
+}
+
+QList<QPointer<QObject> > Qtilities::Core::Observer::cloneSubjects(Observer* target, const QList<QObject*>& subjects, bool* complete) const {
+    if (!target) {
+        if (complete)
+            *complete = false;
+        return QList<QPointer<QObject> >();
+    }
+
+    return observerData->cloneSubjects(target,subjects,complete);
+}
+
+void Qtilities::Core::Observer::postOperations(const QList<ObserverData::PostedOperation>& operations) {
+    if (operations.isEmpty())
+        return;
+
+    QMutexLocker locker(&observerData->posted_operations_mutex);
+    observerData->posted_operations << operations;
+    // All operations posted before the observer's thread gets to them are processed together:
+    if (observerData->posted_operations_queued)
+        return;
+
+    observerData->posted_operations_queued = true;
+    QMetaObject::invokeMethod(this,"processPostedOperations",Qt::QueuedConnection);
+}
+
+void Qtilities::Core::Observer::processPostedOperations() {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this,"processPostedOperations",Qt::QueuedConnection);
+        return;
+    }
+
+    QList<ObserverData::PostedOperation> operations;
+    {
+        QMutexLocker locker(&observerData->posted_operations_mutex);
+        operations = observerData->posted_operations;
+        observerData->posted_operations.clear();
+        observerData->posted_operations_queued = false;
+    }
+    if (operations.isEmpty())
+        return;
+
+    startProcessingCycle();
+    int i = 0;
+    while (i < operations.count()) {
+        const ObserverData::PostedOperation& operation = operations.at(i);
+        if (operation.type == ObserverData::PostedSetProperty) {
+            if (operation.subject && contains(operation.subject))
+                operation.subject->setProperty(operation.property_name.constData(),operation.property_value);
+            ++i;
+            continue;
+        }
+
+        // Consecutive attachments with the same ownership and consecutive detachments are applied together:
+        QList<QObject*> objects;
+        int j = i;
+        while (j < operations.count() && operations.at(j).type == operation.type && operations.at(j).ownership == operation.ownership) {
+            if (operations.at(j).subject)
+                objects << operations.at(j).subject;
+            ++j;
+        }
+
+        if (!objects.isEmpty()) {
+            QString errorMsg;
+            int done = 0;
+            if (operation.type == ObserverData::PostedAttach)
+                done = attachSubjects(objects,(Observer::ObjectOwnership) operation.ownership,&errorMsg).count();
+            else
+                done = detachSubjects(objects,&errorMsg).count();
+            if (done != objects.count())
+                LOG_WARNING(QString("Observer (%1): %2 of %3 posted subjects could not be %4: %5").arg(objectName()).arg(objects.count() - done).arg(objects.count())
+                            .arg(operation.type == ObserverData::PostedAttach ? "attached" : "detached").arg(errorMsg));
+        }
+        i = j;
+    }
+    endProcessingCycle();
+
+    emit postedOperationsProcessed(operations.count());
+}
@@ -24,6 +24,7 @@
 #include "SubjectTypeFilter.h"
 #include "QtilitiesCategory.h"
 #include "IExportableObserver.h"
+#include "MemoryUsageReport.h"
 
 #include <QObject>
 #include <QString>
@@ -108,7 +109,20 @@ observerWidget.show();
         - Observers monitor QDynamicPropertyChange events on objects that it manages, and send QtilitiesPropertyChangeEvent events on specific internal %Qtilities properties to objects that it manages. Since properties cannot be posted to objects living in other threads, and events cannot be filtered on objects in a different thread, this functionality of observers cannot be used when using threads as specified above. Event filtering is enabled by default, thus if you intend to use observers which manage objects in different threads, disable this using toggleSubjectEventFiltering().
         - When using observer's with naming policy filters installed outside of the GUI thread, make sure you don't use the Qtilities::CoreGui::NamingPolicyFilter::PromptUser resolution policy since it will attempt to construct a QWidget under specific circumstances and you application will crash.
 
-        Observer by itself is not thread-safe.
+        Observer by itself is not thread-safe. Since %Qtilities v1.5 other threads can change an observer by posting operations to it
+        using postAttachSubjects(), postDetachSubjects() and postSubjectProperty(). Posted operations are queued and applied in the thread of
+        the observer when control returns to its event loop, all operations posted since the previous time in a single processing cycle. Subjects
+        created in the posting thread are moved to the thread of the observer, together with the subjects of observers among them. This allows
+        worker threads to build subtrees in parallel and to hand them to an observer in the GUI thread:
+
+\code
+// On a worker thread:
+TreeNode* subtree = new TreeNode("Results");
+for (int i = 0; i < result_count; ++i)
+    subtree->addItem(QString("Result %1").arg(i));
+// Moves subtree and its items to the thread of root_node, and attaches subtree to root_node in that thread:
+root_node->postAttachSubject(subtree,Observer::ObserverScopeOwnership);
+\endcode
 
         \section observer_under_the_hood Under The Hood: How observers work behind the scenes.
 
@@ -475,6 +489,30 @@ In this example \p observerA will be deleted as soon as \p object1 is deleted.
               \sa toggleBroadcastModificationStateChanges()
               */
             bool broadcastModificationStateChangesEnabled() const;
+            //! This function enables/disables coalescing of view refreshes requested through refreshViewsLayout() and refreshViewsData().
+            /*!
+              When enabled, refreshViewsLayout() and refreshViewsData() do not notify views immediately. All refreshes requested before control returns to
+              the event loop are merged into a single layoutChanged() and dataChanged() emission, where layoutChanged() carries the union of all requested
+              selections. Thus views are only rebuilt once when many changes are refreshed one after another without a processing cycle.
+
+              Since the refreshes are delivered by the event loop of the observer's thread, coalescing must only be enabled on observers living in threads
+              which run an event loop. Code which depends on the views being updated when refreshViewsLayout() returns must use its \p force parameter.
+              When coalescing is disabled, pending refreshes are delivered immediately.
+
+              \note View refresh coalescing is disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa viewRefreshCoalescingEnabled()
+              */
+            void toggleViewRefreshCoalescing(bool toggle);
+            //! Indicates if view refresh coalescing is enabled.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa toggleViewRefreshCoalescing()
+              */
+            bool viewRefreshCoalescingEnabled() const;
 
             // --------------------------------
             // Factory Interface Implementation
@@ -520,12 +558,42 @@ In this example \p observerA will be deleted as soon as \p object1 is deleted.
               \note This function does not call detachAll() before doing the import.
               */
             virtual IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            /*!
+              The observer's own data and its subjects which are observers are streamed directly to \p writer. Subjects which are not observers are exported
+              one at a time using their exportXml() implementations.
+
+              \note Subclasses which reimplement exportXml() must also reimplement this function.
+              */
+            virtual IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            /*!
+              The same reconstruction sequence as importXml() is used. Subjects which are observers are read directly from \p reader, other subjects are read one at
+              a time and imported using their importXml() implementations.
+
+              \note Subclasses which reimplement importXml() must also reimplement this function.
+              */
+            virtual IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
+            /*!
+              The observer is written as a map of its data, followed by an array of its subjects. Subjects which are observers are written using the same
+              map, other subjects are written using their exportCbor() implementations. See Qtilities::Core::ObserverData::exportCborExt() for the keys used.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual IExportable::ExportResultFlags exportCbor(CborStreamWriter* writer) const;
+            /*!
+              The same reconstruction sequence as importXml() is used. Subjects are read one at a time and imported using their importCbor() implementations.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual IExportable::ExportResultFlags importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
             // --------------------------------
             // IExportableObserver Implementation
             // --------------------------------
             virtual IExportable::ExportResultFlags exportBinaryExt(QDataStream& stream, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData) const;
             virtual IExportable::ExportResultFlags exportXmlExt(QDomDocument* doc, QDomElement* object_node, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData) const;
+            virtual IExportable::ExportResultFlags exportXmlStreamExt(QXmlStreamWriter* writer, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData, const QDomElement* leading_elements = 0) const;
+            virtual IExportable::ExportResultFlags importXmlStreamExt(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list, QDomElement* other_elements = 0);
+            virtual IExportable::ExportResultFlags exportCborExt(CborStreamWriter* writer, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData) const;
 
             // --------------------------------
             // IModificationNotifier Implementation
@@ -549,6 +617,11 @@ In this example \p observerA will be deleted as soon as \p object1 is deleted.
              */
             bool monitorSubjectModificationState(QObject* obj);
 
+            //! Returns true when the observer, one of its monitored subjects, subject filters or display hints is modified.
+            /*!
+              The modification states of monitored subjects are tracked as they are reported, thus the subjects are not asked
+              for their modification states when this function is called.
+              */
             bool isModified() const;
         public slots:
             /*!
@@ -567,6 +640,15 @@ In this example \p observerA will be deleted as soon as \p object1 is deleted.
               data used for a normal observer. Call this function in your subclass constructor to change your object's factory data.
               */
             void setFactoryData(InstanceFactoryInfo factory_data);
+            //! Copies the data of \p source which is not copied by cloneTree() and cloneSubjects() to this observer, which is a clone of \p source.
+            /*!
+              Called on every observer cloned by cloneTree() and cloneSubjects() after its observer data was copied, and before its subjects
+              are attached. Reimplement this function in subclasses which keep data of their own, and call the base implementation. The
+              default implementation does nothing.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual void initializeClone(const Observer* source);
 
             // --------------------------------
             // Functions related to item views viewing this observer and signal emission.
@@ -576,16 +658,49 @@ In this example \p observerA will be deleted as soon as \p object1 is deleted.
             /*!
               This function will emit the layoutChanged() signal with the new_selection parameter.
 
-              \param force When true views will be updated even if a processing cycle is currently active on the observer. When false the processing cycle will be respected.
+              When view refresh coalescing is enabled using toggleViewRefreshCoalescing(), the signal is not emitted immediately. See toggleViewRefreshCoalescing()
+              for more details.
+
+              \param force When true views will be updated immediately, even if a processing cycle is currently active on the observer or view refresh coalescing
+              is enabled. Pending refreshes are delivered together with the forced refresh. When false the processing cycle will be respected.
               */
             void refreshViewsLayout(QList<QPointer<QObject> > new_selection = QList<QPointer<QObject> >(), bool force = false);
             //! Function to refresh the data views showing this observer.
             /*!
-              This function will emit the dataChanged(this) signal.
+              This function will emit the dataChanged(this) signal. Like refreshViewsLayout(), the signal is only delayed when view refresh coalescing
+              is enabled using toggleViewRefreshCoalescing().
 
-              \param force When true views will be updated even if a processing cycle is currently active on the observer. When false the processing cycle will be respected.
+              \param force When true views will be updated immediately, even if a processing cycle is currently active on the observer or view refresh coalescing
+              is enabled. When false the processing cycle will be respected.
               */
             void refreshViewsData(bool force = false);
+            //! Function to refresh the data of a single subject in views showing this observer.
+            /*!
+              This function will emit the subjectDataChanged() signal, allowing views to refresh only the items representing \p subject instead of
+              the complete observer context. When a processing cycle is active, the subject is reported when the processing cycle ends.
+
+              \param subject The subject of which the data changed.
+              \param force When true views will be updated even if a processing cycle is currently active on the observer. When false the processing cycle will be respected.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void refreshViewsSubjectData(QObject* subject, bool force = false);
+        private:
+            //! Emits the changes recorded in observerData since they were last emitted. Must not be called while a processing cycle is active.
+            void broadcastSubjectChanges();
+            //! Posts handleQueuedViewRefreshes() to the event loop, unless it is already posted.
+            void queueViewRefreshes();
+            //! Emits the refreshes requested through refreshViewsLayout() and refreshViewsData() since they were last delivered.
+            void deliverViewRefreshes();
+        private slots:
+            //! Delivers pending view refreshes when control returns to the event loop, see queueViewRefreshes().
+            void handleQueuedViewRefreshes();
+            //! Tracks the modification state reported by a monitored subject, see isModified().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSubjectModificationStateChanged(bool is_modified);
+        public:
             //! Starts a processing cycle.
             /*!
               When adding/removing many subjects to the observer it makes sense to only let item views know
@@ -699,6 +814,11 @@ obs.endProcessingCycle(); // Internal count = 0;
             /*!
               This function will call startProcessingCycle() when it starts and endProcessingCycle() when it is done.
 
+              Since %Qtilities v1.5, space for the new subjects is reserved up front and installed subject filters are notified about the complete list through
+              AbstractSubjectFilter::initializeBulkAttachment() and AbstractSubjectFilter::finalizeBulkAttachment(), allowing them to validate the list in one pass.
+              The attached subjects are reported in a single numberOfSubjectsChanged() signal when the outer processing cycle ends. Thus, when attaching large numbers
+              of objects, this function is much faster than calling attachSubject() for each object.
+
               \param objects A list of objects which must be attached.
               \param ownership The ownership that the observer should use to manage the object. The default is Observer::ManualOwnership.
               \param import_cycle Indicates if the attachment call was made during an observer import cycle. In such cases the subject filter must not add exportable properties to the object since these properties will be added from the import source. Also, it is not necessary to validate the context in such cases. False by default.
@@ -743,6 +863,108 @@ obs.endProcessingCycle(); // Internal count = 0;
              */
             Observer::EvaluationResult canDetach(QObject* obj, QString* rejectMsg = 0) const;
 
+            // --------------------------------
+            // Functions to change the observer from other threads
+            // --------------------------------
+            //! Posts the attachment of \p objects to the thread of the observer. This function is thread-safe.
+            /*!
+              The objects are attached by processPostedOperations() in the thread of the observer, using attachSubjects(). Objects which live in the calling
+              thread and do not have a parent are moved to the thread of the observer first. When such an object is an observer, its subjects which
+              live in the calling thread and do not have parents are moved with it, recursively.
+
+              Objects which cannot be moved, because they have parents or live in a third thread, are attached without being moved. See \ref observer_threads
+              for the limitations of observers with subjects in other threads.
+
+              \note The attachment can be rejected by the subject filters of the observer like any other attachment. Rejections are logged.
+
+              \sa postDetachSubjects(), postSubjectProperty(), processPostedOperations()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void postAttachSubjects(QList<QObject*> objects, Observer::ObjectOwnership ownership = Observer::ManualOwnership);
+            //! Posts the attachment of \p obj to the thread of the observer. This function is thread-safe.
+            /*!
+              See postAttachSubjects() for more information.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void postAttachSubject(QObject* obj, Observer::ObjectOwnership ownership = Observer::ManualOwnership);
+            //! Posts the detachment of \p objects to the thread of the observer. This function is thread-safe.
+            /*!
+              The objects are detached by processPostedOperations() in the thread of the observer, using detachSubjects(). Objects which are deleted
+              before the operation is processed are ignored.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void postDetachSubjects(QList<QObject*> objects);
+            //! Posts setting the dynamic property \p property_name of \p obj to \p value to the thread of the observer. This function is thread-safe.
+            /*!
+              The property is only set when \p obj is still a subject of this observer when the operation is processed, thus the observer's event filter
+              handles the property change in its own thread.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void postSubjectProperty(QObject* obj, const char* property_name, const QVariant& value);
+            //! Returns the number of posted operations which were not processed yet. This function is thread-safe.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int postedOperationCount() const;
+
+            // --------------------------------
+            // Cloning
+            // --------------------------------
+            //! Creates a deep copy of this observer and the tree underneath it.
+            /*!
+              Duplicating a tree by exporting it and importing the result again encodes every object, reconstructs the tree through the
+              relational table and checks the result. Cloning copies the tree directly instead:
+
+              - Every observer and subject is constructed through the factory described by its IExportable::instanceFactoryInfo().
+              - The observer data of observers, thus their hints, categories, access modes and exportable subject filters, is copied
+                directly. Subclasses copy their own data in initializeClone().
+              - Subjects which are not observers copy the data they do not keep in properties through their binary export, which costs
+                nothing for subjects like tree items which keep all their data in properties.
+              - Properties are copied as they are. The contexts of multi context properties, for example categories and activity, are
+                moved from the source observers to their clones, and contexts of observers outside the cloned tree are dropped.
+              - Objects which appear more than once in the tree are cloned once and their clones are attached to the clones of all
+                their parents.
+
+              Clones are attached to their parents using Observer::ObserverScopeOwnership, as they are by imports. Objects which are not
+              IExportable, or which can't be constructed by their factory, are skipped.
+
+\code
+TreeNode* configuration_copy = qobject_cast<TreeNode*> (configuration_node->cloneTree());
+\endcode
+
+              \param complete When valid, set to false when objects were skipped.
+              \returns The clone which has no parents, or 0 when this observer can't be constructed through its factory.
+
+              \sa cloneSubjects()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            Observer* cloneTree(bool* complete = 0) const;
+            //! Creates deep copies of subjects of this observer and the trees underneath them, and attaches them to \p target.
+            /*!
+              The subjects are cloned like cloneTree() clones the subjects of an observer. The contexts of multi context properties in
+              this observer, for example categories, are moved to \p target. The clones are attached to \p target in a single call to
+              attachSubjects(), thus the subject filters of \p target handle them like any other attachment, and views of \p target are
+              updated once. Clones which \p target rejects are deleted.
+
+\code
+// Paste as copy:
+source_observer->cloneSubjects(target_observer,ObjectManager::convSafeObjectsToNormal(mime_data->subjectList()));
+\endcode
+
+              \param target The observer to attach the clones to. It can be this observer.
+              \param subjects The subjects to clone. When empty, all subjects are cloned. Objects which are not subjects of this observer are ignored.
+              \param complete When valid, set to false when objects were skipped or rejected.
+              \returns The clones which were attached to \p target.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<QPointer<QObject> > cloneSubjects(Observer* target, const QList<QObject*>& subjects = QList<QObject*>(), bool* complete = 0) const;
+
         public slots:
             //! Will attempt to detach the specified object from the observer.
             /*!
@@ -782,6 +1004,15 @@ obs.endProcessingCycle(); // Internal count = 0;
               \param refresh_views Indicates if this function must refresh all observer views when done.
               */
             virtual void deleteAll(const QString &base_class_name = "QObject", bool refresh_views = true);
+            //! Applies all operations posted to the observer using postAttachSubjects(), postDetachSubjects() and postSubjectProperty().
+            /*!
+              This function is called automatically in the thread of the observer when control returns to its event loop, all operations are applied in a
+              single processing cycle. Call it directly from the thread of the observer to apply the posted operations immediately. When called from
+              another thread, the call is posted to the thread of the observer.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void processPostedOperations();
 
         private slots:
             //! Will handle an object which has been deleted somewhere else in the application.
@@ -833,6 +1064,15 @@ obs.endProcessingCycle(); // Internal count = 0;
         private:
             //! This function will remove all the properties which this observer might have added to an obj.
             void removeQtilitiesProperties(QObject* obj);
+            //! Updates the typed subject metadata kept for obj in all observers observing it after \p property_name changed on obj.
+            /*!
+              Called by ObjectManager when Qtilities properties are set, thus observers which do not filter the events of their subjects stay in sync as well.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static void updateSubjectMetadataInParents(const QObject* obj, const char* property_name);
+            friend class ObjectManager;
+            friend class ObserverData;
 
         public:
             // --------------------------------
@@ -919,14 +1159,44 @@ obs.endProcessingCycle(); // Internal count = 0;
             //! Function to get the number of children under the specified observer.
             /*!
                 This count includes the children of children as well. To get the number of subjects only in this context use subjectCount().
+
+                When \p base_class_name is empty, the count is maintained by the observers in the tree and is only recalculated for the parts of the tree
+                which changed since the previous call. Otherwise the tree is iterated.
+
                 \note This observer itself is not counted.
                 */
             int treeCount(const QString& base_class_name = QString());
             //! Function to get a QObject reference at a specific location in the tree underneath this observer.
             /*!
               If \p i is < 0 or bigger than or equal to the number of items retuned by allChildren() this function returns 0.
+
+              The item is found by descending into the tree using the tree sizes of the observers in the tree, thus the items before \p i are not collected.
               */
             QObject* treeAt(int i) const;
+            //! Returns an immutable snapshot of the tree underneath this observer.
+            /*!
+              The snapshot contains the names, categories and ownership of all subjects in the tree and can be traversed from any thread
+              while the tree keeps changing, see ObserverSnapshot for details. Only observers in which the tree changed since their previous
+              snapshot create new snapshots, the snapshots of all other observers are shared.
+
+              \note This function must be called from the thread the observer lives in.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObserverSnapshot treeSnapshot() const;
+            //! Returns an estimate of the memory used by this observer and, when \p recursive is true, by the tree underneath it.
+            /*!
+              The report includes the subjects and their dynamic properties, the bookkeeping of the observers in the tree, the subject filters
+              installed in them and their observer hints. Objects which are attached to multiple observers in the tree are counted once. When
+              \p recursive is false, the subjects of this observer are included but not the trees underneath them.
+
+              See MemoryUsageReport for an example.
+
+              \note This function must be called from the thread the observer lives in. It visits every subject in the tree.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            MemoryUsageReport memoryUsage(bool recursive = true) const;
             //! Function to check if a specific AbstractTreeItem is contained in the tree underneath this node.
             bool treeContains(QObject* tree_item) const;
             //! Function to get the QObject references of all items in the tree underneath this observer.
@@ -968,6 +1238,21 @@ QVERIFY(items_verify.count() == 5);
             QStringList subjectDisplayedNames(const QString& base_class_name = "QObject") const;
             //! Returns the subject reference at a given position.
             QObject* subjectAt(int i) const;
+            //! Returns the position of a subject in this observer, or -1 if \p obj is not observed by this observer.
+            /*!
+              The position of a subject is its index in subjectReferences(), and the row of the subject in Qtilities::CoreGui::ObserverTableModel.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int subjectPosition(const QObject* obj) const;
+            //! Returns a counter which changes whenever subjects are attached to or detached from this observer.
+            /*!
+              Positions returned by subjectPosition() stay valid for as long as the revision does not change, which allows
+              SubjectIterator to step through the subjects without looking up the position of the current subject every time.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline int subjectsRevision() const { return observerData->subjects_revision; }
             //! Returns the ID of the object at the specified position of the Observer's pointer list, returns -1 if the object was not found.
             int subjectID(int i) const;
             //! Returns the ID associated with a specific subject.
@@ -981,7 +1266,43 @@ QVERIFY(items_verify.count() == 5);
             //! Returns the IDs for all the attached subjects.
             QList<int> subjectIDs() const;
             //! Returns a list with the subject references of all the observed subjects which inherits a specific base class. If you don't specify an interface, all QObjects in the observer are returned.
+            /*!
+              \p base_class_name can be a class name or an interface name declared using Q_DECLARE_INTERFACE(). The results are cached per name until subjects are
+              attached or detached, thus repeated queries for the same name do not inspect all subjects again.
+              */
             QList<QObject*> subjectReferences(const QString& base_class_name = QString()) const;
+            //! Returns a list with the subject references of all the observed subjects which inherits the class described by \p meta_object.
+            /*!
+              For example:
+\code
+QList<QObject*> nodes = observer->subjectReferences(&TreeNode::staticMetaObject);
+\endcode
+
+              When \p meta_object is 0, all subjects are returned.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<QObject*> subjectReferences(const QMetaObject* meta_object) const;
+            //! Returns a list with the subjects which can be cast to \p T using qobject_cast().
+            /*!
+              \p T can be a QObject based class or an interface declared using Q_DECLARE_INTERFACE(). For example:
+\code
+QList<IMode*> modes = observer->subjectReferences<IMode>();
+\endcode
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            template <class T> QList<T*> subjectReferences() const {
+                QList<T*> subjects;
+                observerData->completeDeferredImport();
+                const int count = observerData->subject_list.count();
+                for (int i = 0; i < count; ++i) {
+                    T* subject = qobject_cast<T*> (observerData->subject_list.at(i));
+                    if (subject)
+                        subjects << subject;
+                }
+                return subjects;
+            }
             //! Return a QMap with references to all subjects as keys with the names used for the subjects in this context as values.
             QMap<QPointer<QObject>, QString> subjectMap();
             //! Returns a list of observers under this observer.
@@ -1177,13 +1498,54 @@ QVERIFY(items_verify.count() == 5);
               Thus, for table views this is enough, for tree views use layoutChanged().
 
               \param change_indication Slots can use this indicator to know what change occurred.
-              \param objects A list of objects which was added/removed. When the list contains null items, these objects were deleted and the observer picked it up and removed them. When this signal is emitted in endProcessingCycle() this list will be empty.
+              \param objects A list of objects which was added/removed. When the list contains null items, these objects were deleted and the observer picked it up and removed them. When this signal is emitted in endProcessingCycle() this list contains the subjects which were attached using attachSubjects() or detached using detachSubjects() during the processing cycle, and is empty when subjects were only attached or detached individually. When both happened in a processing cycle, the signal is emitted with Observer::SubjectRemoved and then with Observer::SubjectAdded.
 
               \note Whenever it is needed to emit this signal, Observer will first set the modification state of the Observer to true and then emit the signal.
               \note When a processing cycle is active on the observer, this signal will be emitted at the end of the processing cycle in endProcessingCycle only if
               the number of subjects changed during the processing cycle. See endProcessingCycle() for more information.
               */
             void numberOfSubjectsChanged(Observer::SubjectChangeIndication change_indication, QList<QPointer<QObject> > objects = QList<QPointer<QObject> >());
+            //! A signal which is emitted after subjects were inserted in this observer context.
+            /*!
+              Together with subjectsRemoved(), subjectsReset() and subjectDataChanged() this signal allows models to update only the rows which changed,
+              instead of resetting on layoutChanged(). When a processing cycle is active, inserted subjects are reported when the processing cycle ends.
+
+              \param first The position of the first inserted subject, see subjectPosition().
+              \param last The position of the last inserted subject.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void subjectsInserted(int first, int last);
+            //! A signal which is emitted after subjects were removed from this observer context.
+            /*!
+              Ranges must be applied in the order in which they are received.
+
+              \param first The position of the first removed subject, before it was removed.
+              \param last The position of the last removed subject, before it was removed.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void subjectsRemoved(int first, int last);
+            //! A signal which is emitted instead of subjectsInserted() and subjectsRemoved() when changes to this observer context cannot be described by ranges.
+            /*!
+              This happens for subjects which are deleted while processing cycles are active, and when large numbers of unrelated changes happen during a processing cycle.
+              Models must rebuild their rows for this observer context.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void subjectsReset();
+            //! A signal which is emitted when the data of a subject shown in views changed, for example its name.
+            /*!
+              This signal is emitted by parent observers as well, thus it can be used to monitor changes in the complete tree underneath an observer.
+
+              \param observer The observer context in which the data of \p subject changed.
+              \param subject The subject of which the data changed.
+
+              \sa refreshViewsSubjectData()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void subjectDataChanged(Observer* observer, QObject* subject);
 
             //! A signal which is emitted when the layout of the observer or the tree underneath it changes.
             /*!
@@ -1219,10 +1581,31 @@ QVERIFY(items_verify.count() == 5);
             void processingCycleStarted();
             //! Signal which is emitted when this observer exists a processing cycle.
             void processingCycleEnded();
+            //! Signal which is emitted when the tree underneath this observer changes for the first time after its tree snapshot was taken.
+            /*!
+              The signal is emitted once for all changes until the next treeSnapshot() is taken, thus it is cheap to monitor large trees
+              with it. It is emitted while the tree is being changed, which might be inside a processing cycle.
+
+              \sa treeSnapshot()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void treeChanged();
+            //! Signal which is emitted when processPostedOperations() applied posted operations.
+            /*!
+              \param operation_count The number of operations which were applied, including rejected operations.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void postedOperationsProcessed(int operation_count);
 
         private:
             //! Performs a delete on an object in a thread-safe way.
             void deleteObject(QObject* object);
+            //! Queues \p operations and posts processPostedOperations() to the thread of the observer, unless it is already posted.
+            void postOperations(const QList<ObserverData::PostedOperation>& operations);
+            //! Adds the estimated memory used by this observer, its subjects and, when \p recursive is true, the trees underneath them to \p report.
+            void addMemoryUsage(MemoryUsageReport* report, bool recursive) const;
 
         protected:
             ObserverData* observerData;
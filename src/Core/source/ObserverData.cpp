@@ -10,20 +10,171 @@
 ****************************************************************************/
 
 #include "ObserverData.h"
+#include "ObserverSnapshot_p.h"
 #include "ObserverHints.h"
 #include "IExportableFormatting.h"
 #include "ActivityPolicyFilter.h"
 #include "ObserverRelationalTable.h"
 #include "ITask.h"
+#include "QtilitiesProperty.h"
+#include "CompactBinaryFormat.h"
+#include "CborStream.h"
+#include "ExportTask.h"
+
+#include <PerformanceCounters>
 
 #include <stdio.h>
 #include <time.h>
 
+#include <QBuffer>
+#include <QPair>
+#include <QtAlgorithms>
 #include <QDomElement>
+#include <QStringList>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
 
 using namespace Qtilities::Core::Interfaces;
 
 quint32 MARKER_OBS_DATA_SECTION = 0xDEADBEEF;
+// The minimum number of objects in the subtree of a child observer before it is exported in its own thread when ExportParallel is used:
+int PARALLEL_EXPORT_MINIMUM_TREE_SIZE = 64;
+
+namespace Qtilities {
+    namespace Core {
+        // Exports the independent subtree of a child observer in a thread pool thread. Binary exports are written to buffer, XML exports to their own document since QDomDocument is not thread safe.
+        class ObserverDataExportWorker : public QRunnable
+        {
+        public:
+            ObserverDataExportWorker(IExportableObserver* export_iface, ObserverData::ExportItemFlags export_flags, IExportable::ExportMode export_mode, const QDataStream* stream_format) : QRunnable(),
+                export_iface(export_iface),
+                export_flags(export_flags),
+                export_mode(export_mode),
+                stream_version(QDataStream::Qt_4_7),
+                byte_order(QDataStream::BigEndian),
+                result(IExportable::Failed)
+            {
+                if (stream_format) {
+                    stream_version = stream_format->version();
+                    byte_order = stream_format->byteOrder();
+                }
+                setAutoDelete(false);
+            }
+
+            void run() {
+                if (export_mode == IExportable::Binary) {
+                    QDataStream stream(&buffer,QIODevice::WriteOnly);
+                    stream.setVersion(stream_version);
+                    stream.setByteOrder(byte_order);
+                    result = export_iface->exportBinaryExt(stream,export_flags);
+                } else {
+                    object_node = doc.createElement("TreeItem");
+                    doc.appendChild(object_node);
+                    result = export_iface->exportXmlExt(&doc,&object_node,export_flags);
+                }
+            }
+
+            IExportableObserver*            export_iface;
+            ObserverData::ExportItemFlags   export_flags;
+            IExportable::ExportMode         export_mode;
+            int                             stream_version;
+            QDataStream::ByteOrder          byte_order;
+            //! The binary export of the subtree.
+            QByteArray                      buffer;
+            //! The document holding the XML export of the subtree.
+            QDomDocument                    doc;
+            //! The TreeItem element of the subtree in doc.
+            QDomElement                     object_node;
+            IExportable::ExportResultFlags  result;
+        };
+
+        // The information needed to import the subjects of an observer of which the import was deferred, see ObserverData::deferBinarySubjects_1_5().
+        struct ObserverDataDeferredImport
+        {
+            //! The data which the observer was read from, it stays valid while owner exists.
+            QByteArray                      data;
+            QSharedPointer<QObject>         owner;
+            //! The position of the first subject in data.
+            qint64                          offset;
+            int                             subject_count;
+            quint32                         export_flags;
+            //! The string table which was active when the subjects were skipped.
+            QStringList                     strings;
+            int                             stream_version;
+            QDataStream::ByteOrder          byte_order;
+            Qtilities::ExportVersion        export_version;
+            quint32                         application_export_version;
+        };
+
+        // The state of a clone of a tree, see ObserverData::cloneTree() and ObserverData::cloneSubjects().
+        struct ObserverDataCloneContext
+        {
+            ObserverDataCloneContext() : complete(true) {}
+
+            //! The clones of the objects in the cloned tree.
+            QHash<const QObject*,QObject*>                      clones;
+            //! The objects which were cloned, in the order in which they were cloned.
+            QList<const QObject*>                               sources;
+            //! The IDs of the cloned observers mapped to the IDs of their clones.
+            QHash<int,int>                                      observer_ids;
+            //! The clones of observers with the clones which must be attached to them, children before their parents.
+            QList<QPair<QPointer<Observer>,QList<QObject*> > >  attachments;
+            //! The buffer used to copy objects through their binary exports.
+            QByteArray                                          buffer;
+            bool                                                complete;
+        };
+    }
+}
+
+namespace {
+    //! Tracks the nesting of observer exports which run in an ExportTask, progress is reported for the subjects of the outermost observers.
+    struct ExportTaskScope {
+        ExportTaskScope() : depth(Qtilities::Core::ExportTask::beginObserverExport()) {}
+        ~ExportTaskScope() { Qtilities::Core::ExportTask::endObserverExport(); }
+
+        const int depth;
+    };
+
+    //! Copies the data of source to target by exporting source to buffer and importing target from it.
+    IExportable::ExportResultFlags qti_private_CopyThroughBinaryExport(const IExportable* source, IExportable* target, QByteArray* buffer) {
+        QBuffer write_buffer(buffer);
+        write_buffer.open(QIODevice::WriteOnly);
+        QDataStream write_stream(&write_buffer);
+        write_stream.setVersion(QDataStream::Qt_4_7);
+        IExportable::ExportResultFlags result = source->exportBinary(write_stream);
+        write_buffer.close();
+        if (result == IExportable::Failed)
+            return result;
+
+        QBuffer read_buffer(buffer);
+        read_buffer.open(QIODevice::ReadOnly);
+        QDataStream read_stream(&read_buffer);
+        read_stream.setVersion(QDataStream::Qt_4_7);
+        QList<QPointer<QObject> > import_list;
+        IExportable::ExportResultFlags import_result = target->importBinary(read_stream,import_list);
+        if (import_result == IExportable::Complete)
+            return result;
+        return import_result;
+    }
+
+    //! Removes obj from the category index and from the count of subjects with valid metadata.
+    void qti_private_RemoveFromCategoryIndex(Qtilities::Core::ObserverData* data, const QObject* obj, const Qtilities::Core::ObserverData::SubjectIndexEntry& entry) {
+        if (entry.category_index >= 0)
+            data->category_subjects[entry.category_index].remove(obj);
+        else
+            data->uncategorized_subjects.remove(obj);
+        if (entry.flags & Qtilities::Core::ObserverData::MetadataValid)
+            --data->metadata_valid_count;
+    }
+}
+
+Qtilities::Core::ObserverData::~ObserverData() {
+    // Subjects which were never accessed are simply not imported:
+    delete deferred_import;
+}
 
 void Qtilities::Core::ObserverData::setExportVersion(Qtilities::ExportVersion version) {
     IExportable::setExportVersion(version);
@@ -47,6 +198,517 @@ void Qtilities::Core::ObserverData::setExportVersion(Qtilities::ExportVersion ve
     // like the rest of the IExportable things (display hints, subject filters, children etc.)
 }
 
+void Qtilities::Core::ObserverData::appendSubject(QObject* obj, int subject_id) {
+    QTI_PERFORMANCE_COUNT("Observer: Subjects Attached");
+    const int position = subject_list.count();
+    subject_list.append(obj);
+    ++subjects_revision;
+    subject_index[obj] = SubjectIndexEntry(position,subject_id);
+    uncategorized_subjects.insert(obj);
+    if (subject_id != -1)
+        subject_id_index[subject_id] = obj;
+    if (subject_index_valid_count == position)
+        subject_index_valid_count = position + 1;
+    // Subjects are always appended, thus they are appended to the cached results they belong to as well:
+    QHash<QByteArray,QList<QObject*> >::iterator type_itr = subject_type_cache.begin();
+    while (type_itr != subject_type_cache.end()) {
+        if (obj->inherits(type_itr.key().constData()))
+            type_itr.value().append(obj);
+        ++type_itr;
+    }
+    invalidateTreeSize();
+    invalidateSubjectSnapshot();
+    invalidateTreeSnapshot();
+    recordSubjectChange(SubjectsInserted,position,position);
+}
+
+void Qtilities::Core::ObserverData::removeSubject(QObject* obj) {
+    QTI_PERFORMANCE_COUNT("Observer: Subjects Detached");
+    removeFromSubjectTypeCache(obj);
+    modified_subjects.remove(obj);
+    invalidateTreeSize();
+    ++subjects_revision;
+    QHash<const QObject*,SubjectIndexEntry>::iterator itr = subject_index.find(obj);
+    if (itr == subject_index.end()) {
+        subject_list.removeOne(obj);
+        invalidateSubjectSnapshot();
+        invalidateTreeSnapshot();
+        return;
+    }
+
+    // When the position of the subject is still valid we don't need to search for it:
+    int position = itr.value().position;
+    if (!(position < subject_index_valid_count && position < subject_list.count() && subject_list.at(position) == obj))
+        position = subject_list.indexOf(obj);
+    if (position != -1) {
+        subject_list.removeAt(position);
+        // All subjects after the removed subject moved one position forward:
+        if (position < subject_index_valid_count)
+            subject_index_valid_count = position;
+    }
+    if (itr.value().subject_id != -1)
+        subject_id_index.remove(itr.value().subject_id);
+    qti_private_RemoveFromCategoryIndex(this,obj,itr.value());
+    subject_index.erase(itr);
+    invalidateSubjectSnapshot();
+    invalidateTreeSnapshot();
+    recordSubjectChange(SubjectsRemoved,position,position);
+}
+
+void Qtilities::Core::ObserverData::removeSubjectFromIndex(const QObject* obj) {
+    QTI_PERFORMANCE_COUNT("Observer: Subjects Detached");
+    // The subject was already removed from subject_list:
+    removeFromSubjectTypeCache(obj);
+    modified_subjects.remove(obj);
+    invalidateTreeSize();
+    ++subjects_revision;
+    invalidateSubjectSnapshot();
+    invalidateTreeSnapshot();
+
+    QHash<const QObject*,SubjectIndexEntry>::iterator itr = subject_index.find(obj);
+    if (itr == subject_index.end())
+        return;
+
+    // The position is only known when it was still valid when subject_list removed the subject:
+    const int position = itr.value().position < subject_index_valid_count ? itr.value().position : -1;
+
+    // All subjects after the removed subject moved one position forward:
+    if (itr.value().position < subject_index_valid_count)
+        subject_index_valid_count = itr.value().position;
+    if (itr.value().subject_id != -1)
+        subject_id_index.remove(itr.value().subject_id);
+    qti_private_RemoveFromCategoryIndex(this,obj,itr.value());
+    subject_index.erase(itr);
+    recordSubjectChange(SubjectsRemoved,position,position);
+}
+
+void Qtilities::Core::ObserverData::removeSubjects(const QList<QObject*>& objects) {
+    if (objects.count() == 1)
+        removeSubject(objects.front());
+    if (objects.count() <= 1)
+        return;
+
+    QTI_PERFORMANCE_COUNT_N("Observer: Subjects Detached",objects.count());
+    // The type cache and the positions are rebuilt on demand, which is cheaper than updating them for every subject:
+    subject_type_cache.clear();
+    invalidateTreeSize();
+    ++subjects_revision;
+    for (int i = 0; i < objects.count(); ++i) {
+        QObject* obj = objects.at(i);
+        subject_list.removeOne(obj);
+        modified_subjects.remove(obj);
+        QHash<const QObject*,SubjectIndexEntry>::iterator itr = subject_index.find(obj);
+        if (itr == subject_index.end())
+            continue;
+        if (itr.value().subject_id != -1)
+            subject_id_index.remove(itr.value().subject_id);
+        qti_private_RemoveFromCategoryIndex(this,obj,itr.value());
+        subject_index.erase(itr);
+    }
+    subject_index_valid_count = 0;
+    invalidateSubjectSnapshot();
+    invalidateTreeSnapshot();
+    recordSubjectChange(SubjectsRemoved,-1,-1);
+}
+
+QList<QObject*> Qtilities::Core::ObserverData::subjectSnapshot() const {
+    QMutexLocker snapshot_locker(&subject_snapshot_mutex);
+    subject_snapshot_used = true;
+    if (!subject_snapshot_valid) {
+        // Only count() and at() are used, they don't change the list and can be called from any thread while the lock is held:
+        QReadLocker locker(&subject_lock);
+        QList<QObject*> snapshot;
+        const int count = subject_list.count();
+        snapshot.reserve(count);
+        for (int i = 0; i < count; ++i)
+            snapshot << subject_list.at(i);
+        subject_snapshot = snapshot;
+        subject_snapshot_valid = true;
+    }
+    return subject_snapshot;
+}
+
+void Qtilities::Core::ObserverData::freezeSubjectSnapshot() {
+    bool snapshot_used;
+    {
+        QMutexLocker snapshot_locker(&subject_snapshot_mutex);
+        snapshot_used = subject_snapshot_used;
+    }
+    if (snapshot_used)
+        subjectSnapshot();
+}
+
+void Qtilities::Core::ObserverData::invalidateSubjectSnapshot() {
+    if (process_cycle_active)
+        return;
+
+    QMutexLocker snapshot_locker(&subject_snapshot_mutex);
+    subject_snapshot_valid = false;
+    subject_snapshot.clear();
+}
+
+QList<QObject*> Qtilities::Core::ObserverData::subjectsInheriting(const QByteArray& class_name) {
+    QHash<QByteArray,QList<QObject*> >::const_iterator itr = subject_type_cache.constFind(class_name);
+    if (itr != subject_type_cache.constEnd())
+        return itr.value();
+
+    QList<QObject*> subjects;
+    const char* class_name_data = class_name.constData();
+    int count = subject_list.count();
+    for (int i = 0; i < count; ++i) {
+        QObject* obj = subject_list.at(i);
+        if (obj->inherits(class_name_data))
+            subjects << obj;
+    }
+
+    // Only a few class names are queried in practice, we guard against unbounded growth anyway:
+    if (subject_type_cache.count() >= 64)
+        subject_type_cache.clear();
+    subject_type_cache[class_name] = subjects;
+    return subjects;
+}
+
+void Qtilities::Core::ObserverData::removeFromSubjectTypeCache(const QObject* obj) {
+    // The object might be destroyed already, thus only its address is used:
+    QObject* address = const_cast<QObject*> (obj);
+    QHash<QByteArray,QList<QObject*> >::iterator itr = subject_type_cache.begin();
+    while (itr != subject_type_cache.end()) {
+        itr.value().removeOne(address);
+        ++itr;
+    }
+}
+
+int Qtilities::Core::ObserverData::treeSize() const {
+    completeDeferredImport();
+    if (tree_size >= 0)
+        return tree_size;
+
+    // Observers which are subjects contribute their own tree sizes, which are only recalculated when they are invalid as well:
+    int size = subject_list.count();
+    for (int i = 0; i < subject_list.count(); ++i) {
+        Observer* obs = qobject_cast<Observer*> (subject_list.at(i));
+        if (obs)
+            size += obs->observerData->treeSize();
+    }
+
+    tree_size = size;
+    return tree_size;
+}
+
+Qtilities::Core::ObserverSnapshot Qtilities::Core::ObserverData::treeSnapshot() const {
+    completeDeferredImport();
+    if (!tree_snapshot.isNull())
+        return tree_snapshot;
+
+    ObserverSnapshotData* data = new ObserverSnapshotData;
+    data->observer_id = observer_id;
+    const int count = subject_list.count();
+    data->tree_count = count;
+    data->subjects.resize(count);
+    if (observer) {
+        data->observer_name = observer->observerName();
+        for (int i = 0; i < count; ++i) {
+            QObject* obj = subject_list.at(i);
+            ObserverSnapshotData::Subject& subject = data->subjects[i];
+            subject.object = obj;
+            subject.name = observer->subjectNameInContext(obj);
+            QVariant category_variant = observer->getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
+            if (category_variant.isValid())
+                subject.category = category_variant.value<QtilitiesCategory>();
+            subject.ownership = observer->getMultiContextPropertyValue(obj,qti_prop_OWNERSHIP).toInt();
+
+            // Child observers which did not change return their cached snapshots:
+            Observer* child_obs = qobject_cast<Observer*> (obj);
+            if (child_obs) {
+                subject.child = child_obs->observerData->treeSnapshot();
+                data->tree_count += subject.child.treeCount();
+            }
+        }
+    }
+
+    tree_snapshot = ObserverSnapshot(data);
+    return tree_snapshot;
+}
+
+void Qtilities::Core::ObserverData::invalidateTreeSnapshot() {
+    // When our snapshot is already invalid, the snapshots of all observers above us are invalid as well:
+    if (tree_snapshot.isNull())
+        return;
+
+    tree_snapshot = ObserverSnapshot();
+    if (!observer)
+        return;
+
+    emit observer->treeChanged();
+    QList<Observer*> parents = Observer::parentReferences(observer);
+    for (int i = 0; i < parents.count(); ++i)
+        parents.at(i)->observerData->invalidateTreeSnapshot();
+}
+
+Qtilities::Core::ObserverData::PropertyRoute Qtilities::Core::ObserverData::propertyRoute(const QByteArray& property_name) const {
+    if (!property_routes_valid) {
+        property_routes.clear();
+        if (observer) {
+            QStringList reserved_properties = observer->reservedProperties();
+            for (int i = 0; i < reserved_properties.count(); ++i)
+                property_routes[reserved_properties.at(i).toLatin1()].flags |= PropertyReserved;
+            QStringList monitored_properties = observer->monitoredProperties();
+            for (int i = 0; i < monitored_properties.count(); ++i)
+                property_routes[monitored_properties.at(i).toLatin1()].flags |= PropertyMonitored;
+        }
+
+        for (int i = 0; i < subject_filters.count(); ++i) {
+            AbstractSubjectFilter* filter = subject_filters.at(i);
+            if (!filter)
+                continue;
+            QStringList filter_properties = filter->monitoredProperties();
+            for (int p = 0; p < filter_properties.count(); ++p) {
+                PropertyRoute& route = property_routes[filter_properties.at(p).toLatin1()];
+                if (!route.filters.contains(filter))
+                    route.filters << filter;
+            }
+        }
+
+        // The role properties shown by views:
+        const char* const data_properties[] = { qti_prop_DECORATION, qti_prop_FOREGROUND, qti_prop_BACKGROUND, qti_prop_TEXT_ALIGNMENT,
+                                                qti_prop_FONT, qti_prop_SIZE_HINT, qti_prop_TOOLTIP, qti_prop_STATUSTIP, qti_prop_WHATS_THIS,
+                                                qti_prop_STYLE, qti_prop_ACCESS_MODE };
+        for (unsigned int i = 0; i < sizeof(data_properties) / sizeof(data_properties[0]); ++i) {
+            QHash<QByteArray,PropertyRoute>::iterator itr = property_routes.find(QByteArray(data_properties[i]));
+            if (itr != property_routes.end())
+                itr.value().flags |= PropertyRefreshesData;
+        }
+        QHash<QByteArray,PropertyRoute>::iterator itr = property_routes.find(QByteArray(qti_prop_CATEGORY_MAP));
+        if (itr != property_routes.end())
+            itr.value().flags |= PropertyRefreshesLayout;
+
+        property_routes_valid = true;
+    }
+
+    return property_routes.value(property_name);
+}
+
+void Qtilities::Core::ObserverData::queuePropertyChangeEvent(QObject* obj, const QByteArray& property_name) {
+    QPair<const QObject*,QByteArray> key(obj,property_name);
+    if (queued_property_change_event_keys.contains(key))
+        return;
+
+    queued_property_change_event_keys.insert(key);
+    queued_property_change_events << qMakePair(QPointer<QObject>(obj),property_name);
+}
+
+void Qtilities::Core::ObserverData::invalidateTreeSize() {
+    // When our size is already invalid, the sizes of all observers above us are invalid as well:
+    if (tree_size == -1)
+        return;
+
+    tree_size = -1;
+    if (!observer)
+        return;
+
+    QList<Observer*> parents = Observer::parentReferences(observer);
+    for (int i = 0; i < parents.count(); ++i)
+        parents.at(i)->observerData->invalidateTreeSize();
+}
+
+void Qtilities::Core::ObserverData::recordSubjectChange(int change, int first, int last) {
+    if (pending_subjects_reset)
+        return;
+
+    if (first == -1 || pending_subject_changes.count() >= 1000) {
+        pending_subject_changes.clear();
+        pending_subjects_reset = true;
+        return;
+    }
+
+    // Merge with the previous change where possible:
+    if (!pending_subject_changes.isEmpty()) {
+        SubjectChangeRange& previous = pending_subject_changes.last();
+        if (previous.change == change) {
+            if (change == SubjectsInserted && previous.last + 1 == first) {
+                previous.last = last;
+                return;
+            } else if (change == SubjectsRemoved && previous.first == first) {
+                // The subjects following the previous range moved into its place:
+                previous.last += last - first + 1;
+                return;
+            } else if (change == SubjectsRemoved && last + 1 == previous.first) {
+                previous.first = first;
+                return;
+            }
+        }
+    }
+
+    pending_subject_changes << SubjectChangeRange(change,first,last);
+}
+
+void Qtilities::Core::ObserverData::recordSubjectDataChange(QObject* obj) {
+    if (!obj || pending_data_changed_all)
+        return;
+
+    if (pending_data_changed_subjects.count() >= 1000) {
+        pending_data_changed_subjects.clear();
+        pending_data_changed_all = true;
+        return;
+    }
+
+    if (!pending_data_changed_subjects.contains(obj))
+        pending_data_changed_subjects << obj;
+}
+
+void Qtilities::Core::ObserverData::clearSubjectChanges() {
+    pending_subject_changes.clear();
+    pending_subjects_reset = false;
+    pending_data_changed_subjects.clear();
+    pending_data_changed_all = false;
+}
+
+int Qtilities::Core::ObserverData::subjectPosition(const QObject* obj) const {
+    QHash<const QObject*,SubjectIndexEntry>::const_iterator itr = subject_index.constFind(obj);
+    if (itr == subject_index.constEnd())
+        return -1;
+    if (itr.value().position < subject_index_valid_count)
+        return itr.value().position;
+
+    // Update the positions which are not valid anymore:
+    const int count = subject_list.count();
+    for (int i = subject_index_valid_count; i < count; ++i)
+        subject_index[subject_list.at(i)].position = i;
+    subject_index_valid_count = count;
+    return subject_index.value(obj).position;
+}
+
+void Qtilities::Core::ObserverData::reserveSubjects(int size) {
+    subject_list.reserve(size);
+    subject_index.reserve(size);
+    subject_id_index.reserve(size);
+}
+
+bool Qtilities::Core::ObserverData::isSubjectMetadataProperty(const char* property_name) {
+    if (!property_name)
+        return false;
+
+    return (!qstrcmp(property_name,qti_prop_OWNERSHIP) ||
+            !qstrcmp(property_name,qti_prop_PARENT_ID) ||
+            !qstrcmp(property_name,qti_prop_CATEGORY_MAP) ||
+            !qstrcmp(property_name,qti_prop_ALIAS_MAP));
+}
+
+void Qtilities::Core::ObserverData::updateSubjectMetadata(const QObject* obj) {
+    if (!obj || !subject_index.contains(obj))
+        return;
+
+    updateSubjectMetadata(obj,qti_prop_OWNERSHIP);
+    updateSubjectMetadata(obj,qti_prop_PARENT_ID);
+    updateSubjectMetadata(obj,qti_prop_CATEGORY_MAP);
+    updateSubjectMetadata(obj,qti_prop_ALIAS_MAP);
+    SubjectIndexEntry& entry = subject_index[obj];
+    if (!(entry.flags & MetadataValid)) {
+        entry.flags |= MetadataValid;
+        ++metadata_valid_count;
+    }
+}
+
+void Qtilities::Core::ObserverData::updateSubjectMetadata(const QObject* obj, const char* property_name) {
+    if (!obj || !isSubjectMetadataProperty(property_name))
+        return;
+
+    QHash<const QObject*,SubjectIndexEntry>::iterator itr = subject_index.find(obj);
+    if (itr == subject_index.end())
+        return;
+    invalidateTreeSnapshot();
+
+    // Get the value of the property in this context, the same way Observer::getMultiContextPropertyValue() does it:
+    QVariant value;
+    QVariant prop = obj->property(property_name);
+    if (prop.isValid() && prop.canConvert<SharedProperty>())
+        value = prop.value<SharedProperty>().value();
+    else if (prop.isValid() && prop.canConvert<MultiContextProperty>())
+        value = prop.value<MultiContextProperty>().value(observer_id);
+
+    SubjectIndexEntry& entry = itr.value();
+    if (!qstrcmp(property_name,qti_prop_OWNERSHIP)) {
+        entry.ownership = value.toInt();
+    } else if (!qstrcmp(property_name,qti_prop_PARENT_ID)) {
+        entry.parent_id = value.isValid() ? value.toInt() : -1;
+    } else if (!qstrcmp(property_name,qti_prop_CATEGORY_MAP)) {
+        int category_index = -1;
+        if (value.isValid()) {
+            QtilitiesCategory category = value.value<QtilitiesCategory>();
+            category_index = subjectCategoryPosition(category);
+            if (category_index == -1) {
+                subject_categories.append(category);
+                category_subjects.append(QSet<const QObject*>());
+                category_index = subject_categories.count() - 1;
+                subject_category_positions[category.categoryID()] = category_index;
+            }
+        }
+
+        // Move the subject to its new category in the category index:
+        if (entry.category_index != category_index) {
+            if (entry.category_index >= 0)
+                category_subjects[entry.category_index].remove(obj);
+            else
+                uncategorized_subjects.remove(obj);
+            if (category_index >= 0)
+                category_subjects[category_index].insert(obj);
+            else
+                uncategorized_subjects.insert(obj);
+            entry.category_index = category_index;
+        }
+    } else if (!qstrcmp(property_name,qti_prop_ALIAS_MAP)) {
+        if (value.isValid()) {
+            entry.alias = value.toString();
+            entry.flags |= HasAlias;
+        } else {
+            entry.alias.clear();
+            entry.flags &= ~HasAlias;
+        }
+    }
+}
+
+int Qtilities::Core::ObserverData::subjectCategoryPosition(const QtilitiesCategory& category) const {
+    return subject_category_positions.value(category.categoryID(),-1);
+}
+
+QList<QObject*> Qtilities::Core::ObserverData::subjectsInCategory(const QtilitiesCategory& category) const {
+    if (category.isEmpty() && uncategorized_subjects.count() == subject_list.count())
+        return subject_list.toQList();
+
+    QList<QPair<int,QObject*> > positions;
+    const int category_position = subjectCategoryPosition(category);
+    if (category_position != -1) {
+        foreach (const QObject* obj, category_subjects.at(category_position))
+            positions << qMakePair(subjectPosition(obj),const_cast<QObject*> (obj));
+    }
+    if (category.isEmpty()) {
+        foreach (const QObject* obj, uncategorized_subjects)
+            positions << qMakePair(subjectPosition(obj),const_cast<QObject*> (obj));
+    }
+    qSort(positions);
+
+    QList<QObject*> subjects;
+    subjects.reserve(positions.count());
+    for (int i = 0; i < positions.count(); ++i)
+        subjects << positions.at(i).second;
+    return subjects;
+}
+
+int Qtilities::Core::ObserverData::definedCategoryAccessMode(const QtilitiesCategory& category) const {
+    if (!category_access_modes_valid) {
+        category_access_modes.clear();
+        // The first entry wins, as it did when the list was searched:
+        for (int i = 0; i < categories.count(); ++i) {
+            const int category_id = categories.at(i).categoryID();
+            if (!category_access_modes.contains(category_id))
+                category_access_modes[category_id] = categories.at(i).accessMode();
+        }
+        category_access_modes_valid = true;
+    }
+
+    return category_access_modes.value(category.categoryID(),-1);
+}
+
 void Qtilities::Core::ObserverData::setExportTask(ITask* task) {
     if (display_hints)
         display_hints->setExportTask(task);
@@ -87,6 +749,7 @@ Qtilities::Core::Interfaces::IExportable::ExportModeFlags Qtilities::Core::Obser
     IExportable::ExportModeFlags flags = 0;
     flags |= IExportable::Binary;
     flags |= IExportable::XML;
+    flags |= IExportable::Cbor;
     return flags;
 }
 
@@ -109,6 +772,15 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
         #endif
         return result;
     }
+    if (exportVersion() == Qtilities::Qtilities_1_5) {
+        IExportable::ExportResultFlags result = exportBinaryExt_1_5(stream,ExportData);
+        #ifdef QTILITIES_BENCHMARKING
+        time(&end);
+        double diff = difftime(end,start);
+        LOG_TASK_WARNING("Observer (" + observer->observerName() + ") took " + QString::number(diff) + " seconds to export (exportBinaryExt_1_5).",exportTask());
+        #endif
+        return result;
+    }
 
     return IExportable::Incomplete;
 }
@@ -132,6 +804,15 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
         #endif
         return result;
     }
+    if (exportVersion() == Qtilities::Qtilities_1_5) {
+        IExportable::ExportResultFlags result = importBinaryExt_1_5(stream,import_list);
+        #ifdef QTILITIES_BENCHMARKING
+        time(&end);
+        double diff = difftime(end,start);
+        LOG_TASK_WARNING("Observer (" + observer->observerName() + ") took " + QString::number(diff) + " seconds to import (importBinaryExt_1_5).",exportTask());
+        #endif
+        return result;
+    }
 
     return IExportable::Incomplete;
 }
@@ -146,7 +827,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2) {
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2 || exportVersion() == Qtilities::Qtilities_1_5) {
         IExportable::ExportResultFlags result = exportXmlExt_1_0(doc,object_node,ExportData);
         #ifdef QTILITIES_BENCHMARKING
         time(&end);
@@ -169,7 +850,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2) {
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2 || exportVersion() == Qtilities::Qtilities_1_5) {
         IExportable::ExportResultFlags result = importXmlExt_1_0(doc,object_node,import_list);
         #ifdef QTILITIES_BENCHMARKING
         time(&end);
@@ -189,6 +870,8 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt(QD
 
     if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2)
         return exportBinaryExt_1_0(stream,export_flags);
+    else if (exportVersion() == Qtilities::Qtilities_1_5)
+        return exportBinaryExt_1_5(stream,export_flags);
 
     return IExportable::Incomplete;
 }
@@ -198,16 +881,137 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlExt(QDomD
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2)
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2 || exportVersion() == Qtilities::Qtilities_1_5)
         return exportXmlExt_1_0(doc,object_node,export_flags);
 
     return IExportable::Incomplete;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlStream(QXmlStreamWriter* writer) const {
+    return exportXmlStreamExt(writer,ExportData);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    return importXmlStreamExt(reader,import_list);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlStreamExt(QXmlStreamWriter* writer, ExportItemFlags export_flags, const QDomElement* leading_elements) const {
+    if (!writer)
+        return IExportable::Failed;
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2 || exportVersion() == Qtilities::Qtilities_1_5) {
+        #ifdef QTILITIES_BENCHMARKING
+        time_t start,end;
+        time(&start);
+        #endif
+        IExportable::ExportResultFlags result = exportXmlStreamExt_1_0(writer,export_flags,leading_elements);
+        #ifdef QTILITIES_BENCHMARKING
+        time(&end);
+        double diff = difftime(end,start);
+        LOG_TASK_WARNING("Observer (" + observer->observerName() + ") took " + QString::number(diff) + " seconds to export (exportXmlStreamExt_1_0).",exportTask());
+        #endif
+        return result;
+    }
+
+    return IExportable::Incomplete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importXmlStreamExt(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list, QDomElement* other_elements) {
+    if (!reader || !reader->isStartElement())
+        return IExportable::Failed;
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported) {
+        reader->skipCurrentElement();
+        return version_check_result;
+    }
+
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2 || exportVersion() == Qtilities::Qtilities_1_5) {
+        #ifdef QTILITIES_BENCHMARKING
+        time_t start,end;
+        time(&start);
+        #endif
+        IExportable::ExportResultFlags result = importXmlStreamExt_1_0(reader,import_list,other_elements);
+        #ifdef QTILITIES_BENCHMARKING
+        time(&end);
+        double diff = difftime(end,start);
+        LOG_TASK_WARNING("Observer (" + observer->observerName() + ") took " + QString::number(diff) + " seconds to import (importXmlStreamExt_1_0).",exportTask());
+        #endif
+        return result;
+    }
+
+    reader->skipCurrentElement();
+    return IExportable::Incomplete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportCbor(CborStreamWriter* writer) const {
+    return exportCborExt(writer,ExportData);
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    if (!reader)
+        return IExportable::Failed;
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported) {
+        reader->next();
+        return version_check_result;
+    }
+
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2 || exportVersion() == Qtilities::Qtilities_1_5) {
+        #ifdef QTILITIES_BENCHMARKING
+        time_t start,end;
+        time(&start);
+        #endif
+        IExportable::ExportResultFlags result = importCbor_1_0(reader,import_list);
+        #ifdef QTILITIES_BENCHMARKING
+        time(&end);
+        double diff = difftime(end,start);
+        LOG_TASK_WARNING("Observer (" + observer->observerName() + ") took " + QString::number(diff) + " seconds to import (importCbor_1_0).",exportTask());
+        #endif
+        return result;
+    }
+
+    reader->next();
+    return IExportable::Incomplete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportCborExt(CborStreamWriter* writer, ExportItemFlags export_flags) const {
+    if (!writer)
+        return IExportable::Failed;
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2 || exportVersion() == Qtilities::Qtilities_1_5) {
+        #ifdef QTILITIES_BENCHMARKING
+        time_t start,end;
+        time(&start);
+        #endif
+        IExportable::ExportResultFlags result = exportCborExt_1_0(writer,export_flags);
+        #ifdef QTILITIES_BENCHMARKING
+        time(&end);
+        double diff = difftime(end,start);
+        LOG_TASK_WARNING("Observer (" + observer->observerName() + ") took " + QString::number(diff) + " seconds to export (exportCborExt_1_0).",exportTask());
+        #endif
+        return result;
+    }
+
+    return IExportable::Incomplete;
+}
+
 IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_0(QDataStream& stream, ExportItemFlags export_flags) const {
+    completeDeferredImport();
+    ExportTaskScope export_scope;
+
     stream << MARKER_OBS_DATA_SECTION;
-    // Export the flags used:
-    stream << (quint32) export_flags;
+    // Export the flags used, ExportParallel only affects how the export is done:
+    stream << (quint32) (export_flags & ~ExportParallel);
 
     // We define a succesfull operation as an export which is able to export all subjects.
     bool success = true;
@@ -345,16 +1149,25 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_
         qint32 iface_count = exportable_list.count();
         stream << iface_count;
 
+        // Independent subtrees are exported concurrently first, their buffers are written in order below:
+        QVector<ObserverDataExportWorker*> workers = exportIndependentSubtrees(exportable_list,export_flags,IExportable::Binary,&stream);
 
         // Now check all subjects for the IExportable interface.
         for (int i = 0; i < exportable_list.count(); ++i) {
-            QCoreApplication::processEvents();
+            IDLE_SCHEDULER->yieldToEventLoop();
+            if (ExportTask::isExportCancelled()) {
+                if (relational_table)
+                    delete relational_table;
+                qDeleteAll(workers);
+                return IExportable::Failed;
+            }
             IExportable* iface = exportable_list.at(i);
             QObject* obj = iface->objectBase();
             LOG_TASK_TRACE(QString("%1/%2: Exporting \"%3\"...").arg(i).arg(iface_count).arg(observer->subjectNameInContext(obj)),exportTask());
             if (!iface->instanceFactoryInfo().exportBinary(stream,exportVersion())) {
                 if (relational_table)
                     delete relational_table;
+                qDeleteAll(workers);
                 return IExportable::Failed;
             }
 
@@ -379,7 +1192,10 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_
             // Check if it is an observer:
             IExportable::ExportResultFlags result;
             Observer* obs = qobject_cast<Observer*> (iface->objectBase());
-            if (obs) {
+            if (workers.at(i)) {
+                stream.writeRawData(workers.at(i)->buffer.constData(),workers.at(i)->buffer.size());
+                result = workers.at(i)->result;
+            } else if (obs) {
                 ExportItemFlags child_obs_flags = export_flags;
                 child_obs_flags &= ~ExportRelationalData;
 
@@ -397,7 +1213,10 @@ IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_
             // Now export the needed properties about this subject:
             if (result == IExportable::Incomplete || result == IExportable::Failed)
                 complete = false;
+            if (export_scope.depth == 1)
+                ExportTask::reportSubtreeExported(observer->subjectNameInContext(obj));
         }
+        qDeleteAll(workers);
 
         stream << MARKER_OBS_DATA_SECTION;
     }
@@ -487,6 +1306,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
             QtilitiesCategory category(stream,exportVersion());
             categories.push_back(category);
         }
+        invalidateCategoryAccessModes();
 
         stream >> deliver_qtilities_property_changed_events;
 
@@ -554,7 +1374,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
 
         // Now check all subjects for the IExportable interface.
         for (int i = 0; i < iface_count; ++i) {
-            QCoreApplication::processEvents();
+            IDLE_SCHEDULER->yieldToEventLoop();
             if (!success)
                 break;
 
@@ -667,49 +1487,78 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     }
 }
 
-Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlExt_1_0(QDomDocument* doc, QDomElement* object_node, ExportItemFlags export_flags) const {
-    object_node->setAttribute("ExportFlags",QString::number(export_flags));
+IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryExt_1_5(QDataStream& stream, ExportItemFlags export_flags) const {
+    stream << MARKER_OBS_DATA_SECTION;
 
-    IExportable::ExportResultFlags result = IExportable::Complete;
-    bool complete = true;
+    // The top level observer in the stream writes the string table of its tree in front of its data. Child observers
+    // use the table of their parent, except when they are exported in their own thread using ExportParallel:
+    CompactBinaryFormat::WriteScope scope(stream);
+    IExportable::ExportResultFlags result = exportBinaryCompact_1_5(scope.stream(),export_flags);
+    scope.finish();
 
-    ObserverRelationalTable* relational_table = 0;
-    if (export_flags & ExportRelationalData) {
-        QDomElement relational_data = doc->createElement("RelationalData");
-        object_node->appendChild(relational_data);
-        // Export relational data about the observer:
-        relational_table = new ObserverRelationalTable(observer,true);
-        relational_table->setExportVersion(exportVersion());
-        relational_table->setExportTask(exportTask());
-        if (relational_table->exportXml(doc,&relational_data) != IExportable::Complete) {
-            if (relational_table)
-                delete relational_table;
-            return IExportable::Failed;
-        }
-        relational_table->clearExportTask();
-    }
+    stream << MARKER_OBS_DATA_SECTION;
+    return result;
+}
 
-    if (export_flags & ExportData) {
-        // 1. The data of this item is added to a new data node:
-        QDomElement subject_data = doc->createElement("Data");
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importBinaryExt_1_5(QDataStream& stream, QList<QPointer<QObject> >& import_list) {
+    quint32 ui32;
+    stream >> ui32;
+    if (ui32 != MARKER_OBS_DATA_SECTION) {
+        LOG_TASK_ERROR("Observer binary import failed to detect marker at start of import. Import will fail at " + QString(Q_FUNC_INFO),exportTask());
+        return IExportable::Failed;
+    }
+
+    IExportable::ExportResultFlags result;
+    {
+        CompactBinaryFormat::ReadScope scope(stream);
+        if (!scope.isValid()) {
+            LOG_TASK_ERROR("Observer binary import failed to read the string table of the observer. Import will fail at " + QString(Q_FUNC_INFO),exportTask());
+            return IExportable::Failed;
+        }
+        result = importBinaryCompact_1_5(stream,import_list);
+    }
+    if (result == IExportable::Failed)
+        return result;
+
+    stream >> ui32;
+    if (ui32 != MARKER_OBS_DATA_SECTION) {
+        LOG_TASK_ERROR("Observer binary import failed to detect end marker. Import will fail at " + QString(Q_FUNC_INFO),exportTask());
+        return IExportable::Failed;
+    }
+    return result;
+}
+
+IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportBinaryCompact_1_5(QDataStream& stream, ExportItemFlags export_flags) const {
+    completeDeferredImport();
+    ExportTaskScope export_scope;
+
+    // Export the flags used, ExportParallel only affects how the export is done:
+    CompactBinaryFormat::writeVarUInt(stream,(quint32) (export_flags & ~ExportParallel));
+
+    bool complete = true;
+
+    ObserverRelationalTable* relational_table = 0;
+    if (export_flags & ExportRelationalData) {
+        // Export relational data about the observer:
+        relational_table = new ObserverRelationalTable(observer,true);
+        relational_table->setExportVersion(exportVersion());
+        relational_table->setExportTask(exportTask());
+        if (relational_table->exportBinary(stream) != IExportable::Complete) {
+            delete relational_table;
+            return IExportable::Failed;
+        }
+        relational_table->clearExportTask();
+    }
 
-        // Observer data:
-        QDomElement observer_data = doc->createElement("ObserverData");
-        // Add parameters as attributes:
-        if (subject_limit != -1)
-            observer_data.setAttribute("SubjectLimit",subject_limit);
-        if (!observer_description.isEmpty())
-            observer_data.setAttribute("Description",observer_description);
-        if (access_mode != Observer::FullAccess)
-            observer_data.setAttribute("AccessMode",Observer::accessModeToString((Observer::AccessMode) access_mode));        
-        if (access_mode != Observer::GlobalScope)
-            observer_data.setAttribute("AccessModeScope",Observer::accessModeScopeToString((Observer::AccessModeScope) access_mode_scope));
-        if (object_deletion_policy != Observer::DeleteImmediately)
-            observer_data.setAttribute("ObjectDeletionPolicy",Observer::objectDeletionPolicyToString((Observer::ObjectDeletionPolicy) object_deletion_policy));
-
-        // Check there are any attributes under observer data:
-        if (observer_data.attributes().count() > 0 || observer_data.childNodes().count() > 0)
-            subject_data.appendChild(observer_data);
+    if (export_flags & ExportData) {
+        // -----------------------------------
+        // Observer Data
+        // -----------------------------------
+        CompactBinaryFormat::writeVarInt(stream,subject_limit);
+        CompactBinaryFormat::writeString(stream,observer_description);
+        CompactBinaryFormat::writeVarUInt(stream,(quint32) access_mode);
+        CompactBinaryFormat::writeVarUInt(stream,(quint32) access_mode_scope);
+        CompactBinaryFormat::writeVarUInt(stream,(quint32) object_deletion_policy);
 
         // Visitor ID (only when needed)
         if (export_flags & ExportVisitorIDs) {
@@ -723,77 +1572,64 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
                     }
                 }
             }
-            object_node->setAttribute("VisitorID",visitor_id);
+            CompactBinaryFormat::writeVarInt(stream,visitor_id);
         }
 
-        // Categories:
-        if (categories.count() > 0) {
-            QDomElement categories_node = doc->createElement("Categories");
-            object_node->appendChild(categories_node);
-            for (int i = 0; i < categories.count(); ++i) {
-                QDomElement category = doc->createElement("Category");
-                categories_node.appendChild(category);
-                categories.at(i).exportXml(doc,&category);
-            }
+        // Stream categories
+        CompactBinaryFormat::writeVarUInt(stream,categories.count());
+        for (int i = 0; i < categories.count(); ++i) {
+            categories.at(i).exportBinary(stream);
         }
 
-        // Observer hints:
-        if (display_hints) {
-            if (display_hints->isExportable()) {
-                QDomElement hints_data = doc->createElement("ObserverHints");
-                display_hints->setExportVersion(exportVersion());
-                display_hints->setExportTask(exportTask());
-                if (display_hints->exportXml(doc,&hints_data) == IExportable::Failed) {
-                    if (relational_table)
-                        delete relational_table;
-                    display_hints->clearExportTask();
-                    return IExportable::Failed;
-                }
+        stream << deliver_qtilities_property_changed_events;
+
+        if (display_hints && display_hints->isExportable()) {
+            // Indicates that this observer has hints.
+            stream << (bool) true;
+            display_hints->setExportTask(exportTask());
+            if (display_hints->exportBinary(stream) != IExportable::Complete) {
+                if (relational_table)
+                    delete relational_table;
                 display_hints->clearExportTask();
-                if (hints_data.attributes().count() > 0 || hints_data.childNodes().count() > 0)
-                    subject_data.appendChild(hints_data);
+                return IExportable::Failed;
             }
+            display_hints->clearExportTask();
+        } else {
+            stream << (bool) false;
+        }
+
+        // -----------------------------------
+        // Subject Filters
+        // -----------------------------------
+        int exportable_filters_count = 0;
+        for (int i = 0; i < subject_filters.count(); ++i) {
+            if (subject_filters.at(i)->isExportable())
+                ++exportable_filters_count;
         }
 
-        // Subject filters:
+        CompactBinaryFormat::writeVarUInt(stream,exportable_filters_count);
         for (int i = 0; i < subject_filters.count(); ++i) {
             if (subject_filters.at(i)->isExportable()) {
-                QDomElement subject_filter = doc->createElement("SubjectFilter");
-                subject_data.appendChild(subject_filter);
-                if (!subject_filters.at(i)->instanceFactoryInfo().exportXml(doc,&subject_filter,exportVersion())) {
-                    if (relational_table)
-                        delete relational_table;
-                    return IExportable::Failed;
-                }
                 subject_filters.at(i)->setExportVersion(exportVersion());
                 subject_filters.at(i)->setExportTask(exportTask());
-                if (subject_filters.at(i)->exportXml(doc,&subject_filter) == IExportable::Failed) {
+                if (!subject_filters.at(i)->instanceFactoryInfo().exportBinary(stream,exportVersion()) || subject_filters.at(i)->exportBinary(stream) != IExportable::Complete) {
                     if (relational_table)
                         delete relational_table;
                     subject_filters.at(i)->clearExportTask();
                     return IExportable::Failed;
                 }
                 subject_filters.at(i)->clearExportTask();
+                LOG_TASK_TRACE(QString("%1/%2: Exporting subject filter \"%3\"...").arg(i+1).arg(subject_filters.count()).arg(subject_filters.at(i)->filterName()),exportTask());
             }
         }
 
-        // Formatting:
-        IExportableFormatting* formatting_iface = qobject_cast<IExportableFormatting*> (objectBase());
-        if (formatting_iface) {
-            if (formatting_iface->exportFormattingXML(doc,&subject_data,exportVersion()) == IExportable::Failed) {
-                if (relational_table)
-                    delete relational_table;
-                return IExportable::Failed;
-            }
-        }
-
-        if (subject_data.attributes().count() > 0 || subject_data.childNodes().count() > 0)
-            object_node->appendChild(subject_data);
-
+        // -----------------------------------
         // Make List Of Exportable Subjects
+        // -----------------------------------
         QList<IExportable*> exportable_list;
+        bool list_complete = true;
         if (export_flags & ExportVisitorIDs)
-            exportable_list = getLimitedExportsList(subject_list.toQList(),IExportable::XML,&complete);
+            exportable_list = getLimitedExportsList(subject_list.toQList(),IExportable::Binary,&list_complete);
         else {
             for (int l = 0; l < subject_list.count(); l++) {
                 IExportable* iface = qobject_cast<IExportable*> (subject_list.at(l));
@@ -801,455 +1637,1862 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
                     exportable_list << iface;
             }
 
-            if (exportable_list.count() < subject_list.count()) {
+            if (exportable_list.count() < subject_list.count())
+                list_complete = false;
+
+            if (!list_complete) {
                 LOG_TASK_TRACE(QString("%1 exportable subjects found under this observer's level of hierarchy. This list is incomplete.").arg(exportable_list.count()),exportTask());
                 complete = false;
             } else {
-                LOG_TASK_TRACE(QString("%1 exportable subjects found under this observer's level of hierarchy. This list is complete.").arg(exportable_list.count()),exportTask());
+                LOG_TASK_TRACE(QString("%1 exportable subjects found under this observer's level of hierarchy. This list is complete").arg(exportable_list.count()),exportTask());
             }
         }
 
-        // Export exportable subjects:
-        QDomElement subject_children = doc->createElement("Children");
-        if (exportable_list.count() > 0)
-            object_node->appendChild(subject_children);
+        // -----------------------------------
+        // Export List Of Exportable Subjects
+        // -----------------------------------
+        int iface_count = exportable_list.count();
+        CompactBinaryFormat::writeVarUInt(stream,iface_count);
+
+        // Independent subtrees are exported concurrently first, their buffers are written in order below:
+        QVector<ObserverDataExportWorker*> workers = exportIndependentSubtrees(exportable_list,export_flags,IExportable::Binary,&stream);
+
         for (int i = 0; i < exportable_list.count(); ++i) {
-            Observer* obs = qobject_cast<Observer*> (exportable_list.at(i)->objectBase());
-            IExportable* export_iface = exportable_list.at(i);
-            if (export_iface) {
-                if (export_iface->supportedFormats() & IExportable::XML) {
-                    // Create a data item with its factory data as attributes for i:
-                    // The item and its factory data:
-                    QDomElement subject_item = doc->createElement("TreeItem");
-                    subject_children.appendChild(subject_item);
-                    // We also append the following information:
-                    // 1. Category:
-                    if (ObjectManager::propertyExists(export_iface->objectBase(),qti_prop_CATEGORY_MAP)) {
-                        QVariant category_variant = observer->getMultiContextPropertyValue(export_iface->objectBase(),qti_prop_CATEGORY_MAP);
-                        if (category_variant.isValid()) {
-                            QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
-                            QDomElement category_item = doc->createElement("Category");
-                            subject_item.appendChild(category_item);
-                            category.setExportVersion(exportVersion());
-                            category.setExportTask(exportTask());
-                            category.exportXml(doc,&category_item);
-                            category.clearExportTask();
-                        }
-                    }
-                    // 2. Is Active:
-                    if (ObjectManager::propertyExists(export_iface->objectBase(),qti_prop_ACTIVITY_MAP)) {
-                        bool activity = observer->getMultiContextPropertyValue(export_iface->objectBase(),qti_prop_ACTIVITY_MAP).toBool();
-                        if (activity)
-                            subject_item.setAttribute("Activity","Active");
-                        else
-                            subject_item.setAttribute("Activity","Inactive");
-                    }
-                    // 3. Ownership:
-                    Observer::ObjectOwnership ownership = observer->subjectOwnershipInContext(export_iface->objectBase());
-                    if (ownership != Observer::ObserverScopeOwnership)
-                        subject_item.setAttribute("Ownership",Observer::objectOwnershipToString(ownership));
+            IDLE_SCHEDULER->yieldToEventLoop();
+            if (ExportTask::isExportCancelled()) {
+                if (relational_table)
+                    delete relational_table;
+                qDeleteAll(workers);
+                return IExportable::Failed;
+            }
+            IExportable* iface = exportable_list.at(i);
+            QObject* obj = iface->objectBase();
+            LOG_TASK_TRACE(QString("%1/%2: Exporting \"%3\"...").arg(i).arg(iface_count).arg(observer->subjectNameInContext(obj)),exportTask());
+            if (!iface->instanceFactoryInfo().exportBinary(stream,exportVersion())) {
+                if (relational_table)
+                    delete relational_table;
+                qDeleteAll(workers);
+                return IExportable::Failed;
+            }
 
-                    // 4. Factory Data:
-                    if (!export_iface->instanceFactoryInfo().exportXml(doc,&subject_item,exportVersion())) {
-                        if (relational_table)
-                            delete relational_table;
-                        return IExportable::Failed;
-                    }
+            iface->setExportVersion(exportVersion());
+            iface->setApplicationExportVersion(applicationExportVersion());
 
-                    // 5. Visitor ID (only when needed)
-                    if (export_flags & ExportVisitorIDs) {
-                        int visitor_id = -1;
-                        if (ObjectManager::propertyExists(export_iface->objectBase(),qti_prop_VISITOR_ID)) {
-                            QVariant prop_variant = export_iface->objectBase()->property(qti_prop_VISITOR_ID);
-                            if (prop_variant.isValid() && prop_variant.canConvert<SharedProperty>()) {
-                                SharedProperty prop = prop_variant.value<SharedProperty>();
-                                if (prop.isValid()) {
-                                     visitor_id = prop.value().toInt();
-                                }
-                            }
+            // Visitor ID (only when needed)
+            if (export_flags & ExportVisitorIDs) {
+                int visitor_id = -1;
+                if (ObjectManager::propertyExists(iface->objectBase(),qti_prop_VISITOR_ID)) {
+                    QVariant prop_variant = iface->objectBase()->property(qti_prop_VISITOR_ID);
+                    if (prop_variant.isValid() && prop_variant.canConvert<SharedProperty>()) {
+                        SharedProperty prop = prop_variant.value<SharedProperty>();
+                        if (prop.isValid()) {
+                             visitor_id = prop.value().toInt();
                         }
-                        subject_item.setAttribute("VisitorID",visitor_id);
                     }
+                }
+                CompactBinaryFormat::writeVarInt(stream,visitor_id);
+            }
 
-                    // Now we let the export iface export whatever it need to export:
-                    export_iface->setExportVersion(exportVersion());
-                    export_iface->setApplicationExportVersion(applicationExportVersion());
-
-                    IExportable::ExportResultFlags intermediate_result;
-                    if (obs) {
-                        ExportItemFlags child_obs_flags = export_flags;
-                        child_obs_flags &= ~ExportRelationalData;
-                        IExportableObserver* export_iface_obs = qobject_cast<IExportableObserver*> (obs->objectBase());
-                        Q_ASSERT(export_iface_obs);
+            // The data of the subject is written in a section, thus readers can skip subjects they cannot construct:
+            qint64 section_position = CompactBinaryFormat::beginSection(stream);
+            IExportable::ExportResultFlags result;
+            Observer* obs = qobject_cast<Observer*> (iface->objectBase());
+            if (workers.at(i)) {
+                stream.writeRawData(workers.at(i)->buffer.constData(),workers.at(i)->buffer.size());
+                result = workers.at(i)->result;
+            } else if (obs) {
+                ExportItemFlags child_obs_flags = export_flags;
+                child_obs_flags &= ~ExportRelationalData;
 
-                        // Must create new IObserverExportable interface to handle this situation.
-                        obs->setExportTask(exportTask());
-                        intermediate_result = export_iface_obs->exportXmlExt(doc,&subject_item,child_obs_flags);
-                    } else {
-                        export_iface->setExportTask(exportTask());
-                        intermediate_result = export_iface->exportXml(doc,&subject_item);
-                    }
+                IExportableObserver* export_iface_obs = qobject_cast<IExportableObserver*> (obs->objectBase());
+                Q_ASSERT(export_iface_obs);
+                obs->setExportTask(exportTask());
+                result = export_iface_obs->exportBinaryExt(stream,child_obs_flags);
+            } else {
+                iface->setExportTask(exportTask());
+                result = iface->exportBinary(stream);
+            }
+            CompactBinaryFormat::endSection(stream,section_position);
 
-                    export_iface->clearExportTask();
+            iface->clearExportTask();
 
-                    if (intermediate_result == IExportable::Failed || intermediate_result == IExportable::VersionTooOld || intermediate_result == IExportable::VersionTooNew) {
-                        if (relational_table)
-                            delete relational_table;
-                        LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") failed.",exportTask());
-                        return intermediate_result;
-                    } else if (intermediate_result == IExportable::Incomplete) {
-                        result = IExportable::Incomplete;
-                        LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") is incomplete.",exportTask());
-                    } else if (intermediate_result == IExportable::Complete) {
-                        LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") is complete.",exportTask());
-                    }
-                } else {
-                    LOG_TASK_WARNING("XML export found an interface (" + observer->subjectNameInContext(export_iface->objectBase()) + " in context " + observer->observerName() + ") which does not support XML exporting. XML export will be incomplete.",exportTask());
-                    result = IExportable::Incomplete;
-                }
-            }
+            if (result == IExportable::Incomplete || result == IExportable::Failed)
+                complete = false;
+            if (export_scope.depth == 1)
+                ExportTask::reportSubtreeExported(observer->subjectNameInContext(obj));
         }
+        qDeleteAll(workers);
     }
 
     if (relational_table)
         delete relational_table;
 
-    if (result == IExportable::Failed || result == IExportable::VersionTooOld || result == IExportable::VersionTooNew) {
-        LOG_TASK_WARNING("Xml export of observer " + observer->observerName() + " failed.",exportTask());
-        return result;
+    if (complete) {
+        LOG_TASK_DEBUG("Binary export of observer " + observer->observerName() + " was successful (complete).",exportTask());
+        return IExportable::Complete;
     } else {
-        if (result == IExportable::Incomplete || !complete) {
-            LOG_TASK_DEBUG("Xml export of observer " + observer->observerName() + " was successful (incomplete).",exportTask());
-            return IExportable::Incomplete;
-        } else {
-            LOG_TASK_DEBUG("Xml export of observer " + observer->observerName() + " was successful (complete).",exportTask());
-            return IExportable::Complete;
-        }
+        LOG_TASK_DEBUG("Binary export of observer " + observer->observerName() + " was successful (incomplete).",exportTask());
+        return IExportable::Incomplete;
     }
 }
 
-Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importXmlExt_1_0(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list) {
-    QList<QPointer<QObject> > active_subjects;
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importBinaryCompact_1_5(QDataStream& stream, QList<QPointer<QObject> >& import_list) {
+    // Only applies to this import, it is set again by the parent of the observer when needed:
+    const bool defer_subjects = defer_subject_import;
+    defer_subject_import = false;
+
+    quint32 ui32 = CompactBinaryFormat::readVarUInt(stream);
+    ExportModeFlags export_flags = (ExportModeFlags) ui32;
+    if (stream.status() != QDataStream::Ok) {
+        LOG_TASK_ERROR("Observer binary import failed to read the export flags of the observer. Import will fail at " + QString(Q_FUNC_INFO),exportTask());
+        return IExportable::Failed;
+    }
+
     observer->startProcessingCycle();
-    IExportable::ExportResultFlags result = IExportable::Complete;
 
-    ObserverRelationalTable* readback_table = 0;
+    // We define a succesfull operation as an import which is able to import all subjects.
+    bool success = true;
+    bool complete = true;
 
     // Create a custom internal import list which will only store this observer and all its children:
     QList<QPointer<QObject> > internal_import_list;
 
-    ExportItemFlags export_flags = ExportData;
-    if (object_node->hasAttribute("ExportFlags"))
-        export_flags = (ExportItemFlags) object_node->attribute("ExportFlags").toInt();
+    // Check if relational data was exported:
+    ObserverRelationalTable readback_table;
+    if (export_flags & ExportRelationalData) {
+        // First stream the relational table
+        readback_table.setExportTask(exportTask());
+        if (readback_table.importBinary(stream,import_list) == IExportable::Failed) {
+            readback_table.clearExportTask();
+            observer->endProcessingCycle();
+            return IExportable::Failed;
+        }
+        readback_table.clearExportTask();
+    }
+
+    if (export_flags & ExportData) {
+        // -----------------------------------
+        // Observer Data
+        // -----------------------------------
+        subject_limit = CompactBinaryFormat::readVarInt(stream);
+        observer_description = CompactBinaryFormat::readString(stream);
+        access_mode = CompactBinaryFormat::readVarUInt(stream);
+        access_mode_scope = CompactBinaryFormat::readVarUInt(stream);
+        object_deletion_policy = CompactBinaryFormat::readVarUInt(stream);
+
+        if (export_flags & ExportVisitorIDs) {
+            SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,(int) CompactBinaryFormat::readVarInt(stream));
+            ObjectManager::setSharedProperty(observer,visitor_id_prop);
+        }
+
+        // Stream categories
+        int category_count = CompactBinaryFormat::readVarUInt(stream);
+        for (int i = 0; i < category_count; ++i) {
+            QtilitiesCategory category(stream,exportVersion());
+            categories.push_back(category);
+        }
+        invalidateCategoryAccessModes();
+
+        stream >> deliver_qtilities_property_changed_events;
+
+        bool has_hints;
+        stream >> has_hints;
+        if (has_hints) {
+            if (!display_hints)
+                display_hints = new ObserverHints();
+            display_hints->setExportVersion(exportVersion());
+            display_hints->setExportTask(exportTask());
+            if (display_hints->importBinary(stream,import_list) == IExportable::Failed) {
+                display_hints->clearExportTask();
+                observer->endProcessingCycle();
+                return IExportable::Failed;
+            }
+            display_hints->clearExportTask();
+        }
+
+        if (stream.status() != QDataStream::Ok) {
+            LOG_TASK_ERROR("Observer binary import failed to read the data of the observer. Import will fail at " + QString(Q_FUNC_INFO),exportTask());
+            observer->endProcessingCycle();
+            return IExportable::Failed;
+        }
+
+        // -----------------------------------
+        // Subject Filters
+        // -----------------------------------
+        int subject_filter_count = CompactBinaryFormat::readVarUInt(stream);
+        for (int i = 0; i < subject_filter_count; ++i) {
+            // Get the factory data of the subject filter:
+            InstanceFactoryInfo instanceFactoryInfo;
+            if (!instanceFactoryInfo.importBinary(stream,exportVersion())) {
+                observer->endProcessingCycle();
+                return IExportable::Failed;
+            } else {
+                AbstractSubjectFilter* new_filter = qobject_cast<AbstractSubjectFilter*> (OBJECT_MANAGER->createInstance(instanceFactoryInfo));
+                if (new_filter) {
+                    new_filter->setExportVersion(exportVersion());
+                    new_filter->setObjectName(instanceFactoryInfo.d_instance_name);
+                    LOG_TASK_TRACE(QString("%1/%2: Importing subject filter \"%3\"...").arg(i+1).arg(subject_filter_count).arg(instanceFactoryInfo.d_instance_name),exportTask());
+                    new_filter->setExportTask(exportTask());
+                    new_filter->importBinary(stream,import_list);
+                    new_filter->clearExportTask();
+                    observer->installSubjectFilter(new_filter);
+                } else {
+                    LOG_TASK_ERROR(QString("%1/%2: Importing subject filter \"%3\" failed. Import cannot continue at %4").arg(i+1).arg(subject_filter_count).arg(instanceFactoryInfo.d_instance_name).arg(Q_FUNC_INFO),exportTask());
+                    observer->endProcessingCycle();
+                    return IExportable::Failed;
+                }
+            }
+        }
+
+        int iface_count = CompactBinaryFormat::readVarUInt(stream);
+        LOG_TASK_TRACE(QString("%1 exportable subject(s) found under this observer's level of hierarchy.").arg(iface_count),exportTask());
+
+        // When the data being read stays available, the subjects of child observers are only imported when they are accessed. Relational
+        // data can only be constructed once the whole tree exists, thus the import is never deferred when it was exported:
+        QByteArray source_data;
+        QSharedPointer<QObject> source_owner;
+        if (defer_subjects && iface_count > 0 && !(export_flags & ExportRelationalData) && stream.device() && !stream.device()->isSequential()
+                && CompactBinaryFormat::deferredImportSource(stream,&source_data,&source_owner)) {
+            if (!deferBinarySubjects_1_5(stream,iface_count,(quint32) export_flags,source_data,source_owner)) {
+                observer->endProcessingCycle();
+                return IExportable::Failed;
+            }
+        } else if (!importBinarySubjects_1_5(stream,iface_count,(quint32) export_flags,exportVersion(),applicationExportVersion(),import_list,internal_import_list,&success,&complete)) {
+            observer->endProcessingCycle();
+            return IExportable::Failed;
+        }
+    }
+
+    if (export_flags & ExportRelationalData) {
+        internal_import_list << observer;
+
+        // Construct relationships:
+        if (!constructRelationships(internal_import_list,&readback_table))
+            complete = false;
+
+        // Cross-check the constructed table:
+        ObserverRelationalTable constructed_table(observer,true);
+        if (!constructed_table.compare(readback_table)) {
+            LOG_TASK_WARNING(QString("Relational verification failed on observer: %1").arg(observer->observerName()),exportTask());
+            complete = false;
+        } else {
+            LOG_TASK_INFO(QString("Relational verification successful on observer: %1").arg(observer->observerName()),exportTask());
+        }
+
+        // Remove all relational properties used.
+        ObserverRelationalTable::removeRelationalProperties(observer);
+    }
+
+    observer->endProcessingCycle();
+
+    if (success) {
+        if (complete) {
+            LOG_TASK_DEBUG("Binary import of observer " + observer->observerName() + " section was Successful (complete).",exportTask());
+            return IExportable::Complete;
+        } else {
+            LOG_TASK_DEBUG("Binary import of observer " + observer->observerName() + " section was Successful (incomplete).",exportTask());
+            return IExportable::Incomplete;
+        }
+    } else {
+        LOG_TASK_WARNING("Binary import of observer " + observer->observerName() + " section failed.",exportTask());
+        return IExportable::Failed;
+    }
+}
+
+bool Qtilities::Core::ObserverData::importBinarySubjects_1_5(QDataStream& stream, int iface_count, quint32 export_flags, Qtilities::ExportVersion version, quint32 application_version,
+                                                           QList<QPointer<QObject> >& import_list, QList<QPointer<QObject> >& internal_import_list, bool* success, bool* complete) {
+    for (int i = 0; i < iface_count; ++i) {
+        IDLE_SCHEDULER->yieldToEventLoop();
+        if (!*success)
+            break;
+
+        InstanceFactoryInfo instanceFactoryInfo;
+        if (!instanceFactoryInfo.importBinary(stream,version))
+            return false;
+
+        int visitor_id = -1;
+        if (export_flags & ExportVisitorIDs)
+            visitor_id = CompactBinaryFormat::readVarInt(stream);
+        quint32 section_length = CompactBinaryFormat::readSectionLength(stream);
+        if (stream.status() != QDataStream::Ok) {
+            LOG_TASK_ERROR("Observer binary import failed to read the section of a subject. Import will fail at " + QString(Q_FUNC_INFO),exportTask());
+            return false;
+        }
+
+        // Subjects which cannot be constructed are skipped using their section length:
+        QObject* new_instance = 0;
+        if (instanceFactoryInfo.isValid()) {
+            LOG_TASK_TRACE(QString("%1/%2: Importing subject type \"%3\" in factory \"%4\"...").arg(i+1).arg(iface_count).arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
+
+            IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
+            if (ifactory) {
+                new_instance = ifactory->createInstance(instanceFactoryInfo);
+                if (!new_instance)
+                    LOG_TASK_WARNING(QString("Factory tag %1 does not exist in the factory %2. This item will be skipped and the import will be incomplete.").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
+            } else
+                LOG_TASK_WARNING(QString("Factory %1 does not exist. This item will be skipped and the import will be incomplete.").arg(instanceFactoryInfo.d_factory_tag),exportTask());
+        }
+
+        IExportable* export_iface = qobject_cast<IExportable*> (new_instance);
+        if (!export_iface) {
+            if (new_instance)
+                delete new_instance;
+            if (!CompactBinaryFormat::skipSection(stream,section_length)) {
+                LOG_TASK_ERROR("Observer binary import failed to skip the section of a subject. Import will fail at " + QString(Q_FUNC_INFO),exportTask());
+                return false;
+            }
+            *complete = false;
+            continue;
+        }
+
+        new_instance->setObjectName(instanceFactoryInfo.d_instance_name);
+        import_list.append(new_instance);
+        export_iface->setExportVersion(version);
+        export_iface->setApplicationExportVersion(application_version);
+        internal_import_list << export_iface->objectBase();
+
+        if (export_flags & ExportVisitorIDs) {
+            SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,visitor_id);
+            ObjectManager::setSharedProperty(export_iface->objectBase(),visitor_id_prop);
+        }
+
+        // Check if it is an observer: if so we must use internal_import_list, not import_list:
+        Observer* obs = qobject_cast<Observer*> (export_iface->objectBase());
+        IExportable::ExportResultFlags result;
+        if (obs) {
+            obs->observerData->defer_subject_import = true;
+            obs->setExportTask(exportTask());
+            result = obs->importBinary(stream,internal_import_list);
+        } else {
+            export_iface->setExportTask(exportTask());
+            result = export_iface->importBinary(stream,import_list);
+        }
+
+        export_iface->clearExportTask();
+
+        if (result == IExportable::Complete) {
+            *success = observer->attachSubject(new_instance,Observer::ObserverScopeOwnership,0,true);
+        } else if (result == IExportable::Incomplete) {
+            *success = observer->attachSubject(new_instance,Observer::ObserverScopeOwnership,0,true);
+            *complete = false;
+        } else if (result == IExportable::Failed) {
+            *success = false;
+        }
+    }
+
+    return true;
+}
+
+bool Qtilities::Core::ObserverData::deferBinarySubjects_1_5(QDataStream& stream, int iface_count, quint32 export_flags, const QByteArray& source_data, QSharedPointer<QObject> source_owner) {
+    ObserverDataDeferredImport* deferred = new ObserverDataDeferredImport;
+    deferred->data = source_data;
+    deferred->owner = source_owner;
+    deferred->offset = stream.device()->pos();
+    deferred->subject_count = iface_count;
+    deferred->export_flags = export_flags;
+    deferred->strings = CompactBinaryFormat::stringTableEntries(stream);
+    deferred->stream_version = stream.version();
+    deferred->byte_order = stream.byteOrder();
+    deferred->export_version = exportVersion();
+    deferred->application_export_version = applicationExportVersion();
+
+    // Only the headers of the subjects are read, their data is skipped using the section lengths:
+    for (int i = 0; i < iface_count; ++i) {
+        InstanceFactoryInfo instanceFactoryInfo;
+        if (!instanceFactoryInfo.importBinary(stream,exportVersion())) {
+            delete deferred;
+            return false;
+        }
+        if (export_flags & ExportVisitorIDs)
+            CompactBinaryFormat::readVarInt(stream);
+        quint32 section_length = CompactBinaryFormat::readSectionLength(stream);
+        if (stream.status() != QDataStream::Ok || !CompactBinaryFormat::skipSection(stream,section_length)) {
+            LOG_TASK_ERROR("Observer binary import failed to skip the section of a subject. Import will fail at " + QString(Q_FUNC_INFO),exportTask());
+            delete deferred;
+            return false;
+        }
+    }
+
+    LOG_TASK_TRACE(QString("The import of %1 subject(s) of observer \"%2\" was deferred until they are accessed.").arg(iface_count).arg(observer->observerName()),exportTask());
+    delete deferred_import;
+    deferred_import = deferred;
+    return true;
+}
+
+void Qtilities::Core::ObserverData::importDeferredSubjects() {
+    // Take the deferred import first, since the observer functions used below would otherwise try to complete it again:
+    ObserverDataDeferredImport* deferred = deferred_import;
+    deferred_import = 0;
+    if (!deferred)
+        return;
+
+    QBuffer buffer(&deferred->data);
+    if (!buffer.open(QIODevice::ReadOnly) || !buffer.seek(deferred->offset)) {
+        LOG_ERROR(QString("Failed to import the deferred subjects of observer \"%1\": The data of the subjects is not available anymore.").arg(observer->observerName()));
+        delete deferred;
+        return;
+    }
+
+    QDataStream stream(&buffer);
+    stream.setVersion(deferred->stream_version);
+    stream.setByteOrder(deferred->byte_order);
+    // Child observers defer the import of their own subjects again:
+    CompactBinaryFormat::setDeferredImportSource(stream,deferred->data,deferred->owner);
+
+    const bool was_modified = observer->isModified();
+    observer->startProcessingCycle();
+
+    bool success = true;
+    bool complete = true;
+    bool read_ok;
+    {
+        CompactBinaryFormat::ReadScope scope(stream,deferred->strings);
+        QList<QPointer<QObject> > import_list;
+        QList<QPointer<QObject> > internal_import_list;
+        read_ok = importBinarySubjects_1_5(stream,deferred->subject_count,deferred->export_flags,deferred->export_version,deferred->application_export_version,import_list,internal_import_list,&success,&complete);
+    }
+    CompactBinaryFormat::clearDeferredImportSource(stream);
+
+    if (!read_ok || !success)
+        LOG_ERROR(QString("Failed to import the deferred subjects of observer \"%1\".").arg(observer->observerName()));
+    else if (!complete)
+        LOG_WARNING(QString("The import of the deferred subjects of observer \"%1\" was incomplete.").arg(observer->observerName()));
+
+    // The subjects belonged to the observer since it was imported, thus their import is not reported as a change:
+    if (!was_modified)
+        observer->setModificationState(false,IModificationNotifier::NotifySubjects);
+    clearSubjectChanges();
+    proc_cycle_attached_subjects.clear();
+    number_of_subjects_start_of_proc_cycle = subject_list.count();
+    observer->endProcessingCycle(false);
+
+    delete deferred;
+}
+
+Qtilities::Core::Observer* Qtilities::Core::ObserverData::cloneTree(bool* complete) const {
+    ObserverDataCloneContext context;
+    Observer* clone = qobject_cast<Observer*> (cloneObject(observer,&context));
+    publishClones(&context,0,QList<QObject*>(),clone);
+
+    if (complete)
+        *complete = clone && context.complete;
+    return clone;
+}
+
+QList<QPointer<QObject> > Qtilities::Core::ObserverData::cloneSubjects(Observer* target, const QList<QObject*>& subjects, bool* complete) const {
+    completeDeferredImport();
+
+    QList<QObject*> source_subjects;
+    if (subjects.isEmpty())
+        source_subjects = subject_list.toQList();
+    else {
+        QSet<const QObject*> added_subjects;
+        for (int i = 0; i < subjects.count(); ++i) {
+            if (containsSubject(subjects.at(i)) && !added_subjects.contains(subjects.at(i))) {
+                added_subjects.insert(subjects.at(i));
+                source_subjects << subjects.at(i);
+            }
+        }
+    }
+
+    ObserverDataCloneContext context;
+    // The contexts of this observer on the subjects move to the target:
+    context.observer_ids[observer_id] = target->observerID();
+
+    QList<QObject*> clones;
+    for (int i = 0; i < source_subjects.count(); ++i) {
+        QObject* clone = cloneObject(source_subjects.at(i),&context);
+        if (clone)
+            clones << clone;
+    }
+    QList<QPointer<QObject> > attached_clones = publishClones(&context,target,clones,0);
+
+    if (complete)
+        *complete = context.complete;
+    return attached_clones;
+}
+
+QObject* Qtilities::Core::ObserverData::cloneObject(QObject* obj, ObserverDataCloneContext* context) {
+    // Objects with more than one parent in the tree are cloned once:
+    QHash<const QObject*,QObject*>::const_iterator itr = context->clones.constFind(obj);
+    if (itr != context->clones.constEnd())
+        return itr.value();
+
+    IExportable* iface = qobject_cast<IExportable*> (obj);
+    if (!iface) {
+        LOG_WARNING(QString("Failed to clone \"%1\": The object does not implement IExportable. The object will be skipped.").arg(obj->objectName()));
+        context->complete = false;
+        return 0;
+    }
+
+    InstanceFactoryInfo instanceFactoryInfo = iface->instanceFactoryInfo();
+    QObject* clone = 0;
+    if (instanceFactoryInfo.isValid())
+        clone = OBJECT_MANAGER->createInstance(instanceFactoryInfo);
+
+    Observer* obs = qobject_cast<Observer*> (obj);
+    Observer* obs_clone = qobject_cast<Observer*> (clone);
+    IExportable* clone_iface = qobject_cast<IExportable*> (clone);
+    if (!clone_iface || (obs == 0) != (obs_clone == 0)) {
+        LOG_WARNING(QString("Failed to clone \"%1\": Factory \"%2\" can't construct an instance of type \"%3\". The object and the tree underneath it will be skipped.")
+                    .arg(obj->objectName()).arg(instanceFactoryInfo.d_factory_tag).arg(instanceFactoryInfo.d_instance_tag));
+        if (clone)
+            delete clone;
+        context->complete = false;
+        return 0;
+    }
+
+    clone->setObjectName(obj->objectName());
+    clone_iface->setExportVersion(iface->exportVersion());
+    clone_iface->setApplicationExportVersion(iface->applicationExportVersion());
+
+    if (obs) {
+        obs->observerData->completeDeferredImport();
+        obs_clone->observerData->copyObserverData(*obs->observerData,context);
+        obs_clone->initializeClone(obs);
+
+        context->clones[obj] = clone;
+        context->sources << obj;
+        context->observer_ids[obs->observerID()] = obs_clone->observerID();
+
+        const QList<QObject*> subjects = obs->observerData->subject_list.toQList();
+        QList<QObject*> subject_clones;
+        for (int i = 0; i < subjects.count(); ++i) {
+            QObject* subject_clone = cloneObject(subjects.at(i),context);
+            if (subject_clone)
+                subject_clones << subject_clone;
+        }
+        // The clones of child observers are complete by the time this observer gets its subjects:
+        context->attachments << qMakePair(QPointer<Observer>(obs_clone),subject_clones);
+    } else {
+        // Subjects keep the data which is not stored in their properties in their exports:
+        if (iface->supportedFormats() & IExportable::Binary) {
+            IExportable::ExportResultFlags result = qti_private_CopyThroughBinaryExport(iface,clone_iface,&context->buffer);
+            if (result == IExportable::Failed) {
+                LOG_WARNING(QString("Failed to clone \"%1\": The data of the object could not be copied. The object will be skipped.").arg(obj->objectName()));
+                delete clone;
+                context->complete = false;
+                return 0;
+            } else if (result == IExportable::Incomplete)
+                context->complete = false;
+        }
+
+        context->clones[obj] = clone;
+        context->sources << obj;
+    }
+
+    return clone;
+}
+
+void Qtilities::Core::ObserverData::copyObserverData(const ObserverData& source, ObserverDataCloneContext* context) {
+    subject_limit = source.subject_limit;
+    observer_description = source.observer_description;
+    access_mode = source.access_mode;
+    access_mode_scope = source.access_mode_scope;
+    object_deletion_policy = source.object_deletion_policy;
+    categories = source.categories;
+    invalidateCategoryAccessModes();
+    deliver_qtilities_property_changed_events = source.deliver_qtilities_property_changed_events;
+
+    if (source.display_hints) {
+        observer->useDisplayHints();
+        *display_hints = *source.display_hints;
+    }
+
+    // Subject filters keep their settings in their private data, thus they are copied through their exports. Like exports, only
+    // exportable filters are copied:
+    for (int i = 0; i < source.subject_filters.count(); ++i) {
+        AbstractSubjectFilter* filter = source.subject_filters.at(i);
+        if (!filter->isExportable())
+            continue;
+
+        AbstractSubjectFilter* new_filter = qobject_cast<AbstractSubjectFilter*> (OBJECT_MANAGER->createInstance(filter->instanceFactoryInfo()));
+        if (!new_filter) {
+            LOG_WARNING(QString("Failed to clone subject filter \"%1\" of observer \"%2\": The filter can't be constructed by its factory.").arg(filter->filterName()).arg(source.observer->observerName()));
+            context->complete = false;
+            continue;
+        }
+
+        new_filter->setObjectName(filter->objectName());
+        new_filter->setExportVersion(filter->exportVersion());
+        if (qti_private_CopyThroughBinaryExport(filter,new_filter,&context->buffer) != IExportable::Complete)
+            context->complete = false;
+        if (!observer->installSubjectFilter(new_filter)) {
+            delete new_filter;
+            context->complete = false;
+        }
+    }
+}
+
+void Qtilities::Core::ObserverData::cloneObjectProperties(const QObject* source, QObject* target, const ObserverDataCloneContext* context) {
+    const int multi_context_type = qMetaTypeId<MultiContextProperty>();
+    const QList<QByteArray> property_names = source->dynamicPropertyNames();
+    for (int i = 0; i < property_names.count(); ++i) {
+        const QByteArray& property_name = property_names.at(i);
+        // Properties which describe where the source is in its tree are added to the clone when it is attached:
+        if (property_name == qti_prop_OBSERVER_MAP || property_name == qti_prop_OWNERSHIP || property_name == qti_prop_PARENT_ID
+                || property_name == qti_prop_VISITOR_ID || property_name == qti_prop_TREE_ITERATOR_SOURCE_OBS)
+            continue;
+
+        const QVariant value = source->property(property_name.constData());
+        if (value.userType() == multi_context_type) {
+            MultiContextProperty property = value.value<MultiContextProperty>();
+            const QList<quint32> context_ids = property.contextIds();
+            QList<QPair<int,QVariant> > cloned_contexts;
+            for (int c = 0; c < context_ids.count(); ++c) {
+                QHash<int,int>::const_iterator itr = context->observer_ids.constFind(context_ids.at(c));
+                if (itr != context->observer_ids.constEnd())
+                    cloned_contexts << qMakePair(itr.value(),property.value(context_ids.at(c)));
+                property.removeContext(context_ids.at(c));
+            }
+            if (cloned_contexts.isEmpty())
+                continue;
+
+            for (int c = 0; c < cloned_contexts.count(); ++c)
+                property.addContext(cloned_contexts.at(c).second,cloned_contexts.at(c).first);
+            ObjectManager::setMultiContextProperty(target,property);
+        } else if (property_name == qti_prop_NAME_MANAGER_ID) {
+            // The name manager moves to its clone, like contexts do:
+            const int manager_id = ObjectManager::getSharedProperty(source,qti_prop_NAME_MANAGER_ID).value().toInt();
+            QHash<int,int>::const_iterator itr = context->observer_ids.constFind(manager_id);
+            if (itr != context->observer_ids.constEnd())
+                ObjectManager::setSharedProperty(target,qti_prop_NAME_MANAGER_ID,QVariant(itr.value()));
+        } else
+            target->setProperty(property_name.constData(),value);
+    }
+}
+
+QList<QPointer<QObject> > Qtilities::Core::ObserverData::publishClones(ObserverDataCloneContext* context, Observer* target, const QList<QObject*>& top_level_clones, QObject* root_clone) {
+    // All observers are cloned at this stage, thus the contexts of all properties can be moved:
+    for (int i = 0; i < context->sources.count(); ++i)
+        cloneObjectProperties(context->sources.at(i),context->clones.value(context->sources.at(i)),context);
+
+    // Nothing observes the clones of observers yet, thus they are filled using imports which skip the checks of their subject filters:
+    for (int i = 0; i < context->attachments.count(); ++i) {
+        Observer* obs_clone = context->attachments.at(i).first;
+        const QList<QObject*>& subject_clones = context->attachments.at(i).second;
+        if (!obs_clone || subject_clones.isEmpty())
+            continue;
+        if (obs_clone->attachSubjects(subject_clones,Observer::ObserverScopeOwnership,0,true).count() != subject_clones.count())
+            context->complete = false;
+    }
+
+    QList<QPointer<QObject> > attached_clones;
+    if (target && !top_level_clones.isEmpty()) {
+        QString errorMsg;
+        attached_clones = target->attachSubjects(top_level_clones,Observer::ObserverScopeOwnership,&errorMsg);
+        if (attached_clones.count() != top_level_clones.count()) {
+            LOG_WARNING(QString("Observer (%1): %2 of %3 clones could not be attached: %4").arg(target->observerName()).arg(top_level_clones.count() - attached_clones.count())
+                        .arg(top_level_clones.count()).arg(errorMsg));
+            context->complete = false;
+        }
+    }
+
+    // Clones which were not attached anywhere are deleted, clones underneath them might be deleted along with them:
+    QList<QPointer<QObject> > clones;
+    for (int i = 0; i < context->sources.count(); ++i)
+        clones << context->clones.value(context->sources.at(i));
+    for (int i = 0; i < clones.count(); ++i) {
+        QObject* clone = clones.at(i);
+        if (clone && clone != root_clone && Observer::parentCount(clone) == 0)
+            delete clone;
+    }
+
+    return attached_clones;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlExt_1_0(QDomDocument* doc, QDomElement* object_node, ExportItemFlags export_flags) const {
+    completeDeferredImport();
+    ExportTaskScope export_scope;
+
+    object_node->setAttribute("ExportFlags",QString::number(export_flags & ~ExportParallel));
+
+    IExportable::ExportResultFlags result = IExportable::Complete;
+    bool complete = true;
+
+    ObserverRelationalTable* relational_table = 0;
+    if (export_flags & ExportRelationalData) {
+        QDomElement relational_data = doc->createElement("RelationalData");
+        object_node->appendChild(relational_data);
+        // Export relational data about the observer:
+        relational_table = new ObserverRelationalTable(observer,true);
+        relational_table->setExportVersion(exportVersion());
+        relational_table->setExportTask(exportTask());
+        if (relational_table->exportXml(doc,&relational_data) != IExportable::Complete) {
+            if (relational_table)
+                delete relational_table;
+            return IExportable::Failed;
+        }
+        relational_table->clearExportTask();
+    }
+
+    if (export_flags & ExportData) {
+        // 1. The data of this item is added to a new data node:
+        QDomElement subject_data = doc->createElement("Data");
+        if (exportXmlData_1_0(doc,&subject_data) == IExportable::Failed) {
+            if (relational_table)
+                delete relational_table;
+            return IExportable::Failed;
+        }
+
+        // Visitor ID (only when needed)
+        if (export_flags & ExportVisitorIDs)
+            object_node->setAttribute("VisitorID",ObserverRelationalTable::getVisitorID(observer));
+
+        // Categories:
+        if (categories.count() > 0) {
+            QDomElement categories_node = doc->createElement("Categories");
+            object_node->appendChild(categories_node);
+            for (int i = 0; i < categories.count(); ++i) {
+                QDomElement category = doc->createElement("Category");
+                categories_node.appendChild(category);
+                categories.at(i).exportXml(doc,&category);
+            }
+        }
+
+        if (subject_data.attributes().count() > 0 || subject_data.childNodes().count() > 0)
+            object_node->appendChild(subject_data);
+
+        // Make List Of Exportable Subjects
+        QList<IExportable*> exportable_list = xmlExportableSubjects(export_flags,&complete);
+
+        // Independent subtrees are exported concurrently first, their elements are added in order below:
+        QVector<ObserverDataExportWorker*> workers = exportIndependentSubtrees(exportable_list,export_flags,IExportable::XML);
+
+        // Export exportable subjects:
+        QDomElement subject_children = doc->createElement("Children");
+        if (exportable_list.count() > 0)
+            object_node->appendChild(subject_children);
+        for (int i = 0; i < exportable_list.count(); ++i) {
+            if (ExportTask::isExportCancelled()) {
+                if (relational_table)
+                    delete relational_table;
+                qDeleteAll(workers);
+                return IExportable::Failed;
+            }
+            Observer* obs = qobject_cast<Observer*> (exportable_list.at(i)->objectBase());
+            IExportable* export_iface = exportable_list.at(i);
+            if (export_iface) {
+                if (export_iface->supportedFormats() & IExportable::XML) {
+                    // Create a data item with its factory data as attributes for i:
+                    QDomElement subject_item = doc->createElement("TreeItem");
+                    subject_children.appendChild(subject_item);
+                    if (!exportXmlSubjectItem_1_0(doc,&subject_item,export_iface,export_flags)) {
+                        if (relational_table)
+                            delete relational_table;
+                        qDeleteAll(workers);
+                        return IExportable::Failed;
+                    }
+
+                    // Now we let the export iface export whatever it need to export:
+                    export_iface->setExportVersion(exportVersion());
+                    export_iface->setApplicationExportVersion(applicationExportVersion());
+
+                    IExportable::ExportResultFlags intermediate_result;
+                    if (workers.at(i)) {
+                        const QDomElement& worker_node = workers.at(i)->object_node;
+                        QDomNamedNodeMap attributes = worker_node.attributes();
+                        for (int a = 0; a < attributes.count(); ++a) {
+                            QDomAttr attribute = attributes.item(a).toAttr();
+                            subject_item.setAttribute(attribute.name(),attribute.value());
+                        }
+                        for (QDomNode node = worker_node.firstChild(); !node.isNull(); node = node.nextSibling())
+                            subject_item.appendChild(doc->importNode(node,true));
+                        intermediate_result = workers.at(i)->result;
+                    } else if (obs) {
+                        ExportItemFlags child_obs_flags = export_flags;
+                        child_obs_flags &= ~ExportRelationalData;
+                        IExportableObserver* export_iface_obs = qobject_cast<IExportableObserver*> (obs->objectBase());
+                        Q_ASSERT(export_iface_obs);
+
+                        // Must create new IObserverExportable interface to handle this situation.
+                        obs->setExportTask(exportTask());
+                        intermediate_result = export_iface_obs->exportXmlExt(doc,&subject_item,child_obs_flags);
+                    } else {
+                        export_iface->setExportTask(exportTask());
+                        intermediate_result = export_iface->exportXml(doc,&subject_item);
+                    }
+
+                    export_iface->clearExportTask();
+
+                    if (intermediate_result == IExportable::Failed || intermediate_result == IExportable::VersionTooOld || intermediate_result == IExportable::VersionTooNew) {
+                        if (relational_table)
+                            delete relational_table;
+                        qDeleteAll(workers);
+                        LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") failed.",exportTask());
+                        return intermediate_result;
+                    } else if (intermediate_result == IExportable::Incomplete) {
+                        result = IExportable::Incomplete;
+                        LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") is incomplete.",exportTask());
+                    } else if (intermediate_result == IExportable::Complete) {
+                        LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") is complete.",exportTask());
+                    }
+                } else {
+                    LOG_TASK_WARNING("XML export found an interface (" + observer->subjectNameInContext(export_iface->objectBase()) + " in context " + observer->observerName() + ") which does not support XML exporting. XML export will be incomplete.",exportTask());
+                    result = IExportable::Incomplete;
+                }
+
+                if (export_scope.depth == 1)
+                    ExportTask::reportSubtreeExported(observer->subjectNameInContext(export_iface->objectBase()));
+            }
+        }
+        qDeleteAll(workers);
+    }
+
+    if (relational_table)
+        delete relational_table;
+
+    if (result == IExportable::Failed || result == IExportable::VersionTooOld || result == IExportable::VersionTooNew) {
+        LOG_TASK_WARNING("Xml export of observer " + observer->observerName() + " failed.",exportTask());
+        return result;
+    } else {
+        if (result == IExportable::Incomplete || !complete) {
+            LOG_TASK_DEBUG("Xml export of observer " + observer->observerName() + " was successful (incomplete).",exportTask());
+            return IExportable::Incomplete;
+        } else {
+            LOG_TASK_DEBUG("Xml export of observer " + observer->observerName() + " was successful (complete).",exportTask());
+            return IExportable::Complete;
+        }
+    }
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlStreamExt_1_0(QXmlStreamWriter* writer, ExportItemFlags export_flags, const QDomElement* leading_elements) const {
+    completeDeferredImport();
+    ExportTaskScope export_scope;
+
+    // The relational table assigns the visitor IDs written below, thus it must exist until all subjects were written, as in exportXmlExt_1_0():
+    ObserverRelationalTable* relational_table = 0;
+    if (export_flags & ExportRelationalData)
+        relational_table = new ObserverRelationalTable(observer,true);
+
+    // All attributes of our element must be written before any child elements. The child elements are written in the same order in which
+    // exportXmlExt_1_0() adds them, thus both produce the same document and both can be read by importXmlExt_1_0() and importXmlStreamExt_1_0().
+    writer->writeAttribute("ExportFlags",QString::number(export_flags & ~ExportParallel));
+    if ((export_flags & ExportData) && (export_flags & ExportVisitorIDs))
+        writer->writeAttribute("VisitorID",QString::number(ObserverRelationalTable::getVisitorID(observer)));
+
+    if (leading_elements)
+        IExportable::writeDomChildNodes(writer,*leading_elements);
+
+    IExportable::ExportResultFlags result = IExportable::Complete;
+    bool complete = true;
+
+    if (relational_table) {
+        // Export relational data about the observer:
+        relational_table->setExportVersion(exportVersion());
+        relational_table->setExportTask(exportTask());
+        writer->writeStartElement("RelationalData");
+        IExportable::ExportResultFlags relational_result = relational_table->exportXmlStream(writer);
+        writer->writeEndElement();
+        relational_table->clearExportTask();
+        if (relational_result != IExportable::Complete) {
+            delete relational_table;
+            return IExportable::Failed;
+        }
+    }
+
+    if (export_flags & ExportData) {
+        // The data element is small, thus we build it in a document before writing it:
+        QDomDocument data_doc;
+        QDomElement subject_data = data_doc.createElement("Data");
+        data_doc.appendChild(subject_data);
+        if (exportXmlData_1_0(&data_doc,&subject_data) == IExportable::Failed) {
+            if (relational_table)
+                delete relational_table;
+            return IExportable::Failed;
+        }
+
+        // Categories:
+        if (categories.count() > 0) {
+            writer->writeStartElement("Categories");
+            for (int i = 0; i < categories.count(); ++i) {
+                writer->writeStartElement("Category");
+                categories.at(i).exportXmlStream(writer);
+                writer->writeEndElement();
+            }
+            writer->writeEndElement();
+        }
+
+        if (subject_data.attributes().count() > 0 || subject_data.childNodes().count() > 0) {
+            writer->writeStartElement("Data");
+            IExportable::writeDomAttributes(writer,subject_data);
+            IExportable::writeDomChildNodes(writer,subject_data);
+            writer->writeEndElement();
+        }
+
+        // Make List Of Exportable Subjects
+        QList<IExportable*> exportable_list = xmlExportableSubjects(export_flags,&complete);
+
+        // Export exportable subjects:
+        if (exportable_list.count() > 0)
+            writer->writeStartElement("Children");
+        for (int i = 0; i < exportable_list.count(); ++i) {
+            if (ExportTask::isExportCancelled()) {
+                if (relational_table)
+                    delete relational_table;
+                return IExportable::Failed;
+            }
+            IExportable* export_iface = exportable_list.at(i);
+            if (!export_iface)
+                continue;
+
+            if (!(export_iface->supportedFormats() & IExportable::XML)) {
+                LOG_TASK_WARNING("XML export found an interface (" + observer->subjectNameInContext(export_iface->objectBase()) + " in context " + observer->observerName() + ") which does not support XML exporting. XML export will be incomplete.",exportTask());
+                result = IExportable::Incomplete;
+                continue;
+            }
+
+            // The information we store about the subject, and the subject itself when it is not an observer, is built in a document
+            // per subject. Thus only a single subject's element is kept in memory at any time:
+            QDomDocument item_doc;
+            QDomElement subject_item = item_doc.createElement("TreeItem");
+            item_doc.appendChild(subject_item);
+            if (!exportXmlSubjectItem_1_0(&item_doc,&subject_item,export_iface,export_flags)) {
+                if (relational_table)
+                    delete relational_table;
+                return IExportable::Failed;
+            }
+
+            export_iface->setExportVersion(exportVersion());
+            export_iface->setApplicationExportVersion(applicationExportVersion());
+            export_iface->setExportTask(exportTask());
+
+            IExportable::ExportResultFlags intermediate_result;
+            writer->writeStartElement("TreeItem");
+            Observer* obs = qobject_cast<Observer*> (export_iface->objectBase());
+            if (obs) {
+                ExportItemFlags child_obs_flags = export_flags;
+                child_obs_flags &= ~ExportRelationalData;
+                IExportableObserver* export_iface_obs = qobject_cast<IExportableObserver*> (obs->objectBase());
+                Q_ASSERT(export_iface_obs);
+
+                // Observers stream their subjects directly, the elements we added to subject_item must be written before them.
+                // The observer writes its visitor ID itself:
+                subject_item.removeAttribute("VisitorID");
+                IExportable::writeDomAttributes(writer,subject_item);
+                intermediate_result = export_iface_obs->exportXmlStreamExt(writer,child_obs_flags,&subject_item);
+            } else {
+                intermediate_result = export_iface->exportXml(&item_doc,&subject_item);
+                IExportable::writeDomAttributes(writer,subject_item);
+                IExportable::writeDomChildNodes(writer,subject_item);
+            }
+            writer->writeEndElement();
+
+            export_iface->clearExportTask();
+
+            if (intermediate_result == IExportable::Failed || intermediate_result == IExportable::VersionTooOld || intermediate_result == IExportable::VersionTooNew) {
+                if (relational_table)
+                    delete relational_table;
+                LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") failed.",exportTask());
+                return intermediate_result;
+            } else if (intermediate_result == IExportable::Incomplete) {
+                result = IExportable::Incomplete;
+                LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") is incomplete.",exportTask());
+            } else if (intermediate_result == IExportable::Complete) {
+                LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") is complete.",exportTask());
+            }
+            if (export_scope.depth == 1)
+                ExportTask::reportSubtreeExported(observer->subjectNameInContext(export_iface->objectBase()));
+        }
+        if (exportable_list.count() > 0)
+            writer->writeEndElement();
+    }
+
+    if (relational_table)
+        delete relational_table;
+
+    if (writer->hasError()) {
+        LOG_TASK_ERROR("Xml export of observer " + observer->observerName() + " failed: The XML stream could not be written.",exportTask());
+        return IExportable::Failed;
+    }
+
+    if (result == IExportable::Incomplete || !complete) {
+        LOG_TASK_DEBUG("Xml export of observer " + observer->observerName() + " was successful (incomplete).",exportTask());
+        return IExportable::Incomplete;
+    } else {
+        LOG_TASK_DEBUG("Xml export of observer " + observer->observerName() + " was successful (complete).",exportTask());
+        return IExportable::Complete;
+    }
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportXmlData_1_0(QDomDocument* doc, QDomElement* subject_data) const {
+    // Observer data:
+    QDomElement observer_data = doc->createElement("ObserverData");
+    // Add parameters as attributes:
+    if (subject_limit != -1)
+        observer_data.setAttribute("SubjectLimit",subject_limit);
+    if (!observer_description.isEmpty())
+        observer_data.setAttribute("Description",observer_description);
+    if (access_mode != Observer::FullAccess)
+        observer_data.setAttribute("AccessMode",Observer::accessModeToString((Observer::AccessMode) access_mode));
+    if (access_mode != Observer::GlobalScope)
+        observer_data.setAttribute("AccessModeScope",Observer::accessModeScopeToString((Observer::AccessModeScope) access_mode_scope));
+    if (object_deletion_policy != Observer::DeleteImmediately)
+        observer_data.setAttribute("ObjectDeletionPolicy",Observer::objectDeletionPolicyToString((Observer::ObjectDeletionPolicy) object_deletion_policy));
+
+    // Check there are any attributes under observer data:
+    if (observer_data.attributes().count() > 0 || observer_data.childNodes().count() > 0)
+        subject_data->appendChild(observer_data);
+
+    // Observer hints:
+    if (display_hints) {
+        if (display_hints->isExportable()) {
+            QDomElement hints_data = doc->createElement("ObserverHints");
+            display_hints->setExportVersion(exportVersion());
+            display_hints->setExportTask(exportTask());
+            if (display_hints->exportXml(doc,&hints_data) == IExportable::Failed) {
+                display_hints->clearExportTask();
+                return IExportable::Failed;
+            }
+            display_hints->clearExportTask();
+            if (hints_data.attributes().count() > 0 || hints_data.childNodes().count() > 0)
+                subject_data->appendChild(hints_data);
+        }
+    }
+
+    // Subject filters:
+    for (int i = 0; i < subject_filters.count(); ++i) {
+        if (subject_filters.at(i)->isExportable()) {
+            QDomElement subject_filter = doc->createElement("SubjectFilter");
+            subject_data->appendChild(subject_filter);
+            if (!subject_filters.at(i)->instanceFactoryInfo().exportXml(doc,&subject_filter,exportVersion()))
+                return IExportable::Failed;
+            subject_filters.at(i)->setExportVersion(exportVersion());
+            subject_filters.at(i)->setExportTask(exportTask());
+            if (subject_filters.at(i)->exportXml(doc,&subject_filter) == IExportable::Failed) {
+                subject_filters.at(i)->clearExportTask();
+                return IExportable::Failed;
+            }
+            subject_filters.at(i)->clearExportTask();
+        }
+    }
+
+    // Formatting:
+    IExportableFormatting* formatting_iface = qobject_cast<IExportableFormatting*> (objectBase());
+    if (formatting_iface) {
+        if (formatting_iface->exportFormattingXML(doc,subject_data,exportVersion()) == IExportable::Failed)
+            return IExportable::Failed;
+    }
+
+    return IExportable::Complete;
+}
+
+QList<IExportable*> Qtilities::Core::ObserverData::xmlExportableSubjects(ExportItemFlags export_flags, bool* complete) const {
+    QList<IExportable*> exportable_list;
+    if (export_flags & ExportVisitorIDs)
+        exportable_list = getLimitedExportsList(subject_list.toQList(),IExportable::XML,complete);
+    else {
+        for (int l = 0; l < subject_list.count(); l++) {
+            IExportable* iface = qobject_cast<IExportable*> (subject_list.at(l));
+            if (iface)
+                exportable_list << iface;
+        }
+
+        if (exportable_list.count() < subject_list.count()) {
+            LOG_TASK_TRACE(QString("%1 exportable subjects found under this observer's level of hierarchy. This list is incomplete.").arg(exportable_list.count()),exportTask());
+            if (complete)
+                *complete = false;
+        } else {
+            LOG_TASK_TRACE(QString("%1 exportable subjects found under this observer's level of hierarchy. This list is complete.").arg(exportable_list.count()),exportTask());
+        }
+    }
+
+    return exportable_list;
+}
+
+bool Qtilities::Core::ObserverData::exportXmlSubjectItem_1_0(QDomDocument* doc, QDomElement* subject_item, IExportable* export_iface, ExportItemFlags export_flags) const {
+    // 1. Category:
+    if (ObjectManager::propertyExists(export_iface->objectBase(),qti_prop_CATEGORY_MAP)) {
+        QVariant category_variant = observer->getMultiContextPropertyValue(export_iface->objectBase(),qti_prop_CATEGORY_MAP);
+        if (category_variant.isValid()) {
+            QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
+            QDomElement category_item = doc->createElement("Category");
+            subject_item->appendChild(category_item);
+            category.setExportVersion(exportVersion());
+            category.setExportTask(exportTask());
+            category.exportXml(doc,&category_item);
+            category.clearExportTask();
+        }
+    }
+    // 2. Is Active:
+    if (ObjectManager::propertyExists(export_iface->objectBase(),qti_prop_ACTIVITY_MAP)) {
+        bool activity = observer->getMultiContextPropertyValue(export_iface->objectBase(),qti_prop_ACTIVITY_MAP).toBool();
+        if (activity)
+            subject_item->setAttribute("Activity","Active");
+        else
+            subject_item->setAttribute("Activity","Inactive");
+    }
+    // 3. Ownership:
+    Observer::ObjectOwnership ownership = observer->subjectOwnershipInContext(export_iface->objectBase());
+    if (ownership != Observer::ObserverScopeOwnership)
+        subject_item->setAttribute("Ownership",Observer::objectOwnershipToString(ownership));
+
+    // 4. Factory Data:
+    if (!export_iface->instanceFactoryInfo().exportXml(doc,subject_item,exportVersion()))
+        return false;
+
+    // 5. Visitor ID (only when needed)
+    if (export_flags & ExportVisitorIDs)
+        subject_item->setAttribute("VisitorID",ObserverRelationalTable::getVisitorID(export_iface->objectBase()));
+
+    return true;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importXmlExt_1_0(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list) {
+    QList<QPointer<QObject> > active_subjects;
+    observer->startProcessingCycle();
+    IExportable::ExportResultFlags result = IExportable::Complete;
+
+    ObserverRelationalTable* readback_table = 0;
+
+    // Create a custom internal import list which will only store this observer and all its children:
+    QList<QPointer<QObject> > internal_import_list;
+
+    ExportItemFlags export_flags = ExportData;
+    if (object_node->hasAttribute("ExportFlags"))
+        export_flags = (ExportItemFlags) object_node->attribute("ExportFlags").toInt();
+
+    if (export_flags & ExportVisitorIDs) {
+        if (object_node->hasAttribute("VisitorID")) {
+            SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,object_node->attribute("VisitorID").toInt());
+            ObjectManager::setSharedProperty(observer,visitor_id_prop);
+        }
+    }
+
+    // All children underneath the root element gets constructed in here:
+    QList<QObject*> constructed_list;
+    QDomNodeList childNodes = object_node->childNodes();
+    for(int i = 0; i < childNodes.count(); ++i)
+    {
+        QDomNode childNode = childNodes.item(i);
+        QDomElement child = childNode.toElement();
+
+        if (child.isNull())
+            continue;
+
+        if (export_flags & ExportRelationalData) {
+            if (child.tagName() == QLatin1String("RelationalData")) {
+                readback_table = new ObserverRelationalTable;
+                QList<QPointer<QObject> > tmp_import_list;
+                readback_table->setExportTask(exportTask());
+                readback_table->importXml(doc,&child,tmp_import_list);
+                readback_table->clearExportTask();
+            }
+        }
+
+        if (export_flags & ExportData) {
+            if (child.tagName() == QLatin1String("Data")) {
+                if (!importXmlData_1_0(doc,&child,import_list,&result)) {
+                    observer->endProcessingCycle();
+                    return IExportable::Failed;
+                }
+                continue;
+            }
+
+            if (child.tagName() == QLatin1String("Children")) {
+                QDomNodeList childrenNodes = child.childNodes();
+                for(int i = 0; i < childrenNodes.count(); ++i)
+                {
+                    QDomNode childrenChildNode = childrenNodes.item(i);
+                    QDomElement childrenChild = childrenChildNode.toElement();
+
+                    if (childrenChild.isNull())
+                        continue;
+
+                    if (childrenChild.tagName() == QLatin1String("TreeItem")) {
+                        // Construct and init the child:
+                        InstanceFactoryInfo instanceFactoryInfo(doc,&childrenChild,exportVersion());
+                        if (instanceFactoryInfo.isValid()) {
+                            LOG_TASK_TRACE(QString("Importing subject type \"%1\" in factory \"%2\"...").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
+
+                            IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
+                            if (ifactory) {
+                                QObject* obj = ifactory->createInstance(instanceFactoryInfo);
+                                if (obj) {
+                                    obj->setObjectName(instanceFactoryInfo.d_instance_name);
+                                    internal_import_list << obj;
+                                    IExportable* iface = qobject_cast<IExportable*> (obj);
+                                    if (iface) {
+                                        // Attach first before doing import on object:
+                                        constructed_list << iface->objectBase();
+                                        // Check if we must restore the ownership is active:
+                                        Observer::ObjectOwnership ownership = Observer::ObserverScopeOwnership;
+                                        if (childrenChild.hasAttribute("Ownership")) {
+                                            ownership = Observer::stringToObjectOwnership(childrenChild.attribute("Ownership"));
+                                        }
+                                        QString error_msg;
+                                        if (observer->attachSubject(iface->objectBase(),ownership,&error_msg)) {
+                                            import_list << obj;
+                                        } else {
+                                            LOG_TASK_WARNING(QString("Failed to attach reconstructed object \"%1\" to tree node: %2. Import will be incomplete.").arg(observer->observerName()).arg(error_msg),exportTask());
+                                            delete obj;
+                                            result = IExportable::Incomplete;
+                                            continue;
+                                        }
+
+                                        QDomNodeList subjectChildNodes = childrenChild.childNodes();
+                                        for(int i = 0; i < subjectChildNodes.count(); ++i)
+                                        {
+                                            QDomNode subjectChildNode = subjectChildNodes.item(i);
+                                            QDomElement subjectChild = subjectChildNode.toElement();
+
+                                            if (subjectChild.isNull())
+                                                continue;
+
+                                            if (subjectChild.tagName() == QLatin1String("Category"))
+                                                importXmlSubjectCategory_1_0(doc,&subjectChild,iface->objectBase(),import_list,&result);
+                                        }
+
+                                        // Now that we created the item, init its data and children:
+                                        iface->setExportVersion(exportVersion());
+                                        iface->setApplicationExportVersion(applicationExportVersion());
+                                        iface->setExportTask(exportTask());
+
+                                        // Check if it is an observer: if so we must use internal_import_list, not import_list:
+                                        Observer* obs = qobject_cast<Observer*> (iface->objectBase());
+                                        IExportable::ExportResultFlags intermediate_result;
+
+                                        if (obs)
+                                            intermediate_result = iface->importXml(doc,&childrenChild,internal_import_list);
+                                        else
+                                            intermediate_result = iface->importXml(doc,&childrenChild,import_list);
+
+                                        if (intermediate_result == IExportable::Incomplete) {
+                                            LOG_TASK_WARNING(QString("Failed to reconstruct object completely in tree node: %1. Item \"%2\" will be incomplete.").arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
+                                            result = IExportable::Incomplete;
+                                        } else if (intermediate_result & IExportable::FailedResult) {
+                                            LOG_TASK_ERROR(QString("Failed to import object in tree node: %1. Item \"%2\" will not be imported.").arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
+                                            result = intermediate_result;
+                                        }
+
+                                        // Check if it is active:
+                                        if (childrenChild.hasAttribute("Activity")) {
+                                            if (childrenChild.attribute("Activity") == QString("Active"))
+                                                active_subjects << iface->objectBase();
+                                        }
+
+                                        // Get VisitorID if needed:
+                                        if (export_flags & ExportVisitorIDs) {
+                                            if (childrenChild.hasAttribute("VisitorID")) {
+                                                SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,childrenChild.attribute("VisitorID").toInt());
+                                                ObjectManager::setSharedProperty(iface->objectBase(),visitor_id_prop);
+                                            }
+                                        }
+
+                                        iface->clearExportTask();
+                                    } else {
+                                        LOG_TASK_ERROR(QString("Found invalid exportable interface on reconstructed object in tree node: %1").arg(observer->observerName()),exportTask());
+                                        observer->endProcessingCycle();
+                                        return IExportable::Failed;
+                                    }
+                                } else {
+                                    LOG_TASK_WARNING(QString("Factory tag %1 does not exist in factory %2. This item will be skipped and the import will be incomplete.").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
+                                    result = IExportable::Incomplete;
+                                }
+                            } else {
+                                LOG_TASK_WARNING(QString("Factory with name %1 does not exist in the object manager. This item will be skipped and the import will be incomplete.").arg(instanceFactoryInfo.d_factory_tag),exportTask());
+                                result = IExportable::Incomplete;
+                            }
+                        } else {
+                            result = IExportable::Incomplete;
+                            LOG_TASK_WARNING(QString("Found invalid factory data for child on tree node: %1").arg(observer->observerName()),exportTask());
+                        }
+                        continue;
+                    }
+                }
+                continue;
+            }
+        }
+    }
+
+    if (export_flags & ExportRelationalData) {
+        internal_import_list << observer;
+
+        // Construct relationships:
+        if (!constructRelationships(internal_import_list,readback_table))
+            result = IExportable::Incomplete;
+
+        // Cross-check the constructed table:
+        ObserverRelationalTable constructed_table(observer,true);
+        /*if (verbose_output) {
+            LOG_TASK_INFO(QString(tr("Relational verification completed on observer: %1. Here is the contents of the reconstructed table.")).arg(obs->observerName()),exportTask());
+            constructed_table.dumpTableInfo();
+        }*/
+        if (!constructed_table.compare(*readback_table)) {
+            LOG_TASK_WARNING(QString("Relational verification failed on observer: %1").arg(observer->observerName()),exportTask());
+            result = IExportable::Incomplete;
+        } else {
+            LOG_TASK_INFO(QString("Relational verification successful on observer: %1").arg(observer->observerName()),exportTask());
+        }
+
+        // Remove all relational properties used.
+        ObserverRelationalTable::removeRelationalProperties(observer);
+    }
+
+    observer->endProcessingCycle();
+
+    // If active_subjects has items in it we must set them active:
+    if (active_subjects.count() > 0) {
+        for (int i = 0; i < subject_filters.count(); ++i) {
+            ActivityPolicyFilter* activity_filter = qobject_cast<ActivityPolicyFilter*> (subject_filters.at(i));
+            if (activity_filter) {
+                activity_filter->setActiveSubjects(active_subjects,true);
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importXmlStreamExt_1_0(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list, QDomElement* other_elements) {
+    QList<QPointer<QObject> > active_subjects;
+    observer->startProcessingCycle();
+    IExportable::ExportResultFlags result = IExportable::Complete;
+
+    ObserverRelationalTable* readback_table = 0;
+
+    // Create a custom internal import list which will only store this observer and all its children:
+    QList<QPointer<QObject> > internal_import_list;
+
+    QXmlStreamAttributes attributes = reader->attributes();
+    ExportItemFlags export_flags = ExportData;
+    if (attributes.hasAttribute("ExportFlags"))
+        export_flags = (ExportItemFlags) attributes.value("ExportFlags").toString().toInt();
+
+    if (export_flags & ExportVisitorIDs) {
+        if (attributes.hasAttribute("VisitorID")) {
+            SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,attributes.value("VisitorID").toString().toInt());
+            ObjectManager::setSharedProperty(observer,visitor_id_prop);
+        }
+    }
+
+    // Elements other than the children of the observer are small, they are read into a document and
+    // imported using the same functions as importXmlExt_1_0():
+    QDomDocument doc;
+    while (reader->readNextStartElement()) {
+        if ((export_flags & ExportRelationalData) && reader->name() == QLatin1String("RelationalData")) {
+            if (!readback_table)
+                readback_table = new ObserverRelationalTable;
+            QList<QPointer<QObject> > tmp_import_list;
+            readback_table->setExportTask(exportTask());
+            readback_table->importXmlStream(reader,tmp_import_list);
+            readback_table->clearExportTask();
+            continue;
+        }
+
+        if ((export_flags & ExportData) && reader->name() == QLatin1String("Data")) {
+            QDomElement data_node = IExportable::readDomElement(reader,&doc);
+            if (!importXmlData_1_0(&doc,&data_node,import_list,&result)) {
+                observer->endProcessingCycle();
+                if (readback_table)
+                    delete readback_table;
+                return IExportable::Failed;
+            }
+            continue;
+        }
+
+        if ((export_flags & ExportData) && reader->name() == QLatin1String("Children")) {
+            while (reader->readNextStartElement()) {
+                if (reader->name() != QLatin1String("TreeItem")) {
+                    reader->skipCurrentElement();
+                    continue;
+                }
+
+                // Construct and init the child:
+                QXmlStreamAttributes item_attributes = reader->attributes();
+                InstanceFactoryInfo instanceFactoryInfo;
+                instanceFactoryInfo.importXmlStream(item_attributes,exportVersion());
+                if (!instanceFactoryInfo.isValid()) {
+                    result = IExportable::Incomplete;
+                    LOG_TASK_WARNING(QString("Found invalid factory data for child on tree node: %1").arg(observer->observerName()),exportTask());
+                    reader->skipCurrentElement();
+                    continue;
+                }
+
+                LOG_TASK_TRACE(QString("Importing subject type \"%1\" in factory \"%2\"...").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
+                IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
+                if (!ifactory) {
+                    LOG_TASK_WARNING(QString("Factory with name %1 does not exist in the object manager. This item will be skipped and the import will be incomplete.").arg(instanceFactoryInfo.d_factory_tag),exportTask());
+                    result = IExportable::Incomplete;
+                    reader->skipCurrentElement();
+                    continue;
+                }
+
+                QObject* obj = ifactory->createInstance(instanceFactoryInfo);
+                if (!obj) {
+                    LOG_TASK_WARNING(QString("Factory tag %1 does not exist in factory %2. This item will be skipped and the import will be incomplete.").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
+                    result = IExportable::Incomplete;
+                    reader->skipCurrentElement();
+                    continue;
+                }
+
+                obj->setObjectName(instanceFactoryInfo.d_instance_name);
+                internal_import_list << obj;
+                IExportable* iface = qobject_cast<IExportable*> (obj);
+                if (!iface) {
+                    LOG_TASK_ERROR(QString("Found invalid exportable interface on reconstructed object in tree node: %1").arg(observer->observerName()),exportTask());
+                    observer->endProcessingCycle();
+                    if (readback_table)
+                        delete readback_table;
+                    return IExportable::Failed;
+                }
+
+                // Attach first before doing import on object:
+                Observer::ObjectOwnership ownership = Observer::ObserverScopeOwnership;
+                if (item_attributes.hasAttribute("Ownership"))
+                    ownership = Observer::stringToObjectOwnership(item_attributes.value("Ownership").toString());
+                QString error_msg;
+                if (observer->attachSubject(obj,ownership,&error_msg)) {
+                    import_list << obj;
+                } else {
+                    LOG_TASK_WARNING(QString("Failed to attach reconstructed object \"%1\" to tree node: %2. Import will be incomplete.").arg(observer->observerName()).arg(error_msg),exportTask());
+                    delete obj;
+                    result = IExportable::Incomplete;
+                    reader->skipCurrentElement();
+                    continue;
+                }
+
+                // Now that we created the item, init its data and children:
+                iface->setExportVersion(exportVersion());
+                iface->setApplicationExportVersion(applicationExportVersion());
+                iface->setExportTask(exportTask());
+
+                // Observers read their children directly from the stream and give back the elements they don't use, like the category
+                // of the observer in our context. Other subjects are read into a document, one subject at a time:
+                QDomDocument item_doc;
+                QDomElement item_node;
+                IExportable::ExportResultFlags intermediate_result = IExportable::Complete;
+                Observer* obs = qobject_cast<Observer*> (obj);
+                IExportableObserver* export_iface_obs = obs ? qobject_cast<IExportableObserver*> (obj) : 0;
+                if (export_iface_obs) {
+                    item_node = item_doc.createElement("TreeItem");
+                    item_doc.appendChild(item_node);
+                    intermediate_result = export_iface_obs->importXmlStreamExt(reader,internal_import_list,&item_node);
+                } else {
+                    item_node = IExportable::readDomElement(reader,&item_doc);
+                    item_doc.appendChild(item_node);
+                }
+
+                for (QDomElement category_node = item_node.firstChildElement("Category"); !category_node.isNull(); category_node = category_node.nextSiblingElement("Category"))
+                    importXmlSubjectCategory_1_0(&item_doc,&category_node,obj,import_list,&result);
+
+                if (!export_iface_obs)
+                    intermediate_result = iface->importXml(&item_doc,&item_node,import_list);
+
+                if (intermediate_result == IExportable::Incomplete) {
+                    LOG_TASK_WARNING(QString("Failed to reconstruct object completely in tree node: %1. Item \"%2\" will be incomplete.").arg(observer->observerName()).arg(obj->objectName()),exportTask());
+                    result = IExportable::Incomplete;
+                } else if (intermediate_result & IExportable::FailedResult) {
+                    LOG_TASK_ERROR(QString("Failed to import object in tree node: %1. Item \"%2\" will not be imported.").arg(observer->observerName()).arg(obj->objectName()),exportTask());
+                    result = intermediate_result;
+                }
+
+                // Check if it is active:
+                if (item_attributes.value("Activity") == QLatin1String("Active"))
+                    active_subjects << obj;
+
+                // Get VisitorID if needed:
+                if (export_flags & ExportVisitorIDs) {
+                    if (item_attributes.hasAttribute("VisitorID")) {
+                        SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,item_attributes.value("VisitorID").toString().toInt());
+                        ObjectManager::setSharedProperty(obj,visitor_id_prop);
+                    }
+                }
+
+                iface->clearExportTask();
+            }
+            continue;
+        }
+
+        // The categories of the observer are not imported, the same as in importXmlExt_1_0():
+        if (other_elements && reader->name() != QLatin1String("Categories")) {
+            QDomDocument other_doc = other_elements->ownerDocument();
+            other_elements->appendChild(IExportable::readDomElement(reader,&other_doc));
+        } else
+            reader->skipCurrentElement();
+    }
+
+    if (reader->hasError()) {
+        LOG_TASK_ERROR(QString("Failed to read XML stream for tree node %1 on line %2: %3").arg(observer->observerName()).arg(reader->lineNumber()).arg(reader->errorString()),exportTask());
+        result = IExportable::Failed;
+    }
+
+    if ((export_flags & ExportRelationalData) && result != IExportable::Failed) {
+        internal_import_list << observer;
+
+        // Construct relationships:
+        if (!readback_table || !constructRelationships(internal_import_list,readback_table)) {
+            result = IExportable::Incomplete;
+        } else {
+            // Cross-check the constructed table:
+            ObserverRelationalTable constructed_table(observer,true);
+            if (!constructed_table.compare(*readback_table)) {
+                LOG_TASK_WARNING(QString("Relational verification failed on observer: %1").arg(observer->observerName()),exportTask());
+                result = IExportable::Incomplete;
+            } else {
+                LOG_TASK_INFO(QString("Relational verification successful on observer: %1").arg(observer->observerName()),exportTask());
+            }
+        }
+
+        // Remove all relational properties used.
+        ObserverRelationalTable::removeRelationalProperties(observer);
+    }
+
+    if (readback_table)
+        delete readback_table;
+
+    observer->endProcessingCycle();
+
+    // If active_subjects has items in it we must set them active:
+    if (active_subjects.count() > 0) {
+        for (int i = 0; i < subject_filters.count(); ++i) {
+            ActivityPolicyFilter* activity_filter = qobject_cast<ActivityPolicyFilter*> (subject_filters.at(i));
+            if (activity_filter) {
+                activity_filter->setActiveSubjects(active_subjects,true);
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::exportCborExt_1_0(CborStreamWriter* writer, ExportItemFlags export_flags) const {
+    completeDeferredImport();
+    ExportTaskScope export_scope;
+
+    // The keys of the observer's map follow the elements written by exportXmlStreamExt_1_0(). The data element and the information
+    // about each subject are small, thus they are built as elements and written using IExportable::writeCborElement():
+    writer->startMap();
+    writer->writeString("exportFlags");
+    writer->writeUnsignedInteger(export_flags & ~ExportParallel);
+    if ((export_flags & ExportData) && (export_flags & ExportVisitorIDs)) {
+        writer->writeString("visitorId");
+        writer->writeInteger(ObserverRelationalTable::getVisitorID(observer));
+    }
+
+    IExportable::ExportResultFlags result = IExportable::Complete;
+    bool complete = true;
+
+    if (export_flags & ExportRelationalData) {
+        // Export relational data about the observer:
+        ObserverRelationalTable relational_table(observer,true);
+        relational_table.setExportVersion(exportVersion());
+        relational_table.setExportTask(exportTask());
+        writer->writeString("relationalData");
+        IExportable::ExportResultFlags relational_result = relational_table.exportCbor(writer);
+        relational_table.clearExportTask();
+        if (relational_result != IExportable::Complete)
+            return IExportable::Failed;
+    }
+
+    if (export_flags & ExportData) {
+        QDomDocument data_doc;
+        QDomElement subject_data = data_doc.createElement("Data");
+        data_doc.appendChild(subject_data);
+        if (exportXmlData_1_0(&data_doc,&subject_data) == IExportable::Failed)
+            return IExportable::Failed;
+
+        if (subject_data.attributes().count() > 0 || subject_data.childNodes().count() > 0) {
+            writer->writeString("data");
+            IExportable::writeCborElement(writer,subject_data);
+        }
+
+        // Make List Of Exportable Subjects
+        QList<IExportable*> exportable_list = xmlExportableSubjects(export_flags,&complete);
+
+        // Export exportable subjects, each subject is a map with its item information followed by the subject itself:
+        writer->writeString("children");
+        writer->startArray();
+        for (int i = 0; i < exportable_list.count(); ++i) {
+            if (ExportTask::isExportCancelled())
+                return IExportable::Failed;
+            IExportable* export_iface = exportable_list.at(i);
+            if (!export_iface)
+                continue;
+
+            if (!(export_iface->supportedFormats() & (IExportable::Cbor | IExportable::XML))) {
+                LOG_TASK_WARNING("CBOR export found an interface (" + observer->subjectNameInContext(export_iface->objectBase()) + " in context " + observer->observerName() + ") which does not support CBOR exporting. CBOR export will be incomplete.",exportTask());
+                result = IExportable::Incomplete;
+                continue;
+            }
+
+            QDomDocument item_doc;
+            QDomElement subject_item = item_doc.createElement("TreeItem");
+            item_doc.appendChild(subject_item);
+            if (!exportXmlSubjectItem_1_0(&item_doc,&subject_item,export_iface,export_flags))
+                return IExportable::Failed;
+
+            export_iface->setExportVersion(exportVersion());
+            export_iface->setApplicationExportVersion(applicationExportVersion());
+            export_iface->setExportTask(exportTask());
+
+            writer->startMap(2);
+            writer->writeString("item");
+            IExportable::writeCborElement(writer,subject_item);
+            writer->writeString("object");
+
+            IExportable::ExportResultFlags intermediate_result;
+            Observer* obs = qobject_cast<Observer*> (export_iface->objectBase());
+            if (obs) {
+                ExportItemFlags child_obs_flags = export_flags;
+                child_obs_flags &= ~ExportRelationalData;
+                IExportableObserver* export_iface_obs = qobject_cast<IExportableObserver*> (obs->objectBase());
+                Q_ASSERT(export_iface_obs);
+                intermediate_result = export_iface_obs->exportCborExt(writer,child_obs_flags);
+            } else
+                intermediate_result = export_iface->exportCbor(writer);
+            writer->endMap();
+
+            export_iface->clearExportTask();
+
+            if (intermediate_result == IExportable::Failed || intermediate_result == IExportable::VersionTooOld || intermediate_result == IExportable::VersionTooNew) {
+                LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") failed.",exportTask());
+                return intermediate_result;
+            } else if (intermediate_result == IExportable::Incomplete) {
+                result = IExportable::Incomplete;
+                LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") is incomplete.",exportTask());
+            } else if (intermediate_result == IExportable::Complete) {
+                LOG_TASK_TRACE("TreeItem (" + export_iface->objectBase()->objectName() + ") is complete.",exportTask());
+            }
+            if (export_scope.depth == 1)
+                ExportTask::reportSubtreeExported(observer->subjectNameInContext(export_iface->objectBase()));
+        }
+        writer->endArray();
+    }
+    writer->endMap();
+
+    if (writer->hasError()) {
+        LOG_TASK_ERROR("CBOR export of observer " + observer->observerName() + " failed: The CBOR stream could not be written.",exportTask());
+        return IExportable::Failed;
+    }
+
+    if (result == IExportable::Incomplete || !complete) {
+        LOG_TASK_DEBUG("CBOR export of observer " + observer->observerName() + " was successful (incomplete).",exportTask());
+        return IExportable::Incomplete;
+    } else {
+        LOG_TASK_DEBUG("CBOR export of observer " + observer->observerName() + " was successful (complete).",exportTask());
+        return IExportable::Complete;
+    }
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverData::importCbor_1_0(CborStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    if (!reader->isMap()) {
+        LOG_TASK_ERROR(QString("Failed to read CBOR stream for tree node %1: Expected a map.").arg(observer->observerName()),exportTask());
+        reader->next();
+        return IExportable::Failed;
+    }
+
+    QList<QPointer<QObject> > active_subjects;
+    observer->startProcessingCycle();
+    IExportable::ExportResultFlags result = IExportable::Complete;
+
+    ObserverRelationalTable* readback_table = 0;
+
+    // Create a custom internal import list which will only store this observer and all its children:
+    QList<QPointer<QObject> > internal_import_list;
 
-    if (export_flags & ExportVisitorIDs) {
-        if (object_node->hasAttribute("VisitorID")) {
-            SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,object_node->attribute("VisitorID").toInt());
-            ObjectManager::setSharedProperty(observer,visitor_id_prop);
+    ExportItemFlags export_flags = ExportData;
+    QDomDocument doc;
+
+    // Keys which are not known are skipped. The export flags are always the first key:
+    reader->enterContainer();
+    while (reader->hasNext()) {
+        QString key = reader->readString();
+        if (key == QLatin1String("exportFlags") && reader->isUnsignedInteger()) {
+            export_flags = (ExportItemFlags) reader->toUnsignedInteger();
+            reader->next();
+            continue;
         }
-    }
-
-    // All children underneath the root element gets constructed in here:
-    QList<QObject*> constructed_list;
-    QDomNodeList childNodes = object_node->childNodes();
-    for(int i = 0; i < childNodes.count(); ++i)
-    {
-        QDomNode childNode = childNodes.item(i);
-        QDomElement child = childNode.toElement();
 
-        if (child.isNull())
+        if (key == QLatin1String("visitorId") && reader->isInteger()) {
+            if (export_flags & ExportVisitorIDs) {
+                SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,(int) reader->toInteger());
+                ObjectManager::setSharedProperty(observer,visitor_id_prop);
+            }
+            reader->next();
             continue;
+        }
 
-        if (export_flags & ExportRelationalData) {
-            if (child.tagName() == QLatin1String("RelationalData")) {
+        if ((export_flags & ExportRelationalData) && key == QLatin1String("relationalData")) {
+            if (!readback_table)
                 readback_table = new ObserverRelationalTable;
-                QList<QPointer<QObject> > tmp_import_list;
-                readback_table->setExportTask(exportTask());
-                readback_table->importXml(doc,&child,tmp_import_list);
-                readback_table->clearExportTask();
+            QList<QPointer<QObject> > tmp_import_list;
+            readback_table->setExportTask(exportTask());
+            readback_table->importCbor(reader,tmp_import_list);
+            readback_table->clearExportTask();
+            continue;
+        }
+
+        if ((export_flags & ExportData) && key == QLatin1String("data")) {
+            QDomElement data_node = IExportable::readCborElement(reader,&doc);
+            if (!data_node.isNull() && !importXmlData_1_0(&doc,&data_node,import_list,&result)) {
+                observer->endProcessingCycle();
+                if (readback_table)
+                    delete readback_table;
+                return IExportable::Failed;
             }
+            continue;
         }
 
-        if (export_flags & ExportData) {
-            if (child.tagName() == QLatin1String("Data")) {
-                QDomNodeList dataNodes = child.childNodes();
-                for(int i = 0; i < dataNodes.count(); ++i)
-                {
-                    QDomNode dataChildNode = dataNodes.item(i);
-                    QDomElement dataChild = dataChildNode.toElement();
+        if ((export_flags & ExportData) && key == QLatin1String("children") && reader->isArray()) {
+            reader->enterContainer();
+            while (reader->hasNext()) {
+                if (!reader->isMap()) {
+                    reader->next();
+                    continue;
+                }
 
-                    if (dataChild.isNull())
+                // The item information is read first, the subject is constructed and attached when its object is reached:
+                QDomDocument item_doc;
+                QDomElement item_node;
+                QPointer<QObject> obj;
+                reader->enterContainer();
+                while (reader->hasNext()) {
+                    QString item_key = reader->readString();
+                    if (item_key == QLatin1String("item")) {
+                        item_node = IExportable::readCborElement(reader,&item_doc);
+                        item_doc.appendChild(item_node);
                         continue;
-
-                    if (dataChild.tagName() == QLatin1String("ObserverHints")) {
-                        observer->useDisplayHints();
-                        display_hints->setExportVersion(exportVersion());
-                        display_hints->setExportTask(exportTask());
-                        if (display_hints->importXml(doc,&dataChild,import_list) == IExportable::Failed) {
-                            display_hints->clearExportTask();
-                            return IExportable::Failed;
-                        }
-                        display_hints->clearExportTask();
+                    }
+                    if (item_key != QLatin1String("object") || item_node.isNull() || obj) {
+                        reader->next();
                         continue;
                     }
 
-                    if (dataChild.tagName() == QLatin1String("ObserverData")) {
-                        if (dataChild.hasAttribute("SubjectLimit"))
-                            subject_limit = dataChild.attribute("SubjectLimit").toInt();
-                        if (dataChild.hasAttribute("Description"))
-                            observer_description = dataChild.attribute("Description");
-                        if (dataChild.hasAttribute("AccessMode"))
-                            access_mode = Observer::stringToAccessMode(dataChild.attribute("AccessMode"));
-                        if (dataChild.hasAttribute("AccessModeScope"))
-                            access_mode_scope = Observer::stringToAccessModeScope(dataChild.attribute("AccessModeScope"));
-                        if (dataChild.hasAttribute("ObjectDeletionPolicy"))
-                            object_deletion_policy = Observer::stringToObjectDeletionPolicy(dataChild.attribute("ObjectDeletionPolicy"));
-
-                        // Category stuff:
-                        QDomNodeList childNodes = dataChild.childNodes();
-                        for(int i = 0; i < childNodes.count(); ++i)
-                        {
-                            QDomNode childNode = childNodes.item(i);
-                            QDomElement child = childNode.toElement();
-
-                            if (child.isNull())
-                                continue;
-
-                            if (child.tagName() == QLatin1String("Categories")) {
-                                QDomNodeList categoryNodes = child.childNodes();
-                                for(int i = 0; i < categoryNodes.count(); ++i)
-                                {
-                                    QDomNode categoryNode = categoryNodes.item(i);
-                                    QDomElement category = categoryNode.toElement();
-
-                                    if (category.isNull())
-                                        continue;
-
-                                    if (category.tagName() == QLatin1String("Categories")) {
-                                        QtilitiesCategory new_category;
-                                        new_category.setExportVersion(exportVersion());
-                                        new_category.setExportTask(exportTask());
-                                        new_category.importXml(doc,&category,import_list);
-                                        if (new_category.isValid())
-                                            categories << new_category;
-                                        new_category.clearExportTask();
-                                        continue;
-                                    }
-                                }
-                                continue;
-                            }
-                        }
+                    // Construct and init the child:
+                    InstanceFactoryInfo instanceFactoryInfo;
+                    instanceFactoryInfo.importXml(&item_doc,&item_node,exportVersion());
+                    if (!instanceFactoryInfo.isValid()) {
+                        result = IExportable::Incomplete;
+                        LOG_TASK_WARNING(QString("Found invalid factory data for child on tree node: %1").arg(observer->observerName()),exportTask());
+                        reader->next();
                         continue;
                     }
 
-                    if (dataChild.tagName() == QLatin1String("SubjectFilter")) {
-                        // Construct and init the subject filter:
-                        InstanceFactoryInfo instanceFactoryInfo(doc,&dataChild,exportVersion());
-                        if (instanceFactoryInfo.isValid()) {
-                            LOG_TASK_TRACE(QString("Importing subject type \"%1\" in factory \"%2\"...").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
-
-                            IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
-                            if (ifactory) {
-                                QObject* obj = ifactory->createInstance(instanceFactoryInfo);
-                                if (obj) {
-                                    obj->setObjectName(instanceFactoryInfo.d_instance_name);
-                                    AbstractSubjectFilter* abstract_filter = qobject_cast<AbstractSubjectFilter*> (obj);
-                                    if (abstract_filter) {
-                                        abstract_filter->setExportVersion(exportVersion());
-                                        abstract_filter->setExportTask(exportTask());
-                                        if (abstract_filter->importXml(doc,&dataChild,import_list) == IExportable::Failed) {
-                                            LOG_TASK_ERROR(QString("Failed to import subject filter \"%1\" for tree node: \"%2\". Importing will not continue.").arg(instanceFactoryInfo.d_instance_tag).arg(observer->observerName()),exportTask());
-                                            delete abstract_filter;
-                                            result = IExportable::Failed;
-                                        }
-                                        abstract_filter->clearExportTask();
-                                        if (!observer->installSubjectFilter(abstract_filter)) {
-                                            LOG_TASK_DEBUG(QString("Failed to install subject filter \"%1\" for tree node: \"%2\". If this filter already existed this is not a problem.").arg(instanceFactoryInfo.d_instance_tag).arg(observer->observerName()),exportTask());
-                                            delete abstract_filter;
-                                        }
-                                    }
-                                }
-                            }
-                        } else
-                            LOG_TASK_WARNING(QString("Found invalid factory data for subject filter on tree node: %1").arg(observer->observerName()),exportTask());
+                    LOG_TASK_TRACE(QString("Importing subject type \"%1\" in factory \"%2\"...").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
+                    IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
+                    if (!ifactory) {
+                        LOG_TASK_WARNING(QString("Factory with name %1 does not exist in the object manager. This item will be skipped and the import will be incomplete.").arg(instanceFactoryInfo.d_factory_tag),exportTask());
+                        result = IExportable::Incomplete;
+                        reader->next();
                         continue;
                     }
 
-                    if (dataChild.tagName() == QLatin1String("Formatting")) {
-                        IExportableFormatting* formatting_iface = qobject_cast<IExportableFormatting*> (observer->objectBase());
-                        if (formatting_iface) {
-                            if (formatting_iface->importFormattingXML(doc,&dataChild,exportVersion()) != IExportable::Complete) {
-                                LOG_TASK_WARNING(QString("Failed to import formatting for tree node: \"%1\"").arg(observer->observerName()),exportTask());
-                                result = IExportable::Incomplete;
-                            }
-                        }
+                    obj = ifactory->createInstance(instanceFactoryInfo);
+                    if (!obj) {
+                        LOG_TASK_WARNING(QString("Factory tag %1 does not exist in factory %2. This item will be skipped and the import will be incomplete.").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
+                        result = IExportable::Incomplete;
+                        reader->next();
                         continue;
                     }
-                }
-                continue;
-            }
 
-            if (child.tagName() == QLatin1String("Children")) {
-                QDomNodeList childrenNodes = child.childNodes();
-                for(int i = 0; i < childrenNodes.count(); ++i)
-                {
-                    QDomNode childrenChildNode = childrenNodes.item(i);
-                    QDomElement childrenChild = childrenChildNode.toElement();
+                    obj->setObjectName(instanceFactoryInfo.d_instance_name);
+                    internal_import_list << obj;
+                    IExportable* iface = qobject_cast<IExportable*> (obj);
+                    if (!iface) {
+                        LOG_TASK_ERROR(QString("Found invalid exportable interface on reconstructed object in tree node: %1").arg(observer->observerName()),exportTask());
+                        observer->endProcessingCycle();
+                        if (readback_table)
+                            delete readback_table;
+                        return IExportable::Failed;
+                    }
 
-                    if (childrenChild.isNull())
+                    // Attach first before doing import on object:
+                    Observer::ObjectOwnership ownership = Observer::ObserverScopeOwnership;
+                    if (item_node.hasAttribute("Ownership"))
+                        ownership = Observer::stringToObjectOwnership(item_node.attribute("Ownership"));
+                    QString error_msg;
+                    if (observer->attachSubject(obj,ownership,&error_msg)) {
+                        import_list << obj;
+                    } else {
+                        LOG_TASK_WARNING(QString("Failed to attach reconstructed object \"%1\" to tree node: %2. Import will be incomplete.").arg(observer->observerName()).arg(error_msg),exportTask());
+                        delete obj;
+                        result = IExportable::Incomplete;
+                        reader->next();
                         continue;
+                    }
 
-                    if (childrenChild.tagName() == QLatin1String("TreeItem")) {
-                        // Construct and init the child:
-                        InstanceFactoryInfo instanceFactoryInfo(doc,&childrenChild,exportVersion());
-                        if (instanceFactoryInfo.isValid()) {
-                            LOG_TASK_TRACE(QString("Importing subject type \"%1\" in factory \"%2\"...").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
-
-                            IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
-                            if (ifactory) {
-                                QObject* obj = ifactory->createInstance(instanceFactoryInfo);
-                                if (obj) {
-                                    obj->setObjectName(instanceFactoryInfo.d_instance_name);
-                                    internal_import_list << obj;
-                                    IExportable* iface = qobject_cast<IExportable*> (obj);
-                                    if (iface) {
-                                        // Attach first before doing import on object:
-                                        constructed_list << iface->objectBase();
-                                        // Check if we must restore the ownership is active:
-                                        Observer::ObjectOwnership ownership = Observer::ObserverScopeOwnership;
-                                        if (childrenChild.hasAttribute("Ownership")) {
-                                            ownership = Observer::stringToObjectOwnership(childrenChild.attribute("Ownership"));
-                                        }
-                                        QString error_msg;
-                                        if (observer->attachSubject(iface->objectBase(),ownership,&error_msg)) {
-                                            import_list << obj;
-                                        } else {
-                                            LOG_TASK_WARNING(QString("Failed to attach reconstructed object \"%1\" to tree node: %2. Import will be incomplete.").arg(observer->observerName()).arg(error_msg),exportTask());
-                                            delete obj;
-                                            result = IExportable::Incomplete;
-                                            continue;
-                                        }
-
-                                        QDomNodeList subjectChildNodes = childrenChild.childNodes();
-                                        for(int i = 0; i < subjectChildNodes.count(); ++i)
-                                        {
-                                            QDomNode subjectChildNode = subjectChildNodes.item(i);
-                                            QDomElement subjectChild = subjectChildNode.toElement();
-
-                                            if (subjectChild.isNull())
-                                                continue;
-
-                                            if (subjectChild.tagName() == QLatin1String("Category")) {
-                                                // We just created this object, it will not have a category property yet so no need to check if it needs one:
-                                                QtilitiesCategory category;
-                                                category.setExportVersion(exportVersion());
-                                                category.setExportTask(exportTask());
-                                                IExportable::ExportResultFlags category_result = category.importXml(doc,&subjectChild,import_list);
-                                                category.clearExportTask();
-
-                                                if (category_result == IExportable::Incomplete) {
-                                                    LOG_TASK_WARNING(QString("Failed to import category completely for object in tree node: %1. Item \"%2\" will not have its category set.").arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
-                                                    result = IExportable::Incomplete;
-                                                } else if (category_result & IExportable::FailedResult) {
-                                                    LOG_TASK_ERROR(QString("Failed to import category for object in tree node: %1. Item \"%2\" will not have its category set.").arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
-                                                    result = category_result;
-                                                }
-
-                                                MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
-                                                category_property.setValue(qVariantFromValue(category),observer->observerID());
-                                                if (!ObjectManager::setMultiContextProperty(iface->objectBase(),category_property)) {
-                                                    LOG_TASK_WARNING(QString("Failed to set category on object \"%1\" to tree node: %2. Import will be incomplete.").arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
-                                                    result = IExportable::Incomplete;
-                                                }
-                                            }
-                                        }
-
-                                        // Now that we created the item, init its data and children:
-                                        iface->setExportVersion(exportVersion());
-                                        iface->setApplicationExportVersion(applicationExportVersion());
-                                        iface->setExportTask(exportTask());
+                    // Now that we created the item, init its data and children:
+                    iface->setExportVersion(exportVersion());
+                    iface->setApplicationExportVersion(applicationExportVersion());
+                    iface->setExportTask(exportTask());
 
-                                        // Check if it is an observer: if so we must use internal_import_list, not import_list:
-                                        Observer* obs = qobject_cast<Observer*> (iface->objectBase());
-                                        IExportable::ExportResultFlags intermediate_result;
+                    IExportable::ExportResultFlags intermediate_result;
+                    Observer* obs = qobject_cast<Observer*> (obj);
+                    if (obs)
+                        intermediate_result = obs->importCbor(reader,internal_import_list);
+                    else
+                        intermediate_result = iface->importCbor(reader,import_list);
+
+                    if (intermediate_result == IExportable::Incomplete) {
+                        LOG_TASK_WARNING(QString("Failed to reconstruct object completely in tree node: %1. Item \"%2\" will be incomplete.").arg(observer->observerName()).arg(obj->objectName()),exportTask());
+                        result = IExportable::Incomplete;
+                    } else if (intermediate_result & IExportable::FailedResult) {
+                        LOG_TASK_ERROR(QString("Failed to import object in tree node: %1. Item \"%2\" will not be imported.").arg(observer->observerName()).arg(obj->objectName()),exportTask());
+                        result = intermediate_result;
+                    }
 
-                                        if (obs)
-                                            intermediate_result = iface->importXml(doc,&childrenChild,internal_import_list);
-                                        else
-                                            intermediate_result = iface->importXml(doc,&childrenChild,import_list);
+                    iface->clearExportTask();
+                }
+                reader->leaveContainer();
 
-                                        if (intermediate_result == IExportable::Incomplete) {
-                                            LOG_TASK_WARNING(QString("Failed to reconstruct object completely in tree node: %1. Item \"%2\" will be incomplete.").arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
-                                            result = IExportable::Incomplete;
-                                        } else if (intermediate_result & IExportable::FailedResult) {
-                                            LOG_TASK_ERROR(QString("Failed to import object in tree node: %1. Item \"%2\" will not be imported.").arg(observer->observerName()).arg(iface->objectBase()->objectName()),exportTask());
-                                            result = intermediate_result;
-                                        }
+                if (!obj)
+                    continue;
 
-                                        // Check if it is active:
-                                        if (childrenChild.hasAttribute("Activity")) {
-                                            if (childrenChild.attribute("Activity") == QString("Active"))
-                                                active_subjects << iface->objectBase();
-                                        }
+                for (QDomElement category_node = item_node.firstChildElement("Category"); !category_node.isNull(); category_node = category_node.nextSiblingElement("Category"))
+                    importXmlSubjectCategory_1_0(&item_doc,&category_node,obj,import_list,&result);
 
-                                        // Get VisitorID if needed:
-                                        if (export_flags & ExportVisitorIDs) {
-                                            if (childrenChild.hasAttribute("VisitorID")) {
-                                                SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,childrenChild.attribute("VisitorID").toInt());
-                                                ObjectManager::setSharedProperty(iface->objectBase(),visitor_id_prop);
-                                            }
-                                        }
+                // Check if it is active:
+                if (item_node.attribute("Activity") == QLatin1String("Active"))
+                    active_subjects << obj;
 
-                                        iface->clearExportTask();
-                                    } else {
-                                        LOG_TASK_ERROR(QString("Found invalid exportable interface on reconstructed object in tree node: %1").arg(observer->observerName()),exportTask());
-                                        observer->endProcessingCycle();
-                                        return IExportable::Failed;
-                                    }
-                                } else {
-                                    LOG_TASK_WARNING(QString("Factory tag %1 does not exist in factory %2. This item will be skipped and the import will be incomplete.").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
-                                    result = IExportable::Incomplete;
-                                }
-                            } else {
-                                LOG_TASK_WARNING(QString("Factory with name %1 does not exist in the object manager. This item will be skipped and the import will be incomplete.").arg(instanceFactoryInfo.d_factory_tag),exportTask());
-                                result = IExportable::Incomplete;
-                            }
-                        } else {
-                            result = IExportable::Incomplete;
-                            LOG_TASK_WARNING(QString("Found invalid factory data for child on tree node: %1").arg(observer->observerName()),exportTask());
-                        }
-                        continue;
+                // Get VisitorID if needed:
+                if (export_flags & ExportVisitorIDs) {
+                    if (item_node.hasAttribute("VisitorID")) {
+                        SharedProperty visitor_id_prop(qti_prop_VISITOR_ID,item_node.attribute("VisitorID").toInt());
+                        ObjectManager::setSharedProperty(obj,visitor_id_prop);
                     }
                 }
-                continue;
             }
+            reader->leaveContainer();
+            continue;
         }
+
+        reader->next();
     }
+    reader->leaveContainer();
 
-    if (export_flags & ExportRelationalData) {
+    if (reader->hasError()) {
+        LOG_TASK_ERROR(QString("Failed to read CBOR stream for tree node %1: %2").arg(observer->observerName()).arg(reader->errorString()),exportTask());
+        result = IExportable::Failed;
+    }
+
+    if ((export_flags & ExportRelationalData) && result != IExportable::Failed) {
         internal_import_list << observer;
 
         // Construct relationships:
-        if (!constructRelationships(internal_import_list,readback_table))
-            result = IExportable::Incomplete;
-
-        // Cross-check the constructed table:
-        ObserverRelationalTable constructed_table(observer,true);
-        /*if (verbose_output) {
-            LOG_TASK_INFO(QString(tr("Relational verification completed on observer: %1. Here is the contents of the reconstructed table.")).arg(obs->observerName()),exportTask());
-            constructed_table.dumpTableInfo();
-        }*/
-        if (!constructed_table.compare(*readback_table)) {
-            LOG_TASK_WARNING(QString("Relational verification failed on observer: %1").arg(observer->observerName()),exportTask());
+        if (!readback_table || !constructRelationships(internal_import_list,readback_table)) {
             result = IExportable::Incomplete;
         } else {
-            LOG_TASK_INFO(QString("Relational verification successful on observer: %1").arg(observer->observerName()),exportTask());
+            // Cross-check the constructed table:
+            ObserverRelationalTable constructed_table(observer,true);
+            if (!constructed_table.compare(*readback_table)) {
+                LOG_TASK_WARNING(QString("Relational verification failed on observer: %1").arg(observer->observerName()),exportTask());
+                result = IExportable::Incomplete;
+            } else {
+                LOG_TASK_INFO(QString("Relational verification successful on observer: %1").arg(observer->observerName()),exportTask());
+            }
         }
 
         // Remove all relational properties used.
         ObserverRelationalTable::removeRelationalProperties(observer);
     }
 
+    if (readback_table)
+        delete readback_table;
+
     observer->endProcessingCycle();
 
     // If active_subjects has items in it we must set them active:
@@ -1266,6 +3509,152 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     return result;
 }
 
+bool Qtilities::Core::ObserverData::importXmlData_1_0(QDomDocument* doc, QDomElement* subject_data, QList<QPointer<QObject> >& import_list, IExportable::ExportResultFlags* result) {
+    QDomNodeList dataNodes = subject_data->childNodes();
+    for(int i = 0; i < dataNodes.count(); ++i)
+    {
+        QDomNode dataChildNode = dataNodes.item(i);
+        QDomElement dataChild = dataChildNode.toElement();
+
+        if (dataChild.isNull())
+            continue;
+
+        if (dataChild.tagName() == QLatin1String("ObserverHints")) {
+            observer->useDisplayHints();
+            display_hints->setExportVersion(exportVersion());
+            display_hints->setExportTask(exportTask());
+            if (display_hints->importXml(doc,&dataChild,import_list) == IExportable::Failed) {
+                display_hints->clearExportTask();
+                return false;
+            }
+            display_hints->clearExportTask();
+            continue;
+        }
+
+        if (dataChild.tagName() == QLatin1String("ObserverData")) {
+            if (dataChild.hasAttribute("SubjectLimit"))
+                subject_limit = dataChild.attribute("SubjectLimit").toInt();
+            if (dataChild.hasAttribute("Description"))
+                observer_description = dataChild.attribute("Description");
+            if (dataChild.hasAttribute("AccessMode"))
+                access_mode = Observer::stringToAccessMode(dataChild.attribute("AccessMode"));
+            if (dataChild.hasAttribute("AccessModeScope"))
+                access_mode_scope = Observer::stringToAccessModeScope(dataChild.attribute("AccessModeScope"));
+            if (dataChild.hasAttribute("ObjectDeletionPolicy"))
+                object_deletion_policy = Observer::stringToObjectDeletionPolicy(dataChild.attribute("ObjectDeletionPolicy"));
+
+            // Category stuff:
+            QDomNodeList childNodes = dataChild.childNodes();
+            for(int i = 0; i < childNodes.count(); ++i)
+            {
+                QDomNode childNode = childNodes.item(i);
+                QDomElement child = childNode.toElement();
+
+                if (child.isNull())
+                    continue;
+
+                if (child.tagName() == QLatin1String("Categories")) {
+                    QDomNodeList categoryNodes = child.childNodes();
+                    for(int i = 0; i < categoryNodes.count(); ++i)
+                    {
+                        QDomNode categoryNode = categoryNodes.item(i);
+                        QDomElement category = categoryNode.toElement();
+
+                        if (category.isNull())
+                            continue;
+
+                        if (category.tagName() == QLatin1String("Categories")) {
+                            QtilitiesCategory new_category;
+                            new_category.setExportVersion(exportVersion());
+                            new_category.setExportTask(exportTask());
+                            new_category.importXml(doc,&category,import_list);
+                            if (new_category.isValid()) {
+                                categories << new_category;
+                                invalidateCategoryAccessModes();
+                            }
+                            new_category.clearExportTask();
+                            continue;
+                        }
+                    }
+                    continue;
+                }
+            }
+            continue;
+        }
+
+        if (dataChild.tagName() == QLatin1String("SubjectFilter")) {
+            // Construct and init the subject filter:
+            InstanceFactoryInfo instanceFactoryInfo(doc,&dataChild,exportVersion());
+            if (instanceFactoryInfo.isValid()) {
+                LOG_TASK_TRACE(QString("Importing subject type \"%1\" in factory \"%2\"...").arg(instanceFactoryInfo.d_instance_tag).arg(instanceFactoryInfo.d_factory_tag),exportTask());
+
+                IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
+                if (ifactory) {
+                    QObject* obj = ifactory->createInstance(instanceFactoryInfo);
+                    if (obj) {
+                        obj->setObjectName(instanceFactoryInfo.d_instance_name);
+                        AbstractSubjectFilter* abstract_filter = qobject_cast<AbstractSubjectFilter*> (obj);
+                        if (abstract_filter) {
+                            abstract_filter->setExportVersion(exportVersion());
+                            abstract_filter->setExportTask(exportTask());
+                            if (abstract_filter->importXml(doc,&dataChild,import_list) == IExportable::Failed) {
+                                LOG_TASK_ERROR(QString("Failed to import subject filter \"%1\" for tree node: \"%2\". Importing will not continue.").arg(instanceFactoryInfo.d_instance_tag).arg(observer->observerName()),exportTask());
+                                delete abstract_filter;
+                                *result = IExportable::Failed;
+                            }
+                            abstract_filter->clearExportTask();
+                            if (!observer->installSubjectFilter(abstract_filter)) {
+                                LOG_TASK_DEBUG(QString("Failed to install subject filter \"%1\" for tree node: \"%2\". If this filter already existed this is not a problem.").arg(instanceFactoryInfo.d_instance_tag).arg(observer->observerName()),exportTask());
+                                delete abstract_filter;
+                            }
+                        }
+                    }
+                }
+            } else
+                LOG_TASK_WARNING(QString("Found invalid factory data for subject filter on tree node: %1").arg(observer->observerName()),exportTask());
+            continue;
+        }
+
+        // Tree nodes export their value items next to their formatting:
+        if (dataChild.tagName() == QLatin1String("Formatting") || dataChild.tagName() == QLatin1String("ValueItems")) {
+            IExportableFormatting* formatting_iface = qobject_cast<IExportableFormatting*> (observer->objectBase());
+            if (formatting_iface) {
+                if (formatting_iface->importFormattingXML(doc,&dataChild,exportVersion()) != IExportable::Complete) {
+                    LOG_TASK_WARNING(QString("Failed to import formatting for tree node: \"%1\"").arg(observer->observerName()),exportTask());
+                    *result = IExportable::Incomplete;
+                }
+            }
+            continue;
+        }
+    }
+
+    return true;
+}
+
+void Qtilities::Core::ObserverData::importXmlSubjectCategory_1_0(QDomDocument* doc, QDomElement* category_node, QObject* obj, QList<QPointer<QObject> >& import_list, IExportable::ExportResultFlags* result) {
+    // We just created this object, it will not have a category property yet so no need to check if it needs one:
+    QtilitiesCategory category;
+    category.setExportVersion(exportVersion());
+    category.setExportTask(exportTask());
+    IExportable::ExportResultFlags category_result = category.importXml(doc,category_node,import_list);
+    category.clearExportTask();
+
+    if (category_result == IExportable::Incomplete) {
+        LOG_TASK_WARNING(QString("Failed to import category completely for object in tree node: %1. Item \"%2\" will not have its category set.").arg(observer->observerName()).arg(obj->objectName()),exportTask());
+        *result = IExportable::Incomplete;
+    } else if (category_result & IExportable::FailedResult) {
+        LOG_TASK_ERROR(QString("Failed to import category for object in tree node: %1. Item \"%2\" will not have its category set.").arg(observer->observerName()).arg(obj->objectName()),exportTask());
+        *result = category_result;
+    }
+
+    MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
+    category_property.setValue(qVariantFromValue(category),observer->observerID());
+    if (!ObjectManager::setMultiContextProperty(obj,category_property)) {
+        LOG_TASK_WARNING(QString("Failed to set category on object \"%1\" to tree node: %2. Import will be incomplete.").arg(observer->observerName()).arg(obj->objectName()),exportTask());
+        *result = IExportable::Incomplete;
+    }
+}
+
 bool Qtilities::Core::ObserverData::constructRelationships(QList<QPointer<QObject> >& objects, ObserverRelationalTable* table) const {
     if (!table)
         return false;
@@ -1513,8 +3902,12 @@ QList<IExportable*> Qtilities::Core::ObserverData::getLimitedExportsList(QList<Q
                     *complete = false;
             } else {
                 // Handle limited export object, thus they should only be exported once.
+                // Worker threads only export independent subtrees in which objects appear once, they must not set properties on objects living in other threads.
                 int count = ObjectManager::getSharedProperty(obj,qti_prop_LIMITED_EXPORTS).value().toInt();
-                if (count == 0) {
+                if (QThread::currentThread() != observer->thread()) {
+                    exportable_list << iface;
+                    ++iface_count;
+                } else if (count == 0) {
                     SharedProperty limited_exports_prop(qti_prop_LIMITED_EXPORTS,count+1);
                     ObjectManager::setSharedProperty(obj,limited_exports_prop);
                     exportable_list << iface;
@@ -1532,3 +3925,73 @@ QList<IExportable*> Qtilities::Core::ObserverData::getLimitedExportsList(QList<Q
     //qDebug() << "getLimitedExportsList() on " + observer->observerName() + ": input list count = " + QString::number(objects.count()) + ", exportable list count = " + QString::number(exportable_list.count());
     return exportable_list;
 }
+
+bool Qtilities::Core::ObserverData::isIndependentExportSubtree(const Observer* obs) {
+    if (Observer::parentCount(obs) > 1)
+        return false;
+
+    obs->observerData->completeDeferredImport();
+    const PointerList& subjects = obs->observerData->subject_list;
+    for (int i = 0; i < subjects.count(); ++i) {
+        QObject* obj = subjects.at(i);
+        Observer* child_obs = qobject_cast<Observer*> (obj);
+        if (child_obs) {
+            if (!isIndependentExportSubtree(child_obs))
+                return false;
+        } else if (Observer::parentCount(obj) > 1)
+            return false;
+    }
+
+    return true;
+}
+
+QVector<Qtilities::Core::ObserverDataExportWorker*> Qtilities::Core::ObserverData::exportIndependentSubtrees(const QList<IExportable*>& exportable_list, ExportItemFlags export_flags, IExportable::ExportMode export_mode, const QDataStream* stream_format) const {
+    QVector<ObserverDataExportWorker*> workers(exportable_list.count(),0);
+    if (!(export_flags & ExportParallel) || QThread::idealThreadCount() < 2)
+        return workers;
+    // Subtrees are only scheduled from the observer's own thread, inside workers subtrees are exported serially:
+    if (QThread::currentThread() != observer->thread())
+        return workers;
+
+    QList<int> independent_subtrees;
+    for (int i = 0; i < exportable_list.count(); ++i) {
+        Observer* obs = qobject_cast<Observer*> (exportable_list.at(i)->objectBase());
+        if (!obs || !(obs->supportedFormats() & export_mode))
+            continue;
+        if (obs->observerData->treeSize() < PARALLEL_EXPORT_MINIMUM_TREE_SIZE)
+            continue;
+        if (!isIndependentExportSubtree(obs)) {
+            LOG_TASK_TRACE(QString("Subtree of \"%1\" contains shared subjects and will be exported serially.").arg(obs->observerName()),exportTask());
+            continue;
+        }
+        independent_subtrees << i;
+    }
+
+    // A single subtree does not gain anything from a thread:
+    if (independent_subtrees.count() < 2)
+        return workers;
+
+    LOG_TASK_TRACE(QString("Exporting %1 independent subtrees of observer \"%2\" concurrently...").arg(independent_subtrees.count()).arg(observer->observerName()),exportTask());
+
+    ExportItemFlags child_obs_flags = export_flags;
+    child_obs_flags &= ~ExportRelationalData;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(QThread::idealThreadCount());
+    for (int i = 0; i < independent_subtrees.count(); ++i) {
+        int position = independent_subtrees.at(i);
+        Observer* obs = qobject_cast<Observer*> (exportable_list.at(position)->objectBase());
+        obs->setExportVersion(exportVersion());
+        obs->setApplicationExportVersion(applicationExportVersion());
+        // Tasks are not thread safe, thus workers log their messages without it:
+        obs->clearExportTask();
+
+        IExportableObserver* export_iface_obs = qobject_cast<IExportableObserver*> (obs->objectBase());
+        Q_ASSERT(export_iface_obs);
+        workers[position] = new ObserverDataExportWorker(export_iface_obs,child_obs_flags,export_mode,stream_format);
+        pool.start(workers.at(position));
+    }
+    pool.waitForDone();
+
+    return workers;
+}
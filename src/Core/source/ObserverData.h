@@ -19,16 +19,26 @@
 #include "QtilitiesCategory.h"
 #include "AbstractSubjectFilter.h"
 #include "IExportable.h"
+#include "ObserverSnapshot.h"
 
 #include <QSharedData>
+#include <QSharedPointer>
 #include <QObject>
 #include <QMutex>
+#include <QPointer>
+#include <QReadWriteLock>
+#include <QVariant>
 #include <QHash>
+#include <QSet>
+#include <QVector>
 
 namespace Qtilities {
     namespace Core {
         class ObserverHints;
         class ObserverRelationalTable;
+        class ObserverDataExportWorker;
+        struct ObserverDataDeferredImport;
+        struct ObserverDataCloneContext;
         using namespace Qtilities::Core::Interfaces;
         using namespace Qtilities::Core::Constants;
 
@@ -38,6 +48,18 @@ namespace Qtilities {
 
           Each Observer holds an explicitly shared data pointer to an ObserverData object.
 
+          <b>Concurrency</b>
+
+          An observer is only modified from the thread it lives in. Other threads can read its subjects through subjectSnapshot(), which is
+          used by Observer::subjectCount(), Observer::subjectAt(), Observer::subjectReferences() and Observer::subjectNames() when they are
+          called from another thread. Changes to subject_list are made while subject_lock is locked for writing, and snapshots are taken while
+          it is locked for reading, thus any number of readers can share a snapshot while writes are serialized. During a processing cycle the
+          snapshot taken when the cycle started is kept, thus readers only see the subjects at processing cycle boundaries. Only the list of
+          subjects is protected, the subjects themselves and their properties are not.
+
+          Other threads change an observer by posting operations to it, see Observer::postAttachSubjects(). The posted operations are the only
+          members which are written by other threads, they are protected by posted_operations_mutex.
+
           \sa Observer
           */
         class QTILIITES_CORE_SHARED_EXPORT ObserverData : public IExportable
@@ -51,6 +73,7 @@ namespace Qtilities {
                 ExportData                  = 1, /*!< Exports all observer data, subjects and their children. */
                 ExportVisitorIDs            = 2, /*!< XML Only: Indicates that VisitorIDs must be added to subject nodes. This is needed when ExportRelationalData is used, and therefore it is automatically enabled in that case.  */
                 ExportRelationalData        = 4, /*!< Indicates that an ObserverRelationalTable must be constructed for the observer and it must be exported with the observer data. During extended imports the relational structure of the tree under your observer will be reconstructed. */
+                ExportParallel              = 8, /*!< Binary and XML only: Child observers whose subtrees do not contain subjects with multiple parents are exported concurrently on a thread pool. Their subjects must support being exported from a thread other than the one they live in. The streaming XML export is always serial. This flag is not stored in exported files. <i>This flag was added in %Qtilities v1.5.</i> */
                 ExportAllItems             = ExportData | ExportVisitorIDs | ExportRelationalData
             };
             Q_DECLARE_FLAGS(ExportItemFlags, ExportItem)
@@ -71,9 +94,29 @@ namespace Qtilities {
                 object_deletion_policy(0),
                 number_of_subjects_start_of_proc_cycle(0),
                 broadcast_modification_state_changes(true),
-                modification_state_start_of_proc_cycle(false)
+                modification_state_start_of_proc_cycle(false),
+                subject_index_valid_count(0),
+                metadata_valid_count(0),
+                pending_subjects_reset(false),
+                pending_data_changed_all(false),
+                coalesce_view_refreshes(false),
+                pending_refresh_layout(false),
+                pending_refresh_data(false),
+                refresh_delivery_queued(false),
+                tree_size(-1),
+                deferred_import(0),
+                defer_subject_import(false),
+                subject_lock(),
+                subject_snapshot_valid(false),
+                subject_snapshot_used(false),
+                property_routes_valid(false),
+                notified_modification_state(false),
+                category_access_modes_valid(false),
+                subjects_revision(0),
+                posted_operations_queued(false)
             {
                 subject_list.setObjectName(observer_name);
+                subject_list.setWriteLock(&subject_lock);
             }
 
             ObserverData(const ObserverData &other) : IObjectBase(), IExportable(), subject_list(other.subject_list),
@@ -95,7 +138,36 @@ namespace Qtilities {
                 object_deletion_policy(other.object_deletion_policy),
                 number_of_subjects_start_of_proc_cycle(0),
                 broadcast_modification_state_changes(true),
-                modification_state_start_of_proc_cycle(false) {}
+                modification_state_start_of_proc_cycle(false),
+                subject_index(other.subject_index),
+                subject_id_index(other.subject_id_index),
+                subject_index_valid_count(other.subject_index_valid_count),
+                subject_categories(other.subject_categories),
+                subject_category_positions(other.subject_category_positions),
+                category_subjects(other.category_subjects),
+                uncategorized_subjects(other.uncategorized_subjects),
+                metadata_valid_count(other.metadata_valid_count),
+                pending_subjects_reset(false),
+                pending_data_changed_all(false),
+                coalesce_view_refreshes(false),
+                pending_refresh_layout(false),
+                pending_refresh_data(false),
+                refresh_delivery_queued(false),
+                tree_size(-1),
+                deferred_import(0),
+                defer_subject_import(false),
+                subject_lock(),
+                subject_snapshot_valid(false),
+                subject_snapshot_used(false),
+                property_routes_valid(false),
+                modified_subjects(other.modified_subjects),
+                notified_modification_state(false),
+                category_access_modes_valid(false),
+                subjects_revision(0),
+                posted_operations_queued(false) {
+                subject_list.setWriteLock(&subject_lock);
+            }
+            ~ObserverData();
 
             // --------------------------------
             // IObjectBase Implementation
@@ -120,6 +192,10 @@ namespace Qtilities {
             IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
             IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
             IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportCbor(CborStreamWriter* writer) const;
+            IExportable::ExportResultFlags importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
             // --------------------------------
             // Extended Access Call Functions From Observer
@@ -128,6 +204,278 @@ namespace Qtilities {
             IExportable::ExportResultFlags exportBinaryExt(QDataStream& stream, ExportItemFlags export_flags) const;
             //! Extended XML export function.
             IExportable::ExportResultFlags exportXmlExt(QDomDocument* doc, QDomElement* object_node, ExportItemFlags export_flags) const;
+            //! Extended streaming XML export function, see IExportableObserver::exportXmlStreamExt().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            IExportable::ExportResultFlags exportXmlStreamExt(QXmlStreamWriter* writer, ExportItemFlags export_flags, const QDomElement* leading_elements = 0) const;
+            //! Extended streaming XML import function, see IExportableObserver::importXmlStreamExt().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            IExportable::ExportResultFlags importXmlStreamExt(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list, QDomElement* other_elements = 0);
+            //! Extended CBOR export function, see IExportableObserver::exportCborExt().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            IExportable::ExportResultFlags exportCborExt(CborStreamWriter* writer, ExportItemFlags export_flags) const;
+
+            // --------------------------------
+            // Subject Index
+            // --------------------------------
+            //! Appends a subject to subject_list and adds it to the subject index.
+            /*!
+              \param obj The subject to append.
+              \param subject_id The ID of the subject in the observer's context. Use -1 for subjects without IDs, for example subjects of the global object pool.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void appendSubject(QObject* obj, int subject_id = -1);
+            //! Removes a subject from subject_list and from the subject index.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeSubject(QObject* obj);
+            //! Removes a subject from the subject index only.
+            /*!
+              Used for subjects which were destroyed, in which case subject_list already removed the subject itself.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeSubjectFromIndex(const QObject* obj);
+            //! Removes a list of subjects from subject_list and from the subject index in a single pass.
+            /*!
+              The subjects are disconnected from subject_list, thus they can be deleted afterwards without being reported
+              as destroyed subjects. A single reset is recorded instead of a change for every subject.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeSubjects(const QList<QObject*>& objects);
+            //! Returns a snapshot of subject_list which can be used from any thread.
+            /*!
+              The snapshot is shared by all readers until the subjects change. Subjects in the snapshot might be destroyed at any time
+              after the snapshot was taken, and subjects of which the import was deferred are not included.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<QObject*> subjectSnapshot() const;
+            //! Takes a snapshot of the subjects at the start of a processing cycle when other threads read the subjects, which is kept until invalidateSubjectSnapshot() is called at the end of the cycle.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void freezeSubjectSnapshot();
+            //! Invalidates the snapshot returned by subjectSnapshot() after subject_list changed, unless a processing cycle is active.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void invalidateSubjectSnapshot();
+            //! Records a change to subject_list which must be reported to views using Observer::subjectsInserted() or Observer::subjectsRemoved().
+            /*!
+              Consecutive changes are merged into a single range. When too many changes are pending, or when \p first is -1,
+              the pending changes are replaced by a reset which is reported using Observer::subjectsReset().
+
+              \param change The type of change.
+              \param first The first position which changed. For removals the position the subject had before it was removed.
+              \param last The last position which changed.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void recordSubjectChange(int change, int first, int last);
+            //! Records a change to the data of obj which must be reported to views using Observer::subjectDataChanged().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void recordSubjectDataChange(QObject* obj);
+            //! Clears all pending subject changes.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void clearSubjectChanges();
+            //! Returns the subjects which inherit a class or interface, see QObject::inherits().
+            /*!
+              Results are cached per class name, and are kept up to date as subjects are added and removed. Thus only the first call for a
+              class name checks every subject.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<QObject*> subjectsInheriting(const QByteArray& class_name);
+            //! Removes \p obj from the cached results of subjectsInheriting().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeFromSubjectTypeCache(const QObject* obj);
+            //! Returns the number of items in the tree underneath the observer, thus the number of items TreeIterator visits below it.
+            /*!
+              The size is cached and only recalculated for observers in which the tree changed since the last call.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int treeSize() const;
+            //! Invalidates the cached tree size of the observer and of all observers above it in the tree.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void invalidateTreeSize();
+            //! Returns a snapshot of the tree underneath the observer, see Observer::treeSnapshot().
+            /*!
+              The snapshot is cached, thus only observers in which the tree changed since their last snapshot create new snapshots.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObserverSnapshot treeSnapshot() const;
+            //! Drops the cached tree snapshot of the observer and of all observers above it in the tree.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void invalidateTreeSnapshot();
+            //! Indicates if the import of the subjects of the observer was deferred until they are accessed.
+            /*!
+              \sa CompactBinaryFormat::setDeferredImportSource()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline bool hasDeferredImport() const { return deferred_import != 0; }
+            //! Flags describing how Observer::eventFilter() handles changes to a property, see PropertyRoute.
+            enum PropertyRouteFlag {
+                PropertyReserved        = 1, /*!< The property is in Observer::reservedProperties(). */
+                PropertyMonitored       = 2, /*!< The property is in Observer::monitoredProperties(). */
+                PropertyRefreshesData   = 4, /*!< Changes to the property change the data of the subject shown in views. */
+                PropertyRefreshesLayout = 8  /*!< Changes to the property can change the layout of views. */
+            };
+            //! Describes how Observer::eventFilter() handles changes to a property.
+            struct PropertyRoute {
+                PropertyRoute() : flags(0) {}
+                //! A combination of PropertyRouteFlag values, 0 for properties which the observer does not reserve or monitor.
+                int flags;
+                //! The installed subject filters of which AbstractSubjectFilter::monitoredProperties() contains the property.
+                QList<AbstractSubjectFilter*> filters;
+            };
+            //! Returns the route of \p property_name.
+            /*!
+              The routes of all reserved and monitored properties are collected once, thus events for properties which the observer
+              does not handle are rejected with a single lookup. The routes are rebuilt after invalidatePropertyRoutes() was called.
+
+              \note The property lists of subject filters must not change while they are installed.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            PropertyRoute propertyRoute(const QByteArray& property_name) const;
+            //! Drops the routes returned by propertyRoute(), called when subject filters are installed or uninstalled.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline void invalidatePropertyRoutes() { property_routes_valid = false; property_routes.clear(); }
+            //! Queues a QtilitiesPropertyChangeEvent for \p obj, posted by Observer::endProcessingCycle().
+            /*!
+              Multiple changes to the same property of a subject during a processing cycle result in a single event.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void queuePropertyChangeEvent(QObject* obj, const QByteArray& property_name);
+            //! Imports the subjects of the observer when their import was deferred, does nothing otherwise.
+            /*!
+              Called by all Observer functions which access subjects, thus subjects are imported the first time they are needed.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline void completeDeferredImport() const {
+                if (deferred_import)
+                    const_cast<ObserverData*> (this)->importDeferredSubjects();
+            }
+            //! Returns true if obj is a subject, using the subject index.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline bool containsSubject(const QObject* obj) const { return subject_index.contains(obj); }
+            //! Returns the subject with the specified ID, or 0 if no subject has that ID.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline QObject* subjectWithID(int subject_id) const { return subject_id_index.value(subject_id,0); }
+            //! Returns the position of obj in subject_list, or -1 if obj is not a subject.
+            /*!
+              Positions behind removed subjects are updated lazily the first time they are needed.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int subjectPosition(const QObject* obj) const;
+            //! Reserves space for \p size subjects in subject_list and in the subject index.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void reserveSubjects(int size);
+            //! Returns the index entry of obj, or 0 if obj is not a subject or when its metadata was not read yet.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline const SubjectIndexEntry* subjectMetadata(const QObject* obj) const {
+                QHash<const QObject*,SubjectIndexEntry>::const_iterator itr = subject_index.constFind(obj);
+                if (itr == subject_index.constEnd() || !(itr.value().flags & MetadataValid))
+                    return 0;
+                return &itr.value();
+            }
+            //! Reads all typed metadata of obj from its properties.
+            /*!
+              Does nothing when obj is not a subject.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void updateSubjectMetadata(const QObject* obj);
+            //! Reads the typed metadata which depends on \p property_name from the properties of obj.
+            /*!
+              Does nothing when obj is not a subject, or when \p property_name is not a property for which metadata is kept.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void updateSubjectMetadata(const QObject* obj, const char* property_name);
+            //! Returns true if typed metadata is kept for \p property_name.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static bool isSubjectMetadataProperty(const char* property_name);
+            //! Returns true when the metadata of all subjects was read, thus the category index can answer category queries.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline bool isCategoryIndexComplete() const { return metadata_valid_count == subject_index.count(); }
+            //! Returns the position of \p category in subject_categories, or -1 if no subject used it in this context yet.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int subjectCategoryPosition(const QtilitiesCategory& category) const;
+            //! Returns the subjects in \p category, in the order of subject_list. When \p category is empty, subjects without a category are returned as well.
+            /*!
+              Only valid when isCategoryIndexComplete() is true.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<QObject*> subjectsInCategory(const QtilitiesCategory& category) const;
+            //! Returns the access mode defined for \p category in categories, or -1 if no access mode was defined for it.
+            /*!
+              The modes are looked up in a table keyed by category ID, which is rebuilt after invalidateCategoryAccessModes() was called.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int definedCategoryAccessMode(const QtilitiesCategory& category) const;
+            //! Drops the table used by definedCategoryAccessMode(), must be called whenever categories changes.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline void invalidateCategoryAccessModes() { category_access_modes_valid = false; category_access_modes.clear(); }
+
+            // --------------------------------
+            // Cloning
+            // --------------------------------
+            //! Clones the observer and the tree underneath it, see Observer::cloneTree().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            Observer* cloneTree(bool* complete) const;
+            //! Clones \p subjects and the trees underneath them, and attaches the clones to \p target, see Observer::cloneSubjects().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<QPointer<QObject> > cloneSubjects(Observer* target, const QList<QObject*>& subjects, bool* complete) const;
 
             // --------------------------------
             // Export Implementations For Different Qtilities Versions
@@ -135,8 +483,66 @@ namespace Qtilities {
         private:
             IExportable::ExportResultFlags exportBinaryExt_1_0(QDataStream& stream, ExportItemFlags export_flags) const;
             IExportable::ExportResultFlags importBinaryExt_1_0(QDataStream& stream, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportBinaryExt_1_5(QDataStream& stream, ExportItemFlags export_flags) const;
+            IExportable::ExportResultFlags importBinaryExt_1_5(QDataStream& stream, QList<QPointer<QObject> >& import_list);
+            //! Writes the data of exportBinaryExt_1_5() using the compact encoding of CompactBinaryFormat, \p stream must have an active string table.
+            IExportable::ExportResultFlags exportBinaryCompact_1_5(QDataStream& stream, ExportItemFlags export_flags) const;
+            //! Reads the data written by exportBinaryCompact_1_5(), \p stream must have an active string table.
+            IExportable::ExportResultFlags importBinaryCompact_1_5(QDataStream& stream, QList<QPointer<QObject> >& import_list);
+            //! Reads the subjects written by exportBinaryCompact_1_5() and attaches them to the observer.
+            /*!
+              \param success Set to false when a subject could not be attached or imported.
+              \param complete Set to false when a subject was skipped, or when its import was incomplete.
+              \returns False when the import cannot continue.
+              */
+            bool importBinarySubjects_1_5(QDataStream& stream, int iface_count, quint32 export_flags, Qtilities::ExportVersion version, quint32 application_version,
+                                          QList<QPointer<QObject> >& import_list, QList<QPointer<QObject> >& internal_import_list, bool* success, bool* complete);
+            //! Skips the subjects written by exportBinaryCompact_1_5() and stores what is needed to import them later in deferred_import.
+            /*!
+              \returns False when the subjects could not be skipped.
+              */
+            bool deferBinarySubjects_1_5(QDataStream& stream, int iface_count, quint32 export_flags, const QByteArray& source_data, QSharedPointer<QObject> source_owner);
+            //! Imports the subjects of which the import was deferred by deferBinarySubjects_1_5().
+            void importDeferredSubjects();
+            //! Returns the clone of \p obj in \p context, and creates it and the clones of the tree underneath it when \p obj was not cloned yet.
+            /*!
+              \returns The clone, or 0 when \p obj can't be cloned.
+              */
+            static QObject* cloneObject(QObject* obj, ObserverDataCloneContext* context);
+            //! Copies the data of \p source which is copied by Observer::cloneTree() to this observer data.
+            void copyObserverData(const ObserverData& source, ObserverDataCloneContext* context);
+            //! Copies the properties of \p source to its clone \p target, moving the contexts of multi context properties to the clones of their observers.
+            static void cloneObjectProperties(const QObject* source, QObject* target, const ObserverDataCloneContext* context);
+            //! Copies the properties of all clones in \p context, attaches the clones to the clones of their parents and attaches \p top_level_clones to \p target.
+            /*!
+              Clones which were not attached to any observer are deleted, except \p root_clone.
+
+              \returns The clones which were attached to \p target.
+              */
+            static QList<QPointer<QObject> > publishClones(ObserverDataCloneContext* context, Observer* target, const QList<QObject*>& top_level_clones, QObject* root_clone);
             IExportable::ExportResultFlags exportXmlExt_1_0(QDomDocument* doc, QDomElement* object_node, ExportItemFlags export_flags) const;
             IExportable::ExportResultFlags importXmlExt_1_0(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportXmlStreamExt_1_0(QXmlStreamWriter* writer, ExportItemFlags export_flags, const QDomElement* leading_elements) const;
+            IExportable::ExportResultFlags importXmlStreamExt_1_0(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list, QDomElement* other_elements);
+            //! Writes the observer as a CBOR map, subjects which are not observers are written using their IExportable::exportCbor() implementations.
+            IExportable::ExportResultFlags exportCborExt_1_0(CborStreamWriter* writer, ExportItemFlags export_flags) const;
+            IExportable::ExportResultFlags importCbor_1_0(CborStreamReader* reader, QList<QPointer<QObject> >& import_list);
+            //! Exports the \p Data element of the observer, used by both the QDomDocument and the streaming XML exports.
+            IExportable::ExportResultFlags exportXmlData_1_0(QDomDocument* doc, QDomElement* subject_data) const;
+            //! Imports the \p Data element of the observer, used by both the QDomDocument and the streaming XML imports.
+            /*!
+              \returns False when the import must be aborted. Failures which do not abort the import are reported through \p result.
+              */
+            bool importXmlData_1_0(QDomDocument* doc, QDomElement* subject_data, QList<QPointer<QObject> >& import_list, IExportable::ExportResultFlags* result);
+            //! Returns the subjects which must be exported to XML, \p complete is set to false when not all subjects are exportable.
+            QList<IExportable*> xmlExportableSubjects(ExportItemFlags export_flags, bool* complete) const;
+            //! Adds the information about a subject which is stored by the observer to the \p TreeItem element of the subject, used by both the QDomDocument and the streaming XML exports.
+            /*!
+              \returns False when the instance factory information of the subject could not be exported.
+              */
+            bool exportXmlSubjectItem_1_0(QDomDocument* doc, QDomElement* subject_item, IExportable* export_iface, ExportItemFlags export_flags) const;
+            //! Imports the category of a subject from the \p Category element of its \p TreeItem element, used by both the QDomDocument and the streaming XML imports.
+            void importXmlSubjectCategory_1_0(QDomDocument* doc, QDomElement* category_node, QObject* obj, QList<QPointer<QObject> >& import_list, IExportable::ExportResultFlags* result);
 
             //! Construct relationships between a list of objects with the relational data being passed to the function as a RelationalObserverTable.
             bool constructRelationships(QList<QPointer<QObject> >& objects, ObserverRelationalTable* table) const;
@@ -145,6 +551,20 @@ namespace Qtilities {
               In this case, we need to make sure objects appearing multiple times in the tree is not exported more than once. This is done using qti_prop_LIMITED_EXPORTS.
               */
             QList<IExportable*> getLimitedExportsList(QList<QObject* > objects, IExportable::ExportMode export_mode, bool * complete = 0) const;
+            //! Checks if the subtree of an observer can be exported independently, thus if neither the observer nor any object underneath it has more than one parent.
+            static bool isIndependentExportSubtree(const Observer* obs);
+            //! Exports the child observers in \p exportable_list with independent subtrees concurrently when ExportParallel is set.
+            /*!
+              Subtrees are only scheduled from the thread the observer lives in, thus subtrees are exported serially inside worker threads. Child observers
+              which are too small to be worth a thread, or with subtrees which are not independent, are left to the caller to export serially.
+
+              \param exportable_list The subjects being exported.
+              \param export_flags The export flags of this observer.
+              \param export_mode The type of export, IExportable::Binary or IExportable::XML.
+              \param stream_format When \p export_mode is IExportable::Binary, the stream which the workers' buffers must be compatible with.
+              \returns The finished workers indexed by the position of their subjects in \p exportable_list, 0 for subjects which must be exported serially. The caller must delete the workers.
+              */
+            QVector<ObserverDataExportWorker*> exportIndependentSubtrees(const QList<IExportable*>& exportable_list, ExportItemFlags export_flags, IExportable::ExportMode export_mode, const QDataStream* stream_format = 0) const;
 
             // --------------------------------
             // All Data Stored For An Observer
@@ -188,6 +608,150 @@ namespace Qtilities {
             bool                                broadcast_modification_state_changes;
             //! Used during processing cycles to store the modification state of the observer when a processing cycle is started. When different when the processing cycle is stopped, only then will it emit that the modification state changed.
             bool                                modification_state_start_of_proc_cycle;
+
+            //! The types of changes to subject_list recorded by recordSubjectChange().
+            enum SubjectChange {
+                SubjectsInserted    = 0, /*!< Subjects were inserted. */
+                SubjectsRemoved     = 1  /*!< Subjects were removed. */
+            };
+            //! A range of positions in subject_list which changed, recorded by recordSubjectChange().
+            struct SubjectChangeRange {
+                SubjectChangeRange(int change = SubjectsInserted, int first = -1, int last = -1) : change(change), first(first), last(last) {}
+                int change;
+                int first;
+                int last;
+            };
+            //! Flags describing the typed subject metadata stored in a SubjectIndexEntry.
+            enum SubjectMetadataFlag {
+                MetadataValid   = 1, /*!< The metadata fields of the entry were read from the subject's properties. */
+                HasAlias        = 2  /*!< The subject has a qti_prop_ALIAS_MAP value in this context. */
+            };
+            //! An entry in the subject index.
+            /*!
+              Apart from the position and ID of the subject, the entry holds typed copies of the Qtilities properties which the observer
+              reads frequently. The dynamic properties on the subject remain the authoritative data used for exports and by code outside of the observer,
+              the entry is kept in sync with them by updateSubjectMetadata().
+              */
+            struct SubjectIndexEntry {
+                SubjectIndexEntry(int position = -1, int subject_id = -1) : position(position), subject_id(subject_id),
+                    ownership(0), parent_id(-1), category_index(-1), flags(0) {}
+                int position;
+                int subject_id;
+                //! The Observer::ObjectOwnership of the subject, from qti_prop_OWNERSHIP.
+                int ownership;
+                //! The observer ID in qti_prop_PARENT_ID.
+                int parent_id;
+                //! The index of the subject's category in subject_categories, -1 when the subject has no category in this context.
+                int category_index;
+                //! The alias of the subject in this context, from qti_prop_ALIAS_MAP. Only valid when flags contains HasAlias.
+                QString alias;
+                int flags;
+            };
+            //! Index of all subjects in subject_list, used to avoid linear scans through subject_list on large observers.
+            /*!
+              \note Must be kept in sync with subject_list, thus subjects must be added and removed through appendSubject() and removeSubject().
+              */
+            mutable QHash<const QObject*,SubjectIndexEntry> subject_index;
+            //! Maps subject IDs to subjects.
+            QHash<int,QObject*>                 subject_id_index;
+            //! The positions in subject_index are only valid for positions smaller than this count.
+            mutable int                         subject_index_valid_count;
+            //! The categories used by subjects in this context, referenced by SubjectIndexEntry::category_index.
+            QVector<QtilitiesCategory>          subject_categories;
+            //! Maps QtilitiesCategory::categoryID() of the categories in subject_categories to their positions in subject_categories.
+            QHash<int,int>                      subject_category_positions;
+            //! The subjects in each category of subject_categories, at the same positions as subject_categories.
+            QVector<QSet<const QObject*> >      category_subjects;
+            //! The subjects which do not have a category in this context.
+            QSet<const QObject*>                uncategorized_subjects;
+            //! The number of entries in subject_index of which the flags contain MetadataValid.
+            int                                 metadata_valid_count;
+            //! Changes to subject_list which were not reported to views yet. Reported directly after the change, or when the processing cycle ends.
+            QList<SubjectChangeRange>           pending_subject_changes;
+            //! Indicates that the pending changes could not be described by ranges, thus views must be reset.
+            bool                                pending_subjects_reset;
+            //! Subjects of which the data changed during the current processing cycle.
+            QList<QPointer<QObject> >           pending_data_changed_subjects;
+            //! Indicates that too many subjects' data changed during the current processing cycle to report them individually.
+            bool                                pending_data_changed_all;
+            //! Indicates that view refreshes are coalesced, see Observer::toggleViewRefreshCoalescing().
+            bool                                coalesce_view_refreshes;
+            //! Set by Observer::refreshViewsLayout() until the layout refresh is delivered to views.
+            bool                                pending_refresh_layout;
+            //! Set by Observer::refreshViewsData() until the data refresh is delivered to views.
+            bool                                pending_refresh_data;
+            //! Indicates that Observer::deliverViewRefreshes() was posted to the event loop and did not run yet.
+            bool                                refresh_delivery_queued;
+            //! The union of the selections passed to Observer::refreshViewsLayout() since the layout refresh was last delivered.
+            QList<QPointer<QObject> >           pending_refresh_selection;
+            //! Subjects attached using Observer::attachSubjects() during the current processing cycle. Reported by numberOfSubjectsChanged() when the cycle ends.
+            QList<QPointer<QObject> >           proc_cycle_attached_subjects;
+            //! Subjects detached using Observer::detachSubjects() during the current processing cycle. Reported by numberOfSubjectsChanged() when the cycle ends.
+            QList<QPointer<QObject> >           proc_cycle_detached_subjects;
+            //! Results of subjectsInheriting(), keyed by class name. Updated whenever subjects are added or removed.
+            QHash<QByteArray,QList<QObject*> >  subject_type_cache;
+            //! The cached result of treeSize(), -1 when it must be recalculated.
+            /*!
+              \note When the size of an observer is invalid, the sizes of all observers above it are invalid as well.
+              */
+            mutable int                         tree_size;
+            //! The subjects which have not been imported yet, 0 when the import of the subjects was not deferred.
+            ObserverDataDeferredImport*         deferred_import;
+            //! Set by the parent of an observer while its subjects are imported to indicate that the import of the observer's own subjects can be deferred.
+            bool                                defer_subject_import;
+            //! Locked for writing while subject_list changes, and for reading while subjectSnapshot() copies it.
+            mutable QReadWriteLock              subject_lock;
+            //! Protects the snapshot members below.
+            mutable QMutex                      subject_snapshot_mutex;
+            //! The subjects returned by subjectSnapshot().
+            mutable QList<QObject*>             subject_snapshot;
+            mutable bool                        subject_snapshot_valid;
+            //! Indicates if subjectSnapshot() was ever called, snapshots are only frozen at the start of processing cycles when it was.
+            mutable bool                        subject_snapshot_used;
+            //! The snapshot returned by treeSnapshot(), null when the tree changed since it was taken.
+            mutable ObserverSnapshot            tree_snapshot;
+            //! The routes returned by propertyRoute().
+            mutable QHash<QByteArray,PropertyRoute> property_routes;
+            mutable bool                        property_routes_valid;
+            //! The QtilitiesPropertyChangeEvent events queued by queuePropertyChangeEvent() during the current processing cycle.
+            QList<QPair<QPointer<QObject>,QByteArray> > queued_property_change_events;
+            //! The subjects and property names in queued_property_change_events.
+            QSet<QPair<const QObject*,QByteArray> > queued_property_change_event_keys;
+            //! The monitored subjects which reported that they are modified, thus Observer::isModified() does not have to ask every subject.
+            /*!
+              Updated by Observer::handleSubjectModificationStateChanged(), and when subjects are removed.
+              */
+            QSet<const QObject*>                modified_subjects;
+            //! The modification state last reported by Observer::modificationStateChanged().
+            bool                                notified_modification_state;
+            //! The access modes of the categories in categories keyed by their category IDs, used by definedCategoryAccessMode().
+            mutable QHash<int,int>              category_access_modes;
+            mutable bool                        category_access_modes_valid;
+            //! Changes whenever subjects are added to or removed from subject_list, see Observer::subjectsRevision().
+            int                                 subjects_revision;
+
+            //! The types of operations which can be posted to an observer from any thread, see Observer::postAttachSubjects().
+            enum PostedOperationType {
+                PostedAttach        = 0, /*!< The subject must be attached. */
+                PostedDetach        = 1, /*!< The subject must be detached. */
+                PostedSetProperty   = 2  /*!< A property must be set on the subject. */
+            };
+            //! An operation posted to the observer, applied in the thread of the observer by Observer::processPostedOperations().
+            struct PostedOperation {
+                PostedOperation(int type = PostedAttach, QObject* subject = 0, int ownership = 0) : type(type), subject(subject), ownership(ownership) {}
+                int type;
+                QPointer<QObject> subject;
+                //! The Observer::ObjectOwnership of PostedAttach operations.
+                int ownership;
+                //! The property name and value of PostedSetProperty operations.
+                QByteArray property_name;
+                QVariant property_value;
+            };
+            //! Protects posted_operations and posted_operations_queued, which are written by any thread.
+            QMutex                              posted_operations_mutex;
+            QList<PostedOperation>              posted_operations;
+            //! Indicates that Observer::processPostedOperations() was posted to the event loop of the observer and did not run yet.
+            bool                                posted_operations_queued;
         };
 
         Q_DECLARE_OPERATORS_FOR_FLAGS(ObserverData::ExportItemFlags)
@@ -14,12 +14,47 @@
 #include "Observer.h"
 #include "QtilitiesProperty.h"
 
+#include <QFile>
+#include <QBuffer>
+#include <QTextStream>
+
+namespace {
+    //! Escapes the quotes in a string which is written as a quoted dot string.
+    QString qti_private_DotQuoted(const QString& text) {
+        QString quoted = text;
+        quoted.replace(QLatin1Char('"'),QLatin1String("\\\""));
+        return quoted;
+    }
+
+    //! Writes the statement declaring the node of \p entry, including its node attributes.
+    void qti_private_WriteDotNode(QTextStream& stream, Qtilities::Core::RelationalTableEntry* entry, const char* indent) {
+        stream << indent << entry->visitorID() << " [label=\"" << qti_private_DotQuoted(entry->name()) << "\"";
+        if (entry->object()) {
+            const QList<QByteArray> property_names = entry->object()->dynamicPropertyNames();
+            for (int p = 0; p < property_names.count(); ++p) {
+                if (!property_names.at(p).startsWith("qti.dot.node."))
+                    continue;
+
+                // This is a dot node attribute property:
+                Qtilities::Core::SharedProperty shared_property = Qtilities::Core::ObjectManager::getSharedProperty(entry->object(),property_names.at(p).constData());
+                if (shared_property.isValid())
+                    stream << " " << QString::fromUtf8(property_names.at(p).mid(13)) << "=" << shared_property.value().toString();
+            }
+        }
+        stream << "];\n";
+    }
+}
+
 struct Qtilities::Core::ObserverDotWriterPrivateData {
-    ObserverDotWriterPrivateData() : observer(0) {}
+    ObserverDotWriterPrivateData() : observer(0),
+        maximum_depth(-1),
+        cluster_observers(false) {}
 
     Observer*                       observer;
     // Key = attribue, Value = value
     QHash<QString,QString>          graph_attributes;
+    int                             maximum_depth;
+    bool                            cluster_observers;
 };
 
 Qtilities::Core::ObserverDotWriter::ObserverDotWriter(Observer* observer) : QObject(observer) {
@@ -47,12 +82,16 @@ Qtilities::Core::Observer* Qtilities::Core::ObserverDotWriter::observerContext()
 Qtilities::Core::ObserverDotWriter::ObserverDotWriter(const ObserverDotWriter& other) : QObject(other.parent()) {
     d = new ObserverDotWriterPrivateData;
     d->observer = other.observerContext();
+    d->maximum_depth = other.maximumDepth();
+    d->cluster_observers = other.clusterObservers();
 }
 
 ObserverDotWriter& Qtilities::Core::ObserverDotWriter::operator=(const ObserverDotWriter& other) {
     if (this==&other) return *this;
 
     d->observer = other.observerContext();
+    d->maximum_depth = other.maximumDepth();
+    d->cluster_observers = other.clusterObservers();
 
     return *this;
 }
@@ -65,105 +104,181 @@ bool Qtilities::Core::ObserverDotWriter::saveToFile(const QString& fileName) con
     if (!file.open(QFile::WriteOnly))
         return false;
 
-    file.write(generateDotScript().toUtf8());
+    bool success = writeDotScript(&file);
     file.close();
 
-    return true;
+    return success;
 }
 
 QString Qtilities::Core::ObserverDotWriter::generateDotScript() const {
     if (!d->observer)
         return QString();
 
-    // Create the dot string:
-    QString dotString;
-    dotString.append(QString("digraph \"%1\" {\n").arg(d->observer->observerName()));
+    QByteArray script;
+    QBuffer buffer(&script);
+    buffer.open(QIODevice::WriteOnly);
+    writeDotScript(&buffer);
+    buffer.close();
+
+    return QString::fromUtf8(script.constData(),script.size());
+}
+
+bool Qtilities::Core::ObserverDotWriter::writeDotScript(QIODevice* device) const {
+    if (!d->observer || !device || !device->isWritable())
+        return false;
+
+    QTextStream stream(device);
+    stream.setCodec("UTF-8");
+    stream << "digraph \"" << qti_private_DotQuoted(d->observer->observerName()) << "\" {\n";
 
     // Add graph attributes:
-    for (int i = 0; i < d->graph_attributes.count(); ++i) {
-        dotString.append("    ");
-        dotString.append(d->graph_attributes.keys().at(i));
-        dotString.append(" = \"");
-        dotString.append(d->graph_attributes.values().at(i));
-        dotString.append("\";\n");
+    QHash<QString,QString>::const_iterator attribute_itr = d->graph_attributes.constBegin();
+    for (; attribute_itr != d->graph_attributes.constEnd(); ++attribute_itr)
+        stream << "    " << attribute_itr.key() << " = \"" << attribute_itr.value() << "\";\n";
+
+    ObserverRelationalTable table(d->observer);
+
+    // When the depth is limited, find the shallowest depth of all entries using a breadth first traversal. Entries
+    // which are not in entry_depths are deeper than the maximum depth:
+    QHash<int,int> entry_depths;
+    if (d->maximum_depth >= 0) {
+        QList<int> queue;
+        for (int i = 0; i < table.count(); ++i) {
+            RelationalTableEntry* entry = table.entryAt(i);
+            if (entry->parents().isEmpty()) {
+                entry_depths[entry->visitorID()] = 0;
+                queue << entry->visitorID();
+            }
+        }
+        for (int q = 0; q < queue.count(); ++q) {
+            int child_depth = entry_depths.value(queue.at(q)) + 1;
+            if (child_depth > d->maximum_depth)
+                continue;
+            RelationalTableEntry* entry = table.entryWithVisitorID(queue.at(q));
+            if (!entry)
+                continue;
+            const QList<int> children = entry->children();
+            for (int c = 0; c < children.count(); ++c) {
+                int child_id = children.at(c);
+                if (!entry_depths.contains(child_id)) {
+                    entry_depths[child_id] = child_depth;
+                    queue << child_id;
+                }
+            }
+        }
+    }
+    const bool depth_limited = (d->maximum_depth >= 0);
+
+    // When observers are clustered, all nodes are declared in the clusters first:
+    if (d->cluster_observers) {
+        QList<RelationalTableEntry*> unclustered_entries;
+        for (int i = 0; i < table.count(); ++i) {
+            RelationalTableEntry* entry = table.entryAt(i);
+            if (depth_limited && !entry_depths.contains(entry->visitorID()))
+                continue;
+
+            if (!qobject_cast<Observer*> (entry->object())) {
+                // Items are declared in the cluster of their first parent, only items without parents are declared here:
+                if (entry->parents().isEmpty())
+                    unclustered_entries << entry;
+                continue;
+            }
+
+            stream << "    subgraph \"cluster_" << entry->visitorID() << "\" {\n";
+            stream << "        label = \"" << qti_private_DotQuoted(entry->name()) << "\";\n";
+            qti_private_WriteDotNode(stream,entry,"        ");
+            const QList<int> children = entry->children();
+            for (int c = 0; c < children.count(); ++c) {
+                RelationalTableEntry* child_entry = table.entryWithVisitorID(children.at(c));
+                if (!child_entry || qobject_cast<Observer*> (child_entry->object()))
+                    continue;
+                if (child_entry->parents().isEmpty() || child_entry->parents().first() != entry->visitorID())
+                    continue;
+                if (depth_limited && !entry_depths.contains(child_entry->visitorID()))
+                    continue;
+                qti_private_WriteDotNode(stream,child_entry,"        ");
+            }
+            stream << "    }\n";
+        }
+
+        for (int i = 0; i < unclustered_entries.count(); ++i)
+            qti_private_WriteDotNode(stream,unclustered_entries.at(i),"    ");
     }
 
     // Then do the relationships between items:
-    ObserverRelationalTable table(d->observer);
     for (int i = 0; i < table.count(); ++i) {
         RelationalTableEntry* entry = table.entryAt(i);
+        if (depth_limited && !entry_depths.contains(entry->visitorID()))
+            continue;
 
         // Label this entry:
-        QString entry_label = QString("    %1 [label=\"%2\"").arg(entry->visitorID()).arg(entry->name());
-        // Add properties to it (node attributes):
-        if (entry->object()) {
-            QList<QByteArray> property_names = entry->object()->dynamicPropertyNames();
-            for (int p = 0; p < property_names.count(); p++) {
-                QString property_name(property_names.at(p).data());
-                if (property_name.startsWith("qti.dot.node")) {
-                    // This is a dot node attribute property:
-                    QByteArray ba = property_name.remove(0,13).toUtf8();
-                    const char* char_name = ba.data();
-                    // Get the shared property:
-                    SharedProperty shared_property = ObjectManager::getSharedProperty(entry->object(),property_names.at(p).data());
-                    if (shared_property.isValid()) {
-                        entry_label.append(" " + QString(char_name) + "=" + shared_property.value().toString());
-                    }
-                }
-            }
-        }
-        entry_label.append("];\n");
-        dotString.append(entry_label);
+        if (!d->cluster_observers)
+            qti_private_WriteDotNode(stream,entry,"    ");
 
         // Now fill in the relationship data:
-        for (int c = 0; c < entry->children().count(); c++) {
-            QString relationship_string = QString("    %1").arg(entry->visitorID());
-            relationship_string.append(" -> ");
-            RelationalTableEntry* child_entry = table.entryWithVisitorID(entry->children().at(c));
-            relationship_string.append(QString("%1").arg(child_entry->visitorID()));
-            dotString.append(relationship_string);
+        const QList<int> children = entry->children();
+        for (int c = 0; c < children.count(); c++) {
+            RelationalTableEntry* child_entry = table.entryWithVisitorID(children.at(c));
+            if (!child_entry)
+                continue;
+            if (depth_limited && !entry_depths.contains(child_entry->visitorID()))
+                continue;
+
+            stream << "    " << entry->visitorID() << " -> " << child_entry->visitorID();
 
-            QMap<QString,QString> edge_attributes;
             // Get edge attributes for this relationship:
-            QList<QByteArray> property_names = child_entry->object()->dynamicPropertyNames();
-            for (int p = 0; p < property_names.count(); p++) {
-                QString property_name(property_names.at(p).data());
-                if (property_name.startsWith("qti.dot.edge")) {
-                    // This is a dot note attribute property:
-                    QByteArray ba = property_name.remove(0,13).toUtf8();
-                    const char* char_name = ba.data();
-                    // Get the shared property:
-                    MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(child_entry->object(),property_names.at(p).data());
-                    if (multi_context_property.isValid()) {
-                        // Now check if this multi_context_property has a value for our context:
-                        if (multi_context_property.hasContext(entry->sessionID())) {
-                            edge_attributes[QString(char_name)] = multi_context_property.value(entry->sessionID()).toString();
-                        }
-                    }
+            QMap<QString,QString> edge_attributes;
+            if (child_entry->object()) {
+                const QList<QByteArray> property_names = child_entry->object()->dynamicPropertyNames();
+                for (int p = 0; p < property_names.count(); p++) {
+                    if (!property_names.at(p).startsWith("qti.dot.edge."))
+                        continue;
+
+                    // This is a dot edge attribute property, check if it has a value for our context:
+                    MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(child_entry->object(),property_names.at(p).constData());
+                    if (multi_context_property.isValid() && multi_context_property.hasContext(entry->sessionID()))
+                        edge_attributes[QString::fromUtf8(property_names.at(p).mid(13))] = multi_context_property.value(entry->sessionID()).toString();
                 }
             }
 
             // Now add all found attributes for this edge:
-            for (int e = 0; e < edge_attributes.count(); e++) {
-                if (e == 0)
-                    dotString.append(" [");
-                dotString.append(edge_attributes.keys().at(e) + "=" + edge_attributes.values().at(e));
-                if (edge_attributes.count() > 1 && e != edge_attributes.count()-1)
-                    dotString.append(",");
-                if (e == edge_attributes.count()-1)
-                    dotString.append("]");
+            if (!edge_attributes.isEmpty()) {
+                stream << " [";
+                QMap<QString,QString>::const_iterator edge_itr = edge_attributes.constBegin();
+                for (; edge_itr != edge_attributes.constEnd(); ++edge_itr) {
+                    if (edge_itr != edge_attributes.constBegin())
+                        stream << ",";
+                    stream << edge_itr.key() << "=" << edge_itr.value();
+                }
+                stream << "]";
             }
 
             // Finally add the new end line character and the new line:
-            dotString.append(";\n");
+            stream << ";\n";
         }
     }
 
     // Append the closing } character:
-    dotString.append("}");
-    LOG_INFO(dotString);
+    stream << "}";
+    stream.flush();
+
+    return stream.status() == QTextStream::Ok;
+}
+
+void Qtilities::Core::ObserverDotWriter::setMaximumDepth(int depth) {
+    d->maximum_depth = depth < 0 ? -1 : depth;
+}
+
+int Qtilities::Core::ObserverDotWriter::maximumDepth() const {
+    return d->maximum_depth;
+}
+
+void Qtilities::Core::ObserverDotWriter::setClusterObservers(bool cluster_observers) {
+    d->cluster_observers = cluster_observers;
+}
 
-    return dotString;
+bool Qtilities::Core::ObserverDotWriter::clusterObservers() const {
+    return d->cluster_observers;
 }
 
 bool Qtilities::Core::ObserverDotWriter::addNodeAttribute(QObject* node, const QString& attribute, const QString& value) {
@@ -316,7 +431,7 @@ bool Qtilities::Core::ObserverDotWriter::removeEdgeAttribute(Observer* parent, Q
         property.removeContext(parent->observerID());
 
         // Set the property again:
-        if (property.contextMap().keys().count() == 0)
+        if (property.contextCount() == 0)
             child->setProperty(char_name,QVariant());
         else
             ObjectManager::setMultiContextProperty(child,property);
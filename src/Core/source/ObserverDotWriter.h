@@ -18,6 +18,8 @@
 #include <QString>
 #include <QHash>
 
+class QIODevice;
+
 namespace Qtilities {
     namespace Core {  
         class Observer;
@@ -236,6 +238,12 @@ digraph "Root Node" {
 
         Note the needed extra \p \" characters for the \p label attribute.
 
+        \section observer_dot_graph_large_trees Large Trees
+
+        For large trees the script should be written directly to a file or another QIODevice using saveToFile() or writeDotScript(), which
+        stream the script instead of building it in memory first. The size of the graph can be limited using setMaximumDepth(), and
+        setClusterObservers() draws every observer and the items directly underneath it in a cluster, which keeps large graphs readable.
+
         Combining all of the different attributes that we've set above, we get a graph like this:
 
         \image html observer_dot_graph_example_attributes_dot.jpg "Example Graph With Attributes (Dot Layout Engine)"
@@ -267,7 +275,7 @@ digraph "Root Node" {
 
             //! Saves the dot script to a file.
             /*!
-              Function which will write the dot script generated using the generateDotScript() function to the specified file.
+              Function which will write the dot script to the specified file. The script is streamed to the file using writeDotScript().
 
               \note If no observer context have been specified, this function will return false.
               */
@@ -275,8 +283,52 @@ digraph "Root Node" {
             //! Function which will generate the dot script for the specified observer context.
             /*!
               \note If no observer context have been specified, this function will return QString().
+
+              \sa writeDotScript()
               */
             QString generateDotScript() const;
+            //! Writes the dot script for the specified observer context to \p device, encoded as UTF-8.
+            /*!
+              The script is written while the tree is traversed, thus the complete script is never held in memory.
+
+              \param device The device to write to. The device must be open for writing.
+              \returns True if successfull, false when no observer context have been specified or the device is not writable.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool writeDotScript(QIODevice* device) const;
+
+            //! Sets the maximum depth of the nodes in the graph.
+            /*!
+              The observer context is at depth 0, its children at depth 1 etc. Nodes deeper than \p depth and their edges are not part of the graph.
+              Items which appear at multiple depths are placed at the shallowest depth at which they appear.
+
+              \param depth The maximum depth, or -1 to include the complete tree. The default is -1.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setMaximumDepth(int depth);
+            //! Gets the maximum depth of the nodes in the graph.
+            /*!
+              \sa setMaximumDepth()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int maximumDepth() const;
+            //! Sets if every observer and the items directly underneath it must be drawn in a cluster.
+            /*!
+              Items which are not observers are placed in the cluster of the first observer in which they appear. The default is false.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setClusterObservers(bool cluster_observers);
+            //! Indicates if every observer and the items directly underneath it are drawn in a cluster.
+            /*!
+              \sa setClusterObservers()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool clusterObservers() const;
 
             //! Adds a node attribute to a node in the graph.
             /*!
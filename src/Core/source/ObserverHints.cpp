@@ -12,42 +12,113 @@
 #include "ObserverHints.h"
 
 #include <QDomElement>
+#include <QSharedData>
+#include <QHash>
+#include <QMutex>
+#include <QDataStream>
+
+namespace {
+    //! The hints of an ObserverHints object. Equal hints are implicitly shared between ObserverHints objects, and are copied when one of them changes.
+    struct ObserverHintsData : public QSharedData {
+        ObserverHintsData() : observer_selection_context(ObserverHints::SelectionUseParentContext),
+            naming_control(ObserverHints::NoNamingControlHint),
+            activity_display(ObserverHints::NoActivityDisplayHint),
+            activity_control(ObserverHints::NoActivityControlHint),
+            item_selection_control(ObserverHints::SelectableItems),
+            hierarhical_display(ObserverHints::NoHierarchicalDisplayHint),
+            display_flags(ObserverHints::NoDisplayFlagsHint),
+            item_view_column_hint(ObserverHints::ColumnNoHints),
+            action_hints(ObserverHints::ActionNoHints),
+            drag_drop_flags(ObserverHints::NoDragDrop),
+            modification_state_display(ObserverHints::NoModificationStateDisplayHint),
+            category_editing_flags(ObserverHints::CategoriesReadOnly),
+            root_index_display_hint(ObserverHints::RootIndexHide),
+            //root_index_display_hint(ObserverHints::RootIndexDisplayDecorated),
+            has_inversed_category_display(true),
+            category_filter_enabled(false),
+            id(-1) {}
+        ObserverHintsData(const ObserverHintsData& other) : QSharedData(other),
+            observer_selection_context(other.observer_selection_context),
+            naming_control(other.naming_control),
+            activity_display(other.activity_display),
+            activity_control(other.activity_control),
+            item_selection_control(other.item_selection_control),
+            hierarhical_display(other.hierarhical_display),
+            display_flags(other.display_flags),
+            item_view_column_hint(other.item_view_column_hint),
+            action_hints(other.action_hints),
+            drag_drop_flags(other.drag_drop_flags),
+            modification_state_display(other.modification_state_display),
+            category_editing_flags(other.category_editing_flags),
+            root_index_display_hint(other.root_index_display_hint),
+            displayed_categories(other.displayed_categories),
+            has_inversed_category_display(other.has_inversed_category_display),
+            category_filter_enabled(other.category_filter_enabled),
+            id(-1) {}
+
+        //! Returns a key which is equal for equal hints.
+        QByteArray key() const {
+            QByteArray key;
+            QDataStream stream(&key,QIODevice::WriteOnly);
+            stream << (quint32) observer_selection_context << (quint32) naming_control << (quint32) activity_display
+                   << (quint32) activity_control << (quint32) item_selection_control << (quint32) hierarhical_display
+                   << (quint32) display_flags << (quint32) item_view_column_hint << (quint32) action_hints
+                   << (quint32) drag_drop_flags << (quint32) modification_state_display << (quint32) category_editing_flags
+                   << (quint32) root_index_display_hint << has_inversed_category_display << category_filter_enabled;
+            stream << (quint32) displayed_categories.count();
+            for (int i = 0; i < displayed_categories.count(); ++i)
+                stream << displayed_categories.at(i).toStringList();
+            return key;
+        }
+
+        ObserverHints::ObserverSelectionContext     observer_selection_context;
+        ObserverHints::NamingControl                naming_control;
+        ObserverHints::ActivityDisplay              activity_display;
+        ObserverHints::ActivityControl              activity_control;
+        ObserverHints::ItemSelectionControl         item_selection_control;
+        ObserverHints::HierarchicalDisplay          hierarhical_display;
+        ObserverHints::DisplayFlags                 display_flags;
+        ObserverHints::ItemViewColumnFlags          item_view_column_hint;
+        ObserverHints::ActionHints                  action_hints;
+        ObserverHints::DragDropFlags                drag_drop_flags;
+        ObserverHints::ModificationStateDisplayHint modification_state_display;
+        ObserverHints::CategoryEditingFlags         category_editing_flags;
+        ObserverHints::RootIndexDisplayHint         root_index_display_hint;
+        QList<Qtilities::Core::QtilitiesCategory>   displayed_categories;
+        bool                                        has_inversed_category_display;
+        bool                                        category_filter_enabled;
+        //! The id assigned when the hints were interned, -1 when they were not interned. Copies are never interned.
+        int                                         id;
+    };
+
+    //! The table in which equal hints are interned, keyed by ObserverHintsData::key(). Interned hints are never released.
+    struct ObserverHintsTable {
+        ObserverHintsTable() : default_hints(new ObserverHintsData) {
+            // Id 0 is the default hints:
+            default_hints->id = 0;
+            hints[default_hints.constData()->key()] = default_hints;
+            next_id = 1;
+        }
+
+        QMutex                                                      mutex;
+        QHash<QByteArray,QSharedDataPointer<ObserverHintsData> >    hints;
+        QSharedDataPointer<ObserverHintsData>                       default_hints;
+        int                                                         next_id;
+    };
+}
+
+Q_GLOBAL_STATIC(ObserverHintsTable, qti_private_observer_hints_table)
 
 struct Qtilities::Core::ObserverHintsPrivateData {
-    ObserverHintsPrivateData() : observer_selection_context(ObserverHints::SelectionUseParentContext),
-        naming_control(ObserverHints::NoNamingControlHint),
-        activity_display(ObserverHints::NoActivityDisplayHint),
-        activity_control(ObserverHints::NoActivityControlHint),
-        item_selection_control(ObserverHints::SelectableItems),
-        hierarhical_display(ObserverHints::NoHierarchicalDisplayHint),
-        display_flags(ObserverHints::NoDisplayFlagsHint),
-        item_view_column_hint(ObserverHints::ColumnNoHints),
-        action_hints(ObserverHints::ActionNoHints),
-        drag_drop_flags(ObserverHints::NoDragDrop),
-        modification_state_display(ObserverHints::NoModificationStateDisplayHint),
-        category_editing_flags(ObserverHints::CategoriesReadOnly),
-        root_index_display_hint(ObserverHints::RootIndexHide),
-        //root_index_display_hint(ObserverHints::RootIndexDisplayDecorated),
-        has_inversed_category_display(true),
-        category_filter_enabled(false),
+    ObserverHintsPrivateData() : shared_hints(qti_private_observer_hints_table()->default_hints),
         is_modified(false) {}
 
-    ObserverHints::ObserverSelectionContext     observer_selection_context;
-    ObserverHints::NamingControl                naming_control;
-    ObserverHints::ActivityDisplay              activity_display;
-    ObserverHints::ActivityControl              activity_control;
-    ObserverHints::ItemSelectionControl         item_selection_control;
-    ObserverHints::HierarchicalDisplay          hierarhical_display;
-    ObserverHints::DisplayFlags                 display_flags;
-    ObserverHints::ItemViewColumnFlags          item_view_column_hint;
-    ObserverHints::ActionHints                  action_hints;
-    ObserverHints::DragDropFlags                drag_drop_flags;
-    ObserverHints::ModificationStateDisplayHint modification_state_display;
-    ObserverHints::CategoryEditingFlags         category_editing_flags;
-    ObserverHints::RootIndexDisplayHint         root_index_display_hint;
-    QList<Qtilities::Core::QtilitiesCategory>   displayed_categories;
-    bool                                        has_inversed_category_display;
-    bool                                        category_filter_enabled;
+    //! Returns the hints for reading, without copying them when they are shared.
+    const ObserverHintsData* constHints() const { return shared_hints.constData(); }
+    //! Returns the hints for writing, which copies them first when they are shared.
+    ObserverHintsData* hints() { return shared_hints.data(); }
+
+    QSharedDataPointer<ObserverHintsData>       shared_hints;
     bool                                        is_modified;
 };
 
@@ -65,22 +136,8 @@ Qtilities::Core::ObserverHints::~ObserverHints() {
 
 Qtilities::Core::ObserverHints::ObserverHints(const ObserverHints& other) : QObject(other.parent()), ObserverAwareBase() {
     d = new ObserverHintsPrivateData;
-    d->observer_selection_context = other.observerSelectionContextHint();
-    d->naming_control = other.namingControlHint();
-    d->activity_display = other.activityDisplayHint();
-    d->activity_control = other.activityControlHint();
-    d->item_selection_control = other.itemSelectionControlHint();
-    d->hierarhical_display = other.hierarchicalDisplayHint();
-    d->display_flags = other.displayFlagsHint();
-    d->item_view_column_hint = other.itemViewColumnHint();
-    d->action_hints = other.actionHints();
-    d->displayed_categories = other.displayedCategories();
-    d->has_inversed_category_display = other.hasInversedCategoryDisplay();
-    d->category_filter_enabled = other.categoryFilterEnabled();
-    d->modification_state_display = other.modificationStateDisplayHint();
-    d->category_editing_flags = other.categoryEditingFlags();
-    d->root_index_display_hint = other.rootIndexDisplayHint();
-    d->drag_drop_flags = other.dragDropHint();
+    // The hints are shared until one of the objects change them:
+    d->shared_hints = other.d->shared_hints;
 
     setIsExportable(other.isExportable());
 }
@@ -88,22 +145,7 @@ Qtilities::Core::ObserverHints::ObserverHints(const ObserverHints& other) : QObj
 ObserverHints& Qtilities::Core::ObserverHints::operator=(const ObserverHints& other) {
     if (this==&other) return *this;
 
-    d->observer_selection_context = other.observerSelectionContextHint();
-    d->naming_control = other.namingControlHint();
-    d->activity_display = other.activityDisplayHint();
-    d->activity_control = other.activityControlHint();
-    d->item_selection_control = other.itemSelectionControlHint();
-    d->hierarhical_display = other.hierarchicalDisplayHint();
-    d->display_flags = other.displayFlagsHint();
-    d->item_view_column_hint = other.itemViewColumnHint();
-    d->action_hints = other.actionHints();
-    d->displayed_categories = other.displayedCategories();
-    d->has_inversed_category_display = other.hasInversedCategoryDisplay();
-    d->category_filter_enabled = other.categoryFilterEnabled();
-    d->modification_state_display = other.modificationStateDisplayHint();
-    d->category_editing_flags = other.categoryEditingFlags();
-    d->root_index_display_hint = other.rootIndexDisplayHint();
-    d->drag_drop_flags = other.dragDropHint();
+    d->shared_hints = other.d->shared_hints;
 
     setIsExportable(other.isExportable());
 
@@ -114,37 +156,43 @@ ObserverHints& Qtilities::Core::ObserverHints::operator=(const ObserverHints& ot
 }
 
 bool Qtilities::Core::ObserverHints::operator==(const ObserverHints& other) const {
-    if (d->observer_selection_context != other.observerSelectionContextHint())
+    // Shared hints are equal, and interned hints with different ids are not:
+    if (d->constHints() == other.d->constHints())
+        return true;
+    if (d->constHints()->id != -1 && other.d->constHints()->id != -1)
         return false;
-    if (d->naming_control != other.namingControlHint())
+
+    if (d->constHints()->observer_selection_context != other.observerSelectionContextHint())
+        return false;
+    if (d->constHints()->naming_control != other.namingControlHint())
         return false;
-    if (d->activity_display != other.activityDisplayHint())
+    if (d->constHints()->activity_display != other.activityDisplayHint())
         return false;
-    if (d->activity_control != other.activityControlHint())
+    if (d->constHints()->activity_control != other.activityControlHint())
         return false;
-    if (d->item_selection_control != other.itemSelectionControlHint())
+    if (d->constHints()->item_selection_control != other.itemSelectionControlHint())
         return false;
-    if (d->hierarhical_display != other.hierarchicalDisplayHint())
+    if (d->constHints()->hierarhical_display != other.hierarchicalDisplayHint())
         return false;
-    if (d->display_flags != other.displayFlagsHint())
+    if (d->constHints()->display_flags != other.displayFlagsHint())
         return false;
-    if (d->item_view_column_hint != other.itemViewColumnHint())
+    if (d->constHints()->item_view_column_hint != other.itemViewColumnHint())
         return false;
-    if (d->action_hints != other.actionHints())
+    if (d->constHints()->action_hints != other.actionHints())
         return false;
-    if (d->displayed_categories != other.displayedCategories())
+    if (d->constHints()->displayed_categories != other.displayedCategories())
         return false;
-    if (d->has_inversed_category_display != other.hasInversedCategoryDisplay())
+    if (d->constHints()->has_inversed_category_display != other.hasInversedCategoryDisplay())
         return false;
-    if (d->category_filter_enabled != other.categoryFilterEnabled())
+    if (d->constHints()->category_filter_enabled != other.categoryFilterEnabled())
         return false;
-    if (d->drag_drop_flags != other.dragDropHint())
+    if (d->constHints()->drag_drop_flags != other.dragDropHint())
         return false;
-    if (d->modification_state_display != other.modificationStateDisplayHint())
+    if (d->constHints()->modification_state_display != other.modificationStateDisplayHint())
         return false;
-    if (d->category_editing_flags != other.categoryEditingFlags())
+    if (d->constHints()->category_editing_flags != other.categoryEditingFlags())
         return false;
-    if (d->root_index_display_hint != other.rootIndexDisplayHint())
+    if (d->constHints()->root_index_display_hint != other.rootIndexDisplayHint())
         return false;
 
     return true;
@@ -154,188 +202,208 @@ bool Qtilities::Core::ObserverHints::operator!=(const ObserverHints& other) cons
     return !(*this==other);
 }
 
+int Qtilities::Core::ObserverHints::hintSetId() const {
+    if (d->constHints()->id != -1)
+        return d->constHints()->id;
+
+    QByteArray key = d->constHints()->key();
+    ObserverHintsTable* table = qti_private_observer_hints_table();
+    QMutexLocker locker(&table->mutex);
+    QHash<QByteArray,QSharedDataPointer<ObserverHintsData> >::const_iterator itr = table->hints.constFind(key);
+    if (itr != table->hints.constEnd()) {
+        // Share the interned copy of the hints:
+        d->shared_hints = itr.value();
+    } else {
+        // The id does not change the hints, thus it is assigned without copying hints which are shared with other objects:
+        const_cast<ObserverHintsData*> (d->constHints())->id = table->next_id++;
+        table->hints.insert(key,d->shared_hints);
+    }
+
+    return d->constHints()->id;
+}
+
 void Qtilities::Core::ObserverHints::setObserverSelectionContextHint(ObserverHints::ObserverSelectionContext observer_selection_context) {
-    if (d->observer_selection_context == observer_selection_context)
+    if (d->constHints()->observer_selection_context == observer_selection_context)
         return;
 
-    d->observer_selection_context = observer_selection_context;
+    d->hints()->observer_selection_context = observer_selection_context;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::ObserverSelectionContext Qtilities::Core::ObserverHints::observerSelectionContextHint() const {
-    return d->observer_selection_context;
+    return d->constHints()->observer_selection_context;
 }
 
 void Qtilities::Core::ObserverHints::setNamingControlHint(ObserverHints::NamingControl naming_control) {
-    if (d->naming_control == naming_control)
+    if (d->constHints()->naming_control == naming_control)
         return;
 
-    d->naming_control = naming_control;
+    d->hints()->naming_control = naming_control;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::NamingControl Qtilities::Core::ObserverHints::namingControlHint() const {
-    return d->naming_control;
+    return d->constHints()->naming_control;
 }
 
 void Qtilities::Core::ObserverHints::setActivityDisplayHint(ObserverHints::ActivityDisplay activity_display) {
-    if (d->activity_display == activity_display)
+    if (d->constHints()->activity_display == activity_display)
         return;
 
-    d->activity_display = activity_display;
+    d->hints()->activity_display = activity_display;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::ActivityDisplay Qtilities::Core::ObserverHints::activityDisplayHint() const {
-    return d->activity_display;
+    return d->constHints()->activity_display;
 }
 
 void Qtilities::Core::ObserverHints::setActivityControlHint(ObserverHints::ActivityControl activity_control) {
-    if (d->activity_control == activity_control)
+    if (d->constHints()->activity_control == activity_control)
         return;
 
-    d->activity_control = activity_control;
+    d->hints()->activity_control = activity_control;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::ActivityControl Qtilities::Core::ObserverHints::activityControlHint() const {
-    return d->activity_control;
+    return d->constHints()->activity_control;
 }
 
 void Qtilities::Core::ObserverHints::setItemSelectionControlHint(ObserverHints::ItemSelectionControl item_selection_control) {
-    if (d->item_selection_control == item_selection_control)
+    if (d->constHints()->item_selection_control == item_selection_control)
         return;
 
-    d->item_selection_control = item_selection_control;
+    d->hints()->item_selection_control = item_selection_control;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::ItemSelectionControl Qtilities::Core::ObserverHints::itemSelectionControlHint() const {
-    return d->item_selection_control;
+    return d->constHints()->item_selection_control;
 }
 
 void Qtilities::Core::ObserverHints::setHierarchicalDisplayHint(ObserverHints::HierarchicalDisplay hierarhical_display) {
-    if (d->hierarhical_display == hierarhical_display)
+    if (d->constHints()->hierarhical_display == hierarhical_display)
         return;
 
-    d->hierarhical_display = hierarhical_display;
+    d->hints()->hierarhical_display = hierarhical_display;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::HierarchicalDisplay Qtilities::Core::ObserverHints::hierarchicalDisplayHint() const {
-    return d->hierarhical_display;
+    return d->constHints()->hierarhical_display;
 }
 
 void Qtilities::Core::ObserverHints::setDisplayFlagsHint(ObserverHints::DisplayFlags display_flags) {
-    if (d->display_flags == display_flags)
+    if (d->constHints()->display_flags == display_flags)
         return;
 
-    d->display_flags = display_flags;
+    d->hints()->display_flags = display_flags;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::DisplayFlags Qtilities::Core::ObserverHints::displayFlagsHint() const {
-    return d->display_flags;
+    return d->constHints()->display_flags;
 }
 
 void Qtilities::Core::ObserverHints::setItemViewColumnHint(ObserverHints::ItemViewColumnFlags item_view_column_hint) {
-    if (d->item_view_column_hint == item_view_column_hint)
+    if (d->constHints()->item_view_column_hint == item_view_column_hint)
         return;
 
-    d->item_view_column_hint = item_view_column_hint;
+    d->hints()->item_view_column_hint = item_view_column_hint;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::ItemViewColumnFlags Qtilities::Core::ObserverHints::itemViewColumnHint() const {
-    return d->item_view_column_hint;
+    return d->constHints()->item_view_column_hint;
 }
 
 void Qtilities::Core::ObserverHints::setActionHints(ObserverHints::ActionHints action_hints) {
-    if (d->action_hints == action_hints)
+    if (d->constHints()->action_hints == action_hints)
         return;
 
-    d->action_hints = action_hints;
+    d->hints()->action_hints = action_hints;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::ActionHints Qtilities::Core::ObserverHints::actionHints() const {
-    return d->action_hints;
+    return d->constHints()->action_hints;
 }
 
 void Qtilities::Core::ObserverHints::setDragDropHint(ObserverHints::DragDropFlags drag_drop_flags) {
-    d->drag_drop_flags = drag_drop_flags;
+    d->hints()->drag_drop_flags = drag_drop_flags;
 }
 
 Qtilities::Core::ObserverHints::DragDropFlags Qtilities::Core::ObserverHints::dragDropHint() const {
-    return d->drag_drop_flags;
+    return d->constHints()->drag_drop_flags;
 }
 
 void Qtilities::Core::ObserverHints::setModificationStateDisplayHint(ObserverHints::ModificationStateDisplayHint modification_state_display) {
-    if (d->modification_state_display == modification_state_display)
+    if (d->constHints()->modification_state_display == modification_state_display)
         return;
 
-    d->modification_state_display = modification_state_display;
+    d->hints()->modification_state_display = modification_state_display;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::ModificationStateDisplayHint Qtilities::Core::ObserverHints::modificationStateDisplayHint() const {
-    return d->modification_state_display;
+    return d->constHints()->modification_state_display;
 }
 
 void Qtilities::Core::ObserverHints::setCategoryEditingFlags(ObserverHints::CategoryEditingFlags category_editing_flags) {
-    if (d->category_editing_flags == category_editing_flags)
+    if (d->constHints()->category_editing_flags == category_editing_flags)
         return;
 
-    d->category_editing_flags = category_editing_flags;
+    d->hints()->category_editing_flags = category_editing_flags;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 Qtilities::Core::ObserverHints::CategoryEditingFlags Qtilities::Core::ObserverHints::categoryEditingFlags() const {
-    return d->category_editing_flags;
+    return d->constHints()->category_editing_flags;
 }
 
 void ObserverHints::setRootIndexDisplayHint(ObserverHints::RootIndexDisplayHint root_index_display_hint) {
-    if (d->root_index_display_hint == root_index_display_hint)
+    if (d->constHints()->root_index_display_hint == root_index_display_hint)
         return;
 
-    d->root_index_display_hint = root_index_display_hint;
+    d->hints()->root_index_display_hint = root_index_display_hint;
 
     if (observerContext())
         observerContext()->setModificationState(true);
 }
 
 ObserverHints::RootIndexDisplayHint ObserverHints::rootIndexDisplayHint() const {
-    return d->root_index_display_hint;
+    return d->constHints()->root_index_display_hint;
 }
 
 void Qtilities::Core::ObserverHints::setDisplayedCategories(const QList<QtilitiesCategory>& displayed_categories, bool inversed) {
-    if (d->displayed_categories == displayed_categories && d->has_inversed_category_display == inversed)
+    if (d->constHints()->displayed_categories == displayed_categories && d->constHints()->has_inversed_category_display == inversed)
         return;
 
-    d->displayed_categories = displayed_categories;
-    d->has_inversed_category_display = inversed;
+    d->hints()->displayed_categories = displayed_categories;
+    d->hints()->has_inversed_category_display = inversed;
 
     // Will update views connected to this signal.
     if (observerContext()) {
@@ -346,30 +414,30 @@ void Qtilities::Core::ObserverHints::setDisplayedCategories(const QList<Qtilitie
 }
 
 void Qtilities::Core::ObserverHints::addDisplayedCategory(const QtilitiesCategory& category) {
-    for (int i = 0; i < d->displayed_categories.count(); ++i) {
-        if (d->displayed_categories.at(i) == category)
+    for (int i = 0; i < d->constHints()->displayed_categories.count(); ++i) {
+        if (d->constHints()->displayed_categories.at(i) == category)
             return;
     }
 
-    d->displayed_categories.append(category);
+    d->hints()->displayed_categories.append(category);
 }
 
 void Qtilities::Core::ObserverHints::removeDisplayedCategory(const QtilitiesCategory& category) {
-    for (int i = 0; i < d->displayed_categories.count(); ++i) {
-        if (d->displayed_categories.at(i) == category) {
-            d->displayed_categories.removeAt(i);
+    for (int i = 0; i < d->constHints()->displayed_categories.count(); ++i) {
+        if (d->constHints()->displayed_categories.at(i) == category) {
+            d->hints()->displayed_categories.removeAt(i);
             return;
         }
     }
 }
 
 QList<Qtilities::Core::QtilitiesCategory> Qtilities::Core::ObserverHints::displayedCategories() const {
-    return d->displayed_categories;
+    return d->constHints()->displayed_categories;
 }
 
 void Qtilities::Core::ObserverHints::setCategoryFilterEnabled(bool enabled) {
-    if (enabled != d->category_filter_enabled) {
-        d->category_filter_enabled = enabled;
+    if (enabled != d->constHints()->category_filter_enabled) {
+        d->hints()->category_filter_enabled = enabled;
 
         if (observerContext()) {
             observerContext()->setModificationState(true);
@@ -379,11 +447,11 @@ void Qtilities::Core::ObserverHints::setCategoryFilterEnabled(bool enabled) {
 }
 
 bool Qtilities::Core::ObserverHints::categoryFilterEnabled() const {
-    return d->category_filter_enabled;
+    return d->constHints()->category_filter_enabled;
 }
 
 bool Qtilities::Core::ObserverHints::hasInversedCategoryDisplay() const {
-    return d->has_inversed_category_display;
+    return d->constHints()->has_inversed_category_display;
 }
 
 bool Qtilities::Core::ObserverHints::isModified() const {
@@ -655,42 +723,42 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    stream << (quint32) d->observer_selection_context;
-    stream << (quint32) d->naming_control;
-    stream << (quint32) d->activity_display;
-    stream << (quint32) d->activity_control;
-    stream << (quint32) d->item_selection_control;
-    stream << (quint32) d->hierarhical_display;
-    stream << (quint32) d->display_flags;
-    stream << (quint32) d->item_view_column_hint;
-    stream << (quint32) d->action_hints;
-    stream << (quint32) d->drag_drop_flags;
-    stream << (quint32) d->modification_state_display;
+    stream << (quint32) d->constHints()->observer_selection_context;
+    stream << (quint32) d->constHints()->naming_control;
+    stream << (quint32) d->constHints()->activity_display;
+    stream << (quint32) d->constHints()->activity_control;
+    stream << (quint32) d->constHints()->item_selection_control;
+    stream << (quint32) d->constHints()->hierarhical_display;
+    stream << (quint32) d->constHints()->display_flags;
+    stream << (quint32) d->constHints()->item_view_column_hint;
+    stream << (quint32) d->constHints()->action_hints;
+    stream << (quint32) d->constHints()->drag_drop_flags;
+    stream << (quint32) d->constHints()->modification_state_display;
 
     // -----------------------------------
     // Start of specific to Qtilities::Qtilities_1_1:
     // -----------------------------------
     if (exportVersion() == Qtilities::Qtilities_1_1) {
-        stream << (quint32) d->category_editing_flags;
+        stream << (quint32) d->constHints()->category_editing_flags;
     }
     // -----------------------------------
     // End of specific to Qtilities::Qtilities_1_1:
     // -----------------------------------
     // Start of specific to Qtilities::Qtilities_1_2:
     // -----------------------------------
-    if (exportVersion() == Qtilities::Qtilities_1_2) {
-        stream << (quint32) d->root_index_display_hint;
+    if (exportVersion() >= Qtilities::Qtilities_1_2) {
+        stream << (quint32) d->constHints()->root_index_display_hint;
     }
     // -----------------------------------
     // End of specific to Qtilities::Qtilities_1_2:
     // -----------------------------------
 
-    stream << (quint32) d->displayed_categories.count();
-    for (int i = 0; i < d->displayed_categories.count(); ++i)
-        d->displayed_categories.at(i).exportBinary(stream);
+    stream << (quint32) d->constHints()->displayed_categories.count();
+    for (int i = 0; i < d->constHints()->displayed_categories.count(); ++i)
+        d->constHints()->displayed_categories.at(i).exportBinary(stream);
 
-    stream << d->has_inversed_category_display;
-    stream << d->category_filter_enabled;
+    stream << d->constHints()->has_inversed_category_display;
+    stream << d->constHints()->category_filter_enabled;
 
     return IExportable::Complete;
 }
@@ -704,43 +772,43 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
      
     quint32 qi32;
     stream >> qi32;
-    d->observer_selection_context = ObserverHints::ObserverSelectionContext (qi32);
+    d->hints()->observer_selection_context = ObserverHints::ObserverSelectionContext (qi32);
     stream >> qi32;
-    d->naming_control = ObserverHints::NamingControl (qi32);
+    d->hints()->naming_control = ObserverHints::NamingControl (qi32);
     stream >> qi32;
-    d->activity_display = ObserverHints::ActivityDisplay (qi32);
+    d->hints()->activity_display = ObserverHints::ActivityDisplay (qi32);
     stream >> qi32;
-    d->activity_control = ObserverHints::ActivityControl (qi32);
+    d->hints()->activity_control = ObserverHints::ActivityControl (qi32);
     stream >> qi32;
-    d->item_selection_control = ObserverHints::ItemSelectionControl (qi32);
+    d->hints()->item_selection_control = ObserverHints::ItemSelectionControl (qi32);
     stream >> qi32;
-    d->hierarhical_display = ObserverHints::HierarchicalDisplay (qi32);
+    d->hints()->hierarhical_display = ObserverHints::HierarchicalDisplay (qi32);
     stream >> qi32;
-    d->display_flags = ObserverHints::DisplayFlags (qi32);
+    d->hints()->display_flags = ObserverHints::DisplayFlags (qi32);
     stream >> qi32;
-    d->item_view_column_hint = ObserverHints::ItemViewColumnFlags (qi32);
+    d->hints()->item_view_column_hint = ObserverHints::ItemViewColumnFlags (qi32);
     stream >> qi32;
-    d->action_hints = ObserverHints::ActionHints (qi32);
+    d->hints()->action_hints = ObserverHints::ActionHints (qi32);
     stream >> qi32;
-    d->drag_drop_flags = ObserverHints::DragDropFlags (qi32);
+    d->hints()->drag_drop_flags = ObserverHints::DragDropFlags (qi32);
     stream >> qi32;
-    d->modification_state_display = ObserverHints::ModificationStateDisplayHint (qi32);
+    d->hints()->modification_state_display = ObserverHints::ModificationStateDisplayHint (qi32);
 
     // -----------------------------------
     // Start of specific to Qtilities::Qtilities_1_1:
     // -----------------------------------
     if (exportVersion() == Qtilities::Qtilities_1_1) {
         stream >> qi32;
-        d->category_editing_flags = ObserverHints::CategoryEditingFlags (qi32);
+        d->hints()->category_editing_flags = ObserverHints::CategoryEditingFlags (qi32);
     }
     // -----------------------------------
     // End of specific to Qtilities::Qtilities_1_1:
     // -----------------------------------
     // Start of specific to Qtilities::Qtilities_1_2:
     // -----------------------------------
-    if (exportVersion() == Qtilities::Qtilities_1_2) {
+    if (exportVersion() >= Qtilities::Qtilities_1_2) {
         stream >> qi32;
-        d->root_index_display_hint = ObserverHints::RootIndexDisplayHint (qi32);
+        d->hints()->root_index_display_hint = ObserverHints::RootIndexDisplayHint (qi32);
     }
     // -----------------------------------
     // End of specific to Qtilities::Qtilities_1_2:
@@ -750,11 +818,11 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     int category_count = qi32;
     for (int i = 0; i < category_count; ++i) {
         QtilitiesCategory category(stream,exportVersion());
-        d->displayed_categories << category;
+        d->hints()->displayed_categories << category;
     }
 
-    stream >> d->has_inversed_category_display;
-    stream >> d->category_filter_enabled;
+    stream >> d->hints()->has_inversed_category_display;
+    stream >> d->hints()->category_filter_enabled;
 
     if (observerContext())
         observerContext()->setModificationState(true);
@@ -768,67 +836,67 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
         return version_check_result;
 
     // Export hints:
-    if (d->action_hints != ActionNoHints)
-        object_node->setAttribute("ActionHints",actionHintsToString(d->action_hints));
-    if (d->activity_control != NoActivityControlHint)
-        object_node->setAttribute("ActivityControl",activityControlToString(d->activity_control));
-    if (d->activity_display != NoActivityDisplayHint)
-        object_node->setAttribute("ActivityDisplay",activityDisplayToString(d->activity_display));
-    if (d->display_flags != NoDisplayFlagsHint)
-        object_node->setAttribute("DisplayFlags",displayFlagsToString(d->display_flags));
-    if (d->drag_drop_flags != NoDragDrop)
-        object_node->setAttribute("DragDropFlags",dragDropFlagsToString(d->drag_drop_flags));
-    if (d->hierarhical_display != NoHierarchicalDisplayHint)
-        object_node->setAttribute("HierarchicalDisplay",hierarchicalDisplayToString(d->hierarhical_display));
-    if (d->item_view_column_hint != SelectableItems)
-        object_node->setAttribute("ItemSelectionControl",itemSelectionControlToString(d->item_selection_control));
-    if (d->item_view_column_hint != ColumnNoHints)
-        object_node->setAttribute("ItemViewColumnFlags",itemViewColumnFlagsToString(d->item_view_column_hint));
-    if (d->naming_control != NoNamingControlHint)
-        object_node->setAttribute("NamingControl",namingControlToString(d->naming_control));
-    if (d->observer_selection_context != SelectionUseParentContext)
-        object_node->setAttribute("ObserverSelectionContext",observerSelectionContextToString(d->observer_selection_context));
-    if (d->modification_state_display != NoModificationStateDisplayHint)
-        object_node->setAttribute("ModificationStateDisplay",modificationStateDisplayToString(d->modification_state_display));
+    if (d->constHints()->action_hints != ActionNoHints)
+        object_node->setAttribute("ActionHints",actionHintsToString(d->constHints()->action_hints));
+    if (d->constHints()->activity_control != NoActivityControlHint)
+        object_node->setAttribute("ActivityControl",activityControlToString(d->constHints()->activity_control));
+    if (d->constHints()->activity_display != NoActivityDisplayHint)
+        object_node->setAttribute("ActivityDisplay",activityDisplayToString(d->constHints()->activity_display));
+    if (d->constHints()->display_flags != NoDisplayFlagsHint)
+        object_node->setAttribute("DisplayFlags",displayFlagsToString(d->constHints()->display_flags));
+    if (d->constHints()->drag_drop_flags != NoDragDrop)
+        object_node->setAttribute("DragDropFlags",dragDropFlagsToString(d->constHints()->drag_drop_flags));
+    if (d->constHints()->hierarhical_display != NoHierarchicalDisplayHint)
+        object_node->setAttribute("HierarchicalDisplay",hierarchicalDisplayToString(d->constHints()->hierarhical_display));
+    if (d->constHints()->item_view_column_hint != SelectableItems)
+        object_node->setAttribute("ItemSelectionControl",itemSelectionControlToString(d->constHints()->item_selection_control));
+    if (d->constHints()->item_view_column_hint != ColumnNoHints)
+        object_node->setAttribute("ItemViewColumnFlags",itemViewColumnFlagsToString(d->constHints()->item_view_column_hint));
+    if (d->constHints()->naming_control != NoNamingControlHint)
+        object_node->setAttribute("NamingControl",namingControlToString(d->constHints()->naming_control));
+    if (d->constHints()->observer_selection_context != SelectionUseParentContext)
+        object_node->setAttribute("ObserverSelectionContext",observerSelectionContextToString(d->constHints()->observer_selection_context));
+    if (d->constHints()->modification_state_display != NoModificationStateDisplayHint)
+        object_node->setAttribute("ModificationStateDisplay",modificationStateDisplayToString(d->constHints()->modification_state_display));
 
     // -----------------------------------
     // Start of specific to Qtilities::Qtilities_1_1:
     // -----------------------------------
     if (exportVersion() == Qtilities::Qtilities_1_1) {
-        if (d->category_editing_flags != CategoriesReadOnly)
-            object_node->setAttribute("CategoryEditingFlags",categoryEditingFlagsToString(d->category_editing_flags));
+        if (d->constHints()->category_editing_flags != CategoriesReadOnly)
+            object_node->setAttribute("CategoryEditingFlags",categoryEditingFlagsToString(d->constHints()->category_editing_flags));
     }
     // -----------------------------------
     // End of specific to Qtilities::Qtilities_1_1:
     // -----------------------------------
     // Start of specific to Qtilities::Qtilities_1_2:
     // -----------------------------------
-    if (exportVersion() == Qtilities::Qtilities_1_2) {
-        if (d->root_index_display_hint != RootIndexHide)
-            object_node->setAttribute("RootIndexDisplayHint",rootIndexDisplayHintToString(d->root_index_display_hint));
+    if (exportVersion() >= Qtilities::Qtilities_1_2) {
+        if (d->constHints()->root_index_display_hint != RootIndexHide)
+            object_node->setAttribute("RootIndexDisplayHint",rootIndexDisplayHintToString(d->constHints()->root_index_display_hint));
     }
     // -----------------------------------
     // End of specific to Qtilities::Qtilities_1_2:
     // -----------------------------------
 
     // Export category related stuff only if it is neccesarry:
-    if (d->displayed_categories.count() > 0) {
+    if (d->constHints()->displayed_categories.count() > 0) {
         QDomElement category_data = doc->createElement("CategoryFilter");
         object_node->appendChild(category_data);
 
-        if (d->category_filter_enabled)
+        if (d->constHints()->category_filter_enabled)
             category_data.setAttribute("FilterEnabled","True");
         else
             category_data.setAttribute("FilterEnabled","False");
-        if (d->has_inversed_category_display)
+        if (d->constHints()->has_inversed_category_display)
             category_data.setAttribute("FilterInversed","True");
         else
             category_data.setAttribute("FilterInversed","False");
-        category_data.setAttribute("CategoryCount",d->displayed_categories.count());
+        category_data.setAttribute("CategoryCount",d->constHints()->displayed_categories.count());
 
-        for (int i = 0; i < d->displayed_categories.count(); ++i) {
+        for (int i = 0; i < d->constHints()->displayed_categories.count(); ++i) {
             QDomElement category_item = doc->createElement("Category_" + QString::number(i));
-            d->displayed_categories.at(i).exportXml(doc,&category_item);
+            d->constHints()->displayed_categories.at(i).exportXml(doc,&category_item);
             category_data.appendChild(category_item);
         }
     }
@@ -844,40 +912,40 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
      
     // Hints:
     if (object_node->hasAttribute("ActionHints"))
-        d->action_hints = stringToActionHints(object_node->attribute("ActionHints"));
+        d->hints()->action_hints = stringToActionHints(object_node->attribute("ActionHints"));
     if (object_node->hasAttribute("ActivityControl"))
-        d->activity_control = stringToActivityControl(object_node->attribute("ActivityControl"));
+        d->hints()->activity_control = stringToActivityControl(object_node->attribute("ActivityControl"));
     if (object_node->hasAttribute("ActivityDisplay"))
-        d->activity_display = stringToActivityDisplay(object_node->attribute("ActivityDisplay"));
+        d->hints()->activity_display = stringToActivityDisplay(object_node->attribute("ActivityDisplay"));
     if (object_node->hasAttribute("DisplayFlags"))
-        d->display_flags = stringToDisplayFlags(object_node->attribute("DisplayFlags"));
+        d->hints()->display_flags = stringToDisplayFlags(object_node->attribute("DisplayFlags"));
     if (object_node->hasAttribute("DragDropFlags"))
-        d->drag_drop_flags = stringToDragDropFlags(object_node->attribute("DragDropFlags"));
+        d->hints()->drag_drop_flags = stringToDragDropFlags(object_node->attribute("DragDropFlags"));
     if (object_node->hasAttribute("HierarchicalDisplay"))
-        d->hierarhical_display = stringToHierarchicalDisplay(object_node->attribute("HierarchicalDisplay"));
+        d->hints()->hierarhical_display = stringToHierarchicalDisplay(object_node->attribute("HierarchicalDisplay"));
     if (object_node->hasAttribute("ItemSelectionControl"))
-        d->item_selection_control = stringToItemSelectionControl(object_node->attribute("ItemSelectionControl"));
+        d->hints()->item_selection_control = stringToItemSelectionControl(object_node->attribute("ItemSelectionControl"));
     if (object_node->hasAttribute("ItemViewColumnFlags"))
-        d->item_view_column_hint = stringToItemViewColumnFlags(object_node->attribute("ItemViewColumnFlags"));
+        d->hints()->item_view_column_hint = stringToItemViewColumnFlags(object_node->attribute("ItemViewColumnFlags"));
     if (object_node->hasAttribute("NamingControl"))
-        d->naming_control = stringToNamingControl(object_node->attribute("NamingControl"));
+        d->hints()->naming_control = stringToNamingControl(object_node->attribute("NamingControl"));
     if (object_node->hasAttribute("ObserverSelectionContext"))
-        d->observer_selection_context = stringToObserverSelectionContext(object_node->attribute("ObserverSelectionContext"));
+        d->hints()->observer_selection_context = stringToObserverSelectionContext(object_node->attribute("ObserverSelectionContext"));
     if (object_node->hasAttribute("ModificationStateDisplay"))
-        d->modification_state_display = stringToModificationStateDisplay(object_node->attribute("ModificationStateDisplay"));
+        d->hints()->modification_state_display = stringToModificationStateDisplay(object_node->attribute("ModificationStateDisplay"));
 
     // -----------------------------------
     // Start of specific to Qtilities v1.1:
     // -----------------------------------
     if (object_node->hasAttribute("CategoryEditingFlags"))
-        d->category_editing_flags = stringToCategoryEditingFlags(object_node->attribute("CategoryEditingFlags"));
+        d->hints()->category_editing_flags = stringToCategoryEditingFlags(object_node->attribute("CategoryEditingFlags"));
     // -----------------------------------
     // End of specific to Qtilities v1.1:
     // -----------------------------------
     // Start of specific to Qtilities v1.2:
     // -----------------------------------
     if (object_node->hasAttribute("RootIndexDisplayHint"))
-        d->root_index_display_hint = stringToRootIndexDisplayHint(object_node->attribute("RootIndexDisplayHint"));
+        d->hints()->root_index_display_hint = stringToRootIndexDisplayHint(object_node->attribute("RootIndexDisplayHint"));
     // -----------------------------------
     // End of specific to Qtilities v1.2:
     // -----------------------------------
@@ -894,13 +962,13 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
 
         if (child.tagName() == QLatin1String("CategoryFilter")) {
             if (child.attribute("FilterEnabled") == QLatin1String("True"))
-                d->category_filter_enabled = true;
+                d->hints()->category_filter_enabled = true;
             else
-                d->category_filter_enabled = false;
+                d->hints()->category_filter_enabled = false;
             if (child.attribute("FilterInversed") == QLatin1String("True"))
-                d->has_inversed_category_display = true;
+                d->hints()->has_inversed_category_display = true;
             else
-                d->has_inversed_category_display = false;
+                d->hints()->has_inversed_category_display = false;
             QDomNodeList categoryNodes = child.childNodes();
             for(int i = 0; i < categoryNodes.count(); ++i)
             {
@@ -914,7 +982,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
                     QtilitiesCategory new_category;
                     new_category.importXml(doc,&category,import_list);
                     if (new_category.isValid())
-                        d->displayed_categories << new_category;
+                        d->hints()->displayed_categories << new_category;
                     continue;
                 }
             }
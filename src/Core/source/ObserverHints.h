@@ -357,6 +357,17 @@ category_filter_enabled(false),
             bool operator==(const ObserverHints& other) const;
             bool operator!=(const ObserverHints& other) const;
 
+            //! Returns an id which is the same for all ObserverHints objects with equal hints.
+            /*!
+              The hints of ObserverHints objects are implicitly shared: Copies share the hints of the object they were copied from until
+              one of them changes its hints. When the id of the hints is requested, the hints are interned, thus all ObserverHints objects
+              with equal hints whose ids were requested share a single copy of the hints. Views can use the id to cache decisions which only
+              depend on the hints, for example whether observers are displayed as a categorized hierarchy. The default hints have id 0.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int hintSetId() const;
+
             // --------------------------------
             // Hints Getter and Setter Functions
             // --------------------------------
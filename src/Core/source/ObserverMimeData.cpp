@@ -0,0 +1,160 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ObserverMimeData.h"
+#include "IExportable.h"
+#include "IFactoryProvider.h"
+#include "InstanceFactoryInfo.h"
+#include "QtilitiesCoreApplication.h"
+#include "CompactBinaryFormat.h"
+
+#include <Logger>
+
+#include <QDataStream>
+
+using namespace Qtilities::Core::Interfaces;
+
+namespace {
+    //! Marker written at the start of the export format, used to detect invalid data provided by other applications.
+    /*!
+      The subjects following the header share a single CompactBinaryFormat string table and are written in sections, thus the marker
+      differs from the one used by the first version of the format, which wrote every subject in full.
+      */
+    const quint32 qti_private_OBSERVER_MIME_DATA_EXPORT_MARKER = 0x51544D45;
+}
+
+QStringList Qtilities::Core::ObserverMimeData::formats() const {
+    QStringList mime_formats = QMimeData::formats();
+    for (int i = 0; i < d_subject_list.count(); ++i) {
+        if (qobject_cast<IExportable*> (d_subject_list.at(i))) {
+            mime_formats << QString(Qtilities::Core::Constants::qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE);
+            break;
+        }
+    }
+    return mime_formats;
+}
+
+QVariant Qtilities::Core::ObserverMimeData::retrieveData(const QString& mimetype, QVariant::Type type) const {
+    if (mimetype != QLatin1String(Qtilities::Core::Constants::qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE))
+        return QMimeData::retrieveData(mimetype,type);
+
+    if (!d_export_data_valid)
+        exportSubjects();
+    return d_export_data;
+}
+
+void Qtilities::Core::ObserverMimeData::exportSubjects() const {
+    d_export_data.clear();
+    d_export_data_valid = true;
+
+    QList<IExportable*> exportable_list;
+    for (int i = 0; i < d_subject_list.count(); ++i) {
+        IExportable* iface = qobject_cast<IExportable*> (d_subject_list.at(i));
+        if (iface)
+            exportable_list << iface;
+    }
+
+    QDataStream stream(&d_export_data,QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_4_7);
+    stream << qti_private_OBSERVER_MIME_DATA_EXPORT_MARKER;
+    stream << (quint32) Qtilities::Qtilities_Latest;
+    stream << (qint32) d_source_id;
+
+    // All subjects share one string table, thus factory tags and names which are used by many subjects are only written once:
+    CompactBinaryFormat::WriteScope scope(stream);
+    QDataStream& subject_stream = scope.stream();
+    CompactBinaryFormat::writeVarUInt(subject_stream,exportable_list.count());
+
+    for (int i = 0; i < exportable_list.count(); ++i) {
+        IExportable* iface = exportable_list.at(i);
+        iface->setExportVersion(Qtilities::Qtilities_Latest);
+        // Every subject is written in a section, thus importers can skip subjects which they cannot construct:
+        qint64 section_position = CompactBinaryFormat::beginSection(subject_stream);
+        if (!iface->instanceFactoryInfo().exportBinary(subject_stream,Qtilities::Qtilities_Latest) || iface->exportBinary(subject_stream) == IExportable::Failed) {
+            LOG_WARNING(QString("Failed to export \"%1\" for the clipboard, other applications will not be able to paste the selection.").arg(iface->objectBase()->objectName()));
+            d_export_data.clear();
+            return;
+        }
+        CompactBinaryFormat::endSection(subject_stream,section_position);
+    }
+
+    scope.finish();
+}
+
+bool Qtilities::Core::ObserverMimeData::importSubjects(const QMimeData* mime_data, QList<QObject*>& subjects) {
+    if (!mime_data)
+        return false;
+
+    QByteArray export_data = mime_data->data(Qtilities::Core::Constants::qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE);
+    if (export_data.isEmpty())
+        return false;
+
+    QDataStream stream(export_data);
+    stream.setVersion(QDataStream::Qt_4_7);
+    quint32 marker;
+    quint32 export_version;
+    qint32 source_id;
+    stream >> marker;
+    if (marker != qti_private_OBSERVER_MIME_DATA_EXPORT_MARKER)
+        return false;
+    stream >> export_version;
+    stream >> source_id;
+    if (export_version > (quint32) Qtilities::Qtilities_Latest || stream.status() != QDataStream::Ok)
+        return false;
+
+    CompactBinaryFormat::ReadScope scope(stream);
+    if (!scope.isValid())
+        return false;
+    quint64 subject_count = CompactBinaryFormat::readVarUInt(stream);
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    bool success = true;
+    for (quint64 i = 0; i < subject_count; ++i) {
+        quint32 section_length = CompactBinaryFormat::readSectionLength(stream);
+        if (stream.status() != QDataStream::Ok)
+            return false;
+        const qint64 section_end = stream.device()->pos() + section_length;
+
+        InstanceFactoryInfo instanceFactoryInfo;
+        if (!instanceFactoryInfo.importBinary(stream,(Qtilities::ExportVersion) export_version) || !instanceFactoryInfo.isValid())
+            return false;
+
+        // Subjects of which the factories do not exist in this application are skipped:
+        IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
+        if (!ifactory) {
+            LOG_WARNING(QString("Factory \"%1\" does not exist, pasted data which needs this factory cannot be imported.").arg(instanceFactoryInfo.d_factory_tag));
+            success = false;
+            if (!stream.device()->seek(section_end))
+                return false;
+            continue;
+        }
+
+        QObject* new_instance = ifactory->createInstance(instanceFactoryInfo);
+        if (!new_instance)
+            return false;
+        new_instance->setObjectName(instanceFactoryInfo.d_instance_name);
+        subjects << new_instance;
+
+        IExportable* export_iface = qobject_cast<IExportable*> (new_instance);
+        if (!export_iface)
+            return false;
+
+        QList<QPointer<QObject> > import_list;
+        export_iface->setExportVersion((Qtilities::ExportVersion) export_version);
+        if (export_iface->importBinary(stream,import_list) == IExportable::Failed)
+            return false;
+        if (stream.device()->pos() != section_end)
+            return false;
+    }
+
+    return success;
+}
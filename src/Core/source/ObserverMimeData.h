@@ -18,6 +18,7 @@
 #include <QMimeData>
 #include <QList>
 #include <QPointer>
+#include <QStringList>
 
 namespace Qtilities {
     namespace Core {
@@ -26,12 +27,24 @@ namespace Qtilities {
           \brief The ObserverMimeData stores information about subjects when Qtilities does drag and drops between ObserverWidget views.
 
           ObserverMimeData will return Qtilities::Core::Constants::qti_def_OBSERVER_MIME_DATA_MIME_TYPE as its format in formats().
+
+          The mime data object only holds references to the subjects, thus copying or cutting a large selection does not copy
+          the subjects. When pasted in the same application, the subjects are attached in one go through Observer::attachSubjects().
+
+          Since %Qtilities v1.5, formats() also returns Qtilities::Core::Constants::qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE when any of the
+          subjects implement Qtilities::Core::Interfaces::IExportable. The binary export of the subjects is only produced when this format is
+          actually requested, for example when another application pastes the data, after which it is cached in the mime data object. Use
+          importSubjects() to construct the subjects from such data.
+
+          The export format uses the compact binary format of observer exports, see Qtilities::Core::CompactBinaryFormat. All subjects share one string
+          table and every subject is written in its own section. Thus dragging or copying large subtrees to other applications does not require an XML export.
          */
         class QTILIITES_CORE_SHARED_EXPORT ObserverMimeData : public QMimeData {
             Q_OBJECT
 
         public:
-            ObserverMimeData(QList<QPointer<QObject> > subject_list, int source_id, Qt::DropAction drop_action) : QMimeData() {
+            ObserverMimeData(QList<QPointer<QObject> > subject_list, int source_id, Qt::DropAction drop_action) : QMimeData(),
+                d_export_data_valid(false) {
                 d_source_id = source_id;
                 d_subject_list = subject_list;
                 d_drop_action = drop_action;
@@ -41,7 +54,8 @@ namespace Qtilities {
             ObserverMimeData(const ObserverMimeData& other) : QMimeData(),
                 d_source_id(other.sourceID()),
                 d_subject_list(other.subjectList()),
-                d_drop_action(other.dropAction()) {
+                d_drop_action(other.dropAction()),
+                d_export_data_valid(false) {
 
                 QByteArray ba;
                 setData(Qtilities::Core::Constants::qti_def_OBSERVER_MIME_DATA_MIME_TYPE,ba);
@@ -54,10 +68,43 @@ namespace Qtilities {
             //! Gets the drop action assocaited with this mime data object when used during a drop action.
             Qt::DropAction dropAction() const { return d_drop_action; }
 
+            //! Returns the formats of the mime data object.
+            /*!
+              Adds Qtilities::Core::Constants::qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE to the formats returned by QMimeData when any
+              of the subjects implement IExportable. Checking the formats does not export the subjects.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QStringList formats() const;
+            //! Constructs the subjects in the export format of \p mime_data, typically provided by another application.
+            /*!
+              The subjects are constructed using their factories, and imported using IExportable::importBinary(). The caller becomes
+              the owner of the constructed subjects, which can be attached to an observer in one go using Observer::attachSubjects().
+
+              \param mime_data The mime data which provides Qtilities::Core::Constants::qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE.
+              \param subjects The constructed subjects are appended to this list.
+              Subjects of which the factories do not exist in this application are skipped, after which the remaining subjects are still imported.
+
+              \returns True when all subjects were constructed and imported successfully. When false, subjects which were constructed
+              before the failure are still appended to \p subjects.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static bool importSubjects(const QMimeData* mime_data, QList<QObject*>& subjects);
+
+        protected:
+            //! Exports the subjects the first time Qtilities::Core::Constants::qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE is requested.
+            QVariant retrieveData(const QString& mimetype, QVariant::Type type) const;
+
         private:
+            //! Exports the subjects implementing IExportable into d_export_data.
+            void exportSubjects() const;
+
             int                         d_source_id;
             QList<QPointer<QObject> >   d_subject_list;
             Qt::DropAction              d_drop_action;
+            mutable QByteArray          d_export_data;
+            mutable bool                d_export_data_valid;
         };
     }
 }
@@ -10,12 +10,16 @@
 ****************************************************************************/
 
 #include "ObserverRelationalTable.h"
+#include "CborStream.h"
 #include "QtilitiesCoreConstants.h"
 #include "QtilitiesProperty.h"
 
 #include <Logger>
 
 #include <QDomDocument>
+#include <QHash>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 
 using namespace Qtilities::Core::Constants;
 
@@ -32,6 +36,7 @@ struct Qtilities::Core::RelationalTableEntryData {
         ownership = -1;
         sessionID = -1;
         obj = 0;
+        table = 0;
     }
 
     //! The visitor IDs of all parents of this item.
@@ -52,6 +57,8 @@ struct Qtilities::Core::RelationalTableEntryData {
     int             parentVisitorID;
     //! A reference to the object.
     QObject*        obj;
+    //! The table to which this entry was added, used to invalidate the table's indexes when IDs change.
+    ObserverRelationalTable* table;
 };
 
 Qtilities::Core::RelationalTableEntry::RelationalTableEntry() {
@@ -131,6 +138,8 @@ int Qtilities::Core::RelationalTableEntry::visitorID() const {
 
 void Qtilities::Core::RelationalTableEntry::setVisitorID(int visitor_id) {
     d->visitorID = visitor_id;
+    if (d->table)
+        d->table->invalidateVisitorIndex();
 }
 
 int Qtilities::Core::RelationalTableEntry::sessionID() const {
@@ -139,6 +148,8 @@ int Qtilities::Core::RelationalTableEntry::sessionID() const {
 
 void Qtilities::Core::RelationalTableEntry::setSessionID(int session_id) {
     d->sessionID = session_id;
+    if (d->table)
+        d->table->invalidateSessionIndexes();
 }
 
 int Qtilities::Core::RelationalTableEntry::previousSessionID() const {
@@ -147,6 +158,8 @@ int Qtilities::Core::RelationalTableEntry::previousSessionID() const {
 
 void Qtilities::Core::RelationalTableEntry::setPreviousSessionID(int session_id) {
     d->previousSessionID = session_id;
+    if (d->table)
+        d->table->invalidateSessionIndexes();
 }
 
 QString Qtilities::Core::RelationalTableEntry::name() const {
@@ -200,6 +213,7 @@ Qtilities::Core::Interfaces::IExportable::ExportModeFlags Qtilities::Core::Relat
     IExportable::ExportModeFlags flags = 0;
     flags |= IExportable::Binary;
     flags |= IExportable::XML;
+    flags |= IExportable::Cbor;
     return flags;
 }
 
@@ -304,6 +318,167 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Rel
     return IExportable::Complete;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::RelationalTableEntry::exportXmlStream(QXmlStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (!writer)
+        return IExportable::Failed;
+
+    writer->writeAttribute("Name",d->name);
+    if (d->parents.count() > 0)
+        writer->writeAttribute("Parents",intListToString(d->parents));
+    if (d->children.count() > 0)
+        writer->writeAttribute("Children",intListToString(d->children));
+    writer->writeAttribute("VisitorID",QString::number(d->visitorID));
+    writer->writeAttribute("SessionID",QString::number(d->sessionID));
+    writer->writeAttribute("Ownership",QString::number(d->ownership));
+    writer->writeAttribute("ParentVisitorID",QString::number(d->parentVisitorID));
+
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::RelationalTableEntry::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    Q_UNUSED(import_list)
+
+    if (!reader || !reader->isStartElement())
+        return IExportable::Failed;
+
+    // Entries only have attributes:
+    QXmlStreamAttributes attributes = reader->attributes();
+    reader->skipCurrentElement();
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (attributes.hasAttribute("Name"))
+        d->name = attributes.value("Name").toString();
+    else
+        return IExportable::Failed;
+    if (attributes.hasAttribute("Parents"))
+        d->parents = stringToIntList(attributes.value("Parents").toString());
+    if (attributes.hasAttribute("Children"))
+        d->children = stringToIntList(attributes.value("Children").toString());
+    if (attributes.hasAttribute("VisitorID"))
+        d->visitorID = attributes.value("VisitorID").toString().toInt();
+    else
+        return IExportable::Failed;
+    if (attributes.hasAttribute("SessionID"))
+        d->sessionID = attributes.value("SessionID").toString().toInt();
+    else
+        return IExportable::Failed;
+    if (attributes.hasAttribute("Ownership"))
+        d->ownership = attributes.value("Ownership").toString().toInt();
+    else
+        return IExportable::Failed;
+    if (attributes.hasAttribute("ParentVisitorID"))
+        d->parentVisitorID = attributes.value("ParentVisitorID").toString().toInt();
+    else
+        return IExportable::Failed;
+
+    return IExportable::Complete;
+}
+
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::RelationalTableEntry::exportCbor(CborStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (!writer)
+        return IExportable::Failed;
+
+    writer->startMap();
+    writer->writeString("name");
+    writer->writeString(d->name);
+    writer->writeString("visitorId");
+    writer->writeInteger(d->visitorID);
+    writer->writeString("sessionId");
+    writer->writeInteger(d->sessionID);
+    writer->writeString("ownership");
+    writer->writeInteger(d->ownership);
+    writer->writeString("parentVisitorId");
+    writer->writeInteger(d->parentVisitorID);
+    if (d->parents.count() > 0) {
+        writer->writeString("parents");
+        writer->startArray(d->parents.count());
+        for (int i = 0; i < d->parents.count(); ++i)
+            writer->writeInteger(d->parents.at(i));
+        writer->endArray();
+    }
+    if (d->children.count() > 0) {
+        writer->writeString("children");
+        writer->startArray(d->children.count());
+        for (int i = 0; i < d->children.count(); ++i)
+            writer->writeInteger(d->children.at(i));
+        writer->endArray();
+    }
+    writer->endMap();
+
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::RelationalTableEntry::importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    Q_UNUSED(import_list)
+
+    if (!reader)
+        return IExportable::Failed;
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported) {
+        reader->next();
+        return version_check_result;
+    }
+
+    if (!reader->isMap()) {
+        reader->next();
+        return IExportable::Failed;
+    }
+
+    // The same values as in importXml() are required:
+    int required_values = 0;
+    reader->enterContainer();
+    while (reader->hasNext()) {
+        QString key = reader->readString();
+        if (key == QLatin1String("name") && reader->isString()) {
+            d->name = reader->readString();
+            ++required_values;
+        } else if ((key == QLatin1String("parents") || key == QLatin1String("children")) && reader->isArray()) {
+            QList<int> ids;
+            reader->enterContainer();
+            while (reader->hasNext()) {
+                ids << (int) reader->toInteger();
+                reader->next();
+            }
+            reader->leaveContainer();
+            if (key == QLatin1String("parents"))
+                d->parents = ids;
+            else
+                d->children = ids;
+        } else if (reader->isInteger() && (key == QLatin1String("visitorId") || key == QLatin1String("sessionId") || key == QLatin1String("ownership") || key == QLatin1String("parentVisitorId"))) {
+            int value = (int) reader->toInteger();
+            if (key == QLatin1String("visitorId"))
+                d->visitorID = value;
+            else if (key == QLatin1String("sessionId"))
+                d->sessionID = value;
+            else if (key == QLatin1String("ownership"))
+                d->ownership = value;
+            else
+                d->parentVisitorID = value;
+            ++required_values;
+            reader->next();
+        } else
+            reader->next();
+    }
+    reader->leaveContainer();
+
+    if (reader->hasError() || required_values != 5)
+        return IExportable::Failed;
+    return IExportable::Complete;
+}
+
 
 // -------------------------------------------------------
 // ObserverRelationalTable
@@ -312,16 +487,30 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Rel
 struct Qtilities::Core::ObserverRelationalTablePrivateData {
     ObserverRelationalTablePrivateData() : observer(0),
     visitor_id_count(0),
-    exportable_subjects_only(false) {}
+    exportable_subjects_only(false),
+    visitor_index_valid(false),
+    session_indexes_valid(false) {}
     ~ObserverRelationalTablePrivateData() {
-        for (int i = 0; i < entries.count(); ++i)
-            delete entries.values().at(i);
+        qDeleteAll(entries);
     }
 
     Observer*                           observer;
     QMap<int, RelationalTableEntry*>    entries;
     int                                 visitor_id_count;
     bool                                exportable_subjects_only;
+
+    //! The entries in visitor ID order, used by entryAt().
+    QList<RelationalTableEntry*>        entry_list;
+    //! The entries indexed by their visitor IDs, which only differ from the keys in entries when an entry's visitor ID changed after it was added.
+    QHash<int, RelationalTableEntry*>   visitor_index;
+    //! Indicates if entry_list and visitor_index are valid.
+    bool                                visitor_index_valid;
+    //! The entries indexed by their session IDs.
+    QHash<int, RelationalTableEntry*>   session_index;
+    //! The entries indexed by their previous session IDs.
+    QHash<int, RelationalTableEntry*>   previous_session_index;
+    //! Indicates if session_index and previous_session_index are valid.
+    bool                                session_indexes_valid;
 };
 
 Qtilities::Core::ObserverRelationalTable::ObserverRelationalTable(Observer* observer, bool exportable_subjects_only) {
@@ -340,11 +529,10 @@ Qtilities::Core::ObserverRelationalTable::ObserverRelationalTable(const Observer
     d = new ObserverRelationalTablePrivateData;
     d->observer = other.d->observer;
     d->exportable_subjects_only = other.d->exportable_subjects_only;
-    for (int i = 0; i < other.count(); ++i) {
-        RelationalTableEntry* other_entry_ptr = other.entryAt(i);
-        RelationalTableEntry* entry_ptr = new RelationalTableEntry(*other_entry_ptr);
+    for (QMap<int, RelationalTableEntry*>::const_iterator itr = other.d->entries.constBegin(); itr != other.d->entries.constEnd(); ++itr) {
+        RelationalTableEntry* entry_ptr = new RelationalTableEntry(*itr.value());
         entry_ptr->setSessionID(-1);
-        d->entries[other_entry_ptr->visitorID()] = entry_ptr;
+        addEntry(entry_ptr);
     }
 }
 
@@ -356,10 +544,7 @@ Qtilities::Core::ObserverRelationalTable::~ObserverRelationalTable() {
     removeRelationalProperties(d->observer);
 
     // Delete all entries
-    for (int i = 0; i < d->entries.count(); ++i) {
-        delete d->entries.values().at(i);
-        d->entries[d->entries.keys().at(i)] = 0;
-    }
+    clearEntries();
     delete d;
 }
 
@@ -367,52 +552,46 @@ void Qtilities::Core::ObserverRelationalTable::refresh() {
     // Clear up everything:
     removeRelationalProperties(d->observer);
     // Delete all entries
-    for (int i = 0; i < d->entries.count(); ++i) {
-        delete d->entries.values().at(i);
-        d->entries[d->entries.keys().at(i)] = 0;
-    }
-    d->entries.clear();
+    clearEntries();
     d->visitor_id_count = 0;
 
     // Now construct the table again:
     constructTable(d->observer);
 }
 
-bool Qtilities::Core::ObserverRelationalTable::compare(ObserverRelationalTable other) const {
-    bool result = true;
-
+bool Qtilities::Core::ObserverRelationalTable::compare(const ObserverRelationalTable& other) const {
     // Check for the same amount of items first.
     if (d->entries.count() != other.count()) {
-        LOG_TRACE(QString("ObserverRelationalTable::compare() failed. Number of entries in table (%1) does not match the number of entries in the table to check (%2).").arg(d->entries.count()).arg(other.count()));
-        LOG_TRACE("Items in table:");
-        for (int i = 0; i < d->entries.count(); ++i) {
-            if (d->entries.values().at(i))
-                LOG_TRACE(d->entries.values().at(i)->name());
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("ObserverRelationalTable::compare() failed. Number of entries in table (%1) does not match the number of entries in the table to check (%2).").arg(d->entries.count()).arg(other.count()));
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Items in table:");
+        for (QMap<int, RelationalTableEntry*>::const_iterator itr = d->entries.constBegin(); itr != d->entries.constEnd(); ++itr) {
+            if (itr.value())
+                LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,itr.value()->name());
         }
-        LOG_TRACE("Items in comparison table:");
-        for (int i = 0; i < other.count(); ++i) {
-            if (other.entryAt(i))
-                LOG_TRACE(other.entryAt(i)->name());
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Items in comparison table:");
+        for (QMap<int, RelationalTableEntry*>::const_iterator itr = other.d->entries.constBegin(); itr != other.d->entries.constEnd(); ++itr) {
+            if (itr.value())
+                LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,itr.value()->name());
         }
         return false;
     }
 
-    // We compare by looking up each item in table in this table and compare each item individially.
-    for (int i = 0; i < d->entries.count(); ++i) {
-        if (!d->entries.values().at(i)) {
+    // We compare the entries of both tables in visitor ID order, thus matching entries are at the same positions in both tables:
+    QMap<int, RelationalTableEntry*>::const_iterator other_itr = other.d->entries.constBegin();
+    for (QMap<int, RelationalTableEntry*>::const_iterator itr = d->entries.constBegin(); itr != d->entries.constEnd(); ++itr, ++other_itr) {
+        if (!itr.value()) {
             LOG_FATAL(QObject::tr("Null entry found in current observer in method ObserverRelationalTable::compare()."));
             return false;
         }
-        if (!other.entryAt(i)) {
+        if (!other_itr.value()) {
             LOG_FATAL(QObject::tr("Null entry found in other observer in method ObserverRelationalTable::compare()."));
             return false;
         }
-        if (*d->entries.values().at(i) != *other.entryAt(i)) {
+        if (*itr.value() != *other_itr.value())
             return false;
-        }
     }
 
-    return result;
+    return true;
 }
 
 int Qtilities::Core::ObserverRelationalTable::count() const {
@@ -420,37 +599,26 @@ int Qtilities::Core::ObserverRelationalTable::count() const {
 }
 
 Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable::entryWithVisitorID(int visitor_id) const {
-    for (int i = 0; i < d->entries.count(); ++i) {
-        if (d->entries.values().at(i)->visitorID() == visitor_id)
-            return d->entries.values().at(i);
-    }
-
-    return 0;
+    buildVisitorIndex();
+    return d->visitor_index.value(visitor_id);
 }
 
 Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable::entryWithSessionID(int session_id) const {
-    for (int i = 0; i < d->entries.count(); ++i) {
-        if (d->entries.values().at(i)->sessionID() == session_id)
-            return d->entries.values().at(i);
-    }
-
-    return 0;
+    buildSessionIndexes();
+    return d->session_index.value(session_id);
 }
 
 Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable::entryWithPreviousSessionID(int session_id) const {
-    for (int i = 0; i < d->entries.count(); ++i) {
-        if (d->entries.values().at(i)->previousSessionID() == session_id)
-            return d->entries.values().at(i);
-    }
-
-    return 0;
+    buildSessionIndexes();
+    return d->previous_session_index.value(session_id);
 }
 
 Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable::entryAt(int index) {
     if (index < 0 || index >= d->entries.count())
         return 0;
 
-    return d->entries.values().at(index);
+    buildVisitorIndex();
+    return d->entry_list.at(index);
 }
 
 int Qtilities::Core::ObserverRelationalTable::getVisitorID(QObject* obj) {
@@ -524,13 +692,13 @@ bool Qtilities::Core::ObserverRelationalTable::compareObjects(QList<QPointer<QOb
     // Check for the same amount of items first.
     if (d->entries.count() != objects.count()) {
         LOG_ERROR(QString("ObserverRelationalTable::compareObjects() failed. Number of entries in table (%1) does not match the number of objects in list to check (%2).").arg(d->entries.count()).arg(objects.count()));
-        LOG_TRACE("Items in relational table:");
-        for (int i = 0; i < d->entries.count(); ++i) {
-            LOG_TRACE(d->entries.values().at(i)->name());
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Items in relational table:");
+        for (QMap<int, RelationalTableEntry*>::const_iterator itr = d->entries.constBegin(); itr != d->entries.constEnd(); ++itr) {
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,itr.value()->name());
         }
-        LOG_TRACE("Items in object list:");
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Items in object list:");
         for (int i = 0; i < objects.count(); ++i) {
-            LOG_TRACE(objects.at(i)->objectName());
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,objects.at(i)->objectName());
         }
         return false;
     }
@@ -541,10 +709,10 @@ bool Qtilities::Core::ObserverRelationalTable::compareObjects(QList<QPointer<QOb
         int other_id = getVisitorID(objects.at(i));
         // Now compare it against the key at entry i
         if (!d->entries.contains(other_id)) {
-            LOG_TRACE(QString("Visitor ID \"%1\" on object \"%2\" does not exist in the readback table.").arg(other_id).arg(objects.at(i)->objectName()));
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Visitor ID \"%1\" on object \"%2\" does not exist in the readback table.").arg(other_id).arg(objects.at(i)->objectName()));
             success = false;
         } else {
-            LOG_TRACE(QString("Visitor ID \"%1\" on object \"%2\" found in the readback table.").arg(other_id).arg(objects.at(i)->objectName()));
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Visitor ID \"%1\" on object \"%2\" found in the readback table.").arg(other_id).arg(objects.at(i)->objectName()));
         }
     }
 
@@ -555,7 +723,8 @@ Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable:
     if (index < 0 || index >= d->entries.count())
         return 0;
 
-    return d->entries.values().at(index);
+    buildVisitorIndex();
+    return d->entry_list.at(index);
 }
 
 void Qtilities::Core::ObserverRelationalTable::dumpTableInfo() const {
@@ -569,8 +738,9 @@ void Qtilities::Core::ObserverRelationalTable::dumpTableInfo() const {
     else
         LOG_INFO(QObject::tr("Observer Relational Table Dump For Readback Table:"));
     LOG_INFO("-------------------------------------");
-    for (int i = 0; i < d->entries.count(); ++i) {
-        RelationalTableEntry* entry = d->entries.values().at(i);
+    int i = 0;
+    for (QMap<int, RelationalTableEntry*>::const_iterator itr = d->entries.constBegin(); itr != d->entries.constEnd(); ++itr, ++i) {
+        RelationalTableEntry* entry = itr.value();
         if (!entry) {
             LOG_INFO(QObject::tr("Null entry found..."));
             break;
@@ -585,7 +755,7 @@ void Qtilities::Core::ObserverRelationalTable::dumpTableInfo() const {
         LOG_INFO(QString("> Owner Visitor ID:       %1").arg(entry->parentVisitorID()));
         LOG_INFO(QString("> Child count:            %1").arg(entry->children().count()));
         for (int c = 0; c < entry->children().count(); c++) {
-            RelationalTableEntry* child = d->entries[entry->children().at(c)];
+            RelationalTableEntry* child = d->entries.value(entry->children().at(c));
             if (child) {
                 LOG_INFO(QString(">> Child No.   %1").arg(c));
                 LOG_INFO(QString(">> Name        %1").arg(child->name()));
@@ -596,7 +766,7 @@ void Qtilities::Core::ObserverRelationalTable::dumpTableInfo() const {
         }
         LOG_INFO(QString("> Parent count: %1").arg(entry->parents().count()));
         for (int c = 0; c < entry->parents().count(); c++) {
-            RelationalTableEntry* parent = d->entries[entry->parents().at(c)];
+            RelationalTableEntry* parent = d->entries.value(entry->parents().at(c));
             if (parent) {
                 LOG_INFO(QString(">> Parent No.  %1").arg(c));
                 LOG_INFO(QString(">> Name        %1").arg(parent->name()));
@@ -697,7 +867,7 @@ Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable:
                 // Already existed:
                 // Get the entry
                 subject_id = getVisitorID(obj);
-                subject_entry = d->entries[subject_id];
+                subject_entry = d->entries.value(subject_id);
                 addLimitedExportProperty(obj);
                 // Now add this observer as a parent to the subject
                 if (subject_entry)
@@ -708,7 +878,7 @@ Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable:
                 // Did not exist:
                 // Add the subject to the table entries map:
                 subject_entry = new RelationalTableEntry(subject_id,-1,observer->subjectNameInContext(obj),subject_ownership,obj);
-                d->entries[subject_id] = subject_entry;
+                addEntry(subject_entry);
                 // Now add this observer as a parent to the subject
                 subject_entry->addParent(observer_id);
             }
@@ -730,10 +900,71 @@ Qtilities::Core::RelationalTableEntry* Qtilities::Core::ObserverRelationalTable:
     // ---------------------------------------
     // ADD THE OBSERVER ENTRY
     // ---------------------------------------
-    d->entries[observer_id] = observer_entry;
+    addEntry(observer_entry);
     return observer_entry;
 }
 
+void Qtilities::Core::ObserverRelationalTable::addEntry(RelationalTableEntry* entry) {
+    entry->d->table = this;
+    d->entries[entry->visitorID()] = entry;
+    d->visitor_index_valid = false;
+    d->session_indexes_valid = false;
+}
+
+void Qtilities::Core::ObserverRelationalTable::clearEntries() {
+    qDeleteAll(d->entries);
+    d->entries.clear();
+    d->entry_list.clear();
+    d->visitor_index.clear();
+    d->session_index.clear();
+    d->previous_session_index.clear();
+    d->visitor_index_valid = false;
+    d->session_indexes_valid = false;
+}
+
+void Qtilities::Core::ObserverRelationalTable::invalidateVisitorIndex() {
+    d->visitor_index_valid = false;
+}
+
+void Qtilities::Core::ObserverRelationalTable::invalidateSessionIndexes() {
+    d->session_indexes_valid = false;
+}
+
+void Qtilities::Core::ObserverRelationalTable::buildVisitorIndex() const {
+    if (d->visitor_index_valid)
+        return;
+
+    // When IDs are not unique, the first entry in visitor ID order is found:
+    d->entry_list = d->entries.values();
+    d->visitor_index.clear();
+    d->visitor_index.reserve(d->entry_list.count());
+    for (int i = 0; i < d->entry_list.count(); ++i) {
+        RelationalTableEntry* entry = d->entry_list.at(i);
+        if (entry && !d->visitor_index.contains(entry->visitorID()))
+            d->visitor_index.insert(entry->visitorID(),entry);
+    }
+    d->visitor_index_valid = true;
+}
+
+void Qtilities::Core::ObserverRelationalTable::buildSessionIndexes() const {
+    if (d->session_indexes_valid)
+        return;
+
+    // When IDs are not unique, the first entry in visitor ID order is found:
+    d->session_index.clear();
+    d->previous_session_index.clear();
+    for (QMap<int, RelationalTableEntry*>::const_iterator itr = d->entries.constBegin(); itr != d->entries.constEnd(); ++itr) {
+        RelationalTableEntry* entry = itr.value();
+        if (!entry)
+            continue;
+        if (!d->session_index.contains(entry->sessionID()))
+            d->session_index.insert(entry->sessionID(),entry);
+        if (!d->previous_session_index.contains(entry->previousSessionID()))
+            d->previous_session_index.insert(entry->previousSessionID(),entry);
+    }
+    d->session_indexes_valid = true;
+}
+
 int Qtilities::Core::ObserverRelationalTable::getOwnership(QObject* obj) const {
     QVariant prop_variant = obj->property(qti_prop_OWNERSHIP);
     if (prop_variant.isValid() && prop_variant.canConvert<SharedProperty>()) {
@@ -752,9 +983,9 @@ int Qtilities::Core::ObserverRelationalTable::addVisitorID(QObject* obj) {
         QVariant new_prop_variant = qVariantFromValue(new_prop);
         obj->setProperty(new_prop.propertyNameString().toUtf8().data(),new_prop_variant);
         if (ObjectManager::propertyExists(obj,qti_prop_VISITOR_ID))
-            LOG_TRACE("Added visitor ID property to object: " + obj->objectName());
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Added visitor ID property to object: " + obj->objectName());
         else
-            LOG_TRACE("Failed to add visitor ID property to object: " + obj->objectName());
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Failed to add visitor ID property to object: " + obj->objectName());
         // Increment the visitor id counter:
         ++d->visitor_id_count;
         return d->visitor_id_count-1;
@@ -792,6 +1023,7 @@ Qtilities::Core::Interfaces::IExportable::ExportModeFlags Qtilities::Core::Obser
     IExportable::ExportModeFlags flags = 0;
     flags |= IExportable::Binary;
     flags |= IExportable::XML;
+    flags |= IExportable::Cbor;
     return flags;
 }
 
@@ -803,10 +1035,11 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
     // Stream the entries one after another:
     stream << (quint32) count();
     bool all_successful = true;
-    for (int i = 0; i < count(); ++i) {
-        if (entryAt(i)) {
-            entryAt(i)->setExportVersion(exportVersion());
-            if (entryAt(i)->exportBinary(stream) != IExportable::Complete)
+    int i = 0;
+    for (QMap<int, RelationalTableEntry*>::const_iterator itr = d->entries.constBegin(); itr != d->entries.constEnd(); ++itr, ++i) {
+        if (itr.value()) {
+            itr.value()->setExportVersion(exportVersion());
+            if (itr.value()->exportBinary(stream) != IExportable::Complete)
                 all_successful = false;
         } else {
             LOG_ERROR(QString("Internal error, ObserverRelationalTable::exportBinary(stream) found null object in entry position %1/%2").arg(i).arg(count()));
@@ -833,8 +1066,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
         RelationalTableEntry entry;
         entry.setExportVersion(exportVersion());
         if (entry.importBinary(stream,import_list) == IExportable::Complete) {
-            RelationalTableEntry* entry_ptr = new RelationalTableEntry(entry);
-            d->entries[entry.visitorID()] = entry_ptr;
+            addEntry(new RelationalTableEntry(entry));
         }
     }
 
@@ -857,12 +1089,13 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
 
     object_node->setAttribute("EntryCount",d->entries.count());
     bool all_successful = true;
-    for (int i = 0; i < d->entries.count(); ++i) {
+    int i = 0;
+    for (QMap<int, RelationalTableEntry*>::const_iterator itr = d->entries.constBegin(); itr != d->entries.constEnd(); ++itr, ++i) {
         QDomElement entry = doc->createElement("Entry_" + QString::number(i));
         object_node->appendChild(entry);
-        if (d->entries.values().at(i)) {
-            d->entries.values().at(i)->setExportVersion(exportVersion());
-            d->entries.values().at(i)->exportXml(doc,&entry);
+        if (itr.value()) {
+            itr.value()->setExportVersion(exportVersion());
+            itr.value()->exportXml(doc,&entry);
         }
     }
 
@@ -897,7 +1130,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
             RelationalTableEntry* new_entry = new RelationalTableEntry;
             new_entry->setExportVersion(exportVersion());
             if (new_entry->importXml(doc,&child,import_list) == IExportable::Complete)
-                d->entries[new_entry->visitorID()] = new_entry;
+                addEntry(new_entry);
             continue;
         }
     }
@@ -908,6 +1141,116 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Obs
         return IExportable::Failed;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverRelationalTable::exportXmlStream(QXmlStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (!writer)
+        return IExportable::Failed;
+
+    writer->writeAttribute("EntryCount",QString::number(d->entries.count()));
+    int i = 0;
+    for (QMap<int, RelationalTableEntry*>::const_iterator itr = d->entries.constBegin(); itr != d->entries.constEnd(); ++itr, ++i) {
+        writer->writeStartElement("Entry_" + QString::number(i));
+        if (itr.value()) {
+            itr.value()->setExportVersion(exportVersion());
+            itr.value()->exportXmlStream(writer);
+        }
+        writer->writeEndElement();
+    }
+
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverRelationalTable::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    if (!reader || !reader->isStartElement())
+        return IExportable::Failed;
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported) {
+        reader->skipCurrentElement();
+        return version_check_result;
+    }
+
+    int depth_readback = 0;
+    if (reader->attributes().hasAttribute("EntryCount"))
+        depth_readback = reader->attributes().value("EntryCount").toString().toInt();
+
+    while (reader->readNextStartElement()) {
+        if (reader->name().startsWith(QLatin1String("Entry_"))) {
+            RelationalTableEntry* new_entry = new RelationalTableEntry;
+            new_entry->setExportVersion(exportVersion());
+            if (new_entry->importXmlStream(reader,import_list) == IExportable::Complete)
+                addEntry(new_entry);
+            else
+                delete new_entry;
+        } else
+            reader->skipCurrentElement();
+    }
+
+    if (d->entries.count() == depth_readback)
+        return IExportable::Complete;
+    else
+        return IExportable::Failed;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverRelationalTable::exportCbor(CborStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (!writer)
+        return IExportable::Failed;
+
+    // The table is written as an array of entries, thus the entry count is the length of the array:
+    writer->startArray(d->entries.count());
+    for (QMap<int, RelationalTableEntry*>::const_iterator itr = d->entries.constBegin(); itr != d->entries.constEnd(); ++itr) {
+        if (itr.value()) {
+            itr.value()->setExportVersion(exportVersion());
+            itr.value()->exportCbor(writer);
+        } else
+            writer->writeNull();
+    }
+    writer->endArray();
+
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::ObserverRelationalTable::importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    if (!reader)
+        return IExportable::Failed;
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported) {
+        reader->next();
+        return version_check_result;
+    }
+
+    if (!reader->isArray()) {
+        reader->next();
+        return IExportable::Failed;
+    }
+
+    int depth_readback = 0;
+    reader->enterContainer();
+    while (reader->hasNext()) {
+        ++depth_readback;
+        RelationalTableEntry* new_entry = new RelationalTableEntry;
+        new_entry->setExportVersion(exportVersion());
+        if (new_entry->importCbor(reader,import_list) == IExportable::Complete)
+            addEntry(new_entry);
+        else
+            delete new_entry;
+    }
+    reader->leaveContainer();
+
+    if (!reader->hasError() && d->entries.count() == depth_readback)
+        return IExportable::Complete;
+    else
+        return IExportable::Failed;
+}
+
 QDataStream & operator<< (QDataStream& stream, const Qtilities::Core::RelationalTableEntry& stream_obj) {
     stream_obj.exportBinary(stream);
     return stream;
@@ -33,12 +33,15 @@ namespace Qtilities {
         \brief The RelationalTableEntryData stores private data used by the RelationalTableEntry class.
           */
         struct RelationalTableEntryData;
+        class ObserverRelationalTable;
 
         /*!
           \class RelationalTableEntry
           \brief The RelationalTableEntry class represents a single entry in an observer relational table.
          */
         class QTILIITES_CORE_SHARED_EXPORT RelationalTableEntry  : public IExportable {
+            friend class Qtilities::Core::ObserverRelationalTable;
+
         public:
             RelationalTableEntry();
             RelationalTableEntry(int visitorID, int sessionID, const QString& name, int ownership, QObject* obj = 0);
@@ -107,6 +110,10 @@ namespace Qtilities {
             IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
             IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
             IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportCbor(CborStreamWriter* writer) const;
+            IExportable::ExportResultFlags importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
         private:
             QString intListToString(QList<int> list) const;
@@ -213,6 +220,7 @@ for (int i = 0; i < table.count(); i++) {
         class QTILIITES_CORE_SHARED_EXPORT ObserverRelationalTable : public IExportable
         {            
             friend class Qtilities::Core::ObserverData;
+            friend class Qtilities::Core::RelationalTableEntry;
 
         public:
             //! Constructs an observer relational table for the given observer.
@@ -252,15 +260,27 @@ for (int i = 0; i < table.count(); i++) {
               Note that for compare to return true, the tables must match completely. That is, the number of
               entries in the tables must be the same and each entry must be exactly the same (except for d_sessionID and
               d_previousSessionID).
+
+              The entries of both tables are compared in visitor ID order, thus this function runs in linear time.
               */
-            bool compare(ObserverRelationalTable table) const;
+            bool compare(const ObserverRelationalTable& table) const;
             //! Returns the number of entries in the table.
             int count() const;
             //! Returns the entry with the given visitor ID.
+            /*!
+              Lookups use a hash index which is built when first needed after the table changed, thus they run in constant time.
+              The indexes stay valid while entries' IDs change, for example while relationships are constructed during an import.
+              */
             RelationalTableEntry* entryWithVisitorID(int visitor_id) const;
             //! Returns the entry with the given session ID.
+            /*!
+              \sa entryWithVisitorID()
+              */
             RelationalTableEntry* entryWithSessionID(int session_id) const;
             //! Returns the entry with the given previous session ID.
+            /*!
+              \sa entryWithVisitorID()
+              */
             RelationalTableEntry* entryWithPreviousSessionID(int session_id) const;
             //! Returns the entry at position index.
             RelationalTableEntry* entryAt(int index);
@@ -301,6 +321,10 @@ for (int i = 0; i < table.count(); i++) {
             IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
             IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
             IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportCbor(CborStreamWriter* writer) const;
+            IExportable::ExportResultFlags importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
         private:
             //! Returns true if all the objects in the pointer list matches the objects in the table using the visitor ID property on each object. This comparison does not take any relational data into account.
@@ -315,6 +339,18 @@ for (int i = 0; i < table.count(); i++) {
             int addLimitedExportProperty(QObject* obj);
             //! Gets the specific parent of an object (that is, parent with ownership of SpecificObserverOwnership). Returns -1 if no specific parent exists.
             int getSpecificParent(QObject* obj) const;
+            //! Adds an entry to the table, the table takes ownership of the entry.
+            void addEntry(RelationalTableEntry* entry);
+            //! Deletes all entries in the table.
+            void clearEntries();
+            //! Called by entries in the table when their visitor IDs changed.
+            void invalidateVisitorIndex();
+            //! Called by entries in the table when their session IDs or previous session IDs changed.
+            void invalidateSessionIndexes();
+            //! Builds the visitor ID index and the list of entries used by entryAt() when they are invalid.
+            void buildVisitorIndex() const;
+            //! Builds the session ID and previous session ID indexes when they are invalid.
+            void buildSessionIndexes() const;
 
             ObserverRelationalTablePrivateData* d;
         };
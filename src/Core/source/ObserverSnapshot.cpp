@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ObserverSnapshot.h"
+#include "ObserverSnapshot_p.h"
+
+Qtilities::Core::ObserverSnapshot::ObserverSnapshot() {
+
+}
+
+Qtilities::Core::ObserverSnapshot::ObserverSnapshot(ObserverSnapshotData* data) : d(data) {
+
+}
+
+Qtilities::Core::ObserverSnapshot::ObserverSnapshot(const ObserverSnapshot& other) : d(other.d) {
+
+}
+
+Qtilities::Core::ObserverSnapshot& Qtilities::Core::ObserverSnapshot::operator=(const ObserverSnapshot& other) {
+    d = other.d;
+    return *this;
+}
+
+Qtilities::Core::ObserverSnapshot::~ObserverSnapshot() {
+
+}
+
+bool Qtilities::Core::ObserverSnapshot::isNull() const {
+    return !d;
+}
+
+bool Qtilities::Core::ObserverSnapshot::isSharedWith(const ObserverSnapshot& other) const {
+    return d && d == other.d;
+}
+
+int Qtilities::Core::ObserverSnapshot::observerID() const {
+    return d ? d->observer_id : -1;
+}
+
+QString Qtilities::Core::ObserverSnapshot::observerName() const {
+    return d ? d->observer_name : QString();
+}
+
+int Qtilities::Core::ObserverSnapshot::count() const {
+    return d ? d->subjects.count() : 0;
+}
+
+int Qtilities::Core::ObserverSnapshot::treeCount() const {
+    return d ? d->tree_count : 0;
+}
+
+QObject* Qtilities::Core::ObserverSnapshot::subjectAt(int i) const {
+    if (i < 0 || i >= count())
+        return 0;
+    return d->subjects.at(i).object;
+}
+
+QString Qtilities::Core::ObserverSnapshot::subjectNameAt(int i) const {
+    if (i < 0 || i >= count())
+        return QString();
+    return d->subjects.at(i).name;
+}
+
+Qtilities::Core::QtilitiesCategory Qtilities::Core::ObserverSnapshot::subjectCategoryAt(int i) const {
+    if (i < 0 || i >= count())
+        return QtilitiesCategory();
+    return d->subjects.at(i).category;
+}
+
+int Qtilities::Core::ObserverSnapshot::subjectOwnershipAt(int i) const {
+    if (i < 0 || i >= count())
+        return 0;
+    return d->subjects.at(i).ownership;
+}
+
+Qtilities::Core::ObserverSnapshot Qtilities::Core::ObserverSnapshot::childAt(int i) const {
+    if (i < 0 || i >= count())
+        return ObserverSnapshot();
+    return d->subjects.at(i).child;
+}
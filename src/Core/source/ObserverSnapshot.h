@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef OBSERVER_SNAPSHOT_H
+#define OBSERVER_SNAPSHOT_H
+
+#include "QtilitiesCore_global.h"
+#include "QtilitiesCategory.h"
+
+#include <QExplicitlySharedDataPointer>
+#include <QString>
+
+namespace Qtilities {
+    namespace Core {
+        class ObserverData;
+
+        /*!
+        \struct ObserverSnapshotData
+        \brief Structure used by ObserverSnapshot to store its immutable, implicitly shared data.
+          */
+        struct ObserverSnapshotData;
+
+        /*!
+        \class ObserverSnapshot
+        \brief The ObserverSnapshot class is an immutable, point-in-time copy of the tree underneath an observer.
+
+        A snapshot contains the subjects of an observer together with their names, categories and ownership in the context of
+        the observer. Subjects which are observers have their own snapshots, which are returned by childAt(). Snapshots are taken
+        using Observer::treeSnapshot():
+
+\code
+ObserverSnapshot snapshot = observer->treeSnapshot();
+// The snapshot can now be passed to another thread and traversed while the observer keeps changing:
+for (int i = 0; i < snapshot.count(); ++i) {
+    qDebug() << snapshot.subjectNameAt(i);
+    ObserverSnapshot child = snapshot.childAt(i);
+    if (!child.isNull())
+        qDebug() << child.treeCount() << "items underneath" << snapshot.subjectNameAt(i);
+}
+\endcode
+
+        Snapshots are never changed after they were taken, thus they can be copied to and traversed from any thread without locking.
+        Every observer keeps its last snapshot until the observer or the tree underneath it changes. Taking a snapshot of a tree
+        therefore only creates new snapshots for the observers which changed and the observers above them, all other observers share
+        their previous snapshots. isSharedWith() can be used to skip unchanged subtrees when comparing two snapshots of the same tree.
+
+        \note The subjects are stored as plain pointers, they might be destroyed at any time after the snapshot was taken. Use the
+        snapshot's names and categories instead of accessing the subjects from other threads. Names which are changed using
+        QObject::setObjectName() directly, instead of through the naming policy filter, are only picked up when something else in the
+        observer changes.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT ObserverSnapshot
+        {
+            friend class Qtilities::Core::ObserverData;
+
+        public:
+            //! Constructs a null snapshot.
+            ObserverSnapshot();
+            ObserverSnapshot(const ObserverSnapshot& other);
+            ObserverSnapshot& operator=(const ObserverSnapshot& other);
+            ~ObserverSnapshot();
+
+            //! Indicates if this is a null snapshot, thus not the snapshot of an observer.
+            bool isNull() const;
+            //! Indicates if this snapshot and \p other share the same data, in which case the trees they represent are identical.
+            bool isSharedWith(const ObserverSnapshot& other) const;
+
+            //! The ID of the observer at the time of the snapshot.
+            int observerID() const;
+            //! The name of the observer at the time of the snapshot.
+            QString observerName() const;
+            //! The number of subjects in the observer.
+            int count() const;
+            //! The number of items in the tree underneath the observer, the same number that Observer::treeCount() would return.
+            int treeCount() const;
+
+            //! Returns the subject at position \p i.
+            /*!
+              \note The subject might have been destroyed since the snapshot was taken.
+              */
+            QObject* subjectAt(int i) const;
+            //! Returns the name of the subject at position \p i in the context of the observer, see Observer::subjectNameInContext().
+            QString subjectNameAt(int i) const;
+            //! Returns the category of the subject at position \p i in the context of the observer.
+            QtilitiesCategory subjectCategoryAt(int i) const;
+            //! Returns the Observer::ObjectOwnership of the subject at position \p i.
+            int subjectOwnershipAt(int i) const;
+            //! Returns the snapshot of the subject at position \p i when it is an observer, a null snapshot otherwise.
+            ObserverSnapshot childAt(int i) const;
+
+        private:
+            explicit ObserverSnapshot(ObserverSnapshotData* data);
+
+            QExplicitlySharedDataPointer<ObserverSnapshotData> d;
+        };
+    }
+}
+
+#endif // OBSERVER_SNAPSHOT_H
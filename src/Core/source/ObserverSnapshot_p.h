@@ -0,0 +1,39 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef OBSERVER_SNAPSHOT_P_H
+#define OBSERVER_SNAPSHOT_P_H
+
+#include "ObserverSnapshot.h"
+
+#include <QSharedData>
+#include <QVector>
+
+struct Qtilities::Core::ObserverSnapshotData : public QSharedData {
+    ObserverSnapshotData() : observer_id(-1), tree_count(0) { }
+
+    struct Subject {
+        Subject() : object(0), ownership(0) { }
+
+        QObject*            object;
+        QString             name;
+        QtilitiesCategory   category;
+        int                 ownership;
+        ObserverSnapshot    child;
+    };
+
+    int                 observer_id;
+    QString             observer_name;
+    QVector<Subject>    subjects;
+    int                 tree_count;
+};
+
+#endif // OBSERVER_SNAPSHOT_P_H
@@ -0,0 +1,405 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ObserverTreeDiff.h"
+#include "Observer.h"
+#include "ObjectManager.h"
+#include "QtilitiesProperty.h"
+#include "QtilitiesCoreConstants.h"
+#include "QtilitiesCoreApplication.h"
+
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QSet>
+#include <QVector>
+#include <QStringList>
+#include <QPointer>
+
+using namespace Qtilities::Core;
+using namespace Qtilities::Core::Constants;
+using namespace Qtilities::Core::Properties;
+
+namespace {
+    //! Computes the edits between two snapshots, see ObserverTreeDiff::compute().
+    class ObserverTreeDiffBuilder {
+    public:
+        //! A subject which was only found in one of the snapshots, which is either an insertion or a removal until it is paired into a move.
+        struct PendingSubject {
+            PendingSubject() : observer_id(-1), subject(0), ownership(0), paired(false) {}
+
+            int                 observer_id;
+            QObject*            subject;
+            QString             name;
+            QtilitiesCategory   category;
+            int                 ownership;
+            ObserverSnapshot    child;
+            bool                paired;
+        };
+
+        void diffRoots(const ObserverSnapshot& from, const ObserverSnapshot& to) {
+            if (from.isNull()) {
+                for (int i = 0; i < to.count(); ++i)
+                    insertions << pendingSubject(to,i);
+            } else if (to.isNull()) {
+                for (int i = 0; i < from.count(); ++i)
+                    removals << pendingSubject(from,i);
+            } else {
+                diffObserver(from,to);
+            }
+            pairMoves();
+        }
+
+        QList<ObserverTreeEdit> edits() const {
+            QList<ObserverTreeEdit> inserts;
+            QList<ObserverTreeEdit> removes;
+            for (int i = 0; i < insertions.count(); ++i) {
+                if (!insertions.at(i).paired)
+                    inserts << edit(ObserverTreeEdit::InsertSubject,insertions.at(i));
+            }
+            for (int i = 0; i < removals.count(); ++i) {
+                if (!removals.at(i).paired)
+                    removes << edit(ObserverTreeEdit::RemoveSubject,removals.at(i));
+            }
+
+            QList<ObserverTreeEdit> all_edits;
+            all_edits << inserts << moves << renames << category_changes << removes;
+            return all_edits;
+        }
+
+    private:
+        //! Compares two snapshots of the same observer.
+        void diffObserver(const ObserverSnapshot& from, const ObserverSnapshot& to) {
+            // Subtrees which did not change share their snapshots:
+            if (from.isSharedWith(to))
+                return;
+            // Observers which are attached to more than one observer are only compared once:
+            if (visited_observers.contains(to.observerID()))
+                return;
+            visited_observers.insert(to.observerID());
+
+            const int from_count = from.count();
+            QHash<const QObject*,int> from_indexes;
+            from_indexes.reserve(from_count);
+            for (int i = 0; i < from_count; ++i)
+                from_indexes.insert(from.subjectAt(i),i);
+
+            QVector<bool> matched(from_count,false);
+            const int to_count = to.count();
+            for (int j = 0; j < to_count; ++j) {
+                QHash<const QObject*,int>::const_iterator itr = from_indexes.constFind(to.subjectAt(j));
+                if (itr == from_indexes.constEnd()) {
+                    insertions << pendingSubject(to,j);
+                    continue;
+                }
+
+                const int i = itr.value();
+                matched[i] = true;
+                if (from.subjectNameAt(i) != to.subjectNameAt(j)) {
+                    ObserverTreeEdit rename;
+                    rename.type = ObserverTreeEdit::RenameSubject;
+                    rename.subject = to.subjectAt(j);
+                    rename.observer_id = to.observerID();
+                    rename.name = to.subjectNameAt(j);
+                    rename.old_name = from.subjectNameAt(i);
+                    rename.category = to.subjectCategoryAt(j);
+                    rename.ownership = to.subjectOwnershipAt(j);
+                    renames << rename;
+                }
+                if (from.subjectCategoryAt(i) != to.subjectCategoryAt(j)) {
+                    ObserverTreeEdit category_change;
+                    category_change.type = ObserverTreeEdit::ChangeCategory;
+                    category_change.subject = to.subjectAt(j);
+                    category_change.observer_id = to.observerID();
+                    category_change.name = to.subjectNameAt(j);
+                    category_change.category = to.subjectCategoryAt(j);
+                    category_change.old_category = from.subjectCategoryAt(i);
+                    category_change.ownership = to.subjectOwnershipAt(j);
+                    category_changes << category_change;
+                }
+
+                ObserverSnapshot from_child = from.childAt(i);
+                ObserverSnapshot to_child = to.childAt(j);
+                if (!from_child.isNull() && !to_child.isNull())
+                    diffObserver(from_child,to_child);
+            }
+
+            for (int i = 0; i < from_count; ++i) {
+                if (!matched.at(i))
+                    removals << pendingSubject(from,i);
+            }
+        }
+
+        //! Pairs insertions and removals of the same subject into moves.
+        void pairMoves() {
+            QHash<const QObject*,QList<int> > removal_indexes;
+            int indexed_removals = 0;
+            // Comparing the subtrees of moved observers can add insertions and removals, thus the counts are read on every iteration:
+            for (int k = 0; k < insertions.count(); ++k) {
+                for (; indexed_removals < removals.count(); ++indexed_removals)
+                    removal_indexes[removals.at(indexed_removals).subject] << indexed_removals;
+
+                QHash<const QObject*,QList<int> >::iterator itr = removal_indexes.find(insertions.at(k).subject);
+                if (itr == removal_indexes.end() || itr.value().isEmpty())
+                    continue;
+
+                const int r = itr.value().takeFirst();
+                removals[r].paired = true;
+                insertions[k].paired = true;
+
+                const PendingSubject& insertion = insertions.at(k);
+                const PendingSubject& removal = removals.at(r);
+                ObserverTreeEdit move = edit(ObserverTreeEdit::MoveSubject,insertion);
+                move.source_observer_id = removal.observer_id;
+                move.old_name = removal.name;
+                move.old_category = removal.category;
+                moves << move;
+
+                if (!removal.child.isNull() && !insertion.child.isNull())
+                    diffObserver(removal.child,insertion.child);
+            }
+        }
+
+        static PendingSubject pendingSubject(const ObserverSnapshot& snapshot, int i) {
+            PendingSubject pending;
+            pending.observer_id = snapshot.observerID();
+            pending.subject = snapshot.subjectAt(i);
+            pending.name = snapshot.subjectNameAt(i);
+            pending.category = snapshot.subjectCategoryAt(i);
+            pending.ownership = snapshot.subjectOwnershipAt(i);
+            pending.child = snapshot.childAt(i);
+            return pending;
+        }
+        static ObserverTreeEdit edit(ObserverTreeEdit::EditType type, const PendingSubject& pending) {
+            ObserverTreeEdit new_edit;
+            new_edit.type = type;
+            new_edit.subject = pending.subject;
+            new_edit.observer_id = pending.observer_id;
+            new_edit.name = pending.name;
+            new_edit.category = pending.category;
+            new_edit.ownership = pending.ownership;
+            return new_edit;
+        }
+
+        QList<PendingSubject>   insertions;
+        QList<PendingSubject>   removals;
+        QList<ObserverTreeEdit> moves;
+        QList<ObserverTreeEdit> renames;
+        QList<ObserverTreeEdit> category_changes;
+        QSet<int>               visited_observers;
+    };
+
+    //! Sets the name of \p obj in the context of \p observer, the same way ObserverTreeModel renames subjects.
+    void renameSubject(Observer* observer, QObject* obj, const QString& name) {
+        if (observer->subjectNameInContext(obj) == name)
+            return;
+
+        // Instance names are used in the context of the observer, also when the subject is not managed by a naming policy filter:
+        MultiContextProperty instance_names = ObjectManager::getMultiContextProperty(obj,qti_prop_ALIAS_MAP);
+        if (instance_names.isValid() && instance_names.hasContext(observer->observerID()))
+            observer->setMultiContextPropertyValue(obj,qti_prop_ALIAS_MAP,name);
+        else if (ObjectManager::getSharedProperty(obj,qti_prop_NAME).isValid())
+            observer->setMultiContextPropertyValue(obj,qti_prop_NAME,name);
+        else
+            obj->setObjectName(name);
+    }
+
+    //! Sets the category of \p obj in the context of \p observer.
+    void setSubjectCategory(Observer* observer, QObject* obj, const QtilitiesCategory& category) {
+        if (observer->subjectCategoryInContext(obj) == category)
+            return;
+
+        if (ObjectManager::propertyExists(obj,qti_prop_CATEGORY_MAP)) {
+            observer->setMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP,qVariantFromValue(category));
+        } else {
+            MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
+            category_property.setValue(qVariantFromValue(category),observer->observerID());
+            ObjectManager::setMultiContextProperty(obj,category_property);
+        }
+    }
+
+    //! Sets the name and category which subjects which were inserted or moved have in the edit.
+    void applySubjectContext(Observer* observer, const ObserverTreeEdit& edit) {
+        if (!observer->contains(edit.subject))
+            return;
+        if (!edit.name.isEmpty())
+            renameSubject(observer,edit.subject,edit.name);
+        if (edit.category.isValid() || observer->subjectCategoryInContext(edit.subject).isValid())
+            setSubjectCategory(observer,edit.subject,edit.category);
+    }
+}
+
+Qtilities::Core::ObserverTreeDiff::ObserverTreeDiff() {
+
+}
+
+Qtilities::Core::ObserverTreeDiff Qtilities::Core::ObserverTreeDiff::compute(const ObserverSnapshot& from, const ObserverSnapshot& to) {
+    ObserverTreeDiffBuilder builder;
+    builder.diffRoots(from,to);
+
+    ObserverTreeDiff diff;
+    diff.d_edits = builder.edits();
+    return diff;
+}
+
+bool Qtilities::Core::ObserverTreeDiff::isEmpty() const {
+    return d_edits.isEmpty();
+}
+
+int Qtilities::Core::ObserverTreeDiff::count() const {
+    return d_edits.count();
+}
+
+Qtilities::Core::ObserverTreeEdit Qtilities::Core::ObserverTreeDiff::editAt(int i) const {
+    if (i < 0 || i >= d_edits.count())
+        return ObserverTreeEdit();
+    return d_edits.at(i);
+}
+
+QList<Qtilities::Core::ObserverTreeEdit> Qtilities::Core::ObserverTreeDiff::edits() const {
+    return d_edits;
+}
+
+Qtilities::Core::ObserverTreeDiff Qtilities::Core::ObserverTreeDiff::inverted() const {
+    QList<ObserverTreeEdit> inserts;
+    QList<ObserverTreeEdit> moves;
+    QList<ObserverTreeEdit> renames;
+    QList<ObserverTreeEdit> category_changes;
+    QList<ObserverTreeEdit> removes;
+
+    for (int i = 0; i < d_edits.count(); ++i) {
+        ObserverTreeEdit inverse = d_edits.at(i);
+        if (inverse.type == ObserverTreeEdit::InsertSubject) {
+            inverse.type = ObserverTreeEdit::RemoveSubject;
+            removes << inverse;
+        } else if (inverse.type == ObserverTreeEdit::RemoveSubject) {
+            inverse.type = ObserverTreeEdit::InsertSubject;
+            inserts << inverse;
+        } else if (inverse.type == ObserverTreeEdit::MoveSubject) {
+            qSwap(inverse.observer_id,inverse.source_observer_id);
+            qSwap(inverse.name,inverse.old_name);
+            qSwap(inverse.category,inverse.old_category);
+            moves << inverse;
+        } else if (inverse.type == ObserverTreeEdit::RenameSubject) {
+            qSwap(inverse.name,inverse.old_name);
+            renames << inverse;
+        } else if (inverse.type == ObserverTreeEdit::ChangeCategory) {
+            qSwap(inverse.category,inverse.old_category);
+            category_changes << inverse;
+        }
+    }
+
+    ObserverTreeDiff diff;
+    diff.d_edits << inserts << moves << renames << category_changes << removes;
+    return diff;
+}
+
+bool Qtilities::Core::ObserverTreeDiff::apply(QString* error_msg) const {
+    if (d_edits.isEmpty())
+        return true;
+
+    QStringList errors;
+
+    // Get the observers which are edited:
+    QHash<int,Observer*> observers;
+    for (int i = 0; i < d_edits.count(); ++i) {
+        const ObserverTreeEdit& edit = d_edits.at(i);
+        if (!observers.contains(edit.observer_id))
+            observers[edit.observer_id] = OBJECT_MANAGER->observerReference(edit.observer_id);
+        if (edit.type == ObserverTreeEdit::MoveSubject && !observers.contains(edit.source_observer_id))
+            observers[edit.source_observer_id] = OBJECT_MANAGER->observerReference(edit.source_observer_id);
+    }
+    QList<Observer*> edited_observers;
+    for (QHash<int,Observer*>::const_iterator itr = observers.constBegin(); itr != observers.constEnd(); ++itr) {
+        if (itr.value())
+            edited_observers << itr.value();
+        else
+            errors << QString("Observer with ID %1 does not exist anymore.").arg(itr.key());
+    }
+
+    for (int i = 0; i < edited_observers.count(); ++i)
+        edited_observers.at(i)->startProcessingCycle();
+
+    // Group the insertions, moves and removals by observer, thus they can be applied in bulk:
+    QMap<QPair<int,int>,QList<QObject*> > insertions;
+    QMap<QPair<int,int>,QList<QObject*> > moves;
+    QMap<int,QList<QObject*> > removals;
+    for (int i = 0; i < d_edits.count(); ++i) {
+        const ObserverTreeEdit& edit = d_edits.at(i);
+        Observer* observer = observers.value(edit.observer_id);
+        if (!observer || !edit.subject)
+            continue;
+
+        if (edit.type == ObserverTreeEdit::InsertSubject) {
+            if (!observer->contains(edit.subject))
+                insertions[qMakePair(edit.observer_id,edit.ownership)] << edit.subject;
+        } else if (edit.type == ObserverTreeEdit::MoveSubject) {
+            Observer* source_observer = observers.value(edit.source_observer_id);
+            if (source_observer && source_observer->contains(edit.subject))
+                moves[qMakePair(edit.source_observer_id,edit.observer_id)] << edit.subject;
+        } else if (edit.type == ObserverTreeEdit::RemoveSubject) {
+            if (observer->contains(edit.subject))
+                removals[edit.observer_id] << edit.subject;
+        }
+    }
+
+    for (QMap<QPair<int,int>,QList<QObject*> >::const_iterator itr = insertions.constBegin(); itr != insertions.constEnd(); ++itr) {
+        QString reject_msg;
+        QList<QPointer<QObject> > attached = observers.value(itr.key().first)->attachSubjects(itr.value(),(Observer::ObjectOwnership) itr.key().second,&reject_msg);
+        if (attached.count() != itr.value().count())
+            errors << reject_msg;
+    }
+    for (QMap<QPair<int,int>,QList<QObject*> >::const_iterator itr = moves.constBegin(); itr != moves.constEnd(); ++itr) {
+        QString move_msg;
+        if (!OBJECT_MANAGER->moveSubjects(itr.value(),itr.key().first,itr.key().second,&move_msg,true))
+            errors << move_msg;
+    }
+
+    // Inserted and moved subjects get the names and categories they have in the edits, after which the remaining renames and category changes are applied:
+    for (int i = 0; i < d_edits.count(); ++i) {
+        const ObserverTreeEdit& edit = d_edits.at(i);
+        Observer* observer = observers.value(edit.observer_id);
+        if (!observer || !edit.subject || edit.type == ObserverTreeEdit::RemoveSubject || !observer->contains(edit.subject))
+            continue;
+
+        if (edit.type == ObserverTreeEdit::InsertSubject || edit.type == ObserverTreeEdit::MoveSubject)
+            applySubjectContext(observer,edit);
+        else if (edit.type == ObserverTreeEdit::RenameSubject)
+            renameSubject(observer,edit.subject,edit.name);
+        else if (edit.type == ObserverTreeEdit::ChangeCategory)
+            setSubjectCategory(observer,edit.subject,edit.category);
+    }
+
+    // Removals are applied last, thus subjects which are removed from one observer and inserted into another do not go out of scope:
+    for (QMap<int,QList<QObject*> >::const_iterator itr = removals.constBegin(); itr != removals.constEnd(); ++itr) {
+        Observer* observer = observers.value(itr.key());
+        QString reject_msg;
+        observer->detachSubjects(itr.value(),&reject_msg);
+        // Subjects which went out of scope are not returned by detachSubjects(), thus the observer is checked instead:
+        for (int i = 0; i < itr.value().count(); ++i) {
+            if (observer->contains(itr.value().at(i))) {
+                errors << reject_msg;
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < edited_observers.count(); ++i)
+        edited_observers.at(i)->endProcessingCycle();
+
+    if (!errors.isEmpty()) {
+        if (error_msg)
+            *error_msg = errors.join("\n");
+        return false;
+    }
+
+    return true;
+}
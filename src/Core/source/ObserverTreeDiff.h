@@ -0,0 +1,140 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef OBSERVER_TREE_DIFF_H
+#define OBSERVER_TREE_DIFF_H
+
+#include "QtilitiesCore_global.h"
+#include "QtilitiesCategory.h"
+#include "ObserverSnapshot.h"
+
+#include <QList>
+#include <QString>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \struct ObserverTreeEdit
+        \brief A single edit in an ObserverTreeDiff.
+
+        Subjects are identified by their object pointers and observers by their observer IDs, thus edits refer to the same
+        subjects and observers in both trees which were compared.
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct QTILIITES_CORE_SHARED_EXPORT ObserverTreeEdit {
+            //! The types of edits.
+            enum EditType {
+                InsertSubject,      /*!< The subject was attached to the observer. */
+                RemoveSubject,      /*!< The subject was detached from the observer. */
+                MoveSubject,        /*!< The subject was moved from the source observer to the observer. */
+                RenameSubject,      /*!< The name of the subject in the context of the observer changed from old_name to name. */
+                ChangeCategory      /*!< The category of the subject in the context of the observer changed from old_category to category. */
+            };
+
+            ObserverTreeEdit() : type(InsertSubject), subject(0), observer_id(-1), source_observer_id(-1), ownership(0) {}
+
+            //! The type of the edit.
+            EditType            type;
+            //! The subject which was edited.
+            /*!
+              \note The subject might have been destroyed since the snapshots were taken, for example when it went out of scope when it was removed.
+              */
+            QObject*            subject;
+            //! The ID of the observer in which the edit happened. For moves this is the destination observer.
+            int                 observer_id;
+            //! The ID of the observer from which the subject was moved, only used by MoveSubject edits.
+            int                 source_observer_id;
+            //! The name of the subject in the context of the observer after the edit.
+            QString             name;
+            //! The name of the subject in the context of the observer before the edit, only used by RenameSubject and MoveSubject edits.
+            QString             old_name;
+            //! The category of the subject in the context of the observer after the edit.
+            QtilitiesCategory   category;
+            //! The category of the subject in the context of the observer before the edit, only used by ChangeCategory and MoveSubject edits.
+            QtilitiesCategory   old_category;
+            //! The Observer::ObjectOwnership of the subject in the context of the observer, used by InsertSubject edits.
+            int                 ownership;
+        };
+
+        /*!
+        \class ObserverTreeDiff
+        \brief The ObserverTreeDiff class describes the structural differences between two snapshots of an observer tree.
+
+        A diff is computed from two ObserverSnapshot objects using compute(). Subjects are matched by their object pointers and
+        observers by their IDs, thus a subject which was detached from one observer and attached to another is reported as a single
+        move instead of a removal and an insertion. Subtrees which did not change between the snapshots share their snapshot data,
+        see ObserverSnapshot::isSharedWith(), and are skipped. The cost of computing a diff is therefore linear in the size of the
+        parts of the tree which changed.
+
+        The edits can be applied to the live observers using apply(), and inverted() returns the diff which undoes a diff:
+
+\code
+ObserverSnapshot before = observer->treeSnapshot();
+// Change the tree...
+ObserverSnapshot after = observer->treeSnapshot();
+
+ObserverTreeDiff diff = ObserverTreeDiff::compute(before,after);
+// Undo the changes:
+diff.inverted().apply();
+\endcode
+
+        \note The order of subjects within an observer and properties other than names and categories are not part of snapshots, thus they
+        are not compared.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT ObserverTreeDiff
+        {
+        public:
+            //! Constructs an empty diff.
+            ObserverTreeDiff();
+
+            //! Computes the edits which change the tree in \p from into the tree in \p to.
+            static ObserverTreeDiff compute(const ObserverSnapshot& from, const ObserverSnapshot& to);
+
+            //! Indicates if the diff does not contain any edits, thus if the compared trees are the same.
+            bool isEmpty() const;
+            //! Returns the number of edits in the diff.
+            int count() const;
+            //! Returns the edit at position \p i.
+            ObserverTreeEdit editAt(int i) const;
+            //! Returns all edits in the diff.
+            /*!
+              Edits are ordered in the order in which apply() applies them: Insertions, moves, renames, category changes and removals.
+              */
+            QList<ObserverTreeEdit> edits() const;
+
+            //! Returns the diff which undoes this diff.
+            /*!
+              \note Subjects which were destroyed when they were removed, for example because they went out of scope, cannot be inserted again.
+              */
+            ObserverTreeDiff inverted() const;
+            //! Applies the edits in the diff to the live observers.
+            /*!
+              Insertions, moves and removals are applied in bulk for each observer using Observer::attachSubjects(), ObjectManager::moveSubjects()
+              and Observer::detachSubjects(), inside processing cycles on all observers which are edited. Thus each observer reports the changes
+              in a single change set.
+
+              Edits which refer to subjects which are no longer in their observers are skipped. Subjects which are inserted must still exist.
+
+              \param error_msg When valid, it will be populated with the reasons why edits failed.
+              \returns True when all edits were applied, false otherwise.
+              */
+            bool apply(QString* error_msg = 0) const;
+
+        private:
+            QList<ObserverTreeEdit> d_edits;
+        };
+    }
+}
+
+#endif // OBSERVER_TREE_DIFF_H
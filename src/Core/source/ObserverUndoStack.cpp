@@ -0,0 +1,358 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ObserverUndoStack.h"
+#include "Observer.h"
+
+#include <QPointer>
+#include <QStringList>
+#include <QtDebug>
+
+struct Qtilities::Core::ObserverUndoStackPrivateData {
+    ObserverUndoStackPrivateData() : index(0),
+        edit_count(0),
+        step_limit(0),
+        edit_limit(0),
+        step_depth(0),
+        checkpoint_queued(false),
+        applying(false) {}
+
+    QPointer<Observer>          root;
+    //! The snapshot of the tree after the step at index - 1.
+    ObserverSnapshot            current;
+    QList<ObserverTreeDiff>     steps;
+    QStringList                 texts;
+    int                         index;
+    int                         edit_count;
+    int                         step_limit;
+    int                         edit_limit;
+    int                         step_depth;
+    QString                     step_text;
+    bool                        checkpoint_queued;
+    bool                        applying;
+};
+
+Qtilities::Core::ObserverUndoStack::ObserverUndoStack(Observer* root, QObject* parent) : QObject(parent ? parent : root) {
+    d = new ObserverUndoStackPrivateData;
+    d->root = root;
+
+    if (root) {
+        d->current = root->treeSnapshot();
+        connect(root,SIGNAL(treeChanged()),SLOT(handleTreeChanged()));
+        connect(root,SIGNAL(processingCycleEnded()),SLOT(handleTreeChanged()));
+        connect(root,SIGNAL(destroyed()),SLOT(handleRootDestroyed()));
+    }
+}
+
+Qtilities::Core::ObserverUndoStack::~ObserverUndoStack() {
+    delete d;
+}
+
+Qtilities::Core::Observer* Qtilities::Core::ObserverUndoStack::rootObserver() const {
+    return d->root;
+}
+
+int Qtilities::Core::ObserverUndoStack::count() const {
+    return d->steps.count();
+}
+
+int Qtilities::Core::ObserverUndoStack::index() const {
+    return d->index;
+}
+
+bool Qtilities::Core::ObserverUndoStack::canUndo() const {
+    return d->index > 0;
+}
+
+bool Qtilities::Core::ObserverUndoStack::canRedo() const {
+    return d->index < d->steps.count();
+}
+
+QString Qtilities::Core::ObserverUndoStack::text(int index) const {
+    if (index < 0 || index >= d->texts.count())
+        return QString();
+    return d->texts.at(index);
+}
+
+QString Qtilities::Core::ObserverUndoStack::undoText() const {
+    return text(d->index - 1);
+}
+
+QString Qtilities::Core::ObserverUndoStack::redoText() const {
+    return text(d->index);
+}
+
+Qtilities::Core::ObserverTreeDiff Qtilities::Core::ObserverUndoStack::stepDiff(int index) const {
+    if (index < 0 || index >= d->steps.count())
+        return ObserverTreeDiff();
+    return d->steps.at(index);
+}
+
+int Qtilities::Core::ObserverUndoStack::editCount() const {
+    return d->edit_count;
+}
+
+void Qtilities::Core::ObserverUndoStack::setStepLimit(int limit) {
+    if (limit < 0)
+        limit = 0;
+    if (d->step_limit == limit)
+        return;
+
+    const int previous_index = d->index;
+    const bool previous_can_undo = canUndo();
+    const bool previous_can_redo = canRedo();
+    const QString previous_undo_text = undoText();
+    const QString previous_redo_text = redoText();
+
+    d->step_limit = limit;
+    trimSteps();
+    emitStateChanges(previous_index,previous_can_undo,previous_can_redo,previous_undo_text,previous_redo_text);
+}
+
+int Qtilities::Core::ObserverUndoStack::stepLimit() const {
+    return d->step_limit;
+}
+
+void Qtilities::Core::ObserverUndoStack::setEditLimit(int limit) {
+    if (limit < 0)
+        limit = 0;
+    if (d->edit_limit == limit)
+        return;
+
+    const int previous_index = d->index;
+    const bool previous_can_undo = canUndo();
+    const bool previous_can_redo = canRedo();
+    const QString previous_undo_text = undoText();
+    const QString previous_redo_text = redoText();
+
+    d->edit_limit = limit;
+    trimSteps();
+    emitStateChanges(previous_index,previous_can_undo,previous_can_redo,previous_undo_text,previous_redo_text);
+}
+
+int Qtilities::Core::ObserverUndoStack::editLimit() const {
+    return d->edit_limit;
+}
+
+void Qtilities::Core::ObserverUndoStack::beginStep(const QString& text) {
+    if (d->step_depth == 0) {
+        // Changes made before the step started do not become part of it:
+        checkpoint();
+        d->step_text = text;
+    }
+    ++d->step_depth;
+}
+
+void Qtilities::Core::ObserverUndoStack::endStep() {
+    if (d->step_depth == 0) {
+        qWarning() << "ObserverUndoStack::endStep() called without a matching beginStep().";
+        return;
+    }
+
+    --d->step_depth;
+    if (d->step_depth == 0) {
+        QString text = d->step_text;
+        d->step_text.clear();
+        checkpoint(text);
+    }
+}
+
+bool Qtilities::Core::ObserverUndoStack::checkpoint(const QString& text) {
+    if (!d->root || d->step_depth > 0 || d->applying)
+        return false;
+
+    ObserverSnapshot snapshot = d->root->treeSnapshot();
+    ObserverTreeDiff diff = ObserverTreeDiff::compute(d->current,snapshot);
+    d->current = snapshot;
+    if (diff.isEmpty())
+        return false;
+
+    const int previous_index = d->index;
+    const bool previous_can_undo = canUndo();
+    const bool previous_can_redo = canRedo();
+    const QString previous_undo_text = undoText();
+    const QString previous_redo_text = redoText();
+
+    // The steps which could be redone are replaced by the new step:
+    while (d->steps.count() > d->index) {
+        d->edit_count -= d->steps.last().count();
+        d->steps.removeLast();
+        d->texts.removeLast();
+    }
+
+    d->steps << diff;
+    d->texts << (text.isEmpty() ? stepText(diff) : text);
+    d->edit_count += diff.count();
+    ++d->index;
+
+    trimSteps();
+    emitStateChanges(previous_index,previous_can_undo,previous_can_redo,previous_undo_text,previous_redo_text);
+    return true;
+}
+
+bool Qtilities::Core::ObserverUndoStack::undo() {
+    checkpoint();
+    if (!d->root || !canUndo() || d->step_depth > 0)
+        return false;
+
+    const int previous_index = d->index;
+    const bool previous_can_undo = canUndo();
+    const bool previous_can_redo = canRedo();
+    const QString previous_undo_text = undoText();
+    const QString previous_redo_text = redoText();
+
+    QString error_msg;
+    d->applying = true;
+    bool success = d->steps.at(d->index - 1).inverted().apply(&error_msg);
+    d->applying = false;
+    // The changes made by the undo are not recorded as a new step:
+    d->current = d->root->treeSnapshot();
+    --d->index;
+
+    emitStateChanges(previous_index,previous_can_undo,previous_can_redo,previous_undo_text,previous_redo_text);
+    if (!success)
+        emit stepFailed(error_msg);
+    return success;
+}
+
+bool Qtilities::Core::ObserverUndoStack::redo() {
+    if (!d->root || !canRedo() || d->step_depth > 0)
+        return false;
+
+    // Changes which were not recorded yet replace the steps which can be redone:
+    if (checkpoint())
+        return false;
+
+    const int previous_index = d->index;
+    const bool previous_can_undo = canUndo();
+    const bool previous_can_redo = canRedo();
+    const QString previous_undo_text = undoText();
+    const QString previous_redo_text = redoText();
+
+    QString error_msg;
+    d->applying = true;
+    bool success = d->steps.at(d->index).apply(&error_msg);
+    d->applying = false;
+    d->current = d->root->treeSnapshot();
+    ++d->index;
+
+    emitStateChanges(previous_index,previous_can_undo,previous_can_redo,previous_undo_text,previous_redo_text);
+    if (!success)
+        emit stepFailed(error_msg);
+    return success;
+}
+
+void Qtilities::Core::ObserverUndoStack::clear() {
+    const int previous_index = d->index;
+    const bool previous_can_undo = canUndo();
+    const bool previous_can_redo = canRedo();
+    const QString previous_undo_text = undoText();
+    const QString previous_redo_text = redoText();
+
+    d->steps.clear();
+    d->texts.clear();
+    d->index = 0;
+    d->edit_count = 0;
+    if (d->root)
+        d->current = d->root->treeSnapshot();
+    else
+        d->current = ObserverSnapshot();
+
+    emitStateChanges(previous_index,previous_can_undo,previous_can_redo,previous_undo_text,previous_redo_text);
+}
+
+void Qtilities::Core::ObserverUndoStack::handleTreeChanged() {
+    if (d->applying || d->step_depth > 0 || d->checkpoint_queued)
+        return;
+
+    // All changes made before the event loop runs again are recorded as one step:
+    d->checkpoint_queued = true;
+    QMetaObject::invokeMethod(this,"handleQueuedCheckpoint",Qt::QueuedConnection);
+}
+
+void Qtilities::Core::ObserverUndoStack::handleQueuedCheckpoint() {
+    d->checkpoint_queued = false;
+    // When a processing cycle is active, the changes are recorded when it ends:
+    if (d->root && !d->root->isProcessingCycleActive())
+        checkpoint();
+}
+
+void Qtilities::Core::ObserverUndoStack::handleRootDestroyed() {
+    d->root = 0;
+    clear();
+}
+
+void Qtilities::Core::ObserverUndoStack::trimSteps() {
+    while (d->steps.count() > 1) {
+        bool over_step_limit = d->step_limit > 0 && d->steps.count() > d->step_limit;
+        bool over_edit_limit = d->edit_limit > 0 && d->edit_count > d->edit_limit;
+        if (!over_step_limit && !over_edit_limit)
+            break;
+
+        // The oldest steps are discarded first. When all steps were undone, the steps furthest from the current tree are discarded:
+        if (d->index > 0) {
+            d->edit_count -= d->steps.first().count();
+            d->steps.removeFirst();
+            d->texts.removeFirst();
+            --d->index;
+        } else {
+            d->edit_count -= d->steps.last().count();
+            d->steps.removeLast();
+            d->texts.removeLast();
+        }
+    }
+}
+
+void Qtilities::Core::ObserverUndoStack::emitStateChanges(int previous_index, bool previous_can_undo, bool previous_can_redo, const QString& previous_undo_text, const QString& previous_redo_text) {
+    if (d->index != previous_index)
+        emit indexChanged(d->index);
+    if (canUndo() != previous_can_undo)
+        emit canUndoChanged(canUndo());
+    if (canRedo() != previous_can_redo)
+        emit canRedoChanged(canRedo());
+    if (undoText() != previous_undo_text)
+        emit undoTextChanged(undoText());
+    if (redoText() != previous_redo_text)
+        emit redoTextChanged(redoText());
+}
+
+QString Qtilities::Core::ObserverUndoStack::stepText(const ObserverTreeDiff& diff) {
+    const int edit_count = diff.count();
+    ObserverTreeEdit first_edit = diff.editAt(0);
+    for (int i = 1; i < edit_count; ++i) {
+        if (diff.editAt(i).type != first_edit.type)
+            return tr("Change %1 Items").arg(edit_count);
+    }
+
+    if (edit_count == 1) {
+        if (first_edit.type == ObserverTreeEdit::InsertSubject)
+            return tr("Attach \"%1\"").arg(first_edit.name);
+        else if (first_edit.type == ObserverTreeEdit::RemoveSubject)
+            return tr("Detach \"%1\"").arg(first_edit.name);
+        else if (first_edit.type == ObserverTreeEdit::MoveSubject)
+            return tr("Move \"%1\"").arg(first_edit.name);
+        else if (first_edit.type == ObserverTreeEdit::RenameSubject)
+            return tr("Rename \"%1\"").arg(first_edit.old_name);
+        else
+            return tr("Change Category Of \"%1\"").arg(first_edit.name);
+    }
+
+    if (first_edit.type == ObserverTreeEdit::InsertSubject)
+        return tr("Attach %1 Items").arg(edit_count);
+    else if (first_edit.type == ObserverTreeEdit::RemoveSubject)
+        return tr("Detach %1 Items").arg(edit_count);
+    else if (first_edit.type == ObserverTreeEdit::MoveSubject)
+        return tr("Move %1 Items").arg(edit_count);
+    else if (first_edit.type == ObserverTreeEdit::RenameSubject)
+        return tr("Rename %1 Items").arg(edit_count);
+    else
+        return tr("Change Category Of %1 Items").arg(edit_count);
+}
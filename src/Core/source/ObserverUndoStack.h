@@ -0,0 +1,167 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef OBSERVER_UNDO_STACK_H
+#define OBSERVER_UNDO_STACK_H
+
+#include "QtilitiesCore_global.h"
+#include "ObserverTreeDiff.h"
+
+#include <QObject>
+#include <QString>
+
+namespace Qtilities {
+    namespace Core {
+        class Observer;
+
+        /*!
+        \struct ObserverUndoStackPrivateData
+        \brief Structure used by ObserverUndoStack to store private data.
+          */
+        struct ObserverUndoStackPrivateData;
+
+        /*!
+        \class ObserverUndoStack
+        \brief The ObserverUndoStack class journals the changes to an observer tree, thus they can be undone and redone.
+
+        The stack records every change to the tree underneath its root observer as a step. Steps are ObserverTreeDiff objects
+        which only contain the subjects which were attached, detached, moved, renamed or re-categorized, thus the memory used
+        by a step and the time it takes to undo or redo it depend on the size of the change and not on the size of the tree:
+
+\code
+TreeNode* root = new TreeNode("Root");
+ObserverUndoStack* undo_stack = new ObserverUndoStack(root);
+
+root->addItem("Item 1");
+undo_stack->checkpoint();
+
+// Detaches "Item 1" again:
+undo_stack->undo();
+\endcode
+
+        Changes are recorded when the event loop runs after the tree changed, or when checkpoint() is called. Changes made
+        inside processing cycles on the root observer are recorded when the cycle ends. Thus all changes made in one processing
+        cycle, or in one pass of the event loop, form a single step. Use beginStep() and endStep() to group changes explicitly.
+
+        The history can be limited using setStepLimit() and setEditLimit(), in which case the oldest steps are discarded first.
+
+        \note Steps are computed from the tree snapshots of the root observer, thus the properties which are journaled are the names
+        and categories of subjects in their observer contexts. Subjects which were deleted when they were detached, for example because
+        they went out of scope, cannot be attached again when such a step is undone.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT ObserverUndoStack : public QObject
+        {
+            Q_OBJECT
+
+        public:
+            //! Constructs an undo stack which journals the changes to the tree underneath \p root.
+            /*!
+              The stack is a child of \p root when \p parent is 0.
+              */
+            ObserverUndoStack(Observer* root, QObject* parent = 0);
+            virtual ~ObserverUndoStack();
+
+            //! Returns the root observer of the journaled tree.
+            Observer* rootObserver() const;
+
+            //! Returns the number of steps on the stack.
+            int count() const;
+            //! Returns the index of the next step which will be redone, thus the number of steps which can be undone.
+            int index() const;
+            //! Indicates if a step can be undone.
+            bool canUndo() const;
+            //! Indicates if a step can be redone.
+            bool canRedo() const;
+            //! Returns the text of the step at \p index.
+            QString text(int index) const;
+            //! Returns the text of the step which will be undone next.
+            QString undoText() const;
+            //! Returns the text of the step which will be redone next.
+            QString redoText() const;
+            //! Returns the diff of the step at \p index, which redoes the step.
+            ObserverTreeDiff stepDiff(int index) const;
+            //! Returns the total number of edits in all steps on the stack.
+            int editCount() const;
+
+            //! Sets the maximum number of steps on the stack. When 0, which is the default, the number of steps is not limited.
+            void setStepLimit(int limit);
+            //! Returns the maximum number of steps on the stack.
+            int stepLimit() const;
+            //! Sets the maximum number of edits in all steps on the stack. When 0, which is the default, the number of edits is not limited.
+            /*!
+              The number of edits is a measure of the memory used by the stack. The newest step is always kept, even when it has more edits than the limit.
+              */
+            void setEditLimit(int limit);
+            //! Returns the maximum number of edits in all steps on the stack.
+            int editLimit() const;
+
+            //! Starts a step which groups all changes until the matching endStep() call.
+            /*!
+              Calls to beginStep() can be nested, the step is recorded when the outermost step ends. Changes made before beginStep() are recorded as a step of their own.
+              */
+            void beginStep(const QString& text = QString());
+            //! Ends a step started with beginStep().
+            void endStep();
+
+        public slots:
+            //! Records the changes made since the previous step as a new step.
+            /*!
+              \param text The text of the step. When empty, a text which describes the edits in the step is used.
+              \returns True when a step was recorded, false when the tree did not change or when a step is being grouped using beginStep().
+              */
+            bool checkpoint(const QString& text = QString());
+            //! Undoes the step at index() - 1.
+            /*!
+              Changes which were not recorded yet are recorded as a step first, after which that step is undone.
+
+              \returns True when the step was undone completely, false otherwise.
+              */
+            bool undo();
+            //! Redoes the step at index().
+            /*!
+              \returns True when the step was redone completely, false otherwise.
+              */
+            bool redo();
+            //! Removes all steps from the stack, the current tree becomes the starting point of the journal.
+            void clear();
+
+        signals:
+            //! Signal which is emitted when index() changes.
+            void indexChanged(int index);
+            //! Signal which is emitted when canUndo() changes.
+            void canUndoChanged(bool can_undo);
+            //! Signal which is emitted when canRedo() changes.
+            void canRedoChanged(bool can_redo);
+            //! Signal which is emitted when undoText() changes.
+            void undoTextChanged(const QString& undo_text);
+            //! Signal which is emitted when redoText() changes.
+            void redoTextChanged(const QString& redo_text);
+            //! Signal which is emitted when undo() or redo() could not apply all edits of a step.
+            void stepFailed(const QString& error_msg);
+
+        private slots:
+            void handleTreeChanged();
+            void handleQueuedCheckpoint();
+            void handleRootDestroyed();
+
+        private:
+            void trimSteps();
+            void emitStateChanges(int previous_index, bool previous_can_undo, bool previous_can_redo, const QString& previous_undo_text, const QString& previous_redo_text);
+            static QString stepText(const ObserverTreeDiff& diff);
+
+            ObserverUndoStackPrivateData* d;
+        };
+    }
+}
+
+#endif // OBSERVER_UNDO_STACK_H
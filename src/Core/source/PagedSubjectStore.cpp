@@ -0,0 +1,435 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "PagedSubjectStore.h"
+#include "Observer.h"
+#include "QtilitiesCoreApplication.h"
+#include "IFactoryProvider.h"
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QFile>
+#include <QHash>
+#include <QLinkedList>
+#include <QPointer>
+#include <QVector>
+
+#include <Logger>
+
+using namespace Qtilities::Core;
+using namespace Qtilities::Core::Interfaces;
+
+namespace {
+    //! The location of a record in the backing file of a PagedSubjectStore.
+    struct qti_private_PagedRecord {
+        qti_private_PagedRecord() : offset(-1), size(0) {}
+
+        qint64      offset;
+        qint32      size;
+        QString     name;
+    };
+
+    //! A record which is attached to the observer of a PagedSubjectStore.
+    struct qti_private_ResidentSubject {
+        qti_private_ResidentSubject() : key(0) {}
+
+        QPointer<QObject>   subject;
+        //! The address of the subject, which is still needed to forget the subject after it was destroyed.
+        QObject*            key;
+    };
+}
+
+struct Qtilities::Core::PagedSubjectStorePrivateData {
+    PagedSubjectStorePrivateData() : mapped_data(0),
+        mapped_size(0),
+        maximum_resident_count(1000) {}
+
+    QPointer<Observer>                  observer;
+    QFile                               file;
+    //! The mapping of the backing file. The file is mapped again when records were appended since it was mapped.
+    uchar*                              mapped_data;
+    qint64                              mapped_size;
+    QVector<qti_private_PagedRecord>    records;
+
+    QHash<int,qti_private_ResidentSubject>  resident_subjects;
+    QHash<QObject*,int>                 subject_records;
+    QHash<int,int>                      lock_counts;
+    //! The resident records which are not locked, the least recently used record first.
+    QLinkedList<int>                    unlocked_records;
+    //! The positions of records in unlocked_records, thus records are moved and removed in constant time.
+    QHash<int,QLinkedList<int>::iterator> unlocked_positions;
+    int                                 maximum_resident_count;
+};
+
+Qtilities::Core::PagedSubjectStore::PagedSubjectStore(Observer* observer, QObject* parent) : QObject(parent) {
+    d = new PagedSubjectStorePrivateData;
+    d->observer = observer;
+}
+
+Qtilities::Core::PagedSubjectStore::~PagedSubjectStore() {
+    close();
+    delete d;
+}
+
+Qtilities::Core::Observer* Qtilities::Core::PagedSubjectStore::observer() const {
+    return d->observer;
+}
+
+bool Qtilities::Core::PagedSubjectStore::open(const QString& file_name, QString* errorMsg) {
+    close();
+
+    d->file.setFileName(file_name);
+    if (!d->file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        if (errorMsg)
+            *errorMsg = QString(tr("Failed to open paged subject store file \"%1\": %2")).arg(file_name).arg(d->file.errorString());
+        return false;
+    }
+
+    return true;
+}
+
+void Qtilities::Core::PagedSubjectStore::close() {
+    if (!d->file.isOpen())
+        return;
+
+    // Modified subjects do not have to be written back since the file is discarded:
+    QList<int> resident_records = d->resident_subjects.keys();
+    if (d->observer && !resident_records.isEmpty())
+        d->observer->startProcessingCycle();
+    for (int i = 0; i < resident_records.count(); ++i) {
+        QPointer<QObject> subject = d->resident_subjects.value(resident_records.at(i)).subject;
+        forgetResidentRecord(resident_records.at(i));
+        if (subject && d->observer && d->observer->contains(subject))
+            d->observer->detachSubject(subject);
+        if (subject)
+            delete subject;
+    }
+    if (d->observer && !resident_records.isEmpty())
+        d->observer->endProcessingCycle();
+    d->lock_counts.clear();
+
+    if (d->mapped_data)
+        d->file.unmap(d->mapped_data);
+    d->mapped_data = 0;
+    d->mapped_size = 0;
+    d->records.clear();
+    d->file.close();
+}
+
+bool Qtilities::Core::PagedSubjectStore::isOpen() const {
+    return d->file.isOpen();
+}
+
+QString Qtilities::Core::PagedSubjectStore::fileName() const {
+    return d->file.fileName();
+}
+
+int Qtilities::Core::PagedSubjectStore::appendSubject(QObject* subject) {
+    int record = writeRecord(-1,subject);
+    if (record != -1)
+        delete subject;
+    return record;
+}
+
+bool Qtilities::Core::PagedSubjectStore::storeRecord(int record) {
+    QObject* subject = residentSubject(record);
+    if (!subject)
+        return false;
+
+    if (writeRecord(record,subject) == -1)
+        return false;
+
+    IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (subject);
+    if (mod_iface)
+        mod_iface->setModificationState(false,IModificationNotifier::NotifyNone);
+    return true;
+}
+
+int Qtilities::Core::PagedSubjectStore::recordCount() const {
+    return d->records.count();
+}
+
+QString Qtilities::Core::PagedSubjectStore::recordName(int record) const {
+    if (record < 0 || record >= d->records.count())
+        return QString();
+    return d->records.at(record).name;
+}
+
+QObject* Qtilities::Core::PagedSubjectStore::referenceRecord(int record) {
+    QObject* subject = residentSubject(record);
+    if (subject) {
+        if (!isRecordLocked(record)) {
+            removeUnlockedRecord(record);
+            appendUnlockedRecord(record);
+        }
+        return subject;
+    }
+
+    subject = materializeRecord(record);
+    if (!subject)
+        return 0;
+
+    appendUnlockedRecord(record);
+    trimResidentRecords();
+    return residentSubject(record);
+}
+
+QObject* Qtilities::Core::PagedSubjectStore::lockRecord(int record) {
+    QObject* subject = residentSubject(record);
+    if (!subject)
+        subject = materializeRecord(record);
+    if (!subject)
+        return 0;
+
+    removeUnlockedRecord(record);
+    ++d->lock_counts[record];
+    trimResidentRecords();
+    return subject;
+}
+
+void Qtilities::Core::PagedSubjectStore::unlockRecord(int record) {
+    if (!d->lock_counts.contains(record))
+        return;
+
+    if (--d->lock_counts[record] > 0)
+        return;
+
+    d->lock_counts.remove(record);
+    if (residentSubject(record)) {
+        appendUnlockedRecord(record);
+        trimResidentRecords();
+    }
+}
+
+bool Qtilities::Core::PagedSubjectStore::isRecordLocked(int record) const {
+    return d->lock_counts.value(record) > 0;
+}
+
+bool Qtilities::Core::PagedSubjectStore::isRecordResident(int record) const {
+    return residentSubject(record) != 0;
+}
+
+int Qtilities::Core::PagedSubjectStore::recordOfSubject(QObject* subject) const {
+    int record = d->subject_records.value(subject,-1);
+    if (record == -1 || !residentSubject(record))
+        return -1;
+    return record;
+}
+
+int Qtilities::Core::PagedSubjectStore::residentCount() const {
+    return d->resident_subjects.count();
+}
+
+void Qtilities::Core::PagedSubjectStore::setMaximumResidentCount(int count) {
+    if (count < 0)
+        count = 0;
+    if (d->maximum_resident_count == count)
+        return;
+
+    d->maximum_resident_count = count;
+    trimResidentRecords();
+}
+
+int Qtilities::Core::PagedSubjectStore::maximumResidentCount() const {
+    return d->maximum_resident_count;
+}
+
+void Qtilities::Core::PagedSubjectStore::evictUnlockedRecords() {
+    if (d->unlocked_records.isEmpty())
+        return;
+
+    if (d->observer)
+        d->observer->startProcessingCycle();
+    while (!d->unlocked_records.isEmpty())
+        evictRecord(d->unlocked_records.first());
+    if (d->observer)
+        d->observer->endProcessingCycle();
+}
+
+void Qtilities::Core::PagedSubjectStore::handleSubjectDestroyed(QObject* subject) {
+    int record = d->subject_records.value(subject,-1);
+    if (record != -1)
+        forgetResidentRecord(record);
+}
+
+int Qtilities::Core::PagedSubjectStore::writeRecord(int record, QObject* subject) {
+    if (!subject || !d->file.isOpen())
+        return -1;
+
+    IExportable* export_iface = qobject_cast<IExportable*> (subject);
+    if (!export_iface)
+        return -1;
+
+    QByteArray bytes;
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    QDataStream stream(&buffer);
+    stream.setVersion(QDataStream::Qt_4_7);
+
+    if (!export_iface->instanceFactoryInfo().exportBinary(stream,Qtilities::Qtilities_Latest))
+        return -1;
+    export_iface->setExportVersion(Qtilities::Qtilities_Latest);
+    if (export_iface->exportBinary(stream) == IExportable::Failed)
+        return -1;
+    buffer.close();
+
+    // Records are always appended, thus the mapping of records which are being read stays valid until the file is mapped again:
+    qint64 offset = d->file.size();
+    if (!d->file.seek(offset) || d->file.write(bytes) != bytes.size()) {
+        LOG_ERROR(QString(tr("Failed to write record to paged subject store file \"%1\": %2")).arg(d->file.fileName()).arg(d->file.errorString()));
+        return -1;
+    }
+
+    qti_private_PagedRecord paged_record;
+    paged_record.offset = offset;
+    paged_record.size = bytes.size();
+    paged_record.name = subject->objectName();
+
+    if (record == -1) {
+        d->records.append(paged_record);
+        return d->records.count() - 1;
+    } else {
+        d->records[record] = paged_record;
+        return record;
+    }
+}
+
+QObject* Qtilities::Core::PagedSubjectStore::materializeRecord(int record) {
+    if (record < 0 || record >= d->records.count() || !d->observer)
+        return 0;
+
+    const qti_private_PagedRecord& paged_record = d->records.at(record);
+    if (paged_record.offset + paged_record.size > d->mapped_size) {
+        if (d->mapped_data)
+            d->file.unmap(d->mapped_data);
+        d->file.flush();
+        d->mapped_size = d->file.size();
+        d->mapped_data = d->file.map(0,d->mapped_size);
+        if (!d->mapped_data) {
+            d->mapped_size = 0;
+            LOG_ERROR(QString(tr("Failed to map paged subject store file \"%1\": %2")).arg(d->file.fileName()).arg(d->file.errorString()));
+            return 0;
+        }
+    }
+
+    // The record is read directly from the mapping without copying it:
+    QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char*> (d->mapped_data + paged_record.offset),paged_record.size);
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_4_7);
+
+    InstanceFactoryInfo instanceFactoryInfo;
+    if (!instanceFactoryInfo.importBinary(stream,Qtilities::Qtilities_Latest) || !instanceFactoryInfo.isValid())
+        return 0;
+
+    IFactoryProvider* ifactory = OBJECT_MANAGER->referenceIFactoryProvider(instanceFactoryInfo.d_factory_tag);
+    if (!ifactory) {
+        LOG_ERROR(QString(tr("Failed to materialize paged subject \"%1\": Factory \"%2\" does not exist.")).arg(paged_record.name).arg(instanceFactoryInfo.d_factory_tag));
+        return 0;
+    }
+
+    QObject* subject = ifactory->createInstance(instanceFactoryInfo);
+    IExportable* export_iface = qobject_cast<IExportable*> (subject);
+    if (!export_iface) {
+        delete subject;
+        return 0;
+    }
+
+    subject->setObjectName(instanceFactoryInfo.d_instance_name);
+    export_iface->setExportVersion(Qtilities::Qtilities_Latest);
+    QList<QPointer<QObject> > import_list;
+    if (export_iface->importBinary(stream,import_list) == IExportable::Failed) {
+        delete subject;
+        return 0;
+    }
+
+    IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (subject);
+    if (mod_iface)
+        mod_iface->setModificationState(false,IModificationNotifier::NotifyNone);
+
+    if (!d->observer->attachSubject(subject,Observer::ObserverScopeOwnership)) {
+        delete subject;
+        return 0;
+    }
+
+    qti_private_ResidentSubject resident_subject;
+    resident_subject.subject = subject;
+    resident_subject.key = subject;
+    d->resident_subjects[record] = resident_subject;
+    d->subject_records[subject] = record;
+    connect(subject,SIGNAL(destroyed(QObject*)),SLOT(handleSubjectDestroyed(QObject*)));
+
+    emit recordMaterialized(record,subject);
+    return subject;
+}
+
+void Qtilities::Core::PagedSubjectStore::evictRecord(int record) {
+    QPointer<QObject> subject = residentSubject(record);
+    if (!subject)
+        return;
+
+    IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (subject);
+    if (mod_iface && mod_iface->isModified())
+        writeRecord(record,subject);
+
+    forgetResidentRecord(record);
+    if (d->observer)
+        d->observer->detachSubject(subject);
+    // Detaching deletes the subject unless another observer also uses it:
+    if (subject)
+        delete subject;
+
+    emit recordEvicted(record);
+}
+
+void Qtilities::Core::PagedSubjectStore::trimResidentRecords() {
+    if (residentCount() <= d->maximum_resident_count || d->unlocked_records.isEmpty())
+        return;
+
+    if (d->observer)
+        d->observer->startProcessingCycle();
+    while (residentCount() > d->maximum_resident_count && !d->unlocked_records.isEmpty())
+        evictRecord(d->unlocked_records.first());
+    if (d->observer)
+        d->observer->endProcessingCycle();
+}
+
+QObject* Qtilities::Core::PagedSubjectStore::residentSubject(int record) const {
+    if (!d->resident_subjects.contains(record))
+        return 0;
+
+    QObject* subject = d->resident_subjects.value(record).subject;
+    if (!subject || !d->observer || !d->observer->contains(subject)) {
+        forgetResidentRecord(record);
+        return 0;
+    }
+    return subject;
+}
+
+void Qtilities::Core::PagedSubjectStore::forgetResidentRecord(int record) const {
+    qti_private_ResidentSubject resident_subject = d->resident_subjects.take(record);
+    if (resident_subject.subject)
+        resident_subject.subject->disconnect(this);
+    d->subject_records.remove(resident_subject.key);
+    removeUnlockedRecord(record);
+}
+
+void Qtilities::Core::PagedSubjectStore::appendUnlockedRecord(int record) const {
+    d->unlocked_positions[record] = d->unlocked_records.insert(d->unlocked_records.end(),record);
+}
+
+void Qtilities::Core::PagedSubjectStore::removeUnlockedRecord(int record) const {
+    QHash<int,QLinkedList<int>::iterator>::iterator itr = d->unlocked_positions.find(record);
+    if (itr == d->unlocked_positions.end())
+        return;
+
+    d->unlocked_records.erase(itr.value());
+    d->unlocked_positions.erase(itr);
+}
@@ -0,0 +1,177 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef PAGED_SUBJECT_STORE_H
+#define PAGED_SUBJECT_STORE_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QObject>
+#include <QString>
+
+namespace Qtilities {
+    namespace Core {
+        class Observer;
+
+        /*!
+        \struct PagedSubjectStorePrivateData
+        \brief Structure used by PagedSubjectStore to store private data.
+          */
+        struct PagedSubjectStorePrivateData;
+
+        /*!
+        \class PagedSubjectStore
+        \brief The PagedSubjectStore class keeps the subjects of an observer in a memory mapped file and attaches them to the observer only while they are needed.
+
+        Observers keep all their subjects in memory as live QObjects. Data sets with millions of records do not fit into memory in this way.
+        A paged subject store keeps such records serialized in a file instead. Subjects are added using appendSubject(), which serializes
+        the subject using its IExportable implementation, writes it to the end of the file and deletes it. A record is turned back into a subject using
+        the factory information stored with it, in the same way that subjects are created when an observer is imported. The subject
+        is then attached to the observer of the store:
+
+\code
+Observer* obs = new Observer("Large Data Set");
+PagedSubjectStore* store = new PagedSubjectStore(obs);
+store->open(QDir::tempPath() + "/large_data_set.pages");
+store->setMaximumResidentCount(1000);
+
+for (int i = 0; i < record_count; ++i)
+    store->appendSubject(new TreeItem(QString("Record %1").arg(i)));
+
+// Attach record 42 to the observer until it is unlocked:
+QObject* subject = store->lockRecord(42);
+// ...
+store->unlockRecord(42);
+\endcode
+
+        Records which are attached to the observer are called resident records. They are normal subjects of the observer, thus the Observer API,
+        views on the observer and TreeIterator work on them without changes. The observer only contains the resident records, not the
+        complete data set. Use recordCount() and recordName() to list the complete data set without attaching records.
+
+        A record stays resident while it is locked using lockRecord(). Records which are only referenced using referenceRecord() are evicted
+        in least recently used order when more than maximumResidentCount() records are resident. Evicted subjects are detached from the observer and
+        deleted. If a subject implements IModificationNotifier and it is modified when it is evicted, it is written back to the store first.
+        Subjects which are detached from the observer or deleted by other parts of the application are no longer resident, but their records remain in the store.
+
+        Records are never changed in place. Writing a record again appends the new version to the file, thus the file grows until the store is closed.
+        The file is only a cache for the lifetime of the store and it is truncated when the store is opened.
+
+        \note Subjects are attached to the observer using Observer::ObserverScopeOwnership. Subjects must implement IExportable and their
+        factories must be registered with the object manager, otherwise appendSubject() rejects them.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT PagedSubjectStore : public QObject
+        {
+            Q_OBJECT
+
+        public:
+            //! Constructs a store for \p observer. The store must be opened using open() before records can be added.
+            PagedSubjectStore(Observer* observer, QObject* parent = 0);
+            //! Destructs the store. All resident records are evicted and the store is closed.
+            virtual ~PagedSubjectStore();
+
+            //! Returns the observer to which resident records are attached.
+            Observer* observer() const;
+
+            //! Opens \p file_name as the backing file of the store. An existing file is truncated.
+            /*!
+             * \param file_name The file in which records must be stored.
+             * \param errorMsg When valid, will be populated with error message if the function fails.
+             * \returns True if successfull, false otherwise.
+             */
+            bool open(const QString& file_name, QString* errorMsg = 0);
+            //! Evicts all resident records, removes all records and closes the backing file.
+            void close();
+            //! Indicates if the store is open.
+            bool isOpen() const;
+            //! Returns the backing file of the store.
+            QString fileName() const;
+
+            //! Serializes \p subject into a new record and deletes \p subject.
+            /*!
+             * \returns The number of the new record, or -1 when \p subject does not implement IExportable or could not be written. In that case \p subject is not deleted.
+             */
+            int appendSubject(QObject* subject);
+            //! Writes the resident subject of \p record to the store again, for example after it was changed.
+            /*!
+             * \returns True if successfull, false when the record is not resident or could not be written.
+             */
+            bool storeRecord(int record);
+            //! Returns the number of records in the store.
+            int recordCount() const;
+            //! Returns the name of \p record without attaching it.
+            QString recordName(int record) const;
+
+            //! Attaches \p record to the observer if it is not resident and marks it as the most recently used record.
+            /*!
+             * Referencing a record might evict other unlocked records. The returned subject is only valid until it is evicted in turn, use lockRecord() to keep it resident.
+             *
+             * \returns The subject of the record, or 0 when the record could not be materialized or attached to the observer.
+             */
+            QObject* referenceRecord(int record);
+            //! Attaches \p record to the observer if it is not resident and keeps it resident until unlockRecord() is called as many times as this function.
+            /*!
+             * \returns The subject of the record, or 0 when the record could not be materialized or attached to the observer.
+             */
+            QObject* lockRecord(int record);
+            //! Releases a lock obtained using lockRecord().
+            void unlockRecord(int record);
+            //! Indicates if \p record is locked.
+            bool isRecordLocked(int record) const;
+            //! Indicates if \p record is attached to the observer.
+            bool isRecordResident(int record) const;
+            //! Returns the record of a resident subject, or -1 if \p subject is not a resident subject of this store.
+            int recordOfSubject(QObject* subject) const;
+            //! Returns the number of resident records.
+            int residentCount() const;
+
+            //! Sets the number of resident records after which unlocked records are evicted. The default is 1000.
+            void setMaximumResidentCount(int count);
+            //! Returns the number of resident records after which unlocked records are evicted.
+            int maximumResidentCount() const;
+            //! Evicts all resident records which are not locked.
+            void evictUnlockedRecords();
+
+        signals:
+            //! Signal emitted after \p record was attached to the observer as \p subject.
+            void recordMaterialized(int record, QObject* subject);
+            //! Signal emitted after \p record was detached from the observer.
+            void recordEvicted(int record);
+
+        private slots:
+            //! Forgets resident subjects which are deleted by other parts of the application.
+            void handleSubjectDestroyed(QObject* subject);
+
+        private:
+            //! Serializes \p subject into the store for \p record. Pass -1 as \p record to add a new record.
+            int writeRecord(int record, QObject* subject);
+            //! Creates the subject of \p record and attaches it to the observer.
+            QObject* materializeRecord(int record);
+            //! Detaches the subject of \p record from the observer and deletes it.
+            void evictRecord(int record);
+            //! Evicts least recently used records until maximumResidentCount() is honored.
+            void trimResidentRecords();
+            //! Returns the resident subject of \p record. Subjects which were detached from the observer by other parts of the application are forgotten.
+            QObject* residentSubject(int record) const;
+            //! Removes \p record from the resident bookkeeping.
+            void forgetResidentRecord(int record) const;
+            //! Marks \p record as the most recently used unlocked record.
+            void appendUnlockedRecord(int record) const;
+            //! Removes \p record from the unlocked records.
+            void removeUnlockedRecord(int record) const;
+
+            PagedSubjectStorePrivateData* d;
+        };
+    }
+}
+
+#endif // PAGED_SUBJECT_STORE_H
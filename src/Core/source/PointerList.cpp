@@ -11,47 +11,111 @@
 
 #include "PointerList.h"
 
+#include <QPointer>
+
 Qtilities::Core::PointerList::PointerList(bool cleanup_when_done, QObject *parent) : PointerListDeleter() {
     Q_UNUSED(parent)
 
     cleanup_enabled = cleanup_when_done;
+    empty_slots = 0;
+    list_cache_valid = true;
+    write_lock = 0;
 }
 
 Qtilities::Core::PointerList::~PointerList() {
-    if (cleanup_enabled)
-        list.clear();
+    if (cleanup_enabled) {
+        object_slots.clear();
+        slot_tree.clear();
+        object_slot_index.clear();
+        list_cache.clear();
+        iterator_list.clear();
+    }
 }
 
 //! Appends a new instance of T to the PointerList.
 void Qtilities::Core::PointerList::append(QObject* object) {
+    if (object_slot_index.contains(object))
+        return;
+
     addThisObject(object);
-    list.append(object);
+    QWriteLocker locker(write_lock);
+    const int slot = object_slots.count();
+    object_slots.append(object);
+    object_slot_index[object] = slot;
+
+    // The new Fenwick tree node counts the new object and the slots covered by the nodes below it:
+    const int node = slot + 1;
+    int node_count = 1;
+    for (int j = node - 1; j > node - (node & -node); j -= (j & -j))
+        node_count += slot_tree.at(j - 1);
+    slot_tree.append(node_count);
+
+    if (list_cache_valid)
+        list_cache.append(object);
 }
 
 void Qtilities::Core::PointerList::deleteAll() {
-    int total =list.count();
-    for (int i = 0; i < total; ++i) {
-        delete list.at(0);
-    }
-    list.clear();
+    // Objects might delete other objects in the list, thus guarded pointers are used:
+    QList<QPointer<QObject> > objects;
+    foreach (QObject* obj, toQList())
+        objects << obj;
+    for (int i = 0; i < objects.count(); ++i)
+        delete objects.at(i);
+
+    QWriteLocker locker(write_lock);
+    object_slots.clear();
+    slot_tree.clear();
+    object_slot_index.clear();
+    empty_slots = 0;
+    list_cache.clear();
+    list_cache_valid = true;
 }
 
 int Qtilities::Core::PointerList::count() const {
-    return list.count();
+    return object_slots.count() - empty_slots;
 }
 
 QObject* Qtilities::Core::PointerList::at(int i) const {
-    return list.at(i);
+    return object_slots.at(slotAt(i));
 }
 
 void Qtilities::Core::PointerList::removeThisObject(QObject * obj) {
-    list.removeOne(obj);
+    QHash<const QObject*,int>::const_iterator itr = object_slot_index.constFind(obj);
+    if (itr != object_slot_index.constEnd())
+        removeSlot(itr.value());
     emit objectDestroyed(obj);
 }
 
 void Qtilities::Core::PointerList::removeOne(QObject* obj) {
+    QHash<const QObject*,int>::const_iterator itr = object_slot_index.constFind(obj);
+    if (itr == object_slot_index.constEnd())
+        return;
+
     QObject::disconnect(obj, SIGNAL(destroyed(QObject *)), this, SLOT(removeSender()));
-    list.removeOne(obj);
+    removeSlot(itr.value());
+}
+
+void Qtilities::Core::PointerList::removeAt(int i) {
+    const int slot = slotAt(i);
+    QObject::disconnect(object_slots.at(slot), SIGNAL(destroyed(QObject *)), this, SLOT(removeSender()));
+    removeSlot(slot);
+}
+
+int Qtilities::Core::PointerList::indexOf(QObject* obj) const {
+    QHash<const QObject*,int>::const_iterator itr = object_slot_index.constFind(obj);
+    if (itr == object_slot_index.constEnd())
+        return -1;
+
+    if (empty_slots == 0)
+        return itr.value();
+    return countUpTo(itr.value()) - 1;
+}
+
+void Qtilities::Core::PointerList::reserve(int size) {
+    QWriteLocker locker(write_lock);
+    object_slots.reserve(size);
+    slot_tree.reserve(size);
+    object_slot_index.reserve(size);
 }
 
 void Qtilities::Core::PointerList::addThisObject(QObject * obj) {
@@ -59,10 +123,109 @@ void Qtilities::Core::PointerList::addThisObject(QObject * obj) {
 }
 
 QMutableListIterator<QObject*> Qtilities::Core::PointerList::iterator() {
-    QMutableListIterator<QObject*> itr(list);
+    // Changes made through the iterator must not change the cached list returned by toQList():
+    iterator_list = toQList();
+    QMutableListIterator<QObject*> itr(iterator_list);
     return itr;
 }
 
 QList<QObject*> Qtilities::Core::PointerList::toQList() const {
-    return list;
+    if (!list_cache_valid) {
+        list_cache.clear();
+        list_cache.reserve(count());
+        const int slot_count = object_slots.count();
+        for (int i = 0; i < slot_count; ++i) {
+            if (object_slots.at(i))
+                list_cache.append(object_slots.at(i));
+        }
+        list_cache_valid = true;
+    }
+    return list_cache;
+}
+
+int Qtilities::Core::PointerList::slotAt(int i) const {
+    if (empty_slots == 0)
+        return i;
+
+    // Finds the first slot for which the number of objects up to and including it is i + 1:
+    const int node_count = slot_tree.count();
+    int step = 1;
+    while (step * 2 <= node_count)
+        step *= 2;
+
+    int node = 0;
+    int remaining = i + 1;
+    for (; step > 0; step >>= 1) {
+        if (node + step <= node_count && slot_tree.at(node + step - 1) < remaining) {
+            node += step;
+            remaining -= slot_tree.at(node - 1);
+        }
+    }
+    return node;
+}
+
+void Qtilities::Core::PointerList::setWriteLock(QReadWriteLock* lock) {
+    write_lock = lock;
+}
+
+void Qtilities::Core::PointerList::removeSlot(int slot) {
+    QWriteLocker locker(write_lock);
+    object_slot_index.remove(object_slots.at(slot));
+    list_cache_valid = false;
+
+    if (slot == object_slots.count() - 1) {
+        // Fenwick tree nodes only count slots before them, thus the last node can simply be dropped:
+        object_slots.remove(slot);
+        slot_tree.remove(slot);
+        while (!object_slots.isEmpty() && !object_slots.last()) {
+            object_slots.remove(object_slots.count() - 1);
+            slot_tree.remove(slot_tree.count() - 1);
+            --empty_slots;
+        }
+        return;
+    }
+
+    object_slots[slot] = 0;
+    addToTree(slot,-1);
+    ++empty_slots;
+    if (empty_slots > 32 && empty_slots > count())
+        compact();
+}
+
+void Qtilities::Core::PointerList::compact() {
+    int used_slots = 0;
+    const int slot_count = object_slots.count();
+    for (int i = 0; i < slot_count; ++i) {
+        QObject* obj = object_slots.at(i);
+        if (!obj)
+            continue;
+        if (used_slots != i) {
+            object_slots[used_slots] = obj;
+            object_slot_index[obj] = used_slots;
+        }
+        ++used_slots;
+    }
+    object_slots.resize(used_slots);
+    empty_slots = 0;
+
+    // Builds the Fenwick tree in linear time:
+    slot_tree.fill(1,used_slots);
+    for (int node = 1; node <= used_slots; ++node) {
+        const int parent = node + (node & -node);
+        if (parent <= used_slots)
+            slot_tree[parent - 1] += slot_tree.at(node - 1);
+    }
+}
+
+void Qtilities::Core::PointerList::addToTree(int slot, int delta) {
+    const int node_count = slot_tree.count();
+    for (int node = slot + 1; node <= node_count; node += (node & -node))
+        slot_tree[node - 1] += delta;
+}
+
+int Qtilities::Core::PointerList::countUpTo(int slot) const {
+    int result = 0;
+    for (int node = slot + 1; node > 0; node -= (node & -node))
+        result += slot_tree.at(node - 1);
+    return result;
 }
@@ -18,6 +18,9 @@
 
 #include <QObject>
 #include <QList>
+#include <QVector>
+#include <QHash>
+#include <QReadWriteLock>
 #include <QtDebug>
 
 #include "QtilitiesCore_global.h"
@@ -79,6 +82,11 @@ test_list: Adding object test2.
 test_list: Removing object test from the pointer list when it is destructed.
 test_list: Delete object test2 during destruction of test_list. Deleting it will also result in test2 being removed from the pointer list before it is destructed.
 \endcode
+
+        Objects are stored in a dense array together with a hash of their positions. Removed objects leave an empty slot behind, and a
+        Fenwick tree which counts the objects in use before each slot maps positions to slots. Thus appending, removing and looking up
+        objects take at most O(log n) time, also when large numbers of objects are destroyed. Empty slots are compacted once they outnumber
+        the objects in the list.
 */
 
         class QTILIITES_CORE_SHARED_EXPORT PointerList : public PointerListDeleter
@@ -92,21 +100,82 @@ test_list: Delete object test2 during destruction of test_list. Deleting it will
             PointerList(bool cleanup_when_done = false, QObject *parent = 0);
             ~PointerList();
 
+            //! Appends object to the list.
+            /*!
+              Objects which are already in the list are not added again, thus every object is in the list at most once.
+
+              \note Before %Qtilities v1.5 an object could be added to the list more than once.
+              */
             void append(QObject* object);
             void deleteAll();
             int count() const;
             void removeOne(QObject* obj);
+            //! Removes the object at position i.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeAt(int i);
+            //! Returns the position of obj in the list, or -1 if obj is not in the list.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int indexOf(QObject* obj) const;
+            //! Reserves space for \p size objects.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void reserve(int size);
             QObject* at(int i) const;
-            QMutableListIterator<QObject*> iterator();
+            //! Returns an iterator over a copy of the objects in the list.
+            /*!
+              \deprecated Since %Qtilities v1.5 changes made through the iterator, for example QMutableListIterator::remove(), are not applied to the
+              list. Use toQList() to iterate over the objects, and removeOne() or removeAt() to remove objects from the list.
+
+              The copy is replaced every time this function is called, thus only the iterator returned last may be used.
+              */
+            Q_DECL_DEPRECATED QMutableListIterator<QObject*> iterator();
             QList<QObject*> toQList() const;
+            //! Sets a lock which is locked for writing while objects are added to or removed from the list.
+            /*!
+              This allows other threads to read the list using count() and at() while holding the lock for reading. The
+              lock is not owned by the list. Pass 0 to stop using a lock.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setWriteLock(QReadWriteLock* lock);
 
         protected:
             virtual void removeThisObject(QObject * object);
             virtual void addThisObject(QObject * obj);
 
         private:
+            //! Returns the slot of the object at position i.
+            int slotAt(int i) const;
+            //! Removes the object in the given slot.
+            void removeSlot(int slot);
+            //! Removes all empty slots and rebuilds the position hash and the Fenwick tree.
+            void compact();
+            //! Adds delta to the Fenwick tree count of the given slot.
+            void addToTree(int slot, int delta);
+            //! Returns the number of objects in slots up to and including the given slot.
+            int countUpTo(int slot) const;
+
             bool cleanup_enabled;
-            QList<QObject*> list;
+            //! The objects in the list, removed objects leave a null slot behind.
+            QVector<QObject*> object_slots;
+            //! Fenwick tree counting the objects in object_slots.
+            QVector<int> slot_tree;
+            //! The slot of each object in object_slots.
+            QHash<const QObject*,int> object_slot_index;
+            //! The number of null slots in object_slots.
+            int empty_slots;
+            //! Cached result of toQList(), it is extended when objects are appended and rebuilt after objects were removed.
+            mutable QList<QObject*> list_cache;
+            mutable bool list_cache_valid;
+            //! The copy of the list used by the iterator returned by iterator().
+            QList<QObject*> iterator_list;
+            //! The lock set using setWriteLock(), or 0.
+            QReadWriteLock* write_lock;
         };
     }
 }
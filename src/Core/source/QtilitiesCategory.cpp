@@ -10,10 +10,27 @@
 ****************************************************************************/
 
 #include "QtilitiesCategory.h"
+#include "CborStream.h"
+#include "CompactBinaryFormat.h"
 
 #include <Logger.h>
 
 #include <QDomElement>
+#include <QHash>
+#include <QMutex>
+
+namespace {
+    //! The table from which QtilitiesCategory::categoryID() assigns IDs, keyed by the joined level names of categories.
+    struct CategoryIDTable {
+        CategoryIDTable() : next_id(1) {}
+
+        QMutex              mutex;
+        QHash<QString,int>  ids;
+        int                 next_id;
+    };
+}
+
+Q_GLOBAL_STATIC(CategoryIDTable, qti_private_category_id_table)
 
 // -----------------------------------------
 // CategoryLevel
@@ -30,7 +47,10 @@ Qtilities::Core::IExportable::ExportResultFlags Qtilities::Core::CategoryLevel::
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    stream << d_name;
+    if (CompactBinaryFormat::isActive(stream))
+        CompactBinaryFormat::writeString(stream,d_name);
+    else
+        stream << d_name;
     return IExportable::Complete;
 }
 
@@ -41,7 +61,10 @@ Qtilities::Core::IExportable::ExportResultFlags Qtilities::Core::CategoryLevel::
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    stream >> d_name;
+    if (CompactBinaryFormat::isActive(stream))
+        d_name = CompactBinaryFormat::readString(stream);
+    else
+        stream >> d_name;
     return IExportable::Complete;
 }
 
@@ -76,14 +99,14 @@ Qtilities::Core::IExportable::ExportResultFlags Qtilities::Core::CategoryLevel::
 // QtilitiesCategory
 // -----------------------------------------
 
-Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QString& category_level_name) : IExportable()  {
+Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QString& category_level_name) : IExportable(), d_category_id(-1)  {
     if (!category_level_name.isEmpty())
         addLevel(category_level_name);
     d_access_mode = 3;
     //d_category_icon = 0;
 }
 
-Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QString& category_levels, const QString& separator) : IExportable() {
+Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QString& category_levels, const QString& separator) : IExportable(), d_category_id(-1) {
     QStringList category_name_list = category_levels.split(separator,QString::SkipEmptyParts);
     foreach(QString level,category_name_list) {
         if (level.trimmed().length() > 0)
@@ -93,7 +116,7 @@ Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QString& category_le
     //d_category_icon = 0;
 }
 
-Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QStringList& category_name_list) : IExportable() {
+Qtilities::Core::QtilitiesCategory::QtilitiesCategory(const QStringList& category_name_list) : IExportable(), d_category_id(-1) {
     foreach(QString level,category_name_list)
         addLevel(level);
     d_access_mode = 3;
@@ -105,6 +128,7 @@ QtilitiesCategory& Qtilities::Core::QtilitiesCategory::operator=(const Qtilities
 
     d_category_levels = other.categoryLevels();
     d_access_mode = other.accessMode();
+    d_category_id = other.d_category_id;
 //    if (!other.categoryIcon().isNull())
 //        d_category_icon = new QIcon(other.categoryIcon());
 
@@ -112,7 +136,9 @@ QtilitiesCategory& Qtilities::Core::QtilitiesCategory::operator=(const Qtilities
 }
 
 bool Qtilities::Core::QtilitiesCategory::operator==(const QtilitiesCategory& ref) const {
-    return d_category_levels == ref.categoryLevels();
+    if (d_category_levels.count() != ref.d_category_levels.count())
+        return false;
+    return categoryID() == ref.categoryID();
 }
 
 bool Qtilities::Core::QtilitiesCategory::operator!=(const QtilitiesCategory& ref) const {
@@ -150,10 +176,36 @@ QStringList Qtilities::Core::QtilitiesCategory::toStringList(int level) const {
 void Qtilities::Core::QtilitiesCategory::addLevel(const QString& name) {
     CategoryLevel category_level(name);
     d_category_levels.push_back(category_level);
+    d_category_id = -1;
 }
 
 void Qtilities::Core::QtilitiesCategory::addLevel(CategoryLevel category_level) {
     d_category_levels.push_back(category_level);
+    d_category_id = -1;
+}
+
+int Qtilities::Core::QtilitiesCategory::categoryID() const {
+    if (d_category_id != -1)
+        return d_category_id;
+
+    // Empty categories don't need to be looked up:
+    if (d_category_levels.isEmpty()) {
+        d_category_id = 0;
+        return d_category_id;
+    }
+
+    // The unit separator can't be typed, thus level names containing the join string used in toString() still get unique keys:
+    QString key = toString(QString(QChar(0x1F)));
+    CategoryIDTable* table = qti_private_category_id_table();
+    QMutexLocker locker(&table->mutex);
+    QHash<QString,int>::const_iterator itr = table->ids.constFind(key);
+    if (itr != table->ids.constEnd()) {
+        d_category_id = itr.value();
+    } else {
+        d_category_id = table->next_id++;
+        table->ids.insert(key,d_category_id);
+    }
+    return d_category_id;
 }
 
 void Qtilities::Core::QtilitiesCategory::setExportVersion(Qtilities::ExportVersion version) {
@@ -175,6 +227,7 @@ Qtilities::Core::Interfaces::IExportable::ExportModeFlags Qtilities::Core::Qtili
     IExportable::ExportModeFlags flags = 0;
     flags |= IExportable::Binary;
     flags |= IExportable::XML;
+    flags |= IExportable::Cbor;
     return flags;
 }
 
@@ -183,8 +236,13 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Qti
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    stream << (quint32) accessMode();
-    stream << (quint32) categoryDepth();
+    if (CompactBinaryFormat::isActive(stream)) {
+        CompactBinaryFormat::writeVarInt(stream,accessMode());
+        CompactBinaryFormat::writeVarUInt(stream,categoryDepth());
+    } else {
+        stream << (quint32) accessMode();
+        stream << (quint32) categoryDepth();
+    }
     bool all_successful = true;
     for (int i = 0; i < categoryDepth(); ++i) {
         if (categoryLevels().at(i).exportBinary(stream) != IExportable::Complete)
@@ -203,11 +261,17 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Qti
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    quint32 ui32;
-    stream >> ui32;
-    setAccessMode(ui32);
-    stream >> ui32;
-    int count_int = ui32;
+    int count_int;
+    if (CompactBinaryFormat::isActive(stream)) {
+        setAccessMode(CompactBinaryFormat::readVarInt(stream));
+        count_int = CompactBinaryFormat::readVarUInt(stream);
+    } else {
+        quint32 ui32;
+        stream >> ui32;
+        setAccessMode(ui32);
+        stream >> ui32;
+        count_int = ui32;
+    }
     for (int i = 0; i < count_int; ++i) {
         Qtilities::Core::CategoryLevel category_level(stream,exportVersion());
         addLevel(category_level);
@@ -279,6 +343,65 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Qti
         return IExportable::Failed;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::QtilitiesCategory::exportCbor(CborStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (!writer)
+        return IExportable::Failed;
+
+    writer->startMap(2);
+    writer->writeString("accessMode");
+    writer->writeInteger(d_access_mode);
+    writer->writeString("levels");
+    writer->startArray(d_category_levels.count());
+    for (int i = 0; i < d_category_levels.count(); ++i)
+        writer->writeString(d_category_levels.at(i).d_name);
+    writer->endArray();
+    writer->endMap();
+
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::QtilitiesCategory::importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    Q_UNUSED(import_list)
+
+    if (!reader)
+        return IExportable::Failed;
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported) {
+        reader->next();
+        return version_check_result;
+    }
+
+    if (!reader->isMap()) {
+        reader->next();
+        return IExportable::Failed;
+    }
+
+    reader->enterContainer();
+    while (reader->hasNext()) {
+        QString key = reader->readString();
+        if (key == QLatin1String("accessMode") && reader->isInteger()) {
+            d_access_mode = (int) reader->toInteger();
+            reader->next();
+        } else if (key == QLatin1String("levels") && reader->isArray()) {
+            reader->enterContainer();
+            while (reader->hasNext())
+                addLevel(reader->readString());
+            reader->leaveContainer();
+        } else
+            reader->next();
+    }
+    reader->leaveContainer();
+
+    if (reader->hasError() || !isValid())
+        return IExportable::Failed;
+    return IExportable::Complete;
+}
+
 QDataStream & operator<< (QDataStream& stream, const Qtilities::Core::CategoryLevel& stream_obj) {
     stream_obj.exportBinary(stream);
     return stream;
@@ -168,7 +168,7 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
             QtilitiesCategory(const QString& category_levels, const QString& separator);
             //! Creates a QtilitiesCategory object from a QStringList.
             QtilitiesCategory(const QStringList& category_name_list);
-            QtilitiesCategory(QDataStream &ds, Qtilities::ExportVersion version) : IObjectBase(), IExportable() {
+            QtilitiesCategory(QDataStream &ds, Qtilities::ExportVersion version) : IObjectBase(), IExportable(), d_category_id(-1) {
                 QList<QPointer<QObject> > import_list;
                 setExportVersion(version);
                 importBinary(ds,import_list);
@@ -176,6 +176,7 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
             QtilitiesCategory(const QtilitiesCategory& category) : IObjectBase(), IExportable() {
                 d_category_levels = category.d_category_levels;
                 d_access_mode = category.d_access_mode;
+                d_category_id = category.d_category_id;
             }
             virtual ~QtilitiesCategory() {}
             QtilitiesCategory& operator=(const QtilitiesCategory& other);
@@ -198,21 +199,29 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
             //! Overload < operator so that we can use QtilitiesCategory in a QMap.
             inline bool operator<(const QtilitiesCategory &e1) const
             {
+                if (categoryID() == e1.categoryID())
+                    return false;
                 return toString() < e1.toString();
             }
             //! Overload > operator.
             inline bool operator>(const QtilitiesCategory &e1) const
             {
+                if (categoryID() == e1.categoryID())
+                    return false;
                 return toString() > e1.toString();
             }
             //! Overload <= operator.
             inline bool operator<=(const QtilitiesCategory &e1) const
             {
+                if (categoryID() == e1.categoryID())
+                    return true;
                 return toString() <= e1.toString();
             }
             //! Overload >= operator.
             inline bool operator>=(const QtilitiesCategory &e1) const
             {
+                if (categoryID() == e1.categoryID())
+                    return true;
                 return toString() >= e1.toString();
             }
 
@@ -224,7 +233,19 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
             //! Indicates if this category is empty. Thus no levels have been added to it.
             inline bool isEmpty() const { return (d_category_levels.count() == 0); }
             //! Clears the category.
-            inline void clear() { d_category_levels.clear(); }
+            inline void clear() { d_category_levels.clear(); d_category_id = -1; }
+            //! Returns an ID which identifies the levels of this category.
+            /*!
+              Categories with the same level names always have the same ID, and categories with different level names always have different IDs.
+              The IDs are assigned from a table shared by the whole application the first time the ID of a category is requested, afterwards the ID
+              is stored with the category and copied along with it. Thus operator==() and qHash() do not compare or hash strings for categories which
+              were compared before.
+
+              \note The access mode of the category is not part of its ID.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int categoryID() const;
 
             //! Returns the category as a QString.
             /*!
@@ -299,10 +320,18 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
               */
             IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
             IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            //! Writes the category as a map containing its \p accessMode and an array of its \p levels names.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            IExportable::ExportResultFlags exportCbor(CborStreamWriter* writer) const;
+            IExportable::ExportResultFlags importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
         protected:
             QList<CategoryLevel>    d_category_levels;
             int                     d_access_mode;
+            //! The cached result of categoryID(), -1 when it must be looked up. Must be reset whenever d_category_levels changes.
+            mutable int             d_category_id;
             //QIcon*                  d_category_icon;
         };
     }
@@ -310,6 +339,18 @@ sure that categories are handled the same way everywhere. Some usages in %Qtilit
 
 Q_DECLARE_METATYPE(Qtilities::Core::QtilitiesCategory);
 
+namespace Qtilities {
+    namespace Core {
+        //! Allows QtilitiesCategory to be used as a key in QHash and QSet.
+        /*!
+          <i>This function was added in %Qtilities v1.5.</i>
+          */
+        inline uint qHash(const QtilitiesCategory& category) {
+            return (uint) category.categoryID();
+        }
+    }
+}
+
 QDataStream & operator<< (QDataStream& stream, const Qtilities::Core::CategoryLevel& stream_obj);
 QDataStream & operator>> (QDataStream& stream, Qtilities::Core::CategoryLevel& stream_obj);
 QDataStream & operator<< (QDataStream& stream, const Qtilities::Core::QtilitiesCategory& stream_obj);
@@ -14,6 +14,7 @@
 #include "QtilitiesCoreConstants.h"
 #include "ObjectManager.h"
 #include "ContextManager.h"
+#include "HeadlessTreeNode.h"
 
 #include <QVariant>
 #include <QMap>
@@ -27,6 +28,14 @@ Qtilities::Core::QtilitiesCoreApplication* Qtilities::Core::QtilitiesCoreApplica
 Qtilities::Core::QtilitiesCoreApplication::QtilitiesCoreApplication(int &argc, char ** argv) : QCoreApplication(argc, argv) {
     if (!m_Instance) {
         m_Instance = this;
+
+        // Register the headless tree building blocks in the object manager. GUI applications register the
+        // CoreGui tree building blocks under the same tags in QtilitiesApplication instead:
+        FactoryItemID tree_item_tag(qti_def_FACTORY_TAG_TREE_ITEM,QtilitiesCategory(tr("Tree Building Blocks")));
+        QtilitiesCoreApplicationPrivate::instance()->objectManager()->registerFactoryInterface(&HeadlessTreeItem::factory,tree_item_tag);
+        FactoryItemID tree_node_tag(qti_def_FACTORY_TAG_TREE_NODE,QtilitiesCategory(tr("Tree Building Blocks")));
+        QtilitiesCoreApplicationPrivate::instance()->objectManager()->registerFactoryInterface(&HeadlessTreeNode::factory,tree_node_tag);
+
         connect(QtilitiesCoreApplicationPrivate::instance(),SIGNAL(busyStateChanged(bool)),this,SIGNAL(busyStateChanged(bool)));
     } else {
         qWarning() << QString("An instance was already created for QtilitiesCoreApplication");
@@ -49,6 +58,10 @@ Qtilities::Core::Interfaces::TaskManager* Qtilities::Core::QtilitiesCoreApplicat
     return QtilitiesCoreApplicationPrivate::instance()->taskManager();
 }
 
+Qtilities::Core::IdleScheduler* Qtilities::Core::QtilitiesCoreApplication::idleScheduler() {
+    return QtilitiesCoreApplicationPrivate::instance()->idleScheduler();
+}
+
 QString Qtilities::Core::QtilitiesCoreApplication::qtilitiesVersionString() {
     return QtilitiesCoreApplicationPrivate::instance()->qtilitiesVersionString();
 }
@@ -106,6 +119,10 @@ QString Qtilities::Core::QtilitiesCoreApplication::qtilitiesSettingsPath() {
     return QtilitiesCoreApplicationPrivate::instance()->qtilitiesSettingsPath();
 }
 
+Qtilities::Logging::SettingsStore* Qtilities::Core::QtilitiesCoreApplication::qtilitiesSettings() {
+    return Qtilities::Logging::SettingsStore::store(qtilitiesSettingsPath());
+}
+
 void Qtilities::Core::QtilitiesCoreApplication::setQtilitiesSettingsEnabled(bool is_enabled) {
     QtilitiesCoreApplicationPrivate::instance()->setQtilitiesSettingsEnabled(is_enabled);
     Log->setLoggerSettingsEnabled(is_enabled);
@@ -17,8 +17,10 @@
 #include "ContextManager.h"
 #include "VersionInformation.h"
 #include "TaskManager.h"
+#include "IdleScheduler.h"
 
 #include <Logger>
+#include <SettingsStore>
 
 #include <QList>
 #include <QString>
@@ -71,6 +73,13 @@ namespace Qtilities {
               This function is thread-safe.
               */
             static TaskManager* taskManager();
+            //! Returns a reference to the idle scheduler, which runs time sliced jobs when the application is idle.
+            /*!
+              Use the idle scheduler instead of QCoreApplication::processEvents() to keep long running work responsive. See IdleScheduler for more information.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static IdleScheduler* idleScheduler();
 
             //! Returns a reference to the QtilitiesCoreApplication instance.
             /*!
@@ -135,22 +144,34 @@ namespace Qtilities {
             /*!
               The path used points to a file called \p qtilities.ini in the path returned by applicationSessionPath().
 
-              Everywhere in %Qtilities this path is used as follows to save settings.
+              %Qtilities classes do not access this file directly, they use the settings store of the file returned by qtilitiesSettings().
+
+              By using this ini file, the %Qtilities settings are kept seperate from the rest of the settings used by your application. If you don't want
+              %Qtilities to save any information during runtime you can disable is using setQtilitiesSettingsEnabled().
+
+              \sa setQtilitiesSettingsEnabled(), qtilitiesSettingsEnabled()
+              */
+            static QString qtilitiesSettingsPath();
+            //! Returns the settings store of the file at qtilitiesSettingsPath().
+            /*!
+              Everywhere in %Qtilities settings are saved and loaded through this store as follows:
 
 \code
 if (!QtilitiesCoreApplication::qtilitiesSettingsEnabled())
     return;
 
-QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-// Some settings related code...
+SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+settings->setValue("Qtilities/GUI/MainWindow/geometry",saveGeometry());
 \endcode
 
-              By using this ini file, the %Qtilities settings are kept seperate from the rest of the settings used by your application. If you don't want
-              %Qtilities to save any information during runtime you can disable is using setQtilitiesSettingsEnabled().
+              The store reads the file once, after which settings are loaded from memory. Changes are saved to the file on a background thread, see
+              Qtilities::Logging::SettingsStore for more information.
 
-              \sa setQtilitiesSettingsEnabled(), qtilitiesSettingsEnabled()
+              \note The store returned belongs to the current qtilitiesSettingsPath(), thus a different store is returned after the session path was changed using setApplicationSessionPath().
+
+              <i>This function was added in %Qtilities v1.5.</i>
               */
-            static QString qtilitiesSettingsPath();
+            static Qtilities::Logging::SettingsStore* qtilitiesSettings();
             //! Enables/disables the saving of settings by %Qtilities classes.
             /*!
               By disabling the saving of settings by %Qtilities classes, you can make sure %Qtilities does not save any settings information anywhere on the host machine where a
@@ -207,5 +228,6 @@ QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::
 #define OBJECT_MANAGER static_cast<Qtilities::Core::QtilitiesCoreApplication *>(QCoreApplication::instance())->objectManager()
 #define CONTEXT_MANAGER static_cast<Qtilities::Core::QtilitiesCoreApplication *>(QCoreApplication::instance())->contextManager()
 #define TASK_MANAGER static_cast<Qtilities::Core::QtilitiesCoreApplication *>(QCoreApplication::instance())->taskManager()
+#define IDLE_SCHEDULER Qtilities::Core::QtilitiesCoreApplication::idleScheduler()
 
 #endif // QTILITIES_CORE_H
@@ -12,6 +12,9 @@
 #include "QtilitiesCoreApplication_p.h"
 #include "ObjectManager.h"
 #include "ContextManager.h"
+#include "IContext.h"
+#include "ITask.h"
+#include "StartupProfiler.h"
 #include "VersionInformation.h"
 
 #include <LoggingConstants>
@@ -40,6 +43,9 @@ Qtilities::Core::QtilitiesCoreApplicationPrivate* Qtilities::Core::QtilitiesCore
 }
 
 Qtilities::Core::QtilitiesCoreApplicationPrivate::QtilitiesCoreApplicationPrivate() {
+    // Startup spans are relative to the construction of the profiler, thus construct it as early as possible:
+    StartupProfiler::instance();
+
     // Object Manager
     d_objectManager = new ObjectManager;
     QObject* objectManagerQ = qobject_cast<QObject*> (d_objectManager);
@@ -49,12 +55,14 @@ Qtilities::Core::QtilitiesCoreApplicationPrivate::QtilitiesCoreApplicationPrivat
     d_contextManager = new ContextManager;
     QObject* contextManagerQ = qobject_cast<QObject*> (d_contextManager);
     d_contextManagerIFace = qobject_cast<IContextManager*> (contextManagerQ);
-    QObject::connect(d_objectManager,SIGNAL(newObjectAdded(QObject*)),d_contextManager,SLOT(addContexts(QObject*)));
+    d_objectManager->subscribeToInterface<IContext>(d_contextManager,SLOT(addContexts(QObject*)),0,false);
 
     // Task Manager
     d_taskManager = new TaskManager;
-    QObject::connect(d_objectManager,SIGNAL(newObjectAdded(QObject*)),d_taskManager,SLOT(addTask(QObject*)));
-    QObject::connect(d_objectManager,SIGNAL(objectRemoved(QObject*)),d_taskManager,SLOT(removeTask(QObject*)));
+    d_objectManager->subscribeToInterface<ITask>(d_taskManager,SLOT(addTask(QObject*)),SLOT(removeTask(QObject*)),false);
+
+    // Idle Scheduler
+    d_idleScheduler = new IdleScheduler;
 
     // Register QList<QPointer<QObject> > in Meta Object System.
     qRegisterMetaType<QList<QPointer<QObject> > >("QList<QPointer<QObject> >");
@@ -90,6 +98,10 @@ Qtilities::Core::Interfaces::TaskManager* Qtilities::Core::QtilitiesCoreApplicat
     return d_taskManager;
 }
 
+Qtilities::Core::IdleScheduler* Qtilities::Core::QtilitiesCoreApplicationPrivate::idleScheduler() const {
+    return d_idleScheduler;
+}
+
 QString Qtilities::Core::QtilitiesCoreApplicationPrivate::qtilitiesVersionString() const {
     QString version_string;
     if (qti_def_VERSION_BETA != 0)
@@ -47,6 +47,10 @@ namespace Qtilities {
             const char * const qti_def_FACTORY_TAG_OBSERVER                 = "qti.def.FactoryTag.Observer";
             //! %Factory tag for FileSetInfo.
             const char * const qti_def_FACTORY_TAG_FILE_SET_INFO            = "qti.def.FactoryTag.FileSetInfo";
+            //! %Factory tag for tree nodes, used by Qtilities::Core::HeadlessTreeNode and Qtilities::CoreGui::TreeNode. <i>This constant was moved from the CoreGui module in %Qtilities v1.5.</i>
+            const char * const qti_def_FACTORY_TAG_TREE_NODE                = "qti.def.FactoryTag.TreeNode";
+            //! %Factory tag for tree items, used by Qtilities::Core::HeadlessTreeItem and Qtilities::CoreGui::TreeItem. <i>This constant was moved from the CoreGui module in %Qtilities v1.5.</i>
+            const char * const qti_def_FACTORY_TAG_TREE_ITEM                = "qti.def.FactoryTag.TreeItem";
             //! %Factory tag for GenericProperty.
             const char * const qti_def_FACTORY_TAG_GENERIC_PROPERTY         = "qti.def.FactoryTag.GenericProperty";
             //! The QtilitiesCategory used by GenericProperty to group macros.
@@ -58,6 +62,8 @@ namespace Qtilities {
             const char * const qti_def_CONTEXT_STANDARD                     = "qti.def.Context.Standard";
             //! Mime type used by Qtilities::Core::ObserverMimeData.
             const char * const qti_def_OBSERVER_MIME_DATA_MIME_TYPE         = "application/vnd.qtilities.observer_mime_data";
+            //! Mime type of the binary export of the subjects in a Qtilities::Core::ObserverMimeData object.
+            const char * const qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE  = "application/vnd.qtilities.observer_mime_data.export";
         }
 
         //! Namespace containing reserved observer properties used inside the Core Module.
@@ -573,6 +579,27 @@ ObjectManager::setSharedProperty(obj, property);
 */
 const char * const qti_prop_FOREGROUND       = "qti.role.Foreground";
 
+//! Object Style Role Property
+/*!
+If an object has this property, the property's value is the id of an interned style record which provides the data
+of the Qt::DecorationRole, Qt::FontRole, Qt::ForegroundRole, Qt::BackgroundRole, Qt::TextAlignmentRole and Qt::SizeHintRole
+roles to observer item models. Objects which are formatted the same share a single style record, thus formatting large trees
+only costs a single property per object.
+
+This property is managed by Qtilities::CoreGui::AbstractTreeItem and must not be set directly. The role properties above
+can still be set directly, they are used for roles which the style of the object does not provide.
+
+<b>Permission:</b> Read<br>
+<b>Data Type:</b> int<br>
+<b>Property Type:</b> Qtilities::Core::SharedProperty<br>
+<b>Is Exportable:</b> No, style ids are only valid in the process which created them<br>
+<b>Change Notifications:</b> Yes<br>
+<b>Removable:</b> Yes
+
+<i>This property was added in %Qtilities v1.5.</i>
+*/
+const char * const qti_prop_STYLE            = "qti.role.Style";
+
         }
     }
 }
@@ -15,10 +15,19 @@
 #include <QDir>
 
 struct Qtilities::Core::QtilitiesFileInfoPrivateData {
-    QtilitiesFileInfoPrivateData() : relative_to_path(QString()) {}
+    QtilitiesFileInfoPrivateData() : relative_to_path(QString()),
+        actual_paths_valid(false) {}
 
     //! The relative to path of this file.
     QString relative_to_path;
+    //! Indicates if actual_path and actual_file_path are valid for relative_to_path and cached_file_path.
+    bool actual_paths_valid;
+    //! The filePath() for which actual_path and actual_file_path were determined.
+    QString cached_file_path;
+    //! The cached actualPath().
+    QString actual_path;
+    //! The cached actualFilePath().
+    QString actual_file_path;
 };
 
 Qtilities::Core::QtilitiesFileInfo::QtilitiesFileInfo(const QString& file, const QString& relative_to_path) : QFileInfo(file) {
@@ -28,7 +37,16 @@ Qtilities::Core::QtilitiesFileInfo::QtilitiesFileInfo(const QString& file, const
 
 Qtilities::Core::QtilitiesFileInfo::QtilitiesFileInfo(const QtilitiesFileInfo& ref) : QFileInfo(ref) {
     d = new QtilitiesFileInfoPrivateData;
-    d->relative_to_path = ref.relativeToPath();
+    *d = *ref.d;
+}
+
+Qtilities::Core::QtilitiesFileInfo& Qtilities::Core::QtilitiesFileInfo::operator=(const QtilitiesFileInfo& ref) {
+    if (this == &ref)
+        return *this;
+
+    QFileInfo::operator=(ref);
+    *d = *ref.d;
+    return *this;
 }
 
 bool Qtilities::Core::QtilitiesFileInfo::operator==(const Qtilities::Core::QtilitiesFileInfo &ref) const {
@@ -53,6 +71,7 @@ QString Qtilities::Core::QtilitiesFileInfo::relativeToPath() const {
 
 void Qtilities::Core::QtilitiesFileInfo::setRelativeToPath(const QString& relative_to_path) {
     d->relative_to_path = relative_to_path;
+    d->actual_paths_valid = false;
 }
 
 QString Qtilities::Core::QtilitiesFileInfo::absoluteToRelativePath() const {
@@ -74,25 +93,30 @@ void Qtilities::Core::QtilitiesFileInfo::setFileName(const QString& new_file_nam
 }
 
 QString Qtilities::Core::QtilitiesFileInfo::actualPath() const {
-    if (isAbsolute()) {
-        return path();
-    } else if (isRelative()) {
-        if (hasRelativeToPath())
-            return absoluteToRelativePath();
-    }
-
-    return path();
+    updateActualPaths();
+    return d->actual_path;
 }
 
 QString Qtilities::Core::QtilitiesFileInfo::actualFilePath() const {
-    if (isAbsolute()) {
-        return filePath();
-    } else if (isRelative()) {
-        if (hasRelativeToPath())
-            return absoluteToRelativeFilePath();
+    updateActualPaths();
+    return d->actual_file_path;
+}
+
+void Qtilities::Core::QtilitiesFileInfo::updateActualPaths() const {
+    // QFileInfo::setFile() is not virtual, thus changes to the file are detected by comparing filePath() against the cached file path:
+    const QString file_path = filePath();
+    if (d->actual_paths_valid && d->cached_file_path == file_path)
+        return;
+
+    if (isRelative() && hasRelativeToPath()) {
+        d->actual_path = absoluteToRelativePath();
+        d->actual_file_path = absoluteToRelativeFilePath();
+    } else {
+        d->actual_path = path();
+        d->actual_file_path = file_path;
     }
-
-    return filePath();
+    d->cached_file_path = file_path;
+    d->actual_paths_valid = true;
 }
 
 bool Qtilities::Core::QtilitiesFileInfo::compareActualFilePaths(const QtilitiesFileInfo& ref) const {   
@@ -156,6 +156,11 @@ completeSuffix:  "tar.gz"
               */
             QtilitiesFileInfo(const QString& file = QString(), const QString& relative_to_path = QString());
             QtilitiesFileInfo(const QtilitiesFileInfo& ref);
+            //! Assignment operator which copies the file as well as the relative to path.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QtilitiesFileInfo& operator=(const QtilitiesFileInfo& ref);
             //! Operator overload to compare two QtilitiesFileInfo objects with each other.
             /*!
               \note This overload does a comparison using the actualFilePath() paths of the two objects being compared.
@@ -223,6 +228,9 @@ completeSuffix:  "tar.gz"
               - If the file is relative with a relativeToPath() set, it will return absoluteToRelativeFilePath()
               - If the file is relative without a relativeToPath() set, it will just return filePath() as well.
 
+              \note From %Qtilities v1.5 onwards, actualPath() and actualFilePath() are determined using string operations only and are cached
+              until the file or relativeToPath() changes.
+
               \sa actualPath()
               */
             QString actualFilePath() const;
@@ -273,6 +281,9 @@ completeSuffix:  "tar.gz"
             }
 
         private:
+            //! Determines actualPath() and actualFilePath() when the file or relative to path changed since they were last determined.
+            void updateActualPaths() const;
+
             QtilitiesFileInfoPrivateData* d;
         };
     }
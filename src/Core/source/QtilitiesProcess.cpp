@@ -10,37 +10,690 @@
 ****************************************************************************/
 
 #include "QtilitiesProcess.h"
+#include "QtilitiesProcess_p.h"
+#include "QtilitiesCoreApplication.h"
 
+#include <QBasicTimer>
 #include <QCoreApplication>
+#include <QDebug>
 #include <FileUtils>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QPointer>
 #include <QRegExp>
+#include <QTemporaryFile>
+#include <QThread>
+#include <QTimer>
+#include <QTimerEvent>
+#include <QVector>
+#include <QWaitCondition>
 
 #include <Logger>
 #include <LoggerEngines.h>
 using namespace Qtilities::Logging;
 
+#include <limits.h>
+#include <string.h>
+
+// -----------------------------------------
+// ProcessBufferMessageClassifier
+// -----------------------------------------
+namespace {
+    //! The literals which a message must contain for the expression of a hint to match it.
+    struct CompiledProcessBufferMessageTypeHint {
+        //! A literal which the message must start with, empty when not known.
+        QString                 prefix;
+        //! A literal which the message must contain, empty when not known.
+        QString                 fragment;
+        Qt::CaseSensitivity     case_sensitivity;
+    };
+
+    CompiledProcessBufferMessageTypeHint compileProcessBufferMessageTypeHint(const QRegExp& regexp) {
+        CompiledProcessBufferMessageTypeHint compiled;
+        compiled.case_sensitivity = regexp.caseSensitivity();
+        const QString pattern = regexp.pattern();
+
+        if (regexp.patternSyntax() == QRegExp::FixedString) {
+            compiled.prefix = pattern;
+            compiled.fragment = pattern;
+        } else if (regexp.patternSyntax() == QRegExp::Wildcard || regexp.patternSyntax() == QRegExp::WildcardUnix) {
+            // Character sets and escapes are not analyzed, such hints are always evaluated:
+            if (pattern.contains('[') || pattern.contains('\\'))
+                return compiled;
+
+            QStringList fragments = pattern.split(QRegExp("[*?]"));
+            compiled.prefix = fragments.front();
+            for (int i = 0; i < fragments.count(); ++i) {
+                if (fragments.at(i).length() > compiled.fragment.length())
+                    compiled.fragment = fragments.at(i);
+            }
+        } else if (regexp.patternSyntax() == QRegExp::RegExp || regexp.patternSyntax() == QRegExp::RegExp2) {
+            // Alternations make the leading literal optional:
+            if (pattern.contains('|'))
+                return compiled;
+
+            static const QString meta_characters("\\^$.|?*+()[]{}");
+            int start = pattern.startsWith('^') ? 1 : 0;
+            int end = start;
+            while (end < pattern.length() && !meta_characters.contains(pattern.at(end)))
+                ++end;
+            // A quantifier applies to the last literal character, which can then be optional:
+            if (end < pattern.length() && end > start && QString("?*{").contains(pattern.at(end)))
+                --end;
+            compiled.prefix = pattern.mid(start,end - start);
+            compiled.fragment = compiled.prefix;
+        }
+
+        // Case insensitive literals are only used when they are ASCII, since QRegExp and QString do not fold all other characters the same way:
+        if (compiled.case_sensitivity == Qt::CaseInsensitive) {
+            const QString literals = compiled.prefix + compiled.fragment;
+            for (int i = 0; i < literals.length(); ++i) {
+                if (literals.at(i).unicode() > 127) {
+                    compiled.prefix.clear();
+                    compiled.fragment.clear();
+                    break;
+                }
+            }
+        }
+
+        return compiled;
+    }
+}
+
+struct Qtilities::Core::ProcessBufferMessageClassifierPrivateData {
+    ProcessBufferMessageClassifierPrivateData() : forward_unmatched(true) {}
+
+    QList<ProcessBufferMessageTypeHint>             hints;
+    QList<CompiledProcessBufferMessageTypeHint>     compiled_hints;
+    //! Hints without a prefix, they are evaluated for every message.
+    QList<int>                                      unindexed_hints;
+    //! Hints with a case sensitive prefix, indexed by the first character of the prefix.
+    QHash<ushort,QList<int> >                       case_sensitive_index;
+    //! Hints with a case insensitive prefix, indexed by the case folded first character of the prefix.
+    QHash<ushort,QList<int> >                       case_insensitive_index;
+    QList<ProcessBufferMessageTypeHint>             active_message_disablers;
+    //! Reused between messages to avoid allocations.
+    QVector<int>                                    candidates;
+    bool                                            forward_unmatched;
+};
+
+Qtilities::Core::ProcessBufferMessageClassifier::ProcessBufferMessageClassifier() {
+    d = new ProcessBufferMessageClassifierPrivateData;
+}
+
+Qtilities::Core::ProcessBufferMessageClassifier::~ProcessBufferMessageClassifier() {
+    delete d;
+}
+
+void Qtilities::Core::ProcessBufferMessageClassifier::setHints(const QList<ProcessBufferMessageTypeHint>& hints) {
+    d->hints.clear();
+    d->compiled_hints.clear();
+    d->unindexed_hints.clear();
+    d->case_sensitive_index.clear();
+    d->case_insensitive_index.clear();
+
+    for (int i = 0; i < hints.count(); ++i) {
+        // Every QRegExp is copied instead of sharing the list, thus classifiers can be used in different threads:
+        d->hints.append(ProcessBufferMessageTypeHint(hints.at(i)));
+        CompiledProcessBufferMessageTypeHint compiled = compileProcessBufferMessageTypeHint(hints.at(i).d_regexp);
+        d->compiled_hints << compiled;
+
+        if (compiled.prefix.isEmpty())
+            d->unindexed_hints << i;
+        else if (compiled.case_sensitivity == Qt::CaseSensitive)
+            d->case_sensitive_index[compiled.prefix.at(0).unicode()] << i;
+        else
+            d->case_insensitive_index[compiled.prefix.at(0).toCaseFolded().unicode()] << i;
+    }
+
+    resetState();
+}
+
+QList<Qtilities::Core::ProcessBufferMessageTypeHint> Qtilities::Core::ProcessBufferMessageClassifier::hints() const {
+    return d->hints;
+}
+
+QList<int> Qtilities::Core::ProcessBufferMessageClassifier::matchingHints(const QString& buffer_message) {
+    // Get the hints of which the prefix can match the message, in the order in which the hints were set:
+    d->candidates.clear();
+    for (int i = 0; i < d->unindexed_hints.count(); ++i)
+        d->candidates << d->unindexed_hints.at(i);
+    if (!buffer_message.isEmpty()) {
+        const QChar first = buffer_message.at(0);
+        QHash<ushort,QList<int> >::const_iterator itr = d->case_sensitive_index.constFind(first.unicode());
+        if (itr != d->case_sensitive_index.constEnd()) {
+            for (int i = 0; i < itr.value().count(); ++i)
+                d->candidates << itr.value().at(i);
+        }
+        itr = d->case_insensitive_index.constFind(first.toCaseFolded().unicode());
+        if (itr != d->case_insensitive_index.constEnd()) {
+            for (int i = 0; i < itr.value().count(); ++i)
+                d->candidates << itr.value().at(i);
+        }
+    }
+    qSort(d->candidates);
+
+    QList<int> matching_hints;
+    int highest_matching_hint_priority = -1;
+    for (int c = 0; c < d->candidates.count(); ++c) {
+        const int i = d->candidates.at(c);
+        const CompiledProcessBufferMessageTypeHint& compiled = d->compiled_hints.at(i);
+        if (!compiled.prefix.isEmpty() && !buffer_message.startsWith(compiled.prefix,compiled.case_sensitivity))
+            continue;
+        if (!compiled.fragment.isEmpty() && buffer_message.indexOf(compiled.fragment,0,compiled.case_sensitivity) == -1)
+            continue;
+
+        const ProcessBufferMessageTypeHint& hint = d->hints.at(i);
+        if (hint.d_priority < highest_matching_hint_priority)
+            continue;
+        if (hint.d_regexp.exactMatch(buffer_message)) {
+            if (hint.d_priority > highest_matching_hint_priority) {
+                highest_matching_hint_priority = hint.d_priority;
+                matching_hints.clear();
+            }
+            matching_hints << i;
+        }
+    }
+
+    return matching_hints;
+}
+
+bool Qtilities::Core::ProcessBufferMessageClassifier::classify(const QString& buffer_message, Logger::MessageType msg_type, QList<QPair<QString,Logger::MessageType> >& log_messages) {
+    if (d->hints.isEmpty()) {
+        if (d->forward_unmatched)
+            log_messages << qMakePair(buffer_message,msg_type);
+        return false;
+    }
+
+    bool found_match_is_stopper = false;
+
+    // Log the message using all hints that match with the highest priority:
+    QList<int> matching_hints = matchingHints(buffer_message);
+    for (int i = 0; i < matching_hints.count(); ++i) {
+        const ProcessBufferMessageTypeHint& hint = d->hints.at(matching_hints.at(i));
+        bool log_this_message = d->active_message_disablers.isEmpty();
+        if (hint.d_is_enabler) {
+            if (!d->active_message_disablers.isEmpty())
+                d->active_message_disablers.pop_front();
+            log_this_message = d->active_message_disablers.isEmpty();
+        } else if (hint.d_is_disabler) {
+            d->active_message_disablers.push_front(hint);
+            // Note that we don't set log_this_message. The disabler message must also be logged.
+        }
+
+        // If log_this_message=false, one or more disabler is active.
+        // We need to now check the d_disabled_unblocked_message_types of all active disablers against hint.d_message_type
+        // to see if this type is unblocked while disabled:
+        if (!log_this_message) {
+            bool is_unblocked = true;
+            foreach (const ProcessBufferMessageTypeHint& disabler_hint, d->active_message_disablers) {
+                if (!(disabler_hint.d_disabled_unblocked_message_types & hint.d_message_type)) {
+                    is_unblocked = false;
+                    break;
+                }
+            }
+            if (is_unblocked)
+                log_this_message = true;
+        }
+
+        if (hint.d_is_stopper)
+            found_match_is_stopper = true;
+
+        if (hint.d_message_type != Logger::None && log_this_message) {
+            log_messages << qMakePair(buffer_message,hint.d_message_type);
+            if (hint.d_is_stopper && !hint.d_stop_message.isEmpty())
+                log_messages << qMakePair(hint.d_stop_message,hint.d_stop_message_type);
+        }
+    }
+
+    if (found_match_is_stopper)
+        return true;
+
+    if (matching_hints.isEmpty() && d->forward_unmatched) {
+        if (d->active_message_disablers.isEmpty()) {
+            log_messages << qMakePair(buffer_message,msg_type);
+        } else {
+            bool is_unblocked = true;
+            foreach (const ProcessBufferMessageTypeHint& disabler_hint, d->active_message_disablers) {
+                if (!(disabler_hint.d_disabled_unblocked_message_types & msg_type)) {
+                    is_unblocked = false;
+                    break;
+                }
+            }
+            if (is_unblocked)
+                log_messages << qMakePair(buffer_message,msg_type);
+        }
+    }
+
+    return false;
+}
+
+void Qtilities::Core::ProcessBufferMessageClassifier::setForwardUnmatchedMessages(bool forward_unmatched) {
+    d->forward_unmatched = forward_unmatched;
+}
+
+bool Qtilities::Core::ProcessBufferMessageClassifier::forwardUnmatchedMessages() const {
+    return d->forward_unmatched;
+}
+
+void Qtilities::Core::ProcessBufferMessageClassifier::resetState() {
+    d->active_message_disablers.clear();
+}
+
+namespace Qtilities {
+    namespace Core {
+        typedef QList<QPair<QString,Logger::MessageType> > ProcessBufferMessageList;
+
+        // Worker thread used by QtilitiesProcess when setBackgroundBufferProcessingEnabled() is enabled, or when raw output is captured. It writes
+        // the data read from the backend process to the capture file and splits it into lines which it classifies, after which the process logs
+        // the results in batches in its own thread.
+        class QtilitiesProcessBufferWorker : public QThread
+        {
+        public:
+            QtilitiesProcessBufferWorker(QObject* receiver) : QThread(),
+                receiver(receiver),
+                generation(0),
+                reset_requested(false),
+                pending_classify_lines(true),
+                finish_requested(false),
+                stop_requested(false),
+                stopper_matched(false),
+                result_stopper(false),
+                result_finished(false),
+                notify_pending(false),
+                classify_lines(true) {}
+
+            //! Prepares the worker for a new run of the process, data of the previous run which was not processed yet is discarded.
+            /*!
+              When \p capture_file_name is not empty, the data is written to that file and only lines which match a hint are logged.
+              When \p classify is false, the data is not split into lines at all.
+              */
+            void reset(const QList<ProcessBufferMessageTypeHint>& new_hints, const QString& capture_file_name, bool classify) {
+                QMutexLocker locker(&mutex);
+                ++generation;
+                // The hints are compiled in the worker thread, the classifier copies every QRegExp:
+                pending_hints = new_hints;
+                pending_capture_file_name = capture_file_name;
+                pending_classify_lines = classify;
+                reset_requested = true;
+                finish_requested = false;
+                stopper_matched = false;
+                queued_chunks.clear();
+                queued_channels.clear();
+                result_messages.clear();
+                result_errors.clear();
+                result_stopper = false;
+                result_finished = false;
+                locker.unlock();
+
+                if (!isRunning())
+                    start();
+            }
+            //! Queues data read from a channel of the process.
+            void enqueue(const QByteArray& data, QProcess::ProcessChannel channel) {
+                QMutexLocker locker(&mutex);
+                if (stopper_matched)
+                    return;
+                queued_chunks << data;
+                queued_channels << channel;
+                queue_not_empty.wakeOne();
+            }
+            //! Indicates that the process finished, thus incomplete lines must be processed as well.
+            void finish() {
+                QMutexLocker locker(&mutex);
+                finish_requested = true;
+                queue_not_empty.wakeOne();
+            }
+            //! Takes the results which are available.
+            void takeResults(ProcessBufferMessageList* messages, QStringList* errors, bool* stopper, bool* finished) {
+                QMutexLocker locker(&mutex);
+                messages->swap(result_messages);
+                errors->swap(result_errors);
+                *stopper = result_stopper;
+                *finished = result_finished;
+                result_stopper = false;
+                result_finished = false;
+                notify_pending = false;
+            }
+            //! Stops the worker thread, unprocessed data is discarded.
+            void stop() {
+                mutex.lock();
+                stop_requested = true;
+                queue_not_empty.wakeOne();
+                mutex.unlock();
+                wait();
+            }
+
+        protected:
+            void run() {
+                QList<QByteArray> chunks;
+                QList<int> channels;
+                QMutexLocker locker(&mutex);
+                forever {
+                    while (queued_chunks.isEmpty() && !finish_requested && !stop_requested)
+                        queue_not_empty.wait(&mutex);
+                    if (stop_requested)
+                        break;
+
+                    bool open_capture_file = false;
+                    QString capture_file_name;
+                    if (reset_requested) {
+                        classifier.setHints(pending_hints);
+                        classifier.setForwardUnmatchedMessages(pending_capture_file_name.isEmpty());
+                        classify_lines = pending_classify_lines;
+                        remainders[0].clear();
+                        remainders[1].clear();
+                        open_capture_file = true;
+                        capture_file_name = pending_capture_file_name;
+                        reset_requested = false;
+                    }
+                    chunks.swap(queued_chunks);
+                    channels.swap(queued_channels);
+                    const bool is_final = finish_requested;
+                    finish_requested = false;
+                    const int chunks_generation = generation;
+                    // Nothing is processed after a stopper matched:
+                    bool matched_stopper = stopper_matched;
+                    locker.unlock();
+
+                    QStringList errors;
+                    if (open_capture_file) {
+                        capture_file.close();
+                        if (!capture_file_name.isEmpty()) {
+                            capture_file.setFileName(capture_file_name);
+                            // The chunks are large, thus they are written as they are without copying them into the buffer of the file:
+                            if (!capture_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered))
+                                errors << QString("Failed to open raw output capture file \"%1\": %2").arg(capture_file_name).arg(capture_file.errorString());
+                        }
+                    }
+                    if (capture_file.isOpen()) {
+                        for (int i = 0; i < chunks.count(); ++i) {
+                            if (capture_file.write(chunks.at(i)) != chunks.at(i).size()) {
+                                errors << QString("Failed to write to raw output capture file \"%1\", capturing stopped: %2").arg(capture_file.fileName()).arg(capture_file.errorString());
+                                capture_file.close();
+                                break;
+                            }
+                        }
+                    }
+
+                    ProcessBufferMessageList messages;
+                    if (classify_lines) {
+                        for (int i = 0; i < chunks.count() && !matched_stopper; ++i)
+                            matched_stopper = processChunk(chunks.at(i),channels.at(i),messages);
+                    }
+                    if (is_final) {
+                        for (int c = 0; c < 2 && !matched_stopper && classify_lines; ++c) {
+                            if (!remainders[c].isEmpty())
+                                matched_stopper = processLine(remainders[c].constData(),remainders[c].size(),c,messages);
+                        }
+                        remainders[0].clear();
+                        remainders[1].clear();
+                        capture_file.close();
+                    }
+                    chunks.clear();
+                    channels.clear();
+
+                    locker.relock();
+                    // Results of a previous run of the process are discarded:
+                    if (chunks_generation != generation)
+                        continue;
+
+                    result_messages << messages;
+                    result_errors << errors;
+                    if (matched_stopper && !stopper_matched) {
+                        stopper_matched = true;
+                        result_stopper = true;
+                        queued_chunks.clear();
+                        queued_channels.clear();
+                    }
+                    if (is_final)
+                        result_finished = true;
+                    if (!notify_pending && (!result_messages.isEmpty() || !result_errors.isEmpty() || result_stopper || result_finished)) {
+                        notify_pending = true;
+                        QMetaObject::invokeMethod(receiver,"handleProcessedBufferMessages",Qt::QueuedConnection);
+                    }
+                }
+                capture_file.close();
+            }
+
+        private:
+            //! Splits a chunk into lines, returns true when a stopper matched.
+            bool processChunk(const QByteArray& data, int channel, ProcessBufferMessageList& messages) {
+                QByteArray& remainder = remainders[channel];
+                const char* line_start = data.constData();
+                const char* end = line_start + data.size();
+                while (line_start < end) {
+                    const char* line_end = (const char*) memchr(line_start,'\n',end - line_start);
+                    if (!line_end)
+                        break;
+
+                    bool matched_stopper;
+                    if (remainder.isEmpty())
+                        matched_stopper = processLine(line_start,line_end - line_start,channel,messages);
+                    else {
+                        // The line started in a previous chunk:
+                        remainder.append(line_start,line_end - line_start);
+                        matched_stopper = processLine(remainder.constData(),remainder.size(),channel,messages);
+                        remainder.clear();
+                    }
+                    if (matched_stopper)
+                        return true;
+                    line_start = line_end + 1;
+                }
+
+                if (line_start < end)
+                    remainder.append(line_start,end - line_start);
+                return false;
+            }
+            bool processLine(const char* line, int length, int channel, ProcessBufferMessageList& messages) {
+                if (length > 0 && line[length - 1] == '\r')
+                    --length;
+                return classifier.classify(QString::fromUtf8(line,length),channel == QProcess::StandardError ? Logger::Error : Logger::Info,messages);
+            }
+
+            QObject*                                receiver;
+            QMutex                                  mutex;
+            QWaitCondition                          queue_not_empty;
+            int                                     generation;
+            bool                                    reset_requested;
+            QString                                 pending_capture_file_name;
+            bool                                    pending_classify_lines;
+            bool                                    finish_requested;
+            bool                                    stop_requested;
+            bool                                    stopper_matched;
+            QList<ProcessBufferMessageTypeHint>     pending_hints;
+            QList<QByteArray>                       queued_chunks;
+            QList<int>                              queued_channels;
+            ProcessBufferMessageList                result_messages;
+            QStringList                             result_errors;
+            bool                                    result_stopper;
+            bool                                    result_finished;
+            bool                                    notify_pending;
+
+            // Only used in the worker thread:
+            ProcessBufferMessageClassifier          classifier;
+            QByteArray                              remainders[2];
+            bool                                    classify_lines;
+            QFile                                   capture_file;
+        };
+    }
+}
+
+namespace Qtilities {
+    namespace Core {
+        // Read only view on a QtilitiesProcessLastRunBuffer, which shows the buffer as it was when the view was created.
+        class QtilitiesProcessLastRunBufferDevice : public QIODevice
+        {
+        public:
+            QtilitiesProcessLastRunBufferDevice(const QtilitiesProcessLastRunBuffer& buffer, QObject* parent) : QIODevice(parent),
+                chunks(buffer.chunks),
+                spilled_size(0) {
+                if (buffer.spill_file && buffer.spilled_size > 0) {
+                    spill_file.setFileName(buffer.spill_file->fileName());
+                    if (spill_file.open(QIODevice::ReadOnly))
+                        spilled_size = buffer.spilled_size;
+                }
+                qint64 start = spilled_size;
+                for (int i = 0; i < chunks.count(); ++i) {
+                    chunk_starts << start;
+                    start += chunks.at(i).size();
+                }
+                total_size = start;
+                open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+            }
+
+            bool isSequential() const {
+                return false;
+            }
+            qint64 size() const {
+                return total_size;
+            }
+
+        protected:
+            qint64 readData(char* data, qint64 maxlen) {
+                qint64 position = pos();
+                qint64 read = 0;
+                if (position < spilled_size) {
+                    if (!spill_file.seek(position))
+                        return -1;
+                    qint64 spill_read = spill_file.read(data,qMin(maxlen,spilled_size - position));
+                    if (spill_read < 0)
+                        return -1;
+                    read += spill_read;
+                    position += spill_read;
+                    if (position < spilled_size)
+                        return read;
+                }
+
+                // Find the chunk which contains the position:
+                int index = 0;
+                while (index + 1 < chunk_starts.count() && chunk_starts.at(index + 1) <= position)
+                    ++index;
+                while (read < maxlen && index < chunks.count()) {
+                    const qint64 offset = position - chunk_starts.at(index);
+                    const qint64 available = chunks.at(index).size() - offset;
+                    if (available > 0) {
+                        const qint64 length = qMin(available,maxlen - read);
+                        memcpy(data + read,chunks.at(index).constData() + offset,length);
+                        read += length;
+                        position += length;
+                    }
+                    ++index;
+                }
+                return read;
+            }
+            qint64 writeData(const char* data, qint64 len) {
+                Q_UNUSED(data)
+                Q_UNUSED(len)
+                return -1;
+            }
+
+        private:
+            QList<QByteArray>   chunks;
+            QList<qint64>       chunk_starts;
+            QFile               spill_file;
+            qint64              spilled_size;
+            qint64              total_size;
+        };
+    }
+}
+
+namespace {
+    //! Kills terminated processes once their timeouts expired, using a single timer for all processes.
+    /*!
+      The deadlines are kept ordered in a map and the timer only runs while deadlines are pending. Deadlines are checked at a fixed
+      resolution, thus a process can be killed up to one resolution period after its timeout expired.
+      */
+    class QtilitiesProcessKillScheduler : public QObject
+    {
+    public:
+        //! The scheduler of the application, which lives in the main thread. Null when there is no application.
+        static QtilitiesProcessKillScheduler* instance() {
+            static QPointer<QtilitiesProcessKillScheduler> scheduler;
+            if (!scheduler && QCoreApplication::instance())
+                scheduler = new QtilitiesProcessKillScheduler(QCoreApplication::instance());
+            return scheduler;
+        }
+
+        void schedule(QObject* process, int msecs) {
+            if (!clock.isValid())
+                clock.start();
+            deadlines.insertMulti(clock.elapsed() + msecs,QPointer<QObject>(process));
+            if (!timer.isActive())
+                timer.start(50,this);
+        }
+
+    protected:
+        void timerEvent(QTimerEvent* event) {
+            if (event->timerId() != timer.timerId()) {
+                QObject::timerEvent(event);
+                return;
+            }
+
+            const qint64 now = clock.elapsed();
+            while (!deadlines.isEmpty() && deadlines.begin().key() <= now) {
+                QPointer<QObject> process = deadlines.begin().value();
+                deadlines.erase(deadlines.begin());
+                if (process)
+                    QMetaObject::invokeMethod(process,"killTerminatedProcess",Qt::DirectConnection);
+            }
+            if (deadlines.isEmpty())
+                timer.stop();
+        }
+
+    private:
+        QtilitiesProcessKillScheduler(QObject* parent) : QObject(parent) {}
+
+        QBasicTimer                         timer;
+        QElapsedTimer                       clock;
+        QMap<qint64,QPointer<QObject> >     deadlines;
+    };
+}
+
 struct Qtilities::Core::QtilitiesProcessPrivateData {
     QtilitiesProcessPrivateData() : process(0),
         read_process_buffers(false),
         last_run_buffer_enabled(false),
         process_info_messages_enabled(true),
-        ignore_read_buffer_slot(false),
         refresh_frequency(0),
         timeout(-1),
-        was_stopped(false) {}
+        terminate_timeout(0),
+        was_stopped(false),
+        classifier_outdated(false),
+        background_processing_enabled(false),
+        buffer_worker(0),
+        buffer_worker_active(false),
+        waiting_for_buffer_worker(false),
+        finished_exit_code(0),
+        finished_exit_status(QProcess::NormalExit) {}
 
     QProcess* process;
     QString default_qprocess_error_string;
     QList<ProcessBufferMessageTypeHint> buffer_message_type_hints;
     bool read_process_buffers;
-    QByteArray last_run_buffer;
+    QtilitiesProcessLastRunBuffer last_run_buffer;
     bool last_run_buffer_enabled;
     bool process_info_messages_enabled;
-    QList<ProcessBufferMessageTypeHint> active_message_disablers;
-    bool ignore_read_buffer_slot;
+    ProcessBufferMessageClassifier classifier;
+    //! Indicates if the hints changed since they were set on the classifier.
+    bool classifier_outdated;
     int refresh_frequency;
     int timeout;
+    int terminate_timeout;
     bool was_stopped;
+    bool background_processing_enabled;
+    QString raw_capture_file;
+    QtilitiesProcessBufferWorker* buffer_worker;
+    //! Indicates if the buffers of the current run are processed by buffer_worker.
+    bool buffer_worker_active;
+    bool waiting_for_buffer_worker;
+    int finished_exit_code;
+    QProcess::ExitStatus finished_exit_status;
 };
 
 Qtilities::Core::QtilitiesProcess::QtilitiesProcess(const QString& task_name,
@@ -72,6 +725,11 @@ Qtilities::Core::QtilitiesProcess::QtilitiesProcess(const QString& task_name,
 }
 
 Qtilities::Core::QtilitiesProcess::~QtilitiesProcess() {
+    if (d->buffer_worker) {
+        d->buffer_worker->stop();
+        delete d->buffer_worker;
+        d->buffer_worker = 0;
+    }
     if (d->process) {
         if (state() == ITask::TaskBusy)
             completeTask();
@@ -87,6 +745,7 @@ QProcess* Qtilities::Core::QtilitiesProcess::process() {
 
 void Qtilities::Core::QtilitiesProcess::addProcessBufferMessageTypeHint(ProcessBufferMessageTypeHint hint) {
     d->buffer_message_type_hints.append(hint);
+    d->classifier_outdated = true;
 }
 
 void Qtilities::Core::QtilitiesProcess::setProcessInfoMessagesEnabled(bool is_enabled) {
@@ -106,7 +765,45 @@ bool Qtilities::Core::QtilitiesProcess::lastRunBufferEnabled() const {
 }
 
 QByteArray Qtilities::Core::QtilitiesProcess::lastRunBuffer() const {
-    return d->last_run_buffer;
+    return d->last_run_buffer.toByteArray();
+}
+
+QList<QByteArray> Qtilities::Core::QtilitiesProcess::lastRunBufferChunks() const {
+    return d->last_run_buffer.chunks;
+}
+
+QIODevice* Qtilities::Core::QtilitiesProcess::lastRunBufferDevice(QObject* parent) const {
+    return new QtilitiesProcessLastRunBufferDevice(d->last_run_buffer,parent);
+}
+
+qint64 Qtilities::Core::QtilitiesProcess::lastRunBufferSize() const {
+    return d->last_run_buffer.totalSize();
+}
+
+void Qtilities::Core::QtilitiesProcess::setLastRunBufferMaximumSize(qint64 maximum_size) {
+    d->last_run_buffer.maximum_size = qMax((qint64) 0,maximum_size);
+    d->last_run_buffer.enforceLimits();
+}
+
+qint64 Qtilities::Core::QtilitiesProcess::lastRunBufferMaximumSize() const {
+    return d->last_run_buffer.maximum_size;
+}
+
+void Qtilities::Core::QtilitiesProcess::setLastRunBufferMaximumLineCount(qint64 maximum_line_count) {
+    d->last_run_buffer.maximum_line_count = qMax((qint64) 0,maximum_line_count);
+    d->last_run_buffer.enforceLimits();
+}
+
+qint64 Qtilities::Core::QtilitiesProcess::lastRunBufferMaximumLineCount() const {
+    return d->last_run_buffer.maximum_line_count;
+}
+
+void Qtilities::Core::QtilitiesProcess::setLastRunBufferSpillEnabled(bool is_enabled) {
+    d->last_run_buffer.spill_enabled = is_enabled;
+}
+
+bool Qtilities::Core::QtilitiesProcess::lastRunBufferSpillEnabled() const {
+    return d->last_run_buffer.spill_enabled;
 }
 
 void Qtilities::Core::QtilitiesProcess::clearLastRunBuffer() {
@@ -116,7 +813,7 @@ void Qtilities::Core::QtilitiesProcess::clearLastRunBuffer() {
 void Qtilities::Core::QtilitiesProcess::manualAppendLastRunBuffer() {
     if (d->last_run_buffer_enabled)  {
         while (d->process->canReadLine())
-            d->last_run_buffer.append(d->process->readLine().constData());
+            d->last_run_buffer.append(d->process->readLine());
     }
 }
 
@@ -159,9 +856,22 @@ bool Qtilities::Core::QtilitiesProcess::startProcess(const QString& program,
         logMessage("");
     }
 
-    d->active_message_disablers.clear();
+    if (d->classifier_outdated) {
+        d->classifier.setHints(d->buffer_message_type_hints);
+        d->classifier_outdated = false;
+    } else
+        d->classifier.resetState();
     clearLastRunBuffer();
     d->was_stopped = false;
+    d->waiting_for_buffer_worker = false;
+    d->buffer_worker_active = d->read_process_buffers && ((d->background_processing_enabled && loggingEnabled()) || !d->raw_capture_file.isEmpty());
+    if (d->buffer_worker_active) {
+        if (!d->buffer_worker)
+            d->buffer_worker = new QtilitiesProcessBufferWorker(this);
+        // While capturing, lines only have to be classified when hints can forward them to the log:
+        bool classify_lines = loggingEnabled() && (d->raw_capture_file.isEmpty() || !d->buffer_message_type_hints.isEmpty());
+        d->buffer_worker->reset(d->buffer_message_type_hints,d->raw_capture_file,classify_lines);
+    }
     d->process->start(native_program, arguments, mode);
 
     if (!d->process->waitForStarted(wait_for_started_msecs)) {
@@ -235,6 +945,14 @@ AbstractLoggerEngine* Qtilities::Core::QtilitiesProcess::assignFileLoggerEngineT
     return engine;
 }
 
+void Qtilities::Core::QtilitiesProcess::setRawOutputCaptureFile(const QString& file_path) {
+    d->raw_capture_file = file_path;
+}
+
+QString Qtilities::Core::QtilitiesProcess::rawOutputCaptureFile() const {
+    return d->raw_capture_file;
+}
+
 bool Qtilities::Core::QtilitiesProcess::processBackendProcessBuffersEnabled() const {
     return d->read_process_buffers;
 }
@@ -247,7 +965,35 @@ int Qtilities::Core::QtilitiesProcess::guiRefreshFrequency() const {
     return d->refresh_frequency;
 }
 
+void Qtilities::Core::QtilitiesProcess::setBackgroundBufferProcessingEnabled(bool is_enabled) {
+    d->background_processing_enabled = is_enabled;
+}
+
+bool Qtilities::Core::QtilitiesProcess::backgroundBufferProcessingEnabled() const {
+    return d->background_processing_enabled;
+}
+
+void Qtilities::Core::QtilitiesProcess::setTerminateTimeout(int msecs) {
+    d->terminate_timeout = qMax(0,msecs);
+}
+
+int Qtilities::Core::QtilitiesProcess::terminateTimeout() const {
+    return d->terminate_timeout;
+}
+
+void Qtilities::Core::QtilitiesProcess::stopProcesses(const QList<QtilitiesProcess*>& processes, int kill_timeout_msecs) {
+    for (int i = 0; i < processes.count(); ++i) {
+        if (processes.at(i))
+            processes.at(i)->terminateProcess(kill_timeout_msecs);
+    }
+}
+
 void Qtilities::Core::QtilitiesProcess::stopProcess() {
+    if (d->terminate_timeout > 0) {
+        terminateProcess(d->terminate_timeout);
+        return;
+    }
+
     d->was_stopped = true;
 
     // New implementation:
@@ -265,9 +1011,48 @@ void Qtilities::Core::QtilitiesProcess::stopProcess() {
 //        completeTask();
 }
 
+void Qtilities::Core::QtilitiesProcess::terminateProcess(int kill_timeout_msecs) {
+    d->was_stopped = true;
+    if (d->process->state() == QProcess::NotRunning)
+        return;
+
+    d->process->terminate();
+    if (kill_timeout_msecs <= 0) {
+        d->process->kill();
+        return;
+    }
+
+    // The process is stopped in procFinished() once it exited:
+    QtilitiesProcessKillScheduler* scheduler = QtilitiesProcessKillScheduler::instance();
+    if (scheduler && scheduler->thread() == QThread::currentThread())
+        scheduler->schedule(this,kill_timeout_msecs);
+    else
+        QTimer::singleShot(kill_timeout_msecs,this,SLOT(killTerminatedProcess()));
+}
+
+void Qtilities::Core::QtilitiesProcess::killTerminatedProcess() {
+    if (!d->was_stopped || d->process->state() == QProcess::NotRunning)
+        return;
+
+    if (d->process_info_messages_enabled)
+        logWarning(QString("Process %1 did not exit after it was terminated, it will be killed.").arg(taskName()));
+    d->process->kill();
+}
+
 void Qtilities::Core::QtilitiesProcess::procFinished(int exit_code, QProcess::ExitStatus exit_status) {
+    if (d->buffer_worker_active && !d->was_stopped) {
+        // Queue whatever is left in the process buffers, the task is completed when the worker processed everything:
+        readStandardOutput();
+        readStandardError();
+        d->finished_exit_code = exit_code;
+        d->finished_exit_status = exit_status;
+        d->waiting_for_buffer_worker = true;
+        d->buffer_worker->finish();
+        return;
+    }
+
     // Read whatever is in left in the process buffer:
-    if (d->read_process_buffers && !d->was_stopped) {
+    if (d->read_process_buffers && !d->was_stopped && !d->buffer_worker_active) {
         QString msg = d->process->readAllStandardOutput();
         if (!msg.isEmpty()) {
             QStringList splits = msg.split("\n");
@@ -292,6 +1077,14 @@ void Qtilities::Core::QtilitiesProcess::procFinished(int exit_code, QProcess::Ex
         }
     }
 
+    // Lets the worker close the capture file of a stopped process:
+    if (d->buffer_worker_active)
+        d->buffer_worker->finish();
+
+    completeProcess(exit_code,exit_status);
+}
+
+void Qtilities::Core::QtilitiesProcess::completeProcess(int exit_code, QProcess::ExitStatus exit_status) {
     if (exit_code != 0) {
         if (d->process_info_messages_enabled && !d->was_stopped) {
             QString error_string = d->process->errorString();
@@ -365,9 +1158,46 @@ void Qtilities::Core::QtilitiesProcess::stopTimedOut() {
     stop();
 }
 
+void Qtilities::Core::QtilitiesProcess::handleProcessedBufferMessages() {
+    if (!d->buffer_worker)
+        return;
+
+    ProcessBufferMessageList messages;
+    QStringList errors;
+    bool stopper_matched;
+    bool finished;
+    d->buffer_worker->takeResults(&messages,&errors,&stopper_matched,&finished);
+
+    for (int i = 0; i < errors.count(); ++i)
+        logError(errors.at(i));
+
+    if (!d->was_stopped) {
+        for (int i = 0; i < messages.count(); ++i)
+            logMessage(messages.at(i).first,messages.at(i).second);
+        if (stopper_matched) {
+            d->was_stopped = true;
+            stopProcess();
+        }
+    }
+
+    if (finished && d->waiting_for_buffer_worker) {
+        d->waiting_for_buffer_worker = false;
+        completeProcess(d->finished_exit_code,d->finished_exit_status);
+    }
+}
+
 void Qtilities::Core::QtilitiesProcess::readStandardOutput() {
-    if (d->ignore_read_buffer_slot)
+    if (d->buffer_worker_active) {
+        // Read everything that is available in one chunk, it is processed by the buffer worker:
+        QByteArray data = d->process->readAllStandardOutput();
+        if (data.isEmpty())
+            return;
+        if (d->last_run_buffer_enabled)
+            d->last_run_buffer.append(data);
+        if ((state() & TaskBusy) && !d->was_stopped)
+            d->buffer_worker->enqueue(data,QProcess::StandardOutput);
         return;
+    }
 
     int msg_count = 0;
     while (d->process->canReadLine()) {
@@ -376,14 +1206,11 @@ void Qtilities::Core::QtilitiesProcess::readStandardOutput() {
         if (d->was_stopped)
             break;
 
-        if (d->refresh_frequency > 0)
-            ++msg_count;
-        if (msg_count > d->refresh_frequency) {
-            msg_count = 0;
-            // To keep GUI applications responsive in case the backend process dumps tons of data for us.
-            d->ignore_read_buffer_slot = true;
-            QCoreApplication::processEvents(QEventLoop::ExcludeSocketNotifiers);
-            d->ignore_read_buffer_slot = false;
+        if (d->refresh_frequency > 0 && ++msg_count > d->refresh_frequency) {
+            // To keep GUI applications responsive in case the backend process dumps tons of data for us, the rest of the
+            // buffer is read in the next idle slice. Whatever is left when the process finishes is read in procFinished():
+            IDLE_SCHEDULER->scheduleInvoke(this,"readStandardOutput",IdleScheduler::HighPriority);
+            return;
         }
 
         QByteArray ba = d->process->readLine();
@@ -394,8 +1221,16 @@ void Qtilities::Core::QtilitiesProcess::readStandardOutput() {
 }
 
 void Qtilities::Core::QtilitiesProcess::readStandardError() {
-    if (d->ignore_read_buffer_slot)
+    if (d->buffer_worker_active) {
+        QByteArray data = d->process->readAllStandardError();
+        if (data.isEmpty())
+            return;
+        if (d->last_run_buffer_enabled)
+            d->last_run_buffer.append(data);
+        if ((state() & TaskBusy) && !d->was_stopped)
+            d->buffer_worker->enqueue(data,QProcess::StandardError);
         return;
+    }
 
     int msg_count = 0;
     while (d->process->canReadLine()) {
@@ -404,14 +1239,11 @@ void Qtilities::Core::QtilitiesProcess::readStandardError() {
         if (d->was_stopped)
             break;
 
-        if (d->refresh_frequency > 0)
-            ++msg_count;
-        if (msg_count > d->refresh_frequency) {
-            msg_count = 0;
-            // To keep GUI applications responsive in case the backend process dumps tons of data for us.
-            d->ignore_read_buffer_slot = true;
-            QCoreApplication::processEvents(QEventLoop::ExcludeSocketNotifiers);
-            d->ignore_read_buffer_slot = false;
+        if (d->refresh_frequency > 0 && ++msg_count > d->refresh_frequency) {
+            // To keep GUI applications responsive in case the backend process dumps tons of data for us, the rest of the
+            // buffer is read in the next idle slice. Whatever is left when the process finishes is read in procFinished():
+            IDLE_SCHEDULER->scheduleInvoke(this,"readStandardError",IdleScheduler::HighPriority);
+            return;
         }
 
         QByteArray ba = d->process->readLine();
@@ -424,103 +1256,21 @@ void Qtilities::Core::QtilitiesProcess::readStandardError() {
 void Qtilities::Core::QtilitiesProcess::processSingleBufferMessage(const QString &buffer_message, Logger::MessageType msg_type) {
     // If logging is disabled, we can skip the processing of the buffer message altogether:
     if (loggingEnabled()) {
-        if (d->buffer_message_type_hints.isEmpty()) {
-            logMessage(buffer_message,msg_type);
-        } else {
-            bool found_match = false;
-            bool found_match_is_stopper = false;
-
-            // Get all hints that match the message:
-            QListIterator<ProcessBufferMessageTypeHint> itr(d->buffer_message_type_hints);
-            int highest_matching_hint_priority = -1;
-            QList<ProcessBufferMessageTypeHint> matching_hints;
-            while (itr.hasNext()) {
-                ProcessBufferMessageTypeHint hint = itr.next();
-                if (hint.d_regexp.exactMatch(buffer_message)) {
-                    if (hint.d_priority >= highest_matching_hint_priority) {
-                        highest_matching_hint_priority = hint.d_priority;
-                        matching_hints << hint;
-                    } /*else {
-                        LOG_DEBUG(QString("-> Ignoring process buffer message type hint (its overwritten by a higher priority hint): %1").arg(hint.d_regexp.pattern()));
-                    }*/
-                }
-            }
-
-            // Next, log the message using all hints that match the highest_matching_hint_priority:
-//            if (!matching_hints.isEmpty())
-//                LOG_DEBUG("ANALYZING HINTS FOR MESSAGE: " + buffer_message);
-            QListIterator<ProcessBufferMessageTypeHint> itr_log(matching_hints);
-            while (itr_log.hasNext()) {
-                ProcessBufferMessageTypeHint hint = itr_log.next();
-//                LOG_DEBUG("-> MATCHING HINT: " + hint.d_regexp.pattern() + ", priority: " + QString::number(hint.d_priority) + ", hint: " + QString::number((int) hint.d_message_type) + ", enabler: " + QString::number((int) hint.d_is_enabler) + ", disabler: " + QString::number((int) hint.d_is_disabler));
-                if (hint.d_priority == highest_matching_hint_priority) {
-                    bool log_this_message = d->active_message_disablers.isEmpty();
-                    if (hint.d_is_enabler) {
-//                        LOG_WARNING("0. hint.d_is_enabler = true: " + buffer_message);
-                        d->active_message_disablers.pop_front();
-                        log_this_message = d->active_message_disablers.isEmpty();
-//                        LOG_DEBUG("--d->active_message_disabler_count, current = " + QString::number(d->active_message_disablers.count()));
-                    } else if (hint.d_is_disabler) {
-//                        LOG_WARNING("0. hint.d_is_enabler = false: " + buffer_message);
-                        d->active_message_disablers.push_front(hint);
-                        // Note that we don't set log_this_message. The disabler message must also be logged.
-//                        LOG_DEBUG("++d->active_message_disabler_count, current = " + QString::number(d->active_message_disablers.count()));
-                    }
-
-
-                    // If log_this_message=false, one or more disabler is active.
-                    // We need to now check the d_disabled_unblocked_message_types of all active disablers against hint.d_message_type
-                    // to see if this type is unblocked while disabled:
-//                    LOG_WARNING("XXX - " + buffer_message);
-                    if (!log_this_message) {
-//                        LOG_WARNING("1. log_this_message = false: " + buffer_message);
-                        bool is_unblocked = true;
-                        foreach (const ProcessBufferMessageTypeHint& disabler_hint, d->active_message_disablers) {
-//                            LOG_WARNING(QString("2. disabler_hint.d_disabled_unblocked_message_types = %1, message type = %2").arg(disabler_hint.d_disabled_unblocked_message_types).arg(hint.d_message_type));
-                            if (!(disabler_hint.d_disabled_unblocked_message_types & hint.d_message_type)) {
-//                                LOG_WARNING("2.1 - no match, this message will be blocked! - " + disabler_hint.d_regexp.pattern());
-                                is_unblocked = false;
-                                break;
-                            }
-                        }
-                        if (is_unblocked)
-                            log_this_message = true;
-//                        LOG_WARNING(QString("3. log_this_message = %1").arg(log_this_message));
-                    }
+        // Hints can be added while the process is running:
+        if (d->classifier_outdated) {
+            d->classifier.setHints(d->buffer_message_type_hints);
+            d->classifier_outdated = false;
+        }
 
-                    if (hint.d_is_stopper)
-                        found_match_is_stopper = true;
+        ProcessBufferMessageList log_messages;
+        bool found_match_is_stopper = d->classifier.classify(buffer_message,msg_type,log_messages);
+        for (int i = 0; i < log_messages.count(); ++i)
+            logMessage(log_messages.at(i).first,log_messages.at(i).second);
 
-                    found_match = true;
-                    if (hint.d_message_type != Logger::None && log_this_message) {
-                        logMessage(buffer_message,hint.d_message_type);
-                        if (hint.d_is_stopper && !hint.d_stop_message.isEmpty())
-                            logMessage(hint.d_stop_message,hint.d_stop_message_type);
-                    }
-                }
-            }
-
-            if (found_match_is_stopper) {
-                d->was_stopped = true;
-                stopProcess();
-                return;
-            }
-
-            if (!found_match) {
-                if (d->active_message_disablers.isEmpty()) {
-                    logMessage(buffer_message,msg_type);
-                } else {
-                    bool is_unblocked = true;
-                    foreach (const ProcessBufferMessageTypeHint& disabler_hint, d->active_message_disablers) {
-                        if (!(disabler_hint.d_disabled_unblocked_message_types & msg_type)) {
-                            is_unblocked = false;
-                            break;
-                        }
-                    }
-                    if (is_unblocked)
-                        logMessage(buffer_message,msg_type);
-                }
-            }
+        if (found_match_is_stopper) {
+            d->was_stopped = true;
+            stopProcess();
+            return;
         }
     }
 }
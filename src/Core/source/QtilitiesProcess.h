@@ -16,6 +16,7 @@
 #include "Task.h"
 
 #include <QObject>
+#include <QPair>
 #include <QProcess>
 #include <Logger>
 using namespace Qtilities::Logging;
@@ -126,6 +127,71 @@ namespace Qtilities {
             Logger::MessageTypeFlags    d_disabled_unblocked_message_types;
         };
 
+        /*!
+        \struct ProcessBufferMessageClassifierPrivateData
+        \brief Structure used by ProcessBufferMessageClassifier to store private data.
+          */
+        struct ProcessBufferMessageClassifierPrivateData;
+
+        /*!
+        \class ProcessBufferMessageClassifier
+        \brief The ProcessBufferMessageClassifier class classifies process buffer messages using a set of ProcessBufferMessageTypeHint hints.
+
+        QtilitiesProcess uses a classifier to decide how the messages received from its backend process must be logged. When the hints are set,
+        every hint is compiled into a literal prefix and a literal fragment which a message must contain for the hint's regular expression to match
+        it, where these can be derived from the expression. Hints which require a prefix are indexed by the first character of their prefix. Thus, for a
+        single message only the hints of which the literals appear in the message are evaluated using their regular expressions, while hints
+        without literals, for example regular expressions with alternations, are always evaluated.
+
+        The results are the same as evaluating every hint on every message: the hints which match are evaluated in the order in which they were
+        set, and priorities, enablers, disablers and stoppers are handled as described in ProcessBufferMessageTypeHint.
+
+        A classifier can only be used in one thread at a time since QRegExp matching is not thread safe. It keeps its own copies of the hints, thus
+        different classifiers can be used in different threads.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT ProcessBufferMessageClassifier {
+        public:
+            ProcessBufferMessageClassifier();
+            ~ProcessBufferMessageClassifier();
+
+            //! Sets and compiles the hints used by this classifier, this also calls resetState().
+            void setHints(const QList<ProcessBufferMessageTypeHint>& hints);
+            //! Gets the hints used by this classifier.
+            QList<ProcessBufferMessageTypeHint> hints() const;
+
+            //! Returns the indexes of the hints which match \p buffer_message and have the highest priority of all hints which match it, in the order in which the hints were set.
+            QList<int> matchingHints(const QString& buffer_message);
+            //! Classifies \p buffer_message and appends the messages which must be logged for it to \p log_messages.
+            /*!
+              \param buffer_message The message to classify.
+              \param msg_type The message type to use for the message when no hint matches it.
+              \param log_messages The messages to log for \p buffer_message, along with their message types. Stoppers can add their stop message
+              after the message.
+              \returns True when a stopper hint matched the message, false otherwise.
+              */
+            bool classify(const QString& buffer_message, Logger::MessageType msg_type, QList<QPair<QString,Logger::MessageType> >& log_messages);
+            //! Sets if classify() logs messages which no hint matches, using the message type passed to it. True by default.
+            /*!
+              When false, only messages which match a hint are logged. Enablers, disablers and stoppers are handled as usual.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setForwardUnmatchedMessages(bool forward_unmatched);
+            //! Gets if classify() logs messages which no hint matches.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool forwardUnmatchedMessages() const;
+            //! Clears the disablers which are active, used when the classifier is used for a new run of a process.
+            void resetState();
+
+        private:
+            Q_DISABLE_COPY(ProcessBufferMessageClassifier)
+            ProcessBufferMessageClassifierPrivateData* d;
+        };
+
         /*!
         \struct QtilitiesProcessPrivateData
         \brief Structure used by QtilitiesProcess to store private data.
@@ -161,6 +227,12 @@ namespace Qtilities {
         of messages through \p read_process_buffers. The last run buffer can be cleared using clearLastRunBuffer() and accessed
         through lastRunBuffer(). The last run buffer is disabled by default.
 
+        The last run buffer stores the messages in chunks, thus appending to it never copies the messages collected so far. It is not limited by default.
+        For long running processes it can be limited using setLastRunBufferMaximumSize() and setLastRunBufferMaximumLineCount(), in which case the oldest
+        messages are removed from the buffer. When setLastRunBufferSpillEnabled() is enabled, the removed messages are written to a temporary file instead and
+        remain part of the buffer, while the memory used by the buffer stays limited. To access large buffers without copying them, use lastRunBufferDevice()
+        or lastRunBufferChunks().
+
         If \p read_process_buffers is false and the last run buffer is not used, the process buffer won't be touched and you can manually access it
         through the internal QIODevice exposed through the process() function.
 
@@ -179,6 +251,25 @@ my_process.addProcessBufferMessageTypeHint(message_hint_error);
         The processing logic will then know to log these messages as errors instead of normal information messages.
 
         Note that it is also possible to filter specific messages by assigning a message type of Logger::None in the ProcessBufferMessageTypeHint.
+
+        \subsection qtilities_process_buffering_background Processing buffers in a worker thread
+
+        By default the process buffers are read one line at a time and classified in the thread of the process, which can make GUI applications
+        unresponsive when the backend process produces large amounts of output, for example compilers on build servers. When
+        setBackgroundBufferProcessingEnabled() is enabled, all available data is read in large chunks instead. A worker thread splits the chunks into
+        lines and classifies them using the process buffer message type hints, after which the classified messages are logged in batches in the thread
+        of the process. Thus setGuiRefreshFrequency() is not needed in this mode.
+
+        Lines are logged without their line endings in this mode, and processSingleBufferMessage() is not called. The hints are copied when the process
+        starts, thus hints added while the process is running are used during its next run.
+
+        \subsection qtilities_process_buffering_raw Capturing raw output to a file
+
+        Logging the output of a process to a file using assignFileLoggerEngineToProcess() sends every line through the logger and a formatting engine.
+        For processes which produce large amounts of output which only has to be archived, setRawOutputCaptureFile() writes the data received on
+        \p stdout and \p stderr to a file exactly as it was received, in the order in which it was received. The data is written by the worker thread
+        described above in the chunks in which it was read, without splitting it into lines. Only lines which match a process buffer message type hint
+        are logged to the task, see ProcessBufferMessageClassifier::setForwardUnmatchedMessages(). When no hints were added, nothing is logged.
           */
         class QTILIITES_CORE_SHARED_EXPORT QtilitiesProcess : public Task
         {
@@ -244,6 +335,24 @@ my_process.addProcessBufferMessageTypeHint(message_hint_error);
              * <i>This function was added in %Qtilities v1.5.</i>
              */
             AbstractLoggerEngine* assignFileLoggerEngineToProcess(const QString &file_path, bool log_only_to_file = false, QString *engine_name = 0, QString* errorMsg = 0);
+            //! Sets the file to which the raw output of the backend process is written, an empty path disables raw capturing.
+            /*!
+             * The file is overwritten every time the process starts. While capturing, the process buffers are processed in a worker thread
+             * whether setBackgroundBufferProcessingEnabled() is enabled or not, and only messages which match a process buffer message type hint
+             * are logged. Errors opening or writing the file are logged as errors to the task.
+             *
+             * \note The \p read_process_buffers parameter of the constructor must be true. Call this function before starting the process.
+             *
+             * For more details, see \ref qtilities_process_buffering_raw.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setRawOutputCaptureFile(const QString& file_path);
+            //! Gets the file to which the raw output of the backend process is written, empty when raw capturing is disabled.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            QString rawOutputCaptureFile() const;
 
             // --------------------------------------------------------
             // Process Buffer
@@ -289,17 +398,54 @@ my_process.addProcessBufferMessageTypeHint(message_hint_error);
              * the message processing hint based processing of the dump can cause applications where QtilitiesProcess
              * lives in the GUI process to become unresponsive for short periods. To counter this, it is possible
              * to set the buffer UI refresh frequency which is the number of lines to process in the buffer before
-             * issuing an UI refresh as shown below:
+             * returning to the event loop. The rest of the buffer is processed in a high priority call scheduled on
+             * the idle scheduler (see Qtilities::Core::IdleScheduler::scheduleInvoke()).
              *
-             * \code
-             * QCoreApplication::processEvents(QEventLoop::ExcludeSocketNotifiers);
-             * \endcode
+             * \note Prior to %Qtilities v1.5, the event loop was re-entered using QCoreApplication::processEvents(QEventLoop::ExcludeSocketNotifiers)
+             * in the middle of processing the buffer.
              *
              * To disable any UI refreshes, set the refresh frequency to 0. By default, refreshing is disabled.
              */
             void setGuiRefreshFrequency(int refresh_frequency);
             //! Gets the backend buffer UI refresh frequency.
             int guiRefreshFrequency() const;
+            //! Sets if the process buffers are split into lines and classified in a worker thread.
+            /*!
+             * Disabled by default. Call this function before starting the process.
+             *
+             * For more details, see \ref qtilities_process_buffering_background.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setBackgroundBufferProcessingEnabled(bool is_enabled);
+            //! Gets if the process buffers are split into lines and classified in a worker thread.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            bool backgroundBufferProcessingEnabled() const;
+            //! Sets the time in milli seconds which stopProcess() waits for the process to exit after terminating it, before it kills the process.
+            /*!
+             * When 0, stopProcess() kills the process immediately, which is the default. Otherwise stopProcess() behaves like terminateProcess().
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setTerminateTimeout(int msecs);
+            //! Gets the time in milli seconds which stopProcess() waits for the process to exit after terminating it, before it kills the process.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            int terminateTimeout() const;
+            //! Stops all \p processes at the same time, killing the ones which did not exit \p kill_timeout_msecs after they were terminated.
+            /*!
+             * This function does not wait for the processes to exit. Every process stops its task once it exited, thus completion is
+             * reported through ITask::taskStopped() and ITask::taskCompleted() of each process. Since all processes are terminated at once
+             * and share a single timer to escalate to kill, stopping many processes takes at most one timeout period.
+             *
+             * \sa terminateProcess()
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            static void stopProcesses(const QList<QtilitiesProcess*>& processes, int kill_timeout_msecs = 3000);
 
             // --------------------------------------------------------
             // Process Information Messages
@@ -368,11 +514,67 @@ my_process.addProcessBufferMessageTypeHint(message_hint_error);
              * be enabled using setLastRunBuffer() enabled. The last run buffer can be cleared using clearLastRunBuffer() and accessed
              * through lastRunBuffer(). The last run buffer is disabled by default.
              *
+             * This function returns a copy of the complete buffer, including the part which was spilled to disk. For large buffers, use
+             * lastRunBufferDevice() instead.
+             *
              * \sa setLastRunBufferEnabled(), lastRunBufferEnabled(), clearLastRunBuffer()
              *
              * <i>This function was added in %Qtilities v1.5.</i>
              */
             QByteArray lastRunBuffer() const;
+            //! Gets the chunks of the last run buffer which are kept in memory, without copying them.
+            /*!
+             * When spilling is enabled, the spilled part of the buffer is not included. Use lastRunBufferDevice() to access the complete buffer.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            QList<QByteArray> lastRunBufferChunks() const;
+            //! Gets a read only device on the complete last run buffer, including the part which was spilled to disk.
+            /*!
+             * The device shows the buffer as it was when this function was called, thus the process can continue to append to the buffer while the device is read.
+             * The spilled part can only be read through the device until clearLastRunBuffer() is called or the process is started again. The caller takes
+             * ownership of the device.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            QIODevice* lastRunBufferDevice(QObject* parent = 0) const;
+            //! Gets the size of the complete last run buffer in bytes, including the part which was spilled to disk.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            qint64 lastRunBufferSize() const;
+            //! Sets the maximum number of bytes kept in the last run buffer, the oldest data is removed first. When 0, the size is not limited, which is the default.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setLastRunBufferMaximumSize(qint64 maximum_size);
+            //! Gets the maximum number of bytes kept in the last run buffer.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            qint64 lastRunBufferMaximumSize() const;
+            //! Sets the maximum number of lines kept in the last run buffer, the oldest lines are removed first. When 0, the number of lines is not limited, which is the default.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setLastRunBufferMaximumLineCount(qint64 maximum_line_count);
+            //! Gets the maximum number of lines kept in the last run buffer.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            qint64 lastRunBufferMaximumLineCount() const;
+            //! Sets if data removed from the last run buffer because of its limits is written to a temporary file, where it remains part of the buffer.
+            /*!
+             * Disabled by default.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setLastRunBufferSpillEnabled(bool is_enabled);
+            //! Gets if data removed from the last run buffer because of its limits is written to a temporary file.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            bool lastRunBufferSpillEnabled() const;
             //! Clears the last run buffer.
             /*!
              * \sa setLastRunBufferEnabled(), lastRunBufferEnabled(), lastRunBuffer()
@@ -390,19 +592,39 @@ my_process.addProcessBufferMessageTypeHint(message_hint_error);
             void procFinished(int exit_code, QProcess::ExitStatus exit_status);
             void procError(QProcess::ProcessError error);
             void stopTimedOut();
+            //! Logs the messages classified by the buffer worker thread.
+            void handleProcessedBufferMessages();
+            //! Kills the process when it did not exit within the timeout given to terminateProcess().
+            void killTerminatedProcess();
 
         public slots:
             //! Stops the process.
             /*!
-             * This function will first call terminate() on the process, wait and then call kill().
+             * This function will first call terminate() on the process and then call kill(). When a terminateTimeout() is set, the process is
+             * only killed when it did not exit within the timeout, without blocking. See terminateProcess().
              * \note When reimplementing this function, it is important to call Task::stop() at the end of your implementation.
              */
             virtual void stopProcess();
+            //! Asks the process to exit by terminating it, and kills it when it did not exit after \p kill_timeout_msecs.
+            /*!
+             * This function returns immediately. The task of the process is stopped once the process exited, after which
+             * ITask::taskStopped() and ITask::taskCompleted() are emitted.
+             *
+             * When \p kill_timeout_msecs is 0, the process is killed immediately.
+             *
+             * \sa stopProcesses(), setTerminateTimeout()
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void terminateProcess(int kill_timeout_msecs = 3000);
 
         protected:
             virtual void processSingleBufferMessage(const QString &buffer_message, Logger::MessageType msg_type);
 
         private:
+            //! Logs the exit code of the process when needed and completes its task.
+            void completeProcess(int exit_code, QProcess::ExitStatus exit_status);
+
             QtilitiesProcessPrivateData* d;
         };
     }
@@ -0,0 +1,250 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "QtilitiesProcessPool.h"
+
+#include <QPointer>
+#include <QSet>
+#include <QThread>
+
+namespace {
+    struct QtilitiesProcessPoolEntry {
+        QtilitiesProcessPoolEntry() : process_object(0), priority(0), mode(QProcess::ReadWrite), wait_for_started_msecs(30000), timeout_msecs(-1) {}
+
+        QPointer<Qtilities::Core::QtilitiesProcess> process;
+        //! The process, used to find the entry when the process is destroyed.
+        QObject*                                    process_object;
+        QString                                     program;
+        QStringList                                 arguments;
+        int                                         priority;
+        QProcess::OpenMode                          mode;
+        int                                         wait_for_started_msecs;
+        int                                         timeout_msecs;
+    };
+}
+
+struct Qtilities::Core::QtilitiesProcessPoolPrivateData {
+    QtilitiesProcessPoolPrivateData() : pool_task(0),
+        maximum_concurrent_processes(1),
+        starting_processes(false),
+        has_processes(false) {}
+
+    Task*                               pool_task;
+    //! The queued processes, ordered by priority.
+    QList<QtilitiesProcessPoolEntry>    pending;
+    QSet<QObject*>                      running;
+    int                                 maximum_concurrent_processes;
+    //! Guards startPendingProcesses(), since processes which fail to start complete while they are being started.
+    bool                                starting_processes;
+    //! Indicates if processes were added since allProcessesFinished() was emitted.
+    bool                                has_processes;
+};
+
+Qtilities::Core::QtilitiesProcessPool::QtilitiesProcessPool(const QString& pool_name, QObject* parent) : QObject(parent) {
+    d = new QtilitiesProcessPoolPrivateData;
+    d->maximum_concurrent_processes = qMax(1,QThread::idealThreadCount());
+
+    d->pool_task = new Task(pool_name,true,this);
+    d->pool_task->setCanStop(true);
+    connect(d->pool_task,SIGNAL(stopTaskRequest()),SLOT(stopAll()));
+    setObjectName(pool_name);
+}
+
+Qtilities::Core::QtilitiesProcessPool::~QtilitiesProcessPool() {
+    for (int i = 0; i < d->pending.count(); ++i) {
+        if (d->pending.at(i).process)
+            d->pending.at(i).process->disconnect(this);
+    }
+    foreach (QObject* process, d->running)
+        process->disconnect(this);
+    delete d;
+}
+
+bool Qtilities::Core::QtilitiesProcessPool::enqueue(QtilitiesProcess* process,
+                                                    const QString& program,
+                                                    const QStringList& arguments,
+                                                    int priority,
+                                                    QProcess::OpenMode mode,
+                                                    int wait_for_started_msecs,
+                                                    int timeout_msecs) {
+    if (!process || d->running.contains(process))
+        return false;
+    for (int i = 0; i < d->pending.count(); ++i) {
+        if (d->pending.at(i).process_object == process)
+            return false;
+    }
+
+    QtilitiesProcessPoolEntry entry;
+    entry.process = process;
+    entry.process_object = process;
+    entry.program = program;
+    entry.arguments = arguments;
+    entry.priority = priority;
+    entry.mode = mode;
+    entry.wait_for_started_msecs = wait_for_started_msecs;
+    entry.timeout_msecs = timeout_msecs;
+
+    // Insert after all entries with the same or a higher priority:
+    int index = d->pending.count();
+    for (int i = 0; i < d->pending.count(); ++i) {
+        if (d->pending.at(i).priority < priority) {
+            index = i;
+            break;
+        }
+    }
+    d->pending.insert(index,entry);
+    d->has_processes = true;
+
+    process->setParentTask(d->pool_task);
+    connect(process,SIGNAL(destroyed(QObject*)),SLOT(handleProcessDestroyed(QObject*)));
+
+    if (d->pool_task->state() == ITask::TaskBusy || d->pool_task->state() == ITask::TaskPaused)
+        d->pool_task->setNumberOfSubTasks(d->pool_task->numberOfSubTasks() + 1);
+    else
+        d->pool_task->startTask(1);
+
+    startPendingProcesses();
+    return true;
+}
+
+bool Qtilities::Core::QtilitiesProcessPool::dequeue(QtilitiesProcess* process) {
+    for (int i = 0; i < d->pending.count(); ++i) {
+        if (d->pending.at(i).process_object == process) {
+            d->pending.removeAt(i);
+            process->disconnect(this);
+            process->removeParentTask();
+            if (d->pool_task->state() == ITask::TaskBusy || d->pool_task->state() == ITask::TaskPaused)
+                d->pool_task->setNumberOfSubTasks(d->pool_task->numberOfSubTasks() - 1);
+            checkFinished();
+            return true;
+        }
+    }
+    return false;
+}
+
+void Qtilities::Core::QtilitiesProcessPool::setMaximumConcurrentProcesses(int maximum) {
+    d->maximum_concurrent_processes = qMax(1,maximum);
+    startPendingProcesses();
+}
+
+int Qtilities::Core::QtilitiesProcessPool::maximumConcurrentProcesses() const {
+    return d->maximum_concurrent_processes;
+}
+
+int Qtilities::Core::QtilitiesProcessPool::runningCount() const {
+    return d->running.count();
+}
+
+int Qtilities::Core::QtilitiesProcessPool::pendingCount() const {
+    return d->pending.count();
+}
+
+Qtilities::Core::Task* Qtilities::Core::QtilitiesProcessPool::poolTask() const {
+    return d->pool_task;
+}
+
+void Qtilities::Core::QtilitiesProcessPool::stopAll() {
+    QList<QtilitiesProcessPoolEntry> pending = d->pending;
+    d->pending.clear();
+    for (int i = 0; i < pending.count(); ++i) {
+        if (pending.at(i).process) {
+            pending.at(i).process->disconnect(this);
+            pending.at(i).process->removeParentTask();
+        }
+    }
+
+    if (d->pool_task->state() == ITask::TaskBusy || d->pool_task->state() == ITask::TaskPaused)
+        d->pool_task->stopTask();
+
+    // The processes finish asynchronously, after which they are removed from running:
+    QList<QObject*> running = d->running.toList();
+    for (int i = 0; i < running.count(); ++i) {
+        QtilitiesProcess* process = qobject_cast<QtilitiesProcess*> (running.at(i));
+        if (process)
+            process->stopProcess();
+    }
+    checkFinished();
+}
+
+void Qtilities::Core::QtilitiesProcessPool::handleProcessCompleted() {
+    QObject* process = sender();
+    if (!d->running.contains(process))
+        return;
+
+    finishProcess(process);
+    startPendingProcesses();
+}
+
+void Qtilities::Core::QtilitiesProcessPool::handleProcessDestroyed(QObject* obj) {
+    for (int i = 0; i < d->pending.count(); ++i) {
+        if (d->pending.at(i).process_object == obj) {
+            d->pending.removeAt(i);
+            if (d->pool_task->state() == ITask::TaskBusy || d->pool_task->state() == ITask::TaskPaused)
+                d->pool_task->setNumberOfSubTasks(d->pool_task->numberOfSubTasks() - 1);
+            checkFinished();
+            return;
+        }
+    }
+
+    if (d->running.contains(obj)) {
+        finishProcess(obj);
+        startPendingProcesses();
+    }
+}
+
+void Qtilities::Core::QtilitiesProcessPool::startPendingProcesses() {
+    if (d->starting_processes)
+        return;
+
+    d->starting_processes = true;
+    while (d->running.count() < d->maximum_concurrent_processes && !d->pending.isEmpty()) {
+        QtilitiesProcessPoolEntry entry = d->pending.takeFirst();
+        if (!entry.process)
+            continue;
+
+        QtilitiesProcess* process = entry.process;
+        d->running.insert(process);
+        connect(process,SIGNAL(taskCompleted(ITask::TaskResult,QString,Logger::MessageType)),SLOT(handleProcessCompleted()));
+
+        // A process which fails to start might complete its task before startProcess() returns, in which case it was finished already:
+        if (!process->startProcess(entry.program,entry.arguments,entry.mode,entry.wait_for_started_msecs,entry.timeout_msecs) && d->running.contains(process))
+            finishProcess(process);
+    }
+    d->starting_processes = false;
+
+    checkFinished();
+}
+
+void Qtilities::Core::QtilitiesProcessPool::finishProcess(QObject* process) {
+    d->running.remove(process);
+    process->disconnect(this);
+
+    if (d->pool_task->state() == ITask::TaskBusy || d->pool_task->state() == ITask::TaskPaused)
+        d->pool_task->addCompletedSubTasks(1);
+
+    QtilitiesProcess* qtilities_process = qobject_cast<QtilitiesProcess*> (process);
+    if (qtilities_process)
+        emit processFinished(qtilities_process);
+}
+
+void Qtilities::Core::QtilitiesProcessPool::checkFinished() {
+    if (!d->running.isEmpty() || !d->pending.isEmpty() || d->starting_processes)
+        return;
+
+    // Processes log their messages to the pool task as well, thus its result reflects the errors logged by them:
+    if (d->pool_task->state() == ITask::TaskBusy || d->pool_task->state() == ITask::TaskPaused)
+        d->pool_task->completeTask(ITask::TaskResultFromBusyStateFailOnError);
+
+    if (d->has_processes) {
+        d->has_processes = false;
+        emit allProcessesFinished();
+    }
+}
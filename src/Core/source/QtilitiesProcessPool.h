@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef QTILITIES_PROCESS_POOL_H
+#define QTILITIES_PROCESS_POOL_H
+
+#include "QtilitiesCore_global.h"
+#include "QtilitiesProcess.h"
+
+#include <QObject>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \struct QtilitiesProcessPoolPrivateData
+        \brief Structure used by QtilitiesProcessPool to store private data.
+          */
+        struct QtilitiesProcessPoolPrivateData;
+
+        /*!
+        \class QtilitiesProcessPool
+        \brief The QtilitiesProcessPool class limits the number of QtilitiesProcess instances which run at the same time.
+
+        When hundreds of external tools are launched using QtilitiesProcess::startProcess() directly, they all run at the same time. A QtilitiesProcessPool
+        queues processes instead, and only starts a process once fewer than maximumConcurrentProcesses() of its processes are running:
+
+\code
+QtilitiesProcessPool* pool = new QtilitiesProcessPool("Linting");
+OBJECT_MANAGER->registerObject(pool->poolTask(),QtilitiesCategory("Tasks"));
+
+foreach (const QString& file, files) {
+    QtilitiesProcess* process = new QtilitiesProcess("Lint " + file);
+    process->setTaskLifeTimeFlags(Task::LifeTimeDestroyWhenCompleted);
+    pool->enqueue(process,"lint",QStringList() << file);
+}
+\endcode
+
+        Processes with a higher priority are started first, processes with the same priority are started in the order in which they were enqueued.
+
+        Every process remains a task of its own, which can be registered in the object manager as usual. In addition, the pool aggregates its processes
+        under poolTask(): the pool task is the parent task of every enqueued process, thus messages logged by the processes are also logged to it, and it
+        completes a sub task every time one of the processes finished. Stopping the pool task stops the running processes and removes the queued processes
+        from the pool.
+
+        The pool does not take ownership of the processes.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT QtilitiesProcessPool : public QObject
+        {
+            Q_OBJECT
+
+        public:
+            //! Constructs a pool of which the pool task is named \p pool_name.
+            QtilitiesProcessPool(const QString& pool_name, QObject* parent = 0);
+            //! Destructor. Processes which are still queued are not started.
+            ~QtilitiesProcessPool();
+
+            //! Queues \p process to be started with \p program and \p arguments.
+            /*!
+              The remaining parameters are passed to QtilitiesProcess::startProcess() when the process is started. When \p process is deleted
+              while it is queued, it is removed from the pool.
+
+              \returns False when \p process is null, or when it is already queued or running in the pool.
+              */
+            bool enqueue(QtilitiesProcess* process,
+                         const QString& program,
+                         const QStringList& arguments,
+                         int priority = 0,
+                         QProcess::OpenMode mode = QProcess::ReadWrite,
+                         int wait_for_started_msecs = 30000,
+                         int timeout_msecs = -1);
+            //! Removes \p process from the queue without starting it. Processes which are running are not affected.
+            bool dequeue(QtilitiesProcess* process);
+
+            //! Sets the maximum number of processes which run at the same time. Default is QThread::idealThreadCount().
+            void setMaximumConcurrentProcesses(int maximum);
+            //! Gets the maximum number of processes which run at the same time.
+            int maximumConcurrentProcesses() const;
+
+            //! The number of processes which are running.
+            int runningCount() const;
+            //! The number of processes which are queued.
+            int pendingCount() const;
+            //! The task under which the processes in the pool are aggregated.
+            Task* poolTask() const;
+
+        public slots:
+            //! Stops all running processes and removes all queued processes from the pool.
+            void stopAll();
+
+        signals:
+            //! Signal emitted when \p process, which was run by the pool, finished.
+            void processFinished(Qtilities::Core::QtilitiesProcess* process);
+            //! Signal emitted when all processes in the pool finished, and no processes are queued.
+            void allProcessesFinished();
+
+        private slots:
+            void handleProcessCompleted();
+            void handleProcessDestroyed(QObject* obj);
+
+        private:
+            //! Starts queued processes while fewer than maximumConcurrentProcesses() processes are running.
+            void startPendingProcesses();
+            void finishProcess(QObject* process);
+            void checkFinished();
+
+            QtilitiesProcessPoolPrivateData* d;
+        };
+    }
+}
+
+#endif // QTILITIES_PROCESS_POOL_H
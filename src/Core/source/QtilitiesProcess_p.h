@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef QTILITIES_PROCESS_P_H
+#define QTILITIES_PROCESS_P_H
+
+#include <QByteArray>
+#include <QDebug>
+#include <QList>
+#include <QTemporaryFile>
+
+#include <limits.h>
+#include <string.h>
+
+namespace Qtilities {
+    namespace Core {
+        // The last run buffer of a QtilitiesProcess. Data is stored in chunks, thus appending never copies the data collected so far and the
+        // oldest data can be removed cheaply when the buffer is limited.
+        class QtilitiesProcessLastRunBuffer
+        {
+        public:
+            QtilitiesProcessLastRunBuffer() : size(0),
+                line_count(0),
+                maximum_size(0),
+                maximum_line_count(0),
+                spill_enabled(false),
+                spill_file(0),
+                spilled_size(0) {}
+            ~QtilitiesProcessLastRunBuffer() {
+                delete spill_file;
+            }
+
+            void append(const QByteArray& data) {
+                if (data.isEmpty())
+                    return;
+
+                if (!chunks.isEmpty() && chunks.last().size() + data.size() <= chunk_size)
+                    chunks.last().append(data);
+                else
+                    chunks << data;
+                size += data.size();
+                line_count += data.count('\n');
+                enforceLimits();
+            }
+            void clear() {
+                chunks.clear();
+                size = 0;
+                line_count = 0;
+                if (spill_file)
+                    spill_file->resize(0);
+                spilled_size = 0;
+            }
+            //! Returns the complete buffer, including the data which was spilled to disk.
+            QByteArray toByteArray() const {
+                QByteArray result;
+                if (spilled_size > 0 && spill_file->seek(0))
+                    result = spill_file->read(spilled_size);
+                result.reserve((int) qMin(totalSize(),(qint64) INT_MAX));
+                for (int i = 0; i < chunks.count(); ++i)
+                    result.append(chunks.at(i));
+                return result;
+            }
+            qint64 totalSize() const {
+                return spilled_size + size;
+            }
+            void enforceLimits() {
+                if (maximum_size > 0 && size > maximum_size)
+                    removeFront(size - maximum_size);
+                if (maximum_line_count > 0 && line_count > maximum_line_count) {
+                    // Find the end of the lines which must be removed:
+                    qint64 lines_to_remove = line_count - maximum_line_count;
+                    qint64 bytes_to_remove = 0;
+                    for (int i = 0; i < chunks.count() && lines_to_remove > 0; ++i) {
+                        const char* begin = chunks.at(i).constData();
+                        const char* end = begin + chunks.at(i).size();
+                        const char* position = begin;
+                        while (lines_to_remove > 0) {
+                            const char* line_end = (const char*) memchr(position,'\n',end - position);
+                            if (!line_end)
+                                break;
+                            position = line_end + 1;
+                            --lines_to_remove;
+                        }
+                        // When lines remain to be removed, the last line of this chunk continues in the next chunk and is removed as well:
+                        bytes_to_remove += (lines_to_remove > 0 ? end : position) - begin;
+                    }
+                    removeFront(bytes_to_remove);
+                }
+            }
+
+            QList<QByteArray>   chunks;
+            qint64              size;
+            qint64              line_count;
+            qint64              maximum_size;
+            qint64              maximum_line_count;
+            bool                spill_enabled;
+            QTemporaryFile*     spill_file;
+            qint64              spilled_size;
+
+            static const int    chunk_size = 65536;
+
+        private:
+            //! Removes bytes from the front of the buffer, they are written to the spill file when spilling is enabled.
+            void removeFront(qint64 bytes) {
+                while (bytes > 0 && !chunks.isEmpty()) {
+                    QByteArray& front = chunks.first();
+                    if (front.size() <= bytes) {
+                        spill(front);
+                        bytes -= front.size();
+                        size -= front.size();
+                        line_count -= front.count('\n');
+                        chunks.removeFirst();
+                    } else {
+                        const QByteArray removed = front.left((int) bytes);
+                        spill(removed);
+                        size -= removed.size();
+                        line_count -= removed.count('\n');
+                        front.remove(0,(int) bytes);
+                        bytes = 0;
+                    }
+                }
+            }
+            void spill(const QByteArray& data) {
+                if (!spill_enabled)
+                    return;
+                if (!spill_file) {
+                    spill_file = new QTemporaryFile;
+                    if (!spill_file->open()) {
+                        qWarning() << "QtilitiesProcess: Failed to open the last run buffer spill file:" << spill_file->errorString();
+                        delete spill_file;
+                        spill_file = 0;
+                        spill_enabled = false;
+                        return;
+                    }
+                }
+                if (spill_file->seek(spilled_size) && spill_file->write(data) == data.size())
+                    spilled_size += data.size();
+            }
+        };
+    }
+}
+
+#endif // QTILITIES_PROCESS_P_H
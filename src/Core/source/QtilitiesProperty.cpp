@@ -13,10 +13,15 @@
 #include "QtilitiesCoreConstants.h"
 #include "ObjectManager.h"
 #include "Observer.h"
+#include "CompactBinaryFormat.h"
 
 #include <Logger>
 
 #include <QDomDocument>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <QVector>
+#include <QPair>
 
 using namespace Qtilities::Core::Properties;
 
@@ -230,6 +235,22 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Qti
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
+    if (CompactBinaryFormat::isActive(stream)) {
+        // Properties are exported for most subjects, thus their names are written through the string table and their flags in a single byte:
+        CompactBinaryFormat::writeString(stream,name);
+        quint8 flags = 0;
+        if (is_reserved)
+            flags |= 0x01;
+        if (read_only)
+            flags |= 0x02;
+        if (is_removable)
+            flags |= 0x04;
+        if (supports_change_notifications)
+            flags |= 0x08;
+        stream << flags;
+        return IExportable::Complete;
+    }
+
     stream << MARKER_OBSERVER_PROPERTY;
     stream << name;
     stream << is_reserved;
@@ -246,6 +267,21 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Qti
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
+    if (CompactBinaryFormat::isActive(stream)) {
+        name = CompactBinaryFormat::readString(stream);
+        quint8 flags = 0;
+        stream >> flags;
+        is_reserved = (flags & 0x01);
+        read_only = (flags & 0x02);
+        is_removable = (flags & 0x04);
+        supports_change_notifications = (flags & 0x08);
+        if (stream.status() != QDataStream::Ok) {
+            LOG_ERROR("QtilitiesProperty binary import failed to read compact property data. Import will fail.");
+            return IExportable::Failed;
+        }
+        return IExportable::Complete;
+    }
+
     quint32 ui32;
     stream >> ui32;
     if (ui32 != MARKER_OBSERVER_PROPERTY) {
@@ -338,6 +374,69 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Qti
     return IExportable::Complete;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::QtilitiesProperty::exportXmlStream(QXmlStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (!writer)
+        return IExportable::Failed;
+
+    if (!name.isEmpty())
+        writer->writeAttribute("Name",name);
+    writer->writeAttribute("Reserved",is_reserved ? "1" : "0");
+    writer->writeAttribute("ReadOnly",read_only ? "1" : "0");
+    writer->writeAttribute("Removable",is_removable ? "1" : "0");
+    writer->writeAttribute("Notifications",supports_change_notifications ? "1" : "0");
+
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::QtilitiesProperty::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    Q_UNUSED(import_list)
+
+    if (!reader || !reader->isStartElement())
+        return IExportable::Failed;
+
+    importXmlAttributes(reader->attributes());
+    reader->skipCurrentElement();
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    return IExportable::Complete;
+}
+
+void Qtilities::Core::QtilitiesProperty::importXmlAttributes(const QXmlStreamAttributes& attributes) {
+    name = attributes.value("Name").toString();
+
+    if (attributes.hasAttribute("Reserved")) {
+        if (attributes.value("Reserved") == QLatin1String("1"))
+            is_reserved = true;
+        if (attributes.value("Reserved") == QLatin1String("0"))
+            is_reserved = false;
+    }
+    if (attributes.hasAttribute("ReadOnly")) {
+        if (attributes.value("ReadOnly") == QLatin1String("1"))
+            read_only = true;
+        if (attributes.value("ReadOnly") == QLatin1String("0"))
+            read_only = false;
+    }
+    if (attributes.hasAttribute("Removable")) {
+        if (attributes.value("Removable") == QLatin1String("1"))
+            is_removable = true;
+        if (attributes.value("Removable") == QLatin1String("0"))
+            is_removable = false;
+    }
+    if (attributes.hasAttribute("Notifications")) {
+        if (attributes.value("Notifications") == QLatin1String("1"))
+            supports_change_notifications = true;
+        if (attributes.value("Notifications") == QLatin1String("0"))
+            supports_change_notifications = false;
+    }
+}
+
 QVariant Qtilities::Core::QtilitiesProperty::constructVariant(const QString& type_string, const QString& value_string) {
     QVariant::Type type = QVariant::nameToType(type_string.toUtf8().constData());
     return QtilitiesProperty::constructVariant(type,value_string);
@@ -388,31 +487,75 @@ bool Qtilities::Core::QtilitiesProperty::isExportableVariant(QVariant variant) {
 // MultiContextProperty
 // ------------------------------------------
 
+struct Qtilities::Core::MultiContextPropertyPrivateData : public QSharedData {
+    MultiContextPropertyPrivateData() : last_change_context(-1) { }
+
+    //! Returns the position of \p context_id in contexts, or the position where it must be inserted when it is not present.
+    int lowerBound(quint32 context_id) const {
+        int first = 0;
+        int count = contexts.count();
+        while (count > 0) {
+            const int step = count / 2;
+            if (contexts.at(first + step).first < context_id) {
+                first += step + 1;
+                count -= step + 1;
+            } else
+                count = step;
+        }
+        return first;
+    }
+    //! Returns the position of \p context_id in contexts, or -1 when it is not present.
+    int indexOf(quint32 context_id) const {
+        const int position = lowerBound(context_id);
+        if (position < contexts.count() && contexts.at(position).first == context_id)
+            return position;
+        return -1;
+    }
+    void setContextMap(const QMap<quint32,QVariant>& context_map) {
+        contexts.clear();
+        contexts.reserve(context_map.count());
+        QMap<quint32,QVariant>::const_iterator itr;
+        for (itr = context_map.constBegin(); itr != context_map.constEnd(); ++itr)
+            contexts.append(qMakePair(itr.key(),itr.value()));
+    }
+    //! Sets the value of \p context_id, keeping contexts sorted.
+    void insert(quint32 context_id, const QVariant& value) {
+        const int position = lowerBound(context_id);
+        if (position < contexts.count() && contexts.at(position).first == context_id)
+            contexts[position].second = value;
+        else
+            contexts.insert(position,qMakePair(context_id,value));
+    }
+
+    //! The contexts of the property and their values, sorted by context ID.
+    QVector<QPair<quint32,QVariant> >   contexts;
+    int                                 last_change_context;
+};
+
 Qtilities::Core::MultiContextProperty::MultiContextProperty(const char* property_name) : QtilitiesProperty(property_name) {
-    last_change_context = -1;
+    d = new MultiContextPropertyPrivateData;
 }
 
 Qtilities::Core::MultiContextProperty::MultiContextProperty(QDataStream &ds, Qtilities::ExportVersion version) : QtilitiesProperty("") {
+    d = new MultiContextPropertyPrivateData;
     setExportVersion(version);
     QList<QPointer<QObject> > import_list;
     importBinary(ds,import_list);
 }
 
-Qtilities::Core::MultiContextProperty::MultiContextProperty(const MultiContextProperty& property) : QtilitiesProperty(property){
-    context_map = property.contextMap();
-    last_change_context = property.lastChangedContext();
+Qtilities::Core::MultiContextProperty::MultiContextProperty(const MultiContextProperty& property) : QtilitiesProperty(property), d(property.d) {
+
 }
 
 Qtilities::Core::MultiContextProperty::MultiContextProperty(const QtilitiesProperty& qtilities_property) : QtilitiesProperty(qtilities_property){
-
+    d = new MultiContextPropertyPrivateData;
 }
 
 MultiContextProperty& Qtilities::Core::MultiContextProperty::operator=(const MultiContextProperty& other) {
     if (this==&other) return *this;
 
     name = other.propertyNameString();
-    context_map = other.contextMap();
-    last_change_context = other.lastChangedContext();
+    d = other.d;
     is_reserved = other.isReserved();
     is_removable = other.isRemovable();
     read_only = other.isReadOnly();
@@ -425,14 +568,8 @@ MultiContextProperty& Qtilities::Core::MultiContextProperty::operator=(const Mul
 bool Qtilities::Core::MultiContextProperty::operator==(const MultiContextProperty& other) const {
     if (name != other.propertyNameString())
         return false;
-    if (context_map != other.contextMap()) {
-//        for (int i = 0; i < context_map.count(); ++i)
-//            qDebug() << context_map.values().at(i).toString();
-//        for (int i = 0; i < other.contextMap().count(); ++i)
-//            qDebug() << other.contextMap().values().at(i).toString();
-
+    if (d != other.d && d->contexts != other.d->contexts)
         return false;
-    }
     if (is_reserved != other.isReserved())
         return false;
     if (is_removable != other.isRemovable())
@@ -454,11 +591,29 @@ bool Qtilities::Core::MultiContextProperty::operator!=(const MultiContextPropert
 Qtilities::Core::MultiContextProperty::~MultiContextProperty() {}
 
 QMap<quint32,QVariant> Qtilities::Core::MultiContextProperty::contextMap() const {
+    QMap<quint32,QVariant> context_map;
+    for (int i = 0; i < d->contexts.count(); ++i)
+        context_map.insert(d->contexts.at(i).first,d->contexts.at(i).second);
     return context_map;
 }
 
+int Qtilities::Core::MultiContextProperty::contextCount() const {
+    return d->contexts.count();
+}
+
+QList<quint32> Qtilities::Core::MultiContextProperty::contextIds() const {
+    QList<quint32> context_ids;
+    context_ids.reserve(d->contexts.count());
+    for (int i = 0; i < d->contexts.count(); ++i)
+        context_ids << d->contexts.at(i).first;
+    return context_ids;
+}
+
 QVariant Qtilities::Core::MultiContextProperty::value(int context_id) const {
-    return (context_map.value((quint32) context_id));
+    const int position = d->indexOf((quint32) context_id);
+    if (position == -1)
+        return QVariant();
+    return d->contexts.at(position).second;
 }
 
 bool Qtilities::Core::MultiContextProperty::setValue(QVariant new_value, int context_id) {
@@ -466,16 +621,16 @@ bool Qtilities::Core::MultiContextProperty::setValue(QVariant new_value, int con
         return false;
     if (!new_value.isValid())
         return false;
-    context_map[(quint32) context_id] = new_value;
-    last_change_context = context_id;
+    d->insert((quint32) context_id,new_value);
+    d->last_change_context = context_id;
     return true;
 }
 
 QString Qtilities::Core::MultiContextProperty::valueString() const {
     QStringList value_strings;
-    for (int i = 0; i < context_map.count(); ++i) {
-        if (QtilitiesProperty::isExportableVariant(context_map.values().at(i)))
-            value_strings << context_map.values().at(i).toString();
+    for (int i = 0; i < d->contexts.count(); ++i) {
+        if (QtilitiesProperty::isExportableVariant(d->contexts.at(i).second))
+            value_strings << d->contexts.at(i).second.toString();
         else
             value_strings << QObject::tr("Non-exportable variant");
     }
@@ -483,21 +638,27 @@ QString Qtilities::Core::MultiContextProperty::valueString() const {
 }
 
 int Qtilities::Core::MultiContextProperty::lastChangedContext() const {
-    return last_change_context;
+    return d->last_change_context;
 }
 
 bool Qtilities::Core::MultiContextProperty::hasContext(int context_id) const {
-    return context_map.contains((quint32) context_id);
+    return d->indexOf((quint32) context_id) != -1;
 }
 
 void Qtilities::Core::MultiContextProperty::removeContext(int context_id) {
-    last_change_context = context_id;
-    context_map.remove((quint32) context_id);
+    const int position = d.constData()->indexOf((quint32) context_id);
+    d->last_change_context = context_id;
+    if (position != -1)
+        d->contexts.remove(position);
 }
 
 void Qtilities::Core::MultiContextProperty::addContext(QVariant new_value, int context_id) {
-    if (!context_map.contains((quint32) context_id))
-        context_map[context_id] = new_value;
+    // Only detach when the context is added:
+    const int position = d.constData()->lowerBound((quint32) context_id);
+    const QVector<QPair<quint32,QVariant> >& contexts = d.constData()->contexts;
+    if (position < contexts.count() && contexts.at(position).first == (quint32) context_id)
+        return;
+    d->contexts.insert(position,qMakePair((quint32) context_id,new_value));
 }
 
 Qtilities::Core::Interfaces::IExportable::ExportModeFlags Qtilities::Core::MultiContextProperty::supportedFormats() const {
@@ -516,6 +677,15 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Mul
     if (result == IExportable::Failed)
         return result;
 
+    if (CompactBinaryFormat::isActive(stream)) {
+        CompactBinaryFormat::writeVarUInt(stream,d->contexts.count());
+        for (int i = 0; i < d->contexts.count(); ++i) {
+            CompactBinaryFormat::writeVarUInt(stream,d->contexts.at(i).first);
+            stream << d->contexts.at(i).second;
+        }
+        return result;
+    }
+
     stream << contextMap();
     stream << MARKER_OBSERVER_PROPERTY;
     return result;
@@ -530,8 +700,26 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Mul
     if (result == IExportable::Failed)
         return result;
 
+    d->last_change_context = -1;
+    if (CompactBinaryFormat::isActive(stream)) {
+        d->contexts.clear();
+        quint64 count = CompactBinaryFormat::readVarUInt(stream);
+        for (quint64 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+            quint32 context = CompactBinaryFormat::readVarUInt(stream);
+            QVariant value;
+            stream >> value;
+            d->insert(context,value);
+        }
+        if (stream.status() != QDataStream::Ok) {
+            LOG_ERROR("MultiContextProperty binary import failed to read compact context data. Import will fail.");
+            return IExportable::Failed;
+        }
+        return result;
+    }
+
+    QMap<quint32,QVariant> context_map;
     stream >> context_map;
-    last_change_context = -1;
+    d->setContextMap(context_map);
 
     quint32 ui32;
     stream >> ui32;
@@ -548,9 +736,9 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Mul
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    for (int i = 0; i < context_map.count(); ++i) {
-        if (!isExportableVariant(context_map.values().at(i))) {
-            LOG_DEBUG("Failed to export MultiContextProperty. It contains a QVariant which cannot be converted to a QString(). Type name: " + QString(context_map.values().at(i).typeName()));
+    for (int i = 0; i < d->contexts.count(); ++i) {
+        if (!isExportableVariant(d->contexts.at(i).second)) {
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreLogTag,"Failed to export MultiContextProperty. It contains a QVariant which cannot be converted to a QString(). Type name: " + QString(d->contexts.at(i).second.typeName()));
             return IExportable::Incomplete;
         }
     }
@@ -559,16 +747,17 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Mul
     if (result == IExportable::Failed)
         return result;
 
-    object_node->setAttribute("Count",context_map.count());
-    for (int i = 0; i < context_map.count(); ++i) {
+    object_node->setAttribute("Count",d->contexts.count());
+    for (int i = 0; i < d->contexts.count(); ++i) {
+        const QVariant& context_value = d->contexts.at(i).second;
         QDomElement context_element = doc->createElement("Context_" + QString::number(i));
         object_node->appendChild(context_element);
-        context_element.setAttribute("ID",QString::number(context_map.keys().at(i)));
-        context_element.setAttribute("Type",context_map.values().at(i).typeName());
-        if (context_map.values().at(i).type() == QVariant::StringList)
-            context_element.setAttribute("Value",context_map.values().at(i).toStringList().join(","));
+        context_element.setAttribute("ID",QString::number(d->contexts.at(i).first));
+        context_element.setAttribute("Type",context_value.typeName());
+        if (context_value.type() == QVariant::StringList)
+            context_element.setAttribute("Value",context_value.toStringList().join(","));
         else
-            context_element.setAttribute("Value",context_map.values().at(i).toString());
+            context_element.setAttribute("Value",context_value.toString());
     }
 
     return result;
@@ -579,7 +768,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Mul
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
-    context_map.clear();
+    d->contexts.clear();
 
     IExportable::ExportResultFlags  result = QtilitiesProperty::importXml(doc,object_node,import_list);
     if (result == IExportable::Failed)
@@ -598,7 +787,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Mul
                 int observer_id = prop.attribute("ID").toInt();
                 QString type_string = prop.attribute("Type");
                 QString value_string = prop.attribute("Value");
-                context_map[observer_id] = constructVariant(type_string,value_string);
+                d->insert(observer_id,constructVariant(type_string,value_string));
             } else
                 result = IExportable::Incomplete;
             continue;
@@ -608,6 +797,69 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Mul
     return result;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::MultiContextProperty::exportXmlStream(QXmlStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    for (int i = 0; i < d->contexts.count(); ++i) {
+        if (!isExportableVariant(d->contexts.at(i).second)) {
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreLogTag,"Failed to export MultiContextProperty. It contains a QVariant which cannot be converted to a QString(). Type name: " + QString(d->contexts.at(i).second.typeName()));
+            return IExportable::Incomplete;
+        }
+    }
+
+    IExportable::ExportResultFlags result = QtilitiesProperty::exportXmlStream(writer);
+    if (result == IExportable::Failed)
+        return result;
+
+    writer->writeAttribute("Count",QString::number(d->contexts.count()));
+    for (int i = 0; i < d->contexts.count(); ++i) {
+        const QVariant& context_value = d->contexts.at(i).second;
+        writer->writeStartElement("Context_" + QString::number(i));
+        writer->writeAttribute("ID",QString::number(d->contexts.at(i).first));
+        writer->writeAttribute("Type",context_value.typeName());
+        if (context_value.type() == QVariant::StringList)
+            writer->writeAttribute("Value",context_value.toStringList().join(","));
+        else
+            writer->writeAttribute("Value",context_value.toString());
+        writer->writeEndElement();
+    }
+
+    return result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::MultiContextProperty::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    Q_UNUSED(import_list)
+
+    if (!reader || !reader->isStartElement())
+        return IExportable::Failed;
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported) {
+        reader->skipCurrentElement();
+        return version_check_result;
+    }
+
+    d->contexts.clear();
+    importXmlAttributes(reader->attributes());
+
+    IExportable::ExportResultFlags result = IExportable::Complete;
+    while (reader->readNextStartElement()) {
+        if (reader->name().startsWith(QLatin1String("Context_"))) {
+            QXmlStreamAttributes attributes = reader->attributes();
+            if (attributes.hasAttribute("Type") && attributes.hasAttribute("Value")) {
+                int observer_id = attributes.value("ID").toString().toInt();
+                d->insert(observer_id,constructVariant(attributes.value("Type").toString(),attributes.value("Value").toString()));
+            } else
+                result = IExportable::Incomplete;
+        }
+        reader->skipCurrentElement();
+    }
+
+    return result;
+}
+
 // ------------------------------------------
 // SharedProperty
 // ------------------------------------------
@@ -696,7 +948,8 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Sha
         return result;
 
     stream << property_value;
-    stream << MARKER_OBSERVER_PROPERTY;
+    if (!CompactBinaryFormat::isActive(stream))
+        stream << MARKER_OBSERVER_PROPERTY;
     return result;
 }
 
@@ -710,6 +963,8 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Sha
         return result;
 
     stream >> property_value;
+    if (CompactBinaryFormat::isActive(stream))
+        return result;
 
     quint32 ui32;
     stream >> ui32;
@@ -727,7 +982,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Sha
         return version_check_result;
 
     if (!isExportableVariant(property_value)) {
-        LOG_DEBUG("Failed to export SharedProperty. It contains a QVariant which cannot be converted to a QString(). Type name: " + QString(property_value.typeName()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreLogTag,"Failed to export SharedProperty. It contains a QVariant which cannot be converted to a QString(). Type name: " + QString(property_value.typeName()));
         return IExportable::Incomplete;
     }
 
@@ -763,6 +1018,52 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Sha
     return result;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::SharedProperty::exportXmlStream(QXmlStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (!isExportableVariant(property_value)) {
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreLogTag,"Failed to export SharedProperty. It contains a QVariant which cannot be converted to a QString(). Type name: " + QString(property_value.typeName()));
+        return IExportable::Incomplete;
+    }
+
+    IExportable::ExportResultFlags result = QtilitiesProperty::exportXmlStream(writer);
+    if (result == IExportable::Failed)
+        return result;
+
+    writer->writeAttribute("Type",property_value.typeName());
+    if (property_value.type() == QVariant::StringList)
+        writer->writeAttribute("Value",property_value.toStringList().join(","));
+    else
+        writer->writeAttribute("Value",property_value.toString());
+
+    return result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::SharedProperty::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    Q_UNUSED(import_list)
+
+    if (!reader || !reader->isStartElement())
+        return IExportable::Failed;
+
+    // Shared properties only have attributes:
+    QXmlStreamAttributes attributes = reader->attributes();
+    reader->skipCurrentElement();
+
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    importXmlAttributes(attributes);
+    if (attributes.hasAttribute("Type") && attributes.hasAttribute("Value"))
+        property_value = constructVariant(attributes.value("Type").toString(),attributes.value("Value").toString());
+    else
+        return IExportable::Incomplete;
+
+    return IExportable::Complete;
+}
+
 QDataStream & operator<< (QDataStream& stream, const Qtilities::Core::MultiContextProperty& stream_obj) {
     stream_obj.exportBinary(stream);
     return stream;
@@ -796,16 +1097,18 @@ QDebug operator<<(QDebug dbg, const Qtilities::Core::SharedProperty &prop) {
 
 QDebug operator<<(QDebug dbg, const Qtilities::Core::MultiContextProperty &prop) {
     dbg.nospace() << "(Multi Context Property: " << prop.propertyNameString() << ")";
-    for (int i = 0; i < prop.contextMap().count(); ++i) {
-        QString context_name = QString::number(prop.contextMap().keys().at(i));
-        Qtilities::Core::Observer* obs = OBJECT_MANAGER->observerReference(prop.contextMap().keys().at(i));
+    QList<quint32> context_ids = prop.contextIds();
+    for (int i = 0; i < context_ids.count(); ++i) {
+        QString context_name = QString::number(context_ids.at(i));
+        Qtilities::Core::Observer* obs = OBJECT_MANAGER->observerReference(context_ids.at(i));
         if (obs)
             context_name = obs->observerName();
 
-        if (Qtilities::Core::QtilitiesProperty::isExportableVariant(prop.contextMap().values().at(i)))
+        QVariant context_value = prop.value(context_ids.at(i));
+        if (Qtilities::Core::QtilitiesProperty::isExportableVariant(context_value))
             dbg.nospace() << "(Context: " << context_name << ", Value: Non exportable variant type)";
         else
-            dbg.nospace() << "(Context: " << context_name << ", Value: " << prop.contextMap().values().at(i).toString() << ")";
+            dbg.nospace() << "(Context: " << context_name << ", Value: " << context_value.toString() << ")";
     }
 
     return dbg.space();
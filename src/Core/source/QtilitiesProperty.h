@@ -16,6 +16,7 @@
 #include <QMap>
 #include <QVariant>
 #include <QMetaType>
+#include <QSharedDataPointer>
 
 #include "QtilitiesCore_global.h"
 #include "Qtilities.h"
@@ -145,6 +146,8 @@ namespace Qtilities {
                 virtual IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
                 virtual IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
                 virtual IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+                virtual IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+                virtual IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
                 //! Converts a QString type_string and QString value_string to a matching QVariant.
                 static QVariant constructVariant(const QString& type_string, const QString& value_string);
@@ -154,6 +157,12 @@ namespace Qtilities {
                 static bool isExportableVariant(QVariant variant);
 
             protected:
+                //! Reads the attributes written by exportXml() and exportXmlStream() from \p attributes.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                void importXmlAttributes(const QXmlStreamAttributes& attributes);
+
                 QString                 name;
                 bool                    is_reserved;
                 bool                    read_only;
@@ -161,6 +170,12 @@ namespace Qtilities {
                 bool                    supports_change_notifications;
             };
 
+        /*!
+        \struct MultiContextPropertyPrivateData
+        \brief Structure used by MultiContextProperty to store its implicitly shared context values.
+          */
+        struct MultiContextPropertyPrivateData;
+
         /*!
         \class Qtilities::Core::MultiContextProperty
         \brief A MultiContextProperty provides a property which has different values in different contexts.
@@ -215,6 +230,11 @@ if (prop.isValid() && prop.canConvert<MultiContextProperty>()) {
 
         For more information about how MultiContextProperty are used in the context of Qtilities::Core::Observer, please see \ref qtilities_properties.
 
+        The context values are implicitly shared between copies of a MultiContextProperty and they are only copied when a copy is changed, thus
+        getting a property from an object using ObjectManager::getMultiContextProperty() is cheap. The values are stored in a vector sorted by
+        context ID since most objects only have a few contexts. To get or set the value of a single context on an object, use
+        ObjectManager::getMultiContextPropertyValue() and ObjectManager::setMultiContextPropertyValue() which do not copy the property.
+
         Note that you can inspect all MultiContextProperty properties on an object through the Qtilities::CoreGui::ObjectDynamicPropertyBrowser widget.
         See the \p qti.core.CategoryMap property as an example below:
 
@@ -235,7 +255,20 @@ if (prop.isValid() && prop.canConvert<MultiContextProperty>()) {
             bool operator!=(const MultiContextProperty& other) const;
 
             //! Returns a map with the contexts and their respective values for this property.
+            /*!
+              \note The map is constructed when this function is called, use contextCount(), contextIds() or value() where possible.
+              */
             QMap<quint32,QVariant> contextMap() const;
+            //! Returns the number of contexts in which this property is defined.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int contextCount() const;
+            //! Returns the IDs of the contexts in which this property is defined, sorted in ascending order.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<quint32> contextIds() const;
             //! Returns the value of the property.
             /*!
               \param context_id Indicates the context ID for which the property value is required.
@@ -286,10 +319,11 @@ if (prop.isValid() && prop.canConvert<MultiContextProperty>()) {
               This function will add a set of attributes directly to the object_node passed to it.
               */
             virtual IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            virtual IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            virtual IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
-        protected:
-            QMap<quint32,QVariant>  context_map;
-            int                     last_change_context;
+        private:
+            QSharedDataPointer<MultiContextPropertyPrivateData> d;
         };
 
         /*!
@@ -387,6 +421,8 @@ if (prop.isValid() && prop.canConvert<SharedProperty>()) {
               This function will add a set of attributes directly to the object_node passed to it.
               */
             virtual IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            virtual IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            virtual IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
         private:
             QVariant property_value;
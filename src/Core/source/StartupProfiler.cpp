@@ -0,0 +1,156 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "StartupProfiler.h"
+#include "TraceEventWriter_p.h"
+
+#include <Logger>
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+
+using namespace Qtilities::Logging;
+
+struct Qtilities::Core::StartupProfilerPrivateData {
+    StartupProfilerPrivateData() : is_enabled(1),
+        maximum_spans(10000),
+        main_thread_id(0) {}
+
+    QAtomicInt                  is_enabled;
+    QElapsedTimer               timer;
+    mutable QMutex              mutex;
+    QList<StartupProfileSpan>   spans;
+    int                         maximum_spans;
+    quint64                     main_thread_id;
+};
+
+Qtilities::Core::StartupProfiler* Qtilities::Core::StartupProfiler::m_Instance = 0;
+
+Qtilities::Core::StartupProfiler* Qtilities::Core::StartupProfiler::instance() {
+    static QMutex mutex;
+    if (!m_Instance)
+    {
+        mutex.lock();
+
+        if (!m_Instance)
+            m_Instance = new StartupProfiler;
+
+        mutex.unlock();
+    }
+
+    return m_Instance;
+}
+
+Qtilities::Core::StartupProfiler::StartupProfiler() {
+    d = new StartupProfilerPrivateData;
+    d->timer.start();
+    d->main_thread_id = (quint64) (quintptr) QThread::currentThreadId();
+}
+
+Qtilities::Core::StartupProfiler::~StartupProfiler() {
+    delete d;
+}
+
+void Qtilities::Core::StartupProfiler::setEnabled(bool is_enabled) {
+    d->is_enabled.fetchAndStoreOrdered(is_enabled ? 1 : 0);
+}
+
+bool Qtilities::Core::StartupProfiler::isEnabled() const {
+    return d->is_enabled.fetchAndAddOrdered(0) != 0;
+}
+
+void Qtilities::Core::StartupProfiler::setMaximumSpans(int maximum) {
+    QMutexLocker locker(&d->mutex);
+    d->maximum_spans = qMax(0,maximum);
+    while (d->spans.count() > d->maximum_spans)
+        d->spans.removeLast();
+}
+
+int Qtilities::Core::StartupProfiler::maximumSpans() const {
+    QMutexLocker locker(&d->mutex);
+    return d->maximum_spans;
+}
+
+qint64 Qtilities::Core::StartupProfiler::elapsed() const {
+    return d->timer.nsecsElapsed() / 1000;
+}
+
+void Qtilities::Core::StartupProfiler::recordSpan(const QString& name, const QString& category, qint64 start, qint64 end) {
+    if (!isEnabled())
+        return;
+
+    StartupProfileSpan span;
+    span.name = name;
+    span.category = category;
+    span.start = start;
+    span.duration = qMax(Q_INT64_C(0),end - start);
+    span.thread_id = (quint64) (quintptr) QThread::currentThreadId();
+
+    QMutexLocker locker(&d->mutex);
+    if (d->spans.count() < d->maximum_spans)
+        d->spans << span;
+}
+
+QList<Qtilities::Core::StartupProfileSpan> Qtilities::Core::StartupProfiler::spans() const {
+    QMutexLocker locker(&d->mutex);
+    return d->spans;
+}
+
+void Qtilities::Core::StartupProfiler::clear() {
+    QMutexLocker locker(&d->mutex);
+    d->spans.clear();
+}
+
+bool Qtilities::Core::StartupProfiler::exportTrace(const QString& file_name) const {
+    TraceEventWriter writer(file_name);
+    if (!writer.open(d->main_thread_id)) {
+        LOG_ERROR(QString("Startup Profiler: Failed to open file for startup profile export: %1").arg(file_name));
+        return false;
+    }
+
+    // Complete events of the same thread nest according to their times, thus spans can be written in any order:
+    const QList<StartupProfileSpan> recorded_spans = spans();
+    for (int i = 0; i < recorded_spans.count(); ++i) {
+        const StartupProfileSpan& span = recorded_spans.at(i);
+        writer.writeEvent("\"name\":" + TraceEventWriter::jsonString(span.name) + ",\"cat\":" + TraceEventWriter::jsonString(span.category)
+                          + QString(",\"ph\":\"X\",\"ts\":%1,\"dur\":%2,\"tid\":%3").arg(span.start).arg(span.duration).arg(span.thread_id));
+    }
+
+    if (!writer.close()) {
+        LOG_ERROR(QString("Startup Profiler: Failed to write startup profile to file: %1").arg(file_name));
+        return false;
+    }
+    return true;
+}
+
+// -----------------------------------
+// StartupProfileScope
+// -----------------------------------
+Qtilities::Core::StartupProfileScope::StartupProfileScope(const QString& name, const QString& category) : d_start(-1) {
+    StartupProfiler* profiler = StartupProfiler::instance();
+    if (!profiler->isEnabled())
+        return;
+
+    d_name = name;
+    d_category = category;
+    d_start = profiler->elapsed();
+}
+
+Qtilities::Core::StartupProfileScope::~StartupProfileScope() {
+    if (d_start < 0)
+        return;
+
+    StartupProfiler* profiler = StartupProfiler::instance();
+    profiler->recordSpan(d_name,d_category,d_start,profiler->elapsed());
+}
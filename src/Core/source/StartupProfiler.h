@@ -0,0 +1,135 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef STARTUP_PROFILER_H
+#define STARTUP_PROFILER_H
+
+#include "QtilitiesCore_global.h"
+
+#include <QList>
+#include <QString>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \struct StartupProfileSpan
+        \brief A span of time recorded by the StartupProfiler.
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct QTILIITES_CORE_SHARED_EXPORT StartupProfileSpan {
+            StartupProfileSpan() : start(0), duration(0), thread_id(0) {}
+
+            //! The name of the span, for example the name of the plugin which was initialized.
+            QString     name;
+            //! The category of the span, for example "initialize()".
+            QString     category;
+            //! The start of the span in microseconds, relative to the construction of the profiler.
+            qint64      start;
+            //! The duration of the span in microseconds.
+            qint64      duration;
+            //! The thread on which the span was recorded.
+            quint64     thread_id;
+        };
+
+        /*!
+        \struct StartupProfilerPrivateData
+        \brief Structure used by StartupProfiler to store private data.
+          */
+        struct StartupProfilerPrivateData;
+
+        /*!
+        \class StartupProfiler
+        \brief The StartupProfiler class records high resolution timing spans of the steps taken while an application starts up.
+
+        The profiler is always available and is enabled by default. %Qtilities records the loading and initialization of plugins in
+        Qtilities::ExtensionSystem::ExtensionSystemCore::initialize(), the construction of configuration pages and the setup of the main
+        window. Applications can record their own steps using StartupProfileScope:
+
+\code
+{
+    StartupProfileScope scope("Open Last Project","Application");
+    PROJECT_MANAGER->openLastProject();
+}
+\endcode
+
+        Recording a span takes a short lock, and at most maximumSpans() spans are kept. Applications which do not want to record spans
+        once they started up can call setEnabled(false), in which case StartupProfileScope does not do any work.
+
+        The recorded spans are shown in the debug plugin, and can be exported in the Chrome trace event format using exportTrace().
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT StartupProfiler
+        {
+        public:
+            static StartupProfiler* instance();
+            ~StartupProfiler();
+
+            //! Enables or disables the recording of spans. Enabled by default.
+            void setEnabled(bool is_enabled);
+            //! Indicates if spans are recorded.
+            bool isEnabled() const;
+            //! Sets the maximum number of spans which are kept. Spans recorded once this number is reached are discarded. Default is 10000.
+            void setMaximumSpans(int maximum);
+            //! Gets the maximum number of spans which are kept.
+            int maximumSpans() const;
+
+            //! The number of microseconds since the profiler was constructed.
+            qint64 elapsed() const;
+            //! Records a span which started at \p start and ended at \p end, both as returned by elapsed(). This function is thread-safe.
+            void recordSpan(const QString& name, const QString& category, qint64 start, qint64 end);
+            //! The recorded spans, in the order in which they ended.
+            QList<StartupProfileSpan> spans() const;
+            //! Removes all recorded spans.
+            void clear();
+
+            //! Exports the recorded spans in the Chrome trace event format to \p file_name.
+            /*!
+              The file can be opened in chrome://tracing or in Perfetto.
+
+              \returns True when the file was written successfully.
+              */
+            bool exportTrace(const QString& file_name) const;
+
+        private:
+            StartupProfiler();
+            Q_DISABLE_COPY(StartupProfiler)
+
+            static StartupProfiler* m_Instance;
+            StartupProfilerPrivateData* d;
+        };
+
+        /*!
+        \class StartupProfileScope
+        \brief The StartupProfileScope class records a StartupProfiler span for the lifetime of the scope in which it is constructed.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT StartupProfileScope
+        {
+        public:
+            //! Starts a span named \p name in \p category.
+            StartupProfileScope(const QString& name, const QString& category);
+            //! Ends the span and records it in the StartupProfiler.
+            ~StartupProfileScope();
+
+        private:
+            Q_DISABLE_COPY(StartupProfileScope)
+
+            QString d_name;
+            QString d_category;
+            qint64  d_start;
+        };
+    }
+}
+
+#endif // STARTUP_PROFILER_H
@@ -59,7 +59,7 @@ bool Qtilities::Core::SubjectFilterTemplate::initializeAttachment(QObject* obj,
     if (!observer) {
         if (rejectMsg)
             *rejectMsg = QString(tr("Cannot evaluate an attachment in a subject filter without an observer context."));
-        LOG_TRACE("Cannot evaluate an attachment in a subject filter without an observer context.");
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Cannot evaluate an attachment in a subject filter without an observer context.");
         return false;
     }
 
@@ -13,6 +13,7 @@
 #define SUBJECT_ITERATOR_H
 
 #include <QObject>
+#include <QPointer>
 #include <QString>
 
 #include <QtilitiesLogging>
@@ -139,7 +140,10 @@ while (itrB.hasNext()) {
                             const Observer* observer = 0,
                             int iterator_id = -1) :
                 d_root(subject),
-                d_parent_observer(observer)
+                d_parent_observer(observer),
+                d_context(0),
+                d_index(-1),
+                d_context_revision(0)
             {
                 d_current = subject;
                 if (iterator_id == -1)
@@ -159,16 +163,17 @@ while (itrB.hasNext()) {
                             ObserverIterationLevel iteration_level,
                             const Observer* sibling_iteration_parent_observer = 0,
                             int iterator_id = -1) :
+                d_current(0),
                 d_root(0),
-                d_parent_observer(observer)
+                d_parent_observer(observer),
+                d_context(0),
+                d_index(-1),
+                d_context_revision(0)
             {
                 if (iteration_level == IterateChildren) {
-                    QList<QObject*> subjects = observer->subjectReferences();
-                    if (subjects.count() > 0) {
-                        d_current = qobject_cast<T*>(subjects[0]);
-                        d_root = qobject_cast<T*>(subjects[0]);
-                    } else
-                        d_current = 0;
+                    d_context = const_cast<Observer*> (observer);
+                    d_root = moveTo(0);
+                    d_context_revision = observer->subjectsRevision();
                 } else if (iteration_level == IterateSiblings) {
                     d_current = observer;
                     d_parent_observer = sibling_iteration_parent_observer;
@@ -182,21 +187,13 @@ while (itrB.hasNext()) {
             }
 
             T* first() {
-                QList<QObject*> subjects = getSubjects(getParent());
-                if(subjects.count() != 0)
-                    d_current = qobject_cast<T*>(subjects[0]);
-                else
-                    d_current = NULL;
-                return const_cast<T*> (d_current);
+                updatePosition();
+                return const_cast<T*> (moveTo(0));
             }
 
             T* last() {
-                QList<QObject*> subjects = getSubjects(getParent());
-                if(subjects.count() != 0)
-                    d_current = qobject_cast<T*>(subjects[subjects.count() - 1]);
-                else
-                    d_current = NULL;
-                return const_cast<T*> (d_current);
+                updatePosition();
+                return const_cast<T*> (moveTo(d_context ? d_context->subjectCount() - 1 : -1));
             }
 
             T* current() const {
@@ -205,35 +202,34 @@ while (itrB.hasNext()) {
 
             void setCurrent(const T* current) {
                 d_current = current;
+                // The iteration context is kept when current is observed in it:
+                if (current && d_context && d_context_revision == d_context->subjectsRevision()) {
+                    d_index = d_context->subjectPosition(current);
+                    if (d_index != -1)
+                        return;
+                }
+                d_context = 0;
+                d_index = -1;
             }
 
             T* next() {
-                QList<QObject*> subjects = getSubjects(getParent());
-                int current_index = getCurrentIndex(subjects);
-
-                // The subject was found:
-                if (current_index != -1) {
-                    // Check if there is another subject after this one:
-                    if (current_index < (subjects.count() - 1)) {
-                        d_current = qobject_cast<T*>(subjects[current_index + 1]);
-                        return const_cast<T*> (d_current);
-                    }
-                }
-
-                d_current = 0;
-                return const_cast<T*> (d_current);
+                updatePosition();
+                return const_cast<T*> (moveTo(d_index == -1 ? -1 : d_index + 1));
             }
 
             T* previous() {
-                QList<QObject*> subjects = getSubjects(getParent());
-                int current_index = getCurrentIndex(subjects);
-                if (current_index > 0) {
-                    d_current = qobject_cast<T*>(subjects[current_index - 1]);
-                    return const_cast<T*> (d_current);
-                }
+                updatePosition();
+                return const_cast<T*> (moveTo(d_index - 1));
+            }
 
-                d_current = NULL;
-                return const_cast<T*> (d_current);
+            bool hasNext() {
+                updatePosition();
+                return d_index != -1 && subjectAt(d_index + 1);
+            }
+
+            bool hasPrevious() {
+                updatePosition();
+                return d_index != -1 && subjectAt(d_index - 1);
             }
 
             Observer* iterationContext() const {
@@ -291,11 +287,50 @@ while (itrB.hasNext()) {
                 return subjects.indexOf(const_cast<QObject*>(obj));
             }
 
+            //! Looks up the observer in which the current subject is iterated and the position of the subject in it.
+            /*!
+              Nothing is looked up when subjects were not attached to or detached from the observer since the previous lookup, see Observer::subjectsRevision().
+              Thus stepping through the subjects of an observer does not copy or search its subjects.
+              */
+            void updatePosition() {
+                if (d_context && d_context_revision == d_context->subjectsRevision())
+                    return;
+
+                if (d_current)
+                    d_context = const_cast<Observer*> (getParent());
+                d_index = -1;
+                if (d_context) {
+                    if (d_current)
+                        d_index = d_context->subjectPosition(d_current);
+                    d_context_revision = d_context->subjectsRevision();
+                }
+            }
+
+            //! Returns the subject at \p index in the iteration context, or 0 if there is no such subject of type T.
+            const T* subjectAt(int index) const {
+                if (!d_context || index < 0 || index >= d_context->subjectCount())
+                    return 0;
+                return qobject_cast<T*>(d_context->subjectAt(index));
+            }
+
+            //! Makes the subject at \p index in the iteration context the current subject.
+            const T* moveTo(int index) {
+                d_current = subjectAt(index);
+                d_index = d_current ? index : -1;
+                return d_current;
+            }
+
         private:
             const T* d_current;
             const T* d_root;
             const Observer* d_parent_observer;
             int d_iterator_id;
+            //! The observer in which d_current is iterated, found by updatePosition().
+            QPointer<Observer> d_context;
+            //! The position of d_current in d_context, -1 when d_current is not observed in d_context.
+            int d_index;
+            //! The Observer::subjectsRevision() of d_context when d_index was looked up.
+            int d_context_revision;
         };
 
         // -----------------------------------------------
@@ -329,7 +364,10 @@ while (itrB.hasNext()) {
                                  Observer* observer = 0,
                                  int iterator_id = -1) :
                 d_root(subject),
-                d_parent_observer(observer)
+                d_parent_observer(observer),
+                d_context(0),
+                d_index(-1),
+                d_context_revision(0)
             {
                 d_current = subject;
                 if (iterator_id == -1)
@@ -349,16 +387,17 @@ while (itrB.hasNext()) {
                             ObserverIterationLevel iteration_level,
                             const Observer* sibling_iteration_parent_observer = 0,
                             int iterator_id = -1) :
+                d_current(0),
                 d_root(0),
-                d_parent_observer(observer)
+                d_parent_observer(observer),
+                d_context(0),
+                d_index(-1),
+                d_context_revision(0)
             {
                 if (iteration_level == IterateChildren) {
-                    QList<QObject*> subjects = observer->subjectReferences();
-                    if (subjects.count() > 0) {
-                        d_current = qobject_cast<T*>(subjects[0]);
-                        d_root = qobject_cast<T*>(subjects[0]);
-                    } else
-                        d_current = 0;
+                    d_context = const_cast<Observer*> (observer);
+                    d_root = moveTo(0);
+                    d_context_revision = observer->subjectsRevision();
                 } else if (iteration_level == IterateSiblings) {
                     d_current = observer;
                     d_parent_observer = sibling_iteration_parent_observer;
@@ -372,21 +411,13 @@ while (itrB.hasNext()) {
             }
 
             const T* first() {
-                QList<QObject*> subjects = getSubjects(getParent());
-                if(subjects.count() != 0)
-                    d_current = qobject_cast<T*>(subjects[0]);
-                else
-                    d_current = NULL;
-                return d_current;
+                updatePosition();
+                return moveTo(0);
             }
 
             const T* last() {
-                QList<QObject*> subjects = getSubjects(getParent());
-                if(subjects.count() != 0)
-                    d_current = qobject_cast<T*>(subjects[subjects.count() - 1]);
-                else
-                    d_current = NULL;
-                return d_current;
+                updatePosition();
+                return moveTo(d_context ? d_context->subjectCount() - 1 : -1);
             }
 
             const T* current() const {
@@ -395,35 +426,34 @@ while (itrB.hasNext()) {
 
             void setCurrent(const T* current) {
                 d_current = current;
+                // The iteration context is kept when current is observed in it:
+                if (current && d_context && d_context_revision == d_context->subjectsRevision()) {
+                    d_index = d_context->subjectPosition(current);
+                    if (d_index != -1)
+                        return;
+                }
+                d_context = 0;
+                d_index = -1;
             }
 
             const T* next() {
-                QList<QObject*> subjects = getSubjects(getParent());
-                int current_index = getCurrentIndex(subjects);
-
-                // The subject was found:
-                if (current_index != -1) {
-                    // Check if there is another subject after this one:
-                    if (current_index < (subjects.count() - 1)) {
-                        d_current = qobject_cast<T*>(subjects[current_index + 1]);
-                        return d_current;
-                    }
-                }
-
-                d_current = NULL;
-                return d_current;
+                updatePosition();
+                return moveTo(d_index == -1 ? -1 : d_index + 1);
             }
 
             const T* previous() {
-                QList<QObject*> subjects = getSubjects(getParent());
-                int current_index = getCurrentIndex(subjects);
-                if (current_index > 0) {
-                    d_current = qobject_cast<T*>(subjects[current_index - 1]);
-                    return d_current;
-                }
+                updatePosition();
+                return moveTo(d_index - 1);
+            }
 
-                d_current = NULL;
-                return d_current;
+            bool hasNext() {
+                updatePosition();
+                return d_index != -1 && subjectAt(d_index + 1);
+            }
+
+            bool hasPrevious() {
+                updatePosition();
+                return d_index != -1 && subjectAt(d_index - 1);
             }
 
             Observer* iterationContext() const {
@@ -481,11 +511,50 @@ while (itrB.hasNext()) {
                 return subjects.indexOf(const_cast<QObject*>(obj));
             }
 
+            //! Looks up the observer in which the current subject is iterated and the position of the subject in it.
+            /*!
+              Nothing is looked up when subjects were not attached to or detached from the observer since the previous lookup, see Observer::subjectsRevision().
+              Thus stepping through the subjects of an observer does not copy or search its subjects.
+              */
+            void updatePosition() {
+                if (d_context && d_context_revision == d_context->subjectsRevision())
+                    return;
+
+                if (d_current)
+                    d_context = const_cast<Observer*> (getParent());
+                d_index = -1;
+                if (d_context) {
+                    if (d_current)
+                        d_index = d_context->subjectPosition(d_current);
+                    d_context_revision = d_context->subjectsRevision();
+                }
+            }
+
+            //! Returns the subject at \p index in the iteration context, or 0 if there is no such subject of type T.
+            const T* subjectAt(int index) const {
+                if (!d_context || index < 0 || index >= d_context->subjectCount())
+                    return 0;
+                return qobject_cast<T*>(d_context->subjectAt(index));
+            }
+
+            //! Makes the subject at \p index in the iteration context the current subject.
+            const T* moveTo(int index) {
+                d_current = subjectAt(index);
+                d_index = d_current ? index : -1;
+                return d_current;
+            }
+
         private:
             const T* d_current;
             const T* d_root;
             const Observer* d_parent_observer;
             int d_iterator_id;
+            //! The observer in which d_current is iterated, found by updatePosition().
+            QPointer<Observer> d_context;
+            //! The position of d_current in d_context, -1 when d_current is not observed in d_context.
+            int d_index;
+            //! The Observer::subjectsRevision() of d_context when d_index was looked up.
+            int d_context_revision;
         };
     }
 }
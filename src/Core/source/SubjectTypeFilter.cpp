@@ -16,6 +16,7 @@
 #include <Logger.h>
 
 #include <QMutex>
+#include <QHash>
 #include <QVariant>
 #include <QDomElement>
 #include <QDomDocument>
@@ -36,6 +37,8 @@ struct Qtilities::Core::SubjectTypeFilterPrivateData {
     bool                    is_modified;
     QList<SubjectTypeInfo>  known_subject_types;
     QString                 known_objects_group_name;
+    //! The evaluation result of each class which was evaluated since the known types last changed.
+    QHash<const QMetaObject*, bool> known_meta_objects;
 };
 
 Qtilities::Core::SubjectTypeFilter::SubjectTypeFilter(const QString& known_objects_group_name, QObject* parent) : AbstractSubjectFilter(parent) {
@@ -52,6 +55,7 @@ SubjectTypeFilter& Qtilities::Core::SubjectTypeFilter::operator=(const SubjectTy
 
     d->inversed_filtering = ref.inverseFilteringEnabled();
     d->known_subject_types = ref.knownSubjectTypes();
+    d->known_meta_objects.clear();
     d->known_objects_group_name = ref.groupName();
 
     return *this;
@@ -89,41 +93,49 @@ AbstractSubjectFilter::EvaluationResult Qtilities::Core::SubjectTypeFilter::eval
     if (!observer) {
         if (rejectMsg)
             *rejectMsg = QString(tr("Subject Type Filter: Cannot evaluate an attachment in a subject filter without an observer context."));
-        LOG_TRACE("Cannot evaluate an attachment in a subject filter without an observer context.");
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Cannot evaluate an attachment in a subject filter without an observer context.");
         return AbstractSubjectFilter::Rejected;
     }
 
+    // All instances of a class give the same result, thus classes are only checked against the known types once:
     bool is_known_type = false;
-    // If inversed and there are no known types is_known_type must be true:
-    if (d->inversed_filtering && d->known_subject_types.count() == 0)
-        is_known_type = true;
-
-    // Check the obj meta info against the known filter types
-    for (int i = 0; i < d->known_subject_types.count(); ++i) {
-        QString meta_type = d->known_subject_types.at(i).d_meta_type;
-        if (obj->inherits(meta_type.toUtf8().data())) {
-            if (!d->inversed_filtering) {
-                is_known_type = true;
-                break;
-            }
-        } else {
-            if (d->inversed_filtering) {
-                is_known_type = true;
-                break;
+    const QMetaObject* meta_object = obj->metaObject();
+    QHash<const QMetaObject*, bool>::const_iterator itr = d->known_meta_objects.constFind(meta_object);
+    if (itr != d->known_meta_objects.constEnd()) {
+        is_known_type = itr.value();
+    } else {
+        // If inversed and there are no known types is_known_type must be true:
+        if (d->inversed_filtering && d->known_subject_types.count() == 0)
+            is_known_type = true;
+
+        // Check the obj meta info against the known filter types
+        for (int i = 0; i < d->known_subject_types.count(); ++i) {
+            QString meta_type = d->known_subject_types.at(i).d_meta_type;
+            if (obj->inherits(meta_type.toUtf8().data())) {
+                if (!d->inversed_filtering) {
+                    is_known_type = true;
+                    break;
+                }
+            } else {
+                if (d->inversed_filtering) {
+                    is_known_type = true;
+                    break;
+                }
             }
         }
+        d->known_meta_objects[meta_object] = is_known_type;
     }
 
     if (!is_known_type) {
         QString msg = QString(tr("Subject filter \"%1\" rejected attachment of object \"%2\" to observer \"%3\". It is not an allowed type in this context.")).arg(filterName()).arg(obj->objectName()).arg(observer->observerName());
         #ifndef QT_NO_DEBUG
         for (int t = 0; t < d->known_subject_types.count(); t++)
-            LOG_TRACE("Allowed types: Meta type: " + d->known_subject_types.at(t).d_meta_type + ", Type description: " + d->known_subject_types.at(t).d_name);
-        LOG_TRACE("Attachment type: " + QString(obj->metaObject()->className()));
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Allowed types: Meta type: " + d->known_subject_types.at(t).d_meta_type + ", Type description: " + d->known_subject_types.at(t).d_name);
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Attachment type: " + QString(obj->metaObject()->className()));
         if (d->inversed_filtering)
-            LOG_TRACE("Inversed filtering status: Enabled");
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Inversed filtering status: Enabled");
         else
-            LOG_TRACE("Inversed filtering status: Disabled");
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,"Inversed filtering status: Disabled");
         #endif
 
         if (rejectMsg)
@@ -173,6 +185,7 @@ void Qtilities::Core::SubjectTypeFilter::addSubjectType(SubjectTypeInfo subject_
     }
 
     d->known_subject_types.append(subject_type_info);
+    d->known_meta_objects.clear();
     setModificationState(true);
 }
 
@@ -202,6 +215,7 @@ void Qtilities::Core::SubjectTypeFilter::enableInverseFiltering(bool enabled) {
         }
 
         d->inversed_filtering = enabled;
+        d->known_meta_objects.clear();
         setModificationState(true);
     }
 }
@@ -251,6 +265,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Sub
     stream >> known_type_count;
     int known_type_count_int = known_type_count;
     d->known_subject_types.clear();
+    d->known_meta_objects.clear();
     for (int i = 0; i < known_type_count_int; ++i) {
         QString meta_type;
         QString name;
@@ -303,6 +318,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Core::Sub
     if (version_check_result != IExportable::VersionSupported)
         return version_check_result;
 
+    d->known_meta_objects.clear();
     if (object_node->hasAttribute("InversedFiltering")) {
         if (object_node->attribute("InversedFiltering") == QString("True"))
             d->inversed_filtering = true;
@@ -11,14 +11,19 @@
 
 #include "Task.h"
 #include "QtilitiesCoreApplication.h"
+#include "TaskMessageRing.h"
 
 #include <LoggerEngines>
 
+#include <QTimer>
+
 using namespace Qtilities::Core::Interfaces;
 using namespace Qtilities::Core;
 
 struct Qtilities::Core::TaskPrivateData {
     TaskPrivateData() : last_error_messages_count(10),
+        last_error_messages_head(0),
+        last_error_messages_size(0),
         task_state(ITask::TaskNotStarted),
         task_busy_state(ITask::TaskBusyClean),
         task_result(ITask::TaskNoResult),
@@ -39,12 +44,19 @@ struct Qtilities::Core::TaskPrivateData {
         logging_enabled_to_console(true),
         clear_log_on_start(true),
         last_run_time(-1),
+        elapsed_time_notification_timer(0),
+        elapsed_time_notifications_active(false),
+        message_ring(0),
+        logger_forwarding_enabled(true),
         parent_task(0) {}
 
     QString                         task_name;
     QString                         task_display_name;
+    //! The last error messages in a circular buffer of last_error_messages_count messages, of which the newest is at last_error_messages_head.
     QVector<QString>                last_error_messages;
     int                             last_error_messages_count;
+    int                             last_error_messages_head;
+    int                             last_error_messages_size;
     ITask::TaskState                task_state;
     ITask::TaskBusyState            task_busy_state;
     ITask::TaskResult               task_result;
@@ -69,7 +81,11 @@ struct Qtilities::Core::TaskPrivateData {
 
     QTime                           timer;
     int                             last_run_time;
-    QTimer                          elapsed_time_notification_timer;
+    //! Only used when the task does not live in the thread of the task manager, otherwise the shared tick of the task manager is used.
+    QTimer*                         elapsed_time_notification_timer;
+    bool                            elapsed_time_notifications_active;
+    TaskMessageRing*                message_ring;
+    bool                            logger_forwarding_enabled;
 
     ITask*                          parent_task;
     QPointer<QObject>               parent_task_base;
@@ -80,13 +96,12 @@ Qtilities::Core::Task::Task(const QString& task_name, bool enable_logging, QObje
     d->task_name = task_name;
     d->logging_enabled = enable_logging;
 
-    d->elapsed_time_notification_timer.setInterval(1000);
-    connect(&d->elapsed_time_notification_timer,SIGNAL(timeout()),SLOT(broadcastElapsedTimeChanged()));
-
     QtilitiesCoreApplication::taskManager()->assignIdToTask(this);
 }
 
 Qtilities::Core::Task::~Task() {
+    stopElapsedTimeNotifications();
+    delete d->message_ring;
     delete d;
 }
 
@@ -112,6 +127,18 @@ int Qtilities::Core::Task::numberOfSubTasks() const {
     return d->number_of_sub_tasks;
 }
 
+void Qtilities::Core::Task::setNumberOfSubTasks(int number_of_sub_tasks) {
+    if (d->number_of_sub_tasks == number_of_sub_tasks)
+        return;
+
+    d->number_of_sub_tasks = number_of_sub_tasks;
+    // Progress is shown relative to the number of sub tasks, thus views showing the progress of a running task are notified through the sub task signals:
+    if (d->task_state == ITask::TaskBusy || d->task_state == ITask::TaskPaused) {
+        emit taskSubTaskAboutToComplete();
+        emit subTaskCompleted(0);
+    }
+}
+
 int Task::elapsedTime() const {
     if (d->task_state == ITask::TaskNotStarted) {
         if (d->last_run_time == -1)
@@ -232,15 +259,14 @@ void Qtilities::Core::Task::setTaskLifeTimeFlags(TaskLifeTimeFlags task_lifetime
 // --------------------------------------------------
 QStringList Task::lastErrorMessages(int count) const {
     QStringList returned_messages;
-    if (count == -1)
-        count = d->last_error_messages.count();
+    if (count == -1 || count > d->last_error_messages_size)
+        count = d->last_error_messages_size;
 
+    // Newest messages first:
     for (int i = 0; i < count; i++) {
-        if (d->last_error_messages.count() < i+1)
-            break;
-
-        if (!d->last_error_messages.at(i).isEmpty())
-            returned_messages.append(d->last_error_messages.at(i));
+        int index = (d->last_error_messages_head - i + d->last_error_messages_count) % d->last_error_messages_count;
+        if (!d->last_error_messages.at(index).isEmpty())
+            returned_messages.append(d->last_error_messages.at(index));
     }
 
     return returned_messages;
@@ -251,8 +277,16 @@ void Task::setLastErrorMessagesStackSize(int size) {
         return;
 
     if (d->last_error_messages_count != size) {
+        // Keep the newest messages which fit in the new stack:
+        QStringList kept_messages = lastErrorMessages(size);
         d->last_error_messages_count = size;
-        d->last_error_messages.resize(size);
+        d->last_error_messages.fill(QString(),size);
+        d->last_error_messages_size = kept_messages.count();
+        d->last_error_messages_head = kept_messages.count() - 1;
+        for (int i = 0; i < kept_messages.count(); ++i)
+            d->last_error_messages[kept_messages.count() - 1 - i] = kept_messages.at(i);
+        if (d->last_error_messages_head < 0)
+            d->last_error_messages_head = size - 1;
     }
 }
 
@@ -282,6 +316,8 @@ void Qtilities::Core::Task::setLoggerEngine(AbstractLoggerEngine* engine) {
 void Qtilities::Core::Task::clearLog() {
     if (d->log_engine)
         d->log_engine->clearLog();
+    if (d->message_ring)
+        d->message_ring->clear();
 }
 
 void Qtilities::Core::Task::setClearLogOnStart(bool clear_log_on_start) const {
@@ -323,6 +359,24 @@ AbstractLoggerEngine* Qtilities::Core::Task::customLoggerEngine() const {
     return d->custom_log_engine;
 }
 
+Qtilities::Core::TaskMessageRing* Qtilities::Core::Task::enableMessageRing(int capacity, int maximum_message_size) {
+    if (!d->message_ring)
+        d->message_ring = new TaskMessageRing(capacity,maximum_message_size);
+    return d->message_ring;
+}
+
+Qtilities::Core::TaskMessageRing* Qtilities::Core::Task::messageRing() const {
+    return d->message_ring;
+}
+
+void Qtilities::Core::Task::setLoggerForwardingEnabled(bool is_enabled) {
+    d->logger_forwarding_enabled = is_enabled;
+}
+
+bool Qtilities::Core::Task::loggerForwardingEnabled() const {
+    return d->logger_forwarding_enabled;
+}
+
 void Qtilities::Core::Task::logMessage(const QString& message, Logger::MessageType type) {
     if (!d->logging_enabled)
         return;
@@ -334,12 +388,31 @@ void Qtilities::Core::Task::logMessage(const QString& message, Logger::MessageTy
 
     if (d->task_state == ITask::TaskBusy && d->last_error_messages_count > 0) {
         if (type == Logger::Error) {
-            if (d->last_error_messages.count() == d->last_error_messages_count)
-                d->last_error_messages.pop_back();
-            d->last_error_messages.push_front(message);
+            if (d->last_error_messages.count() != d->last_error_messages_count)
+                d->last_error_messages.resize(d->last_error_messages_count);
+            d->last_error_messages_head = (d->last_error_messages_head + 1) % d->last_error_messages_count;
+            d->last_error_messages[d->last_error_messages_head] = message;
+            if (d->last_error_messages_size < d->last_error_messages_count)
+                ++d->last_error_messages_size;
         }
     }
 
+    if (d->message_ring)
+        d->message_ring->append(message,type);
+
+    // Messages are stored with the ID of the task in the session log store. Messages of subtasks forwarded to this task keep the ID of the subtask:
+    const int previous_task_id = Log->currentTaskId();
+    if (previous_task_id == -1)
+        Log->setCurrentTaskId(taskID());
+
+    if (!d->logger_forwarding_enabled) {
+        if (parentTask())
+            parentTask()->logMessage(message,type);
+        if (previous_task_id == -1)
+            Log->setCurrentTaskId(-1);
+        return;
+    }
+
     if (d->log_context & Logger::SystemWideMessages)
         Log->logMessage(QString(),type,message);
     if (d->log_context & Logger::PriorityMessages)
@@ -367,6 +440,9 @@ void Qtilities::Core::Task::logMessage(const QString& message, Logger::MessageTy
                 ConsoleLoggerEngine::instance()->logMessage(message,type);
         }
     }
+
+    if (previous_task_id == -1)
+        Log->setCurrentTaskId(-1);
 }
 
 void Qtilities::Core::Task::logError(const QString& message) {
@@ -481,7 +557,7 @@ void Qtilities::Core::Task::resume() {
 
 bool Qtilities::Core::Task::startTask(int expected_subtasks, const QString& message, Logger::MessageType type) {  
     if (d->task_state == ITask::TaskBusy) {
-        LOG_DEBUG("Attempting to start task which is already busy. Task name: " + d->task_name + ", Task ID: " + QString::number(taskID()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::TaskLogTag,"Attempting to start task which is already busy. Task name: " + d->task_name + ", Task ID: " + QString::number(taskID()));
         return false;
     }
 
@@ -507,7 +583,8 @@ bool Qtilities::Core::Task::startTask(int expected_subtasks, const QString& mess
     d->last_run_time = 0;
 
     if (elapsedTimeChangedNotificationsEnabled())
-        d->elapsed_time_notification_timer.start();
+        startElapsedTimeNotifications();
+    QtilitiesCoreApplication::taskManager()->recordTaskTraceEvent(this,TaskTraceEvent::TaskStarted);
 
     emit taskStarted(d->number_of_sub_tasks,message,type);
     emit stateChanged(ITask::TaskBusy,old_state);
@@ -544,6 +621,7 @@ bool Task::pauseTask(const QString &message, Logger::MessageType type) {
     d->task_state = Task::TaskPaused;
 
     logMessage(QString("Task paused (%1).").arg(elapsedTimeString()));
+    QtilitiesCoreApplication::taskManager()->recordTaskTraceEvent(this,TaskTraceEvent::TaskPaused);
 
     emit taskPaused();
     emit stateChanged(state(),current_state);
@@ -559,6 +637,7 @@ bool Task::resumeTask(const QString &message, Logger::MessageType type) {
         logMessage(message,type);
 
     d->task_state = Task::TaskBusy;
+    QtilitiesCoreApplication::taskManager()->recordTaskTraceEvent(this,TaskTraceEvent::TaskResumed);
 
     emit taskResumed();
     emit stateChanged(state(),current_state);
@@ -567,7 +646,7 @@ bool Task::resumeTask(const QString &message, Logger::MessageType type) {
 
 void Qtilities::Core::Task::addCompletedSubTasks(int number_of_sub_tasks, const QString& message, Logger::MessageType type) {
     if (d->task_state != ITask::TaskBusy) {
-        LOG_DEBUG("Attempting to register completed sub-tasks in a task which has not been started. Task name: " + d->task_name + ", Task ID: " + QString::number(taskID()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::TaskLogTag,"Attempting to register completed sub-tasks in a task which has not been started. Task name: " + d->task_name + ", Task ID: " + QString::number(taskID()));
         return;
     }
 
@@ -580,13 +659,14 @@ void Qtilities::Core::Task::addCompletedSubTasks(int number_of_sub_tasks, const
     d->current_progress = d->current_progress + number_of_sub_tasks;
     if (!message.isEmpty())
         logMessage(message,type);
+    QtilitiesCoreApplication::taskManager()->recordTaskTraceEvent(this,TaskTraceEvent::TaskSubTasksCompleted,number_of_sub_tasks);
 
     emit subTaskCompleted(number_of_sub_tasks, message, type);
 }
 
 bool Qtilities::Core::Task::completeTask(ITask::TaskResult result, const QString& message, Logger::MessageType type) {
     if (d->task_state != ITask::TaskBusy && d->task_state != ITask::TaskStopped) {
-        LOG_DEBUG("Attempting to complete task which is not busy. Task name: " + d->task_name + ", Task ID: " + QString::number(taskID()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::TaskLogTag,"Attempting to complete task which is not busy. Task name: " + d->task_name + ", Task ID: " + QString::number(taskID()));
         return false;
     }
 
@@ -618,9 +698,9 @@ bool Qtilities::Core::Task::completeTask(ITask::TaskResult result, const QString
         d->task_state = ITask::TaskCompleted;
     d->task_busy_state = ITask::TaskBusyClean;
 
-    if (elapsedTimeChangedNotificationsEnabled())
-        d->elapsed_time_notification_timer.stop();
+    stopElapsedTimeNotifications();
     d->last_run_time = d->timer.elapsed();
+    QtilitiesCoreApplication::taskManager()->recordTaskTraceEvent(this,d->task_state == ITask::TaskStopped ? TaskTraceEvent::TaskStopped : TaskTraceEvent::TaskCompleted);
 
     // Log information about the result of the task:
     QString task_name_to_log;
@@ -669,3 +749,33 @@ int Qtilities::Core::Task::currentProgress() const {
 void Task::broadcastElapsedTimeChanged() {
     emit taskElapsedTimeChanged(elapsedTime());
 }
+
+void Task::startElapsedTimeNotifications() {
+    if (d->elapsed_time_notifications_active)
+        return;
+    d->elapsed_time_notifications_active = true;
+
+    // Thousands of tasks can be busy at the same time, thus tasks share a single tick instead of using a timer each:
+    TaskManager* task_manager = QtilitiesCoreApplication::taskManager();
+    if (task_manager->thread() == thread()) {
+        task_manager->startElapsedTimeTick(this);
+    } else {
+        if (!d->elapsed_time_notification_timer) {
+            d->elapsed_time_notification_timer = new QTimer(this);
+            d->elapsed_time_notification_timer->setInterval(1000);
+            connect(d->elapsed_time_notification_timer,SIGNAL(timeout()),SLOT(broadcastElapsedTimeChanged()));
+        }
+        d->elapsed_time_notification_timer->start();
+    }
+}
+
+void Task::stopElapsedTimeNotifications() {
+    if (!d->elapsed_time_notifications_active)
+        return;
+    d->elapsed_time_notifications_active = false;
+
+    if (d->elapsed_time_notification_timer)
+        d->elapsed_time_notification_timer->stop();
+    else
+        QtilitiesCoreApplication::taskManager()->stopElapsedTimeTick(this);
+}
@@ -29,6 +29,7 @@ namespace Qtilities {
         \brief Structure used by Task to store private data.
           */
         struct TaskPrivateData;
+        class TaskMessageRing;
 
         /*!
         \class Task
@@ -115,6 +116,14 @@ namespace Qtilities {
             void setDisplayName(const QString& display_name);
             QString displayName() const;
             int numberOfSubTasks() const;
+            //! Changes the number of expected sub tasks while the task is busy, for example when work is added to a task after it was started.
+            /*!
+              When the task is busy or paused, taskSubTaskAboutToComplete() and subTaskCompleted() are emitted with no completed sub tasks, thus
+              views showing the progress of the task are updated.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setNumberOfSubTasks(int number_of_sub_tasks);
             int elapsedTime() const;
             void setLastRunTime(int msec);
             TaskState state() const;
@@ -175,6 +184,36 @@ namespace Qtilities {
             void removeCustomLoggerEngine();
             AbstractLoggerEngine* customLoggerEngine() const;
 
+            //! Creates a message ring in which the most recent messages logged to this task are kept.
+            /*!
+              The ring is created once, calling this function again returns the existing ring. Messages logged using logMessage() are appended to
+              the ring, and in contrast to logMessage() the ring can also be written directly by worker threads through messageRing(), since
+              appending to it is thread-safe and lock-free. Widgets read the messages on demand using TaskMessageRing::messagesSince().
+
+              Call this function before the task is used by worker threads.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            TaskMessageRing* enableMessageRing(int capacity = 256, int maximum_message_size = 512);
+            //! The message ring of this task, or 0 when enableMessageRing() was not called.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            TaskMessageRing* messageRing() const;
+            //! Sets if messages logged to this task are forwarded to the logger, that is to the system wide context, priority messages and logger engines of the task.
+            /*!
+              Enabled by default. Tasks which log large numbers of messages which are only of interest while the task is viewed can disable forwarding,
+              in which case messages are still appended to messageRing(), forwarded to the parent task and emitted using newMessageLogged().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setLoggerForwardingEnabled(bool is_enabled);
+            //! Gets if messages logged to this task are forwarded to the logger.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool loggerForwardingEnabled() const;
+
         signals:
             void newMessageLogged(const QString& message, Logger::MessageType) const;
 
@@ -263,6 +302,9 @@ namespace Qtilities {
         private:
             //! Updates the busy state of the task. Called when messages are logged while the task is busy.
             void updateBusyState(Logger::MessageType type);
+            //! Starts emitting taskElapsedTimeChanged() every second, using the shared tick of the task manager when possible.
+            void startElapsedTimeNotifications();
+            void stopElapsedTimeNotifications();
 
             TaskPrivateData* d;
         };
@@ -0,0 +1,478 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TaskExecutor.h"
+#include "QtilitiesCoreApplication.h"
+#include "TaskManager.h"
+
+#include <PerformanceCounters>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+namespace {
+    enum TaskExecutorEventType {
+        SubTasksCompletedEvent,
+        MessageLoggedEvent,
+        JobFinishedEvent
+    };
+
+    //! Progress reported by a job on a worker thread, which must be applied to its task on the executor's thread.
+    struct TaskExecutorEvent {
+        TaskExecutorEvent() : job(0), event_type(JobFinishedEvent), count(0), message_type(Logger::Info), result(ITask::TaskFailed) {}
+
+        Qtilities::Core::TaskExecutorJob*   job;
+        TaskExecutorEventType               event_type;
+        int                                 count;
+        QString                             message;
+        Logger::MessageType                 message_type;
+        ITask::TaskResult                   result;
+    };
+
+    //! The events posted by the jobs of an executor. The receiver is only notified once until it took the events which were posted.
+    struct TaskExecutorEventQueue {
+        TaskExecutorEventQueue() : receiver(0), notify_pending(false) {}
+
+        void post(const TaskExecutorEvent& event) {
+            QMutexLocker locker(&mutex);
+            events << event;
+            if (!notify_pending) {
+                notify_pending = true;
+                QMetaObject::invokeMethod(receiver,"processJobEvents",Qt::QueuedConnection);
+            }
+        }
+
+        QList<TaskExecutorEvent> take() {
+            QMutexLocker locker(&mutex);
+            QList<TaskExecutorEvent> taken = events;
+            events.clear();
+            notify_pending = false;
+            return taken;
+        }
+
+        QObject*                    receiver;
+        QMutex                      mutex;
+        QList<TaskExecutorEvent>    events;
+        bool                        notify_pending;
+    };
+
+    //! Updates the performance counters which show how busy the executor's threads are.
+    void qti_private_UpdateUtilizationCounters(int running_jobs, int maximum_threads) {
+        QTI_PERFORMANCE_GAUGE("TaskExecutor: Running Jobs",running_jobs);
+        QTI_PERFORMANCE_GAUGE("TaskExecutor: Utilization (%)",maximum_threads > 0 ? qMin(100,(running_jobs * 100) / maximum_threads) : 0);
+    }
+}
+
+struct Qtilities::Core::TaskExecutorJobPrivateData {
+    TaskExecutorJobPrivateData() : queue(0),
+        task_object(0),
+        task_type(ITask::TaskGlobal),
+        expected_subtasks(-1),
+        stop_requested(false),
+        pause_requested(false) {}
+
+    TaskExecutorEventQueue*     queue;
+    //! Only used on the executor's thread.
+    QPointer<Task>              task;
+    //! The task, used as key in TaskExecutorPrivateData::task_jobs after the task was destroyed.
+    QObject*                    task_object;
+    ITask::TaskType             task_type;
+    int                         expected_subtasks;
+
+    //! Protects stop_requested and pause_requested, which are set on the executor's thread and read on the worker thread.
+    mutable QMutex              state_mutex;
+    QWaitCondition              state_changed;
+    bool                        stop_requested;
+    bool                        pause_requested;
+};
+
+namespace Qtilities {
+    namespace Core {
+        //! Runs a job on a thread of the pool, after which the executor is notified that it finished.
+        class TaskExecutorRunnable : public QRunnable
+        {
+        public:
+            TaskExecutorRunnable(TaskExecutorJob* job, TaskExecutorJobPrivateData* job_data) : QRunnable(), job(job), job_data(job_data) {
+                setAutoDelete(true);
+            }
+
+            void run() {
+                TaskExecutorEvent event;
+                event.job = job;
+                event.event_type = JobFinishedEvent;
+
+                bool stop_requested;
+                {
+                    QMutexLocker locker(&job_data->state_mutex);
+                    stop_requested = job_data->stop_requested;
+                }
+                if (!stop_requested) {
+                    TaskManager* task_manager = QtilitiesCoreApplication::taskManager();
+                    task_manager->recordJobTraceEvent(job_data->task_object,TaskTraceEvent::JobStarted);
+                    event.result = job->execute();
+                    task_manager->recordJobTraceEvent(job_data->task_object,TaskTraceEvent::JobFinished);
+                }
+
+                // The job is deleted once the executor processed this event, thus it must not be used after this point:
+                job_data->queue->post(event);
+            }
+
+            TaskExecutorJob*            job;
+            TaskExecutorJobPrivateData* job_data;
+        };
+    }
+}
+
+// -----------------------------------------
+// TaskExecutorJob
+// -----------------------------------------
+Qtilities::Core::TaskExecutorJob::TaskExecutorJob() {
+    d = new TaskExecutorJobPrivateData;
+}
+
+Qtilities::Core::TaskExecutorJob::~TaskExecutorJob() {
+    delete d;
+}
+
+bool Qtilities::Core::TaskExecutorJob::isStopRequested() const {
+    QMutexLocker locker(&d->state_mutex);
+    return d->stop_requested;
+}
+
+bool Qtilities::Core::TaskExecutorJob::waitWhilePaused() {
+    QMutexLocker locker(&d->state_mutex);
+    while (d->pause_requested && !d->stop_requested)
+        d->state_changed.wait(&d->state_mutex);
+    return !d->stop_requested;
+}
+
+void Qtilities::Core::TaskExecutorJob::addCompletedSubTasks(int number_of_sub_tasks, const QString& message, Logger::MessageType type) {
+    if (!d->queue)
+        return;
+
+    TaskExecutorEvent event;
+    event.job = this;
+    event.event_type = SubTasksCompletedEvent;
+    event.count = number_of_sub_tasks;
+    event.message = message;
+    event.message_type = type;
+    d->queue->post(event);
+}
+
+void Qtilities::Core::TaskExecutorJob::logMessage(const QString& message, Logger::MessageType type) {
+    if (!d->queue)
+        return;
+
+    TaskExecutorEvent event;
+    event.job = this;
+    event.event_type = MessageLoggedEvent;
+    event.message = message;
+    event.message_type = type;
+    d->queue->post(event);
+}
+
+// -----------------------------------------
+// TaskExecutor
+// -----------------------------------------
+struct Qtilities::Core::TaskExecutorPrivateData {
+    QThreadPool                         pool;
+    TaskExecutorEventQueue              queue;
+    //! Jobs waiting for the limit of their task type, in the order in which they were submitted.
+    QList<TaskExecutorJob*>             pending_jobs;
+    QList<TaskExecutorJob*>             running_jobs;
+    //! The pending and running jobs, using their tasks as keys.
+    QHash<QObject*,TaskExecutorJob*>    task_jobs;
+    //! The maximum number of concurrent jobs for each task type which is limited.
+    QMap<int,int>                       maximum_concurrent_jobs;
+};
+
+Qtilities::Core::TaskExecutor::TaskExecutor(QObject* parent) : QObject(parent) {
+    d = new TaskExecutorPrivateData;
+    d->queue.receiver = this;
+    setObjectName("Task Executor");
+}
+
+Qtilities::Core::TaskExecutor::~TaskExecutor() {
+    stopAll();
+    d->pool.waitForDone();
+
+    // The jobs which were running finished, thus their events can be dropped:
+    d->queue.take();
+    qDeleteAll(d->running_jobs);
+    delete d;
+}
+
+bool Qtilities::Core::TaskExecutor::submit(Task* task, TaskExecutorJob* job, int expected_subtasks) {
+    if (!job)
+        return false;
+    if (!task) {
+        delete job;
+        return false;
+    }
+    if (d->task_jobs.contains(task) || task->state() == ITask::TaskBusy || task->state() == ITask::TaskPaused) {
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::TaskLogTag,"Task Executor: Attempting to submit a job for a task which is already busy. Task name: " + task->taskName());
+        delete job;
+        return false;
+    }
+
+    job->d->queue = &d->queue;
+    job->d->task = task;
+    job->d->task_object = task;
+    job->d->expected_subtasks = expected_subtasks;
+    d->task_jobs[task] = job;
+
+    connect(task,SIGNAL(stopTaskRequest()),SLOT(handleStopTaskRequest()));
+    connect(task,SIGNAL(pauseTaskRequest()),SLOT(handlePauseTaskRequest()));
+    connect(task,SIGNAL(resumeTaskRequest()),SLOT(handleResumeTaskRequest()));
+    connect(task,SIGNAL(destroyed(QObject*)),SLOT(handleTaskDestroyed(QObject*)));
+
+    d->pending_jobs << job;
+    dispatchPendingJobs();
+    return true;
+}
+
+void Qtilities::Core::TaskExecutor::setMaximumConcurrentJobs(ITask::TaskType task_type, int maximum) {
+    if (maximum < 0)
+        d->maximum_concurrent_jobs.remove(task_type);
+    else
+        d->maximum_concurrent_jobs[task_type] = maximum;
+    dispatchPendingJobs();
+}
+
+int Qtilities::Core::TaskExecutor::maximumConcurrentJobs(ITask::TaskType task_type) const {
+    return d->maximum_concurrent_jobs.value(task_type,-1);
+}
+
+void Qtilities::Core::TaskExecutor::setMaximumThreadCount(int count) {
+    d->pool.setMaxThreadCount(count);
+}
+
+int Qtilities::Core::TaskExecutor::maximumThreadCount() const {
+    return d->pool.maxThreadCount();
+}
+
+int Qtilities::Core::TaskExecutor::activeJobCount() const {
+    return d->running_jobs.count();
+}
+
+int Qtilities::Core::TaskExecutor::pendingJobCount() const {
+    return d->pending_jobs.count();
+}
+
+void Qtilities::Core::TaskExecutor::stopAll() {
+    // Queued jobs were not started, thus their tasks are left as they are:
+    QList<TaskExecutorJob*> pending_jobs = d->pending_jobs;
+    for (int i = 0; i < pending_jobs.count(); ++i)
+        stopJob(pending_jobs.at(i));
+
+    for (int i = 0; i < d->running_jobs.count(); ++i) {
+        TaskExecutorJob* job = d->running_jobs.at(i);
+        {
+            QMutexLocker locker(&job->d->state_mutex);
+            job->d->stop_requested = true;
+            job->d->state_changed.wakeAll();
+        }
+        if (job->d->task && (job->d->task->state() == ITask::TaskBusy || job->d->task->state() == ITask::TaskPaused))
+            job->d->task->stopTask();
+    }
+}
+
+bool Qtilities::Core::TaskExecutor::waitForDone(int msecs) {
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!d->running_jobs.isEmpty() || !d->pending_jobs.isEmpty()) {
+        int remaining = -1;
+        if (msecs >= 0) {
+            remaining = msecs - (int) timer.elapsed();
+            if (remaining < 0)
+                remaining = 0;
+        }
+
+        bool done = d->pool.waitForDone(remaining);
+        // Finishing the jobs which returned dispatches the jobs which are queued:
+        processJobEvents();
+        if (!done || (msecs >= 0 && timer.elapsed() >= msecs))
+            break;
+        // Jobs which are queued while nothing runs are blocked by a limit of 0, thus they will never finish:
+        if (d->running_jobs.isEmpty())
+            break;
+    }
+
+    return d->running_jobs.isEmpty() && d->pending_jobs.isEmpty();
+}
+
+void Qtilities::Core::TaskExecutor::processJobEvents() {
+    QList<TaskExecutorEvent> events = d->queue.take();
+    for (int i = 0; i < events.count(); ++i) {
+        const TaskExecutorEvent& event = events.at(i);
+        if (!d->running_jobs.contains(event.job))
+            continue;
+
+        Task* task = event.job->d->task;
+        bool task_active = task && (task->state() == ITask::TaskBusy || task->state() == ITask::TaskPaused);
+        if (event.event_type == SubTasksCompletedEvent) {
+            if (task_active)
+                task->addCompletedSubTasks(event.count,event.message,event.message_type);
+        } else if (event.event_type == MessageLoggedEvent) {
+            if (task)
+                task->logMessage(event.message,event.message_type);
+        } else if (event.event_type == JobFinishedEvent) {
+            finishJob(event.job,event.result);
+        }
+    }
+
+    dispatchPendingJobs();
+}
+
+void Qtilities::Core::TaskExecutor::stop(Task* task) {
+    TaskExecutorJob* job = d->task_jobs.value(task,0);
+    if (job)
+        stopJob(job);
+}
+
+void Qtilities::Core::TaskExecutor::handleStopTaskRequest() {
+    TaskExecutorJob* job = jobForSender();
+    if (job)
+        stopJob(job);
+}
+
+void Qtilities::Core::TaskExecutor::stopJob(TaskExecutorJob* job) {
+    if (d->pending_jobs.removeOne(job)) {
+        d->task_jobs.remove(job->d->task_object);
+    qti_private_UpdateUtilizationCounters(d->running_jobs.count(),d->pool.maxThreadCount());
+        QPointer<Task> task = job->d->task;
+        delete job;
+        if (task) {
+            task->disconnect(this);
+            emit jobFinished(task,ITask::TaskFailed);
+        }
+        return;
+    }
+
+    {
+        QMutexLocker locker(&job->d->state_mutex);
+        job->d->stop_requested = true;
+        job->d->state_changed.wakeAll();
+    }
+    if (job->d->task)
+        job->d->task->stopTask();
+}
+
+void Qtilities::Core::TaskExecutor::handlePauseTaskRequest() {
+    TaskExecutorJob* job = jobForSender();
+    if (!job || !d->running_jobs.contains(job))
+        return;
+
+    {
+        QMutexLocker locker(&job->d->state_mutex);
+        job->d->pause_requested = true;
+    }
+    if (job->d->task)
+        job->d->task->pauseTask();
+}
+
+void Qtilities::Core::TaskExecutor::handleResumeTaskRequest() {
+    TaskExecutorJob* job = jobForSender();
+    if (!job || !d->running_jobs.contains(job))
+        return;
+
+    {
+        QMutexLocker locker(&job->d->state_mutex);
+        job->d->pause_requested = false;
+        job->d->state_changed.wakeAll();
+    }
+    if (job->d->task)
+        job->d->task->resumeTask();
+}
+
+void Qtilities::Core::TaskExecutor::handleTaskDestroyed(QObject* obj) {
+    TaskExecutorJob* job = d->task_jobs.value(obj,0);
+    if (!job)
+        return;
+
+    if (d->pending_jobs.removeOne(job)) {
+        d->task_jobs.remove(obj);
+        delete job;
+        dispatchPendingJobs();
+        return;
+    }
+
+    // The job is finished as usual once it returned, there is just no task to report to anymore:
+    QMutexLocker locker(&job->d->state_mutex);
+    job->d->stop_requested = true;
+    job->d->state_changed.wakeAll();
+}
+
+void Qtilities::Core::TaskExecutor::dispatchPendingJobs() {
+    int i = 0;
+    while (i < d->pending_jobs.count()) {
+        TaskExecutorJob* job = d->pending_jobs.at(i);
+        if (!job->d->task) {
+            ++i;
+            continue;
+        }
+
+        ITask::TaskType task_type = job->d->task->taskType();
+        int maximum = maximumConcurrentJobs(task_type);
+        if (maximum >= 0) {
+            int running = 0;
+            for (int r = 0; r < d->running_jobs.count(); ++r) {
+                if (d->running_jobs.at(r)->d->task_type == task_type)
+                    ++running;
+            }
+            if (running >= maximum) {
+                ++i;
+                continue;
+            }
+        }
+
+        d->pending_jobs.removeAt(i);
+        job->d->task_type = task_type;
+        startJob(job);
+    }
+}
+
+void Qtilities::Core::TaskExecutor::startJob(TaskExecutorJob* job) {
+    d->running_jobs << job;
+    job->d->task->startTask(job->d->expected_subtasks);
+    d->pool.start(new TaskExecutorRunnable(job,job->d));
+    qti_private_UpdateUtilizationCounters(d->running_jobs.count(),d->pool.maxThreadCount());
+}
+
+void Qtilities::Core::TaskExecutor::finishJob(TaskExecutorJob* job, ITask::TaskResult result) {
+    d->running_jobs.removeOne(job);
+    d->task_jobs.remove(job->d->task_object);
+
+    QPointer<Task> task = job->d->task;
+    delete job;
+
+    if (task) {
+        task->disconnect(this);
+        // When the task was stopped, it was completed already in Task::stopTask():
+        if (task->state() == ITask::TaskBusy || task->state() == ITask::TaskPaused)
+            task->completeTask(result);
+        // The task might delete itself when it completes, depending on its lifetime flags:
+        if (task)
+            emit jobFinished(task,result);
+    }
+}
+
+Qtilities::Core::TaskExecutorJob* Qtilities::Core::TaskExecutor::jobForSender() const {
+    return d->task_jobs.value(sender(),0);
+}
@@ -0,0 +1,236 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TASK_EXECUTOR_H
+#define TASK_EXECUTOR_H
+
+#include "QtilitiesCore_global.h"
+#include "Task.h"
+
+#include <QObject>
+
+namespace Qtilities {
+    namespace Core {
+        using namespace Qtilities::Core::Interfaces;
+
+        class TaskExecutor;
+
+        /*!
+        \struct TaskExecutorJobPrivateData
+        \brief Structure used by TaskExecutorJob to store private data.
+          */
+        struct TaskExecutorJobPrivateData;
+
+        /*!
+        \class TaskExecutorJob
+        \brief The TaskExecutorJob class is the base class of work which is run by a TaskExecutor.
+
+        Implement execute() to do the work of a job. It is called on one of the executor's worker threads, thus it must not access the
+        Qtilities::Core::Task which represents it, or any other object living in the GUI thread, directly. Instead, the progress of the job is reported
+        using the protected functions of this class, which are marshalled back to the thread of the executor and applied to the task there:
+
+\code
+class CountJob : public TaskExecutorJob {
+public:
+    ITask::TaskResult execute() {
+        for (int i = 0; i < 100; ++i) {
+            if (!waitWhilePaused())
+                return ITask::TaskFailed;
+            doWork(i);
+            addCompletedSubTasks();
+        }
+        return ITask::TaskSuccessful;
+    }
+};
+\endcode
+
+        Stopping and pausing jobs is cooperative: when the task is stopped or paused by the user, the job only reacts to it the next time it calls
+        isStopRequested() or waitWhilePaused().
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT TaskExecutorJob
+        {
+            friend class TaskExecutor;
+
+        public:
+            TaskExecutorJob();
+            virtual ~TaskExecutorJob();
+
+            //! Does the work of the job. Called on a worker thread of the executor.
+            /*!
+              \returns The result with which the task of the job must be completed. When the task was stopped while the job was busy, the result is ignored.
+              */
+            virtual ITask::TaskResult execute() = 0;
+
+        protected:
+            //! Indicates if the task of the job was stopped. Can be called from execute().
+            bool isStopRequested() const;
+            //! Blocks for as long as the task of the job is paused. Can be called from execute().
+            /*!
+              \returns False when the task was stopped, in which case execute() should return as soon as possible. True otherwise.
+              */
+            bool waitWhilePaused();
+            //! Adds completed sub tasks to the task of the job. Can be called from execute().
+            void addCompletedSubTasks(int number_of_sub_tasks = 1, const QString& message = QString(), Logger::MessageType type = Logger::Info);
+            //! Logs a message to the task of the job. Can be called from execute().
+            void logMessage(const QString& message, Logger::MessageType type = Logger::Info);
+
+        private:
+            Q_DISABLE_COPY(TaskExecutorJob)
+            TaskExecutorJobPrivateData* d;
+        };
+
+        /*!
+        \class TaskExecutorFunctorJob
+        \brief The TaskExecutorFunctorJob class runs a functor as a TaskExecutorJob.
+
+        The functor is called with a reference to the job, and must return the ITask::TaskResult of the job. Thus the functor is able to report its progress
+        through the job. See TaskExecutor::submitFunctor().
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        template <typename Functor>
+        class TaskExecutorFunctorJob : public TaskExecutorJob
+        {
+        public:
+            TaskExecutorFunctorJob(Functor functor) : TaskExecutorJob(), d_functor(functor) {}
+
+            ITask::TaskResult execute() {
+                return d_functor(*this);
+            }
+
+            // The progress functions are made public, thus the functor is able to use them:
+            using TaskExecutorJob::isStopRequested;
+            using TaskExecutorJob::waitWhilePaused;
+            using TaskExecutorJob::addCompletedSubTasks;
+            using TaskExecutorJob::logMessage;
+
+        private:
+            Functor d_functor;
+        };
+
+        /*!
+        \struct TaskExecutorPrivateData
+        \brief Structure used by TaskExecutor to store private data.
+          */
+        struct TaskExecutorPrivateData;
+
+        /*!
+        \class TaskExecutor
+        \brief The TaskExecutor class runs the work of tasks on a pool of worker threads.
+
+        Qtilities::Core::Task only represents the state and the log of a task, the work it represents runs wherever its caller runs it, which is usually the
+        GUI thread. A TaskExecutor runs that work, in the form of a TaskExecutorJob, on its own QThreadPool instead, while the task reports the progress of the
+        job. An application wide executor is available through Qtilities::Core::TaskManager::taskExecutor():
+
+\code
+Task* task = new Task("Counting");
+task->setCanStop(true);
+task->setCanPause(true);
+task->setTaskLifeTimeFlags(Task::LifeTimeDestroyWhenSuccessful);
+OBJECT_MANAGER->registerObject(task,QtilitiesCategory("Tasks"));
+
+TASK_MANAGER->taskExecutor()->submit(task,new CountJob,100);
+\endcode
+
+        When a job is submitted, the task is started on the executor's thread once the job is dispatched to the thread pool. Sub tasks and messages reported by
+        the job are marshalled back to the executor's thread, and the task is completed with the result returned by TaskExecutorJob::execute(). When the
+        task requests to be stopped, paused or resumed, for example by the user through Qtilities::CoreGui::SingleTaskWidget, the task's state is updated and
+        the job is notified. Whether a task can be stopped or paused is determined by ITask::canStop() and ITask::canPause() of the task itself.
+
+        The number of jobs running at the same time can be limited for each ITask::TaskType using setMaximumConcurrentJobs(), for example to keep global
+        tasks from using all worker threads. Jobs which cannot run yet because of this limit are queued in the order in which they were submitted.
+
+        Tasks must live in the thread of the executor, which is the GUI thread for the executor of the task manager.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT TaskExecutor : public QObject
+        {
+            Q_OBJECT
+
+        public:
+            TaskExecutor(QObject* parent = 0);
+            //! Destructor. Stops all jobs and waits until the jobs which are running returned, after which the jobs are deleted.
+            ~TaskExecutor();
+
+            //! Submits \p job, which reports its progress to \p task.
+            /*!
+              The executor takes ownership of \p job and deletes it after it finished. It does not take ownership of \p task. When \p task is deleted while
+              the job is busy, the job is stopped.
+
+              \param expected_subtasks The number of sub tasks with which \p task is started.
+
+              \returns True when the job was submitted. False when \p task or \p job is null, or when \p task is busy already, in which case \p job is deleted.
+              */
+            bool submit(Task* task, TaskExecutorJob* job, int expected_subtasks = -1);
+            //! Submits \p functor as a TaskExecutorFunctorJob. See submit().
+            template <typename Functor>
+            bool submitFunctor(Task* task, Functor functor, int expected_subtasks = -1) {
+                return submit(task,new TaskExecutorFunctorJob<Functor>(functor),expected_subtasks);
+            }
+
+            //! Sets the maximum number of jobs of which the task has \p task_type which can run at the same time.
+            /*!
+              When -1, the number of jobs is only limited by maximumThreadCount(), which is the default.
+              */
+            void setMaximumConcurrentJobs(ITask::TaskType task_type, int maximum);
+            //! Gets the maximum number of jobs of which the task has \p task_type which can run at the same time.
+            int maximumConcurrentJobs(ITask::TaskType task_type) const;
+            //! Sets the number of worker threads. Default is QThread::idealThreadCount().
+            void setMaximumThreadCount(int count);
+            //! Gets the number of worker threads.
+            int maximumThreadCount() const;
+
+            //! The number of jobs which are running.
+            int activeJobCount() const;
+            //! The number of jobs which are queued because of the limits set using setMaximumConcurrentJobs().
+            int pendingJobCount() const;
+
+            //! Stops the job of \p task, independent of ITask::canStop(). A queued job is deleted without being run, after which jobFinished() is emitted for it.
+            void stop(Task* task);
+            //! Stops all jobs. Queued jobs are deleted without being run.
+            void stopAll();
+            //! Waits until all jobs finished, or until \p msecs milliseconds passed.
+            /*!
+              Progress reported by the jobs is applied to their tasks before this function returns.
+
+              \returns True when all jobs finished.
+              */
+            bool waitForDone(int msecs = -1);
+
+        signals:
+            //! Signal emitted on the executor's thread when the job of \p task finished, or when it was stopped before it started.
+            void jobFinished(Qtilities::Core::Task* task, Qtilities::Core::Interfaces::ITask::TaskResult result);
+
+        private slots:
+            //! Applies the progress reported by jobs on the worker threads.
+            void processJobEvents();
+            void handleStopTaskRequest();
+            void handlePauseTaskRequest();
+            void handleResumeTaskRequest();
+            void handleTaskDestroyed(QObject* obj);
+
+        private:
+            //! Dispatches queued jobs for as long as the limits set using setMaximumConcurrentJobs() allow it.
+            void dispatchPendingJobs();
+            void startJob(TaskExecutorJob* job);
+            void finishJob(TaskExecutorJob* job, ITask::TaskResult result);
+            void stopJob(TaskExecutorJob* job);
+            TaskExecutorJob* jobForSender() const;
+
+            TaskExecutorPrivateData* d;
+        };
+    }
+}
+
+#endif // TASK_EXECUTOR_H
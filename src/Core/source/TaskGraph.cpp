@@ -0,0 +1,355 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TaskGraph.h"
+#include "QtilitiesCoreApplication.h"
+#include "TaskManager.h"
+
+#include <QHash>
+#include <QPointer>
+
+namespace {
+    struct TaskGraphNode {
+        TaskGraphNode() : job(0), expected_subtasks(-1), state(Qtilities::Core::TaskGraph::NodeWaiting) {}
+
+        QPointer<Qtilities::Core::Task>         task;
+        //! The job of the node until it was submitted, after which it is owned by the executor.
+        Qtilities::Core::TaskExecutorJob*       job;
+        int                                     expected_subtasks;
+        QList<int>                              dependencies;
+        QList<int>                              dependents;
+        Qtilities::Core::TaskGraph::NodeState   state;
+    };
+}
+
+struct Qtilities::Core::TaskGraphPrivateData {
+    TaskGraphPrivateData() : graph_task(0),
+        started(false),
+        running(false),
+        stopping(false) {}
+
+    QList<TaskGraphNode>        nodes;
+    //! The nodes using their tasks as keys.
+    QHash<QObject*,int>         task_nodes;
+    QPointer<TaskExecutor>      executor;
+    Task*                       graph_task;
+    bool                        started;
+    bool                        running;
+    bool                        stopping;
+};
+
+Qtilities::Core::TaskGraph::TaskGraph(const QString& graph_name, TaskExecutor* executor, QObject* parent) : QObject(parent) {
+    d = new TaskGraphPrivateData;
+    if (executor)
+        d->executor = executor;
+    else
+        d->executor = TASK_MANAGER->taskExecutor();
+
+    d->graph_task = new Task(graph_name,true,this);
+    d->graph_task->setCanStop(true);
+    connect(d->graph_task,SIGNAL(stopTaskRequest()),SLOT(stop()));
+    setObjectName(graph_name);
+}
+
+Qtilities::Core::TaskGraph::~TaskGraph() {
+    if (d->running)
+        stop();
+    if (d->executor)
+        d->executor->disconnect(this);
+
+    for (int i = 0; i < d->nodes.count(); ++i) {
+        if (d->nodes.at(i).task)
+            d->nodes.at(i).task->disconnect(this);
+        delete d->nodes.at(i).job;
+    }
+    delete d;
+}
+
+int Qtilities::Core::TaskGraph::addNode(Task* task, TaskExecutorJob* job, int expected_subtasks) {
+    if (!task || !job || d->started || d->task_nodes.contains(task))
+        return -1;
+
+    TaskGraphNode node;
+    node.task = task;
+    node.job = job;
+    node.expected_subtasks = expected_subtasks;
+    d->nodes << node;
+
+    int index = d->nodes.count() - 1;
+    d->task_nodes[task] = index;
+    if (!task->parent())
+        task->setParent(this);
+    connect(task,SIGNAL(destroyed(QObject*)),SLOT(handleNodeTaskDestroyed(QObject*)));
+    return index;
+}
+
+bool Qtilities::Core::TaskGraph::addDependency(int node, int dependency) {
+    if (d->started || node < 0 || node >= d->nodes.count() || dependency < 0 || dependency >= d->nodes.count())
+        return false;
+    if (node == dependency || dependsOn(dependency,node))
+        return false;
+
+    if (!d->nodes.at(node).dependencies.contains(dependency)) {
+        d->nodes[node].dependencies << dependency;
+        d->nodes[dependency].dependents << node;
+    }
+    return true;
+}
+
+int Qtilities::Core::TaskGraph::nodeCount() const {
+    return d->nodes.count();
+}
+
+Qtilities::Core::Task* Qtilities::Core::TaskGraph::nodeTask(int node) const {
+    if (node < 0 || node >= d->nodes.count())
+        return 0;
+    return d->nodes.at(node).task;
+}
+
+Qtilities::Core::TaskGraph::NodeState Qtilities::Core::TaskGraph::nodeState(int node) const {
+    if (node < 0 || node >= d->nodes.count())
+        return NodeSkipped;
+    return d->nodes.at(node).state;
+}
+
+QList<int> Qtilities::Core::TaskGraph::dependencies(int node) const {
+    if (node < 0 || node >= d->nodes.count())
+        return QList<int>();
+    return d->nodes.at(node).dependencies;
+}
+
+QList<int> Qtilities::Core::TaskGraph::dependents(int node) const {
+    if (node < 0 || node >= d->nodes.count())
+        return QList<int>();
+    return d->nodes.at(node).dependents;
+}
+
+QList<int> Qtilities::Core::TaskGraph::topologicalOrder() const {
+    QList<int> remaining_dependencies;
+    QList<int> ready;
+    for (int i = 0; i < d->nodes.count(); ++i) {
+        remaining_dependencies << d->nodes.at(i).dependencies.count();
+        if (remaining_dependencies.last() == 0)
+            ready << i;
+    }
+
+    QList<int> order;
+    while (!ready.isEmpty()) {
+        int node = ready.takeFirst();
+        order << node;
+        const QList<int>& node_dependents = d->nodes.at(node).dependents;
+        for (int i = 0; i < node_dependents.count(); ++i) {
+            int dependent = node_dependents.at(i);
+            if (--remaining_dependencies[dependent] == 0)
+                ready << dependent;
+        }
+    }
+
+    // Cycles are rejected in addDependency(), thus all nodes are always in the order:
+    Q_ASSERT(order.count() == d->nodes.count());
+    return order;
+}
+
+Qtilities::Core::Task* Qtilities::Core::TaskGraph::graphTask() const {
+    return d->graph_task;
+}
+
+bool Qtilities::Core::TaskGraph::isRunning() const {
+    return d->running;
+}
+
+bool Qtilities::Core::TaskGraph::start() {
+    if (d->started || !d->executor)
+        return false;
+
+    d->started = true;
+    d->running = true;
+    connect(d->executor,SIGNAL(jobFinished(Qtilities::Core::Task*,Qtilities::Core::Interfaces::ITask::TaskResult)),
+            SLOT(handleJobFinished(Qtilities::Core::Task*,Qtilities::Core::Interfaces::ITask::TaskResult)));
+
+    d->graph_task->startTask(d->nodes.count());
+    submitReadyNodes();
+    checkFinished();
+    return true;
+}
+
+void Qtilities::Core::TaskGraph::stop() {
+    if (!d->running || d->stopping)
+        return;
+
+    d->stopping = true;
+    for (int i = 0; i < d->nodes.count(); ++i) {
+        if (d->nodes.at(i).state == NodeWaiting)
+            skipNode(i,tr("The task graph was stopped."));
+    }
+
+    // Jobs which are queued in the executor are finished immediately, the others when they returned:
+    for (int i = 0; i < d->nodes.count(); ++i) {
+        if (d->nodes.at(i).state == NodeRunning && d->nodes.at(i).task && d->executor)
+            d->executor->stop(d->nodes.at(i).task);
+    }
+    checkFinished();
+}
+
+void Qtilities::Core::TaskGraph::handleJobFinished(Task* task, ITask::TaskResult result) {
+    Q_UNUSED(result)
+
+    int node = d->task_nodes.value(task,-1);
+    if (node < 0 || d->nodes.at(node).state != NodeRunning)
+        return;
+
+    // A task which was stopped is not completed, and its result is determined by the task itself since it depends on the messages logged to it:
+    finishNode(node,task->state() == ITask::TaskCompleted && task->result() != ITask::TaskFailed);
+    if (!d->stopping)
+        submitReadyNodes();
+    checkFinished();
+}
+
+void Qtilities::Core::TaskGraph::handleNodeTaskDestroyed(QObject* obj) {
+    int node = d->task_nodes.value(obj,-1);
+    if (node < 0)
+        return;
+    d->task_nodes.remove(obj);
+
+    // Tasks which finished might destroy themselves, depending on their lifetime flags:
+    if (d->nodes.at(node).state == NodeRunning)
+        finishNode(node,false);
+    else if (d->nodes.at(node).state == NodeWaiting && d->running) {
+        skipNode(node,tr("The task was deleted."));
+        skipDependents(node,tr("The task was deleted."));
+    }
+
+    if (d->running) {
+        if (!d->stopping)
+            submitReadyNodes();
+        checkFinished();
+    }
+}
+
+void Qtilities::Core::TaskGraph::submitReadyNodes() {
+    for (int i = 0; i < d->nodes.count(); ++i) {
+        if (d->nodes.at(i).state != NodeWaiting)
+            continue;
+
+        bool ready = true;
+        const QList<int>& node_dependencies = d->nodes.at(i).dependencies;
+        for (int dep = 0; dep < node_dependencies.count(); ++dep) {
+            if (d->nodes.at(node_dependencies.at(dep)).state != NodeSucceeded) {
+                ready = false;
+                break;
+            }
+        }
+        if (!ready)
+            continue;
+
+        if (!d->nodes.at(i).task) {
+            skipNode(i,tr("The task was deleted."));
+            skipDependents(i,tr("The task was deleted."));
+            continue;
+        }
+
+        TaskExecutorJob* job = d->nodes.at(i).job;
+        d->nodes[i].job = 0;
+        d->nodes[i].state = NodeRunning;
+        // The executor takes ownership of the job, also when it fails to submit it:
+        if (!d->executor->submit(d->nodes.at(i).task,job,d->nodes.at(i).expected_subtasks))
+            finishNode(i,false);
+    }
+}
+
+void Qtilities::Core::TaskGraph::finishNode(int node, bool successful) {
+    d->nodes[node].state = successful ? NodeSucceeded : NodeFailed;
+
+    QString node_name;
+    if (d->nodes.at(node).task)
+        node_name = d->nodes.at(node).task->taskName();
+    else
+        node_name = QString::number(node);
+
+    if (successful)
+        d->graph_task->addCompletedSubTasks(1,tr("Task \"%1\" completed.").arg(node_name));
+    else {
+        d->graph_task->addCompletedSubTasks(1,tr("Task \"%1\" failed.").arg(node_name),Logger::Error);
+        skipDependents(node,tr("Task \"%1\" on which it depends failed.").arg(node_name));
+    }
+}
+
+void Qtilities::Core::TaskGraph::skipDependents(int node, const QString& reason) {
+    QList<int> dependents_to_check = d->nodes.at(node).dependents;
+    while (!dependents_to_check.isEmpty()) {
+        int dependent = dependents_to_check.takeFirst();
+        if (d->nodes.at(dependent).state != NodeWaiting)
+            continue;
+
+        skipNode(dependent,reason);
+        dependents_to_check << d->nodes.at(dependent).dependents;
+    }
+}
+
+void Qtilities::Core::TaskGraph::skipNode(int node, const QString& reason) {
+    d->nodes[node].state = NodeSkipped;
+    delete d->nodes.at(node).job;
+    d->nodes[node].job = 0;
+
+    QString node_name;
+    if (d->nodes.at(node).task) {
+        node_name = d->nodes.at(node).task->taskName();
+        d->nodes.at(node).task->logWarning(tr("Task skipped: %1").arg(reason));
+    } else
+        node_name = QString::number(node);
+
+    d->graph_task->addCompletedSubTasks(1,tr("Task \"%1\" skipped: %2").arg(node_name).arg(reason),Logger::Warning);
+}
+
+void Qtilities::Core::TaskGraph::checkFinished() {
+    if (!d->running)
+        return;
+
+    bool successful = true;
+    for (int i = 0; i < d->nodes.count(); ++i) {
+        NodeState state = d->nodes.at(i).state;
+        if (state == NodeWaiting || state == NodeRunning)
+            return;
+        if (state != NodeSucceeded)
+            successful = false;
+    }
+
+    d->running = false;
+    if (d->executor)
+        d->executor->disconnect(this);
+    if (d->stopping)
+        d->graph_task->stopTask();
+    else if (successful)
+        d->graph_task->completeTask(ITask::TaskSuccessful);
+    else
+        d->graph_task->completeTask(ITask::TaskFailed);
+    d->stopping = false;
+
+    emit graphFinished(successful);
+}
+
+bool Qtilities::Core::TaskGraph::dependsOn(int node, int other) const {
+    QList<int> to_check = d->nodes.at(node).dependencies;
+    QList<bool> checked;
+    for (int i = 0; i < d->nodes.count(); ++i)
+        checked << false;
+
+    while (!to_check.isEmpty()) {
+        int dependency = to_check.takeFirst();
+        if (dependency == other)
+            return true;
+        if (checked.at(dependency))
+            continue;
+        checked[dependency] = true;
+        to_check << d->nodes.at(dependency).dependencies;
+    }
+    return false;
+}
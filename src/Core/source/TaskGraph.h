@@ -0,0 +1,152 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include "QtilitiesCore_global.h"
+#include "TaskExecutor.h"
+
+#include <QObject>
+
+namespace Qtilities {
+    namespace Core {
+        using namespace Qtilities::Core::Interfaces;
+
+        /*!
+        \struct TaskGraphPrivateData
+        \brief Structure used by TaskGraph to store private data.
+          */
+        struct TaskGraphPrivateData;
+
+        /*!
+        \class TaskGraph
+        \brief The TaskGraph class runs a set of tasks of which some depend on others.
+
+        ITask::setParentTask() only allows tasks to be arranged in a hierarchy which is used to log messages to parent tasks. A TaskGraph allows tasks to
+        depend on other tasks instead: every node in the graph is a task together with the TaskExecutorJob which does its work, and a node only runs
+        after all the nodes it depends on completed successfully. Nodes of which the dependencies completed are submitted to a TaskExecutor, thus
+        independent nodes run at the same time:
+
+\code
+TaskGraph* graph = new TaskGraph("Build");
+int generate = graph->addNode(new Task("Generate"),new GenerateJob);
+int compile_a = graph->addNode(new Task("Compile A"),new CompileJob("a"));
+int compile_b = graph->addNode(new Task("Compile B"),new CompileJob("b"));
+int link = graph->addNode(new Task("Link"),new LinkJob);
+graph->addDependency(compile_a,generate);
+graph->addDependency(compile_b,generate);
+graph->addDependency(link,compile_a);
+graph->addDependency(link,compile_b);
+
+OBJECT_MANAGER->registerObject(graph->graphTask(),QtilitiesCategory("Tasks"));
+graph->start();
+\endcode
+
+        When a node fails or is stopped, the nodes which depend on it, directly or through other nodes, are skipped while the rest of the graph continues.
+        Stopping the graph, using stop() or by stopping graphTask(), stops all running nodes and skips the nodes which did not start yet.
+
+        The graph's progress is reported through graphTask(), which completes a sub task every time a node finished and can be registered in the
+        object manager to show the graph in Qtilities::CoreGui::TaskSummaryWidget. The tasks of the nodes can be registered as well to show their
+        individual progress.
+
+        The graph takes ownership of the tasks and jobs of its nodes.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT TaskGraph : public QObject
+        {
+            Q_OBJECT
+            Q_ENUMS(NodeState)
+
+        public:
+            //! The possible states of a node.
+            enum NodeState {
+                NodeWaiting     = 0,    /*!< The node did not start yet. */
+                NodeRunning     = 1,    /*!< The node was submitted to the executor. */
+                NodeSucceeded   = 2,    /*!< The node completed successfully. */
+                NodeFailed      = 3,    /*!< The node failed or was stopped. */
+                NodeSkipped     = 4     /*!< The node was not run because a node it depends on failed, or because the graph was stopped. */
+            };
+
+            //! Constructs a graph of which the nodes are run by \p executor. When \p executor is null, Qtilities::Core::TaskManager::taskExecutor() is used.
+            TaskGraph(const QString& graph_name, TaskExecutor* executor = 0, QObject* parent = 0);
+            //! Destructor. Stops the graph when it is running.
+            ~TaskGraph();
+
+            //! Adds a node of which the work is done by \p job, reporting its progress to \p task.
+            /*!
+              Nodes can only be added while the graph is not running.
+
+              \returns The index of the new node, or -1 when the node could not be added.
+              */
+            int addNode(Task* task, TaskExecutorJob* job, int expected_subtasks = -1);
+            //! Indicates that \p node must only run after \p dependency completed successfully.
+            /*!
+              \returns False when one of the nodes does not exist, when the graph is running, or when the dependency would create a cycle.
+              */
+            bool addDependency(int node, int dependency);
+
+            //! The number of nodes in the graph.
+            int nodeCount() const;
+            //! The task of \p node.
+            Task* nodeTask(int node) const;
+            //! The state of \p node.
+            NodeState nodeState(int node) const;
+            //! The nodes on which \p node depends directly.
+            QList<int> dependencies(int node) const;
+            //! The nodes which depend on \p node directly.
+            QList<int> dependents(int node) const;
+            //! Returns the nodes in an order in which every node comes after the nodes it depends on.
+            QList<int> topologicalOrder() const;
+
+            //! The task reporting the progress of the graph.
+            Task* graphTask() const;
+            //! Indicates if the graph is running.
+            bool isRunning() const;
+
+        public slots:
+            //! Starts the graph. A graph can only be run once.
+            /*!
+              \returns True when the graph was started.
+              */
+            bool start();
+            //! Stops the nodes which are running and skips the nodes which did not start yet.
+            void stop();
+
+        signals:
+            //! Signal emitted when all nodes finished or were skipped.
+            /*!
+              \param successful True when all nodes completed successfully.
+              */
+            void graphFinished(bool successful);
+
+        private slots:
+            void handleJobFinished(Qtilities::Core::Task* task, Qtilities::Core::Interfaces::ITask::TaskResult result);
+            void handleNodeTaskDestroyed(QObject* obj);
+
+        private:
+            //! Submits the waiting nodes of which all dependencies succeeded.
+            void submitReadyNodes();
+            void finishNode(int node, bool successful);
+            //! Marks all waiting nodes which depend on \p node, directly or indirectly, as skipped.
+            void skipDependents(int node, const QString& reason);
+            void skipNode(int node, const QString& reason);
+            //! Completes graphTask() and emits graphFinished() when no node can run anymore.
+            void checkFinished();
+            bool dependsOn(int node, int other) const;
+
+            TaskGraphPrivateData* d;
+        };
+    }
+}
+
+#endif // TASK_GRAPH_H
@@ -11,8 +11,10 @@
 
 #include "QtilitiesCoreConstants.h"
 #include "TaskManager.h"
-#include "Observer.h"
 #include "ITask.h"
+#include "Task.h"
+#include "TaskExecutor.h"
+#include "TraceEventWriter_p.h"
 
 #include <Logger>
 
@@ -20,26 +22,79 @@
 #include <QtDebug>
 #include <QPointer>
 #include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QThread>
+#include <QTimer>
+#include <QtAlgorithms>
 
 using namespace Qtilities::Core::Constants;
 using namespace Qtilities::Core::Interfaces;
 
+namespace {
+    QString traceTaskId(const void* task) {
+        return TraceEventWriter::jsonString(QString("0x%1").arg((quintptr) task,0,16));
+    }
+
+    quint64 traceCurrentThreadId() {
+        return (quint64) (quintptr) QThread::currentThreadId();
+    }
+}
+
 struct Qtilities::Core::TaskManagerPrivateData {
-    TaskManagerPrivateData() : task_observer(qti_def_GLOBAL_OBJECT_POOL),
-        id_counter(-1),
+    TaskManagerPrivateData() : id_counter(-1),
         forward_task_messages_to_qt_msg_engine(false),
-        forward_task_messages_to_console_engine(false) { }
+        forward_task_messages_to_console_engine(false),
+        task_executor(0),
+        automatic_task_reaping(false),
+        maximum_task_trace_events(100000) { }
 
-    Observer            task_observer;
-    QMap<int,QString>   task_id_name_map;
-    int                 id_counter;
+    //! The registered tasks, indexed by their IDs.
+    QHash<int,QObject*>             task_objects;
+    //! The IDs of the registered tasks, indexed by their objects. Used for tasks which are being deleted.
+    QHash<QObject*,int>             task_object_ids;
+    //! The names of the registered tasks when they were registered.
+    QHash<int,QString>              task_names;
+    //! The IDs of the registered tasks, indexed by their names.
+    QHash<QString,QSet<int> >       task_name_ids;
+    //! Tasks are constructed on any thread, thus an atomic.
+    QAtomicInt          id_counter;
     bool                forward_task_messages_to_qt_msg_engine;
     bool                forward_task_messages_to_console_engine;
+    TaskExecutor*       task_executor;
+    QTimer              elapsed_time_tick;
+    QSet<Task*>         elapsed_time_tick_tasks;
+
+    bool                automatic_task_reaping;
+    QList<int>          pending_reaped_task_ids;
+    QList<int>          pending_added_task_ids;
+    QSet<int>           pending_added_task_id_set;
+    QList<int>          pending_removed_task_ids;
+    QTimer              pending_changes_timer;
+
+    //! Read on the threads on which tasks record their events, thus an atomic.
+    QAtomicInt              task_tracing_enabled;
+    //! Protects the members below, since events are recorded on any thread.
+    mutable QMutex          task_trace_mutex;
+    QElapsedTimer           task_trace_timer;
+    QList<TaskTraceEvent>   task_trace_events;
+    int                     maximum_task_trace_events;
+    //! The thread of the task manager, which is named in exported traces.
+    quint64                 main_thread_id;
 };
 
 Qtilities::Core::TaskManager::TaskManager(QObject* parent) : QObject(parent) {
     d = new TaskManagerPrivateData;
-    d->task_observer.setObjectName("Tasks Observer");
+    d->pending_changes_timer.setSingleShot(true);
+    d->pending_changes_timer.setInterval(0);
+    connect(&d->pending_changes_timer,SIGNAL(timeout()),SLOT(processPendingTaskChanges()));
+    d->task_executor = new TaskExecutor(this);
+    d->main_thread_id = traceCurrentThreadId();
+    d->elapsed_time_tick.setInterval(1000);
+    connect(&d->elapsed_time_tick,SIGNAL(timeout()),SIGNAL(elapsedTimeTick()));
     setObjectName("Task Manager");
 }
 
@@ -48,13 +103,17 @@ Qtilities::Core::TaskManager::~TaskManager(){
 }
 
 QList<int> Qtilities::Core::TaskManager::allTaskIDs() const {
-    return d->task_id_name_map.keys();
+    QList<int> task_ids = d->task_objects.keys();
+    qSort(task_ids);
+    return task_ids;
 }
 
 QList<ITask*> Qtilities::Core::TaskManager::allTasks() const {
     QList<ITask*> all_tasks;
-    for (int i = 0; i < d->task_observer.subjectCount(); ++i) {
-        ITask* task = qobject_cast<ITask*> (d->task_observer.subjectAt(i));
+    QList<int> task_ids = allTaskIDs();
+    all_tasks.reserve(task_ids.count());
+    for (int i = 0; i < task_ids.count(); ++i) {
+        ITask* task = qobject_cast<ITask*> (d->task_objects.value(task_ids.at(i)));
         if (task)
             all_tasks << task;
     }
@@ -62,36 +121,42 @@ QList<ITask*> Qtilities::Core::TaskManager::allTasks() const {
 }
 
 QStringList Qtilities::Core::TaskManager::taskNames() const {
-    return d->task_id_name_map.values();
+    QStringList names;
+    QList<int> task_ids = allTaskIDs();
+    names.reserve(task_ids.count());
+    for (int i = 0; i < task_ids.count(); ++i)
+        names << d->task_names.value(task_ids.at(i));
+    return names;
 }
 
-ITask* Qtilities::Core::TaskManager::hasTask(const int task_id) const {
-    if (d->task_id_name_map.contains(task_id)) {
-        // Loop through all tasks and return one that contains task_id:
-        for (int i = 0; i < d->task_observer.subjectCount(); ++i) {
-            ITask* task = qobject_cast<ITask*> (d->task_observer.subjectAt(i));
-            if (task) {
-                if (task->taskID() == task_id)
-                    return task;
-            }
-        }
-    }
+int Qtilities::Core::TaskManager::taskCount() const {
+    return d->task_objects.count();
+}
 
+ITask* Qtilities::Core::TaskManager::hasTask(const int task_id) const {
+    QObject* obj = d->task_objects.value(task_id);
+    if (obj)
+        return qobject_cast<ITask*> (obj);
     return 0;
 }
 
 ITask* Qtilities::Core::TaskManager::hasTask(const QString& task_name) const {
-    if (d->task_id_name_map.values().contains(task_name)) {
-        int id = d->task_id_name_map.key(task_name);
-        return hasTask(id);
-    } else
+    QHash<QString,QSet<int> >::const_iterator itr = d->task_name_ids.constFind(task_name);
+    if (itr == d->task_name_ids.constEnd() || itr.value().isEmpty())
         return 0;
+
+    QSet<int>::const_iterator id_itr = itr.value().constBegin();
+    int lowest_id = *id_itr;
+    for (++id_itr; id_itr != itr.value().constEnd(); ++id_itr)
+        lowest_id = qMin(lowest_id,*id_itr);
+    return hasTask(lowest_id);
 }
 
 int Qtilities::Core::TaskManager::taskID(const QString& task_name) {
-    if (d->task_id_name_map.values().contains(task_name)) {
-        return d->task_id_name_map.key(task_name);
-    } else
+    ITask* task = hasTask(task_name);
+    if (task)
+        return task->taskID();
+    else
         return -1;
 }
 
@@ -131,52 +196,308 @@ bool TaskManager::assignIdToTask(ITask *task) {
     if (task->taskID() != -1)
         return false;
 
-    ++d->id_counter;
-    task->setTaskID(d->id_counter);
-    d->task_id_name_map[d->id_counter] = task->taskName();
+    // Tasks are only indexed once they are registered, thus unregistered tasks which are deleted do not leave anything behind:
+    task->setTaskID(d->id_counter.fetchAndAddOrdered(1) + 1);
+    return true;
+}
+
+void Qtilities::Core::TaskManager::setAutomaticTaskReapingEnabled(bool is_enabled) {
+    d->automatic_task_reaping = is_enabled;
+    if (!is_enabled)
+        d->pending_reaped_task_ids.clear();
+}
+
+bool Qtilities::Core::TaskManager::automaticTaskReapingEnabled() const {
+    return d->automatic_task_reaping;
+}
+
+Qtilities::Core::TaskExecutor* Qtilities::Core::TaskManager::taskExecutor() const {
+    return d->task_executor;
+}
+
+void Qtilities::Core::TaskManager::startElapsedTimeTick(Task* task) {
+    if (!task || d->elapsed_time_tick_tasks.contains(task))
+        return;
+
+    d->elapsed_time_tick_tasks.insert(task);
+    connect(this,SIGNAL(elapsedTimeTick()),task,SLOT(broadcastElapsedTimeChanged()));
+    if (!d->elapsed_time_tick.isActive())
+        d->elapsed_time_tick.start();
+}
+
+void Qtilities::Core::TaskManager::stopElapsedTimeTick(Task* task) {
+    if (!d->elapsed_time_tick_tasks.remove(task))
+        return;
+
+    disconnect(this,SIGNAL(elapsedTimeTick()),task,SLOT(broadcastElapsedTimeChanged()));
+    if (d->elapsed_time_tick_tasks.isEmpty())
+        d->elapsed_time_tick.stop();
+}
+
+void Qtilities::Core::TaskManager::setTaskTracingEnabled(bool is_enabled) {
+    QMutexLocker locker(&d->task_trace_mutex);
+    if (is_enabled && !d->task_trace_timer.isValid())
+        d->task_trace_timer.start();
+    d->task_tracing_enabled.fetchAndStoreOrdered(is_enabled ? 1 : 0);
+}
+
+bool Qtilities::Core::TaskManager::taskTracingEnabled() const {
+    return d->task_tracing_enabled.fetchAndAddOrdered(0) != 0;
+}
+
+void Qtilities::Core::TaskManager::setMaximumTaskTraceEvents(int maximum) {
+    QMutexLocker locker(&d->task_trace_mutex);
+    d->maximum_task_trace_events = qMax(0,maximum);
+}
+
+int Qtilities::Core::TaskManager::maximumTaskTraceEvents() const {
+    QMutexLocker locker(&d->task_trace_mutex);
+    return d->maximum_task_trace_events;
+}
+
+void Qtilities::Core::TaskManager::recordTaskTraceEvent(ITask* task, TaskTraceEvent::EventType event_type, int sub_tasks) {
+    if (!task || !taskTracingEnabled())
+        return;
+
+    TaskTraceEvent event;
+    event.event_type = event_type;
+    event.thread_id = traceCurrentThreadId();
+    event.task = task->objectBase();
+    event.task_id = task->taskID();
+    event.task_name = task->taskName();
+    event.sub_tasks = sub_tasks;
+    ITask* parent_task = task->parentTask();
+    if (parent_task) {
+        event.parent_task_id = parent_task->taskID();
+        event.parent_task_name = parent_task->taskName();
+    }
+
+    QMutexLocker locker(&d->task_trace_mutex);
+    if (d->task_trace_events.count() >= d->maximum_task_trace_events)
+        return;
+    event.timestamp = d->task_trace_timer.nsecsElapsed() / 1000;
+    d->task_trace_events << event;
+}
+
+void Qtilities::Core::TaskManager::recordJobTraceEvent(const void* task_address, TaskTraceEvent::EventType event_type) {
+    if (!task_address || !taskTracingEnabled())
+        return;
+
+    TaskTraceEvent event;
+    event.event_type = event_type;
+    event.thread_id = traceCurrentThreadId();
+    event.task = task_address;
+
+    QMutexLocker locker(&d->task_trace_mutex);
+    if (d->task_trace_events.count() >= d->maximum_task_trace_events)
+        return;
+    event.timestamp = d->task_trace_timer.nsecsElapsed() / 1000;
+    d->task_trace_events << event;
+}
+
+QList<Qtilities::Core::TaskTraceEvent> Qtilities::Core::TaskManager::taskTraceEvents() const {
+    QMutexLocker locker(&d->task_trace_mutex);
+    return d->task_trace_events;
+}
+
+void Qtilities::Core::TaskManager::clearTaskTrace() {
+    QMutexLocker locker(&d->task_trace_mutex);
+    d->task_trace_events.clear();
+}
+
+bool Qtilities::Core::TaskManager::exportTaskTrace(const QString& file_name) const {
+    TraceEventWriter writer(file_name);
+    if (!writer.open(d->main_thread_id)) {
+        LOG_ERROR(QString("Task Manager: Failed to open file for task trace export: %1").arg(file_name));
+        return false;
+    }
+
+    const QList<TaskTraceEvent> events = taskTraceEvents();
+
+    // Job events do not have task names, thus the name of the task is taken from the last time it started:
+    QHash<const void*,QString> task_names;
+    for (int i = 0; i < events.count(); ++i) {
+        const TaskTraceEvent& event = events.at(i);
+        if (event.event_type == TaskTraceEvent::TaskStarted)
+            task_names[event.task] = event.task_name;
+
+        QString name;
+        QString category = "task";
+        QString phase;
+        QString args;
+        switch (event.event_type) {
+        case TaskTraceEvent::TaskStarted:
+            name = event.task_name;
+            phase = "b";
+            args = QString("\"task_id\":%1,\"parent_task_id\":%2,\"parent_task\":%3").arg(event.task_id).arg(event.parent_task_id).arg(TraceEventWriter::jsonString(event.parent_task_name));
+            break;
+        case TaskTraceEvent::TaskPaused:
+            name = "Paused";
+            phase = "b";
+            break;
+        case TaskTraceEvent::TaskResumed:
+            name = "Paused";
+            phase = "e";
+            break;
+        case TaskTraceEvent::TaskSubTasksCompleted:
+            name = "Sub tasks completed";
+            phase = "n";
+            args = QString("\"sub_tasks\":%1").arg(event.sub_tasks);
+            break;
+        case TaskTraceEvent::TaskCompleted:
+        case TaskTraceEvent::TaskStopped:
+            name = task_names.value(event.task,event.task_name);
+            phase = "e";
+            args = QString("\"stopped\":%1").arg(event.event_type == TaskTraceEvent::TaskStopped ? "true" : "false");
+            break;
+        case TaskTraceEvent::JobStarted:
+        case TaskTraceEvent::JobFinished:
+            name = task_names.value(event.task);
+            category = "job";
+            phase = event.event_type == TaskTraceEvent::JobStarted ? "B" : "E";
+            break;
+        }
+
+        QString fields = "\"name\":" + TraceEventWriter::jsonString(name) + ",\"cat\":\"" + category + "\",\"ph\":\"" + phase + "\"";
+        if (category == "task")
+            fields += ",\"id\":" + traceTaskId(event.task);
+        fields += QString(",\"ts\":%1,\"tid\":%2").arg(event.timestamp).arg(event.thread_id);
+        if (!args.isEmpty())
+            fields += ",\"args\":{" + args + "}";
+        writer.writeEvent(fields);
+    }
+
+    if (!writer.close()) {
+        LOG_ERROR(QString("Task Manager: Failed to write task trace to file: %1").arg(file_name));
+        return false;
+    }
     return true;
 }
 
 void Qtilities::Core::TaskManager::removeTask(const int task_id) {
     ITask* task = hasTask(task_id);
-    if (task) {
-        LOG_DEBUG(QString("Task Manager: Removing task with ID \"%1\" and name \"%2\"").arg(task->taskID()).arg(task->taskName()));
-        d->task_observer.detachSubject(task->objectBase());
-    }
+    if (task)
+        removeTask(task->objectBase());
 }
 
 void Qtilities::Core::TaskManager::removeTask(QObject* obj) {
+    if (!d->task_object_ids.contains(obj))
+        return;
+
     ITask* task = qobject_cast<ITask*> (obj);
     if (task) {
-        LOG_DEBUG(QString("Task Manager: Removing task with ID \"%1\" and name \"%2\"").arg(task->taskID()).arg(task->taskName()));
-        d->task_observer.detachSubject(obj);
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::TaskLogTag,QString("Task Manager: Removing task with ID \"%1\" and name \"%2\"").arg(task->taskID()).arg(task->taskName()));
+        obj->disconnect(this);
+        unregisterTask(d->task_object_ids.value(obj));
+        emit taskRemoved(task);
     }
 }
 
 bool Qtilities::Core::TaskManager::addTask(QObject* obj) {
     ITask* task = qobject_cast<ITask*> (obj);
-    if (task) {
-        if (task->taskID() == -1) {
-            ++d->id_counter;
-            if (obj->objectName().isEmpty())
-                obj->setObjectName("Task with ID: " + QString::number(d->id_counter) + ", Name: " + task->taskName());
-            if (d->task_observer.attachSubject(obj,Observer::ManualOwnership))  {
-                task->setTaskID(d->id_counter);
-                d->task_id_name_map[d->id_counter] = task->taskName();
-                LOG_TRACE(QString("Task Manager: Registering new task with ID \"%1\" and name \"%2\"").arg(d->id_counter).arg(task->taskName()));
-                return true;
-            } else
-                return false;
-        } else {
-            if (obj->objectName().isEmpty())
-                obj->setObjectName("Task with ID: " + QString::number(task->taskID()) + ", Name: " + task->taskName());
-            if (d->task_observer.attachSubject(obj,Observer::ManualOwnership))  {
-                LOG_TRACE(QString("Task Manager: Registering new task with ID \"%1\" and name \"%2\"").arg(task->taskID()).arg(task->taskName()));
-                return true;
-            } else
-                return false;
-        }
-    } else
+    if (!task || d->task_object_ids.contains(obj))
+        return false;
+
+    if (task->taskID() == -1)
+        task->setTaskID(d->id_counter.fetchAndAddOrdered(1) + 1);
+    if (d->task_objects.contains(task->taskID()))
         return false;
+
+    const int task_id = task->taskID();
+    if (obj->objectName().isEmpty())
+        obj->setObjectName("Task with ID: " + QString::number(task_id) + ", Name: " + task->taskName());
+
+    d->task_objects[task_id] = obj;
+    d->task_object_ids[obj] = task_id;
+    d->task_names[task_id] = task->taskName();
+    d->task_name_ids[task->taskName()].insert(task_id);
+    connect(obj,SIGNAL(destroyed(QObject*)),SLOT(handleTaskDestroyed(QObject*)));
+    connect(obj,SIGNAL(taskCompleted(ITask::TaskResult,QString,Logger::MessageType)),SLOT(handleTaskFinished()));
+    connect(obj,SIGNAL(taskStopped()),SLOT(handleTaskFinished()));
+
+    d->pending_added_task_ids << task_id;
+    d->pending_added_task_id_set.insert(task_id);
+    schedulePendingTaskChanges();
+
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::TaskLogTag,QString("Task Manager: Registering new task with ID \"%1\" and name \"%2\"").arg(task_id).arg(task->taskName()));
+    emit newTaskAdded(task);
+    return true;
+}
+
+void Qtilities::Core::TaskManager::handleTaskDestroyed(QObject* obj) {
+    QHash<QObject*,int>::iterator itr = d->task_object_ids.find(obj);
+    if (itr != d->task_object_ids.end())
+        unregisterTask(itr.value());
+}
+
+void Qtilities::Core::TaskManager::handleTaskFinished() {
+    if (!d->automatic_task_reaping)
+        return;
+
+    QHash<QObject*,int>::const_iterator itr = d->task_object_ids.constFind(sender());
+    if (itr == d->task_object_ids.constEnd())
+        return;
+
+    d->pending_reaped_task_ids << itr.value();
+    schedulePendingTaskChanges();
+}
+
+void Qtilities::Core::TaskManager::processPendingTaskChanges() {
+    // Reap finished tasks first, thus their removal is part of this batch:
+    QList<int> reaped_task_ids = d->pending_reaped_task_ids;
+    d->pending_reaped_task_ids.clear();
+    for (int i = 0; i < reaped_task_ids.count(); ++i) {
+        ITask* task = hasTask(reaped_task_ids.at(i));
+        if (!task)
+            continue;
+        // The task might have been started again since it finished:
+        if (task->state() != ITask::TaskCompleted && task->state() != ITask::TaskStopped)
+            continue;
+
+        QObject* obj = task->objectBase();
+        removeTask(obj);
+        if (task->taskRemoveAction() == ITask::TaskDeleteWhenRemoved)
+            obj->deleteLater();
+    }
+
+    QList<int> added_task_ids;
+    added_task_ids.reserve(d->pending_added_task_ids.count());
+    for (int i = 0; i < d->pending_added_task_ids.count(); ++i) {
+        if (d->pending_added_task_id_set.contains(d->pending_added_task_ids.at(i)))
+            added_task_ids << d->pending_added_task_ids.at(i);
+    }
+    QList<int> removed_task_ids = d->pending_removed_task_ids;
+    d->pending_added_task_ids.clear();
+    d->pending_added_task_id_set.clear();
+    d->pending_removed_task_ids.clear();
+
+    if (!added_task_ids.isEmpty())
+        emit tasksAdded(added_task_ids);
+    if (!removed_task_ids.isEmpty())
+        emit tasksRemoved(removed_task_ids);
 }
 
+void Qtilities::Core::TaskManager::unregisterTask(int task_id) {
+    QObject* obj = d->task_objects.take(task_id);
+    if (!obj)
+        return;
+
+    d->task_object_ids.remove(obj);
+    const QString task_name = d->task_names.take(task_id);
+    QHash<QString,QSet<int> >::iterator itr = d->task_name_ids.find(task_name);
+    if (itr != d->task_name_ids.end()) {
+        itr.value().remove(task_id);
+        if (itr.value().isEmpty())
+            d->task_name_ids.erase(itr);
+    }
+
+    // Tasks which were added and removed in the same batch are not reported at all:
+    if (!d->pending_added_task_id_set.remove(task_id))
+        d->pending_removed_task_ids << task_id;
+    schedulePendingTaskChanges();
+}
+
+void Qtilities::Core::TaskManager::schedulePendingTaskChanges() {
+    if (!d->pending_changes_timer.isActive())
+        d->pending_changes_timer.start();
+}
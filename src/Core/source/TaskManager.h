@@ -14,6 +14,7 @@
 
 #include <QObject>
 #include <QPointer>
+#include <QString>
 
 #include "QtilitiesCore_global.h"
 
@@ -28,6 +29,48 @@ using namespace Qtilities::Core::Interfaces;
 
 namespace Qtilities {
     namespace Core {
+        class Task;
+        class TaskExecutor;
+
+        /*!
+        \struct TaskTraceEvent
+        \brief A timing event recorded by the task manager while task tracing is enabled.
+
+        See Qtilities::Core::TaskManager::setTaskTracingEnabled() for more information.
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct QTILIITES_CORE_SHARED_EXPORT TaskTraceEvent {
+            //! The types of trace events.
+            enum EventType {
+                TaskStarted             = 0,    /*!< The task was started. */
+                TaskPaused              = 1,    /*!< The task was paused. */
+                TaskResumed             = 2,    /*!< The task was resumed. */
+                TaskSubTasksCompleted   = 3,    /*!< Sub tasks of the task were completed. */
+                TaskCompleted           = 4,    /*!< The task was completed. */
+                TaskStopped             = 5,    /*!< The task was stopped. */
+                JobStarted              = 6,    /*!< A Qtilities::Core::TaskExecutorJob of the task started on a worker thread. */
+                JobFinished             = 7     /*!< A Qtilities::Core::TaskExecutorJob of the task finished on a worker thread. */
+            };
+
+            TaskTraceEvent() : event_type(TaskStarted), timestamp(0), thread_id(0), task(0), task_id(-1), parent_task_id(-1), sub_tasks(0) {}
+
+            EventType       event_type;
+            //! The time of the event in microseconds, measured from the moment tracing was first enabled.
+            qint64          timestamp;
+            //! The ID of the thread on which the event was recorded.
+            quint64         thread_id;
+            //! The address of the task, which identifies the task also when it does not have an ID. Only valid while the task exists.
+            const void*     task;
+            int             task_id;
+            //! The name of the task. Empty for job events, since they are recorded on worker threads.
+            QString         task_name;
+            int             parent_task_id;
+            QString         parent_task_name;
+            //! The number of sub tasks completed by TaskSubTasksCompleted events.
+            int             sub_tasks;
+        };
+
         /*!
         \struct TaskManagerPrivateData
         \brief A structure storing private data in the TaskManager class.
@@ -40,6 +83,11 @@ namespace Qtilities {
 
         The task manager is responsible to monitor the global object pool for tasks registered in it and to provide information about these tasks.
 
+        Registered tasks are indexed by ID and by name, thus looking up and removing tasks does not depend on the number of registered tasks. Tasks
+        are removed automatically when they are deleted. Applications which create many short lived tasks can also let the task manager remove
+        tasks when they complete, see setAutomaticTaskReapingEnabled(). Changes to the registered tasks are reported in batches using tasksAdded()
+        and tasksRemoved().
+
         See the \ref page_tasking article for more information on tasking.
 
         <i>This class was added in %Qtilities v1.0.</i>
@@ -52,24 +100,31 @@ namespace Qtilities {
             TaskManager(QObject* parent = 0);
             ~TaskManager();
 
-            //! Returns the IDs of all tasks.
+            //! Returns the IDs of all registered tasks, in ascending order.
             QList<int> allTaskIDs() const;
-            //! Returns all the tasks managed by the task manager.
+            //! Returns all the tasks managed by the task manager, ordered by their IDs.
             QList<ITask*> allTasks() const;
-            //! Returns the names of all tasks.
+            //! Returns the names of all registered tasks, ordered by the IDs of the tasks.
             QStringList taskNames() const;
+            //! Returns the number of registered tasks.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            int taskCount() const;
             //! Checks if a specific task exists and returns a reference to it when found, 0 otherwise.
             ITask* hasTask(const int task_id) const;
             //! Checks if a task with the specified task name exists.
             /*!
-              If multiple tasks with task_name exists this function will returns the ID of the first one found.
+              If multiple tasks with task_name exists this function will returns the one with the lowest ID.
               */
             ITask* hasTask(const QString& task_name) const;
             //! Maps a task name to the corresponding task ID.
             /*!
-              If multiple tasks with task_name exists this function will returns the ID of the first one found.
+              If multiple tasks with task_name exists this function will returns the lowest ID.
 
               If no task with \p task_name exists, -1 will be returned.
+
+              \note Tasks are indexed using the name they had when they were registered.
               */
             int taskID(const QString& task_name);
             //! Maps a task ID to the corresponding task string.
@@ -152,6 +207,111 @@ namespace Qtilities {
              * \return True if successfull, false otherwise. If a task already has an ID assigned (thus, taskID() != -1), this function will fail.
              */
             bool assignIdToTask(ITask* task);
+            //! Sets if registered tasks are removed from the task manager when they complete or are stopped.
+            /*!
+             * When enabled, tasks are removed shortly after they completed or were stopped, unless they were started again in the meantime.
+             * Tasks which use ITask::TaskDeleteWhenRemoved as their remove action are also deleted using QObject::deleteLater().
+             *
+             * Disabled by default.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setAutomaticTaskReapingEnabled(bool is_enabled);
+            //! Gets if registered tasks are removed from the task manager when they complete or are stopped.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            bool automaticTaskReapingEnabled() const;
+
+            //! Returns the application wide task executor, which runs the work of tasks on a pool of worker threads.
+            /*!
+             * See Qtilities::Core::TaskExecutor for more information.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            TaskExecutor* taskExecutor() const;
+
+            //! Includes \p task in the shared tick used to emit ITask::taskElapsedTimeChanged() for busy tasks.
+            /*!
+             * Tasks do not use a timer each, instead tasks which live in the thread of the task manager share a single tick which
+             * is only active while at least one task uses it. Qtilities::Core::Task calls this function when it starts and elapsed time
+             * notifications are enabled, thus you should not need to call it yourself.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void startElapsedTimeTick(Task* task);
+            //! Removes \p task from the shared tick used to emit ITask::taskElapsedTimeChanged() for busy tasks.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void stopElapsedTimeTick(Task* task);
+
+            //! Enables or disables recording of task timing events.
+            /*!
+             * While tracing is enabled, the task manager records an event every time a Qtilities::Core::Task (registered or not) starts,
+             * pauses, resumes, completes sub tasks, completes or stops, together with the thread on which it happened and the parent task
+             * of the task. Jobs run by a Qtilities::Core::TaskExecutor record when they start and finish on their worker thread, which shows
+             * whether jobs actually overlap on the pool.
+             *
+             * The recorded events can be exported in the Chrome trace event format using exportTaskTrace(), which can be opened in
+             * chrome://tracing or the Perfetto UI.
+             *
+             * Disabled by default. When disabled, tasks only check this flag.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setTaskTracingEnabled(bool is_enabled);
+            //! Gets if recording of task timing events is enabled. This function is thread-safe.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            bool taskTracingEnabled() const;
+            //! Sets the maximum number of trace events kept by the task manager. Events recorded once the maximum is reached are dropped.
+            /*!
+             * Default is 100000.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setMaximumTaskTraceEvents(int maximum);
+            //! Gets the maximum number of trace events kept by the task manager.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            int maximumTaskTraceEvents() const;
+            //! Records a trace event for \p task when tracing is enabled. This function is thread-safe.
+            /*!
+             * Qtilities::Core::Task records its events itself, thus you only need to call this function for custom ITask implementations.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void recordTaskTraceEvent(ITask* task, TaskTraceEvent::EventType event_type, int sub_tasks = 0);
+            //! Records a job trace event for the task at \p task_address on the current thread when tracing is enabled. This function is thread-safe.
+            /*!
+             * Used by Qtilities::Core::TaskExecutor on its worker threads, where the task itself must not be accessed.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void recordJobTraceEvent(const void* task_address, TaskTraceEvent::EventType event_type);
+            //! Returns the recorded trace events, in the order in which they were recorded.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            QList<TaskTraceEvent> taskTraceEvents() const;
+            //! Removes all recorded trace events.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void clearTaskTrace();
+            //! Writes the recorded trace events to \p file_name in the Chrome trace event JSON format.
+            /*!
+             * Tasks are exported as asynchronous events, since many tasks can be busy on the same thread, with their pauses nested inside
+             * them and completed sub tasks as instant events. Jobs are exported as duration events on the worker threads which ran them.
+             *
+             * \returns True when the file was written successfully.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            bool exportTaskTrace(const QString& file_name) const;
 
         public slots:
             //! Removes the task specified by task_id if it exists.
@@ -168,10 +328,42 @@ namespace Qtilities {
             //! Called when a new task is registered in the global object pool.
             void newTaskAdded(ITask* new_task);
             //! Called when a task if removed from the global object pool.
+            /*!
+              Not emitted for tasks which are removed because they were deleted, see tasksRemoved().
+              */
             void taskRemoved(ITask* task_removed);
+            //! Emitted once for all tasks which were registered since the previous time this signal was emitted.
+            /*!
+             * Tasks which were removed again before the signal is emitted are not included.
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void tasksAdded(const QList<int>& task_ids);
+            //! Emitted once for all tasks which were removed since the previous time this signal was emitted, including deleted tasks.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void tasksRemoved(const QList<int>& task_ids);
+            //! Emitted every second while tasks use the shared elapsed time tick. See startElapsedTimeTick().
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void elapsedTimeTick();
+
+        private slots:
+            //! Removes a deleted task from the registry.
+            void handleTaskDestroyed(QObject* obj);
+            //! Schedules a completed or stopped task for removal when automaticTaskReapingEnabled() is true.
+            void handleTaskFinished();
+            //! Removes finished tasks and emits tasksAdded() and tasksRemoved() for the pending changes.
+            void processPendingTaskChanges();
 
         private:
             QString contextName(int id) const;
+            //! Removes the task with ID \p task_id from the indexes and schedules its removal notification.
+            void unregisterTask(int task_id);
+            //! Starts the timer which processes pending task changes if it is not running.
+            void schedulePendingTaskChanges();
             TaskManagerPrivateData* d;
         };
     }
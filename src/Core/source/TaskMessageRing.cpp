@@ -0,0 +1,169 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TaskMessageRing.h"
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QVarLengthArray>
+
+#include <string.h>
+
+namespace {
+    struct TaskMessageRingSlot {
+        //! The sequence number of the message in the slot, or 0 while a message is being written to it.
+        QAtomicInt  sequence;
+        int         type;
+        int         length;
+    };
+
+    //! Qt 4 and Qt 5 use different functions to load atomic values, thus this is done using a fetch which does not change the value.
+    inline quint32 loadSequence(QAtomicInt& value) {
+        return (quint32) value.fetchAndAddOrdered(0);
+    }
+}
+
+struct Qtilities::Core::TaskMessageRingPrivateData {
+    TaskMessageRingPrivateData() : capacity(0),
+        mask(0),
+        maximum_message_size(0),
+        ring_slots(0),
+        text(0),
+        appended(0),
+        cleared(0) {}
+
+    int                     capacity;
+    quint32                 mask;
+    int                     maximum_message_size;
+    TaskMessageRingSlot*    ring_slots;
+    //! The text of all slots, maximum_message_size bytes for each slot.
+    char*                   text;
+    //! The number of messages appended, thus the sequence number of the last message.
+    mutable QAtomicInt      appended;
+    //! The sequence number of the last message which was removed by clear().
+    mutable QAtomicInt      cleared;
+};
+
+Qtilities::Core::TaskMessageRing::TaskMessageRing(int capacity, int maximum_message_size) {
+    d = new TaskMessageRingPrivateData;
+
+    // Sequence numbers wrap around, thus the capacity must divide 2^32:
+    d->capacity = 1;
+    while (d->capacity < capacity && d->capacity < (1 << 30))
+        d->capacity <<= 1;
+    d->mask = (quint32) d->capacity - 1;
+    d->maximum_message_size = qMax(1,maximum_message_size);
+
+    d->ring_slots = new TaskMessageRingSlot[d->capacity];
+    for (int i = 0; i < d->capacity; ++i) {
+        d->ring_slots[i].type = Logger::Info;
+        d->ring_slots[i].length = 0;
+    }
+    d->text = new char[(size_t) d->capacity * (size_t) d->maximum_message_size];
+}
+
+Qtilities::Core::TaskMessageRing::~TaskMessageRing() {
+    delete [] d->ring_slots;
+    delete [] d->text;
+    delete d;
+}
+
+int Qtilities::Core::TaskMessageRing::capacity() const {
+    return d->capacity;
+}
+
+int Qtilities::Core::TaskMessageRing::maximumMessageSize() const {
+    return d->maximum_message_size;
+}
+
+void Qtilities::Core::TaskMessageRing::append(const QString& message, Logger::MessageType type) {
+    QByteArray utf8 = message.toUtf8();
+    int length = utf8.size();
+    if (length > d->maximum_message_size) {
+        // Don't split multi-byte characters:
+        length = d->maximum_message_size;
+        while (length > 0 && (((uchar) utf8.at(length)) & 0xC0) == 0x80)
+            --length;
+    }
+
+    quint32 sequence = (quint32) d->appended.fetchAndAddOrdered(1) + 1;
+    TaskMessageRingSlot& slot = d->ring_slots[(sequence - 1) & d->mask];
+
+    // Readers ignore the slot while its sequence is 0:
+    slot.sequence.fetchAndStoreOrdered(0);
+    slot.type = (int) type;
+    slot.length = length;
+    memcpy(d->text + (size_t) ((sequence - 1) & d->mask) * (size_t) d->maximum_message_size,utf8.constData(),(size_t) length);
+    slot.sequence.fetchAndStoreOrdered((int) sequence);
+}
+
+QList<Qtilities::Core::TaskMessageRing::Message> Qtilities::Core::TaskMessageRing::messages(int count) const {
+    quint32 last = lastSequence();
+    quint32 available = last - loadSequence(d->cleared);
+    if (available > (quint32) d->capacity)
+        available = d->capacity;
+    if (count >= 0 && (quint32) count < available)
+        available = count;
+    if (available == 0)
+        return QList<Message>();
+    return readMessages(last - available + 1,last);
+}
+
+QList<Qtilities::Core::TaskMessageRing::Message> Qtilities::Core::TaskMessageRing::messagesSince(quint32 sequence) const {
+    quint32 last = lastSequence();
+    quint32 cleared = loadSequence(d->cleared);
+    // Sequence numbers are compared using their distance to the last sequence, since they wrap around:
+    if (last - sequence > last - cleared)
+        sequence = cleared;
+    quint32 available = last - sequence;
+    if (available > (quint32) d->capacity)
+        available = d->capacity;
+    if (available == 0)
+        return QList<Message>();
+    return readMessages(last - available + 1,last);
+}
+
+quint32 Qtilities::Core::TaskMessageRing::lastSequence() const {
+    return loadSequence(d->appended);
+}
+
+void Qtilities::Core::TaskMessageRing::clear() {
+    d->cleared.fetchAndStoreOrdered((int) lastSequence());
+}
+
+QList<Qtilities::Core::TaskMessageRing::Message> Qtilities::Core::TaskMessageRing::readMessages(quint32 first, quint32 last) const {
+    QList<Message> read_messages;
+    QVarLengthArray<char,1024> buffer(d->maximum_message_size);
+
+    for (quint32 sequence = first; sequence - first <= last - first; ++sequence) {
+        TaskMessageRingSlot& slot = d->ring_slots[(sequence - 1) & d->mask];
+        if (loadSequence(slot.sequence) != sequence)
+            continue;
+
+        // The slot might be overwritten while it is copied, which is detected by checking its sequence again afterwards:
+        int type = slot.type;
+        int length = qBound(0,slot.length,d->maximum_message_size);
+        memcpy(buffer.data(),d->text + (size_t) ((sequence - 1) & d->mask) * (size_t) d->maximum_message_size,(size_t) length);
+        if (loadSequence(slot.sequence) != sequence)
+            continue;
+
+        Message message;
+        message.sequence = sequence;
+        message.message = QString::fromUtf8(buffer.constData(),length);
+        message.type = (Logger::MessageType) type;
+        read_messages << message;
+
+        if (sequence == last)
+            break;
+    }
+
+    return read_messages;
+}
@@ -0,0 +1,99 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TASK_MESSAGE_RING_H
+#define TASK_MESSAGE_RING_H
+
+#include "QtilitiesCore_global.h"
+
+#include <Logger>
+
+#include <QList>
+#include <QString>
+
+namespace Qtilities {
+    namespace Core {
+        using namespace Qtilities::Logging;
+
+        /*!
+        \struct TaskMessageRingPrivateData
+        \brief Structure used by TaskMessageRing to store private data.
+          */
+        struct TaskMessageRingPrivateData;
+
+        /*!
+        \class TaskMessageRing
+        \brief The TaskMessageRing class keeps the most recent messages of a task in a fixed amount of memory.
+
+        A message ring has a fixed number of slots which are allocated when it is constructed. Messages are appended to the next slot, overwriting the
+        oldest message once all slots are used. Appending never locks and the ring never grows, thus the ring can be written from multiple worker threads
+        at the same time without contention, while the GUI reads the messages on demand using messages() or messagesSince().
+
+        Every slot stores at most maximumMessageSize() bytes of the UTF-8 encoded message, longer messages are truncated.
+
+        Reading never blocks writers either. Messages which are overwritten while they are being read are left out of the result, thus a reader might
+        see fewer messages than were appended when writers are much faster than it. When more writers than there are slots overwrite the same slot at the
+        same time, the message in that slot can be lost.
+
+        See Qtilities::Core::Task::enableMessageRing() for the ring used by tasks.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILIITES_CORE_SHARED_EXPORT TaskMessageRing
+        {
+        public:
+            //! A message read from the ring.
+            struct Message {
+                Message() : sequence(0), type(Logger::Info) {}
+
+                //! The sequence number of the message, which is incremented for every message appended to the ring.
+                quint32             sequence;
+                QString             message;
+                Logger::MessageType type;
+            };
+
+            //! Constructs a ring with \p capacity slots, which is rounded up to a power of two, each storing up to \p maximum_message_size bytes.
+            TaskMessageRing(int capacity = 256, int maximum_message_size = 512);
+            ~TaskMessageRing();
+
+            //! The number of slots in the ring.
+            int capacity() const;
+            //! The maximum number of UTF-8 bytes stored for each message.
+            int maximumMessageSize() const;
+
+            //! Appends a message to the ring. This function is thread-safe and lock-free.
+            void append(const QString& message, Logger::MessageType type = Logger::Info);
+            //! Returns the most recent messages, oldest first.
+            /*!
+              \param count The maximum number of messages to return. When -1, all messages which are in the ring are returned.
+              */
+            QList<Message> messages(int count = -1) const;
+            //! Returns the messages of which the sequence number follows \p sequence, oldest first.
+            /*!
+              Use the sequence number of the last message returned to read only the messages appended since the previous call. Pass 0 to get all messages.
+              */
+            QList<Message> messagesSince(quint32 sequence) const;
+            //! The sequence number of the message which was appended last, thus the number of messages appended since the ring was constructed.
+            quint32 lastSequence() const;
+            //! Removes all messages from the ring. Messages appended while the ring is cleared might be removed as well.
+            void clear();
+
+        private:
+            Q_DISABLE_COPY(TaskMessageRing)
+            //! Reads the messages with sequence numbers in the range between \p first and \p last, both inclusive.
+            QList<Message> readMessages(quint32 first, quint32 last) const;
+
+            TaskMessageRingPrivateData* d;
+        };
+    }
+}
+
+#endif // TASK_MESSAGE_RING_H
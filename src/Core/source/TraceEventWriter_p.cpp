@@ -0,0 +1,60 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TraceEventWriter_p.h"
+
+#include <QCoreApplication>
+
+Qtilities::Core::TraceEventWriter::TraceEventWriter(const QString& file_name) : d_file(file_name), d_pid(QCoreApplication::applicationPid()) {
+
+}
+
+bool Qtilities::Core::TraceEventWriter::open(quint64 main_thread_id) {
+    if (!d_file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+        return false;
+
+    d_stream.setDevice(&d_file);
+    d_stream.setCodec("UTF-8");
+    d_stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    d_stream << QString("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%1,\"tid\":%2,\"args\":{\"name\":\"Main Thread\"}}").arg(d_pid).arg(main_thread_id);
+    return true;
+}
+
+void Qtilities::Core::TraceEventWriter::writeEvent(const QString& fields) {
+    d_stream << ",\n{" << fields << ",\"pid\":" << d_pid << "}";
+}
+
+bool Qtilities::Core::TraceEventWriter::close() {
+    d_stream << "\n]}\n";
+    d_stream.flush();
+    const bool success = d_file.error() == QFile::NoError && d_stream.status() == QTextStream::Ok;
+    d_file.close();
+    return success;
+}
+
+QString Qtilities::Core::TraceEventWriter::jsonString(const QString& value) {
+    QString escaped;
+    escaped.reserve(value.length() + 2);
+    escaped += QLatin1Char('"');
+    for (int i = 0; i < value.length(); ++i) {
+        const QChar c = value.at(i);
+        if (c == QLatin1Char('"'))
+            escaped += QLatin1String("\\\"");
+        else if (c == QLatin1Char('\\'))
+            escaped += QLatin1String("\\\\");
+        else if (c.unicode() < 0x20)
+            escaped += QString("\\u%1").arg(c.unicode(),4,16,QLatin1Char('0'));
+        else
+            escaped += c;
+    }
+    escaped += QLatin1Char('"');
+    return escaped;
+}
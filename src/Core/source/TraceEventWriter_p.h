@@ -0,0 +1,55 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TRACE_EVENT_WRITER_P_H
+#define TRACE_EVENT_WRITER_P_H
+
+#include <QFile>
+#include <QString>
+#include <QTextStream>
+
+namespace Qtilities {
+    namespace Core {
+        /*!
+        \class TraceEventWriter
+        \brief The TraceEventWriter class writes a file in the Chrome trace event format.
+
+        Used by TaskManager::exportTaskTrace() and StartupProfiler::exportTrace(). Events are written one at a time using writeEvent(),
+        after which close() completes the file.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class TraceEventWriter
+        {
+        public:
+            TraceEventWriter(const QString& file_name);
+
+            //! Opens the file and writes the start of the trace, which names the thread identified by \p main_thread_id as the main thread.
+            bool open(quint64 main_thread_id);
+            //! Writes an event containing \p fields, a comma separated list of JSON members. The process ID of the application is added to the event.
+            void writeEvent(const QString& fields);
+            //! Writes the end of the trace and closes the file. Returns false when the file could not be written.
+            bool close();
+
+            //! Returns \p value as a quoted JSON string.
+            static QString jsonString(const QString& value);
+
+        private:
+            Q_DISABLE_COPY(TraceEventWriter)
+
+            QFile       d_file;
+            QTextStream d_stream;
+            qint64      d_pid;
+        };
+    }
+}
+
+#endif // TRACE_EVENT_WRITER_P_H
@@ -14,6 +14,7 @@
 
 #include <QObject>
 #include <QString>
+#include <QVector>
 
 #include <QtilitiesLogging>
 
@@ -108,6 +109,23 @@ rootTop->attachSubject(rootNodeB);
           with. Thus, the path information will also be stored for you and TreeIterator will be able to iterate through the tree regardless of any multiple parents that
           it might find on its way.
 
+        \section tree_iterator_stack_iteration Stack based iteration
+
+        By default TreeIterator finds its position in the tree again on every step and it tracks the path it has taken through subjects with multiple parents
+        using the qti_prop_TREE_ITERATOR_SOURCE_OBS property on those subjects. Thus a walk through a tree sets dynamic properties on subjects.
+
+        When constructed with TreeIterator::StackIteration, the iterator keeps the path from the top node to the current item on a stack instead. In this
+        mode next() and previous() are O(1) amortized, subjects with multiple parents need no special handling and no properties are set on any subjects:
+
+\code
+TreeIterator itr(rootNode,TreeIterator::StackIteration);
+while (itr.hasNext())
+    qDebug() << itr.next()->objectName();
+\endcode
+
+        \note In StackIteration mode setCurrent() needs to search the tree for the new current item. When the item appears more than once in the
+        tree, the first occurrence is used.
+
         \sa SubjectIterator, ConstSubjectIterator
 
         <i>This class was added in %Qtilities v1.0.</i>
@@ -115,29 +133,72 @@ rootTop->attachSubject(rootNodeB);
         class TreeIterator : public Interfaces::IIterator<QObject>
         {
         public:
+            //! The ways in which TreeIterator can track its position in a tree.
+            /*!
+              <i>This enumeration was added in %Qtilities v1.5.</i>
+              */
+            enum IterationMode {
+                PropertyTrackedIteration,   /*!< The position is found again on every step. The path through subjects with multiple parents is tracked using the qti_prop_TREE_ITERATOR_SOURCE_OBS property. This is the default. */
+                StackIteration              /*!< The path from the top node to the current item is kept on a stack. No properties are set on subjects. */
+            };
+
             /*!
              * \brief TreeIterator Constructs a new iterator
              * \param top_node The top node of the tree on which the iterator should operate.
+             * \param iterator_id The iterator ID used for the qti_prop_TREE_ITERATOR_SOURCE_OBS property. When -1, a new ID is assigned. Not used in StackIteration mode.
+             * \param mode The iteration mode, added in %Qtilities v1.5.
              */
             TreeIterator(const Observer* top_node = 0,
-                         int iterator_id = -1) :
-                  d_top_node(top_node)
+                         int iterator_id = -1,
+                         IterationMode mode = PropertyTrackedIteration) :
+                  d_top_node(top_node),
+                  d_mode(mode)
             {
                 d_current = top_node;
-                if (iterator_id == -1)
+                if (iterator_id == -1 && mode == PropertyTrackedIteration)
                     d_iterator_id = OBJECT_MANAGER->getNewIteratorID();
                 else
                     d_iterator_id = iterator_id;
             }
+            /*!
+             * \brief TreeIterator Constructs a new iterator using the specified iteration mode.
+             * \param top_node The top node of the tree on which the iterator should operate.
+             * \param mode The iteration mode.
+             *
+             * <i>This constructor was added in %Qtilities v1.5.</i>
+             */
+            TreeIterator(const Observer* top_node,
+                         IterationMode mode) :
+                  d_top_node(top_node),
+                  d_mode(mode)
+            {
+                d_current = top_node;
+                if (mode == PropertyTrackedIteration)
+                    d_iterator_id = OBJECT_MANAGER->getNewIteratorID();
+                else
+                    d_iterator_id = -1;
+            }
+
+            //! Returns the iteration mode of this iterator.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            IterationMode iterationMode() const {
+                return d_mode;
+            }
 
             QObject* first()
             {
+                d_stack.clear();
                 d_current = d_top_node;
                 return const_cast<QObject*> (d_current);
             }
 
             QObject* last()
             {
+                if (d_mode == StackIteration)
+                    return stackLast();
+
                 QList<QObject*> tree_children = d_top_node->treeChildren("QObject",-1,d_iterator_id);
                 if (tree_children.count() > 0) {
                     d_current = tree_children.last();
@@ -155,11 +216,32 @@ rootTop->attachSubject(rootNodeB);
 
             void setCurrent(const QObject* current)
             {
+                if (d_mode == StackIteration && current != d_current) {
+                    stackSetCurrent(current);
+                    return;
+                }
                 d_current = current;
             }
 
+            bool hasNext()
+            {
+                if (d_mode == StackIteration)
+                    return stackHasNext();
+                return Interfaces::IIterator<QObject>::hasNext();
+            }
+
+            bool hasPrevious()
+            {
+                if (d_mode == StackIteration)
+                    return d_current && !d_stack.isEmpty();
+                return Interfaces::IIterator<QObject>::hasPrevious();
+            }
+
             QObject* next()
             {
+                if (d_mode == StackIteration)
+                    return stackNext();
+
                 //qDebug() << "Starting next(): from current" << d_current << ", previous parent" << findParentPrevious(d_current);
                 Observer* obs = qobject_cast<Observer*> (const_cast<QObject*> (d_current));
                 if (obs) {
@@ -233,6 +315,9 @@ rootTop->attachSubject(rootNodeB);
 
             QObject* previous()
             {
+                if (d_mode == StackIteration)
+                    return stackPrevious();
+
                 if (d_current == d_top_node)
                     return 0;
 
@@ -419,9 +504,114 @@ rootTop->attachSubject(rootNodeB);
             }
 
         private:
+            //! A frame on the StackIteration stack: the index of the subject of observer which is on the path to the current item.
+            struct TreeIteratorFrame {
+                TreeIteratorFrame(const Observer* obs = 0, int i = 0) : observer(obs), index(i) {}
+                const Observer* observer;
+                int index;
+            };
+
+            //! Descends to the last item in the tree under the current item, used in StackIteration mode.
+            void stackDescendToLast() {
+                const Observer* obs = qobject_cast<const Observer*> (d_current);
+                while (obs && obs->subjectCount() > 0) {
+                    d_stack.push_back(TreeIteratorFrame(obs,obs->subjectCount() - 1));
+                    d_current = obs->subjectAt(obs->subjectCount() - 1);
+                    obs = qobject_cast<const Observer*> (d_current);
+                }
+            }
+
+            //! Returns the depth of the frame which will be advanced by the next call to next(), -1 when there is no next item. Used in StackIteration mode.
+            int stackNextFrame() const {
+                for (int i = d_stack.count() - 1; i >= 0; --i) {
+                    if (d_stack.at(i).index + 1 < d_stack.at(i).observer->subjectCount())
+                        return i;
+                }
+                return -1;
+            }
+
+            bool stackHasNext() const {
+                if (!d_current)
+                    return false;
+                const Observer* obs = qobject_cast<const Observer*> (d_current);
+                if (obs && obs->subjectCount() > 0)
+                    return true;
+                return stackNextFrame() != -1;
+            }
+
+            QObject* stackNext() {
+                if (!d_current)
+                    return 0;
+
+                // Step into the current item if it has children:
+                const Observer* obs = qobject_cast<const Observer*> (d_current);
+                if (obs && obs->subjectCount() > 0) {
+                    d_stack.push_back(TreeIteratorFrame(obs,0));
+                    d_current = obs->subjectAt(0);
+                    return const_cast<QObject*> (d_current);
+                }
+
+                // Otherwise move to the next sibling of the closest parent which has one. The
+                // position is only changed when there is a next item:
+                int frame = stackNextFrame();
+                if (frame == -1)
+                    return 0;
+
+                d_stack.resize(frame + 1);
+                TreeIteratorFrame& top = d_stack.last();
+                ++top.index;
+                d_current = top.observer->subjectAt(top.index);
+                return const_cast<QObject*> (d_current);
+            }
+
+            QObject* stackPrevious() {
+                if (!d_current || d_stack.isEmpty())
+                    return 0;
+
+                TreeIteratorFrame& top = d_stack.last();
+                if (top.index > 0 && top.index <= top.observer->subjectCount()) {
+                    // Move to the previous sibling, and then to the last item in its tree:
+                    --top.index;
+                    d_current = top.observer->subjectAt(top.index);
+                    stackDescendToLast();
+                } else {
+                    // Move up to the parent:
+                    d_current = top.observer;
+                    d_stack.pop_back();
+                }
+
+                return const_cast<QObject*> (d_current);
+            }
+
+            QObject* stackLast() {
+                d_stack.clear();
+                d_current = d_top_node;
+                stackDescendToLast();
+                if (d_stack.isEmpty())
+                    return 0;
+                return const_cast<QObject*> (d_current);
+            }
+
+            void stackSetCurrent(const QObject* current) {
+                first();
+                if (!current || current == d_top_node)
+                    return;
+
+                while (stackNext()) {
+                    if (d_current == current)
+                        return;
+                }
+
+                // The item is not in the tree:
+                first();
+            }
+
             const QObject* d_current;
             const Observer* const d_top_node;
             int d_iterator_id;
+            IterationMode d_mode;
+            //! The path from the top node to d_current, used in StackIteration mode.
+            QVector<TreeIteratorFrame> d_stack;
         };
     }
 }
@@ -12,6 +12,109 @@
 #include "VersionInformation.h"
 
 #include <QStringList>
+#include <QVarLengthArray>
+#include <QVector>
+#include <QtAlgorithms>
+
+#include <limits.h>
+
+namespace {
+    //! The characters of a string, typically short enough to be stored on the stack.
+    typedef QVarLengthArray<QChar,64> qti_private_VersionChars;
+
+    //! Appends the lower case characters of \p string to \p chars, skipping spaces.
+    void qti_private_appendVersionChars(const QString& string, qti_private_VersionChars& chars) {
+        const QChar* data = string.constData();
+        const int length = string.length();
+        for (int i = 0; i < length; ++i) {
+            if (data[i] != QLatin1Char(' '))
+                chars.append(data[i].toLower());
+        }
+    }
+
+    //! Returns the position of \p pattern in \p chars between \p from and \p to, or -1 when it does not occur.
+    int qti_private_indexOf(const qti_private_VersionChars& chars, int from, int to, const qti_private_VersionChars& pattern) {
+        const int pattern_length = pattern.size();
+        if (pattern_length == 0)
+            return -1;
+        for (int i = from; i + pattern_length <= to; ++i) {
+            int p = 0;
+            while (p < pattern_length && chars[i + p] == pattern[p])
+                ++p;
+            if (p == pattern_length)
+                return i;
+        }
+        return -1;
+    }
+
+    //! Finds the first non-empty piece of the range \p begin to \p end when it is split at \p pattern. Returns the number of non-empty pieces.
+    /*!
+      The range of the first piece is returned in \p first_begin and \p first_end, and the range of the last piece in \p last_begin and \p last_end.
+      */
+    int qti_private_splitRange(const qti_private_VersionChars& chars, int begin, int end, const qti_private_VersionChars& pattern,
+                               int* first_begin, int* first_end, int* last_begin, int* last_end) {
+        int count = 0;
+        int piece_begin = begin;
+        while (piece_begin <= end) {
+            int piece_end = qti_private_indexOf(chars,piece_begin,end,pattern);
+            if (piece_end == -1)
+                piece_end = end;
+            if (piece_end > piece_begin) {
+                if (count == 0) {
+                    *first_begin = piece_begin;
+                    *first_end = piece_end;
+                }
+                *last_begin = piece_begin;
+                *last_end = piece_end;
+                ++count;
+            }
+            if (piece_end == end)
+                break;
+            piece_begin = piece_end + pattern.size();
+        }
+        return count;
+    }
+
+    //! Parses the decimal integer in the range \p begin to \p end, the same way QString::toInt() does.
+    bool qti_private_parseInt(const qti_private_VersionChars& chars, int begin, int end, int* value) {
+        if (begin >= end)
+            return false;
+
+        bool negative = false;
+        if (chars[begin] == QLatin1Char('+') || chars[begin] == QLatin1Char('-')) {
+            negative = (chars[begin] == QLatin1Char('-'));
+            ++begin;
+            if (begin >= end)
+                return false;
+        }
+
+        qint64 result = 0;
+        for (int i = begin; i < end; ++i) {
+            const ushort c = chars[i].unicode();
+            if (c < '0' || c > '9')
+                return false;
+            result = result * 10 + (c - '0');
+            if (result > (qint64) INT_MAX + 1)
+                return false;
+        }
+        if (negative)
+            result = -result;
+        if (result > INT_MAX || result < INT_MIN)
+            return false;
+
+        *value = (int) result;
+        return true;
+    }
+
+    //! Clamps \p value to the range 0 to \p maximum.
+    inline quint64 qti_private_clampKeyPart(int value, int maximum) {
+        if (value < 0)
+            return 0;
+        if (value > maximum)
+            return (quint64) maximum;
+        return (quint64) value;
+    }
+}
 
 // ------------------------------------
 // VersionNumber
@@ -90,6 +193,9 @@ Qtilities::Core::VersionNumber::~VersionNumber() {
 }
 
 bool Qtilities::Core::VersionNumber::operator==(const VersionNumber& ref) const {
+    if (hasComparisonKey() && ref.hasComparisonKey())
+        return comparisonKey() == ref.comparisonKey();
+
     if (d->version_major != ref.versionMajor())
         return false;
     if (d->is_version_minor_used && ref.isVersionMinorUsed()) {
@@ -125,11 +231,17 @@ Qtilities::Core::VersionNumber& Qtilities::Core::VersionNumber::operator=(const
     d->field_width_revision = ref.fieldWidthRevision();
     d->is_version_minor_used = ref.isVersionMinorUsed();
     d->is_version_revision_used = ref.isVersionRevisionUsed();
+    d->development_stage = ref.developmentStage();
+    d->development_stage_identifier = ref.developmentStageIdentifier();
+    d->version_development_stage = ref.versionDevelopmentStage();
 
     return *this;
 }
 
 bool Qtilities::Core::VersionNumber::operator>(const VersionNumber& ref) const {
+    if (hasComparisonKey() && ref.hasComparisonKey())
+        return comparisonKey() > ref.comparisonKey();
+
     if (*this == ref)
         return false;
     else
@@ -137,6 +249,9 @@ bool Qtilities::Core::VersionNumber::operator>(const VersionNumber& ref) const {
 }
 
 bool Qtilities::Core::VersionNumber::operator>=(const VersionNumber& ref) const {
+    if (hasComparisonKey() && ref.hasComparisonKey())
+        return comparisonKey() >= ref.comparisonKey();
+
     if (*this==ref)
         return true;
     else
@@ -144,6 +259,9 @@ bool Qtilities::Core::VersionNumber::operator>=(const VersionNumber& ref) const
 }
 
 bool Qtilities::Core::VersionNumber::operator<(const VersionNumber& ref) const {
+    if (hasComparisonKey() && ref.hasComparisonKey())
+        return comparisonKey() < ref.comparisonKey();
+
     if (*this == ref)
         return false;
 
@@ -208,6 +326,9 @@ bool Qtilities::Core::VersionNumber::operator<(const VersionNumber& ref) const {
 }
 
 bool Qtilities::Core::VersionNumber::operator<=(const VersionNumber& ref) const {
+    if (hasComparisonKey() && ref.hasComparisonKey())
+        return comparisonKey() <= ref.comparisonKey();
+
     if (*this==ref)
         return true;
     else
@@ -218,6 +339,28 @@ bool Qtilities::Core::VersionNumber::isNull() const {
     return (d->version_major == 0 && d->version_minor == 0 && d->version_revision == 0 && d->version_development_stage == 0);
 }
 
+bool Qtilities::Core::VersionNumber::hasComparisonKey() const {
+    return d->is_version_minor_used && d->is_version_revision_used
+            && d->version_major >= 0 && d->version_major <= 0xFFFF
+            && d->version_minor >= 0 && d->version_minor <= 0xFFFF
+            && d->version_revision >= 0 && d->version_revision <= 0xFFFF
+            && d->version_development_stage >= 0 && d->version_development_stage <= 0xFFF;
+}
+
+quint64 Qtilities::Core::VersionNumber::comparisonKey() const {
+    // The development stage version is only part of the version when a development stage is used, see operator==():
+    DevelopmentStage stage = developmentStage(true);
+    quint64 stage_version = 0;
+    if (stage != DevelopmentStageNone)
+        stage_version = qti_private_clampKeyPart(d->version_development_stage,0xFFF);
+
+    return (qti_private_clampKeyPart(d->version_major,0xFFFF) << 48)
+            | (qti_private_clampKeyPart(d->version_minor,0xFFFF) << 32)
+            | (qti_private_clampKeyPart(d->version_revision,0xFFFF) << 16)
+            | ((quint64) stage << 12)
+            | stage_version;
+}
+
 int Qtilities::Core::VersionNumber::versionMajor() const {
     return d->version_major;
 }
@@ -349,65 +492,85 @@ QString Qtilities::Core::VersionNumber::toString(const QString& separator) const
 }
 
 void Qtilities::Core::VersionNumber::fromString(const QString& version, const QString& separator, const QString& stage_identifier, DevelopmentStage stage) {
-    QString cleaned_version = version.toLower();
-    cleaned_version.replace(" ","");
+    // The string is scanned in place instead of being split, thus typical version strings are parsed without allocating memory:
+    qti_private_VersionChars chars;
+    qti_private_appendVersionChars(version,chars);
+    qti_private_VersionChars separator_chars;
+    qti_private_appendVersionChars(separator,separator_chars);
 
-    QStringList list = cleaned_version.split(separator,QString::SkipEmptyParts);
-    if (list.isEmpty())
-        return;
-
-    QString local_stage_identifier = stage_identifier.toLower();
-    if (local_stage_identifier.isEmpty())
-        local_stage_identifier = d->development_stage_identifier.toLower();
     DevelopmentStage local_stage = stage;
     if (local_stage == DevelopmentStageNone)
         local_stage = d->development_stage;
-
-    bool conv_ok;
-    if (list.count() >= 1) {
-        // We need to handle for example: 11sp1
-        QString major_string = list.at(0);
-        if (major_string.contains(local_stage_identifier) && !local_stage_identifier.isEmpty() && local_stage != DevelopmentStageNone) {
-            QStringList revision_split = major_string.split(local_stage_identifier,QString::SkipEmptyParts);
-            if (revision_split.count() > 0)
-                major_string = revision_split.front();
-        }
-        int tmp_int = major_string.toInt(&conv_ok);
-        if (conv_ok)
-            d->version_major = tmp_int;
+    qti_private_VersionChars identifier_chars;
+    if (local_stage != DevelopmentStageNone) {
+        if (stage_identifier.isEmpty())
+            qti_private_appendVersionChars(d->development_stage_identifier,identifier_chars);
+        else
+            qti_private_appendVersionChars(stage_identifier,identifier_chars);
     }
-    if (list.count() >= 2) {
-        // We need to handle for example: 11.0sp1
-        QString minor_string = list.at(1);
-        if (minor_string.contains(local_stage_identifier) && !local_stage_identifier.isEmpty() && local_stage != DevelopmentStageNone) {
-            QStringList revision_split = minor_string.split(local_stage_identifier,QString::SkipEmptyParts);
-            if (revision_split.count() > 0)
-                minor_string = revision_split.front();
+
+    // Find the first three non-empty parts and the last non-empty part:
+    int part_begin[3] = {0, 0, 0};
+    int part_end[3] = {0, 0, 0};
+    int last_begin = 0;
+    int last_end = 0;
+    int first_piece_begin = 0;
+    int first_piece_end = 0;
+    int part_count = 0;
+    if (separator_chars.isEmpty()) {
+        part_count = qti_private_splitRange(chars,0,chars.size(),separator_chars,&first_piece_begin,&first_piece_end,&last_begin,&last_end);
+        part_begin[0] = first_piece_begin;
+        part_end[0] = first_piece_end;
+    } else {
+        int begin = 0;
+        const int size = chars.size();
+        while (begin <= size) {
+            int end = qti_private_indexOf(chars,begin,size,separator_chars);
+            if (end == -1)
+                end = size;
+            if (end > begin) {
+                if (part_count < 3) {
+                    part_begin[part_count] = begin;
+                    part_end[part_count] = end;
+                }
+                last_begin = begin;
+                last_end = end;
+                ++part_count;
+            }
+            if (end == size)
+                break;
+            begin = end + separator_chars.size();
         }
-        int tmp_int = minor_string.toInt(&conv_ok);
-        if (conv_ok)
-            d->version_minor = tmp_int;
     }
-    if (list.count() >= 3) {
-        // We need to handle for example: 11.0.0sp1
-        QString revision_string = list.at(2);
-        if (revision_string.contains(local_stage_identifier) && !local_stage_identifier.isEmpty() && local_stage != DevelopmentStageNone) {
-            QStringList revision_split = revision_string.split(local_stage_identifier,QString::SkipEmptyParts);
-            if (revision_split.count() > 0)
-                revision_string = revision_split.front();
+    if (part_count == 0)
+        return;
+
+    // The major, minor and revision parts. We need to handle for example: 11sp1, 11.0sp1 and 11.0.0sp1
+    int* const versions[3] = {&d->version_major, &d->version_minor, &d->version_revision};
+    for (int i = 0; i < 3 && i < part_count; ++i) {
+        int begin = part_begin[i];
+        int end = part_end[i];
+        if (!identifier_chars.isEmpty() && qti_private_indexOf(chars,begin,end,identifier_chars) != -1) {
+            int piece_last_begin;
+            int piece_last_end;
+            if (qti_private_splitRange(chars,begin,end,identifier_chars,&first_piece_begin,&first_piece_end,&piece_last_begin,&piece_last_end) > 0) {
+                begin = first_piece_begin;
+                end = first_piece_end;
+            }
         }
-        int tmp_int = revision_string.toInt(&conv_ok);
-        if (conv_ok)
-            d->version_revision = tmp_int;
+        int value;
+        if (qti_private_parseInt(chars,begin,end,&value))
+            *versions[i] = value;
     }
 
     // Next, see if a stage type was specified:
-    if (local_stage != DevelopmentStageNone) {
-        QStringList stage_split_list = list.last().split(local_stage_identifier,QString::SkipEmptyParts);
-        if (stage_split_list.count() == 2) {
-            int tmp_int = stage_split_list.last().toInt(&conv_ok);
-            if (conv_ok)
-                d->version_development_stage = tmp_int;
+    if (!identifier_chars.isEmpty()) {
+        int stage_begin;
+        int stage_end;
+        if (qti_private_splitRange(chars,last_begin,last_end,identifier_chars,&first_piece_begin,&first_piece_end,&stage_begin,&stage_end) == 2) {
+            int value;
+            if (qti_private_parseInt(chars,stage_begin,stage_end,&value))
+                d->version_development_stage = value;
         }
     }
 }
@@ -417,16 +580,33 @@ void Qtilities::Core::VersionNumber::fromString(const QString& version, const QS
 // ------------------------------------
 
 struct Qtilities::Core::VersionInformationPrivateData {
-    VersionInformationPrivateData() {}
+    VersionInformationPrivateData() : unkeyed_supported_versions(0) {}
+
+    //! Adds \p version_number to the index of supported versions.
+    void indexSupportedVersion(const VersionNumber& version_number) {
+        if (version_number.hasComparisonKey()) {
+            const quint64 key = version_number.comparisonKey();
+            QVector<quint64>::iterator itr = qLowerBound(supported_keys.begin(),supported_keys.end(),key);
+            if (itr == supported_keys.end() || *itr != key)
+                supported_keys.insert(itr,key);
+        } else
+            ++unkeyed_supported_versions;
+    }
 
     VersionNumber version;
     QList<VersionNumber> supported_versions;
+    //! The sorted comparison keys of the supported versions which have comparison keys.
+    QVector<quint64> supported_keys;
+    //! The number of supported versions which do not have comparison keys, for example because they do not use their revision numbers.
+    int unkeyed_supported_versions;
 };
 
 Qtilities::Core::VersionInformation::VersionInformation(const VersionNumber& version, QList<VersionNumber> supported_versions) {
     d = new VersionInformationPrivateData;
     d->version = version;
     d->supported_versions = supported_versions;
+    for (int i = 0; i < supported_versions.count(); ++i)
+        d->indexSupportedVersion(supported_versions.at(i));
 }
 
 Qtilities::Core::VersionInformation::VersionInformation(int major, int minor, int revision) {
@@ -439,6 +619,8 @@ Qtilities::Core::VersionInformation::VersionInformation(const VersionInformation
     d = new VersionInformationPrivateData;
     d->version = ref.version();
     d->supported_versions = ref.supportedVersions();
+    d->supported_keys = ref.d->supported_keys;
+    d->unkeyed_supported_versions = ref.d->unkeyed_supported_versions;
 }
 
 Qtilities::Core::VersionInformation::~VersionInformation() {
@@ -459,15 +641,31 @@ QList<Qtilities::Core::VersionNumber> Qtilities::Core::VersionInformation::suppo
 
 void Qtilities::Core::VersionInformation::addSupportedVersion(const VersionNumber& version_number) {
     d->supported_versions.append(version_number);
+    d->indexSupportedVersion(version_number);
 }
 
 bool Qtilities::Core::VersionInformation::isSupportedVersion(const VersionNumber& version_number) const {
-    return d->supported_versions.contains(version_number);
+    if (!version_number.hasComparisonKey())
+        return d->supported_versions.contains(version_number);
+
+    // Versions with comparison keys equal each other only when their keys are equal:
+    if (qBinaryFind(d->supported_keys.constBegin(),d->supported_keys.constEnd(),version_number.comparisonKey()) != d->supported_keys.constEnd())
+        return true;
+
+    // Supported versions without comparison keys, for example v1.5 which does not use its revision, still need to be compared one by one:
+    if (d->unkeyed_supported_versions == 0)
+        return false;
+    for (int i = 0; i < d->supported_versions.count(); ++i) {
+        const VersionNumber& supported_version = d->supported_versions.at(i);
+        if (!supported_version.hasComparisonKey() && supported_version == version_number)
+            return true;
+    }
+    return false;
 }
 
 bool Qtilities::Core::VersionInformation::isSupportedVersion(const QString& version_string, const QString& separator) const {
     VersionNumber version_number(version_string,separator);
-    return d->supported_versions.contains(version_number);
+    return isSupportedVersion(version_number);
 }
 
 QStringList Qtilities::Core::VersionInformation::supportedVersionString() const {
@@ -70,6 +70,9 @@ bool is_smaller_and_equal = (ver0 <= ver1); // True
 bool is_smaller = (ver0 < ver1); // True
 \endcode
 
+        Since %Qtilities v1.5, version numbers which use their minor and revision parts are compared using comparisonKey(), which packs the complete
+        version into a single 64-bit integer. Parsing version strings using fromString() does not allocate memory for typical version strings.
+
         For Minor and Revision numbers you can specify the fieldWidth of the QString::number() conversion used using setFieldWidthMinor() and setFieldWidthRevision() respectively. It is also
         possible to control which parts of a version number is used using setIsVersionMinorUsed() and setIsVersionRevisionUsed().
 
@@ -173,6 +176,24 @@ example2_from_string.setIsVersionRevisionUsed(false);
             //! Is null means the version is 0.0.0, this will be the case when object is constructed with default constructor.
             bool isNull() const;
 
+            //! Indicates if comparisonKey() represents this version number exactly.
+            /*!
+              This is the case when the minor and revision parts are used, the major, minor and revision numbers are between 0 and 65535 and the
+              development stage version is between 0 and 4095.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool hasComparisonKey() const;
+            //! Returns the version number packed into a single 64-bit integer, which orders the same way as the comparison operators.
+            /*!
+              The major, minor and revision numbers use 16 bits each, followed by 4 bits for the development stage and 12 bits for the development
+              stage version. Two version numbers for which hasComparisonKey() is true are equal when their keys are equal, and smaller when their
+              keys are smaller. When hasComparisonKey() is false, the parts which do not fit are clamped.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            quint64 comparisonKey() const;
+
             //! Gets the major version.
             int versionMajor() const;
             //! Sets the major version.
@@ -306,6 +327,10 @@ version_info << VersionNumber(2,0,0);
             //! Adds a version number to the list of supported version.
             void addSupportedVersion(const VersionNumber& version_number);
             //! Indicates if a specific version number is supported by this VersionInformation object.
+            /*!
+              Since %Qtilities v1.5, the supported versions are indexed by their VersionNumber::comparisonKey(), thus checking a version
+              number which has a comparison key is done using a binary search.
+              */
             bool isSupportedVersion(const VersionNumber& version_number) const;
             //! Indicates if a specific version number is supported by this VersionInformation object by providing a version string.
             /*!
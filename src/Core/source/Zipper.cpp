@@ -11,15 +11,767 @@
 #include "FileUtils.h"
 #include "QtilitiesFileInfo.h"
 
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QRegExp>
+#include <QTime>
+#include <QTimer>
+
+#include <string.h>
+
 struct Qtilities::Core::ZipperPrivateData {
-    ZipperPrivateData() : zip_process("zipper") {}
+    ZipperPrivateData() : zip_process("zipper"),
+        backend(Zipper::AutomaticBackend) {}
 
     QString                 ignore_list;
     QtilitiesProcess        zip_process;
     QString                 path_7za;
     QString                 temp_dir;
+    Zipper::Backend         backend;
 };
 
+namespace {
+    // -------------------------
+    // In-process ZIP support
+    // -------------------------
+    const quint32 ZIP_LOCAL_HEADER_SIGNATURE = 0x04034b50;
+    const quint32 ZIP_CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+    const quint32 ZIP_END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+    const quint16 ZIP_VERSION = 20;
+    const quint16 ZIP_FLAG_ENCRYPTED = 0x0001;
+    const quint16 ZIP_FLAG_UTF8 = 0x0800;
+    const quint16 ZIP_METHOD_STORED = 0;
+    const quint16 ZIP_METHOD_DEFLATED = 8;
+    const quint32 ZIP_ATTRIBUTE_DIRECTORY = 0x10;
+
+    // -------------------------
+    // External backend
+    // -------------------------
+    //! The interval in milliseconds at which executeCommand() checks the state of the backend process.
+    const int ZIPPER_POLLING_INTERVAL = 10;
+    //! The time in milliseconds for which executeCommand() waits for the task of a backend process which is no longer running to complete.
+    const int ZIPPER_COMPLETION_TIMEOUT = 5000;
+
+    struct ZipEntryInfo {
+        ZipEntryInfo() : flags(0), method(ZIP_METHOD_STORED), dos_time(0), dos_date(0), crc(0), compressed_size(0), uncompressed_size(0),
+            external_attributes(0), local_header_offset(0) {}
+
+        QString     name;
+        quint16     flags;
+        quint16     method;
+        quint16     dos_time;
+        quint16     dos_date;
+        quint32     crc;
+        quint32     compressed_size;
+        quint32     uncompressed_size;
+        quint32     external_attributes;
+        quint32     local_header_offset;
+    };
+
+    struct ZipCrc32Table {
+        ZipCrc32Table() {
+            for (quint32 i = 0; i < 256; ++i) {
+                quint32 c = i;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+                values[i] = c;
+            }
+        }
+
+        quint32 values[256];
+    };
+
+    Q_GLOBAL_STATIC(ZipCrc32Table,zipCrc32Table)
+
+    quint32 zipCrc32(const QByteArray& data) {
+        const quint32* table = zipCrc32Table()->values;
+        quint32 crc = 0xFFFFFFFF;
+        const uchar* bytes = (const uchar*) data.constData();
+        for (int i = 0; i < data.size(); ++i)
+            crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        return crc ^ 0xFFFFFFFF;
+    }
+
+    void toDosDateTime(const QDateTime& date_time, quint16* dos_time, quint16* dos_date) {
+        const QDate date = date_time.date();
+        const QTime time = date_time.time();
+        if (!date_time.isValid() || date.year() < 1980) {
+            // The earliest date which can be stored, 1 January 1980:
+            *dos_time = 0;
+            *dos_date = (1 << 5) | 1;
+            return;
+        }
+        *dos_time = (quint16) ((time.hour() << 11) | (time.minute() << 5) | (time.second() / 2));
+        *dos_date = (quint16) (((date.year() - 1980) << 9) | (date.month() << 5) | date.day());
+    }
+
+    QDateTime fromDosDateTime(quint16 dos_time, quint16 dos_date) {
+        return QDateTime(QDate(1980 + (dos_date >> 9),(dos_date >> 5) & 0x0F,dos_date & 0x1F),QTime(dos_time >> 11,(dos_time >> 5) & 0x3F,(dos_time & 0x1F) * 2));
+    }
+
+    // Compresses data to a raw deflate stream as stored in ZIP archives.
+    QByteArray rawDeflate(const QByteArray& data) {
+        // qCompress() writes the uncompressed size followed by a zlib stream. Without the size, the 2 byte zlib header and the adler32
+        // checksum at the end, the zlib stream is the raw deflate stream:
+        QByteArray compressed = qCompress(data);
+        if (compressed.size() < 10)
+            return QByteArray();
+        return compressed.mid(6,compressed.size() - 10);
+    }
+
+    // -------------------------
+    // Inflate
+    // -------------------------
+    // qUncompress() can only read zlib streams, which need the adler32 checksum of the uncompressed data. ZIP archives only store raw deflate
+    // streams with a CRC-32 checksum, thus they are inflated using the decoder below, which follows the canonical Huffman decoding of RFC 1951.
+    const int INFLATE_MAX_BITS = 15;
+
+    struct InflateHuffman {
+        short count[INFLATE_MAX_BITS + 1];
+        short symbol[288];
+    };
+
+    class Inflater {
+    public:
+        Inflater(const QByteArray& input, char* output, qint64 output_size) :
+            in((const uchar*) input.constData()), in_size(input.size()), in_pos(0), bit_buffer(0), bit_count(0),
+            out(output), out_size(output_size), out_pos(0), input_error(false) {}
+
+        // Returns 0 on success.
+        int inflate() {
+            int last;
+            do {
+                last = bits(1);
+                const int type = bits(2);
+                int result;
+                if (type == 0)
+                    result = stored();
+                else if (type == 1)
+                    result = fixed();
+                else if (type == 2)
+                    result = dynamic();
+                else
+                    result = -1;
+                if (input_error)
+                    return -2;
+                if (result != 0)
+                    return result;
+            } while (!last);
+            return 0;
+        }
+
+        qint64 outputSize() const { return out_pos; }
+
+    private:
+        int bits(int need) {
+            quint32 value = bit_buffer;
+            while (bit_count < need) {
+                if (in_pos >= in_size) {
+                    input_error = true;
+                    return 0;
+                }
+                value |= (quint32) in[in_pos++] << bit_count;
+                bit_count += 8;
+            }
+            bit_buffer = value >> need;
+            bit_count -= need;
+            return (int) (value & ((1U << need) - 1));
+        }
+
+        int stored() {
+            // Stored blocks start at a byte boundary:
+            bit_buffer = 0;
+            bit_count = 0;
+            if (in_pos + 4 > in_size)
+                return -2;
+            const quint32 length = in[in_pos] | (in[in_pos + 1] << 8);
+            const quint32 length_complement = in[in_pos + 2] | (in[in_pos + 3] << 8);
+            in_pos += 4;
+            if (length != (~length_complement & 0xFFFF))
+                return -3;
+            if (in_pos + length > in_size)
+                return -2;
+            if (out_pos + length > out_size)
+                return -4;
+            memcpy(out + out_pos,in + in_pos,length);
+            in_pos += length;
+            out_pos += length;
+            return 0;
+        }
+
+        int decode(const InflateHuffman& huffman) {
+            int code = 0;
+            int first = 0;
+            int index = 0;
+            for (int length = 1; length <= INFLATE_MAX_BITS; ++length) {
+                code |= bits(1);
+                if (input_error)
+                    return -2;
+                const int count = huffman.count[length];
+                if (code - count < first)
+                    return huffman.symbol[index + (code - first)];
+                index += count;
+                first += count;
+                first <<= 1;
+                code <<= 1;
+            }
+            return -5;
+        }
+
+        // Returns 0 for a complete code, a negative value for an over subscribed code and a positive value for an incomplete code.
+        static int construct(InflateHuffman* huffman, const short* lengths, int count) {
+            for (int length = 0; length <= INFLATE_MAX_BITS; ++length)
+                huffman->count[length] = 0;
+            for (int symbol = 0; symbol < count; ++symbol)
+                ++huffman->count[lengths[symbol]];
+            if (huffman->count[0] == count)
+                return 0;
+
+            int left = 1;
+            for (int length = 1; length <= INFLATE_MAX_BITS; ++length) {
+                left <<= 1;
+                left -= huffman->count[length];
+                if (left < 0)
+                    return left;
+            }
+
+            short offsets[INFLATE_MAX_BITS + 1];
+            offsets[1] = 0;
+            for (int length = 1; length < INFLATE_MAX_BITS; ++length)
+                offsets[length + 1] = offsets[length] + huffman->count[length];
+            for (int symbol = 0; symbol < count; ++symbol) {
+                if (lengths[symbol] != 0)
+                    huffman->symbol[offsets[lengths[symbol]]++] = (short) symbol;
+            }
+            return left;
+        }
+
+        int codes(const InflateHuffman& length_code, const InflateHuffman& distance_code) {
+            static const short length_base[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+            static const short length_extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+            static const short distance_base[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+                                                     4097, 6145, 8193, 12289, 16385, 24577 };
+            static const short distance_extra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+            int symbol;
+            do {
+                symbol = decode(length_code);
+                if (symbol < 0)
+                    return symbol;
+                if (symbol < 256) {
+                    if (out_pos >= out_size)
+                        return -4;
+                    out[out_pos++] = (char) symbol;
+                } else if (symbol > 256) {
+                    symbol -= 257;
+                    if (symbol >= 29)
+                        return -6;
+                    const int length = length_base[symbol] + bits(length_extra[symbol]);
+                    symbol = decode(distance_code);
+                    if (symbol < 0)
+                        return symbol;
+                    if (symbol >= 30)
+                        return -6;
+                    const int distance = distance_base[symbol] + bits(distance_extra[symbol]);
+                    if (input_error)
+                        return -2;
+                    if (distance > out_pos)
+                        return -7;
+                    if (out_pos + length > out_size)
+                        return -4;
+                    // The regions can overlap, thus the bytes are copied one at a time:
+                    for (int i = 0; i < length; ++i) {
+                        out[out_pos] = out[out_pos - distance];
+                        ++out_pos;
+                    }
+                }
+            } while (symbol != 256);
+            return 0;
+        }
+
+        int fixed() {
+            // The fixed codes are cheap to construct compared to decoding a block:
+            InflateHuffman length_code;
+            InflateHuffman distance_code;
+            short lengths[288];
+            int symbol = 0;
+            for (; symbol < 144; ++symbol)
+                lengths[symbol] = 8;
+            for (; symbol < 256; ++symbol)
+                lengths[symbol] = 9;
+            for (; symbol < 280; ++symbol)
+                lengths[symbol] = 7;
+            for (; symbol < 288; ++symbol)
+                lengths[symbol] = 8;
+            construct(&length_code,lengths,288);
+            for (symbol = 0; symbol < 30; ++symbol)
+                lengths[symbol] = 5;
+            construct(&distance_code,lengths,30);
+            return codes(length_code,distance_code);
+        }
+
+        int dynamic() {
+            static const short order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+            const int length_count = bits(5) + 257;
+            const int distance_count = bits(5) + 1;
+            const int code_count = bits(4) + 4;
+            if (input_error)
+                return -2;
+            if (length_count > 286 || distance_count > 30)
+                return -8;
+
+            short lengths[286 + 30];
+            int index = 0;
+            for (; index < code_count; ++index)
+                lengths[order[index]] = (short) bits(3);
+            for (; index < 19; ++index)
+                lengths[order[index]] = 0;
+            if (input_error)
+                return -2;
+
+            InflateHuffman length_code;
+            InflateHuffman distance_code;
+            if (construct(&length_code,lengths,19) != 0)
+                return -9;
+
+            index = 0;
+            while (index < length_count + distance_count) {
+                int symbol = decode(length_code);
+                if (symbol < 0)
+                    return symbol;
+                if (symbol < 16)
+                    lengths[index++] = (short) symbol;
+                else {
+                    short length = 0;
+                    if (symbol == 16) {
+                        if (index == 0)
+                            return -10;
+                        length = lengths[index - 1];
+                        symbol = 3 + bits(2);
+                    } else if (symbol == 17)
+                        symbol = 3 + bits(3);
+                    else
+                        symbol = 11 + bits(7);
+                    if (input_error)
+                        return -2;
+                    if (index + symbol > length_count + distance_count)
+                        return -10;
+                    while (symbol--)
+                        lengths[index++] = length;
+                }
+            }
+
+            // The end of block code must exist:
+            if (lengths[256] == 0)
+                return -11;
+
+            // Incomplete codes are only allowed when they consist of a single code of one bit:
+            int result = construct(&length_code,lengths,length_count);
+            if (result < 0 || (result > 0 && length_count != length_code.count[0] + length_code.count[1]))
+                return -12;
+            result = construct(&distance_code,lengths + length_count,distance_count);
+            if (result < 0 || (result > 0 && distance_count != distance_code.count[0] + distance_code.count[1]))
+                return -12;
+
+            return codes(length_code,distance_code);
+        }
+
+        const uchar*    in;
+        qint64          in_size;
+        qint64          in_pos;
+        quint32         bit_buffer;
+        int             bit_count;
+        char*           out;
+        qint64          out_size;
+        qint64          out_pos;
+        bool            input_error;
+    };
+
+    // -------------------------
+    // Archive reading
+    // -------------------------
+    bool isZipArchive(const QString& file_path) {
+        QFile file(file_path);
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+        const QByteArray signature = file.read(4);
+        // Empty archives only contain the end of central directory record:
+        return signature == QByteArray("PK\x03\x04",4) || signature == QByteArray("PK\x05\x06",4);
+    }
+
+    bool readZipDirectory(QIODevice* device, QList<ZipEntryInfo>* entries, QString* error) {
+        const qint64 size = device->size();
+        if (size < 22) {
+            *error = "The archive is too small to be a ZIP archive.";
+            return false;
+        }
+
+        // The end of central directory record is followed by a comment of at most 65535 bytes:
+        const qint64 search_size = qMin(size,(qint64) 22 + 65535);
+        device->seek(size - search_size);
+        const QByteArray tail = device->read(search_size);
+        int record_position = -1;
+        for (int i = tail.size() - 22; i >= 0; --i) {
+            if (tail.at(i) == 'P' && tail.at(i + 1) == 'K' && tail.at(i + 2) == 0x05 && tail.at(i + 3) == 0x06) {
+                record_position = i;
+                break;
+            }
+        }
+        if (record_position == -1) {
+            *error = "The end of the central directory of the archive could not be found.";
+            return false;
+        }
+
+        QDataStream record(tail.mid(record_position,22));
+        record.setByteOrder(QDataStream::LittleEndian);
+        quint32 signature, directory_size, directory_offset;
+        quint16 disk, directory_disk, disk_entry_count, entry_count;
+        record >> signature >> disk >> directory_disk >> disk_entry_count >> entry_count >> directory_size >> directory_offset;
+        if (disk != 0 || directory_disk != 0 || disk_entry_count != entry_count) {
+            *error = "Archives which span multiple disks are not supported in-process.";
+            return false;
+        }
+        if (directory_offset == 0xFFFFFFFF || entry_count == 0xFFFF) {
+            *error = "ZIP64 archives are not supported in-process.";
+            return false;
+        }
+
+        if (!device->seek(directory_offset)) {
+            *error = "The central directory of the archive could not be read.";
+            return false;
+        }
+        const QByteArray directory = device->read(directory_size);
+        if ((quint32) directory.size() != directory_size) {
+            *error = "The central directory of the archive could not be read.";
+            return false;
+        }
+
+        QDataStream stream(directory);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        for (int i = 0; i < entry_count; ++i) {
+            ZipEntryInfo entry;
+            quint16 version_made_by, version_needed, name_length, extra_length, comment_length, disk_start, internal_attributes;
+            stream >> signature;
+            if (signature != ZIP_CENTRAL_HEADER_SIGNATURE) {
+                *error = "The central directory of the archive is corrupt.";
+                return false;
+            }
+            stream >> version_made_by >> version_needed >> entry.flags >> entry.method >> entry.dos_time >> entry.dos_date >> entry.crc
+                   >> entry.compressed_size >> entry.uncompressed_size >> name_length >> extra_length >> comment_length >> disk_start
+                   >> internal_attributes >> entry.external_attributes >> entry.local_header_offset;
+
+            QByteArray name(name_length,'\0');
+            if (stream.readRawData(name.data(),name_length) != name_length || stream.skipRawData(extra_length + comment_length) != extra_length + comment_length) {
+                *error = "The central directory of the archive is corrupt.";
+                return false;
+            }
+            if (entry.flags & ZIP_FLAG_UTF8)
+                entry.name = QString::fromUtf8(name.constData(),name.size());
+            else
+                entry.name = QString::fromLocal8Bit(name.constData(),name.size());
+            entry.name.replace('\\','/');
+            entries->append(entry);
+        }
+        return true;
+    }
+
+    bool readZipEntry(QIODevice* device, const ZipEntryInfo& entry, QByteArray* data, QString* error) {
+        if (entry.flags & ZIP_FLAG_ENCRYPTED) {
+            *error = QString("Entry \"%1\" is encrypted, encrypted entries are not supported in-process.").arg(entry.name);
+            return false;
+        }
+        if (entry.uncompressed_size >= 0x7FFFFFFF || entry.compressed_size >= 0x7FFFFFFF) {
+            *error = QString("Entry \"%1\" is 2GB or larger, such entries are not supported in-process.").arg(entry.name);
+            return false;
+        }
+        if (entry.method != ZIP_METHOD_STORED && entry.method != ZIP_METHOD_DEFLATED) {
+            *error = QString("Entry \"%1\" uses compression method %2, only stored and deflated entries are supported in-process.").arg(entry.name).arg(entry.method);
+            return false;
+        }
+
+        // The local header can have a different extra field than the central directory:
+        quint32 signature;
+        quint16 name_length, extra_length;
+        QDataStream stream(device);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        if (!device->seek(entry.local_header_offset)) {
+            *error = QString("Entry \"%1\" could not be found in the archive.").arg(entry.name);
+            return false;
+        }
+        stream >> signature;
+        stream.skipRawData(22);
+        stream >> name_length >> extra_length;
+        stream.skipRawData(name_length + extra_length);
+        if (signature != ZIP_LOCAL_HEADER_SIGNATURE || stream.status() != QDataStream::Ok) {
+            *error = QString("The local header of entry \"%1\" is corrupt.").arg(entry.name);
+            return false;
+        }
+
+        const QByteArray compressed = device->read(entry.compressed_size);
+        if ((quint32) compressed.size() != entry.compressed_size) {
+            *error = QString("The data of entry \"%1\" could not be read.").arg(entry.name);
+            return false;
+        }
+
+        if (entry.method == ZIP_METHOD_STORED)
+            *data = compressed;
+        else {
+            data->resize((int) entry.uncompressed_size);
+            Inflater inflater(compressed,data->data(),entry.uncompressed_size);
+            if (inflater.inflate() != 0 || inflater.outputSize() != (qint64) entry.uncompressed_size) {
+                *error = QString("The data of entry \"%1\" is corrupt.").arg(entry.name);
+                data->clear();
+                return false;
+            }
+        }
+
+        if ((quint32) data->size() != entry.uncompressed_size || zipCrc32(*data) != entry.crc) {
+            *error = QString("The checksum of entry \"%1\" does not match its data.").arg(entry.name);
+            data->clear();
+            return false;
+        }
+        return true;
+    }
+
+    // Returns the path in destination_path at which an entry must be extracted, or an empty string for entries which would be extracted outside of it.
+    QString entryDestinationPath(const QString& destination_path, const QString& entry_name) {
+        const QString clean_name = QDir::cleanPath(entry_name);
+        if (clean_name.isEmpty() || clean_name == "." || clean_name.startsWith('/') || clean_name.startsWith("../") || clean_name == ".." || clean_name.contains(':'))
+            return QString();
+        return destination_path + "/" + clean_name;
+    }
+
+    // -------------------------
+    // Archive writing
+    // -------------------------
+    class ZipArchiveWriter {
+    public:
+        ZipArchiveWriter(const QString& file_path) : file(file_path) {
+            stream.setByteOrder(QDataStream::LittleEndian);
+        }
+
+        bool open(QString* error) {
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                *error = "Failed to open archive for writing: " + file.fileName();
+                return false;
+            }
+            stream.setDevice(&file);
+            return true;
+        }
+
+        bool addDirectory(const QString& entry_name, const QDateTime& modified) {
+            ZipEntryInfo entry;
+            entry.name = entry_name + "/";
+            entry.external_attributes = ZIP_ATTRIBUTE_DIRECTORY;
+            toDosDateTime(modified,&entry.dos_time,&entry.dos_date);
+            return writeEntry(entry,QByteArray());
+        }
+
+        bool addFile(const QString& entry_name, const QString& file_path, bool compress, QString* error) {
+            QFile source(file_path);
+            if (!source.open(QIODevice::ReadOnly)) {
+                *error = "Failed to open file for archiving: " + file_path;
+                return false;
+            }
+            if (source.size() >= (qint64) 0x7FFFFFFF) {
+                *error = "Files of 2GB and larger are not supported in-process: " + file_path;
+                return false;
+            }
+            const QByteArray data = source.readAll();
+
+            ZipEntryInfo entry;
+            entry.name = entry_name;
+            entry.crc = zipCrc32(data);
+            entry.uncompressed_size = data.size();
+            toDosDateTime(QFileInfo(file_path).lastModified(),&entry.dos_time,&entry.dos_date);
+
+            if (compress) {
+                // Data which does not become smaller is stored, as done by other zip tools:
+                const QByteArray deflated = rawDeflate(data);
+                if (!deflated.isEmpty() && deflated.size() < data.size()) {
+                    entry.method = ZIP_METHOD_DEFLATED;
+                    if (!writeEntry(entry,deflated)) {
+                        *error = "Failed to write to archive: " + file.fileName();
+                        return false;
+                    }
+                    return true;
+                }
+            }
+            if (!writeEntry(entry,data)) {
+                *error = "Failed to write to archive: " + file.fileName();
+                return false;
+            }
+            return true;
+        }
+
+        bool finish(QString* error) {
+            const qint64 directory_offset = file.pos();
+            for (int i = 0; i < entries.count(); ++i) {
+                const ZipEntryInfo& entry = entries.at(i);
+                const QByteArray name = entry.name.toUtf8();
+                stream << ZIP_CENTRAL_HEADER_SIGNATURE << ZIP_VERSION << ZIP_VERSION << entry.flags << entry.method << entry.dos_time << entry.dos_date
+                       << entry.crc << entry.compressed_size << entry.uncompressed_size << (quint16) name.size() << (quint16) 0 << (quint16) 0
+                       << (quint16) 0 << (quint16) 0 << entry.external_attributes << entry.local_header_offset;
+                stream.writeRawData(name.constData(),name.size());
+            }
+            const qint64 directory_size = file.pos() - directory_offset;
+
+            if (entries.count() >= 0xFFFF || directory_offset + directory_size > (qint64) 0xFFFFFFFF) {
+                *error = "Archives with more than 65534 entries or larger than 4GB are not supported in-process.";
+                file.close();
+                return false;
+            }
+
+            stream << ZIP_END_OF_CENTRAL_DIRECTORY_SIGNATURE << (quint16) 0 << (quint16) 0 << (quint16) entries.count() << (quint16) entries.count()
+                   << (quint32) directory_size << (quint32) directory_offset << (quint16) 0;
+            const bool success = (stream.status() == QDataStream::Ok);
+            file.close();
+            if (!success)
+                *error = "Failed to write to archive: " + file.fileName();
+            return success;
+        }
+
+    private:
+        bool writeEntry(ZipEntryInfo& entry, const QByteArray& data) {
+            if (file.pos() > (qint64) 0xFFFFFFFF)
+                return false;
+            entry.flags = ZIP_FLAG_UTF8;
+            entry.compressed_size = data.size();
+            entry.local_header_offset = (quint32) file.pos();
+
+            const QByteArray name = entry.name.toUtf8();
+            stream << ZIP_LOCAL_HEADER_SIGNATURE << ZIP_VERSION << entry.flags << entry.method << entry.dos_time << entry.dos_date << entry.crc
+                   << entry.compressed_size << entry.uncompressed_size << (quint16) name.size() << (quint16) 0;
+            stream.writeRawData(name.constData(),name.size());
+            if (!data.isEmpty())
+                stream.writeRawData(data.constData(),data.size());
+            entries.append(entry);
+            return stream.status() == QDataStream::Ok;
+        }
+
+        QFile                   file;
+        QDataStream             stream;
+        QList<ZipEntryInfo>     entries;
+    };
+
+    // -------------------------
+    // Source collection
+    // -------------------------
+    // A file or folder archived or copied in-process.
+    struct ZipperSourceItem {
+        //! The path of the item relative to the archive root, using / as separator.
+        QString     entry_name;
+        QString     file_path;
+        bool        is_dir;
+    };
+
+    QList<QRegExp> ignorePatterns(const QString& ignore_list) {
+        QList<QRegExp> patterns;
+        QStringList ignore_list_items = ignore_list.split(" ",QString::SkipEmptyParts);
+        foreach (const QString& ignore_token, ignore_list_items)
+            patterns << QRegExp(ignore_token,Qt::CaseInsensitive,QRegExp::Wildcard);
+        return patterns;
+    }
+
+    // Ignore patterns apply to the names of files and folders at all levels, like the -xr! switch of 7za:
+    bool isIgnored(const QString& name, const QList<QRegExp>& ignore_patterns) {
+        for (int i = 0; i < ignore_patterns.count(); ++i) {
+            if (ignore_patterns.at(i).exactMatch(name))
+                return true;
+        }
+        return false;
+    }
+
+    void addSourceItems(const QFileInfo& info, const QString& entry_name, const QList<QRegExp>& ignore_patterns, QList<ZipperSourceItem>* items) {
+        if (isIgnored(info.fileName(),ignore_patterns))
+            return;
+
+        ZipperSourceItem item;
+        item.entry_name = entry_name;
+        item.file_path = info.absoluteFilePath();
+        item.is_dir = info.isDir();
+        items->append(item);
+
+        // Symbolic links to folders are not followed since they can create cycles:
+        if (!info.isDir() || info.isSymLink())
+            return;
+
+        QDir dir(info.absoluteFilePath());
+        const QFileInfoList children = dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System,QDir::Name | QDir::DirsFirst);
+        for (int i = 0; i < children.count(); ++i)
+            addSourceItems(children.at(i),entry_name + "/" + children.at(i).fileName(),ignore_patterns,items);
+    }
+
+    // Collects the items under source_path using the same conventions as 7za: When source_path ends with /*, only its contents are collected.
+    bool collectSourceItems(const QString& source_path, const QList<QRegExp>& ignore_patterns, QList<ZipperSourceItem>* items, QString* error) {
+        QString path = QDir::fromNativeSeparators(source_path);
+        const bool contents_only = path.endsWith("/*");
+        if (contents_only)
+            path.chop(2);
+        while (path.length() > 1 && path.endsWith('/'))
+            path.chop(1);
+
+        QFileInfo info(path);
+        if (!info.exists()) {
+            *error = "Source path does not exist: " + source_path;
+            return false;
+        }
+
+        if (contents_only) {
+            if (!info.isDir()) {
+                *error = "Source path is not a folder: " + source_path;
+                return false;
+            }
+            QDir dir(info.absoluteFilePath());
+            const QFileInfoList children = dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System,QDir::Name | QDir::DirsFirst);
+            for (int i = 0; i < children.count(); ++i)
+                addSourceItems(children.at(i),children.at(i).fileName(),ignore_patterns,items);
+        } else
+            addSourceItems(info,info.fileName(),ignore_patterns,items);
+        return true;
+    }
+
+    bool writeZipArchive(const QString& output_file, const QList<ZipperSourceItem>& items, bool compress, QStringList* errorMsgs) {
+        QString error;
+        ZipArchiveWriter writer(output_file);
+        if (!writer.open(&error)) {
+            if (errorMsgs)
+                errorMsgs->append(error);
+            return false;
+        }
+
+        for (int i = 0; i < items.count(); ++i) {
+            const ZipperSourceItem& item = items.at(i);
+            bool success;
+            if (item.is_dir)
+                success = writer.addDirectory(item.entry_name,QFileInfo(item.file_path).lastModified());
+            else
+                success = writer.addFile(item.entry_name,item.file_path,compress,&error);
+            if (!success) {
+                if (errorMsgs)
+                    errorMsgs->append(error.isEmpty() ? "Failed to write to archive: " + output_file : error);
+                writer.finish(&error);
+                QFile::remove(output_file);
+                return false;
+            }
+        }
+
+        if (!writer.finish(&error)) {
+            if (errorMsgs)
+                errorMsgs->append(error);
+            QFile::remove(output_file);
+            return false;
+        }
+        return true;
+    }
+}
+
 Qtilities::Core::Zipper::Zipper(const QString& path_7za, const QString& ignore_list, const QString &temp_dir, QObject *parent) :
     QObject(parent)
 {
@@ -48,6 +800,46 @@ QtilitiesProcess* Qtilities::Core::Zipper::zipProcess() {
     return &d->zip_process;
 }
 
+void Qtilities::Core::Zipper::setBackend(Backend backend) {
+    d->backend = backend;
+}
+
+Qtilities::Core::Zipper::Backend Qtilities::Core::Zipper::backend() const {
+    return d->backend;
+}
+
+bool Qtilities::Core::Zipper::createInProcess(const QString& output_file) const {
+    if (d->backend == ExternalBackend)
+        return false;
+
+    // The archive type is determined in the same way as for 7za, where unknown extensions create ZIP archives:
+    QFileInfo file_info(output_file);
+    QString suffix = file_info.completeSuffix();
+    if (suffix.endsWith("zip") || suffix.isEmpty() || !isValidExtension(suffix))
+        return true;
+
+    QList<ArchiveType> archive_types = validArchiveTypes();
+    for (int i = 0; i < archive_types.count(); ++i) {
+        if (archive_types.at(i).extension == suffix)
+            return archive_types.at(i).in_process;
+    }
+    return false;
+}
+
+bool Qtilities::Core::Zipper::readInProcess(const QString& file_path, const QStringList& additional_arguments) const {
+    if (d->backend == ExternalBackend)
+        return false;
+    if (d->backend == InProcessBackend)
+        return true;
+
+    // Existing files are always overwritten in-process, which is what these switches request from 7za:
+    foreach (const QString& argument, additional_arguments) {
+        if (argument != "-aoa" && argument != "-y")
+            return false;
+    }
+    return isZipArchive(file_path);
+}
+
 // -------------------------
 // Zip Process Evoking Functions
 // -------------------------
@@ -69,6 +861,54 @@ QString Qtilities::Core::Zipper::zipInfo(const QString& file_path, bool *ok, QSt
         return QString();
     }
 
+    if (readInProcess(file_path)) {
+        QFile file(file_path);
+        QList<ZipEntryInfo> entries;
+        QString error;
+        if (!file.open(QIODevice::ReadOnly) || !readZipDirectory(&file,&entries,&error)) {
+            if (errorMsgs)
+                errorMsgs->append(error.isEmpty() ? "Failed to open archive: " + file_path : error);
+            if (ok)
+                *ok = false;
+            return QString();
+        }
+
+        // The listing uses the same layout as the l command of 7za:
+        const QString separator = "------------------- ----- ------------ ------------  ------------------------";
+        QStringList lines;
+        lines << "   Date      Time    Attr         Size   Compressed  Name";
+        lines << separator;
+        qint64 total_size = 0;
+        qint64 total_compressed = 0;
+        int file_count = 0;
+        int folder_count = 0;
+        for (int i = 0; i < entries.count(); ++i) {
+            const ZipEntryInfo& entry = entries.at(i);
+            const bool is_dir = entry.name.endsWith('/') || (entry.external_attributes & ZIP_ATTRIBUTE_DIRECTORY);
+            if (is_dir)
+                ++folder_count;
+            else
+                ++file_count;
+            total_size += entry.uncompressed_size;
+            total_compressed += entry.compressed_size;
+            lines << QString("%1 %2 %3 %4  %5").arg(fromDosDateTime(entry.dos_time,entry.dos_date).toString("yyyy-MM-dd hh:mm:ss"))
+                     .arg(is_dir ? "D...." : "....A").arg(entry.uncompressed_size,12).arg(entry.compressed_size,12).arg(entry.name);
+        }
+        lines << separator;
+        lines << QString("%1 %2 %3  %4 files, %5 folders").arg(QString(),25).arg(total_size,12).arg(total_compressed,12).arg(file_count).arg(folder_count);
+
+        if (ok)
+            *ok = true;
+        return lines.join("\n");
+    }
+    if (d->backend == InProcessBackend) {
+        if (errorMsgs)
+            errorMsgs->append("The archive type is not supported in-process: " + file_path);
+        if (ok)
+            *ok = false;
+        return QString();
+    }
+
     QStringList arguments;
     arguments << "l";
     arguments << file_path;
@@ -83,6 +923,78 @@ QString Qtilities::Core::Zipper::zipInfo(const QString& file_path, bool *ok, QSt
     return buffer;
 }
 
+QStringList Qtilities::Core::Zipper::archiveEntries(const QString& file_path, bool* ok, QStringList* errorMsgs) {
+    if (ok)
+        *ok = false;
+    if (d->backend == ExternalBackend || !isZipArchive(file_path)) {
+        if (errorMsgs)
+            errorMsgs->append("Only ZIP archives can be listed in-process: " + file_path);
+        return QStringList();
+    }
+
+    QFile file(file_path);
+    QList<ZipEntryInfo> entries;
+    QString error;
+    if (!file.open(QIODevice::ReadOnly) || !readZipDirectory(&file,&entries,&error)) {
+        if (errorMsgs)
+            errorMsgs->append(error.isEmpty() ? "Failed to open archive: " + file_path : error);
+        return QStringList();
+    }
+
+    QStringList names;
+    for (int i = 0; i < entries.count(); ++i)
+        names << entries.at(i).name;
+    if (ok)
+        *ok = true;
+    return names;
+}
+
+bool Qtilities::Core::Zipper::extractEntry(const QString& file_path, const QString& entry_name, QIODevice* device, QStringList* errorMsgs) {
+    if (!device || !device->isWritable()) {
+        if (errorMsgs)
+            errorMsgs->append("The device to extract to is not open for writing.");
+        return false;
+    }
+    if (d->backend == ExternalBackend || !isZipArchive(file_path)) {
+        if (errorMsgs)
+            errorMsgs->append("Entries can only be extracted from ZIP archives in-process: " + file_path);
+        return false;
+    }
+
+    // Only the central directory and the data of the entry itself are read:
+    QFile file(file_path);
+    QList<ZipEntryInfo> entries;
+    QString error;
+    if (!file.open(QIODevice::ReadOnly) || !readZipDirectory(&file,&entries,&error)) {
+        if (errorMsgs)
+            errorMsgs->append(error.isEmpty() ? "Failed to open archive: " + file_path : error);
+        return false;
+    }
+
+    const QString name = QDir::fromNativeSeparators(entry_name);
+    for (int i = 0; i < entries.count(); ++i) {
+        if (entries.at(i).name != name)
+            continue;
+
+        QByteArray data;
+        if (!readZipEntry(&file,entries.at(i),&data,&error)) {
+            if (errorMsgs)
+                errorMsgs->append(error);
+            return false;
+        }
+        if (device->write(data) != data.size()) {
+            if (errorMsgs)
+                errorMsgs->append("Failed to write the extracted entry: " + entry_name);
+            return false;
+        }
+        return true;
+    }
+
+    if (errorMsgs)
+        errorMsgs->append(QString("Entry \"%1\" does not exist in archive: %2").arg(entry_name).arg(file_path));
+    return false;
+}
+
 bool Zipper::zipFiles(const QStringList &files, const QString &output_file, QStringList *errorMsgs) {
     if (files.isEmpty()) {
         if (errorMsgs)
@@ -105,6 +1017,26 @@ bool Zipper::zipFiles(const QStringList &files, const QString &output_file, QStr
         }
     }
 
+    if (createInProcess(output_file)) {
+        // Files are stored using their names, folders are added with their contents:
+        QList<QRegExp> ignore_patterns = ignorePatterns(d->ignore_list);
+        QList<ZipperSourceItem> items;
+        foreach (const QString& file, files) {
+            QString error;
+            if (!collectSourceItems(file,ignore_patterns,&items,&error)) {
+                if (errorMsgs)
+                    errorMsgs->append(error);
+                return false;
+            }
+        }
+        return writeZipArchive(output_file,items,true,errorMsgs);
+    }
+    if (d->backend == InProcessBackend) {
+        if (errorMsgs)
+            errorMsgs->append("The archive type is not supported in-process: " + output_file);
+        return false;
+    }
+
     QFileInfo file_info(output_file);
     QStringList arguments;
     arguments << "a";
@@ -163,6 +1095,22 @@ bool Qtilities::Core::Zipper::zipFolder(const QString& source_path, const QStrin
         }
     }
 
+    if (createInProcess(output_file)) {
+        QList<ZipperSourceItem> items;
+        QString error;
+        if (!collectSourceItems(source_path,ignorePatterns(d->ignore_list),&items,&error)) {
+            if (errorMsgs)
+                errorMsgs->append(error);
+            return false;
+        }
+        return writeZipArchive(output_file,items,mode == CompressMode,errorMsgs);
+    }
+    if (d->backend == InProcessBackend) {
+        if (errorMsgs)
+            errorMsgs->append("The archive type is not supported in-process: " + output_file);
+        return false;
+    }
+
     QFileInfo file_info(output_file);
     QStringList arguments;
     arguments << "a";
@@ -209,6 +1157,57 @@ bool Qtilities::Core::Zipper::unzipFolder(const QString& source_path, const QStr
         }
     }
 
+    if (readInProcess(source_path,additional_arguments)) {
+        QFile file(source_path);
+        QList<ZipEntryInfo> entries;
+        QString error;
+        if (!file.open(QIODevice::ReadOnly) || !readZipDirectory(&file,&entries,&error)) {
+            if (errorMsgs)
+                errorMsgs->append(error.isEmpty() ? "Failed to open archive: " + source_path : error);
+            return false;
+        }
+
+        QString extract_path = destination_path.isEmpty() ? QDir::currentPath() : destination_path;
+        QDir dir;
+        for (int i = 0; i < entries.count(); ++i) {
+            const ZipEntryInfo& entry = entries.at(i);
+            const QString entry_path = entryDestinationPath(extract_path,entry.name);
+            if (entry_path.isEmpty()) {
+                if (errorMsgs)
+                    errorMsgs->append("Archive entry would be extracted outside of the destination folder: " + entry.name);
+                return false;
+            }
+
+            if (entry.name.endsWith('/')) {
+                if (!dir.mkpath(entry_path)) {
+                    if (errorMsgs)
+                        errorMsgs->append("Failed to create folder at: " + entry_path);
+                    return false;
+                }
+                continue;
+            }
+
+            QByteArray data;
+            if (!readZipEntry(&file,entry,&data,&error)) {
+                if (errorMsgs)
+                    errorMsgs->append(error);
+                return false;
+            }
+            QFile output(entry_path);
+            if (!dir.mkpath(QFileInfo(entry_path).absolutePath()) || !output.open(QIODevice::WriteOnly | QIODevice::Truncate) || output.write(data) != data.size()) {
+                if (errorMsgs)
+                    errorMsgs->append("Failed to write extracted file at: " + entry_path);
+                return false;
+            }
+        }
+        return true;
+    }
+    if (d->backend == InProcessBackend) {
+        if (errorMsgs)
+            errorMsgs->append("The archive type is not supported in-process: " + source_path);
+        return false;
+    }
+
     QStringList arguments;
     arguments << "x";
     arguments << source_path;
@@ -256,6 +1255,48 @@ bool Qtilities::Core::Zipper::copyFolder(const QString& source_path, const QStri
         return false;
     }
 
+    if (d->backend != ExternalBackend) {
+        // Files are copied directly, thus no temporary archive is needed:
+        QList<ZipperSourceItem> items;
+        QString error;
+        if (!collectSourceItems(source_path,ignorePatterns(d->ignore_list),&items,&error)) {
+            if (errorMsgs)
+                errorMsgs->append(error);
+            return false;
+        }
+
+        QDir dir;
+        if (!dir.mkpath(destination_path)) {
+            if (errorMsgs)
+                errorMsgs->append("Failed to create destination folder at: " + destination_path);
+            return false;
+        }
+        for (int i = 0; i < items.count(); ++i) {
+            const ZipperSourceItem& item = items.at(i);
+            const QString target_path = destination_path + "/" + item.entry_name;
+            if (item.is_dir) {
+                if (!dir.mkpath(target_path)) {
+                    if (errorMsgs)
+                        errorMsgs->append("Failed to create folder at: " + target_path);
+                    return false;
+                }
+                continue;
+            }
+
+            if (QFile::exists(target_path) && !QFile::remove(target_path)) {
+                if (errorMsgs)
+                    errorMsgs->append("Failed to replace existing file at: " + target_path);
+                return false;
+            }
+            if (!QFile::copy(item.file_path,target_path)) {
+                if (errorMsgs)
+                    errorMsgs->append(QString("Failed to copy \"%1\" to \"%2\".").arg(item.file_path).arg(target_path));
+                return false;
+            }
+        }
+        return true;
+    }
+
     QString tmp_file = d->temp_dir + "/tmp.zip";
     QFile tmp_file_del(tmp_file);
     if (tmp_file_del.exists()) {
@@ -290,12 +1331,13 @@ bool Qtilities::Core::Zipper::copyFolderContents(const QString& source_path, con
 // -------------------------
 // Archive Types
 // -------------------------
-Qtilities::Core::ArchiveType Qtilities::Core::Zipper::newArchiveType(const QString& type,const QString& description ,const QString& argument ,const QString& extension){
+Qtilities::Core::ArchiveType Qtilities::Core::Zipper::newArchiveType(const QString& type,const QString& description ,const QString& argument ,const QString& extension, bool in_process){
     ArchiveType archiveType;
     archiveType.type = type;
     archiveType.description = description;
     archiveType.argument = argument;
     archiveType.extension = extension;
+    archiveType.in_process = in_process;
 
     return archiveType;
 }
@@ -305,7 +1347,7 @@ Qtilities::Core::ArchiveType Qtilities::Core::Zipper::newArchiveType(const QStri
     valid_archive_types.append(newArchiveType("7Z","http://en.wikipedia.org/wiki/7z","-t7z","7z"));
     valid_archive_types.append(newArchiveType("GZIP","http://en.wikipedia.org/wiki/Gzip","-tgzip","gzip"));
     valid_archive_types.append(newArchiveType("GZIP","http://en.wikipedia.org/wiki/Gzip","-tgzip","gz"));
-    valid_archive_types.append(newArchiveType("ZIP","http://en.wikipedia.org/wiki/ZIP_(file_format)","-tzip","zip"));
+    valid_archive_types.append(newArchiveType("ZIP","http://en.wikipedia.org/wiki/ZIP_(file_format)","-tzip","zip",true));
     valid_archive_types.append(newArchiveType("BZIP2","http://en.wikipedia.org/wiki/Bzip2","-tbzip2","bzip2"));
     valid_archive_types.append(newArchiveType("TAR","http://en.wikipedia.org/wiki/Tar_(file_format)","-ttar","tar"));
     valid_archive_types.append(newArchiveType("ISO","http://en.wikipedia.org/wiki/ISO_image","-tiso","iso"));
@@ -339,36 +1381,44 @@ bool Qtilities::Core::Zipper::isValidExtension(const QString& extension) {
 }
 
 bool Qtilities::Core::Zipper::executeCommand(QStringList arguments, QStringList* errorMsgs) {
-    int polling_interval = 10;
-    if (d->zip_process.startProcess(d->path_7za,arguments)) {
-        if (polling_interval != -1) {
-            while (d->zip_process.state() == ITask::TaskBusy) {
-                QEventLoop loop;
-                QTimer t;
-
-                connect(d->zip_process.process(),SIGNAL(finished(int)),&loop,SLOT(quit()));
-                if (polling_interval > 0) {
-                    t.start(polling_interval);
-                    connect(&t,SIGNAL(timeout()),&loop, SLOT(quit()));
-                }
+    if (!d->zip_process.startProcess(d->path_7za,arguments)) {
+        if (errorMsgs)
+            errorMsgs->append(QString("Failed to start process for command \"%1\".").arg(d->path_7za));
+        return false;
+    }
 
-                loop.exec();
-                QCoreApplication::processEvents();
-            }
-        } else {
-            while (d->zip_process.state() == ITask::TaskBusy)
-                QCoreApplication::processEvents();
+    // Wait in a local event loop instead of spinning on QCoreApplication::processEvents(). The task is only completed once the process buffers
+    // were processed, thus it can still be busy shortly after the process stopped running. When a process fails to start after startProcess()
+    // returned, its task is never completed, thus we stop waiting once the process is not running for longer than ZIPPER_COMPLETION_TIMEOUT:
+    QTime not_running_time;
+    while (d->zip_process.state() == ITask::TaskBusy) {
+        if (d->zip_process.process()->state() == QProcess::NotRunning) {
+            if (!not_running_time.isValid())
+                not_running_time.start();
+            else if (not_running_time.elapsed() > ZIPPER_COMPLETION_TIMEOUT)
+                break;
         }
 
-        if (d->zip_process.result() == ITask::TaskFailed) {
-            if (errorMsgs)
-                *errorMsgs = d->zip_process.lastErrorMessages();
-            return false;
-        } else
-            return true;
-    } else {
+        QEventLoop loop;
+        QTimer t;
+        connect(d->zip_process.process(),SIGNAL(finished(int)),&loop,SLOT(quit()));
+        connect(d->zip_process.process(),SIGNAL(error(QProcess::ProcessError)),&loop,SLOT(quit()));
+        connect(&t,SIGNAL(timeout()),&loop,SLOT(quit()));
+        t.start(ZIPPER_POLLING_INTERVAL);
+        loop.exec();
+    }
+
+    if (d->zip_process.state() == ITask::TaskBusy) {
+        d->zip_process.stopTask();
         if (errorMsgs)
-            errorMsgs->append(QString("Failed to start process for command \"%1\".").arg(d->path_7za));
+            errorMsgs->append(QString("The process for command \"%1\" stopped without completing.").arg(d->path_7za));
         return false;
     }
+
+    if (d->zip_process.result() == ITask::TaskFailed) {
+        if (errorMsgs)
+            *errorMsgs = d->zip_process.lastErrorMessages();
+        return false;
+    } else
+        return true;
 }
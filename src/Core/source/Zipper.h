@@ -11,6 +11,8 @@
 #include <QObject>
 #include <QStringList>
 
+class QIODevice;
+
 #include <QtilitiesProcess>
 
 namespace Qtilities {
@@ -23,18 +25,24 @@ using namespace Qtilities::Core;
 \brief A structure storing details about an archive type.
   */
 struct ArchiveType{
-    ArchiveType() {}
+    ArchiveType() : in_process(false) {}
     ArchiveType(const ArchiveType& ref) {
         type = ref.type;
         description = ref.description;
         argument = ref.argument;
         extension = ref.extension;
+        in_process = ref.in_process;
     }
 
     QString type;
     QString description;
     QString argument;
     QString extension;
+    //! Indicates if archives of this type can be created and extracted without 7za, see Zipper::Backend.
+    /*!
+      <i>This field was added in %Qtilities v1.5.</i>
+      */
+    bool in_process;
 };
 
 /*!
@@ -47,6 +55,14 @@ struct ZipperPrivateData;
 /*!
 This class is basically a wrapper around 7za, the command line utility from the 7-Zip project (see http://www.7-zip.org/).
 
+Since %Qtilities v1.5, ZIP archives are created and extracted in-process by default, thus without starting 7za. Files are compressed using
+deflate, which is provided by QtCore through qCompress(), and extracted using a built-in inflater. Copying folders using copyFolder() and
+copyFolderContents() also does not create temporary archives anymore. Archive types which are not supported in-process, see ArchiveType::in_process,
+are still handled by 7za. This behaviour can be changed using setBackend(). Single files can be extracted from ZIP archives without extracting the
+complete archive using extractEntry(), and archiveEntries() lists the files in an archive.
+
+To compress a stream instead of files, for example a binary project which is saved, see CompressedDevice.
+
 Below is an example showing how to use Zipper to move the contents of a folder to a different folder:
 
 \code
@@ -90,6 +106,28 @@ public:
     explicit Zipper(const QString& path_7za, const QString& ignore_list = QString(), const QString& temp_dir = QString(), QObject *parent = 0);
     ~Zipper();
 
+    //! The possible backends used to perform archive and extraction operations.
+    /*!
+      <i>This enumeration was added in %Qtilities v1.5.</i>
+      */
+    enum Backend {
+        AutomaticBackend = 0,   /*!< Archives which are supported in-process are handled in-process, 7za is used for all other archives. This is the default. */
+        InProcessBackend = 1,   /*!< All operations are done in-process, operations on archives which are not supported in-process fail. */
+        ExternalBackend = 2     /*!< All operations are done using 7za, which was the behaviour before %Qtilities v1.5. */
+    };
+    //! Sets the backend used by the zipper.
+    /*!
+      <i>This function was added in %Qtilities v1.5.</i>
+      */
+    void setBackend(Backend backend);
+    //! Gets the backend used by the zipper.
+    /*!
+      Default is AutomaticBackend.
+
+      <i>This function was added in %Qtilities v1.5.</i>
+      */
+    Backend backend() const;
+
     //! Sets the ignore list used by the zipper.
     void setIgnoreList(const QString& ignore_list);
     //! Gets the ignore list used by the zipper.
@@ -109,7 +147,7 @@ public:
     //! Checks if an extension is valid.
     static bool isValidExtension(const QString& extension);
     //! Returns an ArchiveType.
-    static ArchiveType newArchiveType(const QString& type,const QString& description ,const QString& argument ,const QString& extension);
+    static ArchiveType newArchiveType(const QString& type,const QString& description ,const QString& argument ,const QString& extension, bool in_process = false);
 
     // -------------------------
     // Zip Process Evoking Functions
@@ -190,12 +228,40 @@ public:
      * \returns The information of the archive. If the information could not be obtained, returns an empty string and sets ok to false.
      */
     QString zipInfo(const QString& file_path, bool *ok, QStringList* errorMsgs = 0);
+    //! Returns the names of the entries in an archive.
+    /*!
+     * Directories end with a / character. Only archives which are supported in-process can be listed.
+     *
+     * \param file_path The archive.
+     * \param ok Indicates if the entries could be read.
+     *
+     * <i>This function was added in %Qtilities v1.5.</i>
+     */
+    QStringList archiveEntries(const QString& file_path, bool* ok = 0, QStringList* errorMsgs = 0);
+    //! Extracts a single entry from an archive to \p device, without extracting the rest of the archive.
+    /*!
+     * Only the data of the requested entry is read from the archive. Only archives which are supported in-process can be used.
+     *
+     * \param file_path The archive.
+     * \param entry_name The name of the entry, as returned by archiveEntries().
+     * \param device The device to write the entry to, it must be open for writing.
+     *
+     * \returns True if the entry was extracted successfully, false otherwise.
+     *
+     * <i>This function was added in %Qtilities v1.5.</i>
+     */
+    bool extractEntry(const QString& file_path, const QString& entry_name, QIODevice* device, QStringList* errorMsgs = 0);
 
 protected:
     //! Executes a zip command with the given arguments.
     virtual bool executeCommand(QStringList arguments, QStringList *errorMsgs = 0);
 
 private:
+    //! Returns true if the archive at \p output_file must be created in-process.
+    bool createInProcess(const QString& output_file) const;
+    //! Returns true if the existing archive at \p file_path must be read in-process. Extraction arguments other than overwrite switches are only understood by 7za.
+    bool readInProcess(const QString& file_path, const QStringList& additional_arguments = QStringList()) const;
+
     ZipperPrivateData* d;
 };
 
@@ -64,6 +64,9 @@ HEADERS += \
     source/ConfigurationWidget.h \
     source/DynamicSideWidgetViewer.h \
     source/DynamicSideWidgetWrapper.h \
+    source/FileSystemStatCache_p.h \
+    source/LargeTextFile_p.h \
+    source/TreeItemStyleTable_p.h \
     source/GenericPropertyBrowser.h \
     source/GenericPropertyPathEditor.h \
     source/GenericPropertyPathEditorListWrapper.h \
@@ -105,12 +108,17 @@ HEADERS += \
     source/StringListWidget.h \
     source/TaskManagerGui.h \
     source/TaskSummaryWidget.h \
+    source/TaskSummaryModel.h \
+    source/TreeBuilder.h \
     source/TreeFileItem.h \
     source/TreeItemBase.h \
     source/TreeItem.h \
     source/TreeNode.h \
     source/WidgetLoggerEngineFrontend.h \
     source/WidgetLoggerEngine.h \
+    source/LogMessageStorage.h \
+    source/MessagesListViewTab.h \
+    source/StartupSnapshot.h \
 
 
 SOURCES += \
@@ -131,6 +139,9 @@ SOURCES += \
     source/ConfigurationWidget.cpp \
     source/DynamicSideWidgetViewer.cpp \
     source/DynamicSideWidgetWrapper.cpp \
+    source/FileSystemStatCache_p.cpp \
+    source/LargeTextFile_p.cpp \
+    source/TreeItemStyleTable_p.cpp \
     source/GenericPropertyBrowser.cpp \
     source/GenericPropertyPathEditor.cpp \
     source/GenericPropertyPathEditorListWrapper.cpp \
@@ -161,12 +172,17 @@ SOURCES += \
     source/StringListWidget.cpp \
     source/TaskManagerGui.cpp \
     source/TaskSummaryWidget.cpp \
+    source/TaskSummaryModel.cpp \
+    source/TreeBuilder.cpp \
     source/TreeFileItem.cpp \
     source/TreeItemBase.cpp \
     source/TreeItem.cpp \
     source/TreeNode.cpp \
     source/WidgetLoggerEngine.cpp \
     source/WidgetLoggerEngineFrontend.cpp \
+    source/LogMessageStorage.cpp \
+    source/MessagesListViewTab.cpp \
+    source/StartupSnapshot.cpp \
 
 
 FORMS += \
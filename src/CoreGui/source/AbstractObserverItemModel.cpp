@@ -11,8 +11,18 @@
 
 #include "AbstractObserverItemModel.h"
 
+#include <QHash>
+
 using namespace Qtilities::Core;
 
+namespace {
+    //! The icons returned by AbstractObserverItemModel::cachedIcon(), keyed by resource path.
+    QHash<QString,QIcon>& iconCache() {
+        static QHash<QString,QIcon> cache;
+        return cache;
+    }
+}
+
 Qtilities::CoreGui::AbstractObserverItemModel::AbstractObserverItemModel() {
     model = new AbstractObserverItemModelData;
     model->hints_default = new ObserverHints;
@@ -91,6 +101,40 @@ bool Qtilities::CoreGui::AbstractObserverItemModel::respondToObserverChanges() c
     return model->respond_to_observer_changes;
 }
 
+void Qtilities::CoreGui::AbstractObserverItemModel::setUpdatesSuspended(bool suspended) {
+    if (model->updates_suspended == suspended)
+        return;
+
+    model->updates_suspended = suspended;
+    if (suspended || model->pending_changes == NoPendingChanges)
+        return;
+
+    PendingChanges changes = PendingChanges(model->pending_changes);
+    model->pending_changes = NoPendingChanges;
+    applyPendingChanges(changes);
+}
+
+bool Qtilities::CoreGui::AbstractObserverItemModel::updatesSuspended() const {
+    return model->updates_suspended;
+}
+
+Qtilities::CoreGui::AbstractObserverItemModel::PendingChanges Qtilities::CoreGui::AbstractObserverItemModel::pendingChanges() const {
+    return PendingChanges(model->pending_changes);
+}
+
+bool Qtilities::CoreGui::AbstractObserverItemModel::deferChange(PendingChange change) {
+    if (!model->updates_suspended)
+        return false;
+
+    model->pending_changes |= change;
+    return true;
+}
+
+void Qtilities::CoreGui::AbstractObserverItemModel::applyPendingChanges(PendingChanges changes) {
+    Q_UNUSED(changes)
+    refresh();
+}
+
 void Qtilities::CoreGui::AbstractObserverItemModel::setReadOnly(bool read_only) {
     model->read_only = read_only;
 }
@@ -114,3 +158,14 @@ void Qtilities::CoreGui::AbstractObserverItemModel::setColumnChildCountLimit(int
 int Qtilities::CoreGui::AbstractObserverItemModel::columnChildCountLimit() const {
     return model->child_count_limit;
 }
+
+QIcon Qtilities::CoreGui::AbstractObserverItemModel::cachedIcon(const QString& path) {
+    QHash<QString,QIcon>& cache = iconCache();
+    QHash<QString,QIcon>::const_iterator itr = cache.constFind(path);
+    if (itr != cache.constEnd())
+        return itr.value();
+
+    QIcon icon(path);
+    cache.insert(path,icon);
+    return icon;
+}
@@ -20,6 +20,7 @@
 #include <ActivityPolicyFilter>
 
 #include <QModelIndex>
+#include <QIcon>
 
 namespace Qtilities {
     namespace CoreGui {
@@ -31,6 +32,8 @@ namespace Qtilities {
           */
         struct AbstractObserverItemModelData {
             AbstractObserverItemModelData() : respond_to_observer_changes(true),
+                updates_suspended(false),
+                pending_changes(0),
                 child_count_base("QObject"),
                 child_count_limit(-1) { }
 
@@ -50,6 +53,10 @@ namespace Qtilities {
 
             //! Indicates if this model responds to changes to the observer context.
             bool                            respond_to_observer_changes;
+            //! Indicates if updates are suspended, see AbstractObserverItemModel::setUpdatesSuspended().
+            bool                            updates_suspended;
+            //! The AbstractObserverItemModel::PendingChanges received while updates were suspended.
+            int                             pending_changes;
             //! Indicates if this model is read only.
             bool                            read_only;
             //! The base class name used to count items in ColumnChildCount if it is shown.
@@ -83,6 +90,7 @@ namespace Qtilities {
 
               \note You must call this function before setObserverContext() for it to have any effect.
               \note From the current models in %Qtilities, only ObserverTreeModel makes use of lazy initialialization. For ObserverTableModel this is not neccesarry.
+              \note ObserverTreeModel also builds the children of observer nodes on demand when lazy initialization is enabled, see the ObserverTreeModel class documentation.
 
               \sa lazyInitEnabled()
 
@@ -154,6 +162,39 @@ namespace Qtilities {
               */
             bool respondToObserverChanges() const;
 
+            //! The kinds of changes to the observer context which can be pending while updates are suspended.
+            enum PendingChange {
+                NoPendingChanges    = 0,    /*!< No changes are pending. */
+                PendingDataChange   = 1,    /*!< The data of the observer context or of its subjects changed. */
+                PendingLayoutChange = 2     /*!< Subjects were attached, detached or moved, or a refresh was requested. */
+            };
+            Q_DECLARE_FLAGS(PendingChanges, PendingChange)
+
+            //! Suspends or resumes the updates of this model.
+            /*!
+              While updates are suspended, changes to the observer context are not applied to the model. The kinds of changes which were
+              received are recorded instead, and applied in a single catch up when the updates are resumed. For example, a tree model which
+              received many layout changes while suspended rebuilds its tree once when it is resumed. This allows views which are not visible,
+              for example in inactive modes or hidden dock widgets, to skip the work of keeping their models up to date.
+
+              ObserverWidget suspends the updates of its models while it is hidden, after it was shown.
+
+              \note Changes which are received while respondToObserverChanges() is false are ignored, not recorded.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setUpdatesSuspended(bool suspended);
+            //! Gets if the updates of this model are suspended.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool updatesSuspended() const;
+            //! Gets the changes which were received while updates were suspended, and which will be applied when they are resumed.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            PendingChanges pendingChanges() const;
+
             //! Sets if this model must be read only, thus its actions and property editor will be read only.
             /*!
               \sa readOnly()
@@ -214,9 +255,28 @@ namespace Qtilities {
               */
             virtual void refresh() = 0;
 
+            //! Returns the icon for the resource at \p path from a cache shared by all observer models.
+            /*!
+              QIcon loads its pixmaps when it is painted and keeps them, thus returning the same icon for all items means that the
+              pixmaps of a decoration are only loaded once, no matter how many items show it.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static QIcon cachedIcon(const QString& path);
+
         protected:
+            //! Records \p change when updates are suspended, in which case it returns true and the change must not be applied now.
+            bool deferChange(PendingChange change);
+            //! Applies \p changes which were received while updates were suspended, called when the updates are resumed.
+            /*!
+              The default implementation calls refresh().
+              */
+            virtual void applyPendingChanges(PendingChanges changes);
+
             AbstractObserverItemModelData* model;
         };
+
+        Q_DECLARE_OPERATORS_FOR_FLAGS(AbstractObserverItemModel::PendingChanges)
     }
 }
 
@@ -12,11 +12,56 @@
 #include "AbstractTreeItem.h"
 #include "TreeNode.h"
 #include "NamingPolicyFilter.h"
+#include "TreeItemStyleTable_p.h"
 
 #include <QDomElement>
 
 using namespace Qtilities::Core;
 
+namespace {
+    //! Sets \p role in the interned style of \p obj, replacing the legacy role property of the role when it exists.
+    void qti_private_SetStyleRole(QObject* obj, int role, const QVariant& value, const char* role_property) {
+        if (!obj)
+            return;
+
+        int current_id = Qtilities::CoreGui::TreeItemStyleTable::styleIdOf(obj);
+        Qtilities::CoreGui::TreeItemStyle style = Qtilities::CoreGui::TreeItemStyleTable::instance()->style(current_id);
+        style.setData(role,value);
+        int new_id = Qtilities::CoreGui::TreeItemStyleTable::instance()->styleId(style);
+
+        if (ObjectManager::propertyExists(obj,role_property))
+            obj->setProperty(role_property,QVariant());
+        if (new_id == current_id)
+            return;
+
+        if (new_id == 0) {
+            obj->setProperty(qti_prop_STYLE,QVariant());
+        } else {
+            SharedProperty property(qti_prop_STYLE,new_id);
+            ObjectManager::setSharedProperty(obj,property);
+        }
+    }
+
+    //! Returns \p role from the interned style of \p obj, falling back to the legacy role property of the role.
+    QVariant qti_private_StyleRole(const QObject* obj, int role, const char* role_property) {
+        if (!obj)
+            return QVariant();
+
+        QVariant value = Qtilities::CoreGui::TreeItemStyleTable::roleDataOf(obj,role);
+        if (value.isValid())
+            return value;
+
+        return ObjectManager::getSharedProperty(obj,role_property).value();
+    }
+
+    bool qti_private_HasStyleRole(const QObject* obj, int role, const char* role_property) {
+        if (!obj)
+            return false;
+
+        return Qtilities::CoreGui::TreeItemStyleTable::roleDataOf(obj,role).isValid() || ObjectManager::propertyExists(obj,role_property);
+    }
+}
+
 Qtilities::CoreGui::AbstractTreeItem::AbstractTreeItem() {
     baseItemData = new AbstractTreeItemPrivateData;
 
@@ -321,7 +366,7 @@ bool Qtilities::CoreGui::AbstractTreeItem::setCategory(const QtilitiesCategory&
         if (parent_count == 1) {
             MultiContextProperty prop = ObjectManager::getMultiContextProperty(getTreeItemObjectBase(),qti_prop_OBSERVER_MAP);
             if (prop.isValid()) {
-                observer_id = prop.contextMap().keys().at(0);
+                observer_id = prop.contextIds().at(0);
                 parent_observer = OBJECT_MANAGER->observerReference(observer_id);
             }
         } else if (parent_count > 1 && getTreeItemObjectBase()) {
@@ -354,7 +399,7 @@ bool Qtilities::CoreGui::AbstractTreeItem::setCategory(const QtilitiesCategory&
                 return true;
             }
         } else {
-            LOG_DEBUG(QString("setCategory(-1) on item \"%1\" failed, the item has %2 parent(s) and/or a specific parent could not be found.").arg(getTreeItemObjectBase()->objectName()).arg(parent_count));
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::TreeModelLogTag,QString("setCategory(-1) on item \"%1\" failed, the item has %2 parent(s) and/or a specific parent could not be found.").arg(getTreeItemObjectBase()->objectName()).arg(parent_count));
         }
     } else {
         QObject* obj = getTreeItemObjectBase();
@@ -403,7 +448,7 @@ QtilitiesCategory Qtilities::CoreGui::AbstractTreeItem::getCategory(int observer
         if (parent_count == 1) {
             MultiContextProperty prop = ObjectManager::getMultiContextProperty(getTreeItemObjectBase(),qti_prop_OBSERVER_MAP);
             if (prop.isValid()) {
-                observer_id = prop.contextMap().keys().at(0);
+                observer_id = prop.contextIds().at(0);
                 parent_observer = OBJECT_MANAGER->observerReference(observer_id);
             }
         } else if (parent_count > 1 && getTreeItemObjectBase()) {
@@ -416,7 +461,7 @@ QtilitiesCategory Qtilities::CoreGui::AbstractTreeItem::getCategory(int observer
             if (category_variant.isValid())
                 return category_variant.value<QtilitiesCategory>();
         } else {
-            LOG_DEBUG(QString("getCategory(-1) on item \"%1\" failed, the item has %2 parent(s) and/or a specific parent could not be found.").arg(getTreeItemObjectBase()->objectName()).arg(parent_count));
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::TreeModelLogTag,QString("getCategory(-1) on item \"%1\" failed, the item has %2 parent(s) and/or a specific parent could not be found.").arg(getTreeItemObjectBase()->objectName()).arg(parent_count));
         }
     } else {
         const QObject* obj = getTreeItemObjectBase();
@@ -457,29 +502,18 @@ bool Qtilities::CoreGui::AbstractTreeItem::hasToolTip() const {
 }
 
 void Qtilities::CoreGui::AbstractTreeItem::setIcon(const QIcon& icon) {
-    QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        if (icon.isNull()) {
-            obj->setProperty(qti_prop_DECORATION,QVariant());
-        } else {
-            SharedProperty property(qti_prop_DECORATION,icon);
-            ObjectManager::setSharedProperty(obj,property);
-        }
-    }
+    if (icon.isNull())
+        qti_private_SetStyleRole(getTreeItemObjectBase(),Qt::DecorationRole,QVariant(),qti_prop_DECORATION);
+    else
+        qti_private_SetStyleRole(getTreeItemObjectBase(),Qt::DecorationRole,icon,qti_prop_DECORATION);
 }
 
 QIcon Qtilities::CoreGui::AbstractTreeItem::getIcon() const {
-    const QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        QVariant variant = ObjectManager::getSharedProperty(obj,qti_prop_DECORATION).value();
-        return variant.value<QIcon>();
-    }
-
-    return QIcon();
+    return qti_private_StyleRole(getTreeItemObjectBase(),Qt::DecorationRole,qti_prop_DECORATION).value<QIcon>();
 }
 
 bool Qtilities::CoreGui::AbstractTreeItem::hasIcon() const {
-    return ObjectManager::propertyExists(getTreeItemObjectBase(),qti_prop_DECORATION);
+    return qti_private_HasStyleRole(getTreeItemObjectBase(),Qt::DecorationRole,qti_prop_DECORATION);
 }
 
 void Qtilities::CoreGui::AbstractTreeItem::setWhatsThis(const QString& whats_this) {
@@ -523,91 +557,56 @@ bool Qtilities::CoreGui::AbstractTreeItem::hasStatusTip() const {
 }
 
 void Qtilities::CoreGui::AbstractTreeItem::setSizeHint(const QSize& size) {
-    QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        if (size.isValid()) {
-            SharedProperty property(qti_prop_SIZE_HINT,size);
-            ObjectManager::setSharedProperty(obj,property);
-        }
-    }
+    if (size.isValid())
+        qti_private_SetStyleRole(getTreeItemObjectBase(),Qt::SizeHintRole,size,qti_prop_SIZE_HINT);
 }
 
 QSize Qtilities::CoreGui::AbstractTreeItem::getSizeHint() const {
-    const QObject* obj = getTreeItemObjectBase();
-    if (obj)
-        return ObjectManager::getSharedProperty(obj,qti_prop_SIZE_HINT).value().toSize();
-
-    return QSize();
+    return qti_private_StyleRole(getTreeItemObjectBase(),Qt::SizeHintRole,qti_prop_SIZE_HINT).toSize();
 }
 
 bool Qtilities::CoreGui::AbstractTreeItem::hasSizeHint() const {
-    return ObjectManager::propertyExists(getTreeItemObjectBase(),qti_prop_SIZE_HINT);
+    return qti_private_HasStyleRole(getTreeItemObjectBase(),Qt::SizeHintRole,qti_prop_SIZE_HINT);
 }
 
 void Qtilities::CoreGui::AbstractTreeItem::setFont(const QFont& font) {
-    QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        SharedProperty property(qti_prop_FONT,font);
-        ObjectManager::setSharedProperty(obj,property);
-    }
+    qti_private_SetStyleRole(getTreeItemObjectBase(),Qt::FontRole,font,qti_prop_FONT);
 }
 
 QFont Qtilities::CoreGui::AbstractTreeItem::getFont() const {
-    const QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        QVariant variant = ObjectManager::getSharedProperty(obj,qti_prop_FONT).value();
-        return variant.value<QFont>();
-    }
-
-    return QFont();
+    return qti_private_StyleRole(getTreeItemObjectBase(),Qt::FontRole,qti_prop_FONT).value<QFont>();
 }
 
 bool Qtilities::CoreGui::AbstractTreeItem::hasFont() const {
-    return ObjectManager::propertyExists(getTreeItemObjectBase(),qti_prop_FONT);
+    return qti_private_HasStyleRole(getTreeItemObjectBase(),Qt::FontRole,qti_prop_FONT);
 }
 
 void Qtilities::CoreGui::AbstractTreeItem::setAlignment(const Qt::AlignmentFlag& alignment) {
-    QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        SharedProperty property(qti_prop_TEXT_ALIGNMENT,(int) alignment);
-        ObjectManager::setSharedProperty(obj,property);
-    }
+    qti_private_SetStyleRole(getTreeItemObjectBase(),Qt::TextAlignmentRole,(int) alignment,qti_prop_TEXT_ALIGNMENT);
 }
 
 Qt::AlignmentFlag Qtilities::CoreGui::AbstractTreeItem::getAlignment() const {
-    const QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        QVariant variant = ObjectManager::getSharedProperty(obj,qti_prop_TEXT_ALIGNMENT).value();
+    QVariant variant = qti_private_StyleRole(getTreeItemObjectBase(),Qt::TextAlignmentRole,qti_prop_TEXT_ALIGNMENT);
+    if (variant.isValid())
         return (Qt::AlignmentFlag) variant.toInt();
-    }
 
     return Qt::AlignLeft;
 }
 
 bool Qtilities::CoreGui::AbstractTreeItem::hasAlignment() const {
-    return ObjectManager::propertyExists(getTreeItemObjectBase(),qti_prop_TEXT_ALIGNMENT);
+    return qti_private_HasStyleRole(getTreeItemObjectBase(),Qt::TextAlignmentRole,qti_prop_TEXT_ALIGNMENT);
 }
 
 void Qtilities::CoreGui::AbstractTreeItem::setForegroundRole(const QBrush& foreground_role) {
-    QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        SharedProperty property(qti_prop_FOREGROUND,foreground_role);
-        ObjectManager::setSharedProperty(obj,property);
-    }
+    qti_private_SetStyleRole(getTreeItemObjectBase(),Qt::ForegroundRole,foreground_role,qti_prop_FOREGROUND);
 }
 
 QBrush Qtilities::CoreGui::AbstractTreeItem::getForegroundRole() const {
-    const QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        QVariant variant = ObjectManager::getSharedProperty(obj,qti_prop_FOREGROUND).value();
-        return variant.value<QBrush>();
-    }
-
-    return QBrush();
+    return qti_private_StyleRole(getTreeItemObjectBase(),Qt::ForegroundRole,qti_prop_FOREGROUND).value<QBrush>();
 }
 
 bool Qtilities::CoreGui::AbstractTreeItem::hasForegroundRole() const {
-    return ObjectManager::propertyExists(getTreeItemObjectBase(),qti_prop_FOREGROUND);
+    return qti_private_HasStyleRole(getTreeItemObjectBase(),Qt::ForegroundRole,qti_prop_FOREGROUND);
 }
 
 void Qtilities::CoreGui::AbstractTreeItem::setForegroundColor(const QColor& color) {
@@ -628,25 +627,15 @@ QColor Qtilities::CoreGui::AbstractTreeItem::getForegroundColor() const {
 }
 
 void Qtilities::CoreGui::AbstractTreeItem::setBackgroundRole(const QBrush& background_role) {
-    QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        SharedProperty property(qti_prop_BACKGROUND,background_role);
-        ObjectManager::setSharedProperty(obj,property);
-    }
+    qti_private_SetStyleRole(getTreeItemObjectBase(),Qt::BackgroundRole,background_role,qti_prop_BACKGROUND);
 }
 
 QBrush Qtilities::CoreGui::AbstractTreeItem::getBackgroundRole() const {
-    const QObject* obj = getTreeItemObjectBase();
-    if (obj) {
-        QVariant variant = ObjectManager::getSharedProperty(obj,qti_prop_BACKGROUND).value();
-        return variant.value<QBrush>();
-    }
-
-    return QBrush();
+    return qti_private_StyleRole(getTreeItemObjectBase(),Qt::BackgroundRole,qti_prop_BACKGROUND).value<QBrush>();
 }
 
 bool Qtilities::CoreGui::AbstractTreeItem::hasBackgroundRole() const {
-    return ObjectManager::propertyExists(getTreeItemObjectBase(),qti_prop_BACKGROUND);
+    return qti_private_HasStyleRole(getTreeItemObjectBase(),Qt::BackgroundRole,qti_prop_BACKGROUND);
 }
 
 void Qtilities::CoreGui::AbstractTreeItem::setBackgroundColor(const QColor& color) {
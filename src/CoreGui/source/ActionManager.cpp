@@ -25,6 +25,8 @@
 #include <QMainWindow>
 #include <QList>
 #include <QHash>
+#include <QPair>
+#include <QSet>
 #include <QApplication>
 #include <QDomDocument>
 #include <QDomElement>
@@ -41,13 +43,42 @@ using namespace Qtilities::Logging::Constants;
 
 bool Qtilities::CoreGui::ActionManager::showed_warning;
 
+namespace {
+    // Returns the contexts in which command has backend actions or is enabled. Returns false when the contexts of the command type are unknown.
+    bool qti_private_CommandContexts(Command* command, QList<int>* contexts) {
+        if (ProxyAction* proxy_action = qobject_cast<ProxyAction*> (command)) {
+            *contexts = proxy_action->contextIDActionMap().keys();
+            return true;
+        } else if (ShortcutCommand* shortcut_command = qobject_cast<ShortcutCommand*> (command)) {
+            *contexts = shortcut_command->activeContexts();
+            return true;
+        }
+        return false;
+    }
+}
+
 struct Qtilities::CoreGui::ActionManagerPrivateData {
     ActionManagerPrivateData() : observer_commands("Registered Commands"),
-      observer_action_container("Registered Action Containers") { }
+      observer_action_container("Registered Action Containers"),
+      contexts_initialized(false) { }
 
     QPointer<CommandEditor> command_editor;
     TreeNode observer_commands;
     TreeNode observer_action_container;
+    //! The active contexts received during the last context change.
+    QList<int> current_contexts;
+    //! Indicates that all commands were updated for current_contexts at least once.
+    bool contexts_initialized;
+    //! The commands which have backend actions, or are enabled, in each context.
+    QHash<int, QList<QPointer<Command> > > context_commands;
+    //! The contexts under which each command is stored in context_commands.
+    QHash<QObject*, QList<int> > command_contexts;
+    //! Commands of which the contexts are unknown, these are updated on every context change.
+    QList<QPointer<Command> > unindexed_commands;
+    //! The commands using each key of their key sequence. Keys are the parts of QKeySequence::toString() split on ",".
+    QHash<QString, QList<QPointer<Command> > > key_commands;
+    //! The keys under which each command is stored in key_commands.
+    QHash<QObject*, QStringList> command_keys;
 };
 
 Qtilities::CoreGui::ActionManager::ActionManager(QObject* parent) : IActionManager(parent)
@@ -161,13 +192,13 @@ Qtilities::CoreGui::Command *Qtilities::CoreGui::ActionManager::registerAction(c
 
             if (multi->keySequence().isEmpty() && !action->shortcut().isEmpty()) {
                 #if defined(QTILITIES_VERBOSE_ACTION_DEBUGGING)
-                LOG_TRACE(QString(tr("Base action shortcut did not exist previously, now using shortcut (%1) from backend action: %2.")).arg(action->shortcut().toString()).arg(action->text()));
+                LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,QString(tr("Base action shortcut did not exist previously, now using shortcut (%1) from backend action: %2.")).arg(action->shortcut().toString()).arg(action->text()));
                 #endif
                 multi->setKeySequence(action->shortcut());
             }
 
             #if defined(QTILITIES_VERBOSE_ACTION_DEBUGGING)
-            LOG_TRACE(QString(tr("Registering new backend action for base action %1 (shortcut %2). New action: %3 (shortcut %4).")).arg(multi->text()).arg(multi->keySequence().toString()).arg(action->text()).arg(action->shortcut().toString()));
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,QString(tr("Registering new backend action for base action %1 (shortcut %2). New action: %3 (shortcut %4).")).arg(multi->text()).arg(multi->keySequence().toString()).arg(action->text()).arg(action->shortcut().toString()));
             #endif
 
             // We set the backend action's shortcut to nothing, otherwise we get ambigious action shortcuts.
@@ -175,6 +206,7 @@ Qtilities::CoreGui::Command *Qtilities::CoreGui::ActionManager::registerAction(c
 
             // Add it down here in order to avoid unneccesary updates when changing action in the above code:
             multi->addAction(action,context);
+            indexCommand(multi);
 
             //emit numberOfCommandsChanged();
             return multi;
@@ -216,7 +248,7 @@ Qtilities::CoreGui::Command* Qtilities::CoreGui::ActionManager::registerActionPl
             showed_warning = true;
         }
         #else
-            LOG_DEBUG("QtilitiesApplication::mainWindow() is required when registering actions in the action manager.<br><br>Proxy actions will not work as intended.");
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreGuiLogTag,"QtilitiesApplication::mainWindow() is required when registering actions in the action manager.<br><br>Proxy actions will not work as intended.");
         #endif
     } else
         QtilitiesApplication::mainWindow()->addAction(frontend_action);
@@ -232,6 +264,7 @@ Qtilities::CoreGui::Command* Qtilities::CoreGui::ActionManager::registerActionPl
         }
         new_action->setCurrentContext(CONTEXT_MANAGER->activeContexts());
         d->observer_commands << new_action;
+        indexCommand(new_action);
 
         new_action->setKeySequence(key_sequence);
         new_action->setDefaultKeySequence(key_sequence);
@@ -270,6 +303,7 @@ Qtilities::CoreGui::Command *Qtilities::CoreGui::ActionManager::registerShortcut
         new_shortcut->setDefaultText(id);
         new_shortcut->setCurrentContext(CONTEXT_MANAGER->activeContexts());
         d->observer_commands << new_shortcut;
+        indexCommand(new_shortcut);
 
         new_shortcut->setDefaultKeySequence(shortcut->key());
         new_shortcut->setKeySequence(shortcut->key());
@@ -304,18 +338,150 @@ Qtilities::CoreGui::Command *Qtilities::CoreGui::ActionManager::command(const QS
 }
 
 void Qtilities::CoreGui::ActionManager::handleContextChanged(QList<int> new_contexts) {
-    if (d->observer_commands.subjectCount() == 0)
+    QList<int> old_contexts = d->current_contexts;
+    d->current_contexts = new_contexts;
+
+    if (d->observer_commands.subjectCount() == 0) {
+        d->contexts_initialized = true;
         return;
+    }
 
-    Command* command = qobject_cast<Command*> (d->observer_commands.subjectAt(0));
-    SubjectIterator<Qtilities::CoreGui::Command> command_itr(command,
-                                                             &d->observer_commands);
+    if (!d->contexts_initialized) {
+        d->contexts_initialized = true;
 
-    if (command_itr.current())
-        command_itr.current()->setCurrentContext(new_contexts);
+        Command* command = qobject_cast<Command*> (d->observer_commands.subjectAt(0));
+        SubjectIterator<Qtilities::CoreGui::Command> command_itr(command,
+                                                                 &d->observer_commands);
 
-    while (command_itr.hasNext()) {
-        command_itr.next()->setCurrentContext(new_contexts);
+        if (command_itr.current())
+            command_itr.current()->setCurrentContext(new_contexts);
+
+        while (command_itr.hasNext()) {
+            command_itr.next()->setCurrentContext(new_contexts);
+        }
+        return;
+    }
+
+    // Only commands in contexts which became active or inactive can change their active backend action:
+    QList<int> changed_contexts;
+    QList<int> old_remaining_contexts;
+    QList<int> new_remaining_contexts;
+    for (int i = 0; i < old_contexts.count(); ++i) {
+        if (new_contexts.contains(old_contexts.at(i)))
+            old_remaining_contexts << old_contexts.at(i);
+        else
+            changed_contexts << old_contexts.at(i);
+    }
+    for (int i = 0; i < new_contexts.count(); ++i) {
+        if (old_contexts.contains(new_contexts.at(i)))
+            new_remaining_contexts << new_contexts.at(i);
+        else
+            changed_contexts << new_contexts.at(i);
+    }
+    // Proxy actions use the first active context which has a backend action, thus a change in the order of the
+    // contexts which stayed active affects their commands as well:
+    if (old_remaining_contexts != new_remaining_contexts)
+        changed_contexts << new_remaining_contexts;
+
+    QSet<Command*> updated_commands;
+    for (int i = 0; i < changed_contexts.count(); ++i) {
+        const QList<QPointer<Command> > commands = d->context_commands.value(changed_contexts.at(i));
+        for (int c = 0; c < commands.count(); ++c) {
+            Command* command = commands.at(c);
+            if (command && !updated_commands.contains(command)) {
+                updated_commands.insert(command);
+                command->setCurrentContext(new_contexts);
+            }
+        }
+    }
+
+    for (int i = 0; i < d->unindexed_commands.count(); ++i) {
+        if (d->unindexed_commands.at(i))
+            d->unindexed_commands.at(i)->setCurrentContext(new_contexts);
+    }
+}
+
+void Qtilities::CoreGui::ActionManager::indexCommand(Command* command) {
+    if (!command)
+        return;
+
+    const QList<int> old_contexts = d->command_contexts.value(command);
+    for (int i = 0; i < old_contexts.count(); ++i) {
+        QHash<int, QList<QPointer<Command> > >::iterator itr = d->context_commands.find(old_contexts.at(i));
+        if (itr != d->context_commands.end()) {
+            itr.value().removeAll(command);
+            if (itr.value().isEmpty())
+                d->context_commands.erase(itr);
+        }
+    }
+
+    QList<int> contexts;
+    if (qti_private_CommandContexts(command,&contexts)) {
+        d->command_contexts[command] = contexts;
+        for (int i = 0; i < contexts.count(); ++i)
+            d->context_commands[contexts.at(i)] << command;
+    } else if (!d->unindexed_commands.contains(command)) {
+        d->unindexed_commands << command;
+    }
+
+    if (!d->command_keys.contains(command))
+        indexCommandKeySequence(command);
+
+    connect(command,SIGNAL(registeredContextsChanged()),SLOT(handleCommandContextsChanged()),Qt::UniqueConnection);
+    connect(command,SIGNAL(keySequenceChanged()),SLOT(handleCommandKeySequenceChanged()),Qt::UniqueConnection);
+    connect(command,SIGNAL(destroyed(QObject*)),SLOT(handleCommandDestroyed(QObject*)),Qt::UniqueConnection);
+}
+
+void Qtilities::CoreGui::ActionManager::indexCommandKeySequence(Command* command) {
+    if (!command)
+        return;
+
+    const QStringList old_keys = d->command_keys.value(command);
+    for (int i = 0; i < old_keys.count(); ++i) {
+        QHash<QString, QList<QPointer<Command> > >::iterator itr = d->key_commands.find(old_keys.at(i));
+        if (itr != d->key_commands.end()) {
+            itr.value().removeAll(command);
+            if (itr.value().isEmpty())
+                d->key_commands.erase(itr);
+        }
+    }
+
+    QStringList keys = command->keySequence().toString().split(",");
+    keys.removeDuplicates();
+    d->command_keys[command] = keys;
+    for (int i = 0; i < keys.count(); ++i)
+        d->key_commands[keys.at(i)] << command;
+}
+
+void Qtilities::CoreGui::ActionManager::handleCommandKeySequenceChanged() {
+    indexCommandKeySequence(qobject_cast<Command*> (sender()));
+}
+
+void Qtilities::CoreGui::ActionManager::handleCommandContextsChanged() {
+    indexCommand(qobject_cast<Command*> (sender()));
+}
+
+void Qtilities::CoreGui::ActionManager::handleCommandDestroyed(QObject* obj) {
+    // The QPointers in context_commands are already null, thus only the empty entries are removed:
+    const QList<int> contexts = d->command_contexts.take(obj);
+    for (int i = 0; i < contexts.count(); ++i) {
+        QHash<int, QList<QPointer<Command> > >::iterator itr = d->context_commands.find(contexts.at(i));
+        if (itr != d->context_commands.end()) {
+            itr.value().removeAll(QPointer<Command>());
+            if (itr.value().isEmpty())
+                d->context_commands.erase(itr);
+        }
+    }
+    d->unindexed_commands.removeAll(QPointer<Command>());
+
+    const QStringList keys = d->command_keys.take(obj);
+    for (int i = 0; i < keys.count(); ++i) {
+        QHash<QString, QList<QPointer<Command> > >::iterator itr = d->key_commands.find(keys.at(i));
+        if (itr != d->key_commands.end()) {
+            itr.value().removeAll(QPointer<Command>());
+            if (itr.value().isEmpty())
+                d->key_commands.erase(itr);
+        }
     }
 }
 
@@ -457,7 +623,7 @@ bool Qtilities::CoreGui::ActionManager::loadShortcutMapping(const QString& file_
                         if (command) {
                             command->setKeySequence(QKeySequence(key_sequence));
                             #if defined(QTILITIES_VERBOSE_ACTION_DEBUGGING)
-                            LOG_TRACE("Importing shortcut for action: " + commandID + ", Shortcut: " + key_sequence);
+                            LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,"Importing shortcut for action: " + commandID + ", Shortcut: " + key_sequence);
                             #endif
                         }
 
@@ -489,6 +655,28 @@ QList<Command*> Qtilities::CoreGui::ActionManager::commandsWithKeySequence(QKeyS
     if (d->observer_commands.subjectCount() == 0)
         return commands;
 
+    // When all commands are in the key sequence index, only the commands using the keys in key_sequence are visited:
+    if (d->command_keys.count() == d->observer_commands.subjectCount()) {
+        QSet<Command*> found_commands;
+        QList<QPair<int,Command*> > found_positions;
+        foreach (const QString& search_string, key_sequence.toString().split(",")) {
+            const QList<QPointer<Command> > key_commands = d->key_commands.value(search_string);
+            for (int i = 0; i < key_commands.count(); ++i) {
+                Command* key_command = key_commands.at(i);
+                if (key_command && !found_commands.contains(key_command)) {
+                    found_commands.insert(key_command);
+                    found_positions << qMakePair(d->observer_commands.subjectPosition(key_command),key_command);
+                }
+            }
+        }
+
+        // Return the commands in the order in which they are registered:
+        qSort(found_positions);
+        for (int i = 0; i < found_positions.count(); ++i)
+            commands << found_positions.at(i).second;
+        return commands;
+    }
+
     Command* command = qobject_cast<Command*> (d->observer_commands.subjectAt(0));
     SubjectIterator<Qtilities::CoreGui::Command> command_itr(command,&d->observer_commands);
 
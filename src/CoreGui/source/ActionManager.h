@@ -82,7 +82,20 @@ namespace Qtilities {
             void unregisterCommandsForContext(int context);
             void handleContextChanged(QList<int> new_contexts);
 
+        private slots:
+            //! Updates the context index entries of the command which emitted Command::registeredContextsChanged().
+            void handleCommandContextsChanged();
+            //! Updates the key sequence index entries of the command which emitted Command::keySequenceChanged().
+            void handleCommandKeySequenceChanged();
+            //! Removes a deleted command from the context and key sequence indexes.
+            void handleCommandDestroyed(QObject* obj);
+
         private:
+            //! Adds \p command to the context index, or updates its entries when it is already indexed.
+            void indexCommand(Command* command);
+            //! Adds \p command to the key sequence index used by commandsWithKeySequence(), or updates its entries when it is already indexed.
+            void indexCommandKeySequence(Command* command);
+
             ActionManagerPrivateData* d;
             static bool showed_warning;
         };
@@ -418,13 +418,7 @@ void Qtilities::CoreGui::AddDynamicPropertyWizard::initializePropertyProviders()
     d->property_providers.clear();
 
     // Get a list of all the property providers in the system:
-    QList<QObject*> propertyProviderObjects = OBJECT_MANAGER->registeredInterfaces("com.Qtilities.Core.IAvailablePropertyProvider/1.0");
-    // Check all items
-    for (int i = 0; i < propertyProviderObjects.count(); ++i) {
-        IAvailablePropertyProvider* provider = qobject_cast<IAvailablePropertyProvider*> (propertyProviderObjects.at(i));
-        if (provider)
-            d->property_providers << provider;
-    }
+    d->property_providers = OBJECT_MANAGER->registeredInterfaces<IAvailablePropertyProvider>();
 }
 
 void Qtilities::CoreGui::AddDynamicPropertyWizard::getAvailableProperties() const {
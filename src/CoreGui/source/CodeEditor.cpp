@@ -12,14 +12,38 @@
 
 #include <QSyntaxHighlighter>
 #include <QPainter>
+#include <QTimer>
 #include <QtDebug>
 
+namespace {
+    // The number of blocks before and after the visible blocks in which words are highlighted, thus scrolling
+    // a little does not require the highlighting to be updated:
+    const int qti_private_word_highlight_lookahead = 100;
+}
+
 struct Qtilities::CoreGui::CodeEditorPrivateData {
     CodeEditorPrivateData() : lineNumberArea(0),
-    syntaxHighlighter(0) {}
+    syntaxHighlighter(0),
+    word_range_first(-1),
+    word_range_last(-1) {}
 
     QWidget *lineNumberArea;
     QSyntaxHighlighter* syntaxHighlighter;
+
+    //! The current line selection, empty when the editor is read only.
+    QList<QTextEdit::ExtraSelection> line_selections;
+    //! The words highlighted using highlightWords().
+    QStringList highlighted_words;
+    //! The brush used to highlight highlighted_words.
+    QBrush word_brush;
+    //! The word selections of the blocks from word_range_first to word_range_last.
+    QList<QTextEdit::ExtraSelection> word_selections;
+    //! The first block number for which word_selections are valid, -1 when they are not valid.
+    int word_range_first;
+    //! The last block number for which word_selections are valid.
+    int word_range_last;
+    //! Coalesces word highlighting updates requested while scrolling, resizing and editing.
+    QTimer word_highlight_timer;
 };
 
 Qtilities::CoreGui::CodeEditor::CodeEditor(QWidget* parent) : QPlainTextEdit(parent) {
@@ -33,6 +57,12 @@ Qtilities::CoreGui::CodeEditor::CodeEditor(QWidget* parent) : QPlainTextEdit(par
     connect(this, SIGNAL(updateRequest(const QRect &, int)), this, SLOT(updateLineNumberArea(const QRect &, int)));
     connect(this, SIGNAL(cursorPositionChanged()), this, SLOT(highlightCurrentLine()));
 
+    // Words are only highlighted around the visible blocks, thus the highlighting follows the viewport:
+    d->word_highlight_timer.setSingleShot(true);
+    d->word_highlight_timer.setInterval(0);
+    connect(&d->word_highlight_timer, SIGNAL(timeout()), this, SLOT(updateWordHighlighting()));
+    connect(this, SIGNAL(textChanged()), this, SLOT(invalidateWordHighlighting()));
+
     updateLineNumberAreaWidth(0);
     highlightCurrentLine();
 }
@@ -103,7 +133,9 @@ void Qtilities::CoreGui::CodeEditor::highlightLine(QTextCursor cursor) {
         extraSelections.append(selection);
     }
 
-    setExtraSelections(extraSelections);
+    // The word selections are reused, thus moving the cursor does not search for highlighted words again:
+    d->line_selections = extraSelections;
+    setExtraSelections(d->line_selections + d->word_selections);
 }
 
 void Qtilities::CoreGui::CodeEditor::updateLineNumberArea(const QRect& rect, int dy) {
@@ -114,6 +146,9 @@ void Qtilities::CoreGui::CodeEditor::updateLineNumberArea(const QRect& rect, int
 
     if (rect.contains(viewport()->rect()))
         updateLineNumberAreaWidth(0);
+
+    if (dy && !d->highlighted_words.isEmpty())
+        d->word_highlight_timer.start();
 }
 
 void Qtilities::CoreGui::CodeEditor::resizeEvent(QResizeEvent *e) {
@@ -121,31 +156,86 @@ void Qtilities::CoreGui::CodeEditor::resizeEvent(QResizeEvent *e) {
 
     QRect cr = contentsRect();
     d->lineNumberArea->setGeometry(QRect(cr.left(), cr.top(), lineNumberAreaWidth(), cr.height()));
+
+    if (!d->highlighted_words.isEmpty())
+        d->word_highlight_timer.start();
 }
 
 void Qtilities::CoreGui::CodeEditor::highlightWords(const QStringList& words, const QBrush& brush) {
-    QTextCursor cursor = textCursor();
-    cursor.movePosition(QTextCursor::Start);
-    setTextCursor(cursor);
-
-    foreach (const QString& current_string, words) {
-        while (find(current_string)) {
-            QTextCursor find_cursor = document()->find(current_string,cursor);
-            QTextCharFormat format(find_cursor.charFormat());
-            format.setBackground(brush);
-            find_cursor.mergeCharFormat(format);
-        }
-        cursor.movePosition(QTextCursor::Start);
-        setTextCursor(cursor);
+    d->highlighted_words.clear();
+    foreach (const QString& word, words) {
+        if (!word.isEmpty())
+            d->highlighted_words << word;
     }
-
-    cursor.movePosition(QTextCursor::Start);
-    setTextCursor(cursor);
+    d->word_brush = brush;
+    invalidateWordHighlighting();
+    updateWordHighlighting();
 }
 
 void Qtilities::CoreGui::CodeEditor::removeWordHighlighting() {
-    QString tmp = document()->toPlainText();
-    document()->clear();
-    document()->setPlainText(tmp);
+    d->highlighted_words.clear();
+    invalidateWordHighlighting();
+    setExtraSelections(d->line_selections);
 }
 
+void Qtilities::CoreGui::CodeEditor::invalidateWordHighlighting() {
+    d->word_range_first = -1;
+    d->word_range_last = -1;
+    if (!d->highlighted_words.isEmpty())
+        d->word_highlight_timer.start();
+}
+
+void Qtilities::CoreGui::CodeEditor::updateWordHighlighting() {
+    d->word_highlight_timer.stop();
+    if (d->highlighted_words.isEmpty()) {
+        if (!d->word_selections.isEmpty()) {
+            d->word_selections.clear();
+            setExtraSelections(d->line_selections);
+        }
+        return;
+    }
+
+    // Find the visible blocks:
+    QTextBlock block = firstVisibleBlock();
+    if (!block.isValid())
+        return;
+    const int first_visible = block.blockNumber();
+    int last_visible = first_visible;
+    const int viewport_bottom = viewport()->rect().bottom();
+    qreal top = blockBoundingGeometry(block).translated(contentOffset()).top();
+    while (block.isValid() && top <= viewport_bottom) {
+        last_visible = block.blockNumber();
+        top += blockBoundingRect(block).height();
+        block = block.next();
+    }
+
+    // Nothing changed when the visible blocks are still inside the highlighted range:
+    if (d->word_range_first != -1 && first_visible >= d->word_range_first && last_visible <= d->word_range_last)
+        return;
+
+    d->word_range_first = qMax(0,first_visible - qti_private_word_highlight_lookahead);
+    d->word_range_last = qMin(blockCount() - 1,last_visible + qti_private_word_highlight_lookahead);
+
+    d->word_selections.clear();
+    QTextCharFormat format;
+    format.setBackground(d->word_brush);
+    block = document()->findBlockByNumber(d->word_range_first);
+    while (block.isValid() && block.blockNumber() <= d->word_range_last) {
+        const QString text = block.text();
+        foreach (const QString& word, d->highlighted_words) {
+            int index = text.indexOf(word,0,Qt::CaseInsensitive);
+            while (index != -1) {
+                QTextEdit::ExtraSelection selection;
+                selection.format = format;
+                selection.cursor = QTextCursor(block);
+                selection.cursor.setPosition(block.position() + index);
+                selection.cursor.setPosition(block.position() + index + word.length(),QTextCursor::KeepAnchor);
+                d->word_selections << selection;
+                index = text.indexOf(word,index + word.length(),Qt::CaseInsensitive);
+            }
+        }
+        block = block.next();
+    }
+
+    setExtraSelections(d->line_selections + d->word_selections);
+}
@@ -54,11 +54,21 @@ namespace Qtilities {
             //! Slot to highlight the line specified  by the cursor.
             void highlightLine(QTextCursor cursor);
             //! Function which highlights the specified word in the document using the brush.
+            /*!
+              \note From %Qtilities v1.5 onwards, words are highlighted using extra selections instead of changing the formatting of the document, and
+              only in the visible blocks and a number of blocks around them. The highlighting is updated when the editor is scrolled, resized or edited.
+              */
             void highlightWords(const QStringList& words, const QBrush& brush);
         public:
             //! Function which removes highlighted words set using highlightWords().
             void removeWordHighlighting();
 
+        private slots:
+            //! Invalidates the highlighted words when the document changed.
+            void invalidateWordHighlighting();
+            //! Highlights the words set using highlightWords() in and around the visible blocks.
+            void updateWordHighlighting();
+
         protected:
             void resizeEvent(QResizeEvent *e);
 
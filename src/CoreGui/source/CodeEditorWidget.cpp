@@ -17,6 +17,7 @@
 #include "QtilitiesApplication.h"
 #include "QtilitiesCoreGuiConstants.h"
 #include "ConfigurationWidget.h"
+#include "LargeTextFile_p.h"
 
 #include <FileUtils>
 
@@ -25,9 +26,125 @@
 
 #include <QPrintDialog>
 #include <QPrintPreviewDialog>
+#include <QMutex>
+#include <QRunnable>
+#include <QScrollBar>
+#include <QSharedPointer>
+#include <QThreadPool>
 
 using namespace Qtilities::CoreGui::Icons;
 using namespace Qtilities::CoreGui::Actions;
+using namespace Qtilities::Logging;
+
+namespace {
+    //! The number of lines of a large file which are shown in the editor at any time.
+    const int LARGE_FILE_WINDOW_LINES = 2000;
+    //! The number of bytes decoded at a time by large file searches.
+    const qint64 LARGE_FILE_SEARCH_BLOCK_SIZE = 4 * 1024 * 1024;
+    //! The maximum number of matches found by a large file search.
+    const int LARGE_FILE_MAX_MATCHES = 100000;
+
+    struct LargeFileMatch {
+        int line;
+        int column;
+        int length;
+    };
+
+    //! The state shared between a CodeEditorWidget and the worker searching its large file.
+    struct LargeFileSearchJob {
+        LargeFileSearchJob(QObject* receiver, int generation) : receiver(receiver), generation(generation), finished(false) {}
+
+        QMutex                  mutex;
+        //! The widget to notify when matches are found, set to null when the search is no longer current.
+        QObject*                receiver;
+        int                     generation;
+        //! Matches found since the receiver last took them.
+        QList<LargeFileMatch>   matches;
+        bool                    finished;
+    };
+
+    //! Searches a large file block by block, handing the matches of each block to the widget as they are found.
+    class LargeFileSearchRunnable : public QRunnable
+    {
+    public:
+        LargeFileSearchRunnable(QSharedPointer<LargeFileSearchJob> job, QSharedPointer<LargeTextFile> file, const QRegExp& expression) :
+            job(job), file(file), expression(expression) {}
+
+        void run() {
+            int match_count = 0;
+            int line = 0;
+            qint64 position = 0;
+            bool finished = false;
+            while (!finished) {
+                {
+                    QMutexLocker locker(&job->mutex);
+                    if (!job->receiver)
+                        return;
+                }
+
+                // Blocks end on line boundaries, thus lines and columns match the text shown in the editor.
+                // The file is read block by block, thus a file which is truncated meanwhile only ends the search early:
+                QByteArray data = file->read(position,qMin(LARGE_FILE_SEARCH_BLOCK_SIZE,file->size() - position));
+                finished = data.isEmpty() || position + data.size() >= file->size();
+                if (!finished) {
+                    int block_end = data.lastIndexOf('\n');
+                    while (block_end == -1 && !finished) {
+                        QByteArray more = file->read(position + data.size(),qMin(LARGE_FILE_SEARCH_BLOCK_SIZE,file->size() - position - data.size()));
+                        finished = more.isEmpty() || position + data.size() + more.size() >= file->size();
+                        int newline = more.indexOf('\n');
+                        if (newline != -1 && !finished) {
+                            block_end = data.size() + newline;
+                            more.truncate(newline + 1);
+                        }
+                        data += more;
+                    }
+                    if (!finished)
+                        data.truncate(block_end + 1);
+                }
+                position += data.size();
+
+                QString text = QString::fromUtf8(data.constData(),data.size());
+                text.remove(QLatin1Char('\r'));
+
+                QList<LargeFileMatch> matches;
+                int match_line = line;
+                int line_position = 0;
+                int text_position = 0;
+                while (match_count < LARGE_FILE_MAX_MATCHES && (text_position = expression.indexIn(text,text_position)) != -1) {
+                    int newline;
+                    while ((newline = text.indexOf(QLatin1Char('\n'),line_position)) != -1 && newline < text_position) {
+                        ++match_line;
+                        line_position = newline + 1;
+                    }
+
+                    LargeFileMatch match;
+                    match.line = match_line;
+                    match.column = text_position - line_position;
+                    match.length = expression.matchedLength();
+                    matches << match;
+                    ++match_count;
+                    text_position += qMax(1,match.length);
+                }
+                line += text.count(QLatin1Char('\n'));
+
+                if (match_count >= LARGE_FILE_MAX_MATCHES)
+                    finished = true;
+                if (!matches.isEmpty() || finished) {
+                    QMutexLocker locker(&job->mutex);
+                    job->matches << matches;
+                    job->finished = finished;
+                    if (job->receiver)
+                        QMetaObject::invokeMethod(job->receiver,"handleLargeFileSearchResults",Qt::QueuedConnection,Q_ARG(int,job->generation));
+                }
+            }
+        }
+
+    private:
+        QSharedPointer<LargeFileSearchJob>  job;
+        QSharedPointer<LargeTextFile>       file;
+        QRegExp                             expression;
+    };
+}
 
 struct Qtilities::CoreGui::CodeEditorWidgetPrivateData {
     CodeEditorWidgetPrivateData() : actionNew(0),
@@ -49,7 +166,18 @@ struct Qtilities::CoreGui::CodeEditorWidgetPrivateData {
         syntax_highlighter(0),
         searchBoxWidget(0),
         action_provider(0),
-        removed_outside_policy(CodeEditorWidget::CloseFile){}
+        removed_outside_policy(CodeEditorWidget::CloseFile),
+        large_file_threshold(32 * 1024 * 1024),
+        large_file_scrollbar(0),
+        large_file_window_first(-1),
+        large_file_window_end(-1),
+        ignore_editor_scroll(false),
+        previous_line_wrap_mode(QPlainTextEdit::WidgetWidth),
+        previous_read_only(false),
+        large_file_search_generation(0),
+        large_file_current_match(-1),
+        large_file_select_pending(false),
+        large_file_select_from_line(0) {}
     ~CodeEditorWidgetPrivateData() {
         if (syntax_highlighter)
             delete syntax_highlighter;
@@ -108,6 +236,37 @@ struct Qtilities::CoreGui::CodeEditorWidgetPrivateData {
     //! FileModifiedOutsideHandlingPolicy
     CodeEditorWidget::FileModifiedOutsideHandlingPolicy modified_outside_policy;
 
+    //! The file shown in large file mode, null when the file is loaded into the editor completely.
+    QSharedPointer<LargeTextFile> large_file;
+    //! The file size from which files are opened in large file mode.
+    qint64 large_file_threshold;
+    //! Scrolls through the complete large file, the editor only holds a window of it.
+    QScrollBar* large_file_scrollbar;
+    //! The first line of the large file shown in the editor.
+    int large_file_window_first;
+    //! The line after the last line of the large file shown in the editor.
+    int large_file_window_end;
+    //! Set while the widget scrolls the editor itself.
+    bool ignore_editor_scroll;
+    //! Attaches the syntax highlighter once scrolling through a large file settled.
+    QTimer highlight_timer;
+    //! The editor settings restored when leaving large file mode.
+    QPlainTextEdit::LineWrapMode previous_line_wrap_mode;
+    bool previous_read_only;
+
+    //! The search string and options of the current large file search.
+    QString large_file_search_key;
+    //! Incremented for every large file search, results of previous searches are discarded.
+    int large_file_search_generation;
+    //! The running large file search, null when it finished.
+    QSharedPointer<LargeFileSearchJob> large_file_search_job;
+    //! The matches received so far, in file order.
+    QList<LargeFileMatch> large_file_matches;
+    int large_file_current_match;
+    //! Indicates that the first match from large_file_select_from_line must be selected when it arrives.
+    bool large_file_select_pending;
+    int large_file_select_from_line;
+
 };
 
 Qtilities::CoreGui::CodeEditorWidget::CodeEditorWidget(ActionFlags action_flags, DisplayFlags display_flags, QWidget* parent) :
@@ -129,6 +288,15 @@ Qtilities::CoreGui::CodeEditorWidget::CodeEditorWidget(ActionFlags action_flags,
     d->codeEditor->installEventFilter(this);
     d->codeEditor->viewport()->installEventFilter(this);
     connect(d->codeEditor,SIGNAL(modificationChanged(bool)),SLOT(setModificationState(bool)));
+    connect(d->codeEditor->verticalScrollBar(),SIGNAL(valueChanged(int)),SLOT(handleEditorScrolled(int)));
+
+    // Set up large file mode:
+    d->large_file_scrollbar = new QScrollBar(Qt::Vertical);
+    d->large_file_scrollbar->hide();
+    connect(d->large_file_scrollbar,SIGNAL(valueChanged(int)),SLOT(handleLargeFileScrollBarMoved(int)));
+    d->highlight_timer.setSingleShot(true);
+    d->highlight_timer.setInterval(150);
+    connect(&d->highlight_timer,SIGNAL(timeout()),SLOT(handleHighlightTimeout()));
 
     // Set the tab width:
     QString tab_width_text = "tabs";
@@ -146,7 +314,12 @@ Qtilities::CoreGui::CodeEditorWidget::CodeEditorWidget(ActionFlags action_flags,
         delete d->central_widget->layout();
 
     d->central_widget_layout = new QBoxLayout(QBoxLayout::TopToBottom,d->central_widget);
-    d->central_widget_layout->addWidget(d->codeEditor);
+    QHBoxLayout* editor_layout = new QHBoxLayout;
+    editor_layout->setMargin(0);
+    editor_layout->setSpacing(0);
+    editor_layout->addWidget(d->codeEditor);
+    editor_layout->addWidget(d->large_file_scrollbar);
+    d->central_widget_layout->addLayout(editor_layout);
     d->central_widget_layout->setMargin(0);
     d->central_widget_layout->setSpacing(0);
 
@@ -171,6 +344,7 @@ Qtilities::CoreGui::CodeEditorWidget::CodeEditorWidget(ActionFlags action_flags,
 Qtilities::CoreGui::CodeEditorWidget::~CodeEditorWidget() {
     CONTEXT_MANAGER->unregisterContext(d->global_meta_type);
     maybeSave();
+    cancelLargeFileSearch();
     delete d;
     delete ui;
 }
@@ -276,7 +450,10 @@ void Qtilities::CoreGui::CodeEditorWidget::setSyntaxHighlighter(QSyntaxHighlight
         return;
 
     d->syntax_highlighter = highlighter;
-    d->syntax_highlighter->setDocument(d->codeEditor->document());
+    if (d->large_file)
+        d->highlight_timer.start();
+    else
+        d->syntax_highlighter->setDocument(d->codeEditor->document());
 }
 
 QSyntaxHighlighter* Qtilities::CoreGui::CodeEditorWidget::syntaxHighlighter() const {
@@ -293,15 +470,44 @@ bool Qtilities::CoreGui::CodeEditorWidget::loadFile(const QString &file_name) {
     if (file_name.isEmpty())
         return false;
 
-    // Read everything from the file
-    QFile file(file_name);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return false;
-    }
+    QFileInfo file_info(file_name);
+    if (d->large_file_threshold > 0 && file_info.size() >= d->large_file_threshold) {
+        // Index the lines of the file and only show a window of it in the editor:
+        QSharedPointer<LargeTextFile> large_file(new LargeTextFile(file_name));
+        if (!large_file->open())
+            return false;
+
+        cancelLargeFileSearch();
+        if (!d->large_file) {
+            d->previous_line_wrap_mode = d->codeEditor->lineWrapMode();
+            d->previous_read_only = d->codeEditor->isReadOnly();
+            d->codeEditor->setLineWrapMode(QPlainTextEdit::NoWrap);
+            d->codeEditor->setReadOnly(true);
+            d->codeEditor->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+        }
+        d->large_file = large_file;
+        d->large_file_window_first = -1;
+        d->large_file_window_end = -1;
+        d->large_file_scrollbar->blockSignals(true);
+        d->large_file_scrollbar->setRange(0,qMax(0,large_file->lineCount() - 1));
+        d->large_file_scrollbar->setValue(0);
+        d->large_file_scrollbar->blockSignals(false);
+        d->large_file_scrollbar->show();
+        d->codeEditor->document()->setModified(false);
+        showLargeFileWindow(0);
+        configureSearchBox();
+    } else {
+        // Read everything from the file
+        QFile file(file_name);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            return false;
+        }
 
-    QString contents = file.readAll();
-    d->codeEditor->document()->setModified(false);
-    d->codeEditor->setPlainText(contents);
+        leaveLargeFileMode();
+        QString contents = file.readAll();
+        d->codeEditor->document()->setModified(false);
+        d->codeEditor->setPlainText(contents);
+    }
     setWindowModified(false);
 
     QString prev_file = d->current_file;
@@ -322,6 +528,7 @@ void Qtilities::CoreGui::CodeEditorWidget::closeFile() {
     d->current_file.clear();
     emit fileNameChanged(tr("Untitled"));
 
+    leaveLargeFileMode();
     d->codeEditor->clear();
     refreshActions();
 }
@@ -333,6 +540,17 @@ bool Qtilities::CoreGui::CodeEditorWidget::saveFile(QString file_name) {
     if (file_name.isEmpty())
         return false;
 
+    if (d->large_file) {
+        // The file can't be modified in large file mode, thus saving it under a different name copies it:
+        if (FileUtils::comparePaths(file_name,d->current_file))
+            return true;
+        if (QFile::exists(file_name) && !QFile::remove(file_name))
+            return false;
+        if (!QFile::copy(d->current_file,file_name))
+            return false;
+        return loadFile(file_name);
+    }
+
     if (d->watcher.files().contains(d->current_file))
         d->watcher.removePath(d->current_file);
 
@@ -488,27 +706,18 @@ void Qtilities::CoreGui::CodeEditorWidget::handleSettingsUpdateRequest(const QSt
         if (!QtilitiesCoreApplication::qtilitiesSettingsEnabled())
             return;
 
-        // Read the text editor settings from QSettings
-        QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-        settings.beginGroup("Qtilities");
-        settings.beginGroup("GUI");
-        settings.beginGroup("Editors");
-        settings.beginGroup("Code Editor Widget");
+        // Read the text editor settings from the settings store
+        SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
 
         QFont font;
-        font.setFamily(settings.value("font_type","Courier").toString());
+        font.setFamily(settings->value("Qtilities/GUI/Editors/Code Editor Widget/font_type","Courier").toString());
         font.setFixedPitch(true);
         #ifdef Q_OS_WIN
-        font.setPointSize(settings.value("font_size",8).toInt());
+        font.setPointSize(settings->value("Qtilities/GUI/Editors/Code Editor Widget/font_size",8).toInt());
         #else
-        font.setPointSize(settings.value("font_size",10).toInt());
+        font.setPointSize(settings->value("Qtilities/GUI/Editors/Code Editor Widget/font_size",10).toInt());
         #endif
         d->codeEditor->setFont(font);
-
-        settings.endGroup();
-        settings.endGroup();
-        settings.endGroup();
-        settings.endGroup();
     }
 }
 
@@ -524,7 +733,11 @@ void Qtilities::CoreGui::CodeEditorWidget::showSearchBox() {
         d->searchBoxWidget = new SearchBoxWidget(search_options,SearchBoxWidget::SearchAndReplace,button_flags);
         d->searchBoxWidget->setObjectName("Search Box: Code Editor (" + objectName() + ")");
         d->searchBoxWidget->setWholeWordsOnly(false);
-        d->searchBoxWidget->setPlainTextEditor(d->codeEditor);
+        connect(d->searchBoxWidget,SIGNAL(btnFindNext_clicked()),SLOT(handleLargeFileFindNext()));
+        connect(d->searchBoxWidget,SIGNAL(btnFindPrevious_clicked()),SLOT(handleLargeFileFindPrevious()));
+        connect(d->searchBoxWidget,SIGNAL(searchStringChanged(QString)),SLOT(handleLargeFileSearchChanged()));
+        connect(d->searchBoxWidget,SIGNAL(searchOptionsChanged()),SLOT(handleLargeFileSearchChanged()));
+        configureSearchBox();
         if (d->central_widget_layout)
             d->central_widget_layout->addWidget(d->searchBoxWidget);
     }
@@ -622,6 +835,313 @@ void Qtilities::CoreGui::CodeEditorWidget::handleFileChangedNotification(const Q
     d->watcher_mutex.unlock();
 }
 
+void Qtilities::CoreGui::CodeEditorWidget::setLargeFileThreshold(qint64 bytes) {
+    d->large_file_threshold = bytes;
+}
+
+qint64 Qtilities::CoreGui::CodeEditorWidget::largeFileThreshold() const {
+    return d->large_file_threshold;
+}
+
+bool Qtilities::CoreGui::CodeEditorWidget::isLargeFileMode() const {
+    return !d->large_file.isNull();
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::leaveLargeFileMode() {
+    if (!d->large_file)
+        return;
+
+    cancelLargeFileSearch();
+    d->large_file.clear();
+    d->large_file_window_first = -1;
+    d->large_file_window_end = -1;
+    d->highlight_timer.stop();
+    d->large_file_scrollbar->hide();
+    d->codeEditor->setLineWrapMode(d->previous_line_wrap_mode);
+    d->codeEditor->setReadOnly(d->previous_read_only);
+    d->codeEditor->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    if (d->syntax_highlighter && d->syntax_highlighter->document() != d->codeEditor->document())
+        d->syntax_highlighter->setDocument(d->codeEditor->document());
+    configureSearchBox();
+}
+
+bool Qtilities::CoreGui::CodeEditorWidget::reloadLargeFile() {
+    // The file changed since its lines were indexed, thus index it again before it is searched:
+    QSharedPointer<LargeTextFile> large_file(new LargeTextFile(d->large_file->fileName()));
+    if (!large_file->open())
+        return false;
+
+    int current_line = d->large_file_window_first + d->codeEditor->verticalScrollBar()->value();
+    d->large_file = large_file;
+    d->large_file_window_first = -1;
+    d->large_file_window_end = -1;
+    d->large_file_scrollbar->blockSignals(true);
+    d->large_file_scrollbar->setRange(0,qMax(0,large_file->lineCount() - 1));
+    d->large_file_scrollbar->blockSignals(false);
+    scrollLargeFileToLine(qMin(current_line,large_file->lineCount() - 1));
+    return true;
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::showLargeFileWindow(int first_line) {
+    int line_count = d->large_file->lineCount();
+    first_line = qBound(0,first_line,qMax(0,line_count - LARGE_FILE_WINDOW_LINES));
+    int end_line = qMin(line_count,first_line + LARGE_FILE_WINDOW_LINES);
+    if (first_line == d->large_file_window_first && end_line == d->large_file_window_end)
+        return;
+
+    // Keep the cursor where it was in the file when it is part of the new window:
+    int cursor_line = -1;
+    int cursor_column = 0;
+    if (d->large_file_window_first >= 0) {
+        QTextCursor cursor = d->codeEditor->textCursor();
+        cursor_line = d->large_file_window_first + cursor.blockNumber();
+        cursor_column = cursor.positionInBlock();
+    }
+
+    QString text = d->large_file->text(first_line,end_line);
+    if (text.endsWith(QLatin1Char('\n')))
+        text.chop(1);
+
+    // Highlighting is deferred until scrolling settled, see handleHighlightTimeout():
+    if (d->syntax_highlighter)
+        d->syntax_highlighter->setDocument(0);
+
+    d->ignore_editor_scroll = true;
+    d->codeEditor->setPlainText(text);
+    d->large_file_window_first = first_line;
+    d->large_file_window_end = end_line;
+    if (cursor_line >= first_line && cursor_line < end_line) {
+        QTextBlock block = d->codeEditor->document()->findBlockByNumber(cursor_line - first_line);
+        QTextCursor cursor(block);
+        cursor.setPosition(block.position() + qMin(cursor_column,block.length() - 1));
+        d->codeEditor->setTextCursor(cursor);
+    }
+    d->ignore_editor_scroll = false;
+    d->highlight_timer.start();
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::scrollLargeFileToLine(int line) {
+    if (!d->large_file)
+        return;
+
+    int visible_lines = largeFileVisibleLines();
+    if (line < d->large_file_window_first || line + visible_lines > d->large_file_window_end)
+        showLargeFileWindow(line - LARGE_FILE_WINDOW_LINES / 2);
+
+    d->ignore_editor_scroll = true;
+    d->codeEditor->verticalScrollBar()->setValue(line - d->large_file_window_first);
+    d->ignore_editor_scroll = false;
+    updateLargeFileScrollBar();
+}
+
+int Qtilities::CoreGui::CodeEditorWidget::largeFileVisibleLines() const {
+    return qMax(1,d->codeEditor->viewport()->height() / qMax(1,d->codeEditor->fontMetrics().lineSpacing()));
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::updateLargeFileScrollBar() {
+    d->large_file_scrollbar->blockSignals(true);
+    d->large_file_scrollbar->setPageStep(largeFileVisibleLines());
+    d->large_file_scrollbar->setValue(d->large_file_window_first + d->codeEditor->verticalScrollBar()->value());
+    d->large_file_scrollbar->blockSignals(false);
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::handleLargeFileScrollBarMoved(int line) {
+    scrollLargeFileToLine(line);
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::handleEditorScrolled(int value) {
+    if (!d->large_file || d->ignore_editor_scroll)
+        return;
+
+    // Move the window when the editor is scrolled close to either end of it:
+    int margin = LARGE_FILE_WINDOW_LINES / 8;
+    QScrollBar* scrollbar = d->codeEditor->verticalScrollBar();
+    if ((value < margin && d->large_file_window_first > 0) ||
+        (value > scrollbar->maximum() - margin && d->large_file_window_end < d->large_file->lineCount()))
+        scrollLargeFileToLine(d->large_file_window_first + value);
+    else
+        updateLargeFileScrollBar();
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::handleHighlightTimeout() {
+    if (d->large_file && d->syntax_highlighter)
+        d->syntax_highlighter->setDocument(d->codeEditor->document());
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::configureSearchBox() {
+    if (!d->searchBoxWidget)
+        return;
+
+    // In large file mode the editor only holds a window of the file, thus searches are handled by the widget:
+    if (d->large_file) {
+        d->searchBoxWidget->setPlainTextEditor(0);
+        d->searchBoxWidget->setWidgetMode(SearchBoxWidget::SearchOnly);
+    } else {
+        d->searchBoxWidget->setPlainTextEditor(d->codeEditor);
+        d->searchBoxWidget->setWidgetMode(SearchBoxWidget::SearchAndReplace);
+        d->searchBoxWidget->clearInfoText();
+    }
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::cancelLargeFileSearch() {
+    if (d->large_file_search_job) {
+        QMutexLocker locker(&d->large_file_search_job->mutex);
+        d->large_file_search_job->receiver = 0;
+    }
+    d->large_file_search_job.clear();
+    d->large_file_search_key.clear();
+    d->large_file_matches.clear();
+    d->large_file_current_match = -1;
+    d->large_file_select_pending = false;
+}
+
+bool Qtilities::CoreGui::CodeEditorWidget::updateLargeFileSearch() {
+    SearchBoxWidget* search_box = d->searchBoxWidget;
+    QString search_string = search_box->currentSearchString();
+    QRegExp::PatternSyntax pattern_syntax = search_box->patternSyntax();
+    QString search_key = QString("%1:%2:%3:").arg(search_box->caseSensitive()).arg(search_box->wholeWordsOnly()).arg((int) pattern_syntax) + search_string;
+    if (search_key == d->large_file_search_key)
+        return false;
+
+    cancelLargeFileSearch();
+    d->large_file_search_key = search_key;
+    if (d->large_file->hasChanged() && !reloadLargeFile()) {
+        search_box->setInfoText(tr("The file could not be read"));
+        return true;
+    }
+    if (search_string.isEmpty()) {
+        search_box->clearInfoText();
+        return true;
+    }
+
+    QRegExp expression(search_string,search_box->caseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive,pattern_syntax);
+    if (search_box->wholeWordsOnly()) {
+        if (pattern_syntax == QRegExp::FixedString)
+            expression = QRegExp("\\b" + QRegExp::escape(search_string) + "\\b",expression.caseSensitivity(),QRegExp::RegExp);
+        else if (pattern_syntax == QRegExp::RegExp || pattern_syntax == QRegExp::RegExp2)
+            expression.setPattern("\\b(?:" + search_string + ")\\b");
+    }
+    if (!expression.isValid()) {
+        search_box->setInfoText(tr("Invalid search expression"));
+        return true;
+    }
+
+    d->large_file_search_job = QSharedPointer<LargeFileSearchJob>(new LargeFileSearchJob(this,++d->large_file_search_generation));
+    d->large_file_select_pending = true;
+    d->large_file_select_from_line = d->large_file_window_first + d->codeEditor->verticalScrollBar()->value();
+    search_box->setInfoText(tr("Searching..."));
+    QThreadPool::globalInstance()->start(new LargeFileSearchRunnable(d->large_file_search_job,d->large_file,expression));
+    return true;
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::handleLargeFileSearchResults(int generation) {
+    if (generation != d->large_file_search_generation || !d->large_file_search_job)
+        return;
+
+    int first_new_match = d->large_file_matches.count();
+    bool finished;
+    {
+        QMutexLocker locker(&d->large_file_search_job->mutex);
+        d->large_file_matches << d->large_file_search_job->matches;
+        d->large_file_search_job->matches.clear();
+        finished = d->large_file_search_job->finished;
+    }
+    if (finished)
+        d->large_file_search_job.clear();
+
+    // Matches arrive in file order, thus only the new matches can be the first one after the line the search started from:
+    if (d->large_file_select_pending) {
+        for (int i = first_new_match; i < d->large_file_matches.count(); ++i) {
+            if (d->large_file_matches.at(i).line >= d->large_file_select_from_line) {
+                selectLargeFileMatch(i);
+                break;
+            }
+        }
+        if (d->large_file_select_pending && finished && !d->large_file_matches.isEmpty())
+            selectLargeFileMatch(0);
+    }
+
+    int match_count = d->large_file_matches.count();
+    if (!finished)
+        d->searchBoxWidget->setInfoText(tr("Searching... %1 matches found").arg(match_count));
+    else if (match_count == 0)
+        d->searchBoxWidget->setInfoText(tr("No matches found"));
+    else if (match_count >= LARGE_FILE_MAX_MATCHES)
+        d->searchBoxWidget->setInfoText(tr("More than %1 matches found").arg(match_count));
+    else
+        d->searchBoxWidget->setInfoText(tr("%1 matches found").arg(match_count));
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::selectLargeFileMatch(int index) {
+    d->large_file_select_pending = false;
+    d->large_file_current_match = index;
+    const LargeFileMatch& match = d->large_file_matches.at(index);
+
+    int margin = LARGE_FILE_WINDOW_LINES / 4;
+    if (match.line < d->large_file_window_first + margin || match.line >= d->large_file_window_end - margin)
+        showLargeFileWindow(match.line - LARGE_FILE_WINDOW_LINES / 2);
+
+    QTextDocument* document = d->codeEditor->document();
+    QTextBlock block = document->findBlockByNumber(match.line - d->large_file_window_first);
+    if (!block.isValid())
+        return;
+
+    int start = block.position() + match.column;
+    QTextCursor cursor(document);
+    cursor.setPosition(qMin(start,document->characterCount() - 1));
+    cursor.setPosition(qMin(start + match.length,document->characterCount() - 1),QTextCursor::KeepAnchor);
+    d->ignore_editor_scroll = true;
+    d->codeEditor->setTextCursor(cursor);
+    d->codeEditor->centerCursor();
+    d->ignore_editor_scroll = false;
+    updateLargeFileScrollBar();
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::handleLargeFileSearchChanged() {
+    if (!d->large_file || !d->searchBoxWidget)
+        return;
+
+    updateLargeFileSearch();
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::handleLargeFileFindNext() {
+    if (!d->large_file || !d->searchBoxWidget)
+        return;
+
+    // A new search selects its first match itself:
+    if (updateLargeFileSearch())
+        return;
+
+    int match_count = d->large_file_matches.count();
+    if (d->large_file_current_match + 1 < match_count) {
+        selectLargeFileMatch(d->large_file_current_match + 1);
+    } else if (d->large_file_search_job) {
+        // Wait for the next match from the running search:
+        d->large_file_select_pending = true;
+        if (match_count > 0)
+            d->large_file_select_from_line = d->large_file_matches.last().line + 1;
+    } else if (match_count > 0) {
+        selectLargeFileMatch(0);
+    }
+}
+
+void Qtilities::CoreGui::CodeEditorWidget::handleLargeFileFindPrevious() {
+    if (!d->large_file || !d->searchBoxWidget)
+        return;
+
+    if (updateLargeFileSearch())
+        return;
+
+    int match_count = d->large_file_matches.count();
+    if (match_count == 0)
+        return;
+
+    if (d->large_file_current_match > 0)
+        selectLargeFileMatch(d->large_file_current_match - 1);
+    else
+        selectLargeFileMatch(match_count - 1);
+}
+
 void Qtilities::CoreGui::CodeEditorWidget::constructActions() {
     if (d->action_provider)
         return;
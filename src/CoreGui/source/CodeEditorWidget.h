@@ -272,6 +272,13 @@ code_editor.codeEditor()->setReadOnly(true);
         private slots:
             void updateSaveAction();
             void handleFileChangedNotification(const QString& path);
+            void handleLargeFileScrollBarMoved(int line);
+            void handleEditorScrolled(int value);
+            void handleHighlightTimeout();
+            void handleLargeFileSearchResults(int generation);
+            void handleLargeFileSearchChanged();
+            void handleLargeFileFindNext();
+            void handleLargeFileFindPrevious();
 
         protected:
             void constructActions();
@@ -326,6 +333,35 @@ code_editor.codeEditor()->setReadOnly(true);
               <i>This function was added in %Qtilities v1.1.</i>
               */
             QString defaultPath() const;
+            //! Sets the file size in bytes from which loadFile() opens files in large file mode.
+            /*!
+              In large file mode the file is read in blocks using a sparse index of its lines and the editor only holds a window of a few thousand lines around the
+              visible part of the file. A separate scroll bar scrolls through the complete file. The editor is read only in this mode,
+              searches in the search box run over the complete file in a background thread and the syntax highlighter is only applied
+              to the window once scrolling settled. When the file changed on disk since it was indexed, it is indexed again before
+              the next search starts.
+
+              Set the threshold to 0 to always load files completely. The default is 32 MB.
+
+              \sa largeFileThreshold(), isLargeFileMode()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setLargeFileThreshold(qint64 bytes);
+            //! Gets the file size in bytes from which loadFile() opens files in large file mode.
+            /*!
+              \sa setLargeFileThreshold()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            qint64 largeFileThreshold() const;
+            //! Indicates if the current file is shown in large file mode.
+            /*!
+              \sa setLargeFileThreshold()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool isLargeFileMode() const;
 
             // --------------------------------
             // Access To Contained Elements
@@ -346,6 +382,23 @@ code_editor.codeEditor()->setReadOnly(true);
             void refreshActionToolBar(bool force_full_refresh);
             bool maybeSave();
         private:
+            //! Restores the editor after large file mode.
+            void leaveLargeFileMode();
+            //! Shows the window of the large file starting at \p first_line in the editor.
+            void showLargeFileWindow(int first_line);
+            //! Indexes the large file again after it changed on disk, returns false when it could not be read.
+            bool reloadLargeFile();
+            //! Scrolls the editor so that \p line of the large file is at the top, moving the window when needed.
+            void scrollLargeFileToLine(int line);
+            int largeFileVisibleLines() const;
+            void updateLargeFileScrollBar();
+            //! Lets the search box operate on the editor, or on the widget in large file mode.
+            void configureSearchBox();
+            void cancelLargeFileSearch();
+            //! Starts a new large file search when the search string or options changed, returns true when it did.
+            bool updateLargeFileSearch();
+            void selectLargeFileMatch(int index);
+
             Ui::CodeEditorWidget *ui;
             CodeEditorWidgetPrivateData* d;
         };
@@ -22,10 +22,10 @@
 #include "QtilitiesApplication.h"
 #include "QtilitiesCoreGuiConstants.h"
 
-#include <QSettings>
 #include <QFontDatabase>
 
 using namespace Qtilities::CoreGui::Constants;
+using namespace Qtilities::Logging;
 using namespace Qtilities::CoreGui::Icons;
 
 Qtilities::CoreGui::CodeEditorWidgetConfig::CodeEditorWidgetConfig(QWidget* parent, Qt::WindowFlags f) :
@@ -62,18 +62,10 @@ void Qtilities::CoreGui::CodeEditorWidgetConfig::configPageApply() {
     if (!QtilitiesCoreApplication::qtilitiesSettingsEnabled())
         return;
 
-    // Save fields back to QSettings
-    QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("GUI");
-    settings.beginGroup("Editors");
-    settings.beginGroup("Code Editor Widget");
-    settings.setValue("font_type",ui->fontComboBox->currentText());
-    settings.setValue("font_size",ui->fontSizeComboBox->currentText().toInt());
-    settings.endGroup();
-    settings.endGroup();
-    settings.endGroup();
-    settings.endGroup();
+    // Save fields back to the settings store
+    SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+    settings->setValue("Qtilities/GUI/Editors/Code Editor Widget/font_type",ui->fontComboBox->currentText());
+    settings->setValue("Qtilities/GUI/Editors/Code Editor Widget/font_size",ui->fontSizeComboBox->currentText().toInt());
 
     // Emit the settings update request signal
     QtilitiesApplication::newSettingsUpdateRequest("AllCodeEditors");
@@ -85,16 +77,8 @@ void Qtilities::CoreGui::CodeEditorWidgetConfig::configPageInitialize() {
     foreach(int size, db.standardSizes())
         ui->fontSizeComboBox->addItem(QString::number(size));
 
-    // Populate fields with values from QSettings
-    QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("GUI");
-    settings.beginGroup("Editors");
-    settings.beginGroup("Code Editor Widget");
-    ui->fontComboBox->setEditText(settings.value("font_type","Courier").toString());
-    ui->fontSizeComboBox->setEditText(settings.value("font_size",8).toString());
-    settings.endGroup();
-    settings.endGroup();
-    settings.endGroup();
-    settings.endGroup();
+    // Populate fields with values from the settings store
+    SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+    ui->fontComboBox->setEditText(settings->value("Qtilities/GUI/Editors/Code Editor Widget/font_type","Courier").toString());
+    ui->fontSizeComboBox->setEditText(settings->value("Qtilities/GUI/Editors/Code Editor Widget/font_size",8).toString());
 }
@@ -167,7 +167,7 @@ void Qtilities::CoreGui::ProxyAction::addAction(QAction* action, QList<int> cont
             // Check if there is already an action for this context
             if (d->id_action_map.contains(context_ids.at(i))) {
                 if (d->id_action_map.contains(context_ids.at(i))) {
-                    LOG_DEBUG(tr("Attempting to register a backend action for a proxy action twice for a single context with name: ") + CONTEXT_MANAGER->contextString(context_ids.at(i)) + tr(". Last action will be ignored: ") + action->text());
+                    LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreGuiLogTag,tr("Attempting to register a backend action for a proxy action twice for a single context with name: ") + CONTEXT_MANAGER->contextString(context_ids.at(i)) + tr(". Last action will be ignored: ") + action->text());
                     qWarning() << "Attempting to register a backend action for a proxy action twice for a single context with name: " << CONTEXT_MANAGER->contextString(context_ids.at(i)) <<  ". Last action will be ignored: " <<  action->text();
                     continue;
                 } else
@@ -184,6 +184,8 @@ void Qtilities::CoreGui::ProxyAction::addAction(QAction* action, QList<int> cont
         }
     }
 
+    emit registeredContextsChanged();
+
     // If any of the context_ids are active, we need to update the active backend action:
     setCurrentContext(CONTEXT_MANAGER->activeContexts());
     //qDebug() << "Adding action to proxy action:" << defaultText() << activeBackendAction() << CONTEXT_MANAGER->activeContexts();
@@ -195,7 +197,7 @@ bool Qtilities::CoreGui::ProxyAction::isActive() {
 
 bool Qtilities::CoreGui::ProxyAction::setCurrentContext(QList<int> context_ids) {
     #if defined(QTILITIES_VERBOSE_ACTION_DEBUGGING)
-    LOG_TRACE("Context update request on command (proxy action): " + defaultText());
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,"Context update request on command (proxy action): " + defaultText());
     #endif
 
     // If this is just a place holder without any backend action we do nothing in here.
@@ -211,7 +213,7 @@ bool Qtilities::CoreGui::ProxyAction::setCurrentContext(QList<int> context_ids)
             d->active_backend_action->setObjectName(a->text());
 
             #if defined(QTILITIES_VERBOSE_ACTION_DEBUGGING)
-            LOG_TRACE("Backend action found: " + d->active_backend_action->text() + ", backend shortcut: " + d->active_backend_action->shortcut().toString() + ", ProxyAction shortcut: " + d->proxy_action->shortcut().toString());
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,"Backend action found: " + d->active_backend_action->text() + ", backend shortcut: " + d->active_backend_action->shortcut().toString() + ", ProxyAction shortcut: " + d->proxy_action->shortcut().toString());
             qDebug() << "Backend action found: " + d->active_backend_action->text() + ", backend shortcut: " + d->active_backend_action->shortcut().toString() + ", ProxyAction shortcut: " + d->proxy_action->shortcut().toString();
             #endif
 
@@ -223,7 +225,7 @@ bool Qtilities::CoreGui::ProxyAction::setCurrentContext(QList<int> context_ids)
     if (d->active_backend_action == old_action && d->initialized)  {
         updateFrontendAction();
         #if defined(QTILITIES_VERBOSE_ACTION_DEBUGGING)
-        LOG_TRACE("New backend action is the same as the current active backend action. Nothing to be done in here.");
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,"New backend action is the same as the current active backend action. Nothing to be done in here.");
         qDebug() << "New backend action is the same as the current active backend action. Nothing to be done in here.";
         #endif
         return true;
@@ -240,7 +242,7 @@ bool Qtilities::CoreGui::ProxyAction::setCurrentContext(QList<int> context_ids)
         if (parent) {
              parent_name = parent->objectName();
         }
-        LOG_TRACE("Disconnecting multicontext action from previous backend action in parent: " + parent_name);
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,"Disconnecting multicontext action from previous backend action in parent: " + parent_name);
         #endif
     }
 
@@ -258,13 +260,13 @@ bool Qtilities::CoreGui::ProxyAction::setCurrentContext(QList<int> context_ids)
         if (parent) {
              parent_name = parent->objectName();
         }
-        LOG_TRACE("Base action connected: " + d->active_backend_action->text() + ", Base shortcut: " + d->proxy_action->shortcut().toString() + ", Parent: " + parent_name);
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,"Base action connected: " + d->active_backend_action->text() + ", Base shortcut: " + d->proxy_action->shortcut().toString() + ", Parent: " + parent_name);
         qDebug() << "Base action connected: " << d->active_backend_action->text() << ", Base shortcut: " << d->proxy_action->shortcut().toString() << ", Parent: " << parent_name;
         #endif
         return true;
     } else {
         #if defined(QTILITIES_VERBOSE_ACTION_DEBUGGING)
-        LOG_TRACE("New backend action could not be found. Action will be disabled in this context.");
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,"New backend action could not be found. Action will be disabled in this context.");
         #endif
     }
     // We can hide the action here if needed
@@ -395,7 +397,7 @@ void Qtilities::CoreGui::ProxyAction::handleKeySequenceChange(const QKeySequence
 void Qtilities::CoreGui::ProxyAction::unregisterContext(int context_id) {
     if (d->id_action_map.contains(context_id)) {
         #if defined(QTILITIES_VERBOSE_ACTION_DEBUGGING)
-        LOG_TRACE("Context backend removed on command (action): " + defaultText());
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,"Context backend removed on command (action): " + defaultText());
         #endif
         d->id_action_map.remove(context_id);
 
@@ -403,6 +405,7 @@ void Qtilities::CoreGui::ProxyAction::unregisterContext(int context_id) {
             d->active_contexts.removeOne(context_id);
             setCurrentContext(d->active_contexts); // Needed to update d->active_backend_action
         }
+        emit registeredContextsChanged();
     }
 }
 
@@ -464,7 +467,7 @@ bool Qtilities::CoreGui::ShortcutCommand::isActive() {
 
 bool Qtilities::CoreGui::ShortcutCommand::setCurrentContext(QList<int> context_ids) {
     #if defined(QTILITIES_VERBOSE_ACTION_DEBUGGING)
-    LOG_TRACE("Context update request on command (shortcut): " + defaultText());
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,"Context update request on command (shortcut): " + defaultText());
     #endif
 
     bool must_become_active = false;
@@ -497,11 +500,12 @@ void Qtilities::CoreGui::ShortcutCommand::handleKeySequenceChange(const QKeySequ
 void Qtilities::CoreGui::ShortcutCommand::unregisterContext(int context_id) {
     if (d->active_contexts.contains(context_id)) {
         #if defined(QTILITIES_VERBOSE_ACTION_DEBUGGING)
-        LOG_TRACE("Context backend removed on command (shortcut): " + defaultText());
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::CoreGuiLogTag,"Context backend removed on command (shortcut): " + defaultText());
         #endif
 
         d->active_contexts.removeOne(context_id);
         setCurrentContext(d->active_contexts); // Needed to update d->is_active
+        emit registeredContextsChanged();
     }
 }
 
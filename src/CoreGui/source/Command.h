@@ -104,6 +104,13 @@ namespace Qtilities {
 
         signals:
             void keySequenceChanged();
+            //! Emitted when the contexts in which the command has backend actions or in which it is enabled changed.
+            /*!
+              The action manager uses this signal to keep track of the commands affected by changes to the active contexts.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void registeredContextsChanged();
 
         protected:
             static int d_category_context;
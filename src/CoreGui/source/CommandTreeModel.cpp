@@ -21,7 +21,55 @@
 #endif
 
 Qtilities::CoreGui::qti_private_CommandTreeModel::qti_private_CommandTreeModel(QObject* parent) : ObserverTreeModel(parent) {
+    connect(this,SIGNAL(treeModelBuildEnded()),SLOT(clearCommandCache()));
+}
+
+Qtilities::CoreGui::qti_private_CommandTreeModel::CommandRowData& Qtilities::CoreGui::qti_private_CommandTreeModel::commandRowData(Command* command) const {
+    QHash<const QObject*, CommandRowData>::iterator itr = command_rows.find(command);
+    if (itr != command_rows.end())
+        return itr.value();
+
+    // Commands are only watched once their rows are shown:
+    QObject::connect(command,SIGNAL(keySequenceChanged()),this,SLOT(handleCommandKeySequenceChanged()),Qt::UniqueConnection);
+    CommandRowData row_data;
+    row_data.shortcut = command->keySequence().toString();
+    return command_rows.insert(command,row_data).value();
+}
+
+void Qtilities::CoreGui::qti_private_CommandTreeModel::handleCommandKeySequenceChanged() {
+    Command* command = qobject_cast<Command*> (sender());
+    if (!command)
+        return;
+
+    // The conflict state of the commands which shared the old keys, or share the new keys, might have changed:
+    QList<Command*> affected_commands;
+    QHash<const QObject*, CommandRowData>::const_iterator itr = command_rows.constFind(command);
+    if (itr != command_rows.constEnd() && !itr.value().shortcut.isEmpty())
+        affected_commands << ACTION_MANAGER->commandsWithKeySequence(QKeySequence(itr.value().shortcut));
+    if (!command->keySequence().isEmpty())
+        affected_commands << ACTION_MANAGER->commandsWithKeySequence(command->keySequence());
+    command_rows.remove(command);
+
+    int shortcut_column = columnCount() - 1;
+    QModelIndex command_index = findObject(command,shortcut_column);
+    if (command_index.isValid())
+        emit dataChanged(command_index,command_index);
+
+    for (int i = 0; i < affected_commands.count(); ++i) {
+        Command* affected_command = affected_commands.at(i);
+        QHash<const QObject*, CommandRowData>::iterator affected_itr = command_rows.find(affected_command);
+        if (affected_command == command || affected_itr == command_rows.end() || !affected_itr.value().conflict_valid)
+            continue;
+
+        affected_itr.value().conflict_valid = false;
+        QModelIndex affected_index = findObject(affected_command,shortcut_column);
+        if (affected_index.isValid())
+            emit dataChanged(affected_index,affected_index);
+    }
+}
 
+void Qtilities::CoreGui::qti_private_CommandTreeModel::clearCommandCache() {
+    command_rows.clear();
 }
 
 QVariant Qtilities::CoreGui::qti_private_CommandTreeModel::data(const QModelIndex &index, int role) const {
@@ -39,7 +87,7 @@ QVariant Qtilities::CoreGui::qti_private_CommandTreeModel::data(const QModelInde
         if (obj) {
             Command* command = qobject_cast<Command*> (obj);
             if (command) {
-                return command->keySequence().toString();
+                return commandRowData(command).shortcut;
             }
         }
         return QVariant();
@@ -48,7 +96,12 @@ QVariant Qtilities::CoreGui::qti_private_CommandTreeModel::data(const QModelInde
         if (obj) {
             Command* command = qobject_cast<Command*> (obj);
             if (command) {
-                if (ACTION_MANAGER->commandsWithKeySequence(command->keySequence()).count() > 1)
+                CommandRowData& row_data = commandRowData(command);
+                if (!row_data.conflict_valid) {
+                    row_data.has_conflict = !row_data.shortcut.isEmpty() && ACTION_MANAGER->commandsWithKeySequence(command->keySequence()).count() > 1;
+                    row_data.conflict_valid = true;
+                }
+                if (row_data.has_conflict)
                     return QBrush(Qt::red);
             }
         }
@@ -17,9 +17,12 @@
 #include <QMutex>
 #include <QAbstractTableModel>
 #include <QItemSelection>
+#include <QHash>
 
 namespace Qtilities {
     namespace CoreGui {
+        class Command;
+
         // -----------------------------------------------
         // CommandTableModel
         // -----------------------------------------------
@@ -40,6 +43,28 @@ namespace Qtilities {
             int rowCount(const QModelIndex &parent = QModelIndex()) const;
             int columnCount(const QModelIndex &parent = QModelIndex()) const;
             bool setData(const QModelIndex &index, const QVariant &value, int role);
+
+        private slots:
+            //! Drops the cached shortcut of the command which changed, and the conflict state of the commands sharing its keys.
+            void handleCommandKeySequenceChanged();
+            //! Drops all cached shortcuts, the commands in the tree might have changed.
+            void clearCommandCache();
+
+        private:
+            //! The shortcut data shown for a command, computed when its row is first shown.
+            struct CommandRowData {
+                CommandRowData() : has_conflict(false), conflict_valid(false) {}
+
+                QString shortcut;
+                bool    has_conflict;
+                //! Indicates if has_conflict is up to date, it is computed on demand since it depends on other commands.
+                bool    conflict_valid;
+            };
+
+            //! Returns the cached row data of \p command, computing the shortcut string the first time.
+            CommandRowData& commandRowData(Command* command) const;
+
+            mutable QHash<const QObject*, CommandRowData> command_rows;
         };
 
         // -----------------------------------------------
@@ -16,14 +16,25 @@
 #include "QtilitiesMainWindow.h"
 
 #include <Logger>
+#include <StartupProfiler>
 
 #include <QTreeWidgetItem>
 #include <QBoxLayout>
 #include <QDesktopWidget>
 #include <QPushButton>
+#include <QRegExp>
+#include <QSet>
 #include <QStatusBar>
 
 using namespace Qtilities::CoreGui::Interfaces;
+
+namespace {
+    //! Splits \p text into the lower case words used in the page search index.
+    QStringList qti_private_configPageSearchWords(const QString& text) {
+        return text.toLower().split(QRegExp("\\W+"),QString::SkipEmptyParts);
+    }
+}
+
 struct Qtilities::CoreGui::ConfigurationWidgetPrivateData {
     ConfigurationWidgetPrivateData() : config_pages_obs(QObject::tr("Application Settings")),
         activity_filter(0),
@@ -67,6 +78,12 @@ struct Qtilities::CoreGui::ConfigurationWidgetPrivateData {
     bool                    categorized_display;
     //! Indicates if icons must be used when categorized display is enabled.
     bool                    categorized_display_use_tab_icons;
+    //! The pages which were initialized and of which the widget was created.
+    QSet<IConfigPage*>      constructed_pages;
+    //! The search index of the pages, mapping the words in their titles, categories and keywords to the pages.
+    QMap<QString,QList<IConfigPage*> > search_index;
+    //! The indexed pages, in the order they were passed to initialize().
+    QList<IConfigPage*>     indexed_pages;
 };
 
 Qtilities::CoreGui::ConfigurationWidget::ConfigurationWidget(Qtilities::DisplayMode display_mode, QWidget *parent) :
@@ -175,6 +192,7 @@ void Qtilities::CoreGui::ConfigurationWidget::sharedConstruct() {
 }
 
 void Qtilities::CoreGui::ConfigurationWidget::initialize(QList<IConfigPage*> config_pages, QList<IGroupedConfigPageInfoProvider*> grouped_page_info_providers) {
+    StartupProfileScope profile_scope(windowTitle(),"Configuration Pages");
     if (!d->initialized) {
         // Add an activity policy filter to the config pages observer:
         d->activity_filter = new ActivityPolicyFilter();
@@ -196,12 +214,15 @@ void Qtilities::CoreGui::ConfigurationWidget::initialize(QList<IConfigPage*> con
     QApplication::setOverrideCursor(Qt::BusyCursor);
     d->apply_all_pages_visible = false;
 
+    // In item view display modes, pages are only initialized and their widgets created when they are selected for the first time.
+    // The mode manager used in the mode widget display modes needs the widgets of all modes, thus pages are constructed up front in those modes:
+    bool construct_on_selection = d->display_mode & DisplayLeftItemViews;
+
     // Figure out what the maximum sizes are in all pages.
     int max_width = -1;
     int max_height = -1;
 
     QList<IConfigPage*> uncategorized_pages;
-    QList<IConfigPage*> initialized_pages;
 
     d->config_pages_obs.startProcessingCycle();
     if (d->categorized_display) {
@@ -221,10 +242,9 @@ void Qtilities::CoreGui::ConfigurationWidget::initialize(QList<IConfigPage*> con
                         categories << current_category;
                     config_page_category_map[config_page] = current_category;
                 }
+                // Categorized pages are initialized by their grouped page when their tab is shown for the first time:
                 if (config_page->supportsApply())
                     d->apply_all_pages_visible = true;
-                config_page->configPageInitialize();
-                initialized_pages << config_page;
             }
         }
 
@@ -258,14 +278,6 @@ void Qtilities::CoreGui::ConfigurationWidget::initialize(QList<IConfigPage*> con
             if (grouped_config_pages.contains(itr.value())) {
                 GroupedConfigPage* group_page_for_category = grouped_config_pages[itr.value()];
                 group_page_for_category->addConfigPage(itr.key());
-
-                QWidget* page_widget = itr.key()->configPageWidget();
-                if (page_widget) {
-                    if (page_widget->size().width() > max_width)
-                        max_width = page_widget->sizeHint().width();
-                    if (page_widget->size().height() > max_height)
-                        max_height = page_widget->sizeHint().height();
-                }
             } else {
                 qWarning() << Q_FUNC_INFO << "Could not find grouped category page for category " << itr.value().toString();
             }
@@ -295,7 +307,20 @@ void Qtilities::CoreGui::ConfigurationWidget::initialize(QList<IConfigPage*> con
     // Add all the pages to the config pages observer:
     for (int i = 0; i < uncategorized_pages.count(); ++i) {
         IConfigPage* config_page = uncategorized_pages.at(i);
-        if (config_page) {
+        if (config_page && construct_on_selection) {
+            if (d->config_pages_obs.contains(config_page->objectBase()))
+                continue;
+
+            // Only properties which do not need the page widget are set up here, see constructPage():
+            config_page->objectBase()->setObjectName(config_page->configPageTitle());
+            addPageCategoryProperty(config_page);
+            addPageIconProperty(config_page);
+
+            if (config_page->supportsApply())
+                d->apply_all_pages_visible = true;
+
+            d->config_pages_obs.attachSubject(config_page->objectBase());
+        } else if (config_page) {
             if (config_page->configPageWidget()) {
                 if (d->config_pages_obs.contains(uncategorized_pages.at(i)->objectBase())) {
                     if (config_page->configPageWidget()->size().width() > max_width)
@@ -307,8 +332,11 @@ void Qtilities::CoreGui::ConfigurationWidget::initialize(QList<IConfigPage*> con
 
                 // Set the object name to the page title:
                 config_page->objectBase()->setObjectName(config_page->configPageTitle());
-                if (!initialized_pages.contains(config_page))
+                if (!d->constructed_pages.contains(config_page)) {
+                    StartupProfileScope page_profile_scope(config_page->configPageTitle(),"Configuration Page");
                     config_page->configPageInitialize();
+                    d->constructed_pages.insert(config_page);
+                }
 
                 addPageCategoryProperty(config_page);
                 addPageIconProperty(config_page);
@@ -350,13 +378,30 @@ void Qtilities::CoreGui::ConfigurationWidget::initialize(QList<IConfigPage*> con
                     d->mode_wrappers.append(new ConfigPageModeWrapper(config_page));
                 }
             } else {
-                LOG_DEBUG("Found configuration page \"" + config_page->configPageTitle() + "\" without a valid configuration widget. This page will not be shown.");
+                LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreGuiLogTag,"Found configuration page \"" + config_page->configPageTitle() + "\" without a valid configuration widget. This page will not be shown.");
             }
         }
     }
 
     d->config_pages_obs.endProcessingCycle();
 
+    // Index the titles, categories and keywords of all pages, including pages in grouped pages:
+    d->search_index.clear();
+    d->indexed_pages.clear();
+    for (int i = 0; i < config_pages.count(); ++i) {
+        IConfigPage* config_page = config_pages.at(i);
+        if (!config_page || d->indexed_pages.contains(config_page))
+            continue;
+
+        QStringList words = qti_private_configPageSearchWords(config_page->configPageTitle());
+        words << qti_private_configPageSearchWords(config_page->configPageCategory().toString());
+        words << qti_private_configPageSearchWords(config_page->configPageKeywords().join(" "));
+        words.removeDuplicates();
+        for (int w = 0; w < words.count(); ++w)
+            d->search_index[words.at(w)] << config_page;
+        d->indexed_pages << config_page;
+    }
+
     // Check if the max sizes are bigger than the current size. If so we need to resize:
     int new_width = size().width();
     int new_heigth = size().height();
@@ -411,7 +456,7 @@ void Qtilities::CoreGui::ConfigurationWidget::initialize(QList<QObject*> object_
     if (object_list.isEmpty()) {
         object_list = OBJECT_MANAGER->registeredInterfaces("com.Qtilities.CoreGui.IConfigPage/1.0");
         object_list.append(OBJECT_MANAGER->registeredInterfaces("com.Qtilities.CoreGui.IGroupedConfigPageInfoProvider/1.0"));
-        LOG_DEBUG(QString("%1 config pages and grouped config page info providers page(s) found.").arg(object_list.count()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreGuiLogTag,QString("%1 config pages and grouped config page info providers page(s) found.").arg(object_list.count()));
     }
 
     QList<IConfigPage*> config_ifaces;
@@ -476,6 +521,52 @@ IConfigPage* Qtilities::CoreGui::ConfigurationWidget::getPage(const QString& pag
     return 0;
 }
 
+QList<IConfigPage*> Qtilities::CoreGui::ConfigurationWidget::findPages(const QString& text) const {
+    QStringList words = qti_private_configPageSearchWords(text);
+    if (words.isEmpty())
+        return QList<IConfigPage*>();
+
+    // Every word must be the start of a word of the page:
+    QSet<IConfigPage*> matches;
+    for (int w = 0; w < words.count(); ++w) {
+        QSet<IConfigPage*> word_matches;
+        QMap<QString,QList<IConfigPage*> >::const_iterator itr = d->search_index.lowerBound(words.at(w));
+        while (itr != d->search_index.constEnd() && itr.key().startsWith(words.at(w))) {
+            for (int i = 0; i < itr.value().count(); ++i)
+                word_matches.insert(itr.value().at(i));
+            ++itr;
+        }
+
+        if (w == 0)
+            matches = word_matches;
+        else
+            matches.intersect(word_matches);
+        if (matches.isEmpty())
+            return QList<IConfigPage*>();
+    }
+
+    QList<IConfigPage*> pages;
+    for (int i = 0; i < d->indexed_pages.count(); ++i) {
+        if (matches.contains(d->indexed_pages.at(i)))
+            pages << d->indexed_pages.at(i);
+    }
+    return pages;
+}
+
+bool Qtilities::CoreGui::ConfigurationWidget::isPageConstructed(IConfigPage* config_page) const {
+    if (d->constructed_pages.contains(config_page))
+        return true;
+
+    // Check if its in a grouped config page:
+    for (int i = 0; i < d->config_pages_obs.subjectCount(); ++i) {
+        GroupedConfigPage* grouped_config_page = qobject_cast<GroupedConfigPage*> (d->config_pages_obs.subjectAt(i));
+        if (grouped_config_page && grouped_config_page->isConfigPageConstructed(config_page))
+            return true;
+    }
+
+    return false;
+}
+
 void Qtilities::CoreGui::ConfigurationWidget::setCategorizedTabDisplay(bool enabled, bool use_tab_icons) {
     d->categorized_display = enabled;
     d->categorized_display_use_tab_icons = use_tab_icons;
@@ -522,7 +613,7 @@ void Qtilities::CoreGui::ConfigurationWidget::handleActiveItemChanges(QList<QObj
 
         ui->buttonBox->button(QDialogButtonBox::RestoreDefaults)->setVisible(config_page->supportsRestoreDefaults());
 
-        d->active_widget = config_page->configPageWidget();
+        d->active_widget = constructPage(config_page);
         if (d->display_mode & DisplayLeftItemViews) {
             ui->lblPageHeader->setText(config_page->configPageTitle());
             if (!config_page->configPageIcon().isNull()) {
@@ -593,7 +684,7 @@ void Qtilities::CoreGui::ConfigurationWidget::changeEvent(QEvent *e) {
 
 void Qtilities::CoreGui::ConfigurationWidget::setActivePage(const QString& active_page_name) {
     if (!d->initialized) {
-        LOG_DEBUG(QString("%1 - called before initialize() was called."));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreGuiLogTag,QString("%1 - called before initialize() was called."));
         return;
     }
 
@@ -621,7 +712,7 @@ void Qtilities::CoreGui::ConfigurationWidget::setActivePage(const QString& activ
         }
     }
 
-    LOG_DEBUG("Cannot set active configuration page to \"" + active_page_name + "\". A page with this title does not exist.");
+    LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreGuiLogTag,"Cannot set active configuration page to \"" + active_page_name + "\". A page with this title does not exist.");
 }
 
 QString Qtilities::CoreGui::ConfigurationWidget::activePageName() const {
@@ -657,7 +748,8 @@ void Qtilities::CoreGui::ConfigurationWidget::on_buttonBox_clicked(QAbstractButt
         if (d->apply_all_pages) {
             for (int i = 0; i < d->config_pages_obs.subjectCount(); ++i) {
                 IConfigPage* config_page = qobject_cast<IConfigPage*> (d->config_pages_obs.subjectAt(i));
-                if (config_page){
+                // Pages which were never shown do not have changes to apply:
+                if (config_page && d->constructed_pages.contains(config_page)) {
                     config_page->configPageApply();
                     emit appliedPage(config_page);
                 }
@@ -689,6 +781,23 @@ void Qtilities::CoreGui::ConfigurationWidget::on_buttonBox_clicked(QAbstractButt
     }
 }
 
+QWidget* Qtilities::CoreGui::ConfigurationWidget::constructPage(IConfigPage* config_page) {
+    if (!config_page)
+        return 0;
+
+    if (!d->constructed_pages.contains(config_page)) {
+        d->constructed_pages.insert(config_page);
+        config_page->configPageInitialize();
+
+        // Grow to fit the page, initialize() can only do this for pages constructed up front:
+        QWidget* page_widget = config_page->configPageWidget();
+        if (page_widget && page_widget->sizeHint().width() > size().width())
+            resize(page_widget->sizeHint().width(),size().height());
+    }
+
+    return config_page->configPageWidget();
+}
+
 void Qtilities::CoreGui::ConfigurationWidget::addPageIconProperty(IConfigPage *config_page) {
     if (d->display_mode & DisplayLeftItemViews) {
         if (!config_page)
@@ -161,24 +161,31 @@ if (QtilitiesApplication::configWidget()) {
 
         \sa Qtilities::CoreGui::Interfaces::IConfigPage
 
+        \section configuration_widget_page_construction Page construction
+
+        In the item view display modes (DisplayLeftItemViews), initialize() only adds the pages to the list using their titles, categories and icons.
+        IConfigPage::configPageInitialize() and IConfigPage::configPageWidget() are called when a page is selected for the first time, and pages grouped
+        under tabs (see setCategorizedTabDisplay()) are constructed when their tab is shown for the first time. Thus, opening the widget does not build
+        the widgets of all pages. Pages which were never shown are not applied, since they cannot have changes. In the mode widget display modes all
+        pages are constructed by initialize().
+
+        The titles, categories and keywords (see IConfigPage::configPageKeywords()) of all pages are indexed when initialize() is called, thus pages can be
+        searched using findPages() without constructing them.
+
         \section configuration_widget_storage_layout Configuration settings storage in Qtilities
 
-        Throughout %Qtilities classes store settings using \p QSettings using the QSettings::IniFormat.
+        Throughout %Qtilities classes store settings in an ini file (QSettings::IniFormat) through the Qtilities::Logging::SettingsStore of the file, which keeps the settings
+        in memory and saves changes on a background thread.
 
-        The construction of the QSettings object is done as follows everywhere that settings are saved. This example saves settings of a specific ObserverWidget:
+        Settings are saved as follows everywhere. This example saves settings of a specific ObserverWidget:
 \code
-QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-settings.beginGroup("Qtilities");
-settings.beginGroup("GUI");
-settings.beginGroup(d->global_meta_type);
-// .... Stores some ObserverWidget stuff ...
-settings.endGroup();
-settings.endGroup();
-settings.endGroup();
+SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+settings->setValue(QString("Qtilities/GUI/%1/display_mode").arg(d->global_meta_type),(int) d->display_mode);
+// .... Stores some more ObserverWidget stuff ...
 \endcode
 
         An important difference is that the Logger modulde does not depend on the Core module, thus it does not have access to QtilitiesCoreApplication. However the logger stores the session path
-        it uses as well (see Qtilities::Logging::Logger::setLoggerSessionConfigPath()) and it will save its settings under that path in a file called \p qtilities.ini which by default points to the
+        it uses as well (see Qtilities::Logging::Logger::setLoggerSessionConfigPath()) and it will save its settings under that path in a file called \p qtilities.ini using the settings store of that file, which by default points to the
         same files as the rest of Qtilities. If you however changes the session path used by your application through QtilitiesCoreApplication::setApplicationSessionPath(), the Logger will automatically
         be updated to use the same settings path, thus your settings will all be saved in the same ini file accross all %Qtilities modules. The same counts for disabling settings using
         QtilitiesCoreApplication::setQtilitiesSettingsEnabled().
@@ -243,6 +250,21 @@ settings.endGroup();
             bool hasPage(const QString& page_name) const;
             //! Checks if a configuration page with the given name exists and if so returns a pointer to the interface.
             IConfigPage* getPage(const QString& page_name) const;
+            //! Finds the pages of which the titles, categories or keywords contain words starting with every word in \p text, ignoring case.
+            /*!
+              The pages are found in an index which is built by initialize(), thus pages are not constructed to search them. Pages grouped under
+              tabs are returned themselves, and can be shown by passing their titles to setActivePage().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<IConfigPage*> findPages(const QString& text) const;
+            //! Checks if a configuration page was initialized and its widget created.
+            /*!
+              \sa \ref configuration_widget_page_construction
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool isPageConstructed(IConfigPage* config_page) const;
 
             //! Sets if the configuration widget groups pages with the same categories under tabs in pages named using the name of the category.
             /*!
@@ -291,6 +313,8 @@ settings.endGroup();
             void on_buttonBox_clicked(QAbstractButton *button);
 
         private:
+            //! Initializes a config page and creates its widget the first time it is called for the page, and returns the widget of the page.
+            QWidget* constructPage(IConfigPage* config_page);
             //! Adds icon property to a config page.
             void addPageIconProperty(IConfigPage* config_page);
             //! Adds category property to a config page.
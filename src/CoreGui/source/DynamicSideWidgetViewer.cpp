@@ -16,12 +16,15 @@
 #include "QtilitiesCoreGuiConstants.h"
 
 #include <QBoxLayout>
+#include <QPair>
+#include <QPointer>
 #include <QSplitter>
 #include <QLabel>
 
 struct Qtilities::CoreGui::DynamicSideWidgetViewerPrivateData {
     DynamicSideWidgetViewerPrivateData() : splitter(0),
-    is_exclusive(false) {}
+    is_exclusive(false),
+    widget_cache_limit(3) {}
 
     QSplitter* splitter;
     QMap<QString, ISideViewerWidget*> text_iface_map;
@@ -29,6 +32,9 @@ struct Qtilities::CoreGui::DynamicSideWidgetViewerPrivateData {
     int mode_destination;
     bool is_exclusive;
     QStringList hidden_widgets;
+    //! Managed widgets released by wrappers, with their labels, least recently used first.
+    QList<QPair<QString,QPointer<QWidget> > > widget_cache;
+    int widget_cache_limit;
 };
 
 Qtilities::CoreGui::DynamicSideWidgetViewer::DynamicSideWidgetViewer(int mode_destination, QWidget *parent) :
@@ -55,14 +61,26 @@ Qtilities::CoreGui::DynamicSideWidgetViewer::DynamicSideWidgetViewer(int mode_de
 }
 
 Qtilities::CoreGui::DynamicSideWidgetViewer::~DynamicSideWidgetViewer() {
+    // Wrappers are deleted with the splitter, without touching the cache:
+    for (int i = 0; i < d->active_wrappers.count(); ++i)
+        d->active_wrappers.at(i)->setViewer(0);
+
+    for (int i = 0; i < d->widget_cache.count(); ++i)
+        delete d->widget_cache.at(i).second;
     delete ui;
+    delete d;
 }
 
 void Qtilities::CoreGui::DynamicSideWidgetViewer::setIFaceMap(QMap<QString, ISideViewerWidget*> text_iface_map, bool is_exclusive, const QStringList& widget_order) {
     d->is_exclusive = is_exclusive;
 
-    // Clear previous widgets:
-    d->active_wrappers.clear();;
+    // Clear previous wrappers, their widgets are kept in the cache:
+    for (int i = 0; i < d->active_wrappers.count(); ++i) {
+        d->active_wrappers.at(i)->disconnect(this);
+        d->active_wrappers.at(i)->releaseCurrentWidget();
+        delete d->active_wrappers.at(i);
+    }
+    d->active_wrappers.clear();
     d->text_iface_map.clear();
 
     // Create a filtered list depending on the mode destination:
@@ -79,13 +97,7 @@ void Qtilities::CoreGui::DynamicSideWidgetViewer::setIFaceMap(QMap<QString, ISid
     for (int i = 0; i < widget_order.count(); ++i) {
         QString current_item = widget_order.at(i);
         if (filtered_list.contains(current_item)) {
-            DynamicSideWidgetWrapper* wrapper = new DynamicSideWidgetWrapper(filtered_list,current_item,d->is_exclusive);
-            connect(wrapper,SIGNAL(aboutToBeDestroyed(QWidget*)),SLOT(handleSideWidgetDestroyed(QWidget*)));
-            connect(wrapper,SIGNAL(newSideWidgetRequest()),SLOT(handleNewSideWidgetRequest()));
-            connect(wrapper,SIGNAL(currentTextChanged(QString)),SLOT(updateWrapperComboBoxes()));
-            d->splitter->addWidget(wrapper);
-            d->active_wrappers << wrapper;
-            wrapper->show();
+            addWrapper(filtered_list,current_item);
             filtered_list.remove(current_item);
         }
     }
@@ -94,15 +106,8 @@ void Qtilities::CoreGui::DynamicSideWidgetViewer::setIFaceMap(QMap<QString, ISid
     QMapIterator<QString, ISideViewerWidget*> itr_filtered(filtered_list);
     while (itr_filtered.hasNext()) {
         itr_filtered.next();
-        if (itr_filtered.value()->startupModes().contains(d->mode_destination)) {
-            DynamicSideWidgetWrapper* wrapper = new DynamicSideWidgetWrapper(filtered_list,itr_filtered.key(),d->is_exclusive);
-            connect(wrapper,SIGNAL(aboutToBeDestroyed(QWidget*)),SLOT(handleSideWidgetDestroyed(QWidget*)));
-            connect(wrapper,SIGNAL(newSideWidgetRequest()),SLOT(handleNewSideWidgetRequest()));
-            connect(wrapper,SIGNAL(currentTextChanged(QString)),SLOT(updateWrapperComboBoxes()));
-            d->splitter->addWidget(wrapper);
-            d->active_wrappers << wrapper;
-            wrapper->show();
-        }
+        if (itr_filtered.value()->startupModes().contains(d->mode_destination))
+            addWrapper(filtered_list,itr_filtered.key());
     }
 
     if (d->is_exclusive)
@@ -122,9 +127,12 @@ QList<ISideViewerWidget *> Qtilities::CoreGui::DynamicSideWidgetViewer::sideView
 }
 
 QList<QWidget *> Qtilities::CoreGui::DynamicSideWidgetViewer::sideViewerWidgets() const {
+    // Wrappers which were not shown yet did not produce their widgets:
     QList<QWidget*> widgets;
-    for (int i = 0; i < d->active_wrappers.count(); ++i)
-        widgets << d->active_wrappers.at(i)->currentWidget();
+    for (int i = 0; i < d->active_wrappers.count(); ++i) {
+        if (d->active_wrappers.at(i)->currentWidget())
+            widgets << d->active_wrappers.at(i)->currentWidget();
+    }
     return widgets;
 }
 
@@ -150,6 +158,55 @@ QStringList Qtilities::CoreGui::DynamicSideWidgetViewer::hiddenSideWidgets() con
     return d->hidden_widgets;
 }
 
+void Qtilities::CoreGui::DynamicSideWidgetViewer::setWidgetCacheLimit(int limit) {
+    d->widget_cache_limit = qMax(0,limit);
+    trimWidgetCache();
+}
+
+int Qtilities::CoreGui::DynamicSideWidgetViewer::widgetCacheLimit() const {
+    return d->widget_cache_limit;
+}
+
+Qtilities::CoreGui::DynamicSideWidgetWrapper* Qtilities::CoreGui::DynamicSideWidgetViewer::addWrapper(QMap<QString, ISideViewerWidget*> text_iface_map, const QString& current_text) {
+    DynamicSideWidgetWrapper* wrapper = new DynamicSideWidgetWrapper(text_iface_map,current_text,d->is_exclusive);
+    wrapper->setViewer(this);
+    connect(wrapper,SIGNAL(aboutToBeDestroyed(QWidget*)),SLOT(handleSideWidgetDestroyed(QWidget*)));
+    connect(wrapper,SIGNAL(newSideWidgetRequest()),SLOT(handleNewSideWidgetRequest()));
+    connect(wrapper,SIGNAL(currentTextChanged(QString)),SLOT(updateWrapperComboBoxes(QString)));
+    d->splitter->addWidget(wrapper);
+    d->active_wrappers << wrapper;
+    wrapper->show();
+    return wrapper;
+}
+
+void Qtilities::CoreGui::DynamicSideWidgetViewer::cacheSideWidget(const QString& label, QWidget* widget) {
+    if (!widget)
+        return;
+
+    widget->hide();
+    d->widget_cache << qMakePair(label,QPointer<QWidget>(widget));
+    trimWidgetCache();
+}
+
+QWidget* Qtilities::CoreGui::DynamicSideWidgetViewer::takeCachedSideWidget(const QString& label) {
+    for (int i = d->widget_cache.count() - 1; i >= 0; --i) {
+        if (d->widget_cache.at(i).first != label)
+            continue;
+
+        QPointer<QWidget> widget = d->widget_cache.takeAt(i).second;
+        // Widgets deleted by their owners are skipped:
+        if (widget)
+            return widget;
+    }
+
+    return 0;
+}
+
+void Qtilities::CoreGui::DynamicSideWidgetViewer::trimWidgetCache() {
+    while (d->widget_cache.count() > d->widget_cache_limit)
+        delete d->widget_cache.takeFirst().second;
+}
+
 void Qtilities::CoreGui::DynamicSideWidgetViewer::handleSideWidgetDestroyed(QWidget* widget) {
     DynamicSideWidgetWrapper* wrapper = qobject_cast<DynamicSideWidgetWrapper*> (widget);
     QString wrapper_test = wrapper->currentText();
@@ -157,13 +214,7 @@ void Qtilities::CoreGui::DynamicSideWidgetViewer::handleSideWidgetDestroyed(QWid
         d->active_wrappers.removeOne(wrapper);
         if (d->active_wrappers.count() == 0) {
             // In this case we create the last widget again.
-            DynamicSideWidgetWrapper* wrapper = new DynamicSideWidgetWrapper(d->text_iface_map,wrapper_test,d->is_exclusive);
-            connect(wrapper,SIGNAL(aboutToBeDestroyed(QWidget*)),SLOT(handleSideWidgetDestroyed(QWidget*)));
-            connect(wrapper,SIGNAL(newSideWidgetRequest()),SLOT(handleNewSideWidgetRequest()));
-            connect(wrapper,SIGNAL(currentTextChanged(QString)),SLOT(updateWrapperComboBoxes(QString)));
-            d->splitter->addWidget(wrapper);
-            d->active_wrappers << wrapper;
-            wrapper->show();
+            addWrapper(d->text_iface_map,wrapper_test);
 
             emit toggleVisibility(false);
         } else
@@ -194,13 +245,7 @@ void Qtilities::CoreGui::DynamicSideWidgetViewer::handleNewSideWidgetRequest() {
     } else {
         new_widget_label = d->text_iface_map.keys().at(0);
     }
-    DynamicSideWidgetWrapper* wrapper = new DynamicSideWidgetWrapper(d->text_iface_map,new_widget_label,d->is_exclusive);
-    connect(wrapper,SIGNAL(aboutToBeDestroyed(QWidget*)),SLOT(handleSideWidgetDestroyed(QWidget*)));
-    connect(wrapper,SIGNAL(newSideWidgetRequest()),SLOT(handleNewSideWidgetRequest()));
-    connect(wrapper,SIGNAL(currentTextChanged(QString)),SLOT(updateWrapperComboBoxes(QString)));
-    d->splitter->addWidget(wrapper);
-    d->active_wrappers << wrapper;
-    wrapper->show();
+    addWrapper(d->text_iface_map,new_widget_label);
     updateWrapperComboBoxes();
 }
 
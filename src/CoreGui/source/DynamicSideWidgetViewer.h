@@ -26,6 +26,7 @@ namespace Ui {
 namespace Qtilities {
     namespace CoreGui {
         using namespace Qtilities::CoreGui::Interfaces;
+        class DynamicSideWidgetWrapper;
 
         /*!
           \struct DynamicSideWidgetViewerPrivateData
@@ -36,6 +37,10 @@ namespace Qtilities {
         /*!
         \class DynamicSideWidgetViewer
         \brief The widget which can display dynamic side widgets (widgets implementing the ISideViewerWidget interface).
+
+        Side widgets are only produced when the wrapper showing them becomes visible, thus the side widgets of modes which are never entered are
+        not created. Widgets which are managed by the viewer (see ISideViewerWidget::manageWidgets()) are kept in a least recently used cache
+        when they are replaced or closed, and reused when the same side widget is shown again. See setWidgetCacheLimit().
           */
         class QTILITIES_CORE_GUI_SHARED_EXPORT DynamicSideWidgetViewer : public QWidget {
             Q_OBJECT
@@ -91,6 +96,21 @@ namespace Qtilities {
              */
             QStringList hiddenSideWidgets() const;
 
+            //! Sets the maximum number of managed side widgets which are kept alive after they were replaced or closed.
+            /*!
+             * The least recently used widgets are deleted when the cache is full. When 0, replaced and closed widgets are deleted immediately.
+             *
+             * Default is 3.
+             *
+             * <i>This function  was added in %Qtilities v1.5.</i>
+             */
+            void setWidgetCacheLimit(int limit);
+            //! Gets the maximum number of managed side widgets which are kept alive after they were replaced or closed.
+            /*!
+             * <i>This function  was added in %Qtilities v1.5.</i>
+             */
+            int widgetCacheLimit() const;
+
         public slots:
             //! Handles the deletion of side widgets.
             void handleSideWidgetDestroyed(QWidget* widget);
@@ -113,6 +133,16 @@ namespace Qtilities {
         private:
             //! Gets a QStringList of all active wrapper names.
             QStringList activeWrapperNames() const;
+            //! Creates a wrapper showing \p current_text and adds it to the splitter.
+            DynamicSideWidgetWrapper* addWrapper(QMap<QString, ISideViewerWidget*> text_iface_map, const QString& current_text);
+            //! Adds a managed widget, which was released by a wrapper, to the widget cache.
+            void cacheSideWidget(const QString& label, QWidget* widget);
+            //! Takes the most recently cached widget with \p label from the widget cache. Returns 0 when there is no such widget.
+            QWidget* takeCachedSideWidget(const QString& label);
+            //! Deletes the least recently used cached widgets until the cache is within its limit.
+            void trimWidgetCache();
+
+            friend class DynamicSideWidgetWrapper;
 
             Ui::DynamicSideWidgetViewer *ui;
             DynamicSideWidgetViewerPrivateData* d;
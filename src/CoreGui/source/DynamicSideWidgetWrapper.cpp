@@ -11,6 +11,7 @@
 
 #include "DynamicSideWidgetWrapper.h"
 #include "ui_DynamicSideWidgetWrapper.h"
+#include "DynamicSideWidgetViewer.h"
 #include "ISideViewerWidget.h"
 #include "QtilitiesCoreGuiConstants.h"
 #include "IActionProvider.h"
@@ -29,6 +30,11 @@ struct Qtilities::CoreGui::DynamicSideWidgetWrapperPrivateData {
 
     QComboBox*                          widgetCombo;
     QPointer<QWidget>                   current_widget;
+    //! The label of the current widget.
+    QString                             current_label;
+    //! The label of the widget which must be produced when the wrapper is shown.
+    QString                             pending_text;
+    QPointer<DynamicSideWidgetViewer>   viewer;
     QMap<QString, ISideViewerWidget*>   text_iface_map;
     QList<QAction*>                     viewer_actions;
     bool                                ignore_combo_box_changes;
@@ -69,7 +75,8 @@ Qtilities::CoreGui::DynamicSideWidgetWrapper::DynamicSideWidgetWrapper(QMap<QStr
     // Set before we connect in case the text changes and the index change handler is called twice:
     ui->widgetCombo->setCurrentIndex(index);
     connect(ui->widgetCombo,SIGNAL(currentIndexChanged(QString)),SLOT(handleCurrentIndexChanged(QString)));
-    handleCurrentIndexChanged(current_text);
+    // The widget is produced when the wrapper is shown:
+    d->pending_text = current_text;
     setObjectName(current_text);
 
     //ui->widgetCombo->setStyleSheet(DynamicSideWidgetWrapper::comboBoxStyle());
@@ -136,27 +143,62 @@ QWidget *Qtilities::CoreGui::DynamicSideWidgetWrapper::currentWidget() const {
     return d->current_widget;
 }
 
+void Qtilities::CoreGui::DynamicSideWidgetWrapper::setViewer(DynamicSideWidgetViewer* viewer) {
+    d->viewer = viewer;
+}
+
+void Qtilities::CoreGui::DynamicSideWidgetWrapper::releaseCurrentWidget() {
+    if (!d->current_widget)
+        return;
+
+    // TODO
+//    for (int i = 0; i < d->viewer_actions.count(); ++i)
+//        ui->toolBar->removeAction(d->viewer_actions.at(i));
+
+    d->viewer_actions.clear();
+    QWidget* widget = d->current_widget;
+    d->current_widget = 0;
+    widget->setParent(0);
+
+    // Check if we must delete the current widget:
+    if (d->is_current_widget_managed) {
+        if (d->viewer)
+            d->viewer->cacheSideWidget(d->current_label,widget);
+        else
+            delete widget;
+    }
+
+    if (d->pending_text.isEmpty())
+        d->pending_text = d->current_label;
+}
+
+void Qtilities::CoreGui::DynamicSideWidgetWrapper::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    if (!d->current_widget && !d->pending_text.isEmpty())
+        handleCurrentIndexChanged(d->pending_text);
+}
+
 void Qtilities::CoreGui::DynamicSideWidgetWrapper::handleCurrentIndexChanged(const QString& text) {
     if (d->ignore_combo_box_changes)
         return;
 
     if (d->text_iface_map.contains(text)) {
-        if (d->current_widget) {
-            // TODO
-//            for (int i = 0; i < d->viewer_actions.count(); ++i)
-//                ui->toolBar->removeAction(d->viewer_actions.at(i));
+        releaseCurrentWidget();
 
-            d->viewer_actions.clear();
-            d->current_widget->setParent(0);
-
-            // Check if we must delete the current widget:
-            if (d->text_iface_map[text]->manageWidgets()) {
-                delete d->current_widget;
-            }
+        // Widgets of hidden wrappers are produced when they are shown:
+        if (!isVisible()) {
+            d->pending_text = text;
+            setObjectName(text);
+            return;
         }
+        d->pending_text.clear();
 
         ISideViewerWidget* iface = d->text_iface_map[text];
-        QWidget* widget = iface->produceWidget();
+        QWidget* widget = 0;
+        if (d->viewer && iface->manageWidgets())
+            widget = d->viewer->takeCachedSideWidget(text);
+        if (!widget)
+            widget = iface->produceWidget();
         if (widget) {
             // Check if the viewer widget needs to add actions to the toolbar:
             // TODO
@@ -177,6 +219,7 @@ void Qtilities::CoreGui::DynamicSideWidgetWrapper::handleCurrentIndexChanged(con
             widget->show();
             widget->setEnabled(true);
             d->current_widget = widget;
+            d->current_label = text;
             d->is_current_widget_managed = iface->manageWidgets();
             setObjectName(text);
             emit currentTextChanged(text);
@@ -185,19 +228,25 @@ void Qtilities::CoreGui::DynamicSideWidgetWrapper::handleCurrentIndexChanged(con
 }
 
 void Qtilities::CoreGui::DynamicSideWidgetWrapper::updateAvailableWidgets(QMap<QString, ISideViewerWidget*> text_iface_map) {
-    d->ignore_combo_box_changes = true;
     QString current_text = ui->widgetCombo->currentText();
-    ISideViewerWidget* current_iface = d->text_iface_map[current_text];
-    d->text_iface_map.clear();
-    d->text_iface_map.unite(text_iface_map);
-    d->text_iface_map.insert(current_text,current_iface);
+    text_iface_map.insert(current_text,d->text_iface_map.value(current_text));
+    if (text_iface_map == d->text_iface_map)
+        return;
+
+    d->ignore_combo_box_changes = true;
+    d->text_iface_map = text_iface_map;
+
+    // Update the items incrementally, the items are kept in the sorted order of the map and the current item is never removed:
+    for (int i = ui->widgetCombo->count() - 1; i >= 0; --i) {
+        if (!d->text_iface_map.contains(ui->widgetCombo->itemText(i)))
+            ui->widgetCombo->removeItem(i);
+    }
+    QStringList items = d->text_iface_map.keys();
+    for (int i = 0; i < items.count(); ++i) {
+        if (ui->widgetCombo->itemText(i) != items.at(i))
+            ui->widgetCombo->insertItem(i,items.at(i));
+    }
 
-    ui->widgetCombo->clear();
-    QStringList items;
-    for (int i = 0; i < d->text_iface_map.count(); ++i)
-        items << d->text_iface_map.keys().at(i);
-    ui->widgetCombo->addItems(items);
-    ui->widgetCombo->setCurrentIndex(ui->widgetCombo->findText(current_text));
     refreshNewWidgetAction();
     d->ignore_combo_box_changes = false;
 }
@@ -205,17 +254,13 @@ void Qtilities::CoreGui::DynamicSideWidgetWrapper::updateAvailableWidgets(QMap<Q
 void Qtilities::CoreGui::DynamicSideWidgetWrapper::close() {
     ui->btnClose->setEnabled(false);
     ui->btnNew->setEnabled(false);
-    d->current_widget->setEnabled(false);
+    if (d->current_widget)
+        d->current_widget->setEnabled(false);
 
     emit aboutToBeDestroyed(this);
 
-    // Delete the current widget if we need to manage it:
-    if (d->current_widget) {
-        QString current_text = ui->widgetCombo->currentText();
-        ISideViewerWidget* current_iface = d->text_iface_map[current_text];
-        if (current_iface->manageWidgets())
-            delete d->current_widget;
-    }
+    // Hand the current widget to the viewer's cache, or delete it if we need to manage it:
+    releaseCurrentWidget();
 
     // Delete this object.
     deleteLater();
@@ -26,6 +26,7 @@ namespace Ui {
 namespace Qtilities {
     namespace CoreGui {
         using namespace Qtilities::CoreGui::Interfaces;
+        class DynamicSideWidgetViewer;
 
         /*!
           \struct DynamicSideWidgetWrapperPrivateData
@@ -36,6 +37,10 @@ namespace Qtilities {
         /*!
         \class DynamicSideWidgetWrapper
         \brief A wrapper for side viewer widgets.
+
+        The wrapper only produces the widget selected in its combo box once the wrapper is shown, thus wrappers of modes which are never
+        entered do not create their widgets. When the wrapper belongs to a DynamicSideWidgetViewer (see setViewer()), widgets managed by the
+        wrapper are handed to the widget cache of the viewer when another widget is selected or the wrapper is closed, instead of being deleted.
           */
         class QTILITIES_CORE_GUI_SHARED_EXPORT DynamicSideWidgetWrapper : public QWidget {
             Q_OBJECT
@@ -65,6 +70,20 @@ namespace Qtilities {
              * <i>This function  was added in %Qtilities v1.2.</i>
              */
             QWidget* currentWidget() const;
+            //! Sets the viewer of which the widget cache is used for managed widgets.
+            /*!
+             * \sa DynamicSideWidgetViewer::setWidgetCacheLimit()
+             *
+             * <i>This function  was added in %Qtilities v1.5.</i>
+             */
+            void setViewer(DynamicSideWidgetViewer* viewer);
+            //! Removes the current widget from this wrapper. Managed widgets are handed to the widget cache of the viewer, or deleted when there is no viewer.
+            /*!
+             * The widget is produced again when the wrapper is shown.
+             *
+             * <i>This function  was added in %Qtilities v1.5.</i>
+             */
+            void releaseCurrentWidget();
 
         public slots:
             void handleCurrentIndexChanged(const QString& text);
@@ -80,6 +99,9 @@ namespace Qtilities {
             void newSideWidgetRequest();
             void aboutToBeDestroyed(QWidget* widget);
 
+        protected:
+            void showEvent(QShowEvent* event);
+
         private:
             //! Refreshes the new widget action's state.
             void refreshNewWidgetAction();
@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "FileSystemStatCache_p.h"
+
+#include <QFileInfo>
+#include <QDir>
+#include <QMutexLocker>
+#include <QThread>
+
+using namespace Qtilities::CoreGui;
+
+Q_GLOBAL_STATIC(FileSystemStatCache,fileSystemStatCache)
+
+Qtilities::CoreGui::FileSystemStatCache* Qtilities::CoreGui::FileSystemStatCache::instance() {
+    return fileSystemStatCache();
+}
+
+Qtilities::CoreGui::FileSystemStatCache::FileSystemStatCache() : QObject(),
+    d_generation(0)
+{
+    connect(&d_watcher,SIGNAL(directoryChanged(QString)),SLOT(handleDirectoryChanged(QString)));
+}
+
+bool Qtilities::CoreGui::FileSystemStatCache::exists(const QString& path) {
+    return entry(path).exists;
+}
+
+bool Qtilities::CoreGui::FileSystemStatCache::isDir(const QString& path) {
+    return entry(path).is_dir;
+}
+
+void Qtilities::CoreGui::FileSystemStatCache::invalidate(const QString& path) {
+    if (path.isEmpty())
+        return;
+
+    QString key = QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+    QMutexLocker locker(&d_mutex);
+    d_entries.remove(key);
+    ++d_generation;
+}
+
+Qtilities::CoreGui::FileSystemStatCache::Entry Qtilities::CoreGui::FileSystemStatCache::entry(const QString& path) {
+    Entry result;
+    result.exists = false;
+    result.is_dir = false;
+    if (path.isEmpty())
+        return result;
+
+    QString key = QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+    quint64 generation;
+    {
+        QMutexLocker locker(&d_mutex);
+        QHash<QString,Entry>::const_iterator itr = d_entries.constFind(key);
+        if (itr != d_entries.constEnd())
+            return itr.value();
+        generation = d_generation;
+    }
+
+    // The file system is queried without holding the lock, thus slow file systems do not block other threads:
+    QFileInfo file_info(key);
+    result.exists = file_info.exists();
+    result.is_dir = result.exists && file_info.isDir();
+
+    // The watcher can only be used in our own thread:
+    if (QThread::currentThread() != thread())
+        return result;
+
+    // Only cache the entry when changes to its directory will be reported:
+    QString directory = file_info.absolutePath();
+    QMutexLocker locker(&d_mutex);
+    if (generation != d_generation)
+        return result;
+    if (!d_directory_entries.contains(directory)) {
+        if (d_directory_entries.count() >= max_watched_directories || !QFileInfo(directory).isDir())
+            return result;
+        d_watcher.addPath(directory);
+        if (!d_watcher.directories().contains(directory))
+            return result;
+    }
+
+    d_entries[key] = result;
+    d_directory_entries[directory] << key;
+    return result;
+}
+
+void Qtilities::CoreGui::FileSystemStatCache::handleDirectoryChanged(const QString& path) {
+    QString directory = QDir::cleanPath(path);
+    QMutexLocker locker(&d_mutex);
+    foreach (const QString& key, d_directory_entries.value(directory))
+        d_entries.remove(key);
+    d_directory_entries.remove(directory);
+    ++d_generation;
+    d_watcher.removePath(path);
+    // The directory itself might have been removed or renamed:
+    d_entries.remove(directory);
+}
@@ -0,0 +1,80 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef FILE_SYSTEM_STAT_CACHE_P_H
+#define FILE_SYSTEM_STAT_CACHE_P_H
+
+#include "QtilitiesCoreGui_global.h"
+
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+namespace Qtilities {
+    namespace CoreGui {
+        /*!
+          \class FileSystemStatCache
+          \brief The FileSystemStatCache class caches the existence of files and directories which are queried from the GUI thread.
+
+          Every path which is cached has its parent directory watched using a QFileSystemWatcher. When the platform reports a change
+          in a watched directory, the cached entries in that directory are dropped, thus the file system is only queried again for paths
+          which could have changed. Paths in directories which can't be watched are never cached.
+
+          The cache can be queried from any thread. Paths are only added to the cache, and their directories watched, when they are queried
+          from the thread in which the cache lives, which is the thread in which instance() was first called. Queries from other threads use
+          cached entries when they exist and query the file system otherwise.
+
+          The cache is used by SideWidgetFileSystem. Since changes are only reported after the platform noticed them, callers which create or
+          remove paths themselves must call invalidate() before querying them again.
+         */
+        class QTILITIES_CORE_GUI_SHARED_EXPORT FileSystemStatCache : public QObject {
+            Q_OBJECT
+
+        public:
+            //! Constructs a cache, use instance() to access the cache shared by the application.
+            FileSystemStatCache();
+            static FileSystemStatCache* instance();
+
+            //! Returns true if \p path exists.
+            bool exists(const QString& path);
+            //! Returns true if \p path exists and is a directory.
+            bool isDir(const QString& path);
+            //! Drops the cached entry for \p path, for example after the application created or removed it.
+            void invalidate(const QString& path);
+
+        private slots:
+            void handleDirectoryChanged(const QString& path);
+
+        private:
+            struct Entry {
+                bool exists;
+                bool is_dir;
+            };
+
+            Entry entry(const QString& path);
+
+            //! The maximum number of directories watched by the cache, platforms limit the number of watches per process.
+            static const int max_watched_directories = 256;
+
+            //! Protects d_entries and d_directory_entries, the watcher is only used in the thread of the cache.
+            mutable QMutex                  d_mutex;
+            QFileSystemWatcher              d_watcher;
+            QHash<QString,Entry>            d_entries;
+            QHash<QString,QStringList>      d_directory_entries;
+            //! Incremented whenever entries are dropped, thus entries queried while they were dropped are not cached.
+            quint64                         d_generation;
+        };
+    }
+}
+
+#endif // FILE_SYSTEM_STAT_CACHE_P_H
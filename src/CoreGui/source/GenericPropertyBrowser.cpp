@@ -164,6 +164,7 @@ GenericPropertyBrowser::GenericPropertyBrowser(GenericPropertyManager* property_
     connect(d->generic_property_manager,SIGNAL(propertyPossibleValuesChanged(GenericProperty*)),SLOT(handlePropertyPossibleValuesChanged(GenericProperty*)));
     connect(d->generic_property_manager,SIGNAL(propertyDefaultValueChanged(GenericProperty*)),SLOT(handlePropertyDefaultValueChanged(GenericProperty*)));
     connect(d->generic_property_manager,SIGNAL(propertyNoteChanged(GenericProperty*)),SLOT(handlePropertyNoteChanged(GenericProperty*)));
+    connect(d->generic_property_manager,SIGNAL(propertiesChanged(GenericPropertyManager::PropertyChangeSet)),SLOT(handlePropertiesChanged(GenericPropertyManager::PropertyChangeSet)));
 }
 
 GenericPropertyBrowser::~GenericPropertyBrowser() {
@@ -442,6 +443,37 @@ void GenericPropertyBrowser::handlePropertyNoteChanged(GenericProperty *property
     }
 }
 
+void GenericPropertyBrowser::handlePropertiesChanged(const GenericPropertyManager::PropertyChangeSet& changes) {
+    // Repaint the browser once after all changes were applied:
+    d->property_browser->setUpdatesEnabled(false);
+    GenericPropertyManager::PropertyChangeSet::const_iterator itr = changes.constBegin();
+    while (itr != changes.constEnd()) {
+        GenericProperty* property = itr.key();
+        const GenericPropertyManager::PropertyChanges property_changes = itr.value();
+        ++itr;
+
+        // Properties which are not displayed are skipped:
+        if (!d->property_link_map.contains(property))
+            continue;
+
+        // The possible values are updated before the value since updating them keeps the current value:
+        if (property_changes & GenericPropertyManager::PropertyPossibleValuesChange)
+            handlePropertyPossibleValuesChanged(property);
+        if (property_changes & GenericPropertyManager::PropertyValueChange)
+            handlePropertyValueChanged(property);
+        if (property_changes & (GenericPropertyManager::PropertyEditableChange | GenericPropertyManager::PropertyContextDependentChange))
+            handlePropertyEditableChanged(property);
+        // Value changes update the modified state and tooltip too:
+        if (!(property_changes & GenericPropertyManager::PropertyValueChange)) {
+            if (property_changes & GenericPropertyManager::PropertyDefaultValueChange)
+                handlePropertyDefaultValueChanged(property);
+            else if (property_changes & GenericPropertyManager::PropertyNoteChange)
+                handlePropertyNoteChanged(property);
+        }
+    }
+    d->property_browser->setUpdatesEnabled(true);
+}
+
 void GenericPropertyBrowser::inspectPropertyManager() {
     clear();
 
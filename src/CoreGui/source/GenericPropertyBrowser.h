@@ -103,6 +103,11 @@ namespace Qtilities {
             void handlePropertyDefaultValueChanged(GenericProperty *property);
             //! Function which responds to note changes to displayed properties from the build step side, thus it will update the display.
             void handlePropertyNoteChanged(GenericProperty *property);
+            //! Function which responds to a batch of changes from the build step side, it updates the display once for all changes.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handlePropertiesChanged(const GenericPropertyManager::PropertyChangeSet& changes);
 
         protected:
             //! Gets the tooltip text for a property.
@@ -16,6 +16,10 @@
 #include "QtilitiesCoreGuiConstants.h"
 #include "QMainWindow"
 
+#include <QLabel>
+#include <QSet>
+#include <QVBoxLayout>
+
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::CoreGui::Icons;
 using namespace Qtilities::CoreGui::Interfaces;
@@ -24,7 +28,12 @@ struct Qtilities::CoreGui::GroupedConfigPageData {
     GroupedConfigPageData() : apply_all(false),
       use_tab_icons(false) {}
 
-    QMap<QWidget*,IConfigPage*>     pages;
+    //! The pages in this grouping, in the order they were added.
+    QList<IConfigPage*>             pages;
+    //! The tab holding each page. Tabs hold a placeholder into which the widget of the page is placed when the tab is first shown.
+    QMap<QWidget*,IConfigPage*>     tab_pages;
+    //! The pages which were initialized and of which the widget was placed in its tab.
+    QSet<IConfigPage*>              constructed_pages;
     QStringList                     page_order;
     QtilitiesCategory               category;
     bool                            apply_all;
@@ -53,10 +62,9 @@ QIcon Qtilities::CoreGui::GroupedConfigPage::configPageIcon() const {
         return d->grouping_icon;
 
     // For now use the first IConfigPage icon.
-    QList<IConfigPage*> values = d->pages.values();
     for (int i = 0; i < d->pages.count(); ++i) {
-        if (!values.at(i)->configPageIcon().isNull())
-            return values.at(i)->configPageIcon();
+        if (!d->pages.at(i)->configPageIcon().isNull())
+            return d->pages.at(i)->configPageIcon();
     }
 
     QWidget* main_window = QtilitiesApplication::mainWindow();
@@ -85,26 +93,37 @@ QtilitiesCategory Qtilities::CoreGui::GroupedConfigPage::configPageCategory() co
     return QtilitiesCategory();
 }
 
+QStringList Qtilities::CoreGui::GroupedConfigPage::configPageKeywords() const {
+    // The grouped page is found by the titles and keywords of its pages as well:
+    QStringList keywords;
+    for (int i = 0; i < d->pages.count(); ++i) {
+        keywords << d->pages.at(i)->configPageTitle();
+        keywords << d->pages.at(i)->configPageKeywords();
+    }
+    return keywords;
+}
+
 void Qtilities::CoreGui::GroupedConfigPage::configPageApply() {
     if (d->apply_all) {
-        QList<IConfigPage*> values = d->pages.values();
-        for (int i = 0; i < values.count(); ++i) {
-            values.at(i)->configPageApply();
-            emit appliedPage(values.at(i));
+        // Pages which were never shown do not have changes to apply:
+        for (int i = 0; i < d->pages.count(); ++i) {
+            if (!d->constructed_pages.contains(d->pages.at(i)))
+                continue;
+            d->pages.at(i)->configPageApply();
+            emit appliedPage(d->pages.at(i));
         }
     } else {
         if (activePage()) {
+            activePage()->configPageApply();
             emit appliedPage(activePage());
-            activePage()->supportsApply();
         }
     }
 }
 
 bool Qtilities::CoreGui::GroupedConfigPage::supportsApply() const {
     if (d->apply_all) {
-        QList<IConfigPage*> values = d->pages.values();
-        for (int i = 0; i < values.count(); ++i) {
-            if (values.at(i)->supportsApply()) {
+        for (int i = 0; i < d->pages.count(); ++i) {
+            if (d->pages.at(i)->supportsApply()) {
                 return true;
             }
         }
@@ -122,13 +141,10 @@ void Qtilities::CoreGui::GroupedConfigPage::setPageOrder(const QStringList &page
 }
 
 void Qtilities::CoreGui::GroupedConfigPage::addConfigPage(IConfigPage *page) {
-    if (hasConfigPage(page))
+    if (!page || hasConfigPage(page))
         return;
 
-    if (!page->configPageWidget())
-        return;
-
-    d->pages[page->configPageWidget()] = page;
+    d->pages << page;
 }
 
 void Qtilities::CoreGui::GroupedConfigPage::removeConfigPage(IConfigPage *page) {
@@ -136,33 +152,32 @@ void Qtilities::CoreGui::GroupedConfigPage::removeConfigPage(IConfigPage *page)
         return;
 
     removePageTab(page);
-    d->pages.remove(page->configPageWidget());
+    d->pages.removeOne(page);
+    d->constructed_pages.remove(page);
 }
 
 bool Qtilities::CoreGui::GroupedConfigPage::hasConfigPage(IConfigPage *page) const {
-    return d->pages.values().contains(page);
+    return d->pages.contains(page);
 }
 
 bool Qtilities::CoreGui::GroupedConfigPage::hasConfigPage(const QString &page_title) const {
-    QList<IConfigPage*> values = d->pages.values();
-    for (int i = 0; i < d->pages.count(); ++i) {
-        if (values.at(i)->configPageTitle() == page_title)
-            return true;
-    }
-    return false;
+    return getConfigPage(page_title) != 0;
 }
 
 IConfigPage* Qtilities::CoreGui::GroupedConfigPage::getConfigPage(const QString &page_title) const {
-    QList<IConfigPage*> values = d->pages.values();
-    for (int i = 0; i < values.count(); ++i) {
-        if (values.at(i)->configPageTitle() == page_title)
-            return values.at(i);
+    for (int i = 0; i < d->pages.count(); ++i) {
+        if (d->pages.at(i)->configPageTitle() == page_title)
+            return d->pages.at(i);
     }
     return 0;
 }
 
 void Qtilities::CoreGui::GroupedConfigPage::constructTabWidget() {
-    QList<IConfigPage*> pages_copy = d->pages.values();
+    // Pages which already have tabs (in case this function is called twice) are not added again:
+    QList<IConfigPage*> pages_copy = d->pages;
+    QList<IConfigPage*> tabbed_pages = d->tab_pages.values();
+    for (int i = 0; i < tabbed_pages.count(); ++i)
+        pages_copy.removeOne(tabbed_pages.at(i));
 
     // Add pages for which the order has been specified:
     foreach (const QString& page, d->page_order) {
@@ -182,44 +197,35 @@ void Qtilities::CoreGui::GroupedConfigPage::constructTabWidget() {
 }
 
 IConfigPage *Qtilities::CoreGui::GroupedConfigPage::activePage() const {
-    QWidget* current_widget = ui->groupedTab->currentWidget();
-    return d->pages[current_widget];
+    return d->tab_pages.value(ui->groupedTab->currentWidget());
 }
 
 void Qtilities::CoreGui::GroupedConfigPage::setActivePage(IConfigPage *page) {
-    if (!hasConfigPage(page))
-        return;
-
-    if (page) {
-        if (page->configPageWidget())
-            ui->groupedTab->setCurrentWidget(page->configPageWidget());
-    }
+    int tab_index = findTabIndex(page);
+    if (tab_index != -1)
+        ui->groupedTab->setCurrentIndex(tab_index);
 }
 
 void Qtilities::CoreGui::GroupedConfigPage::setActivePage(const QString& page_title) {
-    if (!hasConfigPage(page_title))
-        return;
-
-    IConfigPage* page = getConfigPage(page_title);
-    if (page) {
-        if (page->configPageWidget())
-            ui->groupedTab->setCurrentWidget(page->configPageWidget());
-    }
+    setActivePage(getConfigPage(page_title));
 }
 
 QList<IConfigPage *> Qtilities::CoreGui::GroupedConfigPage::configPages() const {
-    return d->pages.values();
+    return d->pages;
 }
 
 QStringList Qtilities::CoreGui::GroupedConfigPage::configPageNames() const {
     QStringList names;
-    QList<IConfigPage*> values = d->pages.values();
     for (int i = 0; i < d->pages.count(); ++i) {
-        names << values.at(i)->configPageTitle();
+        names << d->pages.at(i)->configPageTitle();
     }
     return names;
 }
 
+bool Qtilities::CoreGui::GroupedConfigPage::isConfigPageConstructed(IConfigPage* page) const {
+    return d->constructed_pages.contains(page);
+}
+
 QtilitiesCategory Qtilities::CoreGui::GroupedConfigPage::category() const {
     return d->category;
 }
@@ -233,42 +239,77 @@ void Qtilities::CoreGui::GroupedConfigPage::setUseTabIcons(bool use_tab_icons) {
 }
 
 void Qtilities::CoreGui::GroupedConfigPage::addPageTab(IConfigPage *page) {
+    QWidget* placeholder = new QWidget;
+    QVBoxLayout* layout = new QVBoxLayout(placeholder);
+    layout->setMargin(0);
+    d->tab_pages[placeholder] = page;
+
     if (d->use_tab_icons)
-        ui->groupedTab->addTab(page->configPageWidget(),page->configPageIcon(),page->configPageTitle());
+        ui->groupedTab->addTab(placeholder,page->configPageIcon(),page->configPageTitle());
     else
-        ui->groupedTab->addTab(page->configPageWidget(),QIcon(),page->configPageTitle());
+        ui->groupedTab->addTab(placeholder,QIcon(),page->configPageTitle());
 }
 
 void Qtilities::CoreGui::GroupedConfigPage::removePageTab(IConfigPage *page) {
-    // Find the tab inx
-    ui->groupedTab->removeTab(findTabIndex(page));
+    int tab_index = findTabIndex(page);
+    if (tab_index == -1)
+        return;
+
+    QWidget* placeholder = ui->groupedTab->widget(tab_index);
+    ui->groupedTab->removeTab(tab_index);
+    d->tab_pages.remove(placeholder);
+
+    // The page owns its widget, thus it is taken out of the placeholder before the placeholder is deleted:
+    if (d->constructed_pages.contains(page) && page->configPageWidget())
+        page->configPageWidget()->setParent(0);
+    delete placeholder;
 }
 
 int Qtilities::CoreGui::GroupedConfigPage::findTabIndex(IConfigPage *page) {
-    if (!hasConfigPage(page))
+    if (!page)
         return -1;
 
-    if (page)
+    QWidget* placeholder = d->tab_pages.key(page);
+    if (!placeholder)
         return -1;
 
-    if (page->configPageWidget())
-        return -1;
+    return ui->groupedTab->indexOf(placeholder);
+}
 
-    for (int i = 0; i < ui->groupedTab->count(); ++i) {
-        if (ui->groupedTab->widget(i) == page->configPageWidget())
-            return i;
-    }
+void Qtilities::CoreGui::GroupedConfigPage::constructPage(IConfigPage* page) {
+    if (!page || d->constructed_pages.contains(page))
+        return;
+
+    QWidget* placeholder = d->tab_pages.key(page);
+    if (!placeholder)
+        return;
 
-    return -1;
+    d->constructed_pages.insert(page);
+    page->configPageInitialize();
+    QWidget* page_widget = page->configPageWidget();
+    if (page_widget) {
+        placeholder->layout()->addWidget(page_widget);
+        page_widget->show();
+    } else
+        placeholder->layout()->addWidget(new QLabel(tr("Configuration page \"%1\" does not have a valid configuration widget.").arg(page->configPageTitle())));
 }
 
 bool Qtilities::CoreGui::GroupedConfigPage::useTabIcons() const {
     return d->use_tab_icons;
 }
 
+void Qtilities::CoreGui::GroupedConfigPage::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    constructPage(activePage());
+}
+
 void Qtilities::CoreGui::GroupedConfigPage::handleCurrentPageChanged(int new_index) {
     QWidget* widget = ui->groupedTab->widget(new_index);
+    if (!d->tab_pages.contains(widget))
+        return;
 
-    if (d->pages.contains(widget))
-        emit activeGroupedPageChanged(d->pages[widget]);
+    // Tabs become current while the grouped page is constructed as well, those pages are only constructed when the grouped page is shown:
+    if (isVisible())
+        constructPage(d->tab_pages[widget]);
+    emit activeGroupedPageChanged(d->tab_pages[widget]);
 }
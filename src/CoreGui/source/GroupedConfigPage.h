@@ -34,6 +34,9 @@ namespace Qtilities {
         \class GroupedConfigPage
         \brief A config page which groups other IConfigPage pages using tabs.
 
+        The grouped pages are only initialized, and their widgets only created, when their tabs are shown for the first time. Pages which were never shown
+        are not applied, since they cannot have changes.
+
         <i>This class was added in %Qtilities v1.1.</i>
           */
         class QTILITIES_CORE_GUI_SHARED_EXPORT GroupedConfigPage : public QWidget, public IConfigPage
@@ -53,6 +56,7 @@ namespace Qtilities {
             QWidget* configPageWidget();
             QtilitiesCategory configPageCategory() const;
             QString configPageTitle() const;
+            QStringList configPageKeywords() const;
             void configPageApply();
             bool supportsApply() const;
 
@@ -91,6 +95,11 @@ namespace Qtilities {
             QList<IConfigPage*> configPages() const;
             //! Returns a list of names of all config pages in this grouping.
             QStringList configPageNames() const;
+            //! Checks if the widget of a page in this grouping was created, which happens when its tab is shown for the first time.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool isConfigPageConstructed(IConfigPage* page) const;
 
             //! Returns the category of this grouped page.
             QtilitiesCategory category() const;
@@ -112,11 +121,16 @@ namespace Qtilities {
              //! Signal emitted whenever the active config page in the group changes.
              void activeGroupedPageChanged(IConfigPage* config_page);
 
+        protected:
+            void showEvent(QShowEvent* event);
+
         private slots:
              //! Slots which responds to changes to the active tab in the grouped tab widget.
              void handleCurrentPageChanged(int new_index);
 
         private:
+            //! Initializes a page and places its widget in its tab, if this was not done yet.
+            void constructPage(IConfigPage* page);
             //! Creates a tab for a given page.
             void addPageTab(IConfigPage* page);
             //! Removes a tab for a given page.
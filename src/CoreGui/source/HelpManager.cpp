@@ -19,18 +19,72 @@ using namespace QtilitiesCoreGui;
 
 #include <QHelpEngine>
 #include <QHelpSearchEngine>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSettings>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+#include <QStandardPaths>
+#endif
 
 using namespace Qtilities::CoreGui;
 
+namespace {
+    //! The version of the persistent help collection, changing it discards collections created by earlier versions.
+    const int qti_private_HELP_COLLECTION_VERSION = 1;
+
+    //! The registration of a file in the persistent help collection.
+    struct qti_private_HelpRegistration {
+        //! The signature of the file when it was registered, see qti_private_HelpFileSignature().
+        QString signature;
+        QString namespace_name;
+        //! The copy registered for files in the Qt Resource System, empty for other files.
+        QString local_copy;
+    };
+
+    //! Returns the directory in which the help collection and local copies of documentation are kept.
+    QString qti_private_HelpCachePath() {
+        #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
+        QString cache_path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        #else
+        QString cache_path = QDesktopServices::storageLocation(QDesktopServices::CacheLocation);
+        #endif
+        if (cache_path.isEmpty())
+            cache_path = QDir::tempPath();
+        return QDir::cleanPath(cache_path + "/help");
+    }
+
+    //! Returns a signature which changes when the contents of \p file_name changes.
+    QString qti_private_HelpFileSignature(const QString& file_name) {
+        // Files in the Qt Resource System do not have modification times:
+        if (file_name.startsWith(QLatin1Char(':'))) {
+            QFile file(file_name);
+            if (!file.open(QFile::ReadOnly))
+                return QString();
+            return QString(QCryptographicHash::hash(file.readAll(),QCryptographicHash::Md5).toHex());
+        }
+
+        QFileInfo file_info(file_name);
+        if (!file_info.exists())
+            return QString();
+        return QString("%1-%2").arg(file_info.size()).arg(file_info.lastModified().toString(Qt::ISODate));
+    }
+}
+
 struct Qtilities::CoreGui::HelpManagerPrivateData {
-    HelpManagerPrivateData() { }
+    HelpManagerPrivateData() : setup_queued(false),
+        reindex_required(false) { }
 
     QPointer<QHelpEngine>   helpEngine;
     QStringList             registered_files_session;
     QStringList             registered_files;
     QPointer<Task>          setup_task;
     QPointer<Task>          indexing_task;
+    //! Maps registered files to their namespaces in the help collection.
     QMap<QString,QString>   file_namespace_map;
+    bool                    setup_queued;
+    //! Set when documentation was registered again after its file changed, the search index does not notice such changes.
+    bool                    reindex_required;
 
     // Settings
     QUrl                    home_page;
@@ -55,11 +109,11 @@ QHelpEngine* HelpManager::helpEngine()  {
 
 void HelpManager::initialize() {
     if (!d->helpEngine) {
-        QTemporaryFile temp_file;
-        temp_file.open();
-
-        // Delete the current help collection file:
-        d->helpEngine = new QHelpEngine(temp_file.fileName(),this);
+        // The collection is kept between sessions, thus only documentation which changed must be registered and indexed again:
+        QString cache_path = qti_private_HelpCachePath();
+        QDir().mkpath(cache_path);
+        QString collection_file = QString("%1/qtilities_help_v%2.qhc").arg(cache_path).arg(qti_private_HELP_COLLECTION_VERSION);
+        d->helpEngine = new QHelpEngine(collection_file,this);
         connect(d->helpEngine,SIGNAL(warning(QString)),SLOT(logMessage(QString)));
 
         readSettings(false);
@@ -74,42 +128,35 @@ void HelpManager::initialize() {
         connect(d->helpEngine,SIGNAL(setupFinished()),d->setup_task,SLOT(completeTask()));
     }
 
-    if (!d->helpEngine->setupData())
-        LOG_ERROR(tr("Failed to setup the help engine. Error: ") + d->helpEngine->error());
-
-    // Unregister everything here. All files in d->registered_files will be registered again.
-    unregisterAllNamespaces();
-
-    foreach (const QString& registered_file, d->registered_files) {
-        QString filename = registered_file;
-
-        QFile file(filename);
-        if (file.open(QFile::ReadOnly)) {
-            QTemporaryFile *temp_file = QTemporaryFile::createLocalFile(file);
-            if (temp_file) {
-                filename = temp_file->fileName();
-                temp_file->setParent(this);
-                temp_file->setAutoRemove(true);
-            }
-        }
-
-        if (!d->helpEngine->registerDocumentation(filename))
-            LOG_ERROR(tr("Failed to register documentation from file: ") + registered_file + tr(". Error: ") + d->helpEngine->error());
-        else {
-            QString namespace_name = d->helpEngine->namespaceName(filename);
-            d->file_namespace_map[filename] = namespace_name;
-            LOG_INFO(tr("Successfully registered documentation from file: ") + registered_file + tr(" using namespace ") + namespace_name);
-        }
-    }
-
-    // Search engine indexing:
+    // Search engine indexing. The search engine indexes documentation which is not indexed yet every time the engine is set up:
     if (!d->indexing_task) {
         d->indexing_task = new Task("Indexing Documentation");
         OBJECT_MANAGER->registerObject(d->indexing_task);
         connect(d->helpEngine->searchEngine(),SIGNAL(indexingStarted()),d->indexing_task,SLOT(startTask()));
         connect(d->helpEngine->searchEngine(),SIGNAL(indexingFinished()),d->indexing_task,SLOT(completeTask()));
     }
-    d->helpEngine->searchEngine()->reindexDocumentation();
+
+    synchronizeCollection();
+
+    // Setting up the engine reads all registered documentation, thus it is done once control returns to the event loop:
+    if (!d->setup_queued) {
+        d->setup_queued = true;
+        QMetaObject::invokeMethod(this,"setupHelpEngine",Qt::QueuedConnection);
+    }
+}
+
+void HelpManager::setupHelpEngine() {
+    d->setup_queued = false;
+    if (!d->helpEngine)
+        return;
+
+    if (!d->helpEngine->setupData())
+        LOG_ERROR(tr("Failed to setup the help engine. Error: ") + d->helpEngine->error());
+
+    if (d->reindex_required) {
+        d->reindex_required = false;
+        d->helpEngine->searchEngine()->reindexDocumentation();
+    }
 }
 
 void HelpManager::setHomePage(const QUrl& home_page) {
@@ -131,16 +178,99 @@ void HelpManager::clearRegisteredFiles(bool initialize_after_change) {
     emit registeredFilesChanged(d->registered_files);
 }
 
-void HelpManager::unregisterAllNamespaces() {
-    foreach (const QString& namespace_name, d->file_namespace_map.values()) {
-        if (!d->helpEngine->unregisterDocumentation(namespace_name))
-            LOG_ERROR(tr("Failed to unregister namespace from help engine: ") + namespace_name + tr(". Error: ") + d->helpEngine->error());
-        else {
-            LOG_INFO(tr("Successfully unregistered namespace from help engine: ") + namespace_name);
+void HelpManager::synchronizeCollection() {
+    // The registrations made in previous sessions are kept next to the collection file:
+    QSettings registrations(d->helpEngine->collectionFile() + ".ini",QSettings::IniFormat);
+    QMap<QString,qti_private_HelpRegistration> previous_registrations;
+    int count = registrations.beginReadArray("registrations");
+    for (int i = 0; i < count; ++i) {
+        registrations.setArrayIndex(i);
+        qti_private_HelpRegistration registration;
+        registration.signature = registrations.value("signature").toString();
+        registration.namespace_name = registrations.value("namespace").toString();
+        registration.local_copy = registrations.value("local_copy").toString();
+        previous_registrations[registrations.value("file").toString()] = registration;
+    }
+    registrations.endArray();
+
+    // Unregister documentation which is no longer registered, or of which the file changed:
+    QMap<QString,qti_private_HelpRegistration> current_registrations;
+    QMapIterator<QString,qti_private_HelpRegistration> itr(previous_registrations);
+    while (itr.hasNext()) {
+        itr.next();
+        const bool is_registered = d->registered_files.contains(itr.key());
+        if (is_registered && !itr.value().signature.isEmpty() && qti_private_HelpFileSignature(itr.key()) == itr.value().signature) {
+            current_registrations[itr.key()] = itr.value();
+            continue;
+        }
+
+        if (!d->helpEngine->unregisterDocumentation(itr.value().namespace_name))
+            LOG_ERROR(tr("Failed to unregister namespace from help engine: ") + itr.value().namespace_name + tr(". Error: ") + d->helpEngine->error());
+        else
+            LOG_INFO(tr("Successfully unregistered namespace from help engine: ") + itr.value().namespace_name);
+        if (!itr.value().local_copy.isEmpty())
+            QFile::remove(itr.value().local_copy);
+        if (is_registered)
+            d->reindex_required = true;
+    }
+
+    // Register documentation which was added, or of which the file changed:
+    foreach (const QString& registered_file, d->registered_files) {
+        if (current_registrations.contains(registered_file))
+            continue;
+
+        qti_private_HelpRegistration registration;
+        registration.signature = qti_private_HelpFileSignature(registered_file);
+        QString filename = registered_file;
+
+        // Files in the Qt Resource System are registered through a local copy:
+        if (registered_file.startsWith(QLatin1Char(':'))) {
+            QByteArray file_hash = QCryptographicHash::hash(registered_file.toUtf8(),QCryptographicHash::Md5).toHex();
+            registration.local_copy = QString("%1/%2.qch").arg(QFileInfo(d->helpEngine->collectionFile()).absolutePath()).arg(QString(file_hash));
+            QFile::remove(registration.local_copy);
+            if (!QFile::copy(registered_file,registration.local_copy)) {
+                LOG_ERROR(tr("Failed to register documentation from file: ") + registered_file + tr(". Error: A local copy could not be created at ") + registration.local_copy);
+                continue;
+            }
+            // Copies of resources are read only:
+            QFile::setPermissions(registration.local_copy,QFile::ReadOwner | QFile::WriteOwner);
+            filename = registration.local_copy;
+        }
+
+        registration.namespace_name = QHelpEngineCore::namespaceName(filename);
+        bool success = d->helpEngine->registerDocumentation(filename);
+        if (!success && !registration.namespace_name.isEmpty()) {
+            // The namespace might still be registered when the registrations file was lost:
+            d->helpEngine->unregisterDocumentation(registration.namespace_name);
+            success = d->helpEngine->registerDocumentation(filename);
         }
+
+        if (!success) {
+            LOG_ERROR(tr("Failed to register documentation from file: ") + registered_file + tr(". Error: ") + d->helpEngine->error());
+            if (!registration.local_copy.isEmpty())
+                QFile::remove(registration.local_copy);
+            continue;
+        }
+
+        LOG_INFO(tr("Successfully registered documentation from file: ") + registered_file + tr(" using namespace ") + registration.namespace_name);
+        current_registrations[registered_file] = registration;
     }
 
+    registrations.remove("registrations");
+    registrations.beginWriteArray("registrations",current_registrations.count());
     d->file_namespace_map.clear();
+    int index = 0;
+    QMapIterator<QString,qti_private_HelpRegistration> current_itr(current_registrations);
+    while (current_itr.hasNext()) {
+        current_itr.next();
+        registrations.setArrayIndex(index++);
+        registrations.setValue("file",current_itr.key());
+        registrations.setValue("signature",current_itr.value().signature);
+        registrations.setValue("namespace",current_itr.value().namespace_name);
+        registrations.setValue("local_copy",current_itr.value().local_copy);
+        d->file_namespace_map[current_itr.key()] = current_itr.value().namespace_name;
+    }
+    registrations.endArray();
 }
 
 void HelpManager::registerFiles(const QStringList &files, bool initialize_after_change) {
@@ -204,24 +334,15 @@ void Qtilities::CoreGui::HelpManager::logMessage(const QString& message) {
 }
 
 void Qtilities::CoreGui::HelpManager::readSettings(bool initialize_after_change) {
-    QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("Help");
-    registerFiles(settings.value("registered_files").toStringList(),initialize_after_change);
-    settings.endGroup();
-    settings.endGroup();
+    SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+    registerFiles(settings->value("Qtilities/Help/registered_files").toStringList(),initialize_after_change);
 }
 
 void Qtilities::CoreGui::HelpManager::writeSettings() {
     if (!QtilitiesCoreApplication::qtilitiesSettingsEnabled())
         return;
 
-    QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("Help");
-    settings.setValue("registered_files",d->registered_files);
-    settings.endGroup();
-    settings.endGroup();
+    QtilitiesCoreApplication::qtilitiesSettings()->setValue("Qtilities/Help/registered_files",d->registered_files);
 }
 
 QString Qtilities::CoreGui::HelpManager::formatFileName(const QString &file_name) {
@@ -57,7 +57,11 @@ HELP_MANAGER->helpEngine();
         files you want to show through registerFile(), registerFiles(), clearRegisteredFiles(), unregisterFile() and unregisterFiles(). After you have registered and unregistered the files you want,
         you can call initialize() again which will set up and index the help system for the registered files found through registeredFiles().
 
-        When registering files from the Qt Resource System the help manager will automatically create temporary local copies of the files to register, thus you don't need to worry about that.
+        When registering files from the Qt Resource System the help manager will automatically create local copies of the files to register, thus you don't need to worry about that.
+
+        The help collection and its search index are kept between sessions in the \p help directory of the user's cache location. Files which did not change
+        since the previous session are not registered again, and only documentation which was added or changed is indexed. Thus the contents, index and
+        search widgets of the help engine can be used directly after startup.
 
         The Qtilities::Plugins::Help plugin provides a ready to use GUI frontend for the help system which allows you to view the contents of all help files, view an index or search the documentation:
 
@@ -92,6 +96,9 @@ bool MyPlugins::initializeDependencies(QStringList *error_strings) {
             //! Initializes the help engine.
             /*!
               Initialize will set up the internal help engine and start indexing of all documentation registered in the manager.
+
+              Documentation in the persistent help collection is only registered again when its file changed. The help engine's data is set up
+              when control returns to the event loop, which starts the indexing of documentation which is not indexed yet.
               */
             void initialize();
 
@@ -148,6 +155,8 @@ bool MyPlugins::initializeDependencies(QStringList *error_strings) {
         private slots:
             //! Logs warning messages from the help engine in the logger.
             void logMessage(const QString& message);
+            //! Sets up the data of the help engine, queued by initialize().
+            void setupHelpEngine();
 
         signals:
             //! Signal which is emitted when the files registered in the engine is changed.
@@ -161,8 +170,8 @@ bool MyPlugins::initializeDependencies(QStringList *error_strings) {
             void homePageChanged(const QUrl& url);
 
         private:
-            //! Unregister all files.
-            void unregisterAllNamespaces();
+            //! Brings the documentation registered in the help collection in line with registeredFiles().
+            void synchronizeCollection();
 
             HelpManagerPrivateData* d;
         };
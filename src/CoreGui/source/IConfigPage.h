@@ -19,6 +19,7 @@
 
 #include <QObject>
 #include <QIcon>
+#include <QStringList>
 
 using namespace Qtilities::Core;
 using namespace Qtilities::Core::Interfaces;
@@ -110,6 +111,15 @@ else
                 }
                 //! Gets the title of the config page.
                 virtual QString configPageTitle() const = 0;
+                //! Gets keywords which find the config page when searching pages, in addition to its title and category.
+                /*!
+                  Keywords should be cheap to return, since they are indexed by ConfigurationWidget::findPages() before the page is initialized.
+
+                  \note The default implementation returns an empty list.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual QStringList configPageKeywords() const { return QStringList(); }
                 //! Indicates that the current state of the config page must be saved (applied).
                 virtual void configPageApply() = 0;
                 //! Indicates if the page supports apply operations. When a page only displays information, ExtensionSystemConfig, we don't want the apply button to be active. This function thus controls the activity of the apply button.
@@ -134,14 +144,16 @@ else
                 virtual bool supportsRestoreDefaults() const { return false; }
                 //! Initialization function where you can do any initialization required by your page.
                 /*!
-                 * This function will be called when the configuration widget searches the object pool for config pages.
-                 * The function will be called on all found pages before adding them to the configuration widget.
+                 * This function will be called by the configuration widget before configPageWidget() is called for the first time. In
+                 * ConfigurationWidget::DisplayLeftItemViews display modes this happens when the page is selected for the first time, and when the
+                 * page is a tab in a GroupedConfigPage when its tab is shown for the first time. In other display modes it is called when the
+                 * configuration widget is initialized.
                  *
                  * In big applications where many configuration pages exists, it makes sense to make use of this function in order
                  * to speed up the launch time of your application. Without this function, you will typically initialize your config
                  * pages in their constructors. Thus, all the pages will be set up during application launch even if the user
                  * never goes to the configuration page. This function provides a solution to that problem where pages will only be
-                 * initialized when the configuration widget is actually used.
+                 * initialized when they are actually shown, thus pages should create their widgets here or in configPageWidget().
                  *
                  *\note The default implementation does nothing.
                  *
@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "LargeTextFile_p.h"
+
+#include <QFile>
+#include <QFileInfo>
+
+#include <string.h>
+
+namespace {
+    //! The number of bytes read at a time while building the index.
+    const qint64 LARGE_TEXT_FILE_INDEX_BLOCK_SIZE = 4 * 1024 * 1024;
+    //! The number of bytes read at a time while looking for lines which are not in the index.
+    const qint64 LARGE_TEXT_FILE_SCAN_BLOCK_SIZE = 64 * 1024;
+}
+
+Qtilities::CoreGui::LargeTextFile::LargeTextFile(const QString& file_name) :
+    d_file_name(file_name),
+    d_size(0),
+    d_line_count(0)
+{
+}
+
+bool Qtilities::CoreGui::LargeTextFile::open() {
+    QFile file(d_file_name);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    d_size = file.size();
+    d_last_modified = QFileInfo(d_file_name).lastModified();
+    d_line_index.clear();
+    d_line_index.append(0);
+    d_line_count = 1;
+
+    qint64 position = 0;
+    while (position < d_size) {
+        QByteArray buffer = file.read(qMin(LARGE_TEXT_FILE_INDEX_BLOCK_SIZE,d_size - position));
+        if (buffer.isEmpty()) {
+            // The file was truncated while we read it:
+            d_size = position;
+            break;
+        }
+
+        const char* begin = buffer.constData();
+        const char* end = begin + buffer.size();
+        const char* pos = begin;
+        while ((pos = (const char*) memchr(pos,'\n',end - pos)) != 0) {
+            ++pos;
+            qint64 line_start = position + (pos - begin);
+            if (line_start < d_size) {
+                if (d_line_count % line_index_interval == 0)
+                    d_line_index.append(line_start);
+                ++d_line_count;
+            }
+        }
+        position += buffer.size();
+    }
+    return true;
+}
+
+QString Qtilities::CoreGui::LargeTextFile::fileName() const {
+    return d_file_name;
+}
+
+qint64 Qtilities::CoreGui::LargeTextFile::size() const {
+    return d_size;
+}
+
+bool Qtilities::CoreGui::LargeTextFile::hasChanged() const {
+    QFileInfo file_info(d_file_name);
+    return !file_info.exists() || file_info.size() != d_size || file_info.lastModified() != d_last_modified;
+}
+
+int Qtilities::CoreGui::LargeTextFile::lineCount() const {
+    return d_line_count;
+}
+
+qint64 Qtilities::CoreGui::LargeTextFile::lineStart(int line) const {
+    if (line <= 0)
+        return 0;
+    if (line >= d_line_count)
+        return d_size;
+
+    qint64 position = d_line_index.at(line / line_index_interval);
+    int remaining = line % line_index_interval;
+    if (remaining == 0)
+        return position;
+
+    // Read forward from the closest indexed line:
+    QFile file(d_file_name);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(position))
+        return d_size;
+    while (remaining > 0) {
+        QByteArray buffer = file.read(LARGE_TEXT_FILE_SCAN_BLOCK_SIZE);
+        if (buffer.isEmpty())
+            return d_size;
+
+        const char* begin = buffer.constData();
+        const char* end = begin + buffer.size();
+        const char* pos = begin;
+        while ((pos = (const char*) memchr(pos,'\n',end - pos)) != 0) {
+            ++pos;
+            if (--remaining == 0)
+                return qMin(d_size,position + (pos - begin));
+        }
+        position += buffer.size();
+    }
+    return d_size;
+}
+
+QString Qtilities::CoreGui::LargeTextFile::text(int first_line, int end_line) const {
+    qint64 start = lineStart(first_line);
+    qint64 end = lineStart(end_line);
+    if (end <= start)
+        return QString();
+
+    QByteArray data = read(start,end - start);
+    QString result = QString::fromUtf8(data.constData(),data.size());
+    result.remove(QLatin1Char('\r'));
+    return result;
+}
+
+QByteArray Qtilities::CoreGui::LargeTextFile::read(qint64 position, qint64 max_size) const {
+    QFile file(d_file_name);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(position))
+        return QByteArray();
+    return file.read(max_size);
+}
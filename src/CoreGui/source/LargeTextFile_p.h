@@ -0,0 +1,71 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef LARGE_TEXT_FILE_P_H
+#define LARGE_TEXT_FILE_P_H
+
+#include "QtilitiesCoreGui_global.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QString>
+#include <QVector>
+
+namespace Qtilities {
+    namespace CoreGui {
+        /*!
+          \class LargeTextFile
+          \brief The LargeTextFile class provides access to the lines of a text file which is too large to be loaded completely.
+
+          When the file is opened, an index is built containing the offset of every line_index_interval'th line. The offsets of
+          other lines are found by reading forward from the closest indexed line, thus the index stays small for files with many
+          lines. The file is read in blocks and never memory mapped, therefore the file can be truncated or replaced while it is
+          used: reads then return less data, and hasChanged() indicates that the file must be opened again.
+
+          The index is not changed after open() succeeded and every read uses its own file handle. Thus a LargeTextFile can be
+          read from multiple threads at the same time. It is used by CodeEditorWidget in large file mode.
+         */
+        class QTILITIES_CORE_GUI_SHARED_EXPORT LargeTextFile {
+        public:
+            LargeTextFile(const QString& file_name);
+
+            //! Reads the file and builds the line index, returns false when the file could not be read.
+            bool open();
+            QString fileName() const;
+            //! The size of the file when it was opened.
+            qint64 size() const;
+            //! Returns true when the size or modification time of the file differs from when it was opened.
+            bool hasChanged() const;
+
+            //! The number of lines in the file. A newline at the end of the file does not start a new line.
+            int lineCount() const;
+            //! The offset at which \p line starts, size() for lines after the last line.
+            qint64 lineStart(int line) const;
+            //! Returns the text of the lines from \p first_line up to, but excluding, \p end_line without carriage returns.
+            QString text(int first_line, int end_line) const;
+            //! Reads up to \p max_size bytes from \p position. Less data is returned when the file was truncated.
+            QByteArray read(qint64 position, qint64 max_size) const;
+
+            //! The number of lines between the lines of which the offsets are stored in the index.
+            static const int line_index_interval = 64;
+
+        private:
+            QString             d_file_name;
+            qint64              d_size;
+            QDateTime           d_last_modified;
+            int                 d_line_count;
+            //! The offsets of lines 0, line_index_interval, 2 * line_index_interval, etc.
+            QVector<qint64>     d_line_index;
+        };
+    }
+}
+
+#endif // LARGE_TEXT_FILE_P_H
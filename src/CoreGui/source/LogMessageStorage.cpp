@@ -0,0 +1,385 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "LogMessageStorage.h"
+
+#include <QReadWriteLock>
+#include <QVector>
+
+namespace Qtilities {
+    namespace CoreGui {
+        // A chunk of messages in a LogMessageStorage.
+        struct LogMessageStorageChunk {
+            //! The UTF-8 encoded text of all messages in the chunk.
+            QByteArray          text;
+            //! The offset of each message in text.
+            QVector<int>        offsets;
+            //! The Logger::MessageType of each message.
+            QVector<quint8>     types;
+            //! The font color of each message, 0 when no color was specified.
+            QVector<QRgb>       colors;
+
+            inline int count() const { return offsets.count(); }
+            inline const char* lineStart(int i) const { return text.constData() + offsets.at(i); }
+            inline int lineLength(int i) const { return (i + 1 < offsets.count() ? offsets.at(i + 1) : text.size()) - offsets.at(i); }
+        };
+    }
+}
+
+struct Qtilities::CoreGui::LogMessageStoragePrivateData {
+    LogMessageStoragePrivateData() : count(0),
+        first_line(0),
+        chunk_size(8192),
+        max_count(0) {}
+
+    mutable QReadWriteLock                  lock;
+    QList<LogMessageStorageChunk*>          chunks;
+    int                                     count;
+    qlonglong                               first_line;
+    int                                     chunk_size;
+    int                                     max_count;
+
+    // Must be called with the write lock held.
+    void appendLocked(const QString& message, Logger::MessageType message_type) {
+        if (chunks.isEmpty() || chunks.last()->count() >= chunk_size) {
+            LogMessageStorageChunk* chunk = new LogMessageStorageChunk;
+            chunk->offsets.reserve(chunk_size);
+            chunk->types.reserve(chunk_size);
+            chunk->colors.reserve(chunk_size);
+            chunks << chunk;
+        }
+
+        QColor color;
+        QString plain_text = LogMessageStorage::toPlainText(message,&color);
+        QRgb rgb = color.isValid() ? color.rgba() : 0;
+
+        LogMessageStorageChunk* chunk = chunks.last();
+        chunk->offsets << chunk->text.size();
+        chunk->text.append(plain_text.toUtf8());
+        chunk->types << quint8(messageTypeIndex(message_type));
+        chunk->colors << rgb;
+        ++count;
+    }
+
+    inline const LogMessageStorageChunk* chunkForRow(int row, int* index) const {
+        *index = row % chunk_size;
+        return chunks.at(row / chunk_size);
+    }
+
+    // Message types are stored as the index of their bit in order to fit in a quint8:
+    static inline int messageTypeIndex(Logger::MessageType message_type) {
+        int index = 0;
+        int type = message_type;
+        while (type > 1) {
+            type >>= 1;
+            ++index;
+        }
+        return index;
+    }
+};
+
+Qtilities::CoreGui::LogMessageStorage::LogMessageStorage(int chunk_size) {
+    d = new LogMessageStoragePrivateData;
+    d->chunk_size = qMax(1,chunk_size);
+}
+
+Qtilities::CoreGui::LogMessageStorage::~LogMessageStorage() {
+    qDeleteAll(d->chunks);
+    delete d;
+}
+
+void Qtilities::CoreGui::LogMessageStorage::append(const QString& message, Logger::MessageType message_type) {
+    QWriteLocker locker(&d->lock);
+    d->appendLocked(message,message_type);
+}
+
+void Qtilities::CoreGui::LogMessageStorage::append(const QStringList& messages, const QList<Logger::MessageType>& message_types) {
+    QWriteLocker locker(&d->lock);
+    for (int i = 0; i < messages.count(); ++i)
+        d->appendLocked(messages.at(i),i < message_types.count() ? message_types.at(i) : Logger::Info);
+}
+
+void Qtilities::CoreGui::LogMessageStorage::clear() {
+    QWriteLocker locker(&d->lock);
+    qDeleteAll(d->chunks);
+    d->chunks.clear();
+    d->first_line += d->count;
+    d->count = 0;
+}
+
+int Qtilities::CoreGui::LogMessageStorage::count() const {
+    QReadLocker locker(&d->lock);
+    return d->count;
+}
+
+qlonglong Qtilities::CoreGui::LogMessageStorage::firstLineNumber() const {
+    QReadLocker locker(&d->lock);
+    return d->first_line;
+}
+
+QString Qtilities::CoreGui::LogMessageStorage::message(int row) const {
+    QReadLocker locker(&d->lock);
+    if (row < 0 || row >= d->count)
+        return QString();
+
+    int index;
+    const LogMessageStorageChunk* chunk = d->chunkForRow(row,&index);
+    return QString::fromUtf8(chunk->lineStart(index),chunk->lineLength(index));
+}
+
+Qtilities::Logging::Logger::MessageType Qtilities::CoreGui::LogMessageStorage::messageType(int row) const {
+    QReadLocker locker(&d->lock);
+    if (row < 0 || row >= d->count)
+        return Logger::None;
+
+    int index;
+    const LogMessageStorageChunk* chunk = d->chunkForRow(row,&index);
+    return (Logger::MessageType) (1 << chunk->types.at(index));
+}
+
+QColor Qtilities::CoreGui::LogMessageStorage::messageColor(int row) const {
+    QReadLocker locker(&d->lock);
+    if (row < 0 || row >= d->count)
+        return QColor();
+
+    int index;
+    const LogMessageStorageChunk* chunk = d->chunkForRow(row,&index);
+    QRgb rgb = chunk->colors.at(index);
+    if (rgb == 0)
+        return QColor();
+    return QColor::fromRgba(rgb);
+}
+
+void Qtilities::CoreGui::LogMessageStorage::setMaximumCount(int maximum_count) {
+    QWriteLocker locker(&d->lock);
+    d->max_count = qMax(0,maximum_count);
+}
+
+int Qtilities::CoreGui::LogMessageStorage::maximumCount() const {
+    QReadLocker locker(&d->lock);
+    return d->max_count;
+}
+
+int Qtilities::CoreGui::LogMessageStorage::trimCount() const {
+    QReadLocker locker(&d->lock);
+    if (d->max_count == 0)
+        return 0;
+
+    // Messages are removed in whole chunks, thus up to one chunk more than the maximum count is kept:
+    int trim_count = 0;
+    int remaining = d->count;
+    for (int i = 0; i < d->chunks.count() - 1; ++i) {
+        if (remaining - d->chunks.at(i)->count() < d->max_count)
+            break;
+        trim_count += d->chunks.at(i)->count();
+        remaining -= d->chunks.at(i)->count();
+    }
+    return trim_count;
+}
+
+void Qtilities::CoreGui::LogMessageStorage::trim() {
+    int trim_count = trimCount();
+    if (trim_count == 0)
+        return;
+
+    QWriteLocker locker(&d->lock);
+    while (trim_count > 0 && !d->chunks.isEmpty()) {
+        LogMessageStorageChunk* chunk = d->chunks.takeFirst();
+        trim_count -= chunk->count();
+        d->count -= chunk->count();
+        d->first_line += chunk->count();
+        delete chunk;
+    }
+}
+
+qlonglong Qtilities::CoreGui::LogMessageStorage::find(const QRegExp& pattern, qlonglong from_line, bool backward, int max_lines, qlonglong* next_line) const {
+    QReadLocker locker(&d->lock);
+    qlonglong row = from_line - d->first_line;
+    if (row < 0 || row >= d->count) {
+        if (next_line)
+            *next_line = -1;
+        return -1;
+    }
+
+    QString line;
+    for (int scanned = 0; scanned < max_lines; ++scanned) {
+        int index;
+        const LogMessageStorageChunk* chunk = d->chunkForRow(int(row),&index);
+        line = QString::fromUtf8(chunk->lineStart(index),chunk->lineLength(index));
+        if (pattern.indexIn(line) != -1) {
+            if (next_line)
+                *next_line = -1;
+            return d->first_line + row;
+        }
+
+        row += backward ? -1 : 1;
+        if (row < 0 || row >= d->count) {
+            if (next_line)
+                *next_line = -1;
+            return -1;
+        }
+    }
+
+    if (next_line)
+        *next_line = d->first_line + row;
+    return -1;
+}
+
+QString Qtilities::CoreGui::LogMessageStorage::toPlainText(const QString& message, QColor* color) {
+    if (color)
+        *color = QColor();
+
+    // Fast path for plain text messages:
+    if (!message.contains(QLatin1Char('<')) && !message.contains(QLatin1Char('&')))
+        return QString(message).replace(QChar(QChar::Nbsp),QLatin1Char(' '));
+
+    QString plain_text;
+    plain_text.reserve(message.size());
+    const int length = message.size();
+    int i = 0;
+    while (i < length) {
+        const QChar c = message.at(i);
+        if (c == QLatin1Char('<')) {
+            int end = message.indexOf(QLatin1Char('>'),i);
+            if (end == -1)
+                break;
+
+            QString tag = message.mid(i + 1,end - i - 1).trimmed().toLower();
+            if (tag.startsWith(QLatin1String("br")))
+                plain_text.append(QLatin1String("  "));
+            else if (color && !color->isValid() && tag.startsWith(QLatin1String("font"))) {
+                int color_index = tag.indexOf(QLatin1String("color="));
+                if (color_index != -1) {
+                    QString color_name = tag.mid(color_index + 6).section(QRegExp("[\\s>]"),0,0);
+                    color_name.remove(QLatin1Char('\'')).remove(QLatin1Char('"'));
+                    color->setNamedColor(color_name);
+                }
+            }
+            i = end + 1;
+        } else if (c == QLatin1Char('&')) {
+            int end = message.indexOf(QLatin1Char(';'),i);
+            if (end == -1 || end - i > 8) {
+                plain_text.append(c);
+                ++i;
+                continue;
+            }
+
+            QString entity = message.mid(i + 1,end - i - 1);
+            if (entity == QLatin1String("lt"))
+                plain_text.append(QLatin1Char('<'));
+            else if (entity == QLatin1String("gt"))
+                plain_text.append(QLatin1Char('>'));
+            else if (entity == QLatin1String("amp"))
+                plain_text.append(QLatin1Char('&'));
+            else if (entity == QLatin1String("quot"))
+                plain_text.append(QLatin1Char('"'));
+            else if (entity == QLatin1String("apos") || entity == QLatin1String("#39"))
+                plain_text.append(QLatin1Char('\''));
+            else if (entity == QLatin1String("nbsp"))
+                plain_text.append(QLatin1Char(' '));
+            else
+                plain_text.append(message.mid(i,end - i + 1));
+            i = end + 1;
+        } else {
+            plain_text.append(c == QChar(QChar::Nbsp) ? QChar(QLatin1Char(' ')) : c);
+            ++i;
+        }
+    }
+
+    return plain_text;
+}
+
+// ------------------------------------
+// LogMessageListModel
+// ------------------------------------
+Qtilities::CoreGui::LogMessageListModel::LogMessageListModel(LogMessageStorage* storage, QObject* parent) : QAbstractListModel(parent),
+    m_storage(storage) {
+
+}
+
+Qtilities::CoreGui::LogMessageListModel::~LogMessageListModel() {
+
+}
+
+int Qtilities::CoreGui::LogMessageListModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || !m_storage)
+        return 0;
+    return m_storage->count();
+}
+
+QVariant Qtilities::CoreGui::LogMessageListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || !m_storage)
+        return QVariant();
+
+    if (role == Qt::DisplayRole) {
+        return m_storage->message(index.row());
+    } else if (role == Qt::ForegroundRole) {
+        QColor color = m_storage->messageColor(index.row());
+        if (color.isValid())
+            return color;
+
+        Logger::MessageType message_type = m_storage->messageType(index.row());
+        if (message_type == Logger::Warning)
+            return QColor("orange");
+        else if (message_type == Logger::Error)
+            return QColor(Qt::red);
+        else if (message_type == Logger::Fatal)
+            return QColor("purple");
+        else if (message_type == Logger::Debug || message_type == Logger::Trace)
+            return QColor(Qt::gray);
+    } else if (role == MessageTypeRole) {
+        return (int) m_storage->messageType(index.row());
+    } else if (role == LineNumberRole) {
+        return m_storage->firstLineNumber() + index.row();
+    }
+
+    return QVariant();
+}
+
+Qtilities::CoreGui::LogMessageStorage* Qtilities::CoreGui::LogMessageListModel::storage() const {
+    return m_storage;
+}
+
+void Qtilities::CoreGui::LogMessageListModel::appendMessages(const QStringList& messages, const QList<Logger::MessageType>& message_types) {
+    if (!m_storage || messages.isEmpty())
+        return;
+
+    const int first_row = m_storage->count();
+    beginInsertRows(QModelIndex(),first_row,first_row + messages.count() - 1);
+    m_storage->append(messages,message_types);
+    endInsertRows();
+
+    const int trim_count = m_storage->trimCount();
+    if (trim_count > 0) {
+        beginRemoveRows(QModelIndex(),0,trim_count - 1);
+        m_storage->trim();
+        endRemoveRows();
+    }
+}
+
+void Qtilities::CoreGui::LogMessageListModel::clear() {
+    if (!m_storage)
+        return;
+
+    beginResetModel();
+    m_storage->clear();
+    endResetModel();
+}
+
+int Qtilities::CoreGui::LogMessageListModel::rowForLine(qlonglong line_number) const {
+    if (!m_storage)
+        return -1;
+
+    qlonglong row = line_number - m_storage->firstLineNumber();
+    if (row < 0 || row >= m_storage->count())
+        return -1;
+    return int(row);
+}
@@ -0,0 +1,157 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef LOGMESSAGESTORAGE_H
+#define LOGMESSAGESTORAGE_H
+
+#include "QtilitiesCoreGui_global.h"
+
+#include <Logger.h>
+
+#include <QAbstractListModel>
+#include <QColor>
+#include <QRegExp>
+#include <QStringList>
+
+namespace Qtilities {
+    namespace CoreGui {
+        using namespace Qtilities::Logging;
+
+        /*!
+        \struct LogMessageStoragePrivateData
+        \brief The LogMessageStoragePrivateData struct stores private data used by the LogMessageStorage class.
+          */
+        struct LogMessageStoragePrivateData;
+
+        /*!
+        \class LogMessageStorage
+        \brief Compact, append only storage for the messages shown in a log viewer.
+
+        Messages are stored as plain text in chunks of UTF-8 encoded lines, thus millions of messages can be kept without the overhead of a text document
+        or a QString per message. Rich text messages, like those produced by Qtilities::Logging::FormattingEngine_Rich_Text, are converted to plain
+        text and their font color is kept.
+
+        Every message gets an absolute line number when it is appended. Since old messages are removed in whole chunks when a maximum count is set, line numbers
+        stay valid for as long as the message is stored. The row of a message is its line number minus firstLineNumber().
+
+        The storage is thread safe: messages can be searched using find() in a worker thread while messages are appended from the GUI thread.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILITIES_CORE_GUI_SHARED_EXPORT LogMessageStorage
+        {
+        public:
+            //! Constructs log message storage.
+            /*!
+              \param chunk_size The number of messages stored in each chunk.
+              */
+            LogMessageStorage(int chunk_size = 8192);
+            ~LogMessageStorage();
+
+            //! Appends a message.
+            /*!
+              \param message The message, which may contain rich text.
+              \param message_type The type of the message.
+              */
+            void append(const QString& message, Logger::MessageType message_type);
+            //! Appends a list of messages, holding the storage lock only once.
+            void append(const QStringList& messages, const QList<Logger::MessageType>& message_types);
+            //! Removes all messages.
+            void clear();
+
+            //! Returns the number of stored messages.
+            int count() const;
+            //! Returns the line number of the first stored message.
+            qlonglong firstLineNumber() const;
+            //! Returns the plain text of the message at the given row.
+            QString message(int row) const;
+            //! Returns the type of the message at the given row.
+            Logger::MessageType messageType(int row) const;
+            //! Returns the font color of the message at the given row, an invalid color when the message did not specify a color.
+            QColor messageColor(int row) const;
+
+            //! Sets the maximum number of messages to keep. When 0, the number of messages is not limited. The default is 0.
+            void setMaximumCount(int maximum_count);
+            //! Returns the maximum number of messages to keep.
+            int maximumCount() const;
+            //! Returns the number of messages at the start of the storage which will be removed by trim().
+            int trimCount() const;
+            //! Removes the trimCount() oldest messages.
+            void trim();
+
+            //! Searches a limited number of messages for a pattern.
+            /*!
+              This function is intended to be called repeatedly from a worker thread, thus the storage is only locked while \p max_lines messages are searched.
+
+              \param pattern The pattern to search for.
+              \param from_line The line number of the first message to search.
+              \param backward When true, messages are searched from \p from_line towards the first message. Otherwise towards the last message.
+              \param max_lines The maximum number of messages to search.
+              \param next_line Set to the line number where the search must continue when no match was found. Set to -1 when the start or end of the storage was reached.
+              \returns The line number of the first matching message, or -1 when no match was found.
+              */
+            qlonglong find(const QRegExp& pattern, qlonglong from_line, bool backward, int max_lines, qlonglong* next_line) const;
+
+            //! Converts a rich text message to plain text.
+            /*!
+              \param message The message to convert.
+              \param color When not 0, set to the first font color found in the message.
+              */
+            static QString toPlainText(const QString& message, QColor* color = 0);
+
+        private:
+            Q_DISABLE_COPY(LogMessageStorage)
+            LogMessageStoragePrivateData* d;
+        };
+
+        /*!
+        \class LogMessageListModel
+        \brief A list model showing the messages in a LogMessageStorage.
+
+        The model only creates display data for the rows requested by its view, thus it can be used with millions of messages. Use it with a QListView
+        which has \p uniformItemSizes enabled, for example MessagesListViewTab. Messages must be appended through the model in order for it to notify its views.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILITIES_CORE_GUI_SHARED_EXPORT LogMessageListModel : public QAbstractListModel
+        {
+            Q_OBJECT
+
+        public:
+            //! Constructs a model for the given storage, the storage is not owned by the model.
+            LogMessageListModel(LogMessageStorage* storage, QObject* parent = 0);
+            ~LogMessageListModel();
+
+            //! Custom roles provided by this model.
+            enum LogMessageRole {
+                MessageTypeRole = Qt::UserRole + 1,     /*!< The Logger::MessageType of the message, as an int. */
+                LineNumberRole  = Qt::UserRole + 2      /*!< The line number of the message in the storage, as a qlonglong. */
+            };
+
+            int rowCount(const QModelIndex& parent = QModelIndex()) const;
+            QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+
+            //! Returns the storage used by this model.
+            LogMessageStorage* storage() const;
+            //! Appends messages to the storage, removing the oldest messages when the storage's maximum count is exceeded.
+            void appendMessages(const QStringList& messages, const QList<Logger::MessageType>& message_types);
+            //! Removes all messages from the storage.
+            void clear();
+            //! Returns the row of a line number, -1 when the line is not stored anymore.
+            int rowForLine(qlonglong line_number) const;
+
+        private:
+            LogMessageStorage* m_storage;
+        };
+    }
+}
+
+#endif // LOGMESSAGESTORAGE_H
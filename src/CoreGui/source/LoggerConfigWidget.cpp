@@ -17,6 +17,7 @@
 #include "CodeEditorWidget.h"
 
 #include <LoggerEngines>
+#include <NetworkLoggerEngine>
 #include <Logger>
 #include <LoggingConstants>
 #include <AbstractLoggerEngine>
@@ -27,6 +28,7 @@
 #include <QHBoxLayout>
 #include <QTableWidgetItem>
 #include <QFileDialog>
+#include <QTimer>
 
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::CoreGui::Icons;
@@ -38,6 +40,8 @@ struct Qtilities::CoreGui::LoggerConfigWidgetPrivateData {
 
     qti_private_LoggerEnginesTableModel logger_engine_model;
     AbstractLoggerEngine* active_engine;
+    //! Refreshes the throttling counters while the widget is visible.
+    QTimer throttling_refresh_timer;
 };
 
 Qtilities::CoreGui::LoggerConfigWidget::LoggerConfigWidget(bool applyButtonVisisble, QWidget *parent) :
@@ -119,6 +123,14 @@ void Qtilities::CoreGui::LoggerConfigWidget::configPageInitialize() {
     connect(ui->comboGlobalLogLevel,SIGNAL(currentIndexChanged(QString)),SLOT(handle_ComboBoxGlobalLogLevelCurrentIndexChange(QString)));
     connect(ui->checkBoxRememberSession,SIGNAL(clicked(bool)),SLOT(handle_CheckBoxRememberSessionConfigClicked(bool)));
 
+    // Throttling:
+    ui->checkBoxCoalesceMessages->setChecked(Log->messageCoalescingEnabled());
+    connect(ui->checkBoxCoalesceMessages,SIGNAL(clicked(bool)),SLOT(handle_CheckBoxCoalesceMessagesClicked(bool)));
+    connect(ui->btnResetThrottlingCounters,SIGNAL(clicked()),SLOT(handle_BtnResetThrottlingCountersClicked()));
+    connect(&d->throttling_refresh_timer,SIGNAL(timeout()),SLOT(refreshThrottlingCounters()));
+    d->throttling_refresh_timer.setInterval(1000);
+    refreshThrottlingCounters();
+
     updateActiveEngine();
 }
 
@@ -150,6 +162,42 @@ void Qtilities::CoreGui::LoggerConfigWidget::handle_NewLoggerEngineRequest() {
             if (!fileName.isEmpty()) {
                 Log->newFileEngine(engine_name,fileName,QString());
             }
+        } else if (new_item_selection == QString(qti_def_FACTORY_TAG_NETWORK_LOGGER_ENGINE)) {
+            QString endpoint = QInputDialog::getText(this, tr("Log Collector"),tr("Collector Endpoint (host:port):"), QLineEdit::Normal, "localhost:12201", &ok);
+            if (!ok)
+                return;
+            int separator = endpoint.lastIndexOf(':');
+            quint16 port = separator > 0 ? endpoint.mid(separator + 1).toUShort() : 0;
+            if (port == 0) {
+                QMessageBox::warning(this,tr("Invalid Endpoint"),tr("The collector endpoint must be specified as host:port."));
+                return;
+            }
+
+            QStringList protocols;
+            protocols << "TCP" << "UDP";
+            QString protocol = QInputDialog::getItem(this, tr("Log Collector"),tr("Protocol:"), protocols, 0, false, &ok);
+            if (!ok)
+                return;
+            QStringList record_formats;
+            record_formats << "GELF" << "Syslog";
+            QString record_format = QInputDialog::getItem(this, tr("Log Collector"),tr("Record Format:"), record_formats, 0, false, &ok);
+            if (!ok)
+                return;
+
+            if (Log->attachedLoggerEngineNames().contains(engine_name)) {
+                QMessageBox::warning(this,tr("Duplicate Engine Name"),tr("A logger engine with the name \"%1\" already exists.").arg(engine_name));
+                return;
+            }
+
+            NetworkLoggerEngine* network_engine = qobject_cast<NetworkLoggerEngine*> (Log->newLoggerEngine(qti_def_FACTORY_TAG_NETWORK_LOGGER_ENGINE));
+            if (!network_engine)
+                return;
+            network_engine->setName(engine_name);
+            network_engine->setEndpoint(endpoint.left(separator),port);
+            network_engine->setProtocol(protocol == "UDP" ? NetworkLoggerEngine::UdpProtocol : NetworkLoggerEngine::TcpProtocol);
+            network_engine->setRecordFormat(record_format == "Syslog" ? NetworkLoggerEngine::SyslogFormat : NetworkLoggerEngine::GelfFormat);
+            // The logger deletes the engine when it cannot be attached:
+            Log->attachLoggerEngine(network_engine);
         }
     }
 }
@@ -226,6 +274,44 @@ void Qtilities::CoreGui::LoggerConfigWidget::handle_CheckBoxRememberSessionConfi
     Log->setRememberSessionConfig(checked);
 }
 
+void Qtilities::CoreGui::LoggerConfigWidget::handle_CheckBoxCoalesceMessagesClicked(bool checked) {
+    Log->setMessageCoalescingEnabled(checked);
+}
+
+void Qtilities::CoreGui::LoggerConfigWidget::handle_BtnResetThrottlingCountersClicked() {
+    Log->resetThrottlingCounters();
+    refreshThrottlingCounters();
+}
+
+void Qtilities::CoreGui::LoggerConfigWidget::refreshThrottlingCounters() {
+    QStringList counters;
+    int coalesced = Log->coalescedMessageCount();
+    if (coalesced > 0)
+        counters << tr("%1 coalesced").arg(coalesced);
+    for (int i = 1; i < 7; ++i) {
+        Logger::MessageType message_type = (Logger::MessageType) (1 << i);
+        int rate_limited = Log->rateLimitedMessageCount(message_type);
+        if (rate_limited > 0)
+            counters << tr("%1 %2 rate limited").arg(rate_limited).arg(Log->logLevelToString(message_type).toLower());
+    }
+
+    if (counters.isEmpty())
+        ui->lblThrottlingCounters->setText(tr("None"));
+    else
+        ui->lblThrottlingCounters->setText(counters.join(", "));
+}
+
+void Qtilities::CoreGui::LoggerConfigWidget::showEvent(QShowEvent *e) {
+    refreshThrottlingCounters();
+    d->throttling_refresh_timer.start();
+    QWidget::showEvent(e);
+}
+
+void Qtilities::CoreGui::LoggerConfigWidget::hideEvent(QHideEvent *e) {
+    d->throttling_refresh_timer.stop();
+    QWidget::hideEvent(e);
+}
+
 void Qtilities::CoreGui::LoggerConfigWidget::handle_ComboBoxGlobalLogLevelCurrentIndexChange(const QString& text) {
     Log->setGlobalLogLevel(Log->stringToLogLevel(text));
 }
@@ -272,38 +358,25 @@ void Qtilities::CoreGui::LoggerConfigWidget::writeSettings() {
     if (!QtilitiesCoreApplication::qtilitiesSettingsEnabled())
         return;
 
-    // Store settings using QSettings only if it was initialized
-    QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("Logging");
-    settings.beginGroup("General");
-    settings.setValue("global_log_level", QVariant(Log->globalLogLevel()));
-    settings.setValue("remember_session_config", QVariant(Log->rememberSessionConfig()));
-    settings.endGroup();
-    settings.endGroup();
-    settings.endGroup();
+    // Store settings only if it was initialized
+    SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+    settings->setValue("Qtilities/Logging/General/global_log_level", QVariant(Log->globalLogLevel()));
+    settings->setValue("Qtilities/Logging/General/remember_session_config", QVariant(Log->rememberSessionConfig()));
 }
 
 void Qtilities::CoreGui::LoggerConfigWidget::readSettings() {
     if (QCoreApplication::organizationName().isEmpty() || QCoreApplication::organizationDomain().isEmpty() || QCoreApplication::applicationName().isEmpty())
         qDebug() << tr("The logger may not be able to restore paramaters from previous sessions since the correct details in QCoreApplication have not been set.");
 
-    // Load logging paramaters using QSettings()
-    QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("Logging");
-    settings.beginGroup("General");
-    QVariant log_level =  settings.value("global_log_level", Logger::Fatal);
+    // Load logging paramaters from the settings store
+    SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+    QVariant log_level =  settings->value("Qtilities/Logging/General/global_log_level", Logger::Fatal);
     Logger::MessageType global_type = (Logger::MessageType) log_level.toInt();
     ui->comboGlobalLogLevel->setCurrentIndex(ui->comboGlobalLogLevel->findText(Log->logLevelToString(global_type)));
-    if (settings.value("remember_session_config", true).toBool())
+    if (settings->valueAs<bool>("Qtilities/Logging/General/remember_session_config", true))
         ui->checkBoxRememberSession->setChecked(true);
     else
         ui->checkBoxRememberSession->setChecked(false);
-
-    settings.endGroup();
-    settings.endGroup();
-    settings.endGroup();
 }
 
 void Qtilities::CoreGui::LoggerConfigWidget::refreshLoggerEngineInformation() {
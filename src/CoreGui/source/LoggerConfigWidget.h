@@ -88,6 +88,8 @@ OBJECT_MANAGER->registerObject(LoggerGui::createLoggerConfigWidget());
 
         protected:
             void changeEvent(QEvent *e);
+            void showEvent(QShowEvent *e);
+            void hideEvent(QHideEvent *e);
 
         private slots:
             void handle_NewLoggerEngineRequest();
@@ -98,6 +100,9 @@ OBJECT_MANAGER->registerObject(LoggerGui::createLoggerConfigWidget());
             void handle_CheckBoxToggleAllClicked(bool checked);
             void handle_CheckBoxRememberSessionConfigClicked(bool checked);
             void handle_ComboBoxGlobalLogLevelCurrentIndexChange(const QString& text);
+            void handle_CheckBoxCoalesceMessagesClicked(bool checked);
+            void handle_BtnResetThrottlingCountersClicked();
+            void refreshThrottlingCounters();
             void handle_BtnSaveConfigClicked();
             void handle_BtnLoadConfigClicked();
             void handle_BtnApplyClicked();
@@ -91,6 +91,38 @@ log_engine->setMessageContexts(Logger::EngineSpecificMessages);
                                             bool is_active = true,
                                             Logger::MessageTypeFlags message_types = Logger::AllLogLevels,
                                             Qt::ToolBarArea toolbar_area = Qt::TopToolBarArea) {
+                WidgetLoggerEngine* new_widget_engine = createLogWidgetEngine(engine_name,
+                                                                              message_displays_flag,
+                                                                              window_title,
+                                                                              is_active,
+                                                                              message_types,
+                                                                              toolbar_area);
+                if (new_widget_engine)
+                    return new_widget_engine->getWidget();
+                else
+                    return 0;
+            }
+
+            //! Creates a new widget logger engine without creating its widget.
+            /*!
+                This function is similar to createLogWidget(), except that it returns the new engine. The widget of the engine is only created when
+                WidgetLoggerEngine::getWidget() is called, until then messages logged to the engine are kept in a list. Use this function when the log
+                might never be shown, for example for the logs of tasks.
+
+                The parameters are the same as the parameters of createLogWidget().
+
+                \returns The new engine, or 0 when it could not be created.
+
+                <i>This function was added in %Qtilities v1.5.</i>
+
+                \sa createLogWidget()
+              */
+            static WidgetLoggerEngine* createLogWidgetEngine(QString* engine_name,
+                                                             WidgetLoggerEngine::MessageDisplaysFlag message_displays_flag = WidgetLoggerEngine::DefaultDisplays,
+                                                             const QString& window_title = QString(),
+                                                             bool is_active = true,
+                                                             Logger::MessageTypeFlags message_types = Logger::AllLogLevels,
+                                                             Qt::ToolBarArea toolbar_area = Qt::TopToolBarArea) {
                 if (!engine_name)
                     return 0;
 
@@ -128,7 +160,7 @@ log_engine->setMessageContexts(Logger::EngineSpecificMessages);
                         new_widget_engine->setWindowTitle(new_logger_name);
                     else
                         new_widget_engine->setWindowTitle(window_title);
-                    return new_widget_engine->getWidget();
+                    return new_widget_engine;
                 } else
                     return 0;
              }
@@ -0,0 +1,508 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "MessagesListViewTab.h"
+#include "QtilitiesApplication.h"
+#include "QtilitiesCoreGuiConstants.h"
+#include "ActionProvider.h"
+#include "SearchBoxWidget.h"
+
+#include <QListView>
+#include <QVBoxLayout>
+#include <QToolBar>
+#include <QAction>
+#include <QTimer>
+#include <QThread>
+#include <QFile>
+#include <QFileDialog>
+#include <QTextStream>
+#include <QClipboard>
+#include <QApplication>
+
+using namespace Qtilities::Core;
+using namespace Qtilities::CoreGui;
+using namespace Qtilities::CoreGui::Icons;
+using namespace Qtilities::CoreGui::Actions;
+using namespace Qtilities::CoreGui::Constants;
+
+namespace Qtilities {
+    namespace CoreGui {
+        // Worker thread which searches the storage of a MessagesListViewTab.
+        class MessagesListViewSearchWorker : public QThread
+        {
+        public:
+            MessagesListViewSearchWorker(LogMessageStorage* storage, QObject* receiver) : QThread(),
+                storage(storage),
+                receiver(receiver),
+                from_line(0),
+                backward(false),
+                search_id(0) {}
+
+            //! Starts a new search, any running search is cancelled first.
+            void search(const QRegExp& new_pattern, qlonglong new_from_line, bool new_backward, int new_search_id) {
+                cancel();
+                pattern = new_pattern;
+                from_line = new_from_line;
+                backward = new_backward;
+                search_id = new_search_id;
+                cancelled.fetchAndStoreOrdered(0);
+                start(QThread::LowPriority);
+            }
+            //! Cancels a running search and waits for the thread to finish.
+            void cancel() {
+                cancelled.fetchAndStoreOrdered(1);
+                wait();
+            }
+
+        protected:
+            void run() {
+                // The number of messages searched while the storage is locked:
+                const int batch_size = 20000;
+
+                qlonglong first = storage->firstLineNumber();
+                int count = storage->count();
+                if (count == 0) {
+                    report(-1);
+                    return;
+                }
+
+                const qlonglong origin = qBound(first,from_line,first + count - 1);
+                qlonglong line = origin;
+                bool wrapped = false;
+                while (!isCancelled()) {
+                    qlonglong next_line;
+                    qlonglong match = storage->find(pattern,line,backward,batch_size,&next_line);
+                    if (match != -1) {
+                        if (wrapped && ((!backward && match > origin) || (backward && match < origin)))
+                            match = -1;
+                        report(match);
+                        return;
+                    }
+
+                    if (next_line == -1) {
+                        if (wrapped) {
+                            report(-1);
+                            return;
+                        }
+                        // Continue from the other end of the log:
+                        wrapped = true;
+                        first = storage->firstLineNumber();
+                        count = storage->count();
+                        line = backward ? first + count - 1 : first;
+                    } else if (wrapped && ((!backward && next_line > origin) || (backward && next_line < origin))) {
+                        report(-1);
+                        return;
+                    } else
+                        line = next_line;
+                }
+            }
+
+        private:
+            bool isCancelled() const {
+                #if QT_VERSION >= 0x050000
+                return cancelled.load() != 0;
+                #else
+                return cancelled != 0;
+                #endif
+            }
+            void report(qlonglong line_number) {
+                if (!isCancelled())
+                    QMetaObject::invokeMethod(receiver,"handle_SearchResult",Qt::QueuedConnection,Q_ARG(qlonglong,line_number),Q_ARG(int,search_id));
+            }
+
+            LogMessageStorage*  storage;
+            QObject*            receiver;
+            QRegExp             pattern;
+            qlonglong           from_line;
+            bool                backward;
+            int                 search_id;
+            QAtomicInt          cancelled;
+        };
+    }
+}
+
+struct Qtilities::CoreGui::MessagesListViewTabPrivateData {
+    MessagesListViewTabPrivateData() : model(&storage),
+        list_view(0),
+        searchBoxWidget(0),
+        actionCopy(0),
+        actionSelectAll(0),
+        actionClear(0),
+        actionSave(0),
+        actionFind(0),
+        actionFreezeLog(0),
+        frozen(false),
+        search_worker(0),
+        search_id(0),
+        action_provider(0) {
+        flush_timer.setSingleShot(true);
+        flush_timer.setInterval(30);
+    }
+
+    LogMessageStorage               storage;
+    LogMessageListModel             model;
+    QListView*                      list_view;
+    SearchBoxWidget*                searchBoxWidget;
+    QAction*                        actionCopy;
+    QAction*                        actionSelectAll;
+    QAction*                        actionClear;
+    QAction*                        actionSave;
+    QAction*                        actionFind;
+    QAction*                        actionFreezeLog;
+
+    //! Indicates if this widget is frozen.
+    bool                            frozen;
+    //! Messages which were not yet appended to the view.
+    QStringList                     pending_messages;
+    //! The types of the messages in pending_messages.
+    QList<Logger::MessageType>      pending_types;
+    //! Timer used to append pending messages to the view in batches.
+    QTimer                          flush_timer;
+    //! The worker thread used for searching.
+    MessagesListViewSearchWorker*   search_worker;
+    //! The id of the last search started, results from older searches are ignored.
+    int                             search_id;
+    //! The IActionProvider interface implementation.
+    ActionProvider*                 action_provider;
+    //! The global meta type string used for this widget.
+    QString                         global_meta_type;
+};
+
+Qtilities::CoreGui::MessagesListViewTab::MessagesListViewTab(QWidget *parent, Qt::ToolBarArea toolbar_area) : QMainWindow(parent)
+{
+    d = new MessagesListViewTabPrivateData;
+    d->action_provider = new ActionProvider(this);
+    d->search_worker = new MessagesListViewSearchWorker(&d->storage,this);
+
+    // Setup search box widget:
+    SearchBoxWidget::SearchOptions search_options = 0;
+    search_options |= SearchBoxWidget::CaseSensitive;
+    search_options |= SearchBoxWidget::WholeWordsOnly;
+    search_options |= SearchBoxWidget::RegEx;
+    d->searchBoxWidget = new SearchBoxWidget(search_options);
+    d->searchBoxWidget->setWholeWordsOnly(false);
+    connect(d->searchBoxWidget,SIGNAL(searchStringChanged(const QString)),SLOT(handleSearchStringChanged(QString)));
+    connect(d->searchBoxWidget,SIGNAL(btnClose_clicked()),d->searchBoxWidget,SLOT(hide()));
+    connect(d->searchBoxWidget,SIGNAL(btnFindNext_clicked()),SLOT(handle_FindNext()));
+    connect(d->searchBoxWidget,SIGNAL(btnFindPrevious_clicked()),SLOT(handle_FindPrevious()));
+    d->searchBoxWidget->setEditorFocus();
+    d->searchBoxWidget->hide();
+
+    // Setup the log view. Uniform item sizes allows the view to lay out only the visible rows:
+    d->list_view = new QListView;
+    d->list_view->setModel(&d->model);
+    d->list_view->setUniformItemSizes(true);
+    d->list_view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    d->list_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    d->list_view->setFont(QFont("Courier New"));
+    d->list_view->setFrameShape(QFrame::NoFrame);
+    connect(&d->flush_timer,SIGNAL(timeout()),SLOT(flushPendingMessages()));
+
+    QWidget* central_widget = new QWidget;
+    QVBoxLayout* layout = new QVBoxLayout(central_widget);
+    layout->setMargin(0);
+    layout->setSpacing(0);
+    layout->addWidget(d->list_view);
+    layout->addWidget(d->searchBoxWidget);
+    setCentralWidget(central_widget);
+
+    // Assign a default meta type for this widget:
+    QString context_string = "MessagesListViewTab";
+    int count = 0;
+    context_string.append(QString("%1").arg(count));
+    while (CONTEXT_MANAGER->hasContext(context_string)) {
+        QString count_string = QString("%1").arg(count);
+        context_string.chop(count_string.length());
+        ++count;
+        context_string.append(QString("%1").arg(count));
+    }
+    CONTEXT_MANAGER->registerContext(context_string);
+    d->global_meta_type = context_string;
+    setObjectName(context_string);
+
+    // Construct actions only after global meta type was set.
+    if (toolbar_area != Qt::NoToolBarArea) {
+        constructActions();
+        QList<QtilitiesCategory> categories = d->action_provider->actionCategories();
+        for (int i = 0; i < categories.count(); ++i) {
+            QList<QAction*> action_list = d->action_provider->actions(IActionProvider::FilterHidden,categories.at(i));
+            if (action_list.count() > 0) {
+                QToolBar* new_toolbar = new QToolBar(categories.at(i).toString());
+                addToolBar(toolbar_area,new_toolbar);
+                new_toolbar->addActions(action_list);
+            }
+        }
+    }
+
+    d->list_view->installEventFilter(this);
+}
+
+Qtilities::CoreGui::MessagesListViewTab::~MessagesListViewTab() {
+    d->search_worker->cancel();
+    delete d->search_worker;
+    delete d;
+}
+
+bool Qtilities::CoreGui::MessagesListViewTab::eventFilter(QObject *object, QEvent *event) {
+    if (object == d->list_view && event->type() == QEvent::FocusIn)
+        CONTEXT_MANAGER->setNewContext(d->global_meta_type,true);
+    return false;
+}
+
+QString Qtilities::CoreGui::MessagesListViewTab::contextString() const {
+    return d->global_meta_type;
+}
+
+QListView* Qtilities::CoreGui::MessagesListViewTab::listView() const {
+    return d->list_view;
+}
+
+Qtilities::CoreGui::LogMessageStorage* Qtilities::CoreGui::MessagesListViewTab::storage() const {
+    return &d->storage;
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::clear() {
+    d->search_worker->cancel();
+    d->flush_timer.stop();
+    d->pending_messages.clear();
+    d->pending_types.clear();
+    d->model.clear();
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::setFlushInterval(int msecs) {
+    d->flush_timer.setInterval(qMax(0,msecs));
+}
+
+int Qtilities::CoreGui::MessagesListViewTab::flushInterval() const {
+    return d->flush_timer.interval();
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::setMaximumBlockCount(int maximum) {
+    d->storage.setMaximumCount(maximum);
+}
+
+int Qtilities::CoreGui::MessagesListViewTab::maximumBlockCount() const {
+    return d->storage.maximumCount();
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::appendMessage(const QString& message, Logger::MessageType message_type) {
+    d->pending_messages << message;
+    d->pending_types << message_type;
+    if (d->frozen) {
+        // Only keep the messages which will fit in the log when it is unfrozen:
+        const int max_count = d->storage.maximumCount();
+        if (max_count > 0 && d->pending_messages.count() > 2 * max_count) {
+            const int remove_count = d->pending_messages.count() - max_count;
+            d->pending_messages.erase(d->pending_messages.begin(),d->pending_messages.begin() + remove_count);
+            d->pending_types.erase(d->pending_types.begin(),d->pending_types.begin() + remove_count);
+        }
+    } else if (!d->flush_timer.isActive())
+        d->flush_timer.start();
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::flushPendingMessages() {
+    d->flush_timer.stop();
+    if (d->pending_messages.isEmpty())
+        return;
+
+    d->model.appendMessages(d->pending_messages,d->pending_types);
+    d->pending_messages.clear();
+    d->pending_types.clear();
+
+    if (!d->frozen)
+        d->list_view->scrollToBottom();
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::startSearch(qlonglong from_line, bool backward) {
+    QString search_string = d->searchBoxWidget->currentSearchString();
+    if (search_string.isEmpty()) {
+        d->search_worker->cancel();
+        return;
+    }
+
+    Qt::CaseSensitivity case_sensitivity = d->searchBoxWidget->caseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    QRegExp pattern(search_string,case_sensitivity,d->searchBoxWidget->patternSyntax());
+    if (d->searchBoxWidget->wholeWordsOnly()) {
+        if (pattern.patternSyntax() == QRegExp::FixedString)
+            search_string = QRegExp::escape(search_string);
+        pattern = QRegExp("\\b" + search_string + "\\b",case_sensitivity,QRegExp::RegExp);
+    }
+    if (!pattern.isValid())
+        return;
+
+    // The search box notifies find previous, find next and the changed string when the string changes, thus
+    // only the result of the last search started is used:
+    d->search_worker->search(pattern,from_line,backward,++d->search_id);
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::handle_SearchResult(qlonglong line_number, int search_id) {
+    if (search_id != d->search_id)
+        return;
+
+    int row = d->model.rowForLine(line_number);
+    if (row == -1) {
+        d->searchBoxWidget->setMessage(tr("No matches found."));
+        return;
+    }
+
+    d->searchBoxWidget->setMessage(QString());
+    QModelIndex index = d->model.index(row);
+    d->list_view->setCurrentIndex(index);
+    d->list_view->scrollTo(index,QAbstractItemView::PositionAtCenter);
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::handleSearchStringChanged(const QString& filter_string) {
+    Q_UNUSED(filter_string)
+
+    // Search from the current message, thus the selection stays where it is while the string still matches:
+    QModelIndex current = d->list_view->currentIndex();
+    qlonglong from_line = d->storage.firstLineNumber() + (current.isValid() ? current.row() : 0);
+    startSearch(from_line,false);
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::handle_FindPrevious() {
+    QModelIndex current = d->list_view->currentIndex();
+    qlonglong from_line = d->storage.firstLineNumber() + (current.isValid() ? current.row() - 1 : d->storage.count() - 1);
+    startSearch(from_line,true);
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::handle_FindNext() {
+    QModelIndex current = d->list_view->currentIndex();
+    qlonglong from_line = d->storage.firstLineNumber() + (current.isValid() ? current.row() + 1 : 0);
+    startSearch(from_line,false);
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::handle_Save() {
+    QString file_name = QFileDialog::getSaveFileName(this, tr("Save Log"),QtilitiesApplication::applicationSessionPath(),tr("Log File (*.log)"));
+
+    if (file_name.isEmpty())
+        return;
+
+    QFile file(file_name);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return;
+
+    QTextStream out(&file);
+    const int count = d->storage.count();
+    for (int i = 0; i < count; ++i)
+        out << d->storage.message(i) << "\n";
+    file.close();
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::handle_Clear() {
+    clear();
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::handle_FreezeLog() {
+    d->frozen = !d->frozen;
+    if (d->frozen) {
+        // While frozen, messages are only buffered:
+        d->flush_timer.stop();
+    } else {
+        // Append the messages buffered while the log was frozen and scroll to the end:
+        flushPendingMessages();
+        d->list_view->scrollToBottom();
+    }
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::handle_Copy() {
+    QModelIndexList selected = d->list_view->selectionModel()->selectedIndexes();
+    if (selected.isEmpty())
+        return;
+
+    QList<int> rows;
+    for (int i = 0; i < selected.count(); ++i)
+        rows << selected.at(i).row();
+    qSort(rows);
+
+    QStringList messages;
+    for (int i = 0; i < rows.count(); ++i)
+        messages << d->storage.message(rows.at(i));
+    QApplication::clipboard()->setText(messages.join("\n"));
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::handle_SearchShortcut() {
+    if (d->searchBoxWidget && !d->searchBoxWidget->isVisible()) {
+        d->searchBoxWidget->show();
+        d->searchBoxWidget->setEditorFocus();
+    }
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::handle_SelectAll() {
+    d->list_view->selectAll();
+}
+
+void Qtilities::CoreGui::MessagesListViewTab::constructActions() {
+    QList<int> context;
+    context.push_front(CONTEXT_MANAGER->contextID(d->global_meta_type));
+
+    ACTION_MANAGER->commandObserver()->startProcessingCycle();
+
+    // ---------------------------
+    // Save
+    // ---------------------------
+    d->actionSave = new QAction(QIcon(qti_icon_FILE_SAVE_16x16),QObject::tr("Save"),this);
+    d->action_provider->addAction(d->actionSave,QtilitiesCategory(tr("Log")));
+    connect(d->actionSave,SIGNAL(triggered()),SLOT(handle_Save()));
+    Command* command = ACTION_MANAGER->registerAction(qti_action_FILE_SAVE,d->actionSave,context);
+    command->setCategory(QtilitiesCategory("Editing"));
+    // ---------------------------
+    // Copy
+    // ---------------------------
+    d->actionCopy = new QAction(QIcon(qti_icon_EDIT_COPY_16x16),QObject::tr("Copy"),this);
+    d->action_provider->addAction(d->actionCopy,QtilitiesCategory(tr("Log")));
+    connect(d->actionCopy,SIGNAL(triggered()),SLOT(handle_Copy()));
+    command = ACTION_MANAGER->registerAction(qti_action_EDIT_COPY,d->actionCopy,context);
+    command->setCategory(QtilitiesCategory("Editing"));
+    // ---------------------------
+    // Select All
+    // ---------------------------
+    d->actionSelectAll = new QAction(QIcon(qti_icon_EDIT_SELECT_ALL_16x16),QObject::tr("Select All"),this);
+    d->action_provider->addAction(d->actionSelectAll,QtilitiesCategory(tr("Log")));
+    connect(d->actionSelectAll,SIGNAL(triggered()),SLOT(handle_SelectAll()));
+    command = ACTION_MANAGER->registerAction(qti_action_EDIT_SELECT_ALL,d->actionSelectAll,context);
+    command->setCategory(QtilitiesCategory("Editing"));
+    // ---------------------------
+    // Clear
+    // ---------------------------
+    d->actionClear = new QAction(QIcon(qti_icon_BROOM_16x16),QObject::tr("Clear"),this);
+    d->action_provider->addAction(d->actionClear,QtilitiesCategory(tr("Log")));
+    connect(d->actionClear,SIGNAL(triggered()),SLOT(handle_Clear()));
+    command = ACTION_MANAGER->registerAction(qti_action_EDIT_CLEAR,d->actionClear,context);
+    command->setCategory(QtilitiesCategory("Editing"));
+    // ---------------------------
+    // Pause/Resume
+    // ---------------------------
+    d->actionFreezeLog = new QAction(QIcon("://qtilities/coregui/icons/widget_log_freeze_output_16x16.png"),QObject::tr("Freeze Output"),this);
+    d->actionFreezeLog->setCheckable(true);
+    d->actionFreezeLog->setChecked(false);
+    d->action_provider->addAction(d->actionFreezeLog,QtilitiesCategory(tr("Log")));
+    connect(d->actionFreezeLog,SIGNAL(triggered()),SLOT(handle_FreezeLog()));
+    command = ACTION_MANAGER->registerAction("Edit.FreezeOutput",d->actionFreezeLog,context);
+    command->setCategory(QtilitiesCategory("Editing"));
+    // ---------------------------
+    // Find
+    // ---------------------------
+    d->actionFind = new QAction(QIcon(qti_icon_FIND_16x16),QObject::tr("Find"),this);
+    d->action_provider->addAction(d->actionFind,QtilitiesCategory(tr("Log")));
+    connect(d->actionFind,SIGNAL(triggered()),SLOT(handle_SearchShortcut()));
+    command = ACTION_MANAGER->registerAction(qti_action_EDIT_FIND,d->actionFind,context);
+
+    // Add actions to the list view.
+    d->list_view->addAction(d->actionClear);
+    d->list_view->addAction(d->actionSave);
+    d->list_view->addAction(d->actionCopy);
+    d->list_view->addAction(d->actionFreezeLog);
+    d->list_view->addAction(d->actionFind);
+    d->list_view->setContextMenuPolicy(Qt::ActionsContextMenu);
+
+    ACTION_MANAGER->commandObserver()->endProcessingCycle(false);
+}
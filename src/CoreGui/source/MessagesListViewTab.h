@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef MESSAGESLISTVIEWTAB_H
+#define MESSAGESLISTVIEWTAB_H
+
+#include "QtilitiesCoreGui_global.h"
+#include "LogMessageStorage.h"
+
+#include <IContext.h>
+#include <Logger.h>
+
+#include <QMainWindow>
+
+class QListView;
+
+namespace Qtilities {
+    namespace CoreGui {
+        using namespace Qtilities::Core::Interfaces;
+        using namespace Qtilities::Logging;
+
+        /*!
+        \struct MessagesListViewTabPrivateData
+        \brief The MessagesListViewTabPrivateData struct stores private data used by the MessagesListViewTab class.
+          */
+        struct MessagesListViewTabPrivateData;
+
+        /*!
+        \class MessagesListViewTab
+        \brief A messages tab used in WidgetLoggerEngineFrontend which shows messages in a virtualized QListView.
+
+        Unlike MessagesPlainTextEditTab, this tab does not keep its messages in a text document. Messages are stored in a LogMessageStorage and
+        shown through a LogMessageListModel in a QListView with uniform item sizes, thus only the visible rows are laid out. This allows sessions with
+        millions of messages to be viewed and searched. Searching is done incrementally in a worker thread on the storage, thus the GUI stays responsive.
+
+        This tab is used for the WidgetLoggerEngine::AllMessagesListWidget, WidgetLoggerEngine::IssuesListWidget, WidgetLoggerEngine::WarningsListWidget
+        and WidgetLoggerEngine::ErrorsListWidget message displays.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILITIES_CORE_GUI_SHARED_EXPORT MessagesListViewTab : public QMainWindow, public IContext {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Core::Interfaces::IContext)
+
+        public:
+            //! Constructor for MessagesListViewTab
+            /*!
+             * \param parent The parent widget.
+             * \param toolbar_area The toolbar area to use for action toolbars. If no toolbars should be displayed
+             * use Qt::NoToolBarArea.
+             */
+            MessagesListViewTab(QWidget *parent = 0,
+                                Qt::ToolBarArea toolbar_area = Qt::TopToolBarArea);
+            ~MessagesListViewTab();
+            bool eventFilter(QObject *object, QEvent *event);
+
+            // --------------------------------
+            // IContext Implementation
+            // --------------------------------
+            QString contextString() const;
+            QString contextHelpId() const { return QString(); }
+
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            //! Returns the QListView used by this tab.
+            QListView* listView() const;
+            //! Returns the storage holding the messages shown in this tab.
+            LogMessageStorage* storage() const;
+
+            //! Clears the log.
+            void clear();
+            //! Sets the interval in milliseconds at which messages are appended to the view. The default is 30 milliseconds.
+            void setFlushInterval(int msecs);
+            //! Returns the interval in milliseconds at which messages are appended to the view.
+            int flushInterval() const;
+            //! Sets the maximum number of messages kept in the log, older messages are removed. When 0, the number of messages is not limited, which is the default.
+            void setMaximumBlockCount(int maximum);
+            //! Returns the maximum number of messages kept in the log.
+            int maximumBlockCount() const;
+
+        public slots:
+            //! Queues a message to be appended to the log. Messages are appended in batches, and only buffered while the log is frozen.
+            void appendMessage(const QString& message, Logger::MessageType message_type = Logger::Info);
+            //! Appends all queued messages to the log.
+            void flushPendingMessages();
+
+            // Slots to respond to signals from GUI elements
+            void handle_FindPrevious();
+            void handle_FindNext();
+            void handle_Save();
+            void handle_Clear();
+            void handle_FreezeLog();
+            void handle_Copy();
+            void handle_SearchShortcut();
+            void handle_SelectAll();
+            void handleSearchStringChanged(const QString& filter_string);
+
+        private slots:
+            //! Called by the search worker thread when a search finished.
+            void handle_SearchResult(qlonglong line_number, int search_id);
+
+        private:
+            void constructActions();
+            void startSearch(qlonglong from_line, bool backward);
+
+            MessagesListViewTabPrivateData* d;
+        };
+    }
+}
+
+#endif // MESSAGESLISTVIEWTAB_H
@@ -27,7 +27,9 @@ struct Qtilities::CoreGui::ModeManagerPrivateData {
         previous_active_modes_populate(true),
         mode_id_counter(1000),
         register_shortcuts(true),
-        actionSwitchToPreviousMode(0) {}
+        actionSwitchToPreviousMode(0),
+        processing_cycle_depth(0),
+        refresh_pending(false) {}
 
     // All int values in here reffers to the modeID()s of the modes.
     ModeListWidget*             mode_list_widget;
@@ -45,6 +47,14 @@ struct Qtilities::CoreGui::ModeManagerPrivateData {
     QMap<QShortcut*,Command*>   command_shortcut_map;
     bool                        register_shortcuts;
     QPointer<QAction>           actionSwitchToPreviousMode;
+    //! The number of nested processing cycles, the mode list is not refreshed while this is larger than 0.
+    int                         processing_cycle_depth;
+    //! Indicates if the mode list must be refreshed when the processing cycle ends.
+    bool                        refresh_pending;
+    //! The list widget items of the modes shown in the list, keyed by mode ID.
+    QMap<int, QListWidgetItem*> mode_items;
+    //! The QIcon::cacheKey() of the decoration last set on each mode, keyed by mode ID.
+    QMap<int, qint64>           mode_decoration_keys;
 };
 
 Qtilities::CoreGui::ModeManager::ModeManager(int manager_id, Qt::Orientation orientation, QObject *parent) :
@@ -137,7 +147,7 @@ void CoreGui::ModeManager::refreshModeList() {
 
     d->id_iface_map.clear();
     QList<QObject*> modes = OBJECT_MANAGER->registeredInterfaces("com.Qtilities.CoreGui.IMode/1.0");
-    LOG_DEBUG(QString("Mode manager \"%1\" found %2 mode(s) during initialization.").arg(objectName()).arg(modes.count()));
+    LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreGuiLogTag,QString("Mode manager \"%1\" found %2 mode(s) during initialization.").arg(objectName()).arg(modes.count()));
     addModes(modes,true,false);
 }
 
@@ -147,6 +157,8 @@ void Qtilities::CoreGui::ModeManager::addMode(IMode* mode, bool initialize_mode,
         if (!mode->targetManagerIDs().contains(d->manager_id))
             return;
 
+        StartupProfileScope profile_scope(mode->modeName(),"Main Window Setup");
+
         // Check if it has a valid widget, otherwise we don't add the mode.
         if (!mode->modeWidget())
             return;
@@ -167,7 +179,7 @@ void Qtilities::CoreGui::ModeManager::addMode(IMode* mode, bool initialize_mode,
                     ++d->mode_id_counter;
                 }
                 mode->setModeID(d->mode_id_counter);
-                LOG_DEBUG(QString("Mode Manager: Auto-assigning mode ID %1 found for mode \"%2\".").arg(d->mode_id_counter).arg(mode->modeName()));
+                LOG_TAG_DEBUG(Qtilities::Logging::Logger::CoreGuiLogTag,QString("Mode Manager: Auto-assigning mode ID %1 found for mode \"%2\".").arg(d->mode_id_counter).arg(mode->modeName()));
                 ++d->mode_id_counter;
             }
 
@@ -256,7 +268,44 @@ QString Qtilities::CoreGui::ModeManager::activeModeName() const {
 }
 
 void CoreGui::ModeManager::handleModeIconChanged() {
-    refreshList();
+    // Only the item of the mode which changed its icon needs to be updated:
+    IMode* changed_mode = 0;
+    if (sender()) {
+        foreach (IMode* mode, d->id_iface_map) {
+            if (mode && mode->objectBase() == sender()) {
+                changed_mode = mode;
+                break;
+            }
+        }
+    }
+
+    QListWidgetItem* item = 0;
+    if (changed_mode)
+        item = d->mode_items.value(changed_mode->modeID());
+    if (!item) {
+        refreshList();
+        return;
+    }
+
+    item->setIcon(changed_mode->modeIcon());
+    updateModeDecoration(changed_mode);
+}
+
+void Qtilities::CoreGui::ModeManager::startProcessingCycle() {
+    ++d->processing_cycle_depth;
+}
+
+void Qtilities::CoreGui::ModeManager::endProcessingCycle() {
+    if (d->processing_cycle_depth == 0)
+        return;
+
+    --d->processing_cycle_depth;
+    if (d->processing_cycle_depth == 0 && d->refresh_pending)
+        refreshList();
+}
+
+bool Qtilities::CoreGui::ModeManager::isProcessingCycleActive() const {
+    return d->processing_cycle_depth > 0;
 }
 
 void Qtilities::CoreGui::ModeManager::setPreferredModeOrder(const QStringList& preferred_order, bool refresh_list) {
@@ -294,7 +343,8 @@ QList<int> Qtilities::CoreGui::ModeManager::preferredModeOrderIDs() const {
 
 void Qtilities::CoreGui::ModeManager::setDisabledModes(const QStringList& disabled_modes) {
     d->disabled_modes = modeNamesToIDs(disabled_modes);
-    refreshList();
+    if (!updateModeItemStates())
+        refreshList();
 }
 
 void Qtilities::CoreGui::ModeManager::setDisabledModes(QList<int> disabled_modes) {
@@ -303,7 +353,8 @@ void Qtilities::CoreGui::ModeManager::setDisabledModes(QList<int> disabled_modes
 
 void Qtilities::CoreGui::ModeManager::setDisabledModes(QList<IMode*> disabled_modes) {
     d->disabled_modes = modeIFacesToIDs(disabled_modes);
-    refreshList();
+    if (!updateModeItemStates())
+        refreshList();
 }
 
 QStringList Qtilities::CoreGui::ModeManager::disabledModeNames() const {
@@ -319,9 +370,17 @@ QList<int> Qtilities::CoreGui::ModeManager::disabledModeIDs() const {
 }
 
 void Qtilities::CoreGui::ModeManager::refreshList() {
+    // Refreshes requested during a processing cycle are done once when the cycle ends:
+    if (d->processing_cycle_depth > 0) {
+        d->refresh_pending = true;
+        return;
+    }
+    d->refresh_pending = false;
+
     if (d->id_iface_map.isEmpty()) {
         emit changeCentralWidget(0);
         emit modeListItemSizesChanged();
+        d->mode_items.clear();
         d->mode_list_widget->clear();
         return;
     }
@@ -331,6 +390,7 @@ void Qtilities::CoreGui::ModeManager::refreshList() {
 
     // Clear all lists:
     disconnect(d->mode_list_widget,SIGNAL(currentItemChanged(QListWidgetItem*,QListWidgetItem*)),this,SLOT(handleModeListCurrentItemChanged(QListWidgetItem*,QListWidgetItem*)));
+    d->mode_items.clear();
     d->mode_list_widget->clear();
     connect(d->mode_list_widget,SIGNAL(currentItemChanged(QListWidgetItem*,QListWidgetItem*)),SLOT(handleModeListCurrentItemChanged(QListWidgetItem*,QListWidgetItem*)),Qt::UniqueConnection);
 
@@ -370,10 +430,7 @@ void Qtilities::CoreGui::ModeManager::refreshList() {
             }
 
             // Set the mode icon as the object decoration for mode:
-            if (mode->objectBase()) {
-                SharedProperty icon_property(qti_prop_DECORATION,mode->modeIcon());
-                ObjectManager::setSharedProperty(mode->objectBase(),icon_property);
-            }
+            updateModeDecoration(mode);
             added_ids << id;
             added_names << mode->modeName();
             added_items[id] = new_item;
@@ -404,10 +461,7 @@ void Qtilities::CoreGui::ModeManager::refreshList() {
                 }
 
                 // Set the mode icon as the object decoration for mode:
-                if (mode->objectBase()) {
-                    SharedProperty icon_property(qti_prop_DECORATION,mode->modeIcon());
-                    ObjectManager::setSharedProperty(mode->objectBase(),icon_property);
-                }
+                updateModeDecoration(mode);
 
                 added_ids << mode->modeID();
                 added_names << mode->modeName();
@@ -469,6 +523,8 @@ void Qtilities::CoreGui::ModeManager::refreshList() {
         }
     }
 
+    d->mode_items = added_items;
+
     // If no modes has been set active yet, we set a mode to be active here:
     // We take the first mode that does not appear in the list of disabled modes.
     if (!set_active_done) {
@@ -570,13 +626,45 @@ QList<Qtilities::CoreGui::Interfaces::IMode*> Qtilities::CoreGui::ModeManager::m
 }
 
 QListWidgetItem* Qtilities::CoreGui::ModeManager::listWidgetItemForID(int id) const {
-    for (int i = 0; d->mode_list_widget->count(); ++i) {
-        QListWidgetItem* current = d->mode_list_widget->item(i);
-        if (current->type() == id)
-            return current;
+    return d->mode_items.value(id);
+}
+
+bool Qtilities::CoreGui::ModeManager::updateModeItemStates() {
+    // The list must be rebuilt when it does not show all modes, or when the active mode must change:
+    if (d->mode_items.count() != d->id_iface_map.count() || d->disabled_modes.contains(d->active_mode))
+        return false;
+
+    QMapIterator<int, QListWidgetItem*> itr(d->mode_items);
+    while (itr.hasNext()) {
+        itr.next();
+        if (!itr.value())
+            continue;
+
+        Qt::ItemFlags flags = itr.value()->flags();
+        if (d->disabled_modes.contains(itr.key()))
+            flags &= ~Qt::ItemIsEnabled;
+        else
+            flags |= Qt::ItemIsEnabled;
+        if (flags != itr.value()->flags())
+            itr.value()->setFlags(flags);
     }
 
-    return 0;
+    return true;
+}
+
+void Qtilities::CoreGui::ModeManager::updateModeDecoration(IMode* mode) {
+    if (!mode || !mode->objectBase())
+        return;
+
+    // Setting the shared property notifies all observers of the mode, thus only do it when the icon changed:
+    QIcon icon = mode->modeIcon();
+    QMap<int, qint64>::const_iterator itr = d->mode_decoration_keys.constFind(mode->modeID());
+    if (itr != d->mode_decoration_keys.constEnd() && itr.value() == icon.cacheKey())
+        return;
+
+    d->mode_decoration_keys[mode->modeID()] = icon.cacheKey();
+    SharedProperty icon_property(qti_prop_DECORATION,icon);
+    ObjectManager::setSharedProperty(mode->objectBase(),icon_property);
 }
 
 void CoreGui::ModeManager::updateSwitchToPreviousModeAction() {
@@ -221,9 +221,42 @@ ModeListWidget()->setStyleSheet(stylesheet);
             //! Returns the active mode name.
             QString activeModeName() const;
 
+            // ----------------------------------
+            // Functions related to batched changes
+            // ----------------------------------
+            //! Starts a processing cycle during which the mode list widget is not refreshed.
+            /*!
+              Use this function when registering many modes, changing the preferred mode order and disabled modes in one go. All
+              refreshes of the mode list widget requested during the processing cycle are done once when endProcessingCycle()
+              is called. Processing cycles can be nested, the list is refreshed when the outer cycle ends.
+
+              \sa endProcessingCycle(), isProcessingCycleActive()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void startProcessingCycle();
+            //! Ends a processing cycle started with startProcessingCycle().
+            /*!
+              If a refresh of the mode list widget was requested during the processing cycle, the list is refreshed once.
+
+              \sa startProcessingCycle(), isProcessingCycleActive()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void endProcessingCycle();
+            //! Indicates if a processing cycle is active.
+            /*!
+              \sa startProcessingCycle(), endProcessingCycle()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool isProcessingCycleActive() const;
+
         public slots:
             //! Slot which gets notified when a mode's icon changed.
             /*!
+             * When called from a mode's modeIconChanged() signal, only the item of that mode is updated in the mode list widget.
+             *
              * <i>This function was added in %Qtilities v1.5.</i>
              */
             void handleModeIconChanged();
@@ -420,6 +453,13 @@ ModeListWidget()->setStyleSheet(stylesheet);
             QListWidgetItem* listWidgetItemForID(int id) const;
             //! Update the previous mode switch to action.
             void updateSwitchToPreviousModeAction();
+            //! Updates the enabled state of the existing mode list items after the disabled modes changed.
+            /*!
+              \returns False when the mode list must be refreshed instead.
+              */
+            bool updateModeItemStates();
+            //! Sets the icon of \p mode as its qti_prop_DECORATION property when the icon changed since it was last set.
+            void updateModeDecoration(IMode* mode);
 
             ModeManagerPrivateData* d;
         };
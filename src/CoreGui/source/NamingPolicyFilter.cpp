@@ -16,8 +16,8 @@
 
 #include <QtilitiesPropertyChangeEvent>
 #include <Observer>
+#include <MemoryUsageReport>
 #include <QtilitiesCoreConstants>
-#include <SubjectIterator>
 
 #include <Logger>
 
@@ -27,6 +27,7 @@
 #include <QPushButton>
 #include <QMutex>
 #include <QVariant>
+#include <QSet>
 #include <QRegExpValidator>
 #include <QCoreApplication>
 #include <QDomDocument>
@@ -247,72 +248,200 @@ Qtilities::CoreGui::NamingPolicyFilter::ResolutionPolicy Qtilities::CoreGui::Nam
 Qtilities::CoreGui::NamingPolicyFilter::NameValidity Qtilities::CoreGui::NamingPolicyFilter::evaluateName(const QString& name, QObject* object) const {
     NamingPolicyFilter::NameValidity result = Acceptable;
 
-    bool do_uniqueness_test = true;
-    if (observer->isProcessingCycleActive() && !(d->processing_cycle_validation_check_flags & Uniqueness))
-        do_uniqueness_test = false;
-    else if (!observer->isProcessingCycleActive() && !(d->validation_check_flags & Uniqueness))
-        do_uniqueness_test = false;
-
-    if (do_uniqueness_test && (d->uniqueness_policy == ProhibitDuplicateNames || d->uniqueness_policy == ProhibitDuplicateNamesCaseSensitive)) {
+    if (isValidationCheckEnabled(Uniqueness) && (d->uniqueness_policy == ProhibitDuplicateNames || d->uniqueness_policy == ProhibitDuplicateNamesCaseSensitive)) {
         Qt::CaseSensitivity case_sensitivity = Qt::CaseSensitive;
         if (d->uniqueness_policy == ProhibitDuplicateNames)
             case_sensitivity = Qt::CaseInsensitive;
         else if (d->uniqueness_policy == ProhibitDuplicateNamesCaseSensitive)
             case_sensitivity = Qt::CaseSensitive;
 
-        if (!object) {
-            // Check uniqueness of name:
-            QStringList string_list = observer->subjectNames();
-            if (string_list.contains(name,case_sensitivity))
-                result |= Duplicate;
-        } else {
-            if (observer->subjectCount() > 0) {
-                // Check if the observer has an object model with this name:
-                SubjectIterator<QObject> itr(observer->subjectAt(0),
-                                             observer);
-
-                QMap<QString,QObject*> actual_paths;
-                actual_paths[itr.current()->objectName()] = itr.current();
-                while (itr.next()) {
-                    actual_paths[itr.current()->objectName()] = itr.current();
-                }
-
-                // Check uniqueness of name
-                QStringList string_list = QStringList(actual_paths.keys());
-                if (string_list.contains(name,case_sensitivity)) {
-                    if (actual_paths[name] != object)
-                        result |= Duplicate;
-                }
-            }
-        }
+        // Check uniqueness of name, ignoring the object which is being evaluated:
+        if (indexedSubjectWithName(name,case_sensitivity,object))
+            result |= Duplicate;
     }
 
-    bool do_validation_test = true;
-    if (observer->isProcessingCycleActive() && !(d->processing_cycle_validation_check_flags & Validity))
-        do_validation_test = false;
-    else if (!observer->isProcessingCycleActive() && !(d->validation_check_flags & Validity))
-        do_validation_test = false;
-
     Q_ASSERT(d->validator);
-    if (do_validation_test && d->validator) {
-        // Validate name using QValidator:
-        int pos;
-        if (d->validator->validate(*(const_cast<QString*> (&name)),pos) != QValidator::Acceptable)
+    if (isValidationCheckEnabled(Validity) && !isValidName(name))
+        result |= Invalid;
+
+    return result;
+}
+
+QList<Qtilities::CoreGui::NamingPolicyFilter::NameValidity> Qtilities::CoreGui::NamingPolicyFilter::evaluateNames(const QStringList& names, QList<int>* conflicts) const {
+    QList<NamingPolicyFilter::NameValidity> results;
+    results.reserve(names.count());
+
+    const bool do_uniqueness_test = observer && isValidationCheckEnabled(Uniqueness) && (d->uniqueness_policy == ProhibitDuplicateNames || d->uniqueness_policy == ProhibitDuplicateNamesCaseSensitive);
+    const bool do_validation_test = isValidationCheckEnabled(Validity);
+    Qt::CaseSensitivity case_sensitivity = Qt::CaseSensitive;
+    if (d->uniqueness_policy == ProhibitDuplicateNames)
+        case_sensitivity = Qt::CaseInsensitive;
+
+    // Names which are not unique within the list itself are found using the keys of the names already evaluated:
+    QSet<QString> evaluated_keys;
+    for (int i = 0; i < names.count(); ++i) {
+        const QString& name = names.at(i);
+        NamingPolicyFilter::NameValidity result = Acceptable;
+
+        if (do_uniqueness_test) {
+            const QString key = (case_sensitivity == Qt::CaseInsensitive) ? name.toCaseFolded() : name;
+            if (evaluated_keys.contains(key) || indexedSubjectWithName(name,case_sensitivity))
+                result |= Duplicate;
+            else
+                evaluated_keys.insert(key);
+        }
+
+        if (do_validation_test && !isValidName(name))
             result |= Invalid;
+
+        if (conflicts && result != Acceptable)
+            conflicts->append(i);
+        results << result;
     }
 
-    return result;
+    return results;
+}
+
+bool Qtilities::CoreGui::NamingPolicyFilter::isValidationCheckEnabled(NamingPolicyFilter::ValidationCheck check) const {
+    if (observer && observer->isProcessingCycleActive())
+        return d->processing_cycle_validation_check_flags & check;
+    else
+        return d->validation_check_flags & check;
+}
+
+bool Qtilities::CoreGui::NamingPolicyFilter::isValidName(const QString& name) const {
+    if (!d->validator)
+        return true;
+
+    QHash<QString,bool>::const_iterator itr = d->validity_cache.constFind(name);
+    if (itr != d->validity_cache.constEnd())
+        return itr.value();
+
+    // Validate name using QValidator. The validator may change the string passed to it, thus we pass a copy:
+    QString validated_name = name;
+    int pos = 0;
+    const bool valid = (d->validator->validate(validated_name,pos) == QValidator::Acceptable);
+    d->validity_cache.insert(name,valid);
+    return valid;
 }
 
 QObject* Qtilities::CoreGui::NamingPolicyFilter::getConflictingObject(const QString& name) const {
-    if (observer->subjectNames().contains(name) && d->uniqueness_policy == ProhibitDuplicateNames) {
-        for (int i = 0; i < observer->subjectCount(); ++i) {
-            if (observer->subjectNames().at(i) == name)
-                return observer->subjectAt(i);
+    if (d->uniqueness_policy == ProhibitDuplicateNames)
+        return indexedSubjectWithName(name,Qt::CaseInsensitive);
+    else if (d->uniqueness_policy == ProhibitDuplicateNamesCaseSensitive)
+        return indexedSubjectWithName(name,Qt::CaseSensitive);
+
+    return 0;
+}
+
+QObject* Qtilities::CoreGui::NamingPolicyFilter::indexedSubjectWithName(const QString& name, Qt::CaseSensitivity case_sensitivity, const QObject* ignore_object) const {
+    if (!observer)
+        return 0;
+
+    updateSubjectNameIndex();
+
+    const QString key = name.toCaseFolded();
+    if (!d->name_index.contains(key))
+        return 0;
+
+    // Names can change without this filter being notified, for example when the filter is not the name manager
+    // of a subject. Thus we verify the names of the candidates and move subjects which were renamed:
+    QObject* match = 0;
+    QList<QPointer<QObject> > candidates = d->name_index.value(key);
+    for (int i = 0; i < candidates.count(); ++i) {
+        QObject* candidate = candidates.at(i);
+        if (!candidate) {
+            d->name_index[key].removeAll(candidates.at(i));
+            continue;
+        } else if (!observer->contains(candidate)) {
+            unindexSubjectName(candidate);
+            continue;
         }
+
+        QString current_name = observer->subjectNameInContext(candidate);
+        if (current_name.toCaseFolded() != key) {
+            indexSubjectName(candidate);
+            continue;
+        }
+
+        if (!match && candidate != ignore_object && current_name.compare(name,case_sensitivity) == 0)
+            match = candidate;
     }
 
-    return 0;
+    if (d->name_index.contains(key) && d->name_index.value(key).isEmpty())
+        d->name_index.remove(key);
+
+    return match;
+}
+
+void Qtilities::CoreGui::NamingPolicyFilter::indexSubjectName(QObject* obj) const {
+    if (!obj || !observer)
+        return;
+
+    const QString key = observer->subjectNameInContext(obj).toCaseFolded();
+    if (d->name_index_keys.contains(obj)) {
+        if (d->name_index_keys.value(obj) == key)
+            return;
+        unindexSubjectName(obj);
+    }
+
+    d->name_index[key].append(obj);
+    d->name_index_keys[obj] = key;
+}
+
+void Qtilities::CoreGui::NamingPolicyFilter::unindexSubjectName(const QObject* obj) const {
+    if (!d->name_index_keys.contains(obj))
+        return;
+
+    const QString key = d->name_index_keys.take(obj);
+    QList<QPointer<QObject> >& subjects = d->name_index[key];
+    for (int i = subjects.count() - 1; i >= 0; --i) {
+        // Subjects which are being deleted are already null:
+        if (subjects.at(i) == obj || !subjects.at(i))
+            subjects.removeAt(i);
+    }
+    if (subjects.isEmpty())
+        d->name_index.remove(key);
+}
+
+void Qtilities::CoreGui::NamingPolicyFilter::updateSubjectNameIndex() const {
+    // Subjects attached during import cycles are not passed through finalizeAttachment(), in which case the
+    // number of indexed subjects does not match the number of subjects in the observer context:
+    if (d->name_index_valid && d->name_index_keys.count() == observer->subjectCount())
+        return;
+
+    d->name_index.clear();
+    d->name_index_keys.clear();
+    const int count = observer->subjectCount();
+    for (int i = 0; i < count; ++i)
+        indexSubjectName(observer->subjectAt(i));
+    d->name_index_valid = true;
+}
+
+void Qtilities::CoreGui::NamingPolicyFilter::initializeBulkAttachment(const QList<QObject*>& objects) {
+    if (!observer)
+        return;
+
+    // Evaluate all names up front. This validates every distinct name once, after which the evaluation of the
+    // individual attachments only needs the validation cache, and allows conflicts to be reported together:
+    QStringList names;
+    for (int i = 0; i < objects.count(); ++i) {
+        if (!objects.at(i))
+            continue;
+        QString evaluation_name = getEvaluationName(objects.at(i));
+        if (evaluation_name.isEmpty())
+            evaluation_name = objects.at(i)->objectName();
+        names << evaluation_name;
+    }
+
+    QList<int> conflicts;
+    evaluateNames(names,&conflicts);
+    if (!conflicts.isEmpty()) {
+        QStringList conflicting_names;
+        for (int i = 0; i < conflicts.count(); ++i)
+            conflicting_names << names.at(conflicts.at(i));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Naming Policy Filter: %1 of %2 subject names attached to context \"%3\" are invalid or not unique: %4").arg(conflicts.count()).arg(names.count()).arg(observer->observerName()).arg(conflicting_names.join(", ")));
+    }
 }
 
 Qtilities::CoreGui::AbstractSubjectFilter::EvaluationResult Qtilities::CoreGui::NamingPolicyFilter::evaluateAttachment(QObject* obj, QString* rejectMsg, bool silent) const {
@@ -374,7 +503,7 @@ bool Qtilities::CoreGui::NamingPolicyFilter::initializeAttachment(QObject* obj,
     if (!observer) {
         if (rejectMsg)
             *rejectMsg = tr("Naming Policy Filter: Cannot evaluate an attachment in a subject filter without an observer context.");
-        LOG_TRACE(tr("Cannot evaluate an attachment in a subject filter without an observer context."));
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,tr("Cannot evaluate an attachment in a subject filter without an observer context."));
         return false;
     }
 
@@ -447,7 +576,7 @@ bool Qtilities::CoreGui::NamingPolicyFilter::initializeAttachment(QObject* obj,
                 QByteArray property_name_byte_array = QByteArray(qti_prop_NAME);
                 QtilitiesPropertyChangeEvent* user_event = new QtilitiesPropertyChangeEvent(property_name_byte_array,observer->observerID());
                 QCoreApplication::postEvent(obj,user_event);
-                LOG_TRACE(QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(qti_prop_NAME).arg(obj->objectName()));
+                LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(qti_prop_NAME).arg(obj->objectName()));
             }
         }
     }
@@ -455,6 +584,9 @@ bool Qtilities::CoreGui::NamingPolicyFilter::initializeAttachment(QObject* obj,
 }
 
 void Qtilities::CoreGui::NamingPolicyFilter::finalizeAttachment(QObject* obj, bool attachment_successful, bool import_cycle) {
+    if (attachment_successful && d->name_index_valid)
+        indexSubjectName(obj);
+
     if (import_cycle)
         return;
 
@@ -480,6 +612,9 @@ void Qtilities::CoreGui::NamingPolicyFilter::finalizeAttachment(QObject* obj, bo
 }
 
 void Qtilities::CoreGui::NamingPolicyFilter::finalizeDetachment(QObject* obj, bool detachment_successful, bool subject_deleted) {
+    if (detachment_successful || subject_deleted)
+        unindexSubjectName(obj);
+
     if (detachment_successful && !subject_deleted)
         assignNewNameManager(obj);
 }
@@ -496,6 +631,19 @@ QStringList Qtilities::CoreGui::NamingPolicyFilter::reservedProperties() const {
     return reserved_properties;
 }
 
+qint64 Qtilities::CoreGui::NamingPolicyFilter::estimatedStateBytes() const {
+    qint64 state_bytes = MemoryUsageReport::estimatedHashBytes(d->name_index.count(),sizeof(QString) + sizeof(QList<QPointer<QObject> >))
+            + MemoryUsageReport::estimatedHashBytes(d->name_index_keys.count(),sizeof(void*) + sizeof(QString))
+            + MemoryUsageReport::estimatedHashBytes(d->validity_cache.count(),sizeof(QString) + sizeof(bool));
+    // The keys in name_index_keys share their data with the keys in name_index:
+    QHash<QString,QList<QPointer<QObject> > >::const_iterator itr = d->name_index.constBegin();
+    while (itr != d->name_index.constEnd()) {
+        state_bytes += MemoryUsageReport::estimatedStringBytes(itr.key()) + MemoryUsageReport::estimatedListBytes(itr.value().count(),sizeof(QPointer<QObject>));
+        ++itr;
+    }
+    return state_bytes;
+}
+
 bool Qtilities::CoreGui::NamingPolicyFilter::handleMonitoredPropertyChange(QObject* obj, const char* property_name, QDynamicPropertyChangeEvent* propertyChangeEvent) {
     if (!filter_mutex.tryLock())
         return false;
@@ -531,8 +679,10 @@ bool Qtilities::CoreGui::NamingPolicyFilter::handleMonitoredPropertyChange(QObje
                 if (!new_name.isEmpty()) {
                     QString old_name = obj->objectName();
 
-                    LOG_DEBUG("Sync'ed objectName() with qti_prop_NAME property. New name \"" + new_name + "\", Old name \"" + old_name);
+                    LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,"Sync'ed objectName() with qti_prop_NAME property. New name \"" + new_name + "\", Old name \"" + old_name);
                     obj->setObjectName(new_name);
+                    if (d->name_index_valid)
+                        indexSubjectName(obj);
 
                     // What we do here is to change the property value and filter the actual event.
                     // If we don't do this, the notifications below will happen before the property event
@@ -546,7 +696,7 @@ bool Qtilities::CoreGui::NamingPolicyFilter::handleMonitoredPropertyChange(QObje
 //                            QByteArray property_name_byte_array = QByteArray(propertyChangeEvent->propertyName().data());
 //                            QtilitiesPropertyChangeEvent* user_event = new QtilitiesPropertyChangeEvent(property_name_byte_array,observer->observerID());
 //                            QCoreApplication::postEvent(obj,user_event);
-//                            LOG_TRACE(QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(obj->objectName()));
+//                            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(obj->objectName()));
 //                        }
 //                    }
 
@@ -558,11 +708,11 @@ bool Qtilities::CoreGui::NamingPolicyFilter::handleMonitoredPropertyChange(QObje
                     // 3. Change the modification state of the filter:
                     setModificationState(true);
 
-                    // 4. Emit the dataChanged() signal on the observer context:
+                    // 4. Emit the dataChanged() signal on the observer context. Only the renamed subject needs to be refreshed when the layout did not change:
                     if (layout_changed)
                         observer->refreshViewsLayout();
                     else
-                        observer->refreshViewsData();
+                        observer->refreshViewsSubjectData(obj);
 
                     // 5. Emit the subjectNameChanged() signal:
                     emit subjectNameChanged(obj,old_name,new_name);
@@ -597,7 +747,9 @@ bool Qtilities::CoreGui::NamingPolicyFilter::handleMonitoredPropertyChange(QObje
                     layout_changed = true;
                 }
 
-                LOG_DEBUG(QString("Detected and handled qti_prop_ALIAS_MAP property change to \"%1\" within context \"%2\"").arg(observer->getMultiContextPropertyValue(obj,qti_prop_NAME).toString()).arg(observer->observerName()));
+                LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString("Detected and handled qti_prop_ALIAS_MAP property change to \"%1\" within context \"%2\"").arg(observer->getMultiContextPropertyValue(obj,qti_prop_NAME).toString()).arg(observer->observerName()));
+                if (d->name_index_valid)
+                    indexSubjectName(obj);
 
                 // We need to do some things here:
                 // 1. If enabled, post the QtilitiesPropertyChangeEvent:
@@ -606,7 +758,7 @@ bool Qtilities::CoreGui::NamingPolicyFilter::handleMonitoredPropertyChange(QObje
 //                        QByteArray property_name_byte_array = QByteArray(propertyChangeEvent->propertyName().data());
 //                        QtilitiesPropertyChangeEvent* user_event = new QtilitiesPropertyChangeEvent(property_name_byte_array,observer->observerID());
 //                        QCoreApplication::postEvent(obj,user_event);
-//                        LOG_TRACE(QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(obj->objectName()));
+//                        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Posting QtilitiesPropertyChangeEvent (property: %1) to object (%2)").arg(QString(propertyChangeEvent->propertyName().data())).arg(obj->objectName()));
 //                    }
 //                }
 
@@ -623,7 +775,7 @@ bool Qtilities::CoreGui::NamingPolicyFilter::handleMonitoredPropertyChange(QObje
                 if (layout_changed)
                     observer->refreshViewsLayout();
                 else
-                    observer->refreshViewsData();
+                    observer->refreshViewsSubjectData(obj);
 
             } else {
                 LOG_WARNING(QString(tr("Aborted qti_prop_ALIAS_MAP property change event (attempted change to \"%1\" within context \"%2\").")).arg(observer->getMultiContextPropertyValue(obj,qti_prop_NAME).toString()).arg(observer->observerName()));
@@ -898,22 +1050,27 @@ void Qtilities::CoreGui::NamingPolicyFilter::setValidator(QValidator* valid_nami
     }
 
     d->validator = valid_naming_validator;
+    d->validity_cache.clear();
 }
 
 QValidator* Qtilities::CoreGui::NamingPolicyFilter::getValidator() {
     return d->validator;
 }
 
+void Qtilities::CoreGui::NamingPolicyFilter::clearValidationCache() {
+    d->validity_cache.clear();
+}
+
 void Qtilities::CoreGui::NamingPolicyFilter::makeNameManager(QObject* obj) {
     // Ok, check if this observer context is observing this object, if not we can't make it a name manager
     MultiContextProperty observer_list = ObjectManager::getMultiContextProperty(obj,qti_prop_OBSERVER_MAP);
     if (observer_list.isValid()) {
         if (!observer_list.hasContext(observer->observerID())) {
-            LOG_DEBUG(QString(tr("Cannot make observer (%1) the name manager of object (%2). This observer is not currently observing this object.")).arg(observer->observerName()).arg(obj->objectName()));
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString(tr("Cannot make observer (%1) the name manager of object (%2). This observer is not currently observing this object.")).arg(observer->observerName()).arg(obj->objectName()));
             return;
         }
     } else {
-        LOG_DEBUG(QString(tr("Cannot make observer (%1) the name manager of object (%2). This observer is not currently observing this object.")).arg(observer->observerName()).arg(obj->objectName()));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString(tr("Cannot make observer (%1) the name manager of object (%2). This observer is not currently observing this object.")).arg(observer->observerName()).arg(obj->objectName()));
         return;
     }
 
@@ -921,7 +1078,7 @@ void Qtilities::CoreGui::NamingPolicyFilter::makeNameManager(QObject* obj) {
     SharedProperty current_manager_id = ObjectManager::getSharedProperty(obj,qti_prop_NAME_MANAGER_ID);
     if (current_manager_id.isValid()) {
         if (current_manager_id.value().toInt() == observer->observerID()) {
-            LOG_DEBUG(QString(tr("Cannot make observer (%1) the name manager of object (%2). This observer is currently the name manager for this object.")).arg(observer->observerName()).arg(obj->objectName()));
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ObserverLogTag,QString(tr("Cannot make observer (%1) the name manager of object (%2). This observer is currently the name manager for this object.")).arg(observer->observerName()).arg(obj->objectName()));
             return;
         } else {
             Observer* current_manager = OBJECT_MANAGER->observerReference(current_manager_id.value().toInt());
@@ -1010,7 +1167,7 @@ void Qtilities::CoreGui::NamingPolicyFilter::assignNewNameManager(QObject* obj)
         Observer* next_observer = 0;
         bool found = false;
         if (observer_list.isValid()) {
-            QList<quint32> keys = observer_list.contextMap().keys();
+            QList<quint32> keys = observer_list.contextIds();
             int count = keys.count();
             for (int i = 0; i < count; ++i) {
                 if ((int) keys.at(i) != observer->observerID()) {
@@ -1036,7 +1193,7 @@ void Qtilities::CoreGui::NamingPolicyFilter::assignNewNameManager(QObject* obj)
             // An alternative was not found
             obj->setProperty(qti_prop_ALIAS_MAP,QVariant());
             obj->setProperty(qti_prop_NAME_MANAGER_ID,QVariant());
-            LOG_TRACE(QString(tr("The name manager (%1) of object (%2) is not observing this object any more. An alternative name manager could not be found. This object's name won't be managed until it is attached to a new observer with a naming policy subject filter.")).arg(observer->observerName()).arg(obj->objectName()));
+            LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString(tr("The name manager (%1) of object (%2) is not observing this object any more. An alternative name manager could not be found. This object's name won't be managed until it is attached to a new observer with a naming policy subject filter.")).arg(observer->observerName()).arg(obj->objectName()));
         }
     }
 }
@@ -1258,7 +1415,7 @@ void Qtilities::CoreGui::NamingPolicyDelegate::setModelData(QWidget *editor, QAb
      QString value = lineEdit->text();
 
      if (d->observer) {
-        LOG_TRACE(QString("Naming control delegate delegated object name within context (%1).").arg(d->observer->observerName()));
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::ObserverLogTag,QString("Naming control delegate delegated object name within context (%1).").arg(d->observer->observerName()));
      }
      model->setData(index, value, Qt::EditRole);
 }
@@ -22,6 +22,8 @@
 
 #include <QItemDelegate>
 #include <QValidator>
+#include <QHash>
+#include <QPointer>
 
 namespace Qtilities {
     namespace CoreGui {
@@ -213,10 +215,12 @@ if (ObjectManager::propertyExists(obj,qti_prop_NAME)) {
             AbstractSubjectFilter::EvaluationResult evaluateAttachment(QObject* obj, QString* rejectMsg = 0, bool silent = false) const;
             bool initializeAttachment(QObject* obj, QString* rejectMsg = 0, bool import_cycle = false);
             void finalizeAttachment(QObject* obj, bool attachment_successful, bool import_cycle = false);
+            void initializeBulkAttachment(const QList<QObject*>& objects);
             void finalizeDetachment(QObject* obj, bool detachment_successful, bool subject_deleted = false);
             QString filterName() const { return QString(qti_def_FACTORY_TAG_NAMING_FILTER); }
             QStringList monitoredProperties() const;
             QStringList reservedProperties() const;
+            qint64 estimatedStateBytes() const;
         protected:
             bool handleMonitoredPropertyChange(QObject* obj, const char* property_name, QDynamicPropertyChangeEvent* propertyChangeEvent);
 
@@ -308,6 +312,20 @@ if (ObjectManager::propertyExists(obj,qti_prop_NAME)) {
               \param object The current object. When null (by default) the context is checked for \p name and if it exists, Duplicate is returned. If object is not null, the context is checked for instances of the name except for the current object.
               */
             virtual NamingPolicyFilter::NameValidity evaluateName(const QString& name, QObject* object = 0) const;
+            //! Evaluates a list of names, for example the names of a batch of subjects being imported, in the observer context in which this subject filter is installed.
+            /*!
+              Each distinct name is validated only once and the uniqueness of all names is checked in a single pass over the subject name index. A name is a Duplicate
+              when it already exists in the context, or when it appears earlier in \p names. The same validation checks as evaluateName() are performed.
+
+              \param names The names to evaluate.
+              \param conflicts When not null, the indexes in \p names of all names which are not Acceptable are appended to this list.
+              \returns The validity of each name in \p names, in the same order.
+
+              \note This function does not call evaluateName(), thus reimplementations of evaluateName() are not taken into account.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<NamingPolicyFilter::NameValidity> evaluateNames(const QStringList& names, QList<int>* conflicts = 0) const;
             //! Gets the name to be used during evaluateName() for a specific object.
             /*!
               By default an empty QString is returned and NamingPolicyFilter gets the correct name depending where this function is called.
@@ -324,10 +342,17 @@ if (ObjectManager::propertyExists(obj,qti_prop_NAME)) {
             /*!
               \note The validator can only be set when the context to which this filter is attached to has no objects attached to it.
               \note NamingPolicyFilter takes ownership of the new validator after this call.
+
+              The results of the validator are cached by name until a new validator is set. If you change the validator returned by getValidator(), call clearValidationCache().
               */
             void setValidator(QValidator* valid_naming_validator);
             //! Gets the validator used to validate names.
             QValidator* getValidator();
+            //! Clears the cached results of the validator used to validate names.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void clearValidationCache();
 
             //! Function which makes this naming policy filter the object name manager of the given object.
             void makeNameManager(QObject* obj);
@@ -411,6 +436,21 @@ if (ObjectManager::propertyExists(obj,qti_prop_NAME)) {
               */
             virtual bool validateNamePropertyChange(QObject* obj, const char* property_name);
 
+        private:
+            //! Returns true if the validation check is enabled for the current state of the observer context.
+            bool isValidationCheckEnabled(NamingPolicyFilter::ValidationCheck check) const;
+            //! Returns true if the validator accepts \p name, using the validation cache.
+            bool isValidName(const QString& name) const;
+            //! Returns the first subject, other than \p ignore_object, with the given name in this context using the subject name index.
+            QObject* indexedSubjectWithName(const QString& name, Qt::CaseSensitivity case_sensitivity, const QObject* ignore_object = 0) const;
+            //! Adds \p obj to the subject name index under its current name in this context, or moves it when its name changed.
+            void indexSubjectName(QObject* obj) const;
+            //! Removes \p obj from the subject name index.
+            void unindexSubjectName(const QObject* obj) const;
+            //! Rebuilds the subject name index when it is out of sync with the observer context.
+            void updateSubjectNameIndex() const;
+
+        protected:
             NamingPolicyFilterData* d;
         };
 
@@ -420,7 +460,8 @@ if (ObjectManager::propertyExists(obj,qti_prop_NAME)) {
           */
         struct NamingPolicyFilterData {
             NamingPolicyFilterData() : is_modified(false),
-                conflicting_object(0) { }
+                conflicting_object(0),
+                name_index_valid(false) { }
 
             bool is_modified;
             QValidator* validator;
@@ -436,6 +477,22 @@ if (ObjectManager::propertyExists(obj,qti_prop_NAME)) {
             NamingPolicyFilter::ValidationCheckFlags processing_cycle_validation_check_flags;
             //! Validation checks done while the observer context is NOT busy with a processing cycle.
             NamingPolicyFilter::ValidationCheckFlags validation_check_flags;
+            //! Maps case folded subject names in the observer context to the subjects with that name.
+            /*!
+              Used to check the uniqueness of names without building the list of all subject names.
+
+              <i>This index was added in %Qtilities v1.5.</i>
+              */
+            QHash<QString,QList<QPointer<QObject> > > name_index;
+            //! Maps subjects to the key under which they are stored in name_index.
+            QHash<const QObject*,QString> name_index_keys;
+            //! Indicates if name_index was built for the observer context.
+            bool name_index_valid;
+            //! Caches the results of validator by name. Cleared when the validator changes.
+            /*!
+              <i>This cache was added in %Qtilities v1.5.</i>
+              */
+            QHash<QString,bool> validity_cache;
         };
 
         Q_DECLARE_OPERATORS_FOR_FLAGS(NamingPolicyFilter::NameValidity)
@@ -20,6 +20,7 @@
 #include <QScrollArea>
 #include <QAction>
 #include <QToolBar>
+#include <QSet>
 
 #include <qtvariantproperty.h>
 #include <qtgroupboxpropertybrowser.h>
@@ -51,14 +52,43 @@ struct Qtilities::CoreGui::qti_private_MultiContextPropertyData {
     //! The type of this sub property.
     SubPropertyType             type;
     //! The name of the property on the active object.
-    const char*                 name;
+    QByteArray                  name;
     //! The observer ID for which the value changed in the case of MultiContextProperty properties.
     int                         observer_id;
 };
 
+namespace {
+    //! Returns a signature describing the editor used for a property.
+    /*!
+      Browser properties with the same name and signature are updated in place when an object is inspected again, which keeps their editors alive.
+      */
+    QString qti_private_PropertySignature(const QString& kind, bool enabled, int type = -1) {
+        return QString("%1:%2:%3").arg(kind).arg(enabled).arg(type);
+    }
+
+    //! Expands or collapses an item in browsers which support it.
+    void qti_private_SetBrowserItemExpanded(QtAbstractPropertyBrowser* browser, QtBrowserItem* item, bool expanded) {
+        if (!item)
+            return;
+
+        if (QtTreePropertyBrowser* tree_browser = qobject_cast<QtTreePropertyBrowser*> (browser))
+            tree_browser->setExpanded(item,expanded);
+        else if (QtButtonPropertyBrowser* button_browser = qobject_cast<QtButtonPropertyBrowser*> (browser))
+            button_browser->setExpanded(item,expanded);
+    }
+}
+
 struct Qtilities::CoreGui::ObjectDynamicPropertyBrowserPrivateData {
     QList<QtProperty*>                      top_level_properties;
     QMap<QtProperty*, qti_private_MultiContextPropertyData> multi_context_properties;
+    //! The top level properties in the browser, indexed by the dynamic property name on the object.
+    QHash<QByteArray, QtProperty*>          properties_by_name;
+    //! The dynamic property name on the object for each property created for it.
+    QHash<QtProperty*, QByteArray>          property_names;
+    //! The editor signature of each property created by the browser, see qti_private_PropertySignature().
+    QHash<QtProperty*, QString>             property_signatures;
+    //! MultiContextProperty groups for which the context values have not been decoded yet.
+    QSet<QtProperty*>                       deferred_groups;
 
     QtAbstractPropertyBrowser*              property_browser;
     QtVariantPropertyManager*               property_manager;
@@ -104,12 +134,14 @@ Qtilities::CoreGui::ObjectDynamicPropertyBrowser::ObjectDynamicPropertyBrowser(B
         QtTreePropertyBrowser* property_browser = new QtTreePropertyBrowser(this);
         property_browser->setRootIsDecorated(false);
         property_browser->setResizeMode(QtTreePropertyBrowser::ResizeToContents);
+        connect(property_browser,SIGNAL(expanded(QtBrowserItem*)),SLOT(handleBrowserItemExpanded(QtBrowserItem*)));
         d->property_browser = property_browser;
     } else if (browser_type == GroupBoxBrowser) {
         QtGroupBoxPropertyBrowser* property_browser = new QtGroupBoxPropertyBrowser(this);
         d->property_browser = property_browser;
     } else if (browser_type == ButtonBrowser) {
         QtButtonPropertyBrowser* property_browser = new QtButtonPropertyBrowser(this);
+        connect(property_browser,SIGNAL(expanded(QtBrowserItem*)),SLOT(handleBrowserItemExpanded(QtBrowserItem*)));
         d->property_browser = property_browser;
     }
 
@@ -145,11 +177,9 @@ QSize Qtilities::CoreGui::ObjectDynamicPropertyBrowser::sizeHint() const {
 }
 
 void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::clear() {
-    QListIterator<QtProperty *> it(d->top_level_properties);
-    while (it.hasNext()) {
-        d->property_browser->removeProperty(it.next());
-    }
-    d->top_level_properties.clear();
+    while (!d->top_level_properties.isEmpty())
+        deleteProperty(d->top_level_properties.last());
+    d->properties_by_name.clear();
 }
 
 void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::setNewPropertyType(ObjectManager::PropertyTypes new_property_type) {
@@ -312,7 +342,7 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::propertyChangedFromBrowse
                 }
             }
         } else if (prop_data.type == qti_private_MultiContextPropertyData::Mixed) {
-            MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(d->obj,prop_data.name);
+            MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(d->obj,prop_data.name.constData());
             multi_context_property.setValue(value,prop_data.observer_id);
             if (ObjectManager::setMultiContextProperty(d->obj,multi_context_property) && d->monitor_changes) {
                 // Connect to the IModificationNotifier interface if it exists:
@@ -364,161 +394,263 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::inspectObject(const QObje
         return;
 
     d->ignore_property_changes_from_browser_side = true;
-    clear();
 
+    // Properties which keep their name and editor type are updated in place, thus only
+    // properties which were added, removed or changed type are recreated in the browser:
     QList<QByteArray> property_names = obj->dynamicPropertyNames();
     qSort(property_names);
+    QList<QtProperty*> properties;
+    QHash<QByteArray, QtProperty*> properties_by_name;
     for (int i = 0; i < property_names.count(); ++i) {
-        QString property_name = QString(property_names.at(i).data());
+        const QByteArray& property_name = property_names.at(i);
         if (property_name.startsWith("qti.") && !d->show_qtilities_properties)
             continue;
 
-        QVariant property_variant = obj->property(property_names.at(i));
-        QVariant property_value = property_variant;
-
-        bool is_enabled = !d->read_only;
-        QtProperty *dynamic_property = 0;
-        // If it is MultiContextProperty or SharedProperty then we need to handle it:
-        if (property_variant.isValid() && property_variant.canConvert<SharedProperty>()) {
-            SharedProperty shared_property = (property_variant.value<SharedProperty>());
-            if (shared_property.isReserved() || shared_property.isReadOnly() || d->read_only)
-                is_enabled = false;
-            property_value = shared_property.value();
-
-            // We handle some specific Qtilities properties in a special way:
-            if (!strcmp(property_names.at(i).data(),qti_prop_PARENT_ID) ||
-                !strcmp(property_names.at(i).data(),qti_prop_NAME_MANAGER_ID)) {
-                    int observer_id = property_value.toInt();
-                    if (observer_id == -1) {
-                        property_value = QLatin1String("None");
-                    } else {
-                        Observer* obs = OBJECT_MANAGER->observerReference(observer_id);
-                        if (obs)
-                            property_value = obs->observerName();
-                        else
-                            property_value = QLatin1String("< Unregistered Observer >");
-                    }
-            }
+        QtProperty* property = updateTopLevelProperty(obj,property_name,d->properties_by_name.take(property_name));
+        if (property) {
+            properties.append(property);
+            properties_by_name[property_name] = property;
+        }
+    }
 
-            // Now add the property:
-            if (is_enabled) {
-                if (d->property_manager->isPropertyTypeSupported(property_value.type())) {
-                   dynamic_property = d->property_manager->addProperty(property_value.type(), property_name);
-
-                    if (dynamic_property) {
-                        d->property_manager->setValue(dynamic_property,property_value);
-                        d->top_level_properties.append(dynamic_property);
-                        d->property_browser->addProperty(dynamic_property);
-                        qti_private_MultiContextPropertyData prop_data;
-                        prop_data.name = property_names.at(i).data();
-                        prop_data.type = qti_private_MultiContextPropertyData::Shared;
-                        d->multi_context_properties[dynamic_property] = prop_data;
-                    }
-                } else {
-                    dynamic_property = d->property_manager_read_only->addProperty(QVariant::String, property_name);
-                    d->property_manager_read_only->setValue(dynamic_property,QLatin1String("< Unknown Type >"));
-                    dynamic_property->setEnabled(false);
-                    d->top_level_properties.append(dynamic_property);
-                    d->property_browser->addProperty(dynamic_property);
-                }
-            } else {
-                if (d->property_manager_read_only->isPropertyTypeSupported(property_value.type())) {
-                    dynamic_property = d->property_manager_read_only->addProperty(property_value.type(), property_name);
-
-                    if (dynamic_property) {
-                        d->property_manager_read_only->setValue(dynamic_property,property_value);
-                        d->top_level_properties.append(dynamic_property);
-                        d->property_browser->addProperty(dynamic_property);
-                        qti_private_MultiContextPropertyData prop_data;
-                        prop_data.name = property_names.at(i).data();
-                        prop_data.type = qti_private_MultiContextPropertyData::Shared;
-                        d->multi_context_properties[dynamic_property] = prop_data;
-                    }
+    // Properties which are no longer present on the object:
+    foreach (QtProperty* property, d->properties_by_name)
+        deleteProperty(property);
+
+    QSet<QtProperty*> shown_properties = d->top_level_properties.toSet();
+    QtProperty* previous_property = 0;
+    foreach (QtProperty* property, properties) {
+        if (!shown_properties.contains(property)) {
+            QtBrowserItem* item = d->property_browser->insertProperty(property,previous_property);
+            if (d->deferred_groups.contains(property))
+                qti_private_SetBrowserItemExpanded(d->property_browser,item,false);
+        }
+        previous_property = property;
+    }
+
+    d->top_level_properties = properties;
+    d->properties_by_name = properties_by_name;
+    d->ignore_property_changes_from_browser_side = false;
+}
+
+QtProperty* Qtilities::CoreGui::ObjectDynamicPropertyBrowser::updateTopLevelProperty(const QObject* obj, const QByteArray& name, QtProperty* existing_property) {
+    QString property_name = QString(name.data());
+    QVariant property_variant = obj->property(name);
+    QVariant property_value = property_variant;
+
+    bool is_enabled = !d->read_only;
+    bool is_shared = false;
+    // If it is MultiContextProperty or SharedProperty then we need to handle it:
+    if (property_variant.isValid() && property_variant.canConvert<SharedProperty>()) {
+        SharedProperty shared_property = (property_variant.value<SharedProperty>());
+        if (shared_property.isReserved() || shared_property.isReadOnly() || d->read_only)
+            is_enabled = false;
+        property_value = shared_property.value();
+        is_shared = true;
+
+        // We handle some specific Qtilities properties in a special way:
+        if (!strcmp(name.data(),qti_prop_PARENT_ID) ||
+            !strcmp(name.data(),qti_prop_NAME_MANAGER_ID)) {
+                int observer_id = property_value.toInt();
+                if (observer_id == -1) {
+                    property_value = QLatin1String("None");
                 } else {
-                    dynamic_property = d->property_manager_read_only->addProperty(QVariant::String, property_name);
-                    d->property_manager_read_only->setValue(dynamic_property,QLatin1String("< Unknown Type >"));
-                    dynamic_property->setEnabled(false);
-                    d->top_level_properties.append(dynamic_property);
-                    d->property_browser->addProperty(dynamic_property);
-                }
-            }
-        } else if (property_variant.isValid() && property_variant.canConvert<MultiContextProperty>()) {
-            MultiContextProperty multi_context_property = (property_variant.value<MultiContextProperty>());
-            if (multi_context_property.isReserved() || multi_context_property.isReadOnly() || d->read_only)
-                is_enabled = false;
-
-            // Now make a group property with the values for all the different contexts under it:
-            dynamic_property = d->property_manager->addProperty(QtVariantPropertyManager::groupTypeId(), property_name);
-            if (dynamic_property) {
-                QMap<quint32,QVariant> context_map = multi_context_property.contextMap();
-                QList<quint32> keys = context_map.keys();
-                int count = keys.count();
-                for (int s = 0; s < count; s++) {
-                    QVariant sub_property_value = context_map.values().at(s);
-                    Observer* obs = OBJECT_MANAGER->observerReference((int) keys.at(s));
-                    QString context_name = QString::number(keys.at(s));
+                    Observer* obs = OBJECT_MANAGER->observerReference(observer_id);
                     if (obs)
-                        context_name = obs->observerName() + " (" + QString::number(obs->observerID()) + ")";
-
-                    QtProperty* sub_property = 0;
-                    if (is_enabled) {
-                        if (!d->property_manager->isPropertyTypeSupported(sub_property_value.type())) {
-                            sub_property = d->property_manager_read_only->addProperty(QVariant::String, context_name);
-                            if (sub_property)
-                                d->property_manager_read_only->setValue(sub_property,QLatin1String("< Unknown Type >"));
-                        } else {
-                            sub_property = d->property_manager->addProperty(sub_property_value.type(), context_name);
-                            if (sub_property)
-                                d->property_manager->setValue(sub_property,sub_property_value);
-                        }
-                    } else {
-                        if (!d->property_manager_read_only->isPropertyTypeSupported(sub_property_value.type())) {
-                            sub_property = d->property_manager_read_only->addProperty(QVariant::String, context_name);
-                            d->property_manager_read_only->setValue(sub_property,QLatin1String("< Unknown Type >"));
-                            sub_property->setEnabled(false);
-                        } else {
-                            sub_property = d->property_manager_read_only->addProperty(sub_property_value.type(), context_name);
-                            if (sub_property)
-                                d->property_manager_read_only->setValue(sub_property,sub_property_value);
-                        }
-
-                    }
-
-                    if (sub_property) {
-                        dynamic_property->addSubProperty(sub_property);
-                        qti_private_MultiContextPropertyData prop_data;
-                        prop_data.name = property_names.at(i).data();
-                        prop_data.type = qti_private_MultiContextPropertyData::Mixed;
-                        prop_data.observer_id = (int) keys.at(s);
-                        d->multi_context_properties[sub_property] = prop_data;
-                    }
+                        property_value = obs->observerName();
+                    else
+                        property_value = QLatin1String("< Unregistered Observer >");
                 }
+        }
+    } else if (property_variant.isValid() && property_variant.canConvert<MultiContextProperty>()) {
+        MultiContextProperty multi_context_property = (property_variant.value<MultiContextProperty>());
+        if (multi_context_property.isReserved() || multi_context_property.isReadOnly() || d->read_only)
+            is_enabled = false;
+
+        // Make a group property with the values for all the different contexts under it. The context
+        // values are only decoded once the group is expanded:
+        QString signature = qti_private_PropertySignature("multi",is_enabled);
+        if (existing_property && d->property_signatures.value(existing_property) == signature) {
+            if (!d->deferred_groups.contains(existing_property))
+                populateMultiContextGroup(existing_property);
+            return existing_property;
+        }
 
-                d->top_level_properties.append(dynamic_property);
-                d->property_browser->addProperty(dynamic_property);
-            }
+        if (existing_property)
+            deleteProperty(existing_property);
+
+        QtProperty* group_property = d->property_manager->addProperty(QtVariantPropertyManager::groupTypeId(), property_name);
+        if (!group_property)
+            return 0;
+
+        d->property_signatures[group_property] = signature;
+        d->property_names[group_property] = name;
+        deferMultiContextGroup(group_property);
+        return group_property;
+    }
+
+    QtVariantPropertyManager* manager = is_enabled ? d->property_manager : d->property_manager_read_only;
+    bool is_supported = manager->isPropertyTypeSupported(property_value.type());
+    QString signature;
+    if (is_supported)
+        signature = qti_private_PropertySignature(is_shared ? "shared" : "plain",is_enabled,property_value.type());
+    else
+        signature = qti_private_PropertySignature("unknown",false);
+
+    if (existing_property && d->property_signatures.value(existing_property) == signature) {
+        QtVariantPropertyManager* existing_manager = qobject_cast<QtVariantPropertyManager*> (existing_property->propertyManager());
+        if (existing_manager && is_supported)
+            existing_manager->setValue(existing_property,property_value);
+        return existing_property;
+    }
+
+    if (existing_property)
+        deleteProperty(existing_property);
+
+    // Now add the property:
+    QtProperty* dynamic_property = 0;
+    if (is_supported) {
+        dynamic_property = manager->addProperty(property_value.type(), property_name);
+        if (dynamic_property)
+            manager->setValue(dynamic_property,property_value);
+    } else {
+        dynamic_property = d->property_manager_read_only->addProperty(QVariant::String, property_name);
+        if (dynamic_property) {
+            d->property_manager_read_only->setValue(dynamic_property,QLatin1String("< Unknown Type >"));
+            dynamic_property->setEnabled(false);
+        }
+    }
+
+    if (!dynamic_property)
+        return 0;
+
+    d->property_signatures[dynamic_property] = signature;
+    d->property_names[dynamic_property] = name;
+    if (is_shared && is_supported) {
+        qti_private_MultiContextPropertyData prop_data;
+        prop_data.name = name;
+        prop_data.type = qti_private_MultiContextPropertyData::Shared;
+        d->multi_context_properties[dynamic_property] = prop_data;
+    }
+
+    return dynamic_property;
+}
+
+void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::deferMultiContextGroup(QtProperty* group_property) {
+    // Group box browsers can't collapse their groups, thus the values are decoded immediately:
+    if (qobject_cast<QtGroupBoxPropertyBrowser*> (d->property_browser)) {
+        populateMultiContextGroup(group_property);
+        return;
+    }
+
+    // A placeholder makes the group expandable until the context values are decoded:
+    QtProperty* placeholder = d->property_manager_read_only->addProperty(QVariant::String, tr("Contexts"));
+    if (placeholder) {
+        d->property_manager_read_only->setValue(placeholder,tr("< Expand To Load >"));
+        placeholder->setEnabled(false);
+        group_property->addSubProperty(placeholder);
+    }
+    d->deferred_groups.insert(group_property);
+}
+
+void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::populateMultiContextGroup(QtProperty* group_property) {
+    if (!d->obj)
+        return;
+
+    QByteArray name = d->property_names.value(group_property);
+    MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(d->obj,name.constData());
+    bool is_enabled = !(multi_context_property.isReserved() || multi_context_property.isReadOnly() || d->read_only);
+    QtVariantPropertyManager* manager = is_enabled ? d->property_manager : d->property_manager_read_only;
+
+    // Existing context values are reused when their type did not change:
+    QMap<int, QtProperty*> existing_sub_properties;
+    foreach (QtProperty* sub_property, group_property->subProperties()) {
+        if (d->multi_context_properties.contains(sub_property))
+            existing_sub_properties[d->multi_context_properties[sub_property].observer_id] = sub_property;
+        else
+            deleteProperty(sub_property);
+    }
+    d->deferred_groups.remove(group_property);
+
+    QtProperty* previous_sub_property = 0;
+    QMapIterator<quint32,QVariant> itr(multi_context_property.contextMap());
+    while (itr.hasNext()) {
+        itr.next();
+        int observer_id = (int) itr.key();
+        QVariant sub_property_value = itr.value();
+        Observer* obs = OBJECT_MANAGER->observerReference(observer_id);
+        QString context_name = QString::number(itr.key());
+        if (obs)
+            context_name = obs->observerName() + " (" + QString::number(obs->observerID()) + ")";
+
+        bool is_supported = manager->isPropertyTypeSupported(sub_property_value.type());
+        QString signature;
+        if (is_supported)
+            signature = qti_private_PropertySignature("mixed",is_enabled,sub_property_value.type());
+        else
+            signature = qti_private_PropertySignature("unknown",false);
+
+        QtProperty* sub_property = existing_sub_properties.take(observer_id);
+        if (sub_property && d->property_signatures.value(sub_property) == signature) {
+            QtVariantPropertyManager* existing_manager = qobject_cast<QtVariantPropertyManager*> (sub_property->propertyManager());
+            if (existing_manager && is_supported)
+                existing_manager->setValue(sub_property,sub_property_value);
+            if (sub_property->propertyName() != context_name)
+                sub_property->setPropertyName(context_name);
         } else {
-            // Now add the property:
-            if (d->property_manager->isPropertyTypeSupported(property_value.type())) {
-                if (is_enabled)
-                    dynamic_property = d->property_manager->addProperty(property_value.type(), property_name);
-                else
-                    dynamic_property = d->property_manager_read_only->addProperty(property_value.type(), property_name);
-                if (dynamic_property) {
-                    d->property_manager->setValue(dynamic_property,property_value);
-                    d->top_level_properties.append(dynamic_property);
-                    d->property_browser->addProperty(dynamic_property);
-                }
+            if (sub_property)
+                deleteProperty(sub_property);
+
+            if (is_supported) {
+                sub_property = manager->addProperty(sub_property_value.type(), context_name);
+                if (sub_property)
+                    manager->setValue(sub_property,sub_property_value);
             } else {
-                dynamic_property = d->property_manager_read_only->addProperty(QVariant::String, property_name);
-                d->property_manager_read_only->setValue(dynamic_property,QLatin1String("< Unknown Type >"));
-                dynamic_property->setEnabled(false);
-                d->top_level_properties.append(dynamic_property);
-                d->property_browser->addProperty(dynamic_property);
+                sub_property = d->property_manager_read_only->addProperty(QVariant::String, context_name);
+                if (sub_property) {
+                    d->property_manager_read_only->setValue(sub_property,QLatin1String("< Unknown Type >"));
+                    sub_property->setEnabled(false);
+                }
             }
+
+            if (!sub_property)
+                continue;
+
+            d->property_signatures[sub_property] = signature;
+            qti_private_MultiContextPropertyData prop_data;
+            prop_data.name = name;
+            prop_data.type = qti_private_MultiContextPropertyData::Mixed;
+            prop_data.observer_id = observer_id;
+            d->multi_context_properties[sub_property] = prop_data;
+            group_property->insertSubProperty(sub_property,previous_sub_property);
         }
+        previous_sub_property = sub_property;
     }
 
+    // Contexts which are no longer part of the property:
+    foreach (QtProperty* sub_property, existing_sub_properties)
+        deleteProperty(sub_property);
+}
+
+void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::deleteProperty(QtProperty* property) {
+    foreach (QtProperty* sub_property, property->subProperties())
+        deleteProperty(sub_property);
+
+    d->top_level_properties.removeOne(property);
+    d->multi_context_properties.remove(property);
+    d->property_names.remove(property);
+    d->property_signatures.remove(property);
+    d->deferred_groups.remove(property);
+    // Deleting the property removes it from its parent and from the browser:
+    delete property;
+}
+
+void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::handleBrowserItemExpanded(QtBrowserItem* item) {
+    if (!item || !d->deferred_groups.contains(item->property()))
+        return;
+
+    d->ignore_property_changes_from_browser_side = true;
+    populateMultiContextGroup(item->property());
     d->ignore_property_changes_from_browser_side = false;
 }
 
@@ -558,7 +690,7 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::handleRemoveProperty() {
         // This is an observer property:
         qti_private_MultiContextPropertyData prop_data = d->multi_context_properties[property];
         if (prop_data.type == qti_private_MultiContextPropertyData::Shared) {
-            SharedProperty shared_property = ObjectManager::getSharedProperty(d->obj,prop_data.name);
+            SharedProperty shared_property = ObjectManager::getSharedProperty(d->obj,prop_data.name.constData());
             if (shared_property.isReserved()) {
                 QMessageBox msgBox;
                 msgBox.setIcon(QMessageBox::Information);
@@ -572,12 +704,12 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::handleRemoveProperty() {
                 msgBox.setText(tr("The selected property is not removable, thus you can't delete it."));
                 msgBox.exec();
             } else {
-                d->obj->setProperty(prop_data.name,QVariant());
+                d->obj->setProperty(prop_data.name.constData(),QVariant());
                 refresh();
                 emit propertyRemoved(property->propertyName());
             }
         } else if (prop_data.type == qti_private_MultiContextPropertyData::Mixed) {
-            MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(d->obj,prop_data.name);
+            MultiContextProperty multi_context_property = ObjectManager::getMultiContextProperty(d->obj,prop_data.name.constData());
             if (multi_context_property.isReserved()) {
                 QMessageBox msgBox;
                 msgBox.setIcon(QMessageBox::Information);
@@ -591,12 +723,12 @@ void Qtilities::CoreGui::ObjectDynamicPropertyBrowser::handleRemoveProperty() {
                 msgBox.setText(tr("The selected property is not removable, thus you can't delete it."));
                 msgBox.exec();
             } else {
-                d->obj->setProperty(prop_data.name,QVariant());
+                d->obj->setProperty(prop_data.name.constData(),QVariant());
                 refresh();
                 emit propertyRemoved(property->propertyName());
             }
         }
-    } else {
+    } else if (d->top_level_properties.contains(property)) {
         // This is a normal property on the object:
         d->obj->setProperty(property_name,QVariant());
         refresh();
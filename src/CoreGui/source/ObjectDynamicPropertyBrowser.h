@@ -182,6 +182,8 @@ namespace Qtilities {
             void handleObjectDeleted();
             void handleAddProperty();
             void handleRemoveProperty();
+            //! Decodes the context values of a MultiContextProperty group the first time it is expanded.
+            void handleBrowserItemExpanded(QtBrowserItem* item);
 
         signals:
             void propertyAdded(const QString& property_name);
@@ -189,7 +191,18 @@ namespace Qtilities {
 
         private:
             //! Inspect the dynamic properties of an object and add these properties to the property browser.
+            /*!
+              Properties which keep their name and editor type between calls are updated in place, thus their editors are reused.
+              */
             void inspectObject(const QObject* obj);
+            //! Updates or creates the browser property for a single dynamic property on \p obj and returns it.
+            QtProperty* updateTopLevelProperty(const QObject* obj, const QByteArray& name, QtProperty* existing_property);
+            //! Adds a placeholder to a MultiContextProperty group which is replaced by the context values once the group is expanded.
+            void deferMultiContextGroup(QtProperty* group_property);
+            //! Decodes the context values of a MultiContextProperty group, reusing sub properties which did not change type.
+            void populateMultiContextGroup(QtProperty* group_property);
+            //! Deletes a property and its sub properties, removing them from the browser and the private data.
+            void deleteProperty(QtProperty* property);
 
             ObjectDynamicPropertyBrowserPrivateData* d;
         };
@@ -46,6 +46,7 @@
 #include <QMessageBox>
 #include <QApplication>
 #include <QClipboard>
+#include <QSet>
 
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::CoreGui::Icons;
@@ -56,10 +57,38 @@ using namespace Qtilities::Core;
 QPointer<Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget> Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::currentWidget;
 QPointer<Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget> Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::actionContainerWidget;
 
+namespace {
+    // An object shown in the tree, together with its item and the category under which it is shown:
+    struct ObjectInfoItem {
+        ObjectInfoItem() : item(0) {}
+
+        QPointer<QObject> obj;
+        QTreeWidgetItem* item;
+        QString category;
+    };
+
+    // Gets the category under which an object is shown using its qti_prop_CATEGORY_MAP property:
+    QString qti_private_objectInfoCategory(QObject* obj) {
+        QVariant prop = obj->property(qti_prop_CATEGORY_MAP);
+        if (prop.isValid() && prop.canConvert<SharedProperty>()) {
+            SharedProperty observer_property = prop.value<SharedProperty>();
+            if (observer_property.isValid())
+                return observer_property.value().toString();
+        }
+        return QString();
+    }
+}
+
 struct Qtilities::CoreGui::qti_private_ObjectInfoTreeWidgetPrivateData {
     qti_private_ObjectInfoTreeWidgetPrivateData() : paste_enabled(false) {}
 
     bool paste_enabled;
+    //! The top level category items, by category name.
+    QHash<QString,QTreeWidgetItem*> category_items;
+    //! The objects shown in the tree.
+    QHash<const QObject*,ObjectInfoItem> object_items;
+    //! Object items of which the meta information is only added when they are expanded for the first time.
+    QHash<QTreeWidgetItem*,QPointer<QObject> > unpopulated_items;
 };
 
 Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::qti_private_ObjectInfoTreeWidget(QWidget *parent) : QTreeWidget(parent) {
@@ -69,6 +98,10 @@ Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::qti_private_ObjectInfoTree
     setSortingEnabled(true);
     headerItem()->setText(0,tr("Registered Objects"));
     currentWidget = 0;
+
+    connect(this,SIGNAL(itemExpanded(QTreeWidgetItem*)),SLOT(handleItemExpanded(QTreeWidgetItem*)));
+    // QTreeWidget::clear() resets the model, after which none of the items we know about exist:
+    connect(model(),SIGNAL(modelReset()),SLOT(handleModelReset()));
 }
 
 Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::~qti_private_ObjectInfoTreeWidget() {
@@ -97,53 +130,85 @@ void Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::mousePressEvent(QMous
 }
 
 void Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::setObjectMap(QMap<QPointer<QObject>, QString> object_map) {
-   clear();
+    // The tree is updated incrementally: Items of objects which are already shown under the correct category are kept,
+    // only items of objects which were added, removed or moved to a different category are changed.
+    setSortingEnabled(false);
 
     // Build up a tree using the object map
     // Check all the categories by looking at the qti_prop_CATEGORY_MAP observer property on the objects.
-    // Objects without a category property will not be shown
-    QList<QTreeWidgetItem *> items;
-    for (int i = 0; i < object_map.count(); i++) {
-        if (!object_map.keys().at(i))
-            break;
-
-        QTreeWidgetItem* item = 0;
-        QString category_string = tr("More...");
-        QVariant prop = object_map.keys().at(i)->property(qti_prop_CATEGORY_MAP);
-        if (prop.isValid() && prop.canConvert<SharedProperty>()) {
-            SharedProperty observer_property =  prop.value<SharedProperty>();
-            if (observer_property.isValid()) {
-                // Check if the top level category already exists
-                category_string = observer_property.value().toString();
+    QSet<const QObject*> current_objects;
+    QMap<QPointer<QObject>, QString>::const_iterator itr;
+    for (itr = object_map.constBegin(); itr != object_map.constEnd(); ++itr) {
+        QObject* obj = itr.key();
+        if (!obj)
+            continue;
+        current_objects.insert(obj);
+
+        QString category_string = qti_private_objectInfoCategory(obj);
+        if (category_string.isEmpty())
+            category_string = tr("More...");
+
+        // Objects can be deleted and new objects created at the same address, thus we check the guarded pointer as well:
+        ObjectInfoItem object_item = d->object_items.value(obj);
+        if (object_item.item) {
+            if (object_item.obj == obj && object_item.category == category_string) {
+                if (object_item.item->text(0) != itr.value())
+                    object_item.item->setText(0,itr.value());
+                continue;
             }
+            d->unpopulated_items.remove(object_item.item);
+            delete object_item.item;
         }
 
-        for (int t = 0; t < topLevelItemCount(); t++) {
-            if (topLevelItem(t)->text(0) == category_string)
-                item = topLevelItem(t);
-        }
-        if (!item) {
-            item = new QTreeWidgetItem((QTreeWidget*)0, QStringList(category_string));
+        QTreeWidgetItem* category_item = d->category_items.value(category_string);
+        if (!category_item) {
+            category_item = new QTreeWidgetItem((QTreeWidget*)0, QStringList(category_string));
             // If we use this widget in the future: TODO: rather use QFileIconProvider::Folder;
-            item->setData(0,Qt::DecorationRole,QIcon(QString(qti_icon_FOLDER_16X16)));
-            items.append(item);
+            category_item->setData(0,Qt::DecorationRole,QIcon(QString(qti_icon_FOLDER_16X16)));
+            d->category_items[category_string] = category_item;
+            addTopLevelItem(category_item);
         }
 
-        addTopLevelItem(item);
-
-        // Add this object to the category item
-        QTreeWidgetItem* child = new QTreeWidgetItem((QTreeWidget*)0, QStringList(object_map.values().at(i)));
-        item->addChild(child);
-
-        // Populate the child item
-        populateItem(child,object_map.keys().at(i));
+        // Add this object to the category item. The item is populated when it is expanded:
+        QTreeWidgetItem* child = new QTreeWidgetItem((QTreeWidget*)0, QStringList(itr.value()));
+        child->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+        category_item->addChild(child);
+        d->unpopulated_items[child] = obj;
 
         // Check if it has the OBJECT_ICON shared property set.
-        prop = object_map.keys().at(i)->property(qti_prop_DECORATION);
+        QVariant prop = obj->property(qti_prop_DECORATION);
         if (prop.isValid() && prop.canConvert<SharedProperty>())
             child->setIcon(0,(prop.value<SharedProperty>().value().value<QIcon>()));
+
+        object_item.obj = obj;
+        object_item.item = child;
+        object_item.category = category_string;
+        d->object_items[obj] = object_item;
     }
+
+    // Remove the items of objects which are not in the map anymore:
+    QMutableHashIterator<const QObject*,ObjectInfoItem> object_itr(d->object_items);
+    while (object_itr.hasNext()) {
+        object_itr.next();
+        if (current_objects.contains(object_itr.key()) && object_itr.value().obj)
+            continue;
+        d->unpopulated_items.remove(object_itr.value().item);
+        delete object_itr.value().item;
+        object_itr.remove();
+    }
+
+    // Remove categories which are empty:
+    QMutableHashIterator<QString,QTreeWidgetItem*> category_itr(d->category_items);
+    while (category_itr.hasNext()) {
+        category_itr.next();
+        if (category_itr.value()->childCount() == 0) {
+            delete category_itr.value();
+            category_itr.remove();
+        }
+    }
+
     expandToDepth(0);
+    setSortingEnabled(true);
     sortItems(0,Qt::AscendingOrder);
 }
 
@@ -201,6 +266,22 @@ void Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::handle_actionPaste_tr
     }
 }
 
+void Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::handleItemExpanded(QTreeWidgetItem* item) {
+    if (!d->unpopulated_items.contains(item))
+        return;
+
+    QPointer<QObject> obj = d->unpopulated_items.take(item);
+    item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
+    if (obj)
+        populateItem(item,obj);
+}
+
+void Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::handleModelReset() {
+    d->category_items.clear();
+    d->object_items.clear();
+    d->unpopulated_items.clear();
+}
+
 void Qtilities::CoreGui::qti_private_ObjectInfoTreeWidget::populateItem(QTreeWidgetItem* item, QObject* obj) {
     // Add the following categories:
     // 1. Methods (Signals and Slots)
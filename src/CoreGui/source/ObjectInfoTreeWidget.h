@@ -70,6 +70,9 @@ namespace Qtilities {
             enum MetaCategory { Event, Property, Method, Dependancy, Source };
 
             //! Sets the QMap which contains the object references of objects to be displayed in the tree as keys and the names by which these objects are known in the script backend as values.
+            /*!
+              The tree is updated incrementally, thus items of objects which were already shown are kept. The meta information of an object is added to its item when the item is expanded for the first time.
+              */
             virtual void setObjectMap(QMap<QPointer<QObject>, QString> object_map);
             //! Sets the hierarchy depth to be displayed. When > 0, the tree model will check if any objects are observers and expand their children as well, with the depth of to be expanded being equal to the hierachy depth.
             void setHierarchyDepth(int depth);
@@ -86,11 +89,17 @@ namespace Qtilities {
             void handle_actionPaste_triggered();
 
         signals:
-            //! Emits a signal with an object reference and tree widget item. This signal is emitted when the tree is build. Thus you can add additional categories to a tree widget item based on the object reference.
+            //! Emits a signal with an object reference and tree widget item. This signal is emitted when the item of an object is populated, which happens when it is expanded for the first time. Thus you can add additional categories to a tree widget item based on the object reference.
             void populateTreeItem(QObject* obj, QTreeWidgetItem* item);
             //! Emits a signal which notifies classes which inherit from qti_private_ObjectInfoTreeWidget of data pasted in this widget.
             void pasteActionOccured(const ObserverMimeData* paste_mime_data);
 
+        private slots:
+            //! Populates the item of an object when it is expanded for the first time.
+            void handleItemExpanded(QTreeWidgetItem* item);
+            //! Forgets about all items when the tree is cleared.
+            void handleModelReset();
+
         private:
             void populateItem(QTreeWidgetItem* item, QObject* obj);
 
@@ -109,17 +109,8 @@ QtAbstractPropertyBrowser *Qtilities::CoreGui::ObjectPropertyBrowser::abstractPr
 
 void Qtilities::CoreGui::ObjectPropertyBrowser::refresh(bool has_changes) {
     if (d->obj && has_changes) {
-        if (d->obj) {
-            QListIterator<QtProperty *> it(d->top_level_properties);
-            while (it.hasNext()) {
-                d->property_browser->removeProperty(it.next());
-            }
-            d->top_level_properties.clear();
-            d->obj->disconnect(this);
-        }
-
         d->ignore_property_changes = true;
-        inspectClass(d->obj->metaObject());
+        inspectObject();
         d->ignore_property_changes = false;
     }
 }
@@ -147,18 +138,19 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::setObject(QObject *object, bool
     if (d->obj == object)
         return;
 
-    if (d->obj) {
+    if (d->obj)
+        d->obj->disconnect(this);
+
+    // The class groups of the previous object are kept until inspectObject() compared them to those of the new object:
+    d->obj = object;
+    if (!d->obj) {
         QListIterator<QtProperty *> it(d->top_level_properties);
         while (it.hasNext()) {
             d->property_browser->removeProperty(it.next());
         }
         d->top_level_properties.clear();
-        d->obj->disconnect(this);
-    }
-
-    d->obj = object;
-    if (!d->obj)
         return;
+    }
 
     if (monitor_changes) {
         IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (d->obj);
@@ -172,7 +164,7 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::setObject(QObject *object, bool
 
     connect(d->obj,SIGNAL(destroyed()),SLOT(handleObjectDeleted()));
     d->ignore_property_changes = true;
-    inspectClass(d->obj->metaObject());
+    inspectObject();
     d->ignore_property_changes = false;
 }
 
@@ -209,7 +201,7 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::setFilterList(QStringList filter
     d->top_level_properties.clear();
 
     if (d->obj)
-        inspectClass(d->obj->metaObject());
+        inspectObject();
 }
 
 QStringList Qtilities::CoreGui::ObjectPropertyBrowser::filterList() const {
@@ -229,7 +221,7 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::clearFilter() {
     d->top_level_properties.clear();
 
     if (d->obj)
-        inspectClass(d->obj->metaObject());
+        inspectObject();
 }
 
 void Qtilities::CoreGui::ObjectPropertyBrowser::setFilterListInversed(bool toggle) {
@@ -248,7 +240,7 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::setFilterListInversed(bool toggl
         d->top_level_properties.clear();
 
         if (d->obj)
-            inspectClass(d->obj->metaObject());
+            inspectObject();
     }
 }
 
@@ -397,7 +389,24 @@ void Qtilities::CoreGui::ObjectPropertyBrowser::inspectClass(const QMetaObject *
     }
 
     d->top_level_properties.append(single_property);
-    d->property_browser->addProperty(single_property);
+}
+
+void Qtilities::CoreGui::ObjectPropertyBrowser::inspectObject() {
+    QList<QtProperty *> shown_properties = d->top_level_properties;
+    d->top_level_properties.clear();
+    inspectClass(d->obj->metaObject());
+
+    // Class groups are cached per meta object, thus objects sharing base classes share a prefix of groups.
+    // Those groups keep their browser items and editors, only the groups after the first difference are replaced:
+    int common_count = 0;
+    while (common_count < shown_properties.count() && common_count < d->top_level_properties.count()
+           && shown_properties.at(common_count) == d->top_level_properties.at(common_count))
+        ++common_count;
+
+    for (int i = shown_properties.count() - 1; i >= common_count; --i)
+        d->property_browser->removeProperty(shown_properties.at(i));
+    for (int i = common_count; i < d->top_level_properties.count(); ++i)
+        d->property_browser->addProperty(d->top_level_properties.at(i));
 }
 
 void Qtilities::CoreGui::ObjectPropertyBrowser::refreshClass(const QMetaObject *metaObject, bool recursive) {
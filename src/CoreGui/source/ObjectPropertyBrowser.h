@@ -155,6 +155,8 @@ namespace Qtilities {
         private:
             //! Inspect the meta object of a class to see which properties must be added, then add these properties
             void inspectClass(const QMetaObject *metaObject);
+            //! Inspects the class hierarchy of the current object and updates the top level properties in the browser, reusing groups which are already shown.
+            void inspectObject();
             void refreshClass(const QMetaObject *metaObject, bool recursive);
             int enumToInt(const QMetaEnum &metaEnum, int enumValue) const;
             int intToEnum(const QMetaEnum &metaEnum, int intValue) const;
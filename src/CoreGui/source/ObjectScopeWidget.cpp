@@ -25,6 +25,7 @@
 #include <QTableWidgetItem>
 #include <QCheckBox>
 #include <QMessageBox>
+#include <QShowEvent>
 
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::CoreGui::Actions;
@@ -39,11 +40,90 @@ namespace Qtilities {
     }
 }
 
+namespace {
+    // The name item of a context in the scope table. Its tool tip is only constructed when it is requested, since
+    // objects can be attached to many contexts and tool tips are only shown for the item under the mouse:
+    class ScopeNameItem : public QTableWidgetItem {
+    public:
+        ScopeNameItem(Observer* observer, QObject* obj) : QTableWidgetItem(observer->observerName(),observer->observerID()),
+            observer(observer),
+            obj(obj),
+            tooltip_valid(false) {}
+
+        QVariant data(int role) const {
+            if (role == Qt::ToolTipRole) {
+                if (!tooltip_valid) {
+                    tooltip = constructToolTip();
+                    tooltip_valid = true;
+                }
+                return tooltip;
+            }
+            return QTableWidgetItem::data(role);
+        }
+
+    private:
+        QString constructToolTip() const {
+            if (!observer || !obj)
+                return QString();
+
+            const int id = observer->observerID();
+            QString tooltip_string;
+            tooltip_string.append(QString(QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","<b>Context Name</b>: %1")).arg(observer->observerName()));
+            // Context Description
+            tooltip_string.append(QString(QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","<br><b>Context Description</b>: %1")).arg(observer->observerDescription()));
+            // Context ID
+            tooltip_string.append(QString(QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","<br><b>Context ID</b>: %1")).arg(id));
+            // Context Category
+            QString category_string = QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","None");
+            MultiContextProperty category_prop = ObjectManager::getMultiContextProperty(obj,qti_prop_CATEGORY_MAP);
+            if (category_prop.isValid() && category_prop.hasContext(id))
+                category_string = category_prop.value(id).toString();
+            tooltip_string.append(QString(QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","<br><b>Context Category</b>: %1")).arg(category_string));
+
+            // Attributes
+            tooltip_string.append(QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","<br><br><b>Attributes: </b> "));
+            // Attribute: Activity
+            QVariant activity = observer->getMultiContextPropertyValue(obj,qti_prop_ACTIVITY_MAP);
+            if (activity.isValid() && activity.toBool())
+                tooltip_string.append(QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","Active, "));
+
+            // Attribute: Object Name Controller
+            QVariant name_manager_id = observer->getMultiContextPropertyValue(obj,qti_prop_NAME_MANAGER_ID);
+            if (name_manager_id.isValid() && (name_manager_id.toInt() == id))
+                tooltip_string.append(QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","Manages Name, "));
+
+            // Attribute: Uses Instance Name
+            MultiContextProperty instance_names = ObjectManager::getMultiContextProperty(obj,qti_prop_ALIAS_MAP);
+            if (instance_names.isValid() && instance_names.hasContext(id))
+                tooltip_string.append(QString(QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","Uses Instance Name (\"%1\"), ")).arg(instance_names.value(id).toString()));
+
+            // Attribute: Ownership
+            int parent_id = ObjectManager::getSharedProperty(obj,qti_prop_PARENT_ID).value().toInt();
+            if (parent_id == id)
+                tooltip_string.append(QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","Owner"));
+
+            // Subject Filters
+            QStringList filter_names;
+            const QList<AbstractSubjectFilter*> filters = observer->subjectFilters();
+            for (int r = 0; r < filters.count(); ++r)
+                filter_names << filters.at(r)->filterName();
+            tooltip_string.append(QString(QApplication::translate("Qtilities::CoreGui::ObjectScopeWidget","<br><b>Filters</b>: %1")).arg(filter_names.join(", ")));
+            return tooltip_string;
+        }
+
+        QPointer<Observer> observer;
+        QPointer<QObject> obj;
+        mutable QString tooltip;
+        mutable bool tooltip_valid;
+    };
+}
+
 struct Qtilities::CoreGui::ObjectScopeWidgetPrivateData {
     ObjectScopeWidgetPrivateData() : actionDetachToSelection(0),
         actionRemoveContext(0),
         obj(0),
-        action_provider(0) {}
+        action_provider(0),
+        contents_dirty(false) {}
 
     QAction* actionDetachToSelection;
     QAction* actionRemoveContext;
@@ -51,7 +131,10 @@ struct Qtilities::CoreGui::ObjectScopeWidgetPrivateData {
     ActionProvider* action_provider;
     //! The global meta type string used for this widget.
     QString global_meta_type;
-
+    //! The observers of which the destroyed() signal is connected to updateContents().
+    QList<QPointer<Observer> > connected_observers;
+    //! Indicates that updateContents() was called while the widget was hidden.
+    bool contents_dirty;
 };
 
 Qtilities::CoreGui::ObjectScopeWidget::ObjectScopeWidget(QWidget *parent) :
@@ -104,8 +187,14 @@ void Qtilities::CoreGui::ObjectScopeWidget::setObject(QObject* obj) {
         return;
     }
 
-    if (d->obj)
+    // Changes to the current object are picked up by the event filter, thus selecting it again does not change anything:
+    if (obj == d->obj)
+        return;
+
+    if (d->obj) {
         d->obj->disconnect(this);
+        d->obj->removeEventFilter(this);
+    }
 
     d->obj = obj;
     d->obj->installEventFilter(this);
@@ -113,14 +202,23 @@ void Qtilities::CoreGui::ObjectScopeWidget::setObject(QObject* obj) {
     connect(d->obj,SIGNAL(destroyed(QObject*)),SLOT(handleObjectDestroyed()));
 
     // For this widget we are interested in dynamic observer property changes in ALL the observers
-    // which are observing this object
+    // which are observing this object. Observers of the previous object are disconnected:
+    QList<QPointer<Observer> > observers;
     MultiContextProperty context_map_prop = ObjectManager::getMultiContextProperty(d->obj,qti_prop_OBSERVER_MAP);
-    for (int i = 0; i < context_map_prop.contextMap().count(); ++i) {
-        Observer* observer = OBJECT_MANAGER->observerReference(context_map_prop.contextMap().keys().at(i));
-        if (observer) {
-            connect(observer,SIGNAL(destroyed()),SLOT(updateContents()),Qt::UniqueConnection);
-        }
+    const QList<int> context_ids = context_map_prop.contextIds();
+    for (int i = 0; i < context_ids.count(); ++i) {
+        Observer* observer = OBJECT_MANAGER->observerReference(context_ids.at(i));
+        if (observer)
+            observers << observer;
+    }
+    for (int i = 0; i < d->connected_observers.count(); ++i) {
+        Observer* observer = d->connected_observers.at(i);
+        if (observer && !observers.contains(observer))
+            observer->disconnect(this);
     }
+    for (int i = 0; i < observers.count(); ++i)
+        connect(observers.at(i),SIGNAL(destroyed()),SLOT(updateContents()),Qt::UniqueConnection);
+    d->connected_observers = observers;
 
     updateContents();
     refreshActions();
@@ -143,6 +241,7 @@ void Qtilities::CoreGui::ObjectScopeWidget::setObject(QList<QPointer<QObject> >
 
 void Qtilities::CoreGui::ObjectScopeWidget::handleObjectDestroyed() {
     ui->observerTable->clearContents();
+    ui->observerTable->setRowCount(0);
     ui->txtName->setText(tr("No Scope Information."));
     ui->txtObserverLimit->setText(tr("No Scope Information"));
     ui->txtOwnership->setText(tr("No Scope Information"));
@@ -188,6 +287,13 @@ void Qtilities::CoreGui::ObjectScopeWidget::updateContents() {
     if (!d->obj)
         return;
 
+    // The contents of hidden widgets are updated when they are shown, thus following the active selection is cheap while hidden:
+    if (!isVisible()) {
+        d->contents_dirty = true;
+        return;
+    }
+    d->contents_dirty = false;
+
     int observer_count = -1;
     int observer_limit = -2;
     int ownership = -1;
@@ -196,7 +302,7 @@ void Qtilities::CoreGui::ObjectScopeWidget::updateContents() {
     // Observer Count
     MultiContextProperty context_map_prop = ObjectManager::getMultiContextProperty(d->obj,qti_prop_OBSERVER_MAP);
     if (context_map_prop.isValid())
-        observer_count = context_map_prop.contextMap().count();
+        observer_count = context_map_prop.contextCount();
 
     // Observer Limit
     SharedProperty shared_property = ObjectManager::getSharedProperty(d->obj,qti_prop_OBSERVER_LIMIT);
@@ -224,89 +330,48 @@ void Qtilities::CoreGui::ObjectScopeWidget::updateContents() {
     else if (ownership == Observer::ObserverScopeOwnership)
         ui->txtOwnership->setText(tr("Observer Scope Ownership"));
 
+    // Sorting is disabled while the table is populated, otherwise rows move while they are inserted:
+    ui->observerTable->setSortingEnabled(false);
     ui->observerTable->clearContents();
-    ui->observerTable->setRowCount(observer_count);
-    QString tooltip_string;
+    ui->observerTable->setRowCount(qMax(observer_count,0));
     bool has_instance_names = false;
 
-    for (int i = 0; i < observer_count; ++i) {
-        int id = context_map_prop.contextMap().keys().at(i);
+    const QList<int> context_ids = context_map_prop.contextIds();
+    MultiContextProperty instance_names = ObjectManager::getMultiContextProperty(d->obj,qti_prop_ALIAS_MAP);
+    int row = 0;
+    for (int i = 0; i < context_ids.count(); ++i) {
+        int id = context_ids.at(i);
         Observer* observer = OBJECT_MANAGER->observerReference(id);
         if (!observer)  {
             LOG_ERROR("Object scope widget: Found invalid observer ID on object: " + d->obj->objectName());
             continue;
         }
 
-        // Observer Name
-        QTableWidgetItem *nameItem = new QTableWidgetItem(observer->observerName(), id);
-        ui->observerTable->setItem(i, 0, nameItem);
+        // Observer Name, the tool tip of the item is constructed when it is shown:
+        ui->observerTable->setItem(row, 0, new ScopeNameItem(observer,d->obj));
         if (ownership == Observer::SpecificObserverOwnership) {
             QVariant observer_parent = observer->getMultiContextPropertyValue(d->obj,qti_prop_PARENT_ID);
             if (observer_parent.isValid() && (observer_parent.toInt() == id)) {
                 QTableWidgetItem *ownerItem = new QTableWidgetItem("", id);
                 ownerItem->setIcon(QIcon(qti_icon_SUCCESS_16x16));
                 ownerItem->setToolTip(tr("This context owns the selected object (Manages its lifetime)."));
-                ui->observerTable->setItem(i, OwnerColumn, ownerItem);
+                ui->observerTable->setItem(row, OwnerColumn, ownerItem);
             }
         }
-        tooltip_string.append(QString(tr("<b>Context Name</b>: %1")).arg(observer->observerName()));
-        // Context Description
-        tooltip_string.append(QString(tr("<br><b>Context Description</b>: %1")).arg(observer->observerDescription()));
-        // Context ID
-        tooltip_string.append(QString(tr("<br><b>Context ID</b>: %1")).arg(observer->observerID()));
-        // Context Category
-        MultiContextProperty category_prop = ObjectManager::getMultiContextProperty(d->obj,qti_prop_CATEGORY_MAP);
-        QString category_string;
-        if (category_prop.isValid()) {
-            if (category_prop.contextMap().contains(observer->observerID()))
-                category_string = category_prop.value(observer->observerID()).toString();
-            else
-                category_string = tr("None");
-        } else {
-            category_string = tr("None");
-        }
-        tooltip_string.append(QString(tr("<br><b>Context Category</b>: %1")).arg(category_string));
-
-        // Attributes
-        tooltip_string.append(tr("<br><br><b>Attributes: </b> "));
-        // Attribute: Activity
-        QVariant activity = observer->getMultiContextPropertyValue(d->obj,qti_prop_ACTIVITY_MAP);
-        if (activity.isValid() && activity.toBool())
-            tooltip_string.append(tr("Active, "));
-
-        // Attribute: Object Name Controller
-        QVariant name_manager_id = observer->getMultiContextPropertyValue(d->obj,qti_prop_NAME_MANAGER_ID);
-        if (name_manager_id.isValid() && (name_manager_id.toInt() == observer->observerID()))
-            tooltip_string.append(tr("Manages Name, "));
-
-        // Attribute: Uses Instance Name
-        MultiContextProperty instance_names = ObjectManager::getMultiContextProperty(d->obj,qti_prop_ALIAS_MAP);
-        if (instance_names.isValid() && instance_names.hasContext(observer->observerID())) {
-            tooltip_string.append(QString(tr("Uses Instance Name (\"%1\"), ").arg(instance_names.value(observer->observerID()).toString())));
+
+        // Uses Instance Name
+        if (instance_names.isValid() && instance_names.hasContext(id)) {
             has_instance_names = true;
             QTableWidgetItem *aliasItem = new QTableWidgetItem("", id);
             aliasItem->setIcon(QIcon(qti_icon_SUCCESS_16x16));
             aliasItem->setToolTip(tr("This context uses an instance name (alias) for the selected object."));
-            ui->observerTable->setItem(i, UsesInstanceNameColumn, aliasItem);
-        }
-
-        // Attribute: Ownership
-        int parent_id = ObjectManager::getSharedProperty(d->obj,qti_prop_PARENT_ID).value().toInt();
-        if (parent_id == observer->observerID())
-            tooltip_string.append(tr("Owner"));
-
-        // Subject Filters
-        QString filter_name_string;
-        for (int r = 0; r < observer->subjectFilters().count(); r++) {
-            if (r == 0)
-                filter_name_string.append(observer->subjectFilters().at(r)->filterName());
-            else
-                filter_name_string.append(", " + observer->subjectFilters().at(r)->filterName());
+            ui->observerTable->setItem(row, UsesInstanceNameColumn, aliasItem);
         }
-        tooltip_string.append(QString(tr("<br><b>Filters</b>: %1")).arg(filter_name_string));
-        nameItem->setToolTip(tooltip_string);
-        tooltip_string.clear();   
+        ++row;
     }
+    // Rows of invalid observer IDs are not shown:
+    ui->observerTable->setRowCount(row);
+    ui->observerTable->setSortingEnabled(true);
 
     ui->observerTable->resizeRowsToContents();
     ui->observerTable->setColumnCount(OwnerColumn+1);
@@ -499,6 +564,12 @@ void Qtilities::CoreGui::ObjectScopeWidget::handle_currentItemChanged(QTableWidg
     refreshActions();
 }
 
+void Qtilities::CoreGui::ObjectScopeWidget::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    if (d->contents_dirty)
+        updateContents();
+}
+
 void Qtilities::CoreGui::ObjectScopeWidget::changeEvent(QEvent *e)
 {
     switch (e->type()) {
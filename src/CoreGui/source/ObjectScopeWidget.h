@@ -101,6 +101,11 @@ namespace Qtilities {
 
         protected:
             virtual void changeEvent(QEvent *e);
+            //! Updates the contents of the widget when updateContents() was called while it was hidden.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void showEvent(QShowEvent* event);
             void constructActions();
             void refreshActions();
 
@@ -125,6 +130,9 @@ namespace Qtilities {
             //! Sets the object by providing a list of smart pointers.
             void setObject(QList<QPointer<QObject> > objects);
             //! Refreshes the view.
+            /*!
+              When the widget is hidden, the view is refreshed when it is shown again.
+              */
             void updateContents();
             //! Handles the event where the current object is destroyed.
             void handleObjectDestroyed();
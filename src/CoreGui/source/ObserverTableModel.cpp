@@ -13,6 +13,7 @@
 #include "NamingPolicyFilter.h"
 #include "ActivityPolicyFilter.h"
 #include "QtilitiesCoreGuiConstants.h"
+#include "TreeItemStyleTable_p.h"
 
 #include <SubjectTypeFilter>
 #include <QtilitiesCoreConstants>
@@ -21,6 +22,7 @@
 
 #include <QIcon>
 #include <QMessageBox>
+#include <QVector>
 
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::CoreGui::Icons;
@@ -28,6 +30,33 @@ using namespace Qtilities::Core::Properties;
 using namespace Qtilities::Core;
 using namespace Qtilities::Core::Constants;
 
+namespace {
+    //! The columns which are computed once per row and kept in the row cache.
+    enum CachedColumn {
+        CachedSubject       = 1,
+        CachedName          = 2,
+        CachedCategory      = 4,
+        CachedChildCount    = 8,
+        CachedTypeInfo      = 16,
+        CachedAccess        = 32
+    };
+
+    //! The computed columns of a single row in the table.
+    struct RowCache {
+        RowCache() : cached_columns(0), subject_id(-1), access_mode(-1) {}
+
+        int                 cached_columns;
+        int                 subject_id;
+        QPointer<QObject>   object;
+        QString             name;
+        QString             category;
+        QVariant            child_count;
+        QString             type_info;
+        //! The Observer::AccessMode to display, -1 when no access icon is displayed.
+        int                 access_mode;
+    };
+}
+
 struct Qtilities::CoreGui::ObserverTableModelData {
     ObserverTableModelData() : type_grouping_name(QString()),
         read_only(false),
@@ -37,6 +66,8 @@ struct Qtilities::CoreGui::ObserverTableModelData {
     bool        read_only;
     int         fetch_count;
     QList<QPointer<QObject> > selected_objects;
+    //! The computed columns of the fetched rows, kept in the same order as the rows.
+    QVector<RowCache> row_cache;
 };
 
 #define fetch_limit 1000
@@ -67,9 +98,15 @@ bool Qtilities::CoreGui::ObserverTableModel::setObserverContext(Observer* observ
         return false;
 
     d->fetch_count = 0;
-    connect(d_observer,SIGNAL(numberOfSubjectsChanged(Observer::SubjectChangeIndication, QList<QPointer<QObject> >)),SLOT(handleLayoutChanged()));
+    d->row_cache.clear();
+    connect(d_observer,SIGNAL(subjectsInserted(int,int)),SLOT(handleSubjectsInserted(int,int)));
+    connect(d_observer,SIGNAL(subjectsRemoved(int,int)),SLOT(handleSubjectsRemoved(int,int)));
+    connect(d_observer,SIGNAL(subjectsReset()),SLOT(handleLayoutChanged()));
+    connect(d_observer,SIGNAL(subjectDataChanged(Observer*,QObject*)),SLOT(handleSubjectDataChanged(Observer*,QObject*)));
     connect(d_observer,SIGNAL(destroyed()),SLOT(handleLayoutChanged()));
     connect(d_observer,SIGNAL(dataChanged()),SLOT(handleDataChanged()));
+    // Child observers forward their layout changes, which includes changes to their number of subjects and their access modes:
+    connect(d_observer,SIGNAL(layoutChanged(QList<QPointer<QObject> >)),SLOT(handleTreeLayoutChanged()));
 
     // Check if this observer has a subject type filter installed
     for (int i = 0; i < observer->subjectFilters().count(); ++i) {
@@ -202,7 +239,7 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
     if (index.column() == columnPosition(ColumnSubjectID)) {
         // We need EditRole here, its used in subjectID()
         if (role == Qt::DisplayRole || role == Qt::EditRole)
-            return d_observer->subjectID(index.row());
+            return cachedSubjectID(index.row());
     // ------------------------------------
     // Handle Name Column: We need to inspect all role properties here:
     // ------------------------------------
@@ -213,14 +250,14 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         if (role == Qt::DisplayRole || role == Qt::EditRole) {
             // Check the modification state of the object if it implements IModificationNotifier:
             bool is_modified = false;
-            QObject* obj = d_observer->subjectAt(index.row());
+            QObject* obj = cachedObject(index.row());
             if (activeHints()->modificationStateDisplayHint() == ObserverHints::CharacterModificationStateDisplay) {
                 IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (obj);
                 if (mod_iface)
                     is_modified = mod_iface->isModified();
             }
 
-            QString return_string = d_observer->subjectDisplayedNameInContext(obj);
+            QString return_string = cachedColumnData(index.row(),ColumnName).toString();
             if (is_modified)
                 return return_string + "*";
             else
@@ -232,7 +269,7 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         } else if (role == Qt::CheckStateRole) {
             if (model->activity_filter) {
                 if (activeHints()->activityDisplayHint() == ObserverHints::CheckboxActivityDisplay || activeHints()->activityControlHint() == ObserverHints::CheckboxTriggered) {
-                    QObject* obj = d_observer->subjectReference(getSubjectID(index));
+                    QObject* obj = cachedObject(index.row());
                     QVariant subject_activity = d_observer->getMultiContextPropertyValue(obj,qti_prop_ACTIVITY_MAP);
 
                     if (subject_activity.isValid()) {
@@ -248,7 +285,10 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::DecorationRole
         // ------------------------------------
         } else if (role == Qt::DecorationRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
+            QObject* obj = cachedObject(index.row());
+            QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+            if (style_data.isValid())
+                return style_data;
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_DECORATION);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -257,7 +297,10 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::ForegroundRole
         // ------------------------------------
         } else if (role == Qt::ForegroundRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
+            QObject* obj = cachedObject(index.row());
+            QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+            if (style_data.isValid())
+                return style_data;
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_FOREGROUND);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -266,7 +309,10 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::BackgroundRole
         // ------------------------------------
         } else if (role == Qt::BackgroundRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
+            QObject* obj = cachedObject(index.row());
+            QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+            if (style_data.isValid())
+                return style_data;
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_BACKGROUND);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -275,7 +321,10 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::TextAlignmentRole
         // ------------------------------------
         } else if (role == Qt::TextAlignmentRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
+            QObject* obj = cachedObject(index.row());
+            QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+            if (style_data.isValid())
+                return style_data;
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_TEXT_ALIGNMENT);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -284,7 +333,10 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::FontRole
         // ------------------------------------
         } else if (role == Qt::FontRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
+            QObject* obj = cachedObject(index.row());
+            QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+            if (style_data.isValid())
+                return style_data;
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_FONT);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -293,7 +345,10 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::SizeHintRole
         // ------------------------------------
         } else if (role == Qt::SizeHintRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
+            QObject* obj = cachedObject(index.row());
+            QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+            if (style_data.isValid())
+                return style_data;
             SharedProperty size_property = ObjectManager::getSharedProperty(obj,qti_prop_SIZE_HINT);
             if (size_property.isValid()) {
                 if (size_property.value().toSize().isValid())
@@ -303,7 +358,7 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::WhatsThisRole
         // ------------------------------------
         } else if (role == Qt::WhatsThisRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
+            QObject* obj = cachedObject(index.row());
             SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_WHATS_THIS);
             if (icon_property.isValid()) {
                 return icon_property.value();
@@ -312,7 +367,7 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
         // Qt::ToolTipRole
         // ------------------------------------
         } else if (role == Qt::ToolTipRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
+            QObject* obj = cachedObject(index.row());
             SharedProperty tooltip = ObjectManager::getSharedProperty(obj,qti_prop_TOOLTIP);
             if (tooltip.isValid()) {
                 return tooltip.value();
@@ -322,73 +377,30 @@ QVariant Qtilities::CoreGui::ObserverTableModel::data(const QModelIndex &index,
     // Handle Category Column
     // ------------------------------------
     } else if (index.column() == columnPosition(ColumnCategory)) {
-        if (role == Qt::DisplayRole) {
-            // Get the qti_prop_CATEGORY_MAP property.
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
-            QVariant category_variant = d_observer->getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
-            if (category_variant.isValid()) {
-                QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
-                if (!category.isEmpty()) {
-                    return category.toString();
-                }
-            }
-            return QString();
-        }
+        if (role == Qt::DisplayRole)
+            return cachedColumnData(index.row(),ColumnCategory);
     // ------------------------------------
     // Handle Child Count Column
     // ------------------------------------
     } else if (index.column() == columnPosition(ColumnChildCount)) {
-        if (role == Qt::DisplayRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
-            if (!obj)
-                return QVariant();
-
-            Observer* observer = qobject_cast<Observer*> (obj);
-            if (observer) {
-                int count = observer->treeCount(columnChildCountBaseClass());
-                if ((count > columnChildCountLimit() - 1) && (columnChildCountLimit() != -1))
-                    return QString("> %1").arg(columnChildCountLimit() -1);
-                else
-                    return count;
-            }
-        }
+        if (role == Qt::DisplayRole)
+            return cachedColumnData(index.row(),ColumnChildCount);
     // ------------------------------------
     // Handle Subject Type Info Column
     // ------------------------------------
     } else if (index.column() == columnPosition(ColumnTypeInfo)) {
-        if (role == Qt::DisplayRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
-            if (!obj)
-                return QVariant();
-
-            if (obj->metaObject()) {
-                return QString(QLatin1String(obj->metaObject()->className())).split("::").last();
-            }
-            return QVariant();
-        }
+        if (role == Qt::DisplayRole)
+            return cachedColumnData(index.row(),ColumnTypeInfo);
     // ------------------------------------
     // Handle Access Column
     // ------------------------------------
     } else if (index.column() == columnPosition(ColumnAccess)) {
         if (role == Qt::DecorationRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
-            if (!obj)
-                return QVariant();
-
-            Observer* observer = qobject_cast<Observer*> (obj);
-            if (observer) {
-                if (observer->accessMode() == Observer::FullAccess)
-                    return QVariant();
-                if (observer->accessMode() == Observer::ReadOnlyAccess)
-                    return QIcon(qti_icon_READ_ONLY_16x16);
-                if (observer->accessMode() == Observer::LockedAccess)
-                    return QIcon(qti_icon_LOCKED_16x16);
-            } else {
-                // Inspect the object to see if it has the qti_prop_ACCESS_MODE observer property.
-                QVariant mode = d_observer->getMultiContextPropertyValue(obj,qti_prop_ACCESS_MODE);
-                if (mode.toInt() == (int) Observer::ReadOnlyAccess)
-                    return QIcon(qti_icon_READ_ONLY_16x16);
-            }
+            int access_mode = cachedColumnData(index.row(),ColumnAccess).toInt();
+            if (access_mode == (int) Observer::ReadOnlyAccess)
+                return cachedIcon(qti_icon_READ_ONLY_16x16);
+            if (access_mode == (int) Observer::LockedAccess)
+                return cachedIcon(qti_icon_LOCKED_16x16);
         }
     }
 
@@ -432,19 +444,19 @@ QVariant Qtilities::CoreGui::ObserverTableModel::headerData(int section, Qt::Ori
     } else if ((section == columnPosition(ColumnCategory)) && (orientation == Qt::Horizontal) && (role == Qt::ToolTipRole)) {
         return tr("Category");
     } else if ((section == columnPosition(ColumnChildCount)) && (orientation == Qt::Horizontal) && (role == Qt::DecorationRole)) {
-        return QIcon(qti_icon_CHILD_COUNT_22x22);
+        return cachedIcon(qti_icon_CHILD_COUNT_22x22);
     } else if ((section == columnPosition(ColumnChildCount)) && (orientation == Qt::Horizontal) && (role == Qt::ToolTipRole)) {
         return tr("Child Count");
     } else if ((section == columnPosition(ColumnChildCount)) && (orientation == Qt::Horizontal) && (role == Qt::DisplayRole)) {
         return "";
     } else if ((section == columnPosition(ColumnTypeInfo)) && (orientation == Qt::Horizontal) && (role == Qt::DecorationRole)) {
-        return QIcon(qti_icon_TYPE_INFO_22x22);
+        return cachedIcon(qti_icon_TYPE_INFO_22x22);
     } else if ((section == columnPosition(ColumnTypeInfo)) && (orientation == Qt::Horizontal) && (role == Qt::ToolTipRole)) {
         return tr("Type");
     } else if ((section == columnPosition(ColumnTypeInfo)) && (orientation == Qt::Horizontal) && (role == Qt::DisplayRole)) {
         return "";
     } else if ((section == columnPosition(ColumnAccess)) && (orientation == Qt::Horizontal) && (role == Qt::DecorationRole)) {
-        return QIcon(qti_icon_ACCESS_16x16);
+        return cachedIcon(qti_icon_ACCESS_16x16);
     } else if ((section == columnPosition(ColumnAccess)) && (orientation == Qt::Horizontal) && (role == Qt::ToolTipRole)) {
         return tr("Access");
     } else if ((section == columnPosition(ColumnAccess)) && (orientation == Qt::Horizontal) && (role == Qt::DisplayRole)) {
@@ -462,7 +474,7 @@ bool Qtilities::CoreGui::ObserverTableModel::setData(const QModelIndex &index, c
         return false;
     } else if (index.column() == columnPosition(ColumnName)) {
         if (role == Qt::EditRole || role == Qt::DisplayRole) {
-            QObject* obj = d_observer->subjectReference(getSubjectID(index));
+            QObject* obj = cachedObject(index.row());
             // Check if the object has an qti_prop_NAME property, if not we set the name using setObjectName()
             if (ObjectManager::getSharedProperty(obj, qti_prop_NAME).isValid()) {
                 // Now check if this observer uses an instance name
@@ -474,11 +486,12 @@ bool Qtilities::CoreGui::ObserverTableModel::setData(const QModelIndex &index, c
             } else {
                 obj->setObjectName(value.toString());
             }
+            invalidateRowCache(index.row(),index.row());
             return true;
         } else if (role == Qt::CheckStateRole) {
             if (model->activity_filter) {
                 //if (activeHints()->activityDisplayHint() == ObserverHints::CheckboxActivityDisplay && activeHints()->activityControlHint() == ObserverHints::CheckboxTriggered) {
-                    QObject* obj = d_observer->subjectReference(getSubjectID(index));
+                    QObject* obj = cachedObject(index.row());
                     // The value coming in here is always Qt::Checked
                     // We get the current check state from the qti_prop_ACTIVITY_MAP property and change that:
                     QVariant current_activity = d_observer->getMultiContextPropertyValue(obj,qti_prop_ACTIVITY_MAP);
@@ -556,6 +569,7 @@ void Qtilities::CoreGui::ObserverTableModel::fetchMore(const QModelIndex &parent
 
     beginInsertRows(QModelIndex(), d->fetch_count, d->fetch_count+itemsToFetch-1);
     d->fetch_count += itemsToFetch;
+    d->row_cache.resize(d->fetch_count);
     endInsertRows();
 
     emit moreDataFetched(itemsToFetch);
@@ -601,7 +615,10 @@ void Qtilities::CoreGui::ObserverTableModel::handleDataChanged() {
         qDebug() << "Responding to data changes to observer" << d_observer->observerName() << "in table model";
         #endif
     }
+    if (deferChange(PendingDataChange))
+        return;
 
+    invalidateRowCache(0,d->row_cache.count()-1);
     emit dataChanged(createIndex(0,0),createIndex(rowCount()-1,columnCount()-1));
 }
 
@@ -619,31 +636,99 @@ void Qtilities::CoreGui::ObserverTableModel::handleLayoutChanged() {
         qDebug() << "Responding to number of subjects changed on observer" << d_observer->observerName() << "in table model";
         #endif
     }
+    if (deferChange(PendingLayoutChange))
+        return;
 
     d->fetch_count = qMin(fetch_limit, d_observer->subjectCount());
     emit layoutAboutToBeChanged();
+    d->row_cache.clear();
+    d->row_cache.resize(d->fetch_count);
     emit layoutChanged();
     emit layoutChangeCompleted();
 }
 
+void Qtilities::CoreGui::ObserverTableModel::handleSubjectsInserted(int first, int last) {
+    if (!d_observer || !respondToObserverChanges())
+        return;
+    if (deferChange(PendingLayoutChange))
+        return;
+
+    // Subjects inserted after rows which were not fetched yet will be fetched using fetchMore():
+    if (first > d->fetch_count)
+        return;
+
+    beginInsertRows(QModelIndex(),first,last);
+    d->fetch_count += last - first + 1;
+    d->row_cache.insert(qMin(first,d->row_cache.count()),last - first + 1,RowCache());
+    endInsertRows();
+    emit layoutChangeCompleted();
+}
+
+void Qtilities::CoreGui::ObserverTableModel::handleSubjectsRemoved(int first, int last) {
+    if (!d_observer || !respondToObserverChanges())
+        return;
+    if (deferChange(PendingLayoutChange))
+        return;
+
+    // Only rows which were fetched are known to the view:
+    if (first >= d->fetch_count)
+        return;
+    if (last >= d->fetch_count)
+        last = d->fetch_count - 1;
+
+    beginRemoveRows(QModelIndex(),first,last);
+    d->fetch_count -= last - first + 1;
+    if (first < d->row_cache.count())
+        d->row_cache.remove(first,qMin(last,d->row_cache.count() - 1) - first + 1);
+    endRemoveRows();
+    emit layoutChangeCompleted();
+}
+
+void Qtilities::CoreGui::ObserverTableModel::handleSubjectDataChanged(Observer* observer, QObject* subject) {
+    if (!d_observer || observer != d_observer || !respondToObserverChanges())
+        return;
+    if (deferChange(PendingDataChange))
+        return;
+
+    int row = d_observer->subjectPosition(subject);
+    if (row < 0 || row >= d->fetch_count)
+        return;
+
+    invalidateRowCache(row,row);
+    emit dataChanged(index(row,0),index(row,columnCount()-1));
+}
+
+void Qtilities::CoreGui::ObserverTableModel::handleTreeLayoutChanged() {
+    if (!d_observer || !respondToObserverChanges())
+        return;
+    if (deferChange(PendingDataChange))
+        return;
+
+    // Only the child count and access columns depend on the tree underneath the subjects:
+    for (int row = 0; row < d->row_cache.count(); ++row) {
+        RowCache& cache = d->row_cache[row];
+        cache.cached_columns &= ~(CachedChildCount | CachedAccess);
+        cache.child_count = QVariant();
+        cache.access_mode = -1;
+    }
+    if (d->fetch_count > 0)
+        emit dataChanged(index(0,0),index(d->fetch_count-1,columnCount()-1));
+}
+
+void Qtilities::CoreGui::ObserverTableModel::applyPendingChanges(PendingChanges changes) {
+    // The layout change resets all rows, which refreshes their data as well:
+    if (changes & PendingLayoutChange)
+        handleLayoutChanged();
+    else if (changes & PendingDataChange)
+        handleDataChanged();
+}
+
 int Qtilities::CoreGui::ObserverTableModel::getSubjectID(const QModelIndex &index) const {
-    QModelIndex id_index = createIndex(index.row(),0);
-    bool ok;
-    int id = data(id_index, Qt::EditRole).toInt(&ok);
-    if (ok)
-        return id;
-    else
-        return -1;
+    return cachedSubjectID(index.row());
 }
 
 int Qtilities::CoreGui::ObserverTableModel::getSubjectID(int row) const {
-    QModelIndex id_index = createIndex(row,0);
-    bool ok;
-    int id = data(id_index, Qt::EditRole).toInt(&ok);
-    if (ok)
-        return id;
-    else
-        return -1;
+    return cachedSubjectID(row);
 }
 
 void Qtilities::CoreGui::ObserverTableModel::setSelectedObjects(QList<QPointer<QObject> > selected_objects) {
@@ -651,13 +736,7 @@ void Qtilities::CoreGui::ObserverTableModel::setSelectedObjects(QList<QPointer<Q
 }
 
 QObject* Qtilities::CoreGui::ObserverTableModel::getObject(const QModelIndex &index) const {
-    QModelIndex id_index = createIndex(index.row(),0);
-    bool ok;
-    int id = data(id_index, Qt::EditRole).toInt(&ok);
-    if (ok && d_observer)
-        return d_observer->subjectReference(id);
-    else
-        return 0;
+    return cachedObject(index.row());
 }
 
 void Qtilities::CoreGui::ObserverTableModel::refresh() {
@@ -665,13 +744,7 @@ void Qtilities::CoreGui::ObserverTableModel::refresh() {
 }
 
 QObject* Qtilities::CoreGui::ObserverTableModel::getObject(int row) const {
-    QModelIndex id_index = createIndex(row,0);
-    bool ok;
-    int id = data(id_index, Qt::EditRole).toInt(&ok);
-    if (ok && d_observer)
-        return d_observer->subjectReference(id);
-    else
-        return 0;
+    return cachedObject(row);
 }
 
 QModelIndex Qtilities::CoreGui::ObserverTableModel::getIndex(QObject* obj, int column) const {
@@ -684,23 +757,112 @@ QModelIndex Qtilities::CoreGui::ObserverTableModel::getIndex(QObject* obj, int c
     if (column == -1)
         column = columnPosition(ColumnName);
 
-    // Get the subject id of the obj
-    int id = -1;
-    MultiContextProperty subject_id_property = ObjectManager::getMultiContextProperty(obj,qti_prop_OBSERVER_MAP);
-    if (subject_id_property.isValid()) {
-        id = subject_id_property.value(d_observer->observerID()).toInt();
+    // The rows of the table model are the positions of the subjects in the observer:
+    int row = d_observer->subjectPosition(obj);
+    if (row < 0 || row >= rowCount())
+        return QModelIndex();
+
+    return index(row,column);
+}
+
+void Qtilities::CoreGui::ObserverTableModel::invalidateRowCache(int first, int last) {
+    for (int row = qMax(0,first); row <= last && row < d->row_cache.count(); ++row)
+        d->row_cache[row] = RowCache();
+}
+
+QObject* Qtilities::CoreGui::ObserverTableModel::cachedObject(int row) const {
+    if (!d_observer || row < 0 || row >= d_observer->subjectCount())
+        return 0;
+
+    // Rows which were not fetched yet are not cached:
+    if (row >= d->fetch_count)
+        return d_observer->subjectAt(row);
+
+    if (d->row_cache.count() < d->fetch_count)
+        d->row_cache.resize(d->fetch_count);
+
+    RowCache& cache = d->row_cache[row];
+    if (!(cache.cached_columns & CachedSubject) || !cache.object) {
+        cache = RowCache();
+        cache.object = d_observer->subjectAt(row);
+        cache.subject_id = d_observer->getMultiContextPropertyValue(cache.object,qti_prop_OBSERVER_MAP).toInt();
+        cache.cached_columns = CachedSubject;
     }
+    return cache.object;
+}
 
-    // Check if id is valid
-    if (id < 0)
-        return QModelIndex();
+int Qtilities::CoreGui::ObserverTableModel::cachedSubjectID(int row) const {
+    QObject* obj = cachedObject(row);
+    if (!obj)
+        return -1;
+    if (row >= d->fetch_count)
+        return d_observer->getMultiContextPropertyValue(obj,qti_prop_OBSERVER_MAP).toInt();
+    return d->row_cache.at(row).subject_id;
+}
+
+QVariant Qtilities::CoreGui::ObserverTableModel::cachedColumnData(int row, AbstractObserverItemModel::ColumnID column_id) const {
+    QObject* obj = cachedObject(row);
+    if (!obj)
+        return QVariant();
 
-    // Now look for the id in the ID_COLUMN of the table model
-    for (int i = 0; i < rowCount(); ++i) {
-        if (data(index(i,columnPosition(ColumnSubjectID)),Qt::DisplayRole).toInt() == id) {
-            return index(i,column);
+    RowCache uncached;
+    RowCache& cache = row < d->fetch_count ? d->row_cache[row] : uncached;
+    if (column_id == ColumnName) {
+        if (!(cache.cached_columns & CachedName)) {
+            cache.name = d_observer->subjectDisplayedNameInContext(obj);
+            cache.cached_columns |= CachedName;
+        }
+        return cache.name;
+    } else if (column_id == ColumnCategory) {
+        if (!(cache.cached_columns & CachedCategory)) {
+            // Get the qti_prop_CATEGORY_MAP property.
+            QVariant category_variant = d_observer->getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP);
+            if (category_variant.isValid()) {
+                QtilitiesCategory category = category_variant.value<QtilitiesCategory>();
+                if (!category.isEmpty())
+                    cache.category = category.toString();
+            }
+            cache.cached_columns |= CachedCategory;
+        }
+        return cache.category;
+    } else if (column_id == ColumnChildCount) {
+        if (!(cache.cached_columns & CachedChildCount)) {
+            Observer* observer = qobject_cast<Observer*> (obj);
+            if (observer) {
+                int count = observer->treeCount(columnChildCountBaseClass());
+                if ((count > columnChildCountLimit() - 1) && (columnChildCountLimit() != -1))
+                    cache.child_count = QString("> %1").arg(columnChildCountLimit() -1);
+                else
+                    cache.child_count = count;
+            }
+            cache.cached_columns |= CachedChildCount;
+        }
+        return cache.child_count;
+    } else if (column_id == ColumnTypeInfo) {
+        if (!(cache.cached_columns & CachedTypeInfo)) {
+            if (obj->metaObject())
+                cache.type_info = QString(QLatin1String(obj->metaObject()->className())).split("::").last();
+            cache.cached_columns |= CachedTypeInfo;
+        }
+        if (cache.type_info.isEmpty())
+            return QVariant();
+        return cache.type_info;
+    } else if (column_id == ColumnAccess) {
+        if (!(cache.cached_columns & CachedAccess)) {
+            Observer* observer = qobject_cast<Observer*> (obj);
+            if (observer) {
+                if (observer->accessMode() != Observer::FullAccess)
+                    cache.access_mode = (int) observer->accessMode();
+            } else {
+                // Inspect the object to see if it has the qti_prop_ACCESS_MODE observer property.
+                QVariant mode = d_observer->getMultiContextPropertyValue(obj,qti_prop_ACCESS_MODE);
+                if (mode.toInt() == (int) Observer::ReadOnlyAccess)
+                    cache.access_mode = (int) Observer::ReadOnlyAccess;
+            }
+            cache.cached_columns |= CachedAccess;
         }
+        return cache.access_mode;
     }
 
-    return QModelIndex();
+    return QVariant();
 }
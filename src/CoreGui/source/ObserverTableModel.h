@@ -44,6 +44,10 @@ namespace Qtilities {
         are included in the %Qtilities libraries. Thus it will for example automatically show check boxes etc. if the observer context has
         an Qtilities::Core::ActivityPolicyFilter installed.
 
+        Rows are fetched in pages as the view scrolls through canFetchMore() and fetchMore(), and subjects inserted into or removed from the observer context
+        insert or remove only their own rows. The values of the ID, name, category, child count, access and type info columns are computed once per row and
+        cached until the subject's data or the tree underneath it changes, thus scrolling through large tables does not repeat the observer context lookups.
+
         To customize this model you can simply subclass it and reimplement the virtual functions of QAbstractItemModel. This allows you to
         add columns etc. to your view. The <a class="el" href="namespace_qtilities_1_1_examples_1_1_clipboard.html">Clipboard Example</a> shows how
         to do this.
@@ -125,6 +129,35 @@ namespace Qtilities {
               This slot will automatically be connected to the layoutChanged() signal on the observer context displayed.
               */
             virtual void handleLayoutChanged();
+            //! Slot which inserts rows for subjects inserted in the observer context.
+            /*!
+              This slot will automatically be connected to the Observer::subjectsInserted() signal on the observer context displayed.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSubjectsInserted(int first, int last);
+            //! Slot which removes the rows of subjects removed from the observer context.
+            /*!
+              This slot will automatically be connected to the Observer::subjectsRemoved() signal on the observer context displayed.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSubjectsRemoved(int first, int last);
+            //! Slot which refreshes the row of a single subject.
+            /*!
+              This slot will automatically be connected to the Observer::subjectDataChanged() signal on the observer context displayed.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSubjectDataChanged(Observer* observer, QObject* subject);
+            //! Slot which refreshes the child count and access columns of all rows.
+            /*!
+              This slot will automatically be connected to the Observer::layoutChanged() signal on the observer context displayed, which is
+              forwarded from child observers when their number of subjects or their access mode changes.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleTreeLayoutChanged();
 
         signals:
             //! Signal which is emitted when more data is fetched from the model.
@@ -137,7 +170,23 @@ namespace Qtilities {
             //! This signal will be handled by a slot in the ObserverWidget parent of this model and the objects will be selected. The signal is emitted when grouped activity changes completed.
             void selectObjects(QList<QPointer<QObject> > objects) const;
 
+        private:
+            //! Returns the subject at \p row, using the row cache for rows which were fetched.
+            QObject* cachedObject(int row) const;
+            //! Returns the subject ID of the subject at \p row, using the row cache for rows which were fetched.
+            int cachedSubjectID(int row) const;
+            //! Returns the display value of \p column_id for \p row, computing it only once for rows which were fetched.
+            /*!
+              For AbstractObserverItemModel::ColumnAccess the Observer::AccessMode for which an icon must be displayed is returned, or -1 when no icon is displayed.
+              */
+            QVariant cachedColumnData(int row, AbstractObserverItemModel::ColumnID column_id) const;
+            //! Clears the cached columns of the rows from \p first to \p last.
+            void invalidateRowCache(int first, int last);
+
         protected:
+            //! Resets the layout once for all layout changes received while updates were suspended, or refreshes the data of all rows.
+            void applyPendingChanges(PendingChanges changes);
+
             ObserverTableModelData* d;
         };
     }
@@ -15,15 +15,107 @@
 #include <QStringList>
 #include <QtDebug>
 
+#include <stdlib.h>
+
+namespace {
+    // Every item allocation starts with a header naming the arena it was allocated in, or null for heap allocations.
+    // The header size keeps the item aligned for any type.
+    const size_t qti_private_item_header_size = 16;
+
+    inline Qtilities::CoreGui::ObserverTreeItemArena*& qti_private_itemArena(void* header) {
+        return *static_cast<Qtilities::CoreGui::ObserverTreeItemArena**>(header);
+    }
+}
+
+// --------------------------------
+// ObserverTreeItemArena
+// --------------------------------
+
+Qtilities::CoreGui::ObserverTreeItemArena::ObserverTreeItemArena(int items_per_block) {
+    if (items_per_block < 1)
+        items_per_block = 1;
+    d_items_per_block = items_per_block;
+    d_block_size = items_per_block * (qti_private_item_header_size + ((sizeof(ObserverTreeItem) + 15) & ~size_t(15)));
+    d_current_block_size = 0;
+    d_block_used = 0;
+    d_allocation_count = 0;
+}
+
+Qtilities::CoreGui::ObserverTreeItemArena::~ObserverTreeItemArena() {
+    qDeleteAll(d_sub_arenas);
+    for (int i = 0; i < d_blocks.count(); ++i)
+        free(d_blocks.at(i));
+}
+
+Qtilities::CoreGui::ObserverTreeItemArena* Qtilities::CoreGui::ObserverTreeItemArena::createSubArena() {
+    ObserverTreeItemArena* sub_arena = new ObserverTreeItemArena(d_items_per_block);
+    d_sub_arenas << sub_arena;
+    return sub_arena;
+}
+
+void* Qtilities::CoreGui::ObserverTreeItemArena::allocate(size_t size) {
+    size = (size + 15) & ~size_t(15);
+    if (d_block_used + size > d_current_block_size) {
+        // Blocks are allocated with malloc(), thus their start is suitably aligned:
+        size_t block_size = size > d_block_size ? size : d_block_size;
+        char* block = static_cast<char*> (malloc(block_size));
+        if (!block)
+            qFatal("ObserverTreeItemArena: Out of memory");
+        d_blocks << block;
+        d_current_block_size = block_size;
+        d_block_used = 0;
+    }
+
+    void* ptr = d_blocks.last() + d_block_used;
+    d_block_used += size;
+    ++d_allocation_count;
+    return ptr;
+}
+
+// --------------------------------
+// ObserverTreeItem
+// --------------------------------
+
+void* Qtilities::CoreGui::ObserverTreeItem::operator new(size_t size) {
+    return operator new(size,static_cast<ObserverTreeItemArena*> (0));
+}
+
+void* Qtilities::CoreGui::ObserverTreeItem::operator new(size_t size, ObserverTreeItemArena* arena) {
+    void* header;
+    if (arena)
+        header = arena->allocate(qti_private_item_header_size + size);
+    else
+        header = ::operator new(qti_private_item_header_size + size);
+    qti_private_itemArena(header) = arena;
+    return static_cast<char*> (header) + qti_private_item_header_size;
+}
+
+void Qtilities::CoreGui::ObserverTreeItem::operator delete(void* ptr) {
+    if (!ptr)
+        return;
+
+    void* header = static_cast<char*> (ptr) - qti_private_item_header_size;
+    if (!qti_private_itemArena(header))
+        ::operator delete(header);
+}
+
+void Qtilities::CoreGui::ObserverTreeItem::operator delete(void* ptr, ObserverTreeItemArena* arena) {
+    Q_UNUSED(arena)
+    operator delete(ptr);
+}
+
 Qtilities::CoreGui::ObserverTreeItem::ObserverTreeItem(QObject* object,
                                                        ObserverTreeItem *parent,
                                                        const QVector<QVariant> &data,
                                                        TreeItemType item_type) : QObject(0) {
     parent_item = parent;
-    itemData = data;
+    column_count = data.count();
     obj = object;
     type = item_type;
     contained_observer_ref = 0;
+    value_index = -1;
+    children_populated = true;
+    data_cache_generation = -1;
     //qDebug() << type;
 
     if (obj) {
@@ -33,12 +125,32 @@ Qtilities::CoreGui::ObserverTreeItem::ObserverTreeItem(QObject* object,
     }
 }
 
+Qtilities::CoreGui::ObserverTreeItem::ObserverTreeItem(QObject* object,
+                                                       ObserverTreeItem *parent,
+                                                       int columns,
+                                                       TreeItemType item_type) : QObject(0) {
+    parent_item = parent;
+    column_count = columns;
+    obj = object;
+    type = item_type;
+    contained_observer_ref = 0;
+    value_index = -1;
+    children_populated = true;
+    data_cache_generation = -1;
+
+    if (obj)
+        setObjectName(obj->objectName());
+}
+
 Qtilities::CoreGui::ObserverTreeItem::ObserverTreeItem(const ObserverTreeItem& ref) : QObject(0) {
     parent_item = ref.parentItem();
-    itemData = ref.itemData;
+    column_count = ref.column_count;
     obj = ref.obj;
     type = ref.type;
     contained_observer_ref = 0;
+    value_index = -1;
+    children_populated = true;
+    data_cache_generation = -1;
 
     if (ref.obj) {
         setObjectName(ref.obj->objectName());
@@ -62,7 +174,9 @@ Qtilities::CoreGui::ObserverTreeItem::~ObserverTreeItem() {
 }
 
 void Qtilities::CoreGui::ObserverTreeItem::appendChild(ObserverTreeItem *child_item) {
-    childItemHash[child_item->getObject()->objectName()] = child_item;
+    // Value items do not have objects, they are never looked up by name:
+    if (child_item->getObject())
+        childItemHash[child_item->getObject()->objectName()] = child_item;
     childItemList << child_item;
     child_item->setParent(this);
 }
@@ -74,6 +188,54 @@ Qtilities::CoreGui::ObserverTreeItem* Qtilities::CoreGui::ObserverTreeItem::chil
     return 0;
 }
 
+bool Qtilities::CoreGui::ObserverTreeItem::cachedData(int column, int role, int generation, QVariant* value) const {
+    if (generation != data_cache_generation)
+        return false;
+
+    QHash<int,QVariant>::const_iterator itr = data_cache.constFind((column << 16) | role);
+    if (itr == data_cache.constEnd())
+        return false;
+
+    if (value)
+        *value = itr.value();
+    return true;
+}
+
+void Qtilities::CoreGui::ObserverTreeItem::setCachedData(int column, int role, int generation, const QVariant& value) {
+    if (generation != data_cache_generation) {
+        data_cache.clear();
+        data_cache_generation = generation;
+    }
+
+    data_cache[(column << 16) | role] = value;
+}
+
+void Qtilities::CoreGui::ObserverTreeItem::adoptChildren(ObserverTreeItem* source) {
+    if (!source || source == this)
+        return;
+
+    QList<QPointer<ObserverTreeItem> > children = source->childItemList;
+    source->childItemList.clear();
+    source->childItemHash.clear();
+    for (int i = 0; i < children.count(); ++i) {
+        ObserverTreeItem* child_item = children.at(i);
+        if (!child_item)
+            continue;
+        child_item->parent_item = this;
+        appendChild(child_item);
+    }
+}
+
+void Qtilities::CoreGui::ObserverTreeItem::removeChildren() {
+    QList<QPointer<ObserverTreeItem> > children = childItemList;
+    childItemList.clear();
+    childItemHash.clear();
+    for (int i = 0; i < children.count(); ++i) {
+        if (children.at(i))
+            delete children.at(i);
+    }
+}
+
 Qtilities::CoreGui::ObserverTreeItem* Qtilities::CoreGui::ObserverTreeItem::child(int row) {
     return childItemList.at(row);
 }
@@ -83,7 +245,7 @@ int Qtilities::CoreGui::ObserverTreeItem::childCount() const {
 }
 
 int Qtilities::CoreGui::ObserverTreeItem::columnCount() const {
-    return itemData.count();
+    return column_count;
 }
 
 Qtilities::CoreGui::ObserverTreeItem* Qtilities::CoreGui::ObserverTreeItem::parentItem() const {
@@ -23,6 +23,51 @@ namespace Qtilities {
     namespace CoreGui {
         using namespace Qtilities::Core;
 
+        /*!
+          \class Qtilities::CoreGui::ObserverTreeItemArena
+          \brief The ObserverTreeItemArena class provides the storage of the ObserverTreeItem instances of a single tree build.
+
+          ObserverTreeModel builds a complete ObserverTreeItem hierarchy every time its observer tree changes. Instead of allocating every item
+          on the heap, the items of a build are created in an arena using <tt>new (arena) ObserverTreeItem(...)</tt>. The arena hands out
+          item storage from large blocks, and deleting an item only runs its destructor. The blocks are released together when the arena is
+          deleted, which must happen after all items created in it were deleted.
+
+          An arena is not thread safe, items of a single arena must be created in one thread at a time.
+
+          <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class ObserverTreeItemArena
+        {
+        public:
+            //! Constructs an arena which allocates storage for \p items_per_block items at a time.
+            ObserverTreeItemArena(int items_per_block = 512);
+            //! Releases all storage of the arena. All items created in the arena must be deleted already.
+            ~ObserverTreeItemArena();
+
+            //! Allocates \p size bytes in the arena.
+            void* allocate(size_t size);
+            //! The number of allocations made in the arena.
+            inline int allocationCount() const { return d_allocation_count; }
+            //! Creates an arena which is owned by this arena, and which is released along with it.
+            /*!
+              Sub arenas allow items of one tree to be created in several threads at once, one arena per thread.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObserverTreeItemArena* createSubArena();
+
+        private:
+            Q_DISABLE_COPY(ObserverTreeItemArena)
+
+            QList<char*> d_blocks;
+            QList<ObserverTreeItemArena*> d_sub_arenas;
+            int d_items_per_block;
+            size_t d_block_size;
+            size_t d_current_block_size;
+            size_t d_block_used;
+            int d_allocation_count;
+        };
+
         /*!
           \class Qtilities::CoreGui::ObserverTreeItem
           \brief The ObserverTreeItem class represents a single observer item in a tree view.
@@ -43,15 +88,37 @@ namespace Qtilities {
                 TreeItem            = 1, /*!< A tree item. */
                 TreeNode            = 2, /*!< A tree node. */
                 CategoryItem        = 4, /*!< A category item. */
-                AllItemTypes        = TreeItem | TreeNode | CategoryItem
+                ValueItem           = 8, /*!< A value item of a TreeNode, see TreeNode::addValueItem(). Value items do not have an object. <i>This type was added in %Qtilities v1.5.</i> */
+                AllItemTypes        = TreeItem | TreeNode | CategoryItem | ValueItem
             };
             Q_DECLARE_FLAGS(TreeItemTypeFlags, TreeItemType)
             Q_FLAGS(TreeItemTypeFlags)
 
             ObserverTreeItem(QObject* obj = 0, ObserverTreeItem *parent = 0, const QVector<QVariant> &data = QVector<QVariant>(), TreeItemType type = InvalidType);
+            //! Constructs an item with \p column_count columns.
+            /*!
+              Items only store the number of columns in their data, thus this constructor avoids building a data vector for every item.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObserverTreeItem(QObject* obj, ObserverTreeItem *parent, int column_count, TreeItemType type);
             ObserverTreeItem(const ObserverTreeItem& ref);
             ~ObserverTreeItem();
 
+            //! Allocates an item on the heap.
+            static void* operator new(size_t size);
+            //! Allocates an item in \p arena, or on the heap when \p arena is null.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static void* operator new(size_t size, ObserverTreeItemArena* arena);
+            //! Constructs an item in storage which was already allocated.
+            static inline void* operator new(size_t size, void* where) { Q_UNUSED(size) return where; }
+            //! Releases the storage of an item allocated on the heap. The storage of items allocated in an arena is released with the arena.
+            static void operator delete(void* ptr);
+            static void operator delete(void* ptr, ObserverTreeItemArena* arena);
+            static inline void operator delete(void* ptr, void* where) { Q_UNUSED(ptr) Q_UNUSED(where) }
+
             ObserverTreeItem *child(int row);
             void appendChild(ObserverTreeItem *child_item);
             //! Checks if a child with the name already exists.
@@ -59,6 +126,16 @@ namespace Qtilities {
               If the child already exists a reference is returned to it. If not 0 is returned.
               */
             ObserverTreeItem* childWithName(const QString& name) const;
+            //! Moves all children of \p source to the end of this item's children.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void adoptChildren(ObserverTreeItem* source);
+            //! Deletes all children of this item.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void removeChildren();
             int childCount() const;
             int columnCount() const;
             int row() const;
@@ -73,8 +150,51 @@ namespace Qtilities {
             inline QtilitiesCategory category() const { return category_id; }
             //! Sets a references to an observer in the case where the observer is contained within an interface.
             inline void setContainedObserver(Observer* contained_observer) { contained_observer_ref = contained_observer; }
-            //! Gets the contained observer reference. The reference is held by the category item.
+            //! Gets the contained observer reference. The reference is held by category items and value items.
             inline Observer* containedObserver() const { return contained_observer_ref; }
+            //! Sets the index of the value represented through this item in its TreeNode. Only used with ValueItem types.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline void setValueIndex(int index) { value_index = index; }
+            //! Gets the index of the value represented through this item in its TreeNode, see containedObserver(). Only used with ValueItem types.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline int valueIndex() const { return value_index; }
+            //! Sets if the children of this item were built. Items of observers are not populated when ObserverTreeModel builds its tree lazily.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline void setChildrenPopulated(bool populated) { children_populated = populated; }
+            //! Indicates if the children of this item were built. True by default.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline bool childrenPopulated() const { return children_populated; }
+            //! Gets data cached by ObserverTreeModel for a column and role.
+            /*!
+              \param generation The generation of the data cache. Data cached for a different generation is not valid anymore.
+              \returns True when valid data was cached, in which case \p value is set to it.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool cachedData(int column, int role, int generation, QVariant* value) const;
+            //! Caches data for a column and role. When \p generation is different from the generation of the current cached data, all cached data is discarded first.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setCachedData(int column, int role, int generation, const QVariant& value);
+            //! Discards all cached data.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline void clearCachedData() { data_cache.clear(); }
+            //! Returns the number of column and role combinations for which data is cached.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            inline int cachedDataCount() const { return data_cache.count(); }
 
         signals:
             void newObjectAdded(QObject* obj, ObserverTreeItem* new_item);
@@ -82,12 +202,16 @@ namespace Qtilities {
         private:
             QHash<QString,QPointer<ObserverTreeItem> > childItemHash;
             QList<QPointer<ObserverTreeItem> > childItemList;
-            QVector<QVariant> itemData;
+            int column_count;
             QPointer<ObserverTreeItem> parent_item;
             QPointer<QObject> obj;
             TreeItemType type;
             QtilitiesCategory category_id;
             QPointer<Observer> contained_observer_ref;
+            int value_index;
+            bool children_populated;
+            QHash<int,QVariant> data_cache;
+            int data_cache_generation;
         };
 
         Q_DECLARE_OPERATORS_FOR_FLAGS(ObserverTreeItem::TreeItemTypeFlags);
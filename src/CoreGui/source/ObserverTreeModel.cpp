@@ -14,6 +14,8 @@
 #include "ObserverMimeData.h"
 #include "QtilitiesApplication.h"
 #include "ObserverTreeModelBuilder.h"
+#include "TreeNode.h"
+#include "TreeItemStyleTable_p.h"
 
 #include <SubjectTypeFilter.h>
 #include <QtilitiesCoreConstants.h>
@@ -21,11 +23,15 @@
 #include <ActivityPolicyFilter.h>
 #include <Logger.h>
 #include <QtilitiesCategory.h>
+#include <PerformanceCounters.h>
 
 #include <QMessageBox>
 #include <QIcon>
 #include <QDropEvent>
 #include <QFileIconProvider>
+#include <QTimer>
+#include <QSet>
+#include <QElapsedTimer>
 
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::CoreGui::Icons;
@@ -33,17 +39,56 @@ using namespace Qtilities::Core::Properties;
 using namespace Qtilities::Core;
 using namespace Qtilities::Core::Constants;
 
+namespace {
+    // The rows of the items from the root item down to item.
+    QVector<int> qti_private_TreeItemPath(Qtilities::CoreGui::ObserverTreeItem* item) {
+        QVector<int> path;
+        while (item && item->parentItem()) {
+            path.prepend(item->row());
+            item = item->parentItem();
+        }
+        return path;
+    }
+
+    // Indicates if the item at path comes before the item at other_path in a depth first traversal of the tree.
+    bool qti_private_TreeItemPathBefore(const QVector<int>& path, const QVector<int>& other_path) {
+        const int depth = qMin(path.count(),other_path.count());
+        for (int i = 0; i < depth; ++i) {
+            if (path.at(i) != other_path.at(i))
+                return path.at(i) < other_path.at(i);
+        }
+        return path.count() < other_path.count();
+    }
+}
+
 struct Qtilities::CoreGui::ObserverTreeModelData  {
     ObserverTreeModelData() : tree_model_up_to_date(true),
         tree_rebuild_queued(false),
         at_least_one_tree_build_completed(false),
-        do_auto_select_and_expand(true) {}
+        do_auto_select_and_expand(true),
+        root_arena(0),
+        building_root_item(0),
+        building_arena(0),
+        build_in_progress(false),
+        threaded_building(true),
+        lazy_item_limit(20000),
+        item_count(0),
+        data_cache_generation(0),
+        cached_child_count_limit(-1),
+        item_index_valid(false),
+        drop_acceptance_data(0),
+        drop_acceptance_valid(false),
+        drop_acceptance_result(Observer::Rejected) {}
 
     QPointer<ObserverTreeItem>  rootItem;
+    //! The arena of the items in rootItem, null when they were allocated on the heap. Released along with rootItem.
+    ObserverTreeItemArena*      root_arena;
     QPointer<Observer>          selection_parent;
     QString                     type_grouping_name;
     bool                        read_only;
     QFileIconProvider           icon_provider;
+    //! The decoration of category items, requested from icon_provider once.
+    QIcon                       category_icon;
 
     //! The selected categories.
     QList<QtilitiesCategory>    selected_categories;
@@ -64,6 +109,8 @@ struct Qtilities::CoreGui::ObserverTreeModelData  {
 
     //! Nodes to expand in the tree after a rebuild is done.
     QList<QPointer<QObject> >   expanded_objects;
+    //! The objects in expanded_objects, used for lookups while populating lazily built trees.
+    QSet<const QObject*>        expanded_object_set;
     QStringList                 expanded_categories;
     //! A map with expanded items which must be replaced after d->expanded_categories was set by the observer widget.
     /*!
@@ -71,7 +118,39 @@ struct Qtilities::CoreGui::ObserverTreeModelData  {
       */
     QMap<QString,QString>       expanded_categories_replace_map;
 
-    QMutex                      build_mutex;
+    //! The root of the tree which is being built, it replaces rootItem when the build completed.
+    ObserverTreeItem*           building_root_item;
+    //! The arena of the items in building_root_item, it replaces root_arena when the build completed.
+    ObserverTreeItemArena*      building_arena;
+    //! Indicates if a build was started and its tree was not swapped into the model yet.
+    bool                        build_in_progress;
+    //! Measures the duration of the build in progress, including builds which were restarted before they completed.
+    QElapsedTimer               build_timer;
+    //! Stores if the tree is built in a worker thread. See enableThreadedBuilding().
+    bool                        threaded_building;
+    //! See setLazyItemLimit().
+    int                         lazy_item_limit;
+    //! The number of items in the tree, only maintained when lazy initialization is enabled.
+    int                         item_count;
+    //! Data cached in tree items is only valid for this generation, it is incremented to discard all cached data.
+    int                         data_cache_generation;
+    //! The child count settings used for the cached data.
+    QString                     cached_child_count_base_class;
+    int                         cached_child_count_limit;
+
+    //! The tree items representing each object in the tree, built on demand by indexTreeItems().
+    QHash<const QObject*,QList<QPointer<ObserverTreeItem> > > item_index;
+    //! Indicates if item_index matches the current tree.
+    bool                        item_index_valid;
+
+    //! The drag data for which drop_acceptance_result was evaluated, see dropAcceptance(). Only used to identify the drag session.
+    const QMimeData*            drop_acceptance_data;
+    //! The target observer for which drop_acceptance_result was evaluated.
+    QPointer<Observer>          drop_acceptance_target;
+    //! Indicates if drop_acceptance_result holds a valid result.
+    bool                        drop_acceptance_valid;
+    //! The result of the last drop acceptance evaluation.
+    Observer::EvaluationResult  drop_acceptance_result;
 };
 
 Qtilities::CoreGui::ObserverTreeModel::ObserverTreeModel(QObject* parent) :
@@ -91,8 +170,9 @@ Qtilities::CoreGui::ObserverTreeModel::ObserverTreeModel(QObject* parent) :
 }
 
 Qtilities::CoreGui::ObserverTreeModel::~ObserverTreeModel() {
-    if (d->rootItem)
-        delete d->rootItem;
+    d->tree_builder.cancelBuild();
+    deleteBuildingRootItem();
+    deleteRootItem();
     delete d;
 }
 
@@ -131,6 +211,7 @@ bool Qtilities::CoreGui::ObserverTreeModel::setObserverContext(Observer* observe
     connect(d_observer,SIGNAL(destroyed()),SLOT(handleObserverContextDeleted()));
     connect(d_observer,SIGNAL(layoutChanged(QList<QPointer<QObject> >)),SLOT(recordObserverChange(QList<QPointer<QObject> >)));
     connect(d_observer,SIGNAL(dataChanged(Observer*)),SLOT(handleContextDataChanged(Observer*)));
+    connect(d_observer,SIGNAL(subjectDataChanged(Observer*,QObject*)),SLOT(handleSubjectDataChanged(Observer*,QObject*)));
 
     // If a selection parent does not exist, we set observer as the selection parent:
     if (!d->selection_parent)
@@ -279,6 +360,48 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
             return QVariant();
     }
 
+    // ------------------------------------
+    // Return cached data when possible
+    // ------------------------------------
+    if (isCachedRole(index.column(),role)) {
+        ObserverTreeItem* item = getItem(index);
+        if (item) {
+            // Child counts depend on the child count settings, when they change all cached data is discarded:
+            if (d->cached_child_count_base_class != columnChildCountBaseClass() || d->cached_child_count_limit != columnChildCountLimit()) {
+                d->cached_child_count_base_class = columnChildCountBaseClass();
+                d->cached_child_count_limit = columnChildCountLimit();
+                ++d->data_cache_generation;
+            }
+
+            QVariant value;
+            if (!item->cachedData(index.column(),role,d->data_cache_generation,&value)) {
+                value = computeData(index,role);
+                item->setCachedData(index.column(),role,d->data_cache_generation,value);
+            }
+            return value;
+        }
+    }
+
+    return computeData(index,role);
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::isCachedRole(int column, int role) const {
+    // Names and check states are not cached: names can change without notifications when the objectName() is used, and
+    // activity is not notified per subject.
+    if (column == columnPosition(ColumnName)) {
+        return (role == Qt::DecorationRole || role == Qt::WhatsThisRole || role == Qt::SizeHintRole || role == Qt::StatusTipRole ||
+                role == Qt::FontRole || role == Qt::TextAlignmentRole || role == Qt::BackgroundRole || role == Qt::ForegroundRole ||
+                role == Qt::ToolTipRole);
+    } else if (column == columnPosition(ColumnChildCount) || column == columnPosition(ColumnTypeInfo)) {
+        return (role == Qt::DisplayRole);
+    } else if (column == columnPosition(ColumnAccess)) {
+        return (role == Qt::DecorationRole);
+    }
+
+    return false;
+}
+
+QVariant Qtilities::CoreGui::ObserverTreeModel::computeData(const QModelIndex &index, int role) const {
     // ------------------------------------
     // Handle Name Column
     // ------------------------------------
@@ -290,6 +413,9 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
             ObserverTreeItem* item = getItem(index);
             if (!item)
                 return tr("Invalid Item");
+            // Value items do not have objects, their names are stored in the items:
+            if (item->itemType() == ObserverTreeItem::ValueItem)
+                return item->objectName();
             QObject* obj = item->getObject();
             if (obj) {
                 // If this is a category item we just use objectName:
@@ -401,9 +527,15 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
             // Check if it has the role shared property set.
             if (obj) {
                 // If this is a category item we just use objectName:
-                if (item->itemType() == ObserverTreeItem::CategoryItem)
-                    return d->icon_provider.icon(QFileIconProvider::Folder);
+                if (item->itemType() == ObserverTreeItem::CategoryItem) {
+                    if (d->category_icon.isNull())
+                        d->category_icon = d->icon_provider.icon(QFileIconProvider::Folder);
+                    return d->category_icon;
+                }
                 else {
+                    QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+                    if (style_data.isValid())
+                        return style_data;
                     SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_DECORATION);
                     if (icon_property.isValid())
                         return icon_property.value();
@@ -435,6 +567,9 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
 
             // Check if it has the role shared property set.
             if (obj) {
+                QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+                if (style_data.isValid())
+                    return style_data;
                 SharedProperty size_property = ObjectManager::getSharedProperty(obj,qti_prop_SIZE_HINT);
                 if (size_property.isValid()) {
                     if (size_property.value().toSize().isValid())
@@ -467,6 +602,9 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
 
             // Check if it has the role shared property set.
             if (obj) {
+                QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+                if (style_data.isValid())
+                    return style_data;
                 SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_FONT);
                 if (icon_property.isValid())
                     return icon_property.value();
@@ -482,6 +620,9 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
 
             // Check if it has the role shared property set.
             if (obj) {
+                QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+                if (style_data.isValid())
+                    return style_data;
                 SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_TEXT_ALIGNMENT);
                 if (icon_property.isValid())
                     return icon_property.value();
@@ -497,6 +638,9 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
 
             // Check if it has the role shared property set.
             if (obj) {
+                QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+                if (style_data.isValid())
+                    return style_data;
                 SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_BACKGROUND);
                 if (icon_property.isValid())
                     return icon_property.value();
@@ -512,6 +656,9 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
 
             // Check if it has the role shared property set.
             if (obj) {
+                QVariant style_data = TreeItemStyleTable::roleDataOf(obj,role);
+                if (style_data.isValid())
+                    return style_data;
                 SharedProperty icon_property = ObjectManager::getSharedProperty(obj,qti_prop_FOREGROUND);
                 if (icon_property.isValid())
                     return icon_property.value();
@@ -584,9 +731,9 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
                     if (obs) {
                         if (obs->accessModeScope() == Observer::CategorizedScope) {
                             if (obs->accessMode(item->category()) == Observer::ReadOnlyAccess)
-                                return QIcon(qti_icon_READ_ONLY_16x16);
+                                return cachedIcon(qti_icon_READ_ONLY_16x16);
                             else if (obs->accessMode(item->category()) == Observer::LockedAccess)
-                                return QIcon(qti_icon_LOCKED_16x16);
+                                return cachedIcon(qti_icon_LOCKED_16x16);
                             else
                                 return QVariant();
                         }
@@ -601,24 +748,24 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::data(const QModelIndex &index, i
                             if (observer->accessMode() == Observer::FullAccess)
                                 return QVariant();
                             if (observer->accessMode() == Observer::ReadOnlyAccess)
-                                return QIcon(qti_icon_READ_ONLY_16x16);
+                                return cachedIcon(qti_icon_READ_ONLY_16x16);
                             if (observer->accessMode() == Observer::LockedAccess)
-                                return QIcon(qti_icon_LOCKED_16x16);
+                                return cachedIcon(qti_icon_LOCKED_16x16);
                         } else {
                             // Inspect the object to see if it has the qti_prop_ACCESS_MODE observer property.
                             QVariant mode = d_observer->getMultiContextPropertyValue(obj,qti_prop_ACCESS_MODE);
                             if (mode.toInt() == (int) Observer::ReadOnlyAccess)
-                                return QIcon(qti_icon_READ_ONLY_16x16);
+                                return cachedIcon(qti_icon_READ_ONLY_16x16);
                             if (mode.toInt() == Observer::LockedAccess)
-                                return QIcon(qti_icon_LOCKED_16x16);
+                                return cachedIcon(qti_icon_LOCKED_16x16);
                         }
                     } else {
                         // Inspect the object to see if it has the qti_prop_ACCESS_MODE observer property.
                         QVariant mode = d_observer->getMultiContextPropertyValue(obj,qti_prop_ACCESS_MODE);
                         if (mode.toInt() == (int) Observer::ReadOnlyAccess)
-                            return QIcon(qti_icon_READ_ONLY_16x16);
+                            return cachedIcon(qti_icon_READ_ONLY_16x16);
                         if (mode.toInt() == Observer::LockedAccess)
-                            return QIcon(qti_icon_LOCKED_16x16);
+                            return cachedIcon(qti_icon_LOCKED_16x16);
                     }
                 }
             }
@@ -656,6 +803,10 @@ Qt::ItemFlags Qtilities::CoreGui::ObserverTreeModel::flags(const QModelIndex &in
              item_flags &= ~Qt::ItemIsSelectable;
      }
 
+     // Value items can only be selected:
+     if (item->itemType() == ObserverTreeItem::ValueItem)
+         return item_flags;
+
      // Handle category items
      if (item->itemType() == ObserverTreeItem::CategoryItem) {
          if (activeHints()->categoryEditingFlags() & ObserverHints::CategoriesEditableTopLevel)
@@ -781,19 +932,19 @@ QVariant Qtilities::CoreGui::ObserverTreeModel::headerData(int section, Qt::Orie
         else
             return d->type_grouping_name;
     } else if ((section == columnPosition(ColumnChildCount)) && (orientation == Qt::Horizontal) && (role == Qt::DecorationRole)) {
-        return QIcon(qti_icon_CHILD_COUNT_22x22);
+        return cachedIcon(qti_icon_CHILD_COUNT_22x22);
     } else if ((section == columnPosition(ColumnChildCount)) && (orientation == Qt::Horizontal) && (role == Qt::ToolTipRole)) {
         return tr("Child Count");
     } else if ((section == columnPosition(ColumnChildCount)) && (orientation == Qt::Horizontal) && (role == Qt::DisplayRole)) {
         return "";
     } else if ((section == columnPosition(ColumnTypeInfo)) && (orientation == Qt::Horizontal) && (role == Qt::DecorationRole)) {
-        return QIcon(qti_icon_TYPE_INFO_22x22);
+        return cachedIcon(qti_icon_TYPE_INFO_22x22);
     } else if ((section == columnPosition(ColumnTypeInfo)) && (orientation == Qt::Horizontal) && (role == Qt::ToolTipRole)) {
         return tr("Type");
     } else if ((section == columnPosition(ColumnTypeInfo)) && (orientation == Qt::Horizontal) && (role == Qt::DisplayRole)) {
         return "";
     } else if ((section == columnPosition(ColumnAccess)) && (orientation == Qt::Horizontal) && (role == Qt::DecorationRole)) {
-        return QIcon(qti_icon_ACCESS_16x16);
+        return cachedIcon(qti_icon_ACCESS_16x16);
     } else if ((section == columnPosition(ColumnAccess)) && (orientation == Qt::Horizontal) && (role == Qt::ToolTipRole)) {
         return tr("Access");
     } else if ((section == columnPosition(ColumnAccess)) && (orientation == Qt::Horizontal) && (role == Qt::DisplayRole)) {
@@ -853,6 +1004,9 @@ bool Qtilities::CoreGui::ObserverTreeModel::dropMimeData(const QMimeData * data,
     Q_UNUSED(data)
     Q_UNUSED(action)
 
+    // The drag session ended:
+    clearDropAcceptanceCache();
+
     if (!d->tree_model_up_to_date)
         return false;
 
@@ -886,7 +1040,31 @@ bool Qtilities::CoreGui::ObserverTreeModel::dropMimeData(const QMimeData * data,
 
     if (obs) {
         const ObserverMimeData* observer_mime_data = qobject_cast<const ObserverMimeData*> (CLIPBOARD_MANAGER->mimeData());
-        if (observer_mime_data) {
+        if (!observer_mime_data && !qobject_cast<const ObserverMimeData*> (data) && target_item_type != ObserverTreeItem::CategoryItem
+                && data && data->hasFormat(qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE)) {
+            // Subjects dragged from another application are constructed from their binary export and attached in one go:
+            QList<QObject*> imported_subjects;
+            bool imported = ObserverMimeData::importSubjects(data,imported_subjects);
+            QString error_msg;
+            QList<QPointer<QObject> > attached_list;
+            if (imported)
+                attached_list = obs->attachSubjects(imported_subjects,Observer::ObserverScopeOwnership,&error_msg);
+
+            // Subjects which were not attached are not owned by any observer:
+            QSet<QObject*> attached_subjects = ObjectManager::convSafeObjectsToNormal(attached_list).toSet();
+            for (int i = 0; i < imported_subjects.count(); ++i) {
+                if (!attached_subjects.contains(imported_subjects.at(i)))
+                    delete imported_subjects.at(i);
+            }
+
+            if (!imported)
+                LOG_ERROR_P(QString(tr("The drop operation could not be completed. The dropped objects could not be constructed in this application.")));
+            else if (attached_subjects.count() != imported_subjects.count())
+                LOG_WARNING_P(QString(tr("The drop operation completed partially. %1/%2 objects were drop successfully. Error message: ").arg(attached_subjects.count()).arg(imported_subjects.count())) + error_msg);
+            else
+                LOG_INFO_P(QString(tr("The drop operation completed successfully on %1 objects.").arg(attached_subjects.count())));
+            return true;
+        } else if (observer_mime_data) {
             // Handle cases where we dropped subjects on a category:
             if (target_item_type == ObserverTreeItem::CategoryItem) {
                 if (target_category) {
@@ -965,6 +1143,100 @@ bool Qtilities::CoreGui::ObserverTreeModel::dropMimeData(const QMimeData * data,
     return true;
 }
 
+Qtilities::Core::Observer* Qtilities::CoreGui::ObserverTreeModel::dropTargetObserver(const QModelIndex& index) const {
+    if (!index.isValid())
+        return d_observer;
+
+    ObserverTreeItem* item = getItem(index);
+    if (item && item->itemType() == ObserverTreeItem::TreeNode) {
+        Observer* obs = qobject_cast<Observer*> (item->getObject());
+        if (obs)
+            return obs;
+    }
+
+    return parentOfIndex(index);
+}
+
+Qtilities::Core::Observer::EvaluationResult Qtilities::CoreGui::ObserverTreeModel::dropAcceptance(const QMimeData* data, const QModelIndex& index) const {
+    if (!d->tree_model_up_to_date || d->read_only)
+        return Observer::Rejected;
+
+    Observer* obs = dropTargetObserver(index);
+    if (!obs)
+        return Observer::Rejected;
+
+    // Same logic as dropMimeData(), which uses the clipboard manager's data for drags within this application:
+    const ObserverMimeData* observer_mime_data = qobject_cast<const ObserverMimeData*> (data);
+    if (!observer_mime_data)
+        observer_mime_data = qobject_cast<const ObserverMimeData*> (CLIPBOARD_MANAGER->mimeData());
+    if (!observer_mime_data) {
+        if (data && data->hasFormat(qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE))
+            return Observer::Allowed;
+        return Observer::Rejected;
+    }
+
+    ObserverTreeItem* item = getItem(index);
+    if (index.isValid() && item && item->itemType() == ObserverTreeItem::CategoryItem) {
+        if ((activeHints()->categoryEditingFlags() & ObserverHints::CategoriesAcceptSubjectDrops) && observer_mime_data->sourceID() == obs->observerID())
+            return Observer::Allowed;
+        return Observer::Rejected;
+    }
+
+    // Running the dragged subjects through the subject filters of the target is expensive, thus it is done once per drag session and target:
+    if (!d->drop_acceptance_valid || d->drop_acceptance_data != data || d->drop_acceptance_target != obs) {
+        d->drop_acceptance_result = obs->canAttach(const_cast<ObserverMimeData*> (observer_mime_data),0,true);
+        d->drop_acceptance_data = data;
+        d->drop_acceptance_target = obs;
+        d->drop_acceptance_valid = true;
+    }
+
+    return d->drop_acceptance_result;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::clearDropAcceptanceCache() {
+    d->drop_acceptance_valid = false;
+    d->drop_acceptance_data = 0;
+    d->drop_acceptance_target = 0;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::hasChildren(const QModelIndex &parent) const {
+    if (!d->tree_model_up_to_date)
+        return false;
+
+    // Nodes which are not populated yet show that they can be expanded when their observers have subjects:
+    ObserverTreeItem* item = getItem(parent);
+    if (item && !item->childrenPopulated()) {
+        Observer* observer = qobject_cast<Observer*> (item->getObject());
+        if (!observer || observer->accessMode() == Observer::LockedAccess)
+            return false;
+        TreeNode* tree_node = qobject_cast<TreeNode*> (observer);
+        return observer->subjectCount() > 0 || (tree_node && tree_node->valueItemCount() > 0);
+    }
+
+    return QAbstractItemModel::hasChildren(parent);
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::canFetchMore(const QModelIndex &parent) const {
+    if (!d->tree_model_up_to_date)
+        return false;
+
+    ObserverTreeItem* item = getItem(parent);
+    return item && !item->childrenPopulated();
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::fetchMore(const QModelIndex &parent) {
+    if (!d->tree_model_up_to_date)
+        return;
+
+    populateItem(getItem(parent),true);
+}
+
+QStringList Qtilities::CoreGui::ObserverTreeModel::mimeTypes() const {
+    QStringList types;
+    types << QString(qti_def_OBSERVER_MIME_DATA_MIME_TYPE) << QString(qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE);
+    return types;
+}
+
 Qt::DropActions Qtilities::CoreGui::ObserverTreeModel::supportedDropActions() const {
     if (!d->tree_model_up_to_date)
         return Qt::IgnoreAction;
@@ -1125,24 +1397,48 @@ void Qtilities::CoreGui::ObserverTreeModel::recordObserverChange(QList<QPointer<
         return;
     }
 
-    if (d->tree_model_up_to_date) {
-        if (d->build_mutex.tryLock()) {
-            d->new_selection = new_selection;
-            #ifdef QTILITIES_BENCHMARKING
-            qDebug() << "Recording observer change on tree model: " << objectName() << ". The tree is not being built at the moment. Initiating a build request.";
-            #endif
-            rebuildTreeStructure();
-            d->build_mutex.unlock();
-        } else {
-            d->tree_rebuild_queued = true;
-            d->queued_selection = new_selection;
-        }
-    } else {
-        d->tree_rebuild_queued = true;
+    // The latest requested selection is used when the next build completes:
+    if (deferChange(PendingLayoutChange)) {
         d->queued_selection = new_selection;
+        return;
+    }
+
+    d->queued_selection = new_selection;
+    if (d->tree_rebuild_queued)
+        return;
+
+    if (d->threaded_building) {
+        // A build in progress is outdated now, thus we cancel it and coalesce all changes received before the next event loop iteration into a single rebuild:
+        if (d->tree_builder.isBuilding())
+            d->tree_builder.cancelBuild();
+        d->tree_rebuild_queued = true;
+        QTimer::singleShot(0,this,SLOT(rebuildTreeStructure()));
+        #ifdef QTILITIES_BENCHMARKING
+        qDebug() << "Recording observer change on tree model: " << objectName() << ". Queueing a build request.";
+        #endif
+    } else if (d->build_in_progress) {
+        // The change was received while building in the GUI thread, receiveBuildObserverTreeItem() will rebuild the tree again.
+        d->tree_rebuild_queued = true;
         #ifdef QTILITIES_BENCHMARKING
         qDebug() << QString("Received tree rebuild request in " + d_observer->observerName() + "'s view. The current tree is being rebuilt, thus queueing this change.");
         #endif
+    } else {
+        d->tree_rebuild_queued = true;
+        rebuildTreeStructure();
+    }
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::applyPendingChanges(PendingChanges changes) {
+    // A rebuild refreshes the data as well, using the selection of the last change which was deferred:
+    if (changes & PendingLayoutChange) {
+        recordObserverChange(d->queued_selection);
+        return;
+    }
+
+    if (changes & PendingDataChange) {
+        ++d->data_cache_generation;
+        if (d->tree_model_up_to_date && d->rootItem && rowCount() > 0)
+            emit dataChanged(index(0,0),index(rowCount() - 1,columnPosition(AbstractObserverItemModel::ColumnLast)));
     }
 }
 
@@ -1151,6 +1447,12 @@ void Qtilities::CoreGui::ObserverTreeModel::clearTreeStructure() {
     qDebug() << "Clearing tree structure on view: " << objectName();
     #endif
 
+    // Builds in progress are not needed anymore:
+    d->tree_builder.cancelBuild();
+    deleteBuildingRootItem();
+    d->build_in_progress = false;
+    d->tree_rebuild_queued = false;
+
     emit treeModelBuildStarted();
     beginResetModel();
     emit layoutAboutToBeChanged();
@@ -1171,104 +1473,141 @@ void Qtilities::CoreGui::ObserverTreeModel::clearTreeStructure() {
 }
 
 void Qtilities::CoreGui::ObserverTreeModel::rebuildTreeStructure() {
+    // Rebuilds are only done when requested through recordObserverChange(), and not after clearTreeStructure():
+    if (!d->tree_rebuild_queued)
+        return;
+    d->tree_rebuild_queued = false;
+    d->new_selection = d->queued_selection;
+    d->queued_selection.clear();
+
+    if (!d_observer)
+        return;
+
     #ifdef QTILITIES_BENCHMARKING
     qDebug() << "Rebuilding tree structure on view: " << objectName();
     #endif
 
-    // The view will call setExpandedItems() in its slot.
-    // Note that the first time we show a context we don't emit the
-    // signal below. This will send an empty list of expanded items
-    // to the view which will cause it to expand all items.
-    if (d->at_least_one_tree_build_completed)
-        emit treeModelBuildAboutToStart();
-
-    // d->expanded_categories would have been set in the above code.
-    // Now we do the needed replacements:
-    QList<QString> keys = d->expanded_categories_replace_map.keys();
-    int count = keys.count();
-    for (int i = 0; i < count; ++i) {
-        if (d->expanded_categories.contains(keys.at(i))) {
-            d->expanded_categories.removeOne(keys.at(i));
-            d->expanded_categories << d->expanded_categories_replace_map.values().at(i);
-            //qDebug() << "Doing expanded items replace:" << d->expanded_categories_replace_map.keys().at(i) << "with" << d->expanded_categories_replace_map.values().at(i);
+    QTI_PERFORMANCE_COUNT("ObserverTreeModel: Rebuilds");
+
+    // When a build is restarted, the view was already notified about it:
+    if (!d->build_in_progress) {
+        d->build_timer.start();
+        // The view will call setExpandedItems() in its slot.
+        // Note that the first time we show a context we don't emit the
+        // signal below. This will send an empty list of expanded items
+        // to the view which will cause it to expand all items.
+        if (d->at_least_one_tree_build_completed)
+            emit treeModelBuildAboutToStart();
+
+        // d->expanded_categories would have been set in the above code.
+        // Now we do the needed replacements:
+        QList<QString> keys = d->expanded_categories_replace_map.keys();
+        int count = keys.count();
+        for (int i = 0; i < count; ++i) {
+            if (d->expanded_categories.contains(keys.at(i))) {
+                d->expanded_categories.removeOne(keys.at(i));
+                d->expanded_categories << d->expanded_categories_replace_map.values().at(i);
+                //qDebug() << "Doing expanded items replace:" << d->expanded_categories_replace_map.keys().at(i) << "with" << d->expanded_categories_replace_map.values().at(i);
+            }
         }
+        d->build_in_progress = true;
+        emit treeModelBuildStarted();
     }
-    emit treeModelBuildStarted();
 
-    // Rebuild the tree structure:
-    beginResetModel();
-    d->tree_model_up_to_date = false;
-    deleteRootItem();
+    // Discard the tree of a build which was cancelled:
+    d->tree_builder.cancelBuild();
+    deleteBuildingRootItem();
 
+    // The new tree is built next to the current tree, which stays in the model until the build completed.
     // The root index display hint determines how we create the root node:
     QVector<QVariant> columns;
     columns.push_back("Child Count");
     columns.push_back("Access");
     columns.push_back("Type Info");
     columns.push_back("Object Tree");
+    // All items of the build are created in an arena, which is released in one go when the tree is replaced:
+    d->building_arena = new ObserverTreeItemArena;
     ObserverTreeItem* item_to_send_to_builder = 0;
     if (model->hints_top_level_observer) {
         if (model->hints_top_level_observer->rootIndexDisplayHint() == ObserverHints::RootIndexHide) {
-            d->rootItem = new ObserverTreeItem(d_observer,0,columns,ObserverTreeItem::TreeNode);
-            d->rootItem->setObjectName("Root Item");
-            item_to_send_to_builder = d->rootItem;
+            d->building_root_item = new (d->building_arena) ObserverTreeItem(d_observer,0,columns,ObserverTreeItem::TreeNode);
+            d->building_root_item->setObjectName("Root Item");
+            item_to_send_to_builder = d->building_root_item;
         } else if (model->hints_top_level_observer->rootIndexDisplayHint() == ObserverHints::RootIndexDisplayDecorated || model->hints_top_level_observer->rootIndexDisplayHint() == ObserverHints::RootIndexDisplayUndecorated) {
-            d->rootItem = new ObserverTreeItem(0,0,columns,ObserverTreeItem::TreeNode);
-            d->rootItem->setObjectName("Root Item");
-            ObserverTreeItem* top_level_observer_item = new ObserverTreeItem(d_observer,d->rootItem,QVector<QVariant>(),ObserverTreeItem::TreeNode);
-            d->rootItem->appendChild(top_level_observer_item);
+            d->building_root_item = new (d->building_arena) ObserverTreeItem(0,0,columns,ObserverTreeItem::TreeNode);
+            d->building_root_item->setObjectName("Root Item");
+            ObserverTreeItem* top_level_observer_item = new (d->building_arena) ObserverTreeItem(d_observer,d->building_root_item,QVector<QVariant>(),ObserverTreeItem::TreeNode);
+            d->building_root_item->appendChild(top_level_observer_item);
             item_to_send_to_builder = top_level_observer_item;
         }
     } else {
-        d->rootItem = new ObserverTreeItem(d_observer,0,columns,ObserverTreeItem::TreeNode);
-        d->rootItem->setObjectName("Root Item");
-        item_to_send_to_builder = d->rootItem;
+        d->building_root_item = new (d->building_arena) ObserverTreeItem(d_observer,0,columns,ObserverTreeItem::TreeNode);
+        d->building_root_item->setObjectName("Root Item");
+        item_to_send_to_builder = d->building_root_item;
     }
 
-    d->tree_rebuild_queued = false;
     d->tree_builder.setRootItem(item_to_send_to_builder);
+    d->tree_builder.setItemArena(d->building_arena);
     d->tree_builder.setUseObserverHints(model->use_observer_hints);
     d->tree_builder.setActiveHints(activeHints());
-    //QApplication::processEvents();
+    d->tree_builder.setUseWorkerThread(d->threaded_building);
+    d->tree_builder.setLazyBuild(lazyInitEnabled());
     d->tree_builder.startBuild();
-    //QApplication::processEvents();
 }
 
 void Qtilities::CoreGui::ObserverTreeModel::receiveBuildObserverTreeItem(ObserverTreeItem* item) {
     Q_UNUSED(item)
 
-    d->tree_model_up_to_date = true;
+    if (!d->building_root_item)
+        return;
 
+    // Swap the new tree into the model:
+    beginResetModel();
+    d->tree_model_up_to_date = false;
+    deleteRootItem();
+    d->rootItem = d->building_root_item;
+    d->root_arena = d->building_arena;
+    d->building_root_item = 0;
+    d->building_arena = 0;
+    if (lazyInitEnabled()) {
+        populateExpandedItems(d->rootItem);
+        d->item_count = countItems(d->rootItem);
+    }
+    d->tree_model_up_to_date = true;
+    d->item_index_valid = false;
     endResetModel();
 
     if (d->tree_rebuild_queued) {
-        // Process events here before doing the next rebuild:
-        QApplication::processEvents();
-        emit selectObjects(d->queued_selection);
-        rebuildTreeStructure();
-    } else {
-        // From my understanding not needed because we do a proper reset sequence.
-        // They cause a repaint which makes the rebuilt operation flicker.
-        //emit layoutAboutToBeChanged();
-        //emit layoutChanged();
-        if (d->do_auto_select_and_expand) {
-            // Restore expanded categories:
-            QModelIndexList expanded_indexes = findExpandedNodeIndexes(d->expanded_categories);
-            expanded_indexes << findExpandedNodeIndexes(d->expanded_objects);
-            emit expandItemsRequest(expanded_indexes);
-
-            // Handle item selection after tree has been rebuilt:
-            if (d->new_selection.count() > 0)
-                emit selectObjects(d->new_selection);
-            else if (d->selected_objects.count() > 0)
-                emit selectObjects(d->selected_objects);
-            else if (d->selected_categories.count() > 0)
-                emit selectCategories(d->selected_categories);
-        }
+        // A change was received while building in the GUI thread, thus the new tree is already outdated.
+        // In threaded mode the queued rebuild is started from the event loop.
+        if (!d->threaded_building)
+            rebuildTreeStructure();
+        return;
+    }
 
-        d->at_least_one_tree_build_completed = true;
+    d->build_in_progress = false;
+    QTI_PERFORMANCE_SAMPLE("ObserverTreeModel: Rebuild Duration (us)",d->build_timer.nsecsElapsed() / 1000);
+
+    // From my understanding not needed because we do a proper reset sequence.
+    // They cause a repaint which makes the rebuilt operation flicker.
+    //emit layoutAboutToBeChanged();
+    //emit layoutChanged();
+    if (d->do_auto_select_and_expand) {
+        // Restore expanded categories:
+        QModelIndexList expanded_indexes = findExpandedNodeIndexes(d->expanded_categories);
+        expanded_indexes << findExpandedNodeIndexes(d->expanded_objects);
+        emit expandItemsRequest(expanded_indexes);
+
+        // Handle item selection after tree has been rebuilt:
+        if (d->new_selection.count() > 0)
+            emit selectObjects(d->new_selection);
+        else if (d->selected_objects.count() > 0)
+            emit selectObjects(d->selected_objects);
+        else if (d->selected_categories.count() > 0)
+            emit selectCategories(d->selected_categories);
     }
 
+    d->at_least_one_tree_build_completed = true;
     emit treeModelBuildEnded();
 }
 
@@ -1276,6 +1615,11 @@ void Qtilities::CoreGui::ObserverTreeModel::setExpandedItems(const QList<QPointe
     //qDebug() << "setExpandedItems" << expanded_categories;
     d->expanded_categories = expanded_categories;
     d->expanded_objects = expanded_objects;
+    d->expanded_object_set.clear();
+    for (int i = 0; i < expanded_objects.count(); ++i) {
+        if (expanded_objects.at(i))
+            d->expanded_object_set.insert(expanded_objects.at(i));
+    }
 }
 
 void Qtilities::CoreGui::ObserverTreeModel::enableAutoSelectAndExpand() {
@@ -1286,6 +1630,63 @@ void Qtilities::CoreGui::ObserverTreeModel::disableAutoSelectAndExpand() {
     d->do_auto_select_and_expand = false;
 }
 
+bool Qtilities::CoreGui::ObserverTreeModel::releaseChildren(const QModelIndex& index) {
+    if (!lazyInitEnabled() || !d->tree_model_up_to_date)
+        return false;
+
+    ObserverTreeItem* item = getItem(index);
+    if (!item || item == d->rootItem || item->itemType() != ObserverTreeItem::TreeNode || !item->childrenPopulated())
+        return false;
+
+    int count = item->childCount();
+    if (count > 0) {
+        beginRemoveRows(indexForItem(item),0,count-1);
+        d->item_count -= countItems(item);
+        item->removeChildren();
+        item->setChildrenPopulated(false);
+        d->item_index_valid = false;
+        endRemoveRows();
+    } else
+        item->setChildrenPopulated(false);
+
+    return true;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::releaseCollapsedChildren(const QModelIndex& index) {
+    if (!lazyInitEnabled() || d->item_count <= d->lazy_item_limit)
+        return;
+
+    releaseChildren(index);
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::setLazyItemLimit(int limit) {
+    d->lazy_item_limit = limit;
+}
+
+int Qtilities::CoreGui::ObserverTreeModel::lazyItemLimit() const {
+    return d->lazy_item_limit;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::enableThreadedBuilding() {
+    d->threaded_building = true;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::disableThreadedBuilding() {
+    d->threaded_building = false;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModel::threadedBuildingEnabled() const {
+    return d->threaded_building;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::setParallelBuildThreshold(int count) {
+    d->tree_builder.setParallelSubtreeThreshold(count);
+}
+
+int Qtilities::CoreGui::ObserverTreeModel::parallelBuildThreshold() const {
+    return d->tree_builder.parallelSubtreeThreshold();
+}
+
 Qtilities::Core::Observer* Qtilities::CoreGui::ObserverTreeModel::calculateSelectionParent(QModelIndexList index_list) {
     if (index_list.count() == 1) {
         d->selection_parent = parentOfIndex(index_list.front());
@@ -1368,6 +1769,35 @@ void Qtilities::CoreGui::ObserverTreeModel::refresh() {
     recordObserverChange();
 }
 
+MemoryUsageReport Qtilities::CoreGui::ObserverTreeModel::memoryUsage() const {
+    MemoryUsageReport report;
+    if (!d->rootItem)
+        return report;
+
+    const int pointer_bytes = sizeof(QPointer<ObserverTreeItem>);
+    qint64 item_bytes = 0;
+    int item_count = 0;
+    QList<ObserverTreeItem*> items;
+    items << d->rootItem;
+    while (!items.isEmpty()) {
+        ObserverTreeItem* item = items.takeLast();
+        const int child_count = item->childCount();
+        item_bytes += sizeof(ObserverTreeItem) + sizeof(QObject);
+        item_bytes += MemoryUsageReport::estimatedListBytes(child_count,pointer_bytes);
+        item_bytes += MemoryUsageReport::estimatedHashBytes(child_count,sizeof(QString) + pointer_bytes);
+        item_bytes += MemoryUsageReport::estimatedHashBytes(item->cachedDataCount(),sizeof(int) + sizeof(QVariant));
+        ++item_count;
+
+        for (int i = 0; i < child_count; ++i) {
+            if (item->child(i))
+                items << item->child(i);
+        }
+    }
+
+    report.addBytes(MemoryUsageReport::ModelItemMemory,"ObserverTreeItem",item_bytes,item_count);
+    return report;
+}
+
 Qtilities::Core::Observer* Qtilities::CoreGui::ObserverTreeModel::selectionParent() const {
     return d->selection_parent;
 }
@@ -1410,6 +1840,11 @@ void Qtilities::CoreGui::ObserverTreeModel::handleContextDataChanged(Observer* o
         qDebug() << "Ignoring data changes to observer" << observer->observerName() << "in tree model.";
         return;
     }
+    if (deferChange(PendingDataChange))
+        return;
+
+    // The change can affect any item, thus all cached data is discarded:
+    ++d->data_cache_generation;
 
     QModelIndex parent_index = findObject(observer);
     bool parent_index_valid = parent_index.isValid();
@@ -1437,6 +1872,8 @@ void Qtilities::CoreGui::ObserverTreeModel::handleContextDataChanged(Observer* o
 }
 
 void Qtilities::CoreGui::ObserverTreeModel::handleContextDataChanged(const QModelIndex &set_data_index) {
+    ++d->data_cache_generation;
+
     // We get the indexes for the complete context since activity of many objects might change:
     // Warning: This is not going to work for categorized hierarchy observers.
     QModelIndex parent_index = parent(set_data_index);
@@ -1460,6 +1897,134 @@ void Qtilities::CoreGui::ObserverTreeModel::handleContextDataChanged(const QMode
         emit dataChanged(top_left,bottom_right);
 }
 
+void Qtilities::CoreGui::ObserverTreeModel::handleSubjectDataChanged(Observer* observer, QObject* subject) {
+    Q_UNUSED(observer)
+
+    if (!subject || !respondToObserverChanges())
+        return;
+    if (deferChange(PendingDataChange))
+        return;
+    if (!d->tree_model_up_to_date || !d->rootItem)
+        return;
+
+    // The same subject can appear multiple times in the tree, all its items are refreshed:
+    const QList<QPointer<ObserverTreeItem> > items = itemsOfObject(subject);
+    int last_column = columnPosition(AbstractObserverItemModel::ColumnLast);
+    for (int i = 0; i < items.count(); ++i) {
+        ObserverTreeItem* item = items.at(i);
+        if (!item)
+            continue;
+
+        item->clearCachedData();
+
+        int row = item->row();
+        emit dataChanged(createIndex(row,0,item),createIndex(row,last_column,item));
+    }
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::populateItem(ObserverTreeItem* item, bool notify_views) {
+    if (!item || item->childrenPopulated())
+        return;
+
+    item->setChildrenPopulated(true);
+    Observer* observer = qobject_cast<Observer*> (item->getObject());
+    if (!observer)
+        return;
+
+    // Build the children underneath a staging item first, thus we know how many rows will be inserted:
+    ObserverTreeItem staging_item(observer,0,QVector<QVariant>(),ObserverTreeItem::TreeNode);
+    // The children are created on the heap, since releaseChildren() can delete them again long before the arena of the tree is released:
+    ObserverTreeModelBuilder builder(&staging_item,model->use_observer_hints,activeHints());
+    builder.setLazyBuild(true);
+    builder.startBuild();
+
+    int count = staging_item.childCount();
+    if (count == 0)
+        return;
+
+    if (notify_views)
+        beginInsertRows(indexForItem(item),0,count-1);
+    item->adoptChildren(&staging_item);
+    d->item_count += countItems(item);
+    // Add the new items to the object index when it is in use, at their positions in the tree since other items of their objects can follow them:
+    if (d->item_index_valid) {
+        for (int i = 0; i < item->childCount(); ++i)
+            indexTreeItems(item->child(i),true);
+    }
+    if (notify_views)
+        endInsertRows();
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::populateExpandedItems(ObserverTreeItem* item) {
+    if (!item)
+        return;
+
+    const QList<QPointer<ObserverTreeItem> > children = item->childItemReferences();
+    for (int i = 0; i < children.count(); ++i) {
+        ObserverTreeItem* child_item = children.at(i);
+        if (!child_item)
+            continue;
+
+        if (!child_item->childrenPopulated()) {
+            if (!d->expanded_object_set.contains(child_item->getObject()))
+                continue;
+            populateItem(child_item,false);
+        }
+        populateExpandedItems(child_item);
+    }
+}
+
+int Qtilities::CoreGui::ObserverTreeModel::countItems(ObserverTreeItem* item) const {
+    if (!item)
+        return 0;
+
+    int count = item->childCount();
+    for (int i = 0; i < item->childCount(); ++i)
+        count += countItems(item->child(i));
+    return count;
+}
+
+QModelIndex Qtilities::CoreGui::ObserverTreeModel::indexForItem(ObserverTreeItem* item) const {
+    if (!item || item == d->rootItem)
+        return QModelIndex();
+
+    return createIndex(item->row(),0,item);
+}
+
+QList<QPointer<Qtilities::CoreGui::ObserverTreeItem> > Qtilities::CoreGui::ObserverTreeModel::itemsOfObject(const QObject* obj) const {
+    if (!d->rootItem)
+        return QList<QPointer<ObserverTreeItem> >();
+
+    if (!d->item_index_valid) {
+        d->item_index.clear();
+        indexTreeItems(d->rootItem);
+        d->item_index_valid = true;
+    }
+
+    return d->item_index.value(obj);
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::indexTreeItems(ObserverTreeItem* item, bool insert_in_tree_order) const {
+    if (!item)
+        return;
+
+    if (item->getObject()) {
+        QList<QPointer<ObserverTreeItem> >& items = d->item_index[item->getObject()];
+        int position = items.count();
+        if (insert_in_tree_order && !items.isEmpty()) {
+            // Search backwards, since items fetched later usually follow the items already in the index:
+            const QVector<int> path = qti_private_TreeItemPath(item);
+            while (position > 0 && (!items.at(position-1) || qti_private_TreeItemPathBefore(path,qti_private_TreeItemPath(items.at(position-1)))))
+                --position;
+        }
+        items.insert(position,item);
+    }
+
+    const QList<QPointer<ObserverTreeItem> > children = item->childItemReferences();
+    for (int i = 0; i < children.count(); ++i)
+        indexTreeItems(children.at(i),insert_in_tree_order);
+}
+
 void Qtilities::CoreGui::ObserverTreeModel::setSelectedObjects(QList<QPointer<QObject> > selected_objects) {
     d->selected_objects = selected_objects;
 }
@@ -1484,11 +2049,17 @@ QModelIndexList Qtilities::CoreGui::ObserverTreeModel::getPersistentIndexList()
 }
 
 QModelIndex Qtilities::CoreGui::ObserverTreeModel::findObject(QObject* obj, int column) const {
-    QList<QModelIndex> indices = rootIndices();
-    for (int i = 0; i < indices.count(); i++) {
-        QModelIndex index = findObject(indices.at(i),obj,column);
-        if (index.isValid())
-            return index;
+    if (!obj || !d->tree_model_up_to_date || !model->hints_top_level_observer)
+        return QModelIndex();
+
+    // The index lists the items of an object in the order they appear in the tree, thus the first item underneath the root indices is used:
+    const QList<QPointer<ObserverTreeItem> > items = itemsOfObject(obj);
+    for (int i = 0; i < items.count(); ++i) {
+        ObserverTreeItem* item = items.at(i);
+        if (!item || item == d->rootItem)
+            continue;
+
+        return indexForObjectItem(item,column);
     }
 
     return QModelIndex();
@@ -1510,47 +2081,60 @@ QModelIndex Qtilities::CoreGui::ObserverTreeModel::findCategory(QtilitiesCategor
 }
 
 QModelIndex Qtilities::CoreGui::ObserverTreeModel::findObject(const QModelIndex& current_index, QObject* obj, int column) const {
-    QModelIndex correct_index;
-    if (current_index.isValid()) {
-        // Check this index:
-        ObserverTreeItem* item = getItem(current_index);
-        if (item) {
-            if (item->getObject() == obj)
-                return current_index;
+    ObserverTreeItem* item = getItem(current_index);
+    if (!item)
+        return QModelIndex();
 
-            if (column == -1)
-                column = columnPosition(ObserverTreeModel::ColumnName);
+    if (item->getObject() == obj)
+        return current_index;
 
-            //qDebug() << "findObject(): " << item->getObject()->objectName();
+    ObserverTreeItem* found_item = findObject(item,obj);
+    if (found_item)
+        return indexForObjectItem(found_item,column);
 
-            // Ok it was not this index, loop through all children under this index:
-            for (int i = 0; i < item->childCount(); ++i) {
-                QModelIndex child_index = index(i,column,current_index);
-                correct_index = findObject(child_index,obj);
-                if (correct_index.isValid()) {
-                    return correct_index;
-                }
-            }
-        }
-    }
     return QModelIndex();
 }
 
 Qtilities::CoreGui::ObserverTreeItem* Qtilities::CoreGui::ObserverTreeModel::findObject(ObserverTreeItem* item, QObject* obj) const {
+    if (!item || !obj)
+        return 0;
+
     // Check item:
     if (item->getObject() == obj)
         return item;
 
-    // Check all the children of item and traverse into them.
-    for (int i = 0; i < item->childCount(); ++i) {
-        ObserverTreeItem* tree_item = findObject(item->childItemReferences().at(i),obj);
-        if (tree_item)
-            return tree_item;
+    // Find the first item of obj which is underneath item:
+    const QList<QPointer<ObserverTreeItem> > items = itemsOfObject(obj);
+    for (int i = 0; i < items.count(); ++i) {
+        ObserverTreeItem* parent_item = items.at(i);
+        if (!parent_item)
+            continue;
+
+        ObserverTreeItem* object_item = parent_item;
+        while (parent_item) {
+            parent_item = parent_item->parentItem();
+            if (parent_item == item)
+                return object_item;
+        }
     }
 
     return 0;
 }
 
+QModelIndex Qtilities::CoreGui::ObserverTreeModel::indexForObjectItem(ObserverTreeItem* item, int column) const {
+    if (!item || item == d->rootItem)
+        return QModelIndex();
+
+    // Root indices are returned in the first column, other items in the name column by default:
+    ObserverTreeItem* parent_item = item->parentItem();
+    if (!parent_item || parent_item == d->rootItem)
+        return createIndex(item->row(),0,item);
+
+    if (column == -1)
+        column = columnPosition(ObserverTreeModel::ColumnName);
+    return createIndex(item->row(),column,item);
+}
+
 QModelIndex Qtilities::CoreGui::ObserverTreeModel::findCategory(const QModelIndex& current_index, QtilitiesCategory category) const {
     QModelIndex correct_index;
     if (current_index.isValid()) {
@@ -1590,11 +2174,27 @@ Qtilities::CoreGui::ObserverTreeItem* Qtilities::CoreGui::ObserverTreeModel::fin
 }
 
 void Qtilities::CoreGui::ObserverTreeModel::deleteRootItem() {
-    if (!d->rootItem)
-        return;
+    d->item_index.clear();
+    d->item_index_valid = false;
+
+    if (d->rootItem) {
+        delete d->rootItem;
+        d->rootItem = 0;
+    }
+
+    // All items in the arena were deleted along with the root item:
+    delete d->root_arena;
+    d->root_arena = 0;
+}
+
+void Qtilities::CoreGui::ObserverTreeModel::deleteBuildingRootItem() {
+    if (d->building_root_item) {
+        delete d->building_root_item;
+        d->building_root_item = 0;
+    }
 
-    delete d->rootItem;
-    d->rootItem = 0;
+    delete d->building_arena;
+    d->building_arena = 0;
 }
 
 QList<QModelIndex> Qtilities::CoreGui::ObserverTreeModel::rootIndices() const {
@@ -1617,13 +2217,34 @@ QList<QModelIndex> Qtilities::CoreGui::ObserverTreeModel::rootIndices() const {
 
 QModelIndexList Qtilities::CoreGui::ObserverTreeModel::findExpandedNodeIndexes(const QStringList& node_names) const {
     QModelIndexList complete_match_list;
+    if (!d->rootItem || !d->tree_model_up_to_date)
+        return complete_match_list;
+
+    // Modified nodes are displayed with a trailing *:
+    QSet<QString> remaining_names;
     foreach (const QString& item, node_names) {
-        complete_match_list.append(match(index(0,columnPosition(AbstractObserverItemModel::ColumnName)),Qt::DisplayRole,QVariant::fromValue(item),1,Qt::MatchRecursive));
-        complete_match_list.append(match(index(0,columnPosition(AbstractObserverItemModel::ColumnName)),Qt::DisplayRole,QVariant::fromValue(item + "*"),1,Qt::MatchRecursive));
+        remaining_names.insert(item);
+        remaining_names.insert(item + "*");
     }
+
+    findNamedItems(d->rootItem,remaining_names,complete_match_list);
     return complete_match_list;
 }
 
+void Qtilities::CoreGui::ObserverTreeModel::findNamedItems(ObserverTreeItem* item, QSet<QString>& remaining_names, QModelIndexList& matches) const {
+    int name_column = columnPosition(AbstractObserverItemModel::ColumnName);
+    for (int row = 0; row < item->childCount() && !remaining_names.isEmpty(); ++row) {
+        ObserverTreeItem* child_item = item->child(row);
+        if (!child_item)
+            continue;
+
+        QModelIndex child_index = createIndex(row,name_column,child_item);
+        if (remaining_names.remove(data(child_index,Qt::DisplayRole).toString()))
+            matches << child_index;
+        findNamedItems(child_item,remaining_names,matches);
+    }
+}
+
 QModelIndexList Qtilities::CoreGui::ObserverTreeModel::findExpandedNodeIndexes(const QList<QPointer<QObject> > &objects) const {
     QModelIndexList complete_match_list;
     for (int i = 0; i < objects.count(); i++) {
@@ -1646,15 +2267,13 @@ QModelIndexList Qtilities::CoreGui::ObserverTreeModel::getAllIndexes(ObserverTre
                 return indexes;
 
             // Add this root and call getAllIndexes on all its children.
-            QModelIndex index = findObject(item->getObject());
-            indexes << index;
+            indexes << incides.at(i);
             for (int r = 0; r < item->childCount(); ++r)
                 getAllIndexes(item->child(r));
         }
     } else {
-        // Add this root and call getAllIndexes on all its children.
-        QModelIndex index = findObject(item->getObject());
-        indexes << index;
+        // Add this item and call getAllIndexes on all its children. Categories are not found by findObject(), thus the item's own index is used:
+        indexes << indexForItem(item);
         for (int r = 0; r < item->childCount(); ++r)
             getAllIndexes(item->child(r));
     }
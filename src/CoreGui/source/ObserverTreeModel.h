@@ -22,6 +22,7 @@
 #include <QAbstractItemModel>
 #include <QStack>
 #include <QItemSelection>
+#include <QSet>
 
 namespace Qtilities {
     namespace CoreGui {
@@ -46,6 +47,16 @@ namespace Qtilities {
         add columns etc. to your view. The <a class="el" href="namespace_qtilities_1_1_examples_1_1_clipboard.html">Clipboard Example</a> shows how
         to do this.
 
+        The tree structure is rebuilt by an ObserverTreeModelBuilder whenever the layout of the observer context changes. By default the builder creates the new tree
+        in a worker thread from a snapshot of the observer tree, while the model keeps showing the previous tree. The new tree is swapped in with a single model
+        reset once it is complete. Layout changes received while a build is in progress cancel the build, and multiple changes are coalesced into a single rebuild.
+        See disableThreadedBuilding() to build the tree in the GUI thread instead.
+
+        When lazy initialization is enabled using toggleLazyInit(), only the children of the top level observer are built by a rebuild. The children of other
+        observer nodes are built when views fetch them through canFetchMore() and fetchMore(), for example when nodes are expanded. Note that findObject()
+        and the selection functions only find objects in nodes which were built. To limit the size of large lazily built trees, the children of collapsed
+        nodes are released again once the tree holds more than lazyItemLimit() items.
+
         \sa ObserverTableModel
           */
         class QTILITIES_CORE_GUI_SHARED_EXPORT ObserverTreeModel : public QAbstractItemModel, public AbstractObserverItemModel
@@ -68,7 +79,18 @@ namespace Qtilities {
             virtual QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
             virtual QModelIndex parent(const QModelIndex &index) const;
             virtual bool dropMimeData(const QMimeData * data, Qt::DropAction action, int row, int column, const QModelIndex & parent);
+            //! Returns the mime types which can be dropped on the model.
+            /*!
+              Besides the in-process ObserverMimeData format, the model accepts Qtilities::Core::Constants::qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE
+              data dragged from other applications. Such subjects are constructed using ObserverMimeData::importSubjects() when they are dropped.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual QStringList mimeTypes() const;
             virtual Qt::DropActions supportedDropActions() const;
+            virtual bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+            virtual bool canFetchMore(const QModelIndex &parent) const;
+            virtual void fetchMore(const QModelIndex &parent);
 
             // --------------------------------
             // AbstractObserverItemModel Implementation
@@ -83,6 +105,14 @@ namespace Qtilities {
             // --------------------------------
             // ObserverTreeModel Implementation
             // --------------------------------
+            //! Returns an estimate of the memory used by the items of the model.
+            /*!
+              The items are counted in the Qtilities::Core::MemoryUsageReport::ModelItemMemory category, including their child lists and cached data.
+              The objects shown in the model are not counted, use Qtilities::Core::Observer::memoryUsage() on the observer context for them.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            MemoryUsageReport memoryUsage() const;
             //! Function which gives the visible column position. Thus it takes into account if columns are hidden.
             int columnVisiblePosition(AbstractObserverItemModel::ColumnID column_id) const;
             //! Returns a QStack with the parent hierarchy (in terms of observer IDs) for the object at the given index.
@@ -126,6 +156,8 @@ namespace Qtilities {
             QModelIndex findCategory(QtilitiesCategory category) const;
             //! Finds the matching QModelIndex indexes for all nodes with display names specified by \p node_names.
             /*!
+              The tree is traversed once, and the first node displaying each name is returned.
+
               \sa Qtilities::CoreGui::ObserverWidget::findExpandedItems()
               */
             QModelIndexList findExpandedNodeIndexes(const QStringList& node_names) const;
@@ -136,6 +168,33 @@ namespace Qtilities {
               <i>This function was added in %Qtilities v1.5.</i>
               */
             QModelIndexList findExpandedNodeIndexes(const QList<QPointer<QObject> >& objects) const;
+            //! Returns the observer which receives subjects dropped on the item at \p index.
+            /*!
+              This is the observer represented by \p index for nodes, and the parent observer of \p index for all other items. When \p index is invalid,
+              the observer context of the model is returned.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            Observer* dropTargetObserver(const QModelIndex& index) const;
+            //! Evaluates if \p data can be dropped on the item at \p index.
+            /*!
+              Views call this function for every drag move event, thus the result of Observer::canAttach() for the dragged subjects is cached per drag
+              session and target observer: it is only evaluated again when \p data is different from the data of the previous call, or when the drag moves
+              over an item with a different target observer (see dropTargetObserver()). Call clearDropAcceptanceCache() when a drag session ends.
+
+              Drops on categories are allowed when the observer accepts subject drops on categories and the subjects come from the same observer.
+              Data dragged from other applications can't be evaluated before the subjects are constructed, thus it is allowed.
+
+              \returns Observer::Rejected when the drop will be rejected, Observer::Allowed or Observer::Conditional otherwise.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            Observer::EvaluationResult dropAcceptance(const QMimeData* data, const QModelIndex& index) const;
+            //! Discards the cached result of dropAcceptance(), views call this when a drag enters or leaves them and when data was dropped.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void clearDropAcceptanceCache();
 
         public slots:
             //! When the observer context changes, this function will take note of the change and when needed, the model will rebuild the internal tree structure using rebuildTreeStructure();
@@ -160,6 +219,14 @@ namespace Qtilities {
               This function will emit the dataChanged() signal with the indexes of all items in the same context as the item defined by \p index.
               */
             void handleContextDataChanged(const QModelIndex &set_data_index);
+            //! Handle data changes of a single subject in the tree.
+            /*!
+              This function will emit the dataChanged() signal only for the items representing \p subject. It is connected to the
+              Observer::subjectDataChanged() signal of the top level observer, which is repeated by all observers in the tree.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSubjectDataChanged(Observer* observer, QObject* subject);
             //! Function to let the model know which objects are currently selected in the view connected to this model.
             /*!
               This functionality is used when the layout of the tree changed externally (not in the view) and we
@@ -214,6 +281,79 @@ namespace Qtilities {
               \sa enableAutoSelectAndExpand()
               */
             void disableAutoSelectAndExpand();
+            //! Enables building of the tree structure in a worker thread.
+            /*!
+              True by default. Changes to this setting are used from the next rebuild of the tree.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa disableThreadedBuilding(), threadedBuildingEnabled()
+              */
+            void enableThreadedBuilding();
+            //! Disables building of the tree structure in a worker thread.
+            /*!
+              When disabled, the tree is rebuilt in the GUI thread and it is up to date as soon as the observer's layout change was received.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa enableThreadedBuilding(), threadedBuildingEnabled()
+              */
+            void disableThreadedBuilding();
+            //! Indicates if the tree structure is built in a worker thread.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa enableThreadedBuilding(), disableThreadedBuilding()
+              */
+            bool threadedBuildingEnabled() const;
+            //! Sets the number of top level observers from which the subtrees underneath them are built in parallel.
+            /*!
+              Wide trees with many independent observers underneath the top level observer are built faster by building their subtrees concurrently on a thread
+              pool. When \p count is 0 (the default), trees are always built serially. See ObserverTreeModelBuilder::setParallelSubtreeThreshold() for details.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setParallelBuildThreshold(int count);
+            //! Gets the number of top level observers from which the subtrees underneath them are built in parallel.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int parallelBuildThreshold() const;
+
+            //! Releases the children of a node when the tree is built lazily.
+            /*!
+              When lazy initialization is enabled (see toggleLazyInit()), the children of observer nodes are only built when a view fetches them using fetchMore(),
+              for example when the node is expanded. This function removes the children of \p index again, and they will be built again when they are fetched
+              the next time.
+
+              \returns True when the children were released, false when lazy initialization is disabled or \p index is not an observer node.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa releaseCollapsedChildren()
+              */
+            bool releaseChildren(const QModelIndex& index);
+            //! Releases the children of a collapsed node when the tree holds more items than lazyItemLimit().
+            /*!
+              ObserverWidget calls this function when nodes are collapsed in its tree view. Only has an effect when lazy initialization is enabled.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa releaseChildren()
+              */
+            void releaseCollapsedChildren(const QModelIndex& index);
+            //! Sets the number of items which can be built lazily before the children of collapsed nodes are released.
+            /*!
+              The default is 20000 items.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setLazyItemLimit(int limit);
+            //! Returns the number of items which can be built lazily before the children of collapsed nodes are released.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int lazyItemLimit() const;
 
         signals:
             //! Signal which is emmited when the current selection parent changed. If the root item is selected, new_observer will be null.
@@ -237,22 +377,53 @@ namespace Qtilities {
             //! Clears the tree structure without rebuilding it again from its observer context.
             void clearTreeStructure();
             //! Function which will rebuild the complete tree structure under the top level observer.
+            /*!
+              The current tree stays in the model until receiveBuildObserverTreeItem() swaps in the new tree.
+              */
             void rebuildTreeStructure();
             //! Slot which receives ready-built ObserverTreeItem from ObserverTreeModelBuilder.
             void receiveBuildObserverTreeItem(ObserverTreeItem* item);
 
         protected:
-            //! Recursive function used by findObject() to traverse through the tree trying to find an object.
+            //! Rebuilds the tree once for all layout changes received while updates were suspended, or refreshes the data of all items.
+            void applyPendingChanges(PendingChanges changes);
+            //! Function used by findObject() to find an object at or underneath an index.
             QModelIndex findObject(const QModelIndex& index, QObject* obj, int column = -1) const;
-            //! Recursive function to get the ObserverTreeItem associacted with an object.
+            //! Function to get the first ObserverTreeItem at or underneath item which is associated with an object.
             ObserverTreeItem* findObject(ObserverTreeItem* item, QObject* obj) const;
 
             //! Recursive function used by findCategory() to traverse through the tree trying to find a category.
             QModelIndex findCategory(const QModelIndex& index, QtilitiesCategory category) const;
             //! Recursive function to get the ObserverTreeItem associacted with a category.
             ObserverTreeItem* findCategory(ObserverTreeItem* item, QtilitiesCategory category) const;
-            //! Deletes all tree items, starting with the root item.
+            //! Deletes all tree items, starting with the root item, and releases their arena.
             void deleteRootItem();
+            //! Deletes the tree of the build in progress and releases its arena.
+            void deleteBuildingRootItem();
+            //! Adds item and all items underneath it to the index returned by itemsOfObject().
+            /*!
+              When insert_in_tree_order is true, the items are inserted at their positions in the tree instead of being appended, which is used
+              for items which are added to an existing index.
+              */
+            void indexTreeItems(ObserverTreeItem* item, bool insert_in_tree_order = false) const;
+            //! Returns the items representing obj, in the order they appear in the tree. The index is built on demand and kept until the tree changes.
+            QList<QPointer<ObserverTreeItem> > itemsOfObject(const QObject* obj) const;
+            //! Returns the index of an item found using findObject().
+            QModelIndex indexForObjectItem(ObserverTreeItem* item, int column) const;
+            //! Builds the children of an observer item which was not populated yet. Views are notified about the new rows when \p notify_views is true.
+            void populateItem(ObserverTreeItem* item, bool notify_views);
+            //! Populates the items of expanded objects which are underneath item, used to restore expanded nodes after lazy rebuilds.
+            void populateExpandedItems(ObserverTreeItem* item);
+            //! Returns the number of items underneath item.
+            int countItems(ObserverTreeItem* item) const;
+            //! Adds the first item underneath \p item displaying each of \p remaining_names to \p matches, in the order they appear in the tree. Found names are removed from \p remaining_names.
+            void findNamedItems(ObserverTreeItem* item, QSet<QString>& remaining_names, QModelIndexList& matches) const;
+            //! Returns the model index of item.
+            QModelIndex indexForItem(ObserverTreeItem* item) const;
+            //! Indicates if data() caches the data of a column and role in the tree items.
+            bool isCachedRole(int column, int role) const;
+            //! Computes the data returned by data() for columns which are not hidden.
+            QVariant computeData(const QModelIndex &index, int role) const;
             //! Finds the root indices.
             /*!
              * Depending on the root index display hint, there can be one or more root indices.
@@ -12,19 +12,501 @@
 #include "ObserverTreeModelBuilder.h"
 #include <QtilitiesCoreGui>
 
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QSet>
+
 #include <stdio.h>
 #include <time.h>
 
 using namespace QtilitiesCoreGui;
 
+namespace Qtilities {
+    namespace CoreGui {
+        // Takes a snapshot of an observer tree and creates the ObserverTreeItem hierarchy for it, either in the calling thread or in the worker thread.
+        class ObserverTreeModelBuilderWorker : public QThread
+        {
+        public:
+            // A subject in the snapshot.
+            struct SnapshotSubject {
+                SnapshotSubject() : is_observer(false),
+                    node(-1) {}
+
+                QPointer<QObject>   object;
+                QString             name;
+                QString             category;
+                bool                is_observer;
+                //! The index of the subject's node in nodes when the subject is an observer which must be built, otherwise -1.
+                int                 node;
+            };
+
+            // The display decisions of a set of hints, which are shared by all observers in the snapshot using equal hints.
+            struct SnapshotHints {
+                SnapshotHints() : use_categorized(false),
+                    category_filter_enabled(false),
+                    inversed_category_display(false) {}
+
+                bool                            use_categorized;
+                bool                            category_filter_enabled;
+                bool                            inversed_category_display;
+                QSet<QtilitiesCategory>         displayed_categories;
+            };
+
+            // An observer in the snapshot.
+            struct SnapshotNode {
+                SnapshotNode() : access_mode(Observer::InvalidAccess),
+                    uncategorized_access_mode(Observer::InvalidAccess),
+                    use_categorized(false),
+                    hints(-1) {}
+
+                QPointer<Observer>              observer;
+                Observer::AccessMode            access_mode;
+                Observer::AccessMode            uncategorized_access_mode;
+                bool                            use_categorized;
+                //! The index of the observer's hints in snapshot_hints, -1 when the observer does not have hints.
+                int                             hints;
+                //! All subjects, in the order of subjectReferenceCategoryMap() when use_categorized is true.
+                QList<SnapshotSubject>          subjects;
+                //! The uncategorized subjects, only used when use_categorized is true.
+                QList<SnapshotSubject>          uncategorized_subjects;
+                //! The access modes of all category levels, keyed by the level joined with "::".
+                QHash<QString,int>              category_access_modes;
+                //! The value items of the observer when it is a TreeNode.
+                QStringList                     value_items;
+            };
+
+            //! A subtree underneath a child of the root item, built on the thread pool in parallel builds.
+            struct ParallelSubtree {
+                ParallelSubtree() : item(0),
+                    node(-1),
+                    arena(0),
+                    staging_item(0) {}
+
+                //! The item which will receive the children of the subtree.
+                ObserverTreeItem*       item;
+                int                     node;
+                ObserverTreeItemArena*  arena;
+                //! The item underneath which the subtree was built.
+                ObserverTreeItem*       staging_item;
+            };
+
+            //! Builds a ParallelSubtree on the thread pool.
+            class SubtreeRunnable : public QRunnable
+            {
+            public:
+                SubtreeRunnable(ObserverTreeModelBuilderWorker* worker, ParallelSubtree* subtree, QThread* item_thread) :
+                    worker(worker), subtree(subtree), item_thread(item_thread) {}
+
+                void run() {
+                    worker->buildParallelSubtree(subtree,item_thread);
+                }
+
+            private:
+                ObserverTreeModelBuilderWorker* worker;
+                ParallelSubtree*                subtree;
+                QThread*                        item_thread;
+            };
+
+            ObserverTreeModelBuilderWorker(QObject* receiver) : QThread(),
+                receiver(receiver),
+                target_thread(0),
+                root_item(0),
+                top_item(0),
+                arena(0),
+                parallel_subtrees(0),
+                parallel_subtree_threshold(0),
+                root_node(-1),
+                build_id(0),
+                lazy_build(false) {}
+
+            //! Takes a snapshot of the observer tree underneath item, must be called in the thread of the observers.
+            void takeSnapshot(ObserverTreeItem* item, bool use_hints, ObserverHints* hints, bool lazy, ObserverTreeItemArena* item_arena, int subtree_threshold) {
+                clearSnapshot();
+                lazy_build = lazy;
+                arena = item_arena;
+                parallel_subtree_threshold = subtree_threshold;
+                cancelled.fetchAndStoreOrdered(0);
+                root_item = item;
+                Observer* observer = item ? qobject_cast<Observer*> (item->getObject()) : 0;
+                if (observer)
+                    root_node = snapshotObserver(observer,use_hints,hints);
+            }
+            void clearSnapshot() {
+                nodes.clear();
+                node_indexes.clear();
+                snapshot_hints.clear();
+                snapshot_hint_indexes.clear();
+                root_node = -1;
+            }
+            //! Creates the items for the snapshot in the calling thread.
+            void build() {
+                if (!root_item || root_node == -1)
+                    return;
+
+                if (parallel_subtree_threshold <= 0 || QThread::idealThreadCount() < 2) {
+                    buildNode(root_item,root_node,arena);
+                    return;
+                }
+
+                // Create the children of the root item, collecting the subtrees underneath them:
+                QList<ParallelSubtree> subtrees;
+                parallel_subtrees = &subtrees;
+                buildNode(root_item,root_node,arena);
+                parallel_subtrees = 0;
+
+                if (subtrees.count() < parallel_subtree_threshold) {
+                    for (int i = 0; i < subtrees.count(); ++i)
+                        buildNode(subtrees.at(i).item,subtrees.at(i).node,arena);
+                    return;
+                }
+
+                // Every subtree is built underneath a staging item in its own arena on the thread pool. The snapshot is only read
+                // while building, thus observers which appear in several subtrees are built by each of them, as in a serial build:
+                QThread* item_thread = root_item->thread();
+                {
+                    QThreadPool thread_pool;
+                    for (int i = 0; i < subtrees.count(); ++i) {
+                        subtrees[i].arena = arena ? arena->createSubArena() : 0;
+                        thread_pool.start(new SubtreeRunnable(this,&subtrees[i],item_thread));
+                    }
+                    thread_pool.waitForDone();
+                }
+
+                // Stitch the subtrees into the tree, the items they belong to were created in order:
+                for (int i = 0; i < subtrees.count(); ++i) {
+                    ObserverTreeItem* staging_item = subtrees.at(i).staging_item;
+                    if (!staging_item)
+                        continue;
+                    subtrees.at(i).item->adoptChildren(staging_item);
+                    delete staging_item;
+                }
+            }
+            //! Builds a subtree collected by build() underneath a new staging item, and hands the staging item to item_thread. Called on the thread pool.
+            void buildParallelSubtree(ParallelSubtree* subtree, QThread* item_thread) {
+                ObserverTreeItem* staging_item = new (subtree->arena) ObserverTreeItem(0,0,0,ObserverTreeItem::InvalidType);
+                buildNode(staging_item,subtree->node,subtree->arena);
+                staging_item->moveToThread(item_thread);
+                subtree->staging_item = staging_item;
+            }
+            //! Creates the items for the snapshot in the worker thread. The top item is moved to the worker thread until the build ends.
+            void buildInThread(ObserverTreeItem* top, int new_build_id) {
+                top_item = top;
+                build_id = new_build_id;
+                target_thread = QThread::currentThread();
+                top_item->moveToThread(this);
+                start();
+            }
+            //! Cancels a running build and waits for the thread to finish.
+            void cancel() {
+                cancelled.fetchAndStoreOrdered(1);
+                wait();
+            }
+
+        protected:
+            void run() {
+                build();
+                // Items can only be pushed from the thread they live in, thus we hand them back from here:
+                top_item->moveToThread(target_thread);
+                if (!isCancelled())
+                    QMetaObject::invokeMethod(receiver,"handleBuildFinished",Qt::QueuedConnection,Q_ARG(int,build_id));
+            }
+
+        private:
+            bool isCancelled() const {
+                #if QT_VERSION >= 0x050000
+                return cancelled.load() != 0;
+                #else
+                return cancelled != 0;
+                #endif
+            }
+
+            int snapshotObserver(Observer* observer, bool use_hints, ObserverHints* hints) {
+                if (node_indexes.contains(observer))
+                    return node_indexes.value(observer);
+
+                // Reserve the index before the children are added:
+                int index = nodes.count();
+                nodes.append(SnapshotNode());
+                node_indexes[observer] = index;
+
+                SnapshotNode node;
+                node.observer = observer;
+                node.access_mode = observer->accessMode();
+                node.uncategorized_access_mode = observer->accessMode(QtilitiesCategory());
+
+                // If this observer is locked we don't show its children:
+                if (node.access_mode != Observer::LockedAccess) {
+                    // Check the HierarchicalDisplay hint of the observer:
+                    ObserverHints* hints_to_use = 0;
+                    if (use_hints)
+                        hints_to_use = observer->displayHints();
+                    else
+                        hints_to_use = hints;
+
+                    if (hints_to_use) {
+                        node.hints = snapshotHints(hints_to_use);
+                        node.use_categorized = snapshot_hints.at(node.hints).use_categorized;
+                    }
+
+                    if (node.use_categorized) {
+                        QMap<QPointer<QObject>, QString> category_map = observer->subjectReferenceCategoryMap();
+                        QMap<QPointer<QObject>, QString>::const_iterator itr = category_map.constBegin();
+                        for (; itr != category_map.constEnd(); ++itr)
+                            node.subjects << snapshotSubject(itr.key(),observer->subjectNameInContext(itr.key()),itr.value(),use_hints,hints);
+
+                        QList<QObject*> uncat_list = observer->subjectReferencesByCategory(QtilitiesCategory());
+                        QStringList uncat_names = observer->subjectNamesByCategory(QtilitiesCategory());
+                        int uncat_list_count = uncat_list.count();
+                        for (int i = 0; i < uncat_list_count; ++i)
+                            node.uncategorized_subjects << snapshotSubject(uncat_list.at(i),uncat_names.at(i),QString(),use_hints,hints);
+
+                        // Get the access modes of all category levels:
+                        foreach (const SnapshotSubject& subject, node.subjects) {
+                            if (subject.category.isEmpty())
+                                continue;
+                            QtilitiesCategory category(subject.category,"::");
+                            for (int level = 1; level <= category.categoryDepth(); ++level) {
+                                QStringList category_levels = category.toStringList(level);
+                                QString key = category_levels.join("::");
+                                if (!node.category_access_modes.contains(key))
+                                    node.category_access_modes[key] = (int) observer->accessMode(QtilitiesCategory(category_levels));
+                            }
+                        }
+                    } else {
+                        int count = observer->subjectCount();
+                        for (int i = 0; i < count; ++i) {
+                            QObject* obj_at = observer->subjectAt(i);
+                            node.subjects << snapshotSubject(obj_at,observer->subjectNameInContext(obj_at),QString(),use_hints,hints);
+                        }
+                    }
+
+                    TreeNode* tree_node = qobject_cast<TreeNode*> (observer);
+                    if (tree_node)
+                        node.value_items = tree_node->valueItems();
+                }
+
+                nodes[index] = node;
+                return index;
+            }
+            //! Returns the index of the display decisions of hints in snapshot_hints, which are only evaluated once for equal hints.
+            int snapshotHints(ObserverHints* hints) {
+                int hint_set_id = hints->hintSetId();
+                QHash<int,int>::const_iterator itr = snapshot_hint_indexes.constFind(hint_set_id);
+                if (itr != snapshot_hint_indexes.constEnd())
+                    return itr.value();
+
+                SnapshotHints hint_set;
+                hint_set.use_categorized = (hints->hierarchicalDisplayHint() == ObserverHints::CategorizedHierarchy);
+                hint_set.category_filter_enabled = hints->categoryFilterEnabled();
+                hint_set.inversed_category_display = hints->hasInversedCategoryDisplay();
+                if (hint_set.category_filter_enabled) {
+                    QList<QtilitiesCategory> displayed_categories = hints->displayedCategories();
+                    for (int i = 0; i < displayed_categories.count(); ++i)
+                        hint_set.displayed_categories.insert(displayed_categories.at(i));
+                }
+
+                int index = snapshot_hints.count();
+                snapshot_hints << hint_set;
+                snapshot_hint_indexes[hint_set_id] = index;
+                return index;
+            }
+            SnapshotSubject snapshotSubject(QObject* obj, const QString& name, const QString& category, bool use_hints, ObserverHints* hints) {
+                SnapshotSubject subject;
+                subject.object = obj;
+                subject.name = name;
+                subject.category = category;
+                Observer* obs = qobject_cast<Observer*> (obj);
+                subject.is_observer = (obs != 0);
+                // In lazy builds the children of observers are built when they are fetched:
+                if (obs && !lazy_build)
+                    subject.node = snapshotObserver(obs,use_hints,hints);
+                return subject;
+            }
+
+            //! Builds the complete structure of all the children below item, which represents the observer at node_index.
+            void buildNode(ObserverTreeItem* item, int node_index, ObserverTreeItemArena* item_arena) {
+                const SnapshotNode& node = nodes.at(node_index);
+                if (node.access_mode == Observer::LockedAccess)
+                    return;
+
+                if (!node.use_categorized) {
+                    for (int i = 0; i < node.subjects.count(); ++i)
+                        appendSubject(item,node.subjects.at(i),false,item_arena);
+                    appendValueItems(item,node,item_arena);
+                    return;
+                }
+
+                // Group the categorized subjects:
+                QHash<QString,QList<int> > category_subjects;
+                for (int i = 0; i < node.subjects.count(); ++i)
+                    category_subjects[node.subjects.at(i).category] << i;
+
+                // The keys of category_subjects are already unique:
+                const QList<QString> categories = category_subjects.keys();
+                foreach (const QString& category_string, categories) {
+                    if (isCancelled())
+                        return;
+
+                    QtilitiesCategory category = QtilitiesCategory(category_string,"::");
+                    // Check the category against the displayed category list:
+                    bool valid_category = true;
+                    if (node.hints != -1 && snapshot_hints.at(node.hints).category_filter_enabled) {
+                        const SnapshotHints& node_hints = snapshot_hints.at(node.hints);
+                        if (node_hints.inversed_category_display)
+                            valid_category = !node_hints.displayed_categories.contains(category);
+                        else
+                            valid_category = node_hints.displayed_categories.contains(category);
+                    }
+
+                    // Only add valid categories:
+                    if (!valid_category)
+                        continue;
+
+                    // Ok here we need to create items for each category level and add the items underneath it.
+                    int level_counter = 0;
+                    QList<ObserverTreeItem*> tree_item_list;
+                    while (level_counter < category.categoryDepth()) {
+                        QStringList category_levels = category.toStringList(level_counter+1);
+                        QString category_key = category_levels.join("::");
+
+                        // Get the correct parent:
+                        ObserverTreeItem* correct_parent;
+                        if (tree_item_list.count() == 0)
+                            correct_parent = item;
+                        else
+                            correct_parent = tree_item_list.last();
+
+                        // Check if the parent item already has a category for this level:
+                        ObserverTreeItem* existing_item = correct_parent->childWithName(category_levels.last());
+                        if (!existing_item) {
+                            // Create a category for the first level and add all items under this category to the tree:
+                            QObject* category_item = new QObject();
+                            // Check the access mode of this category and add it to the category object:
+                            Observer::AccessMode category_access_mode = (Observer::AccessMode) node.category_access_modes.value(category_key,Observer::InvalidAccess);
+                            if (category_access_mode != Observer::InvalidAccess) {
+                                SharedProperty access_mode_property(qti_prop_ACCESS_MODE,(int) category_access_mode);
+                                ObjectManager::setSharedProperty(category_item,access_mode_property);
+                            }
+                            category_item->setObjectName(category_levels.last());
+
+                            // Create new item:
+                            ObserverTreeItem* new_item = new (item_arena) ObserverTreeItem(category_item,correct_parent,1,ObserverTreeItem::CategoryItem);
+                            new_item->setContainedObserver(node.observer);
+                            new_item->setCategory(category_levels);
+                            // The category object is owned by its item, this also moves it along with the items between threads:
+                            category_item->setParent(new_item);
+
+                            // Append new item to correct parent item:
+                            correct_parent->appendChild(new_item);
+                            tree_item_list.push_back(new_item);
+
+                            // If this item has locked access, we don't dig into any items underneath it:
+                            if (category_access_mode != Observer::LockedAccess) {
+                                const QList<int> subject_indexes = category_subjects.value(category_key);
+                                for (int i = 0; i < subject_indexes.count(); ++i)
+                                    appendSubject(new_item,node.subjects.at(subject_indexes.at(i)),false,item_arena);
+                            } else
+                                break;
+                        } else
+                            tree_item_list.push_back(existing_item);
+
+                        // Increment the level counter:
+                        ++level_counter;
+                    }
+                }
+
+                // Here we need to add all items which do not belong to a specific category:
+                for (int i = 0; i < node.uncategorized_subjects.count(); ++i)
+                    appendSubject(item,node.uncategorized_subjects.at(i),true,item_arena);
+                appendValueItems(item,node,item_arena);
+            }
+            void appendSubject(ObserverTreeItem* parent, const SnapshotSubject& subject, bool check_locked, ObserverTreeItemArena* item_arena) {
+                if (isCancelled() || !subject.object)
+                    return;
+
+                ObserverTreeItem* new_item;
+                if (subject.is_observer)
+                    new_item = new (item_arena) ObserverTreeItem(subject.object,parent,1,ObserverTreeItem::TreeNode);
+                else
+                    new_item = new (item_arena) ObserverTreeItem(subject.object,parent,1,ObserverTreeItem::TreeItem);
+                parent->appendChild(new_item);
+
+                if (subject.node != -1) {
+                    // If this item has locked access, we don't dig into any items underneath it:
+                    if (!check_locked || nodes.at(subject.node).uncategorized_access_mode != Observer::LockedAccess) {
+                        // While the children of the root item are created, their subtrees are collected to be built in parallel:
+                        if (parallel_subtrees) {
+                            ParallelSubtree subtree;
+                            subtree.item = new_item;
+                            subtree.node = subject.node;
+                            parallel_subtrees->append(subtree);
+                        } else
+                            buildNode(new_item,subject.node,item_arena);
+                    }
+                } else if (subject.is_observer)
+                    new_item->setChildrenPopulated(false);
+            }
+            void appendValueItems(ObserverTreeItem* parent, const SnapshotNode& node, ObserverTreeItemArena* item_arena) {
+                for (int i = 0; i < node.value_items.count(); ++i) {
+                    if (isCancelled())
+                        return;
+
+                    ObserverTreeItem* new_item = new (item_arena) ObserverTreeItem(0,parent,1,ObserverTreeItem::ValueItem);
+                    new_item->setObjectName(node.value_items.at(i));
+                    new_item->setContainedObserver(node.observer);
+                    new_item->setValueIndex(i);
+                    parent->appendChild(new_item);
+                }
+            }
+
+            QObject*                        receiver;
+            QThread*                        target_thread;
+            ObserverTreeItem*               root_item;
+            ObserverTreeItem*               top_item;
+            //! The arena in which items are created, null when they are created on the heap.
+            ObserverTreeItemArena*          arena;
+            //! While the children of the root item are created in parallel builds, the subtrees underneath them are collected here instead of being built.
+            QList<ParallelSubtree>*         parallel_subtrees;
+            //! See ObserverTreeModelBuilder::setParallelSubtreeThreshold().
+            int                             parallel_subtree_threshold;
+            QVector<SnapshotNode>           nodes;
+            QHash<const Observer*,int>      node_indexes;
+            QVector<SnapshotHints>          snapshot_hints;
+            //! The indexes in snapshot_hints, keyed by ObserverHints::hintSetId().
+            QHash<int,int>                  snapshot_hint_indexes;
+            int                             root_node;
+            int                             build_id;
+            bool                            lazy_build;
+            QAtomicInt                      cancelled;
+        };
+
+    }
+}
+
 struct Qtilities::CoreGui::ObserverTreeModelBuilderPrivateData  {
     ObserverTreeModelBuilderPrivateData() : hints(0),
-        root_item(0) {}
+        use_hints(false),
+        root_item(0),
+        item_arena(0),
+        parallel_subtree_threshold(0),
+        use_worker_thread(false),
+        lazy_build(false),
+        building(false),
+        build_id(0),
+        worker(0) {}
 
-    QMutex                          build_lock;
     ObserverHints*                  hints;
     bool                            use_hints;
     ObserverTreeItem*               root_item;
+    ObserverTreeItemArena*          item_arena;
+    int                             parallel_subtree_threshold;
+    bool                            use_worker_thread;
+    bool                            lazy_build;
+    bool                            building;
+    //! Incremented for every build, results of older builds are ignored.
+    int                             build_id;
+    ObserverTreeModelBuilderWorker* worker;
 };
 
 Qtilities::CoreGui::ObserverTreeModelBuilder::ObserverTreeModelBuilder(ObserverTreeItem* item, bool use_observer_hints, ObserverHints* observer_hints, QObject* parent) : QObject(parent) {
@@ -32,21 +514,54 @@ Qtilities::CoreGui::ObserverTreeModelBuilder::ObserverTreeModelBuilder(ObserverT
 
     d->hints = observer_hints;
     d->use_hints = use_observer_hints;
+    d->worker = new ObserverTreeModelBuilderWorker(this);
     setRootItem(item);
 }
 
 Qtilities::CoreGui::ObserverTreeModelBuilder::~ObserverTreeModelBuilder() {
+    d->worker->cancel();
+    delete d->worker;
     delete d;
 }
 
 void Qtilities::CoreGui::ObserverTreeModelBuilder::setRootItem(ObserverTreeItem* item) {
     d->root_item = item;
-    if (d->root_item) {
-        QString context_name = "Root Item";
-        Observer* obs = qobject_cast<Observer*> (d->root_item->getObject());
-        if (obs)
-            context_name = obs->observerName();
-    }
+}
+
+void Qtilities::CoreGui::ObserverTreeModelBuilder::setItemArena(ObserverTreeItemArena* arena) {
+    d->item_arena = arena;
+}
+
+Qtilities::CoreGui::ObserverTreeItemArena* Qtilities::CoreGui::ObserverTreeModelBuilder::itemArena() const {
+    return d->item_arena;
+}
+
+void Qtilities::CoreGui::ObserverTreeModelBuilder::setParallelSubtreeThreshold(int count) {
+    d->parallel_subtree_threshold = count;
+}
+
+int Qtilities::CoreGui::ObserverTreeModelBuilder::parallelSubtreeThreshold() const {
+    return d->parallel_subtree_threshold;
+}
+
+void Qtilities::CoreGui::ObserverTreeModelBuilder::setUseWorkerThread(bool use_worker_thread) {
+    d->use_worker_thread = use_worker_thread;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModelBuilder::useWorkerThread() const {
+    return d->use_worker_thread;
+}
+
+void Qtilities::CoreGui::ObserverTreeModelBuilder::setLazyBuild(bool lazy_build) {
+    d->lazy_build = lazy_build;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModelBuilder::lazyBuild() const {
+    return d->lazy_build;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModelBuilder::isBuilding() const {
+    return d->building;
 }
 
 void Qtilities::CoreGui::ObserverTreeModelBuilder::setUseObserverHints(bool use_observer_hints) {
@@ -58,206 +573,54 @@ void Qtilities::CoreGui::ObserverTreeModelBuilder::setActiveHints(ObserverHints*
 }
 
 void Qtilities::CoreGui::ObserverTreeModelBuilder::startBuild() {
+    cancelBuild();
+
     if (!d->root_item) {
-        LOG_DEBUG(QString("%1 = no root item specified.").arg(Q_FUNC_INFO));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::TreeModelLogTag,QString("%1 = no root item specified.").arg(Q_FUNC_INFO));
         emit buildCompleted(d->root_item);
         return;
     }
 
-    d->build_lock.lock();
-
-    //QApplication::processEvents();
-    buildRecursive(d->root_item);
+    d->worker->takeSnapshot(d->root_item,d->use_hints,d->hints,d->lazy_build,d->item_arena,d->parallel_subtree_threshold);
 
-    d->build_lock.unlock();
+    if (d->use_worker_thread) {
+        // The items above the root item must move to the worker thread along with it:
+        ObserverTreeItem* top_item = d->root_item;
+        while (top_item->parentItem())
+            top_item = top_item->parentItem();
 
-    //printStructure(root_item);
-    emit buildCompleted(d->root_item);
-}
-
-void Qtilities::CoreGui::ObserverTreeModelBuilder::buildRecursive(ObserverTreeItem* item, QList<QPointer<QObject> > category_objects) {
-     // In here we build the complete structure of all the children below item.
-    Observer* observer = qobject_cast<Observer*> (item->getObject());
-    ObserverTreeItem* new_item;
-
-    if (!observer && item->getObject()) {
-        // Handle cases where the item is a category item
-        if (item->itemType() == ObserverTreeItem::CategoryItem) {
-            // Get the observer from the parent of item
-            if (item->parentItem()) {
-                Observer* parent_observer = item->containedObserver();
-                if (parent_observer) {
-                    // Now add all items belonging to this category
-                    int cat_count = category_objects.count();
-                    for (int i = 0; i < cat_count; ++i) {
-                        //QApplication::processEvents();
-                        // Storing all information in the data vector here can improve performance
-                        QPointer<QObject> object = category_objects.at(i);
-                        if (object) {
-                            QPointer<Observer> obs = qobject_cast<Observer*> (object);
-                            QVector<QVariant> column_data;
-                            column_data << QVariant(parent_observer->subjectNameInContext(object));
-                            if (obs) {
-                                new_item = new ObserverTreeItem(object,item,column_data,ObserverTreeItem::TreeNode);
-                            } else {
-                                new_item = new ObserverTreeItem(object,item,column_data,ObserverTreeItem::TreeItem);
-                            }
-                            item->appendChild(new_item);
+        d->building = true;
+        d->worker->buildInThread(top_item,++d->build_id);
+    } else {
+        d->worker->build();
+        d->worker->clearSnapshot();
 
-                            if (obs)
-                                buildRecursive(new_item);
-                        }
-                    }
-                }
-            }
-        }
+        //printStructure(root_item);
+        emit buildCompleted(d->root_item);
     }
+}
 
-    if (observer) {
-        // If this observer is locked we don't show its children:
-        if (observer->accessMode() != Observer::LockedAccess) {
-            // Check the HierarchicalDisplay hint of the observer:
-            // Remember this is an recursive function, we can't use hints directly since thats linked to the selection parent.
-            bool use_categorized;
-            ObserverHints* hints_to_use = 0;
-            if (d->use_hints) {
-                if (observer->displayHints()) {
-                    use_categorized = (observer->displayHints()->hierarchicalDisplayHint() == ObserverHints::CategorizedHierarchy);
-                    hints_to_use = observer->displayHints();
-                } else
-                    use_categorized = false;
-            } else {
-                use_categorized = (d->hints->hierarchicalDisplayHint() == ObserverHints::CategorizedHierarchy);
-                hints_to_use = d->hints;
-            }
-
-            if (use_categorized) {
-                // Get the object / category hash:
-                QMap<QPointer<QObject>, QString> category_map = observer->subjectReferenceCategoryMap();
-                QSet<QString> categories = category_map.values().toSet();
-
-                foreach (const QString& category_string, categories) {
-                    //QApplication::processEvents();
-                    QtilitiesCategory category = QtilitiesCategory(category_string,"::");
-                    // Check the category against the displayed category list:
-                    bool valid_category = true;
-                    if (hints_to_use) {
-                        QList<QtilitiesCategory> displayed_categories = hints_to_use->displayedCategories();
-                        if (hints_to_use->categoryFilterEnabled()) {
-                            if (hints_to_use->hasInversedCategoryDisplay()) {
-                                if (!displayed_categories.contains(category))
-                                    valid_category = true;
-                                else
-                                    valid_category = false;
-                            } else {
-                                if (displayed_categories.contains(category))
-                                    valid_category = true;
-                                else
-                                    valid_category = false;
-                            }
-                        }
-                    }
+void Qtilities::CoreGui::ObserverTreeModelBuilder::cancelBuild() {
+    if (!d->building)
+        return;
 
-                    // Only add valid categories:
-                    if (valid_category) {
-                        // Ok here we need to create items for each category level and add the items underneath it.
-                        int level_counter = 0;
-                        QList<ObserverTreeItem*> tree_item_list;
-                        while (level_counter < category.categoryDepth()) {
-                            QStringList category_levels = category.toStringList(level_counter+1);
-
-                            // Get the correct parent:
-                            ObserverTreeItem* correct_parent;
-                            if (tree_item_list.count() == 0)
-                                correct_parent = item;
-                            else
-                                correct_parent = tree_item_list.last();
-
-                            // Check if the parent item already has a category for this level:
-                            ObserverTreeItem* existing_item = correct_parent->childWithName(category_levels.last());
-                            if (!existing_item) {
-                                // Create a category for the first level and add all items under this category to the tree:
-                                QVector<QVariant> category_columns;
-                                category_columns << category_levels.last();
-                                QObject* category_item = new QObject();
-                                // Check the access mode of this category and add it to the category object:
-                                QtilitiesCategory shortened_category(category_levels);
-                                Observer::AccessMode category_access_mode = observer->accessMode(shortened_category);
-                                if (category_access_mode != Observer::InvalidAccess) {
-                                    SharedProperty access_mode_property(qti_prop_ACCESS_MODE,(int) observer->accessMode(shortened_category));
-                                    ObjectManager::setSharedProperty(category_item,access_mode_property);
-                                }
-                                category_item->setObjectName(category_levels.last());
-
-                                // Create new item:
-                                new_item = new ObserverTreeItem(category_item,correct_parent,category_columns,ObserverTreeItem::CategoryItem);
-                                new_item->setContainedObserver(observer);
-                                new_item->setCategory(category_levels);
-
-                                // Append new item to correct parent item:
-                                if (tree_item_list.count() == 0)
-                                    item->appendChild(new_item);
-                                else
-                                    tree_item_list.last()->appendChild(new_item);
-                                tree_item_list.push_back(new_item);
-
-                                // If this item has locked access, we don't dig into any items underneath it:
-                                if (observer->accessMode(shortened_category) != Observer::LockedAccess) {
-                                    QList<QPointer<QObject> > safe_list = category_map.keys(category_levels.join("::"));
-                                    buildRecursive(new_item,safe_list);
-                                } else
-                                    break;
-                            } else
-                                tree_item_list.push_back(existing_item);
+    d->worker->cancel();
+    d->worker->clearSnapshot();
+    d->building = false;
+    ++d->build_id;
+}
 
-                            // Increment the level counter:
-                            ++level_counter;
-                        }
-                    }
-                }
+void Qtilities::CoreGui::ObserverTreeModelBuilder::handleBuildFinished(int build_id) {
+    if (!d->building || build_id != d->build_id)
+        return;
 
-                // Here we need to add all items which do not belong to a specific category:
-                // Get the list of uncategorized items from the observer
-                QList<QObject*> uncat_list = observer->subjectReferencesByCategory(QtilitiesCategory());
-                QStringList uncat_names = observer->subjectNamesByCategory(QtilitiesCategory());
-                int uncat_list_count = uncat_list.count();
-                for (int i = 0; i < uncat_list_count; ++i) {
-                    //QApplication::processEvents();
-                    QObject* obj_at = uncat_list.at(i);
-                    Observer* obs = qobject_cast<Observer*> (obj_at);
-                    QVector<QVariant> column_data;
-                    column_data << QVariant(uncat_names.at(i));
-                    if (obs) {
-                        new_item = new ObserverTreeItem(obj_at,item,column_data,ObserverTreeItem::TreeNode);
-                        item->appendChild(new_item);
-                        // If this item has locked access, we don't dig into any items underneath it:
-                        if (obs->accessMode(QtilitiesCategory()) != Observer::LockedAccess && obs)
-                            buildRecursive(new_item);
-                    } else {
-                        new_item = new ObserverTreeItem(obj_at,item,column_data,ObserverTreeItem::TreeItem);
-                        item->appendChild(new_item);
-                    }
-                }
-            } else {
-                int count = observer->subjectCount();
-                for (int i = 0; i < count; ++i) {
-                    //QApplication::processEvents();
-                    QObject* obj_at = observer->subjectAt(i);
-                    Observer* obs = qobject_cast<Observer*> (obj_at);
-                    QVector<QVariant> column_data;
-                    column_data << QVariant(observer->subjectNameInContext(obj_at));
-                    if (obs)
-                        new_item = new ObserverTreeItem(obj_at,item,column_data,ObserverTreeItem::TreeNode);
-                    else
-                        new_item = new ObserverTreeItem(obj_at,item,column_data,ObserverTreeItem::TreeItem);
-                    item->appendChild(new_item);
+    // Make sure the thread finished handing the items back:
+    d->worker->wait();
+    d->worker->clearSnapshot();
+    d->building = false;
 
-                    if (obs)
-                        buildRecursive(new_item);
-                }
-            }
-        }
-    }
+    //printStructure(root_item);
+    emit buildCompleted(d->root_item);
 }
 
 void Qtilities::CoreGui::ObserverTreeModelBuilder::printStructure(ObserverTreeItem* item, int level) {
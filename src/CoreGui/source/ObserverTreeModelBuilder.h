@@ -30,6 +30,11 @@ namespace Qtilities {
         /*!
         \class ObserverTreeModelBuilder
         \brief The ObserverTreeModelBuilder builds models for ObserverTreeModel in a different thread.
+
+        When startBuild() is called, the builder takes a snapshot of the observer tree underneath the root item in the calling thread. The snapshot contains
+        the subjects, their names in context, categories and access modes, thus it is consistent even when the observers change while the tree is built. The
+        ObserverTreeItem hierarchy is then created from the snapshot, by default in the calling thread. When setUseWorkerThread() is enabled, the items are created
+        in a worker thread and buildCompleted() is emitted in the builder's thread when the build finished. Builds in progress can be cancelled using cancelBuild().
           */
         class QTILITIES_CORE_GUI_SHARED_EXPORT ObserverTreeModelBuilder : public QObject
         {
@@ -40,11 +45,83 @@ namespace Qtilities {
             virtual ~ObserverTreeModelBuilder();
 
             //! Sets the root ObserverTreeitem.
+            /*!
+              When building in a worker thread, the root item and the items above it must not be used until buildCompleted() was emitted or the build was cancelled.
+              */
             void setRootItem(ObserverTreeItem* item);
+            //! Sets the arena in which new items are created.
+            /*!
+              When null, which is the default, items are created on the heap. Otherwise the arena must stay alive until all items created in it were
+              deleted, and it must not be used by other threads while a build is in progress. See ObserverTreeItemArena.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setItemArena(ObserverTreeItemArena* arena);
+            //! Gets the arena in which new items are created.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObserverTreeItemArena* itemArena() const;
+            //! Sets if items must be created in a worker thread.
+            /*!
+              \param use_worker_thread When true, startBuild() returns after the observer tree snapshot was taken and buildCompleted() is emitted once the items were created
+              in a worker thread. When false, startBuild() only returns after buildCompleted() was emitted. The default is false.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setUseWorkerThread(bool use_worker_thread);
+            //! Indicates if items are created in a worker thread.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool useWorkerThread() const;
+            //! Sets the number of subtrees underneath the children of the root item from which the subtrees are built in parallel.
+            /*!
+              When the children of the root item represent at least \p count observers, the subtrees underneath them are built concurrently on a thread
+              pool, each in its own arena created using ObserverTreeItemArena::createSubArena(), and are then added to the tree in their order. Observers
+              which appear in several subtrees are built by each of them, exactly like a serial build. When \p count is 0 (the default), trees are always
+              built serially.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setParallelSubtreeThreshold(int count);
+            //! Gets the number of subtrees underneath the children of the root item from which the subtrees are built in parallel.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int parallelSubtreeThreshold() const;
+            //! Sets if only the children of the root item must be built.
+            /*!
+              When enabled, items representing observers underneath the root item are created without children and marked as not populated using
+              ObserverTreeItem::setChildrenPopulated(). Their children can be built later by using them as the root item of another build. The default is false.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setLazyBuild(bool lazy_build);
+            //! Indicates if only the children of the root item are built.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool lazyBuild() const;
+            //! Indicates if a build started in a worker thread did not complete yet.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool isBuilding() const;
 
         public slots:
             //! Starts the build.
+            /*!
+              A build which is still in progress is cancelled first.
+              */
             void startBuild();
+            //! Cancels a build in progress. The buildCompleted() signal will not be emitted for the cancelled build.
+            /*!
+              This function waits for the worker thread to stop, after which the root item can be used or deleted again.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void cancelBuild();
             //! Sets if observer hints should be used during tree building.
             void setUseObserverHints(bool use_observer_hints);
             //! Sets the active hints which should be used during tree building.
@@ -54,9 +131,11 @@ namespace Qtilities {
             //! Emitted when build is completed.
             void buildCompleted(ObserverTreeItem* item);
 
+        private slots:
+            //! Called in the builder's thread when a build in the worker thread finished.
+            void handleBuildFinished(int build_id);
+
         private:
-            //! Function which will rebuild the complete tree structure under the top level observer.
-            void buildRecursive(ObserverTreeItem* item, QList<QPointer<QObject> > category_objects = QList<QPointer<QObject> >());
             //! Prints the structure of the tree as trace messages.
             /*!
               \sa LOG_TRACE
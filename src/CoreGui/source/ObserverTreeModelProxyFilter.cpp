@@ -16,27 +16,499 @@
 #include <Observer.h>
 #include <QtilitiesCoreConstants.h>
 
+#include <QBitArray>
+#include <QHash>
+#include <QMutex>
+#include <QRunnable>
+#include <QSet>
+#include <QSharedPointer>
+#include <QStringMatcher>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#if QT_VERSION >= 0x050200
+#include <QCollator>
+#endif
+
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::Core::Properties;
 using namespace Qtilities::Core;
 using namespace Qtilities::Core::Constants;
 
+namespace {
+    //! An item in the name index of the tree. Items are only used as keys, they are never dereferenced by the search workers.
+    struct SearchIndexEntry {
+        SearchIndexEntry() : item(0), parent(0), type(0) {}
+
+        const void* item;
+        const void* parent;
+        int         type;
+        QString     name;
+    };
+
+    //! The state shared between the proxy and the worker matching a search.
+    struct SearchJob {
+        SearchJob(QObject* receiver, int generation) : receiver(receiver), generation(generation) {}
+
+        QMutex              mutex;
+        //! The proxy to notify once the matches are available, set to null when the search is no longer current.
+        QObject*            receiver;
+        int                 generation;
+        QSet<const void*>   matches;
+    };
+
+    class SearchRunnable : public QRunnable
+    {
+    public:
+        SearchRunnable(QSharedPointer<SearchJob> job, const QVector<SearchIndexEntry>& entries, const QRegExp& expression, int filter_types) :
+            job(job), entries(entries), expression(expression), filter_types(filter_types) {}
+
+        void run() {
+            QHash<const void*,const void*> parents;
+            parents.reserve(entries.count());
+            for (int i = 0; i < entries.count(); ++i)
+                parents.insert(entries.at(i).item,entries.at(i).parent);
+
+            // Add every matching item along with its ancestors, stopping at the first ancestor which is already in the set:
+            QSet<const void*> matches;
+            for (int i = 0; i < entries.count(); ++i) {
+                const SearchIndexEntry& entry = entries.at(i);
+                if (!(filter_types & entry.type) || expression.indexIn(entry.name) == -1)
+                    continue;
+
+                const void* item = entry.item;
+                while (item && !matches.contains(item)) {
+                    matches.insert(item);
+                    item = parents.value(item);
+                }
+            }
+
+            QMutexLocker locker(&job->mutex);
+            job->matches = matches;
+            if (job->receiver)
+                QMetaObject::invokeMethod(job->receiver,"handleSearchMatchesReady",Qt::QueuedConnection,Q_ARG(int,job->generation));
+        }
+
+    private:
+        QSharedPointer<SearchJob>   job;
+        QVector<SearchIndexEntry>   entries;
+        QRegExp                     expression;
+        int                         filter_types;
+    };
+
+    //! The precomputed sort key of an item in the name column.
+    struct SortKey {
+        SortKey() : item(0), rank(0), collated(false) {}
+
+        const void* item;
+        //! Tree nodes are sorted before categories, which are sorted before all other items.
+        int         rank;
+        //! The name of the item, case folded when it is compared case insensitive without collation.
+        QString     text;
+        //! Indicates if the name is compared using the locale.
+        bool        collated;
+        #if QT_VERSION >= 0x050200
+        QSharedPointer<QCollatorSortKey> collation_key;
+        #endif
+    };
+
+    bool qti_private_sortKeyLessThan(const SortKey& left, const SortKey& right) {
+        if (left.rank != right.rank)
+            return left.rank < right.rank;
+        if (left.collated && right.collated) {
+            #if QT_VERSION >= 0x050200
+            return left.collation_key->compare(*right.collation_key) < 0;
+            #else
+            return QString::localeAwareCompare(left.text,right.text) < 0;
+            #endif
+        }
+        return left.text < right.text;
+    }
+
+    //! Completes the sort keys from \p first to \p last, of which the rank and name was set.
+    void qti_private_computeSortKeys(QVector<SortKey>* keys, int first, int last, Qt::CaseSensitivity case_sensitivity) {
+        #if QT_VERSION >= 0x050200
+        // QCollator is reentrant, thus every thread uses its own instance:
+        QCollator collator;
+        #endif
+        for (int i = first; i <= last; ++i) {
+            SortKey& key = (*keys)[i];
+            if (key.collated) {
+                #if QT_VERSION >= 0x050200
+                key.collation_key = QSharedPointer<QCollatorSortKey>(new QCollatorSortKey(collator.sortKey(key.text)));
+                #endif
+            } else if (case_sensitivity == Qt::CaseInsensitive)
+                key.text = key.text.toCaseFolded();
+        }
+    }
+
+    //! The names of the children of a parent, stored in a single buffer for fixed string filtering.
+    struct FixedStringRows {
+        FixedStringRows() : role(Qt::DisplayRole), case_sensitivity(Qt::CaseSensitive) {}
+
+        //! The role and case sensitivity used to build the buffer, it is rebuilt when the filter settings change.
+        int                 role;
+        Qt::CaseSensitivity case_sensitivity;
+        //! The names of all rows, each followed by a null character. Names are case folded when the filter is case insensitive.
+        QString             names;
+        //! The position of the name of every row in names, followed by the length of names.
+        QVector<int>        offsets;
+        //! The fixed string which accepted_rows was computed for.
+        QString             pattern;
+        QBitArray           accepted_rows;
+    };
+
+    //! Computes the rows of \p rows which contain \p pattern, in a single pass over the names buffer.
+    void qti_private_matchFixedString(FixedStringRows* rows, const QString& pattern) {
+        const int row_count = rows->offsets.count() - 1;
+        rows->pattern = pattern;
+        rows->accepted_rows.fill(false,row_count);
+
+        const QString folded_pattern = rows->case_sensitivity == Qt::CaseInsensitive ? pattern.toCaseFolded() : pattern;
+        QStringMatcher matcher(folded_pattern,Qt::CaseSensitive);
+        int row = 0;
+        int from = 0;
+        while (row < row_count) {
+            const int position = matcher.indexIn(rows->names,from);
+            if (position == -1)
+                break;
+
+            // The offsets are ascending, thus the row of a match is found by moving forward:
+            while (rows->offsets.at(row + 1) <= position)
+                ++row;
+            // A match must end before the null character after the name:
+            if (position + folded_pattern.length() < rows->offsets.at(row + 1))
+                rows->accepted_rows.setBit(row);
+
+            // The rest of an accepted row does not need to be searched:
+            ++row;
+            if (row < row_count)
+                from = rows->offsets.at(row);
+        }
+    }
+
+    class SortKeyRunnable : public QRunnable
+    {
+    public:
+        SortKeyRunnable(QVector<SortKey>* keys, int first, int last, Qt::CaseSensitivity case_sensitivity) :
+            keys(keys), first(first), last(last), case_sensitivity(case_sensitivity) {}
+
+        void run() {
+            qti_private_computeSortKeys(keys,first,last,case_sensitivity);
+        }
+
+    private:
+        QVector<SortKey>*   keys;
+        int                 first;
+        int                 last;
+        Qt::CaseSensitivity case_sensitivity;
+    };
+}
+
+struct Qtilities::CoreGui::ObserverTreeModelProxyFilterPrivateData {
+    ObserverTreeModelProxyFilterPrivateData() : tree_model(0),
+        index_valid(false),
+        search_generation(0),
+        search_scheduled(false),
+        matches_valid(false),
+        sort_keys_role(Qt::DisplayRole),
+        sort_keys_case_sensitivity(Qt::CaseInsensitive),
+        sort_keys_locale_aware(false),
+        parallel_sort_key_threshold(0) {}
+
+    //! The source model when it is an ObserverTreeModel, cached to avoid casting it for every row.
+    ObserverTreeModel*                  tree_model;
+
+    //! The name index of the tree, keyed by tree item.
+    QHash<const void*,SearchIndexEntry> index;
+    //! Indicates if the index reflects the source model, it is built when the next search starts when false.
+    bool                                index_valid;
+
+    QRegExp                             search_expression;
+    //! Incremented for every search, the matches of previous searches are discarded.
+    int                                 search_generation;
+    //! Indicates if startSearch() was queued.
+    bool                                search_scheduled;
+    QSharedPointer<SearchJob>           search_job;
+    //! The items which matched the search expression, and their ancestors. Removed items are removed from the matches as well.
+    QSet<const void*>                   matches;
+    //! Indicates if matches reflects the current search expression and source model.
+    bool                                matches_valid;
+
+    //! The name buffers used for fixed string filtering, keyed by the tree item of the parent of the rows.
+    QHash<const void*,FixedStringRows>  fixed_string_rows;
+
+    //! The sort keys of the items in the tree, keyed by tree item.
+    QHash<const void*,SortKey>          sort_keys;
+    //! The parents of which the sort keys of all children were computed.
+    QSet<const void*>                   sort_key_parents;
+    //! The sorting settings used to compute the sort keys, they are recomputed when the settings change.
+    int                                 sort_keys_role;
+    Qt::CaseSensitivity                 sort_keys_case_sensitivity;
+    bool                                sort_keys_locale_aware;
+    int                                 parallel_sort_key_threshold;
+};
+
 Qtilities::CoreGui::ObserverTreeModelProxyFilter::ObserverTreeModelProxyFilter(QObject* parent) : QSortFilterProxyModel(parent) {
+    d = new ObserverTreeModelProxyFilterPrivateData;
     row_filter_types = ObserverTreeItem::TreeItem;
     setSortCaseSensitivity(Qt::CaseInsensitive);
 }
 
 Qtilities::CoreGui::ObserverTreeModelProxyFilter::~ObserverTreeModelProxyFilter() {
+    if (d->search_job) {
+        QMutexLocker locker(&d->search_job->mutex);
+        d->search_job->receiver = 0;
+    }
+    delete d;
+}
 
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::setSourceModel(QAbstractItemModel* source_model) {
+    // Only disconnect the index updates, QSortFilterProxyModel manages its own connections:
+    if (d->tree_model) {
+        disconnect(d->tree_model,SIGNAL(modelAboutToBeReset()),this,SLOT(handleSourceModelAboutToBeReset()));
+        disconnect(d->tree_model,SIGNAL(layoutAboutToBeChanged()),this,SLOT(handleSourceModelAboutToBeReset()));
+        disconnect(d->tree_model,SIGNAL(modelReset()),this,SLOT(handleSourceModelReset()));
+        disconnect(d->tree_model,SIGNAL(layoutChanged()),this,SLOT(handleSourceModelReset()));
+        disconnect(d->tree_model,SIGNAL(rowsInserted(QModelIndex,int,int)),this,SLOT(handleSourceRowsInserted(QModelIndex,int,int)));
+        disconnect(d->tree_model,SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)),this,SLOT(handleSourceRowsAboutToBeRemoved(QModelIndex,int,int)));
+        disconnect(d->tree_model,SIGNAL(dataChanged(QModelIndex,QModelIndex)),this,SLOT(handleSourceDataChanged(QModelIndex,QModelIndex)));
+    }
+
+    d->tree_model = qobject_cast<ObserverTreeModel*> (source_model);
+    d->index.clear();
+    d->index_valid = false;
+    d->matches_valid = false;
+    d->sort_keys.clear();
+    d->sort_key_parents.clear();
+    d->fixed_string_rows.clear();
+
+    // Connected before QSortFilterProxyModel connects to the model, thus renamed items have their sort keys removed before the proxy sorts them again:
+    if (d->tree_model) {
+        connect(d->tree_model,SIGNAL(modelAboutToBeReset()),SLOT(handleSourceModelAboutToBeReset()));
+        connect(d->tree_model,SIGNAL(layoutAboutToBeChanged()),SLOT(handleSourceModelAboutToBeReset()));
+        connect(d->tree_model,SIGNAL(modelReset()),SLOT(handleSourceModelReset()));
+        connect(d->tree_model,SIGNAL(layoutChanged()),SLOT(handleSourceModelReset()));
+        connect(d->tree_model,SIGNAL(rowsInserted(QModelIndex,int,int)),SLOT(handleSourceRowsInserted(QModelIndex,int,int)));
+        connect(d->tree_model,SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)),SLOT(handleSourceRowsAboutToBeRemoved(QModelIndex,int,int)));
+        connect(d->tree_model,SIGNAL(dataChanged(QModelIndex,QModelIndex)),SLOT(handleSourceDataChanged(QModelIndex,QModelIndex)));
+    }
+    QSortFilterProxyModel::setSourceModel(source_model);
+
+    if (!d->search_expression.isEmpty())
+        scheduleSearch();
 }
 
-bool Qtilities::CoreGui::ObserverTreeModelProxyFilter::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
-    ObserverTreeModel* tree_model = dynamic_cast<ObserverTreeModel*> (sourceModel());
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::setSearchExpression(const QRegExp& expression) {
+    d->search_expression = expression;
+    if (!expression.isEmpty()) {
+        startSearch();
+        return;
+    }
 
-    if (tree_model) {
+    // Clearing the search only accepts all rows, thus it is done right away:
+    ++d->search_generation;
+    d->search_scheduled = false;
+    if (d->search_job) {
+        QMutexLocker locker(&d->search_job->mutex);
+        d->search_job->receiver = 0;
+    }
+    d->search_job.clear();
+    d->matches.clear();
+    d->matches_valid = false;
+    invalidateFilter();
+    emit searchFinished();
+}
+
+QRegExp Qtilities::CoreGui::ObserverTreeModelProxyFilter::searchExpression() const {
+    return d->search_expression;
+}
+
+bool Qtilities::CoreGui::ObserverTreeModelProxyFilter::isSearching() const {
+    return d->search_scheduled || !d->search_job.isNull();
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::setParallelSortKeyThreshold(int count) {
+    d->parallel_sort_key_threshold = qMax(0,count);
+}
+
+int Qtilities::CoreGui::ObserverTreeModelProxyFilter::parallelSortKeyThreshold() const {
+    return d->parallel_sort_key_threshold;
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::scheduleSearch() {
+    if (d->search_scheduled || d->search_expression.isEmpty())
+        return;
+
+    // Queued, thus bursts of source model changes only restart the search once:
+    d->search_scheduled = true;
+    QMetaObject::invokeMethod(this,"startSearch",Qt::QueuedConnection);
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::startSearch() {
+    d->search_scheduled = false;
+    if (d->search_expression.isEmpty())
+        return;
+
+    if (!d->index_valid) {
+        d->index.clear();
+        if (d->tree_model)
+            indexRows(QModelIndex(),0,d->tree_model->rowCount()-1);
+        d->index_valid = true;
+    }
+
+    if (d->search_job) {
+        QMutexLocker locker(&d->search_job->mutex);
+        d->search_job->receiver = 0;
+    }
+    d->search_job = QSharedPointer<SearchJob>(new SearchJob(this,++d->search_generation));
+    QThreadPool::globalInstance()->start(new SearchRunnable(d->search_job,d->index.values().toVector(),d->search_expression,row_filter_types));
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::handleSearchMatchesReady(int generation) {
+    if (generation != d->search_generation || !d->search_job)
+        return;
+
+    {
+        QMutexLocker locker(&d->search_job->mutex);
+        d->matches = d->search_job->matches;
+    }
+    d->search_job.clear();
+    d->matches_valid = true;
+    invalidateFilter();
+    emit searchFinished();
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::indexRows(const QModelIndex& parent, int first, int last) {
+    int name_column = d->tree_model->columnPosition(AbstractObserverItemModel::ColumnName);
+    const void* parent_item = d->tree_model->getItem(parent);
+    for (int row = first; row <= last; ++row) {
+        QModelIndex child_index = d->tree_model->index(row,0,parent);
+        ObserverTreeItem* tree_item = d->tree_model->getItem(child_index);
+        if (!tree_item)
+            continue;
+
+        SearchIndexEntry entry;
+        entry.item = tree_item;
+        entry.parent = parent_item;
+        entry.type = tree_item->itemType();
+        entry.name = d->tree_model->index(row,name_column,parent).data(filterRole()).toString();
+        d->index[tree_item] = entry;
+
+        int child_count = d->tree_model->rowCount(child_index);
+        if (child_count > 0)
+            indexRows(child_index,0,child_count-1);
+    }
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::unindexRows(const QModelIndex& parent, int first, int last) {
+    for (int row = first; row <= last; ++row) {
+        QModelIndex child_index = d->tree_model->index(row,0,parent);
+        int child_count = d->tree_model->rowCount(child_index);
+        if (child_count > 0)
+            unindexRows(child_index,0,child_count-1);
+        const void* item = d->tree_model->getItem(child_index);
+        d->index.remove(item);
+        d->sort_keys.remove(item);
+        d->sort_key_parents.remove(item);
+        d->fixed_string_rows.remove(item);
+        d->matches.remove(item);
+    }
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::handleSourceModelAboutToBeReset() {
+    // The items in the matches are about to be deleted, thus rows are matched directly until the search finished again:
+    d->index.clear();
+    d->index_valid = false;
+    d->matches.clear();
+    d->matches_valid = false;
+    d->sort_keys.clear();
+    d->sort_key_parents.clear();
+    d->fixed_string_rows.clear();
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::handleSourceModelReset() {
+    scheduleSearch();
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::handleSourceRowsInserted(const QModelIndex& parent, int first, int last) {
+    // The keys of the new rows are computed the next time the children of the parent are sorted:
+    d->sort_key_parents.remove(d->tree_model->getItem(parent));
+    d->fixed_string_rows.remove(d->tree_model->getItem(parent));
+
+    if (!d->index_valid)
+        return;
+
+    indexRows(parent,first,last);
+    scheduleSearch();
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::handleSourceRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last) {
+    // Removed items must not keep their sort keys or name buffers, since new items can be allocated at the same address:
+    d->fixed_string_rows.remove(d->tree_model->getItem(parent));
+    if (!d->index_valid && d->sort_keys.isEmpty() && d->fixed_string_rows.isEmpty())
+        return;
+
+    unindexRows(parent,first,last);
+    if (d->index_valid) {
+        // The matches of a search which is still running can contain the removed items, and new items can be allocated at their
+        // addresses before the matches arrive. The search is therefore discarded, the pruned matches are shown until the next search finished:
+        if (d->search_job) {
+            QMutexLocker locker(&d->search_job->mutex);
+            d->search_job->receiver = 0;
+        }
+        d->search_job.clear();
+        ++d->search_generation;
+        scheduleSearch();
+    }
+}
+
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::handleSourceDataChanged(const QModelIndex& top_left, const QModelIndex& bottom_right) {
+    int name_column = d->tree_model->columnPosition(AbstractObserverItemModel::ColumnName);
+    if (name_column < top_left.column() || name_column > bottom_right.column())
+        return;
+
+    // The name buffer of the parent is rebuilt the next time its rows are filtered:
+    d->fixed_string_rows.remove(d->tree_model->getItem(top_left.parent()));
+
+    // Renamed items get new sort keys the next time they are sorted:
+    if (!d->sort_keys.isEmpty()) {
+        bool keys_removed = false;
+        for (int row = top_left.row(); row <= bottom_right.row(); ++row) {
+            if (d->sort_keys.remove(d->tree_model->getItem(d->tree_model->index(row,0,top_left.parent()))) > 0)
+                keys_removed = true;
+        }
+        if (keys_removed)
+            d->sort_key_parents.remove(d->tree_model->getItem(top_left.parent()));
+    }
+
+    if (!d->index_valid)
+        return;
+
+    // Only names which actually changed restart the search:
+    bool names_changed = false;
+    for (int row = top_left.row(); row <= bottom_right.row(); ++row) {
+        QModelIndex name_index = d->tree_model->index(row,name_column,top_left.parent());
+        QHash<const void*,SearchIndexEntry>::iterator itr = d->index.find(d->tree_model->getItem(name_index));
+        if (itr == d->index.end())
+            continue;
+
+        QString name = name_index.data(filterRole()).toString();
+        if (itr.value().name != name) {
+            itr.value().name = name;
+            names_changed = true;
+        }
+    }
+
+    if (names_changed)
+        scheduleSearch();
+}
+
+bool Qtilities::CoreGui::ObserverTreeModelProxyFilter::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
+    if (d->tree_model) {
         // Get the ObserverTreeItem:
-        QModelIndex name_index = sourceModel()->index(sourceRow, tree_model->columnPosition(AbstractObserverItemModel::ColumnName), sourceParent);        
-        ObserverTreeItem* tree_item = tree_model->getItem(name_index);
+        QModelIndex name_index = d->tree_model->index(sourceRow, d->tree_model->columnPosition(AbstractObserverItemModel::ColumnName), sourceParent);
+        ObserverTreeItem* tree_item = d->tree_model->getItem(name_index);
         if (tree_item) {
             // Don't ever filter the root item:
             if (tree_item->itemType() == ObserverTreeItem::TreeNode && tree_item->parentItem()) {
@@ -47,49 +519,140 @@ bool Qtilities::CoreGui::ObserverTreeModelProxyFilter::filterAcceptsRow(int sour
             // Filter by type:
             if (!(row_filter_types & tree_item->itemType()))
                 return true;
+
+            if (!d->search_expression.isEmpty()) {
+                if (d->matches_valid)
+                    return d->matches.contains(tree_item);
+                // While the first search after a source model change is being matched:
+                return d->search_expression.indexIn(name_index.data(filterRole()).toString()) != -1;
+            }
+
+            // Fixed strings are matched against all the rows of the parent at once:
+            QRegExp filter_expression = filterRegExp();
+            if (filter_expression.patternSyntax() == QRegExp::FixedString && !filter_expression.isEmpty() && filterKeyColumn() == name_index.column())
+                return fixedStringAcceptsRow(sourceRow,sourceParent);
         }
     }
     return QSortFilterProxyModel::filterAcceptsRow(sourceRow,sourceParent);
 }
 
+bool Qtilities::CoreGui::ObserverTreeModelProxyFilter::fixedStringAcceptsRow(int source_row, const QModelIndex& source_parent) const {
+    const int row_count = d->tree_model->rowCount(source_parent);
+    FixedStringRows& rows = d->fixed_string_rows[d->tree_model->getItem(source_parent)];
+
+    if (rows.offsets.count() != row_count + 1 || rows.role != filterRole() || rows.case_sensitivity != filterCaseSensitivity()) {
+        // The names are fetched from the model once, all later fixed strings only scan the buffer:
+        rows.role = filterRole();
+        rows.case_sensitivity = filterCaseSensitivity();
+        rows.names.clear();
+        rows.offsets.clear();
+        rows.offsets.reserve(row_count + 1);
+        int name_column = d->tree_model->columnPosition(AbstractObserverItemModel::ColumnName);
+        for (int row = 0; row < row_count; ++row) {
+            rows.offsets << rows.names.length();
+            QString name = d->tree_model->index(row,name_column,source_parent).data(rows.role).toString();
+            if (rows.case_sensitivity == Qt::CaseInsensitive)
+                rows.names += name.toCaseFolded();
+            else
+                rows.names += name;
+            rows.names += QChar(QChar::Null);
+        }
+        rows.offsets << rows.names.length();
+        rows.pattern.clear();
+        rows.accepted_rows.clear();
+    }
+
+    const QString pattern = filterRegExp().pattern();
+    if (rows.pattern != pattern || rows.accepted_rows.size() != row_count)
+        qti_private_matchFixedString(&rows,pattern);
+
+    return source_row >= 0 && source_row < row_count && rows.accepted_rows.testBit(source_row);
+}
+
 void Qtilities::CoreGui::ObserverTreeModelProxyFilter::setRowFilterTypes(ObserverTreeItem::TreeItemTypeFlags type_flags) {
     row_filter_types = type_flags;
+    if (!d->search_expression.isEmpty()) {
+        d->matches_valid = false;
+        scheduleSearch();
+    }
 }
 
 Qtilities::CoreGui::ObserverTreeItem::TreeItemTypeFlags Qtilities::CoreGui::ObserverTreeModelProxyFilter::rowFilterTypes() const {
     return row_filter_types;
 }
 
+void Qtilities::CoreGui::ObserverTreeModelProxyFilter::buildSortKeys(const QModelIndex& parent) const {
+    ObserverTreeModel* tree_model = d->tree_model;
+    int name_pos = tree_model->columnPosition(AbstractObserverItemModel::ColumnName);
+    int row_count = tree_model->rowCount(parent);
+
+    // Names are read from the model on this thread, only the keys are computed in parallel:
+    QVector<SortKey> keys;
+    keys.reserve(row_count);
+    for (int row = 0; row < row_count; ++row) {
+        ObserverTreeItem* item = tree_model->getItem(tree_model->index(row,0,parent));
+        if (!item || item->itemType() == ObserverTreeItem::InvalidType || d->sort_keys.contains(item))
+            continue;
+
+        SortKey key;
+        key.item = item;
+        if (item->itemType() == ObserverTreeItem::CategoryItem) {
+            key.rank = 1;
+            key.text = item->category().categoryTop();
+            key.collated = true;
+        } else {
+            key.rank = item->itemType() == ObserverTreeItem::TreeNode ? 0 : 2;
+            key.text = tree_model->index(row,name_pos,parent).data(sortRole()).toString();
+            key.collated = isSortLocaleAware();
+        }
+        keys << key;
+    }
+
+    if (d->parallel_sort_key_threshold > 0 && keys.count() >= d->parallel_sort_key_threshold && QThread::idealThreadCount() > 1) {
+        QThreadPool thread_pool;
+        int slice_count = QThread::idealThreadCount();
+        int slice_size = (keys.count() + slice_count - 1) / slice_count;
+        for (int first = 0; first < keys.count(); first += slice_size)
+            thread_pool.start(new SortKeyRunnable(&keys,first,qMin(first + slice_size,keys.count()) - 1,sortCaseSensitivity()));
+        thread_pool.waitForDone();
+    } else if (!keys.isEmpty())
+        qti_private_computeSortKeys(&keys,0,keys.count()-1,sortCaseSensitivity());
+
+    for (int i = 0; i < keys.count(); ++i)
+        d->sort_keys.insert(keys.at(i).item,keys.at(i));
+    d->sort_key_parents.insert(tree_model->getItem(parent));
+}
+
 bool Qtilities::CoreGui::ObserverTreeModelProxyFilter::lessThan(const QModelIndex &left, const QModelIndex &right) const {
-    ObserverTreeModel* tree_model = dynamic_cast<ObserverTreeModel*> (sourceModel());
+    ObserverTreeModel* tree_model = d->tree_model;
 
     if (tree_model) {
         int name_pos = tree_model->columnPosition(AbstractObserverItemModel::ColumnName);
         // Only do this for the name column:
         if (left.column() == name_pos && right.column() == name_pos) {
-            QModelIndex left_name_index = sourceModel()->index(left.row(), name_pos, left.parent());
-            QModelIndex right_name_index = sourceModel()->index(right.row(), name_pos, right.parent());
-            ObserverTreeItem* left_item = tree_model->getItem(left_name_index);
-            ObserverTreeItem* right_item = tree_model->getItem(right_name_index);
+            if (d->sort_keys_role != sortRole() || d->sort_keys_case_sensitivity != sortCaseSensitivity() || d->sort_keys_locale_aware != isSortLocaleAware()) {
+                d->sort_keys.clear();
+                d->sort_key_parents.clear();
+                d->sort_keys_role = sortRole();
+                d->sort_keys_case_sensitivity = sortCaseSensitivity();
+                d->sort_keys_locale_aware = isSortLocaleAware();
+            }
 
+            // The items are stored in the indexes, thus no name indexes have to be created:
+            const void* left_item = tree_model->getItem(left);
+            const void* right_item = tree_model->getItem(right);
             if (left_item && right_item) {
-                // We check according to the following criteria:
-                // Categories are smaller than normal items:
-                if (left_item->itemType() == ObserverTreeItem::CategoryItem && right_item->itemType() == ObserverTreeItem::CategoryItem) {
-                    // Check the names of the category
-                    return QString::localeAwareCompare(left_item->category().categoryTop(), right_item->category().categoryTop()) < 0;
-                } else if (left_item->itemType() == ObserverTreeItem::CategoryItem && right_item->itemType() == ObserverTreeItem::TreeItem)
-                    return true;
-                else if (left_item->itemType() == ObserverTreeItem::TreeItem && right_item->itemType() == ObserverTreeItem::CategoryItem)
-                    return false;
-                else if (left_item->itemType() == ObserverTreeItem::TreeNode && right_item->itemType() == ObserverTreeItem::CategoryItem)
-                    return true;
-                else if (left_item->itemType() == ObserverTreeItem::CategoryItem && right_item->itemType() == ObserverTreeItem::TreeNode)
-                    return false;
-                else if (left_item->itemType() == ObserverTreeItem::TreeNode && right_item->itemType() == ObserverTreeItem::TreeItem)
-                    return true;
-                else if (left_item->itemType() == ObserverTreeItem::TreeItem && right_item->itemType() == ObserverTreeItem::TreeNode)
-                    return false;
+                QHash<const void*,SortKey>::const_iterator left_key = d->sort_keys.constFind(left_item);
+                QHash<const void*,SortKey>::const_iterator right_key = d->sort_keys.constFind(right_item);
+                if (left_key == d->sort_keys.constEnd() || right_key == d->sort_keys.constEnd()) {
+                    if (!d->sort_key_parents.contains(tree_model->getItem(left.parent())))
+                        buildSortKeys(left.parent());
+                    left_key = d->sort_keys.constFind(left_item);
+                    right_key = d->sort_keys.constFind(right_item);
+                }
+
+                if (left_key != d->sort_keys.constEnd() && right_key != d->sort_keys.constEnd())
+                    return qti_private_sortKeyLessThan(left_key.value(),right_key.value());
             }
         }
     }
@@ -17,12 +17,39 @@
 #include "QtilitiesCoreGui_global.h"
 
 #include <QSortFilterProxyModel>
+#include <QRegExp>
 
 namespace Qtilities {
     namespace CoreGui {
+        class ObserverTreeModel;
+
+        /*!
+        \struct ObserverTreeModelProxyFilterPrivateData
+        \brief Structure used by ObserverTreeModelProxyFilter to store private data.
+          */
+        struct ObserverTreeModelProxyFilterPrivateData;
+
         /*!
           \class ObserverTreeModelProxyFilter
           \brief The ObserverTreeModelProxyFilter class is an implementation of a QSortFilterProxyModel which is used for advanced filtering in ObserverTreeModel.
+
+          Trees can be searched in two ways:
+          - Using the normal QSortFilterProxyModel filter functions, like setFilterRegExp(). The rows are matched on the GUI thread whenever the filter changes.
+          - Using setSearchExpression(). The proxy keeps an index of the names of the items in the tree, which is updated as the source model changes, and
+            matches the index against the expression in a worker thread. The rows shown are answered from the set of matching items once the matching
+            finished, thus changing the expression never blocks the GUI. The ancestors of matching items are part of the set as well, thus matches remain
+            visible when their parents are filtered.
+
+          When the filter is a fixed string set using setFilterFixedString() and the filter key column is the name column, the names of the children of
+          a parent are kept in a single case folded buffer. A change of the fixed string scans the buffer of a parent once and answers all its rows from
+          the result, instead of fetching and folding the name of every row again.
+
+          ObserverWidget uses setSearchExpression() for its search box in Qtilities::TreeView mode.
+
+          Rows in the name column are sorted tree nodes first, then categories and then tree items, each group by name. The proxy computes a sort key for
+          every item, consisting of the rank of its type and its name (a collation key when sorting locale aware, or for categories), the first time the
+          children of a parent are sorted. The keys are cached until the item is renamed or removed, thus sorting only compares keys. The keys of parents
+          with many children can be computed on a thread pool, see setParallelSortKeyThreshold().
           */
         class QTILITIES_CORE_GUI_SHARED_EXPORT ObserverTreeModelProxyFilter : public QSortFilterProxyModel
         {
@@ -37,12 +64,82 @@ namespace Qtilities {
             //! Gets the tree item types to be filtered in filterAcceptsRow().
             ObserverTreeItem::TreeItemTypeFlags rowFilterTypes() const;
 
+            void setSourceModel(QAbstractItemModel* source_model);
+
+            //! Sets the expression which is used to search the names of the items in the tree.
+            /*!
+              The expression is matched against the name index of the tree in a worker thread, and searchFinished() is emitted once the proxy was
+              filtered using the result. Until then, the result of the previous expression is shown. Pass an empty expression to clear the search.
+
+              The expression is independent of filterRegExp(), which should be left empty while searching using this function.
+
+              \sa searchExpression(), isSearching()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setSearchExpression(const QRegExp& expression);
+            //! Gets the expression which is used to search the names of the items in the tree.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QRegExp searchExpression() const;
+            //! Indicates if the search expression is currently being matched in a worker thread.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool isSearching() const;
+
+            //! Sets the number of children from which the sort keys of the children of a parent are computed on a thread pool.
+            /*!
+              Computing collation keys dominates the first sort of large trees. When \p count is 0 (the default), keys are always computed on the calling thread.
+
+              \sa parallelSortKeyThreshold()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setParallelSortKeyThreshold(int count);
+            //! Gets the number of children from which the sort keys of the children of a parent are computed on a thread pool.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int parallelSortKeyThreshold() const;
+
+        signals:
+            //! Signal which is emitted when the proxy was filtered using the result of the expression passed to setSearchExpression().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void searchFinished();
+
         protected:
             virtual bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
             virtual bool lessThan(const QModelIndex &left, const QModelIndex &right) const;
 
+        private slots:
+            //! Applies the matches of the search with \p generation, if the search is still current.
+            void handleSearchMatchesReady(int generation);
+            //! Starts matching the search expression against the name index in a worker thread.
+            void startSearch();
+            void handleSourceModelAboutToBeReset();
+            void handleSourceModelReset();
+            void handleSourceRowsInserted(const QModelIndex& parent, int first, int last);
+            void handleSourceRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+            void handleSourceDataChanged(const QModelIndex& top_left, const QModelIndex& bottom_right);
+
         private:
+            //! Adds the rows from \p first to \p last under \p parent, and all their children, to the name index.
+            void indexRows(const QModelIndex& parent, int first, int last);
+            //! Removes the rows from \p first to \p last under \p parent, and all their children, from the name index and the sort keys.
+            void unindexRows(const QModelIndex& parent, int first, int last);
+            //! Queues startSearch(), unless it is already queued.
+            void scheduleSearch();
+            //! Computes the sort keys of the children of \p parent which do not have a sort key yet.
+            void buildSortKeys(const QModelIndex& parent) const;
+            //! Matches \p source_row against the fixed string filter, using the name buffer of \p source_parent.
+            bool fixedStringAcceptsRow(int source_row, const QModelIndex& source_parent) const;
+
             ObserverTreeItem::TreeItemTypeFlags row_filter_types;
+            ObserverTreeModelProxyFilterPrivateData* d;
         };
     }
 }
@@ -40,6 +40,8 @@
 #include <QStack>
 #include <QDropEvent>
 #include <QMouseEvent>
+#include <QShowEvent>
+#include <QHideEvent>
 #include <QDragEnterEvent>
 #include <QMessageBox>
 #include <QDragMoveEvent>
@@ -54,6 +56,11 @@
 #include <QToolBar>
 #include <QDrag>
 #include <QGraphicsOpacityEffect>
+#include <QTimer>
+#include <QSet>
+#include <QItemSelectionModel>
+#include <QHeaderView>
+#include <QStyleOptionViewItem>
 
 #include <stdio.h>
 #include <time.h>
@@ -71,6 +78,95 @@ namespace Qtilities {
     }
 }
 
+namespace {
+    //! The inputs which determine the state of the actions in ObserverWidget::refreshActions().
+    struct ActionStateInputs {
+        ActionStateInputs() : initialized(false),
+            display_mode(-1),
+            hints(0),
+            action_hints(0),
+            use_observer_hints(false),
+            read_only(false),
+            expand_collapse_visible(false),
+            has_filter_actions(false),
+            navigation_depth(0),
+            root_context(0),
+            selection_parent_context(0),
+            selection_parent_context_count(-1),
+            selection_parent(0),
+            selection_parent_access_mode(-1),
+            active_selection_context_hint(-1),
+            selected_access_mode(-1),
+            selected_observer_count(-1),
+            selected_observer_context_hint(-1),
+            selected_observer_access_mode(-1),
+            selected_observer_hints(0) {}
+
+        //! Compares the inputs which determine which actions are visible.
+        bool hintsEqual(const ActionStateInputs& other) const {
+            return display_mode == other.display_mode && hints == other.hints && action_hints == other.action_hints;
+        }
+
+        bool operator==(const ActionStateInputs& other) const {
+            return initialized == other.initialized &&
+                    hintsEqual(other) &&
+                    use_observer_hints == other.use_observer_hints &&
+                    read_only == other.read_only &&
+                    expand_collapse_visible == other.expand_collapse_visible &&
+                    has_filter_actions == other.has_filter_actions &&
+                    navigation_depth == other.navigation_depth &&
+                    root_context == other.root_context &&
+                    selection_parent_context == other.selection_parent_context &&
+                    selection_parent_context_count == other.selection_parent_context_count &&
+                    selection_parent == other.selection_parent &&
+                    selection_parent_access_mode == other.selection_parent_access_mode &&
+                    selection_parent_name == other.selection_parent_name &&
+                    active_selection_context_hint == other.active_selection_context_hint &&
+                    selected_access_mode == other.selected_access_mode &&
+                    selected_name == other.selected_name &&
+                    selected_observer_count == other.selected_observer_count &&
+                    selected_observer_context_hint == other.selected_observer_context_hint &&
+                    selected_observer_access_mode == other.selected_observer_access_mode &&
+                    selected_observer_hints == other.selected_observer_hints &&
+                    selected_observer_name == other.selected_observer_name &&
+                    selection == other.selection &&
+                    selection_item_types == other.selection_item_types;
+        }
+
+        bool                initialized;
+        int                 display_mode;
+        const void*         hints;
+        int                 action_hints;
+        bool                use_observer_hints;
+        bool                read_only;
+        bool                expand_collapse_visible;
+        bool                has_filter_actions;
+        int                 navigation_depth;
+        const void*         root_context;
+        const void*         selection_parent_context;
+        int                 selection_parent_context_count;
+        const void*         selection_parent;
+        int                 selection_parent_access_mode;
+        QString             selection_parent_name;
+        //! The selection context hint of the active hints.
+        int                 active_selection_context_hint;
+        //! The access mode of the category of the selected object in its context when a single object is selected, otherwise -1.
+        int                 selected_access_mode;
+        //! The name of the selected object in its context when a single object is selected.
+        QString             selected_name;
+        //! The subject count of the selected object when a single observer is selected, otherwise -1.
+        int                 selected_observer_count;
+        //! The selection context hint of the selected object when a single observer is selected, otherwise -1.
+        int                 selected_observer_context_hint;
+        //! The access mode of the selected object when a single observer is selected, otherwise -1.
+        int                 selected_observer_access_mode;
+        const void*         selected_observer_hints;
+        QString             selected_observer_name;
+        QList<QObject*>     selection;
+        QList<int>          selection_item_types;
+    };
+}
+
 struct Qtilities::CoreGui::ObserverWidgetData {
     ObserverWidgetData() : refresh_mode(ObserverWidget::RefreshModeShowTree),
         update_progress_widget_contents(0),
@@ -91,6 +187,8 @@ struct Qtilities::CoreGui::ObserverWidgetData {
         actionExpandAll(0),
         actionCollapseAll(0),
         actionFindItem(0),
+        actionUndo(0),
+        actionRedo(0),
         #ifndef QT_NO_DEBUG
         actionDebugObject(0),
         #endif
@@ -116,6 +214,9 @@ struct Qtilities::CoreGui::ObserverWidgetData {
         hints_selection_parent(0),
         use_observer_hints(true),
         update_global_active_objects(false),
+        selection_notified(false),
+        selection_extracted(false),
+        model_updates_suspended(false),
         action_provider(0),
         default_row_height(17),
         confirm_deletes(true),
@@ -134,7 +235,10 @@ struct Qtilities::CoreGui::ObserverWidgetData {
         disable_proxy_models(false),
         lazy_init(false),
         lazy_refresh(false),
-        search_item_filter_flags(ObserverTreeItem::TreeItem) { }
+        search_item_filter_flags(ObserverTreeItem::TreeItem),
+        column_resize_mode(ObserverWidget::ColumnResizeSampledRows),
+        column_resize_sample_size(500),
+        action_state_inputs_valid(false) { }
     ~ObserverWidgetData() {}
 
     //! The current selection parent observer context, returned using selectionParent().
@@ -176,9 +280,13 @@ struct Qtilities::CoreGui::ObserverWidgetData {
     QAction* actionExpandAll;
     QAction* actionCollapseAll;
     QAction* actionFindItem;
+    QAction* actionUndo;
+    QAction* actionRedo;
     #ifndef QT_NO_DEBUG
     QAction* actionDebugObject;
     #endif
+    //! The undo stack which is undone and redone by actionUndo and actionRedo.
+    QPointer<ObserverUndoStack> undo_stack;
 
     //! The navigation stack of this widget, used only in TableView mode.
     QStack<int> navigation_stack;
@@ -255,8 +363,17 @@ struct Qtilities::CoreGui::ObserverWidgetData {
 
     //! The current selection in this widget. Set in the selectedObjects() function.
     QList<QPointer<QObject> > current_selection;
+    //! Handles to the objects in current_selection, passed to the object manager as the global active objects.
+    ObjectHandleList current_selection_handles;
     //! The current selection in this widget in terms of ObserverTreeItems. Set in the selectedObjects() function.
     QList<QPointer<ObserverTreeItem> > current_tree_item_selection;
+    //! The selection for which handleSelectionModelChange() last notified listeners in table view mode, valid when selection_notified is true.
+    ObjectHandleList notified_selection_handles;
+    bool selection_notified;
+    //! Indicates that current_selection is up to date while selectedObjectsChanged() is emitted.
+    bool selection_extracted;
+    //! Indicates if the updates of the models are suspended because the widget is hidden.
+    bool model_updates_suspended;
     //! The IActionProvider interface implementation.
     ActionProvider* action_provider;
     //! The default row height used in TableView mode.
@@ -304,8 +421,149 @@ struct Qtilities::CoreGui::ObserverWidgetData {
     bool lazy_refresh;
 
     ObserverTreeItem::TreeItemTypeFlags search_item_filter_flags;
+    //! Debounces search string changes in the search box.
+    QTimer search_timer;
+    //! The search string which will be applied when search_timer times out.
+    QString pending_search_string;
+
+    ObserverWidget::ColumnResizeMode column_resize_mode;
+    int column_resize_sample_size;
+    //! The widths measured in ColumnResizeSampledRows mode, keyed by column and source item, along with the text which was measured.
+    QHash<QPair<int,quintptr>,QPair<QString,int> > column_width_cache;
+
+    //! The inputs for which refreshActions() last updated the actions.
+    ActionStateInputs action_state_inputs;
+    //! Indicates if the actions reflect action_state_inputs. Cleared when the observer context, the selected observer or the active hints change.
+    bool action_state_inputs_valid;
+    //! The selected observer of which changes invalidate action_state_inputs.
+    QPointer<Observer> action_state_observer;
+    //! The hints of which changes invalidate action_state_inputs.
+    QPointer<ObserverHints> action_state_hints;
 };
 
+namespace {
+    //! Returns the icon in \p file_name. Icons are loaded once and shared by the actions of all observer widgets.
+    QIcon qti_private_sharedActionIcon(const QString& file_name) {
+        static QHash<QString,QIcon> icons;
+        QHash<QString,QIcon>::const_iterator itr = icons.constFind(file_name);
+        if (itr != icons.constEnd())
+            return itr.value();
+
+        QIcon icon(file_name);
+        icons.insert(file_name,icon);
+        return icon;
+    }
+
+    //! Returns the indexes in \p column of the selected rows in \p selection_model, without duplicates.
+    /*!
+      QItemSelectionModel::selectedIndexes() returns an index for every selected cell. This walks the selection ranges instead, thus only the
+      indexes in \p column are created.
+      */
+    QModelIndexList qti_private_selectedColumnIndexes(const QItemSelectionModel* selection_model, int column) {
+        QModelIndexList indexes;
+        if (!selection_model || !selection_model->model())
+            return indexes;
+
+        const QAbstractItemModel* model = selection_model->model();
+        const QItemSelection selection = selection_model->selection();
+        // Ranges only overlap when there is more than one:
+        QSet<QModelIndex> seen_indexes;
+        const bool check_duplicates = selection.count() > 1;
+        for (int r = 0; r < selection.count(); ++r) {
+            const QItemSelectionRange& range = selection.at(r);
+            if (column < range.left() || column > range.right())
+                continue;
+
+            for (int row = range.top(); row <= range.bottom(); ++row) {
+                QModelIndex index = model->index(row,column,range.parent());
+                // Same rule as QItemSelectionModel::selectedIndexes():
+                const Qt::ItemFlags flags = model->flags(index);
+                if (!(flags & Qt::ItemIsSelectable) || !(flags & Qt::ItemIsEnabled))
+                    continue;
+                if (check_duplicates) {
+                    if (seen_indexes.contains(index))
+                        continue;
+                    seen_indexes.insert(index);
+                }
+                indexes << index;
+            }
+        }
+        return indexes;
+    }
+
+    //! Sets the category of the command registered under \p id. All observer widgets register their actions under the same commands, thus it is only set once per command.
+    void qti_private_setCommandCategory(const QString& id, Qtilities::CoreGui::Command* command, const Qtilities::Core::QtilitiesCategory& category) {
+        static QHash<QString,QPointer<Qtilities::CoreGui::Command> > categorized_commands;
+        if (!command)
+            return;
+
+        QPointer<Qtilities::CoreGui::Command>& categorized_command = categorized_commands[id];
+        if (categorized_command == command)
+            return;
+
+        command->setCategory(category);
+        categorized_command = command;
+    }
+
+    //! Gathers the inputs which determine the state of the actions of \p widget.
+    ActionStateInputs currentActionStateInputs(const Qtilities::CoreGui::ObserverWidget* widget, const Qtilities::CoreGui::ObserverWidgetData* d) {
+        ActionStateInputs inputs;
+        inputs.initialized = d->initialized || d->actionRemoveItem;
+        inputs.display_mode = d->display_mode;
+        inputs.hints = widget->activeHints();
+        inputs.action_hints = widget->activeHints()->actionHints();
+        inputs.active_selection_context_hint = widget->activeHints()->observerSelectionContextHint();
+        inputs.use_observer_hints = d->use_observer_hints;
+        inputs.read_only = d->read_only;
+        inputs.expand_collapse_visible = d->is_expand_collapse_visible;
+        inputs.has_filter_actions = d->actionFilterCategories != 0;
+        inputs.navigation_depth = d->navigation_stack.count();
+        inputs.root_context = d->root_observer_context;
+        inputs.selection_parent_context = d->selection_parent_observer_context;
+        if (d->selection_parent_observer_context)
+            inputs.selection_parent_context_count = d->selection_parent_observer_context->subjectCount();
+        Observer* selection_parent = widget->selectionParent();
+        inputs.selection_parent = selection_parent;
+        if (selection_parent) {
+            inputs.selection_parent_access_mode = selection_parent->accessMode();
+            inputs.selection_parent_name = selection_parent->observerName();
+        }
+
+        for (int i = 0; i < d->current_selection.count(); ++i)
+            inputs.selection << d->current_selection.at(i);
+        for (int i = 0; i < d->current_tree_item_selection.count(); ++i) {
+            if (d->current_tree_item_selection.at(i))
+                inputs.selection_item_types << d->current_tree_item_selection.at(i)->itemType();
+            else
+                inputs.selection_item_types << -1;
+        }
+
+        if (d->current_selection.count() == 1 && d->current_selection.front()) {
+            QObject* obj = d->current_selection.front();
+            // The access mode and name of the selected object are looked up in the same context as in refreshActions():
+            Observer* access_context = selection_parent ? selection_parent : d->selection_parent_observer_context;
+            if (access_context) {
+                QtilitiesCategory category = access_context->getMultiContextPropertyValue(obj,qti_prop_CATEGORY_MAP).value<QtilitiesCategory>();
+                inputs.selected_access_mode = access_context->accessMode(category);
+                inputs.selected_name = access_context->subjectNameInContext(obj);
+            } else
+                inputs.selected_name = obj->objectName();
+
+            Observer* selected = qobject_cast<Observer*> (obj);
+            if (selected) {
+                inputs.selected_observer_count = selected->subjectCount();
+                inputs.selected_observer_access_mode = selected->accessMode();
+                inputs.selected_observer_hints = selected->displayHints();
+                inputs.selected_observer_name = selected->observerName();
+                if (selected->displayHints())
+                    inputs.selected_observer_context_hint = selected->displayHints()->observerSelectionContextHint();
+            }
+        }
+
+        return inputs;
+    }
+}
+
 Qtilities::CoreGui::ObserverWidget::ObserverWidget(DisplayMode display_mode, QWidget * parent, Qt::WindowFlags f) :
     QMainWindow(parent, f),
     ui(new Ui::ObserverWidget)
@@ -350,6 +608,10 @@ void Qtilities::CoreGui::ObserverWidget::constructPrivate(DisplayMode display_mo
     ui->widgetSearchBox->hide();
     ui->navigationBarWidget->setVisible(false);
 
+    d->search_timer.setSingleShot(true);
+    d->search_timer.setInterval(250);
+    connect(&d->search_timer,SIGNAL(timeout()),SLOT(handleSearchTimerTimeout()));
+
     // Assign a default meta type for this widget:
     // We construct each action and then register it
     QString context_string = "ObserverWidget";
@@ -438,6 +700,10 @@ bool Qtilities::CoreGui::ObserverWidget::setObserverContext(Observer* observer)
     d->selection_parent_observer_context = observer;
 
     connect(d->selection_parent_observer_context,SIGNAL(destroyed()),SLOT(contextDeleted()),Qt::UniqueConnection);
+    connect(d->selection_parent_observer_context,SIGNAL(dataChanged(Observer*)),SLOT(invalidateActionStates()),Qt::UniqueConnection);
+    connect(d->selection_parent_observer_context,SIGNAL(subjectDataChanged(Observer*,QObject*)),SLOT(invalidateActionStates()),Qt::UniqueConnection);
+    connect(d->selection_parent_observer_context,SIGNAL(layoutChanged(QList<QPointer<QObject> >)),SLOT(invalidateActionStates()),Qt::UniqueConnection);
+    d->action_state_inputs_valid = false;
 
     // Update the observer context of the delegates
     if (d->display_mode == TableView && d->table_name_column_delegate)
@@ -729,10 +995,13 @@ void Qtilities::CoreGui::ObserverWidget::updateLastExpandedResults(const QModelI
             d->last_expanded_objects_result.clear();
             d->last_expanded_categories_result.clear();
 
+            // The expanded objects found so far, the list is checked for the parent of every index:
+            QSet<const QObject*> expanded_objects;
+
             QModelIndexList indexes_to_add = d->tree_model->getAllIndexes();
             // Add required indexes:
             foreach (QModelIndex source_index, indexes_to_add) {
-                QApplication::processEvents();
+                IDLE_SCHEDULER->yieldToEventLoop();
                 ObserverTreeItem* item = d->tree_model->getItem(source_index);
                 if (!item)
                     continue;
@@ -747,7 +1016,7 @@ void Qtilities::CoreGui::ObserverWidget::updateLastExpandedResults(const QModelI
                         Observer* obs = d->tree_model->parentOfIndex(source_index);
                         if (obs) {
                             if (obs != d->root_observer_context) {
-                                if (!d->last_expanded_objects_result.contains(obs)) {
+                                if (!expanded_objects.contains(obs)) {
                                     //qDebug() << "Not adding expanded item" << item->objectName() << "to list of expanded items. Its parent node is not expanded. Parent:" << obs->observerName() << ", Observer context:" << d->root_observer_context;
                                     continue;
                                 }
@@ -756,7 +1025,7 @@ void Qtilities::CoreGui::ObserverWidget::updateLastExpandedResults(const QModelI
                     } else {
                         Observer* obs = d->tree_model->parentOfIndex(source_index);
                         if (obs) {
-                            if (!d->last_expanded_objects_result.contains(obs)) {
+                            if (!expanded_objects.contains(obs)) {
                                 //qDebug() << "Not adding expanded item" << item->objectName() << "to list of expanded items. Its parent node is not expanded. Parent: " << obs->observerName();
                                 continue;
                             }
@@ -778,8 +1047,10 @@ void Qtilities::CoreGui::ObserverWidget::updateLastExpandedResults(const QModelI
                         else if (item->itemType() == ObserverTreeItem::TreeNode)
                             d->last_expanded_names_result << item_text;
                         QObject* obj = d->tree_model->getObject(source_index);
-                        if (obj)
+                        if (obj) {
                             d->last_expanded_objects_result << obj;
+                            expanded_objects.insert(obj);
+                        }
                     }
                 }
             }
@@ -790,6 +1061,9 @@ void Qtilities::CoreGui::ObserverWidget::updateLastExpandedResults(const QModelI
 }
 
 void Qtilities::CoreGui::ObserverWidget::initializePrivate(bool hints_only) {
+    // The context, display mode or hints can change, thus the next selection change is always passed on:
+    d->selection_notified = false;
+
     // Check it this widget was initialized previously
     if (!d->initialized) {
         // Setup some flags and attributes for this widget the first time it is constructed.
@@ -924,6 +1198,7 @@ void Qtilities::CoreGui::ObserverWidget::initializePrivate(bool hints_only) {
                         QSortFilterProxyModel* new_model = new ObserverTreeModelProxyFilter(this);
                         new_model->setDynamicSortFilter(true);
                         new_model->setFilterKeyColumn(d->tree_model->columnPosition(AbstractObserverItemModel::ColumnName));
+                        connect(new_model,SIGNAL(searchFinished()),SLOT(resizeColumns()));
                         d->tree_proxy_model = new_model;
                     }
                 } else {
@@ -1096,9 +1371,9 @@ void Qtilities::CoreGui::ObserverWidget::initializePrivate(bool hints_only) {
     // Refreshes the visibility of columns:
     refreshColumnVisibility();
 
-    // If the action hints indicate that actions must be present, we call
-    // constructActions(). Its clever enought not too construct everything just once:
-    if (activeHints()->actionHints() != ObserverHints::ActionNoHints && !d->actions_constructed)
+    // If the action hints indicate that actions must be present, we call constructActions(). Widgets which are not
+    // visible yet construct their actions when they are shown for the first time, or when actionProvider() is called:
+    if (activeHints()->actionHints() != ObserverHints::ActionNoHints && !d->actions_constructed && isVisible())
         constructActions(); // Will also do the refresh().
 
     if (d->display_mode == Qtilities::TableView) {
@@ -1106,6 +1381,10 @@ void Qtilities::CoreGui::ObserverWidget::initializePrivate(bool hints_only) {
         setCursor(d->current_cursor);
     }
 
+    // Models which were created while the widget is hidden only start to defer changes once they were initialized:
+    if (d->model_updates_suspended)
+        setModelUpdatesSuspended(true);
+
     d->initialized = true;
 }
 
@@ -1338,23 +1617,27 @@ QList<QObject*> Qtilities::CoreGui::ObserverWidget::selectedObjects() const {
     QList<QObject*> selected_objects;
     QList<QPointer<QObject> > smart_selected_objects;
     QList<QPointer<ObserverTreeItem> > smart_tree_item_selection;
+    // Objects can be selected more than once in tree views, where they can appear under different parents:
+    QSet<QObject*> unique_objects;
 
     if (d->display_mode == TableView) {
         if (!d->table_view || !d->table_model)
             return selected_objects;
 
-        if (d->table_view->selectionModel()) {          
-            QModelIndexList selected_indexes = d->table_view->selectionModel()->selectedIndexes();
+        if (d->table_view->selectionModel()) {
+            // Only the name column identifies the objects:
+            const QModelIndexList selected_indexes = qti_private_selectedColumnIndexes(d->table_view->selectionModel(),1);
+            selected_objects.reserve(selected_indexes.count());
             for (int i = 0; i < selected_indexes.count(); ++i) {
-                QModelIndex index = selected_indexes.at(i);
-                if (index.column() == 1) {
-                    QModelIndex mapped_idx = index;
-                    if (proxyModel())
-                        mapped_idx = proxyModel()->mapToSource(index);
-                    QObject* obj = d->table_model->getObject(mapped_idx);
-                    smart_selected_objects << obj;
-                    selected_objects << obj;
-                }
+                QModelIndex mapped_idx = selected_indexes.at(i);
+                if (proxyModel())
+                    mapped_idx = proxyModel()->mapToSource(mapped_idx);
+                QObject* obj = d->table_model->getObject(mapped_idx);
+                if (unique_objects.contains(obj))
+                    continue;
+                unique_objects.insert(obj);
+                smart_selected_objects << obj;
+                selected_objects << obj;
             }
         }
 
@@ -1366,22 +1649,23 @@ QList<QObject*> Qtilities::CoreGui::ObserverWidget::selectedObjects() const {
         QList<QtilitiesCategory> selected_categories;
 
         if (d->tree_view->selectionModel()) {
-            QModelIndexList selected_indexes = d->tree_view->selectionModel()->selectedIndexes();
+            const QModelIndexList selected_indexes = qti_private_selectedColumnIndexes(d->tree_view->selectionModel(),0);
+            selected_objects.reserve(selected_indexes.count());
             for (int i = 0; i < selected_indexes.count(); ++i) {
-                QModelIndex index = selected_indexes.at(i);
-                if (index.column() == 0) {
-                    QModelIndex mapped_idx = index;
-                    if (proxyModel())
-                        mapped_idx = proxyModel()->mapToSource(index);
+                QModelIndex mapped_idx = selected_indexes.at(i);
+                if (proxyModel())
+                    mapped_idx = proxyModel()->mapToSource(mapped_idx);
+                ObserverTreeItem* tree_item = d->tree_model->getItem(mapped_idx);
+                if (tree_item->itemType() == ObserverTreeItem::CategoryItem)
+                    selected_categories << tree_item->category();
+                else if (tree_item->itemType() != ObserverTreeItem::ValueItem) {
                     QObject* obj = d->tree_model->getObject(mapped_idx);
-                    ObserverTreeItem* tree_item = d->tree_model->getItem(mapped_idx);
-                    if (tree_item->itemType() == ObserverTreeItem::CategoryItem)
-                        selected_categories << tree_item->category();
-                    else {
-                        smart_selected_objects << obj;
-                        smart_tree_item_selection << tree_item;
-                        selected_objects << obj;
-                    }
+                    if (unique_objects.contains(obj))
+                        continue;
+                    unique_objects.insert(obj);
+                    smart_selected_objects << obj;
+                    smart_tree_item_selection << tree_item;
+                    selected_objects << obj;
                 }
             }
         }
@@ -1389,13 +1673,17 @@ QList<QObject*> Qtilities::CoreGui::ObserverWidget::selectedObjects() const {
         d->tree_model->setSelectedObjects(smart_selected_objects);
         d->tree_model->setSelectedCategories(selected_categories);
     }
-    d->current_selection = smart_selected_objects;   
+    d->current_selection = smart_selected_objects;
+    d->current_selection_handles = ObjectHandleList(selected_objects);
     d->current_tree_item_selection = smart_tree_item_selection;
-    selectedObjectsContextMatch();
-    selectedObjectsHintsMatch();
     return selected_objects;
 }
 
+Qtilities::Core::ObjectHandleList Qtilities::CoreGui::ObserverWidget::selectedObjectHandles() const {
+    selectedObjects();
+    return d->current_selection_handles;
+}
+
 bool Qtilities::CoreGui::ObserverWidget::selectedObjectsContextMatch() const {
     QModelIndexList indexes = selectedIndexes();
     Observer* parent = 0;
@@ -1454,31 +1742,23 @@ bool Qtilities::CoreGui::ObserverWidget::selectedObjectsHintsMatch() const {
 QModelIndexList Qtilities::CoreGui::ObserverWidget::selectedIndexes() const {
     QModelIndexList selected_indexes;
 
+    QItemSelectionModel* selection_model = 0;
+    int name_column = 0;
     if (d->display_mode == TableView) {
         if (!d->table_view || !d->table_model || !proxyModel())
             return selected_indexes;
-
-        if (d->table_view->selectionModel()) {
-            QModelIndexList selected_indexes_tmp = d->table_view->selectionModel()->selectedIndexes();
-            for (int i = 0; i < selected_indexes_tmp.count(); ++i) {
-                QModelIndex index = selected_indexes_tmp.at(i);
-                if (index.column() == 1)
-                    selected_indexes << proxyModel()->mapToSource(index);
-            }
-        }
+        selection_model = d->table_view->selectionModel();
+        name_column = 1;
     } else if (d->display_mode == TreeView) {
         if (!d->tree_view || !d->tree_model || !proxyModel())
             return selected_indexes;
-
-        if (d->tree_view->selectionModel()) {
-            QModelIndexList selected_indexes_tmp = d->tree_view->selectionModel()->selectedIndexes();
-            for (int i = 0; i < selected_indexes_tmp.count(); ++i) {
-                QModelIndex index = selected_indexes_tmp.at(i);
-                if (index.column() == 0)
-                    selected_indexes << proxyModel()->mapToSource(index);
-            }
-        }
+        selection_model = d->tree_view->selectionModel();
     }
+
+    const QModelIndexList selected_indexes_tmp = qti_private_selectedColumnIndexes(selection_model,name_column);
+    selected_indexes.reserve(selected_indexes_tmp.count());
+    for (int i = 0; i < selected_indexes_tmp.count(); ++i)
+        selected_indexes << proxyModel()->mapToSource(selected_indexes_tmp.at(i));
     return selected_indexes;
 }
 
@@ -1522,6 +1802,25 @@ void Qtilities::CoreGui::ObserverWidget::disableAutoColumnResizing() {
     d->do_column_resizing = false;
 }
 
+void Qtilities::CoreGui::ObserverWidget::setColumnResizeMode(ColumnResizeMode column_resize_mode) {
+    d->column_resize_mode = column_resize_mode;
+    d->column_width_cache.clear();
+}
+
+Qtilities::CoreGui::ObserverWidget::ColumnResizeMode Qtilities::CoreGui::ObserverWidget::columnResizeMode() const {
+    return d->column_resize_mode;
+}
+
+void Qtilities::CoreGui::ObserverWidget::setColumnResizeSampleSize(int sample_size) {
+    if (sample_size < 0)
+        sample_size = 0;
+    d->column_resize_sample_size = sample_size;
+}
+
+int Qtilities::CoreGui::ObserverWidget::columnResizeSampleSize() const {
+    return d->column_resize_sample_size;
+}
+
 void Qtilities::CoreGui::ObserverWidget::enableAutoSelectAndExpand() {
     d->do_auto_select_and_expand = true;
     if (d->tree_model)
@@ -1556,9 +1855,70 @@ QString Qtilities::CoreGui::ObserverWidget::globalMetaType() const {
 }
 
 Qtilities::CoreGui::Interfaces::IActionProvider* Qtilities::CoreGui::ObserverWidget::actionProvider() {
+    if (d->initialized && !d->actions_constructed && activeHints()->actionHints() != ObserverHints::ActionNoHints)
+        constructActions();
     return d->action_provider;
 }
 
+void Qtilities::CoreGui::ObserverWidget::setUndoStack(ObserverUndoStack* undo_stack) {
+    if (d->undo_stack == undo_stack)
+        return;
+
+    if (d->undo_stack)
+        d->undo_stack->disconnect(this);
+
+    d->undo_stack = undo_stack;
+    if (d->undo_stack) {
+        connect(d->undo_stack,SIGNAL(canUndoChanged(bool)),SLOT(refreshUndoActions()));
+        connect(d->undo_stack,SIGNAL(canRedoChanged(bool)),SLOT(refreshUndoActions()));
+        connect(d->undo_stack,SIGNAL(undoTextChanged(QString)),SLOT(refreshUndoActions()));
+        connect(d->undo_stack,SIGNAL(redoTextChanged(QString)),SLOT(refreshUndoActions()));
+        connect(d->undo_stack,SIGNAL(destroyed()),SLOT(refreshUndoActions()));
+    }
+
+    refreshUndoActions();
+}
+
+Qtilities::Core::ObserverUndoStack* Qtilities::CoreGui::ObserverWidget::undoStack() const {
+    return d->undo_stack;
+}
+
+void Qtilities::CoreGui::ObserverWidget::undo() {
+    if (d->undo_stack)
+        d->undo_stack->undo();
+}
+
+void Qtilities::CoreGui::ObserverWidget::redo() {
+    if (d->undo_stack)
+        d->undo_stack->redo();
+}
+
+void Qtilities::CoreGui::ObserverWidget::refreshUndoActions() {
+    if (!d->actionUndo || !d->actionRedo)
+        return;
+
+    // The actions are only shown when the widget has an undo stack:
+    const bool has_undo_stack = !d->undo_stack.isNull();
+    d->actionUndo->setVisible(has_undo_stack);
+    d->actionRedo->setVisible(has_undo_stack);
+    if (!has_undo_stack) {
+        d->actionUndo->setEnabled(false);
+        d->actionRedo->setEnabled(false);
+        return;
+    }
+
+    d->actionUndo->setEnabled(d->undo_stack->canUndo());
+    d->actionRedo->setEnabled(d->undo_stack->canRedo());
+    if (d->undo_stack->canUndo())
+        d->actionUndo->setText(tr("Undo") + " " + d->undo_stack->undoText());
+    else
+        d->actionUndo->setText(tr("Undo"));
+    if (d->undo_stack->canRedo())
+        d->actionRedo->setText(tr("Redo") + " " + d->undo_stack->redoText());
+    else
+        d->actionRedo->setText(tr("Redo"));
+}
+
 #ifdef QTILITIES_PROPERTY_BROWSER
 Qtilities::CoreGui::ObjectPropertyBrowser* Qtilities::CoreGui::ObserverWidget::propertyBrowser() {
     return d->property_browser_widget;
@@ -1631,45 +1991,45 @@ void Qtilities::CoreGui::ObserverWidget::constructActions() {
     // ---------------------------
     // New Item
     // ---------------------------
-    d->actionNewItem = new QAction(QIcon(qti_icon_NEW_16x16),tr("New Item"),this);
+    d->actionNewItem = new QAction(qti_private_sharedActionIcon(qti_icon_NEW_16x16),tr("New Item"),this);
     d->actionNewItem->setShortcut(QKeySequence("+"));
     connect(d->actionNewItem,SIGNAL(triggered()),SLOT(handle_actionNewItem_triggered()));
     Command* command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_NEW_ITEM,d->actionNewItem,context);
     d->action_provider->addAction(d->actionNewItem,QtilitiesCategory(tr("Items")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_NEW_ITEM,command,item_views_category);
     // ---------------------------
     // Remove Item
     // ---------------------------
-    d->actionRemoveItem = new QAction(QIcon(qti_icon_REMOVE_ONE_16x16),tr("Detach Selection"),this);
+    d->actionRemoveItem = new QAction(qti_private_sharedActionIcon(qti_icon_REMOVE_ONE_16x16),tr("Detach Selection"),this);
     connect(d->actionRemoveItem,SIGNAL(triggered()),SLOT(selectionDetach()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_REMOVE_ITEM,d->actionRemoveItem,context);
     d->action_provider->addAction(d->actionRemoveItem,QtilitiesCategory(tr("Items")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_REMOVE_ITEM,command,item_views_category);
     // ---------------------------
     // Delete Item
     // ---------------------------
-    d->actionDeleteItem = new QAction(QIcon(qti_icon_DELETE_ONE_16x16),tr("Delete Selection"),this);
+    d->actionDeleteItem = new QAction(qti_private_sharedActionIcon(qti_icon_DELETE_ONE_16x16),tr("Delete Selection"),this);
     d->actionDeleteItem->setShortcut(QKeySequence(QKeySequence::Delete));
     connect(d->actionDeleteItem,SIGNAL(triggered()),SLOT(selectionDelete()));
     command = ACTION_MANAGER->registerAction(qti_action_SELECTION_DELETE,d->actionDeleteItem,context);
     d->action_provider->addAction(d->actionDeleteItem,QtilitiesCategory(tr("Items")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_SELECTION_DELETE,command,item_views_category);
     // ---------------------------
     // Remove All
     // ---------------------------    
-    d->actionRemoveAll = new QAction(QIcon(qti_icon_REMOVE_ALL_16x16),tr("Deatch All Children"),this);
+    d->actionRemoveAll = new QAction(qti_private_sharedActionIcon(qti_icon_REMOVE_ALL_16x16),tr("Deatch All Children"),this);
     connect(d->actionRemoveAll,SIGNAL(triggered()),SLOT(selectionDetachAll()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_REMOVE_ALL,d->actionRemoveAll,context);
     d->action_provider->addAction(d->actionRemoveAll,QtilitiesCategory(tr("Items")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_REMOVE_ALL,command,item_views_category);
     // ---------------------------
     // Delete All
     // ---------------------------
-    d->actionDeleteAll = new QAction(QIcon(qti_icon_DELETE_ALL_16x16),tr("Delete All Children"),this);
+    d->actionDeleteAll = new QAction(qti_private_sharedActionIcon(qti_icon_DELETE_ALL_16x16),tr("Delete All Children"),this);
     connect(d->actionDeleteAll,SIGNAL(triggered()),SLOT(selectionDeleteAll()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_DELETE_ALL,d->actionDeleteAll,context);
     d->action_provider->addAction(d->actionDeleteAll,QtilitiesCategory(tr("Items")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_DELETE_ALL,command,item_views_category);
     // ---------------------------
     // Switch View
     // ---------------------------
@@ -1678,83 +2038,102 @@ void Qtilities::CoreGui::ObserverWidget::constructActions() {
     connect(d->actionSwitchView,SIGNAL(triggered()),SLOT(toggleDisplayMode()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_SWITCH_VIEW,d->actionSwitchView,context);
     d->action_provider->addAction(d->actionSwitchView,QtilitiesCategory(tr("View")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_SWITCH_VIEW,command,item_views_category);
     // ---------------------------
     // Refresh View
     // ---------------------------
-    d->actionRefreshView = new QAction(QIcon(qti_icon_REFRESH_16x16),tr("Refresh View"),this);
+    d->actionRefreshView = new QAction(qti_private_sharedActionIcon(qti_icon_REFRESH_16x16),tr("Refresh View"),this);
     //d->actionRefreshView->setShortcut(QKeySequence(QKeySequence::Refresh));
     connect(d->actionRefreshView,SIGNAL(triggered()),SLOT(refresh()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_REFRESH_VIEW,d->actionRefreshView,context);
     d->action_provider->addAction(d->actionRefreshView,QtilitiesCategory(tr("View")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_REFRESH_VIEW,command,item_views_category);
     // ---------------------------
     // Find Item
     // ---------------------------
-    d->actionFindItem = new QAction(QIcon(qti_icon_FIND_16x16),tr("Find"),this);
+    d->actionFindItem = new QAction(qti_private_sharedActionIcon(qti_icon_FIND_16x16),tr("Find"),this);
     d->actionFindItem->setShortcut(QKeySequence(QKeySequence::Find));
     connect(d->actionFindItem,SIGNAL(triggered()),SLOT(toggleSearchBox()));
     command = ACTION_MANAGER->registerAction(qti_action_EDIT_FIND,d->actionFindItem,context);
     d->action_provider->addAction(d->actionFindItem,QtilitiesCategory(tr("View")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_EDIT_FIND,command,item_views_category);
+    // ---------------------------
+    // Undo
+    // ---------------------------
+    d->actionUndo = new QAction(qti_private_sharedActionIcon(qti_icon_EDIT_UNDO_16x16),tr("Undo"),this);
+    d->actionUndo->setShortcut(QKeySequence(QKeySequence::Undo));
+    connect(d->actionUndo,SIGNAL(triggered()),SLOT(undo()));
+    command = ACTION_MANAGER->registerAction(qti_action_EDIT_UNDO,d->actionUndo,context);
+    d->action_provider->addAction(d->actionUndo,QtilitiesCategory(tr("Items")));
+    qti_private_setCommandCategory(qti_action_EDIT_UNDO,command,item_views_category);
+    // ---------------------------
+    // Redo
+    // ---------------------------
+    d->actionRedo = new QAction(qti_private_sharedActionIcon(qti_icon_EDIT_REDO_16x16),tr("Redo"),this);
+    d->actionRedo->setShortcut(QKeySequence(QKeySequence::Redo));
+    connect(d->actionRedo,SIGNAL(triggered()),SLOT(redo()));
+    command = ACTION_MANAGER->registerAction(qti_action_EDIT_REDO,d->actionRedo,context);
+    d->action_provider->addAction(d->actionRedo,QtilitiesCategory(tr("Items")));
+    qti_private_setCommandCategory(qti_action_EDIT_REDO,command,item_views_category);
+    refreshUndoActions();
     // ---------------------------
     // Go To Parent
     // ---------------------------
-    d->actionPushUp = new QAction(QIcon(qti_icon_PUSH_UP_CURRENT_16x16),tr("Go To Parent"),this);
+    d->actionPushUp = new QAction(qti_private_sharedActionIcon(qti_icon_PUSH_UP_CURRENT_16x16),tr("Go To Parent"),this);
     d->actionPushUp->setShortcut(QKeySequence("Left"));
     connect(d->actionPushUp,SIGNAL(triggered()),SLOT(selectionPushUp()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_HIERARCHY_UP,d->actionPushUp,context);
     d->action_provider->addAction(d->actionPushUp,QtilitiesCategory(tr("Hierarchy")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_HIERARCHY_UP,command,item_views_category);
     // ---------------------------
     // Go To Parent In New Window
     // ---------------------------
-    d->actionPushUpNew = new QAction(QIcon(qti_icon_PUSH_UP_NEW_16x16),tr("Go To Parent (New Window)"),this);
+    d->actionPushUpNew = new QAction(qti_private_sharedActionIcon(qti_icon_PUSH_UP_NEW_16x16),tr("Go To Parent (New Window)"),this);
     connect(d->actionPushUpNew,SIGNAL(triggered()),SLOT(selectionPushUpNew()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_HIERARCHY_UP_NEW,d->actionPushUpNew,context);
     d->action_provider->addAction(d->actionPushUpNew,QtilitiesCategory(tr("Hierarchy")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_HIERARCHY_UP_NEW,command,item_views_category);
     // ---------------------------
     // Push Down
     // ---------------------------
-    d->actionPushDown = new QAction(QIcon(qti_icon_PUSH_DOWN_CURRENT_16x16),tr("Push Down"),this);
+    d->actionPushDown = new QAction(qti_private_sharedActionIcon(qti_icon_PUSH_DOWN_CURRENT_16x16),tr("Push Down"),this);
     d->actionPushDown->setShortcut(QKeySequence("Right"));
     connect(d->actionPushDown,SIGNAL(triggered()),SLOT(selectionPushDown()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_HIERARCHY_DOWN,d->actionPushDown,context);
     d->action_provider->addAction(d->actionPushDown,QtilitiesCategory(tr("Hierarchy")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_HIERARCHY_DOWN,command,item_views_category);
     // ---------------------------
     // Push Down In New Window
     // ---------------------------
-    d->actionPushDownNew = new QAction(QIcon(qti_icon_PUSH_DOWN_NEW_16x16),tr("Push Down (New Window)"),this);
+    d->actionPushDownNew = new QAction(qti_private_sharedActionIcon(qti_icon_PUSH_DOWN_NEW_16x16),tr("Push Down (New Window)"),this);
     connect(d->actionPushDownNew,SIGNAL(triggered()),SLOT(selectionPushDownNew()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_HIERARCHY_DOWN_NEW,d->actionPushDownNew,context);
     d->action_provider->addAction(d->actionPushDownNew,QtilitiesCategory(tr("Hierarchy")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_HIERARCHY_DOWN_NEW,command,item_views_category);
     // ---------------------------
     // Expand All
     // ---------------------------
-    d->actionExpandAll = new QAction(QIcon(qti_icon_MAGNIFY_PLUS_16x16),tr("Expand All"),this);
+    d->actionExpandAll = new QAction(qti_private_sharedActionIcon(qti_icon_MAGNIFY_PLUS_16x16),tr("Expand All"),this);
     d->actionExpandAll->setShortcut(QKeySequence("Ctrl+>"));
     connect(d->actionExpandAll,SIGNAL(triggered()),SLOT(viewExpandAll()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_HIERARCHY_EXPAND,d->actionExpandAll,context);
     d->action_provider->addAction(d->actionExpandAll,QtilitiesCategory(tr("Hierarchy")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_HIERARCHY_EXPAND,command,item_views_category);
     // ---------------------------
     // Collapse All
     // ---------------------------
-    d->actionCollapseAll = new QAction(QIcon(qti_icon_MAGNIFY_MINUS_16x16),tr("Collapse All"),this);
+    d->actionCollapseAll = new QAction(qti_private_sharedActionIcon(qti_icon_MAGNIFY_MINUS_16x16),tr("Collapse All"),this);
     d->actionCollapseAll->setShortcut(QKeySequence("Ctrl+<"));
     connect(d->actionCollapseAll,SIGNAL(triggered()),SLOT(viewCollapseAll()));
     command = ACTION_MANAGER->registerAction(qti_action_CONTEXT_HIERARCHY_COLLAPSE,d->actionCollapseAll,context);
     d->action_provider->addAction(d->actionCollapseAll,QtilitiesCategory(tr("Hierarchy")));
-    command->setCategory(item_views_category);
+    qti_private_setCommandCategory(qti_action_CONTEXT_HIERARCHY_COLLAPSE,command,item_views_category);
 
     #ifndef QT_NO_DEBUG
     // ---------------------------
     // Object Debug
     // ---------------------------
-    d->actionDebugObject = new QAction(QIcon(qti_icon_DEBUG_16x16),QString("Debug Object<br><br><span style=\"color: gray;\">Adds the selected object to your global object pool. If the debug plugin is loaded, you can inspect the object there.</span>"),this);
+    d->actionDebugObject = new QAction(qti_private_sharedActionIcon(qti_icon_DEBUG_16x16),QString("Debug Object<br><br><span style=\"color: gray;\">Adds the selected object to your global object pool. If the debug plugin is loaded, you can inspect the object there.</span>"),this);
     connect(d->actionDebugObject,SIGNAL(triggered()),SLOT(selectionDebug()));
     d->action_provider->addAction(d->actionDebugObject,QtilitiesCategory(tr("Items")));
     #endif
@@ -1790,6 +2169,15 @@ void Qtilities::CoreGui::ObserverWidget::refreshActions() {
     if (!d->actions_constructed)
         return;
 
+    // Only update the actions when the inputs which determine their states changed:
+    watchActionStateSources();
+    ActionStateInputs inputs = currentActionStateInputs(this,d);
+    if (d->action_state_inputs_valid && inputs == d->action_state_inputs)
+        return;
+    bool hints_changed = !d->action_state_inputs_valid || !d->action_state_inputs.initialized || !inputs.hintsEqual(d->action_state_inputs);
+    d->action_state_inputs = inputs;
+    d->action_state_inputs_valid = true;
+
     if (!d->initialized && !d->actionRemoveItem) {
         if (d->actionCollapseAll)
             d->actionCollapseAll->setEnabled(false);
@@ -1861,68 +2249,70 @@ void Qtilities::CoreGui::ObserverWidget::refreshActions() {
     }
 
     // Ok, first we set only actions specified by the observer's action hints to be visible
-    if (activeHints()->actionHints() & ObserverHints::ActionRemoveItem)
-        d->actionRemoveItem->setVisible(true);
-    else
-        d->actionRemoveItem->setVisible(false);
+    if (hints_changed) {
+        if (activeHints()->actionHints() & ObserverHints::ActionRemoveItem)
+            d->actionRemoveItem->setVisible(true);
+        else
+            d->actionRemoveItem->setVisible(false);
 
-    if (activeHints()->actionHints() & ObserverHints::ActionRemoveAll)
-        d->actionRemoveAll->setVisible(true);
-    else
-        d->actionRemoveAll->setVisible(false);
+        if (activeHints()->actionHints() & ObserverHints::ActionRemoveAll)
+            d->actionRemoveAll->setVisible(true);
+        else
+            d->actionRemoveAll->setVisible(false);
 
-    if (activeHints()->actionHints() & ObserverHints::ActionDeleteItem)
-        d->actionDeleteItem->setVisible(true);
-    else
-        d->actionDeleteItem->setVisible(false);
+        if (activeHints()->actionHints() & ObserverHints::ActionDeleteItem)
+            d->actionDeleteItem->setVisible(true);
+        else
+            d->actionDeleteItem->setVisible(false);
 
-    if (activeHints()->actionHints() & ObserverHints::ActionDeleteAll)
-        d->actionDeleteAll->setVisible(true);
-    else
-        d->actionDeleteAll->setVisible(false);
+        if (activeHints()->actionHints() & ObserverHints::ActionDeleteAll)
+            d->actionDeleteAll->setVisible(true);
+        else
+            d->actionDeleteAll->setVisible(false);
 
-    if (activeHints()->actionHints() & ObserverHints::ActionPushDown) {
-        d->actionPushDown->setVisible(true);
-        connect(this,SIGNAL(doubleClickRequest(QObject*)),SLOT(selectionPushDown()),Qt::UniqueConnection);
-    } else {
-        d->actionPushDown->setVisible(false);
-        disconnect(this,SIGNAL(doubleClickRequest(QObject*)),this,SLOT(selectionPushDown()));
-    }
+        if (activeHints()->actionHints() & ObserverHints::ActionPushDown) {
+            d->actionPushDown->setVisible(true);
+            connect(this,SIGNAL(doubleClickRequest(QObject*)),SLOT(selectionPushDown()),Qt::UniqueConnection);
+        } else {
+            d->actionPushDown->setVisible(false);
+            disconnect(this,SIGNAL(doubleClickRequest(QObject*)),this,SLOT(selectionPushDown()));
+        }
 
-    if (activeHints()->actionHints() & ObserverHints::ActionPushDownNew)
-        d->actionPushDownNew->setVisible(true);
-    else
-        d->actionPushDownNew->setVisible(false);
+        if (activeHints()->actionHints() & ObserverHints::ActionPushDownNew)
+            d->actionPushDownNew->setVisible(true);
+        else
+            d->actionPushDownNew->setVisible(false);
 
-    if (activeHints()->actionHints() & ObserverHints::ActionPushUp)
-        d->actionPushUp->setVisible(true);
-    else
-        d->actionPushUp->setVisible(false);
+        if (activeHints()->actionHints() & ObserverHints::ActionPushUp)
+            d->actionPushUp->setVisible(true);
+        else
+            d->actionPushUp->setVisible(false);
 
-    if (activeHints()->actionHints() & ObserverHints::ActionPushUpNew)
-        d->actionPushUpNew->setVisible(true);
-    else
-        d->actionPushUpNew->setVisible(false);
+        if (activeHints()->actionHints() & ObserverHints::ActionPushUpNew)
+            d->actionPushUpNew->setVisible(true);
+        else
+            d->actionPushUpNew->setVisible(false);
 
-    if (activeHints()->actionHints() & ObserverHints::ActionNewItem)
-        d->actionNewItem->setVisible(true);
-    else
-        d->actionNewItem->setVisible(false);
+        if (activeHints()->actionHints() & ObserverHints::ActionNewItem)
+            d->actionNewItem->setVisible(true);
+        else
+            d->actionNewItem->setVisible(false);
 
-    if (activeHints()->actionHints() & ObserverHints::ActionRefreshView)
-        d->actionRefreshView->setVisible(true);
-    else
-        d->actionRefreshView->setVisible(false);
+        if (activeHints()->actionHints() & ObserverHints::ActionRefreshView)
+            d->actionRefreshView->setVisible(true);
+        else
+            d->actionRefreshView->setVisible(false);
 
-    if (activeHints()->actionHints() & ObserverHints::ActionSwitchView)
-        d->actionSwitchView->setVisible(true);
-    else
-        d->actionSwitchView->setVisible(false);
+        if (activeHints()->actionHints() & ObserverHints::ActionSwitchView)
+            d->actionSwitchView->setVisible(true);
+        else
+            d->actionSwitchView->setVisible(false);
 
-    if (activeHints()->actionHints() & ObserverHints::ActionFindItem)
-        d->actionFindItem->setVisible(true);
-    else
-        d->actionFindItem->setVisible(false);
+        if (activeHints()->actionHints() & ObserverHints::ActionFindItem)
+            d->actionFindItem->setVisible(true);
+        else
+            d->actionFindItem->setVisible(false);
+    }
 
     // Remove & Delete All Actions
     if (d->selection_parent_observer_context) {
@@ -1940,7 +2330,7 @@ void Qtilities::CoreGui::ObserverWidget::refreshActions() {
 
     // Navigating Up/Down Actions
     if (d->display_mode == TableView) {
-        d->actionSwitchView->setIcon(QIcon(qti_icon_TREE_16x16));
+        d->actionSwitchView->setIcon(qti_private_sharedActionIcon(qti_icon_TREE_16x16));
         if (d->navigation_stack.count() == 0) {
             d->actionPushUp->setEnabled(false);
             d->actionPushUpNew->setEnabled(false);
@@ -1974,7 +2364,7 @@ void Qtilities::CoreGui::ObserverWidget::refreshActions() {
         d->actionCollapseAll->setEnabled(d->is_expand_collapse_visible);
         d->actionExpandAll->setEnabled(d->is_expand_collapse_visible);
 
-        d->actionSwitchView->setIcon(QIcon(qti_icon_TABLE_16x16));
+        d->actionSwitchView->setIcon(qti_private_sharedActionIcon(qti_icon_TABLE_16x16));
         d->actionPushDown->setEnabled(false);
         d->actionPushUp->setEnabled(false);
         d->actionPushDownNew->setEnabled(false);
@@ -2268,6 +2658,39 @@ void Qtilities::CoreGui::ObserverWidget::refreshActions() {
     }
 }
 
+void Qtilities::CoreGui::ObserverWidget::invalidateActionStates() {
+    d->action_state_inputs_valid = false;
+}
+
+void Qtilities::CoreGui::ObserverWidget::watchActionStateSources() {
+    // The observer context is watched in setObserverContext(), here the selected observer and the active hints are watched:
+    Observer* selected_observer = 0;
+    if (d->current_selection.count() == 1)
+        selected_observer = qobject_cast<Observer*> (d->current_selection.front());
+
+    if (d->action_state_observer && d->action_state_observer != selected_observer && d->action_state_observer != d->selection_parent_observer_context) {
+        disconnect(d->action_state_observer,0,this,SLOT(invalidateActionStates()));
+        d->action_state_inputs_valid = false;
+    }
+    d->action_state_observer = selected_observer;
+    // Connections are made every time, since setObserverContext() disconnects all connections of the previous context, which might be the selected observer:
+    if (selected_observer) {
+        connect(selected_observer,SIGNAL(dataChanged(Observer*)),SLOT(invalidateActionStates()),Qt::UniqueConnection);
+        connect(selected_observer,SIGNAL(layoutChanged(QList<QPointer<QObject> >)),SLOT(invalidateActionStates()),Qt::UniqueConnection);
+        if (selected_observer->displayHints())
+            connect(selected_observer->displayHints(),SIGNAL(modificationStateChanged(bool)),SLOT(invalidateActionStates()),Qt::UniqueConnection);
+    }
+
+    ObserverHints* hints = activeHints();
+    if (d->action_state_hints && d->action_state_hints != hints) {
+        disconnect(d->action_state_hints,0,this,SLOT(invalidateActionStates()));
+        d->action_state_inputs_valid = false;
+    }
+    d->action_state_hints = hints;
+    if (hints)
+        connect(hints,SIGNAL(modificationStateChanged(bool)),SLOT(invalidateActionStates()),Qt::UniqueConnection);
+}
+
 void Qtilities::CoreGui::ObserverWidget::setTreeSelectionParent(Observer* observer) {
     // This function will only be entered in TreeView mode.
     // It is a slot connected to the selection parent changed signal in the tree model.
@@ -2329,7 +2752,10 @@ void Qtilities::CoreGui::ObserverWidget::setTreeSelectionParent(Observer* observ
             d->disable_view_selection_update_from_activity_filter = current_disable_view_selection_update_from_activity_filter;
         }
 
-        emit selectedObjectsChanged(selectedObjects(),observer);
+        QList<QObject*> object_list = selectedObjects();
+        d->selection_extracted = true;
+        emit selectedObjectsChanged(object_list,observer);
+        d->selection_extracted = false;
         d->tree_name_column_delegate->setObserverContext(observer);
 
         #ifdef QTILITIES_PROPERTY_BROWSER
@@ -2543,7 +2969,9 @@ void Qtilities::CoreGui::ObserverWidget::selectionRemoveItems(bool delete_items)
                     }
 
                     d->selection_parent_observer_context->endTreeProcessingCycle(false);
-                    d->selection_parent_observer_context->refreshViewsLayout();
+                    // The layout must be refreshed before the objects can be selected, also when the observer coalesces view refreshes:
+                    const bool force_refresh = !d->selection_parent_observer_context->isProcessingCycleActive();
+                    d->selection_parent_observer_context->refreshViewsLayout(QList<QPointer<QObject> >(),force_refresh);
                     selectObjects(object_list);
                 }
             }
@@ -2663,7 +3091,7 @@ void Qtilities::CoreGui::ObserverWidget::selectionDelete() {
         }
     }
 
-    QApplication::processEvents();
+    IDLE_SCHEDULER->yieldToEventLoop();
     selectionRemoveItems(true);
 }
 
@@ -2688,7 +3116,7 @@ void Qtilities::CoreGui::ObserverWidget::selectionDeleteAll() {
         }
     }
 
-    QApplication::processEvents();
+    IDLE_SCHEDULER->yieldToEventLoop();
     selectionRemoveAll(true);
 }
 
@@ -2754,7 +3182,7 @@ void Qtilities::CoreGui::ObserverWidget::refresh() {
 
     // Call selectedObjects() in order to update internal d->current_selection.
     QList<QObject*> previous_selection = selectedObjects();
-    QApplication::processEvents();
+    IDLE_SCHEDULER->yieldToEventLoop();
 
     // Call refresh on the applicable model:
     if (displayMode() == Qtilities::TreeView && d->tree_model)
@@ -3154,12 +3582,9 @@ void Qtilities::CoreGui::ObserverWidget::handle_actionPaste_triggered() {
                     OBJECT_MANAGER->moveSubjects(observer_mime_data->subjectList(),observer_mime_data->sourceID(),d->selection_parent_observer_context->observerID());
                     CLIPBOARD_MANAGER->acceptMimeData();
                 } else if (CLIPBOARD_MANAGER->clipboardOrigin() == IClipboard::CopyAction) {
-                    // Attempt to copy the objects:
+                    // Attempt to copy the objects, all objects are attached in one go.
                     // For now we discard objects that cause problems during attachment and detachment:
-                    for (int i = 0; i < observer_mime_data->subjectList().count(); ++i) {
-                        // Attach to destination
-                        d->selection_parent_observer_context->attachSubject(observer_mime_data->subjectList().at(i));
-                    }
+                    d->selection_parent_observer_context->attachSubjects(const_cast<ObserverMimeData*> (observer_mime_data));
                     CLIPBOARD_MANAGER->acceptMimeData();
                 }
             } else {
@@ -3180,6 +3605,30 @@ void Qtilities::CoreGui::ObserverWidget::handle_actionPaste_triggered() {
                       break;
                 }
             }
+        } else if (QApplication::clipboard()->mimeData() && QApplication::clipboard()->mimeData()->hasFormat(qti_def_OBSERVER_MIME_DATA_EXPORT_MIME_TYPE)) {
+            // Subjects copied in another application are constructed from their export and attached in one go:
+            QList<QObject*> imported_subjects;
+            bool imported = ObserverMimeData::importSubjects(QApplication::clipboard()->mimeData(),imported_subjects);
+            QList<QPointer<QObject> > attached_list;
+            if (imported)
+                attached_list = d->selection_parent_observer_context->attachSubjects(imported_subjects,Observer::ObserverScopeOwnership,&error_msg);
+
+            // Subjects which were not attached are not owned by any observer:
+            QSet<QObject*> attached_subjects = ObjectManager::convSafeObjectsToNormal(attached_list).toSet();
+            for (int i = 0; i < imported_subjects.count(); ++i) {
+                if (!attached_subjects.contains(imported_subjects.at(i)))
+                    delete imported_subjects.at(i);
+            }
+
+            if (!imported || attached_subjects.count() != imported_subjects.count()) {
+                QMessageBox msgBox;
+                msgBox.setText(tr("Paste Operation Failed."));
+                if (imported)
+                    msgBox.setInformativeText(tr("The paste operation could not be completed. The destination observer could not accept all the objects in your selection.\n\nError message: ") + error_msg);
+                else
+                    msgBox.setInformativeText(tr("The paste operation could not be completed. The objects copied in another application could not be constructed in this application."));
+                msgBox.exec();
+            }
         } else {
             QMessageBox msgBox;
             msgBox.setText(tr("Paste Operation Failed."));
@@ -3267,7 +3716,7 @@ void Qtilities::CoreGui::ObserverWidget::toggleSearchBox() {
             setSearchBoxCheckedItemFilters(d->search_item_filter_flags);
         }
         connect(d->searchBoxWidget,SIGNAL(searchOptionsChanged()),SLOT(handleSearchOptionsChanged()));
-        connect(d->searchBoxWidget,SIGNAL(searchStringChanged(QString)),SLOT(handleSearchStringChanged(QString)));
+        connect(d->searchBoxWidget,SIGNAL(searchStringChanged(QString)),SLOT(scheduleSearchStringChanged(QString)));
     }
 
     if (!ui->widgetSearchBox->isVisible()) {
@@ -3332,12 +3781,19 @@ void Qtilities::CoreGui::ObserverWidget::handleSelectionModelChange() {
     // The selectedObjects() function will set d->current_selection. Thus use this
     // member of the d pointer inside functions in this class since it is much faster
     // than to calculate the selected objects every time we need them.
-    QList<QObject*> object_list = selectedObjects();     
+    QList<QObject*> object_list = selectedObjects();
 
     // IMPORTANT: In TreeView, the selection parent might have changed, resulting in
     //            initialize() being called to init hints for new parent. Therefore we
     //            only refresh actions, property browser etc here in TableView mode.
     if (d->display_mode == TableView && d->table_view) {
+        // Selection changes which do not change the selected objects, for example when extending the selection to more
+        // columns of the same rows, are not passed on:
+        if (d->selection_notified && d->notified_selection_handles == d->current_selection_handles)
+            return;
+        d->notified_selection_handles = d->current_selection_handles;
+        d->selection_notified = true;
+
         // Only refresh the property browser in table view mode here. In tree view mode it is refreshed in
         // the setTreeSelectionParent slot.
         #ifdef QTILITIES_PROPERTY_BROWSER
@@ -3356,6 +3812,8 @@ void Qtilities::CoreGui::ObserverWidget::handleSelectionModelChange() {
                     disconnect(d->table_view->selectionModel(),SIGNAL(selectionChanged(QItemSelection,QItemSelection)),this,SLOT(handleSelectionModelChange()));
                     selectObjects(d->activity_filter->activeSubjects());
                     connect(d->table_view->selectionModel(),SIGNAL(selectionChanged(QItemSelection,QItemSelection)),this,SLOT(handleSelectionModelChange()));
+                    // The rejected selection must be handled again when it is selected again:
+                    d->selection_notified = false;
                 }
                 d->disable_view_selection_update_from_activity_filter = false;
             }
@@ -3402,7 +3860,9 @@ void Qtilities::CoreGui::ObserverWidget::handleSelectionModelChange() {
         if (usesObserverHints())
             refreshActionToolBar();
 
+        d->selection_extracted = true;
         emit selectedObjectsChanged(object_list, d->selection_parent_observer_context);
+        d->selection_extracted = false;
     } else if (d->display_mode == TreeView && d->tree_model) {
         // Set the selection parent in the tree:
         // Note: The above line will cause setTreeSelectionParent() to be called.
@@ -3436,13 +3896,16 @@ void Qtilities::CoreGui::ObserverWidget::updateGlobalActiveSubjects() {
         else
             global_activity_meta_type = d->shared_global_meta_type;
 
-        // Update the global active object type
-        if (selectedObjects().count() == 0) {
+        // Update the global active object type. The handle list is shared with the object manager, and is only extracted
+        // again when this is not called for a selection which was just extracted:
+        if (!d->selection_extracted)
+            selectedObjects();
+        if (d->current_selection_handles.isEmpty()) {
             QList<QObject*> this_list;
             this_list << d->selection_parent_observer_context;
             OBJECT_MANAGER->setMetaTypeActiveObjects(this_list, global_activity_meta_type);
         } else
-            OBJECT_MANAGER->setMetaTypeActiveObjects(d->current_selection, global_activity_meta_type);
+            OBJECT_MANAGER->setMetaTypeActiveObjects(d->current_selection_handles, global_activity_meta_type);
     }
 }
 
@@ -3535,6 +3998,8 @@ void Qtilities::CoreGui::ObserverWidget::selectObject(QObject* object) {
 }
 
 void Qtilities::CoreGui::ObserverWidget::selectCategories(QList<QtilitiesCategory> categories) {
+    flushSuspendedModelChanges();
+
     if (categories.count() > 0) {
         // Handle for the table view
         if (d->tree_view && d->tree_model && d->display_mode == TreeView) {
@@ -3570,7 +4035,7 @@ void Qtilities::CoreGui::ObserverWidget::selectCategories(QList<QtilitiesCategor
                     d->tree_view->setCurrentIndex(mapped_indexes.front());
 
                 selectedObjects();
-                QApplication::processEvents();
+                IDLE_SCHEDULER->yieldToEventLoop();
             }
 
             // Update the property browser:
@@ -3591,13 +4056,20 @@ void Qtilities::CoreGui::ObserverWidget::selectCategory(QtilitiesCategory catego
 void Qtilities::CoreGui::ObserverWidget::clearSelection() {
     selectObjects(QList<QObject*>());
     d->current_selection.clear();
+    d->current_selection_handles = ObjectHandleList();
 }
 
 void Qtilities::CoreGui::ObserverWidget::selectObjects(QList<QPointer<QObject> > objects) {
     selectObjects(ObjectManager::convSafeObjectsToNormal(objects));
 }
 
+void Qtilities::CoreGui::ObserverWidget::selectObjects(const ObjectHandleList& objects) {
+    selectObjects(objects.objects());
+}
+
 void Qtilities::CoreGui::ObserverWidget::selectObjects(QList<QObject*> objects) {
+    flushSuspendedModelChanges();
+
     // Handle for the table view
     if (d->table_view && d->table_model && d->display_mode == TableView) {
         if (!d->table_view->selectionModel())
@@ -3705,6 +4177,26 @@ void Qtilities::CoreGui::ObserverWidget::handleSearchStringChanged(const QString
     if (proxyModel())
          model = qobject_cast<QSortFilterProxyModel*> (proxyModel());
 
+    // Any pending search box change is replaced by this string:
+    d->search_timer.stop();
+
+    // Trees are searched in a worker thread by the proxy, thus the GUI is not blocked:
+    ObserverTreeModelProxyFilter* tree_proxy = qobject_cast<ObserverTreeModelProxyFilter*> (model);
+    if (tree_proxy && d->display_mode == TreeView) {
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive;
+        QRegExp::PatternSyntax syntax = QRegExp::FixedString;
+        if (d->searchBoxWidget) {
+            caseSensitivity = d->searchBoxWidget->caseSensitive() ? Qt::CaseSensitive : Qt::CaseInsensitive;
+            syntax = d->searchBoxWidget->patternSyntax();
+        }
+
+        // Clear filters set by the table view code path, they would filter the rows on the GUI thread:
+        if (!tree_proxy->filterRegExp().isEmpty())
+            tree_proxy->setFilterRegExp(QString());
+        tree_proxy->setSearchExpression(QRegExp(filter_string,caseSensitivity,syntax));
+        return;
+    }
+
     // Check if the installed proxy model is a QSortFilterProxyModel:
     if (model) {
         d->current_cursor = cursor();
@@ -3728,6 +4220,15 @@ void Qtilities::CoreGui::ObserverWidget::handleSearchStringChanged(const QString
     }
 }
 
+void Qtilities::CoreGui::ObserverWidget::scheduleSearchStringChanged(const QString& filter_string) {
+    d->pending_search_string = filter_string;
+    d->search_timer.start();
+}
+
+void Qtilities::CoreGui::ObserverWidget::handleSearchTimerTimeout() {
+    handleSearchStringChanged(d->pending_search_string);
+}
+
 void Qtilities::CoreGui::ObserverWidget::resetProxyModel() {
     handleSearchStringChanged("");
 }
@@ -3775,7 +4276,7 @@ void Qtilities::CoreGui::ObserverWidget::handleTreeRebuildStarted() {
             }
 
             ui->widgetProgressInfo->show();
-            QApplication::processEvents();
+            IDLE_SCHEDULER->yieldToEventLoop();
         }
 
         emit treeModelBuildStarted();
@@ -3805,7 +4306,7 @@ void Qtilities::CoreGui::ObserverWidget::handleTreeRebuildCompleted(bool emit_tr
     if (emit_tree_build_completed)
         emit treeModelBuildEnded();
 
-    QApplication::processEvents();
+    IDLE_SCHEDULER->yieldToEventLoop();
 }
 
 void Qtilities::CoreGui::ObserverWidget::updateSelectionFromActivityFilter(QList<QObject *> objects) {
@@ -3827,7 +4328,15 @@ void Qtilities::CoreGui::ObserverWidget::resizeColumns() {
 
             QHeaderView* table_header = d->table_view->horizontalHeader();
             if (table_header) {
-                d->table_view->resizeColumnsToContents();
+                if (d->column_resize_mode == ColumnResizeAllRows) {
+                    d->table_view->resizeColumnsToContents();
+                } else {
+                    QModelIndexList rows = sampledResizeRows();
+                    for (int i = 0; i < table_header->count(); ++i) {
+                        if (!table_header->isSectionHidden(i))
+                            resizeColumnToSampledRows(i,rows,true);
+                    }
+                }
                 table_header->setStretchLastSection(true);
             }
 
@@ -3837,10 +4346,17 @@ void Qtilities::CoreGui::ObserverWidget::resizeColumns() {
         } else if (d->tree_view && d->tree_model && d->display_mode == Qtilities::TreeView) {
             QHeaderView* tree_header = d->tree_view->header();
             if (tree_header) {
+                QModelIndexList rows;
+                if (d->column_resize_mode == ColumnResizeSampledRows)
+                    rows = sampledResizeRows();
+
                 for (int i = 0; i < tree_header->count(); ++i) {
                     if (!tree_header->isSectionHidden(i)) {
                         int logical_index = tree_header->logicalIndex(i);
-                        d->tree_view->resizeColumnToContents(logical_index);
+                        if (d->column_resize_mode == ColumnResizeAllRows)
+                            d->tree_view->resizeColumnToContents(logical_index);
+                        else
+                            resizeColumnToSampledRows(logical_index,rows,true);
                     }
                 }
             }
@@ -3848,15 +4364,146 @@ void Qtilities::CoreGui::ObserverWidget::resizeColumns() {
     }
 }
 
+QModelIndexList Qtilities::CoreGui::ObserverWidget::sampledResizeRows() const {
+    QModelIndexList rows;
+    int sample_size = d->column_resize_sample_size;
+
+    if (d->display_mode == Qtilities::TableView && d->table_view && d->table_view->model()) {
+        QAbstractItemModel* model = d->table_view->model();
+        int row_count = model->rowCount();
+        if (row_count <= sample_size) {
+            for (int row = 0; row < row_count; ++row)
+                rows << model->index(row,0);
+            return rows;
+        }
+
+        // The visible rows:
+        int first_visible = d->table_view->rowAt(0);
+        int last_visible = d->table_view->rowAt(d->table_view->viewport()->height() - 1);
+        if (first_visible == -1)
+            first_visible = 0;
+        if (last_visible == -1)
+            last_visible = qMin(row_count - 1,first_visible + sample_size);
+        for (int row = first_visible; row <= last_visible; ++row)
+            rows << model->index(row,0);
+
+        // Rows spread evenly over the rest of the table:
+        int stride = row_count / qMax(1,sample_size);
+        for (int row = 0; row < row_count; row += stride) {
+            if (row < first_visible || row > last_visible)
+                rows << model->index(row,0);
+        }
+    } else if (d->display_mode == Qtilities::TreeView && d->tree_view && d->tree_view->model()) {
+        // The visible rows:
+        int viewport_height = d->tree_view->viewport()->height();
+        QModelIndex index = d->tree_view->indexAt(QPoint(0,0));
+        while (index.isValid() && d->tree_view->visualRect(index).top() < viewport_height) {
+            rows << index;
+            index = d->tree_view->indexBelow(index);
+        }
+
+        // Walking the expanded tree from the top is bounded by the sample size, thus deep trees are never walked completely:
+        index = d->tree_view->model()->index(0,0,d->tree_view->rootIndex());
+        int count = 0;
+        while (index.isValid() && count < sample_size) {
+            rows << index;
+            index = d->tree_view->indexBelow(index);
+            ++count;
+        }
+    }
+
+    return rows;
+}
+
+int Qtilities::CoreGui::ObserverWidget::measuredColumnWidth(const QModelIndex& index) {
+    QAbstractItemView* item_view = view();
+    if (!item_view || !index.isValid())
+        return 0;
+
+    // Key on the source item, proxy indexes change whenever the proxy filters or sorts:
+    QModelIndex source_index = index;
+    QAbstractProxyModel* proxy = qobject_cast<QAbstractProxyModel*> (item_view->model());
+    if (proxy)
+        source_index = proxy->mapToSource(index);
+    quintptr item_key = source_index.internalId() ? source_index.internalId() : (quintptr) source_index.row();
+    QPair<int,quintptr> key(index.column(),item_key);
+
+    QString text = index.data(Qt::DisplayRole).toString();
+    QHash<QPair<int,quintptr>,QPair<QString,int> >::const_iterator itr = d->column_width_cache.constFind(key);
+    if (itr != d->column_width_cache.constEnd() && itr.value().first == text)
+        return itr.value().second;
+
+    QStyleOptionViewItem option;
+    option.font = item_view->font();
+    option.fontMetrics = item_view->fontMetrics();
+    option.decorationSize = item_view->iconSize().isValid() ? item_view->iconSize() : QSize(16,16);
+    int width = item_view->itemDelegate(index)->sizeHint(option,index).width();
+
+    // Items which are no longer shown are never removed, thus the cache is dropped when it grows well beyond the number of measured rows:
+    if (d->column_width_cache.count() > 16 * (d->column_resize_sample_size + 100))
+        d->column_width_cache.clear();
+    d->column_width_cache[key] = QPair<QString,int>(text,width);
+    return width;
+}
+
+void Qtilities::CoreGui::ObserverWidget::resizeColumnToSampledRows(int column, const QModelIndexList& rows, bool shrink) {
+    QHeaderView* header = 0;
+    if (d->display_mode == Qtilities::TableView && d->table_view)
+        header = d->table_view->horizontalHeader();
+    else if (d->display_mode == Qtilities::TreeView && d->tree_view)
+        header = d->tree_view->header();
+    if (!header)
+        return;
+
+    // The tree decorations are drawn in the first visual column:
+    bool indented = d->display_mode == Qtilities::TreeView && header->logicalIndex(0) == column;
+
+    int width = shrink ? header->sectionSizeHint(column) : header->sectionSize(column);
+    foreach (const QModelIndex& row_index, rows) {
+        QModelIndex index = row_index.sibling(row_index.row(),column);
+        if (!index.isValid())
+            continue;
+
+        int index_width = measuredColumnWidth(index);
+        if (indented) {
+            int depth = d->tree_view->rootIsDecorated() ? 1 : 0;
+            for (QModelIndex parent = index.parent(); parent.isValid() && parent != d->tree_view->rootIndex(); parent = parent.parent())
+                ++depth;
+            index_width += depth * d->tree_view->indentation();
+        }
+        width = qMax(width,index_width);
+    }
+
+    if (width != header->sectionSize(column))
+        header->resizeSection(column,width);
+}
+
 void Qtilities::CoreGui::ObserverWidget::adaptColumns(const QModelIndex & topleft, const QModelIndex& bottomRight) {
     if (d->do_column_resizing) {
         if (d->tree_view && d->tree_model && d->display_mode == Qtilities::TreeView) {
-            int firstColumn= topleft.column();
-            int lastColumn = bottomRight.column();
-            do {
-                d->tree_view->resizeColumnToContents(firstColumn);
-                firstColumn++;
-            } while (firstColumn < lastColumn);
+            if (d->column_resize_mode == ColumnResizeAllRows) {
+                for (int column = topleft.column(); column <= bottomRight.column(); ++column)
+                    d->tree_view->resizeColumnToContents(column);
+                return;
+            }
+
+            // Only the changed rows are measured, columns only grow to fit them:
+            QModelIndexList rows;
+            QAbstractProxyModel* proxy = qobject_cast<QAbstractProxyModel*> (d->tree_view->model());
+            for (int row = topleft.row(); row <= bottomRight.row(); ++row) {
+                QModelIndex index = d->tree_model->index(row,0,topleft.parent());
+                if (proxy)
+                    index = proxy->mapFromSource(index);
+                if (index.isValid())
+                    rows << index;
+            }
+
+            if (!rows.isEmpty()) {
+                for (int column = topleft.column(); column <= bottomRight.column(); ++column) {
+                    if (!d->tree_view->header()->isSectionHidden(column))
+                        resizeColumnToSampledRows(column,rows,false);
+                }
+            }
         }
     }
 }
@@ -3889,6 +4536,14 @@ void Qtilities::CoreGui::ObserverWidget::handleCollapsed(const QModelIndex &inde
     updateLastExpandedResults(QModelIndex(),index);
     emit expandedNodesChanged(lastExpandedItemsResults());
     emit expandedObjectsChanged(lastExpandedObjectsResults());
+
+    // Large lazily built trees release the children of collapsed nodes:
+    if (d->tree_model && d->lazy_init) {
+        QModelIndex source_index = index;
+        if (proxyModel())
+            source_index = proxyModel()->mapToSource(index);
+        d->tree_model->releaseCollapsedChildren(source_index);
+    }
 }
 
 void Qtilities::CoreGui::ObserverWidget::expandNodes(const QStringList &node_names) {
@@ -4130,6 +4785,54 @@ void Qtilities::CoreGui::ObserverWidget::deleteActionToolBars() {
     }
 }
 
+void Qtilities::CoreGui::ObserverWidget::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+
+    // Catch up on the changes which were received while the widget was hidden:
+    if (d->model_updates_suspended) {
+        d->model_updates_suspended = false;
+        setModelUpdatesSuspended(false);
+    }
+
+    // Actions of widgets which were initialized while hidden are constructed when they are shown for the first time:
+    if (d->initialized && !d->actions_constructed && activeHints()->actionHints() != ObserverHints::ActionNoHints) {
+        constructActions();
+        refreshActionToolBar(true);
+    }
+}
+
+void Qtilities::CoreGui::ObserverWidget::hideEvent(QHideEvent* event) {
+    QWidget::hideEvent(event);
+
+    // Hidden widgets, for example in inactive modes, hidden dock widgets or collapsed side widgets, do not keep their models up to date.
+    // Widgets which were never shown are not suspended, thus they can still be initialized and used before they are shown:
+    if (d->initialized && !d->model_updates_suspended) {
+        d->model_updates_suspended = true;
+        setModelUpdatesSuspended(true);
+    }
+}
+
+void Qtilities::CoreGui::ObserverWidget::setModelUpdatesSuspended(bool suspended) {
+    if (d->table_model)
+        d->table_model->setUpdatesSuspended(suspended);
+    if (d->tree_model)
+        d->tree_model->setUpdatesSuspended(suspended);
+}
+
+void Qtilities::CoreGui::ObserverWidget::flushSuspendedModelChanges() {
+    if (!d->model_updates_suspended)
+        return;
+
+    if (d->table_model && d->table_model->pendingChanges() != AbstractObserverItemModel::NoPendingChanges) {
+        d->table_model->setUpdatesSuspended(false);
+        d->table_model->setUpdatesSuspended(true);
+    }
+    if (d->tree_model && d->tree_model->pendingChanges() != AbstractObserverItemModel::NoPendingChanges) {
+        d->tree_model->setUpdatesSuspended(false);
+        d->tree_model->setUpdatesSuspended(true);
+    }
+}
+
 void Qtilities::CoreGui::ObserverWidget::changeEvent(QEvent *e) {
     QWidget::changeEvent(e);
     switch (e->type()) {
@@ -4385,7 +5088,7 @@ bool Qtilities::CoreGui::ObserverWidget::eventFilter(QObject *object, QEvent *ev
     // -> TreeView Mode:
     // ----------------------------------------------
     if (d->tree_view && d->tree_model && d->display_mode == TreeView) {
-        if (object == d->tree_view && event->type() == QEvent::DragMove && !d->read_only) {
+        if ((object == d->tree_view || object == d->tree_view->viewport()) && event->type() == QEvent::DragMove && !d->read_only) {
             if (!(activeHints()->dragDropHint() & ObserverHints::AcceptDrops || activeHints()->categoryEditingFlags() & ObserverHints::CategoriesAcceptSubjectDrops))
                 return false;
 
@@ -4393,9 +5096,24 @@ bool Qtilities::CoreGui::ObserverWidget::eventFilter(QObject *object, QEvent *ev
             if (!(dragMoveEvent->mouseButtons() & d->button_copy || dragMoveEvent->mouseButtons() & d->button_move) || (dragMoveEvent->mouseButtons() == Qt::NoButton))
                 return false;
 
+            // Reject drops which the target observer won't accept. The model caches the evaluation per drag session and target observer:
+            QModelIndex drop_index = d->tree_view->indexAt(object == d->tree_view ? d->tree_view->viewport()->mapFrom(d->tree_view,dragMoveEvent->pos()) : dragMoveEvent->pos());
+            if (proxyModel())
+                drop_index = proxyModel()->mapToSource(drop_index);
+            if (d->tree_model->dropAcceptance(dragMoveEvent->mimeData(),drop_index) == Observer::Rejected) {
+                dragMoveEvent->ignore();
+                return true;
+            }
+
             dragMoveEvent->accept();
             return false;
+        } else if ((object == d->tree_view || object == d->tree_view->viewport()) && (event->type() == QEvent::DragLeave || event->type() == QEvent::Drop)) {
+            // The drag session ended:
+            d->tree_model->clearDropAcceptanceCache();
+            return false;
         } else if (object == d->tree_view && event->type() == QEvent::DragEnter && !d->read_only) {
+            // A new drag session starts:
+            d->tree_model->clearDropAcceptanceCache();
             if (!(activeHints()->dragDropHint() & ObserverHints::AcceptDrops || activeHints()->categoryEditingFlags() & ObserverHints::CategoriesAcceptSubjectDrops))
                 return false;
 
@@ -23,6 +23,7 @@
 
 #include <Observer.h>
 #include <ObserverHints.h>
+#include <ObserverUndoStack.h>
 #include <IContext.h>
 #include <Observer.h>
 
@@ -666,6 +667,15 @@ categorized_widget->show();
               \sa selectedObjectsChanged()
               */
             QList<QObject*> selectedObjects() const;
+            //! Provides handles to all the selected objects.
+            /*!
+              The handles are kept with the selection, thus passing them on does not copy the selection.
+
+              \sa selectedObjects(), Qtilities::Core::ObjectHandleList
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObjectHandleList selectedObjectHandles() const;
             //! Checks if all current selectedObjects() are in the same context.
             /*!
               \sa selectedObjectsChanged(), selectedObjects()
@@ -737,6 +747,51 @@ categorized_widget->show();
               \sa enableAutoColumnResizing()
               */
             void disableAutoColumnResizing();
+
+            //! The possible ways in which columns are sized to their contents when automatic column resizing is enabled.
+            /*!
+             * \sa setColumnResizeMode(), columnResizeMode(), enableAutoColumnResizing()
+             *
+             * <i>This enum was added in %Qtilities v1.5.</i>
+             */
+            enum ColumnResizeMode {
+                ColumnResizeAllRows,        /*!< Columns are sized to the widest of all rows in the view. Every resize measures every row, which is slow for large views. */
+                ColumnResizeSampledRows     /*!< Columns are sized to the widest of the visible rows and a bounded sample of the other rows in the view. The measured widths are cached per item and only remeasured when the text of the item changed. */
+            };
+            //! Sets the way in which columns are sized to their contents.
+            /*!
+             * \param column_resize_mode The column resize mode to use.
+             *
+             * \sa columnResizeMode(), setColumnResizeSampleSize()
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setColumnResizeMode(ColumnResizeMode column_resize_mode);
+            //! Gets the way in which columns are sized to their contents.
+            /*!
+             * The default is: ColumnResizeSampledRows
+             *
+             * \sa setColumnResizeMode()
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            ColumnResizeMode columnResizeMode() const;
+            //! Sets the number of rows, in addition to the visible rows, which are measured in ColumnResizeSampledRows mode.
+            /*!
+             * Views with fewer rows than \p sample_size are measured completely. The default is 500.
+             *
+             * \sa columnResizeSampleSize()
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setColumnResizeSampleSize(int sample_size);
+            //! Gets the number of rows, in addition to the visible rows, which are measured in ColumnResizeSampledRows mode.
+            /*!
+             * \sa setColumnResizeSampleSize()
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            int columnResizeSampleSize() const;
             //! Enables automatic selection and expansion in TreeView mode to restore the selection and expansion state of the tree after a refresh has occured.
             /*!
               True by default.
@@ -836,6 +891,13 @@ categorized_widget->show();
               \sa selectedObjectsChanged(), clearSelection(), selectObject()
               */
             void selectObjects(QList<QPointer<QObject> > objects);
+            //! Selects the objects referred to by the handles in \p objects in the active item view. Handles to destroyed objects are ignored.
+            /*!
+              \sa selectObjects(QList<QPointer<QObject> >), selectedObjectHandles()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void selectObjects(const ObjectHandleList& objects);
             //! Slot which resizes the rows in table view mode.
             /*!
               Slot which resizes the rows in table view mode.
@@ -969,9 +1031,37 @@ categorized_widget->show();
               - Hierarchy : Actions related observer tree hierarhcies.
 
               It is possible to add actions to these categories.
+
+              \note Widgets which are initialized while they are hidden only construct their actions when they are shown for the first time, or when this
+              function is called.
               */
             IActionProvider* actionProvider();
+            //! Sets the undo stack which is undone and redone by the Undo and Redo actions of this widget.
+            /*!
+              The Undo and Redo actions are only visible when the widget has an undo stack. The undo stack is not owned by the widget, and
+              can be shared between widgets which show the same tree. Pass 0 to remove the undo stack.
+
+              \sa undoStack(), undo(), redo()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setUndoStack(ObserverUndoStack* undo_stack);
+            //! Returns the undo stack of this widget, or 0 when it does not have an undo stack.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ObserverUndoStack* undoStack() const;
         public slots:
+            //! Undoes the last step on the undo stack of this widget.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void undo();
+            //! Redoes the next step on the undo stack of this widget.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void redo();
             //! Detaches the current selected objects in the item view from the current selection parent.
             /*!
               \sa selectionParent(), selectedObjects(), selectedObjectsChanged()
@@ -1078,6 +1168,10 @@ categorized_widget->show();
             //! Handles search options changes in the SearchBoxWidget if present.
             void handleSearchOptionsChanged();
             //! Handles search string changes in the SearchBoxWidget if present.
+            /*!
+              In Qtilities::TreeView mode the string is matched in a worker thread by ObserverTreeModelProxyFilter::setSearchExpression() when the tree proxy model
+              is an ObserverTreeModelProxyFilter, thus this function returns without filtering the tree.
+              */
             void handleSearchStringChanged(const QString& filter_string);
             //! Handle changes to the type of items which must be filtered.
             void handleSearchItemTypesChanged();
@@ -1087,6 +1181,26 @@ categorized_widget->show();
         private slots:
             //! Handle post layout changed actions in table view mode.
             void handleLayoutChangeCompleted();
+            //! Restarts the search box debounce timer with \p filter_string as the pending search string.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void scheduleSearchStringChanged(const QString& filter_string);
+            //! Calls handleSearchStringChanged() with the pending search string once the user stopped typing.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void handleSearchTimerTimeout();
+            //! Forces the next refreshActions() call to update the actions, even if the selection and hints did not change.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void invalidateActionStates();
+            //! Refreshes the state and text of the Undo and Redo actions.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void refreshUndoActions();
             //! This function is triggered by the Qtilities::Core::ObserverHints::ActionNewItem action.
             virtual void handle_actionNewItem_triggered();
             #ifndef QT_NO_DEBUG
@@ -1186,7 +1300,29 @@ categorized_widget->show();
             void refreshColumnVisibility();
             //! Disconnects the clipboard's copy and cut actions from this widget.
             void disconnectClipboard();
+            //! Returns the rows of the active view which are measured in ColumnResizeSampledRows mode: The visible rows and the sampled rows.
+            QModelIndexList sampledResizeRows() const;
+            //! Returns the width needed to show \p index in the active view, using the cached width when the text of the index did not change.
+            int measuredColumnWidth(const QModelIndex& index);
+            //! Resizes \p column of the active view to the widest of \p rows, never making it narrower than its header when \p shrink is true, or than its current size otherwise.
+            void resizeColumnToSampledRows(int column, const QModelIndexList& rows, bool shrink);
             void changeEvent(QEvent *e);
+            //! Constructs the actions of the widget when it is shown for the first time.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void showEvent(QShowEvent* event);
+            //! Suspends the updates of the models of the widget while it is hidden.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void hideEvent(QHideEvent* event);
+            //! Suspends or resumes the updates of the models of the widget, see AbstractObserverItemModel::setUpdatesSuspended().
+            void setModelUpdatesSuspended(bool suspended);
+            //! Applies the changes which the models received while the widget is hidden, for functions which need the models to be up to date.
+            void flushSuspendedModelChanges();
+            //! Connects invalidateActionStates() to the selected observer and the active hints, which refreshActions() reads beyond its cached inputs.
+            void watchActionStateSources();
 
             Ui::ObserverWidget *ui;
             ObserverWidgetData* d;
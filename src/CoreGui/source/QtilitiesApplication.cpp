@@ -53,7 +53,7 @@ Qtilities::CoreGui::QtilitiesApplication::QtilitiesApplication(int &argc, char *
         // Register QList<QPointer<QObject> > in Meta Object System.
         qRegisterMetaType<QList<QPointer<QObject> > >("QList<QPointer<QObject> >");
 
-        connect(OBJECT_MANAGER,SIGNAL(newObjectAdded(QObject*)),TaskManagerGui::instance(),SLOT(handleObjectPoolAddition(QObject*)));
+        OBJECT_MANAGER->subscribeToInterface<ITask>(TaskManagerGui::instance(),SLOT(handleObjectPoolAddition(QObject*)),0,false);
         connect(QtilitiesCoreApplicationPrivate::instance(),SIGNAL(busyStateChanged(bool)),this,SIGNAL(busyStateChanged(bool)));
 
         // Organization name not set here yet, thus we can't do this:
@@ -136,7 +136,7 @@ void Qtilities::CoreGui::QtilitiesApplication::initialize() {
     // Register QList<QPointer<QObject> > in Meta Object System.
     qRegisterMetaType<QList<QPointer<QObject> > >("QList<QPointer<QObject> >");
 
-    connect(OBJECT_MANAGER,SIGNAL(newObjectAdded(QObject*)),TaskManagerGui::instance(),SLOT(handleObjectPoolAddition(QObject*)));
+    OBJECT_MANAGER->subscribeToInterface<ITask>(TaskManagerGui::instance(),SLOT(handleObjectPoolAddition(QObject*)),0,false);
 }
 
 Qtilities::CoreGui::QtilitiesApplication* Qtilities::CoreGui::QtilitiesApplication::instance(bool silent) {
@@ -175,7 +175,7 @@ QtilitiesApplication::initialize();
               - Shortcut configurations. For more information see: Qtilities::CoreGui::Interfaces::IActionManager::saveShortcutMapping().
               - %Logging configurations. For more information see: Qtilities::Logging::Logger::saveSessionConfig().
               - Plugin configurations. For more information see: Qtilities::ExtensionSystem::ExtensionSystemCore::savePluginConfiguration().
-              - Internal settings saved by %Qtilities classes to a QSettings based ini file. See Qtilities::Core::QtilitiesCoreApplication::qtilitiesSettingsPath() for more information.
+              - Internal settings saved by %Qtilities classes to an ini file through a settings store. See Qtilities::Core::QtilitiesCoreApplication::qtilitiesSettings() for more information.
 
               For more information about the way %Qtilities saves session information see \ref configuration_widget_storage_layout.
 
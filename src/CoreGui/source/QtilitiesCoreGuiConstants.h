@@ -14,6 +14,8 @@
 
 #include "QtilitiesCoreGui_global.h"
 
+#include <QtilitiesCoreConstants>
+
 namespace Qtilities {
     //! The possible display modes of widgets containing observer widgets.
     /*!
@@ -45,10 +47,9 @@ namespace Qtilities {
         namespace Constants {
             //! %Factory tag for naming policy subject filters.
             const char * const qti_def_FACTORY_TAG_NAMING_FILTER     = "qti.def.FactoryTag.NamingFilter";
-            //! %Factory tag for tree nodes.
-            const char * const qti_def_FACTORY_TAG_TREE_NODE         = "qti.def.FactoryTag.TreeNode";
-            //! %Factory tag for tree items.
-            const char * const qti_def_FACTORY_TAG_TREE_ITEM         = "qti.def.FactoryTag.TreeItem";
+            // The tree node and tree item tags are shared with the headless tree types in the Core module:
+            using Qtilities::Core::Constants::qti_def_FACTORY_TAG_TREE_NODE;
+            using Qtilities::Core::Constants::qti_def_FACTORY_TAG_TREE_ITEM;
             //! %Factory tag for tree file items.
             const char * const qti_def_FACTORY_TAG_TREE_FILE_ITEM    = "qti.def.FactoryTag.TreeFileItem";
             //! The default file name used to save session shortcut mappings by the Qtilities::CoreGui::ActionManager class.
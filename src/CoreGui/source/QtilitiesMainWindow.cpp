@@ -16,14 +16,30 @@
 
 #include <QtilitiesCoreApplication>
 #include <QtilitiesApplication>
+#include <StartupProfiler>
 
 #include <QBoxLayout>
-#include <QSettings>
 #include <QLabel>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QElapsedTimer>
+
+namespace {
+    // Priority messages are shown at most once in this interval, roughly one frame:
+    const int qti_private_priority_message_frame_msecs = 16;
+
+    // Ranks the severities of priority messages, a message is not replaced by a message of a lower severity in the same frame.
+    int qti_private_prioritySeverity(Logger::MessageType message_type) {
+        if (message_type == Logger::Error || message_type == Logger::Fatal)
+            return 2;
+        else if (message_type == Logger::Warning)
+            return 1;
+        return 0;
+    }
+}
 
 using namespace Qtilities::Core;
+using namespace Qtilities::Logging;
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::CoreGui::Interfaces;
 using namespace Qtilities::CoreGui::Icons;
@@ -35,7 +51,9 @@ struct Qtilities::CoreGui::QtilitiesMainWindowPrivateData {
         priority_messages_enabled(true),
         task_summary_widget_visible(true),
         task_summary_widget(0),
-        last_restore_state_maximized(true) {}
+        last_restore_state_maximized(true),
+        pending_priority_message_type(Logger::Info),
+        shown_priority_icon(0) {}
 
     bool                            initialized;
     QPointer<QWidget>               current_widget;
@@ -52,11 +70,21 @@ struct Qtilities::CoreGui::QtilitiesMainWindowPrivateData {
     bool                            task_summary_widget_visible;
     QPointer<TaskSummaryWidget>     task_summary_widget;
     bool                            last_restore_state_maximized;
+
+    //! The latest priority message which was received since the status bar was updated.
+    QString                         pending_priority_message;
+    Logger::MessageType             pending_priority_message_type;
+    //! Shows the pending priority message when messages arrive faster than one per frame.
+    QTimer                          priority_message_frame_timer;
+    QElapsedTimer                   priority_message_shown_time;
+    //! The icon resource which is currently set on priority_messages_icon.
+    const char*                     shown_priority_icon;
 };
 
 Qtilities::CoreGui::QtilitiesMainWindow::QtilitiesMainWindow(ModeLayout modeLayout, QWidget *parent, Qt::WindowFlags flags) :
         QMainWindow(parent, flags), ui(new Ui::QtilitiesMainWindow)
 {
+    StartupProfileScope profile_scope("Main Window","Main Window Setup");
     ui->setupUi(this);
     d = new QtilitiesMainWindowPrivateData;
     d->mode_layout = modeLayout;
@@ -102,6 +130,10 @@ Qtilities::CoreGui::QtilitiesMainWindow::QtilitiesMainWindow(ModeLayout modeLayo
     connect(&d->priority_message_timer,SIGNAL(timeout()), &d->priority_messages_icon, SLOT(clear()));
     connect(&d->priority_message_timer,SIGNAL(timeout()), &d->priority_messages_icon, SLOT(hide()));
 
+    d->priority_message_frame_timer.setSingleShot(true);
+    d->priority_message_frame_timer.setInterval(qti_private_priority_message_frame_msecs);
+    connect(&d->priority_message_frame_timer,SIGNAL(timeout()),SLOT(showPendingPriorityMessage()));
+
     doLayout();
 
     installEventFilter(this);
@@ -124,31 +156,21 @@ void Qtilities::CoreGui::QtilitiesMainWindow::writeSettings(const QString &gui_i
     if (!QtilitiesCoreApplication::qtilitiesSettingsEnabled())
         return;
 
-    QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("GUI");
-    settings.beginGroup(gui_id);
-    settings.setValue("size", size());
-    settings.setValue("pos", pos());
-    settings.setValue("state", saveState());
-    settings.setValue("maximized", isMaximized());
-    settings.endGroup();
-    settings.endGroup();
-    settings.endGroup();
+    const QString group = QString("Qtilities/GUI/%1/").arg(gui_id);
+    SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+    settings->setValue(group + "size", size());
+    settings->setValue(group + "pos", pos());
+    settings->setValue(group + "state", saveState());
+    settings->setValue(group + "maximized", isMaximized());
 }
 
 void Qtilities::CoreGui::QtilitiesMainWindow::readSettings(const QString &gui_id) {
-    QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("GUI");
-    settings.beginGroup(gui_id);
-    resize(settings.value("size", QSize(1000, 1000)).toSize());
-    move(settings.value("pos", QPoint(200, 200)).toPoint());
-    restoreState(settings.value("state").toByteArray());
-    d->last_restore_state_maximized = settings.value("maximized",false).toBool();
-    settings.endGroup();
-    settings.endGroup();
-    settings.endGroup();
+    const QString group = QString("Qtilities/GUI/%1/").arg(gui_id);
+    SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+    resize(settings->value(group + "size", QSize(1000, 1000)).toSize());
+    move(settings->value(group + "pos", QPoint(200, 200)).toPoint());
+    restoreState(settings->value(group + "state").toByteArray());
+    d->last_restore_state_maximized = settings->valueAs<bool>(group + "maximized",false);
 }
 
 bool Qtilities::CoreGui::QtilitiesMainWindow::lastReadSettingsIsMaximized() const {
@@ -365,33 +387,52 @@ void Qtilities::CoreGui::QtilitiesMainWindow::changeCurrentWidget(QWidget* new_c
 }
 
 void Qtilities::CoreGui::QtilitiesMainWindow::processPriorityMessage(Logger::MessageType message_type, const QString& message) {
-    QApplication::processEvents();
-
-    if (message.isEmpty())
+    if (message.isEmpty() || !d->priority_messages_enabled)
         return;
 
-    if (d->priority_messages_enabled) {
-        d->priority_messages_text.setVisible(true);
-        if (message_type == Logger::Warning) {
-            d->priority_messages_icon.setPixmap(QIcon(qti_icon_WARNING_12x12).pixmap(12));
-            d->priority_messages_icon.setVisible(true);
-        } else if (message_type == Logger::Error || message_type == Logger::Fatal) {
-            d->priority_messages_icon.setPixmap(QIcon(qti_icon_ERROR_12x12).pixmap(12));
-            d->priority_messages_icon.setVisible(true);
-        } else {
-            if (message.startsWith(tr("Successfully")))
-                d->priority_messages_icon.setPixmap(QIcon(qti_icon_SUCCESS_12x12).pixmap(12));
-            else
-                d->priority_messages_icon.setPixmap(QIcon(qti_icon_INFO_12x12).pixmap(12));
-            d->priority_messages_icon.setVisible(true);
-        }
+    // Messages received in the same frame are coalesced: The latest message is kept, unless it is less severe than the pending message:
+    if (d->pending_priority_message.isEmpty() || qti_private_prioritySeverity(message_type) >= qti_private_prioritySeverity(d->pending_priority_message_type)) {
+        d->pending_priority_message = message;
+        d->pending_priority_message_type = message_type;
+    }
 
+    if (!d->priority_message_shown_time.isValid() || d->priority_message_shown_time.elapsed() >= qti_private_priority_message_frame_msecs) {
+        // Tasks which log priority messages while blocking the event loop still see their progress once per frame:
+        showPendingPriorityMessage();
         QApplication::processEvents();
-        d->priority_messages_text.setText(message);
-        QApplication::processEvents();
-        d->priority_message_timer.start(5000);
+    } else if (!d->priority_message_frame_timer.isActive()) {
+        d->priority_message_frame_timer.start();
+    }
+}
+
+void Qtilities::CoreGui::QtilitiesMainWindow::showPendingPriorityMessage() {
+    d->priority_message_frame_timer.stop();
+    if (d->pending_priority_message.isEmpty())
+        return;
+
+    const QString message = d->pending_priority_message;
+    const Logger::MessageType message_type = d->pending_priority_message_type;
+    d->pending_priority_message.clear();
+    d->priority_message_shown_time.start();
+
+    const char* icon = qti_icon_INFO_12x12;
+    if (message_type == Logger::Warning)
+        icon = qti_icon_WARNING_12x12;
+    else if (message_type == Logger::Error || message_type == Logger::Fatal)
+        icon = qti_icon_ERROR_12x12;
+    else if (message.startsWith(tr("Successfully")))
+        icon = qti_icon_SUCCESS_12x12;
+
+    // Only changes are applied, thus consecutive messages of the same severity only update the text. The icon is cleared when the message times out:
+    if (icon != d->shown_priority_icon || d->priority_messages_icon.isHidden()) {
+        d->priority_messages_icon.setPixmap(QIcon(icon).pixmap(12));
+        d->shown_priority_icon = icon;
     }
-    QApplication::processEvents();
+    d->priority_messages_icon.setVisible(true);
+    if (d->priority_messages_text.text() != message)
+        d->priority_messages_text.setText(message);
+    d->priority_messages_text.setVisible(true);
+    d->priority_message_timer.start(5000);
 }
 
 bool Qtilities::CoreGui::QtilitiesMainWindow::eventFilter(QObject *object, QEvent *event) {
@@ -238,9 +238,18 @@ int main(int argc, char *argv[])
 
         public slots:
             //! Slot which received incomming priority messages from the %Qtilities logger.
+            /*!
+              The status bar is updated at most once per frame. Messages which are received faster are coalesced: only the latest message
+              is shown, unless a more severe message was received in the same frame, in which case the most severe message is shown. Consecutive
+              messages of the same severity only update the text of the status bar.
+
+              \note Before %Qtilities v1.5 every message was shown immediately.
+              */
             void processPriorityMessage(Logger::MessageType message_type, const QString& message);
 
         private slots:
+            //! Shows the latest priority message which was coalesced by processPriorityMessage().
+            void showPendingPriorityMessage();
             //! The mode widget changes the central widget in the main window through this slot.
             void changeCurrentWidget(QWidget* new_central_widget);
             //! Updates sizes of itesm in the main windows when modes are added to the application:
@@ -15,10 +15,39 @@
 
 #include <QMenu>
 #include <QAction>
+#include <QTextCursor>
 
 using namespace Qtilities::CoreGui::Constants;
 using namespace Qtilities::CoreGui::Icons;
 
+namespace {
+    // Returns the positions of all occurrences of search_string in text, using the same matching rules as QTextDocument::find().
+    QList<int> qti_private_findAllOccurrences(const QString& text, const QString& search_string, QTextDocument::FindFlags find_flags) {
+        QList<int> positions;
+        if (search_string.isEmpty())
+            return positions;
+
+        Qt::CaseSensitivity case_sensitivity = (find_flags & QTextDocument::FindCaseSensitively) ? Qt::CaseSensitive : Qt::CaseInsensitive;
+        const int length = search_string.length();
+        int index = text.indexOf(search_string,0,case_sensitivity);
+        while (index != -1) {
+            bool match = true;
+            if (find_flags & QTextDocument::FindWholeWords) {
+                int end = index + length;
+                if ((index != 0 && text.at(index - 1).isLetterOrNumber()) || (end != text.length() && text.at(end).isLetterOrNumber()))
+                    match = false;
+            }
+
+            if (match) {
+                positions << index;
+                index = text.indexOf(search_string,index + length,case_sensitivity);
+            } else
+                index = text.indexOf(search_string,index + 1,case_sensitivity);
+        }
+        return positions;
+    }
+}
+
 namespace Qtilities {
 namespace CoreGui {
 
@@ -312,6 +341,8 @@ void SearchBoxWidget::setTextEditor(QTextEdit* textEdit) {
 
     if (d->textEdit)
         d->widget_target = SearchBoxWidget::TextEdit;
+    else if (d->widget_target == SearchBoxWidget::TextEdit)
+        d->widget_target = SearchBoxWidget::ExternalTarget;
 }
 
 QTextEdit* SearchBoxWidget::textEditor() const {
@@ -323,6 +354,8 @@ void SearchBoxWidget::setPlainTextEditor(QPlainTextEdit* plainTextEdit) {
 
     if (d->plainTextEdit) {
         d->widget_target = SearchBoxWidget::PlainTextEdit;
+    } else if (d->widget_target == SearchBoxWidget::PlainTextEdit) {
+        d->widget_target = SearchBoxWidget::ExternalTarget;
     }
 }
 
@@ -440,52 +473,33 @@ void SearchBoxWidget::handleReplacePrevious() {
 void SearchBoxWidget::handleReplaceAll() {
     if (d->widget_target == ExternalTarget)
         emit btnReplaceAll_clicked();
-    else if (d->widget_target == TextEdit && d->textEdit) {
-        int count = 0;
-
-        QTextCursor cursor = d->textEdit->textCursor();
-        int position = cursor.position();
-        cursor.setPosition(0);
-        cursor.beginEditBlock();
-
-        d->textEdit->setTextCursor(cursor);
-        d->textEdit->find(currentSearchString(),findFlags());
-        while (d->textEdit->textCursor().hasSelection()) {
-            d->textEdit->textCursor().insertText(ui->txtReplaceString->text());
-            ++count;
-            d->textEdit->find(currentSearchString(),findFlags());
-        }
-
-        cursor.endEditBlock();
-        cursor.setPosition(position);
-        d->textEdit->setTextCursor(cursor);
-
-        if (count == 1)
-            setMessage(QString("<font color='green'>Replaced 1 occurance.</font>"));
-        else if (count > 1)
-            setMessage(QString("<font color='green'>Replaced %1 occurances.</font>").arg(count));
-        else
-            setMessage(QString("<font color='orange'>No occurance of your search string was found.</font>"));
-    } else if (d->widget_target == PlainTextEdit && d->plainTextEdit) {
-        int count = 0;
-
-        QTextCursor cursor = d->plainTextEdit->textCursor();
-        int position = cursor.position();
-        cursor.setPosition(0);
-        cursor.beginEditBlock();
-
-        d->plainTextEdit->setTextCursor(cursor);
-        d->plainTextEdit->find(currentSearchString(),findFlags());
-        while (d->plainTextEdit->textCursor().hasSelection()) {
-            d->plainTextEdit->textCursor().insertText(ui->txtReplaceString->text());
-            ++count;
-            d->plainTextEdit->find(currentSearchString(),findFlags());
+    else if (d->widget_target == TextEdit || d->widget_target == PlainTextEdit) {
+        QTextDocument* document = 0;
+        if (d->widget_target == TextEdit && d->textEdit)
+            document = d->textEdit->document();
+        else if (d->widget_target == PlainTextEdit && d->plainTextEdit)
+            document = d->plainTextEdit->document();
+        if (!document)
+            return;
+
+        // Find all matches in a single pass over the text, then replace them back to front in one edit block.
+        // Replacing from the back keeps the positions of the matches in front of the current match valid,
+        // and the single edit block makes the complete replacement a single undo step:
+        QString search_string = currentSearchString();
+        QList<int> positions = qti_private_findAllOccurrences(document->toPlainText(),search_string,findFlags());
+        int count = positions.count();
+        if (count > 0) {
+            QString replace_string = ui->txtReplaceString->text();
+            QTextCursor cursor(document);
+            cursor.beginEditBlock();
+            for (int i = count - 1; i >= 0; --i) {
+                cursor.setPosition(positions.at(i));
+                cursor.setPosition(positions.at(i) + search_string.length(),QTextCursor::KeepAnchor);
+                cursor.insertText(replace_string);
+            }
+            cursor.endEditBlock();
         }
 
-        cursor.endEditBlock();
-        cursor.setPosition(position);
-        d->plainTextEdit->setTextCursor(cursor);
-
         if (count == 1)
             setMessage(QString("<font color='green'>Replaced 1 occurance.</font>"));
         else if (count > 1)
@@ -160,6 +160,8 @@ searchBoxWidget->setPlainTextEditor(myTextEdit);
               search box widget in this way, the buttons (except the HideButton) will not trigger their signals and the search string
               related signals will not trigger either. The widget will handle these buttons directly on the specified text edit.
 
+              Passing null while the text edit is the current target makes the widget use ExternalTarget again.
+
               \sa setPlainTextEditor();
               */
             void setTextEditor(QTextEdit* textEdit);
@@ -171,6 +173,8 @@ searchBoxWidget->setPlainTextEditor(myTextEdit);
               search box widget in this way, the buttons (except the HideButton) will not trigger their signals and the search string
               related signals will not trigger either. The widget will handle these buttons directly on the specified text edit.
 
+              Passing null while the plain text edit is the current target makes the widget use ExternalTarget again.
+
               \sa setTextEditor();
               */
             void setPlainTextEditor(QPlainTextEdit* plainTextEdit);
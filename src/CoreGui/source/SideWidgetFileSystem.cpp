@@ -12,11 +12,13 @@
 #include "SideWidgetFileSystem.h"
 #include "ui_SideWidgetFileSystem.h"
 #include "QtilitiesApplication"
+#include "FileSystemStatCache_p.h"
 
 #include <FileUtils>
 using namespace Qtilities::Core;
 
 #include <QFileSystemModel>
+#include <QFileIconProvider>
 #include <QTreeView>
 #include <QFileDialog>
 #include <QDir>
@@ -27,11 +29,54 @@ namespace Qtilities {
     }
 }
 
+namespace {
+    //! Icon provider which returns generic drive, folder and file icons.
+    /*!
+      The default provider queries the platform for the icon of every file, which is slow on network drives.
+      */
+    class GenericFileIconProvider : public QFileIconProvider {
+    public:
+        QIcon icon(IconType type) const {
+            return QFileIconProvider::icon(type);
+        }
+        QIcon icon(const QFileInfo& info) const {
+            if (info.isRoot())
+                return QFileIconProvider::icon(Drive);
+            if (info.isDir())
+                return QFileIconProvider::icon(Folder);
+            return QFileIconProvider::icon(File);
+        }
+    };
+
+    //! Sets up a file system model so that it does not query the file system for each file on the GUI thread.
+    /*!
+      QFileSystemModel enumerates directories and watches them for changes in its own thread. Resolving symbolic links and looking up
+      file specific icons are the remaining per file queries, thus these are disabled.
+      */
+    void configureFileSystemModel(QFileSystemModel* model, QFileIconProvider* icon_provider) {
+        model->setIconProvider(icon_provider);
+        model->setResolveSymlinks(false);
+        #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+        model->setOption(QFileSystemModel::DontUseCustomDirectoryIcons);
+        #endif
+        // Set up drag ability:
+        #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
+        model->setSupportedDragActions(Qt::CopyAction);
+        #endif
+    }
+
+    //! Returns the parent directory of \p path without querying the file system.
+    QString parentDirectory(const QString& path) {
+        return QFileInfo(QDir::cleanPath(QDir::fromNativeSeparators(path))).absolutePath();
+    }
+}
+
 struct Qtilities::CoreGui::SideWidgetFileSystemPrivateData {
     SideWidgetFileSystemPrivateData(): model(0),
         open_file_on_double_click(true) {}
 
     QFileSystemModel*       model;
+    GenericFileIconProvider icon_provider;
     QPoint                  drag_start_position;
     bool                    open_file_on_double_click;
 };
@@ -44,16 +89,13 @@ Qtilities::CoreGui::SideWidgetFileSystem::SideWidgetFileSystem(const QString& st
     d = new SideWidgetFileSystemPrivateData;
 
     d->model = new QFileSystemModel;
-
-    // Set up drag ability:
-    #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
-    d->model->setSupportedDragActions(Qt::CopyAction);
-    #endif
+    configureFileSystemModel(d->model,&d->icon_provider);
     ui->treeView->setDragEnabled(true);
+    // All rows have the same height, thus the view does not need to measure rows as directories are populated:
+    ui->treeView->setUniformRowHeights(true);
 
     // Set up model etc.:
-    QDir dir(start_path);
-    if (start_path.isEmpty() || !dir.exists())
+    if (start_path.isEmpty() || !FileSystemStatCache::instance()->isDir(start_path))
         d->model->setRootPath(QtilitiesApplication::applicationSessionPath());
     else
         d->model->setRootPath(start_path);
@@ -76,6 +118,9 @@ Qtilities::CoreGui::SideWidgetFileSystem::SideWidgetFileSystem(const QString& st
 }
 
 Qtilities::CoreGui::SideWidgetFileSystem::~SideWidgetFileSystem() {
+    // The model uses the icon provider in d, thus it is deleted first:
+    ui->treeView->setModel(0);
+    delete d->model;
     delete d;
 }
 
@@ -84,11 +129,7 @@ void Qtilities::CoreGui::SideWidgetFileSystem::releasePath() {
     delete d->model;
 
     d->model = new QFileSystemModel;
-
-    // Set up drag ability:
-    #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
-    d->model->setSupportedDragActions(Qt::CopyAction);
-    #endif
+    configureFileSystemModel(d->model,&d->icon_provider);
     d->model->setRootPath(QtilitiesApplication::applicationSessionPath());
     ui->treeView->setModel(d->model);
     QHeaderView* header = ui->treeView->header();
@@ -129,14 +170,16 @@ void Qtilities::CoreGui::SideWidgetFileSystem::dropEvent(QDropEvent *event) {
 
         QFile file(source_path);
         QFileInfo file_info(source_path);
-        if (!file_info.isDir()) {
+        if (!FileSystemStatCache::instance()->isDir(source_path)) {
             // Create the destination path:
             QString dest_path = ui->txtCurrentPath->text();
             if (!dest_path.endsWith("/"))
                 dest_path.append("/");
             dest_path.append(file_info.fileName());
 
-            if (file.copy(dest_path))
+            bool copied = file.copy(dest_path);
+            FileSystemStatCache::instance()->invalidate(dest_path);
+            if (copied)
                 LOG_INFO_P(tr(QString("Successfully copied file from \"" + source_path + "\" to path \"" + dest_path + "\".").toStdString().data()));
             else
                 LOG_ERROR_P(tr(QString("Failed to copy file from \"" + source_path + "\" to path \"" + dest_path + "\".").toStdString().data()));
@@ -154,7 +197,7 @@ void Qtilities::CoreGui::SideWidgetFileSystem::handleBtnBrowse() {
     QString path = QFileDialog::getExistingDirectory(this, tr("Select Path"),ui->txtCurrentPath->text(),QFileDialog::ShowDirsOnly | QFileDialog::DontResolveSymlinks);
     if (!path.isEmpty()) {
         QDir dir(path);
-        if (dir.exists()) {
+        if (FileSystemStatCache::instance()->isDir(path)) {
             ui->treeView->setRootIndex(d->model->index(dir.path()));
             ui->txtCurrentPath->setText(d->model->rootPath());
 
@@ -242,9 +285,8 @@ void Qtilities::CoreGui::SideWidgetFileSystem::toggleDoubleClickFileOpen(bool op
 }
 
 void Qtilities::CoreGui::SideWidgetFileSystem::on_btnCdUp_clicked() {
-    QDir dir(ui->txtCurrentPath->text());
-    dir.cdUp();
-    if (dir.exists()) {
+    QDir dir(parentDirectory(ui->txtCurrentPath->text()));
+    if (FileSystemStatCache::instance()->isDir(dir.path())) {
         ui->treeView->setRootIndex(d->model->index(dir.path()));
         ui->txtCurrentPath->setText(dir.path());
 
@@ -255,7 +297,7 @@ void Qtilities::CoreGui::SideWidgetFileSystem::on_btnCdUp_clicked() {
 
 void Qtilities::CoreGui::SideWidgetFileSystem::on_txtCurrentPath_editingFinished() {
     QDir dir(ui->txtCurrentPath->text());
-    if (dir.exists()) {
+    if (FileSystemStatCache::instance()->isDir(dir.path())) {
         ui->treeView->setRootIndex(d->model->index(dir.path()));
         ui->txtCurrentPath->setText(dir.path());
 
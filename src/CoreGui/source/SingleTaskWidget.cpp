@@ -20,6 +20,7 @@
 
 #include <QPointer>
 #include <QMessageBox>
+#include <QTimer>
 
 using namespace Qtilities::CoreGui::Icons;
 using namespace Qtilities::Core::Interfaces;
@@ -37,6 +38,8 @@ struct Qtilities::CoreGui::SingleTaskWidgetPrivateData {
     bool                stop_button_visible;
     bool                start_button_visible;
     bool                show_log_button_visible;
+    //! Coalesces progress updates, thus the widget is updated at most once per frame.
+    QTimer              progress_update_timer;
 };
 
 Qtilities::CoreGui::SingleTaskWidget::SingleTaskWidget(int task_id, QWidget* parent) :
@@ -46,6 +49,9 @@ Qtilities::CoreGui::SingleTaskWidget::SingleTaskWidget(int task_id, QWidget* par
 {
     ui->setupUi(this);
     d = new SingleTaskWidgetPrivateData;
+    d->progress_update_timer.setSingleShot(true);
+    d->progress_update_timer.setInterval(16);
+    connect(&d->progress_update_timer,SIGNAL(timeout()),SLOT(update()));
     ui->btnShowLog->setIcon(QIcon(qti_icon_TASK_NOT_STARTED_22x22));
     ui->btnShowLog->setToolTip(tr("Task Has Not Been Started."));
 
@@ -85,7 +91,7 @@ Qtilities::CoreGui::SingleTaskWidget::SingleTaskWidget(int task_id, QWidget* par
         d->task_base = d->task->objectBase();
         connect(d->task->objectBase(),SIGNAL(destroyed()),SLOT(handleTaskDeleted()));
         connect(d->task->objectBase(),SIGNAL(taskStarted(int,QString,Logger::MessageType)),SLOT(update()));
-        connect(d->task->objectBase(),SIGNAL(subTaskCompleted(int,QString,Logger::MessageType)),SLOT(update()));
+        connect(d->task->objectBase(),SIGNAL(subTaskCompleted(int,QString,Logger::MessageType)),SLOT(scheduleProgressUpdate()));
         connect(d->task->objectBase(),SIGNAL(taskCompleted(ITask::TaskResult,QString,Logger::MessageType)),SLOT(update()));
         connect(d->task->objectBase(),SIGNAL(taskPaused()),SLOT(update()));
         connect(d->task->objectBase(),SIGNAL(taskResumed()),SLOT(update()));
@@ -316,7 +322,13 @@ void Qtilities::CoreGui::SingleTaskWidget::resizeEvent(QResizeEvent * event) {
     QWidget::resizeEvent(event);
 }
 
+void Qtilities::CoreGui::SingleTaskWidget::scheduleProgressUpdate() {
+    if (!d->progress_update_timer.isActive())
+        d->progress_update_timer.start();
+}
+
 void Qtilities::CoreGui::SingleTaskWidget::update() {  
+    d->progress_update_timer.stop();
     if (!d->task || !d->task_base)
         return;
 
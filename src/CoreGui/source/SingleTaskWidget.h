@@ -157,6 +157,8 @@ SingleTaskWidget* task_widget = TaskManagerGui::instance()->singleTaskWidget(tas
 
         private slots:
             void update();
+            //! Schedules an update when the progress of the task changed. Tasks can complete sub tasks much faster than the widget can be painted, thus updates are coalesced.
+            void scheduleProgressUpdate();
             void on_btnShowLog_clicked();
             void on_btnPause_clicked();
             void on_btnStop_clicked();
@@ -0,0 +1,226 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "StartupSnapshot.h"
+#include "QtilitiesApplication.h"
+#include "QtilitiesMainWindow.h"
+#include "ModeManager.h"
+#include "Command.h"
+#include "IConfigPage.h"
+#include "IMode.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+using namespace Qtilities::CoreGui::Interfaces;
+
+//! The magic number at the start of snapshot files.
+#define STARTUP_SNAPSHOT_MAGIC quint32(0x51535353)
+//! The snapshot format version, snapshots saved using a different version are not loaded.
+#define STARTUP_SNAPSHOT_VERSION quint32(1)
+
+struct Qtilities::CoreGui::StartupSnapshotPrivateData {
+    StartupSnapshotPrivateData() : is_valid(false) {}
+
+    bool                                    is_valid;
+    QByteArray                              validation_key;
+    QList<StartupSnapshot::CommandInfo>     commands;
+    QStringList                             mode_order;
+    QList<StartupSnapshot::ConfigPageInfo>  config_pages;
+};
+
+Qtilities::CoreGui::StartupSnapshot::StartupSnapshot() {
+    d = new StartupSnapshotPrivateData;
+}
+
+Qtilities::CoreGui::StartupSnapshot::StartupSnapshot(const StartupSnapshot& ref) {
+    d = new StartupSnapshotPrivateData(*ref.d);
+}
+
+Qtilities::CoreGui::StartupSnapshot& Qtilities::CoreGui::StartupSnapshot::operator=(const StartupSnapshot& ref) {
+    if (this == &ref) return *this;
+
+    *d = *ref.d;
+    return *this;
+}
+
+Qtilities::CoreGui::StartupSnapshot::~StartupSnapshot() {
+    delete d;
+}
+
+void Qtilities::CoreGui::StartupSnapshot::capture(const QByteArray& validation_key, ModeManager* mode_manager) {
+    clear();
+    d->validation_key = validation_key;
+
+    // Only proxy actions can be restored as placeholders, shortcut commands need their QShortcut instances:
+    Qtilities::Core::Observer* command_observer = ACTION_MANAGER->commandObserver();
+    for (int i = 0; i < command_observer->subjectCount(); ++i) {
+        ProxyAction* proxy_action = qobject_cast<ProxyAction*> (command_observer->subjectAt(i));
+        if (!proxy_action)
+            continue;
+
+        CommandInfo command_info;
+        command_info.id = proxy_action->objectName();
+        command_info.text = proxy_action->text();
+        command_info.default_key_sequence = proxy_action->defaultKeySequence();
+        d->commands << command_info;
+    }
+
+    if (!mode_manager) {
+        QtilitiesMainWindow* main_window = qobject_cast<QtilitiesMainWindow*> (QtilitiesApplication::mainWindow());
+        if (main_window)
+            mode_manager = main_window->modeManager();
+    }
+    if (mode_manager) {
+        QList<IMode*> modes = mode_manager->modes();
+        for (int i = 0; i < modes.count(); ++i)
+            d->mode_order << modes.at(i)->modeName();
+    }
+
+    QList<IConfigPage*> config_pages = OBJECT_MANAGER->registeredInterfaces<IConfigPage>();
+    for (int i = 0; i < config_pages.count(); ++i) {
+        ConfigPageInfo page_info;
+        page_info.category = config_pages.at(i)->configPageCategory().toString("::");
+        page_info.title = config_pages.at(i)->configPageTitle();
+        d->config_pages << page_info;
+    }
+
+    d->is_valid = true;
+}
+
+bool Qtilities::CoreGui::StartupSnapshot::isValid() const {
+    return d->is_valid;
+}
+
+void Qtilities::CoreGui::StartupSnapshot::clear() {
+    d->is_valid = false;
+    d->validation_key.clear();
+    d->commands.clear();
+    d->mode_order.clear();
+    d->config_pages.clear();
+}
+
+QByteArray Qtilities::CoreGui::StartupSnapshot::validationKey() const {
+    return d->validation_key;
+}
+
+bool Qtilities::CoreGui::StartupSnapshot::save(const QString& file_name, QString* errorMsg) const {
+    if (!d->is_valid) {
+        if (errorMsg)
+            *errorMsg = QString("The startup snapshot does not contain any data.");
+        return false;
+    }
+
+    QFileInfo fi(file_name);
+    if (!QDir().mkpath(fi.path())) {
+        if (errorMsg)
+            *errorMsg = QString("Failed to create the directory of the startup snapshot: %1").arg(fi.path());
+        return false;
+    }
+
+    QFile file(file_name);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (errorMsg)
+            *errorMsg = QString("Failed to open the startup snapshot for writing: %1").arg(file_name);
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_7);
+    stream << STARTUP_SNAPSHOT_MAGIC;
+    stream << STARTUP_SNAPSHOT_VERSION;
+    stream << d->validation_key;
+
+    stream << (quint32) d->commands.count();
+    for (int i = 0; i < d->commands.count(); ++i)
+        stream << d->commands.at(i).id << d->commands.at(i).text << d->commands.at(i).default_key_sequence;
+    stream << d->mode_order;
+    stream << (quint32) d->config_pages.count();
+    for (int i = 0; i < d->config_pages.count(); ++i)
+        stream << d->config_pages.at(i).category << d->config_pages.at(i).title;
+
+    file.close();
+    return stream.status() == QDataStream::Ok;
+}
+
+bool Qtilities::CoreGui::StartupSnapshot::load(const QString& file_name, const QByteArray& validation_key) {
+    clear();
+
+    QFile file(file_name);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_7);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != STARTUP_SNAPSHOT_MAGIC || version != STARTUP_SNAPSHOT_VERSION)
+        return false;
+
+    QByteArray stored_key;
+    stream >> stored_key;
+    if (stored_key != validation_key)
+        return false;
+
+    quint32 command_count = 0;
+    stream >> command_count;
+    for (quint32 i = 0; i < command_count && stream.status() == QDataStream::Ok; ++i) {
+        CommandInfo command_info;
+        stream >> command_info.id >> command_info.text >> command_info.default_key_sequence;
+        d->commands << command_info;
+    }
+    stream >> d->mode_order;
+    quint32 page_count = 0;
+    stream >> page_count;
+    for (quint32 i = 0; i < page_count && stream.status() == QDataStream::Ok; ++i) {
+        ConfigPageInfo page_info;
+        stream >> page_info.category >> page_info.title;
+        d->config_pages << page_info;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        clear();
+        return false;
+    }
+
+    d->validation_key = stored_key;
+    d->is_valid = true;
+    return true;
+}
+
+QList<Qtilities::CoreGui::StartupSnapshot::CommandInfo> Qtilities::CoreGui::StartupSnapshot::commands() const {
+    return d->commands;
+}
+
+QStringList Qtilities::CoreGui::StartupSnapshot::modeOrder() const {
+    return d->mode_order;
+}
+
+QList<Qtilities::CoreGui::StartupSnapshot::ConfigPageInfo> Qtilities::CoreGui::StartupSnapshot::configPages() const {
+    return d->config_pages;
+}
+
+int Qtilities::CoreGui::StartupSnapshot::restoreCommands() const {
+    int restored = 0;
+    for (int i = 0; i < d->commands.count(); ++i) {
+        const CommandInfo& command_info = d->commands.at(i);
+        if (command_info.id.isEmpty() || ACTION_MANAGER->command(command_info.id))
+            continue;
+
+        // The default shortcut is used, custom shortcuts are restored by the shortcut mapping of the application:
+        if (ACTION_MANAGER->registerActionPlaceHolder(command_info.id,command_info.text,command_info.default_key_sequence))
+            ++restored;
+    }
+    return restored;
+}
@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef STARTUP_SNAPSHOT_H
+#define STARTUP_SNAPSHOT_H
+
+#include "QtilitiesCoreGui_global.h"
+
+#include <QByteArray>
+#include <QKeySequence>
+#include <QList>
+#include <QStringList>
+
+namespace Qtilities {
+    namespace CoreGui {
+        class ModeManager;
+
+        /*!
+        \struct StartupSnapshotPrivateData
+        \brief The StartupSnapshotPrivateData struct stores private data used by the StartupSnapshot class.
+          */
+        struct StartupSnapshotPrivateData;
+
+        /*!
+        \class StartupSnapshot
+        \brief A versioned cache of the user interface layout of an application, used to construct the user interface before plugins are loaded.
+
+        On every launch the commands, modes and configuration pages of an application are only known once all plugins were loaded and
+        initialized. A startup snapshot captures them when the application shuts down:
+        - The commands registered in the action manager, with their text and default shortcut.
+        - The names of the application modes, in the order in which they appear.
+        - The hierarchy of the configuration pages, as category and title pairs.
+
+        On the next launch, restoreCommands() registers an action placeholder for every command in the snapshot, thus the command editor,
+        shortcut mappings and menus can use the commands right away. The live actions are attached to the placeholders when the plugins
+        register them through Qtilities::CoreGui::Interfaces::IActionManager::registerAction().
+
+        Every snapshot is stored with a validation key, like the hash of the plugin files in the application. load() rejects a snapshot
+        of which the key differs from the current key, or which was saved by a different snapshot format version.
+
+        The extension system manages a snapshot for you, see Qtilities::ExtensionSystem::ExtensionSystemCore::setStartupSnapshotEnabled().
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILITIES_CORE_GUI_SHARED_EXPORT StartupSnapshot
+        {
+        public:
+            //! A command stored in a startup snapshot.
+            struct CommandInfo {
+                QString         id;
+                QString         text;
+                QKeySequence    default_key_sequence;
+            };
+            //! A configuration page stored in a startup snapshot.
+            struct ConfigPageInfo {
+                //! The category of the page, as returned by Qtilities::Core::QtilitiesCategory::toString() using "::" as separator.
+                QString         category;
+                QString         title;
+            };
+
+            StartupSnapshot();
+            StartupSnapshot(const StartupSnapshot& ref);
+            StartupSnapshot& operator=(const StartupSnapshot& ref);
+            ~StartupSnapshot();
+
+            //! Captures the current commands, modes and configuration pages of the application.
+            /*!
+              \param validation_key The key against which the snapshot is validated when it is loaded.
+              \param mode_manager The mode manager of which the modes must be captured. When null, the mode manager of
+              QtilitiesApplication::mainWindow() is used if it is a QtilitiesMainWindow.
+              */
+            void capture(const QByteArray& validation_key, ModeManager* mode_manager = 0);
+            //! Indicates if the snapshot contains data, either captured or loaded.
+            bool isValid() const;
+            //! Removes all data from the snapshot.
+            void clear();
+            //! The key against which the snapshot is validated.
+            QByteArray validationKey() const;
+
+            //! Saves the snapshot to \p file_name.
+            bool save(const QString& file_name, QString* errorMsg = 0) const;
+            //! Loads the snapshot in \p file_name.
+            /*!
+              \returns False when the file does not exist, when it was saved using a different snapshot format version, or when it
+              was saved with a validation key which is not \p validation_key. The snapshot is cleared in these cases.
+              */
+            bool load(const QString& file_name, const QByteArray& validation_key);
+
+            //! The commands in the snapshot.
+            QList<CommandInfo> commands() const;
+            //! The names of the modes in the snapshot, in the order in which they appeared.
+            QStringList modeOrder() const;
+            //! The configuration pages in the snapshot.
+            QList<ConfigPageInfo> configPages() const;
+
+            //! Registers action placeholders for the commands in the snapshot which are not registered in the action manager yet.
+            /*!
+              \returns The number of placeholders registered.
+              */
+            int restoreCommands() const;
+
+        private:
+            StartupSnapshotPrivateData* d;
+        };
+    }
+}
+
+#endif // STARTUP_SNAPSHOT_H
@@ -20,11 +20,30 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QDesktopServices>
+#include <QSet>
 
 using namespace Qtilities::Core;
 using namespace Qtilities::CoreGui::Interfaces;
 using namespace Qtilities::CoreGui::Icons;
 
+namespace {
+    // Removes duplicates from strings in a single pass using a hash set and sorts the result, like QStringListModel::sort() does:
+    QStringList qti_private_uniqueSortedStrings(const QStringList& strings) {
+        QStringList unique_strings;
+        unique_strings.reserve(strings.count());
+        QSet<QString> seen;
+        seen.reserve(strings.count());
+        foreach (const QString& string, strings) {
+            if (!seen.contains(string)) {
+                seen.insert(string);
+                unique_strings << string;
+            }
+        }
+        unique_strings.sort();
+        return unique_strings;
+    }
+}
+
 struct Qtilities::CoreGui::StringListWidgetPrivateData {
     StringListWidgetPrivateData() : list_type(StringListWidget::PlainStrings),
         open_on_double_click(false),
@@ -51,9 +70,8 @@ Qtilities::CoreGui::StringListWidget::StringListWidget(const QStringList& string
     ui->setupUi(this);
     d = new StringListWidgetPrivateData;
     d->toolbar_area = toolbar_area;
-    d->model.setStringList(string_list);
+    d->model.setStringList(qti_private_uniqueSortedStrings(string_list));
     ui->listView->setModel(&d->model);
-    d->model.sort(0);
 
     d->actionAddString = new QAction(QIcon(qti_icon_NEW_16x16),"Add",this);
     d->actionRemoveString = new QAction(QIcon(qti_icon_REMOVE_ONE_16x16),"Remove",this);
@@ -84,10 +102,24 @@ QStringList Qtilities::CoreGui::StringListWidget::stringList() const {
 }
 
 void Qtilities::CoreGui::StringListWidget::setStringList(const QStringList& string_list) {
-    d->model.setStringList(string_list);
+    // The list is prepared before it is given to the model, thus the model is only reset once:
+    const QStringList new_list = qti_private_uniqueSortedStrings(string_list);
+    d->model.setStringList(new_list);
+    emit stringListChanged(new_list);
+}
 
-    emit stringListChanged(d->model.stringList());
-    d->model.sort(0);
+int Qtilities::CoreGui::StringListWidget::addStrings(const QStringList& strings) {
+    QStringList new_list = d->model.stringList();
+    const int previous_count = new_list.count();
+    new_list << strings;
+    new_list = qti_private_uniqueSortedStrings(new_list);
+    const int added_count = new_list.count() - previous_count;
+    if (added_count <= 0)
+        return 0;
+
+    d->model.setStringList(new_list);
+    emit stringListChanged(new_list);
+    return added_count;
 }
 
 QStringList Qtilities::CoreGui::StringListWidget::nonRemovableStringList() const {
@@ -153,28 +185,19 @@ void Qtilities::CoreGui::StringListWidget::handleAddString() {
 
     if (d->list_type == PlainStrings) {
         QString text = QInputDialog::getText(this, string_type,tr("New Item"), QLineEdit::Normal,"", &ok);
-        if (ok && !text.isEmpty()) {
-            QStringList list = d->model.stringList();
-            list << text;
-            list.removeDuplicates();
-            d->model.setStringList(list);
-            emit stringListChanged(list);
-        }
+        if (ok && !text.isEmpty())
+            addStrings(QStringList(text));
     } else if (d->list_type == FilePaths) {            
         QStringList fileNames = QFileDialog::getOpenFileNames(this, tr("Open File"),QDir::cleanPath(d->open_dialog_path),d->open_dialog_filter);
-        int process_count = 0;
-        foreach (const QString& file_name, fileNames) {
-            if (process_count == 0) {
-                QFileInfo fi(file_name);
-                d->open_dialog_path = fi.path();
-            }
-            ++process_count;
-
-            QStringList list = d->model.stringList();
-            list << FileUtils::toNativeSeparators(file_name);
-            list.removeDuplicates();
-            d->model.setStringList(list);
-            emit stringListChanged(list);
+        if (!fileNames.isEmpty()) {
+            QFileInfo fi(fileNames.front());
+            d->open_dialog_path = fi.path();
+
+            // All selected files are added at once:
+            QStringList new_files;
+            foreach (const QString& file_name, fileNames)
+                new_files << FileUtils::toNativeSeparators(file_name);
+            addStrings(new_files);
         }
     } else if (d->list_type == Directories) {
         QString dir = QFileDialog::getExistingDirectory(this, tr("Open Directory"),d->open_dialog_path,QFileDialog::ShowDirsOnly | QFileDialog::DontResolveSymlinks);
@@ -183,26 +206,20 @@ void Qtilities::CoreGui::StringListWidget::handleAddString() {
             new_default_dir.cdUp();
             d->open_dialog_path = new_default_dir.path();
 
-            QStringList list = d->model.stringList();
-            list << FileUtils::toNativeSeparators(dir);
-            list.removeDuplicates();
-            d->model.setStringList(list);
-            emit stringListChanged(list);
+            addStrings(QStringList(FileUtils::toNativeSeparators(dir)));
         }
     }
-    d->model.sort(0);
 }
 
 void Qtilities::CoreGui::StringListWidget::handleRemoveString() {
-    if (ui->listView->selectionModel()->selectedIndexes().count() > 0) {
-        QStringList selected_list;
-        for (int i = 0; i < ui->listView->selectionModel()->selectedIndexes().count(); ++i)
-            selected_list << d->model.data(ui->listView->selectionModel()->selectedIndexes().at(i),Qt::DisplayRole).toString();
-
-        QStringList new_list = d->model.stringList();
-        foreach (const QString& string, selected_list) {
-            if (!d->non_removable_strings.contains(string)) {
-                new_list.removeOne(string);
+    const QModelIndexList selected_indexes = ui->listView->selectionModel()->selectedIndexes();
+    if (selected_indexes.count() > 0) {
+        const QSet<QString> non_removable_strings = d->non_removable_strings.toSet();
+        QSet<QString> removed_strings;
+        for (int i = 0; i < selected_indexes.count(); ++i) {
+            const QString string = d->model.data(selected_indexes.at(i),Qt::DisplayRole).toString();
+            if (!non_removable_strings.contains(string)) {
+                removed_strings.insert(string);
             } else {
                 QMessageBox msgBox;
                 msgBox.setIcon(QMessageBox::Information);
@@ -210,9 +227,19 @@ void Qtilities::CoreGui::StringListWidget::handleRemoveString() {
                 msgBox.exec();
             }
         }
+
+        if (removed_strings.isEmpty())
+            return;
+
+        // Remove the strings in a single pass over the list:
+        QStringList new_list;
+        foreach (const QString& string, d->model.stringList()) {
+            if (!removed_strings.contains(string))
+                new_list << string;
+        }
         d->model.setStringList(new_list);
+        emit stringListChanged(new_list);
     }
-    d->model.sort(0);
 }
 
 void Qtilities::CoreGui::StringListWidget::handleDoubleClick(QModelIndex index) {
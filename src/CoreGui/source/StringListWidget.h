@@ -66,7 +66,19 @@ namespace Qtilities {
             //! Gets the current list of strings.
             QStringList stringList() const;
             //! Sets the current list of string.
+            /*!
+              Duplicates are removed and the list is sorted before it is set on the model, thus the model is reset once and stringListChanged() is emitted once, also for large lists.
+              */
             void setStringList(const QStringList& string_list);     
+            //! Adds strings to the current list of strings.
+            /*!
+              Strings which are already in the list are ignored. The model is reset once and stringListChanged() is emitted once when strings were added.
+
+              \returns The number of strings which were added.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int addStrings(const QStringList& strings);
 
             //! Gets the current list of non-removable only strings.
             QStringList nonRemovableStringList() const;
@@ -135,21 +135,22 @@ AbstractLoggerEngine* TaskManagerGui::assignLoggerEngineToTask(ITask* task, Widg
     }
 
     QString engine_name = "Task Log: " + task->taskName();
-    LoggerGui::createLogWidget(&engine_name,message_displays_flag);
+    // The widget of the engine is only created when the log of the task is shown:
+    LoggerGui::createLogWidgetEngine(&engine_name,message_displays_flag);
     //qDebug() << engine_name;
     AbstractLoggerEngine* log_engine = Log->loggerEngineReference(engine_name);
     Q_ASSERT(log_engine);
     log_engine->setRemovable(false);
     log_engine->setMessageContexts(Logger::EngineSpecificMessages);
     task->setLoggerEngine(log_engine);
-    LOG_TRACE("Assigning logger engine to task: " + task->taskName());
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::TaskLogTag,"Assigning logger engine to task: " + task->taskName());
     return log_engine;
 }
 
 void TaskManagerGui::assignLazyLoggerEngineToTask() {
     ITask* task = qobject_cast<ITask*> (sender());
     if (task) {
-        LOG_TRACE("Assigning lazy logger engine to task: " + task->taskName());
+        LOG_TAG_TRACE(Qtilities::Logging::Logger::TaskLogTag,"Assigning lazy logger engine to task: " + task->taskName());
         assignLoggerEngineToTask(task);
     }
 }
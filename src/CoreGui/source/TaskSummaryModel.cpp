@@ -0,0 +1,509 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TaskSummaryModel.h"
+#include "QtilitiesCoreGuiConstants.h"
+
+#include <QApplication>
+#include <QHash>
+#include <QIcon>
+#include <QMessageBox>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+#include <QStyleOptionProgressBar>
+#include <QTimer>
+
+using namespace Qtilities::CoreGui::Icons;
+
+namespace {
+    //! The size of the stop button painted by TaskProgressDelegate.
+    const int qti_private_STOP_BUTTON_SIZE = 16;
+    //! The maximum width of the progress bar painted by TaskProgressDelegate.
+    const int qti_private_PROGRESS_BAR_WIDTH = 160;
+}
+
+// --------------------------------
+// TaskSummaryModel
+// --------------------------------
+
+struct Qtilities::CoreGui::TaskSummaryModelPrivateData {
+    TaskSummaryModelPrivateData() : summary_row_shown(false),
+        summary_changed(false),
+        aggregate_finished_tasks(true),
+        finished_successful(0),
+        finished_with_warnings(0),
+        finished_failed(0),
+        finished_stopped(0) {}
+
+    //! The tracked tasks.
+    QHash<int,QPointer<QObject> >   tasks;
+    QHash<QObject*,int>             task_ids;
+    //! The IDs of the tasks shown in rows, the newest task first.
+    QList<int>                      rows;
+    QSet<int>                       row_ids;
+    //! The IDs of the tasks which must be shown after the next refresh.
+    QSet<int>                       displayed_ids;
+    //! The IDs of tasks which were displayed since the last refresh, in the order in which they were displayed.
+    QList<int>                      pending_rows;
+    //! The IDs of displayed tasks which changed since the last refresh.
+    QSet<int>                       changed_ids;
+    bool                            summary_row_shown;
+    bool                            summary_changed;
+
+    QTimer                          refresh_timer;
+    bool                            aggregate_finished_tasks;
+    int                             finished_successful;
+    int                             finished_with_warnings;
+    int                             finished_failed;
+    int                             finished_stopped;
+};
+
+Qtilities::CoreGui::TaskSummaryModel::TaskSummaryModel(QObject* parent) : QAbstractListModel(parent) {
+    d = new TaskSummaryModelPrivateData;
+    d->refresh_timer.setSingleShot(true);
+    d->refresh_timer.setInterval(250);
+    connect(&d->refresh_timer,SIGNAL(timeout()),SLOT(refresh()));
+}
+
+Qtilities::CoreGui::TaskSummaryModel::~TaskSummaryModel() {
+    delete d;
+}
+
+int Qtilities::CoreGui::TaskSummaryModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid())
+        return 0;
+    return d->rows.count() + (d->summary_row_shown ? 1 : 0);
+}
+
+QVariant Qtilities::CoreGui::TaskSummaryModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
+        return QVariant();
+
+    if (index.row() == d->rows.count()) {
+        if (role == Qt::DisplayRole || role == Qt::ToolTipRole)
+            return summaryText();
+        else if (role == TaskIdRole)
+            return -1;
+        else if (role == SummaryRowRole)
+            return true;
+        return QVariant();
+    }
+
+    int task_id = d->rows.at(index.row());
+    ITask* itask = task(task_id);
+    if (!itask)
+        return QVariant();
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::ToolTipRole:
+        return itask->displayName();
+    case TaskIdRole:
+        return task_id;
+    case ProgressRole:
+        return itask->currentProgress();
+    case SubTaskCountRole:
+        return itask->numberOfSubTasks();
+    case StateRole:
+        return (int) itask->state();
+    case ResultRole:
+        return (int) itask->result();
+    case CanStopRole:
+        return itask->canStop() && itask->state() == ITask::TaskBusy;
+    case SummaryRowRole:
+        return false;
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::addTask(ITask* task) {
+    if (!task || d->tasks.contains(task->taskID()))
+        return;
+
+    QObject* obj = task->objectBase();
+    d->tasks[task->taskID()] = obj;
+    d->task_ids[obj] = task->taskID();
+
+    // All progress notifications are coalesced by the refresh timer:
+    connect(obj,SIGNAL(destroyed(QObject*)),SLOT(handleTaskDestroyed(QObject*)));
+    connect(obj,SIGNAL(taskStarted(int,QString,Logger::MessageType)),SLOT(handleTaskChanged()));
+    connect(obj,SIGNAL(subTaskCompleted(int,QString,Logger::MessageType)),SLOT(handleTaskChanged()));
+    connect(obj,SIGNAL(taskCompleted(ITask::TaskResult,QString,Logger::MessageType)),SLOT(handleTaskChanged()));
+    connect(obj,SIGNAL(taskPaused()),SLOT(handleTaskChanged()));
+    connect(obj,SIGNAL(taskResumed()),SLOT(handleTaskChanged()));
+    connect(obj,SIGNAL(taskStopped()),SLOT(handleTaskChanged()));
+    connect(obj,SIGNAL(displayedNameChanged(QString)),SLOT(handleTaskChanged()));
+    connect(obj,SIGNAL(canStopChanged(bool)),SLOT(handleTaskChanged()));
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::removeTask(int task_id) {
+    QPointer<QObject> obj = d->tasks.take(task_id);
+    if (obj) {
+        obj->disconnect(this);
+        d->task_ids.remove(obj);
+    }
+
+    if (d->displayed_ids.remove(task_id))
+        scheduleRefresh();
+    d->changed_ids.remove(task_id);
+}
+
+bool Qtilities::CoreGui::TaskSummaryModel::containsTask(int task_id) const {
+    return d->tasks.contains(task_id);
+}
+
+Qtilities::Core::Interfaces::ITask* Qtilities::CoreGui::TaskSummaryModel::task(int task_id) const {
+    QObject* obj = d->tasks.value(task_id);
+    if (!obj)
+        return 0;
+    return qobject_cast<ITask*> (obj);
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::setTaskDisplayed(int task_id, bool is_displayed) {
+    if (!d->tasks.contains(task_id))
+        return;
+
+    if (is_displayed) {
+        if (d->displayed_ids.contains(task_id))
+            return;
+        d->displayed_ids.insert(task_id);
+        d->pending_rows.append(task_id);
+    } else {
+        if (!d->displayed_ids.remove(task_id))
+            return;
+        aggregateFinishedTask(task(task_id));
+    }
+    scheduleRefresh();
+}
+
+bool Qtilities::CoreGui::TaskSummaryModel::isTaskDisplayed(int task_id) const {
+    return d->displayed_ids.contains(task_id);
+}
+
+QList<int> Qtilities::CoreGui::TaskSummaryModel::taskIds() const {
+    return d->tasks.keys();
+}
+
+QList<int> Qtilities::CoreGui::TaskSummaryModel::displayedTaskIds() const {
+    return d->displayed_ids.toList();
+}
+
+int Qtilities::CoreGui::TaskSummaryModel::displayedTaskCount() const {
+    return d->displayed_ids.count();
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::setRefreshInterval(int msec) {
+    d->refresh_timer.setInterval(qMax(0,msec));
+}
+
+int Qtilities::CoreGui::TaskSummaryModel::refreshInterval() const {
+    return d->refresh_timer.interval();
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::setAggregateFinishedTasks(bool aggregate) {
+    if (d->aggregate_finished_tasks == aggregate)
+        return;
+
+    d->aggregate_finished_tasks = aggregate;
+    if (!aggregate)
+        clearFinishedTasks();
+}
+
+bool Qtilities::CoreGui::TaskSummaryModel::aggregateFinishedTasks() const {
+    return d->aggregate_finished_tasks;
+}
+
+int Qtilities::CoreGui::TaskSummaryModel::finishedTaskCount() const {
+    return d->finished_successful + d->finished_with_warnings + d->finished_failed + d->finished_stopped;
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::clear() {
+    d->refresh_timer.stop();
+
+    beginResetModel();
+    QList<QPointer<QObject> > objects = d->tasks.values();
+    for (int i = 0; i < objects.count(); ++i) {
+        if (objects.at(i))
+            objects.at(i)->disconnect(this);
+    }
+    d->tasks.clear();
+    d->task_ids.clear();
+    d->rows.clear();
+    d->row_ids.clear();
+    d->displayed_ids.clear();
+    d->pending_rows.clear();
+    d->changed_ids.clear();
+    d->summary_row_shown = false;
+    d->summary_changed = false;
+    d->finished_successful = 0;
+    d->finished_with_warnings = 0;
+    d->finished_failed = 0;
+    d->finished_stopped = 0;
+    endResetModel();
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::clearFinishedTasks() {
+    if (finishedTaskCount() == 0)
+        return;
+
+    d->finished_successful = 0;
+    d->finished_with_warnings = 0;
+    d->finished_failed = 0;
+    d->finished_stopped = 0;
+    d->summary_changed = true;
+    scheduleRefresh();
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::refresh() {
+    d->refresh_timer.stop();
+
+    // 1. Remove the rows of tasks which are no longer displayed, one range of rows at a time from the bottom up:
+    int row = d->rows.count() - 1;
+    while (row >= 0) {
+        if (d->displayed_ids.contains(d->rows.at(row))) {
+            --row;
+            continue;
+        }
+
+        int last_row = row;
+        while (row > 0 && !d->displayed_ids.contains(d->rows.at(row - 1)))
+            --row;
+
+        beginRemoveRows(QModelIndex(),row,last_row);
+        for (int i = last_row; i >= row; --i)
+            d->row_ids.remove(d->rows.takeAt(i));
+        endRemoveRows();
+        --row;
+    }
+
+    // 2. Insert the newly displayed tasks at the top, the newest task first:
+    QList<int> new_rows;
+    for (int i = d->pending_rows.count() - 1; i >= 0; --i) {
+        int task_id = d->pending_rows.at(i);
+        if (d->displayed_ids.contains(task_id) && !d->row_ids.contains(task_id) && !new_rows.contains(task_id))
+            new_rows << task_id;
+    }
+    d->pending_rows.clear();
+    if (!new_rows.isEmpty()) {
+        beginInsertRows(QModelIndex(),0,new_rows.count() - 1);
+        d->rows = new_rows + d->rows;
+        for (int i = 0; i < new_rows.count(); ++i)
+            d->row_ids.insert(new_rows.at(i));
+        endInsertRows();
+    }
+
+    // 3. Update the summary row:
+    bool show_summary_row = d->aggregate_finished_tasks && finishedTaskCount() > 0;
+    if (show_summary_row && !d->summary_row_shown) {
+        beginInsertRows(QModelIndex(),d->rows.count(),d->rows.count());
+        d->summary_row_shown = true;
+        endInsertRows();
+    } else if (!show_summary_row && d->summary_row_shown) {
+        beginRemoveRows(QModelIndex(),d->rows.count(),d->rows.count());
+        d->summary_row_shown = false;
+        endRemoveRows();
+    } else if (show_summary_row && d->summary_changed) {
+        QModelIndex summary_index = index(d->rows.count());
+        emit dataChanged(summary_index,summary_index);
+    }
+    d->summary_changed = false;
+
+    // 4. Update the rows of the tasks which changed using a single range:
+    if (!d->changed_ids.isEmpty()) {
+        int first_row = -1;
+        int last_row = -1;
+        for (int i = 0; i < d->rows.count(); ++i) {
+            if (d->changed_ids.contains(d->rows.at(i))) {
+                if (first_row == -1)
+                    first_row = i;
+                last_row = i;
+            }
+        }
+        d->changed_ids.clear();
+        if (first_row != -1)
+            emit dataChanged(index(first_row),index(last_row));
+    }
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::handleTaskChanged() {
+    int task_id = d->task_ids.value(sender(),-1);
+    if (task_id == -1 || !d->displayed_ids.contains(task_id))
+        return;
+
+    d->changed_ids.insert(task_id);
+    scheduleRefresh();
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::handleTaskDestroyed(QObject* obj) {
+    int task_id = d->task_ids.value(obj,-1);
+    if (task_id == -1)
+        return;
+
+    d->task_ids.remove(obj);
+    d->tasks.remove(task_id);
+    d->changed_ids.remove(task_id);
+    if (d->displayed_ids.remove(task_id)) {
+        // The rows of deleted tasks must be removed before views ask for their data:
+        refresh();
+    }
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::scheduleRefresh() {
+    if (!d->refresh_timer.isActive())
+        d->refresh_timer.start();
+}
+
+void Qtilities::CoreGui::TaskSummaryModel::aggregateFinishedTask(ITask* task) {
+    if (!task || !d->aggregate_finished_tasks)
+        return;
+
+    if (task->state() == ITask::TaskStopped) {
+        ++d->finished_stopped;
+    } else if (task->state() == ITask::TaskCompleted) {
+        if (task->result() == ITask::TaskFailed)
+            ++d->finished_failed;
+        else if (task->result() == ITask::TaskSuccessfulWithWarnings || task->result() == ITask::TaskSuccessfulWithErrors)
+            ++d->finished_with_warnings;
+        else
+            ++d->finished_successful;
+    } else
+        return;
+
+    d->summary_changed = true;
+}
+
+QString Qtilities::CoreGui::TaskSummaryModel::summaryText() const {
+    QStringList details;
+    if (d->finished_successful > 0)
+        details << QString(tr("%1 successful")).arg(d->finished_successful);
+    if (d->finished_with_warnings > 0)
+        details << QString(tr("%1 with warnings")).arg(d->finished_with_warnings);
+    if (d->finished_failed > 0)
+        details << QString(tr("%1 failed")).arg(d->finished_failed);
+    if (d->finished_stopped > 0)
+        details << QString(tr("%1 stopped")).arg(d->finished_stopped);
+
+    return QString(tr("%1 finished tasks (%2)")).arg(finishedTaskCount()).arg(details.join(", "));
+}
+
+// --------------------------------
+// TaskProgressDelegate
+// --------------------------------
+
+Qtilities::CoreGui::TaskProgressDelegate::TaskProgressDelegate(QObject* parent) : QStyledItemDelegate(parent) {
+
+}
+
+void Qtilities::CoreGui::TaskProgressDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    if (index.data(TaskSummaryModel::SummaryRowRole).toBool()) {
+        QStyledItemDelegate::paint(painter,option,index);
+        return;
+    }
+
+    QStyle* style = option.widget ? option.widget->style() : QApplication::style();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem,&option,painter,option.widget);
+
+    QRect content_rect = option.rect.adjusted(4,2,-4,-2);
+    QRect stop_rect = stopButtonRect(option.rect);
+    if (index.data(TaskSummaryModel::CanStopRole).toBool()) {
+        static QIcon stop_icon(qti_icon_TASK_STOP_22x22);
+        stop_icon.paint(painter,stop_rect);
+    }
+
+    // Progress bar:
+    QStyleOptionProgressBar progress_option;
+    progress_option.state = option.state | QStyle::State_Enabled;
+    progress_option.direction = option.direction;
+    progress_option.fontMetrics = option.fontMetrics;
+    progress_option.palette = option.palette;
+    int bar_width = qMin(content_rect.width() / 2,qti_private_PROGRESS_BAR_WIDTH);
+    progress_option.rect = QRect(stop_rect.left() - 4 - bar_width,content_rect.top(),bar_width,content_rect.height());
+    int state = index.data(TaskSummaryModel::StateRole).toInt();
+    int sub_tasks = index.data(TaskSummaryModel::SubTaskCountRole).toInt();
+    progress_option.minimum = 0;
+    if (sub_tasks > 0) {
+        progress_option.maximum = sub_tasks;
+        progress_option.progress = qBound(0,index.data(TaskSummaryModel::ProgressRole).toInt(),sub_tasks);
+    } else if (state == ITask::TaskBusy || state == ITask::TaskPaused) {
+        // Busy indicator:
+        progress_option.maximum = 0;
+        progress_option.progress = 0;
+    } else {
+        progress_option.maximum = 1;
+        progress_option.progress = (state == ITask::TaskCompleted) ? 1 : 0;
+    }
+    progress_option.textVisible = sub_tasks > 0;
+    if (progress_option.textVisible)
+        progress_option.text = QString("%1%").arg(progress_option.progress * 100 / progress_option.maximum);
+    style->drawControl(QStyle::CE_ProgressBar,&progress_option,painter,option.widget);
+
+    // Task name:
+    QRect text_rect(content_rect.left(),content_rect.top(),progress_option.rect.left() - 4 - content_rect.left(),content_rect.height());
+    QString text = option.fontMetrics.elidedText(index.data(Qt::DisplayRole).toString(),Qt::ElideRight,text_rect.width());
+    painter->save();
+    painter->setPen(option.palette.color((option.state & QStyle::State_Selected) ? QPalette::HighlightedText : QPalette::Text));
+    painter->drawText(text_rect,Qt::AlignLeft | Qt::AlignVCenter,text);
+    painter->restore();
+}
+
+QSize Qtilities::CoreGui::TaskProgressDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    QSize size = QStyledItemDelegate::sizeHint(option,index);
+    size.setHeight(qMax(size.height(),qti_private_STOP_BUTTON_SIZE + 6));
+    return size;
+}
+
+bool Qtilities::CoreGui::TaskProgressDelegate::editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem& option, const QModelIndex& index) {
+    if (event->type() != QEvent::MouseButtonRelease || !index.data(TaskSummaryModel::CanStopRole).toBool())
+        return QStyledItemDelegate::editorEvent(event,model,option,index);
+
+    QMouseEvent* mouse_event = static_cast<QMouseEvent*> (event);
+    if (!stopButtonRect(option.rect).contains(mouse_event->pos()))
+        return QStyledItemDelegate::editorEvent(event,model,option,index);
+
+    TaskSummaryModel* task_model = qobject_cast<TaskSummaryModel*> (model);
+    if (!task_model)
+        return false;
+    QPointer<QObject> task_base;
+    ITask* task = task_model->task(index.data(TaskSummaryModel::TaskIdRole).toInt());
+    if (!task)
+        return false;
+    task_base = task->objectBase();
+
+    if (task->taskStopConfirmation() == ITask::TaskStopConfirmationMsgBox) {
+        QMessageBox msgBox;
+        msgBox.setIcon(QMessageBox::Question);
+        msgBox.setWindowTitle(QString(tr("Stop %1?")).arg(task->taskName()));
+        msgBox.setText(QString(tr("Are you sure you want to stop %1?")).arg(task->taskName()));
+        msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+        msgBox.setDefaultButton(QMessageBox::No);
+        if (msgBox.exec() != QMessageBox::Yes)
+            return true;
+    }
+
+    // The task might have been deleted while the message box was shown:
+    if (task_base && task->state() == ITask::TaskBusy) {
+        QApplication::setOverrideCursor(Qt::WaitCursor);
+        task->stop();
+        QApplication::restoreOverrideCursor();
+    }
+    return true;
+}
+
+QRect Qtilities::CoreGui::TaskProgressDelegate::stopButtonRect(const QRect& row_rect) const {
+    return QRect(row_rect.right() - 4 - qti_private_STOP_BUTTON_SIZE,row_rect.top() + (row_rect.height() - qti_private_STOP_BUTTON_SIZE) / 2,
+                 qti_private_STOP_BUTTON_SIZE,qti_private_STOP_BUTTON_SIZE);
+}
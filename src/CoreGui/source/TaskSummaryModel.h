@@ -0,0 +1,154 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TASK_SUMMARY_MODEL_H
+#define TASK_SUMMARY_MODEL_H
+
+#include "QtilitiesCoreGui_global.h"
+
+#include <ITask>
+
+#include <QAbstractListModel>
+#include <QStyledItemDelegate>
+
+namespace Qtilities {
+    namespace CoreGui {
+        using namespace Qtilities::Core::Interfaces;
+
+        /*!
+        \struct TaskSummaryModelPrivateData
+        \brief A structure storing private data in the TaskSummaryModel class.
+          */
+        struct TaskSummaryModelPrivateData;
+
+        /*!
+        \class TaskSummaryModel
+        \brief A list model showing the progress of tasks, used by TaskSummaryWidget when its view mode is TaskSummaryWidget::TaskItemView.
+
+        Tasks are added to the model using addTask() and shown as rows once setTaskDisplayed() was called for them. Changes to tasks, including
+        their progress, are collected and applied to the rows at most once every refreshInterval() milliseconds, thus tasks which complete thousands
+        of sub tasks per second do not cause thousands of repaints.
+
+        When aggregateFinishedTasks() is true, tasks which are completed or stopped when they are no longer displayed are counted in a single
+        summary row at the bottom of the model instead of disappearing. The summary row can be cleared using clearFinishedTasks().
+
+        Use the model with a QListView which has \p uniformItemSizes enabled and a TaskProgressDelegate.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILITIES_CORE_GUI_SHARED_EXPORT TaskSummaryModel : public QAbstractListModel
+        {
+            Q_OBJECT
+
+        public:
+            //! Custom roles provided by this model.
+            enum TaskSummaryRole {
+                TaskIdRole          = Qt::UserRole + 1,     /*!< The ID of the task, -1 for the summary row. */
+                ProgressRole        = Qt::UserRole + 2,     /*!< The number of completed sub tasks of the task. */
+                SubTaskCountRole    = Qt::UserRole + 3,     /*!< The number of sub tasks of the task, -1 when it is not known. */
+                StateRole           = Qt::UserRole + 4,     /*!< The ITask::TaskState of the task, as an int. */
+                ResultRole          = Qt::UserRole + 5,     /*!< The ITask::TaskResult of the task, as an int. */
+                CanStopRole         = Qt::UserRole + 6,     /*!< Indicates if the task can be stopped at present. */
+                SummaryRowRole      = Qt::UserRole + 7      /*!< True for the row which summarizes the finished tasks. */
+            };
+
+            TaskSummaryModel(QObject* parent = 0);
+            ~TaskSummaryModel();
+
+            int rowCount(const QModelIndex& parent = QModelIndex()) const;
+            QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+
+            //! Starts tracking \p task. The task is not displayed until setTaskDisplayed() is called for it.
+            void addTask(ITask* task);
+            //! Stops tracking the task with ID \p task_id and removes its row.
+            void removeTask(int task_id);
+            //! Indicates if the task with ID \p task_id is tracked by the model.
+            bool containsTask(int task_id) const;
+            //! Returns the task with ID \p task_id, or 0 if it is not tracked or was deleted.
+            ITask* task(int task_id) const;
+            //! Returns the IDs of all tracked tasks, including tasks which are not displayed.
+            QList<int> taskIds() const;
+
+            //! Shows or hides the row of the task with ID \p task_id. The rows are changed during the next refresh.
+            void setTaskDisplayed(int task_id, bool is_displayed);
+            //! Indicates if the task with ID \p task_id is displayed, or will be displayed after the next refresh.
+            bool isTaskDisplayed(int task_id) const;
+            //! Returns the IDs of the displayed tasks.
+            QList<int> displayedTaskIds() const;
+            //! Returns the number of displayed tasks, without the summary row.
+            int displayedTaskCount() const;
+
+            //! Sets the minimum time in milliseconds between updates of the rows. The default is 250.
+            void setRefreshInterval(int msec);
+            //! Returns the minimum time in milliseconds between updates of the rows.
+            int refreshInterval() const;
+            //! Sets if finished tasks which are no longer displayed are counted in a summary row. The default is true.
+            void setAggregateFinishedTasks(bool aggregate);
+            //! Indicates if finished tasks which are no longer displayed are counted in a summary row.
+            bool aggregateFinishedTasks() const;
+            //! Returns the number of finished tasks counted in the summary row.
+            int finishedTaskCount() const;
+
+        public slots:
+            //! Stops tracking all tasks and removes all rows.
+            void clear();
+            //! Resets the summary row.
+            void clearFinishedTasks();
+            //! Applies the pending changes to the rows immediately.
+            void refresh();
+
+        private slots:
+            //! Marks the task which sent the signal as changed.
+            void handleTaskChanged();
+            //! Stops tracking a deleted task.
+            void handleTaskDestroyed(QObject* obj);
+
+        private:
+            //! Starts the refresh timer if it is not running.
+            void scheduleRefresh();
+            //! Counts a finished task in the summary row.
+            void aggregateFinishedTask(ITask* task);
+            //! Returns the text of the summary row.
+            QString summaryText() const;
+
+            TaskSummaryModelPrivateData* d;
+        };
+
+        /*!
+        \class TaskProgressDelegate
+        \brief A delegate which paints the rows of a TaskSummaryModel as progress bars.
+
+        Each row shows the name of the task, a progress bar and a stop button when the task can be stopped. Nothing but the rows which
+        are visible are painted, and no widgets are created for tasks.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class QTILITIES_CORE_GUI_SHARED_EXPORT TaskProgressDelegate : public QStyledItemDelegate
+        {
+            Q_OBJECT
+
+        public:
+            TaskProgressDelegate(QObject* parent = 0);
+
+            void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const;
+            QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const;
+
+        protected:
+            bool editorEvent(QEvent* event, QAbstractItemModel* model, const QStyleOptionViewItem& option, const QModelIndex& index);
+
+        private:
+            //! Returns the area of the stop button in a row.
+            QRect stopButtonRect(const QRect& row_rect) const;
+        };
+    }
+}
+
+#endif // TASK_SUMMARY_MODEL_H
@@ -18,6 +18,8 @@
 #include <ITask>
 #include <QtilitiesCoreApplication>
 
+#include <QListView>
+
 using namespace Qtilities::CoreGui::Icons;
 using namespace Qtilities::CoreGui;
 using namespace Qtilities::Core::Interfaces;
@@ -25,7 +27,10 @@ using namespace Qtilities::Core;
 
 struct Qtilities::CoreGui::TaskSummaryWidgetPrivateData {
     TaskSummaryWidgetPrivateData() : task_summary_enabled(true),
-        last_number_of_displayed_tasks(-1) {}
+        last_number_of_displayed_tasks(-1),
+        view_mode(TaskSummaryWidget::SingleTaskWidgetView),
+        task_view(0),
+        task_model(0) {}
 
     QMap<int,QPointer<SingleTaskWidget> >           id_widget_map;
     TaskSummaryWidget::TaskDisplayOptions           display_options;
@@ -35,6 +40,9 @@ struct Qtilities::CoreGui::TaskSummaryWidgetPrivateData {
     bool                                            task_summary_enabled;
     int                                             last_number_of_displayed_tasks;
     QList<int>                                      displayed_filter_task_ids;
+    TaskSummaryWidget::TaskViewMode                 view_mode;
+    QListView*                                      task_view;
+    TaskSummaryModel*                               task_model;
 };
 
 Qtilities::CoreGui::TaskSummaryWidget::TaskSummaryWidget(TaskRemoveOption remove_options, TaskDisplayOptions display_options, QWidget* parent) :
@@ -55,7 +63,7 @@ Qtilities::CoreGui::TaskSummaryWidget::TaskSummaryWidget(TaskRemoveOption remove
     d->layout->setSpacing(0);
     d->layout->setAlignment(Qt::AlignBottom);
 
-    QObject::connect(OBJECT_MANAGER,SIGNAL(newObjectAdded(QObject*)),SLOT(addTask(QObject*)),Qt::UniqueConnection);
+    OBJECT_MANAGER->subscribeToInterface<ITask>(this,SLOT(addTask(QObject*)),0,false);
 }
 
 Qtilities::CoreGui::TaskSummaryWidget::~TaskSummaryWidget() {
@@ -107,6 +115,36 @@ void Qtilities::CoreGui::TaskSummaryWidget::setTaskSummaryEnabled(bool enable) {
     d->task_summary_enabled = enable;
 }
 
+TaskSummaryWidget::TaskViewMode Qtilities::CoreGui::TaskSummaryWidget::taskViewMode() const {
+    return d->view_mode;
+}
+
+void Qtilities::CoreGui::TaskSummaryWidget::setTaskViewMode(TaskViewMode task_view_mode) {
+    if (d->view_mode == task_view_mode)
+        return;
+
+    clear();
+    d->view_mode = task_view_mode;
+
+    if (d->view_mode == TaskItemView && !d->task_view) {
+        d->task_model = new TaskSummaryModel(this);
+        d->task_view = new QListView;
+        d->task_view->setUniformItemSizes(true);
+        d->task_view->setSelectionMode(QAbstractItemView::NoSelection);
+        d->task_view->setItemDelegate(new TaskProgressDelegate(d->task_view));
+        d->task_view->setModel(d->task_model);
+        d->layout->addWidget(d->task_view);
+    }
+    if (d->task_view)
+        d->task_view->setVisible(d->view_mode == TaskItemView);
+
+    findCurrentTasks();
+}
+
+TaskSummaryModel* Qtilities::CoreGui::TaskSummaryWidget::taskSummaryModel() const {
+    return d->task_model;
+}
+
 void Qtilities::CoreGui::TaskSummaryWidget::findCurrentTasks() {
     if (!d->task_summary_enabled)
         return;
@@ -129,6 +167,17 @@ void Qtilities::CoreGui::TaskSummaryWidget::clear() {
     }
 
     d->id_widget_map.clear();
+
+    if (d->task_model) {
+        QList<int> task_ids = d->task_model->taskIds();
+        for (int i = 0; i < task_ids.count(); ++i) {
+            ITask* task = d->task_model->task(task_ids.at(i));
+            if (task)
+                task->objectBase()->disconnect(this);
+        }
+        d->task_model->clear();
+    }
+
     hideIfNeeded();
 }
 
@@ -160,6 +209,9 @@ void TaskSummaryWidget::displayedTasksFilterRemoveId(int id) {
 QPointer<SingleTaskWidget> TaskSummaryWidget::getSingleTaskWidgetForTask(int task_id) {
     QPointer<SingleTaskWidget> widget;
 
+    if (d->view_mode == TaskItemView)
+        return widget;
+
     if (d->id_widget_map.contains(task_id))
         return d->id_widget_map[task_id];
 
@@ -174,15 +226,27 @@ void Qtilities::CoreGui::TaskSummaryWidget::addTask(QObject* obj) {
     if (task) {
         if (d->id_widget_map.contains(task->taskID()))
             return;
+        if (d->task_model && d->task_model->containsTask(task->taskID()))
+            return;
 
         connect(task->objectBase(),SIGNAL(taskStarted(int,QString,Logger::MessageType)),SLOT(handleTaskStateChanged()));
-        connect(task->objectBase(),SIGNAL(subTaskCompleted(int,QString,Logger::MessageType)),SLOT(handleTaskStateChanged()));
+        // Completed sub tasks do not change the state of a task, thus they don't change its visibility. The progress itself is shown by the SingleTaskWidget.
         connect(task->objectBase(),SIGNAL(taskCompleted(ITask::TaskResult,QString,Logger::MessageType)),SLOT(handleTaskStateChanged()));
         connect(task->objectBase(),SIGNAL(taskPaused()),SLOT(handleTaskStateChanged()));
         connect(task->objectBase(),SIGNAL(taskResumed()),SLOT(handleTaskStateChanged()));
         connect(task->objectBase(),SIGNAL(taskStopped()),SLOT(handleTaskStateChanged()));
 
         if (task->taskType() == ITask::TaskGlobal || (task->taskType() == ITask::TaskLocal && d->displayed_filter_task_ids.contains(task->taskID()))) {
+            if (d->view_mode == TaskItemView) {
+                // Tasks which would start out hidden are not displayed, thus they are never counted as finished tasks:
+                d->task_model->addTask(task);
+                if (taskVisibilityChange(task) != 0)
+                    d->task_model->setTaskDisplayed(task->taskID(),true);
+                connect(task->objectBase(),SIGNAL(taskTypeChanged(ITask::TaskType)),SLOT(handleTaskTypeChanged()),Qt::UniqueConnection);
+                hideIfNeeded();
+                return;
+            }
+
             SingleTaskWidget* task_widget = TaskManagerGui::instance()->singleTaskWidget(task->taskID());
             task_widget->setPauseButtonVisible(false);
             task_widget->setStopButtonVisible(true);
@@ -227,6 +291,11 @@ void Qtilities::CoreGui::TaskSummaryWidget::handleTaskTypeChanged() {
     if (!sender_task)
         return;
 
+    if (d->view_mode == TaskItemView) {
+        updateTaskWidget(sender_task);
+        return;
+    }
+
     for (int i = 0; i < d->id_widget_map.count(); ++i) {
         if (d->id_widget_map.keys().at(i) == sender_task->taskID()) {
             // Disconnect from task:
@@ -250,53 +319,83 @@ void Qtilities::CoreGui::TaskSummaryWidget::handleTaskStateChanged() {
 
 void Qtilities::CoreGui::TaskSummaryWidget::updateTaskWidget(ITask* task) {
     if (task) {
-        QPointer<SingleTaskWidget> task_widget = d->id_widget_map[task->taskID()];
-        if (!task_widget)
-            return;
-
-        if (task->taskType() == ITask::TaskLocal && !d->displayed_filter_task_ids.contains(task->taskID())) {
-            task_widget->hide();
-        } else if (task->taskType() == ITask::TaskGlobal || (d->displayed_filter_task_ids.contains(task->taskID()) && task->taskType() == ITask::TaskLocal)) {
-            if (task->state() == ITask::TaskCompleted) {
-                if (d->display_options == DisplayOnlyBusyTasks) {
-                    if (task->result() == ITask::TaskSuccessful) {
-                        if (d->remove_options & RemoveWhenCompletedSuccessfully)
-                            task_widget->hide();
-                    } else if (task->result() == ITask::TaskSuccessfulWithWarnings) {
-                        if (d->remove_options & RemoveWhenCompletedSuccessfullyWithWarnings)
-                            task_widget->hide();
-                    } else if (task->result() == ITask::TaskFailed) {
-                        if (d->remove_options & RemoveWhenFailed)
-                            task_widget->hide();
-                    } else if (task->result() == ITask::TaskNoResult) {
-                        // Do nothing, we should never get in here.
-                    }
-                }
-            } else if (task->state() == ITask::TaskNotStarted) {
-                if (task->canStart()) {
-                    task_widget->show();
-                } else {
-                    if (d->display_options == DisplayOnlyBusyTasks)
-                        task_widget->hide();
-                    else if (d->display_options == DisplayAllTasks)
-                        task_widget->show();
-                }
-            } else if (task->state() == ITask::TaskPaused) {
+        if (d->view_mode == TaskItemView) {
+            if (!d->task_model->containsTask(task->taskID()))
+                return;
+
+            int visibility_change = taskVisibilityChange(task);
+            if (visibility_change != -1)
+                d->task_model->setTaskDisplayed(task->taskID(),visibility_change == 1);
+        } else {
+            QPointer<SingleTaskWidget> task_widget = d->id_widget_map[task->taskID()];
+            if (!task_widget)
+                return;
+
+            int visibility_change = taskVisibilityChange(task);
+            if (visibility_change == 0)
+                task_widget->hide();
+            else if (visibility_change == 1)
                 task_widget->show();
-            } else if (task->state() == ITask::TaskStopped) {
-                if (d->remove_options & RemoveWhenStopped)
-                    task_widget->hide();
-            } else if (task->state() == ITask::TaskBusy) {
-                task_widget->show();
-            }
         }
 
         hideIfNeeded();
     }
 }
 
+int Qtilities::CoreGui::TaskSummaryWidget::taskVisibilityChange(ITask* task) const {
+    if (task->taskType() == ITask::TaskLocal && !d->displayed_filter_task_ids.contains(task->taskID())) {
+        return 0;
+    } else if (task->taskType() == ITask::TaskGlobal || (d->displayed_filter_task_ids.contains(task->taskID()) && task->taskType() == ITask::TaskLocal)) {
+        if (task->state() == ITask::TaskCompleted) {
+            if (d->display_options == DisplayOnlyBusyTasks) {
+                if (task->result() == ITask::TaskSuccessful) {
+                    if (d->remove_options & RemoveWhenCompletedSuccessfully)
+                        return 0;
+                } else if (task->result() == ITask::TaskSuccessfulWithWarnings) {
+                    if (d->remove_options & RemoveWhenCompletedSuccessfullyWithWarnings)
+                        return 0;
+                } else if (task->result() == ITask::TaskFailed) {
+                    if (d->remove_options & RemoveWhenFailed)
+                        return 0;
+                } else if (task->result() == ITask::TaskNoResult) {
+                    // Do nothing, we should never get in here.
+                }
+            }
+        } else if (task->state() == ITask::TaskNotStarted) {
+            if (task->canStart()) {
+                return 1;
+            } else {
+                if (d->display_options == DisplayOnlyBusyTasks)
+                    return 0;
+                else if (d->display_options == DisplayAllTasks)
+                    return 1;
+            }
+        } else if (task->state() == ITask::TaskPaused) {
+            return 1;
+        } else if (task->state() == ITask::TaskStopped) {
+            if (d->remove_options & RemoveWhenStopped)
+                return 0;
+        } else if (task->state() == ITask::TaskBusy) {
+            return 1;
+        }
+    }
+
+    return -1;
+}
+
 void Qtilities::CoreGui::TaskSummaryWidget::hideIfNeeded() {
     int num_displayed_tasks = 0;
+    if (d->view_mode == TaskItemView) {
+        if (!d->displayed_filter_task_ids.isEmpty()) {
+            QList<int> displayed_task_ids = d->task_model->displayedTaskIds();
+            for (int i = 0; i < displayed_task_ids.count(); ++i) {
+                if (!d->displayed_filter_task_ids.contains(displayed_task_ids.at(i)))
+                    d->task_model->setTaskDisplayed(displayed_task_ids.at(i),false);
+            }
+        }
+        num_displayed_tasks = d->task_model->displayedTaskCount();
+    }
+
     QList<QPointer<SingleTaskWidget> > id_widget_map_values = d->id_widget_map.values();
     for (int i = 0; i < d->id_widget_map.count(); ++i) {
         QPointer<SingleTaskWidget> task_widget = id_widget_map_values.at(i);
@@ -14,6 +14,7 @@
 
 #include "QtilitiesCoreGui_global.h"
 #include "SingleTaskWidget.h"
+#include "TaskSummaryModel.h"
 
 #include <QMainWindow>
 
@@ -61,6 +62,9 @@ task_summary_widget.findCurrentTasks();
         it very easy to provide an overview of tasks in your application. The <a class="el" href="namespace_qtilities_1_1_examples_1_1_tasks_example.html">Tasking Example</a>
         demonstrates this.
 
+        By default every displayed task is shown using its own SingleTaskWidget. Applications which run thousands of concurrent tasks should
+        use the TaskItemView mode instead, see setTaskViewMode().
+
         See the \ref page_tasking article for more information on tasking.
 
         <i>This class was added in %Qtilities v1.0.</i>
@@ -103,6 +107,17 @@ task_summary_widget.findCurrentTasks();
                 RemoveDefault                                       = RemoveWhenCompletedSuccessfully
             };
             Q_ENUMS(TaskRemoveOption)
+            //! The possible ways in which the summary widget shows tasks.
+            /*!
+              Default is SingleTaskWidgetView.
+
+              <i>This enumeration was added in %Qtilities v1.5.</i>
+              */
+            enum TaskViewMode {
+                SingleTaskWidgetView                                = 0,  /*!< Each task is shown using its own SingleTaskWidget. */
+                TaskItemView                                        = 1   /*!< Tasks are shown as rows of a single list view using a TaskSummaryModel and a TaskProgressDelegate. No widgets are created for tasks, and progress updates are coalesced. Finished tasks which are removed are counted in a summary row. */
+            };
+            Q_ENUMS(TaskViewMode)
             Q_DECLARE_FLAGS(TaskRemoveOptionFlags, TaskRemoveOption)
             Q_FLAGS(TaskRemoveOptionFlags)
 
@@ -133,6 +148,26 @@ task_summary_widget.findCurrentTasks();
               */
             void setTaskSummaryEnabled(bool enable);
 
+            //! Gets the TaskViewMode for this summary widget.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            TaskViewMode taskViewMode() const;
+            //! Sets the TaskViewMode for this summary widget.
+            /*!
+              Changing the view mode clears the widget and searches for the current tasks again.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setTaskViewMode(TaskViewMode task_view_mode);
+            //! Returns the model used to display tasks in the TaskItemView mode.
+            /*!
+              \returns The model, or null when the TaskItemView mode was never used.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            TaskSummaryModel* taskSummaryModel() const;
+
             //! Function which will search for all tasks in the global object pool and show them according to how the widget is set up.
             void findCurrentTasks();
             //! Function which will clear all current tasks shown by the summary widget.
@@ -172,7 +207,7 @@ task_summary_widget.findCurrentTasks();
             /*!
              * \returns The SingleTaskWidget if such a widget exists for the specified task at the time when this
              * function is called. Null if no such widget exists for the specified task at the time when this function is
-             * called.
+             * called. Always null in the TaskItemView mode.
              *
              * <i>This function was added in %Qtilities v1.5.</i>
              */
@@ -202,6 +237,8 @@ task_summary_widget.findCurrentTasks();
             void addSingleTaskWidget(SingleTaskWidget* single_task_widget);
             //! Updates the display of a single task.
             void updateTaskWidget(ITask* task);
+            //! Returns how the display of a task must change: -1 when it must not change, 0 when it must be hidden and 1 when it must be shown.
+            int taskVisibilityChange(ITask* task) const;
 
             Ui::TaskSummaryWidget *ui;
             TaskSummaryWidgetPrivateData* d;
@@ -0,0 +1,188 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TreeBuilder.h"
+#include "TreeNode.h"
+#include "TreeItem.h"
+
+#include <QtilitiesCoreConstants>
+
+#include <QIODevice>
+#include <QPointer>
+#include <QSet>
+#include <QTextStream>
+
+using namespace Qtilities::Core::Properties;
+
+struct Qtilities::CoreGui::TreeBuilderPrivateData {
+    TreeBuilderPrivateData() : row_count(0) { }
+
+    QPointer<TreeNode>              tree_node;
+    //! The categories of the rows in the order in which they were seen.
+    QList<QtilitiesCategory>        categories;
+    //! The index of each category in categories and category_names.
+    QHash<QtilitiesCategory,int>    category_indexes;
+    //! The names of the rows in each category.
+    QList<QStringList>              category_names;
+    int                             row_count;
+};
+
+Qtilities::CoreGui::TreeBuilder::TreeBuilder(TreeNode* tree_node) {
+    d = new TreeBuilderPrivateData;
+    d->tree_node = tree_node;
+}
+
+Qtilities::CoreGui::TreeBuilder::~TreeBuilder() {
+    delete d;
+}
+
+Qtilities::CoreGui::TreeNode* Qtilities::CoreGui::TreeBuilder::treeNode() const {
+    return d->tree_node;
+}
+
+void Qtilities::CoreGui::TreeBuilder::addRow(const QString& name, const QtilitiesCategory& category) {
+    int category_index = d->category_indexes.value(category,-1);
+    if (category_index == -1) {
+        category_index = d->categories.count();
+        d->categories << category;
+        d->category_indexes[category] = category_index;
+        d->category_names << QStringList();
+    }
+
+    d->category_names[category_index] << name;
+    ++d->row_count;
+}
+
+void Qtilities::CoreGui::TreeBuilder::addRows(const QStringList& names, const QtilitiesCategory& category) {
+    if (names.isEmpty())
+        return;
+
+    // Add the first row on its own to make sure the category exists:
+    addRow(names.front(),category);
+    int category_index = d->category_indexes.value(category);
+    for (int i = 1; i < names.count(); ++i)
+        d->category_names[category_index] << names.at(i);
+    d->row_count += names.count() - 1;
+}
+
+int Qtilities::CoreGui::TreeBuilder::addRows(RowSource* source) {
+    if (!source)
+        return 0;
+
+    int read_count = 0;
+    Row row;
+    while (source->readRow(row)) {
+        addRow(row.name,row.category);
+        ++read_count;
+    }
+    return read_count;
+}
+
+int Qtilities::CoreGui::TreeBuilder::addRows(QIODevice* device, const QString& column_separator, const QString& category_separator) {
+    if (!device)
+        return -1;
+    if (!device->isOpen() && !device->open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+
+    int read_count = 0;
+    QTextStream stream(device);
+    while (!stream.atEnd()) {
+        const QString line = stream.readLine();
+        if (line.trimmed().isEmpty())
+            continue;
+
+        int separator_index = column_separator.isEmpty() ? -1 : line.indexOf(column_separator);
+        if (separator_index == -1) {
+            addRow(line.trimmed());
+        } else {
+            const QString category_string = line.mid(separator_index + column_separator.length()).trimmed();
+            if (category_string.isEmpty())
+                addRow(line.left(separator_index).trimmed());
+            else
+                addRow(line.left(separator_index).trimmed(),QtilitiesCategory(category_string,category_separator));
+        }
+        ++read_count;
+    }
+    return read_count;
+}
+
+int Qtilities::CoreGui::TreeBuilder::rowCount() const {
+    return d->row_count;
+}
+
+int Qtilities::CoreGui::TreeBuilder::categoryCount() const {
+    return d->categories.count();
+}
+
+void Qtilities::CoreGui::TreeBuilder::clear() {
+    d->categories.clear();
+    d->category_indexes.clear();
+    d->category_names.clear();
+    d->row_count = 0;
+}
+
+QList<Qtilities::CoreGui::TreeItem*> Qtilities::CoreGui::TreeBuilder::finish(QString* rejectMsg) {
+    QList<TreeItem*> items;
+    TreeNode* tree_node = d->tree_node;
+    if (!tree_node || d->row_count == 0) {
+        clear();
+        return items;
+    }
+
+    // Create all items in one go, and set up their names and categories before they are attached. At this point the
+    // node does not watch the items, thus setting their properties does not cause any notifications:
+    QList<QObject*> objects = TreeItem::factory.createInstances(d->row_count);
+    int object_index = 0;
+    for (int i = 0; i < d->categories.count(); ++i) {
+        const QtilitiesCategory& category = d->categories.at(i);
+        const QStringList& names = d->category_names.at(i);
+
+        // All items in a category share the same property value:
+        MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
+        if (category.isValid())
+            category_property.setValue(qVariantFromValue(category),tree_node->observerID());
+
+        for (int n = 0; n < names.count(); ++n) {
+            QObject* obj = objects.at(object_index++);
+            obj->setObjectName(names.at(n));
+            if (category.isValid())
+                ObjectManager::setMultiContextProperty(obj,category_property);
+        }
+    }
+    clear();
+
+    // Attach everything in one batch inside a processing cycle, thus views are refreshed once when the cycle ends:
+    tree_node->startProcessingCycle();
+    QList<QPointer<QObject> > attached_objects = tree_node->attachSubjects(objects,Observer::SpecificObserverOwnership,rejectMsg);
+
+    // Rejected items are not managed by the node, thus we delete them:
+    if (attached_objects.count() != objects.count()) {
+        QSet<QObject*> attached_set;
+        for (int i = 0; i < attached_objects.count(); ++i)
+            attached_set.insert(attached_objects.at(i));
+        for (int i = 0; i < objects.count(); ++i) {
+            if (!attached_set.contains(objects.at(i)))
+                delete objects.at(i);
+        }
+    }
+
+    items.reserve(attached_objects.count());
+    for (int i = 0; i < attached_objects.count(); ++i) {
+        TreeItem* item = qobject_cast<TreeItem*> (attached_objects.at(i));
+        if (item) {
+            item->setModificationState(false,IModificationNotifier::NotifyNone);
+            items << item;
+        }
+    }
+    tree_node->endProcessingCycle();
+
+    return items;
+}
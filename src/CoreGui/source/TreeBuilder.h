@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TREE_BUILDER_H
+#define TREE_BUILDER_H
+
+#include "QtilitiesCoreGui_global.h"
+
+#include <QtilitiesCategory>
+
+#include <QString>
+#include <QStringList>
+
+class QIODevice;
+
+namespace Qtilities {
+    namespace CoreGui {
+        using namespace Qtilities::Core;
+
+        class TreeNode;
+        class TreeItem;
+
+        /*!
+        \struct TreeBuilderPrivateData
+        \brief Structure used by TreeBuilder to store private data.
+          */
+        struct TreeBuilderPrivateData;
+
+        /*!
+          \class TreeBuilder
+          \brief The TreeBuilder class populates a TreeNode with large numbers of tree items from external data sources.
+
+          TreeNode::addItem() and TreeNode::addItems() attach every item on its own: each item is validated by the subject filters of the node,
+          gets its category property while the node is watching it and causes its own change notifications. When a node is populated from
+          external data, for example from a file or a database cursor, the TreeBuilder class avoids this per item overhead:
+
+          - Rows are collected and grouped by category as they are streamed in, without creating any objects.
+          - When finish() is called, all items are created in one call to the bulk creation path of the TreeItem factory (see Factory::createInstances()).
+          - Items in the same category share a single category property value, which is set before the items are attached.
+          - All items are attached in one Observer::attachSubjects() call, thus the subject filters of the node validate them as a batch.
+          - The node is kept in a processing cycle for the whole operation, thus the new subtree is published with a single notification.
+
+          Rows can be added one at a time using addRow(), from a TreeBuilder::RowSource implementation which wraps an iterator, generator or database
+          cursor, or directly from a text device using addRows(QIODevice*):
+
+\code
+TreeNode* node = new TreeNode("Parts");
+node->enableCategorizedDisplay();
+
+QFile file("parts.csv");
+if (file.open(QFile::ReadOnly)) {
+    TreeBuilder builder(node);
+    builder.addRows(&file);
+    builder.finish();
+}
+\endcode
+
+          The builder does not change the node before finish() is called. When the builder is destructed before finish() was called, the
+          collected rows are discarded.
+
+          \note Only plain TreeItem items are created by the builder. Nodes, and items of your own classes, must still be added using TreeNode::addNode() and TreeNode::addItem().
+
+          <i>This class was added in %Qtilities v1.5.</i>
+        */
+        class QTILITIES_CORE_GUI_SHARED_EXPORT TreeBuilder
+        {
+        public:
+            //! A row which describes one tree item.
+            struct Row {
+                //! The name of the item.
+                QString             name;
+                //! The category of the item, which can be invalid when the item does not belong to a category.
+                QtilitiesCategory   category;
+            };
+
+            //! Interface through which rows are streamed into a TreeBuilder.
+            /*!
+              Implement this interface to wrap an iterator, generator or database cursor and pass it to TreeBuilder::addRows(RowSource*).
+              */
+            class QTILITIES_CORE_GUI_SHARED_EXPORT RowSource {
+            public:
+                RowSource() {}
+                virtual ~RowSource() {}
+
+                //! Reads the next row into \p row.
+                /*!
+                  \returns True when \p row was read, false when the source does not have more rows.
+                  */
+                virtual bool readRow(Row& row) = 0;
+            };
+
+            //! Constructs a builder which adds items to \p tree_node.
+            TreeBuilder(TreeNode* tree_node);
+            ~TreeBuilder();
+
+            //! Returns the tree node to which items are added.
+            TreeNode* treeNode() const;
+
+            //! Adds a row for an item called \p name in \p category.
+            void addRow(const QString& name, const QtilitiesCategory& category = QtilitiesCategory());
+            //! Adds a row for each name in \p names, all in \p category.
+            void addRows(const QStringList& names, const QtilitiesCategory& category = QtilitiesCategory());
+            //! Adds all rows read from \p source.
+            /*!
+              \returns The number of rows which were read.
+              */
+            int addRows(RowSource* source);
+            //! Adds a row for every non-empty line read from \p device.
+            /*!
+              Every line contains the name of an item, optionally followed by \p column_separator and the category of the item. The levels of the category
+              are separated by \p category_separator. For example, the line <tt>Bolt M8,Hardware::Bolts</tt> adds an item called <tt>Bolt M8</tt> in the
+              <tt>Bolts</tt> category under the <tt>Hardware</tt> category. Leading and trailing whitespace is removed from names and categories.
+
+              Lines are read as they are needed, thus \p device can be a large file or a sequential device. When \p device is not open it is opened in read only mode.
+
+              \returns The number of rows which were read, or -1 when \p device could not be opened.
+              */
+            int addRows(QIODevice* device, const QString& column_separator = ",", const QString& category_separator = "::");
+
+            //! Returns the number of rows which were added since the builder was constructed or since finish() or clear() were called.
+            int rowCount() const;
+            //! Returns the number of different categories in the rows which were added.
+            int categoryCount() const;
+            //! Removes all rows which were added without changing the tree node.
+            void clear();
+
+            //! Creates the items for all rows which were added and attaches them to the tree node.
+            /*!
+              The tree node manages the lifetime of the items, the same way it does for items created using TreeNode::addItem(). Items which were rejected
+              by the subject filters of the node are deleted. Views showing the node are refreshed once after all items were attached.
+
+              After this call the builder is empty and can be used to add more rows to the node.
+
+              \param rejectMsg When items were rejected, the rejection message is available through this parameter if a valid QString reference is provided.
+              \returns The items which were attached. Items are grouped by category in the order in which their categories were seen.
+              */
+            QList<TreeItem*> finish(QString* rejectMsg = 0);
+
+        private:
+            Q_DISABLE_COPY(TreeBuilder)
+
+            TreeBuilderPrivateData* d;
+        };
+    }
+}
+
+#endif // TREE_BUILDER_H
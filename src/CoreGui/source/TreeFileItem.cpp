@@ -297,6 +297,7 @@ QString Qtilities::CoreGui::TreeFileItem::actualFilePath() const {
 }
 
 bool Qtilities::CoreGui::TreeFileItem::exists() const {
+    // Not cached, callers expect changes they made themselves to be reflected immediately:
     QFileInfo file_info(treeFileItemBase->file_info.actualFilePath());
     return file_info.exists();
 }
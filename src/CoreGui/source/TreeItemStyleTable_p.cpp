@@ -0,0 +1,181 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TreeItemStyleTable_p.h"
+
+#include <QtilitiesCoreConstants.h>
+#include <ObjectManager.h>
+
+#include <QDataStream>
+#include <QIcon>
+#include <QFont>
+#include <QBrush>
+#include <QSize>
+#include <QMutex>
+
+using namespace Qtilities::Core;
+using namespace Qtilities::Core::Properties;
+
+bool Qtilities::CoreGui::TreeItemStyle::isStyleRole(int role) {
+    return (role == Qt::DecorationRole || role == Qt::FontRole || role == Qt::ForegroundRole || role == Qt::BackgroundRole
+            || role == Qt::TextAlignmentRole || role == Qt::SizeHintRole);
+}
+
+QVariant Qtilities::CoreGui::TreeItemStyle::data(int role) const {
+    if (role == Qt::DecorationRole)
+        return decoration;
+    else if (role == Qt::FontRole)
+        return font;
+    else if (role == Qt::ForegroundRole)
+        return foreground;
+    else if (role == Qt::BackgroundRole)
+        return background;
+    else if (role == Qt::TextAlignmentRole)
+        return alignment;
+    else if (role == Qt::SizeHintRole)
+        return size_hint;
+
+    return QVariant();
+}
+
+void Qtilities::CoreGui::TreeItemStyle::setData(int role, const QVariant& value) {
+    if (role == Qt::DecorationRole)
+        decoration = value;
+    else if (role == Qt::FontRole)
+        font = value;
+    else if (role == Qt::ForegroundRole)
+        foreground = value;
+    else if (role == Qt::BackgroundRole)
+        background = value;
+    else if (role == Qt::TextAlignmentRole)
+        alignment = value;
+    else if (role == Qt::SizeHintRole)
+        size_hint = value;
+}
+
+bool Qtilities::CoreGui::TreeItemStyle::isEmpty() const {
+    return !decoration.isValid() && !font.isValid() && !foreground.isValid() && !background.isValid()
+            && !alignment.isValid() && !size_hint.isValid();
+}
+
+Qtilities::CoreGui::TreeItemStyleTable* Qtilities::CoreGui::TreeItemStyleTable::m_Instance = 0;
+
+Qtilities::CoreGui::TreeItemStyleTable* Qtilities::CoreGui::TreeItemStyleTable::instance() {
+    static QMutex mutex;
+    if (!m_Instance)
+    {
+        mutex.lock();
+
+        if (!m_Instance)
+            m_Instance = new TreeItemStyleTable;
+
+        mutex.unlock();
+    }
+
+    return m_Instance;
+}
+
+Qtilities::CoreGui::TreeItemStyleTable::TreeItemStyleTable() {
+    // Id 0 is the empty style:
+    TreeItemStyle empty_style;
+    d_styles << empty_style;
+    d_style_ids[styleKey(empty_style)] = 0;
+}
+
+int Qtilities::CoreGui::TreeItemStyleTable::styleId(const TreeItemStyle& style) {
+    if (style.isEmpty())
+        return 0;
+
+    QByteArray key = styleKey(style);
+    {
+        QReadLocker locker(&d_lock);
+        QHash<QByteArray,int>::const_iterator itr = d_style_ids.constFind(key);
+        if (itr != d_style_ids.constEnd())
+            return itr.value();
+    }
+
+    QWriteLocker locker(&d_lock);
+    // Another thread might have interned the style in the meantime:
+    QHash<QByteArray,int>::const_iterator itr = d_style_ids.constFind(key);
+    if (itr != d_style_ids.constEnd())
+        return itr.value();
+
+    int id = d_styles.count();
+    d_styles << style;
+    d_style_ids[key] = id;
+    return id;
+}
+
+Qtilities::CoreGui::TreeItemStyle Qtilities::CoreGui::TreeItemStyleTable::style(int id) const {
+    QReadLocker locker(&d_lock);
+    if (id > 0 && id < d_styles.count())
+        return d_styles.at(id);
+
+    return TreeItemStyle();
+}
+
+QVariant Qtilities::CoreGui::TreeItemStyleTable::data(int id, int role) const {
+    if (id <= 0)
+        return QVariant();
+
+    QReadLocker locker(&d_lock);
+    if (id < d_styles.count())
+        return d_styles.at(id).data(role);
+
+    return QVariant();
+}
+
+int Qtilities::CoreGui::TreeItemStyleTable::styleIdOf(const QObject* obj) {
+    if (!obj)
+        return 0;
+
+    SharedProperty style_property = ObjectManager::getSharedProperty(obj,qti_prop_STYLE);
+    if (style_property.isValid())
+        return style_property.value().toInt();
+
+    return 0;
+}
+
+QVariant Qtilities::CoreGui::TreeItemStyleTable::roleDataOf(const QObject* obj, int role) {
+    int id = styleIdOf(obj);
+    if (id == 0)
+        return QVariant();
+
+    return instance()->data(id,role);
+}
+
+QByteArray Qtilities::CoreGui::TreeItemStyleTable::styleKey(const TreeItemStyle& style) {
+    // Icons are compared using their cache keys, which copies of an icon share. All other roles are compared by value.
+    QByteArray key;
+    QDataStream stream(&key,QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_4_7);
+
+    stream << style.decoration.isValid();
+    if (style.decoration.isValid())
+        stream << style.decoration.value<QIcon>().cacheKey();
+    stream << style.font.isValid();
+    if (style.font.isValid())
+        stream << style.font.value<QFont>().toString();
+    stream << style.foreground.isValid();
+    if (style.foreground.isValid())
+        stream << style.foreground.value<QBrush>();
+    stream << style.background.isValid();
+    if (style.background.isValid())
+        stream << style.background.value<QBrush>();
+    stream << style.alignment.isValid();
+    if (style.alignment.isValid())
+        stream << (qint32) style.alignment.toInt();
+    stream << style.size_hint.isValid();
+    if (style.size_hint.isValid())
+        stream << style.size_hint.toSize();
+
+    return key;
+}
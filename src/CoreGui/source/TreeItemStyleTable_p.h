@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TREE_ITEM_STYLE_TABLE_P_H
+#define TREE_ITEM_STYLE_TABLE_P_H
+
+#include <QVariant>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+#include <QReadWriteLock>
+
+namespace Qtilities {
+    namespace CoreGui {
+        /*!
+          \struct TreeItemStyle
+          \brief The formatting roles of a tree item which are interned by TreeItemStyleTable.
+
+          Roles which are not set are invalid QVariants.
+         */
+        struct TreeItemStyle {
+            //! Returns true if \p role is one of the roles stored in a style.
+            static bool isStyleRole(int role);
+
+            //! Returns the data of \p role, or an invalid QVariant when it is not set.
+            QVariant data(int role) const;
+            //! Sets the data of \p role, an invalid \p value removes the role from the style.
+            void setData(int role, const QVariant& value);
+            //! Returns true if none of the roles are set.
+            bool isEmpty() const;
+
+            QVariant decoration;
+            QVariant font;
+            QVariant foreground;
+            QVariant background;
+            QVariant alignment;
+            QVariant size_hint;
+        };
+
+        /*!
+          \class TreeItemStyleTable
+          \brief The TreeItemStyleTable class interns the styles of tree items, thus items which are formatted the same share one record.
+
+          Every distinct style is stored once and is referenced by a small id, which AbstractTreeItem stores in the
+          qti_prop_STYLE property of its object. Id 0 is the empty style. Styles are never released, they are
+          small and the number of distinct styles used by an application is bounded by its formatting choices.
+
+          Styles are interned from any thread, while item models read them from the GUI thread.
+         */
+        class TreeItemStyleTable {
+        public:
+            static TreeItemStyleTable* instance();
+
+            //! Returns the id of \p style, interning it when it is not in the table yet.
+            int styleId(const TreeItemStyle& style);
+            //! Returns the style with the given id, or the empty style when the id is not valid.
+            TreeItemStyle style(int id) const;
+            //! Returns the data of \p role in the style with the given id.
+            QVariant data(int id, int role) const;
+
+            //! Returns the id of the style of \p obj, or 0 when it does not have a style.
+            static int styleIdOf(const QObject* obj);
+            //! Returns the data of \p role in the style of \p obj, or an invalid QVariant when its style does not provide the role.
+            static QVariant roleDataOf(const QObject* obj, int role);
+
+        private:
+            TreeItemStyleTable();
+            static QByteArray styleKey(const TreeItemStyle& style);
+
+            static TreeItemStyleTable*      m_Instance;
+
+            mutable QReadWriteLock          d_lock;
+            QVector<TreeItemStyle>          d_styles;
+            QHash<QByteArray,int>           d_style_ids;
+        };
+    }
+}
+
+#endif // TREE_ITEM_STYLE_TABLE_P_H
@@ -10,6 +10,7 @@
 ****************************************************************************/
 
 #include "TreeNode.h"
+#include "TreeBuilder.h"
 #include "QtilitiesCoreGuiConstants.h"
 #include "QtilitiesApplication.h"
 
@@ -30,6 +31,8 @@ struct Qtilities::CoreGui::TreeNodePrivateData {
     QPointer<NamingPolicyFilter>    naming_policy_filter;
     QPointer<ActivityPolicyFilter>  activity_policy_filter;
     QPointer<SubjectTypeFilter>     subject_type_filter;
+    //! The value items under the node, see TreeNode::addValueItem().
+    QStringList                     value_items;
 };
 
 Qtilities::CoreGui::TreeNode::TreeNode(const QString& name, QObject* parent) : Observer(name,QString(),parent), AbstractTreeItem() {
@@ -49,10 +52,35 @@ Qtilities::CoreGui::TreeNode::~TreeNode() {
 }
 
 Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::CoreGui::TreeNode::exportFormattingXML(QDomDocument* doc, QDomElement* object_node, Qtilities::ExportVersion version) const {
-    return saveFormattingToXML(doc,object_node,version);
+    IExportable::ExportResultFlags result = saveFormattingToXML(doc,object_node,version);
+    if (result == IExportable::Failed || nodeData->value_items.isEmpty())
+        return result;
+
+    // Value items are exported next to the formatting of the node:
+    QDomElement value_items_data = doc->createElement("ValueItems");
+    for (int i = 0; i < nodeData->value_items.count(); ++i) {
+        QDomElement value_item = doc->createElement("ValueItem");
+        value_item.setAttribute("Name",nodeData->value_items.at(i));
+        value_items_data.appendChild(value_item);
+    }
+    object_node->appendChild(value_items_data);
+
+    return result;
 }
 
 Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::CoreGui::TreeNode::importFormattingXML(QDomDocument* doc, QDomElement* object_node, Qtilities::ExportVersion version) {
+    if (object_node->tagName() == QLatin1String("ValueItems")) {
+        QStringList names;
+        QDomNodeList value_item_nodes = object_node->childNodes();
+        for (int i = 0; i < value_item_nodes.count(); ++i) {
+            QDomElement value_item = value_item_nodes.item(i).toElement();
+            if (!value_item.isNull() && value_item.tagName() == QLatin1String("ValueItem"))
+                names << value_item.attribute("Name");
+        }
+        addValueItems(names);
+        return IExportable::Complete;
+    }
+
     return loadFormattingFromXML(doc,object_node,version);
 }
 
@@ -265,11 +293,63 @@ Qtilities::CoreGui::TreeItem* Qtilities::CoreGui::TreeNode::addItem(const QStrin
 }
 
 void Qtilities::CoreGui::TreeNode::addItems(const QStringList& items, const QtilitiesCategory& category) {
-    startProcessingCycle();
-    foreach (const QString& item, items) {
-        addItem(item,category);
-    }
-    endProcessingCycle();
+    TreeBuilder builder(this);
+    builder.addRows(items,category);
+    builder.finish();
+}
+
+void Qtilities::CoreGui::TreeNode::addValueItem(const QString& name) {
+    nodeData->value_items << name;
+    setModificationState(true);
+    refreshViewsLayout();
+}
+
+void Qtilities::CoreGui::TreeNode::addValueItems(const QStringList& names) {
+    if (names.isEmpty())
+        return;
+
+    nodeData->value_items << names;
+    setModificationState(true);
+    refreshViewsLayout();
+}
+
+int Qtilities::CoreGui::TreeNode::valueItemCount() const {
+    return nodeData->value_items.count();
+}
+
+QString Qtilities::CoreGui::TreeNode::valueItemAt(int index) const {
+    return nodeData->value_items.value(index);
+}
+
+QStringList Qtilities::CoreGui::TreeNode::valueItems() const {
+    return nodeData->value_items;
+}
+
+void Qtilities::CoreGui::TreeNode::initializeClone(const Observer* source) {
+    Observer::initializeClone(source);
+
+    const TreeNode* source_node = qobject_cast<const TreeNode*> (source);
+    if (source_node)
+        nodeData->value_items = source_node->nodeData->value_items;
+}
+
+bool Qtilities::CoreGui::TreeNode::removeValueItem(int index) {
+    if (index < 0 || index >= nodeData->value_items.count())
+        return false;
+
+    nodeData->value_items.removeAt(index);
+    setModificationState(true);
+    refreshViewsLayout();
+    return true;
+}
+
+void Qtilities::CoreGui::TreeNode::clearValueItems() {
+    if (nodeData->value_items.isEmpty())
+        return;
+
+    nodeData->value_items.clear();
+    setModificationState(true);
+    refreshViewsLayout();
 }
 
 Qtilities::CoreGui::TreeNode* Qtilities::CoreGui::TreeNode::addNode(const QString& name, const QtilitiesCategory& category) {
@@ -382,8 +462,10 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::CoreGui::
 }
 
 Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::CoreGui::TreeNode::loadFromFile(const QString& file_name, QString* errorMsg, bool clear_first) {
-    if (clear_first)
+    if (clear_first) {
         deleteAll();
+        clearValueItems();
+    }
 
     // Load the file into doc:
     QDomDocument doc("QtilitiesTreeExport");
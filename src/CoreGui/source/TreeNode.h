@@ -364,6 +364,56 @@ tree_widget->show();
               */
             bool removeNode(TreeItemBase* node);
 
+            //! Adds a value item with the given name under this node.
+            /*!
+              Value items are lightweight leaves which are stored by value inside the node, instead of being attached to the node as QObject
+              based subjects. A value item only costs its name, thus nodes with very large numbers of simple leaves should use value items
+              instead of TreeItem instances.
+
+              Value items are shown by ObserverTreeModel after the subjects of the node and they are exported and imported along with the
+              node in XML exports. Since value items are not subjects they are not visible to subject filters, categories, activity,
+              Qtilities::Core::TreeIterator and the object based selection of observer widgets, and they are not part of binary exports.
+
+              \sa addValueItems(), valueItems()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void addValueItem(const QString& name);
+            //! Adds value items with the given names under this node.
+            /*!
+              \sa addValueItem()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void addValueItems(const QStringList& names);
+            //! Returns the number of value items under this node.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int valueItemCount() const;
+            //! Returns the name of the value item at \p index, or an empty string when the index is not valid.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString valueItemAt(int index) const;
+            //! Returns the names of all value items under this node.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QStringList valueItems() const;
+            //! Removes the value item at \p index.
+            /*!
+              \returns True if the value item was removed, false when the index is not valid.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool removeValueItem(int index);
+            //! Removes all value items under this node.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void clearValueItems();
+
             //! Saves the tree under this tree node to an XML file.
             /*!
               \param file_name The file name from to which the file must be saved.
@@ -416,6 +466,9 @@ tree_widget->show();
             static FactoryItem<QObject, TreeNode> factory;
 
         protected:
+            //! Copies the value items of \p source when it is a tree node, see Observer::initializeClone().
+            void initializeClone(const Observer* source);
+
             TreeNodePrivateData* nodeData;
         };
     }
@@ -17,16 +17,28 @@
 #include <QWidget>
 #include <QPointer>
 #include <QList>
+#include <QPair>
 #include <QString>
 
 // ------------------------------------
 // WidgetLoggerEngine implementation
 // ------------------------------------
 
-struct Qtilities::CoreGui::WidgetLoggerEnginePrivateData { 
+struct Qtilities::CoreGui::WidgetLoggerEnginePrivateData {
+    WidgetLoggerEnginePrivateData() : line_wrap_mode_set(false),
+        line_wrap_mode(QPlainTextEdit::WidgetWidth),
+        pending_message_limit(1000) {}
+
     QPointer<WidgetLoggerEngineFrontend>            widget;
     WidgetLoggerEngine::MessageDisplaysFlag         message_displays_flag;
     Qt::ToolBarArea                                 toolbar_area;
+
+    // Settings and messages kept until the widget is created:
+    QString                                         window_title;
+    bool                                            line_wrap_mode_set;
+    QPlainTextEdit::LineWrapMode                    line_wrap_mode;
+    QList<QPair<QString,Logger::MessageType> >      pending_messages;
+    int                                             pending_message_limit;
 };
 
 Qtilities::CoreGui::WidgetLoggerEngine::WidgetLoggerEngine(MessageDisplaysFlag message_displays_flag,
@@ -46,6 +58,7 @@ Qtilities::CoreGui::WidgetLoggerEngine::~WidgetLoggerEngine()
 }
 
 void Qtilities::CoreGui::WidgetLoggerEngine::setWindowTitle(const QString& window_title) {
+    d->window_title = window_title;
     if (d->widget)
         d->widget->setWindowTitle(window_title);
 }
@@ -54,27 +67,55 @@ QString Qtilities::CoreGui::WidgetLoggerEngine::windowTitle() const {
     if (d->widget)
         return d->widget->windowTitle();
     else
-        return QString();
+        return d->window_title;
+}
+
+void Qtilities::CoreGui::WidgetLoggerEngine::setPendingMessageLimit(int limit) {
+    d->pending_message_limit = qMax(0,limit);
+    if (d->pending_message_limit > 0) {
+        while (d->pending_messages.count() > d->pending_message_limit)
+            d->pending_messages.removeFirst();
+    }
+}
+
+int Qtilities::CoreGui::WidgetLoggerEngine::pendingMessageLimit() const {
+    return d->pending_message_limit;
+}
+
+bool Qtilities::CoreGui::WidgetLoggerEngine::isWidgetCreated() const {
+    return d->widget;
 }
 
 bool Qtilities::CoreGui::WidgetLoggerEngine::initialize() {
-    // During initialization we build a map with possible widgets
+    // The widget is created when it is needed, see createWidget():
     abstractLoggerEngineData->is_initialized = true;
+
+    // Print startup info messages
+    Q_ASSERT(abstractLoggerEngineData->formatting_engine);
+    #ifndef QT_NO_DEBUG
+    logMessage(objectName() + tr(" initialized successfully."),Logger::Info);
+    logMessage(tr("Log messages will be formatted using the following formatting engine: ") + abstractLoggerEngineData->formatting_engine->name(),Logger::Info);
+    logMessage(" ",Logger::Info);
+    #endif
+    return true;
+}
+
+void Qtilities::CoreGui::WidgetLoggerEngine::createWidget() const {
+    if (d->widget || !abstractLoggerEngineData->is_initialized)
+        return;
+
     d->widget = new WidgetLoggerEngineFrontend(d->message_displays_flag,
                                                d->toolbar_area);
     connect(d->widget,SIGNAL(destroyed(QObject*)),SLOT(deleteLater()));
-
-    if (d->widget) {
-        // Print startup info messages
-        Q_ASSERT(abstractLoggerEngineData->formatting_engine);
-        #ifndef QT_NO_DEBUG
-        d->widget->appendMessage(objectName() + tr(" initialized successfully."));
-        d->widget->appendMessage(tr("Log messages will be formatted using the following formatting engine: ") + abstractLoggerEngineData->formatting_engine->name());
-        d->widget->appendMessage(" ");
-        #endif
-        return true;
-    } else
-        return false;
+    if (!d->window_title.isEmpty())
+        d->widget->setWindowTitle(d->window_title);
+    if (d->line_wrap_mode_set)
+        d->widget->setLineWrapMode(d->line_wrap_mode);
+
+    // The message displays queue appended messages and lay them out in a single batch:
+    for (int i = 0; i < d->pending_messages.count(); ++i)
+        d->widget->appendMessage(d->pending_messages.at(i).first,d->pending_messages.at(i).second);
+    d->pending_messages.clear();
 }
 
 void Qtilities::CoreGui::WidgetLoggerEngine::finalize() {
@@ -97,25 +138,38 @@ QString Qtilities::CoreGui::WidgetLoggerEngine::status() const {
 }
 
 QWidget* Qtilities::CoreGui::WidgetLoggerEngine::getWidget() {
+    createWidget();
     return d->widget;
 }
 
 void Qtilities::CoreGui::WidgetLoggerEngine::logMessage(const QString& message, Logger::MessageType message_type) {
-    if (d->widget)
+    if (d->widget) {
         d->widget->appendMessage(message,message_type);
+        return;
+    }
+
+    d->pending_messages.append(qMakePair(message,message_type));
+    if (d->pending_message_limit > 0 && d->pending_messages.count() > d->pending_message_limit)
+        d->pending_messages.removeFirst();
 }
 
 void Qtilities::CoreGui::WidgetLoggerEngine::clearLog() {
+    d->pending_messages.clear();
     if (d->widget)
         d->widget->clear();
 }
 
 void Qtilities::CoreGui::WidgetLoggerEngine::setLineWrapMode(QPlainTextEdit::LineWrapMode mode) {
+    d->line_wrap_mode_set = true;
+    d->line_wrap_mode = mode;
     if (d->widget)
         d->widget->setLineWrapMode(mode);
 }
 
 QPlainTextEdit* Qtilities::CoreGui::WidgetLoggerEngine::plainTextEdit(MessageDisplaysFlag message_display) const {
+    createWidget();
+    if (!d->widget)
+        return 0;
     return d->widget->plainTextEdit(message_display);
 }
 
@@ -47,6 +47,10 @@ namespace Qtilities {
 
         A logger engine which shows logged messages in a widget with a QPlainTextEdit widget.
 
+        The widget is only created the first time it is needed, that is when getWidget() or plainTextEdit() is called. Until then, formatted messages
+        are kept in a list of at most pendingMessageLimit() messages, which is appended to the widget in a single batch when it is created. Engines of which the
+        widget is never shown, for example the log engines of tasks of which the log is never opened, therefore cost little more than their messages.
+
         \note Clearing the log through clearLog() is supported by this logger engine.
           */
         class QTILITIES_CORE_GUI_SHARED_EXPORT WidgetLoggerEngine : public AbstractLoggerEngine
@@ -58,6 +62,9 @@ namespace Qtilities {
             /*!
               The default is DefaultDisplays.
 
+              The ListWidget displays store their messages as plain text in a LogMessageStorage and only lay out the visible messages, thus they should be used
+              when very large numbers of messages must be shown, for example in a session log.
+
               \note When only one message display is used in the engine, that display will not be tabbed.
               */
             enum MessageDisplays {
@@ -66,10 +73,10 @@ namespace Qtilities {
                 IssuesPlainTextEdit         = 2,   /*!< Displays all issues (warnings, errors etc.) under an "Issues" tab using a QPlainTextEdit. */
                 WarningsPlainTextEdit       = 4,   /*!< Displays all warnings under a "Warnings" tab using a QPlainTextEdit. */
                 ErrorsPlainTextEdit         = 8,   /*!< Displays all errors under a "Errors" tab using a QPlainTextEdit. */
-//                AllMessagesListWidget       = 16,  /*!< Displays all messages under an "All Messages" tab using a QListView. */
-//                IssuesListWidget            = 32,  /*!< Displays all issues (warnings, errors etc.) under an "Issues" tab using a QListView. */
-//                WarningsListWidget          = 64,  /*!< Displays all warnings under a "Warnings" tab using a QListView. */
-//                ErrorsListWidget            = 128  /*!< Displays all errors under a "Errors" tab using a QListView. */
+                AllMessagesListWidget       = 16,  /*!< Displays all messages under an "All Messages" tab using a virtualized QListView, see MessagesListViewTab. <i>This display was added in %Qtilities v1.5.</i> */
+                IssuesListWidget            = 32,  /*!< Displays all issues (warnings, errors etc.) under an "Issues" tab using a virtualized QListView. <i>This display was added in %Qtilities v1.5.</i> */
+                WarningsListWidget          = 64,  /*!< Displays all warnings under a "Warnings" tab using a virtualized QListView. <i>This display was added in %Qtilities v1.5.</i> */
+                ErrorsListWidget            = 128, /*!< Displays all errors under a "Errors" tab using a virtualized QListView. <i>This display was added in %Qtilities v1.5.</i> */
                 DefaultDisplays             = AllMessagesPlainTextEdit,
                 DefaultTaskDisplays         = AllMessagesPlainTextEdit | IssuesPlainTextEdit
             };
@@ -89,14 +96,30 @@ namespace Qtilities {
 
             //! Sets the window title used for this logger engine.
             /*!
-              \note This function only does something usefull after the engine has been initialized.
+              When the widget was not created yet, the title is applied when it is created.
               */
             void setWindowTitle(const QString& window_title);
             //! Gets the window title used for this logger engine.
+            QString windowTitle() const;
+            //! Sets the maximum number of messages kept while the widget is not created yet, older messages are dropped. When 0, the number of messages is not limited.
             /*!
-              \note This function only does something usefull after the engine has been initialized.
+              The default is 1000, which matches the default maximum number of messages kept by plain text displays.
+
+              <i>This function was added in %Qtilities v1.5.</i>
               */
-            QString windowTitle() const;
+            void setPendingMessageLimit(int limit);
+            //! Returns the maximum number of messages kept while the widget is not created yet.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int pendingMessageLimit() const;
+            //! Indicates if the widget of this engine was created.
+            /*!
+              \sa getWidget()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool isWidgetCreated() const;
 
             // AbstractLoggerEngine implementation
             bool initialize();
@@ -108,6 +131,10 @@ namespace Qtilities {
             bool isFormattingEngineConstant() const { return false; }
 
             // WidgetLoggerEngine implementation
+            //! Returns the widget of this engine, creating it and appending the pending messages to it when it was not created yet.
+            /*!
+              Returns 0 when the engine is not initialized.
+              */
             QWidget* getWidget();
 
             // Make this class a factory item
@@ -115,7 +142,7 @@ namespace Qtilities {
 
             //! Returns the QPlainTextEdit used by this widget logger engine. Through this reference you can add your own custom syntax highligter etc.
             /*!
-              \note Only available when your MessageDisplayFlags includes MessagesPlainTextEdit.
+              \note Only available when your MessageDisplayFlags includes MessagesPlainTextEdit. This function creates the widget when it was not created yet.
               */
             QPlainTextEdit* plainTextEdit(MessageDisplaysFlag message_display) const;
 
@@ -125,6 +152,9 @@ namespace Qtilities {
             void setLineWrapMode(QPlainTextEdit::LineWrapMode mode);
 
         private:
+            //! Creates the widget when the engine is initialized and the widget was not created yet.
+            void createWidget() const;
+
             WidgetLoggerEnginePrivateData* d;
         };
 
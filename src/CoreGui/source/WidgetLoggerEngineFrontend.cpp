@@ -10,6 +10,7 @@
 ****************************************************************************/
 
 #include "WidgetLoggerEngineFrontend.h"
+#include "MessagesListViewTab.h"
 #include "LoggingConstants.h"
 #include "QtilitiesApplication.h"
 #include "QtilitiesCoreGuiConstants.h"
@@ -34,6 +35,8 @@
 #include <QToolBar>
 #include <QDockWidget>
 #include <QTabBar>
+#include <QTimer>
+#include <QTextCursor>
 
 using namespace Qtilities::Core;
 using namespace Qtilities::CoreGui;
@@ -58,7 +61,10 @@ struct Qtilities::CoreGui::MessagesPlainTextEditTabPrivateData {
         sep1(0),
         sep2(0),
         frozen(false),
-        central_widget(0) {}
+        central_widget(0) {
+        flush_timer.setSingleShot(true);
+        flush_timer.setInterval(30);
+    }
 
     SearchBoxWidget* searchBoxWidget;
     QPlainTextEdit txtLog;
@@ -86,6 +92,10 @@ struct Qtilities::CoreGui::MessagesPlainTextEditTabPrivateData {
     QString global_meta_type;
     //! This is the widget for the plain text editor and search box widget.
     QWidget* central_widget;
+    //! Messages which were not yet appended to the log.
+    QStringList pending_messages;
+    //! Timer used to append pending messages to the log in batches.
+    QTimer flush_timer;
 };
 
 Qtilities::CoreGui::MessagesPlainTextEditTab::MessagesPlainTextEditTab(QWidget *parent,
@@ -114,6 +124,7 @@ Qtilities::CoreGui::MessagesPlainTextEditTab::MessagesPlainTextEditTab(QWidget *
     d->txtLog.setFont(QFont("Courier New"));
     d->txtLog.setMaximumBlockCount(1000);
     d->txtLog.setFrameShape(QFrame::NoFrame);
+    connect(&d->flush_timer,SIGNAL(timeout()),SLOT(flushPendingMessages()));
 
     d->central_widget = new QWidget;
 
@@ -214,12 +225,56 @@ QString Qtilities::CoreGui::MessagesPlainTextEditTab::globalMetaType() const {
 }
 
 void Qtilities::CoreGui::MessagesPlainTextEditTab::appendMessage(const QString& message) {
-    d->txtLog.appendHtml(message);
+    d->pending_messages << message;
+    if (d->frozen) {
+        // Only keep the messages which will fit in the log when it is unfrozen:
+        const int max_count = d->txtLog.maximumBlockCount();
+        if (max_count > 0 && d->pending_messages.count() > max_count)
+            d->pending_messages.erase(d->pending_messages.begin(),d->pending_messages.begin() + (d->pending_messages.count() - max_count));
+    } else if (!d->flush_timer.isActive())
+        d->flush_timer.start();
+}
+
+void Qtilities::CoreGui::MessagesPlainTextEditTab::flushPendingMessages() {
+    d->flush_timer.stop();
+    if (d->pending_messages.isEmpty())
+        return;
+
+    // Skip messages which will be removed again because of the maximum block count:
+    const int max_count = d->txtLog.maximumBlockCount();
+    int first = 0;
+    if (max_count > 0 && d->pending_messages.count() > max_count)
+        first = d->pending_messages.count() - max_count;
+
+    // All messages are appended in a single edit block, thus the document is laid out only once:
+    QTextCursor cursor(d->txtLog.document());
+    cursor.beginEditBlock();
+    for (int i = first; i < d->pending_messages.count(); ++i)
+        d->txtLog.appendHtml(d->pending_messages.at(i));
+    cursor.endEditBlock();
+    d->pending_messages.clear();
+
     if (!d->frozen)
         d->txtLog.verticalScrollBar()->setValue(d->txtLog.verticalScrollBar()->maximum());
     // Note: d->txtLog.ensureCursorVisible() does not work becuase the log is read only and we don't have a cursor.
 }
 
+void Qtilities::CoreGui::MessagesPlainTextEditTab::setFlushInterval(int msecs) {
+    d->flush_timer.setInterval(qMax(0,msecs));
+}
+
+int Qtilities::CoreGui::MessagesPlainTextEditTab::flushInterval() const {
+    return d->flush_timer.interval();
+}
+
+void Qtilities::CoreGui::MessagesPlainTextEditTab::setMaximumBlockCount(int maximum) {
+    d->txtLog.setMaximumBlockCount(maximum);
+}
+
+int Qtilities::CoreGui::MessagesPlainTextEditTab::maximumBlockCount() const {
+    return d->txtLog.maximumBlockCount();
+}
+
 void Qtilities::CoreGui::MessagesPlainTextEditTab::handle_FindPrevious() {
     QTextDocument::FindFlags find_flags = 0;
     if (d->searchBoxWidget->caseSensitive())
@@ -343,10 +398,16 @@ void MessagesPlainTextEditTab::handle_FreezeLog() {
         if (d->actionLineWrap)
             d->actionLineWrap->setChecked(false);
     } else {
+        // While frozen, messages are only buffered:
+        d->flush_timer.stop();
         if (d->actionLineWrap)
             d->actionLineWrap->setChecked(true);
     }
     d->frozen = !d->frozen;
+
+    // Append the messages buffered while the log was frozen:
+    if (!d->frozen)
+        flushPendingMessages();
 }
 
 void Qtilities::CoreGui::MessagesPlainTextEditTab::handle_Copy() {
@@ -503,6 +564,8 @@ QPlainTextEdit* Qtilities::CoreGui::MessagesPlainTextEditTab::plainTextEdit() co
 }
 
 void MessagesPlainTextEditTab::clear() {
+    d->flush_timer.stop();
+    d->pending_messages.clear();
     d->txtLog.clear();
 }
 
@@ -526,123 +589,60 @@ Qtilities::CoreGui::WidgetLoggerEngineFrontend::WidgetLoggerEngineFrontend(Widge
     d = new WidgetLoggerEngineFrontendPrivateData;
     d->message_displays_flag = message_displays_flag;
 
+    // The message displays which can be created, in the order in which they are tabbed:
+    const int display_count = 8;
+    const WidgetLoggerEngine::MessageDisplays displays[display_count] = { WidgetLoggerEngine::AllMessagesPlainTextEdit,
+                                                                          WidgetLoggerEngine::IssuesPlainTextEdit,
+                                                                          WidgetLoggerEngine::WarningsPlainTextEdit,
+                                                                          WidgetLoggerEngine::ErrorsPlainTextEdit,
+                                                                          WidgetLoggerEngine::AllMessagesListWidget,
+                                                                          WidgetLoggerEngine::IssuesListWidget,
+                                                                          WidgetLoggerEngine::WarningsListWidget,
+                                                                          WidgetLoggerEngine::ErrorsListWidget };
+    const char* titles[4] = { "Messages", "Issues", "Warnings", "Errors" };
+    const char* icons[4] = { qti_icon_INFO_12x12, qti_icon_WARNING_12x12, qti_icon_WARNING_12x12, qti_icon_ERROR_12x12 };
+
     // When only one message display is present we don't create it as a tab widget.
-    if (message_displays_flag == WidgetLoggerEngine::AllMessagesPlainTextEdit ||
-            message_displays_flag == WidgetLoggerEngine::IssuesPlainTextEdit ||
-            message_displays_flag == WidgetLoggerEngine::WarningsPlainTextEdit ||
-            message_displays_flag == WidgetLoggerEngine::ErrorsPlainTextEdit) {
-
-        MessagesPlainTextEditTab* new_tab = new MessagesPlainTextEditTab(0,toolbar_area);
-        d->message_displays[message_displays_flag] = new_tab;
-        setCentralWidget(new_tab);
-    } else {
-        int info_index = -1;
-        int issues_index = -1;
-        int warning_index = -1;
-        int error_index = -1;
-
-        // Create needed tabs:
-        if (d->message_displays_flag & WidgetLoggerEngine::AllMessagesPlainTextEdit) {
-            MessagesPlainTextEditTab* new_tab = new MessagesPlainTextEditTab(0,toolbar_area);
-            d->message_displays[WidgetLoggerEngine::AllMessagesPlainTextEdit] = new_tab;
-            QDockWidget* new_dock = new QDockWidget("Messages");
-
-            // We don't want users to be able to close the individual log
-            // dock widgets since there is no way to get them back then
-            // until the application is restarted.
-            QDockWidget::DockWidgetFeatures features = new_dock->features();
-            features &= ~QDockWidget::DockWidgetClosable;
-            new_dock->setFeatures(features);
-
-            d->message_display_docks[WidgetLoggerEngine::AllMessagesPlainTextEdit] = new_dock;
-            connect(new_dock,SIGNAL(visibilityChanged(bool)),SLOT(handle_dockVisibilityChanged(bool)));
-            new_dock->setWidget(new_tab);
-            addDockWidget(Qt::BottomDockWidgetArea,new_dock);
-
-            info_index = 0;
-        }
+    int requested_count = 0;
+    for (int i = 0; i < display_count; ++i) {
+        if (message_displays_flag & displays[i])
+            ++requested_count;
+    }
 
-        if (d->message_displays_flag & WidgetLoggerEngine::IssuesPlainTextEdit) {
-            MessagesPlainTextEditTab* new_tab = new MessagesPlainTextEditTab(0,toolbar_area);
-            d->message_displays[WidgetLoggerEngine::IssuesPlainTextEdit] = new_tab;
-            QDockWidget* new_dock = new QDockWidget("Issues");
-
-            // We don't want users to be able to close the individual log
-            // dock widgets since there is no way to get them back then
-            // until the application is restarted.
-            QDockWidget::DockWidgetFeatures features = new_dock->features();
-            features &= ~QDockWidget::DockWidgetClosable;
-            new_dock->setFeatures(features);
-
-            d->message_display_docks[WidgetLoggerEngine::IssuesPlainTextEdit] = new_dock;
-            connect(new_dock,SIGNAL(visibilityChanged(bool)),SLOT(handle_dockVisibilityChanged(bool)));
-            new_dock->setWidget(new_tab);
-            addDockWidget(Qt::BottomDockWidgetArea,new_dock);
-
-            if (d->message_displays_flag & WidgetLoggerEngine::AllMessagesPlainTextEdit)
-                issues_index = 1;
-            else
-                issues_index = 0;
+    QStringList tab_icons;
+    for (int i = 0; i < display_count; ++i) {
+        if (!(message_displays_flag & displays[i]))
+            continue;
+
+        QWidget* new_tab = 0;
+        if (i < 4)
+            new_tab = new MessagesPlainTextEditTab(0,toolbar_area);
+        else
+            new_tab = new MessagesListViewTab(0,toolbar_area);
+        d->message_displays[displays[i]] = new_tab;
+
+        if (requested_count == 1) {
+            setCentralWidget(new_tab);
+            break;
         }
 
-        if (d->message_displays_flag & WidgetLoggerEngine::WarningsPlainTextEdit) {
-            MessagesPlainTextEditTab* new_tab = new MessagesPlainTextEditTab(0,toolbar_area);
-            d->message_displays[WidgetLoggerEngine::WarningsPlainTextEdit] = new_tab;
-            QDockWidget* new_dock = new QDockWidget("Warnings");
-
-            // We don't want users to be able to close the individual log
-            // dock widgets since there is no way to get them back then
-            // until the application is restarted.
-            QDockWidget::DockWidgetFeatures features = new_dock->features();
-            features &= ~QDockWidget::DockWidgetClosable;
-            new_dock->setFeatures(features);
-
-            d->message_display_docks[WidgetLoggerEngine::WarningsPlainTextEdit] = new_dock;
-            connect(new_dock,SIGNAL(visibilityChanged(bool)),SLOT(handle_dockVisibilityChanged(bool)));
-            new_dock->setWidget(new_tab);
-            addDockWidget(Qt::BottomDockWidgetArea,new_dock);
-
-            if (d->message_displays_flag & WidgetLoggerEngine::AllMessagesPlainTextEdit && d->message_displays_flag & WidgetLoggerEngine::IssuesPlainTextEdit)
-                warning_index = 2;
-            else if (d->message_displays_flag & WidgetLoggerEngine::AllMessagesPlainTextEdit)
-                warning_index = 1;
-            else
-                warning_index = 0;
-        }
+        QDockWidget* new_dock = new QDockWidget(titles[i % 4]);
 
-        if (d->message_displays_flag & WidgetLoggerEngine::ErrorsPlainTextEdit) {
-            MessagesPlainTextEditTab* new_tab = new MessagesPlainTextEditTab(0,toolbar_area);
-            d->message_displays[WidgetLoggerEngine::ErrorsPlainTextEdit] = new_tab;
-            QDockWidget* new_dock = new QDockWidget("Errors");
-
-            // We don't want users to be able to close the individual log
-            // dock widgets since there is no way to get them back then
-            // until the application is restarted.
-            QDockWidget::DockWidgetFeatures features = new_dock->features();
-            features &= ~QDockWidget::DockWidgetClosable;
-            new_dock->setFeatures(features);
-
-            d->message_display_docks[WidgetLoggerEngine::ErrorsPlainTextEdit] = new_dock;
-            connect(new_dock,SIGNAL(visibilityChanged(bool)),SLOT(handle_dockVisibilityChanged(bool)));
-            new_dock->setWidget(new_tab);
-            addDockWidget(Qt::BottomDockWidgetArea,new_dock);
-
-            if (d->message_displays_flag & WidgetLoggerEngine::AllMessagesPlainTextEdit && d->message_displays_flag & WidgetLoggerEngine::IssuesPlainTextEdit && d->message_displays_flag & WidgetLoggerEngine::WarningsPlainTextEdit)
-                error_index = 3;
-            else if (d->message_displays_flag & WidgetLoggerEngine::AllMessagesPlainTextEdit && d->message_displays_flag & WidgetLoggerEngine::WarningsPlainTextEdit)
-                error_index = 2;
-            else if (d->message_displays_flag & WidgetLoggerEngine::AllMessagesPlainTextEdit && d->message_displays_flag & WidgetLoggerEngine::IssuesPlainTextEdit)
-                error_index = 2;
-            else if (d->message_displays_flag & WidgetLoggerEngine::AllMessagesPlainTextEdit)
-                error_index = 1;
-            else if (d->message_displays_flag & WidgetLoggerEngine::WarningsPlainTextEdit)
-                error_index = 1;
-            else if (d->message_displays_flag & WidgetLoggerEngine::IssuesPlainTextEdit)
-                error_index = 1;
-            else
-                error_index = 0;
-        }
+        // We don't want users to be able to close the individual log
+        // dock widgets since there is no way to get them back then
+        // until the application is restarted.
+        QDockWidget::DockWidgetFeatures features = new_dock->features();
+        features &= ~QDockWidget::DockWidgetClosable;
+        new_dock->setFeatures(features);
 
+        d->message_display_docks[displays[i]] = new_dock;
+        connect(new_dock,SIGNAL(visibilityChanged(bool)),SLOT(handle_dockVisibilityChanged(bool)));
+        new_dock->setWidget(new_tab);
+        addDockWidget(Qt::BottomDockWidgetArea,new_dock);
+        tab_icons << icons[i % 4];
+    }
+
+    if (requested_count > 1) {
         for (int i = 1; i < d->message_display_docks.count(); ++i)
             tabifyDockWidget(d->message_display_docks.values().at(i-1),d->message_display_docks.values().at(i));
 
@@ -652,14 +652,8 @@ Qtilities::CoreGui::WidgetLoggerEngineFrontend::WidgetLoggerEngineFrontend(Widge
             tabBar->setCurrentIndex(0);
             tabBar->setShape(QTabBar::RoundedSouth);
 
-            if (info_index != -1)
-                tabBar->setTabIcon(info_index,QIcon(qti_icon_INFO_12x12));
-            if (issues_index != -1)
-                tabBar->setTabIcon(issues_index,QIcon(qti_icon_WARNING_12x12));
-            if (warning_index != -1)
-                tabBar->setTabIcon(warning_index,QIcon(qti_icon_WARNING_12x12));
-            if (error_index != -1)
-                tabBar->setTabIcon(error_index,QIcon(qti_icon_ERROR_12x12));
+            for (int i = 0; i < tab_icons.count() && i < tabBar->count(); ++i)
+                tabBar->setTabIcon(i,QIcon(tab_icons.at(i)));
         }
     }
 }
@@ -678,39 +672,68 @@ QPlainTextEdit* Qtilities::CoreGui::WidgetLoggerEngineFrontend::plainTextEdit(Wi
 }
 
 void WidgetLoggerEngineFrontend::appendMessage(const QString &message, Logger::MessageType message_type) {
-    MessagesPlainTextEditTab* plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::AllMessagesPlainTextEdit);
-    if (plain_text_edit_tab)
-        plain_text_edit_tab->appendMessage(message);
-
-    plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::IssuesPlainTextEdit);
-    if (plain_text_edit_tab && (message_type & Logger::Warning || message_type & Logger::Error || message_type & Logger::Fatal))
-        plain_text_edit_tab->appendMessage(message);
+    const bool is_issue = (message_type & Logger::Warning || message_type & Logger::Error || message_type & Logger::Fatal);
+    const bool is_warning = (message_type & Logger::Warning);
+    const bool is_error = (message_type & Logger::Error || message_type & Logger::Fatal);
+
+    QMap<WidgetLoggerEngine::MessageDisplaysFlag,QWidget*>::const_iterator itr;
+    for (itr = d->message_displays.constBegin(); itr != d->message_displays.constEnd(); ++itr) {
+        WidgetLoggerEngine::MessageDisplaysFlag display = itr.key();
+        if (!(d->message_displays_flag & display))
+            continue;
+
+        if (display & (WidgetLoggerEngine::IssuesPlainTextEdit | WidgetLoggerEngine::IssuesListWidget) && !is_issue)
+            continue;
+        if (display & (WidgetLoggerEngine::WarningsPlainTextEdit | WidgetLoggerEngine::WarningsListWidget) && !is_warning)
+            continue;
+        if (display & (WidgetLoggerEngine::ErrorsPlainTextEdit | WidgetLoggerEngine::ErrorsListWidget) && !is_error)
+            continue;
+
+        MessagesPlainTextEditTab* plain_text_edit_tab = qobject_cast<MessagesPlainTextEditTab*> (itr.value());
+        if (plain_text_edit_tab) {
+            plain_text_edit_tab->appendMessage(message);
+            continue;
+        }
+        MessagesListViewTab* list_view_tab = qobject_cast<MessagesListViewTab*> (itr.value());
+        if (list_view_tab)
+            list_view_tab->appendMessage(message,message_type);
+    }
+}
 
-    plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::WarningsPlainTextEdit);
-    if (plain_text_edit_tab && (message_type & Logger::Warning))
-        plain_text_edit_tab->appendMessage(message);
+void WidgetLoggerEngineFrontend::setFlushInterval(int msecs) {
+    QList<QWidget*> displays = d->message_displays.values();
+    for (int i = 0; i < displays.count(); ++i) {
+        MessagesPlainTextEditTab* plain_text_edit_tab = qobject_cast<MessagesPlainTextEditTab*> (displays.at(i));
+        if (plain_text_edit_tab)
+            plain_text_edit_tab->setFlushInterval(msecs);
+        MessagesListViewTab* list_view_tab = qobject_cast<MessagesListViewTab*> (displays.at(i));
+        if (list_view_tab)
+            list_view_tab->setFlushInterval(msecs);
+    }
+}
 
-    plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::ErrorsPlainTextEdit);
-    if (plain_text_edit_tab && (message_type & Logger::Error || message_type & Logger::Fatal))
-        plain_text_edit_tab->appendMessage(message);
+void WidgetLoggerEngineFrontend::setMaximumBlockCount(int maximum) {
+    QList<QWidget*> displays = d->message_displays.values();
+    for (int i = 0; i < displays.count(); ++i) {
+        MessagesPlainTextEditTab* plain_text_edit_tab = qobject_cast<MessagesPlainTextEditTab*> (displays.at(i));
+        if (plain_text_edit_tab)
+            plain_text_edit_tab->setMaximumBlockCount(maximum);
+        MessagesListViewTab* list_view_tab = qobject_cast<MessagesListViewTab*> (displays.at(i));
+        if (list_view_tab)
+            list_view_tab->setMaximumBlockCount(maximum);
+    }
 }
 
 void WidgetLoggerEngineFrontend::clear() {
-    MessagesPlainTextEditTab* plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::AllMessagesPlainTextEdit);
-    if (plain_text_edit_tab)
-        plain_text_edit_tab->clear();
-
-    plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::IssuesPlainTextEdit);
-    if (plain_text_edit_tab)
-        plain_text_edit_tab->clear();
-
-    plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::WarningsPlainTextEdit);
-    if (plain_text_edit_tab)
-        plain_text_edit_tab->clear();
-
-    plain_text_edit_tab = plainTextEditTab(WidgetLoggerEngine::ErrorsPlainTextEdit);
-    if (plain_text_edit_tab)
-        plain_text_edit_tab->clear();
+    QList<QWidget*> displays = d->message_displays.values();
+    for (int i = 0; i < displays.count(); ++i) {
+        MessagesPlainTextEditTab* plain_text_edit_tab = qobject_cast<MessagesPlainTextEditTab*> (displays.at(i));
+        if (plain_text_edit_tab)
+            plain_text_edit_tab->clear();
+        MessagesListViewTab* list_view_tab = qobject_cast<MessagesListViewTab*> (displays.at(i));
+        if (list_view_tab)
+            list_view_tab->clear();
+    }
 }
 
 MessagesPlainTextEditTab *WidgetLoggerEngineFrontend::plainTextEditTab(WidgetLoggerEngine::MessageDisplaysFlag message_display) {
@@ -727,6 +750,9 @@ void WidgetLoggerEngineFrontend::handle_dockVisibilityChanged(bool visible) {
         if (front_end) {
             CONTEXT_MANAGER->setNewContext(front_end->contextString(),true);
         }
+        MessagesListViewTab* list_view_tab = qobject_cast<MessagesListViewTab*> (dock->widget());
+        if (list_view_tab)
+            CONTEXT_MANAGER->setNewContext(list_view_tab->contextString(),true);
     }
 }
 
@@ -94,8 +94,43 @@ namespace Qtilities {
             //! Clears the log.
             void clear();
 
+            //! Sets the interval in milliseconds at which messages are appended to the log.
+            /*!
+              Messages passed to appendMessage() are collected and appended to the log in a single edit block every \p msecs milliseconds,
+              thus the log is laid out once per batch instead of once per message. The default is 30 milliseconds.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFlushInterval(int msecs);
+            //! Returns the interval in milliseconds at which messages are appended to the log.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int flushInterval() const;
+            //! Sets the maximum number of messages kept in the log, older messages are removed. When 0, the number of messages is not limited.
+            /*!
+              The default is 1000.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setMaximumBlockCount(int maximum);
+            //! Returns the maximum number of messages kept in the log.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int maximumBlockCount() const;
+
         public slots:
+            //! Queues a message to be appended to the log.
+            /*!
+              Messages are appended in batches, see setFlushInterval(). While the log is frozen, messages are only buffered.
+              */
             void appendMessage(const QString& message);
+            //! Appends all queued messages to the log.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void flushPendingMessages();
 
             // Slots to respond to signals from GUI elements
             void handle_FindPrevious();
@@ -155,6 +190,20 @@ namespace Qtilities {
                 \note Only PlainTextEdit displays can be used with this function.
                 */
             QPlainTextEdit* plainTextEdit(WidgetLoggerEngine::MessageDisplaysFlag message_display) const;
+            //! Sets the interval in milliseconds at which messages are appended to all message displays.
+            /*!
+              \sa MessagesPlainTextEditTab::setFlushInterval()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFlushInterval(int msecs);
+            //! Sets the maximum number of messages kept in all message displays.
+            /*!
+              \sa MessagesPlainTextEditTab::setMaximumBlockCount()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setMaximumBlockCount(int maximum);
 
         public slots:
             void appendMessage(const QString& message, Logger::MessageType message_type = Logger::Info);
@@ -32,18 +32,22 @@ UI_DIR = $$QTILITIES_TEMP/ExtensionSystem
 # Extension Library Files
 # --------------------------
 HEADERS += \
+        source/DeferredPluginMode.h \
         source/ExtensionSystemConfig.h \
         source/ExtensionSystemConstants.h \
         source/ExtensionSystemCore.h \
         source/ExtensionSystem_global.h \
         source/IPlugin.h \
         source/PluginInfoWidget.h \
+        source/PluginManifestCache.h \
         source/PluginTreeModel.h \
 
 SOURCES += \
+        source/DeferredPluginMode.cpp \
         source/ExtensionSystemConfig.cpp \
         source/ExtensionSystemCore.cpp \
         source/PluginInfoWidget.cpp \
+        source/PluginManifestCache.cpp \
         source/PluginTreeModel.cpp \
 
 FORMS   += \
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "DeferredPluginMode.h"
+#include "ExtensionSystemCore.h"
+
+#include <Logger>
+
+#include <QPointer>
+#include <QVBoxLayout>
+#include <QWidget>
+
+struct Qtilities::ExtensionSystem::DeferredPluginModePrivateData {
+    DeferredPluginModePrivateData() : mode(0),
+        activated(false) {}
+
+    QString             plugin_name;
+    QString             mode_name;
+    QIcon               mode_icon;
+    QString             context_string;
+    IMode*              mode;
+    QPointer<QWidget>   container;
+    bool                activated;
+};
+
+Qtilities::ExtensionSystem::DeferredPluginMode::DeferredPluginMode(const QString& plugin_name, const QString& mode_name, const QIcon& mode_icon, QObject* parent) : QObject(parent) {
+    d = new DeferredPluginModePrivateData;
+    d->plugin_name = plugin_name;
+    d->mode_name = mode_name;
+    d->mode_icon = mode_icon;
+    setObjectName(mode_name);
+}
+
+Qtilities::ExtensionSystem::DeferredPluginMode::~DeferredPluginMode() {
+    delete d;
+}
+
+QString Qtilities::ExtensionSystem::DeferredPluginMode::pluginName() const {
+    return d->plugin_name;
+}
+
+void Qtilities::ExtensionSystem::DeferredPluginMode::setMode(IMode* mode) {
+    d->mode = mode;
+}
+
+Qtilities::CoreGui::Interfaces::IMode* Qtilities::ExtensionSystem::DeferredPluginMode::mode() const {
+    return d->mode;
+}
+
+void Qtilities::ExtensionSystem::DeferredPluginMode::setContextString(const QString& context_string) {
+    d->context_string = context_string;
+}
+
+QWidget* Qtilities::ExtensionSystem::DeferredPluginMode::modeWidget() {
+    if (!d->container) {
+        d->container = new QWidget;
+        QVBoxLayout* layout = new QVBoxLayout(d->container);
+        layout->setMargin(0);
+    }
+    return d->container;
+}
+
+QIcon Qtilities::ExtensionSystem::DeferredPluginMode::modeIcon() const {
+    return d->mode_icon;
+}
+
+QString Qtilities::ExtensionSystem::DeferredPluginMode::modeName() const {
+    return d->mode_name;
+}
+
+QString Qtilities::ExtensionSystem::DeferredPluginMode::contextString() const {
+    if (!d->context_string.isEmpty() || !d->mode)
+        return d->context_string;
+    return d->mode->contextString();
+}
+
+QString Qtilities::ExtensionSystem::DeferredPluginMode::contextHelpId() const {
+    if (d->mode)
+        return d->mode->contextHelpId();
+    return QString();
+}
+
+void Qtilities::ExtensionSystem::DeferredPluginMode::aboutToBeActivated() {
+    if (!d->activated)
+        activate();
+    if (d->mode)
+        d->mode->aboutToBeActivated();
+}
+
+void Qtilities::ExtensionSystem::DeferredPluginMode::justActivated() {
+    if (d->mode)
+        d->mode->justActivated();
+}
+
+void Qtilities::ExtensionSystem::DeferredPluginMode::activate() {
+    d->activated = true;
+    if (!EXTENSION_SYSTEM->activatePlugin(d->plugin_name)) {
+        LOG_ERROR(QString("Mode \"%1\" could not be shown since plugin %2 failed to activate.").arg(d->mode_name).arg(d->plugin_name));
+        return;
+    }
+
+    if (!d->mode) {
+        LOG_WARNING(QString("Plugin %1 did not set the mode which must be shown in its deferred mode \"%2\".").arg(d->plugin_name).arg(d->mode_name));
+        return;
+    }
+
+    d->mode->initializeMode();
+    QWidget* mode_widget = d->mode->modeWidget();
+    if (mode_widget && modeWidget()->layout())
+        modeWidget()->layout()->addWidget(mode_widget);
+}
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef DEFERRED_PLUGIN_MODE_H
+#define DEFERRED_PLUGIN_MODE_H
+
+#include "ExtensionSystem_global.h"
+
+#include <IMode>
+
+#include <QObject>
+#include <QIcon>
+
+namespace Qtilities {
+    namespace ExtensionSystem {
+        using namespace Qtilities::CoreGui::Interfaces;
+
+        /*!
+          \struct DeferredPluginModePrivateData
+          \brief The DeferredPluginModePrivateData struct stores private data used by the DeferredPluginMode class.
+         */
+        struct DeferredPluginModePrivateData;
+
+        /*!
+          \class DeferredPluginMode
+          \brief A mode which stands in for the mode of a plugin of which the activation is deferred until its first use.
+
+          Plugins returning IPlugin::ActivateOnFirstUse in IPlugin::pluginActivationPolicy() register a DeferredPluginMode in the global
+          object pool in IPlugin::initializeActivationStubs(), using the name and icon of their real mode. Thus the mode appears in the main
+          window without the plugin being initialized. When the user switches to the mode for the first time, the deferred mode activates the
+          plugin using ExtensionSystemCore::activatePlugin() and shows the widget of the real mode from then on.
+
+          The plugin passes its real mode to the deferred mode using setMode() in its IPlugin::initialize() implementation, instead of
+          registering the real mode in the global object pool:
+
+\code
+bool MyPlugin::initializeActivationStubs(QStringList* error_strings) {
+    Q_UNUSED(error_strings)
+    d->deferred_mode = new DeferredPluginMode(pluginName(),tr("My Mode"),QIcon(":/my_mode_48x48.png"),this);
+    OBJECT_MANAGER->registerObject(d->deferred_mode,QtilitiesCategory("GUI::Application Modes (IMode)","::"));
+    return true;
+}
+
+bool MyPlugin::initialize(const QStringList &arguments, QStringList *error_strings) {
+    Q_UNUSED(arguments)
+    Q_UNUSED(error_strings)
+    d->deferred_mode->setMode(new MyMode(this));
+    return true;
+}
+\endcode
+
+          <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class EXTENSION_SYSTEM_SHARED_EXPORT DeferredPluginMode : public QObject, public IMode
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::CoreGui::Interfaces::IMode)
+
+        public:
+            //! Constructs a deferred mode for the plugin named \p plugin_name, using \p mode_name and \p mode_icon until the plugin is activated.
+            DeferredPluginMode(const QString& plugin_name, const QString& mode_name, const QIcon& mode_icon, QObject* parent = 0);
+            ~DeferredPluginMode();
+
+            //! The name of the plugin which is activated when the mode is activated for the first time.
+            QString pluginName() const;
+            //! Sets the real mode of the plugin, of which the widget is shown in this mode once the plugin is activated.
+            /*!
+              Call this function from the plugin's IPlugin::initialize() implementation. The deferred mode does not take ownership of \p mode.
+              */
+            void setMode(IMode* mode);
+            //! Gets the real mode of the plugin. Returns null until the plugin is activated.
+            IMode* mode() const;
+            //! Sets the context string of the mode, which is known before the plugin is activated.
+            /*!
+              When no context string is set, the context string of the real mode is used once the plugin is activated.
+              */
+            void setContextString(const QString& context_string);
+
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------------------
+            // IMode Implementation
+            // --------------------------------------------
+            QWidget* modeWidget();
+            void initializeMode() {}
+            QIcon modeIcon() const;
+            QString modeName() const;
+            QString contextString() const;
+            QString contextHelpId() const;
+            void aboutToBeActivated();
+            void justActivated();
+
+        private:
+            //! Activates the plugin and embeds the widget of its real mode.
+            void activate();
+
+            DeferredPluginModePrivateData* d;
+        };
+    }
+}
+
+#endif // DEFERRED_PLUGIN_MODE_H
@@ -13,31 +13,170 @@
 #include "ExtensionSystemConstants.h"
 #include "ExtensionSystemConfig.h"
 #include "IPlugin.h"
+#include "PluginManifestCache.h"
 #include "PluginTreeModel.h"
 
 #include <QtilitiesCoreGui>
 
 #include <QLayout>
 #include <QMutex>
+#include <QMutexLocker>
 #include <QPluginLoader>
 #include <QCoreApplication>
 #include <QDir>
 #include <QFileInfo>
 #include <QDomDocument>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QHash>
+#include <QRegExp>
+#include <QRunnable>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
 
 #include <stdio.h>
-#include <time.h>
 
 using namespace QtilitiesCoreGui;
 using namespace Qtilities::ExtensionSystem::Interfaces;
 using namespace Qtilities::ExtensionSystem::Constants;
 using namespace Qtilities::Logging::Constants;
 
+namespace {
+    enum PluginInitializationStatus {
+        PluginWaiting,
+        PluginInitializing,
+        PluginInitialized,
+        PluginFailed,
+        PluginSkipped
+    };
+
+    struct PluginInitialization {
+        PluginInitialization() : plugin(0), status(PluginWaiting), successful(false) {}
+
+        IPlugin*                    plugin;
+        //! The indexes of the plugins on which this plugin depends.
+        QList<int>                  dependencies;
+        PluginInitializationStatus  status;
+        //! Set by the thread which called initialize() on the plugin.
+        bool                        successful;
+        QStringList                 error_strings;
+    };
+
+    //! The plugins of which initialize() returned on worker threads, waiting to be handled on the main thread.
+    struct PluginInitializationResults {
+        QMutex          mutex;
+        QWaitCondition  finished;
+        QList<int>      finished_plugins;
+    };
+
+    void callPluginInitialize(PluginInitialization* initialization) {
+        StartupProfileScope profile_scope(initialization->plugin->pluginName(),"initialize()");
+        initialization->successful = initialization->plugin->initialize(QStringList(),&initialization->error_strings);
+    }
+
+    class PluginInitializationRunnable : public QRunnable
+    {
+    public:
+        PluginInitializationRunnable(int index, PluginInitialization* initialization, PluginInitializationResults* results) :
+            index(index), initialization(initialization), results(results) {
+            setAutoDelete(true);
+        }
+
+        void run() {
+            callPluginInitialize(initialization);
+            QMutexLocker locker(&results->mutex);
+            results->finished_plugins << index;
+            results->finished.wakeAll();
+        }
+
+    private:
+        int                             index;
+        PluginInitialization*           initialization;
+        PluginInitializationResults*    results;
+    };
+
+    //! The library files found in a plugin path.
+    struct PluginPathScan {
+        PluginPathScan() : calculate_fingerprint(false) {}
+
+        QString         path;
+        //! The compiled plugin filter expressions, every scan has its own copies since QRegExp can not be shared between threads.
+        QList<QRegExp>  filter_expressions;
+        //! The files in the path, in the order in which they must be loaded.
+        QStringList     entry_list;
+        //! Indicates for every file in entry_list if it matches one of the filter expressions.
+        QList<bool>     filtered;
+        //! Indicates for every file in entry_list which is not filtered if it is a library.
+        QList<bool>     is_library;
+        //! When true, the file names, sizes and modification times of the libraries are added to fingerprint.
+        bool            calculate_fingerprint;
+        QByteArray      fingerprint;
+    };
+
+    void scanPluginPath(PluginPathScan* scan) {
+        QDir dir(scan->path);
+        const qint64 search_start = StartupProfiler::instance()->elapsed();
+        QStringList entry_list = dir.entryList(QDir::Files);
+        QRegExp reg_exp("*SessionLogPlugin*",Qt::CaseInsensitive,QRegExp::Wildcard);
+        int index_of_log = entry_list.indexOf(reg_exp);
+        if (index_of_log != -1) {
+            entry_list.move(index_of_log,0);
+            //qDebug() << "Moving log plugin to the start of the plugin load-list.";
+        }
+
+        foreach (const QString& fileName, entry_list) {
+            QFileInfo file_info(fileName);
+
+            #if defined(Q_OS_UNIX)
+                // Filter .so.x plugins on linux:
+                if (file_info.completeSuffix().split(".").count() > 1 && file_info.completeSuffix().startsWith("so"))
+                    continue;
+            #endif
+
+            bool is_filtered_plugin = false;
+            for (int i = 0; i < scan->filter_expressions.count(); ++i) {
+                if (scan->filter_expressions[i].exactMatch(file_info.fileName())) {
+                    is_filtered_plugin = true;
+                    break;
+                }
+            }
+
+            scan->entry_list << fileName;
+            scan->filtered << is_filtered_plugin;
+            scan->is_library << (!is_filtered_plugin && QLibrary::isLibrary(dir.absoluteFilePath(fileName)));
+            if (scan->calculate_fingerprint && scan->is_library.last()) {
+                QFileInfo library_info(dir.absoluteFilePath(fileName));
+                scan->fingerprint += QString("%1|%2|%3\n").arg(library_info.absoluteFilePath()).arg(library_info.size()).arg(library_info.lastModified().toTime_t()).toUtf8();
+            }
+        }
+        StartupProfiler::instance()->recordSpan(scan->path,"Library Search",search_start,StartupProfiler::instance()->elapsed());
+    }
+
+    class PluginPathScanRunnable : public QRunnable
+    {
+    public:
+        PluginPathScanRunnable(PluginPathScan* scan) : scan(scan) {
+            setAutoDelete(true);
+        }
+
+        void run() {
+            scanPluginPath(scan);
+        }
+
+    private:
+        PluginPathScan* scan;
+    };
+}
+
 struct Qtilities::ExtensionSystem::ExtensionSystemCorePrivateData {
     ExtensionSystemCorePrivateData() : plugins("Plugins"),
     plugin_activity_filter(0),
     treeModel(0),
-    is_initialized(false) { }
+    is_initialized(false),
+    manifest_cache_enabled(false),
+    startup_snapshot_enabled(false) { }
 
     TreeNode                plugins;
     ActivityPolicyFilter*   plugin_activity_filter;
@@ -54,8 +193,19 @@ struct Qtilities::ExtensionSystem::ExtensionSystemCorePrivateData {
     QStringList             current_inactive_plugins;
     QStringList             current_filtered_plugins;
     QStringList             core_plugins;
+    //! The plugins of which the activation is deferred, and which were not activated yet.
+    QStringList             deferred_plugins;
 
     bool                    is_initialized;
+
+    bool                    manifest_cache_enabled;
+    QString                 manifest_cache_file;
+    qti_private_PluginManifestCache manifest_cache;
+
+    bool                    startup_snapshot_enabled;
+    QString                 startup_snapshot_file;
+    StartupSnapshot         startup_snapshot;
+    QByteArray              plugin_files_hash;
 };
 
 Qtilities::ExtensionSystem::ExtensionSystemCore* Qtilities::ExtensionSystem::ExtensionSystemCore::m_Instance = 0;
@@ -105,6 +255,8 @@ void Qtilities::ExtensionSystem::ExtensionSystemCore::initialize() {
     // Start a processing cycle on the actions observer. Otherwise it will refresh the actions view everytime
     // an action is added in a plugin.
     OBJECT_MANAGER->objectPool()->startProcessingCycle();
+    // Batched interface subscribers are notified once about all objects registered by plugins:
+    OBJECT_MANAGER->startNotificationBatch();
 
     if (d->active_configuration_file.isEmpty()) {
         d->active_configuration_file = QtilitiesApplication::applicationDirPath() + QDir::separator() + "plugins" + QDir::separator() +  "default" + qti_def_SUFFIX_PLUGIN_CONFIG;
@@ -130,114 +282,157 @@ void Qtilities::ExtensionSystem::ExtensionSystemCore::initialize() {
     d->pluginsDir.cd("plugins");
     addPluginPath(d->pluginsDir.path());
 
-    #ifndef QT_NO_DEBUG
-    time_t start,end;
-    time(&start);
-    #endif
+    const qint64 loading_start = StartupProfiler::instance()->elapsed();
 
     emit pluginLoadingStarted();
 
+    if (d->manifest_cache_enabled)
+        d->manifest_cache.load(pluginManifestCacheFile());
+
+    QList<IPlugin*> plugins_to_initialize;
+
+    // Scanning dominates startup when plugin paths are on network drives, thus all paths are scanned concurrently:
+    QList<QRegExp> filter_expressions;
+    foreach (const QString& expression, d->set_filtered_plugins)
+        filter_expressions << QRegExp(expression,Qt::CaseSensitive,QRegExp::Wildcard);
+    QList<PluginPathScan> scans;
     foreach (const QString& path, d->customPluginPaths) {
-        emit newProgressMessage(QString("Searching for plugins in directory: %1").arg(path));
         LOG_INFO(QString("Searching for plugins in directory: %1").arg(path));
-        QCoreApplication::processEvents();
+        PluginPathScan scan;
+        scan.path = path;
+        scan.filter_expressions = filter_expressions;
+        scan.calculate_fingerprint = d->startup_snapshot_enabled;
+        scans << scan;
+    }
+    emit newProgressMessage(QString("Searching for plugins in %1 directories").arg(scans.count()));
+    IDLE_SCHEDULER->yieldToEventLoop();
+    {
+        QThreadPool thread_pool;
+        for (int i = 1; i < scans.count(); ++i)
+            thread_pool.start(new PluginPathScanRunnable(&scans[i]));
+        if (!scans.isEmpty())
+            scanPluginPath(&scans[0]);
+        thread_pool.waitForDone();
+    }
 
-        QDir dir(path);
-        QStringList entry_list = dir.entryList(QDir::Files);
-        QRegExp reg_exp("*SessionLogPlugin*",Qt::CaseInsensitive,QRegExp::Wildcard);
-        int index_of_log = entry_list.indexOf(reg_exp);
-        if (index_of_log != -1) {
-            entry_list.move(index_of_log,0);
-            //qDebug() << "Moving log plugin to the start of the plugin load-list.";
+    if (d->startup_snapshot_enabled) {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(QCoreApplication::applicationVersion().toUtf8());
+        for (int i = 0; i < scans.count(); ++i)
+            hash.addData(scans.at(i).fingerprint);
+        d->plugin_files_hash = hash.result().toHex();
+
+        // Construct the commands of the previous session before plugins are loaded, the plugins attach their actions to them:
+        if (d->startup_snapshot.load(startupSnapshotFile(),d->plugin_files_hash)) {
+            StartupProfileScope profile_scope(startupSnapshotFile(),"Startup Snapshot");
+            int restored = d->startup_snapshot.restoreCommands();
+            LOG_INFO(QString("Restored %1 command(s) from the startup snapshot.").arg(restored));
+        } else {
+            LOG_INFO("No valid startup snapshot was found for the current plugin files.");
         }
-        foreach (const QString& fileName, entry_list) {
-            QFileInfo file_info(fileName);
-            QString stripped_file_name = file_info.fileName();
+    }
 
-            #if defined(Q_OS_UNIX)
-                // Filter .so.x plugins on linux:
-                if (file_info.completeSuffix().split(".").count() > 1 && file_info.completeSuffix().startsWith("so"))
-                    continue;
-            #endif
+    const QSet<QString> inactive_plugins = d->set_inactive_plugins.toSet();
+    QSet<QString> plugin_names = d->plugins.subjectNames().toSet();
+
+    // Plugins linked into the application using Q_IMPORT_PLUGIN are loaded first, thus they take precedence over plugin libraries
+    // with the same plugin name. Their instances already exist, thus filter expressions are matched against their plugin names:
+    const QObjectList static_instances = QPluginLoader::staticInstances();
+    for (int i = 0; i < static_instances.count(); ++i) {
+        IPlugin* pluginIFace = qobject_cast<IPlugin*> (static_instances.at(i));
+        if (!pluginIFace) {
+            // Static builds of Qt also return their own plugins, for example image format plugins:
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ExtensionSystemLogTag,QString("Skipped static plugin which does not implement the IPlugin interface: %1").arg(static_instances.at(i)->metaObject()->className()));
+            continue;
+        }
 
-            bool is_filtered_plugin = false;
-            foreach (const QString& expression, d->set_filtered_plugins) {
-                QRegExp rx(expression);
-                rx.setPatternSyntax(QRegExp::Wildcard);
-                if (rx.exactMatch(stripped_file_name)) {
-                    is_filtered_plugin = true;
-                    break;
-                }
+        const QString plugin_name = pluginIFace->pluginName();
+        bool is_filtered_plugin = false;
+        for (int e = 0; e < filter_expressions.count(); ++e) {
+            if (filter_expressions[e].exactMatch(plugin_name)) {
+                is_filtered_plugin = true;
+                break;
             }
+        }
+        if (is_filtered_plugin) {
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ExtensionSystemLogTag,"Skipped filtered static plugin during plugin loading: " + plugin_name);
+            d->current_filtered_plugins << plugin_name;
+            continue;
+        }
+
+        emit newProgressMessage(QString("Loading static plugin: %1").arg(plugin_name));
+        LOG_INFO(QString("Loading static plugin: %1").arg(plugin_name));
+        if (attachPlugin(pluginIFace,QCoreApplication::applicationFilePath(),&plugin_names) && !inactive_plugins.contains(plugin_name))
+            plugins_to_initialize << pluginIFace;
+    }
+
+    for (int s = 0; s < scans.count(); ++s) {
+        const PluginPathScan& scan = scans.at(s);
+        emit newProgressMessage(QString("Loading plugins from directory: %1").arg(scan.path));
+        IDLE_SCHEDULER->yieldToEventLoop();
+
+        QDir dir(scan.path);
+        for (int f = 0; f < scan.entry_list.count(); ++f) {
+            const QString& fileName = scan.entry_list.at(f);
+            QString stripped_file_name = QFileInfo(fileName).fileName();
 
-            if (!is_filtered_plugin) {
-                if (QLibrary::isLibrary(dir.absoluteFilePath(fileName))) {
+            if (!scan.filtered.at(f)) {
+                if (scan.is_library.at(f)) {
                     LOG_INFO("Found library: " + stripped_file_name);
+
+                    // Inactive and incompatible plugins are not loaded when their manifest is cached:
+                    PluginManifest manifest;
+                    QFileInfo library_info(dir.absoluteFilePath(fileName));
+                    bool has_manifest = d->manifest_cache_enabled && d->manifest_cache.find(library_info,&manifest);
+                    if (has_manifest) {
+                        if (!manifest.is_plugin) {
+                            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ExtensionSystemLogTag,"Skipped library which does not implement the IPlugin interface according to the plugin manifest cache: " + stripped_file_name);
+                            continue;
+                        }
+
+                        bool is_inactive_plugin = inactive_plugins.contains(manifest.name);
+                        VersionInformation version_info = manifest.versionInformation();
+                        bool is_incompatible_plugin = version_info.hasSupportedVersions() && !version_info.isSupportedVersion(QCoreApplication::applicationVersion());
+                        if (is_inactive_plugin || is_incompatible_plugin) {
+                            if (plugin_names.contains(manifest.name)) {
+                                LOG_WARNING(QString("A plugin called %1 already exists. Plugin won't be loaded from file: %2").arg(manifest.name).arg(stripped_file_name));
+                                continue;
+                            }
+
+                            qti_private_CachedPlugin* cached_plugin = new qti_private_CachedPlugin(manifest,this);
+                            MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
+                            category_property.setValue(qVariantFromValue(cached_plugin->pluginCategory()),d->plugins.observerID());
+                            ObjectManager::setMultiContextProperty(cached_plugin,category_property);
+                            cached_plugin->setPluginFileName(library_info.absoluteFilePath());
+                            if (is_incompatible_plugin) {
+                                LOG_ERROR(QString("Incompatible plugin version of the following plugin detected (in file %1): Your application version (v%2) is not found in the list of compatible application versions that this plugin supports. The plugin was not loaded.").arg(stripped_file_name).arg(QCoreApplication::applicationVersion()));
+                                cached_plugin->addPluginState(IPlugin::IncompatibleState);
+                                cached_plugin->addErrorMessage(QString("Application version (v%2) is not found in the list of compatible application versions that this plugin supports.").arg(QCoreApplication::applicationVersion()));
+                            }
+                            LOG_INFO(QString("Plugin in file %1 was not loaded, its details were found in the plugin manifest cache.").arg(stripped_file_name));
+                            d->plugins.attachSubject(cached_plugin);
+                            plugin_names << manifest.name;
+                            continue;
+                        }
+                    }
+
                     QPluginLoader loader(dir.absoluteFilePath(fileName));
+                    const qint64 library_load_start = StartupProfiler::instance()->elapsed();
                     QObject *obj = loader.instance();
+                    StartupProfiler::instance()->recordSpan(stripped_file_name,"Library Loading",library_load_start,StartupProfiler::instance()->elapsed());
                     if (obj) {
                         // Check if the object implements IPlugin:
                         IPlugin* pluginIFace = qobject_cast<IPlugin*> (obj);
+                        if (d->manifest_cache_enabled && !has_manifest)
+                            d->manifest_cache.insert(PluginManifest::fromPlugin(library_info,pluginIFace));
                         if (pluginIFace) {
                             emit newProgressMessage(QString("Loading plugin from file: %1").arg(stripped_file_name));
                             LOG_INFO(QString("Loading plugin from file: %1").arg(stripped_file_name));
-                            QCoreApplication::processEvents();
-
-                            // Check that the plugins with the same does not exist:
-                            if (d->plugins.subjectNames().contains(pluginIFace->pluginName())) {
-                                LOG_WARNING(QString("A plugin called %1 already exists. Plugin won't be loaded from file: %2").arg(pluginIFace->pluginName()).arg(stripped_file_name));
-                                continue;
-                            }
-
-                            // Set the object name of the plugin:
-                            pluginIFace->objectBase()->setObjectName(pluginIFace->pluginName());
-
-                            // Set the category property of the plugin:
-                            MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
-                            category_property.setValue(qVariantFromValue(pluginIFace->pluginCategory()),d->plugins.observerID());
-                            ObjectManager::setMultiContextProperty(pluginIFace->objectBase(),category_property);
-
-                            // Store the file name:
-                            pluginIFace->setPluginFileName(dir.absoluteFilePath(fileName));
-
-                            // Do a plugin compatibility check here:
-                            if (pluginIFace->pluginVersionInformation().hasSupportedVersions()) {
-                                if (!pluginIFace->pluginVersionInformation().isSupportedVersion(QCoreApplication::applicationVersion())) {
-                                    LOG_ERROR(QString("Incompatible plugin version of the following plugin detected (in file %1): Your application version (v%2) is not found in the list of compatible application versions that this plugin supports.").arg(stripped_file_name).arg(QCoreApplication::applicationVersion()));
-                                    pluginIFace->addPluginState(IPlugin::IncompatibleState);
-                                    pluginIFace->addErrorMessage(QString("Application version (v%2) is not found in the list of compatible application versions that this plugin supports.").arg(QCoreApplication::applicationVersion()));
-                                }
-                            }
-
-                            d->plugins.attachSubject(obj);
-
-                            bool is_inactive_plugin = false;
-                            foreach (const QString& inactivePluginName, d->set_inactive_plugins) {
-                                if (pluginIFace->pluginName() == inactivePluginName) {
-                                    is_inactive_plugin = true;
-                                    break;
-                                }
-                            }
+                            IDLE_SCHEDULER->yieldToEventLoop();
 
-                            if (!is_inactive_plugin) {
-                                QStringList error_strings;
-                                #ifdef QTILITIES_BENCHMARKING
-                                time_t start_init,end_init;
-                                time(&start_init);
-                                #endif
-                                if (!pluginIFace->initialize(QStringList(), &error_strings)) {
-                                    LOG_ERROR("Plugin (" + stripped_file_name + ") failed during initialization with error(s): " + error_strings.join(","));
-                                    pluginIFace->addPluginState(IPlugin::ErrorState);
-                                    pluginIFace->addErrorMessages(error_strings);
-                                } else {
-                                    LOG_INFO("Successfully initialized plugin \"" + stripped_file_name + "\".");
-                                }
-                                #ifdef QTILITIES_BENCHMARKING
-                                time(&end_init);
-                                double diff_init = difftime(end_init,start_init);
-                                LOG_TRACE(QString("Initializing plugin " + pluginIFace->pluginName() + " took " + QString::number(diff_init) + " seconds."));
-                                #endif
-                            }
+                            // Plugins are initialized once all plugins were loaded, since they can depend on each other:
+                            if (attachPlugin(pluginIFace,dir.absoluteFilePath(fileName),&plugin_names) && !inactive_plugins.contains(pluginIFace->pluginName()))
+                                plugins_to_initialize << pluginIFace;
                         } else {
                             LOG_ERROR("Plugin found which does not implement the expected IPlugin interface.");
                         }
@@ -247,35 +442,83 @@ void Qtilities::ExtensionSystem::ExtensionSystemCore::initialize() {
                     }
                 }
             } else {
-                LOG_DEBUG("Skipped filtered plugin during plugin loading: " + stripped_file_name);
+                LOG_TAG_DEBUG(Qtilities::Logging::Logger::ExtensionSystemLogTag,"Skipped filtered plugin during plugin loading: " + stripped_file_name);
                 d->current_filtered_plugins << stripped_file_name;
             }
         }
 
-        emit newProgressMessage(QString("Finished loading plugins in directory:\n %1").arg(path));
+        emit newProgressMessage(QString("Finished loading plugins in directory:\n %1").arg(scan.path));
+    }
+
+    // Split off the plugins of which the activation is deferred until their first use. They are initialized on startup anyway when
+    // a plugin which is initialized on startup depends on them, directly or through other plugins:
+    QSet<IPlugin*> deferred_plugins;
+    QHash<QString,IPlugin*> deferred_candidates;
+    QList<IPlugin*> startup_plugins;
+    foreach (IPlugin* pluginIFace, plugins_to_initialize) {
+        if (pluginIFace->pluginActivationPolicy() == IPlugin::ActivateOnFirstUse)
+            deferred_candidates[pluginIFace->pluginName()] = pluginIFace;
+        else
+            startup_plugins << pluginIFace;
+    }
+    for (int i = 0; i < startup_plugins.count() && !deferred_candidates.isEmpty(); ++i) {
+        foreach (const QString& dependency, startup_plugins.at(i)->pluginDependencies()) {
+            IPlugin* dependency_plugin = deferred_candidates.take(dependency);
+            if (dependency_plugin) {
+                LOG_INFO(QString("Plugin %1 is initialized on startup since plugin %2 depends on it.").arg(dependency).arg(startup_plugins.at(i)->pluginName()));
+                startup_plugins << dependency_plugin;
+            }
+        }
+    }
+    foreach (IPlugin* pluginIFace, plugins_to_initialize) {
+        if (!deferred_candidates.contains(pluginIFace->pluginName()))
+            continue;
+
+        plugins_to_initialize.removeOne(pluginIFace);
+        deferred_plugins << pluginIFace;
+
+        QStringList error_strings;
+        StartupProfileScope profile_scope(pluginIFace->pluginName(),"initializeActivationStubs()");
+        if (pluginIFace->initializeActivationStubs(&error_strings)) {
+            pluginIFace->addPluginState(IPlugin::Deferred);
+            d->deferred_plugins << pluginIFace->pluginName();
+            LOG_INFO(QString("Activation of plugin %1 is deferred until its first use.").arg(pluginIFace->pluginName()));
+        } else {
+            pluginIFace->addPluginState(IPlugin::ErrorState);
+            pluginIFace->addErrorMessages(error_strings);
+            LOG_ERROR("Plugin (" + pluginIFace->pluginName() + ") failed to initialize its activation stubs with error(s): " + error_strings.join(","));
+        }
     }
 
-    // Now that all plugins were loaded, we call initializeDependencies() on all active ones:
+    QSet<IPlugin*> uninitialized_plugins = initializePlugins(plugins_to_initialize);
+
+    // Now that all plugins were initialized, we call initializeDependencies() on all active ones, in the order of their dependencies:
+    QList<IPlugin*> all_plugins;
     for (int i = 0; i < d->plugins.subjectCount(); ++i) {
         IPlugin* pluginIFace = qobject_cast<IPlugin*> (d->plugins.subjectAt(i));
-        if (pluginIFace) {
-            bool is_inactive_plugin = false;
-            foreach (const QString& inactivePluginName, d->set_inactive_plugins) {
-                if (pluginIFace->pluginName() == inactivePluginName) {
-                    is_inactive_plugin = true;
-                    break;
-                }
-            }
+        if (pluginIFace)
+            all_plugins << pluginIFace;
+    }
+    all_plugins = pluginsInDependencyOrder(all_plugins);
 
-            if (!is_inactive_plugin) {
+    for (int i = 0; i < all_plugins.count(); ++i) {
+        IPlugin* pluginIFace = all_plugins.at(i);
+        if (pluginIFace) {
+            bool is_inactive_plugin = inactive_plugins.contains(pluginIFace->pluginName());
+
+            if (uninitialized_plugins.contains(pluginIFace)) {
+                // The reason was logged and added to the plugin's error messages in initializePlugins():
+                LOG_WARNING(QString("Plugin %1 was not initialized, thus its dependencies will not be initialized either.").arg(pluginIFace->pluginName()));
+            } else if (deferred_plugins.contains(pluginIFace)) {
+                // The dependencies of deferred plugins are initialized in activatePlugin().
+            } else if (!is_inactive_plugin) {
                 QStringList error_strings;
                 emit newProgressMessage(QString("Initializing dependencies in plugin: %1").arg(pluginIFace->pluginName()));
-                QCoreApplication::processEvents();
-                #ifdef QTILITIES_BENCHMARKING
-                time_t start_init_dep,end_init_dep;
-                time(&start_init_dep);
-                #endif
-                if (!pluginIFace->initializeDependencies(&error_strings)) {
+                IDLE_SCHEDULER->yieldToEventLoop();
+                const qint64 dependencies_start = StartupProfiler::instance()->elapsed();
+                bool dependencies_initialized = pluginIFace->initializeDependencies(&error_strings);
+                StartupProfiler::instance()->recordSpan(pluginIFace->pluginName(),"initializeDependencies()",dependencies_start,StartupProfiler::instance()->elapsed());
+                if (!dependencies_initialized) {
                     pluginIFace->addPluginState(IPlugin::ErrorState);
                     pluginIFace->addErrorMessages(error_strings);
                     LOG_ERROR("Plugin (" + pluginIFace->pluginName() + ") failed during dependency initialization with error(s): " + error_strings.join(","));
@@ -284,11 +527,6 @@ void Qtilities::ExtensionSystem::ExtensionSystemCore::initialize() {
                     d->current_active_plugins << pluginIFace->pluginName();
                     LOG_INFO("Successfully initialized dependencies in plugin \"" + pluginIFace->pluginName() + "\".");
                 }
-                #ifdef QTILITIES_BENCHMARKING
-                time(&end_init_dep);
-                double diff_init_dep = difftime(end_init_dep,start_init_dep);
-                qDebug() << QString("Initializing dependencies in plugin " + pluginIFace->pluginName() + " took " + QString::number(diff_init_dep) + " seconds.");
-                #endif
 
                 // Set the foreground color of core plugins:
                 if (d->core_plugins.contains(pluginIFace->pluginName())) {
@@ -308,48 +546,264 @@ void Qtilities::ExtensionSystem::ExtensionSystemCore::initialize() {
 
                 LOG_INFO(QString("Inactive plugin found which will not be initialized: %1").arg(pluginIFace->pluginName()));
             }
-            OBJECT_MANAGER->registerObject(d->plugins.subjectAt(i),QtilitiesCategory("Core::Plugins (IPlugin)","::"));
-
-            // Give the plugin an icon depending on its state:
-            if (pluginIFace->pluginState() == IPlugin::Functional) {
-                SharedProperty icon_property(qti_prop_DECORATION,QIcon(qti_icon_SUCCESS_16x16));
-                ObjectManager::setSharedProperty(pluginIFace->objectBase(),icon_property);
-            } else if (pluginIFace->pluginState() & IPlugin::ErrorState) {
-                SharedProperty icon_property(qti_prop_DECORATION,QIcon(qti_icon_ERROR_16x16));
-                ObjectManager::setSharedProperty(pluginIFace->objectBase(),icon_property);
-            } else if (pluginIFace->pluginState() & IPlugin::IncompatibleState) {
-                SharedProperty icon_property(qti_prop_DECORATION,QIcon(qti_icon_WARNING_16x16));
-                ObjectManager::setSharedProperty(pluginIFace->objectBase(),icon_property);
-            } else if (pluginIFace->pluginState() == IPlugin::InActive) {
-                SharedProperty icon_property(qti_prop_DECORATION,QIcon(qti_icon_SUCCESS_16x16));
-                ObjectManager::setSharedProperty(pluginIFace->objectBase(),icon_property);
-            }
+            OBJECT_MANAGER->registerObject(pluginIFace->objectBase(),QtilitiesCategory("Core::Plugins (IPlugin)","::"));
+            updatePluginIcon(pluginIFace);
         }
     }
 
-    #ifndef QT_NO_DEBUG
-    time(&end);
-    double diff = difftime(end,start);
-    LOG_TRACE(QString("Extension system took %1 second(s) to load %2 plugins. They were initialized according to your active configuration set.").arg(QString::number(diff)).arg(QString::number(d->plugins.subjectCount())));
-    #endif
+    const qint64 loading_end = StartupProfiler::instance()->elapsed();
+    StartupProfiler::instance()->recordSpan("Extension System","Plugin Loading",loading_start,loading_end);
+    LOG_TAG_TRACE(Qtilities::Logging::Logger::ExtensionSystemLogTag,QString("Extension system took %1 ms to load %2 plugins. They were initialized according to your active configuration set.").arg(QString::number((loading_end - loading_start) / 1000.0,'f',1)).arg(QString::number(d->plugins.subjectCount())));
 
     // Only connect here since the signal will be emitted in above code:
     connect(d->plugin_activity_filter,SIGNAL(activeSubjectsChanged(QList<QObject*>,QList<QObject*>)),SLOT(handlePluginConfigurationChange(QList<QObject*>,QList<QObject*>)));
 
     // TODO: If there was errors or warnings, msgbox the user and ask if they want to review the errors.
     OBJECT_MANAGER->objectPool()->endProcessingCycle(false);
+    OBJECT_MANAGER->endNotificationBatch();
+
+    if (d->manifest_cache_enabled && d->manifest_cache.isModified()) {
+        QString errorMsg;
+        if (!d->manifest_cache.save(pluginManifestCacheFile(),&errorMsg))
+            LOG_WARNING(errorMsg);
+    }
 
     emit newProgressMessage(QString("Finished loading plugins in %1 directories.").arg(d->customPluginPaths.count()));
-    QCoreApplication::processEvents();
+    IDLE_SCHEDULER->yieldToEventLoop();
 
     d->is_initialized = true;
 
     emit pluginLoadingCompleted();
 }
 
+QSet<IPlugin*> Qtilities::ExtensionSystem::ExtensionSystemCore::initializePlugins(const QList<IPlugin*>& plugins) {
+    QList<IPlugin*> ordered_plugins = pluginsInDependencyOrder(plugins);
+    QHash<QString,int> plugin_indexes;
+    for (int i = 0; i < ordered_plugins.count(); ++i)
+        plugin_indexes[ordered_plugins.at(i)->pluginName()] = i;
+
+    // The list is not modified while plugins are initializing, thus pointers into it remain valid:
+    QList<PluginInitialization> initializations;
+    QSet<IPlugin*> uninitialized_plugins;
+    for (int i = 0; i < ordered_plugins.count(); ++i) {
+        PluginInitialization initialization;
+        initialization.plugin = ordered_plugins.at(i);
+        foreach (const QString& dependency, initialization.plugin->pluginDependencies()) {
+            if (plugin_indexes.contains(dependency)) {
+                initialization.dependencies << plugin_indexes[dependency];
+            } else if (initialization.status == PluginWaiting) {
+                QString error_string = tr("Plugin %1 depends on plugin %2, which was not found or is not active.").arg(initialization.plugin->pluginName()).arg(dependency);
+                LOG_ERROR(error_string);
+                initialization.plugin->addPluginState(IPlugin::ErrorState);
+                initialization.plugin->addErrorMessage(error_string);
+                initialization.status = PluginSkipped;
+                uninitialized_plugins << initialization.plugin;
+            }
+        }
+        initializations << initialization;
+    }
+
+    QThreadPool thread_pool;
+    PluginInitializationResults results;
+    int running = 0;
+    bool busy = true;
+    while (busy) {
+        // Handle the plugins which finished initializing on worker threads:
+        QList<int> finished_plugins;
+        {
+            QMutexLocker locker(&results.mutex);
+            finished_plugins = results.finished_plugins;
+            results.finished_plugins.clear();
+        }
+
+        QList<int> main_thread_plugins;
+        for (int i = 0; i < initializations.count(); ++i) {
+            PluginInitialization& initialization = initializations[i];
+            if (finished_plugins.contains(i))
+                --running;
+            else if (initialization.status != PluginWaiting)
+                continue;
+
+            if (initialization.status == PluginWaiting) {
+                bool ready = true;
+                for (int dep = 0; dep < initialization.dependencies.count(); ++dep) {
+                    const PluginInitialization& dependency = initializations.at(initialization.dependencies.at(dep));
+                    if (dependency.status == PluginFailed || dependency.status == PluginSkipped) {
+                        QString error_string = tr("Plugin %1 depends on plugin %2, which was not initialized successfully.").arg(initialization.plugin->pluginName()).arg(dependency.plugin->pluginName());
+                        LOG_ERROR(error_string);
+                        initialization.plugin->addPluginState(IPlugin::ErrorState);
+                        initialization.plugin->addErrorMessage(error_string);
+                        initialization.status = PluginSkipped;
+                        uninitialized_plugins << initialization.plugin;
+                        ready = false;
+                        break;
+                    } else if (dependency.status != PluginInitialized) {
+                        ready = false;
+                    }
+                }
+                if (!ready)
+                    continue;
+
+                if (initialization.plugin->pluginInitializationAffinity() == IPlugin::InitializeInAnyThread) {
+                    initialization.status = PluginInitializing;
+                    ++running;
+                    thread_pool.start(new PluginInitializationRunnable(i,&initialization,&results));
+                } else
+                    main_thread_plugins << i;
+                continue;
+            }
+
+            // The plugin finished initializing:
+            QString file_name = QFileInfo(initialization.plugin->pluginFileName()).fileName();
+            if (!initialization.successful) {
+                LOG_ERROR("Plugin (" + file_name + ") failed during initialization with error(s): " + initialization.error_strings.join(","));
+                initialization.plugin->addPluginState(IPlugin::ErrorState);
+                initialization.plugin->addErrorMessages(initialization.error_strings);
+                initialization.status = PluginFailed;
+            } else {
+                LOG_INFO("Successfully initialized plugin \"" + file_name + "\".");
+                initialization.status = PluginInitialized;
+            }
+        }
+
+        // Initialize one plugin on the main thread, after which plugins which depend on it can be started on the pool:
+        if (!main_thread_plugins.isEmpty()) {
+            PluginInitialization& initialization = initializations[main_thread_plugins.first()];
+            emit newProgressMessage(QString("Initializing plugin: %1").arg(initialization.plugin->pluginName()));
+            IDLE_SCHEDULER->yieldToEventLoop();
+            initialization.status = PluginInitializing;
+            callPluginInitialize(&initialization);
+
+            QMutexLocker locker(&results.mutex);
+            results.finished_plugins << main_thread_plugins.first();
+            ++running;
+            continue;
+        }
+
+        if (finished_plugins.isEmpty() && running > 0) {
+            QMutexLocker locker(&results.mutex);
+            if (results.finished_plugins.isEmpty())
+                results.finished.wait(&results.mutex);
+            continue;
+        }
+
+        // When nothing is running and nothing finished, the plugins which are still waiting depend on each other:
+        if (running == 0 && finished_plugins.isEmpty()) {
+            for (int i = 0; i < initializations.count(); ++i) {
+                PluginInitialization& initialization = initializations[i];
+                if (initialization.status != PluginWaiting)
+                    continue;
+
+                QString error_string = tr("Plugin %1 was not initialized since its dependencies are circular.").arg(initialization.plugin->pluginName());
+                LOG_ERROR(error_string);
+                initialization.plugin->addPluginState(IPlugin::ErrorState);
+                initialization.plugin->addErrorMessage(error_string);
+                initialization.status = PluginSkipped;
+                uninitialized_plugins << initialization.plugin;
+            }
+            busy = false;
+        }
+    }
+
+    return uninitialized_plugins;
+}
+
+QList<IPlugin*> Qtilities::ExtensionSystem::ExtensionSystemCore::pluginsInDependencyOrder(const QList<IPlugin*>& plugins) const {
+    QStringList plugin_names;
+    for (int i = 0; i < plugins.count(); ++i)
+        plugin_names << plugins.at(i)->pluginName();
+
+    // Plugins without dependencies keep the order in which they were found:
+    QList<IPlugin*> ordered_plugins;
+    QSet<QString> ordered_names;
+    QList<IPlugin*> remaining_plugins = plugins;
+    bool progress = true;
+    while (!remaining_plugins.isEmpty() && progress) {
+        progress = false;
+        for (int i = 0; i < remaining_plugins.count(); ++i) {
+            bool ready = true;
+            foreach (const QString& dependency, remaining_plugins.at(i)->pluginDependencies()) {
+                if (plugin_names.contains(dependency) && !ordered_names.contains(dependency)) {
+                    ready = false;
+                    break;
+                }
+            }
+
+            if (ready) {
+                ordered_names << remaining_plugins.at(i)->pluginName();
+                ordered_plugins << remaining_plugins.takeAt(i);
+                progress = true;
+                break;
+            }
+        }
+    }
+
+    ordered_plugins << remaining_plugins;
+    return ordered_plugins;
+}
+
+bool Qtilities::ExtensionSystem::ExtensionSystemCore::attachPlugin(IPlugin* pluginIFace, const QString& file_name, QSet<QString>* plugin_names) {
+    QString stripped_file_name = QFileInfo(file_name).fileName();
+
+    // Check that the plugins with the same does not exist:
+    if (plugin_names->contains(pluginIFace->pluginName())) {
+        LOG_WARNING(QString("A plugin called %1 already exists. Plugin won't be loaded from file: %2").arg(pluginIFace->pluginName()).arg(stripped_file_name));
+        return false;
+    }
+
+    // Set the object name of the plugin:
+    pluginIFace->objectBase()->setObjectName(pluginIFace->pluginName());
+
+    // Set the category property of the plugin:
+    MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
+    category_property.setValue(qVariantFromValue(pluginIFace->pluginCategory()),d->plugins.observerID());
+    ObjectManager::setMultiContextProperty(pluginIFace->objectBase(),category_property);
+
+    // Store the file name:
+    pluginIFace->setPluginFileName(file_name);
+
+    // Do a plugin compatibility check here:
+    if (pluginIFace->pluginVersionInformation().hasSupportedVersions()) {
+        if (!pluginIFace->pluginVersionInformation().isSupportedVersion(QCoreApplication::applicationVersion())) {
+            LOG_ERROR(QString("Incompatible plugin version of the following plugin detected (in file %1): Your application version (v%2) is not found in the list of compatible application versions that this plugin supports.").arg(stripped_file_name).arg(QCoreApplication::applicationVersion()));
+            pluginIFace->addPluginState(IPlugin::IncompatibleState);
+            pluginIFace->addErrorMessage(QString("Application version (v%2) is not found in the list of compatible application versions that this plugin supports.").arg(QCoreApplication::applicationVersion()));
+        }
+    }
+
+    d->plugins.attachSubject(pluginIFace->objectBase());
+    *plugin_names << pluginIFace->pluginName();
+    return true;
+}
+
+void Qtilities::ExtensionSystem::ExtensionSystemCore::updatePluginIcon(IPlugin* plugin) {
+    if (plugin->pluginState() == IPlugin::Functional) {
+        SharedProperty icon_property(qti_prop_DECORATION,QIcon(qti_icon_SUCCESS_16x16));
+        ObjectManager::setSharedProperty(plugin->objectBase(),icon_property);
+    } else if (plugin->pluginState() & IPlugin::ErrorState) {
+        SharedProperty icon_property(qti_prop_DECORATION,QIcon(qti_icon_ERROR_16x16));
+        ObjectManager::setSharedProperty(plugin->objectBase(),icon_property);
+    } else if (plugin->pluginState() & IPlugin::IncompatibleState) {
+        SharedProperty icon_property(qti_prop_DECORATION,QIcon(qti_icon_WARNING_16x16));
+        ObjectManager::setSharedProperty(plugin->objectBase(),icon_property);
+    } else if (plugin->pluginState() == IPlugin::InActive || plugin->pluginState() == IPlugin::Deferred) {
+        SharedProperty icon_property(qti_prop_DECORATION,QIcon(qti_icon_SUCCESS_16x16));
+        ObjectManager::setSharedProperty(plugin->objectBase(),icon_property);
+    }
+}
+
 void Qtilities::ExtensionSystem::ExtensionSystemCore::finalize() {
     disconnect(d->plugin_activity_filter,SIGNAL(activeSubjectsChanged(QList<QObject*>,QList<QObject*>)),this,SLOT(handlePluginConfigurationChange(QList<QObject*>,QList<QObject*>)));
 
+    // Capture the snapshot while the user interface contributed by plugins still exists:
+    if (d->startup_snapshot_enabled && !d->plugin_files_hash.isEmpty()) {
+        StartupSnapshot snapshot;
+        snapshot.capture(d->plugin_files_hash);
+        QString errorMsg;
+        if (!snapshot.save(startupSnapshotFile(),&errorMsg))
+            LOG_WARNING("Failed to save the startup snapshot: " + errorMsg);
+    }
+
     // Loop through all plugins and call finalize on them:
     d->plugins.startProcessingCycle();
     int plugin_count = d->plugins.subjectCount();
@@ -358,7 +812,7 @@ void Qtilities::ExtensionSystem::ExtensionSystemCore::finalize() {
 
         if (pluginIFace) {
             emit newProgressMessage(QString("Finalizing plugin: %1").arg(pluginIFace->pluginName()));
-            QCoreApplication::processEvents();
+            IDLE_SCHEDULER->yieldToEventLoop();
 
             // Check that it is active:
             if (d->current_active_plugins.contains(pluginIFace->pluginName()))
@@ -403,6 +857,62 @@ Qtilities::ExtensionSystem::Interfaces::IPlugin* Qtilities::ExtensionSystem::Ext
         return 0;
 }
 
+bool Qtilities::ExtensionSystem::ExtensionSystemCore::activatePlugin(const QString& plugin_name) {
+    if (d->current_active_plugins.contains(plugin_name))
+        return true;
+    if (!d->deferred_plugins.contains(plugin_name))
+        return false;
+
+    IPlugin* pluginIFace = findPlugin(plugin_name);
+    if (!pluginIFace)
+        return false;
+
+    if (QThread::currentThread() != thread()) {
+        LOG_ERROR(QString("Plugin %1 can only be activated on the main thread.").arg(plugin_name));
+        return false;
+    }
+
+    // Removing it first also stops dependency cycles between deferred plugins:
+    d->deferred_plugins.removeOne(plugin_name);
+    pluginIFace->removePluginState(IPlugin::Deferred);
+
+    QStringList error_strings;
+    foreach (const QString& dependency, pluginIFace->pluginDependencies()) {
+        if (d->current_active_plugins.contains(dependency))
+            continue;
+        if (!activatePlugin(dependency))
+            error_strings << QString("Dependency %1 is not active.").arg(dependency);
+    }
+
+    emit newProgressMessage(QString("Activating plugin: %1").arg(plugin_name));
+    bool activated = false;
+    {
+        StartupProfileScope profile_scope(plugin_name,"Deferred Activation");
+        if (error_strings.isEmpty() && pluginIFace->initialize(QStringList(),&error_strings)) {
+            if (pluginIFace->initializeDependencies(&error_strings))
+                activated = true;
+        }
+    }
+
+    if (activated) {
+        d->current_active_plugins << plugin_name;
+        LOG_INFO("Successfully activated plugin \"" + plugin_name + "\".");
+    } else {
+        pluginIFace->addPluginState(IPlugin::ErrorState);
+        pluginIFace->addErrorMessages(error_strings);
+        LOG_ERROR("Plugin (" + plugin_name + ") failed during activation with error(s): " + error_strings.join(","));
+    }
+    updatePluginIcon(pluginIFace);
+
+    if (activated)
+        emit pluginActivated(plugin_name);
+    return activated;
+}
+
+QStringList Qtilities::ExtensionSystem::ExtensionSystemCore::deferredPlugins() const {
+    return d->deferred_plugins;
+}
+
 void Qtilities::ExtensionSystem::ExtensionSystemCore::addPluginPath(const QString& path) {
     foreach (const QString& existing_path, d->customPluginPaths) {
         if (FileUtils::comparePaths(path,existing_path))
@@ -420,6 +930,52 @@ QStringList Qtilities::ExtensionSystem::ExtensionSystemCore::pluginPaths() const
     return d->customPluginPaths;
 }
 
+void Qtilities::ExtensionSystem::ExtensionSystemCore::setPluginManifestCacheEnabled(bool is_enabled) {
+    d->manifest_cache_enabled = is_enabled;
+}
+
+bool Qtilities::ExtensionSystem::ExtensionSystemCore::pluginManifestCacheEnabled() const {
+    return d->manifest_cache_enabled;
+}
+
+void Qtilities::ExtensionSystem::ExtensionSystemCore::setPluginManifestCacheFile(const QString& file_name) {
+    d->manifest_cache_file = file_name;
+}
+
+QString Qtilities::ExtensionSystem::ExtensionSystemCore::pluginManifestCacheFile() const {
+    if (d->manifest_cache_file.isEmpty())
+        return QtilitiesApplication::applicationSessionPath() + QDir::separator() + "plugin_manifests.xml";
+    return d->manifest_cache_file;
+}
+
+void Qtilities::ExtensionSystem::ExtensionSystemCore::setStartupSnapshotEnabled(bool is_enabled) {
+    d->startup_snapshot_enabled = is_enabled;
+}
+
+bool Qtilities::ExtensionSystem::ExtensionSystemCore::startupSnapshotEnabled() const {
+    return d->startup_snapshot_enabled;
+}
+
+void Qtilities::ExtensionSystem::ExtensionSystemCore::setStartupSnapshotFile(const QString& file_name) {
+    d->startup_snapshot_file = file_name;
+}
+
+QString Qtilities::ExtensionSystem::ExtensionSystemCore::startupSnapshotFile() const {
+    if (d->startup_snapshot_file.isEmpty())
+        return QtilitiesApplication::applicationSessionPath() + QDir::separator() + "startup_snapshot.dat";
+    return d->startup_snapshot_file;
+}
+
+const Qtilities::CoreGui::StartupSnapshot* Qtilities::ExtensionSystem::ExtensionSystemCore::startupSnapshot() const {
+    if (d->startup_snapshot_enabled && d->startup_snapshot.isValid())
+        return &d->startup_snapshot;
+    return 0;
+}
+
+QByteArray Qtilities::ExtensionSystem::ExtensionSystemCore::pluginFilesHash() const {
+    return d->plugin_files_hash;
+}
+
 QString Qtilities::ExtensionSystem::ExtensionSystemCore::activePluginConfigurationFile() const {
     return d->active_configuration_file;
 }
@@ -528,7 +1084,7 @@ bool Qtilities::ExtensionSystem::ExtensionSystemCore::savePluginConfiguration(QS
 
 bool Qtilities::ExtensionSystem::ExtensionSystemCore::loadPluginConfiguration(QString file_name, QStringList* inactive_plugins, QStringList* filtered_plugins) {
     if (d->is_initialized && (!inactive_plugins || !filtered_plugins)) {
-        LOG_DEBUG(QString("Failed to load plugin configuration from file: %1 . The extension system is already initialized.").arg(file_name));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ExtensionSystemLogTag,QString("Failed to load plugin configuration from file: %1 . The extension system is already initialized.").arg(file_name));
         return false;
     }
 
@@ -664,9 +1220,9 @@ bool Qtilities::ExtensionSystem::ExtensionSystemCore::loadPluginConfiguration(QS
 
     if (!d->is_initialized) {
         LOG_INFO("Successfully loaded plugin configuration from file: " + file_name);
-        LOG_DEBUG("Inactive Plugins: " + d->set_inactive_plugins.join(","));
-        LOG_DEBUG("Filtered Plugins: " + d->set_filtered_plugins.join(","));
-        LOG_DEBUG("Core Plugins: " + d->core_plugins.join(","));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ExtensionSystemLogTag,"Inactive Plugins: " + d->set_inactive_plugins.join(","));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ExtensionSystemLogTag,"Filtered Plugins: " + d->set_filtered_plugins.join(","));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ExtensionSystemLogTag,"Core Plugins: " + d->core_plugins.join(","));
     }
 
     d->active_configuration_file = file_name;
@@ -697,7 +1253,7 @@ void Qtilities::ExtensionSystem::ExtensionSystemCore::setCorePlugins(QStringList
         foreach (const QString& core_plugin, d->core_plugins) {
             if (d->set_inactive_plugins.contains(core_plugin)) {
                 d->set_inactive_plugins.removeOne(core_plugin);
-                LOG_DEBUG("ExtensionSystemCore::setCorePlugins() removed plugin " + core_plugin + " from the list of inactive plugins.");
+                LOG_TAG_DEBUG(Qtilities::Logging::Logger::ExtensionSystemLogTag,"ExtensionSystemCore::setCorePlugins() removed plugin " + core_plugin + " from the list of inactive plugins.");
             }
         }
     }
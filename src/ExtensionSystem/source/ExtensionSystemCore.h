@@ -17,9 +17,14 @@
 #include <ObserverHints>
 
 #include <QObject>
+#include <QSet>
 #include <QStringList>
 
 namespace Qtilities {
+    namespace CoreGui {
+        class StartupSnapshot;
+    }
+
     namespace ExtensionSystem {
         using namespace Qtilities::Core;
         namespace Interfaces {
@@ -53,12 +58,14 @@ namespace Qtilities {
 
             //! Initializes the plugin manager by loading all found plugins.
             /*!
-              Will load all plugins in the specified plugin paths. Once an IPlugin interface is discovered, initialize() will be called on it. When all the plugins in the system are loaded, the initializeDependencies() funciton will be called on each plugin.
+              Will load all plugins in the specified plugin paths. Once all plugins are loaded, initialize() will be called on each active plugin, after which the initializeDependencies() funciton will be called on each plugin. Both are called in the order of the dependencies declared through IPlugin::pluginDependencies(), and plugins which allow it through IPlugin::pluginInitializationAffinity() are initialized concurrently on a thread pool.
 
               When enablePluginActivityControl() is true, the initialize() function will attempt to load the default plugin configuration set in the file specified by activePluginConfigurationFile(). If you want to load a file other than the default configuration file you can set it using setActivePluginConfigurationFile() before calling initialize().
 
               It is important to note that the IPlugin implementations loaded through initialize() should live in the same thread as the extension system core instance. Thus you should not move your plugin to a different thread during its lifetime.
 
+              Plugins which are linked statically into the application using Q_IMPORT_PLUGIN are found through QPluginLoader::staticInstances() and are loaded before the plugins in the plugin paths, thus a static plugin takes precedence over a plugin library with the same plugin name. Static plugins are subject to the same filtering, activity control and version checks as plugin libraries, except that filter expressions are matched against their plugin names since they have no files. Their IPlugin::pluginFileName() is the file name of the application. Static and dynamic plugins can be mixed freely, and static plugin support was added in %Qtilities v1.5.
+
               \sa pluginPaths()
               */
             void initialize();
@@ -73,6 +80,26 @@ namespace Qtilities {
 
             //! Function which finds the plugin with the given \p plugin_name and returns its plugin interface. If no plugin exists with that name in the set of loaded plugins (active and inactive plugins), null is returned.
             Interfaces::IPlugin* findPlugin(const QString& plugin_name) const;
+            //! Initializes a plugin of which the activation was deferred until its first use.
+            /*!
+              Calls initialize() and initializeDependencies() on the plugin named \p plugin_name, after activating the deferred plugins it
+              depends on. Once activated, the plugin is part of activePlugins() and pluginActivated() is emitted. This function does nothing
+              when the plugin was activated already, and must be called on the main thread.
+
+              \returns True when the plugin is active, false when it is not a deferred plugin or when its activation failed.
+
+              \sa Interfaces::IPlugin::pluginActivationPolicy(), deferredPlugins()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool activatePlugin(const QString& plugin_name);
+            //! Function to return the names of all active plugins of which the activation is deferred until their first use, and which were not activated yet.
+            /*!
+              \sa activatePlugin()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QStringList deferredPlugins() const;
 
             // --------------------------------
             // Plugin Paths
@@ -95,6 +122,99 @@ namespace Qtilities {
               */
             QStringList pluginPaths() const;
 
+            // --------------------------------
+            // Plugin Manifest Cache
+            // --------------------------------
+            //! Sets if the metadata of plugins is cached, allowing inactive and incompatible plugins to be skipped without loading them.
+            /*!
+              Without the cache, initialize() loads every library in the plugin paths to find out which plugin it contains, including
+              plugins which are inactive in the plugin configuration set. When the cache is enabled, the name, category, version
+              information and details of every plugin that was loaded are stored in pluginManifestCacheFile(), keyed by the file path,
+              size and modification time of the plugin library. On the next startup, plugins of which the library did not change are
+              looked up in the cache:
+              - Inactive plugins are not loaded. They are represented in the plugin tree by an object exposing their cached details,
+                thus they can still be made active in the plugin configuration widget.
+              - Plugins which are not compatible with the application version are not loaded either. Note that this differs from the
+                behavior without the cache, where incompatible plugins are loaded and initialized. These plugins are shown in the
+                error state.
+              - Libraries which do not implement IPlugin are skipped.
+
+              Disabled by default. Call this function before initialize().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setPluginManifestCacheEnabled(bool is_enabled);
+            //! Gets if the metadata of plugins is cached.
+            /*!
+              \sa setPluginManifestCacheEnabled()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool pluginManifestCacheEnabled() const;
+            //! Sets the file in which plugin metadata is cached.
+            /*!
+              By default the cache is stored in QtilitiesApplication::applicationSessionPath()/plugin_manifests.xml.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setPluginManifestCacheFile(const QString& file_name);
+            //! Gets the file in which plugin metadata is cached.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString pluginManifestCacheFile() const;
+
+            // --------------------------------
+            // Startup Snapshot
+            // --------------------------------
+            //! Sets if a startup snapshot of the user interface is stored, allowing it to be constructed before plugins are loaded.
+            /*!
+              When enabled, finalize() captures a Qtilities::CoreGui::StartupSnapshot of the commands, modes and configuration pages of
+              the application in startupSnapshotFile(), validated against pluginFilesHash(). On the next startup, initialize() loads
+              the snapshot after scanning the plugin paths. When the plugin files did not change, action placeholders are registered
+              for all commands in the snapshot before any plugin is loaded, and the snapshot is available through startupSnapshot().
+
+              Disabled by default. Call this function before initialize().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setStartupSnapshotEnabled(bool is_enabled);
+            //! Gets if a startup snapshot of the user interface is stored.
+            /*!
+              \sa setStartupSnapshotEnabled()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool startupSnapshotEnabled() const;
+            //! Sets the file in which the startup snapshot is stored.
+            /*!
+              By default the snapshot is stored in QtilitiesApplication::applicationSessionPath()/startup_snapshot.dat.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setStartupSnapshotFile(const QString& file_name);
+            //! Gets the file in which the startup snapshot is stored.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString startupSnapshotFile() const;
+            //! Gets the startup snapshot which was loaded by initialize().
+            /*!
+              \returns The snapshot, or null when the snapshot is disabled, when no snapshot was stored or when the plugin files changed
+              since it was stored.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            const CoreGui::StartupSnapshot* startupSnapshot() const;
+            //! Gets a hash of the file names, sizes and modification times of the plugin libraries found by initialize().
+            /*!
+              The hash includes the application version. It is only calculated when the startup snapshot is enabled, and is empty before
+              initialize() was called.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QByteArray pluginFilesHash() const;
+
             // --------------------------------
             // Plugin Configuration Sets
             // --------------------------------
@@ -172,6 +292,8 @@ namespace Qtilities {
               Sets a list of wildcard mode <b>regular expressions</b> which will be evaluated during initialize(). Each plugin file that
               is found will be checked against this wildcard mode regular expression and if it matches the expression, it will not be loaded. See QRegExp::Wildcard for more information.
 
+              Plugins linked statically into the application do not have files, thus the expressions are matched against their IPlugin::pluginName() implementations instead.
+
               \note This function only does something usefull when called before initialize().
               */
             void setFilteredPlugins(QStringList filtered_plugins);
@@ -258,12 +380,35 @@ if (!core_plugins_ok) {
              * <i>This class was added in %Qtilities v1.3.</i>
              */
             void pluginPathsChanged(const QStringList& plugin_paths);
+            //! Signal which is emitted when a plugin of which the activation was deferred was activated.
+            /*!
+             * \sa activatePlugin()
+             *
+             * <i>This signal was added in %Qtilities v1.5.</i>
+             */
+            void pluginActivated(const QString& plugin_name);
 
         public slots:
             //! Handle plugin configuration changes.
             void handlePluginConfigurationChange(QList<QObject*> active_plugins, QList<QObject*> inactive_plugins);
 
         private:
+            //! Calls initialize() on \p plugins in the order of their dependencies, initializing independent plugins concurrently when their affinity allows it.
+            /*!
+              \returns The plugins on which initialize() was not called because their dependencies were not initialized.
+              */
+            QSet<Interfaces::IPlugin*> initializePlugins(const QList<Interfaces::IPlugin*>& plugins);
+            //! Sorts \p plugins so that every plugin comes after the plugins in \p plugins it depends on. Plugins in dependency cycles are placed last.
+            QList<Interfaces::IPlugin*> pluginsInDependencyOrder(const QList<Interfaces::IPlugin*>& plugins) const;
+            //! Attaches a loaded plugin to the plugin tree after checking that its name is unique and that it supports the application version.
+            /*!
+              \param file_name The file from which the plugin was loaded, which is the application file for static plugins.
+              \param plugin_names The names of the plugins attached so far. The name of \p pluginIFace is added when it is attached.
+              \returns True when the plugin was attached, false when a plugin with the same name exists already.
+              */
+            bool attachPlugin(Interfaces::IPlugin* pluginIFace, const QString& file_name, QSet<QString>* plugin_names);
+            //! Gives \p plugin an icon depending on its state.
+            void updatePluginIcon(Interfaces::IPlugin* plugin);
             QString regExpToXml(QString pattern) const;
             QString xmlToRegExp(QString xml) const;
             ExtensionSystemCore(QObject* parent = 0);
@@ -49,17 +49,37 @@ namespace Qtilities {
                     Functional = 0,             /*!< The plugin is fully functional and no errors were reported during initialization and dependency initialization. */
                     IncompatibleState = 1,      /*!< The plugin is loaded, but indicated that it is incompatible with the current version of the application it was loaded in. See errorMsg() for a list of error messages. */
                     ErrorState = 2,             /*!< The plugin is loaded, but errors occured. See errorMsg() for a list of error messages. */
-                    InActive = 4                /*!< The plugin was loaded but not initialized. \sa ExtensionSystemCore::setInactivePlugins().  */
+                    InActive = 4,               /*!< The plugin was loaded but not initialized. \sa ExtensionSystemCore::setInactivePlugins().  */
+                    Deferred = 8                /*!< The plugin is active, but it will only be initialized when it is used for the first time. \sa pluginActivationPolicy(). <i>This state was added in %Qtilities v1.5.</i> */
                 };
                 Q_DECLARE_FLAGS(PluginStateFlags, PluginState)
                 Q_FLAGS(PluginStateFlags)
 
+                //! The threads on which initialize() can be called.
+                /*!
+                  <i>This enum was added in %Qtilities v1.5.</i>
+                  */
+                enum PluginInitializationAffinity {
+                    InitializeInMainThread = 0, /*!< initialize() is called on the main thread. This is the default. */
+                    InitializeInAnyThread = 1   /*!< initialize() can be called on a worker thread, at the same time as the initialize() functions of other plugins. */
+                };
+                //! The moments at which an active plugin can be initialized.
+                /*!
+                  <i>This enum was added in %Qtilities v1.5.</i>
+                  */
+                enum PluginActivationPolicy {
+                    ActivateOnStartup = 0,      /*!< The plugin is initialized in ExtensionSystemCore::initialize(). This is the default. */
+                    ActivateOnFirstUse = 1      /*!< Only initializeActivationStubs() is called in ExtensionSystemCore::initialize(), the plugin is initialized in ExtensionSystemCore::activatePlugin(). */
+                };
+
                 //! Function which returns a string associated with a the plugin's state.
                 QString pluginStateString() const {
                     if (d_state == Functional)
                         return QObject::tr("Functional");
                     else if (d_state == InActive)
                         return QObject::tr("Inactive");
+                    else if (d_state == Deferred)
+                        return QObject::tr("Not Activated Yet");
                     else {
                         QString combined_error_str;
                         if (d_state == ErrorState)
@@ -75,6 +95,11 @@ namespace Qtilities {
                 }
                 //! Adds a PluginState the PluginStateFlags of the plugin.
                 void addPluginState(PluginState state) { d_state = d_state | state; }
+                //! Removes a PluginState from the PluginStateFlags of the plugin.
+                /*!
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                void removePluginState(PluginState state) { d_state &= ~state; }
                 //! Gets the plugin state.
                 PluginStateFlags pluginState() const { return d_state; }
                 //! Sets the plugin file name.
@@ -115,6 +140,60 @@ namespace Qtilities {
                     If your plugin needs to do something before it is unloaded (save settings for example), do it in here.
                     */
                 virtual void finalize() { }
+                //! The names of the plugins which must be initialized before this plugin.
+                /*!
+                  The extension system calls initialize() and initializeDependencies() on a plugin only after it called them on all the plugins
+                  returned by this function. When one of these plugins is not found, is inactive, or failed during initialization, this plugin
+                  is not initialized and ends up in the ErrorState.
+
+                  Returns an empty list by default, in which case plugins are initialized in the order in which they were found.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual QStringList pluginDependencies() const { return QStringList(); }
+                //! The threads on which initialize() can be called.
+                /*!
+                  Plugins returning InitializeInAnyThread are initialized on a thread pool, at the same time as other plugins of which the
+                  dependencies were initialized, while plugins returning InitializeInMainThread are initialized on the main thread in the
+                  meantime. Only return InitializeInAnyThread when your initialize() implementation is thread-safe: it must not create
+                  widgets, and objects it creates live in the worker thread until they are moved to the main thread using
+                  QObject::moveToThread(). initializeDependencies() is always called on the main thread.
+
+                  Returns InitializeInMainThread by default.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual PluginInitializationAffinity pluginInitializationAffinity() const { return InitializeInMainThread; }
+                //! Indicates when the plugin must be initialized.
+                /*!
+                  Plugins which are expensive to initialize, but which are not used in every session, can return ActivateOnFirstUse. The
+                  extension system then only calls initializeActivationStubs() during startup, and calls initialize() and initializeDependencies()
+                  when ExtensionSystemCore::activatePlugin() is called for the plugin for the first time. Until then the plugin is in the Deferred
+                  state.
+
+                  A plugin is initialized on startup regardless of its policy when a plugin which is initialized on startup depends on it
+                  through pluginDependencies().
+
+                  Returns ActivateOnStartup by default.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual PluginActivationPolicy pluginActivationPolicy() const { return ActivateOnStartup; }
+                //! This function is called on startup, instead of initialize(), when the plugin returns ActivateOnFirstUse in pluginActivationPolicy().
+                /*!
+                  Register lightweight stubs for the parts of the plugin through which users reach it, and activate the plugin using
+                  ExtensionSystemCore::activatePlugin() when one of them is used. For example, register a DeferredPluginMode instead of the
+                  plugin's mode, and register the plugin's commands in the action manager with their actions connected to a slot which activates
+                  the plugin and then triggers the real action.
+
+                  This function is always called on the main thread, before initializeDependencies() is called on the plugins initialized on startup.
+
+                  \param error_strings Plugins can add error/warning strings to this list when they detect errors.
+                  \returns True if the stubs were registered successfully, false otherwise in which case the plugin ends up in the ErrorState.
+
+                  <i>This function was added in %Qtilities v1.5.</i>
+                  */
+                virtual bool initializeActivationStubs(QStringList* error_strings) { Q_UNUSED(error_strings) return true; }
 
                 // -----------------------------------
                 // Plugin Information Functions
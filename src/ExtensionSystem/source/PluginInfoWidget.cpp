@@ -47,6 +47,8 @@ Qtilities::ExtensionSystem::PluginInfoWidget::PluginInfoWidget(IPlugin* plugin,
                 ui->listErrorMessages->addItem(tr("No errors detected."));
             else if (plugin->pluginState() == IPlugin::InActive)
                 ui->listErrorMessages->addItem(tr("Inactive"));
+            else if (plugin->pluginState() == IPlugin::Deferred)
+                ui->listErrorMessages->addItem(tr("Not activated yet, the plugin will be activated when it is used for the first time."));
         }
 
         if (plugin->pluginVersionInformation().hasSupportedVersions())
@@ -0,0 +1,248 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "PluginManifestCache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDomDocument>
+#include <QFile>
+#include <QTextStream>
+
+// -----------------------------------------
+// PluginManifest
+// -----------------------------------------
+Qtilities::ExtensionSystem::PluginManifest Qtilities::ExtensionSystem::PluginManifest::fromPlugin(const QFileInfo& file_info, IPlugin* plugin) {
+    PluginManifest manifest;
+    manifest.file_path = file_info.absoluteFilePath();
+    manifest.file_size = file_info.size();
+    manifest.file_modified = file_info.lastModified().toTime_t();
+    if (!plugin)
+        return manifest;
+
+    manifest.is_plugin = true;
+    manifest.name = plugin->pluginName();
+    manifest.category = plugin->pluginCategory().toString("::");
+    VersionInformation version_info = plugin->pluginVersionInformation();
+    manifest.version = version_info.version().toString();
+    manifest.supported_versions = version_info.supportedVersionString();
+    manifest.publisher = plugin->pluginPublisher();
+    manifest.publisher_website = plugin->pluginPublisherWebsite();
+    manifest.publisher_contact = plugin->pluginPublisherContact();
+    manifest.description = plugin->pluginDescription();
+    manifest.copyright = plugin->pluginCopyright();
+    manifest.license = plugin->pluginLicense();
+    return manifest;
+}
+
+bool Qtilities::ExtensionSystem::PluginManifest::matchesFile(const QFileInfo& file_info) const {
+    return file_info.exists() && file_size == file_info.size() && file_modified == file_info.lastModified().toTime_t();
+}
+
+Qtilities::Core::VersionInformation Qtilities::ExtensionSystem::PluginManifest::versionInformation() const {
+    QList<VersionNumber> supported;
+    foreach (const QString& supported_version, supported_versions)
+        supported << VersionNumber(supported_version);
+    return VersionInformation(VersionNumber(version),supported);
+}
+
+// -----------------------------------------
+// qti_private_PluginManifestCache
+// -----------------------------------------
+bool Qtilities::ExtensionSystem::qti_private_PluginManifestCache::load(const QString& file_name) {
+    manifests.clear();
+    used_files.clear();
+    modified = false;
+
+    QFile file(file_name);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDomDocument doc("PluginManifests");
+    if (!doc.setContent(&file)) {
+        file.close();
+        return false;
+    }
+    file.close();
+
+    QDomElement root = doc.documentElement();
+    if (root.tagName() != "PluginManifests")
+        return false;
+
+    QDomNodeList children = root.childNodes();
+    for (int i = 0; i < children.count(); ++i) {
+        QDomElement child = children.item(i).toElement();
+        if (child.isNull() || child.tagName() != "Plugin")
+            continue;
+
+        PluginManifest manifest;
+        manifest.file_path = child.attribute("FilePath");
+        manifest.file_size = child.attribute("Size").toLongLong();
+        manifest.file_modified = child.attribute("Modified").toUInt();
+        manifest.is_plugin = (child.attribute("IsPlugin") == "true");
+        manifest.name = child.attribute("Name");
+        manifest.category = child.attribute("Category");
+        manifest.version = child.attribute("Version");
+        QDomNodeList supported_nodes = child.elementsByTagName("SupportedVersion");
+        for (int s = 0; s < supported_nodes.count(); ++s)
+            manifest.supported_versions << supported_nodes.item(s).toElement().attribute("Value");
+        manifest.publisher = child.attribute("Publisher");
+        manifest.publisher_website = child.attribute("PublisherWebsite");
+        manifest.publisher_contact = child.attribute("PublisherContact");
+        manifest.description = child.attribute("Description");
+        manifest.copyright = child.attribute("Copyright");
+        manifest.license = child.attribute("License");
+
+        if (!manifest.file_path.isEmpty())
+            manifests[manifest.file_path] = manifest;
+    }
+
+    return true;
+}
+
+bool Qtilities::ExtensionSystem::qti_private_PluginManifestCache::save(const QString& file_name, QString* errorMsg) const {
+    QDomDocument doc("PluginManifests");
+    QDomElement root = doc.createElement("PluginManifests");
+    doc.appendChild(root);
+
+    foreach (const QString& file_path, used_files) {
+        if (!manifests.contains(file_path))
+            continue;
+
+        const PluginManifest& manifest = manifests[file_path];
+        QDomElement plugin_item = doc.createElement("Plugin");
+        plugin_item.setAttribute("FilePath",manifest.file_path);
+        plugin_item.setAttribute("Size",QString::number(manifest.file_size));
+        plugin_item.setAttribute("Modified",QString::number(manifest.file_modified));
+        plugin_item.setAttribute("IsPlugin",manifest.is_plugin ? "true" : "false");
+        if (manifest.is_plugin) {
+            plugin_item.setAttribute("Name",manifest.name);
+            plugin_item.setAttribute("Category",manifest.category);
+            plugin_item.setAttribute("Version",manifest.version);
+            foreach (const QString& supported_version, manifest.supported_versions) {
+                QDomElement supported_item = doc.createElement("SupportedVersion");
+                supported_item.setAttribute("Value",supported_version);
+                plugin_item.appendChild(supported_item);
+            }
+            plugin_item.setAttribute("Publisher",manifest.publisher);
+            plugin_item.setAttribute("PublisherWebsite",manifest.publisher_website);
+            plugin_item.setAttribute("PublisherContact",manifest.publisher_contact);
+            plugin_item.setAttribute("Description",manifest.description);
+            plugin_item.setAttribute("Copyright",manifest.copyright);
+            plugin_item.setAttribute("License",manifest.license);
+        }
+        root.appendChild(plugin_item);
+    }
+
+    QFileInfo fi(file_name);
+    if (!QDir().mkpath(fi.path())) {
+        if (errorMsg)
+            *errorMsg = QString("Failed to create the directory of the plugin manifest cache: %1").arg(fi.path());
+        return false;
+    }
+
+    QFile file(file_name);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        if (errorMsg)
+            *errorMsg = QString("Failed to open the plugin manifest cache for writing: %1").arg(file_name);
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream.setCodec("UTF-8");
+    stream << doc.toString(2);
+    stream.flush();
+    file.close();
+    return true;
+}
+
+bool Qtilities::ExtensionSystem::qti_private_PluginManifestCache::find(const QFileInfo& file_info, PluginManifest* manifest) {
+    QString file_path = file_info.absoluteFilePath();
+    if (!manifests.contains(file_path))
+        return false;
+
+    const PluginManifest& cached = manifests[file_path];
+    if (!cached.matchesFile(file_info))
+        return false;
+
+    if (!used_files.contains(file_path))
+        used_files << file_path;
+    if (manifest)
+        *manifest = cached;
+    return true;
+}
+
+void Qtilities::ExtensionSystem::qti_private_PluginManifestCache::insert(const PluginManifest& manifest) {
+    manifests[manifest.file_path] = manifest;
+    if (!used_files.contains(manifest.file_path))
+        used_files << manifest.file_path;
+    modified = true;
+}
+
+bool Qtilities::ExtensionSystem::qti_private_PluginManifestCache::isModified() const {
+    return modified || used_files.count() != manifests.count();
+}
+
+// -----------------------------------------
+// qti_private_CachedPlugin
+// -----------------------------------------
+Qtilities::ExtensionSystem::qti_private_CachedPlugin::qti_private_CachedPlugin(const PluginManifest& manifest, QObject* parent) : QObject(parent), manifest(manifest) {
+    setObjectName(manifest.name);
+}
+
+bool Qtilities::ExtensionSystem::qti_private_CachedPlugin::initialize(const QStringList &arguments, QStringList *error_strings) {
+    Q_UNUSED(arguments)
+    if (error_strings)
+        *error_strings << tr("The plugin was not loaded.");
+    return false;
+}
+
+bool Qtilities::ExtensionSystem::qti_private_CachedPlugin::initializeDependencies(QStringList *error_strings) {
+    if (error_strings)
+        *error_strings << tr("The plugin was not loaded since it is not compatible with this version of the application.");
+    return false;
+}
+
+QString Qtilities::ExtensionSystem::qti_private_CachedPlugin::pluginName() const {
+    return manifest.name;
+}
+
+Qtilities::Core::QtilitiesCategory Qtilities::ExtensionSystem::qti_private_CachedPlugin::pluginCategory() const {
+    return QtilitiesCategory(manifest.category,"::");
+}
+
+Qtilities::Core::VersionInformation Qtilities::ExtensionSystem::qti_private_CachedPlugin::pluginVersionInformation() const {
+    return manifest.versionInformation();
+}
+
+QString Qtilities::ExtensionSystem::qti_private_CachedPlugin::pluginPublisher() const {
+    return manifest.publisher;
+}
+
+QString Qtilities::ExtensionSystem::qti_private_CachedPlugin::pluginPublisherWebsite() const {
+    return manifest.publisher_website;
+}
+
+QString Qtilities::ExtensionSystem::qti_private_CachedPlugin::pluginPublisherContact() const {
+    return manifest.publisher_contact;
+}
+
+QString Qtilities::ExtensionSystem::qti_private_CachedPlugin::pluginDescription() const {
+    return manifest.description;
+}
+
+QString Qtilities::ExtensionSystem::qti_private_CachedPlugin::pluginCopyright() const {
+    return manifest.copyright;
+}
+
+QString Qtilities::ExtensionSystem::qti_private_CachedPlugin::pluginLicense() const {
+    return manifest.license;
+}
@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef PLUGIN_MANIFEST_CACHE_H
+#define PLUGIN_MANIFEST_CACHE_H
+
+#include "IPlugin.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+
+namespace Qtilities {
+    namespace ExtensionSystem {
+        using namespace Qtilities::ExtensionSystem::Interfaces;
+
+        /*!
+          \struct PluginManifest
+          \brief The metadata of a plugin file, as stored in the plugin manifest cache.
+
+          <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct PluginManifest {
+            PluginManifest() : file_size(-1), file_modified(0), is_plugin(false) {}
+
+            //! Creates a manifest for \p plugin, which was loaded from \p file_info.
+            static PluginManifest fromPlugin(const QFileInfo& file_info, IPlugin* plugin);
+            //! Indicates if the manifest describes \p file_info in its current state on disk.
+            bool matchesFile(const QFileInfo& file_info) const;
+            //! Constructs the version information of the plugin.
+            VersionInformation versionInformation() const;
+
+            QString         file_path;
+            qint64          file_size;
+            uint            file_modified;
+            //! False when the library could be loaded, but does not implement IPlugin.
+            bool            is_plugin;
+            QString         name;
+            QString         category;
+            QString         version;
+            QStringList     supported_versions;
+            QString         publisher;
+            QString         publisher_website;
+            QString         publisher_contact;
+            QString         description;
+            QString         copyright;
+            QString         license;
+        };
+
+        /*!
+          \class qti_private_PluginManifestCache
+          \brief Stores the metadata of plugin files in a file, allowing the extension system to decide which plugins to load without loading them.
+
+          Manifests are keyed by the absolute file path of the plugin, and are only used while the size and modification time of the file
+          did not change.
+
+          <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class qti_private_PluginManifestCache
+        {
+        public:
+            qti_private_PluginManifestCache() : modified(false) {}
+
+            //! Loads the manifests from \p file_name. Returns false when the file does not exist or is not a valid manifest file.
+            bool load(const QString& file_name);
+            //! Saves the manifests of the files used since load() to \p file_name.
+            bool save(const QString& file_name, QString* errorMsg = 0) const;
+
+            //! Finds the manifest of \p file_info. Returns false when there is no manifest or when the file changed since its manifest was stored.
+            bool find(const QFileInfo& file_info, PluginManifest* manifest);
+            //! Stores \p manifest, replacing the previous manifest of its file.
+            void insert(const PluginManifest& manifest);
+            //! Indicates if the manifests changed since they were loaded.
+            bool isModified() const;
+
+        private:
+            QHash<QString,PluginManifest>   manifests;
+            //! The files of which the manifests were found or inserted, only these are saved.
+            QStringList                     used_files;
+            bool                            modified;
+        };
+
+        /*!
+          \class qti_private_CachedPlugin
+          \brief Represents a plugin which was not loaded, using the metadata in its manifest.
+
+          The extension system uses cached plugins for inactive and incompatible plugins when the plugin manifest cache is enabled, thus
+          these plugins are still shown in the plugin configuration widget while their libraries are never loaded.
+
+          <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class qti_private_CachedPlugin : public QObject, public IPlugin
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::ExtensionSystem::Interfaces::IPlugin)
+
+        public:
+            qti_private_CachedPlugin(const PluginManifest& manifest, QObject* parent = 0);
+
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------------------
+            // IPlugin Implementation
+            // --------------------------------------------
+            bool initialize(const QStringList &arguments, QStringList *error_strings);
+            bool initializeDependencies(QStringList *error_strings);
+            QString pluginName() const;
+            QtilitiesCategory pluginCategory() const;
+            VersionInformation pluginVersionInformation() const;
+            QString pluginPublisher() const;
+            QString pluginPublisherWebsite() const;
+            QString pluginPublisherContact() const;
+            QString pluginDescription() const;
+            QString pluginCopyright() const;
+            QString pluginLicense() const;
+
+        private:
+            PluginManifest manifest;
+        };
+    }
+}
+
+#endif // PLUGIN_MANIFEST_CACHE_H
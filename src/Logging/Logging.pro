@@ -14,7 +14,7 @@ INCLUDEPATH += $$QTILITIES_SOURCE/Common
 
 CONFIG += qt dll
 
-QT += core
+QT += core network
 QT -= gui
 
 TARGET = QtilitiesLogging$${QTILITIES_LIB_POSTFIX}
@@ -34,6 +34,7 @@ UI_DIR = $$QTILITIES_TEMP/Logging
 HEADERS += \
     source/AbstractFormattingEngine.h \
     source/AbstractLoggerEngine.h \
+    source/BinaryLoggerEngine.h \
     source/FormattingEngines.h \
     source/ILoggerExportable.h \
     source/LoggerEngines.h \
@@ -41,9 +42,18 @@ HEADERS += \
     source/Logger.h \
     source/LoggingConstants.h \
     source/Logging_global.h \
+    source/NetworkLoggerEngine.h \
+    source/PerformanceCounters.h \
+    source/SessionLogStore.h \
+    source/SettingsStore.h \
 
 SOURCES += \
     source/AbstractLoggerEngine.cpp \
+    source/BinaryLoggerEngine.cpp \
     source/FormattingEngines.cpp \
     source/Logger.cpp \
     source/LoggerEngines.cpp \
+    source/NetworkLoggerEngine.cpp \
+    source/PerformanceCounters.cpp \
+    source/SessionLogStore.cpp \
+    source/SettingsStore.cpp \
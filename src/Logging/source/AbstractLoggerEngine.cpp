@@ -10,6 +10,105 @@
 ****************************************************************************/
 
 #include "AbstractLoggerEngine.h"
+#include "PerformanceCounters.h"
+
+#include <QThread>
+#include <QThreadStorage>
+#include <QWaitCondition>
+
+namespace Qtilities {
+    namespace Logging {
+        // Worker thread used by AbstractLoggerEngine when setWorkerThreadEnabled() is enabled.
+        class AbstractLoggerEngineWorker : public QThread
+        {
+        public:
+            AbstractLoggerEngineWorker(AbstractLoggerEngine* engine, int queue_capacity) : QThread(),
+                engine(engine),
+                queue_capacity(qMax(1,queue_capacity)),
+                stop_requested(false) {}
+
+            //! Queues a formatted message, blocks while the queue is full. Returns false when the worker was stopped, in which case the message was not queued.
+            bool enqueue(const QString& formatted_message, Logger::MessageType message_type) {
+                QMutexLocker locker(&mutex);
+                while (queued_types.count() >= queue_capacity && !stop_requested)
+                    queue_not_full.wait(&mutex);
+                if (stop_requested)
+                    return false;
+                queued_types << message_type;
+                queued_messages << formatted_message;
+                #ifndef QTILITIES_NO_PERFORMANCE_COUNTERS
+                PerformanceCounters::instance()->setValue(engine->abstractLoggerEngineData->queue_depth_counter_id,queued_types.count());
+                #endif
+                queue_not_empty.wakeOne();
+                return true;
+            }
+            //! Stops the worker. When drain is true, all queued messages are logged first, otherwise they are discarded.
+            void stop(bool drain) {
+                mutex.lock();
+                if (!drain) {
+                    queued_types.clear();
+                    queued_messages.clear();
+                }
+                stop_requested = true;
+                // Logging threads waiting for space in the queue do not queue their messages anymore:
+                queue_not_full.wakeAll();
+                queue_not_empty.wakeOne();
+                mutex.unlock();
+                wait();
+            }
+
+        protected:
+            void run() {
+                QList<Logger::MessageType> types;
+                QStringList messages;
+                QMutexLocker locker(&mutex);
+                forever {
+                    while (queued_types.isEmpty() && !stop_requested)
+                        queue_not_empty.wait(&mutex);
+                    if (queued_types.isEmpty() && stop_requested)
+                        break;
+
+                    types.swap(queued_types);
+                    messages.swap(queued_messages);
+                    #ifndef QTILITIES_NO_PERFORMANCE_COUNTERS
+                    PerformanceCounters::instance()->setValue(engine->abstractLoggerEngineData->queue_depth_counter_id,0);
+                    #endif
+                    queue_not_full.wakeAll();
+                    locker.unlock();
+
+                    for (int i = 0; i < types.count(); ++i)
+                        engine->logFormattedMessage(messages.at(i),types.at(i));
+                    types.clear();
+                    messages.clear();
+
+                    locker.relock();
+                }
+            }
+
+        private:
+            AbstractLoggerEngine*           engine;
+            int                             queue_capacity;
+            QMutex                          mutex;
+            QWaitCondition                  queue_not_empty;
+            QWaitCondition                  queue_not_full;
+            QList<Logger::MessageType>      queued_types;
+            QStringList                     queued_messages;
+            bool                            stop_requested;
+        };
+    }
+}
+
+namespace {
+    // The engine on which the Logger is delivering a message through newMessages() on each thread. The default implementation
+    // of newMessages() clears it to tell the Logger that it must deliver the message itself.
+    Q_GLOBAL_STATIC(QThreadStorage<quintptr>, qti_private_intercepting_engines)
+
+    // Returns the worker thread of an engine, guarded by the engine mutex since the worker can be disabled while other threads log messages.
+    QSharedPointer<Qtilities::Logging::AbstractLoggerEngineWorker> qti_private_EngineWorker(Qtilities::Logging::AbstractLoggerEngineData* data) {
+        QMutexLocker locker(&data->engine_mutex);
+        return data->worker;
+    }
+}
 
 Qtilities::Logging::AbstractLoggerEngine::AbstractLoggerEngine() : QObject()
 {
@@ -24,6 +123,15 @@ Qtilities::Logging::AbstractLoggerEngine::AbstractLoggerEngine() : QObject()
 }
 
 Qtilities::Logging::AbstractLoggerEngine::~AbstractLoggerEngine() {
+    QSharedPointer<AbstractLoggerEngineWorker> worker;
+    {
+        QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+        worker = abstractLoggerEngineData->worker;
+        abstractLoggerEngineData->worker.clear();
+    }
+    // The derived engine is already destroyed at this point, thus we can't log queued messages anymore:
+    if (worker)
+        worker->stop(false);
     Log->detachLoggerEngine(this,false);
     delete abstractLoggerEngineData;
 }
@@ -41,15 +149,23 @@ void Qtilities::Logging::AbstractLoggerEngine::setActive(bool is_active) {
         return;
 
     abstractLoggerEngineData->is_enabled = is_active;
+    Log->updateEnabledMessageMask();
 }
 
 void Qtilities::Logging::AbstractLoggerEngine::setName(const QString& name) {
     setObjectName(name);
     abstractLoggerEngineData->engine_name = name;
+    #ifndef QTILITIES_NO_PERFORMANCE_COUNTERS
+    abstractLoggerEngineData->messages_counter_id = PerformanceCounters::instance()->registerCounter(QString("Logger: %1 Messages").arg(name),PerformanceCounters::Count);
+    abstractLoggerEngineData->queue_depth_counter_id = PerformanceCounters::instance()->registerCounter(QString("Logger: %1 Queue Depth").arg(name),PerformanceCounters::Gauge);
+    #endif
+    // Engine specific messages are routed on engine names:
+    Log->updateEnabledMessageMask();
 }
 
 void Qtilities::Logging::AbstractLoggerEngine::setEnabledMessageTypes(Logger::MessageTypeFlags message_types) {
     abstractLoggerEngineData->enabled_message_types = message_types;
+    Log->updateEnabledMessageMask();
 }
 
 Qtilities::Logging::Logger::MessageTypeFlags Qtilities::Logging::AbstractLoggerEngine::getEnabledMessageTypes() const {
@@ -64,6 +180,12 @@ void Qtilities::Logging::AbstractLoggerEngine::enableAllMessageTypes() {
     abstractLoggerEngineData->enabled_message_types |= Logger::Fatal;
     abstractLoggerEngineData->enabled_message_types |= Logger::Debug;
     abstractLoggerEngineData->enabled_message_types |= Logger::Trace;
+    Log->updateEnabledMessageMask();
+}
+
+void Qtilities::Logging::AbstractLoggerEngine::setMessageContexts(Logger::MessageContextFlags message_contexts) {
+    abstractLoggerEngineData->message_contexts = message_contexts;
+    Log->updateEnabledMessageMask();
 }
 
 void Qtilities::Logging::AbstractLoggerEngine::installFormattingEngine(AbstractFormattingEngine* engine) {
@@ -93,28 +215,145 @@ QString Qtilities::Logging::AbstractLoggerEngine::formattingEngineName() {
         return "None";
 }
 
-void Qtilities::Logging::AbstractLoggerEngine::newMessages(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
+bool Qtilities::Logging::AbstractLoggerEngine::acceptsMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context) const {
     if ((!engine_name.isEmpty()) && (engine_name != name()))
-        return;
+        return false;
 
     // Check the message context:
     if (!(abstractLoggerEngineData->message_contexts & message_context))
+        return false;
+
+    // Check if active
+    if (!abstractLoggerEngineData->is_enabled)
+        return false;
+
+    //Check if this message type is allowed
+    return (abstractLoggerEngineData->enabled_message_types & message_type);
+}
+
+void Qtilities::Logging::AbstractLoggerEngine::newFormattedMessage(const QString& formatted_message, Logger::MessageType message_type) {
+    // Messages which reach a worker after it was stopped are logged as if it was disabled:
+    QSharedPointer<AbstractLoggerEngineWorker> worker = qti_private_EngineWorker(abstractLoggerEngineData);
+    if (worker && worker->enqueue(formatted_message,message_type))
         return;
 
-    static QMutex mutex;
-    mutex.lock();
+    if (thread() == QThread::currentThread())
+        logFormattedMessage(formatted_message,message_type);
+    else
+        QMetaObject::invokeMethod(this,"logFormattedMessage",Qt::QueuedConnection,Q_ARG(QString,formatted_message),Q_ARG(Logger::MessageType,message_type));
+}
+
+void Qtilities::Logging::AbstractLoggerEngine::newRecords(const QList<LoggerRecord>& records) {
+    if (logsUnformattedMessages()) {
+        logRecords(records);
+        return;
+    }
 
-    // Check if active
-    if (abstractLoggerEngineData->is_enabled) {
-        // Check if there is a formatting engine present
-        if (abstractLoggerEngineData->formatting_engine) {
-            //Check if this message type is allowed
-            if (abstractLoggerEngineData->enabled_message_types & message_type)
-                logMessage(abstractLoggerEngineData->formatting_engine->formatMessage(message_type,messages),message_type);
+    QSharedPointer<AbstractLoggerEngineWorker> worker = qti_private_EngineWorker(abstractLoggerEngineData);
+    if (worker) {
+        for (int i = 0; i < records.count(); ++i) {
+            if (!worker->enqueue(records.at(i).formatted_message,records.at(i).message_type)) {
+                // The worker was stopped, the remaining records are logged as if it was disabled:
+                newRecords(records.mid(i));
+                return;
+            }
         }
+        return;
     }
 
-    mutex.unlock();
+    if (thread() == QThread::currentThread())
+        logRecords(records);
+    else
+        QMetaObject::invokeMethod(this,"logRecords",Qt::QueuedConnection,Q_ARG(QList<LoggerRecord>,records));
+}
+
+void Qtilities::Logging::AbstractLoggerEngine::newUnformattedMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    logUnformattedMessage(engine_name,message_type,message_context,messages);
+}
+
+void Qtilities::Logging::AbstractLoggerEngine::newMessages(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
+    if (!acceptsMessage(engine_name,message_type,message_context))
+        return;
+    #ifndef QTILITIES_NO_PERFORMANCE_COUNTERS
+    PerformanceCounters::instance()->add(abstractLoggerEngineData->messages_counter_id);
+    #endif
+
+    QThreadStorage<quintptr>* intercepting_engines = qti_private_intercepting_engines();
+    if (intercepting_engines && intercepting_engines->hasLocalData() && intercepting_engines->localData() == reinterpret_cast<quintptr>(this)) {
+        intercepting_engines->setLocalData(0);
+        return;
+    }
+
+    if (logsUnformattedMessages()) {
+        newUnformattedMessage(engine_name,message_type,message_context,messages);
+        return;
+    }
+
+    // Check if there is a formatting engine present
+    if (abstractLoggerEngineData->formatting_engine)
+        newFormattedMessage(abstractLoggerEngineData->formatting_engine->formatMessage(message_type,messages),message_type);
+}
+
+bool Qtilities::Logging::AbstractLoggerEngine::interceptsMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
+    QThreadStorage<quintptr>* intercepting_engines = qti_private_intercepting_engines();
+    if (!intercepting_engines)
+        return false;
+
+    // Messages logged by overrides of newMessages() are delivered while this one is being delivered, thus the previous engine is restored afterwards:
+    const quintptr previous_engine = intercepting_engines->hasLocalData() ? intercepting_engines->localData() : 0;
+    intercepting_engines->setLocalData(reinterpret_cast<quintptr>(this));
+    newMessages(engine_name,message_type,message_context,messages);
+    const bool intercepted = (intercepting_engines->localData() != 0);
+    intercepting_engines->setLocalData(previous_engine);
+    return intercepted;
+}
+
+void Qtilities::Logging::AbstractLoggerEngine::logFormattedMessage(const QString& formatted_message, Logger::MessageType message_type) {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    logMessage(formatted_message,message_type);
+}
+
+void Qtilities::Logging::AbstractLoggerEngine::logRecords(const QList<LoggerRecord>& records) {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    logMessages(records);
+}
+
+void Qtilities::Logging::AbstractLoggerEngine::logMessages(const QList<LoggerRecord>& records) {
+    if (logsUnformattedMessages()) {
+        for (int i = 0; i < records.count(); ++i)
+            logUnformattedMessage(records.at(i).engine_name,records.at(i).message_type,records.at(i).message_context,records.at(i).message_contents);
+    } else {
+        for (int i = 0; i < records.count(); ++i)
+            logMessage(records.at(i).formatted_message,records.at(i).message_type);
+    }
+}
+
+void Qtilities::Logging::AbstractLoggerEngine::setWorkerThreadEnabled(bool is_enabled, int queue_capacity) {
+    QSharedPointer<AbstractLoggerEngineWorker> worker;
+    {
+        QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+        if (is_enabled == !abstractLoggerEngineData->worker.isNull())
+            return;
+
+        if (is_enabled) {
+            abstractLoggerEngineData->worker = QSharedPointer<AbstractLoggerEngineWorker>(new AbstractLoggerEngineWorker(this,queue_capacity));
+            abstractLoggerEngineData->worker->start();
+            return;
+        }
+
+        worker = abstractLoggerEngineData->worker;
+        abstractLoggerEngineData->worker.clear();
+    }
+
+    // The mutex is released first, since the worker locks it while it logs the queued messages. Logging threads which still hold a
+    // reference to the worker log their messages directly once it stopped, and the worker is deleted when the last reference is released:
+    worker->stop(true);
+}
+
+bool Qtilities::Logging::AbstractLoggerEngine::workerThreadEnabled() const {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    return !abstractLoggerEngineData->worker.isNull();
 }
 
 bool Qtilities::Logging::AbstractLoggerEngine::removable() const {
@@ -16,9 +16,13 @@
 #include "AbstractFormattingEngine.h"
 #include "Logging_global.h"
 
+#include <QMutex>
+#include <QSharedPointer>
+
 namespace Qtilities {
     namespace Logging {
         class AbstractFormattingEngine;
+        class AbstractLoggerEngineWorker;
 
         /*!
         \struct AbstractLoggerEngineData
@@ -28,7 +32,10 @@ namespace Qtilities {
             AbstractLoggerEngineData(): is_enabled(true),
                 is_initialized(false),
                 message_contexts(Logger::AllMessageContexts),
-                is_removable(true) {}
+                is_removable(true),
+                engine_mutex(QMutex::Recursive),
+                messages_counter_id(-1),
+                queue_depth_counter_id(-1) {}
 
             //! The enabled message types for this logger engine.
             Logger::MessageTypeFlags        enabled_message_types;
@@ -44,15 +51,43 @@ namespace Qtilities {
             QString                         engine_name;
             //! Indicates if this engine is removable by the user.
             bool                            is_removable;
+            //! The mutex which serializes logging of messages in this engine.
+            /*!
+              Each engine has its own mutex, thus a slow engine does not block other engines.
+              */
+            QMutex                          engine_mutex;
+            //! The worker thread processing messages for this engine, null when messages are processed in the calling thread.
+            /*!
+              Guarded by engine_mutex. Logging threads take a reference to the worker while holding the mutex, thus the worker is only
+              deleted once the last message passed to it was queued.
+              */
+            QSharedPointer<AbstractLoggerEngineWorker> worker;
+            //! The performance counter counting the messages accepted by this engine, registered when the engine is named.
+            int                             messages_counter_id;
+            //! The performance counter holding the number of messages queued for the worker thread of this engine.
+            int                             queue_depth_counter_id;
         };
 
         /*!
         \class AbstractLoggerEngine
         \brief The base class of all logger engines.
+
+        \section AbstractLoggerEngine_concurrency Concurrency
+
+        Each engine serializes the logging of its messages using its own mutex, thus engines never block each other. Messages are formatted
+        once by the Logger for all engines sharing the same formatting engine, thus formatting does not happen inside the engine.
+        When an engine is slow, for example a file engine writing to network storage, it can be moved onto its own worker thread using
+        setWorkerThreadEnabled(). Messages accepted by the engine are then added to a bounded queue and logged by the worker
+        thread, thus the logging thread only pays for the queue push. When the queue is full, the logging thread blocks until space becomes available.
+
+        \note Only enable the worker thread for engines which implement logMessage() in a thread safe way. Engines which
+        access widgets directly in logMessage(), like Qtilities::CoreGui::WidgetLoggerEngine, must not use a worker thread.
           */
         class LOGGING_SHARED_EXPORT AbstractLoggerEngine : public QObject
         {
             Q_OBJECT
+            friend class AbstractLoggerEngineWorker;
+            friend class Logger;
             Q_PROPERTY(Qtilities::Logging::Logger::MessageTypeFlags EnabledMessageTypes READ getEnabledMessageTypes WRITE setEnabledMessageTypes)
             Q_PROPERTY(QString FormattingEngine READ formattingEngineName)
 
@@ -66,13 +101,22 @@ namespace Qtilities {
             bool isInitialized() const;
             //! Function which receives a formatted string which needs to be logged.
             /*!
-              Messages arrives at logger engines through the newMessages() slot which will format the messages and validate if they must be logged.
-              If so, this function will be called with a formatted message. If you wish to handle the message formatting manually, you can reimplement the
-              newMessages() function.
+              The Logger validates if messages must be logged by an engine using acceptsMessage(). If so, the message is formatted once for all engines
+              sharing the same formatting engine and passed to newFormattedMessage(), which calls this function with the formatted message.
 
               \note When calling this function directly on an engine, the formatting engine will be bypassed.
               */
             virtual void logMessage(const QString& message, Logger::MessageType message_type = Logger::Info) = 0;
+            //! Function which receives a batch of records which need to be logged.
+            /*!
+              The Logger delivers messages in batches when asynchronous dispatching is enabled, see \ref Logger_asynchronous_dispatch. This function
+              is called with the engine's mutex locked. The default implementation calls logMessage() with the formatted message of every record,
+              or logUnformattedMessage() when logsUnformattedMessages() is true. Engines which can log a batch more efficiently than single messages,
+              for example by writing all records to a file at once, should reimplement this function.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual void logMessages(const QList<LoggerRecord>& records);
             //! Clears the log currently hold by the logger engine.
             /*!
               \note This is not supported by all logger engines. See the class documentation of the logger engine you are interested in to see if it is supported.
@@ -117,14 +161,105 @@ namespace Qtilities {
             //! Returns the logging contexts for which this engine accepts messages.
             inline Logger::MessageContextFlags messageContexts() const { return abstractLoggerEngineData->message_contexts; }
             //! Sets the logging contexts for which this engine accepts messages.
-            void setMessageContexts(Logger::MessageContextFlags message_contexts) { abstractLoggerEngineData->message_contexts = message_contexts; }
+            void setMessageContexts(Logger::MessageContextFlags message_contexts);
+
+            //! Enables or disables a dedicated worker thread which logs messages accepted by this engine.
+            /*!
+              See \ref AbstractLoggerEngine_concurrency for more details. Disabled by default.
+
+              \param is_enabled When true, the worker thread is started. When false, all queued messages are logged and the worker thread is stopped.
+              \param queue_capacity The maximum number of messages which can be queued before logging threads are blocked.
+
+              \note When deleting engines directly, disable the worker thread first. The Logger does this for you when engines are deleted through it.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setWorkerThreadEnabled(bool is_enabled, int queue_capacity = 1024);
+            //! Indicates if a dedicated worker thread logs messages accepted by this engine.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool workerThreadEnabled() const;
+
+            //! Returns true if this engine accepts a message with the given parameters.
+            /*!
+              This checks the engine name, the message contexts(), the engine activity and the enabled message types, thus everything
+              except the installed formatting engine.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool acceptsMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context) const;
+            //! Indicates if this engine logs unformatted messages through logUnformattedMessage() instead of formatted messages through logMessage().
+            /*!
+              Engines which store messages in a structured way, like BinaryLoggerEngine, can return true here in order to receive the unformatted
+              message contents. No formatting is done for these engines. The default implementation returns false.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual bool logsUnformattedMessages() const { return false; }
+            //! Function which receives unformatted messages when logsUnformattedMessages() returns true.
+            /*!
+              This function is called with the engine's mutex locked, directly in the thread in which the message was logged. Implementations must therefore be thread safe.
+              The default implementation does nothing.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            virtual void logUnformattedMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
+                Q_UNUSED(engine_name)
+                Q_UNUSED(message_type)
+                Q_UNUSED(message_context)
+                Q_UNUSED(messages)
+            }
+            //! Delivers an unformatted message to this engine, used when logsUnformattedMessages() returns true.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void newUnformattedMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages);
+            //! Delivers a message which was already formatted using the installed formatting engine to this engine.
+            /*!
+              The message is passed to the worker thread when workerThreadEnabled() is true. Otherwise logMessage() is called directly when called from the engine's thread,
+              or through a queued connection when called from any other thread.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void newFormattedMessage(const QString& formatted_message, Logger::MessageType message_type);
+            //! Delivers a batch of records, which were already formatted using the installed formatting engine, to this engine.
+            /*!
+              The formatted messages are passed to the worker thread when workerThreadEnabled() is true. Otherwise logMessages() is called directly when
+              called from the engine's thread or when logsUnformattedMessages() is true, or through a queued connection when called from any other thread.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void newRecords(const QList<LoggerRecord>& records);
 
         public slots:
             //! Function which is called to finalize the logger engine.
             virtual void finalize() = 0;
-            //! Slot which is connected to the newMessage() signal of the Logger class.
+            //! Formats and logs a message if this engine accepts it.
+            /*!
+              The Logger calls this function for every message routed to this engine. The default implementation leaves the delivery of these messages
+              to the Logger, which formats each message once for all engines using the same formatting engine and passes it to newFormattedMessage()
+              or newRecords(). Engines overriding this function therefore still receive every message, and messages are only delivered through
+              the default path when the override calls this implementation.
+
+              When called in any other way, for example to pass unformatted messages to a specific engine or when connected to the Logger::newMessage()
+              signal, the message is formatted and delivered by this function.
+              */
             virtual void newMessages(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages);
 
+        private slots:
+            //! Logs a formatted message through logMessage() while holding the engine's mutex.
+            void logFormattedMessage(const QString& formatted_message, Logger::MessageType message_type);
+            //! Logs a batch of records through logMessages() while holding the engine's mutex.
+            void logRecords(const QList<LoggerRecord>& records);
+
+        private:
+            //! Called by the Logger to deliver a message through newMessages(), returns true when an override of newMessages() handled the message.
+            /*!
+              When false is returned, the default implementation of newMessages() was reached and the Logger delivers the message itself.
+              */
+            bool interceptsMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages);
+
         protected:
             AbstractLoggerEngineData* abstractLoggerEngineData;
         };
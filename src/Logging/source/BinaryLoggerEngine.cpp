@@ -0,0 +1,451 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "BinaryLoggerEngine.h"
+#include "AbstractFormattingEngine.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QHash>
+
+#include <string.h>
+
+using namespace Qtilities::Logging;
+using namespace Qtilities::Logging::Constants;
+using namespace Qtilities::Logging::Interfaces;
+
+// ------------------------------------
+// Ring file layout
+// ------------------------------------
+// The file starts with a header page of qti_binary_log_header_size bytes, followed by the record area (the ring).
+// The header page contains a BinaryLogFileHeader, followed by the engine name table at qti_binary_log_name_table_offset.
+// Each name table entry consists of a quint16 length and up to qti_binary_log_name_max_length UTF-8 bytes. The id
+// of an engine name is its index in the table plus one, id 0 is used for system wide messages.
+//
+// The ring contains a contiguous (in circular order) sequence of chunks, starting at oldest_offset. Each chunk is
+// either a record (BinaryLogRecordHeader followed by the payload) or a padding chunk which fills the unused space at
+// the end of the ring when a record did not fit. Chunks never straddle the end of the ring and are 8 byte aligned.
+//
+// All header fields are stored in host byte order, the payload is serialized using QDataStream.
+namespace {
+    const quint32 qti_binary_log_magic                  = 0x5154424C; // "QTBL"
+    const quint32 qti_binary_log_version                = 1;
+    const quint32 qti_binary_log_record_magic           = 0x52454354; // "RECT"
+    const quint32 qti_binary_log_padding_magic          = 0x50414444; // "PADD"
+    const quint32 qti_binary_log_header_size            = 4096;
+    const quint32 qti_binary_log_name_table_offset      = 64;
+    const quint32 qti_binary_log_name_entry_size        = 64;
+    const quint32 qti_binary_log_name_max_length        = qti_binary_log_name_entry_size - sizeof(quint16);
+    const quint16 qti_binary_log_name_max_count         = (qti_binary_log_header_size - qti_binary_log_name_table_offset) / qti_binary_log_name_entry_size;
+    const quint16 qti_binary_log_unknown_name_id        = 0xFFFF;
+    const quint32 qti_binary_log_min_ring_size          = 64 * 1024;
+
+    struct BinaryLogFileHeader {
+        quint32 magic;
+        quint32 version;
+        quint32 ring_size;
+        quint32 write_offset;
+        quint32 oldest_offset;
+        quint32 used_bytes;
+        quint64 next_sequence;
+        quint32 name_count;
+        quint32 record_count;
+    };
+
+    struct BinaryLogRecordHeader {
+        quint32 magic;
+        quint32 length;
+        quint64 sequence;
+        qint64  timestamp;
+        quint16 message_type;
+        quint16 message_context;
+        quint16 engine_name_id;
+        quint16 reserved;
+        quint32 payload_size;
+        quint32 reserved2;
+    };
+
+    inline quint32 alignChunk(quint32 size) {
+        return (size + 7) & ~quint32(7);
+    }
+
+    QByteArray serializeMessages(const QList<QVariant>& messages) {
+        QByteArray payload;
+        QDataStream stream(&payload,QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_4_7);
+        stream << messages;
+        return payload;
+    }
+}
+
+struct Qtilities::Logging::BinaryLoggerEnginePrivateData {
+    BinaryLoggerEnginePrivateData() : ring_size(4 * 1024 * 1024),
+        map(0) {}
+
+    //! The ring file name.
+    QString                 file_name;
+    //! The size of the record area in the ring file.
+    quint32                 ring_size;
+    //! The mapped ring file.
+    QFile                   file;
+    //! The start of the mapped ring file, 0 when not mapped.
+    uchar*                  map;
+    //! Cache of the ids of engine names in the name table.
+    QHash<QString,quint16>  name_ids;
+
+    inline BinaryLogFileHeader* header() { return reinterpret_cast<BinaryLogFileHeader*> (map); }
+    inline uchar* ring() { return map + qti_binary_log_header_size; }
+
+    //! Removes the oldest chunk from the ring.
+    void evictOldest() {
+        BinaryLogFileHeader* h = header();
+        BinaryLogRecordHeader chunk;
+        memcpy(&chunk,ring() + h->oldest_offset,2*sizeof(quint32));
+        if (chunk.magic == qti_binary_log_record_magic && h->record_count > 0)
+            --h->record_count;
+        h->oldest_offset = (h->oldest_offset + chunk.length) % h->ring_size;
+        h->used_bytes -= chunk.length;
+        if (h->used_bytes == 0)
+            h->oldest_offset = h->write_offset;
+    }
+    //! Evicts chunks until size bytes are free at the write offset.
+    void makeSpace(quint32 size) {
+        BinaryLogFileHeader* h = header();
+        while (h->used_bytes > 0 && h->ring_size - h->used_bytes < size)
+            evictOldest();
+    }
+};
+
+namespace Qtilities {
+    namespace Logging {
+        LoggerFactoryItem<AbstractLoggerEngine, BinaryLoggerEngine> BinaryLoggerEngine::factory;
+    }
+}
+
+Qtilities::Logging::BinaryLoggerEngine::BinaryLoggerEngine() : AbstractLoggerEngine() {
+    d = new BinaryLoggerEnginePrivateData;
+}
+
+Qtilities::Logging::BinaryLoggerEngine::~BinaryLoggerEngine() {
+    finalize();
+    delete d;
+}
+
+bool Qtilities::Logging::BinaryLoggerEngine::initialize() {
+    if (d->file_name.isEmpty())
+        return false;
+
+    if (abstractLoggerEngineData->is_initialized)
+        return true;
+
+    // Check if the extension is correct:
+    QFileInfo fi(d->file_name);
+    if (fi.suffix().isEmpty())
+        d->file_name.append(qti_def_SUFFIX_BINARY_LOG);
+
+    d->file.setFileName(d->file_name);
+    if (!d->file.open(QIODevice::ReadWrite))
+        return false;
+
+    const qint64 file_size = qint64(qti_binary_log_header_size) + d->ring_size;
+    bool reuse = false;
+    if (d->file.size() == file_size) {
+        BinaryLogFileHeader existing;
+        if (d->file.read(reinterpret_cast<char*> (&existing),sizeof(existing)) == sizeof(existing))
+            reuse = (existing.magic == qti_binary_log_magic && existing.version == qti_binary_log_version && existing.ring_size == d->ring_size
+                     && existing.write_offset < d->ring_size && existing.oldest_offset < d->ring_size && existing.used_bytes <= d->ring_size
+                     && existing.name_count <= qti_binary_log_name_max_count);
+    }
+
+    if (!reuse && (!d->file.resize(0) || !d->file.resize(file_size))) {
+        d->file.close();
+        return false;
+    }
+
+    d->map = d->file.map(0,file_size);
+    if (!d->map) {
+        d->file.close();
+        return false;
+    }
+
+    BinaryLogFileHeader* h = d->header();
+    d->name_ids.clear();
+    if (reuse) {
+        // Continue after the records of the previous session, thus records logged before a crash are kept:
+        for (quint16 i = 0; i < h->name_count; ++i) {
+            const uchar* entry = d->map + qti_binary_log_name_table_offset + i * qti_binary_log_name_entry_size;
+            quint16 length;
+            memcpy(&length,entry,sizeof(length));
+            d->name_ids[QString::fromUtf8(reinterpret_cast<const char*> (entry + sizeof(quint16)),qMin<quint32>(length,qti_binary_log_name_max_length))] = i + 1;
+        }
+    } else {
+        memset(d->map,0,qti_binary_log_header_size);
+        h->magic = qti_binary_log_magic;
+        h->version = qti_binary_log_version;
+        h->ring_size = d->ring_size;
+    }
+
+    abstractLoggerEngineData->is_initialized = true;
+    return true;
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::finalize() {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    if (d->map) {
+        d->file.unmap(d->map);
+        d->map = 0;
+    }
+    if (d->file.isOpen())
+        d->file.close();
+    abstractLoggerEngineData->is_initialized = false;
+}
+
+QString Qtilities::Logging::BinaryLoggerEngine::description() const {
+    return tr("Logs binary records to a memory mapped ring file.");
+}
+
+QString Qtilities::Logging::BinaryLoggerEngine::status() const {
+    if (abstractLoggerEngineData->is_initialized) {
+        QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+        return tr("Logging to ring file: %1 (%2 records)").arg(d->file_name).arg(d->header()->record_count);
+    } else
+        return tr("Not initialized, file name: %1").arg(d->file_name);
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::clearLog() {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    if (!d->map)
+        return;
+
+    BinaryLogFileHeader* h = d->header();
+    h->write_offset = 0;
+    h->oldest_offset = 0;
+    h->used_bytes = 0;
+    h->record_count = 0;
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::logUnformattedMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
+    if (!d->map)
+        return;
+
+    QByteArray payload = serializeMessages(messages);
+    BinaryLogFileHeader* h = d->header();
+    // A single record may never use more than half of the ring:
+    if (alignChunk(sizeof(BinaryLogRecordHeader) + payload.size()) > h->ring_size / 2) {
+        QList<QVariant> truncated;
+        truncated << QString("[Message of %1 bytes truncated by the binary logger engine] %2").arg(payload.size()).arg(messages.isEmpty() ? QString() : messages.front().toString().left(1024));
+        payload = serializeMessages(truncated);
+    }
+
+    BinaryLogRecordHeader record;
+    memset(&record,0,sizeof(record));
+    record.magic = qti_binary_log_record_magic;
+    record.length = alignChunk(sizeof(BinaryLogRecordHeader) + payload.size());
+    record.sequence = h->next_sequence;
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.message_type = quint16(message_type);
+    record.message_context = quint16(message_context);
+    record.engine_name_id = engine_name.isEmpty() ? 0 : engineNameId(engine_name);
+    record.payload_size = payload.size();
+
+    // Pad the end of the ring when the record does not fit before it:
+    if (h->ring_size - h->write_offset < record.length) {
+        const quint32 padding = h->ring_size - h->write_offset;
+        d->makeSpace(padding);
+        const quint32 padding_header[2] = { qti_binary_log_padding_magic, padding };
+        memcpy(d->ring() + h->write_offset,padding_header,sizeof(padding_header));
+        h->used_bytes += padding;
+        h->write_offset = 0;
+    }
+
+    // Evict the records which will be overwritten before writing the record, thus the header always describes
+    // valid records, even when the application crashes while the record is being written:
+    d->makeSpace(record.length);
+    uchar* target = d->ring() + h->write_offset;
+    memcpy(target,&record,sizeof(record));
+    memcpy(target + sizeof(record),payload.constData(),payload.size());
+
+    h->used_bytes += record.length;
+    h->write_offset = (h->write_offset + record.length) % h->ring_size;
+    ++h->next_sequence;
+    ++h->record_count;
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::logMessage(const QString& message, Logger::MessageType message_type) {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    QList<QVariant> messages;
+    messages << message;
+    logUnformattedMessage(QString(),message_type,Logger::SystemWideMessages,messages);
+}
+
+quint16 Qtilities::Logging::BinaryLoggerEngine::engineNameId(const QString& engine_name) {
+    QHash<QString,quint16>::const_iterator it = d->name_ids.constFind(engine_name);
+    if (it != d->name_ids.constEnd())
+        return it.value();
+
+    BinaryLogFileHeader* h = d->header();
+    QByteArray utf8 = engine_name.toUtf8();
+    if (h->name_count >= qti_binary_log_name_max_count || quint32(utf8.size()) > qti_binary_log_name_max_length)
+        return qti_binary_log_unknown_name_id;
+
+    uchar* entry = d->map + qti_binary_log_name_table_offset + h->name_count * qti_binary_log_name_entry_size;
+    const quint16 length = utf8.size();
+    memcpy(entry + sizeof(quint16),utf8.constData(),length);
+    memcpy(entry,&length,sizeof(length));
+    ++h->name_count;
+    d->name_ids[engine_name] = h->name_count;
+    return h->name_count;
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::setFileName(const QString& fileName) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->file_name = fileName;
+}
+
+QString Qtilities::Logging::BinaryLoggerEngine::getFileName() const {
+    return d->file_name;
+}
+
+void Qtilities::Logging::BinaryLoggerEngine::setRingSize(quint32 size) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->ring_size = alignChunk(qMax(size,qti_binary_log_min_ring_size));
+}
+
+quint32 Qtilities::Logging::BinaryLoggerEngine::ringSize() const {
+    return d->ring_size;
+}
+
+bool Qtilities::Logging::BinaryLoggerEngine::readRingFile(const QString& file_name, QList<BinaryLogRecord>& records, QString* errorMsg) {
+    records.clear();
+    QFile file(file_name);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorMsg)
+            *errorMsg = tr("Failed to open ring file: %1").arg(file.errorString());
+        return false;
+    }
+
+    QByteArray header_page = file.read(qti_binary_log_header_size);
+    BinaryLogFileHeader h;
+    if (header_page.size() != int(qti_binary_log_header_size)) {
+        if (errorMsg)
+            *errorMsg = tr("The file is too small to be a binary log ring file.");
+        return false;
+    }
+    memcpy(&h,header_page.constData(),sizeof(h));
+    if (h.magic != qti_binary_log_magic || h.version != qti_binary_log_version) {
+        if (errorMsg)
+            *errorMsg = tr("The file is not a supported binary log ring file.");
+        return false;
+    }
+    if (file.size() != qint64(qti_binary_log_header_size) + h.ring_size || h.oldest_offset >= h.ring_size || h.used_bytes > h.ring_size
+            || h.name_count > qti_binary_log_name_max_count) {
+        if (errorMsg)
+            *errorMsg = tr("The ring file header is corrupt.");
+        return false;
+    }
+
+    QStringList names;
+    for (quint16 i = 0; i < h.name_count; ++i) {
+        const char* entry = header_page.constData() + qti_binary_log_name_table_offset + i * qti_binary_log_name_entry_size;
+        quint16 length;
+        memcpy(&length,entry,sizeof(length));
+        names << QString::fromUtf8(entry + sizeof(quint16),qMin<quint32>(length,qti_binary_log_name_max_length));
+    }
+
+    QByteArray ring = file.read(h.ring_size);
+    if (ring.size() != int(h.ring_size)) {
+        if (errorMsg)
+            *errorMsg = tr("Failed to read the ring file records.");
+        return false;
+    }
+
+    quint32 offset = h.oldest_offset;
+    quint32 remaining = h.used_bytes;
+    while (remaining > 0) {
+        BinaryLogRecordHeader record;
+        if (h.ring_size - offset < 2*sizeof(quint32))
+            break;
+        memcpy(&record,ring.constData() + offset,qMin<quint32>(sizeof(record),h.ring_size - offset));
+        if (record.length == 0 || record.length > remaining || record.length > h.ring_size - offset || (record.length & 7)) {
+            if (errorMsg)
+                *errorMsg = tr("Corrupt record found at offset %1, %2 records were read.").arg(offset).arg(records.count());
+            return false;
+        }
+
+        if (record.magic == qti_binary_log_record_magic && record.length >= sizeof(record) && record.payload_size <= record.length - sizeof(record)) {
+            BinaryLogRecord log_record;
+            log_record.sequence = record.sequence;
+            log_record.timestamp = QDateTime::fromMSecsSinceEpoch(record.timestamp);
+            log_record.message_type = Logger::MessageType(record.message_type);
+            log_record.message_context = Logger::MessageContextFlags(record.message_context);
+            if (record.engine_name_id > 0 && record.engine_name_id <= names.count())
+                log_record.engine_name = names.at(record.engine_name_id - 1);
+            else if (record.engine_name_id != 0)
+                log_record.engine_name = "?";
+
+            QByteArray payload = QByteArray::fromRawData(ring.constData() + offset + sizeof(record),record.payload_size);
+            QDataStream stream(payload);
+            stream.setVersion(QDataStream::Qt_4_7);
+            stream >> log_record.messages;
+            records << log_record;
+        } else if (record.magic != qti_binary_log_padding_magic) {
+            if (errorMsg)
+                *errorMsg = tr("Corrupt record found at offset %1, %2 records were read.").arg(offset).arg(records.count());
+            return false;
+        }
+
+        remaining -= record.length;
+        offset = (offset + record.length) % h.ring_size;
+    }
+
+    return true;
+}
+
+QString Qtilities::Logging::BinaryLoggerEngine::formatRingFile(const QString& file_name, AbstractFormattingEngine* formatting_engine, QString* errorMsg) {
+    if (!formatting_engine) {
+        if (errorMsg)
+            *errorMsg = tr("Invalid formatting engine.");
+        return QString();
+    }
+
+    QList<BinaryLogRecord> records;
+    if (!readRingFile(file_name,records,errorMsg))
+        return QString();
+
+    QString formatted = formatting_engine->initializeString();
+    if (!formatted.isEmpty())
+        formatted.append(formatting_engine->endOfLineChar());
+    for (int i = 0; i < records.count(); ++i) {
+        formatted.append(formatting_engine->formatMessage(records.at(i).message_type,records.at(i).messages));
+        formatted.append(formatting_engine->endOfLineChar());
+    }
+    formatted.append(formatting_engine->finalizeString());
+    return formatted;
+}
+
+Qtilities::Logging::Interfaces::ILoggerExportable::ExportModeFlags Qtilities::Logging::BinaryLoggerEngine::supportedFormats() const {
+    ILoggerExportable::ExportModeFlags flags = 0;
+    flags |= ILoggerExportable::Binary;
+    return flags;
+}
+
+bool Qtilities::Logging::BinaryLoggerEngine::exportBinary(QDataStream& stream) const {
+    stream << d->file_name;
+    stream << d->ring_size;
+    return true;
+}
+
+bool Qtilities::Logging::BinaryLoggerEngine::importBinary(QDataStream& stream) {
+    stream >> d->file_name;
+    stream >> d->ring_size;
+    return true;
+}
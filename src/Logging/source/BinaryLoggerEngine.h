@@ -0,0 +1,169 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef BINARYLOGGERENGINE_H
+#define BINARYLOGGERENGINE_H
+
+#include "Logging_global.h"
+#include "AbstractLoggerEngine.h"
+#include "LoggingConstants.h"
+#include "LoggerFactory.h"
+#include "ILoggerExportable.h"
+
+#include <QDateTime>
+#include <QList>
+#include <QVariant>
+
+namespace Qtilities {
+    namespace Logging {
+        using namespace Qtilities::Logging::Interfaces;
+        using namespace Qtilities::Logging::Constants;
+
+        /*!
+        \struct BinaryLogRecord
+        \brief A single message read from a ring file written by BinaryLoggerEngine.
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct LOGGING_SHARED_EXPORT BinaryLogRecord {
+            BinaryLogRecord() : sequence(0),
+                message_type(Logger::Info),
+                message_context(Logger::SystemWideMessages) {}
+
+            //! The sequence number of the record, records are numbered in the order in which they were logged.
+            quint64                         sequence;
+            //! The time at which the message was logged.
+            QDateTime                       timestamp;
+            //! The type of the message.
+            Logger::MessageType             message_type;
+            //! The context of the message.
+            Logger::MessageContextFlags     message_context;
+            //! The name of the engine to which the message was logged, empty for system wide messages.
+            QString                         engine_name;
+            //! The unformatted message contents.
+            QList<QVariant>                 messages;
+        };
+
+        /*!
+        \struct BinaryLoggerEnginePrivateData
+        \brief The BinaryLoggerEnginePrivateData struct stores private data used by the BinaryLoggerEngine class.
+          */
+        struct BinaryLoggerEnginePrivateData;
+
+        /*!
+        \class BinaryLoggerEngine
+        \brief A logger engine which stores compact binary records in a fixed size memory mapped ring file.
+
+        The BinaryLoggerEngine does not format messages. Instead, every message is stored as a binary record containing the time at which it was logged,
+        its Logger::MessageType, its Logger::MessageContextFlags, an id for the engine name it was logged to and the unformatted message contents. Records are
+        written into a memory mapped file with a fixed size, thus the engine uses a constant amount of memory and disk space, and the oldest records are overwritten when the
+        ring is full. Since the records are written directly into the mapped file, all messages logged up to the point where an application crashed are available in the ring file.
+
+        The engine is registered in the Logger using the Qtilities::Logging::Constants::qti_def_FACTORY_TAG_BINARY_LOGGER_ENGINE factory tag:
+
+\code
+BinaryLoggerEngine* binary_engine = qobject_cast<BinaryLoggerEngine*> (Log->newLoggerEngine(qti_def_FACTORY_TAG_BINARY_LOGGER_ENGINE));
+binary_engine->setFileName("production.qtilog");
+binary_engine->setRingSize(16 * 1024 * 1024);
+Log->attachLoggerEngine(binary_engine);
+\endcode
+
+        Ring files can be read using readRingFile() and formatted using formatRingFile(). The \p QtilitiesBinaryLogDump tool in the \p src/Tools directory uses
+        formatRingFile() to convert ring files to the output of any formatting engine registered in the logger.
+
+        \note Clearing the log through clearLog() is supported by this logger engine.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class LOGGING_SHARED_EXPORT BinaryLoggerEngine : public AbstractLoggerEngine, public ILoggerExportable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Logging::Interfaces::ILoggerExportable)
+            Q_PROPERTY(QString FileName READ getFileName)
+
+        public:
+            BinaryLoggerEngine();
+            ~BinaryLoggerEngine();
+
+            // --------------------------------
+            // AbstractLoggerEngine Implementation
+            // --------------------------------
+            bool initialize();
+            void finalize();
+            QString description() const;
+            QString status() const;
+            bool isFormattingEngineConstant() const { return true; }
+            void clearLog();
+            bool logsUnformattedMessages() const { return true; }
+            void logUnformattedMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages);
+
+            // --------------------------------
+            // ILoggerExportable Implementation
+            // --------------------------------
+            ExportModeFlags supportedFormats() const;
+            bool exportBinary(QDataStream& stream) const;
+            bool importBinary(QDataStream& stream);
+            QString factoryTag() const { return qti_def_FACTORY_TAG_BINARY_LOGGER_ENGINE; }
+            QString instanceName() const { return name(); }
+
+            //! Sets the ring file to which this engine will write records.
+            /*!
+                Its not possible to change the file name while the logger engine is in a initialized state.
+                To change the file name: call finalize(), setFileName() and then call initialize() again.
+              */
+            void setFileName(const QString& fileName);
+            //! Gets the ring file to which the logger is currently logging.
+            QString getFileName() const;
+            //! Sets the size in bytes of the record area in the ring file.
+            /*!
+                The default is 4MB. Like setFileName(), this can only be changed while the engine is not initialized. When an existing ring file
+                with a different size is opened during initialize(), the file is recreated.
+              */
+            void setRingSize(quint32 size);
+            //! Returns the size in bytes of the record area in the ring file.
+            quint32 ringSize() const;
+
+            //! Reads all records in a ring file, from the oldest to the newest record.
+            /*!
+              \param file_name The ring file to read.
+              \param records The records read from the file.
+              \param errorMsg When reading fails, the reason is returned through this parameter.
+              \returns True when successful, false otherwise.
+              */
+            static bool readRingFile(const QString& file_name, QList<BinaryLogRecord>& records, QString* errorMsg = 0);
+            //! Formats all records in a ring file using the given formatting engine.
+            /*!
+              The returned string contains the formatting engine's initialization string, all formatted records and its finalization string.
+
+              \param file_name The ring file to read.
+              \param formatting_engine The formatting engine to use.
+              \param errorMsg When reading fails, the reason is returned through this parameter.
+              \returns The formatted log, or an empty string when reading failed.
+              */
+            static QString formatRingFile(const QString& file_name, AbstractFormattingEngine* formatting_engine, QString* errorMsg = 0);
+
+            // Make this class a factory item
+            static LoggerFactoryItem<AbstractLoggerEngine, BinaryLoggerEngine> factory;
+
+        public slots:
+            //! Formatted messages are not supported by this engine, thus this function stores \p message as a single unformatted message.
+            void logMessage(const QString& message, Logger::MessageType message_type);
+
+        private:
+            //! Returns the id of an engine name, adding it to the name table in the ring file when needed.
+            quint16 engineNameId(const QString& engine_name);
+
+            BinaryLoggerEnginePrivateData* d;
+        };
+    }
+}
+
+#endif // BINARYLOGGERENGINE_H
@@ -11,6 +11,127 @@
 
 #include "FormattingEngines.h"
 
+#include <QElapsedTimer>
+#include <QThreadStorage>
+#include <QVarLengthArray>
+
+namespace {
+    // The time of day as formatted by QTime::toString(), cached for each thread.
+    struct qti_private_TimestampCache {
+        qti_private_TimestampCache() : refreshed_at(-1), second_of_day(-1) {
+            timer.start();
+        }
+
+        QElapsedTimer   timer;
+        qint64          refreshed_at;
+        int             second_of_day;
+        QString         text;
+    };
+    Q_GLOBAL_STATIC(QThreadStorage<qti_private_TimestampCache*>, qti_private_timestamp_caches)
+
+    // Returns QTime::currentTime().toString(). The clock is read at most once per millisecond on each thread, and the string is only rebuilt when the second changed.
+    QString qti_private_currentTimeString() {
+        QThreadStorage<qti_private_TimestampCache*>* caches = qti_private_timestamp_caches();
+        if (!caches)
+            return QTime::currentTime().toString();
+        if (!caches->hasLocalData())
+            caches->setLocalData(new qti_private_TimestampCache);
+
+        qti_private_TimestampCache* cache = caches->localData();
+        qint64 now = cache->timer.elapsed();
+        if (now == cache->refreshed_at)
+            return cache->text;
+        cache->refreshed_at = now;
+
+        QTime time = QTime::currentTime();
+        int second_of_day = time.hour() * 3600 + time.minute() * 60 + time.second();
+        if (second_of_day != cache->second_of_day) {
+            cache->second_of_day = second_of_day;
+            const char buffer[8] = { char('0' + time.hour() / 10), char('0' + time.hour() % 10), ':',
+                                     char('0' + time.minute() / 10), char('0' + time.minute() % 10), ':',
+                                     char('0' + time.second() / 10), char('0' + time.second() % 10) };
+            cache->text = QString::fromLatin1(buffer,8);
+        }
+
+        return cache->text;
+    }
+
+    // Returns the name of a message type as returned by Logger::logLevelToString(), or 0 for combinations of types.
+    const char* qti_private_messageTypeName(Qtilities::Logging::Logger::MessageType message_type) {
+        switch (message_type) {
+        case Qtilities::Logging::Logger::None:      return "None";
+        case Qtilities::Logging::Logger::Info:      return "Info";
+        case Qtilities::Logging::Logger::Warning:   return "Warning";
+        case Qtilities::Logging::Logger::Error:     return "Error";
+        case Qtilities::Logging::Logger::Fatal:     return "Fatal";
+        case Qtilities::Logging::Logger::Debug:     return "Debug";
+        case Qtilities::Logging::Logger::Trace:     return "Trace";
+        default:                                    return 0;
+        }
+    }
+
+    // The type columns of the default and rich text engines, with the type names padded to 8 characters using spaces and non-breaking spaces respectively.
+    const char* qti_private_plainTypeColumn(Qtilities::Logging::Logger::MessageType message_type) {
+        switch (message_type) {
+        case Qtilities::Logging::Logger::Info:      return " [Info    ] ";
+        case Qtilities::Logging::Logger::Warning:   return " [Warning ] ";
+        case Qtilities::Logging::Logger::Error:     return " [Error   ] ";
+        case Qtilities::Logging::Logger::Fatal:     return " [Fatal   ] ";
+        case Qtilities::Logging::Logger::Debug:     return " [Debug   ] ";
+        case Qtilities::Logging::Logger::Trace:     return " [Trace   ] ";
+        default:                                    return "";
+        }
+    }
+
+    const char* qti_private_richTextTypeColumn(Qtilities::Logging::Logger::MessageType message_type) {
+        switch (message_type) {
+        case Qtilities::Logging::Logger::None:      return " [None\xA0\xA0\xA0\xA0] ";
+        case Qtilities::Logging::Logger::Info:      return " [Info\xA0\xA0\xA0\xA0] ";
+        case Qtilities::Logging::Logger::Warning:   return " [Warning\xA0] ";
+        case Qtilities::Logging::Logger::Error:     return " [Error\xA0\xA0\xA0] ";
+        case Qtilities::Logging::Logger::Fatal:     return " [Fatal\xA0\xA0\xA0] ";
+        case Qtilities::Logging::Logger::Debug:     return " [Debug\xA0\xA0\xA0] ";
+        case Qtilities::Logging::Logger::Trace:     return " [Trace\xA0\xA0\xA0] ";
+        default:                                    return 0;
+        }
+    }
+
+    // Appends the result of AbstractFormattingEngine::escape() to rich, without creating a temporary string.
+    void qti_private_appendEscaped(QString& rich, const QString& plain) {
+        const QChar* chars = plain.constData();
+        const int length = plain.length();
+        int unescaped_from = 0;
+        for (int i = 0; i < length; ++i) {
+            const char* entity = 0;
+            if (chars[i] == QLatin1Char('<'))
+                entity = "&lt;";
+            else if (chars[i] == QLatin1Char('>'))
+                entity = "&gt;";
+            else if (chars[i] == QLatin1Char('&'))
+                entity = "&amp;";
+            else if (chars[i] == QLatin1Char('"'))
+                entity = "&quot;";
+            else
+                continue;
+
+            rich.append(QStringRef(&plain,unescaped_from,i - unescaped_from));
+            rich.append(QLatin1String(entity));
+            unescaped_from = i + 1;
+        }
+        rich.append(QStringRef(&plain,unescaped_from,length - unescaped_from));
+    }
+
+    // Converts all messages to strings, returns the sum of their lengths.
+    int qti_private_messageStrings(const QList<QVariant>& messages, QVarLengthArray<QString,8>& strings) {
+        int length = 0;
+        for (int i = 0; i < messages.count(); ++i) {
+            strings.append(messages.at(i).toString());
+            length += strings[i].length();
+        }
+        return length;
+    }
+}
+
 // -----------------------------------
 // Default Formatting Engine
 // -----------------------------------
@@ -36,24 +157,20 @@ QString Qtilities::Logging::FormattingEngine_Default::initializeString() const {
 }
 
 QString Qtilities::Logging::FormattingEngine_Default::formatMessage(Logger::MessageType message_type, const QList<QVariant>& messages) const {
-    QString message = QTime::currentTime().toString();
-    if (message_type == Logger::Debug)
-        message.append(QString(" [%1] ").arg("Debug",-8,QChar(' ')));
-    else if (message_type == Logger::Trace)
-        message.append(QString(" [%1] ").arg("Trace",-8,QChar(' ')));
-    else if (message_type == Logger::Warning)
-        message.append(QString(" [%1] ").arg("Warning",-8,QChar(' ')));
-    else if (message_type == Logger::Error)
-        message.append(QString(" [%1] ").arg("Error",-8,QChar(' ')));
-    else if (message_type == Logger::Fatal)
-        message.append(QString(" [%1] ").arg("Fatal",-8,QChar(' ')));
-    else if (message_type == Logger::Info)
-        message.append(QString(" [%1] ").arg("Info",-8,QChar(' ')));
-
-    message.append(messages.front().toString());
-
-    for (int i = 1; i < messages.count(); ++i) {
-        message.append("\n            %1").arg(messages.at(i).toString());
+    static const QLatin1String continuation_prefix("\n            ");
+    const int continuation_prefix_length = 13;
+
+    QVarLengthArray<QString,8> strings;
+    int length = qti_private_messageStrings(messages,strings);
+
+    QString message;
+    message.reserve(8 + 12 + length + continuation_prefix_length * strings.size());
+    message.append(qti_private_currentTimeString());
+    message.append(QLatin1String(qti_private_plainTypeColumn(message_type)));
+    for (int i = 0; i < strings.size(); ++i) {
+        if (i > 0)
+            message.append(continuation_prefix);
+        message.append(strings[i]);
     }
     return message;
 }
@@ -87,80 +204,59 @@ QString Qtilities::Logging::FormattingEngine_Rich_Text::initializeString() const
 }
 
 QString Qtilities::Logging::FormattingEngine_Rich_Text::formatMessage(Logger::MessageType message_type, const QList<QVariant>& messages) const {
-    QString message;
+    static const QLatin1String continuation_prefix("<br>            ");
+    const int continuation_prefix_length = 16;
 
-    message.append(QTime::currentTime().toString());
-    message.append(QString(" [%1] ").arg(Log->logLevelToString(message_type),-8,QChar(QChar::Nbsp)));
-
-    // Since we convert it to rich text, < and > characters must be converted.
-    QString formatted_string = AbstractFormattingEngine::escape(messages.front().toString());
-    message.append(formatted_string);
-    for (int i = 1; i < messages.count(); ++i) {
-        QString formatted_string = AbstractFormattingEngine::escape(messages.at(i).toString());
-        message.append("<br>            %1").arg(formatted_string);
-    }
-    message.append("</font>");
-
-    // To keep a user's log as intended, we need to reserve spaces:
-    // message = message.replace(" ",QChar(QChar::Nbsp));
+    QVarLengthArray<QString,8> strings;
+    int length = qti_private_messageStrings(messages,strings);
 
+    // If the message matches a custom color regexp we use that color, otherwise
+    // we use the color of the message.
     QString custom_color_hint;
-    if (messages.count() > 0)
-        custom_color_hint = matchColorFormattingHint(messages.front().toString(),message_type);
+    if (strings.size() > 0 && !color_formatting_hints.isEmpty())
+        custom_color_hint = matchColorFormattingHint(strings[0],message_type);
 
-    // Start with the correct font:
+    const char* color = 0;
     switch (message_type) {
-    case Logger::Info:
-        if (custom_color_hint.isEmpty())
-            message.prepend("<font color='black'>");
-        else
-            message.prepend(QString("<font color='%1'>").arg(custom_color_hint));
-        break;
-
-    case Logger::Warning:
-        if (custom_color_hint.isEmpty())
-            message.prepend("<font color='orange'>");
-        else
-            message.prepend(QString("<font color='%1'>").arg(custom_color_hint));
-        break;
-
-    case Logger::Error:
-        if (custom_color_hint.isEmpty())
-            message.prepend("<font color='red'>");
-        else
-            message.prepend(QString("<font color='%1'>").arg(custom_color_hint));
-        break;
-
-    case Logger::Fatal:
-        if (custom_color_hint.isEmpty())
-            message.prepend("<font color='purple'>");
-        else
-            message.prepend(QString("<font color='%1'>").arg(custom_color_hint));
-        break;
+    case Logger::Info:      color = "black"; break;
+    case Logger::Warning:   color = "orange"; break;
+    case Logger::Error:     color = "red"; break;
+    case Logger::Fatal:     color = "purple"; break;
+    case Logger::Debug:     color = "grey"; break;
+    case Logger::Trace:     color = "lightgrey"; break;
+    default:                break;
+    }
 
-    case Logger::Debug:
-        if (custom_color_hint.isEmpty())
-            message.prepend("<font color='grey'>");
-        else
-            message.prepend(QString("<font color='%1'>").arg(custom_color_hint));
-        break;
+    QString message;
+    // Since we convert it to rich text, < and > characters must be converted, which makes the message a bit longer:
+    message.reserve(40 + custom_color_hint.size() + int(length * 1.1) + continuation_prefix_length * strings.size());
 
-    case Logger::Trace:
+    // Start with the correct font:
+    if (color) {
+        message.append(QLatin1String("<font color='"));
         if (custom_color_hint.isEmpty())
-            message.prepend("<font color='lightgrey'>");
+            message.append(QLatin1String(color));
         else
-            message.prepend(QString("<font color='%1'>").arg(custom_color_hint));
-        break;
-
-    default:
-        break;
+            message.append(custom_color_hint);
+        message.append(QLatin1String("'>"));
     }
 
-    // If the message matches a custom color regexp we use that color, otherwise
-    // we use the color of the message.
+    message.append(qti_private_currentTimeString());
+    const char* type_column = qti_private_richTextTypeColumn(message_type);
+    if (type_column)
+        message.append(QLatin1String(type_column));
+    else
+        message.append(QString(" [%1] ").arg(Log->logLevelToString(message_type),-8,QChar(QChar::Nbsp)));
+
+    for (int i = 0; i < strings.size(); ++i) {
+        if (i > 0)
+            message.append(continuation_prefix);
+        qti_private_appendEscaped(message,strings[i]);
+    }
+    message.append(QLatin1String("</font>"));
 
     if (message_type == Logger::Fatal)
-        message.append("</b>");
+        message.append(QLatin1String("</b>"));
 
     return message;
 }
@@ -194,14 +290,30 @@ QString Qtilities::Logging::FormattingEngine_XML::initializeString() const {
 }
 
 QString Qtilities::Logging::FormattingEngine_XML::formatMessage(Logger::MessageType message_type, const QList<QVariant>& messages) const {
-    QString type_string = Log->logLevelToString(message_type);
+    QVarLengthArray<QString,8> strings;
+    int length = qti_private_messageStrings(messages,strings);
+
     QString message;
-    message = QString("<Log>\n<Type>%1</Type>").arg(type_string);
-    for (int i = 0; i < messages.count(); ++i) {    
-        QString formatted_string = AbstractFormattingEngine::escape(messages.at(i).toString());
-        message.append(QString("\n<Message_%1>%2</Message_%1>").arg(i).arg(formatted_string));
+    message.reserve(32 + int(length * 1.1) + 32 * strings.size());
+    message.append(QLatin1String("<Log>\n<Type>"));
+    const char* type_name = qti_private_messageTypeName(message_type);
+    if (type_name)
+        message.append(QLatin1String(type_name));
+    else
+        message.append(Log->logLevelToString(message_type));
+    message.append(QLatin1String("</Type>"));
+
+    for (int i = 0; i < strings.size(); ++i) {
+        QString index = QString::number(i);
+        message.append(QLatin1String("\n<Message_"));
+        message.append(index);
+        message.append(QLatin1Char('>'));
+        qti_private_appendEscaped(message,strings[i]);
+        message.append(QLatin1String("</Message_"));
+        message.append(index);
+        message.append(QLatin1Char('>'));
     }
-    message.append("\n</Log>");
+    message.append(QLatin1String("\n</Log>"));
 
     return message;
 }
@@ -244,39 +356,36 @@ QString Qtilities::Logging::FormattingEngine_HTML::formatMessage(Logger::Message
     if (messages.count() == 0)
         return "";
 
-    QString formatted_string = AbstractFormattingEngine::escape(messages.front().toString());
-    QString message;
+    const char* color = 0;
     switch (message_type) {
         case Logger::Trace:
-            message = QString("<td>%1</td><td><font color='grey'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
-            break;
         case Logger::Debug:
-            message = QString("<td>%1</td><td><font color='grey'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
+            color = "grey";
             break;
         case Logger::Warning:
-            message = QString("<td>%1</td><td><font color='orange'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
+            color = "orange";
             break;
         case Logger::Info:
-            message = QString("<td>%1</td><td><font color='black'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
+            color = "black";
             break;
         case Logger::Error:
-            message = QString("<td>%1</td><td><font color='red'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
-            break;
         case Logger::Fatal:
-            message = QString("<td>%1</td><td><font color='red'>%2</font></td>").arg(QTime::currentTime().toString()).arg(formatted_string);
+            color = "red";
             break;
-        case Logger::None:
-            return QString();
-        case Logger::AllLogLevels:
+        default:
             return QString();
         }
 
-    /*for (int i = 1; i < messages.count(); ++i) {
-        message.append(QString("%1").arg(messages.at(i).toString()));
-    }*/
-
-    message.prepend("<tr><font size=\"5\" face=\"verdana\">");
-    message.append("</font></tr>");
+    QString first_message = messages.front().toString();
+    QString message;
+    message.reserve(96 + int(first_message.length() * 1.1));
+    message.append(QLatin1String("<tr><font size=\"5\" face=\"verdana\"><td>"));
+    message.append(qti_private_currentTimeString());
+    message.append(QLatin1String("</td><td><font color='"));
+    message.append(QLatin1String(color));
+    message.append(QLatin1String("'>"));
+    qti_private_appendEscaped(message,first_message);
+    message.append(QLatin1String("</font></td></font></tr>"));
     return message;
 }
 
@@ -311,9 +420,9 @@ QString Qtilities::Logging::FormattingEngine_QtMsgEngineFormat::initializeString
 QString Qtilities::Logging::FormattingEngine_QtMsgEngineFormat::formatMessage(Logger::MessageType message_type, const QList<QVariant>& messages) const {
     Q_UNUSED(message_type)
 
-    QString message = QString();
-    message.append(messages.front().toString());
-    return message;
+    if (messages.isEmpty())
+        return QString();
+    return messages.front().toString();
 }
 
 QString Qtilities::Logging::FormattingEngine_QtMsgEngineFormat::finalizeString() const {
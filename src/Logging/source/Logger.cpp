@@ -15,18 +15,480 @@
 #include "AbstractLoggerEngine.h"
 #include "FormattingEngines.h"
 #include "LoggerEngines.h"
+#include "BinaryLoggerEngine.h"
+#include "NetworkLoggerEngine.h"
+#include "SessionLogStore.h"
+#include "SettingsStore.h"
 #include "LoggingConstants.h"
 
 #include <Qtilities.h>
 
 #include <QtDebug>
 #include <QMutex>
+#include <QReadWriteLock>
+#include <QHash>
+#include <QVarLengthArray>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QThreadStorage>
+#include <QWaitCondition>
+
+#include <stdio.h>
 
 using namespace Qtilities::Logging::Constants;
 
+namespace Qtilities {
+    namespace Logging {
+        // A summary message created by the throttling stage of the logger.
+        struct LoggerThrottleSummary {
+            QString                     engine_name;
+            Logger::MessageType         message_type;
+            Logger::MessageContextFlags message_context;
+            QList<QVariant>             message_contents;
+        };
+
+        // The index of a message type in the rate limiting arrays of LoggerPrivateData:
+        inline int messageTypeIndex(Logger::MessageType message_type) {
+            int index = 0;
+            int type = message_type;
+            while (type > 1 && index < 6) {
+                type >>= 1;
+                ++index;
+            }
+            return index;
+        }
+
+        inline int atomicLoadRelaxed(QAtomicInt& value) {
+            #if QT_VERSION >= 0x050000
+            return value.load();
+            #else
+            return value;
+            #endif
+        }
+        inline int atomicLoadAcquire(QAtomicInt& value) {
+            #if QT_VERSION >= 0x050000
+            return value.loadAcquire();
+            #else
+            return value.fetchAndAddAcquire(0);
+            #endif
+        }
+        inline void atomicStoreRelease(QAtomicInt& value, int new_value) {
+            #if QT_VERSION >= 0x050000
+            value.storeRelease(new_value);
+            #else
+            value.fetchAndStoreRelease(new_value);
+            #endif
+        }
+        inline bool recordTimestampLessThan(const LoggerRecord& record1, const LoggerRecord& record2) {
+            return record1.timestamp < record2.timestamp;
+        }
+
+        // Single producer, single consumer ring buffer holding the records logged by one thread. Only the thread which owns the buffer pushes
+        // records and only the LoggerDispatcher, while holding its drain_mutex, takes them. One slot is always kept empty to distinguish a full
+        // buffer from an empty buffer.
+        struct LoggerRecordBuffer {
+            LoggerRecordBuffer(int capacity) : capacity(capacity),
+                ring(new LoggerRecord[capacity + 1]),
+                head(0),
+                tail(0),
+                orphaned(0) {}
+            ~LoggerRecordBuffer() { delete[] ring; }
+
+            //! Called by the owning thread, returns false when the buffer is full.
+            bool push(const LoggerRecord& record) {
+                const int current_tail = atomicLoadRelaxed(tail);
+                const int next_tail = (current_tail + 1) % (capacity + 1);
+                if (next_tail == atomicLoadAcquire(head))
+                    return false;
+                ring[current_tail] = record;
+                atomicStoreRelease(tail,next_tail);
+                return true;
+            }
+            //! Called by the dispatcher, appends all buffered records to \p records.
+            void takeAll(QList<LoggerRecord>& records) {
+                int current_head = atomicLoadRelaxed(head);
+                const int current_tail = atomicLoadAcquire(tail);
+                while (current_head != current_tail) {
+                    records << ring[current_head];
+                    ring[current_head] = LoggerRecord();
+                    current_head = (current_head + 1) % (capacity + 1);
+                }
+                atomicStoreRelease(head,current_head);
+            }
+            bool isEmpty() {
+                return atomicLoadAcquire(head) == atomicLoadAcquire(tail);
+            }
+
+            const int               capacity;
+            LoggerRecord*           ring;
+            QAtomicInt              head;
+            QAtomicInt              tail;
+            //! Set when the owning thread finished or replaced the buffer, the dispatcher deletes orphaned buffers once they are empty.
+            QAtomicInt              orphaned;
+        };
+
+        // Dispatcher thread used by the Logger when asynchronous dispatching is enabled, see Logger_asynchronous_dispatch.
+        class LoggerDispatcher : public QThread
+        {
+        public:
+            LoggerDispatcher() : QThread(),
+                thread_buffer_capacity(1024),
+                draining_thread(0),
+                sleeping(0),
+                stop_requested(false) {}
+
+            //! Buffers a record logged by the calling thread, waits while the buffer of the calling thread is full.
+            void push(const LoggerRecord& record);
+            //! Delivers all buffered records from all threads in the calling thread.
+            void drain();
+            //! Delivers all buffered records and stops the thread.
+            void stop();
+            //! Indicates if the calling thread is delivering records, messages logged by engines during delivery must be delivered directly.
+            bool isDeliveringInCurrentThread() const {
+                #if QT_VERSION >= 0x050000
+                return QThread::currentThread() == this || QThread::currentThread() == draining_thread.load();
+                #else
+                return QThread::currentThread() == this || QThread::currentThread() == (QThread*) draining_thread;
+                #endif
+            }
+
+            //! The capacity of buffers created for logging threads, only changed while the dispatcher is not running.
+            int                             thread_buffer_capacity;
+
+        protected:
+            void run();
+
+        private:
+            LoggerRecordBuffer* currentThreadBuffer();
+            bool hasBufferedRecords();
+
+            //! Serializes the consumers of the buffers, thus the dispatcher thread and flushing threads.
+            QMutex                          drain_mutex;
+            //! The thread which holds drain_mutex.
+            QAtomicPointer<QThread>         draining_thread;
+            //! Protects buffers, only locked when threads log for the first time and by consumers.
+            QMutex                          buffers_mutex;
+            QList<LoggerRecordBuffer*>      buffers;
+            //! Protects stop_requested and is used to put the dispatcher to sleep and to wait for buffer space.
+            QMutex                          wake_mutex;
+            QWaitCondition                  records_available;
+            QWaitCondition                  space_available;
+            //! Set while the dispatcher is about to sleep, thus logging threads only take the wake_mutex when the dispatcher must be woken up.
+            QAtomicInt                      sleeping;
+            bool                            stop_requested;
+        };
+    }
+}
+
+namespace {
+    // A Qt message captured by installLoggerMessageHandler(). The context details are formatted when the logger drains the message.
+    struct qti_private_CapturedQtMessage {
+        qti_private_CapturedQtMessage() : next(0), message_type(Qtilities::Logging::Logger::None), line(0) {}
+
+        QString detailedMessage() const {
+            if (file.isEmpty())
+                return message;
+
+            QString detailed_msg;
+            detailed_msg.reserve(message.size() + file.size() + function.size() + 16);
+            detailed_msg.append(message);
+            detailed_msg.append(QLatin1String(" ("));
+            detailed_msg.append(QLatin1String(file.constData()));
+            detailed_msg.append(QLatin1Char(':'));
+            detailed_msg.append(QString::number(line));
+            detailed_msg.append(QLatin1String(". "));
+            detailed_msg.append(QLatin1String(function.constData()));
+            detailed_msg.append(QLatin1Char(')'));
+            return detailed_msg;
+        }
+
+        qti_private_CapturedQtMessage*          next;
+        Qtilities::Logging::Logger::MessageType message_type;
+        QString                                 message;
+        QByteArray                              file;
+        QByteArray                              function;
+        int                                     line;
+    };
+
+    // Captured messages are pushed onto a lock-free stack by any thread, the logger takes all of them at once and logs them in the order they were captured.
+    struct qti_private_CapturedQtMessageQueue {
+        QAtomicPointer<qti_private_CapturedQtMessage> head;
+    };
+    Q_GLOBAL_STATIC(qti_private_CapturedQtMessageQueue, qti_private_captured_qt_messages)
+
+    // The number of nested message deliveries to logger engines on each thread. Qt messages produced
+    // during a delivery, for example by the QtMsgLoggerEngine, are not captured again.
+    Q_GLOBAL_STATIC(QThreadStorage<int>, qti_private_qt_message_delivery_depth)
+
+    // The task ID set by Logger::setCurrentTaskId() on each thread, plus one since unset storage reads as 0.
+    Q_GLOBAL_STATIC(QThreadStorage<int>, qti_private_current_task_ids)
+
+    class qti_private_QtMessageDeliveryGuard {
+    public:
+        qti_private_QtMessageDeliveryGuard(bool is_active) : depth(is_active ? qti_private_qt_message_delivery_depth() : 0) {
+            if (depth)
+                ++depth->localData();
+        }
+        ~qti_private_QtMessageDeliveryGuard() {
+            if (depth)
+                --depth->localData();
+        }
+
+    private:
+        QThreadStorage<int>* depth;
+    };
+
+    bool qti_private_isDeliveringMessages() {
+        QThreadStorage<int>* depth = qti_private_qt_message_delivery_depth();
+        return !depth || (depth->hasLocalData() && depth->localData() > 0);
+    }
+
+    // Pushes a message onto the queue, returns true when the queue was empty before the message was pushed.
+    bool qti_private_pushCapturedQtMessage(qti_private_CapturedQtMessageQueue* queue, qti_private_CapturedQtMessage* message) {
+        qti_private_CapturedQtMessage* head;
+        do {
+            #if QT_VERSION >= 0x050000
+            head = queue->head.load();
+            #else
+            head = queue->head;
+            #endif
+            message->next = head;
+        } while (!queue->head.testAndSetOrdered(head,message));
+
+        return head == 0;
+    }
+
+    // Takes all messages from the queue, returns them in the order in which they were pushed.
+    qti_private_CapturedQtMessage* qti_private_takeCapturedQtMessages() {
+        qti_private_CapturedQtMessageQueue* queue = qti_private_captured_qt_messages();
+        if (!queue)
+            return 0;
+
+        qti_private_CapturedQtMessage* message = queue->head.fetchAndStoreOrdered(0);
+        qti_private_CapturedQtMessage* ordered = 0;
+        while (message) {
+            qti_private_CapturedQtMessage* next = message->next;
+            message->next = ordered;
+            ordered = message;
+            message = next;
+        }
+
+        return ordered;
+    }
+
+    void qti_private_captureQtMessage(Qtilities::Logging::Logger::MessageType message_type, const QString& msg, const char* file, int line, const char* function) {
+        bool is_fatal = (message_type == Qtilities::Logging::Logger::Fatal);
+        if (!is_fatal && !Qtilities::Logging::Logger::isMessageLogged(message_type,Qtilities::Logging::Logger::SystemWideMessages))
+            return;
+
+        // Messages produced while the logger delivers messages on this thread, and messages produced
+        // after the queue was destroyed during application exit, are written to stderr:
+        qti_private_CapturedQtMessageQueue* queue = qti_private_captured_qt_messages();
+        if (!queue || qti_private_isDeliveringMessages()) {
+            fprintf(stderr,"%s\n",msg.toLocal8Bit().constData());
+            fflush(stderr);
+            return;
+        }
+
+        qti_private_CapturedQtMessage* message = new qti_private_CapturedQtMessage;
+        message->message_type = message_type;
+        message->message = msg;
+        if (file) {
+            message->file = file;
+            message->function = function;
+            message->line = line;
+        }
+
+        bool was_empty = qti_private_pushCapturedQtMessage(queue,message);
+        if (is_fatal) {
+            QMetaObject::invokeMethod(Log,"drainQtMessages",Qt::DirectConnection);
+            abort();
+        }
+
+        // Messages from the logger's thread are logged immediately, other threads schedule a single
+        // drain for all messages they push until the logger takes them:
+        if (was_empty || QThread::currentThread() == Log->thread())
+            QMetaObject::invokeMethod(Log,"drainQtMessages",Qt::AutoConnection);
+    }
+}
+
+namespace {
+    // Owned by the thread storage of a logging thread, orphans the buffer of the thread when the thread finishes.
+    struct qti_private_LoggerRecordBufferHandle {
+        qti_private_LoggerRecordBufferHandle(Qtilities::Logging::LoggerRecordBuffer* buffer) : buffer(buffer) {}
+        ~qti_private_LoggerRecordBufferHandle() {
+            Qtilities::Logging::atomicStoreRelease(buffer->orphaned,1);
+        }
+
+        Qtilities::Logging::LoggerRecordBuffer* buffer;
+    };
+
+    Q_GLOBAL_STATIC(QThreadStorage<qti_private_LoggerRecordBufferHandle*>,qti_private_logger_record_buffers)
+}
+
+Qtilities::Logging::LoggerRecordBuffer* Qtilities::Logging::LoggerDispatcher::currentThreadBuffer() {
+    QThreadStorage<qti_private_LoggerRecordBufferHandle*>* storage = qti_private_logger_record_buffers();
+    if (!storage)
+        return 0;
+
+    qti_private_LoggerRecordBufferHandle* handle = storage->localData();
+    if (handle && handle->buffer->capacity == thread_buffer_capacity)
+        return handle->buffer;
+
+    // The first message logged by this thread, or the capacity changed. Replacing the handle orphans the previous buffer:
+    LoggerRecordBuffer* buffer = new LoggerRecordBuffer(thread_buffer_capacity);
+    buffers_mutex.lock();
+    buffers << buffer;
+    buffers_mutex.unlock();
+    storage->setLocalData(new qti_private_LoggerRecordBufferHandle(buffer));
+    return buffer;
+}
+
+bool Qtilities::Logging::LoggerDispatcher::hasBufferedRecords() {
+    QMutexLocker locker(&buffers_mutex);
+    for (int i = 0; i < buffers.count(); ++i) {
+        if (!buffers.at(i)->isEmpty())
+            return true;
+    }
+    return false;
+}
+
+void Qtilities::Logging::LoggerDispatcher::push(const LoggerRecord& record) {
+    LoggerRecordBuffer* buffer = currentThreadBuffer();
+    if (!buffer) {
+        // The thread storage is destroyed during application exit:
+        Log->dispatchRecords(QList<LoggerRecord>() << record);
+        return;
+    }
+
+    while (!buffer->push(record)) {
+        // The buffer is full, wake the dispatcher and wait until it took the records of this thread:
+        QMutexLocker locker(&wake_mutex);
+        sleeping.fetchAndStoreOrdered(0);
+        records_available.wakeOne();
+        if (!isRunning()) {
+            locker.unlock();
+            drain();
+        } else
+            space_available.wait(&wake_mutex,10);
+    }
+
+    if (atomicLoadRelaxed(sleeping) && sleeping.testAndSetOrdered(1,0)) {
+        QMutexLocker locker(&wake_mutex);
+        records_available.wakeOne();
+    }
+}
+
+void Qtilities::Logging::LoggerDispatcher::drain() {
+    QMutexLocker drain_locker(&drain_mutex);
+    buffers_mutex.lock();
+    QList<LoggerRecordBuffer*> current_buffers = buffers;
+    buffers_mutex.unlock();
+
+    QList<LoggerRecord> records;
+    int thread_count = 0;
+    for (int i = 0; i < current_buffers.count(); ++i) {
+        LoggerRecordBuffer* buffer = current_buffers.at(i);
+        // The orphaned flag is read first: When set, nothing can be pushed anymore, thus the buffer can be deleted once it was emptied.
+        const bool orphaned = atomicLoadAcquire(buffer->orphaned) != 0;
+        const int previous_count = records.count();
+        buffer->takeAll(records);
+        if (records.count() > previous_count)
+            ++thread_count;
+        if (orphaned) {
+            buffers_mutex.lock();
+            buffers.removeOne(buffer);
+            buffers_mutex.unlock();
+            delete buffer;
+        }
+    }
+    if (records.isEmpty())
+        return;
+
+    wake_mutex.lock();
+    space_available.wakeAll();
+    wake_mutex.unlock();
+
+    // The records of each thread are in order, the records of different threads are merged on their timestamps:
+    if (thread_count > 1)
+        qStableSort(records.begin(),records.end(),recordTimestampLessThan);
+
+    #if QT_VERSION >= 0x050000
+    draining_thread.store(QThread::currentThread());
+    #else
+    draining_thread = QThread::currentThread();
+    #endif
+    Log->dispatchRecords(records);
+    #if QT_VERSION >= 0x050000
+    draining_thread.store(0);
+    #else
+    draining_thread = 0;
+    #endif
+}
+
+void Qtilities::Logging::LoggerDispatcher::stop() {
+    wake_mutex.lock();
+    stop_requested = true;
+    records_available.wakeOne();
+    wake_mutex.unlock();
+    wait();
+    stop_requested = false;
+}
+
+void Qtilities::Logging::LoggerDispatcher::run() {
+    forever {
+        drain();
+
+        QMutexLocker locker(&wake_mutex);
+        if (stop_requested)
+            break;
+        // Logging threads wake the dispatcher when they see this flag, the buffers are checked once more after setting it:
+        sleeping.fetchAndStoreOrdered(1);
+        if (!hasBufferedRecords())
+            records_available.wait(&wake_mutex,100);
+        sleeping.fetchAndStoreOrdered(0);
+    }
+}
+
 struct Qtilities::Logging::LoggerPrivateData {
+    LoggerPrivateData() : logger_engines_lock(QReadWriteLock::Recursive),
+        throttling_active(false),
+        coalescing_enabled(false),
+        coalescing_interval(1000),
+        last_message_type(Logger::None),
+        last_message_context(Logger::NoMessageContext),
+        last_message_repeat_count(0),
+        coalesced_message_count(0),
+        dispatcher(0),
+        asynchronous_dispatch(0),
+        session_log_store(0),
+        session_log_store_enabled(0) {
+        for (int i = 0; i < 7; ++i) {
+            rate_limits[i] = 0;
+            rate_bursts[i] = 0;
+            rate_tokens[i] = 0;
+            rate_last_refill[i] = 0;
+            rate_limited_counts[i] = 0;
+            rate_pending_counts[i] = 0;
+        }
+        throttle_clock.start();
+        coalescing_timer.setSingleShot(true);
+        record_clock.start();
+    }
+
     LoggerFactory<AbstractLoggerEngine>         logger_engine_factory;
     QList<QPointer<AbstractLoggerEngine> >      logger_engines;
+    //! Protects modifications to logger_engines, since messages can be logged from any thread.
+    mutable QReadWriteLock                      logger_engines_lock;
+    // Routing tables, rebuilt by updateEnabledMessageMask() whenever the engines or their settings change:
+    //! Protects the routing tables below.
+    mutable QReadWriteLock                      routes_lock;
+    //! The active engines accepting system wide messages, for each message type index.
+    QList<QPointer<AbstractLoggerEngine> >      system_wide_routes[7];
+    //! The active engines accepting priority messages, for each message type index.
+    QList<QPointer<AbstractLoggerEngine> >      priority_routes[7];
+    //! All attached engines by name, engine specific messages are only offered to these engines.
+    QHash<QString,QList<QPointer<AbstractLoggerEngine> > > engine_routes;
     QList<QPointer<AbstractFormattingEngine> >  formatting_engines;
     QString                                     default_formatting_engine;
     Logger::MessageType                         global_log_level;
@@ -36,9 +498,91 @@ struct Qtilities::Logging::LoggerPrivateData {
     QPointer<AbstractFormattingEngine>          priority_formatting_engine;
     QString                                     session_path;
     bool                                        settings_enabled;
+
+    // Throttling, see Logger_throttling:
+    //! Protects all throttling state below.
+    QMutex                                      throttle_mutex;
+    //! True when coalescing or any rate limit is enabled, allows unthrottled logging to skip the throttle mutex.
+    volatile bool                               throttling_active;
+    bool                                        coalescing_enabled;
+    int                                         coalescing_interval;
+    QString                                     last_message_engine;
+    Logger::MessageType                         last_message_type;
+    Logger::MessageContextFlags                 last_message_context;
+    QList<QVariant>                             last_message_contents;
+    int                                         last_message_repeat_count;
+    QElapsedTimer                               last_message_timer;
+    int                                         coalesced_message_count;
+    QTimer                                      coalescing_timer;
+    QElapsedTimer                               throttle_clock;
+    int                                         rate_limits[7];
+    int                                         rate_bursts[7];
+    double                                      rate_tokens[7];
+    qint64                                      rate_last_refill[7];
+    int                                         rate_limited_counts[7];
+    int                                         rate_pending_counts[7];
+
+    // Asynchronous dispatching, see Logger_asynchronous_dispatch:
+    //! Created the first time asynchronous dispatching is enabled, never deleted while the logger exists since logging threads might still use it.
+    LoggerDispatcher*                           dispatcher;
+    QAtomicInt                                  asynchronous_dispatch;
+    QElapsedTimer                               record_clock;
+
+    // The session log store, see Logger_session_log_store:
+    //! Protected by routes_lock, since it is deleted when the store is disabled while messages are added to it.
+    SessionLogStore*                            session_log_store;
+    //! Allows dispatching to skip routes_lock when the store is not enabled.
+    QAtomicInt                                  session_log_store_enabled;
+
+    //! Returns the engines to which a message must be delivered.
+    QList<QPointer<AbstractLoggerEngine> > routes(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context) const {
+        QReadLocker locker(&routes_lock);
+        if (engine_name.isEmpty()) {
+            if (message_context & Logger::PriorityMessages)
+                return priority_routes[messageTypeIndex(message_type)];
+            return system_wide_routes[messageTypeIndex(message_type)];
+        }
+
+        // Engine specific messages only need to check the engines with the given name:
+        QList<QPointer<AbstractLoggerEngine> > engines = engine_routes.value(engine_name);
+        locker.unlock();
+        for (int i = engines.count() - 1; i >= 0; --i) {
+            if (!engines.at(i) || !engines.at(i)->acceptsMessage(engine_name,message_type,message_context))
+                engines.removeAt(i);
+        }
+        return engines;
+    }
+
+    void updateThrottlingActive() {
+        bool active = coalescing_enabled;
+        for (int i = 0; i < 7; ++i)
+            active |= (rate_limits[i] > 0);
+        throttling_active = active;
+    }
+    //! Creates the "repeated" summary for the last message when it was repeated. Must be called with throttle_mutex locked.
+    void takeRepeatSummary(QList<LoggerThrottleSummary>& summaries) {
+        if (last_message_repeat_count == 0)
+            return;
+
+        LoggerThrottleSummary summary;
+        summary.engine_name = last_message_engine;
+        summary.message_type = last_message_type;
+        summary.message_context = last_message_context;
+        summary.message_contents << QString("Last message repeated %1 times").arg(last_message_repeat_count);
+        summaries << summary;
+        last_message_repeat_count = 0;
+    }
 };
 
 Qtilities::Logging::Logger* Qtilities::Logging::Logger::m_Instance = 0;
+// Until the mask is calculated for the first time, all messages are allowed:
+QAtomicInt Qtilities::Logging::Logger::m_enabled_message_mask(~0);
+// Tagged messages are logged by default in debug builds only, like untagged trace and debug messages:
+#ifndef QT_NO_DEBUG
+QAtomicInt Qtilities::Logging::Logger::m_enabled_tag_mask(Logger::AllLogTags);
+#else
+QAtomicInt Qtilities::Logging::Logger::m_enabled_tag_mask(Logger::NoLogTags);
+#endif
 
 Qtilities::Logging::Logger* Qtilities::Logging::Logger::instance() {
     static QMutex mutex;
@@ -66,12 +610,18 @@ Qtilities::Logging::Logger::Logger(QObject* parent) : QObject(parent) {
     d->session_path = QCoreApplication::applicationDirPath() + qti_def_PATH_SESSION;
     d->settings_enabled = true;
 
+    connect(&d->coalescing_timer,SIGNAL(timeout()),SLOT(flushCoalescedMessages()));
+
     qRegisterMetaType<Logger::MessageType>("Logger::MessageType");
     qRegisterMetaType<Logger::MessageContextFlags>("Logger::MessageContextFlags");
+    qRegisterMetaType<LoggerRecord>("LoggerRecord");
+    qRegisterMetaType<QList<LoggerRecord> >("QList<LoggerRecord>");
 }
 
 Qtilities::Logging::Logger::~Logger() {
+    setAsynchronousDispatchEnabled(false);
     clear();
+    setSessionLogStoreEnabled(false);
     delete d;
 }
 
@@ -92,6 +642,8 @@ void Qtilities::Logging::Logger::initialize(const QString& configuration_file_na
 
     // Register the logger enigines that comes as part of the Qtilities Logging Framework
     d->logger_engine_factory.registerFactoryInterface(qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE, &FileLoggerEngine::factory);
+    d->logger_engine_factory.registerFactoryInterface(qti_def_FACTORY_TAG_BINARY_LOGGER_ENGINE, &BinaryLoggerEngine::factory);
+    d->logger_engine_factory.registerFactoryInterface(qti_def_FACTORY_TAG_NETWORK_LOGGER_ENGINE, &NetworkLoggerEngine::factory);
 
     //qDebug() << tr("> Number of formatting engines available: ") << d->formatting_engines.count();
     //qDebug() << tr("> Number of logger engine factories available: ") << d->logger_engine_factory.tags().count();
@@ -118,6 +670,12 @@ void Qtilities::Logging::Logger::initialize(const QString& configuration_file_na
 }
 
 void Qtilities::Logging::Logger::finalize(const QString &configuration_file_name) {
+    drainQtMessages();
+    flushCoalescedMessages();
+    setAsynchronousDispatchEnabled(false);
+    // The console engine is never deleted, thus it must write its buffered messages here:
+    ConsoleLoggerEngine::instance()->flush();
+
     if (d->remember_session_config) {
         saveSessionConfig(configuration_file_name);
     }
@@ -126,18 +684,27 @@ void Qtilities::Logging::Logger::finalize(const QString &configuration_file_name
 }
 
 void Qtilities::Logging::Logger::clear() {
+    // Engines must not be deleted while the dispatcher delivers records to them:
+    flushMessages();
+
     // Delete all logger engines
     //qDebug() << tr("Qtilities Logging Framework, clearing started...");
-    for (int i = 0; i < d->logger_engines.count(); ++i) {
-        if (d->logger_engines.at(i)) {
-            if (d->logger_engines.at(i) != QtMsgLoggerEngine::instance() && d->logger_engines.at(i) != ConsoleLoggerEngine::instance()) {
-                //qDebug() << tr("> Deleting logger engine: ") << d->logger_engines.at(i)->objectName();
-                delete d->logger_engines.at(i);
+    // Engines detach themselves when deleted, thus we work on a copy of the list:
+    QList<QPointer<AbstractLoggerEngine> > engines = d->logger_engines;
+    for (int i = 0; i < engines.count(); ++i) {
+        if (engines.at(i)) {
+            if (engines.at(i) != QtMsgLoggerEngine::instance() && engines.at(i) != ConsoleLoggerEngine::instance()) {
+                //qDebug() << tr("> Deleting logger engine: ") << engines.at(i)->objectName();
+                engines.at(i)->setWorkerThreadEnabled(false);
+                delete engines.at(i);
             }
         }
 
     }
+    d->logger_engines_lock.lockForWrite();
     d->logger_engines.clear();
+    d->logger_engines_lock.unlock();
+    updateEnabledMessageMask();
     //qDebug() << tr("Qtilities Logging Framework, clearing finished successfully...");
 }
 
@@ -198,6 +765,10 @@ void Qtilities::Logging::Logger::logMessage(const QString& engine_name, MessageT
     else
         context |= EngineSpecificMessages;
 
+    if (d->throttling_active && throttleMessage(engine_name,message_type,context,message_contents))
+        return;
+
+    deliverMessage(engine_name,message_type,context,message_contents);
     emit newMessage(engine_name,message_type,context,message_contents);
 }
 
@@ -230,6 +801,12 @@ void Qtilities::Logging::Logger::logPriorityMessage(const QString& engine_name,
     MessageContextFlags context = 0;
     context |= PriorityMessages;
 
+    if (d->throttling_active && throttleMessage(engine_name,message_type,context,message_contents))
+        return;
+
+    // Priority messages are delivered immediately, after the messages which were logged before them:
+    flushMessages();
+    dispatchMessage(engine_name,message_type,context,message_contents);
     emit newMessage(engine_name,message_type,context,message_contents);
 
     QString formatted_message;
@@ -241,6 +818,405 @@ void Qtilities::Logging::Logger::logPriorityMessage(const QString& engine_name,
     emit newPriorityMessage(message_type,formatted_message);
 }
 
+void Qtilities::Logging::Logger::dispatchMessage(const QString& engine_name, MessageType message_type, MessageContextFlags message_context, const QList<QVariant>& message_contents) {
+    qti_private_QtMessageDeliveryGuard delivery_guard(d->is_qt_message_handler);
+
+    // The session log store receives every message, before it is routed to the engines:
+    if (atomicLoadAcquire(d->session_log_store_enabled)) {
+        d->routes_lock.lockForRead();
+        if (d->session_log_store)
+            d->session_log_store->addMessage(engine_name,message_type,message_contents,currentTaskId());
+        d->routes_lock.unlock();
+    }
+
+    // The routing tables only contain engines accepting the message, this is cheap since QList is implicitly shared:
+    const QList<QPointer<AbstractLoggerEngine> > engines = d->routes(engine_name,message_type,message_context);
+
+    // Format the message once for every distinct formatting engine, all engines using the same
+    // formatting engine receive the same implicitly shared formatted string:
+    QVarLengthArray<AbstractFormattingEngine*,8> formatting_engines;
+    QVarLengthArray<QString,8> formatted_messages;
+    for (int i = 0; i < engines.count(); ++i) {
+        AbstractLoggerEngine* engine = engines.at(i);
+        if (!engine)
+            continue;
+
+        // Engines overriding newMessages() receive the message there:
+        if (engine->interceptsMessage(engine_name,message_type,message_context,message_contents))
+            continue;
+
+        if (engine->logsUnformattedMessages()) {
+            engine->newUnformattedMessage(engine_name,message_type,message_context,message_contents);
+            continue;
+        }
+
+        AbstractFormattingEngine* formatting_engine = engine->getInstalledFormattingEngine();
+        if (!formatting_engine)
+            continue;
+
+        int formatted_index = -1;
+        for (int f = 0; f < formatting_engines.size(); ++f) {
+            if (formatting_engines[f] == formatting_engine) {
+                formatted_index = f;
+                break;
+            }
+        }
+        if (formatted_index == -1) {
+            formatting_engines.append(formatting_engine);
+            formatted_messages.append(formatting_engine->formatMessage(message_type,message_contents));
+            formatted_index = formatted_messages.size() - 1;
+        }
+
+        engine->newFormattedMessage(formatted_messages[formatted_index],message_type);
+    }
+}
+
+void Qtilities::Logging::Logger::deliverMessage(const QString& engine_name, MessageType message_type, MessageContextFlags message_context, const QList<QVariant>& message_contents) {
+    // Messages logged by engines while records are delivered are delivered directly:
+    if (!atomicLoadAcquire(d->asynchronous_dispatch) || d->dispatcher->isDeliveringInCurrentThread()) {
+        dispatchMessage(engine_name,message_type,message_context,message_contents);
+        return;
+    }
+
+    LoggerRecord record;
+    record.engine_name = engine_name;
+    record.message_type = message_type;
+    record.message_context = message_context;
+    record.message_contents = message_contents;
+    record.thread_id = QThread::currentThreadId();
+    record.timestamp = d->record_clock.nsecsElapsed();
+    record.task_id = currentTaskId();
+    d->dispatcher->push(record);
+
+    // Fatal messages are delivered before returning. Records pushed while asynchronous dispatching is being disabled are delivered by the logging thread:
+    if (message_type == Fatal || !atomicLoadAcquire(d->asynchronous_dispatch))
+        d->dispatcher->drain();
+}
+
+void Qtilities::Logging::Logger::dispatchRecords(const QList<LoggerRecord>& records) {
+    qti_private_QtMessageDeliveryGuard delivery_guard(d->is_qt_message_handler);
+
+    if (atomicLoadAcquire(d->session_log_store_enabled)) {
+        d->routes_lock.lockForRead();
+        if (d->session_log_store)
+            d->session_log_store->addRecords(records);
+        d->routes_lock.unlock();
+    }
+
+    // Route every record to the engines accepting it, thus each engine gets the indexes of its records in order:
+    QVarLengthArray<AbstractLoggerEngine*,8> engines;
+    QVarLengthArray<QVector<int>,8> engine_record_indexes;
+    for (int r = 0; r < records.count(); ++r) {
+        const LoggerRecord& record = records.at(r);
+        const QList<QPointer<AbstractLoggerEngine> > routes = d->routes(record.engine_name,record.message_type,record.message_context);
+        for (int i = 0; i < routes.count(); ++i) {
+            AbstractLoggerEngine* engine = routes.at(i);
+            if (!engine)
+                continue;
+
+            // Engines overriding newMessages() receive the record there, the remaining records are delivered in batches:
+            if (engine->interceptsMessage(record.engine_name,record.message_type,record.message_context,record.message_contents))
+                continue;
+
+            int engine_index = -1;
+            for (int e = 0; e < engines.size(); ++e) {
+                if (engines[e] == engine) {
+                    engine_index = e;
+                    break;
+                }
+            }
+            if (engine_index == -1) {
+                engines.append(engine);
+                engine_record_indexes.append(QVector<int>());
+                engine_index = engines.size() - 1;
+            }
+            engine_record_indexes[engine_index].append(r);
+        }
+    }
+
+    // Records are formatted once for every distinct formatting engine, all engines using the same
+    // formatting engine receive the same implicitly shared formatted strings:
+    QVarLengthArray<AbstractFormattingEngine*,8> formatting_engines;
+    QVarLengthArray<QVector<QString>,8> formatted_messages;
+    for (int i = 0; i < engines.size(); ++i) {
+        AbstractLoggerEngine* engine = engines[i];
+        AbstractFormattingEngine* formatting_engine = 0;
+        int formatted_index = -1;
+        if (!engine->logsUnformattedMessages()) {
+            formatting_engine = engine->getInstalledFormattingEngine();
+            if (!formatting_engine)
+                continue;
+
+            for (int f = 0; f < formatting_engines.size(); ++f) {
+                if (formatting_engines[f] == formatting_engine) {
+                    formatted_index = f;
+                    break;
+                }
+            }
+            if (formatted_index == -1) {
+                formatting_engines.append(formatting_engine);
+                formatted_messages.append(QVector<QString>(records.count()));
+                formatted_index = formatted_messages.size() - 1;
+            }
+        }
+
+        const QVector<int>& record_indexes = engine_record_indexes[i];
+        QList<LoggerRecord> engine_records;
+        engine_records.reserve(record_indexes.count());
+        for (int j = 0; j < record_indexes.count(); ++j) {
+            const int r = record_indexes.at(j);
+            const LoggerRecord& record = records.at(r);
+            engine_records << record;
+            if (formatting_engine) {
+                QString& formatted_message = formatted_messages[formatted_index][r];
+                if (formatted_message.isNull())
+                    formatted_message = formatting_engine->formatMessage(record.message_type,record.message_contents);
+                engine_records.last().formatted_message = formatted_message;
+            }
+        }
+
+        if (!engine_records.isEmpty())
+            engine->newRecords(engine_records);
+    }
+}
+
+void Qtilities::Logging::Logger::setAsynchronousDispatchEnabled(bool is_enabled, int thread_buffer_capacity) {
+    if (is_enabled == asynchronousDispatchEnabled())
+        return;
+
+    if (is_enabled) {
+        if (!d->dispatcher)
+            d->dispatcher = new LoggerDispatcher;
+        d->dispatcher->thread_buffer_capacity = qMax(1,thread_buffer_capacity);
+        d->dispatcher->start();
+        atomicStoreRelease(d->asynchronous_dispatch,1);
+    } else {
+        atomicStoreRelease(d->asynchronous_dispatch,0);
+        d->dispatcher->stop();
+        d->dispatcher->drain();
+    }
+}
+
+bool Qtilities::Logging::Logger::asynchronousDispatchEnabled() const {
+    return atomicLoadAcquire(d->asynchronous_dispatch) != 0;
+}
+
+void Qtilities::Logging::Logger::setSessionLogStoreEnabled(bool is_enabled, int capacity) {
+    if (is_enabled == sessionLogStoreEnabled())
+        return;
+
+    SessionLogStore* old_store = 0;
+    d->routes_lock.lockForWrite();
+    if (is_enabled) {
+        d->session_log_store = new SessionLogStore(capacity);
+        atomicStoreRelease(d->session_log_store_enabled,1);
+    } else {
+        atomicStoreRelease(d->session_log_store_enabled,0);
+        old_store = d->session_log_store;
+        d->session_log_store = 0;
+    }
+    d->routes_lock.unlock();
+
+    // Messages can be added to the store while the write lock is not held, thus it is deleted afterwards:
+    delete old_store;
+    updateEnabledMessageMask();
+}
+
+bool Qtilities::Logging::Logger::sessionLogStoreEnabled() const {
+    return atomicLoadAcquire(d->session_log_store_enabled) != 0;
+}
+
+Qtilities::Logging::SessionLogStore* Qtilities::Logging::Logger::sessionLogStore() const {
+    QReadLocker locker(&d->routes_lock);
+    return d->session_log_store;
+}
+
+void Qtilities::Logging::Logger::setCurrentTaskId(int task_id) {
+    qti_private_current_task_ids()->setLocalData(task_id + 1);
+}
+
+int Qtilities::Logging::Logger::currentTaskId() const {
+    QThreadStorage<int>* task_ids = qti_private_current_task_ids();
+    if (!task_ids->hasLocalData())
+        return -1;
+    return task_ids->localData() - 1;
+}
+
+void Qtilities::Logging::Logger::flushMessages() {
+    if (d->dispatcher && !d->dispatcher->isDeliveringInCurrentThread())
+        d->dispatcher->drain();
+}
+
+bool Qtilities::Logging::Logger::throttleMessage(const QString& engine_name, MessageType message_type, MessageContextFlags message_context, const QList<QVariant>& message_contents) {
+    QList<LoggerThrottleSummary> summaries;
+    bool is_throttled = false;
+    bool start_coalescing_timer = false;
+
+    d->throttle_mutex.lock();
+    if (d->coalescing_enabled) {
+        if (d->last_message_type == message_type && d->last_message_context == message_context
+                && d->last_message_engine == engine_name && d->last_message_contents == message_contents) {
+            ++d->coalesced_message_count;
+            start_coalescing_timer = (d->last_message_repeat_count == 0);
+            ++d->last_message_repeat_count;
+            // Report long running floods periodically:
+            if (d->last_message_timer.elapsed() >= d->coalescing_interval) {
+                d->takeRepeatSummary(summaries);
+                d->last_message_timer.restart();
+            }
+            is_throttled = true;
+        } else {
+            d->takeRepeatSummary(summaries);
+            d->last_message_engine = engine_name;
+            d->last_message_type = message_type;
+            d->last_message_context = message_context;
+            d->last_message_contents = message_contents;
+            d->last_message_timer.restart();
+        }
+    }
+
+    const int index = messageTypeIndex(message_type);
+    if (!is_throttled && d->rate_limits[index] > 0) {
+        // Token bucket, refilled at rate_limits[index] tokens per second up to rate_bursts[index] tokens:
+        const qint64 now = d->throttle_clock.elapsed();
+        d->rate_tokens[index] = qMin(double(d->rate_bursts[index]),d->rate_tokens[index] + (now - d->rate_last_refill[index]) * d->rate_limits[index] / 1000.0);
+        d->rate_last_refill[index] = now;
+        if (d->rate_tokens[index] < 1.0) {
+            ++d->rate_limited_counts[index];
+            ++d->rate_pending_counts[index];
+            is_throttled = true;
+        } else {
+            d->rate_tokens[index] -= 1.0;
+            if (d->rate_pending_counts[index] > 0) {
+                LoggerThrottleSummary summary;
+                summary.engine_name = engine_name;
+                summary.message_type = message_type;
+                summary.message_context = message_context;
+                summary.message_contents << QString("%1 %2 messages were dropped by the rate limit").arg(d->rate_pending_counts[index]).arg(logLevelToString(message_type).toLower());
+                summaries << summary;
+                d->rate_pending_counts[index] = 0;
+            }
+        }
+    }
+    d->throttle_mutex.unlock();
+
+    if (start_coalescing_timer) {
+        if (QThread::currentThread() == thread())
+            d->coalescing_timer.start(d->coalescing_interval);
+        else
+            QMetaObject::invokeMethod(&d->coalescing_timer,"start",Qt::QueuedConnection,Q_ARG(int,d->coalescing_interval));
+    }
+
+    for (int i = 0; i < summaries.count(); ++i) {
+        deliverMessage(summaries.at(i).engine_name,summaries.at(i).message_type,summaries.at(i).message_context,summaries.at(i).message_contents);
+        emit newMessage(summaries.at(i).engine_name,summaries.at(i).message_type,summaries.at(i).message_context,summaries.at(i).message_contents);
+    }
+
+    return is_throttled;
+}
+
+void Qtilities::Logging::Logger::flushCoalescedMessages() {
+    QList<LoggerThrottleSummary> summaries;
+    d->throttle_mutex.lock();
+    d->takeRepeatSummary(summaries);
+    d->last_message_timer.restart();
+    d->throttle_mutex.unlock();
+
+    for (int i = 0; i < summaries.count(); ++i) {
+        deliverMessage(summaries.at(i).engine_name,summaries.at(i).message_type,summaries.at(i).message_context,summaries.at(i).message_contents);
+        emit newMessage(summaries.at(i).engine_name,summaries.at(i).message_type,summaries.at(i).message_context,summaries.at(i).message_contents);
+    }
+}
+
+void Qtilities::Logging::Logger::drainQtMessages() {
+    qti_private_CapturedQtMessage* message = qti_private_takeCapturedQtMessages();
+    while (message) {
+        logMessage(QString(),message->message_type,message->detailedMessage());
+
+        qti_private_CapturedQtMessage* next = message->next;
+        delete message;
+        message = next;
+    }
+}
+
+void Qtilities::Logging::Logger::setMessageCoalescingEnabled(bool is_enabled) {
+    if (!is_enabled)
+        flushCoalescedMessages();
+
+    QMutexLocker locker(&d->throttle_mutex);
+    if (d->coalescing_enabled == is_enabled)
+        return;
+
+    d->coalescing_enabled = is_enabled;
+    d->last_message_type = None;
+    d->last_message_contents.clear();
+    d->updateThrottlingActive();
+    locker.unlock();
+
+    writeSettings();
+}
+
+bool Qtilities::Logging::Logger::messageCoalescingEnabled() const {
+    return d->coalescing_enabled;
+}
+
+void Qtilities::Logging::Logger::setMessageCoalescingInterval(int msecs) {
+    QMutexLocker locker(&d->throttle_mutex);
+    d->coalescing_interval = qMax(1,msecs);
+}
+
+int Qtilities::Logging::Logger::messageCoalescingInterval() const {
+    return d->coalescing_interval;
+}
+
+void Qtilities::Logging::Logger::setMessageRateLimit(MessageType message_type, int messages_per_second, int burst_size) {
+    if (message_type == AllLogLevels) {
+        for (int i = 1; i < 7; ++i)
+            setMessageRateLimit((MessageType) (1 << i),messages_per_second,burst_size);
+        return;
+    }
+    if (message_type == None)
+        return;
+
+    QMutexLocker locker(&d->throttle_mutex);
+    const int index = messageTypeIndex(message_type);
+    d->rate_limits[index] = qMax(0,messages_per_second);
+    d->rate_bursts[index] = burst_size > 0 ? burst_size : d->rate_limits[index];
+    d->rate_tokens[index] = d->rate_bursts[index];
+    d->rate_last_refill[index] = d->throttle_clock.elapsed();
+    d->updateThrottlingActive();
+    locker.unlock();
+
+    writeSettings();
+}
+
+int Qtilities::Logging::Logger::messageRateLimit(MessageType message_type) const {
+    return d->rate_limits[messageTypeIndex(message_type)];
+}
+
+int Qtilities::Logging::Logger::coalescedMessageCount() const {
+    QMutexLocker locker(&d->throttle_mutex);
+    return d->coalesced_message_count;
+}
+
+int Qtilities::Logging::Logger::rateLimitedMessageCount(MessageType message_type) const {
+    QMutexLocker locker(&d->throttle_mutex);
+    if (message_type != AllLogLevels)
+        return d->rate_limited_counts[messageTypeIndex(message_type)];
+
+    int count = 0;
+    for (int i = 0; i < 7; ++i)
+        count += d->rate_limited_counts[i];
+    return count;
+}
+
+void Qtilities::Logging::Logger::resetThrottlingCounters() {
+    QMutexLocker locker(&d->throttle_mutex);
+    d->coalesced_message_count = 0;
+    for (int i = 0; i < 7; ++i)
+        d->rate_limited_counts[i] = 0;
+}
+
 bool Qtilities::Logging::Logger::setPriorityFormattingEngine(const QString& name) {
     if (!availableLoggerEnginesInFactory().contains(name))
         return false;
@@ -363,8 +1339,10 @@ bool Qtilities::Logging::Logger::attachLoggerEngine(AbstractLoggerEngine* new_lo
 
     if (new_logger_engine) {
         new_logger_engine->setObjectName(new_logger_engine->name());
+        d->logger_engines_lock.lockForWrite();
         d->logger_engines << new_logger_engine;
-        connect(this,SIGNAL(newMessage(QString,Logger::MessageType,Logger::MessageContextFlags,QList<QVariant>)),new_logger_engine,SLOT(newMessages(QString,Logger::MessageType,Logger::MessageContextFlags,QList<QVariant>)));
+        d->logger_engines_lock.unlock();
+        updateEnabledMessageMask();
     }
 
     emit loggerEngineCountChanged(new_logger_engine, EngineAdded);
@@ -373,10 +1351,16 @@ bool Qtilities::Logging::Logger::attachLoggerEngine(AbstractLoggerEngine* new_lo
 
 bool Qtilities::Logging::Logger::detachLoggerEngine(AbstractLoggerEngine* logger_engine, bool delete_engine) {
     if (logger_engine) {
-        if (d->logger_engines.removeOne(logger_engine)) {
+        d->logger_engines_lock.lockForWrite();
+        bool removed = d->logger_engines.removeOne(logger_engine);
+        d->logger_engines_lock.unlock();
+        if (removed) {
+            updateEnabledMessageMask();
             emit loggerEngineCountChanged(logger_engine, EngineRemoved);
-            if (delete_engine)
+            if (delete_engine) {
+                logger_engine->setWorkerThreadEnabled(false);
                 delete logger_engine;
+            }
             return true;
         }
     }
@@ -441,6 +1425,72 @@ QStringList Qtilities::Logging::Logger::allLogLevelStrings() const {
     return strings;
 }
 
+void Qtilities::Logging::Logger::updateEnabledMessageMask() {
+    // Get the message types allowed by the global log level:
+    int global_types = 0;
+    if (d->global_log_level != None) {
+        for (int type = Info; type <= Trace; type <<= 1) {
+            if (type <= d->global_log_level)
+                global_types |= type;
+        }
+    }
+    // Tagged messages are filtered by their tags instead, thus debug and trace messages are kept for them in release builds:
+    const int tagged_global_types = global_types;
+    #ifdef QT_NO_DEBUG
+    global_types &= ~(Debug | Trace);
+    #endif
+
+    // Priority messages are always emitted through newPriorityMessage(), thus they are only filtered by the global log level.
+    int mask = global_types << 16;
+    // The session log store receives all system wide and engine specific messages allowed by the global log level:
+    if (sessionLogStoreEnabled())
+        mask |= global_types | (global_types << 8) | (tagged_global_types << 24);
+
+    // Rebuild the routing tables used by dispatchMessage() at the same time:
+    QList<QPointer<AbstractLoggerEngine> > system_wide_routes[7];
+    QList<QPointer<AbstractLoggerEngine> > priority_routes[7];
+    QHash<QString,QList<QPointer<AbstractLoggerEngine> > > engine_routes;
+
+    d->logger_engines_lock.lockForRead();
+    for (int i = 0; i < d->logger_engines.count(); ++i) {
+        AbstractLoggerEngine* engine = d->logger_engines.at(i);
+        if (!engine)
+            continue;
+        if (!engine->name().isEmpty())
+            engine_routes[engine->name()] << engine;
+        if (!engine->isActive())
+            continue;
+
+        int engine_types = global_types & (int) engine->getEnabledMessageTypes();
+        if (engine->messageContexts() & SystemWideMessages) {
+            mask |= engine_types;
+            mask |= (tagged_global_types & (int) engine->getEnabledMessageTypes()) << 24;
+        }
+        if (engine->messageContexts() & EngineSpecificMessages)
+            mask |= engine_types << 8;
+
+        for (int index = 1; index < 7; ++index) {
+            if (!(engine->getEnabledMessageTypes() & (1 << index)))
+                continue;
+            if (engine->messageContexts() & SystemWideMessages)
+                system_wide_routes[index] << engine;
+            if (engine->messageContexts() & PriorityMessages)
+                priority_routes[index] << engine;
+        }
+    }
+    d->logger_engines_lock.unlock();
+
+    d->routes_lock.lockForWrite();
+    for (int index = 0; index < 7; ++index) {
+        d->system_wide_routes[index] = system_wide_routes[index];
+        d->priority_routes[index] = priority_routes[index];
+    }
+    d->engine_routes = engine_routes;
+    d->routes_lock.unlock();
+
+    m_enabled_message_mask.fetchAndStoreOrdered(mask);
+}
+
 QString Qtilities::Logging::Logger::messageContextsToString(Logger::MessageContextFlags message_contexts) const {
     QString context_string;
     if (message_contexts & SystemWideMessages)
@@ -481,12 +1531,18 @@ QStringList Qtilities::Logging::Logger::allMessageContextStrings() const {
 }
 
 void Qtilities::Logging::Logger::deleteAllLoggerEngines() {
-    // Delete all logger engines
-    for (int i = 0; i < d->logger_engines.count(); ++i) {
-        if (d->logger_engines.at(i))
-            delete d->logger_engines.at(i);
+    // Delete all logger engines, engines detach themselves when deleted, thus we work on a copy of the list:
+    QList<QPointer<AbstractLoggerEngine> > engines = d->logger_engines;
+    for (int i = 0; i < engines.count(); ++i) {
+        if (engines.at(i)) {
+            engines.at(i)->setWorkerThreadEnabled(false);
+            delete engines.at(i);
+        }
     }
+    d->logger_engines_lock.lockForWrite();
     d->logger_engines.clear();
+    d->logger_engines_lock.unlock();
+    updateEnabledMessageMask();
 }
 
 void Qtilities::Logging::Logger::disableAllLoggerEngines() {
@@ -511,6 +1567,7 @@ void Qtilities::Logging::Logger::deleteEngine(const QString& engine_name) {
 //    else
 //        engine->finalize();
 
+    engine->setWorkerThreadEnabled(false);
     delete engine;
 }
 
@@ -613,6 +1670,7 @@ void Qtilities::Logging::Logger::setGlobalLogLevel(Logger::MessageType new_log_l
         return;
 
     d->global_log_level = new_log_level;
+    updateEnabledMessageMask();
 
     writeSettings();
     LOG_INFO("Global log level changed to " + logLevelToString(new_log_level));
@@ -622,38 +1680,89 @@ Qtilities::Logging::Logger::MessageType Qtilities::Logging::Logger::globalLogLev
     return d->global_log_level;
 }
 
+void Qtilities::Logging::Logger::setEnabledLogTags(LogTags tags) {
+    if (enabledLogTags() == tags)
+        return;
+
+    m_enabled_tag_mask.fetchAndStoreOrdered((int) tags);
+    writeSettings();
+}
+
+Qtilities::Logging::Logger::LogTags Qtilities::Logging::Logger::enabledLogTags() const {
+    return (LogTags) atomicLoadAcquire(m_enabled_tag_mask);
+}
+
+QString Qtilities::Logging::Logger::logTagToString(LogTag tag) const {
+    switch (tag) {
+    case CoreLogTag:                return "Core";
+    case ObserverLogTag:            return "Observer";
+    case TaskLogTag:                return "Task";
+    case CoreGuiLogTag:             return "CoreGui";
+    case TreeModelLogTag:           return "TreeModel";
+    case ExtensionSystemLogTag:     return "ExtensionSystem";
+    case ProjectManagementLogTag:   return "ProjectManagement";
+    case LoggingLogTag:             return "Logging";
+    default:
+        break;
+    }
+
+    int bit = 0;
+    while (bit < 31 && !((int) tag & (1 << bit)))
+        ++bit;
+    return QString("Tag %1").arg(bit);
+}
+
+void Qtilities::Logging::Logger::logTaggedMessage(LogTag tag, MessageType message_type, const QVariant& message) {
+    // Tagged messages are not dropped in release mode, they are only filtered by their tags:
+    if (message_type == AllLogLevels || message_type == None)
+        return;
+
+    if (message_type > d->global_log_level)
+        return;
+
+    QList<QVariant> message_contents;
+    message_contents.push_back(QString("[%1] %2").arg(logTagToString(tag)).arg(message.toString()));
+
+    if (d->throttling_active && throttleMessage(QString(),message_type,SystemWideMessages,message_contents))
+        return;
+
+    deliverMessage(QString(),message_type,SystemWideMessages,message_contents);
+    emit newMessage(QString(),message_type,SystemWideMessages,message_contents);
+}
+
 void Qtilities::Logging::Logger::writeSettings() const {
     if (!d->settings_enabled)
         return;
 
-    // Store settings using QSettings only if it was initialized
-    QSettings settings(d->session_path + QDir::separator() + "qtilities.ini",QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("Logging");
-    settings.beginGroup("General");
-    settings.setValue("global_log_level", QVariant(d->global_log_level));
-    settings.setValue("is_qt_message_handler", d->is_qt_message_handler);
-    settings.endGroup();
-    settings.endGroup();
-    settings.endGroup();
+    // Store settings only if it was initialized. The store saves them on a background thread:
+    SettingsStore* settings = SettingsStore::store(d->session_path + QDir::separator() + "qtilities.ini");
+    settings->setValue("Qtilities/Logging/General/global_log_level", QVariant(d->global_log_level));
+    settings->setValue("Qtilities/Logging/General/is_qt_message_handler", d->is_qt_message_handler);
+    settings->setValue("Qtilities/Logging/General/enabled_log_tags", (int) enabledLogTags());
+    settings->setValue("Qtilities/Logging/Throttling/coalescing_enabled", d->coalescing_enabled);
+    for (int i = 1; i < 7; ++i)
+        settings->setValue(QString("Qtilities/Logging/Throttling/rate_limit_%1").arg(logLevelToString((MessageType) (1 << i)).toLower()), d->rate_limits[i]);
 }
 
 void Qtilities::Logging::Logger::readSettings() {
     if (!d->settings_enabled)
         return;
 
-    // Load logging paramaters using QSettings()
-    QSettings settings(d->session_path + QDir::separator() + "qtilities.ini",QSettings::IniFormat);
-        settings.beginGroup("Qtilities");
-    settings.beginGroup("Logging");
-    settings.beginGroup("General");
-    QVariant log_level =  settings.value("global_log_level", Fatal);
+    // Load logging paramaters from the settings store, which only reads the file the first time it is used
+    SettingsStore* settings = SettingsStore::store(d->session_path + QDir::separator() + "qtilities.ini");
+    QVariant log_level =  settings->value("Qtilities/Logging/General/global_log_level", Fatal);
     d->global_log_level = (MessageType) log_level.toInt();
-    if (settings.value("is_qt_message_handler", false).toBool())
+    updateEnabledMessageMask();
+    if (settings->valueAs<bool>("Qtilities/Logging/General/is_qt_message_handler", false))
         installAsQtMessageHandler(false);
-    settings.endGroup();
-    settings.endGroup();
-    settings.endGroup();
+    m_enabled_tag_mask.fetchAndStoreOrdered(settings->value("Qtilities/Logging/General/enabled_log_tags", (int) enabledLogTags()).toInt());
+    d->coalescing_enabled = settings->valueAs<bool>("Qtilities/Logging/Throttling/coalescing_enabled", false);
+    for (int i = 1; i < 7; ++i) {
+        d->rate_limits[i] = qMax(0,settings->value(QString("Qtilities/Logging/Throttling/rate_limit_%1").arg(logLevelToString((MessageType) (1 << i)).toLower()), 0).toInt());
+        d->rate_bursts[i] = d->rate_limits[i];
+        d->rate_tokens[i] = d->rate_bursts[i];
+    }
+    d->updateThrottlingActive();
 }
 
 void Qtilities::Logging::Logger::setRememberSessionConfig(bool remember) {
@@ -688,6 +1797,7 @@ void Qtilities::Logging::Logger::uninstallAsQtMessageHandler() {
     #else
         qInstallMessageHandler(0);
     #endif
+    drainQtMessages();
 
     d->is_qt_message_handler = false;
     writeSettings();
@@ -716,6 +1826,7 @@ void Qtilities::Logging::Logger::setIsQtMessageHandler(bool toggle) {
         #else
             qInstallMessageHandler(0);
         #endif
+        drainQtMessages();
         LOG_DEBUG("Capturing of Qt debug system messages is now disabled.");
     }
 }
@@ -723,55 +1834,45 @@ void Qtilities::Logging::Logger::setIsQtMessageHandler(bool toggle) {
 #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
 void Qtilities::Logging::installLoggerMessageHandler(QtMsgType type, const char *msg)
 {
-    static QMutex msgMutex;
-    if (!msgMutex.tryLock())
-        return;
-
     switch (type)
     {
     case QtDebugMsg:
-        Log->logMessage(QString(),Logger::Debug, msg);
+        qti_private_captureQtMessage(Logger::Debug,QString::fromLocal8Bit(msg),0,0,0);
         break;
     case QtWarningMsg:
-        Log->logMessage(QString(),Logger::Warning, msg);
+        qti_private_captureQtMessage(Logger::Warning,QString::fromLocal8Bit(msg),0,0,0);
         break;
     case QtCriticalMsg:
-        Log->logMessage(QString(),Logger::Error, msg);
+        qti_private_captureQtMessage(Logger::Error,QString::fromLocal8Bit(msg),0,0,0);
         break;
     case QtFatalMsg:
-        Log->logMessage(QString(),Logger::Fatal, msg);
-        msgMutex.unlock();
+        qti_private_captureQtMessage(Logger::Fatal,QString::fromLocal8Bit(msg),0,0,0);
         abort();
     }
-
-    msgMutex.unlock();
 }
 #else
 void Qtilities::Logging::installLoggerMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-    static QMutex msgMutex;
-    if (!msgMutex.tryLock())
-        return;
-
-    QString detailed_msg = QString("%1 (%2:%3. %4)").arg(msg).arg(context.file).arg(context.line).arg(context.function);
     switch (type)
     {
     case QtDebugMsg:
-        Log->logMessage(QString(),Logger::Debug, detailed_msg);
+        qti_private_captureQtMessage(Logger::Debug,msg,context.file,context.line,context.function);
+        break;
+    #if QT_VERSION >= 0x050500
+    case QtInfoMsg:
+        qti_private_captureQtMessage(Logger::Info,msg,context.file,context.line,context.function);
         break;
+    #endif
     case QtWarningMsg:
-        Log->logMessage(QString(),Logger::Warning, detailed_msg);
+        qti_private_captureQtMessage(Logger::Warning,msg,context.file,context.line,context.function);
         break;
     case QtCriticalMsg:
-        Log->logMessage(QString(),Logger::Error, detailed_msg);
+        qti_private_captureQtMessage(Logger::Error,msg,context.file,context.line,context.function);
         break;
     case QtFatalMsg:
-        Log->logMessage(QString(),Logger::Fatal, detailed_msg);
-        msgMutex.unlock();
+        qti_private_captureQtMessage(Logger::Fatal,msg,context.file,context.line,context.function);
         abort();
     }
-
-    msgMutex.unlock();
 }
 #endif
 
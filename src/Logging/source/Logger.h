@@ -23,6 +23,9 @@ namespace Qtilities {
     namespace Logging {
         class AbstractFormattingEngine;
         class AbstractLoggerEngine;
+        class LoggerDispatcher;
+        class SessionLogStore;
+        struct LoggerRecord;
 
         /*!
         \struct LoggerPrivateData
@@ -35,10 +38,77 @@ namespace Qtilities {
         \brief The Logger class provides thread safe logging functionality to any Qt application.
 
         See the \ref page_logging article for more information on how to use the logger.
+
+        \section Logger_message_gating Disabled message types
+
+        The logger maintains an atomic mask of the message types which will be accepted by at least one attached logger engine for each
+        message context. The mask is updated whenever the global log level changes (see setGlobalLogLevel()), when engines are attached or detached,
+        and when the activity, enabled message types or message contexts of an attached engine changes. All logging macros, for example LOG_INFO, check this mask using
+        isMessageLogged() before evaluating their message expressions, thus messages which will be dropped cost only a single atomic load.
+
+        Message types can also be removed at compile time by defining QTILITIES_LOGGING_COMPILED_MESSAGE_TYPES to a mask of Logger::MessageType values. For example,
+        to remove info messages from a build:
+\code
+DEFINES += "QTILITIES_LOGGING_COMPILED_MESSAGE_TYPES=0x1C"
+\endcode
+
+        \note Messages logged through the macros which are rejected by the mask are not emitted through the newMessage() signal.
+
+        \section Logger_throttling Throttling
+
+        A misbehaving component, for example a process flooding its output, can log the same message thousands of times per second. The logger
+        provides an optional throttling stage to protect logger engines in this case:
+        - When setMessageCoalescingEnabled() is enabled, identical consecutive messages are dropped and a single "Last message repeated N times" summary is logged
+          when a different message arrives, or every messageCoalescingInterval() while the flood continues.
+        - setMessageRateLimit() enables a token bucket rate limit for a message type. Messages exceeding the limit are dropped, and the number of dropped messages
+          is logged with the next message of that type which is allowed through.
+
+        Dropped messages are not emitted through the newMessage() signal. The number of dropped messages is available through coalescedMessageCount()
+        and rateLimitedMessageCount(), and is shown in Qtilities::CoreGui::LoggerConfigWidget. Throttling is disabled by default, in which case it adds
+        no overhead to logging.
+
+        \section Logger_asynchronous_dispatch Asynchronous dispatching
+
+        By default messages are delivered to logger engines in the thread in which they are logged. Applications which log heavily from many threads
+        can enable asynchronous dispatching using setAsynchronousDispatchEnabled(). Every logging thread then gets its own single producer, single consumer
+        ring buffer of LoggerRecord objects, thus logging a message only copies it into the buffer of the calling thread without taking any lock. A single
+        dispatcher thread takes the records from all buffers, orders them by their timestamps and delivers them to the engines in batches through
+        AbstractLoggerEngine::logMessages(). Each record carries the ID of the thread which logged it and a monotonic timestamp.
+
+        When the buffer of a thread is full, the thread waits for the dispatcher. Priority messages and fatal messages are delivered after all messages
+        which were logged before them, before the logging function returns. Use flushMessages() to wait until all logged messages were delivered.
+
+        \section Logger_session_log_store Session log store
+
+        setSessionLogStoreEnabled() creates a SessionLogStore which receives every message logged through the logger, including engine specific and
+        priority messages, and keeps the most recent messages in an indexed in-memory store. The store can be queried by message type, time range,
+        engine, task and text using SessionLogStore::query(), which is used by the session log mode to filter the session log. Messages logged while
+        a task ID is set for the logging thread using setCurrentTaskId() are stored with that ID, Qtilities::Core::Task does this for all messages
+        logged through it.
+
+        \section Logger_log_tags Log tags
+
+        Trace and debug messages can be tagged with the module which logs them, using the tagged logging macros, for example:
+\code
+LOG_TAG_TRACE(Logger::TreeModelLogTag,"Rebuilding tree for observer: " + observer->observerName());
+\endcode
+
+        Tags are filtered at two levels:
+        - At compile time, tagged macros of which the tag is not part of QTILITIES_LOGGING_COMPILED_TAGS evaluate to a constant false condition, thus the compiler removes them completely.
+        - At run time, setEnabledLogTags() selects the tags which are logged. A tagged macro of a tag which is not enabled costs a single atomic load.
+
+        Tagged messages are logged as system wide messages prefixed with the name of their tag, and are subject to the global log level and the message
+        types accepted by the attached engines like all other messages. Unlike LOG_TRACE and LOG_DEBUG, the tagged macros are part of release mode builds,
+        thus the tracing of a single module, for example the tree models, can be enabled in a release build without enabling any other trace messages:
+\code
+Log->setGlobalLogLevel(Logger::Trace);
+Log->setEnabledLogTags(Logger::TreeModelLogTag);
+\endcode
           */
         class LOGGING_SHARED_EXPORT Logger : public QObject
         {
             Q_OBJECT
+            friend class LoggerDispatcher;
 
         public:
             static Logger* instance();
@@ -108,6 +178,29 @@ namespace Qtilities {
             Q_FLAGS(MessageTypeFlags)
             Q_ENUMS(MessageType)
 
+            //! The tags of the modules which log tagged trace and debug messages.
+            /*!
+              See \ref Logger_log_tags for more information. Applications can use their own tags from FirstUserLogTag up to, and including, 1 << 30.
+
+              <i>This enum was added in %Qtilities v1.5.</i>
+              */
+            enum LogTag {
+                NoLogTags               = 0,        /*!< No tags. */
+                CoreLogTag              = 1 << 0,   /*!< Messages of the Core module which are not covered by a more specific tag. */
+                ObserverLogTag          = 1 << 1,   /*!< Messages of observers, subject filters and the observer relational table. */
+                TaskLogTag              = 1 << 2,   /*!< Messages of tasks and the task manager. */
+                CoreGuiLogTag           = 1 << 3,   /*!< Messages of the CoreGui module which are not covered by a more specific tag. */
+                TreeModelLogTag         = 1 << 4,   /*!< Messages of the observer tree and table models and their builders. */
+                ExtensionSystemLogTag   = 1 << 5,   /*!< Messages of the extension system. */
+                ProjectManagementLogTag = 1 << 6,   /*!< Messages of the project management module. */
+                LoggingLogTag           = 1 << 7,   /*!< Messages of the logging module. */
+                FirstUserLogTag         = 1 << 16,  /*!< The first tag which can be used by applications. */
+                AllLogTags              = 0x7FFFFFFF /*!< Represents all tags. */
+            };
+            Q_DECLARE_FLAGS(LogTags, LogTag)
+            Q_FLAGS(LogTags)
+            Q_ENUMS(LogTag)
+
         private:
             Logger(QObject* parent = 0);
 
@@ -232,16 +325,156 @@ namespace Qtilities {
             Logger::MessageContextFlags stringToMessageContexts(const QString& message_contexts_string) const;
             //! Function which returns all available message contexts in a QStringList.
             QStringList allMessageContextStrings() const;
+            //! Returns true if at least one attached logger engine will log a message of the given type in the given context.
+            /*!
+              This function is used by all logging macros in order to avoid evaluating messages that will be dropped. It only does an atomic load of
+              a mask which is kept up to date by the logger, see \ref Logger_message_gating for more information.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static inline bool isMessageLogged(Logger::MessageType message_type, Logger::MessageContext message_context) {
+                #if QT_VERSION >= 0x050000
+                int mask = m_enabled_message_mask.load();
+                #else
+                int mask = m_enabled_message_mask;
+                #endif
+                if (message_context == EngineSpecificMessages)
+                    mask >>= 8;
+                else if (message_context == PriorityMessages)
+                    mask >>= 16;
+                return (mask & message_type);
+            }
+            //! Returns true if a tagged message with the given tag and type will be logged.
+            /*!
+              This function is used by the tagged logging macros, for example LOG_TAG_TRACE. A single atomic load rejects messages of which
+              the tag is not enabled, see setEnabledLogTags(). Messages of enabled tags are then checked against the types accepted by
+              the attached engines, like isMessageLogged() does for system wide messages. Unlike untagged messages, tagged trace and debug
+              messages are also logged in release mode builds.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            static inline bool isTagLogged(Logger::LogTag tag, Logger::MessageType message_type) {
+                #if QT_VERSION >= 0x050000
+                if (!(m_enabled_tag_mask.load() & tag))
+                    return false;
+                int mask = m_enabled_message_mask.load();
+                #else
+                if (!(m_enabled_tag_mask & tag))
+                    return false;
+                int mask = m_enabled_message_mask;
+                #endif
+                return ((mask >> 24) & message_type);
+            }
+            //! Sets the tags of which tagged messages are logged.
+            /*!
+              See \ref Logger_log_tags for more information. By default all tags are enabled in debug builds and no tags are enabled in release builds.
+              The enabled tags are saved with the other logger settings.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setEnabledLogTags(LogTags tags);
+            //! Returns the tags of which tagged messages are logged.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            LogTags enabledLogTags() const;
+            //! Returns the name of a tag, which is used as the prefix of messages logged with the tag.
+            /*!
+              User tags are named "Tag N", where N is the number of the bit of the tag.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString logTagToString(LogTag tag) const;
+            //! Logs a tagged message. Use the tagged logging macros, for example LOG_TAG_TRACE, instead of calling this function directly.
+            /*!
+              The message is logged as a system wide message prefixed with the name of the tag, see logTagToString(). Unlike logMessage(), debug and trace
+              messages are also logged in release mode builds.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void logTaggedMessage(LogTag tag, MessageType message_type, const QVariant& message);
+            //! Recalculates the mask used by isMessageLogged() and the routing tables used to deliver messages.
+            /*!
+              This is called automatically whenever something that affects the mask changes. See \ref Logger_message_gating for more information.
+
+              The routing tables contain the active engines accepting each message type for system wide and priority messages, and all
+              engines by name for engine specific messages. Thus broadcast messages are not checked against every attached engine, and
+              engine specific messages, for example messages logged to the custom logger engines of tasks, are only offered to the named engine.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void updateEnabledMessageMask();
 
             // -----------------------------------------
-            // Functions related to updating of QSettings
+            // Functions related to throttling
             // -----------------------------------------
-            //! Stores the logging parameters using QSettings.
+            //! Enables or disables the coalescing of identical consecutive messages.
+            /*!
+              See \ref Logger_throttling for more information. Disabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setMessageCoalescingEnabled(bool is_enabled);
+            //! Indicates if identical consecutive messages are coalesced.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool messageCoalescingEnabled() const;
+            //! Sets the interval in milliseconds after which a "repeated" summary is logged for a coalesced message.
+            /*!
+              The default is 1000 milliseconds.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setMessageCoalescingInterval(int msecs);
+            //! Returns the interval in milliseconds after which a "repeated" summary is logged for a coalesced message.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int messageCoalescingInterval() const;
+            //! Limits the rate at which messages of the given type are logged.
+            /*!
+              \param message_type The message type to limit. Use AllLogLevels to set the limit of all message types.
+              \param messages_per_second The number of messages per second allowed on average. When 0, the rate is not limited.
+              \param burst_size The number of messages which can be logged in a burst. When 0, \p messages_per_second is used.
+
+              See \ref Logger_throttling for more information.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setMessageRateLimit(Logger::MessageType message_type, int messages_per_second, int burst_size = 0);
+            //! Returns the rate limit in messages per second for the given message type, 0 when the rate is not limited.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int messageRateLimit(Logger::MessageType message_type) const;
+            //! Returns the number of messages which were coalesced since the last call to resetThrottlingCounters().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int coalescedMessageCount() const;
+            //! Returns the number of messages of the given type dropped by the rate limit since the last call to resetThrottlingCounters().
+            /*!
+              \param message_type The message type, or AllLogLevels to get the total for all message types.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int rateLimitedMessageCount(Logger::MessageType message_type = AllLogLevels) const;
+            //! Resets the counters returned by coalescedMessageCount() and rateLimitedMessageCount().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void resetThrottlingCounters();
+
+            // -----------------------------------------
+            // Functions related to updating of settings
+            // -----------------------------------------
+            //! Stores the logging parameters in the settings store of the session path (see SettingsStore).
             /*!
               For more information see \ref configuration_widget_storage_layout and loggerSettingsEnabled()
               */
             void writeSettings() const;
-            //! Reads the current logging paramaters stored in QSettings.
+            //! Reads the current logging paramaters from the settings store of the session path (see SettingsStore).
             /*!
               For more information see \ref configuration_widget_storage_layout.
               */
@@ -263,6 +496,12 @@ namespace Qtilities {
             // Functions related to Qt Debugging output
             // -----------------------------------------
             //! Installs the logger as the Qt Message Handler.
+            /*!
+              Messages from any thread are captured without locking and are logged by the logger in the order in which they were captured. Messages
+              from the thread of the logger are logged immediately, messages from other threads when the event loop of the logger's thread runs, or
+              when the handler is uninstalled. Messages which will not be logged because of the current log level are dropped before they are captured.
+              Qt messages produced while the logger delivers a message to its engines on the same thread are written to stderr instead of being logged.
+              */
             void installAsQtMessageHandler(bool update_stored_settings = true);
             //! Uninstalls the logger as the Qt Message Handler.
             void uninstallAsQtMessageHandler();
@@ -394,8 +633,91 @@ namespace Qtilities {
               */
             bool loggerSettingsEnabled() const;
 
+            // -----------------------------------------
+            // Functions related to asynchronous dispatching
+            // -----------------------------------------
+            //! Enables or disables the asynchronous dispatching of messages to logger engines.
+            /*!
+              See \ref Logger_asynchronous_dispatch for more information. Disabled by default. When disabled, all messages which were logged are delivered
+              before this function returns. The logger disables asynchronous dispatching during finalize().
+
+              \param is_enabled When true, the dispatcher thread is started.
+              \param thread_buffer_capacity The number of records which can be buffered for each logging thread before it waits for the dispatcher.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setAsynchronousDispatchEnabled(bool is_enabled, int thread_buffer_capacity = 1024);
+            //! Indicates if messages are dispatched to logger engines asynchronously.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool asynchronousDispatchEnabled() const;
+
+            // -----------------------------------------
+            // Functions related to the session log store
+            // -----------------------------------------
+            //! Enables or disables the session log store.
+            /*!
+              See \ref Logger_session_log_store for more information. Disabled by default. Enabling the store while it is enabled does nothing, thus
+              the capacity can only be changed by disabling the store first. Disabling the store deletes it with all messages in it.
+
+              \param is_enabled When true, a store keeping the newest \p capacity messages is created.
+              \param capacity The maximum number of messages kept by the store.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setSessionLogStoreEnabled(bool is_enabled, int capacity = 1000000);
+            //! Indicates if the session log store is enabled.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool sessionLogStoreEnabled() const;
+            //! Returns the session log store, null when it is not enabled.
+            /*!
+              The store is valid until setSessionLogStoreEnabled(false) is called.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            SessionLogStore* sessionLogStore() const;
+            //! Sets the ID of the task for which the calling thread logs messages, -1 when it does not log for a task.
+            /*!
+              The ID is stored with every message logged by the thread in the session log store and in LoggerRecord::task_id.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setCurrentTaskId(int task_id);
+            //! Returns the ID of the task for which the calling thread logs messages, -1 when it does not log for a task.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int currentTaskId() const;
+
+        public slots:
+            //! Delivers all messages which were logged from any thread, but which were not delivered to logger engines yet.
+            /*!
+              Only needed when asynchronousDispatchEnabled() is true, otherwise messages are delivered immediately.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void flushMessages();
+            //! Logs the "repeated" summary of the last message when it was coalesced.
+            /*!
+              This is done automatically after messageCoalescingInterval(), and during finalize().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void flushCoalescedMessages();
+
+        private slots:
+            //! Logs the Qt messages which were captured by installLoggerMessageHandler() since the previous call, in the order in which they were captured.
+            void drainQtMessages();
+
         signals:
-            //! Signal which is emitted when a new message was logged. The logger connects all logger engines to this signal.
+            //! Signal which is emitted when a new message was logged.
+            /*!
+              The logger delivers messages to attached logger engines directly, formatting each message only once for all engines using the same
+              formatting engine. Engines are therefore not connected to this signal anymore, it is available for other objects interested in unformatted messages.
+              */
             void newMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& message_contents);
             //! Signal which is emitted when a new priority message was logged.
             /*!
@@ -406,7 +728,18 @@ namespace Qtilities {
             void loggerEngineCountChanged(AbstractLoggerEngine* engine, Logger::EngineChangeIndication change_indication);
 
         private:
+            //! Delivers a message to all attached engines accepting it, formatting it once for every distinct formatting engine used by these engines.
+            void dispatchMessage(const QString& engine_name, MessageType message_type, MessageContextFlags message_context, const QList<QVariant>& message_contents);
+            //! Delivers a message through the dispatcher thread when asynchronousDispatchEnabled() is true, otherwise through dispatchMessage().
+            void deliverMessage(const QString& engine_name, MessageType message_type, MessageContextFlags message_context, const QList<QVariant>& message_contents);
+            //! Delivers a batch of records to all attached engines in batches, formatting each record once for every distinct formatting engine.
+            void dispatchRecords(const QList<LoggerRecord>& records);
+            //! Passes a message through the throttling stage, returns true when the message must be dropped. Summary messages are logged by this function.
+            bool throttleMessage(const QString& engine_name, MessageType message_type, MessageContextFlags message_context, const QList<QVariant>& message_contents);
+
             static Logger* m_Instance;
+            static QAtomicInt m_enabled_message_mask;
+            static QAtomicInt m_enabled_tag_mask;
             LoggerPrivateData* d;
         };
 
@@ -417,10 +750,45 @@ namespace Qtilities {
         #endif
         Q_DECLARE_OPERATORS_FOR_FLAGS(Logger::MessageTypeFlags)
         Q_DECLARE_OPERATORS_FOR_FLAGS(Logger::MessageContextFlags)
+        Q_DECLARE_OPERATORS_FOR_FLAGS(Logger::LogTags)
+
+        /*!
+        \struct LoggerRecord
+        \brief A message logged through the Logger, as delivered to logger engines in batches by AbstractLoggerEngine::logMessages().
+
+        See \ref Logger_asynchronous_dispatch for more information.
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct LoggerRecord {
+            LoggerRecord() : message_type(Logger::None),
+                message_context(Logger::NoMessageContext),
+                thread_id(0),
+                timestamp(0),
+                task_id(-1) {}
+
+            //! The name of the engine to which the message was logged, empty for system wide messages.
+            QString                         engine_name;
+            //! The type of the message.
+            Logger::MessageType             message_type;
+            //! The context of the message.
+            Logger::MessageContextFlags     message_context;
+            //! The unformatted message contents.
+            QList<QVariant>                 message_contents;
+            //! The ID of the thread which logged the message, see QThread::currentThreadId().
+            Qt::HANDLE                      thread_id;
+            //! The monotonic time in nanoseconds at which the message was logged, measured from the construction of the logger.
+            qint64                          timestamp;
+            //! The ID of the task for which the message was logged, see Logger::setCurrentTaskId(). -1 when it was not logged for a task.
+            int                             task_id;
+            //! The message formatted by the formatting engine of the engine receiving the record. Empty for engines which log unformatted messages.
+            QString                         formatted_message;
+        };
      }
 }
 
 Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
+Q_DECLARE_METATYPE(Qtilities::Logging::LoggerRecord)
 
 // -----------------------------------
 // Macro Definitions
@@ -446,6 +814,30 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     */
 #define LOG_FINALIZE() Log->finalize()
 
+// -----------------------------------
+// Message Gating
+// -----------------------------------
+//! The message types which are compiled into the logging macros.
+/*!
+    Define this to a mask of Qtilities::Logging::Logger::MessageType values in order to remove the logging macros for the other message types at compile time.
+    All message types are compiled by default. See \ref Logger_message_gating for more information.
+  */
+#ifndef QTILITIES_LOGGING_COMPILED_MESSAGE_TYPES
+#define QTILITIES_LOGGING_COMPILED_MESSAGE_TYPES 0x7E
+#endif
+//! Evaluates to true when a message of the given type and context will be logged by at least one engine. Used by all logging macros.
+#define LOG_IS_LOGGED(Type, Context) ((QTILITIES_LOGGING_COMPILED_MESSAGE_TYPES & (Type)) && Qtilities::Logging::Logger::isMessageLogged(Type,Context))
+//! The log tags which are compiled into the tagged logging macros.
+/*!
+    Define this to a mask of Qtilities::Logging::Logger::LogTag values in order to remove the tagged logging macros of the other tags at compile time.
+    All tags are compiled by default. See \ref Logger_log_tags for more information.
+  */
+#ifndef QTILITIES_LOGGING_COMPILED_TAGS
+#define QTILITIES_LOGGING_COMPILED_TAGS 0x7FFFFFFF
+#endif
+//! Evaluates to true when a tagged message with the given tag and type will be logged. Used by all tagged logging macros.
+#define LOG_TAG_IS_LOGGED(Tag, Type) ((QTILITIES_LOGGING_COMPILED_TAGS & (Tag)) && (QTILITIES_LOGGING_COMPILED_MESSAGE_TYPES & (Type)) && Qtilities::Logging::Logger::isTagLogged(Tag,Type))
+
 // -----------------------------------
 // Basic Logging Macros
 // -----------------------------------
@@ -454,7 +846,7 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Trace messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_TRACE(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Trace, Msg)
+#define LOG_TRACE(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Trace,Qtilities::Logging::Logger::SystemWideMessages) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Trace, Msg) : (void)0)
 #else
 #define LOG_TRACE(Msg) ((void)0)
 #endif
@@ -463,18 +855,18 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Debug messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_DEBUG(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Debug, Msg)
+#define LOG_DEBUG(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Debug,Qtilities::Logging::Logger::SystemWideMessages) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Debug, Msg) : (void)0)
 #else
 #define LOG_DEBUG(Msg) ((void)0)
 #endif
 //! Logs an error message to all active engines.
-#define LOG_ERROR(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Error, Msg)
+#define LOG_ERROR(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Error,Qtilities::Logging::Logger::SystemWideMessages) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Error, Msg) : (void)0)
 //! Logs a warning message to all active engines.
-#define LOG_WARNING(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Warning, Msg)
+#define LOG_WARNING(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Warning,Qtilities::Logging::Logger::SystemWideMessages) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Warning, Msg) : (void)0)
 //! Logs a fatal message to all active engines.
-#define LOG_FATAL(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg)
+#define LOG_FATAL(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Fatal,Qtilities::Logging::Logger::SystemWideMessages) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg) : (void)0)
 //! Logs an information message to all active engines.
-#define LOG_INFO(Msg) Log->logMessage(QString(),Qtilities::Logging::Logger::Info, Msg)
+#define LOG_INFO(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Info,Qtilities::Logging::Logger::SystemWideMessages) ? Log->logMessage(QString(),Qtilities::Logging::Logger::Info, Msg) : (void)0)
 
 // -----------------------------------
 // Priority Logging Macros
@@ -484,7 +876,7 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Trace messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_TRACE_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Trace, Msg)
+#define LOG_TRACE_P(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Trace,Qtilities::Logging::Logger::PriorityMessages) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Trace, Msg) : (void)0)
 #else
 #define LOG_TRACE_P(Msg) ((void)0)
 #endif
@@ -493,50 +885,55 @@ Q_DECLARE_METATYPE(Qtilities::Logging::Logger::MessageType)
     \note Debug messages are not part of release mode builds.
   */
 #ifndef QT_NO_DEBUG
-#define LOG_DEBUG_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Debug, Msg)
+#define LOG_DEBUG_P(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Debug,Qtilities::Logging::Logger::PriorityMessages) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Debug, Msg) : (void)0)
 #else
 #define LOG_DEBUG_P(Msg) ((void)0)
 #endif
 //! Logs a priority error message to all active engines.
-#define LOG_ERROR_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Error, Msg)
+#define LOG_ERROR_P(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Error,Qtilities::Logging::Logger::PriorityMessages) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Error, Msg) : (void)0)
 //! Logs a priority warning message to all active engines.
-#define LOG_WARNING_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Warning, Msg)
+#define LOG_WARNING_P(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Warning,Qtilities::Logging::Logger::PriorityMessages) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Warning, Msg) : (void)0)
 //! Logs a priority fatal message to all active engines.
-#define LOG_FATAL_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg)
+#define LOG_FATAL_P(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Fatal,Qtilities::Logging::Logger::PriorityMessages) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Fatal, Msg) : (void)0)
 //! Logs a priority information message to all active engines.
-#define LOG_INFO_P(Msg) Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Info, Msg)
+#define LOG_INFO_P(Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Info,Qtilities::Logging::Logger::PriorityMessages) ? Log->logPriorityMessage(QString(),Qtilities::Logging::Logger::Info, Msg) : (void)0)
 
 // -----------------------------------
 // Engine Specific Logging
 // -----------------------------------
 //! Logs a trace message to the engine specified. Note that the engine must be active for the message to be logger.
 #ifndef QT_NO_DEBUG
-#define LOG_TRACE_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Trace, Msg)
+#define LOG_TRACE_E(Engine_Name, Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Trace,Qtilities::Logging::Logger::EngineSpecificMessages) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Trace, Msg) : (void)0)
 #else
 #define LOG_TRACE_E(Engine_Name, Msg) ((void)0)
 #endif
 //! Logs a debug message to the engine specified. Note that the engine must be active for the message to be logger.
 #ifndef QT_NO_DEBUG//!
-#define LOG_DEBUG_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Debug, Msg)
+#define LOG_DEBUG_E(Engine_Name, Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Debug,Qtilities::Logging::Logger::EngineSpecificMessages) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Debug, Msg) : (void)0)
 #else
 #define LOG_DEBUG_E(Engine_Name, Msg) ((void)0)
 #endif
 //! Logs an error message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_ERROR_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Error, Msg)
+#define LOG_ERROR_E(Engine_Name, Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Error,Qtilities::Logging::Logger::EngineSpecificMessages) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Error, Msg) : (void)0)
 //! Logs a warning message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_WARNING_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Warning, Msg)
+#define LOG_WARNING_E(Engine_Name, Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Warning,Qtilities::Logging::Logger::EngineSpecificMessages) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Warning, Msg) : (void)0)
 //! Logs a fatal message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_FATAL_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Fatal, Msg)
+#define LOG_FATAL_E(Engine_Name, Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Fatal,Qtilities::Logging::Logger::EngineSpecificMessages) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Fatal, Msg) : (void)0)
 //! Logs an info message to the engine specified. Note that the engine must be active for the message to be logger.
-#define LOG_INFO_E(Engine_Name, Msg) Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Info, Msg)
+#define LOG_INFO_E(Engine_Name, Msg) (LOG_IS_LOGGED(Qtilities::Logging::Logger::Info,Qtilities::Logging::Logger::EngineSpecificMessages) ? Log->logMessage(Engine_Name,Qtilities::Logging::Logger::Info, Msg) : (void)0)
 
 // -----------------------------------
-// Function Specific Logging
+// Tagged Logging Macros
 // -----------------------------------
-/*#define FUNC_DEBUG(Function_Name, Msg) Log->funcMessage(Engine_Name,Qtilities::Logging::Logger::Debug, Msg)
-#define FUNC_ERROR(Function_Name, Msg) Log->funcMessage(Engine_Name,Qtilities::Logging::Logger::Error, Msg)
-#define FUNC_WARNING(Function_Name, Msg) Log->funcgMessage(Engine_Name,Qtilities::Logging::Logger::Warning, Msg)
-#define FUNC_FATAL(Function_Name, Msg) Log->funcMessage(Engine_Name,Qtilities::Logging::Logger::Fatal, Msg)
-#define FUNC_INFO(Function_Name, Msg) Log->funcMessage(Engine_Name,Qtilities::Logging::Logger::Info, Msg)*/
+//! Logs a trace message tagged with a Qtilities::Logging::Logger::LogTag to all active engines.
+/*!
+    \note Unlike LOG_TRACE, tagged trace messages are part of release mode builds. See \ref Logger_log_tags for more information.
+  */
+#define LOG_TAG_TRACE(Tag, Msg) (LOG_TAG_IS_LOGGED(Tag,Qtilities::Logging::Logger::Trace) ? Log->logTaggedMessage(Tag,Qtilities::Logging::Logger::Trace, Msg) : (void)0)
+//! Logs a debug message tagged with a Qtilities::Logging::Logger::LogTag to all active engines.
+/*!
+    \note Unlike LOG_DEBUG, tagged debug messages are part of release mode builds. See \ref Logger_log_tags for more information.
+  */
+#define LOG_TAG_DEBUG(Tag, Msg) (LOG_TAG_IS_LOGGED(Tag,Qtilities::Logging::Logger::Debug) ? Log->logTaggedMessage(Tag,Qtilities::Logging::Logger::Debug, Msg) : (void)0)
 
 #endif // LOGGER_H
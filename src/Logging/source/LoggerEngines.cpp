@@ -15,27 +15,489 @@
 #include <QFile>
 #include <QTextStream>
 #include <QList>
+#include <QMap>
 #include <QString>
+#include <QStringList>
 #include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+#include <QVector>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QRegExp>
+#include <QTimer>
+#include <QElapsedTimer>
 
 #include <stdio.h>
+#include <stdlib.h>
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 using namespace Qtilities::Logging;
 using namespace Qtilities::Logging::Constants;
 using namespace Qtilities::Logging::Interfaces;
 
+namespace {
+    // Rotated segments are compressed in chunks of this size, thus archiving large log files does not need much memory:
+    const int qti_private_gzip_chunk_size = 4 * 1024 * 1024;
+
+    // The same CRC-32 table which is used by the Zipper in QtilitiesCore, which cannot be used here since QtilitiesCore depends on this module.
+    struct qti_private_GzipCrc32Table {
+        qti_private_GzipCrc32Table() {
+            for (quint32 i = 0; i < 256; ++i) {
+                quint32 c = i;
+                for (int k = 0; k < 8; ++k)
+                    c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+                values[i] = c;
+            }
+        }
+
+        quint32 values[256];
+    };
+
+    Q_GLOBAL_STATIC(qti_private_GzipCrc32Table,qti_private_gzipCrc32Table)
+
+    quint32 qti_private_gzipCrc32(const QByteArray& data) {
+        const quint32* table = qti_private_gzipCrc32Table()->values;
+        quint32 crc = 0xFFFFFFFF;
+        const uchar* bytes = (const uchar*) data.constData();
+        for (int i = 0; i < data.size(); ++i)
+            crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        return crc ^ 0xFFFFFFFF;
+    }
+
+    void qti_private_appendLittleEndian(QByteArray* bytes, quint32 value) {
+        for (int i = 0; i < 4; ++i)
+            bytes->append((char) ((value >> (8 * i)) & 0xFF));
+    }
+
+    // Returns a complete gzip member (RFC 1952) containing data.
+    QByteArray qti_private_gzipMember(const QByteArray& data) {
+        // qCompress() writes the uncompressed size followed by a zlib stream. Without the size, the 2 byte zlib header and the adler32
+        // checksum at the end, the zlib stream is the raw deflate stream:
+        QByteArray deflated = qCompress(data);
+        if (deflated.size() >= 10)
+            deflated = deflated.mid(6,deflated.size() - 10);
+        else
+            deflated.clear();
+        // qCompress() does not produce a stream for empty data, use a final block which is only an end of block code:
+        if (deflated.isEmpty())
+            deflated = QByteArray("\x03\x00",2);
+
+        // Header: magic, deflate method, no flags, no modification time, no extra flags, unknown operating system:
+        static const char header[10] = { 0x1f, (char) 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, (char) 0xff };
+        QByteArray member;
+        member.reserve(deflated.size() + 18);
+        member.append(header,10);
+        member.append(deflated);
+        qti_private_appendLittleEndian(&member,qti_private_gzipCrc32(data));
+        qti_private_appendLittleEndian(&member,(quint32) data.size());
+        return member;
+    }
+
+    // Compresses source_file into the gzip file target_file. Every chunk of the source is written as its own gzip member, which gzip tools
+    // read as a single stream.
+    bool qti_private_gzipFile(const QString& source_file, const QString& target_file) {
+        QFile source(source_file);
+        if (!source.open(QIODevice::ReadOnly))
+            return false;
+        QFile target(target_file);
+        if (!target.open(QIODevice::WriteOnly))
+            return false;
+
+        bool success = true;
+        do {
+            const QByteArray chunk = source.read(qti_private_gzip_chunk_size);
+            const QByteArray member = qti_private_gzipMember(chunk);
+            if (source.error() != QFile::NoError || target.write(member) != member.size()) {
+                success = false;
+                break;
+            }
+        } while (!source.atEnd());
+
+        target.close();
+        if (!success || target.error() != QFile::NoError) {
+            target.remove();
+            return false;
+        }
+        return true;
+    }
+
+    // Returns the name to which a rotated segment of file_name, which was started at segment_start, is renamed until it is archived.
+    QString qti_private_pendingFileName(const QString& file_name, const QDateTime& segment_start) {
+        qint64 msecs = segment_start.toMSecsSinceEpoch();
+        QString pending_file = QString("%1.%2.pending").arg(file_name).arg(msecs);
+        while (QFile::exists(pending_file))
+            pending_file = QString("%1.%2.pending").arg(file_name).arg(++msecs);
+        return pending_file;
+    }
+
+    // Returns the start time of the segment in a file named by qti_private_pendingFileName().
+    QDateTime qti_private_pendingSegmentStart(const QString& pending_file) {
+        const QStringList parts = QFileInfo(pending_file).fileName().split('.');
+        bool ok = false;
+        const qint64 msecs = parts.count() >= 2 ? parts.at(parts.count() - 2).toLongLong(&ok) : 0;
+        if (!ok)
+            return QFileInfo(pending_file).lastModified();
+        return QDateTime::fromMSecsSinceEpoch(msecs);
+    }
+}
+
 // ------------------------------------
 // FileLoggerEngine implementation
 // ------------------------------------
 namespace Qtilities {
     namespace Logging {
         LoggerFactoryItem<AbstractLoggerEngine, FileLoggerEngine> FileLoggerEngine::factory;
+
+        // Writer thread used by FileLoggerEngine when asynchronous logging is enabled.
+        class FileLoggerEngineWriter : public QThread
+        {
+        public:
+            FileLoggerEngineWriter(FileLoggerEnginePrivateData* data) : QThread(), d(data) {}
+
+        protected:
+            void run();
+
+        private:
+            FileLoggerEnginePrivateData* d;
+        };
+
+        // Archiving thread used by FileLoggerEngine to name, compress and prune rotated segments in the order in which they were rotated.
+        class FileLoggerEngineArchiver : public QThread
+        {
+        public:
+            FileLoggerEngineArchiver(const QString& file_name, FileLoggerEngine::ArchiveNaming naming, bool compress, int retention_count) : QThread(),
+                file_name(file_name),
+                naming(naming),
+                compress(compress),
+                retention_count(retention_count),
+                stop_requested(false) {}
+
+            //! Queues a rotated segment, which was renamed using qti_private_pendingFileName(), to be archived.
+            void enqueue(const QString& pending_file);
+            //! Archives all queued segments, after which the thread finishes.
+            void stop();
+
+        protected:
+            void run();
+
+        private:
+            void archive(const QString& pending_file);
+            void shiftNumberedArchives();
+            void pruneDatedArchives();
+
+            const QString                           file_name;
+            const FileLoggerEngine::ArchiveNaming   naming;
+            const bool                              compress;
+            const int                               retention_count;
+
+            // Members below are protected by mutex:
+            QMutex                                  mutex;
+            QWaitCondition                          jobs_available;
+            QStringList                             jobs;
+            bool                                    stop_requested;
+        };
+    }
+}
+
+struct Qtilities::Logging::FileLoggerEnginePrivateData {
+    FileLoggerEnginePrivateData() : async_enabled(false),
+        flush_interval(1000),
+        flush_on_error(true),
+        buffer_capacity(4096),
+        ring_head(0),
+        ring_count(0),
+        stop_requested(false),
+        flush_requested(false),
+        writing(false),
+        rotation_size(0),
+        rotation_interval(FileLoggerEngine::NoRotationInterval),
+        archive_naming(FileLoggerEngine::NumberedArchives),
+        archive_compression(true),
+        archive_retention(10),
+        rotation_requested(false),
+        formatting_engine(0),
+        segment_size(0),
+        next_rotation_msecs(-1),
+        writer(0),
+        archiver(0) {}
+
+    //! Pushes a message into the ring buffer. The mutex must be locked.
+    inline void push(const QString& message) {
+        ring[(ring_head + ring_count) % ring.size()] = message;
+        ++ring_count;
+    }
+    //! The number of queued messages at which the writer thread is woken up before the flush interval expires.
+    inline int watermark() const {
+        return qMax(1,ring.size() / 2);
+    }
+    //! Takes all messages from the ring buffer. The mutex must be locked.
+    QStringList takeAll() {
+        QStringList batch;
+        batch.reserve(ring_count);
+        while (ring_count > 0) {
+            batch << ring.at(ring_head);
+            ring[ring_head] = QString();
+            ring_head = (ring_head + 1) % ring.size();
+            --ring_count;
+        }
+        ring_head = 0;
+        return batch;
+    }
+
+    //! Indicates if the active segment must be rotated before more messages are written to it.
+    inline bool rotationDue() const {
+        if (rotation_size > 0 && segment_size >= rotation_size)
+            return true;
+        return next_rotation_msecs >= 0 && QDateTime::currentMSecsSinceEpoch() >= next_rotation_msecs;
+    }
+    //! Starts a new segment at \p start, the time of the next interval based rotation is aligned to clock boundaries.
+    void startSegment(const QDateTime& start) {
+        segment_start = start;
+        QDateTime next_rotation;
+        if (rotation_interval == FileLoggerEngine::HourlyRotation)
+            next_rotation = QDateTime(start.date(),QTime(start.time().hour(),0)).addSecs(3600);
+        else if (rotation_interval == FileLoggerEngine::DailyRotation)
+            next_rotation = QDateTime(start.date().addDays(1),QTime(0,0));
+        else if (rotation_interval == FileLoggerEngine::WeeklyRotation)
+            next_rotation = QDateTime(start.date().addDays(8 - start.date().dayOfWeek()),QTime(0,0));
+        next_rotation_msecs = next_rotation.isValid() ? next_rotation.toMSecsSinceEpoch() : -1;
+    }
+    //! Returns the archiver, which is created the first time a segment is archived.
+    FileLoggerEngineArchiver* segmentArchiver() {
+        if (!archiver) {
+            archiver = new FileLoggerEngineArchiver(file_name,archive_naming,archive_compression,archive_retention);
+            archiver->start();
+        }
+        return archiver;
+    }
+    //! Finishes the active segment, hands it to the archiver and starts a new segment.
+    /*!
+      In asynchronous mode this is only called by the writer thread, otherwise it is called with the engine mutex locked.
+      */
+    void rotateSegment() {
+        const bool async_file = file.isOpen();
+        if (async_file)
+            file.close();
+
+        QFile segment(file_name);
+        if (segment.open(QIODevice::Append | QIODevice::Text)) {
+            QTextStream out(&segment);
+            if (formatting_engine)
+                out << formatting_engine->finalizeString();
+            out << "\n";
+            out.flush();
+            segment.close();
+        }
+
+        // Only the rename is done here, everything else is done by the archiver:
+        const QString pending_file = qti_private_pendingFileName(file_name,segment_start);
+        const bool renamed = QFile::rename(file_name,pending_file);
+        if (renamed)
+            segmentArchiver()->enqueue(pending_file);
+        else
+            qWarning() << "Failed to rotate file logger engine, the log file will keep growing:" << file_name;
+
+        QFile new_segment(file_name);
+        if (new_segment.open((renamed ? QIODevice::WriteOnly : QIODevice::Append) | QIODevice::Text)) {
+            QTextStream out(&new_segment);
+            if (formatting_engine)
+                out << formatting_engine->initializeString();
+            out << "\n";
+            out.flush();
+            segment_size = new_segment.size();
+            new_segment.close();
+        }
+        startSegment(QDateTime::currentDateTime());
+
+        if (async_file)
+            file.open(QIODevice::Append | QIODevice::Text);
+    }
+
+    QString                 file_name;
+    bool                    async_enabled;
+    int                     flush_interval;
+    bool                    flush_on_error;
+    int                     buffer_capacity;
+
+    // Members below are protected by mutex:
+    QMutex                  mutex;
+    QWaitCondition          buffer_not_empty;
+    QWaitCondition          buffer_not_full;
+    QWaitCondition          buffer_drained;
+    QVector<QString>        ring;
+    int                     ring_head;
+    int                     ring_count;
+    bool                    stop_requested;
+    bool                    flush_requested;
+    //! Indicates that the writer thread is busy writing a batch to file outside of the mutex.
+    bool                    writing;
+
+    qint64                  rotation_size;
+    FileLoggerEngine::RotationInterval rotation_interval;
+    FileLoggerEngine::ArchiveNaming archive_naming;
+    bool                    archive_compression;
+    int                     archive_retention;
+    //! Set by FileLoggerEngine::rotate() in asynchronous mode, protected by mutex.
+    bool                    rotation_requested;
+
+    // Members below are only accessed by the writer thread while it is running, otherwise they are protected by the engine mutex:
+    AbstractFormattingEngine* formatting_engine;
+    QFile                   file;
+    qint64                  segment_size;
+    QDateTime               segment_start;
+    qint64                  next_rotation_msecs;
+
+    FileLoggerEngineWriter* writer;
+    FileLoggerEngineArchiver* archiver;
+};
+
+void Qtilities::Logging::FileLoggerEngineWriter::run() {
+    QMutexLocker locker(&d->mutex);
+    forever {
+        // Wake up when the buffer is half full, when a flush is requested, or when the flush interval expires:
+        if (d->ring_count < d->watermark() && !d->stop_requested && !d->flush_requested && !d->rotation_requested)
+            d->buffer_not_empty.wait(&d->mutex,d->flush_interval);
+
+        QStringList batch = d->takeAll();
+        bool stop = d->stop_requested;
+        bool rotate = d->rotation_requested;
+        d->flush_requested = false;
+        d->rotation_requested = false;
+        d->writing = true;
+        d->buffer_not_full.wakeAll();
+        locker.unlock();
+
+        if (rotate || (!batch.isEmpty() && d->rotationDue()))
+            d->rotateSegment();
+
+        if (!batch.isEmpty()) {
+            QTextStream out(&d->file);
+            for (int i = 0; i < batch.count(); ++i)
+                out << batch.at(i) << "\n";
+            out.flush();
+            d->file.flush();
+            d->segment_size = d->file.size();
+        }
+
+        locker.relock();
+        d->writing = false;
+        d->buffer_drained.wakeAll();
+        if (stop && d->ring_count == 0)
+            break;
+    }
+}
+
+void Qtilities::Logging::FileLoggerEngineArchiver::enqueue(const QString& pending_file) {
+    QMutexLocker locker(&mutex);
+    jobs << pending_file;
+    jobs_available.wakeOne();
+}
+
+void Qtilities::Logging::FileLoggerEngineArchiver::stop() {
+    mutex.lock();
+    stop_requested = true;
+    jobs_available.wakeOne();
+    mutex.unlock();
+    wait();
+}
+
+void Qtilities::Logging::FileLoggerEngineArchiver::run() {
+    QMutexLocker locker(&mutex);
+    forever {
+        while (jobs.isEmpty() && !stop_requested)
+            jobs_available.wait(&mutex);
+        if (jobs.isEmpty())
+            break;
+
+        const QString pending_file = jobs.takeFirst();
+        locker.unlock();
+        archive(pending_file);
+        locker.relock();
+    }
+}
+
+void Qtilities::Logging::FileLoggerEngineArchiver::archive(const QString& pending_file) {
+    QString archive_name;
+    if (naming == FileLoggerEngine::NumberedArchives) {
+        shiftNumberedArchives();
+        archive_name = file_name + ".1";
+    } else {
+        const QString base_name = file_name + "." + qti_private_pendingSegmentStart(pending_file).toString("yyyyMMdd-hhmmss");
+        archive_name = base_name;
+        int duplicate = 0;
+        while (QFile::exists(archive_name) || QFile::exists(archive_name + ".gz"))
+            archive_name = QString("%1-%2").arg(base_name).arg(++duplicate);
+    }
+
+    // Segments which can't be compressed are kept uncompressed:
+    if (compress && qti_private_gzipFile(pending_file,archive_name + ".gz"))
+        QFile::remove(pending_file);
+    else if (!QFile::rename(pending_file,archive_name))
+        qWarning() << "Failed to archive rotated log file:" << pending_file;
+
+    if (naming == FileLoggerEngine::DatedArchives)
+        pruneDatedArchives();
+}
+
+void Qtilities::Logging::FileLoggerEngineArchiver::shiftNumberedArchives() {
+    // Without a retention count, all existing archives are shifted:
+    int last = retention_count;
+    if (last <= 0) {
+        last = 0;
+        while (QFile::exists(QString("%1.%2").arg(file_name).arg(last + 1)) || QFile::exists(QString("%1.%2.gz").arg(file_name).arg(last + 1)))
+            ++last;
+    } else {
+        QFile::remove(QString("%1.%2").arg(file_name).arg(last));
+        QFile::remove(QString("%1.%2.gz").arg(file_name).arg(last));
+        --last;
+    }
+
+    for (int i = last; i >= 1; --i) {
+        const QString current = QString("%1.%2").arg(file_name).arg(i);
+        const QString next = QString("%1.%2").arg(file_name).arg(i + 1);
+        if (QFile::exists(current))
+            QFile::rename(current,next);
+        if (QFile::exists(current + ".gz"))
+            QFile::rename(current + ".gz",next + ".gz");
+    }
+}
+
+void Qtilities::Logging::FileLoggerEngineArchiver::pruneDatedArchives() {
+    if (retention_count <= 0)
+        return;
+
+    const QFileInfo fi(file_name);
+    QDir dir(fi.absolutePath());
+    QRegExp archive_pattern(QRegExp::escape(fi.fileName()) + "\\.\\d{8}-\\d{6}(-\\d+)?(\\.gz)?");
+    // Sorting on the names without the .gz suffix orders the archives from oldest to newest:
+    QMap<QString,QString> archives;
+    foreach (const QString& entry, dir.entryList(QStringList() << fi.fileName() + ".*",QDir::Files)) {
+        if (!archive_pattern.exactMatch(entry))
+            continue;
+        QString key = entry;
+        if (key.endsWith(".gz"))
+            key.chop(3);
+        archives.insertMulti(key,entry);
+    }
+
+    QMapIterator<QString,QString> itr(archives);
+    int excess_count = archives.count() - retention_count;
+    while (itr.hasNext() && excess_count > 0) {
+        itr.next();
+        dir.remove(itr.value());
+        --excess_count;
     }
 }
 
 Qtilities::Logging::FileLoggerEngine::FileLoggerEngine() : AbstractLoggerEngine()
 {
-    file_name = QString();
+    d = new FileLoggerEnginePrivateData;
     abstractLoggerEngineData->formatting_engine = 0;
     setName("File Logger Engine");
 }
@@ -43,17 +505,18 @@ Qtilities::Logging::FileLoggerEngine::FileLoggerEngine() : AbstractLoggerEngine(
 Qtilities::Logging::FileLoggerEngine::~FileLoggerEngine()
 {
     finalize();
+    delete d;
 }
 
 bool Qtilities::Logging::FileLoggerEngine::initialize() {
-    if (file_name.isEmpty()) {
+    if (d->file_name.isEmpty()) {
         LOG_ERROR(QString("Failed to initialize file logger engine (%1): File name is empty...").arg(objectName()));
         return false;
     }
 
     if (!abstractLoggerEngineData->formatting_engine) {
         // Attempt to get the formatting engine with the specified file format.
-        QFileInfo fi(file_name);
+        QFileInfo fi(d->file_name);
         QString extension = fi.fileName().split(".").last();
         AbstractFormattingEngine* formatting_engine_inst = Log->formattingEngineReferenceFromExtension(extension);
         if (!formatting_engine_inst) {
@@ -65,21 +528,57 @@ bool Qtilities::Logging::FileLoggerEngine::initialize() {
         }
     }
 
-    QFileInfo fi(file_name);
+    QFileInfo fi(d->file_name);
     QDir dir(fi.path());
     if (!dir.exists()) {
         dir.mkpath(fi.path());
     }
 
-    QFile file(file_name);
+    d->formatting_engine = abstractLoggerEngineData->formatting_engine;
+    if (rotationEnabled()) {
+        // Archive segments which were rotated but not archived when the previous session ended, followed by the log file of the
+        // previous session, which is archived instead of being overwritten:
+        QStringList pending_files = dir.entryList(QStringList() << fi.fileName() + ".*.pending",QDir::Files,QDir::Name);
+        foreach (const QString& pending_file, pending_files)
+            d->segmentArchiver()->enqueue(dir.filePath(pending_file));
+
+        QFileInfo previous_log(d->file_name);
+        if (previous_log.exists() && previous_log.size() > 0) {
+            const QString pending_file = qti_private_pendingFileName(d->file_name,previous_log.lastModified());
+            if (QFile::rename(d->file_name,pending_file))
+                d->segmentArchiver()->enqueue(pending_file);
+        }
+    }
+
+    QFile file(d->file_name);
     if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        LOG_ERROR(QString("Failed to initialize file logger engine (%1): Can't open the specified file (%2) for writing...").arg(objectName()).arg(file_name));
+        LOG_ERROR(QString("Failed to initialize file logger engine (%1): Can't open the specified file (%2) for writing...").arg(objectName()).arg(d->file_name));
         return false;
     }
 
     QTextStream out(&file);
     out << abstractLoggerEngineData->formatting_engine->initializeString() << "\n";
+    out.flush();
+    d->segment_size = file.size();
     file.close();
+    d->startSegment(QDateTime::currentDateTime());
+    d->rotation_requested = false;
+
+    if (d->async_enabled && !d->writer) {
+        d->file.setFileName(d->file_name);
+        if (!d->file.open(QIODevice::Append | QIODevice::Text)) {
+            LOG_ERROR(QString("Failed to initialize file logger engine (%1): Can't open the specified file (%2) for asynchronous writing...").arg(objectName()).arg(d->file_name));
+            return false;
+        }
+
+        d->ring.fill(QString(),qMax(1,d->buffer_capacity));
+        d->ring_head = 0;
+        d->ring_count = 0;
+        d->stop_requested = false;
+        d->flush_requested = false;
+        d->writer = new FileLoggerEngineWriter(d);
+        d->writer->start();
+    }
 
     abstractLoggerEngineData->is_initialized = true;
     return true;
@@ -87,18 +586,35 @@ bool Qtilities::Logging::FileLoggerEngine::initialize() {
 
 void Qtilities::Logging::FileLoggerEngine::finalize() {
     if (abstractLoggerEngineData->is_initialized) {
-        QFile file(file_name);
-        if (!file.exists())
-            return;
+        if (d->writer) {
+            // Guaranteed drain of all buffered messages:
+            d->mutex.lock();
+            d->stop_requested = true;
+            d->buffer_not_empty.wakeAll();
+            d->mutex.unlock();
+            d->writer->wait();
+            delete d->writer;
+            d->writer = 0;
+            d->file.close();
+        }
+        abstractLoggerEngineData->is_initialized = false;
 
-        if (!file.open(QIODevice::Append | QIODevice::Text))
-            return;
+        QFile file(d->file_name);
+        if (file.exists() && file.open(QIODevice::Append | QIODevice::Text)) {
+            QTextStream out(&file);
+            if (abstractLoggerEngineData->formatting_engine)
+                out << abstractLoggerEngineData->formatting_engine->finalizeString();
+            out << "\n";
+            out.flush();
+            file.close();
+        }
 
-        QTextStream out(&file);
-        if (abstractLoggerEngineData->formatting_engine)
-            out << abstractLoggerEngineData->formatting_engine->finalizeString();
-        out << "\n";
-        file.close();
+        // Wait until all rotated segments are archived:
+        if (d->archiver) {
+            d->archiver->stop();
+            delete d->archiver;
+            d->archiver = 0;
+        }
     }
 }
 
@@ -109,7 +625,7 @@ QString Qtilities::Logging::FileLoggerEngine::description() const {
 QString Qtilities::Logging::FileLoggerEngine::status() const {
     if (abstractLoggerEngineData->is_initialized) {
         if (abstractLoggerEngineData->is_enabled)
-            return QString("Logging in progress to output file: %1").arg(file_name);
+            return QString("Logging in progress to output file: %1").arg(d->file_name);
         else
             return "Ready but inactive.";
     } else
@@ -117,29 +633,133 @@ QString Qtilities::Logging::FileLoggerEngine::status() const {
 }
 
 void Qtilities::Logging::FileLoggerEngine::clearLog() {
-    QFile file(file_name);
+    if (d->writer) {
+        // Discard buffered messages and truncate the file while the writer is idle:
+        QMutexLocker locker(&d->mutex);
+        while (d->writing)
+            d->buffer_drained.wait(&d->mutex);
+        d->takeAll();
+        d->buffer_not_full.wakeAll();
+        if (!d->file.resize(0))
+            qWarning() << "Failed to clear file logger engine:" << d->file_name;
+        d->segment_size = d->file.size();
+        return;
+    }
+
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    QFile file(d->file_name);
     if (!file.open(QIODevice::WriteOnly)) {
-        qWarning() << "Failed to clear file logger engine:" << file_name;
+        qWarning() << "Failed to clear file logger engine:" << d->file_name;
         return;
     }
     file.close();
+    d->segment_size = 0;
 }
 
 void Qtilities::Logging::FileLoggerEngine::logMessage(const QString& message, Logger::MessageType message_type) {
-    Q_UNUSED(message_type)
-
     if (!abstractLoggerEngineData->is_initialized)
         return;
 
-    QFile file(file_name);
+    if (d->writer) {
+        QMutexLocker locker(&d->mutex);
+        while (d->ring_count == d->ring.size()) {
+            d->buffer_not_empty.wakeOne();
+            d->buffer_not_full.wait(&d->mutex);
+        }
+        d->push(message);
+
+        if (d->flush_on_error && (message_type == Logger::Error || message_type == Logger::Fatal)) {
+            d->flush_requested = true;
+            d->buffer_not_empty.wakeOne();
+            while (d->ring_count > 0 || d->writing)
+                d->buffer_drained.wait(&d->mutex);
+        } else if (d->ring_count >= d->watermark())
+            d->buffer_not_empty.wakeOne();
+        return;
+    }
+
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    if (d->rotationDue())
+        d->rotateSegment();
+
+    QFile file(d->file_name);
     if (!file.open(QIODevice::Append | QIODevice::Text))
         return;
 
     QTextStream out(&file);
     out << message << "\n";
+    out.flush();
+    d->segment_size = file.size();
     file.close();
 }
 
+void Qtilities::Logging::FileLoggerEngine::logMessages(const QList<LoggerRecord>& records) {
+    if (!abstractLoggerEngineData->is_initialized || records.isEmpty())
+        return;
+
+    if (d->writer) {
+        QMutexLocker locker(&d->mutex);
+        bool flush = false;
+        for (int i = 0; i < records.count(); ++i) {
+            while (d->ring_count == d->ring.size()) {
+                d->buffer_not_empty.wakeOne();
+                d->buffer_not_full.wait(&d->mutex);
+            }
+            d->push(records.at(i).formatted_message);
+            flush |= (records.at(i).message_type == Logger::Error || records.at(i).message_type == Logger::Fatal);
+        }
+
+        if (d->flush_on_error && flush) {
+            d->flush_requested = true;
+            d->buffer_not_empty.wakeOne();
+            while (d->ring_count > 0 || d->writing)
+                d->buffer_drained.wait(&d->mutex);
+        } else if (d->ring_count >= d->watermark())
+            d->buffer_not_empty.wakeOne();
+        return;
+    }
+
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    if (d->rotationDue())
+        d->rotateSegment();
+
+    QFile file(d->file_name);
+    if (!file.open(QIODevice::Append | QIODevice::Text))
+        return;
+
+    QTextStream out(&file);
+    for (int i = 0; i < records.count(); ++i)
+        out << records.at(i).formatted_message << "\n";
+    out.flush();
+    d->segment_size = file.size();
+    file.close();
+}
+
+void Qtilities::Logging::FileLoggerEngine::rotate() {
+    if (!abstractLoggerEngineData->is_initialized)
+        return;
+
+    if (d->writer) {
+        QMutexLocker locker(&d->mutex);
+        d->rotation_requested = true;
+        d->buffer_not_empty.wakeOne();
+        return;
+    }
+
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    d->rotateSegment();
+}
+
+void Qtilities::Logging::FileLoggerEngine::flush() {
+    if (!d->writer)
+        return;
+
+    QMutexLocker locker(&d->mutex);
+    d->flush_requested = true;
+    d->buffer_not_empty.wakeOne();
+    while (d->ring_count > 0 || d->writing)
+        d->buffer_drained.wait(&d->mutex);
+}
 
 Qtilities::Logging::Interfaces::ILoggerExportable::ExportModeFlags Qtilities::Logging::FileLoggerEngine::supportedFormats() const {
     ILoggerExportable::ExportModeFlags flags = 0;
@@ -148,22 +768,107 @@ Qtilities::Logging::Interfaces::ILoggerExportable::ExportModeFlags Qtilities::Lo
 }
 
 bool Qtilities::Logging::FileLoggerEngine::exportBinary(QDataStream& stream) const {
-    stream << file_name;
+    stream << d->file_name;
     return true;
 }
 
 bool Qtilities::Logging::FileLoggerEngine::importBinary(QDataStream& stream) {
-    stream >> file_name;
+    stream >> d->file_name;
     return true;
 }
 
 void Qtilities::Logging::FileLoggerEngine::setFileName(const QString& fileName) {
     if (!abstractLoggerEngineData->is_initialized)
-        file_name = fileName;
+        d->file_name = fileName;
 }
 
 QString Qtilities::Logging::FileLoggerEngine::getFileName() {
-    return file_name;
+    return d->file_name;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setAsynchronousLoggingEnabled(bool is_enabled) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->async_enabled = is_enabled;
+}
+
+bool Qtilities::Logging::FileLoggerEngine::asynchronousLoggingEnabled() const {
+    return d->async_enabled;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setFlushInterval(int msec) {
+    QMutexLocker locker(&d->mutex);
+    d->flush_interval = qMax(1,msec);
+}
+
+int Qtilities::Logging::FileLoggerEngine::flushInterval() const {
+    return d->flush_interval;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setFlushOnErrorEnabled(bool is_enabled) {
+    QMutexLocker locker(&d->mutex);
+    d->flush_on_error = is_enabled;
+}
+
+bool Qtilities::Logging::FileLoggerEngine::flushOnErrorEnabled() const {
+    return d->flush_on_error;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setBufferCapacity(int capacity) {
+    if (!abstractLoggerEngineData->is_initialized && capacity > 0)
+        d->buffer_capacity = capacity;
+}
+
+int Qtilities::Logging::FileLoggerEngine::bufferCapacity() const {
+    return d->buffer_capacity;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setRotationSize(qint64 bytes) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->rotation_size = qMax(qint64(0),bytes);
+}
+
+qint64 Qtilities::Logging::FileLoggerEngine::rotationSize() const {
+    return d->rotation_size;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setRotationInterval(RotationInterval interval) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->rotation_interval = interval;
+}
+
+Qtilities::Logging::FileLoggerEngine::RotationInterval Qtilities::Logging::FileLoggerEngine::rotationInterval() const {
+    return d->rotation_interval;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setArchiveNaming(ArchiveNaming naming) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->archive_naming = naming;
+}
+
+Qtilities::Logging::FileLoggerEngine::ArchiveNaming Qtilities::Logging::FileLoggerEngine::archiveNaming() const {
+    return d->archive_naming;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setArchiveCompressionEnabled(bool is_enabled) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->archive_compression = is_enabled;
+}
+
+bool Qtilities::Logging::FileLoggerEngine::archiveCompressionEnabled() const {
+    return d->archive_compression;
+}
+
+void Qtilities::Logging::FileLoggerEngine::setArchiveRetentionCount(int count) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->archive_retention = qMax(0,count);
+}
+
+int Qtilities::Logging::FileLoggerEngine::archiveRetentionCount() const {
+    return d->archive_retention;
+}
+
+bool Qtilities::Logging::FileLoggerEngine::rotationEnabled() const {
+    return d->rotation_size > 0 || d->rotation_interval != NoRotationInterval;
 }
 
 // ------------------------------------
@@ -227,6 +932,39 @@ void Qtilities::Logging::QtMsgLoggerEngine::logMessage(const QString& message, L
 // ConsoleLoggerEngine implementation
 // ------------------------------------
 
+namespace {
+    // Makes sure that buffered console messages are not lost when the application exits without finalizing the logger:
+    void qti_private_flushConsoleLoggerEngine() {
+        Qtilities::Logging::ConsoleLoggerEngine::instance()->flush();
+    }
+
+    bool qti_private_isConsole(FILE* stream) {
+        #ifdef Q_OS_WIN
+        return _isatty(_fileno(stream)) != 0;
+        #else
+        return isatty(fileno(stream)) != 0;
+        #endif
+    }
+}
+
+struct Qtilities::Logging::ConsoleLoggerEnginePrivateData {
+    ConsoleLoggerEnginePrivateData() : buffered_line_count(1),
+        buffered_lines(0),
+        flush_timer(0) {}
+
+    //! The escape codes written before and after messages of each type, encoded once when the formatting changes.
+    QMap<Logger::MessageType,QByteArray> prefixes;
+    QMap<Logger::MessageType,QByteArray> suffixes;
+
+    QMutex          buffer_mutex;
+    QByteArray      buffer;
+    int             buffered_line_count;
+    int             buffered_lines;
+    //! Measures the age of the oldest buffered message.
+    QElapsedTimer   buffer_age;
+    QTimer*         flush_timer;
+};
+
 Qtilities::Logging::ConsoleLoggerEngine* Qtilities::Logging::ConsoleLoggerEngine::m_Instance = 0;
 
 Qtilities::Logging::ConsoleLoggerEngine* Qtilities::Logging::ConsoleLoggerEngine::instance()
@@ -246,16 +984,32 @@ Qtilities::Logging::ConsoleLoggerEngine* Qtilities::Logging::ConsoleLoggerEngine
 }
 
 Qtilities::Logging::ConsoleLoggerEngine::ConsoleLoggerEngine() : AbstractLoggerEngine() {
+    d = new ConsoleLoggerEnginePrivateData;
     setName("Console Logger Engine");
-    color_formatting_enabled = true;
+
+    // Escape codes and buffering only make sense when a user watches the output:
+    bool is_console = qti_private_isConsole(stdout);
+    color_formatting_enabled = is_console;
+    if (!is_console)
+        d->buffered_line_count = 64;
 
     message_colors[Logger::Warning] = QString(CONSOLE_BLUE);
     message_colors[Logger::Error] = QString(CONSOLE_RED);
     message_colors[Logger::Fatal] = QString(CONSOLE_RED);
+    updateMessageFormatting();
+
+    d->flush_timer = new QTimer(this);
+    d->flush_timer->setSingleShot(true);
+    d->flush_timer->setInterval(100);
+    connect(d->flush_timer,SIGNAL(timeout()),SLOT(flush()));
+
+    atexit(qti_private_flushConsoleLoggerEngine);
 }
 
 void ConsoleLoggerEngine::setConsoleFormattingEnabled(bool is_enabled) {
+    QMutexLocker locker(&d->buffer_mutex);
     color_formatting_enabled = is_enabled;
+    updateMessageFormatting();
 }
 
 bool ConsoleLoggerEngine::consoleFormattingEnabled() const {
@@ -263,11 +1017,73 @@ bool ConsoleLoggerEngine::consoleFormattingEnabled() const {
 }
 
 void ConsoleLoggerEngine::setConsoleFormattingHint(Logger::MessageType message_type, QString hint_color) {
+    QMutexLocker locker(&d->buffer_mutex);
     message_colors[message_type] = hint_color;
+    updateMessageFormatting();
 }
 
-Qtilities::Logging::ConsoleLoggerEngine::~ConsoleLoggerEngine() {
+void ConsoleLoggerEngine::setBufferedLineCount(int count) {
+    QMutexLocker locker(&d->buffer_mutex);
+    d->buffered_line_count = qMax(1,count);
+    if (d->buffered_lines >= d->buffered_line_count)
+        writeBuffer();
+}
+
+int ConsoleLoggerEngine::bufferedLineCount() const {
+    return d->buffered_line_count;
+}
+
+void ConsoleLoggerEngine::setFlushInterval(int msec) {
+    QMutexLocker locker(&d->buffer_mutex);
+    d->flush_timer->setInterval(qMax(1,msec));
+}
 
+int ConsoleLoggerEngine::flushInterval() const {
+    return d->flush_timer->interval();
+}
+
+void ConsoleLoggerEngine::flush() {
+    QMutexLocker locker(&d->buffer_mutex);
+    writeBuffer();
+}
+
+void ConsoleLoggerEngine::updateMessageFormatting() {
+    d->prefixes.clear();
+    d->suffixes.clear();
+
+#ifndef Q_OS_WIN
+    if (!color_formatting_enabled)
+        return;
+
+    // For more info see: http://en.wikipedia.org/wiki/ANSI_escape_code
+    if (message_colors.contains(Logger::Info)) {
+        d->prefixes[Logger::Info] = message_colors[Logger::Info].toLatin1();
+        d->suffixes[Logger::Info] = QByteArray(CONSOLE_RESET);
+    } else
+        d->prefixes[Logger::Info] = QByteArray(CONSOLE_RESET);
+
+    QList<Logger::MessageType> colored_types;
+    colored_types << Logger::Warning << Logger::Error << Logger::Fatal;
+    for (int i = 0; i < colored_types.count(); ++i) {
+        d->prefixes[colored_types.at(i)] = message_colors.value(colored_types.at(i)).toLatin1();
+        d->suffixes[colored_types.at(i)] = QByteArray(CONSOLE_RESET);
+    }
+#endif
+}
+
+void ConsoleLoggerEngine::writeBuffer() {
+    if (d->buffer.isEmpty())
+        return;
+
+    fwrite(d->buffer.constData(),1,d->buffer.size(),stdout);
+    fflush(stdout);
+    d->buffer.clear();
+    d->buffered_lines = 0;
+}
+
+Qtilities::Logging::ConsoleLoggerEngine::~ConsoleLoggerEngine() {
+    flush();
+    delete d;
 }
 
 bool Qtilities::Logging::ConsoleLoggerEngine::initialize() {
@@ -295,33 +1111,41 @@ QString Qtilities::Logging::ConsoleLoggerEngine::status() const {
 
 void ConsoleLoggerEngine::resetConsoleEscapeCodes() {
     #ifndef Q_OS_WIN
-    fprintf(stdout, CONSOLE_RESET);
+    QMutexLocker locker(&d->buffer_mutex);
+    writeBuffer();
+    fputs(CONSOLE_RESET, stdout);
+    fflush(stdout);
     #endif
 }
 
 void Qtilities::Logging::ConsoleLoggerEngine::logMessage(const QString& message, Logger::MessageType message_type) {
-#ifdef Q_OS_WIN
-    if (message_type == Logger::Error || message_type == Logger::Fatal)
-        fprintf(stderr, "%s\n", qPrintable(message));
-    else
-        fprintf(stdout, "%s\n", qPrintable(message));
-#else
-    if (color_formatting_enabled) {
-        // For more info see: //http://en.wikipedia.org/wiki/ANSI_escape_code
-        if (message_type == Logger::Info) {
-            if (message_colors.contains(Logger::Info))
-                fprintf(stdout, qPrintable(QString("%1%s\n%2").arg(message_colors[Logger::Info]).arg(CONSOLE_RESET)), qPrintable(message));
-            else
-                fprintf(stdout, qPrintable(QString("%1%s\n").arg(CONSOLE_RESET)), qPrintable(message));
-        } else if (message_type == Logger::Warning) {
-            fprintf(stdout, qPrintable(QString("%1%s\n%2").arg(message_colors[Logger::Warning]).arg(CONSOLE_RESET)), qPrintable(message));
-        } else if (message_type == Logger::Error) {
-            fprintf(stderr, qPrintable(QString("%1%s\n%2").arg(message_colors[Logger::Error]).arg(CONSOLE_RESET)), qPrintable(message));
-        } else if (message_type == Logger::Fatal) {
-            fprintf(stderr, qPrintable(QString("%1%s\n%2").arg(message_colors[Logger::Fatal]).arg(CONSOLE_RESET)), qPrintable(message));
-        } else
-            fprintf(stdout, "%s\n", qPrintable(message));
-    } else
-        fprintf(stdout, "%s\n", qPrintable(message));
-#endif
+    // Encode the message before locking the buffer:
+    const QByteArray text = message.toLocal8Bit();
+
+    QMutexLocker locker(&d->buffer_mutex);
+    const QByteArray prefix = d->prefixes.value(message_type);
+    const QByteArray suffix = d->suffixes.value(message_type);
+
+    if (message_type == Logger::Error || message_type == Logger::Fatal) {
+        // Keep the order of messages on the console and write errors immediately:
+        writeBuffer();
+        QByteArray line;
+        line.reserve(prefix.size() + text.size() + suffix.size() + 1);
+        line.append(prefix).append(text).append('\n').append(suffix);
+        fwrite(line.constData(),1,line.size(),stderr);
+        fflush(stderr);
+        return;
+    }
+
+    bool was_empty = d->buffer.isEmpty();
+    d->buffer.append(prefix).append(text).append('\n').append(suffix);
+    ++d->buffered_lines;
+
+    if (was_empty)
+        d->buffer_age.start();
+
+    if (d->buffered_lines >= d->buffered_line_count || d->buffer_age.elapsed() >= d->flush_timer->interval())
+        writeBuffer();
+    else if (was_empty)
+        QMetaObject::invokeMethod(d->flush_timer,"start",Qt::QueuedConnection);
 }
@@ -47,22 +47,89 @@ namespace Qtilities {
         // ------------------------------------
         // File Logger Engine
         // ------------------------------------
+        /*!
+        \struct FileLoggerEnginePrivateData
+        \brief The FileLoggerEnginePrivateData struct stores private data used by the FileLoggerEngine class.
+          */
+        struct FileLoggerEnginePrivateData;
+
         /*!
         \class FileLoggerEngine
         \brief A logger engine which stores the logged messages in a file.
 
         A logger engine which stores the logged messages in a file.
+
+        \section FileLoggerEngine_asynchronous_logging Asynchronous logging
+
+        By default the engine opens, appends to and closes its log file for every message it receives. This is simple and safe,
+        but it becomes expensive when many messages are logged. When asynchronous logging is enabled through setAsynchronousLoggingEnabled(),
+        the file is kept open and formatted messages are queued into a bounded buffer. A dedicated writer thread drains the buffer in batches,
+        thus logging a message only costs a queue push on the calling thread.
+
+        The writer thread writes everything in the buffer to disk every flushInterval() milliseconds, or earlier when
+        the buffer fills up. When flushOnErrorEnabled() is true, Logger::Error and Logger::Fatal messages are written to disk
+        before logMessage() returns. When the buffer is full, logMessage() blocks until the writer thread made space available. All
+        buffered messages are guaranteed to be written when finalize() is called, or whenever flush() is called.
+
+\code
+FileLoggerEngine* file_engine = qobject_cast<FileLoggerEngine*> (Log->newLoggerEngine(qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE));
+file_engine->setFileName("batch_job.log");
+file_engine->setAsynchronousLoggingEnabled(true);
+file_engine->setFlushInterval(500);
+Log->attachLoggerEngine(file_engine);
+\endcode
+
+        \section FileLoggerEngine_rotation Log rotation
+
+        Long running applications can limit the size of the log file by rotating it. When the log file reaches rotationSize() bytes, or when
+        the rotationInterval() passed, the engine finishes the active file (the log file is its own segment, including the initialization
+        and finalization strings of the formatting engine), moves it aside and starts a new log file. Moving the segment aside is a rename,
+        all other work is done by a background archiving thread: The segment is renamed according to archiveNaming(), compressed into a gzip
+        file when archiveCompressionEnabled() is true, and the oldest archives are deleted when there are more than archiveRetentionCount() archives.
+
+\code
+FileLoggerEngine* file_engine = qobject_cast<FileLoggerEngine*> (Log->newLoggerEngine(qti_def_FACTORY_TAG_FILE_LOGGER_ENGINE));
+file_engine->setFileName("service.log");
+file_engine->setRotationSize(64 * 1024 * 1024);
+file_engine->setRotationInterval(FileLoggerEngine::DailyRotation);
+file_engine->setArchiveNaming(FileLoggerEngine::DatedArchives);
+file_engine->setArchiveRetentionCount(30);
+Log->attachLoggerEngine(file_engine);
+\endcode
+
+        When rotation is enabled, a log file left by a previous session is archived during initialize() instead of being overwritten. The
+        rotation settings are not part of the exported session configuration.
           */
         class LOGGING_SHARED_EXPORT FileLoggerEngine : public AbstractLoggerEngine, public ILoggerExportable
         {
             Q_OBJECT
             Q_INTERFACES(Qtilities::Logging::Interfaces::ILoggerExportable)
+            Q_ENUMS(RotationInterval ArchiveNaming)
             Q_PROPERTY(QString FileName READ getFileName)
 
         public:
             FileLoggerEngine();
             ~FileLoggerEngine();
 
+            //! The intervals at which the log file can be rotated, see \ref FileLoggerEngine_rotation.
+            /*!
+              <i>This enumeration was added in %Qtilities v1.5.</i>
+              */
+            enum RotationInterval {
+                NoRotationInterval, /*!< The log file is not rotated based on time. */
+                HourlyRotation,     /*!< The log file is rotated at the start of every hour. */
+                DailyRotation,      /*!< The log file is rotated at midnight. */
+                WeeklyRotation      /*!< The log file is rotated at midnight between Sunday and Monday. */
+            };
+            //! The naming schemes of rotated log files, see \ref FileLoggerEngine_rotation.
+            /*!
+              <i>This enumeration was added in %Qtilities v1.5.</i>
+              */
+            enum ArchiveNaming {
+                NumberedArchives,   /*!< Archives are named file_name.1, file_name.2 etc., where file_name.1 is the newest archive. */
+                DatedArchives       /*!< Archives are named file_name.yyyyMMdd-hhmmss, using the time at which the archived segment was started. */
+            };
+
             // --------------------------------
             // AbstractLoggerEngine Implementation
             // --------------------------------
@@ -75,6 +142,13 @@ namespace Qtilities {
               Clearing of FileLoggerEngine was introduced in %Qtilities v1.1.
               */
             void clearLog();
+            //! Logs a batch of records, opening the log file only once for the batch.
+            /*!
+              When asynchronousLoggingEnabled() is true, the batch is buffered while the buffer mutex is locked once.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void logMessages(const QList<LoggerRecord>& records);
 
             // --------------------------------
             // ILoggerExportable Implementation
@@ -94,14 +168,151 @@ namespace Qtilities {
             //! Gets the file name to which the logger is currently logging.
             QString getFileName();
 
+            //! Enables or disables asynchronous logging.
+            /*!
+              See \ref FileLoggerEngine_asynchronous_logging for more details. Disabled by default.
+
+              Like setFileName(), this can only be changed while the engine is not initialized.
+
+              \sa asynchronousLoggingEnabled()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setAsynchronousLoggingEnabled(bool is_enabled);
+            //! Indicates if asynchronous logging is enabled.
+            /*!
+              \sa setAsynchronousLoggingEnabled()
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool asynchronousLoggingEnabled() const;
+            //! Sets the interval (in milliseconds) at which the writer thread writes buffered messages to disk.
+            /*!
+              Only used when asynchronousLoggingEnabled() is true. The default is 1000 milliseconds.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFlushInterval(int msec);
+            //! Returns the interval (in milliseconds) at which the writer thread writes buffered messages to disk.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int flushInterval() const;
+            //! Sets if Logger::Error and Logger::Fatal messages must be written to disk before logMessage() returns.
+            /*!
+              Only used when asynchronousLoggingEnabled() is true. Enabled by default.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setFlushOnErrorEnabled(bool is_enabled);
+            //! Returns true if Logger::Error and Logger::Fatal messages are written to disk before logMessage() returns.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool flushOnErrorEnabled() const;
+            //! Sets the maximum number of messages which can be queued before logMessage() blocks.
+            /*!
+              Only used when asynchronousLoggingEnabled() is true. The default is 4096 messages. Like setFileName(),
+              this can only be changed while the engine is not initialized.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setBufferCapacity(int capacity);
+            //! Returns the maximum number of messages which can be queued before logMessage() blocks.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int bufferCapacity() const;
+            //! Blocks until all buffered messages were written to disk.
+            /*!
+              Does nothing when asynchronousLoggingEnabled() is false.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void flush();
+
+            //! Sets the size in bytes at which the log file is rotated, see \ref FileLoggerEngine_rotation.
+            /*!
+              The default is 0, which disables size based rotation. Like setFileName(), this can only be changed while the engine is not initialized.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setRotationSize(qint64 bytes);
+            //! Returns the size in bytes at which the log file is rotated.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            qint64 rotationSize() const;
+            //! Sets the interval at which the log file is rotated, see \ref FileLoggerEngine_rotation.
+            /*!
+              The default is NoRotationInterval. Like setFileName(), this can only be changed while the engine is not initialized.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setRotationInterval(RotationInterval interval);
+            //! Returns the interval at which the log file is rotated.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            RotationInterval rotationInterval() const;
+            //! Sets the naming scheme of rotated log files.
+            /*!
+              The default is NumberedArchives. Like setFileName(), this can only be changed while the engine is not initialized.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setArchiveNaming(ArchiveNaming naming);
+            //! Returns the naming scheme of rotated log files.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            ArchiveNaming archiveNaming() const;
+            //! Sets if rotated log files are compressed into gzip files, which get a .gz suffix.
+            /*!
+              Enabled by default. Like setFileName(), this can only be changed while the engine is not initialized.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setArchiveCompressionEnabled(bool is_enabled);
+            //! Indicates if rotated log files are compressed into gzip files.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool archiveCompressionEnabled() const;
+            //! Sets the maximum number of rotated log files which are kept, the oldest archives are deleted first.
+            /*!
+              The default is 10. When 0, archives are never deleted. Like setFileName(), this can only be changed while the engine is not initialized.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setArchiveRetentionCount(int count);
+            //! Returns the maximum number of rotated log files which are kept.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int archiveRetentionCount() const;
+            //! Indicates if the log file is rotated, thus if rotationSize() or rotationInterval() is set.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool rotationEnabled() const;
+
             // Make this class a factory item
             static LoggerFactoryItem<AbstractLoggerEngine, FileLoggerEngine> factory;
 
         public slots:
             void logMessage(const QString& message, Logger::MessageType message_type);
+            //! Rotates the log file now, regardless of rotationSize() and rotationInterval().
+            /*!
+              Does nothing when the engine is not initialized. When asynchronousLoggingEnabled() is true, the writer thread rotates the log
+              file before it writes the next batch of messages.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void rotate();
 
         private:
-            QString file_name;
+            FileLoggerEnginePrivateData* d;
         };
 
         // ------------------------------------
@@ -146,11 +357,23 @@ namespace Qtilities {
         // ------------------------------------
         // Console Logger Engine
         // ------------------------------------
+        /*!
+        \struct ConsoleLoggerEnginePrivateData
+        \brief The ConsoleLoggerEnginePrivateData struct stores private data used by the ConsoleLoggerEngine class.
+          */
+        struct ConsoleLoggerEnginePrivateData;
+
         /*!
         \class ConsoleLoggerEngine
-        \brief A logger engine which pipes messages to a console using the stdio.h fprintf function.
+        \brief A logger engine which pipes messages to a console using the stdio.h fwrite function.
+
+        A logger engine which pipes messages to a console using the stdio.h fwrite function. Logger::Error and Logger::Fatal messages
+        are written to stderr, all other messages are written to stdout.
 
-        A logger engine which pipes messages to a console using the stdio.h fprintf function.
+        Messages written to stdout can be buffered, see setBufferedLineCount(). Buffered messages are written when bufferedLineCount() messages
+        are buffered, when the oldest buffered message is older than flushInterval() milliseconds, before a Logger::Error or Logger::Fatal message
+        is written, when flush() is called and when the application exits. By default messages are only buffered when stdout is not a console, for
+        example when the output of a command line tool is piped to another process.
 
         \note Clearing the log through clearLog() is not supported by this logger engine.
         \note ConsoleLoggerEngine engines are not removeable.
@@ -171,7 +394,7 @@ namespace Qtilities {
             /*!
              * For more information on these escape codes, including OS support etc, see http://en.wikipedia.org/wiki/ANSI_escape_code.
              *
-             * \note Enabled by default and does not work on Windows.
+             * \note Enabled by default when stdout is a console and does not work on Windows.
              *
              * \sa consoleFormattingEnabled(), setConsoleFormattingHint()
              *
@@ -182,7 +405,7 @@ namespace Qtilities {
             /*!
              * For more information on these escape codes, including OS support etc, see http://en.wikipedia.org/wiki/ANSI_escape_code.
              *
-             * \note Enabled by default and does not work on Windows.
+             * \note Enabled by default when stdout is a console and does not work on Windows.
              *
              * \sa setConsoleFormattingEnabled(), setConsoleFormattingHint(), resetConsoleEscapeCodes()
              *
@@ -221,6 +444,40 @@ namespace Qtilities {
              */
             void resetConsoleEscapeCodes();
 
+            //! Sets the number of messages which are buffered before they are written to stdout.
+            /*!
+             * When 1, messages are written as soon as they are logged. The default is 1 when stdout is a console and 64 otherwise.
+             *
+             * \sa bufferedLineCount(), setFlushInterval(), flush()
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setBufferedLineCount(int count);
+            //! Returns the number of messages which are buffered before they are written to stdout.
+            /*!
+             * \sa setBufferedLineCount()
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            int bufferedLineCount() const;
+            //! Sets the maximum time (in milliseconds) for which messages are buffered. The default is 100 milliseconds.
+            /*!
+             * Buffered messages are written by a timer in the thread of the engine when no further messages are logged, thus the interval
+             * is only honored while that thread runs an event loop.
+             *
+             * \sa flushInterval(), setBufferedLineCount()
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void setFlushInterval(int msec);
+            //! Returns the maximum time (in milliseconds) for which messages are buffered.
+            /*!
+             * \sa setFlushInterval()
+             *
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            int flushInterval() const;
+
             // AbstractLoggerEngine implementation
             bool initialize();
             void finalize();
@@ -231,11 +488,22 @@ namespace Qtilities {
 
         public slots:
             void logMessage(const QString& message, Logger::MessageType message_type);
+            //! Writes all buffered messages to stdout.
+            /*!
+             * <i>This function was added in %Qtilities v1.5.</i>
+             */
+            void flush();
 
         private:
+            //! Rebuilds the escape code prefixes and suffixes of all message types.
+            void updateMessageFormatting();
+            //! Writes all buffered messages to stdout. The buffer mutex must be locked.
+            void writeBuffer();
+
             static ConsoleLoggerEngine* m_Instance;
             bool color_formatting_enabled;
             QMap<Logger::MessageType,QString> message_colors;
+            ConsoleLoggerEnginePrivateData* d;
         };
     }
 }
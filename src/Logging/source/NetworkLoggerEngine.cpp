@@ -0,0 +1,703 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "NetworkLoggerEngine.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QHostInfo>
+#include <QMutex>
+#include <QTcpSocket>
+#include <QThread>
+#include <QUdpSocket>
+#include <QWaitCondition>
+
+using namespace Qtilities::Logging;
+using namespace Qtilities::Logging::Constants;
+using namespace Qtilities::Logging::Interfaces;
+
+namespace {
+    const int qti_network_log_connect_timeout           = 3000;
+    const int qti_network_log_write_timeout             = 3000;
+    const int qti_network_log_gelf_chunk_size           = 8192;
+    const int qti_network_log_gelf_chunk_header_size    = 12;
+    const int qti_network_log_gelf_max_chunks           = 128;
+    // The private enterprise number reserved for documentation (RFC 5612), used as the syslog structured data id:
+    const char* const qti_network_log_syslog_sd_id      = "qtilities@32473";
+
+    void appendJsonString(QByteArray& json, const QString& value) {
+        static const char hex_digits[] = "0123456789abcdef";
+        const QByteArray utf8 = value.toUtf8();
+        json.append('"');
+        for (int i = 0; i < utf8.size(); ++i) {
+            const char c = utf8.at(i);
+            if (c == '"')
+                json.append("\\\"");
+            else if (c == '\\')
+                json.append("\\\\");
+            else if (c == '\n')
+                json.append("\\n");
+            else if (c == '\r')
+                json.append("\\r");
+            else if (c == '\t')
+                json.append("\\t");
+            else if (uchar(c) < 0x20) {
+                json.append("\\u00");
+                json.append(hex_digits[uchar(c) >> 4]);
+                json.append(hex_digits[uchar(c) & 0xF]);
+            } else
+                json.append(c);
+        }
+        json.append('"');
+    }
+
+    // Returns a syslog header field: Printable ASCII without spaces, or "-" when empty.
+    QByteArray syslogHeaderField(const QString& value) {
+        QByteArray field = value.toLatin1();
+        for (int i = 0; i < field.size(); ++i) {
+            if (field.at(i) <= ' ' || uchar(field.at(i)) > 126)
+                field[i] = '_';
+        }
+        if (field.isEmpty())
+            return "-";
+        return field;
+    }
+
+    int syslogSeverity(Logger::MessageType message_type) {
+        switch (message_type) {
+        case Logger::Fatal:     return 2;
+        case Logger::Error:     return 3;
+        case Logger::Warning:   return 4;
+        case Logger::Info:      return 6;
+        default:                return 7;
+        }
+    }
+}
+
+namespace Qtilities {
+    namespace Logging {
+        // The settings of a NetworkLoggerEngine, copied into its worker when the engine is initialized.
+        struct NetworkLoggerEngineSettings {
+            NetworkLoggerEngineSettings() : port(0),
+                protocol(NetworkLoggerEngine::TcpProtocol),
+                record_format(NetworkLoggerEngine::GelfFormat),
+                compression_enabled(true),
+                queue_limit(4 * 1024 * 1024),
+                queue_full_policy(NetworkLoggerEngine::DropNewestRecords),
+                batch_size(64),
+                flush_interval(200),
+                initial_reconnect_delay(500),
+                maximum_reconnect_delay(30000) {}
+
+            QString                                 host;
+            quint16                                 port;
+            NetworkLoggerEngine::Protocol           protocol;
+            NetworkLoggerEngine::RecordFormat       record_format;
+            bool                                    compression_enabled;
+            int                                     queue_limit;
+            NetworkLoggerEngine::QueueFullPolicy    queue_full_policy;
+            int                                     batch_size;
+            int                                     flush_interval;
+            int                                     initial_reconnect_delay;
+            int                                     maximum_reconnect_delay;
+
+            // The fields which are the same in all records, resolved when the engine is initialized:
+            QString                                 host_name;
+            QString                                 application_name;
+            qint64                                  process_id;
+
+            //! Encodes a record according to the record format.
+            QByteArray encodeRecord(qint64 timestamp, const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) const {
+                QString short_message = messages.isEmpty() ? QString() : messages.front().toString();
+                QString full_message;
+                if (messages.count() > 1) {
+                    full_message = short_message;
+                    for (int i = 1; i < messages.count(); ++i) {
+                        full_message.append(QLatin1Char('\n'));
+                        full_message.append(messages.at(i).toString());
+                    }
+                }
+
+                QByteArray record;
+                record.reserve(256 + 2 * (short_message.size() + full_message.size()));
+                if (record_format == NetworkLoggerEngine::GelfFormat) {
+                    record.append("{\"version\":\"1.1\",\"host\":");
+                    appendJsonString(record,host_name);
+                    record.append(",\"short_message\":");
+                    appendJsonString(record,short_message);
+                    if (!full_message.isEmpty()) {
+                        record.append(",\"full_message\":");
+                        appendJsonString(record,full_message);
+                    }
+                    record.append(",\"timestamp\":");
+                    record.append(QByteArray::number(timestamp / 1000));
+                    record.append('.');
+                    record.append(QByteArray::number(timestamp % 1000).rightJustified(3,'0'));
+                    record.append(",\"level\":");
+                    record.append(QByteArray::number(syslogSeverity(message_type)));
+                    record.append(",\"_application\":");
+                    appendJsonString(record,application_name);
+                    record.append(",\"_message_type\":");
+                    appendJsonString(record,Log->logLevelToString(message_type));
+                    record.append(",\"_message_context\":");
+                    record.append(QByteArray::number(int(message_context)));
+                    if (!engine_name.isEmpty()) {
+                        record.append(",\"_logger_engine\":");
+                        appendJsonString(record,engine_name);
+                    }
+                    record.append('}');
+                } else {
+                    // <PRI>VERSION TIMESTAMP HOSTNAME APP-NAME PROCID MSGID STRUCTURED-DATA MSG, using the user-level facility:
+                    record.append('<');
+                    record.append(QByteArray::number(8 + syslogSeverity(message_type)));
+                    record.append(">1 ");
+                    record.append(QDateTime::fromMSecsSinceEpoch(timestamp).toUTC().toString("yyyy-MM-dd'T'hh:mm:ss.zzz'Z'").toLatin1());
+                    record.append(' ');
+                    record.append(syslogHeaderField(host_name));
+                    record.append(' ');
+                    record.append(syslogHeaderField(application_name));
+                    record.append(' ');
+                    record.append(QByteArray::number(process_id));
+                    record.append(' ');
+                    record.append(syslogHeaderField(Log->logLevelToString(message_type)));
+                    record.append(' ');
+                    if (engine_name.isEmpty())
+                        record.append('-');
+                    else {
+                        record.append('[');
+                        record.append(qti_network_log_syslog_sd_id);
+                        record.append(" engine=\"");
+                        const QByteArray utf8 = engine_name.toUtf8();
+                        for (int i = 0; i < utf8.size(); ++i) {
+                            if (utf8.at(i) == '"' || utf8.at(i) == '\\' || utf8.at(i) == ']')
+                                record.append('\\');
+                            record.append(utf8.at(i));
+                        }
+                        record.append("\"]");
+                    }
+                    record.append(' ');
+                    record.append(full_message.isEmpty() ? short_message.toUtf8() : full_message.toUtf8());
+                }
+                return record;
+            }
+        };
+
+        // The background thread which sends the records queued by a NetworkLoggerEngine.
+        class NetworkLoggerEngineWorker : public QThread
+        {
+        public:
+            NetworkLoggerEngineWorker(const NetworkLoggerEngineSettings& settings) : QThread(),
+                settings(settings),
+                queued_bytes(0),
+                sent_count(0),
+                dropped_count(0),
+                unreported_drops(0),
+                stop_requested(false),
+                is_connected(false),
+                gelf_message_counter(0) {}
+
+            //! Queues an encoded record, never blocks on the network.
+            void enqueue(const QByteArray& record) {
+                QMutexLocker locker(&mutex);
+                if (queued_bytes + record.size() > settings.queue_limit) {
+                    if (settings.queue_full_policy == NetworkLoggerEngine::DropOldestRecords) {
+                        while (!queue.isEmpty() && queued_bytes + record.size() > settings.queue_limit) {
+                            queued_bytes -= queue.first().size();
+                            queue.removeFirst();
+                            ++dropped_count;
+                            ++unreported_drops;
+                        }
+                    }
+                    if (queued_bytes + record.size() > settings.queue_limit) {
+                        ++dropped_count;
+                        ++unreported_drops;
+                        return;
+                    }
+                }
+
+                queue << record;
+                queued_bytes += record.size();
+                if (queue.count() >= settings.batch_size)
+                    wake_condition.wakeOne();
+            }
+            //! Stops the worker after one last attempt to send the queued records.
+            void stop() {
+                mutex.lock();
+                stop_requested = true;
+                wake_condition.wakeOne();
+                mutex.unlock();
+                wait();
+            }
+
+            NetworkLoggerEngineSettings settings;
+            mutable QMutex              mutex;
+            QWaitCondition              wake_condition;
+            QList<QByteArray>           queue;
+            int                         queued_bytes;
+            quint64                     sent_count;
+            quint64                     dropped_count;
+            quint64                     unreported_drops;
+            bool                        stop_requested;
+            bool                        is_connected;
+            QString                     last_error;
+
+        protected:
+            void run() {
+                QTcpSocket* tcp_socket = 0;
+                QUdpSocket* udp_socket = 0;
+                QHostAddress address;
+                QList<QByteArray> batch;
+                int reconnect_delay = 0;
+
+                QMutexLocker locker(&mutex);
+                forever {
+                    if (batch.isEmpty()) {
+                        if (!stop_requested && queue.count() < settings.batch_size)
+                            wake_condition.wait(&mutex,settings.flush_interval);
+                        if (queue.isEmpty() && unreported_drops == 0) {
+                            if (stop_requested)
+                                break;
+                            continue;
+                        }
+
+                        batch.swap(queue);
+                        queued_bytes = 0;
+                        if (unreported_drops > 0) {
+                            QList<QVariant> messages;
+                            messages << QString("%1 log records were dropped by the network logger engine because its queue was full.").arg(unreported_drops);
+                            batch.prepend(settings.encodeRecord(QDateTime::currentMSecsSinceEpoch(),QString(),Logger::Warning,Logger::SystemWideMessages,messages));
+                            unreported_drops = 0;
+                        }
+                    }
+                    locker.unlock();
+
+                    // The network is only used while the mutex is unlocked, thus logging threads never wait for it:
+                    QString error_msg;
+                    int failed_count = 0;
+                    bool is_sent;
+                    if (settings.protocol == NetworkLoggerEngine::TcpProtocol)
+                        is_sent = sendTcp(tcp_socket,batch,&error_msg);
+                    else
+                        is_sent = sendUdp(udp_socket,address,batch,&failed_count,&error_msg);
+
+                    locker.relock();
+                    if (is_sent) {
+                        sent_count += batch.count() - failed_count;
+                        dropped_count += failed_count;
+                        batch.clear();
+                        reconnect_delay = 0;
+                        is_connected = true;
+                        last_error.clear();
+                        continue;
+                    }
+
+                    is_connected = false;
+                    last_error = error_msg;
+                    if (stop_requested) {
+                        dropped_count += batch.count() + queue.count();
+                        batch.clear();
+                        queue.clear();
+                        queued_bytes = 0;
+                        break;
+                    }
+
+                    // Back off before reconnecting, the batch is kept and sent again:
+                    reconnect_delay = (reconnect_delay == 0) ? settings.initial_reconnect_delay : qMin(reconnect_delay * 2,settings.maximum_reconnect_delay);
+                    QElapsedTimer backoff_timer;
+                    backoff_timer.start();
+                    while (!stop_requested && backoff_timer.elapsed() < reconnect_delay)
+                        wake_condition.wait(&mutex,reconnect_delay - backoff_timer.elapsed());
+                }
+                locker.unlock();
+
+                delete tcp_socket;
+                delete udp_socket;
+            }
+
+        private:
+            bool sendTcp(QTcpSocket*& socket, const QList<QByteArray>& batch, QString* error_msg) {
+                if (!socket)
+                    socket = new QTcpSocket;
+                if (socket->state() != QAbstractSocket::ConnectedState) {
+                    socket->abort();
+                    socket->connectToHost(settings.host,settings.port);
+                    if (!socket->waitForConnected(qti_network_log_connect_timeout)) {
+                        *error_msg = socket->errorString();
+                        socket->abort();
+                        return false;
+                    }
+                }
+
+                // GELF records are terminated with a null byte, syslog records use octet counting:
+                int data_size = 0;
+                for (int i = 0; i < batch.count(); ++i)
+                    data_size += batch.at(i).size() + 12;
+                QByteArray data;
+                data.reserve(data_size);
+                for (int i = 0; i < batch.count(); ++i) {
+                    if (settings.record_format == NetworkLoggerEngine::GelfFormat) {
+                        data.append(batch.at(i));
+                        data.append('\0');
+                    } else {
+                        data.append(QByteArray::number(batch.at(i).size()));
+                        data.append(' ');
+                        data.append(batch.at(i));
+                    }
+                }
+
+                if (socket->write(data) != data.size()) {
+                    *error_msg = socket->errorString();
+                    socket->abort();
+                    return false;
+                }
+                while (socket->bytesToWrite() > 0) {
+                    if (!socket->waitForBytesWritten(qti_network_log_write_timeout)) {
+                        *error_msg = socket->errorString();
+                        socket->abort();
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            bool sendUdp(QUdpSocket*& socket, QHostAddress& address, const QList<QByteArray>& batch, int* failed_count, QString* error_msg) {
+                if (address.isNull() && !address.setAddress(settings.host)) {
+                    QHostInfo host_info = QHostInfo::fromName(settings.host);
+                    if (host_info.error() != QHostInfo::NoError || host_info.addresses().isEmpty()) {
+                        *error_msg = host_info.errorString();
+                        return false;
+                    }
+                    address = host_info.addresses().first();
+                }
+                if (!socket)
+                    socket = new QUdpSocket;
+
+                // Datagrams are lost individually, the batch is only sent again when no datagram could be sent at all:
+                for (int i = 0; i < batch.count(); ++i) {
+                    if (!sendDatagram(socket,address,batch.at(i)))
+                        ++(*failed_count);
+                }
+                if (*failed_count == batch.count() && batch.count() > 0) {
+                    *error_msg = socket->errorString();
+                    *failed_count = 0;
+                    // Resolve the host again, its address might have changed:
+                    address = QHostAddress();
+                    return false;
+                }
+                return true;
+            }
+
+            bool sendDatagram(QUdpSocket* socket, const QHostAddress& address, const QByteArray& record) {
+                if (settings.record_format != NetworkLoggerEngine::GelfFormat)
+                    return socket->writeDatagram(record,address,settings.port) == record.size();
+
+                // qCompress() prefixes the zlib stream with its uncompressed size, which is not part of GELF datagrams:
+                QByteArray datagram = settings.compression_enabled ? qCompress(record).mid(4) : record;
+                if (datagram.size() <= qti_network_log_gelf_chunk_size)
+                    return socket->writeDatagram(datagram,address,settings.port) == datagram.size();
+
+                const int chunk_payload_size = qti_network_log_gelf_chunk_size - qti_network_log_gelf_chunk_header_size;
+                const int chunk_count = (datagram.size() + chunk_payload_size - 1) / chunk_payload_size;
+                if (chunk_count > qti_network_log_gelf_max_chunks)
+                    return false;
+
+                // Chunks are reassembled by their message id, which must be unique for some seconds:
+                const quint64 message_id = (quint64(QDateTime::currentMSecsSinceEpoch()) << 20) ^ ++gelf_message_counter;
+                QByteArray chunk;
+                chunk.reserve(qti_network_log_gelf_chunk_size);
+                for (int c = 0; c < chunk_count; ++c) {
+                    chunk.clear();
+                    chunk.append(char(0x1e));
+                    chunk.append(char(0x0f));
+                    for (int b = 7; b >= 0; --b)
+                        chunk.append(char((message_id >> (8 * b)) & 0xFF));
+                    chunk.append(char(c));
+                    chunk.append(char(chunk_count));
+                    chunk.append(datagram.constData() + c * chunk_payload_size,qMin(chunk_payload_size,datagram.size() - c * chunk_payload_size));
+                    if (socket->writeDatagram(chunk,address,settings.port) != chunk.size())
+                        return false;
+                }
+                return true;
+            }
+
+            quint64 gelf_message_counter;
+        };
+    }
+}
+
+struct Qtilities::Logging::NetworkLoggerEnginePrivateData {
+    NetworkLoggerEnginePrivateData() : worker(0),
+        sent_count(0),
+        dropped_count(0) {}
+
+    NetworkLoggerEngineSettings     settings;
+    //! The worker sending records, only valid while the engine is initialized.
+    NetworkLoggerEngineWorker*      worker;
+    //! The statistics of the previous worker, available after the engine was finalized.
+    quint64                         sent_count;
+    quint64                         dropped_count;
+};
+
+namespace Qtilities {
+    namespace Logging {
+        LoggerFactoryItem<AbstractLoggerEngine, NetworkLoggerEngine> NetworkLoggerEngine::factory;
+    }
+}
+
+Qtilities::Logging::NetworkLoggerEngine::NetworkLoggerEngine() : AbstractLoggerEngine() {
+    d = new NetworkLoggerEnginePrivateData;
+}
+
+Qtilities::Logging::NetworkLoggerEngine::~NetworkLoggerEngine() {
+    finalize();
+    delete d;
+}
+
+bool Qtilities::Logging::NetworkLoggerEngine::initialize() {
+    if (d->settings.host.isEmpty() || d->settings.port == 0)
+        return false;
+
+    if (abstractLoggerEngineData->is_initialized)
+        return true;
+
+    d->settings.host_name = QHostInfo::localHostName();
+    d->settings.application_name = QCoreApplication::applicationName();
+    d->settings.process_id = QCoreApplication::applicationPid();
+
+    d->sent_count = 0;
+    d->dropped_count = 0;
+    d->worker = new NetworkLoggerEngineWorker(d->settings);
+    d->worker->start();
+
+    abstractLoggerEngineData->is_initialized = true;
+    return true;
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::finalize() {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    if (d->worker) {
+        d->worker->stop();
+        d->sent_count = d->worker->sent_count;
+        d->dropped_count = d->worker->dropped_count;
+        delete d->worker;
+        d->worker = 0;
+    }
+    abstractLoggerEngineData->is_initialized = false;
+}
+
+QString Qtilities::Logging::NetworkLoggerEngine::description() const {
+    return tr("Sends structured log records to a log collector over the network.");
+}
+
+QString Qtilities::Logging::NetworkLoggerEngine::status() const {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    if (!d->worker)
+        return tr("Not initialized, endpoint: %1").arg(endpoint());
+
+    QMutexLocker worker_locker(&d->worker->mutex);
+    if (d->worker->last_error.isEmpty())
+        return tr("Sending records to %1 (%2 sent, %3 dropped)").arg(endpoint()).arg(d->worker->sent_count).arg(d->worker->dropped_count);
+    else
+        return tr("Reconnecting to %1: %2 (%3 bytes queued, %4 dropped)").arg(endpoint()).arg(d->worker->last_error).arg(d->worker->queued_bytes).arg(d->worker->dropped_count);
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::logUnformattedMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages) {
+    if (!d->worker)
+        return;
+
+    d->worker->enqueue(d->settings.encodeRecord(QDateTime::currentMSecsSinceEpoch(),engine_name,message_type,message_context,messages));
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::logMessage(const QString& message, Logger::MessageType message_type) {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    QList<QVariant> messages;
+    messages << message;
+    logUnformattedMessage(QString(),message_type,Logger::SystemWideMessages,messages);
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::setEndpoint(const QString& host, quint16 port) {
+    if (!abstractLoggerEngineData->is_initialized) {
+        d->settings.host = host;
+        d->settings.port = port;
+    }
+}
+
+QString Qtilities::Logging::NetworkLoggerEngine::host() const {
+    return d->settings.host;
+}
+
+quint16 Qtilities::Logging::NetworkLoggerEngine::port() const {
+    return d->settings.port;
+}
+
+QString Qtilities::Logging::NetworkLoggerEngine::endpoint() const {
+    return QString("%1:%2").arg(d->settings.host).arg(d->settings.port);
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::setProtocol(Protocol protocol) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->settings.protocol = protocol;
+}
+
+Qtilities::Logging::NetworkLoggerEngine::Protocol Qtilities::Logging::NetworkLoggerEngine::protocol() const {
+    return d->settings.protocol;
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::setRecordFormat(RecordFormat record_format) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->settings.record_format = record_format;
+}
+
+Qtilities::Logging::NetworkLoggerEngine::RecordFormat Qtilities::Logging::NetworkLoggerEngine::recordFormat() const {
+    return d->settings.record_format;
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::setCompressionEnabled(bool is_enabled) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->settings.compression_enabled = is_enabled;
+}
+
+bool Qtilities::Logging::NetworkLoggerEngine::compressionEnabled() const {
+    return d->settings.compression_enabled;
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::setQueueLimit(int bytes) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->settings.queue_limit = qMax(bytes,4096);
+}
+
+int Qtilities::Logging::NetworkLoggerEngine::queueLimit() const {
+    return d->settings.queue_limit;
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::setQueueFullPolicy(QueueFullPolicy policy) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->settings.queue_full_policy = policy;
+}
+
+Qtilities::Logging::NetworkLoggerEngine::QueueFullPolicy Qtilities::Logging::NetworkLoggerEngine::queueFullPolicy() const {
+    return d->settings.queue_full_policy;
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::setBatchSize(int record_count) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->settings.batch_size = qMax(record_count,1);
+}
+
+int Qtilities::Logging::NetworkLoggerEngine::batchSize() const {
+    return d->settings.batch_size;
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::setFlushInterval(int msecs) {
+    if (!abstractLoggerEngineData->is_initialized)
+        d->settings.flush_interval = qMax(msecs,1);
+}
+
+int Qtilities::Logging::NetworkLoggerEngine::flushInterval() const {
+    return d->settings.flush_interval;
+}
+
+void Qtilities::Logging::NetworkLoggerEngine::setReconnectDelays(int initial_msecs, int maximum_msecs) {
+    if (!abstractLoggerEngineData->is_initialized) {
+        d->settings.initial_reconnect_delay = qMax(initial_msecs,1);
+        d->settings.maximum_reconnect_delay = qMax(maximum_msecs,d->settings.initial_reconnect_delay);
+    }
+}
+
+int Qtilities::Logging::NetworkLoggerEngine::initialReconnectDelay() const {
+    return d->settings.initial_reconnect_delay;
+}
+
+int Qtilities::Logging::NetworkLoggerEngine::maximumReconnectDelay() const {
+    return d->settings.maximum_reconnect_delay;
+}
+
+quint64 Qtilities::Logging::NetworkLoggerEngine::sentRecordCount() const {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    if (!d->worker)
+        return d->sent_count;
+
+    QMutexLocker worker_locker(&d->worker->mutex);
+    return d->worker->sent_count;
+}
+
+quint64 Qtilities::Logging::NetworkLoggerEngine::droppedRecordCount() const {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    if (!d->worker)
+        return d->dropped_count;
+
+    QMutexLocker worker_locker(&d->worker->mutex);
+    return d->worker->dropped_count;
+}
+
+int Qtilities::Logging::NetworkLoggerEngine::queuedBytes() const {
+    QMutexLocker locker(&abstractLoggerEngineData->engine_mutex);
+    if (!d->worker)
+        return 0;
+
+    QMutexLocker worker_locker(&d->worker->mutex);
+    return d->worker->queued_bytes;
+}
+
+Qtilities::Logging::Interfaces::ILoggerExportable::ExportModeFlags Qtilities::Logging::NetworkLoggerEngine::supportedFormats() const {
+    ILoggerExportable::ExportModeFlags flags = 0;
+    flags |= ILoggerExportable::Binary;
+    return flags;
+}
+
+bool Qtilities::Logging::NetworkLoggerEngine::exportBinary(QDataStream& stream) const {
+    stream << d->settings.host;
+    stream << d->settings.port;
+    stream << (qint32) d->settings.protocol;
+    stream << (qint32) d->settings.record_format;
+    stream << d->settings.compression_enabled;
+    stream << (qint32) d->settings.queue_limit;
+    stream << (qint32) d->settings.queue_full_policy;
+    stream << (qint32) d->settings.batch_size;
+    stream << (qint32) d->settings.flush_interval;
+    stream << (qint32) d->settings.initial_reconnect_delay;
+    stream << (qint32) d->settings.maximum_reconnect_delay;
+    return true;
+}
+
+bool Qtilities::Logging::NetworkLoggerEngine::importBinary(QDataStream& stream) {
+    QString host;
+    quint16 port;
+    qint32 protocol, record_format, queue_limit, queue_full_policy, batch_size, flush_interval, initial_reconnect_delay, maximum_reconnect_delay;
+    bool compression_enabled;
+    stream >> host;
+    stream >> port;
+    stream >> protocol;
+    stream >> record_format;
+    stream >> compression_enabled;
+    stream >> queue_limit;
+    stream >> queue_full_policy;
+    stream >> batch_size;
+    stream >> flush_interval;
+    stream >> initial_reconnect_delay;
+    stream >> maximum_reconnect_delay;
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    setEndpoint(host,port);
+    setProtocol(protocol == UdpProtocol ? UdpProtocol : TcpProtocol);
+    setRecordFormat(record_format == SyslogFormat ? SyslogFormat : GelfFormat);
+    setCompressionEnabled(compression_enabled);
+    setQueueLimit(queue_limit);
+    setQueueFullPolicy(queue_full_policy == DropOldestRecords ? DropOldestRecords : DropNewestRecords);
+    setBatchSize(batch_size);
+    setFlushInterval(flush_interval);
+    setReconnectDelays(initial_reconnect_delay,maximum_reconnect_delay);
+    return true;
+}
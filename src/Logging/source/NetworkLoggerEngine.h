@@ -0,0 +1,182 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef NETWORKLOGGERENGINE_H
+#define NETWORKLOGGERENGINE_H
+
+#include "Logging_global.h"
+#include "AbstractLoggerEngine.h"
+#include "LoggingConstants.h"
+#include "LoggerFactory.h"
+#include "ILoggerExportable.h"
+
+namespace Qtilities {
+    namespace Logging {
+        using namespace Qtilities::Logging::Interfaces;
+        using namespace Qtilities::Logging::Constants;
+
+        /*!
+        \struct NetworkLoggerEnginePrivateData
+        \brief The NetworkLoggerEnginePrivateData struct stores private data used by the NetworkLoggerEngine class.
+          */
+        struct NetworkLoggerEnginePrivateData;
+
+        /*!
+        \class NetworkLoggerEngine
+        \brief A logger engine which ships structured log records to a central collector over TCP or UDP.
+
+        The NetworkLoggerEngine does not format messages. Instead, every message is encoded as a structured record, either a GELF 1.1 JSON
+        object or a RFC 5424 syslog line, containing the time at which it was logged, its severity, the host and application names, the name of
+        the engine it was logged to and the unformatted message contents. The engine is registered in the Logger using the
+        Qtilities::Logging::Constants::qti_def_FACTORY_TAG_NETWORK_LOGGER_ENGINE factory tag:
+
+\code
+NetworkLoggerEngine* network_engine = qobject_cast<NetworkLoggerEngine*> (Log->newLoggerEngine(qti_def_FACTORY_TAG_NETWORK_LOGGER_ENGINE));
+network_engine->setEndpoint("logs.example.com",12201);
+network_engine->setProtocol(NetworkLoggerEngine::UdpProtocol);
+network_engine->setRecordFormat(NetworkLoggerEngine::GelfFormat);
+Log->attachLoggerEngine(network_engine);
+\endcode
+
+        Logging threads only encode records and append them to a queue, they never wait for the network. A background thread sends the queued
+        records in batches, either when batchSize() records are queued or when flushInterval() passed. The queue is bounded by queueLimit() bytes,
+        when it is full records are dropped according to queueFullPolicy() and the number of dropped records is reported to the collector in a warning
+        record as soon as records can be sent again. When the connection to the collector fails, the background thread retries with an exponential
+        backoff between initialReconnectDelay() and maximumReconnectDelay() while records keep being queued.
+
+        Records are framed according to the record format and protocol: TCP GELF records are terminated with a null byte and TCP syslog records use
+        octet counting (RFC 6587). UDP records are sent as one datagram each, GELF datagrams are zlib compressed when compressionEnabled() is true and
+        are split into GELF chunks when they are larger than a single chunk. Syslog does not support compression, thus compressionEnabled() only applies
+        to UDP GELF records.
+
+        \note Records are delivered at least once. When a connection breaks while a batch is being written, the complete batch is sent again after reconnecting.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class LOGGING_SHARED_EXPORT NetworkLoggerEngine : public AbstractLoggerEngine, public ILoggerExportable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Logging::Interfaces::ILoggerExportable)
+            Q_ENUMS(Protocol RecordFormat QueueFullPolicy)
+            Q_PROPERTY(QString Endpoint READ endpoint)
+
+        public:
+            //! The transport protocols supported by the engine.
+            enum Protocol {
+                TcpProtocol,    /*!< Records are sent over a TCP connection, which is reconnected when it breaks. */
+                UdpProtocol     /*!< Records are sent as UDP datagrams. */
+            };
+            //! The record formats supported by the engine.
+            enum RecordFormat {
+                GelfFormat,     /*!< Records are GELF 1.1 JSON objects. */
+                SyslogFormat    /*!< Records are RFC 5424 syslog messages using the user-level facility. */
+            };
+            //! The policies which determine which records are dropped when the queue is full.
+            enum QueueFullPolicy {
+                DropNewestRecords,  /*!< New records are dropped while the queue is full, thus the records which were queued first are sent. */
+                DropOldestRecords   /*!< The oldest queued records are dropped to make space for new records. */
+            };
+
+            NetworkLoggerEngine();
+            ~NetworkLoggerEngine();
+
+            // --------------------------------
+            // AbstractLoggerEngine Implementation
+            // --------------------------------
+            bool initialize();
+            void finalize();
+            QString description() const;
+            QString status() const;
+            bool isFormattingEngineConstant() const { return true; }
+            bool logsUnformattedMessages() const { return true; }
+            void logUnformattedMessage(const QString& engine_name, Logger::MessageType message_type, Logger::MessageContextFlags message_context, const QList<QVariant>& messages);
+
+            // --------------------------------
+            // ILoggerExportable Implementation
+            // --------------------------------
+            ExportModeFlags supportedFormats() const;
+            bool exportBinary(QDataStream& stream) const;
+            bool importBinary(QDataStream& stream);
+            QString factoryTag() const { return qti_def_FACTORY_TAG_NETWORK_LOGGER_ENGINE; }
+            QString instanceName() const { return name(); }
+
+            //! Sets the host name or address and the port of the collector to which records are sent.
+            /*!
+                Like all other settings of this engine, the endpoint can only be changed while the engine is not initialized.
+                To change it: call finalize(), setEndpoint() and then call initialize() again.
+              */
+            void setEndpoint(const QString& host, quint16 port);
+            //! Returns the host name or address of the collector.
+            QString host() const;
+            //! Returns the port of the collector.
+            quint16 port() const;
+            //! Returns the endpoint of the collector in the "host:port" form.
+            QString endpoint() const;
+            //! Sets the transport protocol, TcpProtocol by default.
+            void setProtocol(Protocol protocol);
+            //! Returns the transport protocol.
+            Protocol protocol() const;
+            //! Sets the record format, GelfFormat by default.
+            void setRecordFormat(RecordFormat record_format);
+            //! Returns the record format.
+            RecordFormat recordFormat() const;
+            //! Enables or disables compression of UDP GELF datagrams, enabled by default.
+            void setCompressionEnabled(bool is_enabled);
+            //! Indicates if UDP GELF datagrams are compressed.
+            bool compressionEnabled() const;
+
+            //! Sets the maximum number of bytes of encoded records which are queued while they cannot be sent, 4MB by default.
+            void setQueueLimit(int bytes);
+            //! Returns the maximum number of bytes of encoded records which are queued.
+            int queueLimit() const;
+            //! Sets the policy used to drop records when the queue is full, DropNewestRecords by default.
+            void setQueueFullPolicy(QueueFullPolicy policy);
+            //! Returns the policy used to drop records when the queue is full.
+            QueueFullPolicy queueFullPolicy() const;
+            //! Sets the number of queued records which causes a batch to be sent before flushInterval() passed, 64 by default.
+            void setBatchSize(int record_count);
+            //! Returns the number of queued records which causes a batch to be sent before flushInterval() passed.
+            int batchSize() const;
+            //! Sets the maximum time in milliseconds for which records are queued before they are sent, 200 by default.
+            void setFlushInterval(int msecs);
+            //! Returns the maximum time in milliseconds for which records are queued before they are sent.
+            int flushInterval() const;
+            //! Sets the delays in milliseconds between attempts to reconnect to the collector, 500 and 30000 by default.
+            /*!
+              The first attempt is made after \p initial_msecs, every next attempt waits twice as long up to \p maximum_msecs.
+              */
+            void setReconnectDelays(int initial_msecs, int maximum_msecs);
+            //! Returns the delay before the first attempt to reconnect to the collector.
+            int initialReconnectDelay() const;
+            //! Returns the maximum delay between attempts to reconnect to the collector.
+            int maximumReconnectDelay() const;
+
+            //! Returns the number of records which were sent to the collector since the engine was initialized.
+            quint64 sentRecordCount() const;
+            //! Returns the number of records which were dropped since the engine was initialized.
+            quint64 droppedRecordCount() const;
+            //! Returns the number of bytes of encoded records which are currently queued.
+            int queuedBytes() const;
+
+            // Make this class a factory item
+            static LoggerFactoryItem<AbstractLoggerEngine, NetworkLoggerEngine> factory;
+
+        public slots:
+            //! Formatted messages are not supported by this engine, thus this function sends \p message as a single unformatted message.
+            void logMessage(const QString& message, Logger::MessageType message_type);
+
+        private:
+            NetworkLoggerEnginePrivateData* d;
+        };
+    }
+}
+
+#endif // NETWORKLOGGERENGINE_H
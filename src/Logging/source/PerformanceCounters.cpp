@@ -0,0 +1,172 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "PerformanceCounters.h"
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <limits.h>
+
+namespace {
+    const int qti_private_MAX_PERFORMANCE_COUNTERS = 256;
+    const int qti_private_HISTOGRAM_BUCKETS = 32;
+}
+
+struct Qtilities::Logging::PerformanceCountersPrivateData {
+    PerformanceCountersPrivateData() : counter_count(0) {
+        for (int i = 0; i < qti_private_MAX_PERFORMANCE_COUNTERS; ++i)
+            types[i] = PerformanceCounters::Count;
+    }
+
+    //! Serializes the registration of counters. Updates to counters don't take this lock.
+    QMutex      registration_mutex;
+    //! The number of registered counters, published after the name and type of a new counter were set.
+    QAtomicInt  counter_count;
+    QString     names[qti_private_MAX_PERFORMANCE_COUNTERS];
+    int         types[qti_private_MAX_PERFORMANCE_COUNTERS];
+    QAtomicInt  values[qti_private_MAX_PERFORMANCE_COUNTERS];
+    QAtomicInt  maximums[qti_private_MAX_PERFORMANCE_COUNTERS];
+    QAtomicInt  buckets[qti_private_MAX_PERFORMANCE_COUNTERS][qti_private_HISTOGRAM_BUCKETS];
+};
+
+Qtilities::Logging::PerformanceCounters* Qtilities::Logging::PerformanceCounters::m_Instance = 0;
+
+Qtilities::Logging::PerformanceCounters* Qtilities::Logging::PerformanceCounters::instance() {
+    static QMutex mutex;
+    if (!m_Instance)
+    {
+        mutex.lock();
+
+        if (!m_Instance)
+            m_Instance = new PerformanceCounters;
+
+        mutex.unlock();
+    }
+
+    return m_Instance;
+}
+
+Qtilities::Logging::PerformanceCounters::PerformanceCounters() {
+    d = new PerformanceCountersPrivateData;
+}
+
+Qtilities::Logging::PerformanceCounters::~PerformanceCounters() {
+    delete d;
+}
+
+int Qtilities::Logging::PerformanceCounters::registerCounter(const QString& name, CounterType type) {
+    QMutexLocker locker(&d->registration_mutex);
+    const int count = d->counter_count.fetchAndAddOrdered(0);
+    for (int i = 0; i < count; ++i) {
+        if (d->names[i] == name)
+            return i;
+    }
+    if (count >= qti_private_MAX_PERFORMANCE_COUNTERS)
+        return -1;
+
+    d->names[count] = name;
+    d->types[count] = type;
+    d->counter_count.fetchAndStoreOrdered(count + 1);
+    return count;
+}
+
+void Qtilities::Logging::PerformanceCounters::add(int counter_id, int value) {
+    if (counter_id < 0)
+        return;
+
+    d->values[counter_id].fetchAndAddRelaxed(value);
+}
+
+void Qtilities::Logging::PerformanceCounters::setValue(int counter_id, int value) {
+    if (counter_id < 0)
+        return;
+
+    d->values[counter_id].fetchAndStoreRelaxed(value);
+    int current_maximum = d->maximums[counter_id].fetchAndAddRelaxed(0);
+    while (value > current_maximum && !d->maximums[counter_id].testAndSetRelaxed(current_maximum,value))
+        current_maximum = d->maximums[counter_id].fetchAndAddRelaxed(0);
+}
+
+void Qtilities::Logging::PerformanceCounters::addSample(int counter_id, qint64 value) {
+    if (counter_id < 0)
+        return;
+
+    int bucket = 0;
+    if (value > 0) {
+        while (bucket < qti_private_HISTOGRAM_BUCKETS - 1 && (value >> bucket) != 0)
+            ++bucket;
+    }
+    d->buckets[counter_id][bucket].fetchAndAddRelaxed(1);
+    d->values[counter_id].fetchAndAddRelaxed(1);
+
+    const int sample = (int) qMin(value,(qint64) INT_MAX);
+    int current_maximum = d->maximums[counter_id].fetchAndAddRelaxed(0);
+    while (sample > current_maximum && !d->maximums[counter_id].testAndSetRelaxed(current_maximum,sample))
+        current_maximum = d->maximums[counter_id].fetchAndAddRelaxed(0);
+}
+
+QList<Qtilities::Logging::PerformanceCounterValue> Qtilities::Logging::PerformanceCounters::values() const {
+    QList<PerformanceCounterValue> counter_values;
+    const int count = d->counter_count.fetchAndAddOrdered(0);
+    for (int i = 0; i < count; ++i) {
+        PerformanceCounterValue value;
+        value.name = d->names[i];
+        value.type = d->types[i];
+        value.total = d->values[i].fetchAndAddRelaxed(0);
+        value.maximum = d->maximums[i].fetchAndAddRelaxed(0);
+        if (value.type == Histogram) {
+            value.buckets.resize(qti_private_HISTOGRAM_BUCKETS);
+            for (int b = 0; b < qti_private_HISTOGRAM_BUCKETS; ++b)
+                value.buckets[b] = d->buckets[i][b].fetchAndAddRelaxed(0);
+        }
+        counter_values << value;
+    }
+    return counter_values;
+}
+
+void Qtilities::Logging::PerformanceCounters::reset() {
+    const int count = d->counter_count.fetchAndAddOrdered(0);
+    for (int i = 0; i < count; ++i) {
+        d->values[i].fetchAndStoreRelaxed(0);
+        d->maximums[i].fetchAndStoreRelaxed(0);
+        for (int b = 0; b < qti_private_HISTOGRAM_BUCKETS; ++b)
+            d->buckets[i][b].fetchAndStoreRelaxed(0);
+    }
+}
+
+int Qtilities::Logging::PerformanceCounters::maximumCounters() {
+    return qti_private_MAX_PERFORMANCE_COUNTERS;
+}
+
+int Qtilities::Logging::PerformanceCounters::histogramBucketCount() {
+    return qti_private_HISTOGRAM_BUCKETS;
+}
+
+qint64 Qtilities::Logging::PerformanceCounters::histogramBucketLimit(int bucket) {
+    if (bucket <= 0)
+        return 0;
+    return (Q_INT64_C(1) << bucket) - 1;
+}
+
+// -----------------------------------
+// PerformanceCounterScope
+// -----------------------------------
+Qtilities::Logging::PerformanceCounterScope::PerformanceCounterScope(int counter_id) : d_counter_id(counter_id) {
+    if (d_counter_id >= 0)
+        d_timer.start();
+}
+
+Qtilities::Logging::PerformanceCounterScope::~PerformanceCounterScope() {
+    if (d_counter_id >= 0)
+        PerformanceCounters::instance()->addSample(d_counter_id,d_timer.nsecsElapsed() / 1000);
+}
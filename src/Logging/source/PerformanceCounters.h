@@ -0,0 +1,169 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef PERFORMANCE_COUNTERS_H
+#define PERFORMANCE_COUNTERS_H
+
+#include "Logging_global.h"
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+namespace Qtilities {
+    namespace Logging {
+        /*!
+        \struct PerformanceCounterValue
+        \brief The value of a performance counter at the time PerformanceCounters::values() was called.
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct LOGGING_SHARED_EXPORT PerformanceCounterValue {
+            PerformanceCounterValue() : type(0), total(0), maximum(0) {}
+
+            //! The name of the counter.
+            QString         name;
+            //! The PerformanceCounters::CounterType of the counter.
+            int             type;
+            //! For counts, the number of events. For gauges, the current value. For histograms, the number of samples.
+            qint64          total;
+            //! For gauges and histograms, the largest value seen.
+            qint64          maximum;
+            //! For histograms, the number of samples in each bucket, see PerformanceCounters::histogramBucketLimit().
+            QVector<qint64> buckets;
+        };
+
+        /*!
+        \struct PerformanceCountersPrivateData
+        \brief Structure used by PerformanceCounters to store private data.
+          */
+        struct PerformanceCountersPrivateData;
+
+        /*!
+        \class PerformanceCounters
+        \brief The PerformanceCounters class collects counters, gauges and histograms on the hot paths of %Qtilities.
+
+        Counters are registered by name the first time they are used and are updated using atomic operations, thus updating a counter does not take
+        a lock. %Qtilities counts observer attachments and detachments, property change events handled by observers, tree model rebuilds and their
+        durations, messages per logger engine and their queue depths, and the utilization of the task executor. Applications can add their own counters
+        using the performance counter macros:
+
+\code
+void MyClass::handleRequest() {
+    QTI_PERFORMANCE_SCOPE("MyClass: Handle Request (us)");
+    QTI_PERFORMANCE_COUNT("MyClass: Requests");
+    ...
+}
+\endcode
+
+        The counters are shown on the performance counters page of the debug plugin, which samples values() periodically to calculate rates.
+
+        When \p QTILITIES_NO_PERFORMANCE_COUNTERS is defined, the macros expand to nothing and no counters are collected.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class LOGGING_SHARED_EXPORT PerformanceCounters
+        {
+        public:
+            //! The types of performance counters.
+            enum CounterType {
+                Count       = 0,    /*!< Counts events, for example messages logged. */
+                Gauge       = 1,    /*!< Holds the last value set, for example the depth of a queue. */
+                Histogram   = 2     /*!< Counts samples in power of two buckets, for example durations in microseconds. */
+            };
+
+            static PerformanceCounters* instance();
+            ~PerformanceCounters();
+
+            //! Registers a counter and returns its ID. When a counter with \p name exists, its ID is returned.
+            /*!
+              At most maximumCounters() counters can be registered, -1 is returned once this limit is reached. Updates to counter -1 are ignored.
+              */
+            int registerCounter(const QString& name, CounterType type);
+            //! Adds \p value to a Count counter. This function is thread-safe and does not take a lock.
+            void add(int counter_id, int value = 1);
+            //! Sets the value of a Gauge counter. This function is thread-safe and does not take a lock.
+            void setValue(int counter_id, int value);
+            //! Adds a sample to a Histogram counter. This function is thread-safe and does not take a lock.
+            void addSample(int counter_id, qint64 value);
+
+            //! The values of all registered counters, in the order in which they were registered.
+            QList<PerformanceCounterValue> values() const;
+            //! Resets all counters to zero. Registered counters stay registered.
+            void reset();
+
+            //! The maximum number of counters which can be registered.
+            static int maximumCounters();
+            //! The number of buckets in histograms.
+            static int histogramBucketCount();
+            //! The largest value counted in \p bucket. Bucket 0 counts values of 0 and less, bucket \p i counts values up to 2^i - 1.
+            static qint64 histogramBucketLimit(int bucket);
+
+        private:
+            PerformanceCounters();
+            Q_DISABLE_COPY(PerformanceCounters)
+
+            static PerformanceCounters* m_Instance;
+            PerformanceCountersPrivateData* d;
+        };
+
+        /*!
+        \class PerformanceCounterScope
+        \brief The PerformanceCounterScope class adds the lifetime of the scope in which it is constructed, in microseconds, to a Histogram counter.
+
+        Use the QTI_PERFORMANCE_SCOPE macro instead of using this class directly.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class LOGGING_SHARED_EXPORT PerformanceCounterScope
+        {
+        public:
+            PerformanceCounterScope(int counter_id);
+            ~PerformanceCounterScope();
+
+        private:
+            Q_DISABLE_COPY(PerformanceCounterScope)
+
+            int             d_counter_id;
+            QElapsedTimer   d_timer;
+        };
+    }
+}
+
+#ifndef QTILITIES_NO_PERFORMANCE_COUNTERS
+    //! Counts an event in the performance counter named \p name.
+    #define QTI_PERFORMANCE_COUNT(name) QTI_PERFORMANCE_COUNT_N(name,1)
+    //! Counts \p n events in the performance counter named \p name.
+    #define QTI_PERFORMANCE_COUNT_N(name,n) do { \
+        static const int qti_performance_counter_id = Qtilities::Logging::PerformanceCounters::instance()->registerCounter(name,Qtilities::Logging::PerformanceCounters::Count); \
+        Qtilities::Logging::PerformanceCounters::instance()->add(qti_performance_counter_id,n); } while (0)
+    //! Sets the value of the performance gauge named \p name.
+    #define QTI_PERFORMANCE_GAUGE(name,value) do { \
+        static const int qti_performance_counter_id = Qtilities::Logging::PerformanceCounters::instance()->registerCounter(name,Qtilities::Logging::PerformanceCounters::Gauge); \
+        Qtilities::Logging::PerformanceCounters::instance()->setValue(qti_performance_counter_id,value); } while (0)
+    //! Adds a sample to the performance histogram named \p name.
+    #define QTI_PERFORMANCE_SAMPLE(name,value) do { \
+        static const int qti_performance_counter_id = Qtilities::Logging::PerformanceCounters::instance()->registerCounter(name,Qtilities::Logging::PerformanceCounters::Histogram); \
+        Qtilities::Logging::PerformanceCounters::instance()->addSample(qti_performance_counter_id,value); } while (0)
+    //! Adds the duration of the enclosing scope in microseconds to the performance histogram named \p name. Use at most once per scope.
+    #define QTI_PERFORMANCE_SCOPE(name) \
+        static const int qti_performance_scope_id = Qtilities::Logging::PerformanceCounters::instance()->registerCounter(name,Qtilities::Logging::PerformanceCounters::Histogram); \
+        Qtilities::Logging::PerformanceCounterScope qti_performance_scope(qti_performance_scope_id)
+#else
+    #define QTI_PERFORMANCE_COUNT(name) ((void)0)
+    #define QTI_PERFORMANCE_COUNT_N(name,n) ((void)0)
+    #define QTI_PERFORMANCE_GAUGE(name,value) ((void)0)
+    #define QTI_PERFORMANCE_SAMPLE(name,value) ((void)0)
+    #define QTI_PERFORMANCE_SCOPE(name)
+#endif
+
+#endif // PERFORMANCE_COUNTERS_H
@@ -0,0 +1,485 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "SessionLogStore.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QVarLengthArray>
+#include <QVector>
+
+using namespace Qtilities::Logging;
+
+namespace {
+    // Messages are grouped in blocks of 64 sequences in the trigram index:
+    const int qti_private_log_store_block_shift = 6;
+
+    inline int qti_private_typeIndex(Logger::MessageType message_type) {
+        int index = 0;
+        int type = message_type;
+        while (type > 1 && index < 6) {
+            type >>= 1;
+            ++index;
+        }
+        return index;
+    }
+
+    inline quint64 qti_private_trigramKey(const QChar* chars) {
+        return ((quint64) chars[0].unicode() << 32) | ((quint64) chars[1].unicode() << 16) | (quint64) chars[2].unicode();
+    }
+
+    // Removes the sequences (or blocks) smaller than first from the front of an ascending posting list.
+    void qti_private_dropStalePostings(QVector<qint64>& postings, qint64 first) {
+        QVector<qint64>::iterator itr = qLowerBound(postings.begin(),postings.end(),first);
+        if (itr != postings.begin())
+            postings.erase(postings.begin(),itr);
+    }
+
+    // Iterates the sequences of one or more disjoint ascending posting lists in descending order, limited to [lower, upper).
+    class qti_private_PostingCursor {
+    public:
+        void addPostings(const QVector<qint64>& postings, qint64 lower, qint64 upper) {
+            Range range;
+            range.begin = qLowerBound(postings.constBegin(),postings.constEnd(),lower);
+            range.end = qLowerBound(range.begin,postings.constEnd(),upper);
+            if (range.begin != range.end)
+                ranges.append(range);
+        }
+        int count() const {
+            int total = 0;
+            for (int i = 0; i < ranges.size(); ++i)
+                total += ranges[i].end - ranges[i].begin;
+            return total;
+        }
+        // Returns the next sequence, or -1 when all sequences were returned.
+        qint64 next() {
+            int newest = -1;
+            for (int i = 0; i < ranges.size(); ++i) {
+                if (ranges[i].begin != ranges[i].end && (newest < 0 || *(ranges[i].end - 1) > *(ranges[newest].end - 1)))
+                    newest = i;
+            }
+            if (newest < 0)
+                return -1;
+            return *(--ranges[newest].end);
+        }
+
+    private:
+        struct Range {
+            QVector<qint64>::const_iterator begin;
+            QVector<qint64>::const_iterator end;
+        };
+        QVarLengthArray<Range,7> ranges;
+    };
+
+    struct qti_private_LogQueryFilter {
+        qti_private_LogQueryFilter() : type_mask(0), engine_id(-1), task_id(-1), blocks(0), block_index(-1) {}
+
+        //! A bit for every accepted message type index.
+        int                     type_mask;
+        int                     engine_id;
+        int                     task_id;
+        QString                 text;
+        QRegExp                 pattern;
+        //! The ascending blocks containing all trigrams of the text, null when the trigram index is not used.
+        const QVector<qint64>*  blocks;
+        //! The position in blocks, moves down as the filter is applied to descending sequences.
+        int                     block_index;
+    };
+}
+
+struct Qtilities::Logging::SessionLogStorePrivateData {
+    SessionLogStorePrivateData() : capacity(1),
+        next_sequence(0),
+        first_sequence(0),
+        last_time(0),
+        compaction_countdown(0) {
+        engine_names << QString();
+    }
+
+    int slot(qint64 sequence) const {
+        return int(sequence % capacity);
+    }
+    //! Returns the ID of the engine with the given name, interning it when needed. System wide messages use 0.
+    quint16 engineId(const QString& engine_name) {
+        if (engine_name.isEmpty())
+            return 0;
+        QHash<QString,int>::const_iterator itr = engine_ids.constFind(engine_name);
+        if (itr != engine_ids.constEnd())
+            return itr.value();
+        // Engines are few and live for the whole session, thus their IDs are never recycled:
+        const int id = engine_names.count();
+        engine_names << engine_name;
+        engine_ids[engine_name] = id;
+        return id;
+    }
+    //! Returns the first sequence in the store logged at or after msecs.
+    qint64 sequenceAtTime(qint64 msecs) const {
+        qint64 low = first_sequence;
+        qint64 high = next_sequence;
+        while (low < high) {
+            const qint64 middle = low + (high - low) / 2;
+            if (times.at(slot(middle)) < msecs)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        return low;
+    }
+    //! Returns the posting list of key in hash, null when there is none.
+    const QVector<qint64>* postings(const QHash<int,QVector<qint64> >& hash, int key) const {
+        QHash<int,QVector<qint64> >::const_iterator itr = hash.constFind(key);
+        return itr == hash.constEnd() ? 0 : &itr.value();
+    }
+    void append(const QString& engine_name, Logger::MessageType message_type, const QList<QVariant>& message_contents, int task_id, qint64 msecs);
+    void compact();
+    bool matches(qint64 sequence, qti_private_LogQueryFilter& filter) const;
+    LogStoreEntry entry(qint64 sequence) const;
+
+    mutable QReadWriteLock              lock;
+    int                                 capacity;
+    //! The sequence of the next message which will be added.
+    qint64                              next_sequence;
+    //! The sequence of the oldest message in the store.
+    qint64                              first_sequence;
+    //! The time of the newest message, times never decrease thus time ranges can be found using a binary search.
+    qint64                              last_time;
+    //! The number of messages to add before compact() is called.
+    int                                 compaction_countdown;
+
+    // Columns, indexed by slot(). They grow until the store is full and are then overwritten:
+    QVector<qint64>                     times;
+    QVector<quint8>                     type_indexes;
+    QVector<quint16>                    engines;
+    QVector<qint32>                     tasks;
+    QVector<QString>                    messages;
+
+    // Ascending posting lists. Entries older than first_sequence are skipped by queries and removed by compact():
+    QVector<qint64>                     type_postings[7];
+    QHash<int,QVector<qint64> >         engine_postings;
+    QHash<int,QVector<qint64> >         task_postings;
+    //! The blocks containing each case folded trigram.
+    QHash<quint64,QVector<qint64> >     trigram_blocks;
+
+    QStringList                         engine_names;
+    QHash<QString,int>                  engine_ids;
+};
+
+void Qtilities::Logging::SessionLogStorePrivateData::append(const QString& engine_name, Logger::MessageType message_type, const QList<QVariant>& message_contents, int task_id, qint64 msecs) {
+    QString message;
+    if (message_contents.count() == 1)
+        message = message_contents.front().toString();
+    else {
+        for (int i = 0; i < message_contents.count(); ++i) {
+            if (i > 0)
+                message.append(QLatin1Char(' '));
+            message.append(message_contents.at(i).toString());
+        }
+    }
+
+    const qint64 sequence = next_sequence++;
+    last_time = qMax(last_time,msecs);
+    const quint16 engine_id = engineId(engine_name);
+    const int type_index = qti_private_typeIndex(message_type);
+
+    if (times.count() < capacity) {
+        times.append(last_time);
+        type_indexes.append(type_index);
+        engines.append(engine_id);
+        tasks.append(task_id);
+        messages.append(message);
+    } else {
+        const int index = slot(sequence);
+        times[index] = last_time;
+        type_indexes[index] = type_index;
+        engines[index] = engine_id;
+        tasks[index] = task_id;
+        messages[index] = message;
+        ++first_sequence;
+    }
+
+    type_postings[type_index].append(sequence);
+    if (engine_id)
+        engine_postings[engine_id].append(sequence);
+    if (task_id != -1)
+        task_postings[task_id].append(sequence);
+
+    if (message.length() >= 3) {
+        const qint64 block = sequence >> qti_private_log_store_block_shift;
+        const QString folded = message.toCaseFolded();
+        const QChar* chars = folded.constData();
+        for (int i = 0; i + 2 < folded.length(); ++i) {
+            QVector<qint64>& blocks = trigram_blocks[qti_private_trigramKey(chars + i)];
+            if (blocks.isEmpty() || blocks.last() != block)
+                blocks.append(block);
+        }
+    }
+
+    if (--compaction_countdown <= 0)
+        compact();
+}
+
+void Qtilities::Logging::SessionLogStorePrivateData::compact() {
+    // Compacting once for every half capacity of overwritten messages keeps the cost per message constant:
+    compaction_countdown = qMax(capacity / 2,1024);
+    if (first_sequence == 0)
+        return;
+
+    for (int i = 0; i < 7; ++i)
+        qti_private_dropStalePostings(type_postings[i],first_sequence);
+
+    QMutableHashIterator<int,QVector<qint64> > engine_itr(engine_postings);
+    while (engine_itr.hasNext()) {
+        qti_private_dropStalePostings(engine_itr.next().value(),first_sequence);
+        if (engine_itr.value().isEmpty())
+            engine_itr.remove();
+    }
+    QMutableHashIterator<int,QVector<qint64> > task_itr(task_postings);
+    while (task_itr.hasNext()) {
+        qti_private_dropStalePostings(task_itr.next().value(),first_sequence);
+        if (task_itr.value().isEmpty())
+            task_itr.remove();
+    }
+    const qint64 first_block = first_sequence >> qti_private_log_store_block_shift;
+    QMutableHashIterator<quint64,QVector<qint64> > trigram_itr(trigram_blocks);
+    while (trigram_itr.hasNext()) {
+        qti_private_dropStalePostings(trigram_itr.next().value(),first_block);
+        if (trigram_itr.value().isEmpty())
+            trigram_itr.remove();
+    }
+}
+
+bool Qtilities::Logging::SessionLogStorePrivateData::matches(qint64 sequence, qti_private_LogQueryFilter& filter) const {
+    const int index = slot(sequence);
+    if (!(filter.type_mask & (1 << type_indexes.at(index))))
+        return false;
+    if (filter.engine_id >= 0 && engines.at(index) != filter.engine_id)
+        return false;
+    if (filter.task_id != -1 && tasks.at(index) != filter.task_id)
+        return false;
+    if (filter.blocks) {
+        const qint64 block = sequence >> qti_private_log_store_block_shift;
+        while (filter.block_index >= 0 && filter.blocks->at(filter.block_index) > block)
+            --filter.block_index;
+        if (filter.block_index < 0 || filter.blocks->at(filter.block_index) != block)
+            return false;
+    }
+    if (!filter.text.isEmpty() && !messages.at(index).contains(filter.text,Qt::CaseInsensitive))
+        return false;
+    if (!filter.pattern.isEmpty() && filter.pattern.indexIn(messages.at(index)) < 0)
+        return false;
+    return true;
+}
+
+LogStoreEntry Qtilities::Logging::SessionLogStorePrivateData::entry(qint64 sequence) const {
+    const int index = slot(sequence);
+    LogStoreEntry entry;
+    entry.sequence = sequence;
+    entry.timestamp = QDateTime::fromMSecsSinceEpoch(times.at(index));
+    entry.message_type = (Logger::MessageType) (1 << type_indexes.at(index));
+    entry.engine_name = engine_names.at(engines.at(index));
+    entry.task_id = tasks.at(index);
+    entry.message = messages.at(index);
+    return entry;
+}
+
+Qtilities::Logging::SessionLogStore::SessionLogStore(int capacity) {
+    d = new SessionLogStorePrivateData;
+    d->capacity = qMax(capacity,1);
+    d->compaction_countdown = qMax(d->capacity / 2,1024);
+}
+
+Qtilities::Logging::SessionLogStore::~SessionLogStore() {
+    delete d;
+}
+
+void Qtilities::Logging::SessionLogStore::addMessage(const QString& engine_name, Logger::MessageType message_type, const QList<QVariant>& message_contents, int task_id) {
+    const qint64 msecs = QDateTime::currentMSecsSinceEpoch();
+    QWriteLocker locker(&d->lock);
+    d->append(engine_name,message_type,message_contents,task_id,msecs);
+}
+
+void Qtilities::Logging::SessionLogStore::addRecords(const QList<LoggerRecord>& records) {
+    const qint64 msecs = QDateTime::currentMSecsSinceEpoch();
+    QWriteLocker locker(&d->lock);
+    for (int i = 0; i < records.count(); ++i) {
+        const LoggerRecord& record = records.at(i);
+        d->append(record.engine_name,record.message_type,record.message_contents,record.task_id,msecs);
+    }
+}
+
+void Qtilities::Logging::SessionLogStore::clear() {
+    QWriteLocker locker(&d->lock);
+    d->next_sequence = 0;
+    d->first_sequence = 0;
+    d->compaction_countdown = qMax(d->capacity / 2,1024);
+    d->times.clear();
+    d->type_indexes.clear();
+    d->engines.clear();
+    d->tasks.clear();
+    d->messages.clear();
+    for (int i = 0; i < 7; ++i)
+        d->type_postings[i].clear();
+    d->engine_postings.clear();
+    d->task_postings.clear();
+    d->trigram_blocks.clear();
+}
+
+QList<LogStoreEntry> Qtilities::Logging::SessionLogStore::query(const LogQuery& query) const {
+    QList<LogStoreEntry> entries;
+    qti_private_LogQueryFilter filter;
+    for (int index = 1; index < 7; ++index) {
+        if (query.message_types & (1 << index))
+            filter.type_mask |= 1 << index;
+    }
+    if (!filter.type_mask)
+        return entries;
+    filter.task_id = query.task_id;
+    filter.text = query.text;
+    // Matching modifies the expression, thus every query uses its own copy:
+    filter.pattern = query.pattern;
+
+    QReadLocker locker(&d->lock);
+
+    // Find the range of sequences logged in the time range:
+    const qint64 lower = query.from.isValid() ? d->sequenceAtTime(query.from.toMSecsSinceEpoch()) : d->first_sequence;
+    const qint64 upper = query.to.isValid() ? d->sequenceAtTime(query.to.toMSecsSinceEpoch() + 1) : d->next_sequence;
+    if (lower >= upper)
+        return entries;
+
+    if (!query.engine_name.isEmpty()) {
+        filter.engine_id = d->engine_ids.value(query.engine_name,-1);
+        if (filter.engine_id < 0)
+            return entries;
+    }
+
+    // Intersect the blocks of all trigrams in the text, starting with the rarest trigram:
+    QVector<qint64> candidate_blocks;
+    if (query.text.length() >= 3) {
+        const QString folded = query.text.toCaseFolded();
+        QVarLengthArray<const QVector<qint64>*,32> trigram_lists;
+        for (int i = 0; i + 2 < folded.length(); ++i) {
+            QHash<quint64,QVector<qint64> >::const_iterator itr = d->trigram_blocks.constFind(qti_private_trigramKey(folded.constData() + i));
+            if (itr == d->trigram_blocks.constEnd())
+                return entries;
+            trigram_lists.append(&itr.value());
+        }
+        int rarest = 0;
+        for (int i = 1; i < trigram_lists.size(); ++i) {
+            if (trigram_lists[i]->count() < trigram_lists[rarest]->count())
+                rarest = i;
+        }
+
+        const qint64 lower_block = lower >> qti_private_log_store_block_shift;
+        const qint64 upper_block = (upper - 1) >> qti_private_log_store_block_shift;
+        const QVector<qint64>& rarest_list = *trigram_lists[rarest];
+        QVector<qint64>::const_iterator itr = qLowerBound(rarest_list.constBegin(),rarest_list.constEnd(),lower_block);
+        for (; itr != rarest_list.constEnd() && *itr <= upper_block; ++itr) {
+            bool in_all_lists = true;
+            for (int i = 0; i < trigram_lists.size() && in_all_lists; ++i) {
+                if (i != rarest)
+                    in_all_lists = qBinaryFind(trigram_lists[i]->constBegin(),trigram_lists[i]->constEnd(),*itr) != trigram_lists[i]->constEnd();
+            }
+            if (in_all_lists)
+                candidate_blocks.append(*itr);
+        }
+        if (candidate_blocks.isEmpty())
+            return entries;
+        filter.blocks = &candidate_blocks;
+        filter.block_index = candidate_blocks.count() - 1;
+    }
+
+    const int max_results = query.max_results > 0 ? query.max_results : d->capacity;
+
+    // Visit the fewest candidates: the posting list of the engine or task, the posting lists of
+    // the selected message types, the candidate blocks of the text, or else all messages in the range.
+    qti_private_PostingCursor cursor;
+    bool use_cursor = false;
+    if (filter.engine_id >= 0 || filter.task_id != -1) {
+        const QVector<qint64>* engine_list = filter.engine_id >= 0 ? d->postings(d->engine_postings,filter.engine_id) : 0;
+        const QVector<qint64>* task_list = filter.task_id != -1 ? d->postings(d->task_postings,filter.task_id) : 0;
+        if ((filter.engine_id >= 0 && !engine_list) || (filter.task_id != -1 && !task_list))
+            return entries;
+        if (engine_list && (!task_list || engine_list->count() <= task_list->count()))
+            cursor.addPostings(*engine_list,lower,upper);
+        else
+            cursor.addPostings(*task_list,lower,upper);
+        use_cursor = true;
+    } else if (filter.type_mask != 0x7E) {
+        for (int index = 1; index < 7; ++index) {
+            if (filter.type_mask & (1 << index))
+                cursor.addPostings(d->type_postings[index],lower,upper);
+        }
+        use_cursor = !filter.blocks || cursor.count() < (candidate_blocks.count() << qti_private_log_store_block_shift);
+    }
+
+    if (use_cursor) {
+        qint64 sequence;
+        while (entries.count() < max_results && (sequence = cursor.next()) >= 0) {
+            if (d->matches(sequence,filter))
+                entries.append(d->entry(sequence));
+        }
+    } else if (filter.blocks) {
+        const QVector<qint64>& blocks = candidate_blocks;
+        for (int b = blocks.count() - 1; b >= 0 && entries.count() < max_results; --b) {
+            const qint64 block_first = qMax(lower,blocks.at(b) << qti_private_log_store_block_shift);
+            const qint64 block_last = qMin(upper - 1,((blocks.at(b) + 1) << qti_private_log_store_block_shift) - 1);
+            for (qint64 sequence = block_last; sequence >= block_first && entries.count() < max_results; --sequence) {
+                if (d->matches(sequence,filter))
+                    entries.append(d->entry(sequence));
+            }
+        }
+    } else {
+        for (qint64 sequence = upper - 1; sequence >= lower && entries.count() < max_results; --sequence) {
+            if (d->matches(sequence,filter))
+                entries.append(d->entry(sequence));
+        }
+    }
+
+    return entries;
+}
+
+QStringList Qtilities::Logging::SessionLogStore::engineNames() const {
+    QReadLocker locker(&d->lock);
+    QStringList names;
+    QHash<int,QVector<qint64> >::const_iterator itr = d->engine_postings.constBegin();
+    for (; itr != d->engine_postings.constEnd(); ++itr) {
+        if (!itr.value().isEmpty() && itr.value().last() >= d->first_sequence)
+            names << d->engine_names.at(itr.key());
+    }
+    names.sort();
+    return names;
+}
+
+QList<int> Qtilities::Logging::SessionLogStore::taskIds() const {
+    QReadLocker locker(&d->lock);
+    QList<int> ids;
+    QHash<int,QVector<qint64> >::const_iterator itr = d->task_postings.constBegin();
+    for (; itr != d->task_postings.constEnd(); ++itr) {
+        if (!itr.value().isEmpty() && itr.value().last() >= d->first_sequence)
+            ids << itr.key();
+    }
+    qSort(ids);
+    return ids;
+}
+
+int Qtilities::Logging::SessionLogStore::capacity() const {
+    return d->capacity;
+}
+
+int Qtilities::Logging::SessionLogStore::count() const {
+    QReadLocker locker(&d->lock);
+    return int(d->next_sequence - d->first_sequence);
+}
+
+qint64 Qtilities::Logging::SessionLogStore::totalCount() const {
+    QReadLocker locker(&d->lock);
+    return d->next_sequence;
+}
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef SESSION_LOG_STORE_H
+#define SESSION_LOG_STORE_H
+
+#include "Logging_global.h"
+#include "Logger.h"
+
+#include <QDateTime>
+#include <QList>
+#include <QRegExp>
+#include <QString>
+#include <QStringList>
+
+namespace Qtilities {
+    namespace Logging {
+        /*!
+        \struct LogQuery
+        \brief A query over the messages kept by a SessionLogStore.
+
+        All conditions which are set must match for a message to be returned. The default query returns the newest maximumResults() messages of all types.
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct LOGGING_SHARED_EXPORT LogQuery {
+            LogQuery() : message_types(Logger::AllLogLevels),
+                task_id(-1),
+                max_results(1000) {}
+
+            //! The types of the messages to return.
+            Logger::MessageTypeFlags    message_types;
+            //! Messages logged before this time are not returned. Ignored when invalid.
+            QDateTime                   from;
+            //! Messages logged after this time are not returned. Ignored when invalid.
+            QDateTime                   to;
+            //! Only messages logged to the engine with this name are returned. Ignored when empty.
+            QString                     engine_name;
+            //! Only messages logged by the task with this ID are returned, see Logger::setCurrentTaskId(). Ignored when -1.
+            int                         task_id;
+            //! Only messages containing this text, compared case insensitive, are returned. Ignored when empty.
+            /*!
+              Text of three or more characters is looked up in the trigram index of the store, thus it is much faster than an equivalent \p pattern.
+              */
+            QString                     text;
+            //! Only messages matching this expression are returned. Ignored when empty.
+            QRegExp                     pattern;
+            //! The maximum number of messages returned. When 0, all matching messages are returned.
+            int                         max_results;
+        };
+
+        /*!
+        \struct LogStoreEntry
+        \brief A message returned by SessionLogStore::query().
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct LOGGING_SHARED_EXPORT LogStoreEntry {
+            LogStoreEntry() : sequence(-1),
+                message_type(Logger::None),
+                task_id(-1) {}
+
+            //! The sequence number of the message, increasing by one for every message added to the store.
+            qint64                      sequence;
+            //! The time at which the message was added to the store.
+            QDateTime                   timestamp;
+            //! The type of the message.
+            Logger::MessageType         message_type;
+            //! The name of the engine to which the message was logged, empty for system wide messages.
+            QString                     engine_name;
+            //! The ID of the task which logged the message, -1 when it was not logged by a task.
+            int                         task_id;
+            //! The unformatted message contents, joined by spaces.
+            QString                     message;
+        };
+
+        /*!
+        \struct SessionLogStorePrivateData
+        \brief Structure used by SessionLogStore to store private data.
+          */
+        struct SessionLogStorePrivateData;
+
+        /*!
+        \class SessionLogStore
+        \brief An indexed in-memory store of the most recent messages logged during the session.
+
+        The store is created by the logger when Logger::setSessionLogStoreEnabled() is called, and receives every message logged through the
+        logger, including engine specific and priority messages, before it is routed to logger engines. It keeps the newest capacity() messages
+        in a columnar layout: the time, type, engine and task of every message are stored in separate compact arrays next to the message text,
+        and the oldest messages are overwritten once the store is full.
+
+        Queries are answered from indexes which are updated as messages are added:
+        - Messages are stored in the order they were added with non-decreasing times, thus time ranges are found using a binary search.
+        - The sequence numbers of the messages of each message type, engine and task are kept in posting lists, thus queries for a rare type, engine or task only visit matching messages.
+        - The messages are grouped in blocks of 64 and the store keeps the blocks containing each case folded trigram (sequence of three characters). Text
+          queries only visit the blocks containing all trigrams of the text.
+
+        Messages are returned newest first:
+
+\code
+LogQuery query;
+query.message_types = Logger::Error | Logger::Fatal;
+query.text = "connection refused";
+query.from = QDateTime::currentDateTime().addSecs(-600);
+QList<LogStoreEntry> entries = Log->sessionLogStore()->query(query);
+\endcode
+
+        All functions are thread safe. Adding messages and queries are serialized by a read write lock, thus queries run concurrently with each other.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class LOGGING_SHARED_EXPORT SessionLogStore
+        {
+        public:
+            //! Constructs a store keeping the newest \p capacity messages.
+            SessionLogStore(int capacity = 1000000);
+            ~SessionLogStore();
+
+            //! Adds a message to the store.
+            /*!
+              Called by the logger for every message logged through it. The time of the message is the current time, or the time of the
+              previous message if the clock went backwards.
+
+              \param task_id The ID of the task logging the message, -1 when it is not logged by a task.
+              */
+            void addMessage(const QString& engine_name, Logger::MessageType message_type, const QList<QVariant>& message_contents, int task_id = -1);
+            //! Adds a batch of records to the store, see addMessage().
+            void addRecords(const QList<LoggerRecord>& records);
+            //! Removes all messages from the store.
+            void clear();
+
+            //! Returns the messages matching \p query, newest first.
+            QList<LogStoreEntry> query(const LogQuery& query) const;
+            //! Returns the names of the engines of the messages in the store, sorted alphabetically. System wide messages are not included.
+            QStringList engineNames() const;
+            //! Returns the IDs of the tasks of the messages in the store, sorted ascending.
+            QList<int> taskIds() const;
+
+            //! Returns the maximum number of messages kept by the store.
+            int capacity() const;
+            //! Returns the number of messages in the store.
+            int count() const;
+            //! Returns the number of messages added to the store since it was constructed or last cleared, including the messages which were overwritten.
+            qint64 totalCount() const;
+
+        private:
+            Q_DISABLE_COPY(SessionLogStore)
+            SessionLogStorePrivateData* d;
+        };
+    }
+}
+
+#endif // SESSION_LOG_STORE_H
@@ -0,0 +1,347 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "SettingsStore.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QRunnable>
+#include <QSettings>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+
+using namespace Qtilities::Logging;
+
+struct Qtilities::Logging::SettingsStorePrivateData {
+    SettingsStorePrivateData() : flush_timer(0),
+        write_delay(500),
+        flush_requested(false),
+        write_in_progress(false) { }
+
+    //! Saves the pending writes to the file. Called on the write thread, or in the calling thread by sync().
+    void writePending();
+
+    QString                 file_name;
+    QTimer*                 flush_timer;
+
+    //! Protects all members below.
+    mutable QMutex          cache_mutex;
+    QMap<QString,QVariant>  values;
+    //! The keys set since the last write, with their last values.
+    QMap<QString,QVariant>  pending_sets;
+    //! The keys and groups removed since the last write, in the order in which they were removed.
+    QStringList             pending_removes;
+    int                     write_delay;
+    bool                    flush_requested;
+    bool                    write_in_progress;
+
+    //! Serializes access to the file. Held for the duration of every load and write.
+    QMutex                  file_mutex;
+};
+
+namespace {
+    // The thread on which stores are saved. A single thread keeps the writes to each file in order:
+    class qti_private_SettingsWritePool : public QThreadPool {
+    public:
+        qti_private_SettingsWritePool() {
+            setMaxThreadCount(1);
+        }
+    };
+
+    struct qti_private_SettingsStoreRegistry {
+        QMutex                          mutex;
+        QHash<QString,SettingsStore*>   stores;
+    };
+
+    class qti_private_SettingsWriter : public QRunnable {
+    public:
+        qti_private_SettingsWriter(SettingsStorePrivateData* store_data) : d(store_data) {}
+        void run() {
+            d->writePending();
+        }
+
+    private:
+        SettingsStorePrivateData* d;
+    };
+
+    // Drops the entries for key, and for all keys in the group key, from map.
+    template <typename T>
+    QStringList qti_private_removeGroup(QMap<QString,T>& map, const QString& key) {
+        QStringList removed_keys;
+        if (map.remove(key) > 0)
+            removed_keys << key;
+
+        const QString group_prefix = key + "/";
+        typename QMap<QString,T>::iterator itr = map.lowerBound(group_prefix);
+        while (itr != map.end() && itr.key().startsWith(group_prefix)) {
+            removed_keys << itr.key();
+            itr = map.erase(itr);
+        }
+        return removed_keys;
+    }
+
+    void qti_private_syncAllSettingsStores() {
+        SettingsStore::syncAll();
+    }
+}
+
+Q_GLOBAL_STATIC(qti_private_SettingsWritePool, qti_private_settingsWritePool)
+Q_GLOBAL_STATIC(qti_private_SettingsStoreRegistry, qti_private_settingsStoreRegistry)
+
+void Qtilities::Logging::SettingsStorePrivateData::writePending() {
+    QMutexLocker file_locker(&file_mutex);
+
+    cache_mutex.lock();
+    QMap<QString,QVariant> sets = pending_sets;
+    QStringList removes = pending_removes;
+    pending_sets.clear();
+    pending_removes.clear();
+    write_in_progress = !sets.isEmpty() || !removes.isEmpty();
+    cache_mutex.unlock();
+
+    if (sets.isEmpty() && removes.isEmpty())
+        return;
+
+    // Removals are applied first. Keys set after a group was removed are still in sets:
+    QSettings settings(file_name,QSettings::IniFormat);
+    for (int i = 0; i < removes.count(); ++i)
+        settings.remove(removes.at(i));
+    QMap<QString,QVariant>::const_iterator itr = sets.constBegin();
+    while (itr != sets.constEnd()) {
+        settings.setValue(itr.key(),itr.value());
+        ++itr;
+    }
+    settings.sync();
+
+    QMutexLocker cache_locker(&cache_mutex);
+    write_in_progress = false;
+}
+
+Qtilities::Logging::SettingsStore* Qtilities::Logging::SettingsStore::store(const QString& file_name) {
+    const QString clean_path = QDir::cleanPath(QDir::fromNativeSeparators(QFileInfo(file_name).absoluteFilePath()));
+
+    qti_private_SettingsStoreRegistry* registry = qti_private_settingsStoreRegistry();
+    QMutexLocker locker(&registry->mutex);
+    SettingsStore* settings_store = registry->stores.value(clean_path,0);
+    if (!settings_store) {
+        if (registry->stores.isEmpty())
+            qAddPostRoutine(qti_private_syncAllSettingsStores);
+
+        settings_store = new SettingsStore(clean_path);
+        // Flushes are scheduled using a timer, thus the store must live in a thread with an event loop:
+        if (QCoreApplication::instance() && settings_store->thread() != QCoreApplication::instance()->thread())
+            settings_store->moveToThread(QCoreApplication::instance()->thread());
+        registry->stores[clean_path] = settings_store;
+    }
+    return settings_store;
+}
+
+void Qtilities::Logging::SettingsStore::syncAll() {
+    qti_private_SettingsStoreRegistry* registry = qti_private_settingsStoreRegistry();
+    if (!registry)
+        return;
+
+    registry->mutex.lock();
+    QList<SettingsStore*> stores = registry->stores.values();
+    registry->mutex.unlock();
+
+    for (int i = 0; i < stores.count(); ++i)
+        stores.at(i)->sync();
+}
+
+Qtilities::Logging::SettingsStore::SettingsStore(const QString& file_name) : QObject(0) {
+    d = new SettingsStorePrivateData;
+    d->file_name = file_name;
+    loadFile(&d->values);
+
+    d->flush_timer = new QTimer(this);
+    d->flush_timer->setSingleShot(true);
+    connect(d->flush_timer,SIGNAL(timeout()),SLOT(flush()));
+}
+
+Qtilities::Logging::SettingsStore::~SettingsStore() {
+    sync();
+    // Writes queued before sync() refer to our private data:
+    if (qti_private_settingsWritePool())
+        qti_private_settingsWritePool()->waitForDone();
+    delete d;
+}
+
+QString Qtilities::Logging::SettingsStore::fileName() const {
+    return d->file_name;
+}
+
+QVariant Qtilities::Logging::SettingsStore::value(const QString& key, const QVariant& default_value) const {
+    QMutexLocker locker(&d->cache_mutex);
+    QMap<QString,QVariant>::const_iterator itr = d->values.constFind(key);
+    if (itr == d->values.constEnd())
+        return default_value;
+    return itr.value();
+}
+
+bool Qtilities::Logging::SettingsStore::contains(const QString& key) const {
+    QMutexLocker locker(&d->cache_mutex);
+    return d->values.contains(key);
+}
+
+QStringList Qtilities::Logging::SettingsStore::allKeys() const {
+    QMutexLocker locker(&d->cache_mutex);
+    return d->values.keys();
+}
+
+QStringList Qtilities::Logging::SettingsStore::childKeys(const QString& group) const {
+    QStringList child_keys;
+    const QString group_prefix = group.isEmpty() ? QString() : group + "/";
+
+    QMutexLocker locker(&d->cache_mutex);
+    QMap<QString,QVariant>::const_iterator itr = d->values.lowerBound(group_prefix);
+    while (itr != d->values.constEnd() && itr.key().startsWith(group_prefix)) {
+        const QString child_key = itr.key().mid(group_prefix.length());
+        if (!child_key.contains(QLatin1Char('/')))
+            child_keys << child_key;
+        ++itr;
+    }
+    return child_keys;
+}
+
+void Qtilities::Logging::SettingsStore::setValue(const QString& key, const QVariant& value) {
+    if (key.isEmpty())
+        return;
+
+    bool schedule = false;
+    d->cache_mutex.lock();
+    QMap<QString,QVariant>::iterator itr = d->values.find(key);
+    if (itr != d->values.end() && itr.value() == value) {
+        d->cache_mutex.unlock();
+        return;
+    }
+    d->values[key] = value;
+    d->pending_sets[key] = value;
+    if (!d->flush_requested) {
+        d->flush_requested = true;
+        schedule = true;
+    }
+    d->cache_mutex.unlock();
+
+    if (schedule)
+        startFlush(false);
+    emit valueChanged(key,value);
+}
+
+void Qtilities::Logging::SettingsStore::remove(const QString& key) {
+    if (key.isEmpty())
+        return;
+
+    bool schedule = false;
+    d->cache_mutex.lock();
+    QStringList removed_keys = qti_private_removeGroup(d->values,key);
+    qti_private_removeGroup(d->pending_sets,key);
+    d->pending_removes << key;
+    if (!d->flush_requested) {
+        d->flush_requested = true;
+        schedule = true;
+    }
+    d->cache_mutex.unlock();
+
+    if (schedule)
+        startFlush(false);
+    for (int i = 0; i < removed_keys.count(); ++i)
+        emit valueChanged(removed_keys.at(i),QVariant());
+}
+
+void Qtilities::Logging::SettingsStore::setWriteDelay(int msec) {
+    QMutexLocker locker(&d->cache_mutex);
+    d->write_delay = qMax(0,msec);
+}
+
+int Qtilities::Logging::SettingsStore::writeDelay() const {
+    QMutexLocker locker(&d->cache_mutex);
+    return d->write_delay;
+}
+
+bool Qtilities::Logging::SettingsStore::hasPendingWrites() const {
+    QMutexLocker locker(&d->cache_mutex);
+    return d->write_in_progress || !d->pending_sets.isEmpty() || !d->pending_removes.isEmpty();
+}
+
+void Qtilities::Logging::SettingsStore::sync() {
+    startFlush(true);
+}
+
+void Qtilities::Logging::SettingsStore::reload() {
+    sync();
+
+    QMap<QString,QVariant> loaded_values;
+    loadFile(&loaded_values);
+
+    d->cache_mutex.lock();
+    QMap<QString,QVariant> old_values = d->values;
+    d->values = loaded_values;
+    d->cache_mutex.unlock();
+
+    QMap<QString,QVariant>::const_iterator itr = loaded_values.constBegin();
+    while (itr != loaded_values.constEnd()) {
+        QMap<QString,QVariant>::iterator old_itr = old_values.find(itr.key());
+        if (old_itr == old_values.end() || old_itr.value() != itr.value())
+            emit valueChanged(itr.key(),itr.value());
+        if (old_itr != old_values.end())
+            old_values.erase(old_itr);
+        ++itr;
+    }
+    // Keys which are left were removed from the file:
+    QMap<QString,QVariant>::const_iterator removed_itr = old_values.constBegin();
+    while (removed_itr != old_values.constEnd()) {
+        emit valueChanged(removed_itr.key(),QVariant());
+        ++removed_itr;
+    }
+}
+
+void Qtilities::Logging::SettingsStore::flush() {
+    d->cache_mutex.lock();
+    d->flush_requested = false;
+    d->cache_mutex.unlock();
+
+    qti_private_settingsWritePool()->start(new qti_private_SettingsWriter(d));
+}
+
+void Qtilities::Logging::SettingsStore::scheduleFlush() {
+    d->flush_timer->start(writeDelay());
+}
+
+void Qtilities::Logging::SettingsStore::loadFile(QMap<QString,QVariant>* values) const {
+    QMutexLocker file_locker(&d->file_mutex);
+    QSettings settings(d->file_name,QSettings::IniFormat);
+    const QStringList keys = settings.allKeys();
+    for (int i = 0; i < keys.count(); ++i)
+        values->insert(keys.at(i),settings.value(keys.at(i)));
+}
+
+void Qtilities::Logging::SettingsStore::startFlush(bool wait) {
+    // Without an event loop, or when the caller waits for the write, the pending writes are saved in the calling thread. A write
+    // which was queued on the write thread before then finds nothing left to save:
+    if (wait || !QCoreApplication::instance()) {
+        d->cache_mutex.lock();
+        d->flush_requested = false;
+        d->cache_mutex.unlock();
+        d->writePending();
+        return;
+    }
+
+    if (QThread::currentThread() == thread())
+        scheduleFlush();
+    else
+        QMetaObject::invokeMethod(this,"scheduleFlush",Qt::QueuedConnection);
+}
@@ -0,0 +1,145 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include "Logging_global.h"
+
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+namespace Qtilities {
+    namespace Logging {
+        /*!
+        \struct SettingsStorePrivateData
+        \brief Structure used by SettingsStore to store private data.
+          */
+        struct SettingsStorePrivateData;
+
+        /*!
+        \class SettingsStore
+        \brief A cached, write-behind store for the settings in an ini file.
+
+        Constructing a QSettings object parses its file, and writing to it saves the file again. On network home directories and roaming profiles
+        this is slow, and %Qtilities classes used to do both every time they loaded or saved their settings, often in the GUI thread. A settings store
+        reads its file once when it is created and answers all reads from memory. Writes update the memory cache immediately, and are saved to the file
+        on a background thread after writeDelay() milliseconds. All writes made during the delay are coalesced into a single save, in which only the
+        last value of each key is written.
+
+        There is one store per file, which is returned by store(). The store for the %Qtilities settings file is also available through
+        Qtilities::Core::QtilitiesCoreApplication::qtilitiesSettings(). Keys are full paths which include their groups:
+
+\code
+SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+bool open_last = settings->valueAs<bool>("Qtilities/Projects/open_last_project",false);
+settings->setValue("Qtilities/Projects/open_last_project",true);
+\endcode
+
+        When a value changes, valueChanged() is emitted with the key and the new value. Removed keys are reported with invalid values.
+
+        Pending writes are saved when the application exits. Call sync() to save them right away, for example before another process reads the file.
+        All functions are thread safe.
+
+        \note The store does not watch its file. Changes made to the file by other processes, or through QSettings objects, are only seen after reload().
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class LOGGING_SHARED_EXPORT SettingsStore : public QObject
+        {
+            Q_OBJECT
+
+        public:
+            //! Returns the store for the ini file at \p file_name, creating and loading it when it is used for the first time.
+            /*!
+              Stores are created once per file and live until the application exits. Different paths to the same file return the same store.
+              */
+            static SettingsStore* store(const QString& file_name);
+            //! Saves the pending writes of all stores and waits until they are saved.
+            static void syncAll();
+
+            ~SettingsStore();
+
+            //! Returns the path of the ini file of this store.
+            QString fileName() const;
+
+            //! Returns the value of \p key, or \p default_value when the key does not exist.
+            QVariant value(const QString& key, const QVariant& default_value = QVariant()) const;
+            //! Returns the value of \p key converted to T, or \p default_value when the key does not exist.
+            template <typename T>
+            T valueAs(const QString& key, const T& default_value = T()) const {
+                QVariant result = value(key);
+                if (!result.isValid())
+                    return default_value;
+                return qvariant_cast<T>(result);
+            }
+            //! Indicates if \p key exists.
+            bool contains(const QString& key) const;
+            //! Returns all keys in the store, sorted alphabetically.
+            QStringList allKeys() const;
+            //! Returns the names of the keys directly under \p group, sorted alphabetically.
+            QStringList childKeys(const QString& group) const;
+
+            //! Sets the value of \p key to \p value.
+            /*!
+              The new value is available to value() immediately and is saved to the file after writeDelay() milliseconds.
+              When the value is the same as the current value, nothing is done.
+              */
+            void setValue(const QString& key, const QVariant& value);
+            //! Removes \p key, and all keys in the group \p key when it is a group.
+            void remove(const QString& key);
+
+            //! Sets the time in milliseconds for which writes are collected before they are saved.
+            /*!
+              Default is 500 milliseconds. When 0, writes are saved on the background thread as soon as control returns to the event loop.
+              */
+            void setWriteDelay(int msec);
+            //! Gets the time in milliseconds for which writes are collected before they are saved.
+            int writeDelay() const;
+            //! Indicates if there are writes which were not saved yet.
+            bool hasPendingWrites() const;
+
+        public slots:
+            //! Saves all pending writes and waits until they are saved.
+            void sync();
+            //! Saves all pending writes, and loads the file again.
+            /*!
+              valueChanged() is emitted for every key of which the value changed.
+              */
+            void reload();
+
+        signals:
+            //! Signal which is emitted when the value of \p key changed to \p value.
+            /*!
+              \p value is invalid when the key was removed. The signal is emitted in the thread in which the value was changed.
+              */
+            void valueChanged(const QString& key, const QVariant& value);
+
+        private slots:
+            void flush();
+            void scheduleFlush();
+
+        private:
+            SettingsStore(const QString& file_name);
+            Q_DISABLE_COPY(SettingsStore)
+
+            void loadFile(QMap<QString,QVariant>* values) const;
+            void startFlush(bool wait);
+
+            SettingsStorePrivateData* d;
+        };
+    }
+}
+
+#endif // SETTINGS_STORE_H
@@ -33,6 +33,7 @@
 #include <QNetworkAccessManager>
 #include <QNetworkProxy>
 #include <QPointer>
+#include <QRegExp>
 #include <QtDebug>
 #include <QTimer>
 #include <QUrl>
@@ -44,11 +45,18 @@ using namespace QtilitiesCoreGui;
 using namespace Qtilities::Plugins::Help::Constants;
 using namespace Qtilities::Plugins::Help;
 
+namespace {
+    //! The maximum number of bytes of help content which is cached.
+    const int qti_private_HELP_CONTENT_CACHE_BYTES = 32 * 1024 * 1024;
+    //! The maximum number of linked resources and pages which are prefetched for a single page.
+    const int qti_private_HELP_PREFETCH_LIMIT = 64;
+}
+
 class qti_private_HelpNetworkAccessManager : public QNetworkAccessManager {
     public:
         qti_private_HelpNetworkAccessManager(QHelpEngineCore* helpEngine, QNetworkAccessManager *manager, QObject *parentObject) :
             QNetworkAccessManager(parentObject),
-            d_help_engine(helpEngine)
+            d_content_cache(helpEngine,this)
         {
             Q_ASSERT(manager);
             Q_ASSERT(helpEngine);
@@ -63,30 +71,126 @@ class qti_private_HelpNetworkAccessManager : public QNetworkAccessManager {
         virtual QNetworkReply *createRequest(
             Operation operation, const QNetworkRequest &request, QIODevice *device) {
                 if (request.url().scheme() == "qthelp" && operation == GetOperation)
-                    return new qti_private_HelpNetworkReply(request.url(), d_help_engine);
+                    return new qti_private_HelpNetworkReply(request.url(), &d_content_cache);
                 else
                     return QNetworkAccessManager::createRequest(operation, request, device);
             }
 
-        QPointer<QHelpEngineCore>   d_help_engine;
+        qti_private_HelpContentCache    d_content_cache;
 
     private:
         Q_DISABLE_COPY(qti_private_HelpNetworkAccessManager)
 };
 
 
-qti_private_HelpNetworkReply::qti_private_HelpNetworkReply(const QUrl& url, QHelpEngineCore* help_engine) : QNetworkReply(help_engine) {
+qti_private_HelpContentCache::qti_private_HelpContentCache(QHelpEngineCore* help_engine, QObject* parent) : QObject(parent) {
     Q_ASSERT(help_engine);
 
     d_help_engine = help_engine;
+    d_cache.setMaxCost(qti_private_HELP_CONTENT_CACHE_BYTES);
+    d_prefetch_timer.setSingleShot(true);
+    d_prefetch_timer.setInterval(0);
+    connect(&d_prefetch_timer,SIGNAL(timeout()),SLOT(prefetchNext()));
+    connect(help_engine,SIGNAL(setupFinished()),SLOT(clear()));
+}
+
+QByteArray qti_private_HelpContentCache::fileData(const QUrl& url) {
+    const QString key = url.toString();
+    QByteArray* cached_data = d_cache.object(key);
+    if (cached_data)
+        return *cached_data;
+
+    QByteArray data = readFileData(url);
+    // Pages are only read once per navigation, thus their links are queued here:
+    queueLinkedContent(url,data);
+    return data;
+}
+
+void qti_private_HelpContentCache::clear() {
+    d_cache.clear();
+    d_prefetch_queue.clear();
+    d_prefetch_queued.clear();
+}
+
+void qti_private_HelpContentCache::prefetchNext() {
+    // A single item is read per event loop iteration, thus requests for pages are never delayed by more than one item:
+    while (!d_prefetch_queue.isEmpty()) {
+        const QString key = d_prefetch_queue.takeFirst();
+        d_prefetch_queued.remove(key);
+        if (d_cache.contains(key))
+            continue;
+
+        readFileData(QUrl(key));
+        break;
+    }
+
+    if (!d_prefetch_queue.isEmpty())
+        d_prefetch_timer.start();
+}
+
+QByteArray qti_private_HelpContentCache::readFileData(const QUrl& url) {
+    if (!d_help_engine)
+        return QByteArray();
+
+    QByteArray data = d_help_engine->fileData(url);
+    // Missing content is not cached, the documentation providing it might still be registered:
+    if (!data.isEmpty())
+        d_cache.insert(url.toString(),new QByteArray(data),data.size());
+    return data;
+}
+
+void qti_private_HelpContentCache::queueLinkedContent(const QUrl& page_url, const QByteArray& page_data) {
+    const QString path = page_url.path().toLower();
+    if (!(path.endsWith(".html") || path.endsWith(".htm")))
+        return;
+
+    // Resources like images and style sheets are prefetched before linked pages:
+    QStringList resources;
+    QStringList pages;
+    const QString page_text = QString::fromUtf8(page_data.constData(),page_data.size());
+    QRegExp link_exp("(src|href)\\s*=\\s*[\"']([^\"'#]+)",Qt::CaseInsensitive);
+    int pos = 0;
+    while ((pos = link_exp.indexIn(page_text,pos)) != -1 && resources.count() + pages.count() < qti_private_HELP_PREFETCH_LIMIT) {
+        pos += link_exp.matchedLength();
+
+        QUrl link_url = page_url.resolved(QUrl(link_exp.cap(2)));
+        if (link_url.scheme() != page_url.scheme() || link_url.host() != page_url.host())
+            continue;
+
+        const QString key = link_url.toString();
+        if (d_prefetch_queued.contains(key) || d_cache.contains(key))
+            continue;
+
+        d_prefetch_queued.insert(key);
+        if (link_exp.cap(1).toLower() == "src" || !link_url.path().toLower().contains(".htm"))
+            resources << key;
+        else
+            pages << key;
+    }
+
+    if (resources.isEmpty() && pages.isEmpty())
+        return;
+
+    // Links of the latest page are prefetched first:
+    d_prefetch_queue = resources + pages + d_prefetch_queue;
+    // Links of pages which were left long ago are dropped:
+    while (d_prefetch_queue.count() > 4 * qti_private_HELP_PREFETCH_LIMIT)
+        d_prefetch_queued.remove(d_prefetch_queue.takeLast());
+    d_prefetch_timer.start();
+}
+
+qti_private_HelpNetworkReply::qti_private_HelpNetworkReply(const QUrl& url, qti_private_HelpContentCache* content_cache) : QNetworkReply(content_cache) {
+    Q_ASSERT(content_cache);
+
+    d_content_cache = content_cache;
     setUrl(url);
 
     QTimer::singleShot(0, this, SLOT(process()));
 }
 
 void qti_private_HelpNetworkReply::process() {
-    if (d_help_engine) {
-        QByteArray rawData = d_help_engine->fileData(url());
+    if (d_content_cache) {
+        QByteArray rawData = d_content_cache->fileData(url());
         d_buffer.setData(rawData);
         d_buffer.open(QIODevice::ReadOnly);
 
@@ -17,7 +17,11 @@
 #include <QMainWindow>
 #include <QtNetwork/QNetworkReply>
 #include <QBuffer>
+#include <QCache>
 #include <QPointer>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
 
 namespace Ui {
     class HelpMode;
@@ -33,11 +37,49 @@ namespace Qtilities {
         namespace Help {
             using namespace Qtilities::CoreGui::Interfaces;
 
+            //! Caches the help content read from the help engine, and prefetches the resources linked from pages.
+            /*!
+              Content is read from compressed .qch storage by QHelpEngineCore::fileData(), which is expensive when the same pages and images are
+              requested again while navigating back and forth. The most recently used content is kept in a cache keyed by URL. When a page is read,
+              the resources and pages it links to are queued and read into the cache while the application is idle. QHelpEngineCore can't be
+              used from other threads, thus prefetching is done in small steps in the thread of the help engine.
+              */
+            class qti_private_HelpContentCache : public QObject
+            {
+                Q_OBJECT
+             public:
+                qti_private_HelpContentCache(QHelpEngineCore* helpEngine, QObject* parent = 0);
+
+                //! Returns the content at \p url, from the cache when available.
+                QByteArray fileData(const QUrl& url);
+
+            public slots:
+                //! Discards all cached content, done when the registered documentation changes.
+                void clear();
+
+            private slots:
+                void prefetchNext();
+
+            private:
+                //! Reads the content at \p url from the help engine and caches it.
+                QByteArray readFileData(const QUrl& url);
+                //! Queues the resources and pages linked from a page for prefetching.
+                void queueLinkedContent(const QUrl& page_url, const QByteArray& page_data);
+
+                QPointer<QHelpEngineCore>   d_help_engine;
+                QCache<QString,QByteArray>  d_cache;
+                QStringList                 d_prefetch_queue;
+                QSet<QString>               d_prefetch_queued;
+                QTimer                      d_prefetch_timer;
+
+                Q_DISABLE_COPY(qti_private_HelpContentCache)
+            };
+
             class qti_private_HelpNetworkReply : public QNetworkReply
             {
                 Q_OBJECT
              public:
-                qti_private_HelpNetworkReply(const QUrl& url, QHelpEngineCore* helpEngine);
+                qti_private_HelpNetworkReply(const QUrl& url, qti_private_HelpContentCache* contentCache);
 
                 virtual void abort() {}
                 virtual qint64 bytesAvailable() const {
@@ -55,8 +97,8 @@ namespace Qtilities {
                     return d_buffer.read(data, maxSize);
                 }
 
-                QPointer<QHelpEngineCore>   d_help_engine;
-                QBuffer                     d_buffer;
+                QPointer<qti_private_HelpContentCache>  d_content_cache;
+                QBuffer                                 d_buffer;
 
             private:
                 Q_DISABLE_COPY(qti_private_HelpNetworkReply)
@@ -41,10 +41,12 @@ HEADERS +=  \
             source/SessionLogPluginConstants.h \
             source/SessionLogPlugin_global.h \
             source/SessionLogPlugin.h \
+            source/SessionLogQueryWidget.h \
 
 SOURCES +=  \
             source/SessionLogMode.cpp \
             source/SessionLogPlugin.cpp \
+            source/SessionLogQueryWidget.cpp \
 
 RESOURCES += \
             resources/SessionLogPlugin.qrc \
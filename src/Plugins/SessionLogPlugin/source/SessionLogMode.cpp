@@ -11,6 +11,7 @@
 
 #include "SessionLogMode.h"
 #include "SessionLogPluginConstants.h"
+#include "SessionLogQueryWidget.h"
 
 #include <QtilitiesCoreGui>
 
@@ -37,10 +38,18 @@ Qtilities::Plugins::SessionLog::SessionLogMode::SessionLogMode(QObject* parent)
 
     QString log_widget_name = tr("Session Log");
     QWidget* session_logger_widget = LoggerGui::createLogWidget(&log_widget_name,
-                                                                WidgetLoggerEngine::AllMessagesPlainTextEdit |
-                                                                WidgetLoggerEngine::WarningsPlainTextEdit |
-                                                                WidgetLoggerEngine::ErrorsPlainTextEdit);
+                                                                WidgetLoggerEngine::AllMessagesListWidget |
+                                                                WidgetLoggerEngine::WarningsListWidget |
+                                                                WidgetLoggerEngine::ErrorsListWidget);
     d->session_mode_widget->setCentralWidget(session_logger_widget);
+
+    // The query dock searches the messages kept by the session log store:
+    if (!Log->sessionLogStoreEnabled())
+        Log->setSessionLogStoreEnabled(true);
+    QDockWidget* query_dock = new QDockWidget(tr("Query Session Log"));
+    query_dock->setObjectName("SessionLogQueryDock");
+    query_dock->setWidget(new SessionLogQueryWidget);
+    d->session_mode_widget->addDockWidget(Qt::BottomDockWidgetArea,query_dock);
 //    if (session_log_dock) {
 //        connect(session_log_dock,SIGNAL(visibilityChanged(bool)),SLOT(handle_dockVisibilityChanged(bool)));
 //        d->session_mode_widget->addDockWidget(Qt::TopDockWidgetArea,session_log_dock);
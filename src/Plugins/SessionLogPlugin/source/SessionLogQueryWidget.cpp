@@ -0,0 +1,198 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "SessionLogQueryWidget.h"
+
+#include <QtilitiesLogging>
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+using namespace QtilitiesLogging;
+
+namespace {
+    // The maximum number of messages shown in the result table:
+    const int qti_private_session_log_query_max_results = 1000;
+}
+
+struct Qtilities::Plugins::SessionLog::SessionLogQueryWidgetPrivateData {
+    SessionLogQueryWidgetPrivateData() : engine_combo(0),
+        task_combo(0),
+        time_range_combo(0),
+        text_edit(0),
+        pattern_edit(0),
+        query_button(0),
+        result_label(0),
+        result_table(0) {}
+
+    QList<QCheckBox*>   type_check_boxes;
+    QComboBox*          engine_combo;
+    QComboBox*          task_combo;
+    QComboBox*          time_range_combo;
+    QLineEdit*          text_edit;
+    QLineEdit*          pattern_edit;
+    QPushButton*        query_button;
+    QLabel*             result_label;
+    QTableWidget*       result_table;
+};
+
+Qtilities::Plugins::SessionLog::SessionLogQueryWidget::SessionLogQueryWidget(QWidget* parent) : QWidget(parent)
+{
+    d = new SessionLogQueryWidgetPrivateData;
+
+    QHBoxLayout* filter_layout = new QHBoxLayout;
+    filter_layout->setMargin(0);
+    QList<Logger::MessageType> message_types;
+    message_types << Logger::Info << Logger::Warning << Logger::Error << Logger::Fatal << Logger::Debug << Logger::Trace;
+    for (int i = 0; i < message_types.count(); ++i) {
+        QCheckBox* check_box = new QCheckBox(Log->logLevelToString(message_types.at(i)));
+        check_box->setProperty("MessageType",(int) message_types.at(i));
+        check_box->setChecked(true);
+        d->type_check_boxes << check_box;
+        filter_layout->addWidget(check_box);
+    }
+
+    d->engine_combo = new QComboBox;
+    d->engine_combo->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    filter_layout->addWidget(d->engine_combo);
+    d->task_combo = new QComboBox;
+    d->task_combo->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    filter_layout->addWidget(d->task_combo);
+
+    d->time_range_combo = new QComboBox;
+    d->time_range_combo->addItem(tr("All Time"),0);
+    d->time_range_combo->addItem(tr("Last Minute"),60);
+    d->time_range_combo->addItem(tr("Last 10 Minutes"),600);
+    d->time_range_combo->addItem(tr("Last Hour"),3600);
+    d->time_range_combo->addItem(tr("Last Day"),86400);
+    filter_layout->addWidget(d->time_range_combo);
+
+    d->text_edit = new QLineEdit;
+    d->text_edit->setPlaceholderText(tr("Containing text"));
+    connect(d->text_edit,SIGNAL(returnPressed()),SLOT(runQuery()));
+    filter_layout->addWidget(d->text_edit,2);
+    d->pattern_edit = new QLineEdit;
+    d->pattern_edit->setPlaceholderText(tr("Matching regular expression"));
+    connect(d->pattern_edit,SIGNAL(returnPressed()),SLOT(runQuery()));
+    filter_layout->addWidget(d->pattern_edit,1);
+
+    d->query_button = new QPushButton(tr("Query"));
+    connect(d->query_button,SIGNAL(clicked()),SLOT(runQuery()));
+    filter_layout->addWidget(d->query_button);
+
+    d->result_table = new QTableWidget(0,5);
+    d->result_table->setHorizontalHeaderLabels(QStringList() << tr("Time") << tr("Type") << tr("Engine") << tr("Task") << tr("Message"));
+    d->result_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    d->result_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    d->result_table->setWordWrap(false);
+    d->result_table->verticalHeader()->hide();
+    d->result_table->horizontalHeader()->setStretchLastSection(true);
+
+    d->result_label = new QLabel;
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->addLayout(filter_layout);
+    layout->addWidget(d->result_table);
+    layout->addWidget(d->result_label);
+
+    refreshFilterChoices();
+    if (!Log->sessionLogStoreEnabled())
+        d->result_label->setText(tr("The session log store is not enabled."));
+}
+
+Qtilities::Plugins::SessionLog::SessionLogQueryWidget::~SessionLogQueryWidget() {
+    delete d;
+}
+
+void Qtilities::Plugins::SessionLog::SessionLogQueryWidget::runQuery() {
+    SessionLogStore* store = Log->sessionLogStore();
+    if (!store) {
+        d->result_label->setText(tr("The session log store is not enabled."));
+        return;
+    }
+
+    LogQuery query;
+    query.message_types = Logger::MessageTypeFlags();
+    for (int i = 0; i < d->type_check_boxes.count(); ++i) {
+        if (d->type_check_boxes.at(i)->isChecked())
+            query.message_types |= (Logger::MessageType) d->type_check_boxes.at(i)->property("MessageType").toInt();
+    }
+    query.engine_name = d->engine_combo->itemData(d->engine_combo->currentIndex()).toString();
+    query.task_id = d->task_combo->itemData(d->task_combo->currentIndex()).toInt();
+    const int range_secs = d->time_range_combo->itemData(d->time_range_combo->currentIndex()).toInt();
+    if (range_secs > 0)
+        query.from = QDateTime::currentDateTime().addSecs(-range_secs);
+    query.text = d->text_edit->text();
+    if (!d->pattern_edit->text().isEmpty()) {
+        query.pattern = QRegExp(d->pattern_edit->text(),Qt::CaseInsensitive);
+        if (!query.pattern.isValid()) {
+            d->result_label->setText(tr("Invalid regular expression: %1").arg(query.pattern.errorString()));
+            return;
+        }
+    }
+    query.max_results = qti_private_session_log_query_max_results;
+
+    QElapsedTimer timer;
+    timer.start();
+    const QList<LogStoreEntry> entries = store->query(query);
+    const qint64 query_msecs = timer.elapsed();
+
+    d->result_table->setUpdatesEnabled(false);
+    d->result_table->clearContents();
+    d->result_table->setRowCount(entries.count());
+    for (int row = 0; row < entries.count(); ++row) {
+        const LogStoreEntry& entry = entries.at(row);
+        d->result_table->setItem(row,0,new QTableWidgetItem(entry.timestamp.toString("yyyy-MM-dd hh:mm:ss.zzz")));
+        d->result_table->setItem(row,1,new QTableWidgetItem(Log->logLevelToString(entry.message_type)));
+        d->result_table->setItem(row,2,new QTableWidgetItem(entry.engine_name));
+        d->result_table->setItem(row,3,new QTableWidgetItem(entry.task_id == -1 ? QString() : QString::number(entry.task_id)));
+        d->result_table->setItem(row,4,new QTableWidgetItem(entry.message));
+    }
+    d->result_table->resizeColumnsToContents();
+    d->result_table->setUpdatesEnabled(true);
+
+    if (entries.count() == query.max_results)
+        d->result_label->setText(tr("Showing the newest %1 results of %2 stored messages, found in %3 ms.").arg(entries.count()).arg(store->count()).arg(query_msecs));
+    else
+        d->result_label->setText(tr("%1 results of %2 stored messages, found in %3 ms.").arg(entries.count()).arg(store->count()).arg(query_msecs));
+
+    refreshFilterChoices();
+}
+
+void Qtilities::Plugins::SessionLog::SessionLogQueryWidget::refreshFilterChoices() {
+    SessionLogStore* store = Log->sessionLogStore();
+    const QString current_engine = d->engine_combo->itemData(d->engine_combo->currentIndex()).toString();
+    const int current_task = d->task_combo->count() > 0 ? d->task_combo->itemData(d->task_combo->currentIndex()).toInt() : -1;
+
+    d->engine_combo->clear();
+    d->engine_combo->addItem(tr("All Engines"),QString());
+    d->task_combo->clear();
+    d->task_combo->addItem(tr("All Tasks"),-1);
+    if (store) {
+        const QStringList engine_names = store->engineNames();
+        for (int i = 0; i < engine_names.count(); ++i)
+            d->engine_combo->addItem(engine_names.at(i),engine_names.at(i));
+        const QList<int> task_ids = store->taskIds();
+        for (int i = 0; i < task_ids.count(); ++i)
+            d->task_combo->addItem(tr("Task %1").arg(task_ids.at(i)),task_ids.at(i));
+    }
+
+    d->engine_combo->setCurrentIndex(qMax(0,d->engine_combo->findData(current_engine)));
+    d->task_combo->setCurrentIndex(qMax(0,d->task_combo->findData(current_task)));
+}
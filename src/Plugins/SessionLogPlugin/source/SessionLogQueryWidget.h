@@ -0,0 +1,59 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef SESSIONLOGQUERYWIDGET_H
+#define SESSIONLOGQUERYWIDGET_H
+
+#include <QWidget>
+
+namespace Qtilities {
+    namespace Plugins {
+        namespace SessionLog {
+            /*!
+              \struct SessionLogQueryWidgetPrivateData
+              \brief The SessionLogQueryWidgetPrivateData struct stores private data used by the SessionLogQueryWidget class.
+             */
+            struct SessionLogQueryWidgetPrivateData;
+
+            /*!
+            \class SessionLogQueryWidget
+            \brief A filter bar and result table which query the session log store of the logger.
+
+            The filter bar selects the message types, engine, task, time range, text and regular expression of a Qtilities::Logging::LogQuery,
+            which is run on Qtilities::Logging::Logger::sessionLogStore() when the query button is clicked or return is pressed in one of the text fields.
+            The newest matching messages are shown in the result table, together with the number of results and the time the query took.
+
+            <i>This class was added in %Qtilities v1.5.</i>
+              */
+            class SessionLogQueryWidget : public QWidget
+            {
+                Q_OBJECT
+
+                public:
+                    SessionLogQueryWidget(QWidget* parent = 0);
+                    ~SessionLogQueryWidget();
+
+                public slots:
+                    //! Runs the query selected in the filter bar and shows its results.
+                    void runQuery();
+
+                private slots:
+                    //! Refreshes the engines and tasks which can be selected in the filter bar.
+                    void refreshFilterChoices();
+
+                private:
+                    SessionLogQueryWidgetPrivateData* d;
+            };
+        }
+    }
+}
+
+#endif // SESSIONLOGQUERYWIDGET_H
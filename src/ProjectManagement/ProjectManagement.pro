@@ -39,6 +39,7 @@ HEADERS += \
     source/ProjectManagementConstants.h \
     source/ProjectManagement_global.h \
     source/ProjectManager.h \
+    source/ProjectPathScanner_p.h \
     source/ProjectsBrowser.h \
 
 SOURCES += \
@@ -47,6 +48,7 @@ SOURCES += \
     source/Project.cpp \
     source/ProjectManagementConfig.cpp \
     source/ProjectManager.cpp \
+    source/ProjectPathScanner_p.cpp \
     source/ProjectsBrowser.cpp \
 
 FORMS += \
@@ -16,9 +16,12 @@
 #include <QtilitiesCoreApplication>
 #include <Logger>
 #include <IFactoryProvider>
+#include <CborStream>
 
 #include <QApplication>
 #include <QDomNodeList>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 
 using namespace Qtilities::Core::Interfaces;
 using namespace Qtilities::Core;
@@ -84,6 +87,7 @@ Qtilities::Core::Interfaces::IExportable::ExportModeFlags Qtilities::ProjectMana
     IExportable::ExportModeFlags flags = 0;
     flags |= IExportable::Binary;
     flags |= IExportable::XML;
+    flags |= IExportable::Cbor;
     return flags;
 }
 
@@ -177,6 +181,73 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
     return IExportable::Incomplete;
 }
 
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::ObserverProjectItemWrapper::exportXmlStream(QXmlStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    if (d->observer) {
+        // Add a new element for this observer, the observer is written directly to the stream:
+        writer->writeStartElement("ObserverProjectItemWrapper");
+        IExportable::ExportResultFlags result = d->observer->exportXmlStreamExt(writer,d->export_flags);
+        writer->writeEndElement();
+        return result;
+    } else
+        return IExportable::Incomplete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::ObserverProjectItemWrapper::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported) {
+        reader->skipCurrentElement();
+        return version_check_result;
+    }
+
+    IExportable::ExportResultFlags result = IExportable::Incomplete;
+    bool found_observer = false;
+    while (reader->readNextStartElement()) {
+        if (d->observer && !found_observer && reader->name() == QLatin1String("ObserverProjectItemWrapper")) {
+            found_observer = true;
+            d->observer->setExportVersion(exportVersion());
+            result = d->observer->importXmlStream(reader,import_list);
+        } else
+            reader->skipCurrentElement();
+    }
+
+    return result;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::ObserverProjectItemWrapper::exportCbor(CborStreamWriter* writer) const {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported)
+        return version_check_result;
+
+    // The observer is written directly to the stream, null is written when there is no observer:
+    if (d->observer) {
+        d->observer->setExportVersion(exportVersion());
+        return d->observer->exportCborExt(writer,d->export_flags);
+    } else {
+        writer->writeNull();
+        return IExportable::Incomplete;
+    }
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::ObserverProjectItemWrapper::importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesImportVersion(exportVersion(),exportTask());
+    if (version_check_result != IExportable::VersionSupported) {
+        reader->next();
+        return version_check_result;
+    }
+
+    if (!d->observer || !reader->isMap()) {
+        reader->next();
+        return IExportable::Incomplete;
+    }
+
+    d->observer->setExportVersion(exportVersion());
+    return d->observer->importCbor(reader,import_list);
+}
+
 void Qtilities::ProjectManagement::ObserverProjectItemWrapper::setExportItemFlags(ObserverData::ExportItemFlags flags) {
     d->export_flags = flags;
 }
@@ -74,6 +74,10 @@ OBJECT_MANAGER->registerObject(project_item,QtilitiesCategory("Core::Project Ite
             virtual IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
             virtual IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
             virtual IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            virtual IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            virtual IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
+            virtual IExportable::ExportResultFlags exportCbor(CborStreamWriter* writer) const;
+            virtual IExportable::ExportResultFlags importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
             //! Sets the export item flags to be used for this project item.
             /*!
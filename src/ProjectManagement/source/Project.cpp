@@ -19,16 +19,32 @@
 #include <QtilitiesApplication>
 #include <FileUtils>
 
+#include <QBuffer>
 #include <QFileInfo>
+#include <QMap>
 #include <QDomElement>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
 #include <QApplication>
 #include <QCursor>
 #include <QMessageBox>
 
 #include <FileLocker>
+#include <CborStream>
+#include <CompactBinaryFormat>
+#include <CompressedDevice>
+#include <Task>
+
+#include <QElapsedTimer>
+#include <QRunnable>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
 
 #include <stdio.h>
 #include <time.h>
+#include <limits.h>
 
 using namespace Qtilities::ProjectManagement::Constants;
 using namespace Qtilities;
@@ -36,16 +52,178 @@ using namespace Qtilities::Core;
 
 struct Qtilities::ProjectManagement::ProjectPrivateData {
     ProjectPrivateData(): project_file(QString()),
-    project_name(QObject::tr("New Project")) {}
+    project_name(QObject::tr("New Project")),
+    updating_modification_state(false),
+    compacting(false),
+    loading_cancelled(false) {}
 
     QList<IProjectItem*>    project_items;
     QString                 project_file;
     QString                 project_name;
-    QMutex                  modification_mutex;
+    //! The project items which reported that they are modified, maintained by handleProjectItemModificationStateChanged().
+    QSet<IProjectItem*>     modified_items;
+    //! Set while setModificationState() notifies the project items, the notifications they emit in turn are not forwarded.
+    bool                    updating_modification_state;
+    //! Indicates that the project is saved completely by compactProject(), thus the journal must not be used.
+    bool                    compacting;
+    //! Set by cancelLoading(), checked by loadProject() after each project item.
+    bool                    loading_cancelled;
 
     FileLocker              file_locker;
 };
 
+namespace {
+    using namespace Qtilities::Core::Interfaces;
+    using namespace Qtilities::ProjectManagement::Interfaces;
+
+    //! Reads a project file into memory on a worker thread, decompressing compressed project files.
+    class qti_private_ProjectFileReader : public QThread {
+    public:
+        qti_private_ProjectFileReader(const QString& file_name) : QThread(), file_name(file_name), success(false) {}
+
+        void run() {
+            QFile file(file_name);
+            if (!file.open(QIODevice::ReadOnly)) {
+                error_string = file.errorString();
+                return;
+            }
+
+            if (CompressedDevice::isCompressed(&file)) {
+                CompressedDevice compressed_device(&file);
+                if (!compressed_device.open(QIODevice::ReadOnly)) {
+                    error_string = compressed_device.errorString();
+                    return;
+                }
+                data = compressed_device.readAll();
+            } else
+                data = file.readAll();
+            success = true;
+        }
+
+        QString     file_name;
+        QByteArray  data;
+        QString     error_string;
+        bool        success;
+    };
+
+    //! Exports a project item into its own buffer on a worker thread, see ProjectManager::setParallelProjectSaving().
+    /*!
+      Binary exports are written to \p buffer using the format of the project's stream. XML exports are written to \p buffer
+      using a QXmlStreamWriter inside a ProjectItem element, or to \p doc when \p dom is true.
+      */
+    class qti_private_ProjectItemExportWorker : public QRunnable {
+    public:
+        qti_private_ProjectItemExportWorker(IProjectItem* item, IExportable::ExportMode export_mode, bool dom, const QDataStream* stream_format) : QRunnable(),
+            item(item),
+            export_mode(export_mode),
+            dom(dom),
+            stream_version(QDataStream::Qt_4_7),
+            byte_order(QDataStream::BigEndian),
+            result(IExportable::Failed),
+            elapsed_msec(0)
+        {
+            if (stream_format) {
+                stream_version = stream_format->version();
+                byte_order = stream_format->byteOrder();
+            }
+            setAutoDelete(false);
+        }
+
+        void run() {
+            QElapsedTimer timer;
+            timer.start();
+            if (export_mode == IExportable::Binary) {
+                QDataStream stream(&buffer,QIODevice::WriteOnly);
+                stream.setVersion(stream_version);
+                stream.setByteOrder(byte_order);
+                result = item->exportBinary(stream);
+            } else if (export_mode == IExportable::Cbor) {
+                // CBOR items can be concatenated, thus the buffer is written as is:
+                QBuffer device(&buffer);
+                device.open(QIODevice::WriteOnly);
+                CborStreamWriter writer(&device);
+                result = item->exportCbor(&writer);
+                if (writer.hasError())
+                    result = IExportable::Failed;
+            } else if (dom) {
+                object_node = doc.createElement("ProjectItem");
+                doc.appendChild(object_node);
+                result = item->exportXml(&doc,&object_node);
+            } else {
+                QXmlStreamWriter writer(&buffer);
+                writer.writeStartElement("ProjectItem");
+                result = item->exportXmlStream(&writer);
+                writer.writeEndElement();
+            }
+            elapsed_msec = timer.elapsed();
+        }
+
+        IProjectItem*                   item;
+        IExportable::ExportMode         export_mode;
+        bool                            dom;
+        QDataStream::Version            stream_version;
+        QDataStream::ByteOrder          byte_order;
+        QByteArray                      buffer;
+        QDomDocument                    doc;
+        QDomElement                     object_node;
+        IExportable::ExportResultFlags  result;
+        qint64                          elapsed_msec;
+    };
+
+    //! Exports the project items supporting \p export_mode concurrently when ProjectManager::parallelProjectSaving() is enabled.
+    /*!
+      Returns a worker for every project item which was exported, at the position of the item. The caller owns the workers.
+      */
+    QVector<qti_private_ProjectItemExportWorker*> qti_private_ExportProjectItems(const QList<IProjectItem*>& items, IExportable::ExportMode export_mode, bool dom, const QDataStream* stream_format = 0) {
+        QVector<qti_private_ProjectItemExportWorker*> workers(items.count(),0);
+        if (!PROJECT_MANAGER->parallelProjectSaving() || QThread::idealThreadCount() < 2)
+            return workers;
+
+        QList<int> exported_items;
+        for (int i = 0; i < items.count(); ++i) {
+            if (items.at(i)->supportedFormats() & export_mode)
+                exported_items << i;
+        }
+        // A single project item does not gain anything from a thread:
+        if (exported_items.count() < 2)
+            return workers;
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(QThread::idealThreadCount());
+        for (int i = 0; i < exported_items.count(); ++i) {
+            int position = exported_items.at(i);
+            // Tasks are not thread safe, thus workers log their messages without it:
+            items.at(position)->clearExportTask();
+            workers[position] = new qti_private_ProjectItemExportWorker(items.at(position),export_mode,dom,stream_format);
+            pool.start(workers.at(position));
+        }
+        pool.waitForDone();
+
+        return workers;
+    }
+
+    //! Copies the content of the ProjectItem element written by a qti_private_ProjectItemExportWorker into the current element of \p writer.
+    void qti_private_WriteProjectItemXml(const QByteArray& buffer, QXmlStreamWriter* writer) {
+        QXmlStreamReader reader(buffer);
+        if (!reader.readNextStartElement())
+            return;
+
+        for (int i = 0; i < reader.namespaceDeclarations().count(); ++i)
+            writer->writeNamespace(reader.namespaceDeclarations().at(i).namespaceUri().toString(),reader.namespaceDeclarations().at(i).prefix().toString());
+        writer->writeAttributes(reader.attributes());
+
+        int depth = 1;
+        while (depth > 0 && !reader.atEnd()) {
+            reader.readNext();
+            if (reader.isStartElement())
+                ++depth;
+            else if (reader.isEndElement() && --depth == 0)
+                break;
+            writer->writeCurrentToken(reader);
+        }
+    }
+}
+
 Qtilities::ProjectManagement::Project::Project(QObject* parent) : QObject(parent), IProject() {
     d = new ProjectPrivateData;
     setObjectName("Project");
@@ -68,6 +246,38 @@ bool Qtilities::ProjectManagement::Project::newProject() {
 }
 
 quint32 MARKER_PROJECT_SECTION = 0xBABEFACE;
+quint32 MARKER_PROJECT_JOURNAL = 0xBABEF00D;
+quint32 MARKER_PROJECT_JOURNAL_RECORD = 0xBABE0ACE;
+
+namespace {
+    QString projectJournalFileName(const QString& project_file) {
+        return project_file + "." + qti_def_SUFFIX_PROJECT_JOURNAL;
+    }
+
+    //! Reads the header of a project journal and checks that the journal belongs to the project file as it currently exists on disk.
+    /*!
+      The size and modification time of the project file are stored in the header when the journal is created. When the project file was replaced,
+      for example by a complete save in a different application instance, the journal is stale.
+      */
+    bool readProjectJournalHeader(QDataStream& stream, const QString& project_file, quint32* export_version, quint32* application_export_version, QStringList* item_names) {
+        quint32 marker = 0;
+        qint64 project_file_size = 0;
+        qint64 project_file_modified = 0;
+        stream >> marker;
+        if (marker != MARKER_PROJECT_JOURNAL)
+            return false;
+        stream >> *export_version;
+        stream >> *application_export_version;
+        stream >> project_file_size;
+        stream >> project_file_modified;
+        stream >> *item_names;
+        if (stream.status() != QDataStream::Ok)
+            return false;
+
+        QFileInfo project_info(project_file);
+        return project_info.size() == project_file_size && project_info.lastModified().toMSecsSinceEpoch() == project_file_modified;
+    }
+}
 
 bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name, ITask* task) {
     if (!PROJECT_MANAGER->projectSavingEnabled()) {
@@ -87,33 +297,63 @@ bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name
 
     LOG_TASK_INFO(tr("Starting to save current project to file: ") + file_name,task);
 
-    if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::XML))) {
+    if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::XML)) || file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::Cbor))) {
         QTemporaryFile file;
         file.open();
 
-        // Create the QDomDocument:
-        QDomDocument doc("QtilitiesXMLProject");
-        QDomElement root = doc.createElement("QtilitiesXMLProject");
-        doc.appendChild(root);
-
-        #ifdef QTILITIES_BENCHMARKING
-        time_t start,end;
-        time(&start);
-        #endif
-        IExportable::setExportTask(task);
-        IExportable::ExportResultFlags success = exportXml(&doc,&root);
-        IExportable::clearExportTask();
-        #ifdef QTILITIES_BENCHMARKING
-        time(&end);
-        double diff = difftime(end,start);
-        LOG_TASK_INFO("Project XML export completed in " + QString::number(diff) + " seconds.",task);
-        #endif
-
-        // Put the complete doc in a string and save it to the file:
-        QString docStr = doc.toString(2);
-        docStr.prepend("<!--Created by " + QApplication::applicationName() + " v" + QApplication::applicationVersion() + " on " + QDateTime::currentDateTime().toString() + "-->\n");
-        docStr.prepend("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
-        file.write(docStr.toUtf8());
+        IExportable::ExportResultFlags success;
+        if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::Cbor))) {
+            // The project is written directly to the file, the self describe tag identifies the file as CBOR:
+            CborStreamWriter writer(&file);
+            writer.writeTag(CborStreamWriter::SelfDescribeTag);
+
+            #ifdef QTILITIES_BENCHMARKING
+            time_t start,end;
+            time(&start);
+            #endif
+            IExportable::setExportTask(task);
+            success = exportCbor(&writer);
+            IExportable::clearExportTask();
+            #ifdef QTILITIES_BENCHMARKING
+            time(&end);
+            double diff = difftime(end,start);
+            LOG_TASK_INFO("Project CBOR export completed in " + QString::number(diff) + " seconds.",task);
+            #endif
+
+            if (writer.hasError()) {
+                LOG_TASK_ERROR(tr("Failed to write the project to a temporary file."),task);
+                success = IExportable::Failed;
+            }
+        } else {
+            // The project is written directly to the file, thus the complete document is never built in memory:
+            QXmlStreamWriter writer(&file);
+            writer.setCodec("UTF-8");
+            writer.setAutoFormatting(true);
+            writer.setAutoFormattingIndent(2);
+            writer.writeStartDocument();
+            writer.writeDTD("<!DOCTYPE QtilitiesXMLProject>");
+            writer.writeComment("Created by " + QApplication::applicationName() + " v" + QApplication::applicationVersion() + " on " + QDateTime::currentDateTime().toString());
+            writer.writeStartElement("QtilitiesXMLProject");
+
+            #ifdef QTILITIES_BENCHMARKING
+            time_t start,end;
+            time(&start);
+            #endif
+            IExportable::setExportTask(task);
+            success = exportXmlStream(&writer);
+            IExportable::clearExportTask();
+            #ifdef QTILITIES_BENCHMARKING
+            time(&end);
+            double diff = difftime(end,start);
+            LOG_TASK_INFO("Project XML export completed in " + QString::number(diff) + " seconds.",task);
+            #endif
+
+            writer.writeEndDocument();
+            if (writer.hasError()) {
+                LOG_TASK_ERROR(tr("Failed to write the project to a temporary file."),task);
+                success = IExportable::Failed;
+            }
+        }
         file.close();
 
         if (success != IExportable::Failed) {
@@ -165,10 +405,25 @@ bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name
 
         return true;
     } else if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::Binary))) {
+        // When saving incrementally, only the modified project items are appended to the journal of the current project file:
+        if (PROJECT_MANAGER->incrementalProjectSaving() && !d->compacting && !d->project_file.isEmpty() && FileUtils::comparePaths(file_name,d->project_file) && QFile::exists(d->project_file)) {
+            QFileInfo journal_info(projectJournalFileName(d->project_file));
+            if (journal_info.exists() && journal_info.size() >= PROJECT_MANAGER->projectJournalLimit())
+                LOG_TASK_INFO(tr("The project journal exceeds its size limit, the complete project will be saved."),task);
+            else if (saveProjectJournal(task))
+                return true;
+        }
+
         QTemporaryFile file;
         file.open();
-        QDataStream stream(&file);
-        if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2)
+        // Compressed projects are compressed block by block while they are exported, thus only the current block of the uncompressed project is kept in memory:
+        CompressedDevice compressed_device(&file);
+        QDataStream stream;
+        if (PROJECT_MANAGER->compressProjects() && compressed_device.open(QIODevice::WriteOnly))
+            stream.setDevice(&compressed_device);
+        else
+            stream.setDevice(&file);
+        if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2 || exportVersion() == Qtilities::Qtilities_1_5)
             stream.setVersion(QDataStream::Qt_4_7);
 
         #ifdef QTILITIES_BENCHMARKING
@@ -184,6 +439,11 @@ bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name
         LOG_TASK_INFO("Project binary export completed in " + QString::number(diff) + " seconds.",task);
         #endif
 
+        if (compressed_device.isOpen()) {
+            compressed_device.close();
+            if (file.error() != QFile::NoError)
+                success = IExportable::Failed;
+        }
         file.close();
 
         if (success != IExportable::Failed) {
@@ -199,6 +459,11 @@ bool Qtilities::ProjectManagement::Project::saveProject(const QString& file_name
             }
             file.copy(d->project_file);
 
+            // The complete project replaces everything which was saved to the journal:
+            QFile journal_file(projectJournalFileName(d->project_file));
+            if (journal_file.exists() && !journal_file.remove())
+                LOG_TASK_WARNING(tr("Failed to remove the project journal at path: ") + journal_file.fileName(),task);
+
             // Only if successfull, check if the new file is different to the old file and handle locks accordingly:
             if (PROJECT_MANAGER->useProjectFileLocks()) {
                 // Unlock the old file:
@@ -244,6 +509,7 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
     if (close_current_first)
         closeProject();
 
+    d->loading_cancelled = false;
     LOG_TASK_INFO_P(tr("Opening project: ") + file_name,task);
     QFile file(file_name);
     if (!file.exists()) {
@@ -254,35 +520,72 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
     d->project_name = QFileInfo(file_name).fileName();
     file.open(QIODevice::ReadOnly);
 
-    if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::XML))) {
-        // Load the file into doc:
-        QDomDocument doc("QtilitiesXMLProject");
-        QString docStr = file.readAll();
-        file.close();
-        QString error_string;
-        int error_line;
-        int error_column;
-        if (!doc.setContent(docStr,&error_string,&error_line,&error_column)) {
-            LOG_TASK_ERROR_P(QString(tr("The tree input file could not be parsed by QDomDocument. Error on line %1 column %2: %3")).arg(error_line).arg(error_column).arg(error_string),task);
-            return false;
-        }
-        QDomElement root = doc.documentElement();
-
-        // Interpret the loaded doc:
+    if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::XML)) || file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::Cbor))) {
+        // Interpret the project:
         QList<QPointer<QObject> > import_list;
+        IExportable::ExportResultFlags success;
+        if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::Cbor))) {
+            // The file is read directly from the stream, the self describe tag written by saveProject() is optional:
+            CborStreamReader reader(&file);
+            if (reader.type() == CborStreamReader::Tag)
+                reader.readTag();
+            if (!reader.isMap()) {
+                if (reader.hasError())
+                    LOG_TASK_ERROR_P(QString(tr("The project file could not be parsed: %1")).arg(reader.errorString()),task);
+                else
+                    LOG_TASK_ERROR_P(tr("The project file does not contain a CBOR project. Project will not be loaded."),task);
+                file.close();
+                return false;
+            }
 
-        #ifdef QTILITIES_BENCHMARKING
-        time_t start,end;
-        time(&start);
-        #endif
-        setExportTask(task);
-        IExportable::ExportResultFlags success = importXml(&doc,&root,import_list);
-        clearExportTask();
-        #ifdef QTILITIES_BENCHMARKING
-        time(&end);
-        double diff = difftime(end,start);
-        LOG_TASK_INFO("Project XML import completed in " + QString::number(diff) + " seconds.",task);
-        #endif
+            #ifdef QTILITIES_BENCHMARKING
+            time_t start,end;
+            time(&start);
+            #endif
+            setExportTask(task);
+            success = importCbor(&reader,import_list);
+            clearExportTask();
+            #ifdef QTILITIES_BENCHMARKING
+            time(&end);
+            double diff = difftime(end,start);
+            LOG_TASK_INFO("Project CBOR import completed in " + QString::number(diff) + " seconds.",task);
+            #endif
+
+            if (reader.hasError()) {
+                LOG_TASK_ERROR_P(QString(tr("The project file could not be parsed: %1")).arg(reader.errorString()),task);
+                success = IExportable::Failed;
+            }
+        } else {
+            // The file is read directly from the stream, thus the complete document is never built in memory:
+            QXmlStreamReader reader(&file);
+            if (!reader.readNextStartElement() || reader.name() != QLatin1String("QtilitiesXMLProject")) {
+                if (reader.hasError())
+                    LOG_TASK_ERROR_P(QString(tr("The project file could not be parsed. Error on line %1 column %2: %3")).arg(reader.lineNumber()).arg(reader.columnNumber()).arg(reader.errorString()),task);
+                else
+                    LOG_TASK_ERROR_P(tr("The project file does not contain a QtilitiesXMLProject element. Project will not be loaded."),task);
+                file.close();
+                return false;
+            }
+
+            #ifdef QTILITIES_BENCHMARKING
+            time_t start,end;
+            time(&start);
+            #endif
+            setExportTask(task);
+            success = importXmlStream(&reader,import_list);
+            clearExportTask();
+            #ifdef QTILITIES_BENCHMARKING
+            time(&end);
+            double diff = difftime(end,start);
+            LOG_TASK_INFO("Project XML import completed in " + QString::number(diff) + " seconds.",task);
+            #endif
+
+            if (reader.hasError()) {
+                LOG_TASK_ERROR_P(QString(tr("The project file could not be parsed. Error on line %1 column %2: %3")).arg(reader.lineNumber()).arg(reader.columnNumber()).arg(reader.errorString()),task);
+                success = IExportable::Failed;
+            }
+        }
+        file.close();
 
         if (success & IExportable::SuccessResult || success == IExportable::Complete) {
             // We change the project name to the selected file name
@@ -304,7 +607,7 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
             // queued QtilitiesPropertyChangeEvents are processed. In some cases this can set the
             // modification state of observers and when these events are delivered later than the
             // setModificationState() call below, it might change the modification state again.
-            QCoreApplication::processEvents();
+            IDLE_SCHEDULER->yieldToEventLoop();
 
             if (!PROJECT_MANAGER->projectChangedDuringLoad())
                 setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
@@ -333,8 +636,49 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
             return false;
         }
     } else if (file_name.endsWith(PROJECT_MANAGER->projectTypeSuffix(IExportable::Binary))) {
-        QDataStream stream(&file);
-        if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2)
+        // When projects are loaded lazily, the file is memory mapped and stays mapped while observers read from it did not import all their subjects yet:
+        const bool lazy_loading = PROJECT_MANAGER->lazyProjectLoading();
+        QSharedPointer<QFile> mapped_file;
+        QByteArray project_data;
+        bool project_data_read = false;
+        // Compressed projects are detected using their signature, thus they can be opened regardless of compressProjects().
+        // Compressed files cannot be mapped, thus deferred subjects are read from the decompressed data in memory:
+        if (lazy_loading && !CompressedDevice::isCompressed(&file)) {
+            mapped_file = QSharedPointer<QFile>(new QFile(file_name));
+            uchar* memory = 0;
+            if (mapped_file->open(QIODevice::ReadOnly) && mapped_file->size() > 0 && mapped_file->size() <= INT_MAX)
+                memory = mapped_file->map(0,mapped_file->size());
+            if (memory) {
+                project_data = QByteArray::fromRawData((const char*) memory,(int) mapped_file->size());
+                project_data_read = true;
+            } else {
+                // Files which cannot be mapped are read into memory, in which case the data owns its contents:
+                LOG_TASK_DEBUG(tr("The project file could not be memory mapped, it will be read into memory instead."),task);
+                mapped_file.clear();
+            }
+        }
+
+        if (!project_data_read) {
+            // The file is read and decompressed on a worker thread, while the event loop keeps the user interface responsive:
+            qti_private_ProjectFileReader reader(file_name);
+            reader.start();
+            while (!reader.wait(20))
+                IDLE_SCHEDULER->yieldToEventLoop();
+            if (!reader.success) {
+                LOG_TASK_ERROR_P(tr("Failed to read project file: ") + reader.error_string,task);
+                return false;
+            }
+            if (d->loading_cancelled) {
+                LOG_TASK_WARNING_P(tr("Opening the project was cancelled."),task);
+                return false;
+            }
+            project_data = reader.data;
+        }
+
+        QBuffer project_buffer(&project_data);
+        project_buffer.open(QIODevice::ReadOnly);
+        QDataStream stream(&project_buffer);
+        if (exportVersion() == Qtilities::Qtilities_1_0 || exportVersion() == Qtilities::Qtilities_1_1 || exportVersion() == Qtilities::Qtilities_1_2 || exportVersion() == Qtilities::Qtilities_1_5)
             stream.setVersion(QDataStream::Qt_4_7);
 
         QList<QPointer<QObject> > import_list;
@@ -343,9 +687,13 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
         time_t start,end;
         time(&start);
         #endif
+        if (lazy_loading)
+            CompactBinaryFormat::setDeferredImportSource(stream,project_data,mapped_file);
         setExportTask(task);
         IExportable::ExportResultFlags success = importBinary(stream,import_list);
         clearExportTask();
+        if (lazy_loading)
+            CompactBinaryFormat::clearDeferredImportSource(stream);
         #ifdef QTILITIES_BENCHMARKING
         time(&end);
         double diff = difftime(end,start);
@@ -354,6 +702,12 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
 
         file.close();
 
+        if (success != IExportable::Failed) {
+            IExportable::ExportResultFlags journal_success = replayProjectJournal(import_list,task);
+            if (journal_success == IExportable::Failed || (journal_success == IExportable::Incomplete && success == IExportable::Complete))
+                success = journal_success;
+        }
+
         if (success != IExportable::Failed) {
             // We change the project name to the selected file name
             QFileInfo fi(d->project_file);
@@ -374,7 +728,7 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
             // queued QtilitiesPropertyChangeEvents are processed. In some cases this can set the
             // modification state of observers and when these events are delivered later than the
             // setModificationState() call below, it might change the modification state again.
-            QCoreApplication::processEvents();
+            IDLE_SCHEDULER->yieldToEventLoop();
 
             if (!PROJECT_MANAGER->projectChangedDuringLoad())
                 setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
@@ -409,6 +763,10 @@ bool Qtilities::ProjectManagement::Project::loadProject(const QString& file_name
 }
 
 bool Qtilities::ProjectManagement::Project::closeProject(ITask *task) {
+    // The journal is compacted into the project file, unless the project contains changes which were not saved:
+    if (!d->project_file.isEmpty() && QFile::exists(projectJournalFileName(d->project_file)) && !isModified())
+        compactProject(task);
+
     LOG_TASK_INFO_P(tr("Closing project: ") + d->project_file,task);
     for (int i = 0; i < d->project_items.count(); ++i) {
         d->project_items.at(i)->closeProjectItem(task);
@@ -425,6 +783,161 @@ bool Qtilities::ProjectManagement::Project::closeProject(ITask *task) {
     return true;
 }
 
+bool Qtilities::ProjectManagement::Project::compactProject(ITask* task) {
+    if (d->project_file.isEmpty() || !QFile::exists(projectJournalFileName(d->project_file)))
+        return true;
+
+    LOG_TASK_INFO(tr("Compacting the project journal into project file: ") + d->project_file,task);
+    d->compacting = true;
+    bool success = saveProject(d->project_file,task);
+    d->compacting = false;
+    return success;
+}
+
+bool Qtilities::ProjectManagement::Project::saveProjectJournal(ITask* task) {
+    QFile journal(projectJournalFileName(d->project_file));
+    const bool new_journal = !journal.exists() || journal.size() == 0;
+    if (!journal.open(QIODevice::ReadWrite)) {
+        LOG_TASK_WARNING(tr("Failed to open the project journal, the complete project will be saved: ") + journal.errorString(),task);
+        return false;
+    }
+
+    QDataStream stream(&journal);
+    stream.setVersion(QDataStream::Qt_4_7);
+    if (new_journal) {
+        QFileInfo project_info(d->project_file);
+        stream << MARKER_PROJECT_JOURNAL;
+        stream << (quint32) exportVersion();
+        stream << (quint32) applicationExportVersion();
+        stream << (qint64) project_info.size();
+        stream << (qint64) project_info.lastModified().toMSecsSinceEpoch();
+        stream << projectItemNames();
+    } else {
+        quint32 journal_export_version;
+        quint32 journal_application_export_version;
+        QStringList item_names;
+        if (!readProjectJournalHeader(stream,d->project_file,&journal_export_version,&journal_application_export_version,&item_names)
+                || journal_export_version != (quint32) exportVersion() || journal_application_export_version != applicationExportVersion() || item_names != projectItemNames()) {
+            LOG_TASK_INFO(tr("The project journal does not match the current project file, the complete project will be saved."),task);
+            return false;
+        }
+        journal.seek(journal.size());
+    }
+
+    // Records are appended, thus a failed save only needs to remove what it added:
+    const qint64 journal_size = journal.pos();
+    int saved_count = 0;
+    for (int i = 0; i < d->project_items.count(); ++i) {
+        IProjectItem* project_item = d->project_items.at(i);
+        if (!d->modified_items.contains(project_item) || !(project_item->supportedFormats() & IExportable::Binary))
+            continue;
+
+        QByteArray item_data;
+        QDataStream item_stream(&item_data,QIODevice::WriteOnly);
+        item_stream.setVersion(QDataStream::Qt_4_7);
+        project_item->setExportTask(task);
+        IExportable::ExportResultFlags item_result = project_item->exportBinary(item_stream);
+        project_item->clearExportTask();
+        if (item_result != IExportable::Complete) {
+            // Incomplete items are saved using a complete save, in which case the project is also marked as incomplete:
+            journal.resize(journal_size);
+            journal.close();
+            LOG_TASK_INFO(QString(tr("Project item %1 could not be saved completely to the project journal, the complete project will be saved.")).arg(project_item->projectItemName()),task);
+            return false;
+        }
+
+        stream << MARKER_PROJECT_JOURNAL_RECORD;
+        stream << (quint32) i;
+        // Items which export nothing leave item_data null, which operator<<() would write as a 0xFFFFFFFF size. Thus the size is written explicitly:
+        stream.writeBytes(item_data.constData(),(uint) item_data.size());
+        ++saved_count;
+    }
+
+    if (stream.status() != QDataStream::Ok || !journal.flush()) {
+        journal.resize(journal_size);
+        journal.close();
+        LOG_TASK_WARNING(tr("Failed to write to the project journal, the complete project will be saved: ") + journal.errorString(),task);
+        return false;
+    }
+    journal.close();
+
+    setModificationState(false,IModificationNotifier::NotifyListeners | IModificationNotifier::NotifySubjects);
+    LOG_TASK_INFO_P(QString(tr("Successfully saved %1 modified project item(s) to the journal of project file: ")).arg(saved_count) + d->project_file,task);
+    return true;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::replayProjectJournal(QList<QPointer<QObject> >& import_list, ITask* task) {
+    QFile journal(projectJournalFileName(d->project_file));
+    if (!journal.exists())
+        return IExportable::Complete;
+    if (!journal.open(QIODevice::ReadOnly)) {
+        LOG_TASK_ERROR_P(tr("Failed to open the project journal: ") + journal.errorString(),task);
+        return IExportable::Failed;
+    }
+
+    QDataStream stream(&journal);
+    stream.setVersion(QDataStream::Qt_4_7);
+    quint32 journal_export_version;
+    quint32 journal_application_export_version;
+    QStringList item_names;
+    if (!readProjectJournalHeader(stream,d->project_file,&journal_export_version,&journal_application_export_version,&item_names) || item_names != projectItemNames()) {
+        LOG_TASK_WARNING_P(tr("The project journal does not belong to the current project file and will be ignored: ") + journal.fileName(),task);
+        return IExportable::Complete;
+    }
+
+    // Only the last record of each project item is imported, earlier records are skipped:
+    QMap<int,qint64> record_positions;
+    while (!stream.atEnd()) {
+        quint32 marker = 0;
+        quint32 item_index = 0;
+        quint32 data_size = 0;
+        stream >> marker;
+        stream >> item_index;
+        const qint64 record_position = journal.pos();
+        stream >> data_size;
+        // Journals written by earlier versions stored empty records as null byte arrays:
+        if (data_size == 0xFFFFFFFF)
+            data_size = 0;
+        if (stream.status() != QDataStream::Ok || marker != MARKER_PROJECT_JOURNAL_RECORD || item_index >= (quint32) d->project_items.count()
+                || data_size > (quint32) INT_MAX || stream.skipRawData((int) data_size) != (int) data_size) {
+            // Records which were not written completely, for example when the application exited during a save, are ignored:
+            LOG_TASK_WARNING_P(tr("The project journal ends with an incomplete record, changes saved in it will be lost."),task);
+            break;
+        }
+        record_positions[(int) item_index] = record_position;
+    }
+
+    IExportable::ExportResultFlags success = IExportable::Complete;
+    QMap<int,qint64>::const_iterator itr;
+    for (itr = record_positions.constBegin(); itr != record_positions.constEnd(); ++itr) {
+        IProjectItem* project_item = d->project_items.at(itr.key());
+        QByteArray item_data;
+        journal.seek(itr.value());
+        stream >> item_data;
+
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ProjectManagementLogTag,QString(tr("Loading item %1 from the project journal: %2.")).arg(itr.key()).arg(project_item->projectItemName()));
+        QDataStream item_stream(item_data);
+        item_stream.setVersion(QDataStream::Qt_4_7);
+        project_item->newProjectItem();
+        project_item->setExportVersion((Qtilities::ExportVersion) journal_export_version);
+        project_item->setApplicationExportVersion(journal_application_export_version);
+        project_item->setExportTask(task);
+        IExportable::ExportResultFlags item_result = project_item->importBinary(item_stream,import_list);
+        project_item->clearExportTask();
+
+        if (item_result == IExportable::Failed) {
+            LOG_TASK_ERROR_P(QString(tr("Failed to load project item %1 from the project journal.")).arg(project_item->projectItemName()),task);
+            return item_result;
+        }
+        if (item_result == IExportable::Incomplete)
+            success = item_result;
+    }
+
+    if (!record_positions.isEmpty())
+        LOG_TASK_INFO(QString(tr("Loaded %1 project item(s) from the project journal.")).arg(record_positions.count()),task);
+    return success;
+}
+
 QString Qtilities::ProjectManagement::Project::projectFile() const {
     return FileUtils::toNativeSeparators(QDir::cleanPath(d->project_file));
 }
@@ -440,8 +953,11 @@ void Qtilities::ProjectManagement::Project::setProjectItems(QList<IProjectItem*>
     }
 
     d->project_items = project_items;
+    d->modified_items.clear();
     for (int i = 0; i < d->project_items.count(); ++i) {
-        connect(d->project_items.at(i)->objectBase(),SIGNAL(modificationStateChanged(bool)),SLOT(setModificationState(bool)));
+        connect(d->project_items.at(i)->objectBase(),SIGNAL(modificationStateChanged(bool)),SLOT(handleProjectItemModificationStateChanged(bool)));
+        if (d->project_items.at(i)->isModified())
+            d->modified_items.insert(d->project_items.at(i));
     }
 
     if (inherit_modification_state)
@@ -454,7 +970,9 @@ void Qtilities::ProjectManagement::Project::addProjectItem(IProjectItem* project
     if (!d->project_items.contains(project_item)) {
         bool is_modified = isModified();
         d->project_items.append(project_item);
-        connect(project_item->objectBase(),SIGNAL(modificationStateChanged(bool)),SLOT(setModificationState(bool)));
+        connect(project_item->objectBase(),SIGNAL(modificationStateChanged(bool)),SLOT(handleProjectItemModificationStateChanged(bool)));
+        if (project_item->isModified())
+            d->modified_items.insert(project_item);
         // Check if project item is modified. If so we need to update the project.
         if (inherit_modification_state)
             setModificationState(project_item->isModified());
@@ -465,6 +983,7 @@ void Qtilities::ProjectManagement::Project::addProjectItem(IProjectItem* project
 
 void Qtilities::ProjectManagement::Project::removeProjectItem(IProjectItem* project_item) {
     d->project_items.removeOne(project_item);
+    d->modified_items.remove(project_item);
     project_item->objectBase()->disconnect(this);
 }
 
@@ -486,34 +1005,72 @@ Qtilities::ProjectManagement::IProjectItem* Qtilities::ProjectManagement::Projec
     return d->project_items.at(index);
 }
 
-bool Qtilities::ProjectManagement::Project::isModified() const {
+QList<Qtilities::ProjectManagement::IProjectItem*> Qtilities::ProjectManagement::Project::modifiedProjectItems() const {
+    QList<IProjectItem*> modified_items;
+    if (d->modified_items.isEmpty())
+        return modified_items;
+
     for (int i = 0; i < d->project_items.count(); ++i) {
-        if (d->project_items.at(i)->isModified())
-            return true;
+        if (d->modified_items.contains(d->project_items.at(i)))
+            modified_items << d->project_items.at(i);
     }
-    return false;
+    return modified_items;
+}
+
+bool Qtilities::ProjectManagement::Project::isModified() const {
+    return !d->modified_items.isEmpty();
 }
 
 void Qtilities::ProjectManagement::Project::setModificationState(bool new_state, IModificationNotifier::NotificationTargets notification_targets, bool force_notifications) {
     Q_UNUSED(force_notifications)
 
-    if (!d->modification_mutex.tryLock())
+    if (d->updating_modification_state)
         return;
+    d->updating_modification_state = true;
 
     if (notification_targets & IModificationNotifier::NotifySubjects) {
         for (int i = 0; i < d->project_items.count(); ++i)
             d->project_items.at(i)->setModificationState(new_state,notification_targets);
+
+        // Items which did not report their new state are synced here:
+        d->modified_items.clear();
+        if (new_state) {
+            for (int i = 0; i < d->project_items.count(); ++i) {
+                if (d->project_items.at(i)->isModified())
+                    d->modified_items.insert(d->project_items.at(i));
+            }
+        }
     }
     if (notification_targets & IModificationNotifier::NotifyListeners) {
         emit modificationStateChanged(new_state);
     }
-    d->modification_mutex.unlock();
+    d->updating_modification_state = false;
+}
+
+void Qtilities::ProjectManagement::Project::handleProjectItemModificationStateChanged(bool is_modified) {
+    IProjectItem* project_item = 0;
+    for (int i = 0; i < d->project_items.count(); ++i) {
+        if (d->project_items.at(i)->objectBase() == sender()) {
+            project_item = d->project_items.at(i);
+            break;
+        }
+    }
+    if (!project_item)
+        return;
+
+    if (is_modified)
+        d->modified_items.insert(project_item);
+    else
+        d->modified_items.remove(project_item);
+
+    setModificationState(isModified());
 }
 
 Qtilities::Core::Interfaces::IExportable::ExportModeFlags Qtilities::ProjectManagement::Project::supportedFormats() const {
     IExportable::ExportModeFlags flags = 0;
     flags |= IExportable::Binary;
     flags |= IExportable::XML;
+    flags |= IExportable::Cbor;
 
     return flags;
 }
@@ -539,14 +1096,28 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
     // ---------------------------------------------------
     // Do the actual export:
     // ---------------------------------------------------
-    LOG_DEBUG(QString(tr("This project contains %1 project item(s).")).arg(d->project_items.count()));
+    LOG_TAG_DEBUG(Qtilities::Logging::Logger::ProjectManagementLogTag,QString(tr("This project contains %1 project item(s).")).arg(d->project_items.count()));
+    // Project items exported concurrently have their buffers written in order below:
+    QVector<qti_private_ProjectItemExportWorker*> workers = qti_private_ExportProjectItems(d->project_items,IExportable::Binary,false,&stream);
     IExportable::ExportResultFlags success = IExportable::Complete;
     for (int i = 0; i < d->project_items.count(); ++i) {
         if (d->project_items.at(i)->supportedFormats() & IExportable::Binary) {
-            LOG_DEBUG(QString(tr("Saving item %1: %2.")).arg(i).arg(d->project_items.at(i)->projectItemName()));
-            d->project_items.at(i)->setExportTask(exportTask());
-            IExportable::ExportResultFlags item_result = d->project_items.at(i)->exportBinary(stream);
-            d->project_items.at(i)->clearExportTask();
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ProjectManagementLogTag,QString(tr("Saving item %1: %2.")).arg(i).arg(d->project_items.at(i)->projectItemName()));
+            IExportable::ExportResultFlags item_result;
+            qint64 elapsed_msec;
+            if (workers.at(i)) {
+                stream.writeRawData(workers.at(i)->buffer.constData(),workers.at(i)->buffer.size());
+                item_result = workers.at(i)->result;
+                elapsed_msec = workers.at(i)->elapsed_msec;
+            } else {
+                QElapsedTimer timer;
+                timer.start();
+                d->project_items.at(i)->setExportTask(exportTask());
+                item_result = d->project_items.at(i)->exportBinary(stream);
+                d->project_items.at(i)->clearExportTask();
+                elapsed_msec = timer.elapsed();
+            }
+            LOG_TASK_INFO(QString(tr("Saved project item \"%1\" in %2 ms.")).arg(d->project_items.at(i)->projectItemName()).arg(elapsed_msec),exportTask());
 
             if (item_result == IExportable::Failed) {
                 success = item_result;
@@ -559,11 +1130,34 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
             LOG_WARNING(QString(tr("Could not save project item %1: %2. This project item does not support binary exporting.")).arg(i).arg(d->project_items.at(i)->projectItemName()));
         }
     }
+    qDeleteAll(workers);
 
     stream << MARKER_PROJECT_SECTION;
     return success;
 }
 
+void Qtilities::ProjectManagement::Project::cancelLoading() {
+    d->loading_cancelled = true;
+}
+
+bool Qtilities::ProjectManagement::Project::loadingCancelled() const {
+    return d->loading_cancelled;
+}
+
+bool Qtilities::ProjectManagement::Project::handleProjectItemLoaded(IProjectItem* item) {
+    Task* task = exportTask() ? qobject_cast<Task*> (exportTask()->objectBase()) : 0;
+    if (task)
+        task->addCompletedSubTasks(1,tr("Loaded project item: ") + item->projectItemName());
+
+    // Views show the project items loaded so far, and the task can be stopped before the next item is loaded:
+    IDLE_SCHEDULER->yieldToEventLoop();
+    if (d->loading_cancelled) {
+        LOG_TASK_WARNING_P(tr("Opening the project was cancelled."),exportTask());
+        return false;
+    }
+    return true;
+}
+
 Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list) {
 
     // ---------------------------------------------------
@@ -621,7 +1215,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
         item_names << d->project_items.at(i)->projectItemName();
     }
     stream >> item_names_readback;
-    LOG_DEBUG(QString(tr("This project contains %1 project item(s).")).arg(item_names_readback.count()));
+    LOG_TAG_DEBUG(Qtilities::Logging::Logger::ProjectManagementLogTag,QString(tr("This project contains %1 project item(s).")).arg(item_names_readback.count()));
     if (item_names != item_names_readback) {
         LOG_ERROR(QString(tr("Failed to load project. The number of project items does not match your current set of plugin's number of project items, or they are not loaded in the same order.")));
         return IExportable::Failed;
@@ -632,7 +1226,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
     IExportable::ExportResultFlags success = IExportable::Complete;
     for (int i = 0; i < int_count; ++i) {
         if (d->project_items.at(i)->supportedFormats() & IExportable::Binary) {
-            LOG_DEBUG(QString(tr("Loading item %1: %2.")).arg(i).arg(d->project_items.at(i)->projectItemName()));
+            LOG_TAG_DEBUG(Qtilities::Logging::Logger::ProjectManagementLogTag,QString(tr("Loading item %1: %2.")).arg(i).arg(d->project_items.at(i)->projectItemName()));
             d->project_items.at(i)->setExportVersion(read_version);
             d->project_items.at(i)->setApplicationExportVersion(application_read_version);
 
@@ -650,6 +1244,11 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
             success = IExportable::Incomplete;
             LOG_WARNING(QString(tr("Could not load project item %1: %2. This project item does not support binary importing.")).arg(i).arg(d->project_items.at(i)->projectItemName()));
         }
+
+        if (!handleProjectItemLoaded(d->project_items.at(i))) {
+            success = IExportable::Failed;
+            break;
+        }
     }
 
     if (success) {
@@ -674,15 +1273,34 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
     // ---------------------------------------------------
     // Do the actual export:
     // ---------------------------------------------------
+    // Project items exported concurrently have their elements added in order below:
+    QVector<qti_private_ProjectItemExportWorker*> workers = qti_private_ExportProjectItems(d->project_items,IExportable::XML,true);
     IExportable::ExportResultFlags success = IExportable::Complete;
     for (int i = 0; i < d->project_items.count(); ++i) {
         QString name = d->project_items.at(i)->projectItemName();
         QDomElement itemRoot = doc->createElement("ProjectItem_" + QString::number(i));
         itemRoot.setAttribute("Name",name);
         object_node->appendChild(itemRoot);
-        d->project_items.at(i)->setExportTask(exportTask());
-        IExportable::ExportResultFlags item_result = d->project_items.at(i)->exportXml(doc,&itemRoot);
-        d->project_items.at(i)->clearExportTask();
+        IExportable::ExportResultFlags item_result;
+        qint64 elapsed_msec;
+        if (workers.at(i)) {
+            QDomElement worker_root = doc->importNode(workers.at(i)->object_node,true).toElement();
+            QDomNamedNodeMap attributes = worker_root.attributes();
+            for (int a = 0; a < attributes.count(); ++a)
+                itemRoot.setAttribute(attributes.item(a).nodeName(),attributes.item(a).nodeValue());
+            while (worker_root.hasChildNodes())
+                itemRoot.appendChild(worker_root.firstChild());
+            item_result = workers.at(i)->result;
+            elapsed_msec = workers.at(i)->elapsed_msec;
+        } else {
+            QElapsedTimer timer;
+            timer.start();
+            d->project_items.at(i)->setExportTask(exportTask());
+            item_result = d->project_items.at(i)->exportXml(doc,&itemRoot);
+            d->project_items.at(i)->clearExportTask();
+            elapsed_msec = timer.elapsed();
+        }
+        LOG_TASK_INFO(QString(tr("Saved project item \"%1\" in %2 ms.")).arg(name).arg(elapsed_msec),exportTask());
         if (item_result == IExportable::Failed) {
             success = item_result;
             break;
@@ -690,6 +1308,7 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
         if (item_result == IExportable::Incomplete && success == IExportable::Complete)
             success = item_result;
     }
+    qDeleteAll(workers);
 
     // TODO - Export dynamic properties here
     return success;
@@ -796,3 +1415,353 @@ Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectMa
 
     return success;
 }
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::exportXmlStream(QXmlStreamWriter* writer) const {
+    // ---------------------------------------------------
+    // Save file format information:
+    // ---------------------------------------------------
+    writer->writeAttribute("ExportVersion",QString::number(exportVersion()));
+    writer->writeAttribute("QtilitiesVersion",CoreGui::QtilitiesApplication::qtilitiesVersionString());
+    writer->writeAttribute("ApplicationExportVersion",QString::number(applicationExportVersion()));
+    writer->writeAttribute("ApplicationVersion",QApplication::applicationVersion());
+    writer->writeAttribute("ApplicationName",QApplication::applicationName());
+
+    // ---------------------------------------------------
+    // Do the actual export:
+    // ---------------------------------------------------
+    // Project items exported concurrently have their elements written in order below:
+    QVector<qti_private_ProjectItemExportWorker*> workers = qti_private_ExportProjectItems(d->project_items,IExportable::XML,false);
+    IExportable::ExportResultFlags success = IExportable::Complete;
+    for (int i = 0; i < d->project_items.count(); ++i) {
+        writer->writeStartElement("ProjectItem_" + QString::number(i));
+        writer->writeAttribute("Name",d->project_items.at(i)->projectItemName());
+        IExportable::ExportResultFlags item_result;
+        qint64 elapsed_msec;
+        if (workers.at(i)) {
+            qti_private_WriteProjectItemXml(workers.at(i)->buffer,writer);
+            item_result = workers.at(i)->result;
+            elapsed_msec = workers.at(i)->elapsed_msec;
+        } else {
+            QElapsedTimer timer;
+            timer.start();
+            d->project_items.at(i)->setExportTask(exportTask());
+            item_result = d->project_items.at(i)->exportXmlStream(writer);
+            d->project_items.at(i)->clearExportTask();
+            elapsed_msec = timer.elapsed();
+        }
+        writer->writeEndElement();
+        LOG_TASK_INFO(QString(tr("Saved project item \"%1\" in %2 ms.")).arg(d->project_items.at(i)->projectItemName()).arg(elapsed_msec),exportTask());
+        if (item_result == IExportable::Failed) {
+            success = item_result;
+            break;
+        }
+        if (item_result == IExportable::Incomplete && success == IExportable::Complete)
+            success = item_result;
+    }
+    qDeleteAll(workers);
+
+    return success;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    QXmlStreamAttributes attributes = reader->attributes();
+
+    // ---------------------------------------------------
+    // Inspect file format:
+    // ---------------------------------------------------
+    Qtilities::ExportVersion read_version;
+    if (attributes.hasAttribute("ExportVersion")) {
+        read_version = (Qtilities::ExportVersion) attributes.value("ExportVersion").toString().toInt();
+        LOG_TASK_INFO(QString(tr("Inspecting project file format: Qtilities export format version: %1")).arg(read_version),exportTask());
+    } else {
+        LOG_TASK_ERROR(QString(tr("The export version of the input file could not be determined. This might indicate that the input file is in the wrong format. The project file will not be parsed.")),exportTask());
+        QApplication::restoreOverrideCursor();
+        return IExportable::Failed;
+    }
+    if (attributes.hasAttribute("QtilitiesVersion"))
+        LOG_TASK_INFO(QString(tr("Inspecting project file format: Qtilities version used to save the file: %1")).arg(attributes.value("QtilitiesVersion").toString()),exportTask());
+    quint32 application_read_version = 0;
+    if (attributes.hasAttribute("ApplicationExportVersion")) {
+        application_read_version = attributes.value("ApplicationExportVersion").toString().toInt();
+        LOG_TASK_INFO(QString(tr("Inspecting project file format: Application export format version: %1")).arg(application_read_version),exportTask());
+    } else {
+        LOG_TASK_ERROR(QString(tr("The application export version of the input file could not be determined. This might indicate that the input file is in the wrong format. The project file will not be parsed.")),exportTask());
+        QApplication::restoreOverrideCursor();
+        return IExportable::Failed;
+    }
+    if (attributes.hasAttribute("ApplicationVersion"))
+        LOG_TASK_INFO(QString(tr("Inspecting project file format: Application version used to save the file: %1")).arg(attributes.value("ApplicationVersion").toString()),exportTask());
+
+    // ---------------------------------------------------
+    // Check if input format is supported:
+    // ---------------------------------------------------
+    IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(read_version,exportTask());
+    if (version_check_result != IExportable::VersionSupported) {
+        LOG_TASK_ERROR(QString(tr("Unsupported project file found with export version: %1. The project file will not be parsed.")).arg(read_version),exportTask());
+        return IExportable::Failed;
+    }
+
+    bool found_project_item = false;
+
+    // ---------------------------------------------------
+    // Do the actual import:
+    // ---------------------------------------------------
+    IExportable::ExportResultFlags success = IExportable::Complete;
+    while (reader->readNextStartElement()) {
+        if (!reader->name().startsWith(QLatin1String("ProjectItem_"))) {
+            reader->skipCurrentElement();
+            continue;
+        }
+
+        found_project_item = true;
+        QString item_name;
+        if (reader->attributes().hasAttribute("Name")) {
+            item_name = reader->attributes().value("Name").toString();
+            LOG_TASK_TRACE("Found project item in import file with name: " + item_name,exportTask());
+        } else {
+            LOG_TASK_WARNING(tr("Nameless project item found in input file. This item will be skipped."),exportTask());
+            reader->skipCurrentElement();
+            continue;
+        }
+
+        // Now get the project item with name item_name:
+        IProjectItem* item_iface = 0;
+        for (int i = 0; i < d->project_items.count(); ++i) {
+            if (d->project_items.at(i)->projectItemName() == item_name) {
+                item_iface = d->project_items.at(i);
+                break;
+            }
+        }
+
+        if (!item_iface) {
+            LOG_TASK_WARNING(QString(tr("Input file contains a project item \"%1\" which does not exist in your application. Import will be incomplete.")).arg(item_name),exportTask());
+            if (success != IExportable::Failed)
+                success = IExportable::Incomplete;
+            reader->skipCurrentElement();
+            continue;
+        }
+
+        item_iface->setExportVersion(read_version);
+        item_iface->setApplicationExportVersion(application_read_version);
+        item_iface->setExportTask(exportTask());
+        success = item_iface->importXmlStream(reader,import_list);
+        item_iface->clearExportTask();
+
+        if (success & IExportable::FailedResult) {
+            LOG_TASK_ERROR(tr("Project item \"") + item_name + tr("\" failed during import."),exportTask());
+            success = IExportable::Incomplete;
+            break;
+        }
+
+        if (!handleProjectItemLoaded(item_iface)) {
+            success = IExportable::Failed;
+            break;
+        }
+    }
+
+    if (!found_project_item)
+        LOG_TASK_WARNING(tr("No project items found in project file."),exportTask());
+
+    return success;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::exportCbor(CborStreamWriter* writer) const {
+    // ---------------------------------------------------
+    // Save file format information:
+    // ---------------------------------------------------
+    writer->startMap();
+    writer->writeString("exportVersion");
+    writer->writeUnsignedInteger(exportVersion());
+    writer->writeString("qtilitiesVersion");
+    writer->writeString(CoreGui::QtilitiesApplication::qtilitiesVersionString());
+    writer->writeString("applicationExportVersion");
+    writer->writeUnsignedInteger(applicationExportVersion());
+    writer->writeString("applicationVersion");
+    writer->writeString(QApplication::applicationVersion());
+    writer->writeString("applicationName");
+    writer->writeString(QApplication::applicationName());
+
+    // ---------------------------------------------------
+    // Do the actual export:
+    // ---------------------------------------------------
+    // Project items exported concurrently have their items written in order below:
+    QVector<qti_private_ProjectItemExportWorker*> workers = qti_private_ExportProjectItems(d->project_items,IExportable::Cbor,false);
+    IExportable::ExportResultFlags success = IExportable::Complete;
+    writer->writeString("items");
+    writer->startArray();
+    for (int i = 0; i < d->project_items.count(); ++i) {
+        writer->startMap(2);
+        writer->writeString("name");
+        writer->writeString(d->project_items.at(i)->projectItemName());
+        writer->writeString("data");
+        IExportable::ExportResultFlags item_result;
+        qint64 elapsed_msec;
+        if (workers.at(i)) {
+            writer->device()->write(workers.at(i)->buffer);
+            item_result = workers.at(i)->result;
+            elapsed_msec = workers.at(i)->elapsed_msec;
+        } else {
+            QElapsedTimer timer;
+            timer.start();
+            d->project_items.at(i)->setExportTask(exportTask());
+            item_result = d->project_items.at(i)->exportCbor(writer);
+            d->project_items.at(i)->clearExportTask();
+            elapsed_msec = timer.elapsed();
+        }
+        writer->endMap();
+        LOG_TASK_INFO(QString(tr("Saved project item \"%1\" in %2 ms.")).arg(d->project_items.at(i)->projectItemName()).arg(elapsed_msec),exportTask());
+        if (item_result == IExportable::Failed) {
+            success = item_result;
+            break;
+        }
+        if (item_result == IExportable::Incomplete && success == IExportable::Complete)
+            success = item_result;
+    }
+    qDeleteAll(workers);
+    writer->endArray();
+    writer->endMap();
+
+    if (writer->hasError())
+        return IExportable::Failed;
+    return success;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::ProjectManagement::Project::importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list) {
+    if (!reader->isMap()) {
+        reader->next();
+        return IExportable::Failed;
+    }
+
+    // The file format information is written before the project items, thus it is known when the items are reached:
+    bool has_read_version = false;
+    Qtilities::ExportVersion read_version = Qtilities::Qtilities_Latest;
+    bool has_application_read_version = false;
+    quint32 application_read_version = 0;
+    bool found_project_item = false;
+    bool import_aborted = false;
+    IExportable::ExportResultFlags success = IExportable::Complete;
+
+    reader->enterContainer();
+    while (reader->hasNext()) {
+        QString key = reader->readString();
+        if (key == QLatin1String("exportVersion") && reader->isUnsignedInteger()) {
+            // ---------------------------------------------------
+            // Inspect file format:
+            // ---------------------------------------------------
+            read_version = (Qtilities::ExportVersion) reader->toUnsignedInteger();
+            has_read_version = true;
+            reader->next();
+            LOG_TASK_INFO(QString(tr("Inspecting project file format: Qtilities export format version: %1")).arg(read_version),exportTask());
+        } else if (key == QLatin1String("qtilitiesVersion") && reader->isString()) {
+            LOG_TASK_INFO(QString(tr("Inspecting project file format: Qtilities version used to save the file: %1")).arg(reader->readString()),exportTask());
+        } else if (key == QLatin1String("applicationExportVersion") && reader->isUnsignedInteger()) {
+            application_read_version = reader->toUnsignedInteger();
+            has_application_read_version = true;
+            reader->next();
+            LOG_TASK_INFO(QString(tr("Inspecting project file format: Application export format version: %1")).arg(application_read_version),exportTask());
+        } else if (key == QLatin1String("applicationVersion") && reader->isString()) {
+            LOG_TASK_INFO(QString(tr("Inspecting project file format: Application version used to save the file: %1")).arg(reader->readString()),exportTask());
+        } else if (key == QLatin1String("items") && reader->isArray()) {
+            if (!has_read_version) {
+                LOG_TASK_ERROR(QString(tr("The export version of the input file could not be determined. This might indicate that the input file is in the wrong format. The project file will not be parsed.")),exportTask());
+                return IExportable::Failed;
+            }
+            if (!has_application_read_version) {
+                LOG_TASK_ERROR(QString(tr("The application export version of the input file could not be determined. This might indicate that the input file is in the wrong format. The project file will not be parsed.")),exportTask());
+                return IExportable::Failed;
+            }
+
+            // ---------------------------------------------------
+            // Check if input format is supported:
+            // ---------------------------------------------------
+            IExportable::ExportResultFlags version_check_result = IExportable::validateQtilitiesExportVersion(read_version,exportTask());
+            if (version_check_result != IExportable::VersionSupported) {
+                LOG_TASK_ERROR(QString(tr("Unsupported project file found with export version: %1. The project file will not be parsed.")).arg(read_version),exportTask());
+                return IExportable::Failed;
+            }
+
+            // ---------------------------------------------------
+            // Do the actual import:
+            // ---------------------------------------------------
+            reader->enterContainer();
+            while (reader->hasNext()) {
+                if (!reader->isMap()) {
+                    reader->next();
+                    continue;
+                }
+
+                found_project_item = true;
+                QString item_name;
+                reader->enterContainer();
+                while (reader->hasNext()) {
+                    QString item_key = reader->readString();
+                    if (item_key == QLatin1String("name") && reader->isString()) {
+                        item_name = reader->readString();
+                        LOG_TASK_TRACE("Found project item in import file with name: " + item_name,exportTask());
+                        continue;
+                    }
+                    if (item_key != QLatin1String("data")) {
+                        reader->next();
+                        continue;
+                    }
+                    if (item_name.isEmpty()) {
+                        LOG_TASK_WARNING(tr("Nameless project item found in input file. This item will be skipped."),exportTask());
+                        reader->next();
+                        continue;
+                    }
+
+                    // Now get the project item with name item_name:
+                    IProjectItem* item_iface = 0;
+                    for (int i = 0; i < d->project_items.count(); ++i) {
+                        if (d->project_items.at(i)->projectItemName() == item_name) {
+                            item_iface = d->project_items.at(i);
+                            break;
+                        }
+                    }
+
+                    if (!item_iface) {
+                        LOG_TASK_WARNING(QString(tr("Input file contains a project item \"%1\" which does not exist in your application. Import will be incomplete.")).arg(item_name),exportTask());
+                        if (success != IExportable::Failed)
+                            success = IExportable::Incomplete;
+                        reader->next();
+                        continue;
+                    }
+
+                    item_iface->setExportVersion(read_version);
+                    item_iface->setApplicationExportVersion(application_read_version);
+                    item_iface->setExportTask(exportTask());
+                    success = item_iface->importCbor(reader,import_list);
+                    item_iface->clearExportTask();
+
+                    if (success & IExportable::FailedResult) {
+                        LOG_TASK_ERROR(tr("Project item \"") + item_name + tr("\" failed during import."),exportTask());
+                        success = IExportable::Incomplete;
+                        import_aborted = true;
+                        break;
+                    }
+
+                    if (!handleProjectItemLoaded(item_iface)) {
+                        success = IExportable::Failed;
+                        import_aborted = true;
+                        break;
+                    }
+                }
+                if (import_aborted)
+                    break;
+                reader->leaveContainer();
+            }
+            // The remaining items are not read when an item failed:
+            if (import_aborted)
+                break;
+            reader->leaveContainer();
+        } else
+            reader->next();
+    }
+    if (!import_aborted)
+        reader->leaveContainer();
+
+    if (!found_project_item)
+        LOG_TASK_WARNING(tr("No project items found in project file."),exportTask());
+
+    return success;
+}
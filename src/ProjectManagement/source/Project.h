@@ -63,6 +63,41 @@ namespace Qtilities {
             int projectItemCount() const;
             IProjectItem* projectItem(int index);
 
+            //! Saves the complete project to its project file, replacing the journal written while saving incrementally.
+            /*!
+              The journal is also compacted automatically when the project is closed without unsaved changes, and when the journal grows larger than
+              ProjectManager::projectJournalLimit(). When the project does not have a journal, this function does nothing.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa ProjectManager::setIncrementalProjectSaving()
+              */
+            bool compactProject(ITask* task = 0);
+            //! Cancels loadProject() while it is loading the project.
+            /*!
+              The project loads its project items one at a time and gives the event loop control between items, thus views show the items
+              which were loaded so far and the loading task can be stopped from the user interface. When cancelled, loadProject() stops after the
+              item which is being loaded and returns false.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+
+              \sa loadingCancelled()
+              */
+            void cancelLoading();
+            //! Indicates if cancelLoading() was called during the last call to loadProject().
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool loadingCancelled() const;
+            //! Returns the project items which are modified, in the order in which they appear in the project.
+            /*!
+              The modification states reported by the project items are tracked as they change, thus the items are not asked for their
+              states. Incremental saves only save these items, see ProjectManager::setIncrementalProjectSaving().
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<IProjectItem*> modifiedProjectItems() const;
+
             // --------------------------------
             // IModificationNotifier Implementation
             // --------------------------------
@@ -72,6 +107,10 @@ namespace Qtilities {
         signals:
             void modificationStateChanged(bool is_modified) const;
 
+        private slots:
+            //! Tracks the modification state reported by a project item, see modifiedProjectItems().
+            void handleProjectItemModificationStateChanged(bool is_modified);
+
         public:
             // --------------------------------
             // IExportable Implementation
@@ -81,6 +120,10 @@ namespace Qtilities {
             IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
             IExportable::ExportResultFlags exportXml(QDomDocument* doc, QDomElement* object_node) const;
             IExportable::ExportResultFlags importXml(QDomDocument* doc, QDomElement* object_node, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportXmlStream(QXmlStreamWriter* writer) const;
+            IExportable::ExportResultFlags importXmlStream(QXmlStreamReader* reader, QList<QPointer<QObject> >& import_list);
+            IExportable::ExportResultFlags exportCbor(CborStreamWriter* writer) const;
+            IExportable::ExportResultFlags importCbor(CborStreamReader* reader, QList<QPointer<QObject> >& import_list);
 
             // --------------------------------
             // IObjectBase Implementation
@@ -89,6 +132,13 @@ namespace Qtilities {
             const QObject* objectBase() const { return this; }
 
         private:
+            //! Appends the modified project items to the journal of the project file. Returns false when the complete project must be saved instead.
+            bool saveProjectJournal(ITask* task);
+            //! Imports the project items saved in the journal of the project file after the project file itself was imported.
+            IExportable::ExportResultFlags replayProjectJournal(QList<QPointer<QObject> >& import_list, ITask* task);
+            //! Reports the progress after \p item was loaded and gives the event loop control. Returns false when loading was cancelled.
+            bool handleProjectItemLoaded(IProjectItem* item);
+
             ProjectPrivateData* d;
         };
     }
@@ -12,6 +12,7 @@
 #include "ProjectManagementConfig.h"
 #include "ui_ProjectManagementConfig.h"
 #include "ProjectManager.h"
+#include "ProjectPathScanner_p.h"
 
 #include <QtilitiesFileInfo>
 #include <FileUtils.h>
@@ -31,6 +32,7 @@ Qtilities::ProjectManagement::ProjectManagementConfig::ProjectManagementConfig(Q
     ui(new Ui::ProjectManagementConfig)
 {
     ui->setupUi(this);
+    connect(ProjectPathScanner::instance(),SIGNAL(pathScanned(QString,int)),SLOT(handleCustomProjectPathScanned(QString,int)));
 }
 
 Qtilities::ProjectManagement::ProjectManagementConfig::~ProjectManagementConfig()
@@ -180,6 +182,7 @@ void Qtilities::ProjectManagement::ProjectManagementConfig::refreshCustomProject
 
     ui->tableCustomPaths->blockSignals(true);
 
+    QStringList scan_paths;
     for (int i = 0; i < categories.count(); ++i) {
         bool is_editable = (categories.at(i) != QString("Default"));
 
@@ -200,17 +203,12 @@ void Qtilities::ProjectManagement::ProjectManagementConfig::refreshCustomProject
         }
         ui->tableCustomPaths->setItem(i, 0, newItem);
 
-        // Path column:
+        // Path column. Paths are checked in the background, see handleCustomProjectPathScanned():
         QString path = PROJECT_MANAGER->customProjectsPath(categories.at(i));
         if (!path.isEmpty()) {
-            QDir dir(path);
-            if (dir.exists()) {
-                newItem = new QTableWidgetItem(path);
-                newItem->setForeground(QBrush(QColor("#00aa00")));
-            } else {
-                newItem = new QTableWidgetItem(path);
-                newItem->setForeground(QBrush(Qt::red));
-            }
+            newItem = new QTableWidgetItem(path);
+            updatePathItemState(newItem,ProjectPathScanner::instance()->pathState(path));
+            scan_paths << path;
         } else {
             path = "None specified";
             newItem = new QTableWidgetItem(path);
@@ -225,6 +223,27 @@ void Qtilities::ProjectManagement::ProjectManagementConfig::refreshCustomProject
 
     ui->tableCustomPaths->resizeColumnsToContents();
     ui->tableCustomPaths->horizontalHeader()->setStretchLastSection(true);
+    ProjectPathScanner::instance()->scanPaths(scan_paths,true);
+}
+
+void Qtilities::ProjectManagement::ProjectManagementConfig::handleCustomProjectPathScanned(const QString& path, int state) {
+    bool signals_blocked = ui->tableCustomPaths->blockSignals(true);
+    for (int i = 0; i < ui->tableCustomPaths->rowCount(); ++i) {
+        QTableWidgetItem* item = ui->tableCustomPaths->item(i,1);
+        if (item && item->text() == path)
+            updatePathItemState(item,state);
+    }
+    ui->tableCustomPaths->blockSignals(signals_blocked);
+}
+
+void Qtilities::ProjectManagement::ProjectManagementConfig::updatePathItemState(QTableWidgetItem* item, int state) {
+    if (state == ProjectPathScanner::PathExists)
+        item->setForeground(QBrush(QColor("#00aa00")));
+    else if (state == ProjectPathScanner::PathMissing)
+        item->setForeground(QBrush(Qt::red));
+    else
+        item->setForeground(QBrush(Qt::gray));
+    item->setToolTip(ProjectPathScanner::pathStateDescription((ProjectPathScanner::PathState) state));
 }
 
 void Qtilities::ProjectManagement::ProjectManagementConfig::saveCustomProjectsPaths() {
@@ -269,11 +288,10 @@ void Qtilities::ProjectManagement::ProjectManagementConfig::handleActiveCustomPr
         QTableWidgetItem* lookup_item = ui->tableCustomPaths->item(item->row(),0);
         if (lookup_item) {
             if (!item->text().isEmpty()) {
-                QDir dir(item->text());
-                if (dir.exists())
-                    item->setForeground(QBrush(QColor("#00aa00")));
-                else
-                    item->setForeground(QBrush(Qt::red));
+                bool signals_blocked = ui->tableCustomPaths->blockSignals(true);
+                updatePathItemState(item,ProjectPathScanner::instance()->pathState(item->text()));
+                ui->tableCustomPaths->blockSignals(signals_blocked);
+                ProjectPathScanner::instance()->scanPaths(QStringList(item->text()),true);
             } else {
                 item->setText("None specified");
                 item->setForeground(QBrush(Qt::red));
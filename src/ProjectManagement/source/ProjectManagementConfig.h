@@ -87,9 +87,13 @@ OBJECT_MANAGER->registerObject(PROJECT_MANAGER->configWidget());
             void on_btnRemove_clicked();
             void on_btnAdd_clicked();
             void refreshCustomProjectPaths();
+            //! Updates the path column when the state of \p path was checked in the background.
+            void handleCustomProjectPathScanned(const QString& path, int state);
 
         private:
             void saveCustomProjectsPaths();
+            //! Shows the ProjectPathScanner::PathState \p state of the path in \p item.
+            void updatePathItemState(QTableWidgetItem* item, int state);
 
             Ui::ProjectManagementConfig*    ui;
             QMap<QString,QString>           custom_paths;
@@ -37,6 +37,10 @@ namespace Qtilities {
             const char * const qti_def_SUFFIX_PROJECT_BINARY  = "prj";
             //! The file extension used for xml project files. By default xml and formatted in the %Qtilities Tree Format.
             const char * const qti_def_SUFFIX_PROJECT_XML     = "xml";
+            //! The file extension used for CBOR project files. See IExportable::Cbor.
+            const char * const qti_def_SUFFIX_PROJECT_CBOR    = "cbor";
+            //! The suffix appended to binary project file names to get the file name of their journal. See ProjectManager::setIncrementalProjectSaving().
+            const char * const qti_def_SUFFIX_PROJECT_JOURNAL = "journal";
         }
     }
 }
@@ -22,7 +22,6 @@
 #include <QCoreApplication>
 #include <QMap>
 #include <QPointer>
-#include <QSettings>
 #include <QApplication>
 #include <QMessageBox>
 #include <QFileDialog>
@@ -37,6 +36,11 @@ struct Qtilities::ProjectManagement::ProjectManagerPrivateData  {
         current_project_busy_count(0),
         open_last_project(false),
         use_project_file_locks(true),
+        lazy_project_loading(false),
+        compress_projects(false),
+        parallel_project_saving(false),
+        incremental_project_saving(false),
+        project_journal_limit(64 * 1024 * 1024),
         default_custom_project_paths_category( QObject::tr("Default")),
         is_initialized(false),
         project_types(IExportable::Binary | IExportable::XML),
@@ -59,6 +63,11 @@ struct Qtilities::ProjectManagement::ProjectManagerPrivateData  {
     QPointer<ProjectManagementConfig>       config_widget;
     bool                                    open_last_project;
     bool                                    use_project_file_locks;
+    bool                                    lazy_project_loading;
+    bool                                    compress_projects;
+    bool                                    parallel_project_saving;
+    bool                                    incremental_project_saving;
+    qint64                                  project_journal_limit;
     bool                                    auto_create_new_project;
     bool                                    use_custom_projects_paths;
     // Keys = Categories, Values = Paths
@@ -118,6 +127,7 @@ Qtilities::ProjectManagement::ProjectManager::ProjectManager(QObject* parent) :
 
     d->suffices[IExportable::Binary] = qti_def_SUFFIX_PROJECT_BINARY;
     d->suffices[IExportable::XML] = qti_def_SUFFIX_PROJECT_XML;
+    d->suffices[IExportable::Cbor] = qti_def_SUFFIX_PROJECT_CBOR;
 
     // Register the tasks contained in this object:
     // Create TaskSaveProject:
@@ -150,6 +160,8 @@ void Qtilities::ProjectManagement::ProjectManager::setAllowedProjectTypes(IExpor
     if (!(d->project_types & d->default_project_type)) {
         if (d->project_types & IExportable::Binary)
             d->default_project_type = IExportable::Binary;
+        if (d->project_types & IExportable::Cbor)
+            d->default_project_type = IExportable::Cbor;
         if (d->project_types & IExportable::XML)
             d->default_project_type = IExportable::XML;
     }
@@ -181,6 +193,8 @@ QString Qtilities::ProjectManagement::ProjectManager::allowedProjectTypesFilter(
         filter_list.append(QString(tr("Binary Project File (*.%1)")).arg(d->suffices[IExportable::Binary]));
     if (d->project_types & IExportable::XML)
         filter_list.append(QString(tr("XML Project File (*.%1)")).arg(d->suffices[IExportable::XML]));
+    if (d->project_types & IExportable::Cbor)
+        filter_list.append(QString(tr("CBOR Project File (*.%1)")).arg(d->suffices[IExportable::Cbor]));
 
     return filter_list.join(";;");
 }
@@ -194,6 +208,10 @@ IExportable::ExportMode ProjectManagement::ProjectManager::projectTypeFromTypeFi
         if (project_type_filter_string.contains(d->suffices[IExportable::XML]))
             return IExportable::XML;
     }
+    if (d->project_types & IExportable::Cbor) {
+        if (project_type_filter_string.contains(d->suffices[IExportable::Cbor]))
+            return IExportable::Cbor;
+    }
     return IExportable::None;
 }
 
@@ -305,17 +323,20 @@ bool Qtilities::ProjectManagement::ProjectManager::openProject(const QString& fi
         Q_ASSERT(task_ref);
         QFileInfo fi(file_name);
         task_ref->setDisplayName(tr("Opening Project: ") + fi.fileName());
-        task_ref->startTask(-1,tr("Opening Project: ") + fi.fileName(),Logger::Info);
+        // One sub task is completed for every project item, and the task can be stopped between items:
+        task_ref->startTask(d->item_list.count(),tr("Opening Project: ") + fi.fileName(),Logger::Info);
+        task_ref->setCanStop(true);
+        connect(task_ref,SIGNAL(stopTaskRequest()),SLOT(cancelProjectLoading()),Qt::UniqueConnection);
     }
 
     // Check if the project is locked:
     if (d->use_project_file_locks) {
-        bool is_file_locked = d->file_locker.isFileLocked(file_name);
-        if (is_file_locked) {
+        FileLocker::LockInfo lock_info = d->file_locker.lockInfo(file_name);
+        if (lock_info.is_locked) {
             if (PROJECT_MANAGER->executionStyle() == ProjectManager::ExecNormal) {
                 QMessageBox msgBox;
                 msgBox.setIcon(QMessageBox::Question);
-                msgBox.setText(tr("The project you are trying to open is currently locked.<br><br>") + d->file_locker.lastLockSummary(file_name,"<br>"));
+                msgBox.setText(tr("The project you are trying to open is currently locked.<br><br>") + FileLocker::lockSummary(lock_info,"<br>"));
                 msgBox.setInformativeText(tr("Do you want to break the lock in order to continue opening it?"));
                 msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::Cancel);
                 msgBox.setDefaultButton(QMessageBox::Cancel);
@@ -326,8 +347,10 @@ bool Qtilities::ProjectManagement::ProjectManager::openProject(const QString& fi
                             QString errorMsg;
                             if (!d->file_locker.unlockFile(file_name,&errorMsg)) {
                                 LOG_TASK_ERROR(errorMsg,task_ref);
-                                if (task_ref)
+                                if (task_ref) {
+                                    task_ref->setCanStop(false);
                                     task_ref->completeTask(ITask::TaskFailed);
+                                }
                                 return false;
                             }
                         }
@@ -335,8 +358,10 @@ bool Qtilities::ProjectManagement::ProjectManager::openProject(const QString& fi
                     case QMessageBox::Cancel:
                         // In this case we say the project was locked and abort.
                         LOG_TASK_ERROR(tr("Project file is locked, you decided not to release the lock: ") + file_name,task_ref);
-                        if (task_ref)
+                        if (task_ref) {
+                            task_ref->setCanStop(false);
                             task_ref->completeTask(ITask::TaskFailed);
+                        }
                         return false;
                         break;
                     default:
@@ -346,8 +371,10 @@ bool Qtilities::ProjectManagement::ProjectManager::openProject(const QString& fi
             } else if (PROJECT_MANAGER->executionStyle() == ProjectManager::ExecSilent) {
                 // In this case we say the project was locked and abort.
                 LOG_TASK_ERROR(tr("Project file is locked, cannot open it in silent execution mode: ") + file_name,task_ref);
-                if (task_ref)
+                if (task_ref) {
+                    task_ref->setCanStop(false);
                     task_ref->completeTask(ITask::TaskFailed);
+                }
                 return false;
             }
         }
@@ -361,7 +388,16 @@ bool Qtilities::ProjectManagement::ProjectManager::openProject(const QString& fi
 
     connect(d->current_project,SIGNAL(modificationStateChanged(bool)),SLOT(setModificationState(bool)));
     d->current_project->setProjectItems(d->item_list);
-    if (!d->current_project->loadProject(file_name,false,task_ref)) {
+    // The project gives the event loop control while it is loading, thus the project is busy to block other project operations until it is loaded:
+    setActiveProjectBusy(true);
+    bool loaded = d->current_project->loadProject(file_name,false,task_ref);
+    setActiveProjectBusy(false);
+    if (task_ref)
+        task_ref->setCanStop(false);
+
+    if (!loaded) {
+        const bool cancelled = d->current_project->loadingCancelled();
+
         // Call close project on all project items in the project.
         // Remember that some of them might have been loaded successfully:
         d->current_project->closeProject(task_ref);
@@ -371,8 +407,12 @@ bool Qtilities::ProjectManagement::ProjectManager::openProject(const QString& fi
         emit projectLoadingFinished(file_name,false);
         markProjectAsChangedDuringLoad(false);
 
-        if (task_ref)
-            task_ref->completeTask(ITask::TaskFailed);
+        if (task_ref) {
+            if (cancelled)
+                task_ref->stopTask(tr("Opening project was cancelled."),Logger::Warning);
+            else
+                task_ref->completeTask(ITask::TaskFailed);
+        }
 
         return false;
     }
@@ -512,7 +552,7 @@ void Qtilities::ProjectManagement::ProjectManager::refreshPartList() {
         if (part) {
             if (!itemNames.contains(part->projectItemName())) {
                 projectItems.append(part);
-                LOG_DEBUG(QString(tr("Project Manager: Found project item: %1")).arg(part->projectItemName()));
+                LOG_TAG_DEBUG(Qtilities::Logging::Logger::ProjectManagementLogTag,QString(tr("Project Manager: Found project item: %1")).arg(part->projectItemName()));
             } else
                 LOG_ERROR(tr("The project manager found duplicate project items called: ") + part->projectItemName() + tr(", the second occurance is on object: ") + projectItemObjects.at(i)->objectName());
         } else
@@ -546,6 +586,11 @@ void Qtilities::ProjectManagement::ProjectManager::setActiveProjectBusy(bool is_
     }
 }
 
+void Qtilities::ProjectManagement::ProjectManager::cancelProjectLoading() {
+    if (d->current_project)
+        d->current_project->cancelLoading();
+}
+
 bool Qtilities::ProjectManagement::ProjectManager::activeProjectBusy() const {
     return (d->current_project_busy_count > 0);
 }
@@ -616,6 +661,46 @@ bool ProjectManagement::ProjectManager::useProjectFileLocks() const {
     return d->use_project_file_locks;
 }
 
+void ProjectManagement::ProjectManager::setLazyProjectLoading(bool toggle) {
+    d->lazy_project_loading = toggle;
+}
+
+bool ProjectManagement::ProjectManager::lazyProjectLoading() const {
+    return d->lazy_project_loading;
+}
+
+void ProjectManagement::ProjectManager::setCompressProjects(bool toggle) {
+    d->compress_projects = toggle;
+}
+
+bool ProjectManagement::ProjectManager::compressProjects() const {
+    return d->compress_projects;
+}
+
+void ProjectManagement::ProjectManager::setParallelProjectSaving(bool toggle) {
+    d->parallel_project_saving = toggle;
+}
+
+bool ProjectManagement::ProjectManager::parallelProjectSaving() const {
+    return d->parallel_project_saving;
+}
+
+void ProjectManagement::ProjectManager::setIncrementalProjectSaving(bool toggle) {
+    d->incremental_project_saving = toggle;
+}
+
+bool ProjectManagement::ProjectManager::incrementalProjectSaving() const {
+    return d->incremental_project_saving;
+}
+
+void ProjectManagement::ProjectManager::setProjectJournalLimit(qint64 size) {
+    d->project_journal_limit = size;
+}
+
+qint64 ProjectManagement::ProjectManager::projectJournalLimit() const {
+    return d->project_journal_limit;
+}
+
 void Qtilities::ProjectManagement::ProjectManager::setCreateNewProjectOnStartup(bool toggle) {
     d->auto_create_new_project = toggle;
     writeSettings();
@@ -720,55 +805,46 @@ void Qtilities::ProjectManagement::ProjectManager::writeSettings() const {
         return;
 
     // Write the settings:
-    QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("Projects");
-    settings.setValue("open_last_project", d->open_last_project);
-    settings.setValue("auto_create_new_project", d->auto_create_new_project);
-    settings.setValue("recent_project_map", d->recent_project_names);
-    settings.setValue("recent_project_stack", d->recent_project_stack);
-    settings.setValue("use_custom_projects_path", d->use_custom_projects_paths);
-    settings.setValue("check_modified_projects", d->check_modified_projects);
-    settings.setValue("modified_projects_handling_policy", QVariant((int) d->modified_projects_handling_policy));
-    settings.setValue("custom_projects_paths", d->custom_projects_paths);
-    settings.setValue("default_custom_project_paths_category",defaultCustomProjectsCategory());
-    settings.endGroup();
-    settings.endGroup();
+    SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+    settings->setValue("Qtilities/Projects/open_last_project", d->open_last_project);
+    settings->setValue("Qtilities/Projects/auto_create_new_project", d->auto_create_new_project);
+    settings->setValue("Qtilities/Projects/recent_project_map", d->recent_project_names);
+    settings->setValue("Qtilities/Projects/recent_project_stack", d->recent_project_stack);
+    settings->setValue("Qtilities/Projects/use_custom_projects_path", d->use_custom_projects_paths);
+    settings->setValue("Qtilities/Projects/check_modified_projects", d->check_modified_projects);
+    settings->setValue("Qtilities/Projects/modified_projects_handling_policy", QVariant((int) d->modified_projects_handling_policy));
+    settings->setValue("Qtilities/Projects/custom_projects_paths", d->custom_projects_paths);
+    settings->setValue("Qtilities/Projects/default_custom_project_paths_category",defaultCustomProjectsCategory());
 }
 
 void Qtilities::ProjectManagement::ProjectManager::readSettings() {
-    // Load project management paramaters using QSettings()
-    QSettings settings(QtilitiesCoreApplication::qtilitiesSettingsPath(),QSettings::IniFormat);
-    settings.beginGroup("Qtilities");
-    settings.beginGroup("Projects");
-    d->open_last_project = settings.value("open_last_project", false).toBool();
-    d->auto_create_new_project = settings.value("auto_create_new_project", false).toBool();
-    d->use_custom_projects_paths = settings.value("use_custom_projects_path", false).toBool();
-    d->check_modified_projects = settings.value("check_modified_projects", true).toBool();
-    d->modified_projects_handling_policy = (ProjectManager::ModifiedProjectsHandlingPolicy) settings.value("modified_projects_handling_policy", 0).toInt();
-    d->recent_project_names = settings.value("recent_project_map", false).toMap();
-    d->recent_project_stack = settings.value("recent_project_stack", QStringList()).toStringList();
-    d->custom_projects_paths = settings.value("custom_projects_paths", false).toMap();
-    d->default_custom_project_paths_category = settings.value("default_custom_project_paths_category","Default").toString();
+    // Load project management paramaters from the settings store
+    SettingsStore* settings = QtilitiesCoreApplication::qtilitiesSettings();
+    d->open_last_project = settings->valueAs<bool>("Qtilities/Projects/open_last_project", false);
+    d->auto_create_new_project = settings->valueAs<bool>("Qtilities/Projects/auto_create_new_project", false);
+    d->use_custom_projects_paths = settings->valueAs<bool>("Qtilities/Projects/use_custom_projects_path", false);
+    d->check_modified_projects = settings->valueAs<bool>("Qtilities/Projects/check_modified_projects", true);
+    d->modified_projects_handling_policy = (ProjectManager::ModifiedProjectsHandlingPolicy) settings->value("Qtilities/Projects/modified_projects_handling_policy", 0).toInt();
+    d->recent_project_names = settings->value("Qtilities/Projects/recent_project_map", false).toMap();
+    d->recent_project_stack = settings->value("Qtilities/Projects/recent_project_stack", QStringList()).toStringList();
+    d->custom_projects_paths = settings->value("Qtilities/Projects/custom_projects_paths", false).toMap();
+    d->default_custom_project_paths_category = settings->value("Qtilities/Projects/default_custom_project_paths_category","Default").toString();
 
     // This is for backward compatibility with Qtilities v1.0:
     // If there was a custom project path saved in Qtilities v1.0, we load it and add it to the list of current custom project paths as the default:
-    if (settings.contains("custom_projects_path")) {
-        QString old_custom_projects_path = settings.value("custom_projects_path",QtilitiesApplication::applicationSessionPath() + QDir::separator() + "Projects").toString();
+    if (settings->contains("Qtilities/Projects/custom_projects_path")) {
+        QString old_custom_projects_path = settings->value("Qtilities/Projects/custom_projects_path",QtilitiesApplication::applicationSessionPath() + QDir::separator() + "Projects").toString();
         setCustomProjectsPath(old_custom_projects_path,"Default");
         // Now clear it:
-        //settings.remove("custom_projects_path");
+        //settings->remove("Qtilities/Projects/custom_projects_path");
     }
-
-    settings.endGroup();
-    settings.endGroup();
 }
 
 void Qtilities::ProjectManagement::ProjectManager::initialize() {
     if (d->is_initialized)
         return;
 
-    LOG_DEBUG(tr("Qtilities Project Management Framework, initialization started..."));
+    LOG_TAG_DEBUG(Qtilities::Logging::Logger::ProjectManagementLogTag,tr("Qtilities Project Management Framework, initialization started..."));
     readSettings();
 
     bool success = true;
@@ -782,7 +858,7 @@ void Qtilities::ProjectManagement::ProjectManager::initialize() {
 
         if (!last_project.isEmpty()) {
             LOG_INFO_P(tr("Opening project from last session from path: ") + last_project);
-            QApplication::processEvents();
+            IDLE_SCHEDULER->yieldToEventLoop();
             if (!openProject(last_project)) {
                 // We create a empty project when the last project was not valid and auto create project is set.
                 if (newProject())
@@ -811,9 +887,9 @@ void Qtilities::ProjectManagement::ProjectManager::initialize() {
 
     d->is_initialized = true;
     if (success)
-        LOG_DEBUG(tr("Qtilities Project Management Framework, initialization finished successfully..."));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ProjectManagementLogTag,tr("Qtilities Project Management Framework, initialization finished successfully..."));
     else
-        LOG_DEBUG(tr("Qtilities Project Management Framework, initialization finished with some errors..."));
+        LOG_TAG_DEBUG(Qtilities::Logging::Logger::ProjectManagementLogTag,tr("Qtilities Project Management Framework, initialization finished with some errors..."));
 }
 
 void Qtilities::ProjectManagement::ProjectManager::finalize() {
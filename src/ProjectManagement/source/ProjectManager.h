@@ -95,7 +95,7 @@ namespace Qtilities {
             /*!
               When prompting to save projects, the allowed project types will be used as the possible file types that the user see. You can define the suffix used for a specific project type in your application using setProjectTypeSuffix().
 
-              By default all available project types are allowed.
+              By default binary and XML projects are allowed. CBOR projects (IExportable::Cbor) are allowed by including them in setAllowedProjectTypes().
 
               \sa setAllowedProjectTypes()
               */
@@ -123,6 +123,7 @@ namespace Qtilities {
               The file naming conventions used by default are defined by the following constants:
               - Binary: qti_def_SUFFIX_PROJECT_BINARY
               - XML:    qti_def_SUFFIX_PROJECT_XML
+              - Cbor:   qti_def_SUFFIX_PROJECT_CBOR
 
               \sa setProjectTypeSuffix()
               */
@@ -175,6 +176,10 @@ namespace Qtilities {
               on the current project and then open the new project as if no project was opened.
 
               If the current project file passed as \p file_name this function does nothing.
+
+              Binary project files are read on a worker thread, after which the project items are imported one at a time. The event loop
+              runs between items, thus views show each item as soon as it is loaded. While the project is loading it is marked as busy
+              (see activeProjectBusy()), and the TaskOpenProject task reports the progress per item and can be stopped to cancel the load.
               */
             bool openProject(const QString& file_name);
             //! Close the current project.
@@ -316,6 +321,117 @@ namespace Qtilities {
              *\sa setUseProjectFileLocks()
              */
             bool useProjectFileLocks() const;
+            //! Sets if binary projects are loaded lazily.
+            /*!
+             *When enabled, binary project files are memory mapped when they are loaded. Observers saved using Qtilities::Qtilities_1_5 or later are
+             *then created without their subjects, which are only imported from the mapped file the first time they are accessed, for example when
+             *their node is expanded in a tree view or when an iterator reaches them. Thus opening a large project takes time proportional to what is
+             *accessed instead of to the size of the project. The project file stays mapped until all deferred subjects were imported, or until the
+             *observers which own them are deleted.
+             *
+             *Observers which were exported with relational data (see Qtilities::Core::ObserverData::ExportRelationalData) are always imported completely.
+             *
+             *The project file may be deleted or replaced while it is mapped, which is what happens when the project is saved. It must not be truncated
+             *or overwritten in place by other applications while it is mapped.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             *
+             *\sa lazyProjectLoading(), Qtilities::Core::CompactBinaryFormat::setDeferredImportSource()
+             */
+            void setLazyProjectLoading(bool toggle);
+            //! Gets if binary projects are loaded lazily.
+            /*!
+             *Default is false.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             *
+             *\sa setLazyProjectLoading()
+             */
+            bool lazyProjectLoading() const;
+            //! Sets if binary projects are compressed when they are saved.
+            /*!
+             *When enabled, binary project files are compressed using Qtilities::Core::CompressedDevice while they are exported. Compressed project files
+             *are recognized when they are opened, thus they can be opened regardless of this setting.
+             *
+             *When a compressed project is loaded lazily (see setLazyProjectLoading()), it is decompressed into memory since compressed files cannot be memory mapped.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             *
+             *\sa compressProjects()
+             */
+            void setCompressProjects(bool toggle);
+            //! Gets if binary projects are compressed when they are saved.
+            /*!
+             *Default is false.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             *
+             *\sa setCompressProjects()
+             */
+            bool compressProjects() const;
+            //! Sets if the project items of a project are exported concurrently when the project is saved.
+            /*!
+             *When enabled, every project item is exported into its own buffer on a thread pool, after which the buffers are written to the project file in
+             *the order of the project items. Thus, saving a project with many independent project items takes about as long as exporting its slowest item.
+             *The time taken to export each project item is logged to the save project task.
+             *
+             *Project items are exported while the GUI thread waits for them, thus project items must only read their data while they are exported, and must
+             *not create or change objects living in other threads. Messages logged by project items during concurrent exports are not logged to the save task.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             *
+             *\sa parallelProjectSaving()
+             */
+            void setParallelProjectSaving(bool toggle);
+            //! Gets if the project items of a project are exported concurrently when the project is saved.
+            /*!
+             *Default is false.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             *
+             *\sa setParallelProjectSaving()
+             */
+            bool parallelProjectSaving() const;
+            //! Sets if binary projects are saved incrementally.
+            /*!
+             *When enabled, saving a binary project to its current project file only exports the project items which are modified. They are appended to a
+             *journal next to the project file, of which the name is the project file name followed by Constants::qti_def_SUFFIX_PROJECT_JOURNAL. When the
+             *project is loaded, the project items saved in the journal replace the ones loaded from the project file. Thus, saving a large project where
+             *only a small project item changed does not rewrite the complete project.
+             *
+             *The journal is compacted into the project file, thus the complete project is saved and the journal removed, when the project is closed without
+             *unsaved changes and when the journal is larger than projectJournalLimit(). Saving the project to a different file always saves the complete project.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             *
+             *\sa incrementalProjectSaving(), setProjectJournalLimit(), Project::compactProject()
+             */
+            void setIncrementalProjectSaving(bool toggle);
+            //! Gets if binary projects are saved incrementally.
+            /*!
+             *Default is false.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             *
+             *\sa setIncrementalProjectSaving()
+             */
+            bool incrementalProjectSaving() const;
+            //! Sets the size in bytes of the project journal at which the next save compacts it into the project file.
+            /*!
+             *<i>This function was added in %Qtilities v1.5.</i>
+             *
+             *\sa projectJournalLimit(), setIncrementalProjectSaving()
+             */
+            void setProjectJournalLimit(qint64 size);
+            //! Gets the size in bytes of the project journal at which the next save compacts it into the project file.
+            /*!
+             *Default is 64MB.
+             *
+             *<i>This function was added in %Qtilities v1.5.</i>
+             *
+             *\sa setProjectJournalLimit()
+             */
+            qint64 projectJournalLimit() const;
             //! Sets the configuration option to create a new project when the no last open project is available.
             /*!
               This configuration setting has no effect if the openLastProjectOnStartup() is false.
@@ -337,12 +453,12 @@ namespace Qtilities {
             ModifiedProjectsHandlingPolicy modifiedProjectsHandlingPolicy() const;
             //! Sets how the project manager should handle modified open projects when set to check for them.
             void setModifiedProjectsHandlingPolicy(ModifiedProjectsHandlingPolicy handling_policy);
-            //! Saves the project manager settings using QSettings.
+            //! Saves the project manager settings in the %Qtilities settings store, see QtilitiesCoreApplication::qtilitiesSettings().
             /*!
               For more information about the saving of settings by %Qtilities classes, see \ref configuration_widget_storage_layout.
               */
             void writeSettings() const;
-            //! Loads the project manager settings using QSettings.
+            //! Loads the project manager settings from the %Qtilities settings store, see QtilitiesCoreApplication::qtilitiesSettings().
             /*!
               For more information about the saving of settings by %Qtilities classes, see \ref configuration_widget_storage_layout.
               */
@@ -488,6 +604,8 @@ namespace Qtilities {
             void handleApplicationBusyStateChanged();
             void refreshRecentProjects();
             void handleRecentProjectActionTriggered();
+            //! Cancels the loading of the current project when the open project task is stopped.
+            void cancelProjectLoading();
 
         public:
             // --------------------------------
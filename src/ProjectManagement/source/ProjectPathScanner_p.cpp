@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ProjectPathScanner_p.h"
+
+#include <FileLocker>
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QRunnable>
+
+using namespace Qtilities::Core;
+using namespace Qtilities::ProjectManagement;
+
+namespace {
+    //! The maximum number of paths checked at the same time. Checks wait on the file system, not the CPU.
+    const int qti_private_MAX_PARALLEL_PATH_SCANS = 8;
+
+    //! Checks a single path and posts the result to ProjectPathScanner::instance().
+    class qti_private_PathScanWorker : public QRunnable {
+    public:
+        qti_private_PathScanWorker(const QString& path, bool directory) : path(path), directory(directory) {}
+
+        void run() {
+            ProjectPathScanner::PathState state = ProjectPathScanner::PathMissing;
+            QFileInfo fi(path);
+            if (directory) {
+                if (fi.isDir())
+                    state = ProjectPathScanner::PathExists;
+            } else if (fi.isFile()) {
+                FileLocker file_locker;
+                state = file_locker.lockInfo(path).is_locked ? ProjectPathScanner::PathLocked : ProjectPathScanner::PathExists;
+            }
+
+            // The scanner is never deleted, see ProjectPathScanner::instance():
+            QMetaObject::invokeMethod(ProjectPathScanner::instance(),"handleScanResult",Qt::QueuedConnection,Q_ARG(QString,path),Q_ARG(int,(int) state));
+        }
+
+        QString path;
+        bool directory;
+    };
+}
+
+ProjectPathScanner* ProjectPathScanner::instance() {
+    static ProjectPathScanner* m_Instance = 0;
+    if (!m_Instance)
+        m_Instance = new ProjectPathScanner;
+    return m_Instance;
+}
+
+ProjectPathScanner::ProjectPathScanner() : QObject() {
+    d_pool.setMaxThreadCount(qti_private_MAX_PARALLEL_PATH_SCANS);
+    d_timeout_timer.setInterval(scan_timeout / 4);
+    connect(&d_timeout_timer,SIGNAL(timeout()),SLOT(handleScanTimeout()));
+}
+
+void ProjectPathScanner::scanPaths(const QStringList& paths, bool directories) {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    foreach (const QString& path, paths) {
+        if (path.isEmpty() || d_pending.contains(path))
+            continue;
+
+        d_pending[path] = now;
+        d_pool.start(new qti_private_PathScanWorker(path,directories));
+    }
+
+    if (!d_pending.isEmpty() && !d_timeout_timer.isActive())
+        d_timeout_timer.start();
+}
+
+ProjectPathScanner::PathState ProjectPathScanner::pathState(const QString& path) const {
+    return d_states.value(path,PathPending);
+}
+
+QString ProjectPathScanner::pathStateDescription(PathState state) {
+    switch (state) {
+    case PathPending:
+        return tr("Checking path...");
+    case PathExists:
+        return QString();
+    case PathMissing:
+        return tr("The path does not exist.");
+    case PathLocked:
+        return tr("The project is locked.");
+    case PathNotResponding:
+        return tr("The path is not responding.");
+    }
+    return QString();
+}
+
+void ProjectPathScanner::handleScanResult(const QString& path, int state) {
+    d_pending.remove(path);
+    if (d_pending.isEmpty())
+        d_timeout_timer.stop();
+
+    d_states[path] = (PathState) state;
+    emit pathScanned(path,state);
+}
+
+void ProjectPathScanner::handleScanTimeout() {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QStringList timed_out_paths;
+    QHash<QString,qint64>::const_iterator itr = d_pending.constBegin();
+    for (; itr != d_pending.constEnd(); ++itr) {
+        if (now - itr.value() >= scan_timeout && d_states.value(itr.key()) != PathNotResponding)
+            timed_out_paths << itr.key();
+    }
+
+    // The checks keep running, their results are reported when they complete:
+    foreach (const QString& path, timed_out_paths) {
+        d_states[path] = PathNotResponding;
+        emit pathScanned(path,PathNotResponding);
+    }
+}
@@ -0,0 +1,80 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef PROJECT_PATH_SCANNER_P_H
+#define PROJECT_PATH_SCANNER_P_H
+
+#include <QObject>
+#include <QHash>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+
+namespace Qtilities {
+    namespace ProjectManagement {
+        /*!
+          \class ProjectPathScanner
+          \brief The ProjectPathScanner class checks the existence and lock states of project files and project directories in the background.
+
+          ProjectsBrowser and ProjectManagementConfig show recent project files and custom projects paths which might be on slow or unreachable
+          network shares. Instead of checking these paths when the widgets are shown, the widgets show the last known state of each path
+          using pathState() and call scanPaths(). The paths are checked on a thread pool owned by the scanner, and pathScanned() is emitted as the result
+          for each path arrives. Paths which did not respond within scan_timeout milliseconds are reported as PathNotResponding, and are updated again
+          when their check completes. A path is never checked more than once at the same time.
+
+          The scanner must only be used from the GUI thread.
+         */
+        class ProjectPathScanner : public QObject {
+            Q_OBJECT
+
+        public:
+            //! The states of paths reported by the scanner.
+            enum PathState {
+                PathPending,        /*!< The path was not checked yet. */
+                PathExists,         /*!< The path exists, and is not locked when it is a project file. */
+                PathMissing,        /*!< The path does not exist. */
+                PathLocked,         /*!< The path is a project file which is locked, see FileLocker. */
+                PathNotResponding   /*!< The check of the path did not complete within scan_timeout milliseconds. */
+            };
+
+            static ProjectPathScanner* instance();
+
+            //! Checks \p paths in the background. When \p directories is true the paths must be existing directories, otherwise they must be existing files.
+            void scanPaths(const QStringList& paths, bool directories);
+            //! Returns the last known state of \p path.
+            PathState pathState(const QString& path) const;
+            //! Returns a description of \p state which can be shown to the user.
+            static QString pathStateDescription(PathState state);
+
+            //! The time in milliseconds after which paths which are still being checked are reported as PathNotResponding.
+            static const int scan_timeout = 3000;
+
+        signals:
+            //! Emitted when the state of \p path is known, \p state is a PathState.
+            void pathScanned(const QString& path, int state);
+
+        private slots:
+            void handleScanResult(const QString& path, int state);
+            void handleScanTimeout();
+
+        private:
+            ProjectPathScanner();
+
+            QThreadPool                 d_pool;
+            QTimer                      d_timeout_timer;
+            QHash<QString,PathState>    d_states;
+            //! The paths which are being checked, with the times at which their checks started.
+            QHash<QString,qint64>       d_pending;
+        };
+    }
+}
+
+#endif // PROJECT_PATH_SCANNER_P_H
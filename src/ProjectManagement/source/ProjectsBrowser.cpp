@@ -12,6 +12,7 @@
 #include "ProjectsBrowser.h"
 #include "ui_ProjectsBrowser.h"
 #include "ProjectManager.h"
+#include "ProjectPathScanner_p.h"
 
 #include <QtilitiesApplication>
 
@@ -26,6 +27,7 @@ Qtilities::ProjectManagement::ProjectsBrowser::ProjectsBrowser(QWidget *parent)
 
     connect(PROJECT_MANAGER,SIGNAL(recentProjectsChanged(QStringList,QStringList)),SLOT(refreshContents()));
     connect(PROJECT_MANAGER,SIGNAL(customProjectPathsChanged()),SLOT(refreshContents()));
+    connect(ProjectPathScanner::instance(),SIGNAL(pathScanned(QString,int)),SLOT(handleProjectPathScanned(QString,int)));
 
     file_system_browser = new SideWidgetFileSystem(QtilitiesApplication::applicationSessionPath());
     connect(file_system_browser,SIGNAL(requestEditor(QString)),SLOT(openProjectAtPath(QString)));
@@ -53,24 +55,27 @@ Qtilities::ProjectManagement::ProjectsBrowser::~ProjectsBrowser() {
 }
 
 void Qtilities::ProjectManagement::ProjectsBrowser::refreshContents() {
-    // Add list of recent files:
+    // Add list of recent files. The paths are checked in the background, thus the items show the
+    // last known states of their paths until the checks complete:
     ui->listWidgetRecent->clear();
+    QStringList recent_paths;
     for (int i = 0; i < PROJECT_MANAGER->recentProjectNames().count(); ++i) {
         QString name = PROJECT_MANAGER->recentProjectNames().at(i);
+        QString path = PROJECT_MANAGER->recentProjectPath(name);
         QListWidgetItem *newItem = new QListWidgetItem;
         newItem->setText(name);
-        newItem->setToolTip(PROJECT_MANAGER->recentProjectPath(name));
-
-        if (name == PROJECT_MANAGER->defaultCustomProjectsCategory()) {
-            newItem->setForeground(Qt::red);
-        }
+        newItem->setData(Qt::UserRole,path);
+        updateItemPathState(newItem,ProjectPathScanner::instance()->pathState(path));
 
         ui->listWidgetRecent->insertItem(i, newItem);
+        recent_paths << path;
     }
+    ProjectPathScanner::instance()->scanPaths(recent_paths,false);
 
     // Refresh project categories list:
     ui->listCustomCategories->clear();
     QListWidgetItem* current_item = 0;
+    QStringList custom_paths;
     for (int i = 0; i < PROJECT_MANAGER->customProjectCategories().count(); ++i) {
         QString category = PROJECT_MANAGER->customProjectCategories().at(i);
         QListWidgetItem *newItem = new QListWidgetItem;
@@ -81,10 +86,45 @@ void Qtilities::ProjectManagement::ProjectsBrowser::refreshContents() {
             ui->widgetCustomBrowser->setEnabled(true);
         }
         newItem->setText(category);
-        newItem->setToolTip(current_path);
+        newItem->setData(Qt::UserRole,current_path);
+        updateItemPathState(newItem,ProjectPathScanner::instance()->pathState(current_path));
         ui->listCustomCategories->insertItem(i, newItem);
+        custom_paths << current_path;
     }
     ui->listCustomCategories->setCurrentItem(current_item);
+    ProjectPathScanner::instance()->scanPaths(custom_paths,true);
+}
+
+void Qtilities::ProjectManagement::ProjectsBrowser::handleProjectPathScanned(const QString& path, int state) {
+    for (int i = 0; i < ui->listWidgetRecent->count(); ++i) {
+        QListWidgetItem* item = ui->listWidgetRecent->item(i);
+        if (item->data(Qt::UserRole).toString() == path)
+            updateItemPathState(item,state);
+    }
+    for (int i = 0; i < ui->listCustomCategories->count(); ++i) {
+        QListWidgetItem* item = ui->listCustomCategories->item(i);
+        if (item->data(Qt::UserRole).toString() == path)
+            updateItemPathState(item,state);
+    }
+}
+
+void Qtilities::ProjectManagement::ProjectsBrowser::updateItemPathState(QListWidgetItem* item, int state) {
+    QString path = item->data(Qt::UserRole).toString();
+    QString description = ProjectPathScanner::pathStateDescription((ProjectPathScanner::PathState) state);
+    if (description.isEmpty())
+        item->setToolTip(path);
+    else
+        item->setToolTip(path + "\n" + description);
+
+    QFont font = item->font();
+    font.setItalic(state == ProjectPathScanner::PathPending || state == ProjectPathScanner::PathNotResponding);
+    item->setFont(font);
+    if (state == ProjectPathScanner::PathMissing || state == ProjectPathScanner::PathLocked)
+        item->setForeground(Qt::red);
+    else if (state == ProjectPathScanner::PathNotResponding)
+        item->setForeground(Qt::gray);
+    else
+        item->setData(Qt::ForegroundRole,QVariant());
 }
 
 void Qtilities::ProjectManagement::ProjectsBrowser::on_btnClearRecent_clicked() {
@@ -96,7 +136,7 @@ void Qtilities::ProjectManagement::ProjectsBrowser::on_buttonBox_accepted() {
     if (ui->tabWidget->currentIndex() == 0) {
         QListWidgetItem* item = ui->listWidgetRecent->currentItem();
         if (item)
-            project_path = item->toolTip();
+            project_path = item->data(Qt::UserRole).toString();
     } else if (ui->tabWidget->currentIndex() == 1) {
         project_path = file_system_browser->filePath();
     }
@@ -106,7 +146,7 @@ void Qtilities::ProjectManagement::ProjectsBrowser::on_buttonBox_accepted() {
 void Qtilities::ProjectManagement::ProjectsBrowser::on_listCustomCategories_itemClicked(QListWidgetItem *item) {
     if (item) {
         ui->widgetCustomBrowser->setEnabled(true);
-        file_system_browser->setPath(item->toolTip());
+        file_system_browser->setPath(item->data(Qt::UserRole).toString());
     } else {
         ui->widgetCustomBrowser->setEnabled(false);
     }
@@ -115,7 +155,7 @@ void Qtilities::ProjectManagement::ProjectsBrowser::on_listCustomCategories_item
 void Qtilities::ProjectManagement::ProjectsBrowser::on_listWidgetRecent_itemDoubleClicked(QListWidgetItem *item) {
     QString project_path;
     if (item)
-        project_path = item->toolTip();
+        project_path = item->data(Qt::UserRole).toString();
     openProjectAtPath(project_path);
 }
 
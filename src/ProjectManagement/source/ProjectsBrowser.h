@@ -48,8 +48,13 @@ namespace Qtilities {
             void on_buttonBox_rejected();
             void on_btnRemoveNonExisting_clicked();
             void openProjectAtPath(const QString& project_path);
+            //! Updates the items showing \p path when its state was checked in the background.
+            void handleProjectPathScanned(const QString& path, int state);
 
         private:
+            //! Shows the ProjectPathScanner::PathState \p state of the path of \p item.
+            void updateItemPathState(QListWidgetItem* item, int state);
+
             Ui::ProjectsBrowser*    ui;
             SideWidgetFileSystem*   file_system_browser;
         };
@@ -69,6 +69,10 @@ include(Dependencies.pri)
 #   Qtilities is done by logging execution times as debug messages.
 #   DEFINES += QTILITIES_BENCHMARKING
 #
+#   When defined, the performance counter macros expand to nothing and
+#   no runtime performance counters are collected.
+#   DEFINES += QTILITIES_NO_PERFORMANCE_COUNTERS
+#
 #   When defined, the CoreGui library does not contain the HELP_MANAGER,
 #   removing the dependency on QtHelp. Also, the Help Plugin does not
 #   contain anything when defined. To remove this definition, add
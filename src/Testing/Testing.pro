@@ -12,7 +12,7 @@ include(../Qtilities.pri)
 INCLUDEPATH += $$QTILITIES_INCLUDE/Testing
 
 CONFIG += qt dll
-QT += xml gui
+QT += xml gui network
 # Note: xml module is deprecated
 greaterThan(QT_MAJOR_VERSION, 4) { QT += widgets printsupport testlib }
 lessThan(QT_MAJOR_VERSION, 5) { CONFIG += qtestlib }
@@ -24,6 +24,9 @@ TEMPLATE = lib
 DEFINES += TESTING_LIBRARY
 DESTDIR = $$QTILITIES_BIN
 
+# The benchmarks use GetProcessMemoryInfo() to measure the peak memory usage:
+win32:LIBS += -lpsapi
+
 OBJECTS_DIR = $$QTILITIES_TEMP/Testing
 MOC_DIR = $$QTILITIES_TEMP/Testing
 RCC_DIR = $$QTILITIES_TEMP/Testing
@@ -36,9 +39,38 @@ UI_DIR = $$QTILITIES_TEMP/Testing
 contains(DEFINES, QTILITIES_TESTING) {
     HEADERS += \
             source/BenchmarkTests.h \
+            source/ObserverBenchmarks.h \
             source/TestAbstractTreeItem.h \
             source/TestActivityPolicyFilter.h \
+            source/TestCborStream.h \
+            source/TestDeferredImport.h \
+            source/TestDeferredPluginMode.h \
             source/TestExporting.h \
+            source/TestFileLoggerEngine.h \
+            source/TestFileSystemStatCache.h \
+            source/TestHeadlessTree.h \
+            source/TestIdleScheduler.h \
+            source/TestLargeTextFile.h \
+            source/TestLogTags.h \
+            source/TestNetworkLoggerEngine.h \
+            source/TestObjectHandle.h \
+            source/TestObserverClone.h \
+            source/TestObserverTableModel.h \
+            source/TestObserverTreeDiff.h \
+            source/TestObserverTreeModel.h \
+            source/TestObserverTreeModelProxyFilter.h \
+            source/TestObserverUndoStack.h \
+            source/TestPagedSubjectStore.h \
+            source/TestPointerList.h \
+            source/TestProjectJournal.h \
+            source/TestQtilitiesProcess.h \
+            source/TestQtilitiesProcessPool.h \
+            source/TestSessionLogStore.h \
+            source/TestSettingsStore.h \
+            source/TestStartupProfiler.h \
+            source/TestTaskSummaryModel.h \
+            source/TestTreeBuilder.h \
+            source/TestZipper.h \
             source/TestingConstants.h \
             source/Testing_global.h \
             source/TestNamingPolicyFilter.h \
@@ -54,16 +86,44 @@ contains(DEFINES, QTILITIES_TESTING) {
 
     SOURCES += \
             source/BenchmarkTests.cpp \
+            source/ObserverBenchmarks.cpp \
             source/TestAbstractTreeItem.cpp \
             source/TestActivityPolicyFilter.cpp \
+            source/TestCborStream.cpp \
+            source/TestDeferredImport.cpp \
+            source/TestDeferredPluginMode.cpp \
             source/TestExporting.cpp \
+            source/TestFileLoggerEngine.cpp \
+            source/TestFileSystemStatCache.cpp \
+            source/TestHeadlessTree.cpp \
+            source/TestIdleScheduler.cpp \
+            source/TestLargeTextFile.cpp \
+            source/TestLogTags.cpp \
             source/TestNamingPolicyFilter.cpp \
+            source/TestNetworkLoggerEngine.cpp \
+            source/TestObjectHandle.cpp \
             source/TestObjectManager.cpp \
             source/TestObserver.cpp \
+            source/TestObserverClone.cpp \
             source/TestObserverRelationalTable.cpp \
+            source/TestObserverTableModel.cpp \
+            source/TestObserverTreeDiff.cpp \
+            source/TestObserverTreeModel.cpp \
+            source/TestObserverTreeModelProxyFilter.cpp \
+            source/TestObserverUndoStack.cpp \
+            source/TestPagedSubjectStore.cpp \
+            source/TestPointerList.cpp \
+            source/TestProjectJournal.cpp \
+            source/TestQtilitiesProcess.cpp \
+            source/TestQtilitiesProcessPool.cpp \
+            source/TestSessionLogStore.cpp \
+            source/TestSettingsStore.cpp \
+            source/TestStartupProfiler.cpp \
             source/TestSubjectIterator.cpp \
             source/TestSubjectTypeFilter.cpp \
             source/TestTask.cpp \
+            source/TestTaskSummaryModel.cpp \
+            source/TestTreeBuilder.cpp \
             source/TestTreeFileItem.cpp \
             source/TestTreeIterator.cpp \
             source/TestVersionNumber.cpp \
@@ -88,6 +148,7 @@ SOURCES += \
         source/FunctionCallAnalyzer.cpp \
         source/TestFileSetInfo.cpp \
         source/TestFrontend.cpp \
+            source/TestZipper.cpp \
 
 FORMS += \
         source/TestFrontend.ui \
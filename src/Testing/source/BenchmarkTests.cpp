@@ -14,7 +14,224 @@
 #include <QtilitiesCoreGui>
 using namespace QtilitiesCoreGui;
 
+#include <QBuffer>
 #include <QDomDocument>
+#include <QElapsedTimer>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX) && !defined(Q_OS_LINUX)
+#include <sys/resource.h>
+#endif
+
+namespace Qtilities {
+    namespace Testing {
+        //! The shapes of the trees used by the export and import benchmarks.
+        enum BenchmarkTreeShape {
+            DeepTree,
+            WideTree,
+            CategorizedTree,
+            MultiParentTree
+        };
+
+        static QString benchmarkTreeShapeName(int shape) {
+            if (shape == DeepTree)
+                return "deep";
+            else if (shape == WideTree)
+                return "wide";
+            else if (shape == CategorizedTree)
+                return "categorized";
+            else
+                return "multi-parent";
+        }
+
+        //! Builds a tree of the given shape with approximately \p subject_count subjects in total.
+        static TreeNode* createBenchmarkTree(int shape, int subject_count) {
+            TreeNode* root = new TreeNode("Benchmark Root");
+
+            if (shape == DeepTree) {
+                const int levels = 100;
+                const int items_per_level = qMax(1,subject_count / levels - 1);
+                TreeNode* node = root;
+                for (int l = 0; l < levels; ++l) {
+                    for (int i = 0; i < items_per_level; ++i)
+                        node->addItem(QString("Item %1_%2").arg(l).arg(i));
+                    node = node->addNode(QString("Level %1").arg(l));
+                }
+            } else if (shape == WideTree) {
+                for (int i = 0; i < subject_count; ++i)
+                    root->addItem(QString("Item %1").arg(i));
+            } else if (shape == CategorizedTree) {
+                const int nodes = 10;
+                const int items_per_node = qMax(1,subject_count / nodes - 1);
+                root->enableCategorizedDisplay();
+                for (int n = 0; n < nodes; ++n) {
+                    TreeNode* node = root->addNode(QString("Node %1").arg(n),QtilitiesCategory("Nodes"));
+                    node->enableCategorizedDisplay();
+                    for (int i = 0; i < items_per_node; ++i)
+                        node->addItem(QString("Item %1_%2").arg(n).arg(i),QtilitiesCategory(QString("Category %1::Sub Category %2").arg(i % 10).arg(i % 3),"::"));
+                }
+            } else {
+                // Every item is attached to two nodes, thus exports with relational data must reconstruct both parents:
+                const int nodes = 20;
+                QList<TreeNode*> node_list;
+                for (int n = 0; n < nodes; ++n)
+                    node_list << root->addNode(QString("Node %1").arg(n));
+                const int item_count = qMax(1,(subject_count - nodes) / 2);
+                for (int i = 0; i < item_count; ++i) {
+                    TreeItem* item = node_list.at(i % nodes)->addItem(QString("Item %1").arg(i));
+                    node_list.at((i + 1) % nodes)->addItem(item);
+                }
+            }
+
+            return root;
+        }
+
+        //! Exports \p node in the given format, returns the exported data.
+        static IExportable::ExportResultFlags exportBenchmarkTree(TreeNode* node, const QString& format, QByteArray* data, ObserverData::ExportItemFlags export_flags = ObserverData::ExportData) {
+            data->clear();
+            IExportable::ExportResultFlags result = IExportable::Failed;
+            if (format.startsWith("binary")) {
+                QDataStream stream(data,QIODevice::WriteOnly);
+                stream.setVersion(QDataStream::Qt_4_7);
+                node->setExportVersion(format == "binary-1.2" ? Qtilities::Qtilities_1_2 : Qtilities::Qtilities_1_5);
+                result = node->exportBinaryExt(stream,export_flags);
+            } else if (format == "xml-dom") {
+                node->setExportVersion(Qtilities::Qtilities_1_5);
+                QDomDocument doc("QtilitiesBenchmark");
+                QDomElement root = doc.createElement("QtilitiesBenchmark");
+                doc.appendChild(root);
+                QDomElement object_node = doc.createElement("object_node");
+                root.appendChild(object_node);
+                result = node->exportXmlExt(&doc,&object_node,export_flags);
+                *data = doc.toByteArray(2);
+            } else if (format == "xml-stream") {
+                node->setExportVersion(Qtilities::Qtilities_1_5);
+                QBuffer buffer(data);
+                buffer.open(QIODevice::WriteOnly);
+                QXmlStreamWriter writer(&buffer);
+                writer.setAutoFormatting(true);
+                writer.writeStartDocument();
+                writer.writeStartElement("QtilitiesBenchmark");
+                writer.writeStartElement("object_node");
+                result = node->exportXmlStreamExt(&writer,export_flags);
+                writer.writeEndElement();
+                writer.writeEndElement();
+                writer.writeEndDocument();
+            }
+            return result;
+        }
+
+        //! Imports data exported using exportBenchmarkTree() into \p node.
+        static IExportable::ExportResultFlags importBenchmarkTree(TreeNode* node, const QString& format, const QByteArray& data) {
+            QList<QPointer<QObject> > import_list;
+            if (format.startsWith("binary")) {
+                QDataStream stream(data);
+                stream.setVersion(QDataStream::Qt_4_7);
+                node->setExportVersion(format == "binary-1.2" ? Qtilities::Qtilities_1_2 : Qtilities::Qtilities_1_5);
+                return node->importBinary(stream,import_list);
+            } else if (format == "xml-dom") {
+                node->setExportVersion(Qtilities::Qtilities_1_5);
+                QDomDocument doc("QtilitiesBenchmark");
+                if (!doc.setContent(data))
+                    return IExportable::Failed;
+                QDomElement object_node = doc.documentElement().firstChildElement("object_node");
+                return node->importXml(&doc,&object_node,import_list);
+            } else if (format == "xml-stream") {
+                node->setExportVersion(Qtilities::Qtilities_1_5);
+                QXmlStreamReader reader(data);
+                if (!reader.readNextStartElement() || !reader.readNextStartElement())
+                    return IExportable::Failed;
+                return node->importXmlStream(&reader,import_list);
+            }
+            return IExportable::Failed;
+        }
+
+        //! Resets the peak memory usage of the process where the platform supports it, thus peakMemoryUsage() reports the peak since the reset.
+        static void resetPeakMemoryUsage() {
+        #if defined(Q_OS_LINUX)
+            QFile file("/proc/self/clear_refs");
+            if (file.open(QIODevice::WriteOnly))
+                file.write("5");
+        #endif
+        }
+
+        //! Returns the peak memory usage of the process in KB, or -1 when it is not known on the platform.
+        static qint64 peakMemoryUsage() {
+        #if defined(Q_OS_LINUX)
+            QFile file("/proc/self/status");
+            if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+                return -1;
+            QByteArray line = file.readLine();
+            while (!line.isEmpty()) {
+                if (line.startsWith("VmHWM:"))
+                    return line.mid(6).trimmed().split(' ').front().toLongLong();
+                line = file.readLine();
+            }
+            return -1;
+        #elif defined(Q_OS_WIN)
+            PROCESS_MEMORY_COUNTERS counters;
+            if (GetProcessMemoryInfo(GetCurrentProcess(),&counters,sizeof(counters)))
+                return (qint64) counters.PeakWorkingSetSize / 1024;
+            return -1;
+        #elif defined(Q_OS_UNIX)
+            struct rusage usage;
+            if (getrusage(RUSAGE_SELF,&usage) != 0)
+                return -1;
+            #if defined(Q_OS_MAC)
+            return (qint64) usage.ru_maxrss / 1024;
+            #else
+            return (qint64) usage.ru_maxrss;
+            #endif
+        #else
+            return -1;
+        #endif
+        }
+
+        // Logger engine which only counts the messages it receives, used to benchmark the logger itself.
+        class CountingLoggerEngine : public AbstractLoggerEngine
+        {
+        public:
+            CountingLoggerEngine() : AbstractLoggerEngine(), message_count(0) {}
+
+            bool initialize() { abstractLoggerEngineData->is_initialized = true; return true; }
+            void finalize() { abstractLoggerEngineData->is_initialized = false; }
+            QString description() const { return "Counts logged messages."; }
+            QString status() const { return QString::number(message_count); }
+            bool isFormattingEngineConstant() const { return true; }
+            void logMessage(const QString& message, Logger::MessageType message_type) {
+                Q_UNUSED(message)
+                Q_UNUSED(message_type)
+                ++message_count;
+            }
+
+            int message_count;
+        };
+    }
+}
+
+struct Qtilities::Testing::BenchmarkTestsPrivateData {
+    QString results_file;
+};
+
+Qtilities::Testing::BenchmarkTests::BenchmarkTests(QObject* parent) : QObject(parent) {
+    d = new BenchmarkTestsPrivateData;
+}
+
+Qtilities::Testing::BenchmarkTests::~BenchmarkTests() {
+    delete d;
+}
+
+void Qtilities::Testing::BenchmarkTests::setResultsFile(const QString& file_name) {
+    d->results_file = file_name;
+}
+
+QString Qtilities::Testing::BenchmarkTests::resultsFile() const {
+    return d->results_file;
+}
 
 int Qtilities::Testing::BenchmarkTests::execTest(int argc, char ** argv) {
     return QTest::qExec(this,argc,argv);
@@ -53,6 +270,10 @@ void Qtilities::Testing::BenchmarkTests::benchmarkObserverExport_1_0_1_0() {
     obj_source->setExportVersion(Qtilities::Qtilities_1_0);
 
     QBENCHMARK {
+        // Export to a new element on every iteration, thus the file only contains the tree once:
+        root.removeChild(rootItem);
+        rootItem = doc.createElement("object_node");
+        root.appendChild(rootItem);
         QCOMPARE(obj_source->exportXml(&doc,&rootItem), IExportable::Complete);
     }
 
@@ -68,24 +289,394 @@ void Qtilities::Testing::BenchmarkTests::benchmarkObserverExport_1_0_1_0() {
 
 void Qtilities::Testing::BenchmarkTests::benchmarkObserverImport_1_0_1_0() {
     // ---------------------------------------------------
-    // Test export only with categories:
+    // Test import only with categories, using the file written by benchmarkObserverExport_1_0_1_0():
     // ---------------------------------------------------
-    TreeNode* obj_import_xml = new TreeNode;
-
     QFile file("testObserverDataOnlyWithCategoriesBenchmark_0_3_0_3.xml");
-    file.open(QIODevice::WriteOnly);
+    if (!file.open(QIODevice::ReadOnly))
+        QFAIL("The file written by benchmarkObserverExport_1_0_1_0() does not exist, run it first.");
     QDomDocument doc("QtilitiesTesting");
-    QDomElement root = doc.createElement("QtilitiesTesting");
-    doc.appendChild(root);
-    QDomElement rootItem = doc.createElement("object_node");
-    root.appendChild(rootItem);
+    QVERIFY(doc.setContent(&file));
+    file.close();
+    QDomElement rootItem = doc.documentElement().firstChildElement("object_node");
+    QVERIFY(!rootItem.isNull());
 
     // Do the import:
-    obj_import_xml->setExportVersion(Qtilities::Qtilities_1_0);
-    QList<QPointer<QObject> > import_list;
+    QList<TreeNode*> imported_nodes;
+    QBENCHMARK {
+        TreeNode* obj_import_xml = new TreeNode;
+        obj_import_xml->setExportVersion(Qtilities::Qtilities_1_0);
+        QList<QPointer<QObject> > import_list;
+        QCOMPARE(obj_import_xml->importXml(&doc,&rootItem,import_list), IExportable::Complete);
+        imported_nodes << obj_import_xml;
+    }
 
-    QCOMPARE(obj_import_xml->importXml(&doc,&rootItem,import_list), IExportable::Complete);
+    QVERIFY(imported_nodes.front()->subjectCount() > 0);
+    qDeleteAll(imported_nodes);
+}
 
-    file.close();
-    delete obj_import_xml;
+void Qtilities::Testing::BenchmarkTests::addTreeRows(bool binary_formats, bool xml_formats) {
+    QTest::addColumn<int>("Shape");
+    QTest::addColumn<int>("Size");
+    QTest::addColumn<QString>("Format");
+
+    QStringList formats;
+    if (binary_formats)
+        formats << "binary-1.2" << "binary-1.5";
+    if (xml_formats)
+        formats << "xml-dom" << "xml-stream";
+    QList<int> sizes;
+    sizes << 1000 << 10000;
+
+    for (int shape = DeepTree; shape <= MultiParentTree; ++shape) {
+        for (int s = 0; s < sizes.count(); ++s) {
+            for (int f = 0; f < formats.count(); ++f) {
+                QString tag = QString("%1 %2 %3").arg(benchmarkTreeShapeName(shape)).arg(sizes.at(s)).arg(formats.at(f));
+                QTest::newRow(tag.toUtf8().constData()) << shape << sizes.at(s) << formats.at(f);
+            }
+        }
+    }
+}
+
+void Qtilities::Testing::BenchmarkTests::recordResult(const QString& benchmark, int iterations, qint64 elapsed_nsecs, int bytes, qint64 peak_memory_kb) {
+    if (d->results_file.isEmpty() || iterations == 0)
+        return;
+
+    QFETCH(int, Shape);
+    QFETCH(int, Size);
+    QFETCH(QString, Format);
+
+    QFile file(d->results_file);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "Failed to open benchmark results file:" << file.errorString();
+        return;
+    }
+
+    QTextStream out(&file);
+    if (file.size() == 0)
+        out << "qtilities_version,qt_version,timestamp,benchmark,shape,size,format,iterations,msecs_per_iteration,bytes,peak_memory_kb\n";
+    out << QtilitiesCoreApplication::qtilitiesVersionString() << ","
+        << qVersion() << ","
+        << QDateTime::currentDateTime().toString(Qt::ISODate) << ","
+        << benchmark << ","
+        << benchmarkTreeShapeName(Shape) << ","
+        << Size << ","
+        << Format << ","
+        << iterations << ","
+        << QString::number(elapsed_nsecs / (1000000.0 * iterations),'f',3) << ","
+        << bytes << ","
+        << peak_memory_kb << "\n";
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkExport_data() {
+    addTreeRows(true,true);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkExport() {
+    QFETCH(int, Shape);
+    QFETCH(int, Size);
+    QFETCH(QString, Format);
+
+    TreeNode* obj_source = createBenchmarkTree(Shape,Size);
+    QByteArray data;
+
+    resetPeakMemoryUsage();
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        timer.start();
+        QCOMPARE(exportBenchmarkTree(obj_source,Format,&data), IExportable::Complete);
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+    }
+    recordResult("export",iterations,elapsed,data.size(),peakMemoryUsage());
+
+    delete obj_source;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkImport_data() {
+    addTreeRows(true,true);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkImport() {
+    QFETCH(int, Shape);
+    QFETCH(int, Size);
+    QFETCH(QString, Format);
+
+    QByteArray data;
+    {
+        TreeNode* obj_source = createBenchmarkTree(Shape,Size);
+        QCOMPARE(exportBenchmarkTree(obj_source,Format,&data), IExportable::Complete);
+        delete obj_source;
+    }
+
+    resetPeakMemoryUsage();
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        TreeNode* obj_import = new TreeNode("Benchmark Root");
+        timer.start();
+        QCOMPARE(importBenchmarkTree(obj_import,Format,data), IExportable::Complete);
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+        QVERIFY(obj_import->subjectCount() > 0);
+        // The deletion of the imported tree is part of the QTest result, but not of the recorded result:
+        delete obj_import;
+    }
+    recordResult("import",iterations,elapsed,data.size(),peakMemoryUsage());
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkRelationalReconstruction_data() {
+    addTreeRows(true,false);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkRelationalReconstruction() {
+    QFETCH(int, Shape);
+    QFETCH(int, Size);
+    QFETCH(QString, Format);
+
+    QByteArray data;
+    {
+        TreeNode* obj_source = createBenchmarkTree(Shape,Size);
+        QCOMPARE(exportBenchmarkTree(obj_source,Format,&data,ObserverData::ExportAllItems), IExportable::Complete);
+        delete obj_source;
+    }
+
+    resetPeakMemoryUsage();
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        TreeNode* obj_import = new TreeNode("Benchmark Root");
+        timer.start();
+        QCOMPARE(importBenchmarkTree(obj_import,Format,data), IExportable::Complete);
+        // Construct the relational table of the imported tree, which visits every relationship that was reconstructed:
+        ObserverRelationalTable table(obj_import);
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+        QVERIFY(table.count() > 0);
+        delete obj_import;
+    }
+    recordResult("relational-reconstruction",iterations,elapsed,data.size(),peakMemoryUsage());
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkLoggerFanOut_data() {
+    QTest::addColumn<int>("EngineCount");
+    QTest::addColumn<bool>("Asynchronous");
+    QTest::newRow("1 engine") << 1 << false;
+    QTest::newRow("5 engines") << 5 << false;
+    QTest::newRow("20 engines") << 20 << false;
+    QTest::newRow("1 engine, asynchronous dispatch") << 1 << true;
+    QTest::newRow("20 engines, asynchronous dispatch") << 20 << true;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkLoggerFanOut() {
+    QFETCH(int, EngineCount);
+    QFETCH(bool, Asynchronous);
+    const int message_count = 1000;
+
+    // Change the log level before attaching the engines since the change is logged:
+    Logger::MessageType previous_log_level = Log->globalLogLevel();
+    Log->setGlobalLogLevel(Logger::AllLogLevels);
+    Log->setAsynchronousDispatchEnabled(Asynchronous);
+
+    QList<CountingLoggerEngine*> engines;
+    for (int i = 0; i < EngineCount; ++i) {
+        CountingLoggerEngine* engine = new CountingLoggerEngine;
+        engine->setName(QString("Benchmark Engine %1").arg(i));
+        engine->installFormattingEngine(FormattingEngine_Default::instance());
+        QVERIFY(Log->attachLoggerEngine(engine));
+        engines << engine;
+    }
+
+    QElapsedTimer timer;
+    int iterations = 0;
+    timer.start();
+    QBENCHMARK {
+        for (int m = 0; m < message_count; ++m)
+            Log->logMessage(QString(),Logger::Info,"Benchmark message",m);
+        ++iterations;
+    }
+    // Batches delivered by the dispatcher thread reach the engines, which live in this thread, through queued calls:
+    Log->setAsynchronousDispatchEnabled(false);
+    QCoreApplication::sendPostedEvents();
+    qint64 elapsed = timer.elapsed();
+    if (elapsed > 0)
+        qDebug() << QString("%1 engine(s)%2: %3 messages per second").arg(EngineCount).arg(Asynchronous ? ", asynchronous dispatch" : "").arg((iterations * message_count * 1000.0) / elapsed,0,'f',0);
+
+    for (int i = 0; i < engines.count(); ++i) {
+        QCOMPARE(engines.at(i)->message_count,iterations * message_count);
+        Log->detachLoggerEngine(engines.at(i),true);
+    }
+
+    Log->setGlobalLogLevel(previous_log_level);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkFormattingEngines_data() {
+    QTest::addColumn<QString>("EngineName");
+    QTest::addColumn<int>("PartCount");
+    QTest::newRow("Default, 1 part") << QString(qti_def_FORMATTING_ENGINE_DEFAULT) << 1;
+    QTest::newRow("Default, 3 parts") << QString(qti_def_FORMATTING_ENGINE_DEFAULT) << 3;
+    QTest::newRow("Rich Text, 1 part") << QString(qti_def_FORMATTING_ENGINE_RICH_TEXT) << 1;
+    QTest::newRow("Rich Text, 3 parts") << QString(qti_def_FORMATTING_ENGINE_RICH_TEXT) << 3;
+    QTest::newRow("XML, 3 parts") << QString(qti_def_FORMATTING_ENGINE_XML) << 3;
+    QTest::newRow("HTML, 1 part") << QString(qti_def_FORMATTING_ENGINE_HTML) << 1;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkFormattingEngines() {
+    QFETCH(QString, EngineName);
+    QFETCH(int, PartCount);
+    const int message_count = 10000;
+
+    AbstractFormattingEngine* formatting_engine = Log->formattingEngineReference(EngineName);
+    QVERIFY(formatting_engine);
+
+    QList<QVariant> messages;
+    messages << QString("Benchmark message with <markup> & \"quotes\"");
+    for (int i = 1; i < PartCount; ++i)
+        messages << i;
+
+    QElapsedTimer timer;
+    int iterations = 0;
+    int formatted_length = 0;
+    timer.start();
+    QBENCHMARK {
+        for (int m = 0; m < message_count; ++m)
+            formatted_length += formatting_engine->formatMessage(Logger::Warning,messages).length();
+        ++iterations;
+    }
+    qint64 elapsed = timer.elapsed();
+    if (elapsed > 0)
+        qDebug() << QString("%1: %2 messages per second").arg(EngineName).arg((iterations * message_count * 1000.0) / elapsed,0,'f',0);
+
+    QVERIFY(formatted_length > 0);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverAttachSubjects() {
+    const int subject_count = 100000;
+
+    QList<QObject*> objects;
+    for (int i = 0; i < subject_count; ++i) {
+        QObject* obj = new QObject;
+        obj->setObjectName(QString("Subject %1").arg(i));
+        objects << obj;
+    }
+
+    QBENCHMARK {
+        Observer* observer = new Observer("Benchmark Observer");
+        observer->startProcessingCycle();
+        for (int i = 0; i < subject_count; ++i)
+            observer->attachSubject(objects.at(i),Observer::ManualOwnership);
+        observer->endProcessingCycle(false);
+
+        QCOMPARE(observer->subjectCount(),subject_count);
+        QVERIFY(observer->contains(objects.last()));
+        QCOMPARE(observer->subjectReference(observer->subjectID(subject_count - 1)),objects.last());
+        delete observer;
+    }
+
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkObserverBulkAttachSubjects() {
+    const int subject_count = 20000;
+
+    QList<QObject*> objects;
+    for (int i = 0; i < subject_count; ++i) {
+        QObject* obj = new QObject;
+        obj->setObjectName(QString("Subject %1").arg(i));
+        objects << obj;
+    }
+
+    QBENCHMARK {
+        Observer* observer = new Observer("Benchmark Observer");
+        ActivityPolicyFilter* activity_filter = new ActivityPolicyFilter;
+        activity_filter->setActivityPolicy(ActivityPolicyFilter::UniqueActivity);
+        activity_filter->setNewSubjectActivityPolicy(ActivityPolicyFilter::SetNewActive);
+        observer->installSubjectFilter(activity_filter);
+
+        QCOMPARE(observer->attachSubjects(objects,Observer::ManualOwnership).count(),subject_count);
+        QCOMPARE(observer->subjectCount(),subject_count);
+        QCOMPARE(activity_filter->activeSubjects().count(),1);
+        QVERIFY(activity_filter->activeSubjects().front() == objects.last());
+
+        // Detach the subjects before the observer is deleted, thus the next iteration starts without activity properties on them:
+        observer->detachAll();
+        delete observer;
+    }
+
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkProcessBufferClassifier_data() {
+    QTest::addColumn<bool>("Compiled");
+    QTest::newRow("every hint") << false;
+    QTest::newRow("compiled classifier") << true;
+}
+
+void Qtilities::Testing::BenchmarkTests::benchmarkProcessBufferClassifier() {
+    QFETCH(bool, Compiled);
+
+    // 40 hints similar to the ones used to classify GCC, MSVC and make output:
+    QList<ProcessBufferMessageTypeHint> hints;
+    for (int i = 0; i < 10; ++i) {
+        hints << ProcessBufferMessageTypeHint(QRegExp(QString("*: error: E%1*").arg(i),Qt::CaseInsensitive,QRegExp::Wildcard),Logger::Error,1);
+        hints << ProcessBufferMessageTypeHint(QRegExp(QString("*: warning: W%1*").arg(i),Qt::CaseInsensitive,QRegExp::Wildcard),Logger::Warning);
+        hints << ProcessBufferMessageTypeHint(QRegExp(QString(".*\\(\\d+\\) : error C%1\\d+:.*").arg(i)),Logger::Error,1);
+        hints << ProcessBufferMessageTypeHint(QRegExp(QString("make\\[%1\\]: .*").arg(i)),Logger::None);
+    }
+
+    QStringList lines;
+    for (int i = 0; i < 10000; ++i) {
+        switch (i % 5) {
+            case 0: lines << QString("g++ -c -O2 src/file%1.cpp -o obj/file%1.o").arg(i); break;
+            case 1: lines << QString("src/file%1.cpp:%2:5: warning: W%3 unused variable 'x'").arg(i).arg(i % 300).arg(i % 10); break;
+            case 2: lines << QString("src/file%1.cpp:%2:5: error: E%3 'y' was not declared in this scope").arg(i).arg(i % 300).arg(i % 10); break;
+            case 3: lines << QString("make[%1]: Entering directory '/build/dir%2'").arg(i % 10).arg(i); break;
+            default: lines << QString("file%1.cpp(%2) : error C%3").arg(i).arg(i % 300).arg(i % 10) + "065: 'z': undeclared identifier"; break;
+        }
+    }
+
+    ProcessBufferMessageClassifier classifier;
+    classifier.setHints(hints);
+
+    // The compiled classifier must match the same hints as evaluating every hint:
+    for (int l = 0; l < lines.count(); ++l) {
+        QList<int> expected;
+        int highest_priority = -1;
+        for (int h = 0; h < hints.count(); ++h) {
+            if (hints.at(h).d_regexp.exactMatch(lines.at(l))) {
+                if (hints.at(h).d_priority > highest_priority) {
+                    highest_priority = hints.at(h).d_priority;
+                    expected.clear();
+                }
+                if (hints.at(h).d_priority == highest_priority)
+                    expected << h;
+            }
+        }
+        QCOMPARE(classifier.matchingHints(lines.at(l)),expected);
+    }
+
+    QElapsedTimer timer;
+    int iterations = 0;
+    int matches = 0;
+    timer.start();
+    QBENCHMARK {
+        for (int l = 0; l < lines.count(); ++l) {
+            if (Compiled) {
+                matches += classifier.matchingHints(lines.at(l)).count();
+            } else {
+                for (int h = 0; h < hints.count(); ++h) {
+                    if (hints.at(h).d_regexp.exactMatch(lines.at(l)))
+                        ++matches;
+                }
+            }
+        }
+        ++iterations;
+    }
+    qint64 elapsed = timer.elapsed();
+    QVERIFY(matches > 0);
+    if (elapsed > 0)
+        qDebug() << QString("%1: %2 lines per second").arg(QTest::currentDataTag()).arg((iterations * lines.count() * 1000.0) / elapsed,0,'f',0);
 }
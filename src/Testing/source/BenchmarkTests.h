@@ -22,13 +22,44 @@ namespace Qtilities {
     namespace Testing {
         using namespace Interfaces;
 
+        /*!
+        \struct BenchmarkTestsPrivateData
+        \brief Structure used by BenchmarkTests to store private data.
+          */
+        struct BenchmarkTestsPrivateData;
+
         //! Contains some bencmarking code to benchmark parts of %Qtilities.
+        /*!
+          The export and import benchmarks run on generated trees of different shapes and sizes:
+          - Deep trees: A chain of nested nodes with items on every level.
+          - Wide trees: A single node with all items attached to it directly.
+          - Categorized trees: Nodes with categorized display enabled, of which the items are spread over nested categories.
+          - Multi-parent trees: Nodes of which all items are also attached to another node, thus exports contain relational data.
+
+          Besides the results reported by QTest, every export and import benchmark records a result line in the results file set using setResultsFile().
+          The file is a CSV file which is appended to, thus the results of different releases can be compared. The QtilitiesBenchmarks tool runs these benchmarks
+          from the command line.
+          */
         class TESTING_SHARED_EXPORT BenchmarkTests: public QObject, public ITestable
         {
             Q_OBJECT
             Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
 
         public:
+            BenchmarkTests(QObject* parent = 0);
+            ~BenchmarkTests();
+
+            //! Sets the CSV file to which the results of the export and import benchmarks are appended. When empty, results are only reported by QTest, which is the default.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setResultsFile(const QString& file_name);
+            //! Gets the CSV file to which the results of the export and import benchmarks are appended.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString resultsFile() const;
+
             // --------------------------------
             // IObjectBase Implementation
             // --------------------------------
@@ -44,8 +75,36 @@ namespace Qtilities {
             void benchmarkObserverExport_1_0_1_0_data();
             //! Do a benchmark on a big observer export
             void benchmarkObserverExport_1_0_1_0();
-            //! Do a benchmark on a big observer export
+            //! Do a benchmark on a big observer import, using the file written by benchmarkObserverExport_1_0_1_0().
             void benchmarkObserverImport_1_0_1_0();
+            void benchmarkExport_data();
+            //! Benchmarks binary and XML exports of generated trees.
+            void benchmarkExport();
+            void benchmarkImport_data();
+            //! Benchmarks binary and XML imports of generated trees.
+            void benchmarkImport();
+            void benchmarkRelationalReconstruction_data();
+            //! Benchmarks imports of binary exports which contain relational data, which reconstruct the relationships in the tree.
+            void benchmarkRelationalReconstruction();
+            void benchmarkLoggerFanOut_data();
+            //! Do a benchmark on the number of messages per second the logger can deliver to N engines sharing the same formatting engine, with and without asynchronous dispatching.
+            void benchmarkLoggerFanOut();
+            void benchmarkFormattingEngines_data();
+            //! Do a benchmark on the number of messages per second each formatting engine can format.
+            void benchmarkFormattingEngines();
+            //! Do a benchmark on attaching a large number of subjects to an observer.
+            void benchmarkObserverAttachSubjects();
+            //! Benchmarks bulk attachment of subjects to an observer with a unique activity policy filter using Observer::attachSubjects().
+            void benchmarkObserverBulkAttachSubjects();
+            void benchmarkProcessBufferClassifier_data();
+            //! Benchmarks the number of process buffer lines per second which are classified using 40 compiler output hints.
+            void benchmarkProcessBufferClassifier();
+
+        private:
+            void addTreeRows(bool binary_formats, bool xml_formats);
+            void recordResult(const QString& benchmark, int iterations, qint64 elapsed_nsecs, int bytes, qint64 peak_memory_kb);
+
+            BenchmarkTestsPrivateData* d;
         };
     }
 }
@@ -15,6 +15,8 @@
 #include <QPointer>
 #include <QAction>
 #include <QMessageBox>
+#include <QThread>
+#include <QElapsedTimer>
 
 #ifdef QTILITIES_CONAN
 #include <Conan.h>
@@ -26,9 +28,55 @@ using namespace QtilitiesExtensionSystem;
 #include <QtilitiesProjectManagement>
 using namespace QtilitiesProjectManagement;
 
+namespace {
+    //! The views of the debug widget which are refreshed when they change, see DebugWidget::scheduleViewRefresh().
+    enum qti_private_DebugView {
+        qti_private_DebugViewPlugins        = 1,
+        qti_private_DebugViewModes          = 2,
+        qti_private_DebugViewStartupProfile = 4,
+        qti_private_DebugViewContexts       = 8,
+        qti_private_DebugViewCommands       = 16,
+        qti_private_DebugViewFactories      = 32,
+        qti_private_DebugViewProjects       = 64,
+        qti_private_DebugViewAll            = 127
+    };
+
+    //! The time in milliseconds over which changes are collected before the changed views are refreshed.
+    const int qti_private_DEBUG_VIEW_REFRESH_DELAY = 250;
+    //! The interval in milliseconds at which performance counters are sampled while the debug widget is visible.
+    const int qti_private_PERFORMANCE_COUNTER_SAMPLE_INTERVAL = 1000;
+    //! The window in milliseconds over which average performance counter rates are calculated.
+    const qint64 qti_private_PERFORMANCE_COUNTER_RATE_WINDOW = 60000;
+
+    //! The recent totals of a performance counter, used to calculate its rates.
+    struct qti_private_PerformanceCounterHistory {
+        QList<qint64>   sample_times;
+        QList<qint64>   totals;
+    };
+
+    //! Returns the upper limit of the histogram bucket containing the given percentile of the samples in \p value.
+    qint64 qti_private_HistogramPercentile(const PerformanceCounterValue& value, double percentile) {
+        qint64 sample_count = 0;
+        for (int i = 0; i < value.buckets.count(); ++i)
+            sample_count += value.buckets.at(i);
+        if (sample_count == 0)
+            return 0;
+
+        const qint64 target = qMax((qint64) 1,(qint64) (sample_count * percentile + 0.5));
+        qint64 cumulative = 0;
+        for (int i = 0; i < value.buckets.count(); ++i) {
+            cumulative += value.buckets.at(i);
+            if (cumulative >= target)
+                return qMin(PerformanceCounters::histogramBucketLimit(i),value.maximum);
+        }
+        return value.maximum;
+    }
+}
+
 struct Qtilities::Testing::DebugWidgetPrivateData {
     DebugWidgetPrivateData() : object_pool_widget(0),
-        plugin_edit_set_loaded(false) {}
+        plugin_edit_set_loaded(false),
+        changed_views(qti_private_DebugViewAll) {}
 
     ObserverWidget*     object_pool_widget;
     ObserverWidget*     action_container_widget;
@@ -64,6 +112,13 @@ struct Qtilities::Testing::DebugWidgetPrivateData {
     #else
     QStringListModel    inheritanceModel;
     #endif
+
+    //! The views which changed since they were last refreshed, see qti_private_DebugView.
+    int                 changed_views;
+    QTimer              view_refresh_timer;
+    QTimer              performance_counter_timer;
+    QElapsedTimer       performance_counter_clock;
+    QHash<QString,qti_private_PerformanceCounterHistory> performance_counter_history;
 };
 
 Qtilities::Testing::DebugWidget::DebugWidget(QWidget *parent) :
@@ -90,6 +145,28 @@ Qtilities::Testing::DebugWidget::DebugWidget(QWidget *parent) :
     connect(&d->plugin_msg_timer,SIGNAL(timeout()), ui->lblPluginInfoIcon, SLOT(hide()));
     connect(&d->plugin_msg_timer,SIGNAL(timeout()), ui->lblPluginInfoMessage, SLOT(clear()));
 
+    // Views are refreshed when the parts of the application they show change, instead of being rebuilt every time
+    // the mode is activated. Changes are collected for a short time, thus the widget can stay open while the application is busy:
+    d->view_refresh_timer.setSingleShot(true);
+    d->view_refresh_timer.setInterval(qti_private_DEBUG_VIEW_REFRESH_DELAY);
+    connect(&d->view_refresh_timer,SIGNAL(timeout()),SLOT(refreshChangedViews()));
+    d->performance_counter_timer.setInterval(qti_private_PERFORMANCE_COUNTER_SAMPLE_INTERVAL);
+    connect(&d->performance_counter_timer,SIGNAL(timeout()),SLOT(refreshPerformanceCounters()));
+    d->performance_counter_timer.start();
+    d->performance_counter_clock.start();
+    connect(CONTEXT_MANAGER,SIGNAL(contextChanged(QList<int>)),SLOT(handleContextsChanged()));
+    connect(CONTEXT_MANAGER,SIGNAL(finishedUnregisterContext(int)),SLOT(handleContextsChanged()));
+    connect(ACTION_MANAGER,SIGNAL(numberOfCommandsChanged()),SLOT(handleCommandsChanged()));
+    connect(OBJECT_MANAGER,SIGNAL(newObjectAdded(QObject*)),SLOT(handleObjectPoolChanged()));
+    connect(OBJECT_MANAGER,SIGNAL(objectRemoved(QObject*)),SLOT(handleObjectPoolChanged()));
+    connect(EXTENSION_SYSTEM,SIGNAL(pluginLoadingCompleted()),SLOT(handlePluginsChanged()));
+    connect(EXTENSION_SYSTEM,SIGNAL(pluginActivated(QString)),SLOT(handlePluginsChanged()));
+    connect(PROJECT_MANAGER,SIGNAL(currentProjectChanged(IProject*)),SLOT(handleProjectsChanged()));
+    connect(PROJECT_MANAGER,SIGNAL(projectLoadingFinished(QString,bool)),SLOT(handleProjectsChanged()));
+    connect(PROJECT_MANAGER,SIGNAL(projectSavingFinished(QString,bool)),SLOT(handleProjectsChanged()));
+    connect(PROJECT_MANAGER,SIGNAL(projectClosingFinished(bool)),SLOT(handleProjectsChanged()));
+    connect(PROJECT_MANAGER,SIGNAL(recentProjectsChanged(QStringList,QStringList)),SLOT(handleProjectsChanged()));
+
     d->command_editor = new CommandEditor;
     connect(d->command_editor->commandWidget(),SIGNAL(selectedObjectsChanged(QList<QObject*>)),SLOT(refreshCommandInformation()));
 
@@ -200,6 +277,7 @@ Qtilities::Testing::DebugWidget::DebugWidget(QWidget *parent) :
     d->task_summary_widget.setTaskRemoveOptionFlags(TaskSummaryWidget::RemoveWhenDeleted);
     d->task_summary_widget.setNoActiveTaskHandling(TaskSummaryWidget::ShowSummaryWidget);
     d->task_summary_widget.findCurrentTasks();
+    ui->chkRecordTaskTrace->setChecked(TASK_MANAGER->taskTracingEnabled());
 
     // Contexts:
     if (ui->widgetContextsHolder->layout())
@@ -263,8 +341,8 @@ Qtilities::Testing::DebugWidget::DebugWidget(QWidget *parent) :
     d->inactive_plugins_view->setModel(&d->inactive_plugins_model);
     d->filtered_plugins_view->setModel(&d->filtered_plugins_model);
 
-    // Lastly we refresh all views:
-    on_btnRefreshViews_clicked();
+    // The views are populated when the mode is activated the first time, see aboutToBeActivated().
+    // The global object pool view is already populated, and it follows changes to the object pool itself.
 }
 
 Qtilities::Testing::DebugWidget::~DebugWidget() {
@@ -285,7 +363,7 @@ QString Qtilities::Testing::DebugWidget::modeName() const {
 }
 
 void Qtilities::Testing::DebugWidget::aboutToBeActivated() {
-    on_btnRefreshViews_clicked();
+    refreshChangedViews();
 }
 
 void Qtilities::Testing::DebugWidget::finalizeMode() {
@@ -360,6 +438,16 @@ void Qtilities::Testing::DebugWidget::on_btnRefreshViews_clicked() {
     // ===============================
     refreshModes();
 
+    // ===============================
+    // Refresh Startup Profile:
+    // ===============================
+    refreshStartupProfile();
+
+    // ===============================
+    // Refresh Performance Counters:
+    // ===============================
+    refreshPerformanceCounters();
+
     // ===============================
     // Refresh Contexts:
     // ===============================
@@ -385,6 +473,61 @@ void Qtilities::Testing::DebugWidget::on_btnRefreshViews_clicked() {
     // ===============================
     d->object_pool_widget->refresh();
     d->object_pool_widget->viewExpandAll();
+
+    d->changed_views = 0;
+    d->view_refresh_timer.stop();
+}
+
+void Qtilities::Testing::DebugWidget::handleContextsChanged() {
+    scheduleViewRefresh(qti_private_DebugViewContexts | qti_private_DebugViewCommands);
+}
+
+void Qtilities::Testing::DebugWidget::handleCommandsChanged() {
+    scheduleViewRefresh(qti_private_DebugViewCommands);
+}
+
+void Qtilities::Testing::DebugWidget::handleObjectPoolChanged() {
+    // Factories are registered by objects in the object pool:
+    scheduleViewRefresh(qti_private_DebugViewFactories);
+}
+
+void Qtilities::Testing::DebugWidget::handlePluginsChanged() {
+    scheduleViewRefresh(qti_private_DebugViewPlugins | qti_private_DebugViewModes | qti_private_DebugViewStartupProfile);
+}
+
+void Qtilities::Testing::DebugWidget::handleProjectsChanged() {
+    scheduleViewRefresh(qti_private_DebugViewProjects);
+}
+
+void Qtilities::Testing::DebugWidget::scheduleViewRefresh(int views) {
+    d->changed_views |= views;
+    // Hidden views are refreshed when the mode is activated:
+    if (isVisible() && !d->view_refresh_timer.isActive())
+        d->view_refresh_timer.start();
+}
+
+void Qtilities::Testing::DebugWidget::refreshChangedViews() {
+    d->view_refresh_timer.stop();
+    int changed_views = d->changed_views;
+    d->changed_views = 0;
+
+    if (changed_views & qti_private_DebugViewPlugins) {
+        refreshCurrentPluginState();
+        refreshCurrentPluginSet();
+        refreshEditedPluginState();
+    }
+    if (changed_views & qti_private_DebugViewModes)
+        refreshModes();
+    if (changed_views & qti_private_DebugViewStartupProfile)
+        refreshStartupProfile();
+    if (changed_views & qti_private_DebugViewContexts)
+        refreshContexts();
+    if (changed_views & qti_private_DebugViewCommands)
+        refreshCommandInformation();
+    if (changed_views & qti_private_DebugViewFactories)
+        refreshFactories();
+    if (changed_views & qti_private_DebugViewProjects)
+        refreshProjectsState();
 }
 
 void Qtilities::Testing::DebugWidget::on_btnExplorePluginConfigSetPath_clicked() {
@@ -629,6 +772,136 @@ void Qtilities::Testing::DebugWidget::refreshModes() {
     ui->tableModes->setEditTriggers(QAbstractItemView::NoEditTriggers);
 }
 
+void Qtilities::Testing::DebugWidget::refreshStartupProfile() {
+    ui->tableStartupProfile->clear();
+    QStringList profile_headers;
+    profile_headers << "Name" << "Category" << "Start (ms)" << "Duration (ms)" << "Thread";
+    ui->tableStartupProfile->setHorizontalHeaderLabels(profile_headers);
+    ui->tableStartupProfile->setSortingEnabled(false);
+
+    // The debug widget lives on the main thread:
+    const quint64 main_thread_id = (quint64) (quintptr) QThread::currentThreadId();
+    const QList<StartupProfileSpan> spans = StartupProfiler::instance()->spans();
+    ui->tableStartupProfile->setRowCount(spans.count());
+    for (int i = 0; i < spans.count(); ++i) {
+        const StartupProfileSpan& span = spans.at(i);
+
+        // Name
+        QTableWidgetItem *newItem = new QTableWidgetItem(span.name);
+        ui->tableStartupProfile->setItem(i, 0, newItem);
+        // Category
+        newItem = new QTableWidgetItem(span.category);
+        ui->tableStartupProfile->setItem(i, 1, newItem);
+        // Start, as a number so that it sorts numerically:
+        newItem = new QTableWidgetItem;
+        newItem->setData(Qt::DisplayRole,span.start / 1000.0);
+        ui->tableStartupProfile->setItem(i, 2, newItem);
+        // Duration
+        newItem = new QTableWidgetItem;
+        newItem->setData(Qt::DisplayRole,span.duration / 1000.0);
+        ui->tableStartupProfile->setItem(i, 3, newItem);
+        // Thread
+        if (span.thread_id == main_thread_id)
+            newItem = new QTableWidgetItem("Main Thread");
+        else
+            newItem = new QTableWidgetItem(QString("0x%1").arg(span.thread_id,0,16));
+        ui->tableStartupProfile->setItem(i, 4, newItem);
+
+        ui->tableStartupProfile->setRowHeight(i,17);
+    }
+
+    ui->tableStartupProfile->resizeColumnsToContents();
+    ui->tableStartupProfile->horizontalHeader()->setStretchLastSection(true);
+    ui->tableStartupProfile->setSortingEnabled(true);
+    ui->tableStartupProfile->sortByColumn(3,Qt::DescendingOrder);
+    ui->tableStartupProfile->setShowGrid(false);
+    ui->tableStartupProfile->setEditTriggers(QAbstractItemView::NoEditTriggers);
+}
+
+void Qtilities::Testing::DebugWidget::refreshPerformanceCounters() {
+    // Counters are only sampled while they can be seen, rates are calculated again from the next samples:
+    if (!isVisible()) {
+        d->performance_counter_history.clear();
+        return;
+    }
+
+    const qint64 now = d->performance_counter_clock.elapsed();
+    const QList<PerformanceCounterValue> values = PerformanceCounters::instance()->values();
+    ui->tablePerformanceCounters->setSortingEnabled(false);
+    ui->tablePerformanceCounters->setRowCount(values.count());
+    for (int i = 0; i < values.count(); ++i) {
+        const PerformanceCounterValue& value = values.at(i);
+        const bool is_gauge = (value.type == PerformanceCounters::Gauge);
+        const bool is_histogram = (value.type == PerformanceCounters::Histogram);
+
+        // Keep the totals within the rate window:
+        qti_private_PerformanceCounterHistory& history = d->performance_counter_history[value.name];
+        // The counters were reset, the previous totals can't be used anymore:
+        if (!history.totals.isEmpty() && value.total < history.totals.last() && !is_gauge) {
+            history.totals.clear();
+            history.sample_times.clear();
+        }
+        history.totals << value.total;
+        history.sample_times << now;
+        while (history.sample_times.count() > 2 && now - history.sample_times.front() > qti_private_PERFORMANCE_COUNTER_RATE_WINDOW) {
+            history.sample_times.removeFirst();
+            history.totals.removeFirst();
+        }
+
+        // Counter
+        QTableWidgetItem *newItem = new QTableWidgetItem(value.name);
+        ui->tablePerformanceCounters->setItem(i, 0, newItem);
+        // Type
+        if (is_gauge)
+            newItem = new QTableWidgetItem("Gauge");
+        else if (is_histogram)
+            newItem = new QTableWidgetItem("Histogram");
+        else
+            newItem = new QTableWidgetItem("Count");
+        ui->tablePerformanceCounters->setItem(i, 1, newItem);
+        // Total / Value, as a number so that it sorts numerically. For histograms this is the number of samples:
+        newItem = new QTableWidgetItem;
+        newItem->setData(Qt::DisplayRole,value.total);
+        ui->tablePerformanceCounters->setItem(i, 2, newItem);
+        // Rate and Average Rate, which are not meaningful for gauges:
+        const int sample_count = history.totals.count();
+        if (!is_gauge && sample_count > 1) {
+            qint64 interval = history.sample_times.at(sample_count-1) - history.sample_times.at(sample_count-2);
+            newItem = new QTableWidgetItem;
+            newItem->setData(Qt::DisplayRole,interval > 0 ? ((history.totals.at(sample_count-1) - history.totals.at(sample_count-2)) * 1000.0) / interval : 0.0);
+            ui->tablePerformanceCounters->setItem(i, 3, newItem);
+            interval = history.sample_times.last() - history.sample_times.front();
+            newItem = new QTableWidgetItem;
+            newItem->setData(Qt::DisplayRole,interval > 0 ? ((history.totals.last() - history.totals.front()) * 1000.0) / interval : 0.0);
+            ui->tablePerformanceCounters->setItem(i, 4, newItem);
+        } else {
+            ui->tablePerformanceCounters->setItem(i, 3, new QTableWidgetItem);
+            ui->tablePerformanceCounters->setItem(i, 4, new QTableWidgetItem);
+        }
+        // Max
+        newItem = new QTableWidgetItem;
+        if (is_gauge || is_histogram)
+            newItem->setData(Qt::DisplayRole,value.maximum);
+        ui->tablePerformanceCounters->setItem(i, 5, newItem);
+        // p50 and p90, as the upper limits of the histogram buckets which contain them:
+        newItem = new QTableWidgetItem;
+        if (is_histogram)
+            newItem->setData(Qt::DisplayRole,qti_private_HistogramPercentile(value,0.5));
+        ui->tablePerformanceCounters->setItem(i, 6, newItem);
+        newItem = new QTableWidgetItem;
+        if (is_histogram)
+            newItem->setData(Qt::DisplayRole,qti_private_HistogramPercentile(value,0.9));
+        ui->tablePerformanceCounters->setItem(i, 7, newItem);
+
+        ui->tablePerformanceCounters->setRowHeight(i,17);
+    }
+
+    ui->tablePerformanceCounters->horizontalHeader()->setStretchLastSection(true);
+    ui->tablePerformanceCounters->setSortingEnabled(true);
+    ui->tablePerformanceCounters->setShowGrid(false);
+    ui->tablePerformanceCounters->setEditTriggers(QAbstractItemView::NoEditTriggers);
+}
+
 void Qtilities::Testing::DebugWidget::refreshContexts() {
     ui->tableContextsAll->clear();
     ui->tableContextsActive->clear();
@@ -903,10 +1176,18 @@ void Qtilities::Testing::DebugWidget::refreshEditedPluginState() {
 }
 
 void Qtilities::Testing::DebugWidget::refreshFactories() {
+    // Objects are added to the object pool much more often than factories are registered:
+    QStringList factory_names = OBJECT_MANAGER->allFactoryNames();
+    QStringList shown_factory_names;
+    for (int i = 0; i < ui->listFactories->count(); ++i)
+        shown_factory_names << ui->listFactories->item(i)->text();
+    if (factory_names == shown_factory_names)
+        return;
+
     ui->listFactoryItemIDs->clear();
     ui->listFactories->clear();
 
-    ui->listFactories->addItems(OBJECT_MANAGER->allFactoryNames());
+    ui->listFactories->addItems(factory_names);
     if (ui->listFactories->count() > 0)
         ui->listFactories->setCurrentRow(0);
 }
@@ -1018,3 +1299,100 @@ void Qtilities::Testing::DebugWidget::on_btnContextUnregisterSelected_clicked()
     refreshContexts();
     refreshCommandInformation();
 }
+
+void Qtilities::Testing::DebugWidget::on_chkRecordTaskTrace_toggled(bool checked) {
+    TASK_MANAGER->setTaskTracingEnabled(checked);
+}
+
+void Qtilities::Testing::DebugWidget::on_btnClearTaskTrace_clicked() {
+    TASK_MANAGER->clearTaskTrace();
+}
+
+void Qtilities::Testing::DebugWidget::on_btnExportTaskTrace_clicked() {
+    QString fileName = QFileDialog::getSaveFileName(0, "Export Task Trace",QString("%1/task_trace.json").arg(QtilitiesApplication::applicationSessionPath()),"Chrome Trace Files (*.json)");
+    if (fileName.isEmpty())
+        return;
+
+    if (TASK_MANAGER->exportTaskTrace(fileName))
+        LOG_INFO_P(QString("Exported %1 task trace events to: %2").arg(TASK_MANAGER->taskTraceEvents().count()).arg(fileName));
+    else
+        LOG_ERROR_P(QString("Failed to export task trace to: %1").arg(fileName));
+}
+
+void Qtilities::Testing::DebugWidget::on_btnClearStartupProfile_clicked() {
+    StartupProfiler::instance()->clear();
+    refreshStartupProfile();
+}
+
+void Qtilities::Testing::DebugWidget::on_btnResetPerformanceCounters_clicked() {
+    PerformanceCounters::instance()->reset();
+    d->performance_counter_history.clear();
+    refreshPerformanceCounters();
+}
+
+void Qtilities::Testing::DebugWidget::on_btnEstimateObjectPoolMemory_clicked() {
+    showMemoryUsageReport(OBJECT_MANAGER->memoryUsage());
+}
+
+void Qtilities::Testing::DebugWidget::on_btnEstimateSelectedObjectMemory_clicked() {
+    if (!d->current_object) {
+        QMessageBox::information(this,"Estimate Memory Usage","Select an object in the object pool first.");
+        return;
+    }
+
+    Observer* observer = qobject_cast<Observer*> (d->current_object);
+    if (observer) {
+        showMemoryUsageReport(observer->memoryUsage());
+    } else {
+        MemoryUsageReport report;
+        report.addObject(d->current_object);
+        showMemoryUsageReport(report);
+    }
+}
+
+void Qtilities::Testing::DebugWidget::showMemoryUsageReport(const MemoryUsageReport& report) {
+    ui->lblMemoryUsageTotal->setText(QString("Estimated total: %1 bytes in %2 objects").arg(report.totalBytes()).arg(report.objectCount()));
+
+    ui->tableMemoryUsage->setSortingEnabled(false);
+    ui->tableMemoryUsage->setRowCount(0);
+    int row = 0;
+    for (int category = MemoryUsageReport::ObjectMemory; category <= MemoryUsageReport::ModelItemMemory; ++category) {
+        const QStringList names = report.names((MemoryUsageReport::MemoryCategory) category);
+        ui->tableMemoryUsage->setRowCount(row + names.count());
+        for (int i = 0; i < names.count(); ++i) {
+            // Category
+            QTableWidgetItem *newItem = new QTableWidgetItem(MemoryUsageReport::memoryCategoryToString((MemoryUsageReport::MemoryCategory) category));
+            ui->tableMemoryUsage->setItem(row, 0, newItem);
+            // Name
+            newItem = new QTableWidgetItem(names.at(i));
+            ui->tableMemoryUsage->setItem(row, 1, newItem);
+            // Count and Bytes, as numbers so that they sort numerically:
+            newItem = new QTableWidgetItem;
+            newItem->setData(Qt::DisplayRole,report.count((MemoryUsageReport::MemoryCategory) category,names.at(i)));
+            ui->tableMemoryUsage->setItem(row, 2, newItem);
+            newItem = new QTableWidgetItem;
+            newItem->setData(Qt::DisplayRole,report.bytes((MemoryUsageReport::MemoryCategory) category,names.at(i)));
+            ui->tableMemoryUsage->setItem(row, 3, newItem);
+
+            ui->tableMemoryUsage->setRowHeight(row,17);
+            ++row;
+        }
+    }
+
+    ui->tableMemoryUsage->horizontalHeader()->setStretchLastSection(true);
+    ui->tableMemoryUsage->setSortingEnabled(true);
+    ui->tableMemoryUsage->sortByColumn(3,Qt::DescendingOrder);
+    ui->tableMemoryUsage->setShowGrid(false);
+    ui->tableMemoryUsage->setEditTriggers(QAbstractItemView::NoEditTriggers);
+}
+
+void Qtilities::Testing::DebugWidget::on_btnExportStartupProfile_clicked() {
+    QString fileName = QFileDialog::getSaveFileName(0, "Export Startup Profile",QString("%1/startup_profile.json").arg(QtilitiesApplication::applicationSessionPath()),"Chrome Trace Files (*.json)");
+    if (fileName.isEmpty())
+        return;
+
+    if (StartupProfiler::instance()->exportTrace(fileName))
+        LOG_INFO_P(QString("Exported %1 startup profile spans to: %2").arg(StartupProfiler::instance()->spans().count()).arg(fileName));
+    else
+        LOG_ERROR_P(QString("Failed to export startup profile to: %1").arg(fileName));
+}
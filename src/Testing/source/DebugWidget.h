@@ -23,6 +23,9 @@ namespace Ui {
 }
 
 namespace Qtilities {
+    namespace Core {
+        class MemoryUsageReport;
+    }
     namespace CoreGui {
         class Command;
     }
@@ -107,12 +110,41 @@ namespace Qtilities {
             void on_chkRefreshProperties_toggled(bool checked);
 
             void on_btnContextUnregisterSelected_clicked();
+            void on_chkRecordTaskTrace_toggled(bool checked);
+            void on_btnClearTaskTrace_clicked();
+            void on_btnExportTaskTrace_clicked();
+            void on_btnClearStartupProfile_clicked();
+            void on_btnExportStartupProfile_clicked();
+            void on_btnResetPerformanceCounters_clicked();
+            void on_btnEstimateObjectPoolMemory_clicked();
+            void on_btnEstimateSelectedObjectMemory_clicked();
+
+            //! Marks the context and command views for refreshing when the contexts changed.
+            void handleContextsChanged();
+            //! Marks the command view for refreshing when commands were registered or removed.
+            void handleCommandsChanged();
+            //! Marks the factory view for refreshing when objects were added to or removed from the object pool.
+            void handleObjectPoolChanged();
+            //! Marks the plugin views for refreshing when plugins were loaded.
+            void handlePluginsChanged();
+            //! Marks the projects view for refreshing when projects were opened, saved or closed.
+            void handleProjectsChanged();
+            //! Refreshes the views which were marked for refreshing since they were last refreshed.
+            void refreshChangedViews();
+            //! Samples the performance counters and refreshes the performance counters table, only done while the widget is visible.
+            void refreshPerformanceCounters();
 
         private:
+            //! Marks \p views for refreshing, they are refreshed shortly afterwards when the widget is visible, or when the mode is activated.
+            void scheduleViewRefresh(int views);
             //! Refreshes the mode information.
             void refreshModes();
+            //! Refreshes the startup profile table.
+            void refreshStartupProfile();
             //! Refreshes the contexts information.
             void refreshContexts();
+            //! Shows \p report in the memory usage table.
+            void showMemoryUsageReport(const Qtilities::Core::MemoryUsageReport& report);
             //! Refreshes the current plugin state of the application.
             void refreshCurrentPluginState();
             //! Refreshes the current plugin set of the application.
@@ -14,6 +14,58 @@
 #include <QtilitiesCoreGui>
 using namespace QtilitiesCoreGui;
 
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QTextStream>
+#include <QThreadStorage>
+
+namespace {
+    //! Separates the scope names in function call paths, as expected by flame graph tools.
+    const QChar qti_private_FUNCTION_PATH_SEPARATOR = QLatin1Char(';');
+
+    struct qti_private_FunctionCallStatistics {
+        qti_private_FunctionCallStatistics() : calls(0), total_nsecs(0), maximum_nsecs(0) {}
+
+        qint64 calls;
+        qint64 total_nsecs;
+        qint64 maximum_nsecs;
+    };
+
+    //! Returns true if \p function_name encloses the last scope in \p function_path, thus the last scope was a recursive call.
+    bool qti_private_IsRecursiveCall(const QString& function_path, const QString& function_name) {
+        QStringList names = function_path.split(qti_private_FUNCTION_PATH_SEPARATOR);
+        names.removeLast();
+        return names.contains(function_name);
+    }
+}
+
+struct Qtilities::Testing::qti_private_FunctionCallThreadData {
+    //! The path of the innermost open scope on the thread, only used by the thread itself.
+    QString                                             current_path;
+    //! Only contended when the analyzer reports timings while the thread records them.
+    QMutex                                              mutex;
+    QHash<QString,qti_private_FunctionCallStatistics>   statistics;
+};
+
+struct Qtilities::Testing::qti_private_FunctionCallAnalyzerPrivateData {
+    //! Protects thread_data, which holds the data of all threads which timed scopes, including threads which finished already.
+    QMutex                                                              mutex;
+    QList<QSharedPointer<qti_private_FunctionCallThreadData> >          thread_data;
+    QThreadStorage<QSharedPointer<qti_private_FunctionCallThreadData> > local_thread_data;
+};
+
+Qtilities::Testing::qti_private_FunctionCallAnalyzer::qti_private_FunctionCallAnalyzer() {
+    d = new qti_private_FunctionCallAnalyzerPrivateData;
+}
+
+Qtilities::Testing::qti_private_FunctionCallAnalyzer::~qti_private_FunctionCallAnalyzer() {
+    delete d;
+}
+
 void Qtilities::Testing::qti_private_FunctionCallAnalyzer::count(const QString& function_name) {
     int current_value = 0;
     if (call_counts.count() > 0) {
@@ -31,6 +83,7 @@ void Qtilities::Testing::qti_private_FunctionCallAnalyzer::clear(const QString&
 
 void Qtilities::Testing::qti_private_FunctionCallAnalyzer::clearAll() {
     call_counts.clear();
+    clearTimings();
 }
 
 void Qtilities::Testing::qti_private_FunctionCallAnalyzer::logCallCount(const QString& function_name) const {
@@ -44,3 +97,171 @@ void Qtilities::Testing::qti_private_FunctionCallAnalyzer::logCallCount(const QS
     for (int i = 0; i < call_counts.count(); ++i)
         LOG_INFO("Call count on function " + call_counts.keys().at(i) + ": " + QString::number(call_counts.values().at(i)));
 }
+
+void Qtilities::Testing::qti_private_FunctionCallAnalyzer::clearTimings() {
+    QMutexLocker locker(&d->mutex);
+    for (int i = 0; i < d->thread_data.count(); ++i) {
+        QMutexLocker thread_locker(&d->thread_data.at(i)->mutex);
+        d->thread_data.at(i)->statistics.clear();
+    }
+}
+
+QList<Qtilities::Testing::FunctionCallTiming> Qtilities::Testing::qti_private_FunctionCallAnalyzer::timings() const {
+    // Merge the paths recorded by the different threads:
+    QMap<QString,FunctionCallTiming> merged;
+    {
+        QMutexLocker locker(&d->mutex);
+        for (int i = 0; i < d->thread_data.count(); ++i) {
+            qti_private_FunctionCallThreadData* thread_data = d->thread_data.at(i).data();
+            QMutexLocker thread_locker(&thread_data->mutex);
+            QHash<QString,qti_private_FunctionCallStatistics>::const_iterator itr = thread_data->statistics.constBegin();
+            while (itr != thread_data->statistics.constEnd()) {
+                FunctionCallTiming& timing = merged[itr.key()];
+                timing.calls += itr.value().calls;
+                timing.total_nsecs += itr.value().total_nsecs;
+                timing.maximum_nsecs = qMax(timing.maximum_nsecs,itr.value().maximum_nsecs);
+                ++itr;
+            }
+        }
+    }
+
+    // The self time of a path is its total time minus the total time of the paths directly nested inside it:
+    QMap<QString,FunctionCallTiming>::iterator itr = merged.begin();
+    while (itr != merged.end()) {
+        itr.value().function_path = itr.key();
+        itr.value().self_nsecs += itr.value().total_nsecs;
+        const int separator = itr.key().lastIndexOf(qti_private_FUNCTION_PATH_SEPARATOR);
+        itr.value().function_name = itr.key().mid(separator + 1);
+        itr.value().depth = itr.key().count(qti_private_FUNCTION_PATH_SEPARATOR);
+        if (separator != -1) {
+            QMap<QString,FunctionCallTiming>::iterator parent_itr = merged.find(itr.key().left(separator));
+            if (parent_itr != merged.end())
+                parent_itr.value().self_nsecs -= itr.value().total_nsecs;
+        }
+        ++itr;
+    }
+
+    return merged.values();
+}
+
+qint64 Qtilities::Testing::qti_private_FunctionCallAnalyzer::totalNSecs(const QString& function_name) const {
+    qint64 total_nsecs = 0;
+    const QList<FunctionCallTiming> all_timings = timings();
+    for (int i = 0; i < all_timings.count(); ++i) {
+        const FunctionCallTiming& timing = all_timings.at(i);
+        if (timing.function_name == function_name && !qti_private_IsRecursiveCall(timing.function_path,function_name))
+            total_nsecs += timing.total_nsecs;
+    }
+    return total_nsecs;
+}
+
+qint64 Qtilities::Testing::qti_private_FunctionCallAnalyzer::timedCallCount(const QString& function_name) const {
+    qint64 calls = 0;
+    const QList<FunctionCallTiming> all_timings = timings();
+    for (int i = 0; i < all_timings.count(); ++i) {
+        if (all_timings.at(i).function_name == function_name)
+            calls += all_timings.at(i).calls;
+    }
+    return calls;
+}
+
+bool Qtilities::Testing::qti_private_FunctionCallAnalyzer::withinBudget(const QString& function_name, qint64 budget_msecs, QString* message) const {
+    const qint64 total_nsecs = totalNSecs(function_name);
+    const bool within_budget = total_nsecs <= budget_msecs * 1000000;
+    if (message)
+        *message = QString("Time spent in \"%1\" over %2 call(s) is %3 ms, the budget is %4 ms.").arg(function_name).arg(timedCallCount(function_name)).arg(total_nsecs / 1000000.0,0,'f',3).arg(budget_msecs);
+    return within_budget;
+}
+
+QString Qtilities::Testing::qti_private_FunctionCallAnalyzer::timingReport() const {
+    QString report;
+    QTextStream stream(&report);
+    const QList<FunctionCallTiming> all_timings = timings();
+    for (int i = 0; i < all_timings.count(); ++i) {
+        const FunctionCallTiming& timing = all_timings.at(i);
+        stream << QString(timing.depth * 2,QLatin1Char(' ')) << timing.function_name
+               << ": calls " << timing.calls
+               << ", total " << QString::number(timing.total_nsecs / 1000000.0,'f',3) << " ms"
+               << ", self " << QString::number(timing.self_nsecs / 1000000.0,'f',3) << " ms"
+               << ", max " << QString::number(timing.maximum_nsecs / 1000.0,'f',1) << " us" << "\n";
+    }
+    return report;
+}
+
+QString Qtilities::Testing::qti_private_FunctionCallAnalyzer::flameGraphReport() const {
+    QString report;
+    QTextStream stream(&report);
+    const QList<FunctionCallTiming> all_timings = timings();
+    for (int i = 0; i < all_timings.count(); ++i) {
+        const FunctionCallTiming& timing = all_timings.at(i);
+        const qint64 self_usecs = timing.self_nsecs / 1000;
+        if (self_usecs > 0)
+            stream << timing.function_path << " " << self_usecs << "\n";
+    }
+    return report;
+}
+
+bool Qtilities::Testing::qti_private_FunctionCallAnalyzer::saveFlameGraphReport(const QString& file_name) const {
+    QFile file(file_name);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        LOG_ERROR(QString("Failed to open flame graph report file for writing: %1").arg(file_name));
+        return false;
+    }
+    file.write(flameGraphReport().toUtf8());
+    file.close();
+    return true;
+}
+
+void Qtilities::Testing::qti_private_FunctionCallAnalyzer::logTimings() const {
+    const QStringList lines = timingReport().split("\n",QString::SkipEmptyParts);
+    for (int i = 0; i < lines.count(); ++i)
+        LOG_INFO("Function call timing: " + lines.at(i));
+}
+
+Qtilities::Testing::qti_private_FunctionCallThreadData* Qtilities::Testing::qti_private_FunctionCallAnalyzer::threadData() {
+    if (!d->local_thread_data.hasLocalData()) {
+        // The analyzer keeps its own reference, thus the timings of threads which finished are still reported:
+        QSharedPointer<qti_private_FunctionCallThreadData> thread_data(new qti_private_FunctionCallThreadData);
+        d->local_thread_data.setLocalData(thread_data);
+        QMutexLocker locker(&d->mutex);
+        d->thread_data << thread_data;
+    }
+    return d->local_thread_data.localData().data();
+}
+
+// -----------------------------------
+// FunctionCallScope
+// -----------------------------------
+Qtilities::Testing::FunctionCallScope::FunctionCallScope(qti_private_FunctionCallAnalyzer* analyzer, const QString& function_name) {
+    d_thread_data = analyzer ? analyzer->threadData() : 0;
+    if (d_thread_data) {
+        // Separators in names would split them into nested scopes:
+        QString name = function_name;
+        name.replace(qti_private_FUNCTION_PATH_SEPARATOR,QLatin1Char(':'));
+        d_parent_path = d_thread_data->current_path;
+        if (d_parent_path.isEmpty())
+            d_thread_data->current_path = name;
+        else
+            d_thread_data->current_path = d_parent_path + qti_private_FUNCTION_PATH_SEPARATOR + name;
+    }
+    d_timer.start();
+}
+
+Qtilities::Testing::FunctionCallScope::~FunctionCallScope() {
+    const qint64 elapsed_nsecs = d_timer.nsecsElapsed();
+    if (!d_thread_data)
+        return;
+
+    {
+        QMutexLocker locker(&d_thread_data->mutex);
+        qti_private_FunctionCallStatistics& statistics = d_thread_data->statistics[d_thread_data->current_path];
+        ++statistics.calls;
+        statistics.total_nsecs += elapsed_nsecs;
+        statistics.maximum_nsecs = qMax(statistics.maximum_nsecs,elapsed_nsecs);
+    }
+    d_thread_data->current_path = d_parent_path;
+}
+
+qint64 Qtilities::Testing::FunctionCallScope::elapsedNSecs() const {
+    return d_timer.nsecsElapsed();
+}
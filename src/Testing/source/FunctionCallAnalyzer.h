@@ -16,25 +16,76 @@
 
 #include <QString>
 #include <QMap>
+#include <QList>
+#include <QElapsedTimer>
 
 namespace Qtilities {
     namespace Testing {
+        /*!
+        \struct FunctionCallTiming
+        \brief The timing of a function call path, as returned by qti_private_FunctionCallAnalyzer::timings().
+
+        <i>This struct was added in %Qtilities v1.5.</i>
+          */
+        struct TESTING_SHARED_EXPORT FunctionCallTiming {
+            FunctionCallTiming() : depth(0), calls(0), total_nsecs(0), self_nsecs(0), maximum_nsecs(0) {}
+
+            //! The names of the enclosing scopes and this scope, separated by semicolons.
+            QString function_path;
+            //! The name of this scope.
+            QString function_name;
+            //! The number of scopes enclosing this scope, 0 for scopes which were not entered inside another scope.
+            int     depth;
+            //! The number of times the scope was entered on this path.
+            qint64  calls;
+            //! The total time spent inside the scope on this path.
+            qint64  total_nsecs;
+            //! The time spent inside the scope on this path, excluding the time spent in scopes nested inside it.
+            qint64  self_nsecs;
+            //! The longest single call of the scope on this path.
+            qint64  maximum_nsecs;
+        };
+
+        /*!
+        \struct qti_private_FunctionCallAnalyzerPrivateData
+        \brief Structure used by qti_private_FunctionCallAnalyzer to store private data.
+          */
+        struct qti_private_FunctionCallAnalyzerPrivateData;
+        struct qti_private_FunctionCallThreadData;
+
         /*!
         \class qti_private_FunctionCallAnalyzer
         \brief Tests can inherit from this base class in order to get access to function call analysis functions.
 
+        Besides counting calls using count(), the analyzer can time scopes using FunctionCallScope or the QTI_FUNCTION_CALL_SCOPE macro.
+        Scopes are aggregated hierarchically, thus a scope entered inside another scope is recorded on the path of its enclosing scopes.
+        Each thread accumulates its own timings, thus scopes timed on different threads do not contend with each other.
+
+\code
+void MyTest::testExport() {
+    {
+        QTI_FUNCTION_CALL_SCOPE(this,"Export");
+        exportTree();
+    }
+    logTimings();
+    QTI_VERIFY_FUNCTION_CALL_BUDGET(this,"Export",500);
+}
+\endcode
+
+        The timings can be reported as text using timingReport(), or in the folded stack format used by flame graph tools using flameGraphReport().
+
         <i>This class was added in %Qtilities v1.0.</i>
           */
         class TESTING_SHARED_EXPORT qti_private_FunctionCallAnalyzer
         {
         public:
-            qti_private_FunctionCallAnalyzer() {}
-            ~qti_private_FunctionCallAnalyzer() {}
+            qti_private_FunctionCallAnalyzer();
+            ~qti_private_FunctionCallAnalyzer();
             //! Increment the call count for the given function name.
             void count(const QString& function_name);
             //! Clears the function call count for the specific function if it exists.
             void clear(const QString& function_name);
-            //! Clears all counts.
+            //! Clears all counts and timings.
             void clearAll();
             //! Prints the function call information to the logger.
             /*!
@@ -42,10 +93,104 @@ namespace Qtilities {
               */
             void logCallCount(const QString& function_name = QString()) const;
 
+            //! Clears all timings recorded using FunctionCallScope.
+            /*!
+              Timings must not be cleared while scopes are open.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void clearTimings();
+            //! Returns the timings of all function call paths recorded by all threads, sorted by path.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QList<FunctionCallTiming> timings() const;
+            //! Returns the total time spent in the scopes named \p function_name, over all paths on which they were entered.
+            /*!
+              Recursive calls are only counted once, thus the result never exceeds the wall time spent in the outermost scope.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            qint64 totalNSecs(const QString& function_name) const;
+            //! Returns the number of times the scopes named \p function_name were entered, over all paths on which they were entered.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            qint64 timedCallCount(const QString& function_name) const;
+            //! Checks if the total time spent in \p function_name is within \p budget_msecs.
+            /*!
+              \param message When not null, a message describing the result is set on it.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool withinBudget(const QString& function_name, qint64 budget_msecs, QString* message = 0) const;
+            //! Returns a text report of the timings, where nested scopes are indented under their enclosing scopes.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString timingReport() const;
+            //! Returns the timings in the folded stack format, where each line contains a path and its self time in microseconds.
+            /*!
+              The report can be rendered directly using flame graph tools, for example flamegraph.pl or speedscope.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            QString flameGraphReport() const;
+            //! Saves flameGraphReport() to \p file_name.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool saveFlameGraphReport(const QString& file_name) const;
+            //! Prints timingReport() to the logger.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void logTimings() const;
+
         private:
+            Q_DISABLE_COPY(qti_private_FunctionCallAnalyzer)
+            friend class FunctionCallScope;
+            //! Returns the timing data of the calling thread, which is created the first time the thread enters a scope.
+            qti_private_FunctionCallThreadData* threadData();
+
             QMap<QString,int> call_counts;
+            qti_private_FunctionCallAnalyzerPrivateData* d;
+        };
+
+        /*!
+        \class FunctionCallScope
+        \brief The FunctionCallScope class times the scope in which it lives and records it on a qti_private_FunctionCallAnalyzer.
+
+        The analyzer must outlive the scope and scopes must be destroyed on the thread on which they were created. See the
+        QTI_FUNCTION_CALL_SCOPE macro.
+
+        <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class TESTING_SHARED_EXPORT FunctionCallScope
+        {
+        public:
+            FunctionCallScope(qti_private_FunctionCallAnalyzer* analyzer, const QString& function_name);
+            ~FunctionCallScope();
+
+            //! Returns the time elapsed since the scope was entered.
+            qint64 elapsedNSecs() const;
+
+        private:
+            Q_DISABLE_COPY(FunctionCallScope)
+
+            qti_private_FunctionCallThreadData*     d_thread_data;
+            QString                                 d_parent_path;
+            QElapsedTimer                           d_timer;
         };
     }
 }
 
+//! Times the rest of the enclosing block and records it under \p function_name on the given qti_private_FunctionCallAnalyzer.
+#define QTI_FUNCTION_CALL_SCOPE(analyzer,function_name) Qtilities::Testing::FunctionCallScope qti_function_call_scope(analyzer,function_name)
+//! Verifies in a QTest test function that the total time spent in \p function_name is within \p budget_msecs.
+#define QTI_VERIFY_FUNCTION_CALL_BUDGET(analyzer,function_name,budget_msecs) do { \
+        QString qti_budget_message; \
+        QVERIFY2((analyzer)->withinBudget(function_name,budget_msecs,&qti_budget_message),qPrintable(qti_budget_message)); \
+    } while (0)
+
 #endif // qti_private_FunctionCallAnalyzer_H
@@ -0,0 +1,474 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "ObserverBenchmarks.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+
+namespace Qtilities {
+    namespace Testing {
+        //! Creates \p count subjects with unique names.
+        static QList<QObject*> createBenchmarkSubjects(int count) {
+            QList<QObject*> objects;
+            for (int i = 0; i < count; ++i) {
+                QObject* obj = new QObject;
+                obj->setObjectName(QString("Subject %1").arg(i));
+                objects << obj;
+            }
+            return objects;
+        }
+
+        //! Creates an observer with the subject filter described by \p variant installed.
+        static Observer* createBenchmarkObserver(const QString& variant) {
+            Observer* observer = new Observer("Benchmark Observer");
+            if (variant == "naming") {
+                NamingPolicyFilter* naming_filter = new NamingPolicyFilter;
+                naming_filter->setUniquenessPolicy(NamingPolicyFilter::ProhibitDuplicateNames);
+                observer->installSubjectFilter(naming_filter);
+            } else if (variant == "activity") {
+                ActivityPolicyFilter* activity_filter = new ActivityPolicyFilter;
+                activity_filter->setActivityPolicy(ActivityPolicyFilter::UniqueActivity);
+                activity_filter->setNewSubjectActivityPolicy(ActivityPolicyFilter::SetNewActive);
+                observer->installSubjectFilter(activity_filter);
+            }
+            return observer;
+        }
+
+        //! Builds a tree with \p subject_count subjects in total, using nodes of 100 items each.
+        static TreeNode* createObserverBenchmarkTree(int subject_count) {
+            TreeNode* root = new TreeNode("Benchmark Root");
+            const int items_per_node = 99;
+            const int nodes = qMax(1,subject_count / (items_per_node + 1));
+            for (int n = 0; n < nodes; ++n) {
+                TreeNode* node = root->addNode(QString("Node %1").arg(n));
+                for (int i = 0; i < items_per_node; ++i)
+                    node->addItem(QString("Item %1_%2").arg(n).arg(i));
+            }
+            return root;
+        }
+
+        //! Requests a rebuild of \p model and waits until it completed. Returns false if the build did not complete within a minute.
+        static bool rebuildTreeModel(ObserverTreeModel* model) {
+            QSignalSpy build_spy(model,SIGNAL(treeModelBuildEnded()));
+            model->refresh();
+            if (build_spy.isEmpty()) {
+                // Threaded builds complete in the event loop:
+                QEventLoop loop;
+                QObject::connect(model,SIGNAL(treeModelBuildEnded()),&loop,SLOT(quit()));
+                QTimer::singleShot(60000,&loop,SLOT(quit()));
+                loop.exec();
+            }
+            return !build_spy.isEmpty();
+        }
+    }
+}
+
+struct Qtilities::Testing::ObserverBenchmarksPrivateData {
+    QString results_file;
+};
+
+Qtilities::Testing::ObserverBenchmarks::ObserverBenchmarks(QObject* parent) : QObject(parent) {
+    d = new ObserverBenchmarksPrivateData;
+}
+
+Qtilities::Testing::ObserverBenchmarks::~ObserverBenchmarks() {
+    delete d;
+}
+
+void Qtilities::Testing::ObserverBenchmarks::setResultsFile(const QString& file_name) {
+    d->results_file = file_name;
+}
+
+QString Qtilities::Testing::ObserverBenchmarks::resultsFile() const {
+    return d->results_file;
+}
+
+int Qtilities::Testing::ObserverBenchmarks::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::ObserverBenchmarks::addRows(const QStringList& variants) {
+    QTest::addColumn<int>("Size");
+    QTest::addColumn<QString>("Variant");
+
+    QList<int> sizes;
+    sizes << 1000 << 10000 << 100000;
+
+    for (int s = 0; s < sizes.count(); ++s) {
+        for (int v = 0; v < variants.count(); ++v) {
+            QString tag = QString("%1 %2").arg(sizes.at(s)).arg(variants.at(v));
+            QTest::newRow(tag.toUtf8().constData()) << sizes.at(s) << variants.at(v);
+        }
+    }
+}
+
+void Qtilities::Testing::ObserverBenchmarks::recordResult(const QString& benchmark, int iterations, qint64 elapsed_nsecs) {
+    if (d->results_file.isEmpty() || iterations == 0)
+        return;
+
+    QFETCH(int, Size);
+    QFETCH(QString, Variant);
+
+    QFile file(d->results_file);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "Failed to open benchmark results file:" << file.errorString();
+        return;
+    }
+
+    const QString timestamp = QDateTime::currentDateTime().toString(Qt::ISODate);
+    const QString msecs_per_iteration = QString::number(elapsed_nsecs / (1000000.0 * iterations),'f',3);
+
+    QTextStream out(&file);
+    if (d->results_file.endsWith(".json",Qt::CaseInsensitive)) {
+        out << "{\"qtilities_version\":\"" << QtilitiesCoreApplication::qtilitiesVersionString() << "\","
+            << "\"qt_version\":\"" << qVersion() << "\","
+            << "\"timestamp\":\"" << timestamp << "\","
+            << "\"benchmark\":\"" << benchmark << "\","
+            << "\"size\":" << Size << ","
+            << "\"variant\":\"" << Variant << "\","
+            << "\"iterations\":" << iterations << ","
+            << "\"msecs_per_iteration\":" << msecs_per_iteration << "}\n";
+    } else {
+        if (file.size() == 0)
+            out << "qtilities_version,qt_version,timestamp,benchmark,size,variant,iterations,msecs_per_iteration\n";
+        out << QtilitiesCoreApplication::qtilitiesVersionString() << ","
+            << qVersion() << ","
+            << timestamp << ","
+            << benchmark << ","
+            << Size << ","
+            << Variant << ","
+            << iterations << ","
+            << msecs_per_iteration << "\n";
+    }
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkAttach_data() {
+    addRows(QStringList() << "none" << "naming" << "activity");
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkAttach() {
+    QFETCH(int, Size);
+    QFETCH(QString, Variant);
+
+    QList<QObject*> objects = createBenchmarkSubjects(Size);
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        Observer* observer = createBenchmarkObserver(Variant);
+
+        timer.start();
+        for (int i = 0; i < Size; ++i)
+            observer->attachSubject(objects.at(i),Observer::ManualOwnership);
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+
+        QCOMPARE(observer->subjectCount(),Size);
+        // Detach the subjects before the observer is deleted, thus the next iteration starts without properties on them:
+        observer->detachAll();
+        delete observer;
+    }
+    recordResult("attach",iterations,elapsed);
+
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkDetach_data() {
+    addRows(QStringList() << "none" << "naming" << "activity");
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkDetach() {
+    QFETCH(int, Size);
+    QFETCH(QString, Variant);
+
+    QList<QObject*> objects = createBenchmarkSubjects(Size);
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        Observer* observer = createBenchmarkObserver(Variant);
+        observer->attachSubjects(objects,Observer::ManualOwnership);
+        QCOMPARE(observer->subjectCount(),Size);
+
+        timer.start();
+        for (int i = 0; i < Size; ++i)
+            observer->detachSubject(objects.at(i));
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+
+        QCOMPARE(observer->subjectCount(),0);
+        delete observer;
+    }
+    recordResult("detach",iterations,elapsed);
+
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkContains_data() {
+    addRows(QStringList() << "attached");
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkContains() {
+    QFETCH(int, Size);
+
+    QList<QObject*> objects = createBenchmarkSubjects(Size);
+    Observer* observer = new Observer("Benchmark Observer");
+    observer->attachSubjects(objects,Observer::ManualOwnership);
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        int found = 0;
+        timer.start();
+        for (int i = 0; i < Size; ++i) {
+            if (observer->contains(objects.at(i)))
+                ++found;
+        }
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+        QCOMPARE(found,Size);
+    }
+    recordResult("contains",iterations,elapsed);
+
+    delete observer;
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkSubjectReferences_data() {
+    addRows(QStringList() << "cached" << "uncached");
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkSubjectReferences() {
+    QFETCH(int, Size);
+    QFETCH(QString, Variant);
+
+    // Every tenth subject is a node, all subjects implement IExportable:
+    Observer* observer = new Observer("Benchmark Observer");
+    observer->startProcessingCycle();
+    for (int i = 0; i < Size; ++i) {
+        if (i % 10 == 0)
+            observer->attachSubject(new TreeNode(QString("Node %1").arg(i)),Observer::ObserverScopeOwnership);
+        else
+            observer->attachSubject(new TreeItem(QString("Item %1").arg(i)),Observer::ObserverScopeOwnership);
+    }
+    observer->endProcessingCycle(false);
+
+    // Detaching more than one subject at once clears the cached results of the observer:
+    QList<QObject*> spare_objects = createBenchmarkSubjects(2);
+    observer->attachSubjects(spare_objects,Observer::ManualOwnership);
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        if (Variant == "uncached") {
+            observer->detachSubjects(spare_objects);
+            observer->attachSubjects(spare_objects,Observer::ManualOwnership);
+        }
+
+        timer.start();
+        int count = observer->subjectReferences("Qtilities::Core::Interfaces::IExportable").count();
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+        QCOMPARE(count,Size);
+    }
+    recordResult("subject_references",iterations,elapsed);
+
+    observer->detachSubjects(spare_objects);
+    qDeleteAll(spare_objects);
+    delete observer;
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkTreeIterator_data() {
+    addRows(QStringList() << "property-tracked" << "stack");
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkTreeIterator() {
+    QFETCH(int, Size);
+    QFETCH(QString, Variant);
+
+    TreeNode* root = createObserverBenchmarkTree(Size);
+    TreeIterator::IterationMode mode = (Variant == "stack") ? TreeIterator::StackIteration : TreeIterator::PropertyTrackedIteration;
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    int count = 0;
+    QBENCHMARK {
+        count = 1;
+        timer.start();
+        TreeIterator itr(root,mode);
+        while (itr.hasNext()) {
+            itr.next();
+            ++count;
+        }
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+    }
+    QCOMPARE(count,root->treeCount() + 1);
+    recordResult("tree_iterator",iterations,elapsed);
+
+    delete root;
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkSubjectIterator_data() {
+    addRows(QStringList() << "children");
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkSubjectIterator() {
+    QFETCH(int, Size);
+
+    QList<QObject*> objects = createBenchmarkSubjects(Size);
+    Observer* observer = new Observer("Benchmark Observer");
+    observer->attachSubjects(objects,Observer::ManualOwnership);
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    int count = 0;
+    QBENCHMARK {
+        timer.start();
+        SubjectIterator<QObject> itr(observer,SubjectIterator<QObject>::IterateChildren);
+        count = itr.current() ? 1 : 0;
+        while (itr.hasNext()) {
+            itr.next();
+            ++count;
+        }
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+    }
+    QCOMPARE(count,Size);
+    recordResult("subject_iterator",iterations,elapsed);
+
+    delete observer;
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkMultiContextPropertyValue_data() {
+    addRows(QStringList() << "1 context" << "5 contexts");
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkMultiContextPropertyValue() {
+    QFETCH(int, Size);
+    QFETCH(QString, Variant);
+
+    QList<QObject*> objects = createBenchmarkSubjects(Size);
+    QList<Observer*> observers;
+    const int context_count = Variant.split(" ").front().toInt();
+    for (int c = 0; c < context_count; ++c) {
+        Observer* observer = new Observer(QString("Benchmark Observer %1").arg(c));
+        observer->attachSubjects(objects,Observer::ManualOwnership);
+        observers << observer;
+    }
+    Observer* observer = observers.front();
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        int valid_count = 0;
+        timer.start();
+        for (int i = 0; i < Size; ++i) {
+            if (observer->getMultiContextPropertyValue(objects.at(i),qti_prop_OBSERVER_MAP).isValid())
+                ++valid_count;
+        }
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+        QCOMPARE(valid_count,Size);
+    }
+    recordResult("multi_context_property_value",iterations,elapsed);
+
+    qDeleteAll(observers);
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkSetActiveSubjects_data() {
+    addRows(QStringList() << "single" << "half");
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkSetActiveSubjects() {
+    QFETCH(int, Size);
+    QFETCH(QString, Variant);
+
+    QList<QObject*> objects = createBenchmarkSubjects(Size);
+    Observer* observer = new Observer("Benchmark Observer");
+    ActivityPolicyFilter* activity_filter = new ActivityPolicyFilter;
+    activity_filter->setActivityPolicy(ActivityPolicyFilter::MultipleActivity);
+    observer->installSubjectFilter(activity_filter);
+    observer->attachSubjects(objects,Observer::ManualOwnership);
+
+    // Every iteration changes between two sets of active subjects:
+    QList<QObject*> first_set;
+    QList<QObject*> second_set;
+    if (Variant == "single") {
+        first_set << objects.first();
+        second_set << objects.last();
+    } else {
+        first_set = objects.mid(0,Size / 2);
+        second_set = objects.mid(Size / 2);
+    }
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        const QList<QObject*>& active_set = (iterations % 2 == 0) ? first_set : second_set;
+        timer.start();
+        QVERIFY(activity_filter->setActiveSubjects(active_set));
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+        QCOMPARE(activity_filter->activeSubjects().count(),active_set.count());
+    }
+    recordResult("set_active_subjects",iterations,elapsed);
+
+    observer->detachAll();
+    delete observer;
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkTreeModelRebuild_data() {
+    addRows(QStringList() << "gui-thread" << "threaded");
+}
+
+void Qtilities::Testing::ObserverBenchmarks::benchmarkTreeModelRebuild() {
+    QFETCH(int, Size);
+    QFETCH(QString, Variant);
+
+    TreeNode* root = createObserverBenchmarkTree(Size);
+    ObserverTreeModel* model = new ObserverTreeModel;
+    if (Variant == "threaded")
+        model->enableThreadedBuilding();
+    else
+        model->disableThreadedBuilding();
+    model->setObserverContext(root);
+    QVERIFY(rebuildTreeModel(model));
+
+    QElapsedTimer timer;
+    qint64 elapsed = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        timer.start();
+        QVERIFY(rebuildTreeModel(model));
+        elapsed += timer.nsecsElapsed();
+        ++iterations;
+    }
+    recordResult("tree_model_rebuild",iterations,elapsed);
+
+    delete model;
+    delete root;
+}
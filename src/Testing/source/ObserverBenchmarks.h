@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef ObserverBenchmarks_H
+#define ObserverBenchmarks_H
+
+#include "Testing_global.h"
+
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        /*!
+        \struct ObserverBenchmarksPrivateData
+        \brief Structure used by ObserverBenchmarks to store private data.
+          */
+        struct ObserverBenchmarksPrivateData;
+
+        //! Microbenchmarks of the core Observer operations.
+        /*!
+          Every benchmark runs on observers with 1000, 10000 and 100000 subjects and covers one operation:
+          - Attaching and detaching subjects, without subject filters and with a NamingPolicyFilter or an ActivityPolicyFilter installed.
+          - Observer::contains() and Observer::subjectReferences() using an interface name, with and without a cached result.
+          - Full walks using TreeIterator and SubjectIterator.
+          - Observer::getMultiContextPropertyValue() on subjects with one and with five observer contexts.
+          - ActivityPolicyFilter::setActiveSubjects().
+          - ObserverTreeModel rebuilds, in the GUI thread and in a worker thread.
+
+          Besides the results reported by QTest, every benchmark records a result line in the results file set using setResultsFile(). The recorded
+          time only covers the benchmarked operation, while QTest also reports the time spent to set up and clean up each iteration. The file is appended to,
+          thus the results of different releases can be compared. The QtilitiesObserverBenchmarks tool runs these benchmarks from the command line.
+
+          <i>This class was added in %Qtilities v1.5.</i>
+          */
+        class TESTING_SHARED_EXPORT ObserverBenchmarks: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            ObserverBenchmarks(QObject* parent = 0);
+            ~ObserverBenchmarks();
+
+            //! Sets the file to which the results are appended. When empty, results are only reported by QTest, which is the default.
+            /*!
+              Files with a \p .json extension receive one JSON object per result line. All other files receive CSV lines, starting with a header line when the file is empty.
+              */
+            void setResultsFile(const QString& file_name);
+            //! Gets the file to which the results are appended.
+            QString resultsFile() const;
+
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("Observer Benchmarks"); }
+
+        private slots:
+            void benchmarkAttach_data();
+            //! Benchmarks attaching subjects one by one, with the subject filter given by the variant installed.
+            void benchmarkAttach();
+            void benchmarkDetach_data();
+            //! Benchmarks detaching subjects one by one, with the subject filter given by the variant installed.
+            void benchmarkDetach();
+            void benchmarkContains_data();
+            //! Benchmarks Observer::contains() for every subject of an observer.
+            void benchmarkContains();
+            void benchmarkSubjectReferences_data();
+            //! Benchmarks Observer::subjectReferences() using an interface name, with and without a cached result.
+            void benchmarkSubjectReferences();
+            void benchmarkTreeIterator_data();
+            //! Benchmarks a full walk over a tree using TreeIterator in both iteration modes.
+            void benchmarkTreeIterator();
+            void benchmarkSubjectIterator_data();
+            //! Benchmarks a full walk over the subjects of an observer using SubjectIterator.
+            void benchmarkSubjectIterator();
+            void benchmarkMultiContextPropertyValue_data();
+            //! Benchmarks Observer::getMultiContextPropertyValue() for every subject of an observer.
+            void benchmarkMultiContextPropertyValue();
+            void benchmarkSetActiveSubjects_data();
+            //! Benchmarks ActivityPolicyFilter::setActiveSubjects() changing between two sets of active subjects.
+            void benchmarkSetActiveSubjects();
+            void benchmarkTreeModelRebuild_data();
+            //! Benchmarks ObserverTreeModel rebuilds, in the GUI thread and in a worker thread.
+            void benchmarkTreeModelRebuild();
+
+        private:
+            void addRows(const QStringList& variants);
+            void recordResult(const QString& benchmark, int iterations, qint64 elapsed_nsecs);
+
+            ObserverBenchmarksPrivateData* d;
+        };
+    }
+}
+
+#endif // ObserverBenchmarks_H
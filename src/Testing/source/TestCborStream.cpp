@@ -0,0 +1,252 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestCborStream.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QBuffer>
+#include <QDomDocument>
+#include <QDomElement>
+
+namespace {
+    QString qti_private_ExportXmlString(Observer* observer) {
+        QDomDocument doc("QtilitiesTesting");
+        QDomElement root = doc.createElement("QtilitiesTesting");
+        doc.appendChild(root);
+        observer->exportXml(&doc,&root);
+        return doc.toString(2);
+    }
+}
+
+int Qtilities::Testing::TestCborStream::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestCborStream::testWriteRead() {
+    QByteArray data;
+    {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        CborStreamWriter writer(&buffer);
+        writer.writeTag(CborStreamWriter::SelfDescribeTag);
+        writer.startMap();
+        writer.writeString("unsigned");
+        writer.writeUnsignedInteger(Q_UINT64_C(5000000000));
+        writer.writeString("negative");
+        writer.writeInteger(-1000);
+        writer.writeString("bool");
+        writer.writeBool(true);
+        writer.writeString("null");
+        writer.writeNull();
+        writer.writeString("double");
+        writer.writeDouble(1.5);
+        writer.writeString("bytes");
+        writer.writeByteArray(QByteArray("\x00\x01\x02",3));
+        writer.writeString("array");
+        writer.startArray(3);
+        writer.writeString("a");
+        writer.writeString(QString::fromUtf8("\xc3\xa9"));
+        writer.startArray();
+        writer.endArray();
+        writer.endArray();
+        QVERIFY(writer.endMap());
+        QVERIFY(!writer.hasError());
+    }
+
+    // Ending a container which is not open is an error:
+    {
+        QByteArray invalid_data;
+        QBuffer buffer(&invalid_data);
+        buffer.open(QIODevice::WriteOnly);
+        CborStreamWriter writer(&buffer);
+        writer.startMap();
+        QVERIFY(!writer.endArray());
+        QVERIFY(writer.hasError());
+    }
+
+    // The self describe tag and the start of an indefinite length map:
+    QCOMPARE(data.left(4),QByteArray("\xd9\xd9\xf7\xbf"));
+    // The break of the map is the last byte:
+    QCOMPARE(data.right(1),QByteArray("\xff"));
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    CborStreamReader reader(&buffer);
+    QVERIFY(reader.type() == CborStreamReader::Tag);
+    QVERIFY(reader.readTag() == CborStreamWriter::SelfDescribeTag);
+    QVERIFY(reader.isMap());
+    QVERIFY(!reader.isLengthKnown());
+    QVERIFY(reader.enterContainer());
+
+    QCOMPARE(reader.readString(),QString("unsigned"));
+    QVERIFY(reader.isUnsignedInteger());
+    QVERIFY(reader.toUnsignedInteger() == Q_UINT64_C(5000000000));
+    QVERIFY(reader.next());
+
+    QCOMPARE(reader.readString(),QString("negative"));
+    QVERIFY(reader.type() == CborStreamReader::NegativeInteger);
+    QVERIFY(reader.toInteger() == -1000);
+    QVERIFY(reader.next());
+
+    QCOMPARE(reader.readString(),QString("bool"));
+    QVERIFY(reader.isBool());
+    QVERIFY(reader.toBool());
+    QVERIFY(reader.next());
+
+    QCOMPARE(reader.readString(),QString("null"));
+    QVERIFY(reader.isNull());
+    QVERIFY(reader.next());
+
+    QCOMPARE(reader.readString(),QString("double"));
+    QVERIFY(reader.type() == CborStreamReader::Double);
+    QCOMPARE(reader.toDouble(),1.5);
+    QVERIFY(reader.next());
+
+    QCOMPARE(reader.readString(),QString("bytes"));
+    QCOMPARE(reader.readByteArray(),QByteArray("\x00\x01\x02",3));
+
+    QCOMPARE(reader.readString(),QString("array"));
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.isLengthKnown());
+    QVERIFY(reader.length() == 3);
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.readString(),QString("a"));
+    QCOMPARE(reader.readString(),QString::fromUtf8("\xc3\xa9"));
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.enterContainer());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.hasError());
+}
+
+void Qtilities::Testing::TestCborStream::testSkipItems() {
+    QByteArray data;
+    {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        CborStreamWriter writer(&buffer);
+        writer.startArray(2);
+        writer.startMap();
+        writer.writeString("nested");
+        writer.startArray();
+        writer.writeInteger(1);
+        writer.writeTag(1);
+        writer.writeInteger(2);
+        writer.endArray();
+        writer.endMap();
+        writer.writeTag(32);
+        writer.writeString("http://qtilities.org");
+        writer.endArray();
+        writer.writeString("last");
+        QVERIFY(!writer.hasError());
+    }
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    CborStreamReader reader(&buffer);
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.enterContainer());
+    // The map and its content:
+    QVERIFY(reader.isMap());
+    QVERIFY(reader.next());
+    // The tag together with the string it applies to:
+    QVERIFY(reader.type() == CborStreamReader::Tag);
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.readString(),QString("last"));
+    QVERIFY(!reader.hasNext());
+    QVERIFY(!reader.hasError());
+}
+
+void Qtilities::Testing::TestCborStream::testTruncatedData() {
+    // An array of two items which only contains one item:
+    QByteArray data("\x82\x01",2);
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    CborStreamReader reader(&buffer);
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.enterContainer());
+    int count = 0;
+    while (reader.hasNext()) {
+        ++count;
+        reader.next();
+    }
+    QCOMPARE(count,1);
+    QVERIFY(reader.hasError());
+    QVERIFY(!reader.errorString().isEmpty());
+    QVERIFY(!reader.leaveContainer());
+
+    // A string which is longer than the data:
+    QByteArray string_data("\x65\x61\x62",3);
+    QBuffer string_buffer(&string_data);
+    string_buffer.open(QIODevice::ReadOnly);
+    CborStreamReader string_reader(&string_buffer);
+    QVERIFY(string_reader.isString());
+    QVERIFY(string_reader.readString().isEmpty());
+    QVERIFY(string_reader.hasError());
+}
+
+void Qtilities::Testing::TestCborStream::testObserverRoundTrip() {
+    TreeNode* obj_source = new TreeNode("Root Node");
+    obj_source->enableCategorizedDisplay();
+    obj_source->enableActivityControl(ObserverHints::CheckboxActivityDisplay);
+    for (int i = 0; i < 10; ++i)
+        obj_source->addItem(QString("Item %1").arg(i),QtilitiesCategory("TestCategory1::LowerTestLevel","::"));
+    TreeNode* child_node = obj_source->addNode("TestNode1");
+    child_node->addItem("TestChild1",QtilitiesCategory("TestCategory2"));
+    child_node->addItem("TestChild2");
+    TreeNode* nested_node = child_node->addNode("TestNode2");
+    nested_node->addItem("TestChild3");
+
+    // Nothing is set, thus the default export version is used:
+    QVERIFY(obj_source->exportVersion() == Qtilities::Qtilities_Latest);
+
+    QByteArray data;
+    {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        CborStreamWriter writer(&buffer);
+        QCOMPARE(obj_source->exportCbor(&writer),IExportable::Complete);
+        QVERIFY(!writer.hasError());
+    }
+    QVERIFY(!data.isEmpty());
+
+    TreeNode* obj_import = new TreeNode;
+    {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+        CborStreamReader reader(&buffer);
+        QList<QPointer<QObject> > import_list;
+        QCOMPARE(obj_import->importCbor(&reader,import_list),IExportable::Complete);
+        QVERIFY(!reader.hasError());
+        QVERIFY(!reader.hasNext());
+        QVERIFY(!import_list.isEmpty());
+    }
+
+    QCOMPARE(obj_import->subjectCount(),obj_source->subjectCount());
+    QCOMPARE(obj_import->treeCount(),obj_source->treeCount());
+    QVERIFY(obj_import->hasCategory(QtilitiesCategory("TestCategory1::LowerTestLevel","::")));
+
+    // The trees must be the same, including their categories and activity:
+    QCOMPARE(qti_private_ExportXmlString(obj_import),qti_private_ExportXmlString(obj_source));
+
+    delete obj_source;
+    delete obj_import;
+}
@@ -0,0 +1,56 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_CBOR_STREAM_H
+#define TEST_CBOR_STREAM_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::CborStreamWriter, Qtilities::Core::CborStreamReader and CBOR exports.
+        class TESTING_SHARED_EXPORT TestCborStream: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("CborStream"); }
+
+        private slots:
+            //! Tests that all item types written by CborStreamWriter are read back by CborStreamReader.
+            void testWriteRead();
+            //! Tests that next() skips containers and tags completely.
+            void testSkipItems();
+            //! Tests that truncated data sets an error and ends loops over hasNext().
+            void testTruncatedData();
+            //! Tests a CBOR export and import of an observer tree using the default export version.
+            void testObserverRoundTrip();
+        };
+    }
+}
+
+#endif // TEST_CBOR_STREAM_H
@@ -0,0 +1,328 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestDeferredImport.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QBuffer>
+#include <QDomDocument>
+#include <QDomElement>
+
+namespace {
+    // Builds a tree where the nodes underneath the root have subjects and child nodes of their own, thus their import can be deferred.
+    TreeNode* qti_private_CreateTree(const QString& item_prefix = QString("Item")) {
+        TreeNode* root = new TreeNode("Root");
+        root->enableCategorizedDisplay();
+        for (int i = 0; i < 3; ++i) {
+            TreeNode* node = root->addNode(QString("Node %1").arg(i));
+            for (int j = 0; j < 5; ++j)
+                node->addItem(QString("%1 %2").arg(item_prefix).arg(j),QtilitiesCategory(QString("Category %1").arg(j % 2)));
+            TreeNode* child_node = node->addNode("Child Node");
+            child_node->addItem("Child Item 1");
+            child_node->addItem("Child Item 2");
+        }
+        return root;
+    }
+
+    bool qti_private_ExportTree(Observer* tree, const QString& file_name) {
+        QFile file(file_name);
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_4_7);
+        return tree->exportBinary(stream) == IExportable::Complete;
+    }
+
+    // Imports file_name into target. When lazy is true, the file is memory mapped the same way Project::loadProject() maps it
+    // and mapping is set to the mapped file, which is destroyed as soon as no deferred import uses it anymore.
+    IExportable::ExportResultFlags qti_private_ImportTree(Observer* target, const QString& file_name, bool lazy, QWeakPointer<QObject>* mapping = 0) {
+        QFile file(file_name);
+        QSharedPointer<QFile> mapped_file;
+        QByteArray data;
+        QBuffer buffer;
+        QDataStream stream;
+        if (lazy) {
+            mapped_file = QSharedPointer<QFile>(new QFile(file_name));
+            if (!mapped_file->open(QIODevice::ReadOnly) || mapped_file->size() == 0)
+                return IExportable::Failed;
+            uchar* memory = mapped_file->map(0,mapped_file->size());
+            if (!memory)
+                return IExportable::Failed;
+            data = QByteArray::fromRawData((const char*) memory,(int) mapped_file->size());
+            buffer.setBuffer(&data);
+            buffer.open(QIODevice::ReadOnly);
+            stream.setDevice(&buffer);
+            if (mapping)
+                *mapping = mapped_file;
+        } else {
+            if (!file.open(QIODevice::ReadOnly))
+                return IExportable::Failed;
+            stream.setDevice(&file);
+        }
+        stream.setVersion(QDataStream::Qt_4_7);
+
+        if (lazy)
+            CompactBinaryFormat::setDeferredImportSource(stream,data,mapped_file);
+        QList<QPointer<QObject> > import_list;
+        IExportable::ExportResultFlags result = target->importBinary(stream,import_list);
+        if (lazy)
+            CompactBinaryFormat::clearDeferredImportSource(stream);
+        return result;
+    }
+
+    QString qti_private_ExportXmlString(Observer* observer) {
+        QDomDocument doc("QtilitiesTesting");
+        QDomElement root = doc.createElement("QtilitiesTesting");
+        doc.appendChild(root);
+        observer->exportXml(&doc,&root);
+        return doc.toString(2);
+    }
+
+    QStringList qti_private_TreeIteratorNames(Observer* observer) {
+        QStringList names;
+        TreeIterator itr(observer);
+        names << itr.current()->objectName();
+        while (itr.hasNext())
+            names << itr.next()->objectName();
+        return names;
+    }
+
+    QStringList qti_private_SubjectIteratorNames(Observer* observer) {
+        QStringList names;
+        SubjectIterator<QObject> itr(observer,SubjectIterator<QObject>::IterateChildren);
+        if (itr.current())
+            names << itr.current()->objectName();
+        while (itr.hasNext())
+            names << itr.next()->objectName();
+        return names;
+    }
+
+    QString qti_private_FileName(const QString& name) {
+        return QtilitiesApplication::applicationSessionPath() + "/" + name;
+    }
+}
+
+int Qtilities::Testing::TestDeferredImport::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestDeferredImport::testLazyAndEagerImport() {
+    const QString file_name = qti_private_FileName("testLazyAndEagerImport.bin");
+    TreeNode* source = qti_private_CreateTree();
+    QVERIFY(qti_private_ExportTree(source,file_name));
+
+    TreeNode* eager = new TreeNode("Root");
+    QCOMPARE(qti_private_ImportTree(eager,file_name,false),IExportable::Complete);
+    TreeNode* lazy = new TreeNode("Root");
+    QWeakPointer<QObject> mapping;
+    QCOMPARE(qti_private_ImportTree(lazy,file_name,true,&mapping),IExportable::Complete);
+
+    // The subjects of the nodes underneath the root were not imported, thus they still use the mapped file:
+    QVERIFY(!mapping.isNull());
+    QCOMPARE(lazy->subjectCount(),source->subjectCount());
+    QVERIFY(!mapping.isNull());
+
+    // Exporting the tree imports all deferred subjects:
+    QCOMPARE(qti_private_ExportXmlString(lazy),qti_private_ExportXmlString(eager));
+    QCOMPARE(qti_private_ExportXmlString(lazy),qti_private_ExportXmlString(source));
+    QVERIFY(mapping.isNull());
+    QCOMPARE(lazy->treeCount(),source->treeCount());
+    QCOMPARE(eager->treeCount(),source->treeCount());
+    QCOMPARE(qti_private_TreeIteratorNames(lazy),qti_private_TreeIteratorNames(source));
+
+    // The file is not used anymore:
+    QVERIFY(QFile::remove(file_name));
+
+    delete source;
+    delete eager;
+    delete lazy;
+}
+
+void Qtilities::Testing::TestDeferredImport::testAccessorsBeforeImport_data() {
+    QTest::addColumn<QString>("Accessor");
+    QStringList accessors;
+    accessors << "subjectCount" << "subjectAt" << "subjectNames" << "subjectDisplayedNames" << "subjectReferences" << "subjectReferencesTemplate"
+              << "subjectIDs" << "subjectReferenceByName" << "subjectIDByName" << "containsSubjectWithName" << "subjectMap" << "subjectObserverReferences"
+              << "subjectCategories" << "subjectNamesByCategory" << "subjectReferencesByCategory" << "subjectReferenceCategoryMap" << "hasCategory"
+              << "treeCount" << "treeAt" << "treeChildren" << "treeContains" << "treeIterator" << "subjectIterator" << "cloneTree" << "exportBinary"
+              << "exportXml" << "isModified" << "setSubjectLimit" << "installSubjectFilter" << "canAttach" << "attachSubject" << "detachAll" << "deleteAll";
+    foreach (const QString& accessor, accessors)
+        QTest::newRow(accessor.toLatin1().constData()) << accessor;
+}
+
+void Qtilities::Testing::TestDeferredImport::testAccessorsBeforeImport() {
+    QFETCH(QString, Accessor);
+
+    const QString file_name = qti_private_FileName("testAccessorsBeforeImport.bin");
+    TreeNode* source = qti_private_CreateTree();
+    QVERIFY(qti_private_ExportTree(source,file_name));
+    delete source;
+
+    TreeNode* eager = new TreeNode("Root");
+    QCOMPARE(qti_private_ImportTree(eager,file_name,false),IExportable::Complete);
+    TreeNode* lazy = new TreeNode("Root");
+    QWeakPointer<QObject> mapping;
+    QCOMPARE(qti_private_ImportTree(lazy,file_name,true,&mapping),IExportable::Complete);
+
+    Observer* eager_node = qobject_cast<Observer*> (eager->subjectAt(0));
+    Observer* lazy_node = qobject_cast<Observer*> (lazy->subjectAt(0));
+    QVERIFY(eager_node);
+    QVERIFY(lazy_node);
+    QVERIFY(!mapping.isNull());
+
+    // The first access to the subjects of lazy_node must import them:
+    if (Accessor == "subjectCount") {
+        QCOMPARE(lazy_node->subjectCount(),eager_node->subjectCount());
+    } else if (Accessor == "subjectAt") {
+        QVERIFY(lazy_node->subjectAt(0));
+        QCOMPARE(lazy_node->subjectAt(0)->objectName(),eager_node->subjectAt(0)->objectName());
+    } else if (Accessor == "subjectNames") {
+        QCOMPARE(lazy_node->subjectNames(),eager_node->subjectNames());
+    } else if (Accessor == "subjectDisplayedNames") {
+        QCOMPARE(lazy_node->subjectDisplayedNames(),eager_node->subjectDisplayedNames());
+    } else if (Accessor == "subjectReferences") {
+        QCOMPARE(lazy_node->subjectReferences().count(),eager_node->subjectReferences().count());
+    } else if (Accessor == "subjectReferencesTemplate") {
+        QCOMPARE(lazy_node->subjectReferences<Observer>().count(),eager_node->subjectReferences<Observer>().count());
+    } else if (Accessor == "subjectIDs") {
+        QCOMPARE(lazy_node->subjectIDs().count(),eager_node->subjectIDs().count());
+    } else if (Accessor == "subjectReferenceByName") {
+        QVERIFY(lazy_node->subjectReference("Item 2"));
+    } else if (Accessor == "subjectIDByName") {
+        QVERIFY(lazy_node->subjectID("Item 2") != -1);
+    } else if (Accessor == "containsSubjectWithName") {
+        QVERIFY(lazy_node->containsSubjectWithName("Item 2"));
+    } else if (Accessor == "subjectMap") {
+        QCOMPARE(lazy_node->subjectMap().count(),eager_node->subjectMap().count());
+    } else if (Accessor == "subjectObserverReferences") {
+        QCOMPARE(lazy_node->subjectObserverReferences().count(),eager_node->subjectObserverReferences().count());
+    } else if (Accessor == "subjectCategories") {
+        QCOMPARE(lazy_node->subjectCategories().count(),eager_node->subjectCategories().count());
+    } else if (Accessor == "subjectNamesByCategory") {
+        QCOMPARE(lazy_node->subjectNamesByCategory(QtilitiesCategory("Category 1")),eager_node->subjectNamesByCategory(QtilitiesCategory("Category 1")));
+    } else if (Accessor == "subjectReferencesByCategory") {
+        QCOMPARE(lazy_node->subjectReferencesByCategory(QtilitiesCategory("Category 1")).count(),eager_node->subjectReferencesByCategory(QtilitiesCategory("Category 1")).count());
+    } else if (Accessor == "subjectReferenceCategoryMap") {
+        QCOMPARE(lazy_node->subjectReferenceCategoryMap().count(),eager_node->subjectReferenceCategoryMap().count());
+    } else if (Accessor == "hasCategory") {
+        QVERIFY(lazy_node->hasCategory(QtilitiesCategory("Category 1")));
+    } else if (Accessor == "treeCount") {
+        QCOMPARE(lazy_node->treeCount(),eager_node->treeCount());
+    } else if (Accessor == "treeAt") {
+        QVERIFY(lazy_node->treeAt(0));
+        QCOMPARE(lazy_node->treeAt(0)->objectName(),eager_node->treeAt(0)->objectName());
+    } else if (Accessor == "treeChildren") {
+        QCOMPARE(lazy_node->treeChildren().count(),eager_node->treeChildren().count());
+    } else if (Accessor == "treeContains") {
+        QVERIFY(lazy_node->treeContains(lazy_node->subjectReference("Item 2")));
+    } else if (Accessor == "treeIterator") {
+        QCOMPARE(qti_private_TreeIteratorNames(lazy_node),qti_private_TreeIteratorNames(eager_node));
+    } else if (Accessor == "subjectIterator") {
+        QCOMPARE(qti_private_SubjectIteratorNames(lazy_node),qti_private_SubjectIteratorNames(eager_node));
+    } else if (Accessor == "cloneTree") {
+        Observer* lazy_clone = lazy_node->cloneTree();
+        Observer* eager_clone = eager_node->cloneTree();
+        QVERIFY(lazy_clone);
+        QVERIFY(eager_clone);
+        QCOMPARE(lazy_clone->treeCount(),eager_clone->treeCount());
+        delete lazy_clone;
+        delete eager_clone;
+    } else if (Accessor == "exportBinary") {
+        QByteArray lazy_data;
+        QByteArray eager_data;
+        QDataStream lazy_stream(&lazy_data,QIODevice::WriteOnly);
+        QDataStream eager_stream(&eager_data,QIODevice::WriteOnly);
+        QCOMPARE(lazy_node->exportBinary(lazy_stream),IExportable::Complete);
+        QCOMPARE(eager_node->exportBinary(eager_stream),IExportable::Complete);
+        QCOMPARE(lazy_data.size(),eager_data.size());
+    } else if (Accessor == "exportXml") {
+        QCOMPARE(qti_private_ExportXmlString(lazy_node),qti_private_ExportXmlString(eager_node));
+    } else if (Accessor == "isModified") {
+        QCOMPARE(lazy_node->isModified(),eager_node->isModified());
+    } else if (Accessor == "setSubjectLimit") {
+        // The node has more subjects than the limit, thus the limit is rejected:
+        QVERIFY(!eager_node->setSubjectLimit(1));
+        QVERIFY(!lazy_node->setSubjectLimit(1));
+    } else if (Accessor == "installSubjectFilter") {
+        // Filters can't be installed on observers which have subjects:
+        ActivityPolicyFilter* eager_filter = new ActivityPolicyFilter;
+        ActivityPolicyFilter* lazy_filter = new ActivityPolicyFilter;
+        QVERIFY(!eager_node->installSubjectFilter(eager_filter));
+        QVERIFY(!lazy_node->installSubjectFilter(lazy_filter));
+        delete eager_filter;
+        delete lazy_filter;
+    } else if (Accessor == "canAttach") {
+        QObject obj;
+        QCOMPARE(lazy_node->canAttach(&obj,Observer::ManualOwnership),eager_node->canAttach(&obj,Observer::ManualOwnership));
+    } else if (Accessor == "attachSubject") {
+        QVERIFY(eager_node->attachSubject(new TreeItem("New Item"),Observer::ObserverScopeOwnership));
+        QVERIFY(lazy_node->attachSubject(new TreeItem("New Item"),Observer::ObserverScopeOwnership));
+    } else if (Accessor == "detachAll") {
+        eager_node->detachAll();
+        lazy_node->detachAll();
+    } else if (Accessor == "deleteAll") {
+        eager_node->deleteAll();
+        lazy_node->deleteAll();
+    } else {
+        QFAIL(qPrintable("Unknown accessor: " + Accessor));
+    }
+
+    // Afterwards both trees are the same:
+    QCOMPARE(lazy_node->subjectCount(),eager_node->subjectCount());
+    QCOMPARE(qti_private_ExportXmlString(lazy),qti_private_ExportXmlString(eager));
+    QVERIFY(mapping.isNull());
+
+    delete eager;
+    delete lazy;
+    QFile::remove(file_name);
+}
+
+void Qtilities::Testing::TestDeferredImport::testFileChangedWhileMapped() {
+    const QString file_name = qti_private_FileName("testFileChangedWhileMapped.bin");
+    TreeNode* source = qti_private_CreateTree();
+    QVERIFY(qti_private_ExportTree(source,file_name));
+    const QString expected_xml = qti_private_ExportXmlString(source);
+
+    // Delete the file while it is mapped. Where mapped files can't be deleted, the file stays. In both cases the mapped data stays readable:
+    TreeNode* lazy = new TreeNode("Root");
+    QWeakPointer<QObject> mapping;
+    QCOMPARE(qti_private_ImportTree(lazy,file_name,true,&mapping),IExportable::Complete);
+    QVERIFY(!mapping.isNull());
+    QFile::remove(file_name);
+    QCOMPARE(qti_private_ExportXmlString(lazy),expected_xml);
+    QVERIFY(mapping.isNull());
+    delete lazy;
+
+    // Replace the file with a different tree while it is mapped, the way Project::saveProject() replaces project files. The deferred
+    // subjects are still imported from the original file:
+    QFile::remove(file_name);
+    QVERIFY(qti_private_ExportTree(source,file_name));
+    lazy = new TreeNode("Root");
+    QCOMPARE(qti_private_ImportTree(lazy,file_name,true,&mapping),IExportable::Complete);
+    QVERIFY(!mapping.isNull());
+    TreeNode* replacement = qti_private_CreateTree("Replaced Item");
+    const QString replacement_file_name = file_name + ".new";
+    QVERIFY(qti_private_ExportTree(replacement,replacement_file_name));
+    if (QFile::remove(file_name))
+        QVERIFY(QFile::rename(replacement_file_name,file_name));
+    QCOMPARE(qti_private_ExportXmlString(lazy),expected_xml);
+    QVERIFY(mapping.isNull());
+
+    // Once the deferred imports completed, the file is not mapped anymore and can be replaced on all platforms:
+    QFile::remove(replacement_file_name);
+    QVERIFY(QFile::remove(file_name));
+
+    delete lazy;
+    delete replacement;
+    delete source;
+}
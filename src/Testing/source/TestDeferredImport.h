@@ -0,0 +1,55 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_DEFERRED_IMPORT_H
+#define TEST_DEFERRED_IMPORT_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of observer imports which are deferred using Qtilities::Core::CompactBinaryFormat::setDeferredImportSource().
+        class TESTING_SHARED_EXPORT TestDeferredImport: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("DeferredImport"); }
+
+        private slots:
+            //! Tests that lazy and eager imports of the same file result in the same tree.
+            void testLazyAndEagerImport();
+            //! Tests that every public accessor of an observer imports its deferred subjects first.
+            void testAccessorsBeforeImport_data();
+            void testAccessorsBeforeImport();
+            //! Tests deleting and replacing the file on disk while it is mapped.
+            void testFileChangedWhileMapped();
+        };
+    }
+}
+
+#endif // TEST_DEFERRED_IMPORT_H
@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestDeferredPluginMode.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QtilitiesExtensionSystem>
+using namespace QtilitiesExtensionSystem;
+
+#include <QLayout>
+#include <QPixmap>
+#include <QPointer>
+#include <QWidget>
+
+namespace {
+    // A real mode which records how the deferred mode uses it:
+    class DeferredPluginTestMode : public QObject, public IMode {
+    public:
+        DeferredPluginTestMode() : widget(new QWidget), initialize_count(0), about_to_be_activated_count(0), just_activated_count(0) {}
+        ~DeferredPluginTestMode() { delete widget; }
+
+        QObject* objectBase() { return this; }
+        const QObject* objectBase() const { return this; }
+
+        QWidget* modeWidget() { return widget; }
+        void initializeMode() { ++initialize_count; }
+        QIcon modeIcon() const { return QIcon(); }
+        QString modeName() const { return "Real Mode"; }
+        QString contextString() const { return "Real Mode Context"; }
+        QString contextHelpId() const { return "Real Mode Help"; }
+        void aboutToBeActivated() { ++about_to_be_activated_count; }
+        void justActivated() { ++just_activated_count; }
+
+        QPointer<QWidget> widget;
+        int initialize_count;
+        int about_to_be_activated_count;
+        int just_activated_count;
+    };
+}
+
+int Qtilities::Testing::TestDeferredPluginMode::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestDeferredPluginMode::testBeforeActivation() {
+    QPixmap pixmap(16,16);
+    pixmap.fill(Qt::red);
+    QIcon icon(pixmap);
+
+    DeferredPluginMode mode("Test Plugin","Test Mode",icon);
+    QCOMPARE(mode.pluginName(),QString("Test Plugin"));
+    QCOMPARE(mode.modeName(),QString("Test Mode"));
+    QCOMPARE(mode.objectName(),QString("Test Mode"));
+    QCOMPARE(mode.modeIcon().cacheKey(),icon.cacheKey());
+    QVERIFY(!mode.mode());
+    QVERIFY(mode.contextString().isEmpty());
+    QVERIFY(mode.contextHelpId().isEmpty());
+
+    // The widget is an empty container until the plugin is activated, and the same container is always returned:
+    QWidget* widget = mode.modeWidget();
+    QVERIFY(widget);
+    QVERIFY(widget->layout());
+    QCOMPARE(widget->layout()->count(),0);
+    QCOMPARE(mode.modeWidget(),widget);
+
+    // The context string can be known before the plugin is activated:
+    mode.setContextString("Deferred Context");
+    QCOMPARE(mode.contextString(),QString("Deferred Context"));
+    delete widget;
+}
+
+void Qtilities::Testing::TestDeferredPluginMode::testRealMode() {
+    DeferredPluginTestMode real_mode;
+    DeferredPluginMode mode("Test Plugin","Test Mode",QIcon());
+    mode.setMode(&real_mode);
+    QCOMPARE(mode.mode(),static_cast<IMode*>(&real_mode));
+
+    // The name of the deferred mode stays in use, the context comes from the real mode unless it was set:
+    QCOMPARE(mode.modeName(),QString("Test Mode"));
+    QCOMPARE(mode.contextString(),QString("Real Mode Context"));
+    QCOMPARE(mode.contextHelpId(),QString("Real Mode Help"));
+    mode.setContextString("Deferred Context");
+    QCOMPARE(mode.contextString(),QString("Deferred Context"));
+    mode.setContextString(QString());
+    QCOMPARE(mode.contextString(),QString("Real Mode Context"));
+
+    mode.justActivated();
+    QCOMPARE(real_mode.just_activated_count,1);
+    QCOMPARE(real_mode.initialize_count,0);
+
+    // The deferred mode does not take ownership of the real mode:
+    mode.setMode(0);
+    QVERIFY(real_mode.widget);
+    delete mode.modeWidget();
+}
+
+void Qtilities::Testing::TestDeferredPluginMode::testActivateUnknownPlugin() {
+    DeferredPluginTestMode real_mode;
+    DeferredPluginMode mode("Plugin Which Is Not Loaded","Test Mode",QIcon());
+    mode.setMode(&real_mode);
+    QVERIFY(!EXTENSION_SYSTEM->activatePlugin(mode.pluginName()));
+
+    // When the plugin fails to activate, the real mode is not initialized and its widget is not embedded:
+    QWidget* widget = mode.modeWidget();
+    mode.aboutToBeActivated();
+    QCOMPARE(real_mode.initialize_count,0);
+    QCOMPARE(widget->layout()->count(),0);
+    QVERIFY(real_mode.widget->parentWidget() != widget);
+
+    // Activation is only attempted once:
+    mode.aboutToBeActivated();
+    QCOMPARE(real_mode.initialize_count,0);
+    QCOMPARE(real_mode.about_to_be_activated_count,2);
+    delete widget;
+}
@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_DEFERRED_PLUGIN_MODE_H
+#define TEST_DEFERRED_PLUGIN_MODE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::ExtensionSystem::DeferredPluginMode.
+        class TESTING_SHARED_EXPORT TestDeferredPluginMode: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("DeferredPluginMode"); }
+
+        private slots:
+            //! Tests what the mode provides before its plugin is activated.
+            void testBeforeActivation();
+            //! Tests that the context string and help ID of the real mode are used once it is set.
+            void testRealMode();
+            //! Tests activating a mode of which the plugin is not loaded.
+            void testActivateUnknownPlugin();
+        };
+    }
+}
+
+#endif // TEST_DEFERRED_PLUGIN_MODE_H
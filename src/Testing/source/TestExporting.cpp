@@ -19,6 +19,62 @@ using namespace QtilitiesExtensionSystem;
 
 #include <QDomDocument>
 #include <QDomElement>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+namespace {
+    // Compares two elements and their child elements recursively. Child elements must appear in the same order, the order of attributes is not significant in XML.
+    bool qti_private_CompareElements(const QDomElement& expected, const QDomElement& actual, QString* mismatch) {
+        if (expected.tagName() != actual.tagName()) {
+            *mismatch = QString("Expected element \"%1\", found \"%2\".").arg(expected.tagName()).arg(actual.tagName());
+            return false;
+        }
+
+        QDomNamedNodeMap expected_attributes = expected.attributes();
+        QDomNamedNodeMap actual_attributes = actual.attributes();
+        if (expected_attributes.count() != actual_attributes.count()) {
+            *mismatch = QString("Element \"%1\" has %2 attributes, expected %3.").arg(expected.tagName()).arg(actual_attributes.count()).arg(expected_attributes.count());
+            return false;
+        }
+        for (int i = 0; i < expected_attributes.count(); ++i) {
+            QDomAttr attribute = expected_attributes.item(i).toAttr();
+            if (actual.attribute(attribute.name(),QString()) != attribute.value() || !actual.hasAttribute(attribute.name())) {
+                *mismatch = QString("Attribute \"%1\" of element \"%2\" does not match.").arg(attribute.name()).arg(expected.tagName());
+                return false;
+            }
+        }
+
+        QDomElement expected_child = expected.firstChildElement();
+        QDomElement actual_child = actual.firstChildElement();
+        while (!expected_child.isNull() && !actual_child.isNull()) {
+            if (!qti_private_CompareElements(expected_child,actual_child,mismatch))
+                return false;
+            expected_child = expected_child.nextSiblingElement();
+            actual_child = actual_child.nextSiblingElement();
+        }
+        if (!expected_child.isNull() || !actual_child.isNull()) {
+            *mismatch = QString("Element \"%1\" has a different number of child elements.").arg(expected.tagName());
+            return false;
+        }
+        if (expected.firstChildElement().isNull() && expected.text() != actual.text()) {
+            *mismatch = QString("The text of element \"%1\" does not match.").arg(expected.tagName());
+            return false;
+        }
+        return true;
+    }
+
+    QByteArray qti_private_ExportXmlStream(Observer* observer, ObserverData::ExportItemFlags export_flags) {
+        QByteArray data;
+        QXmlStreamWriter writer(&data);
+        writer.writeStartDocument();
+        writer.writeStartElement("QtilitiesTesting");
+        if (observer->exportXmlStreamExt(&writer,export_flags) == IExportable::Failed)
+            return QByteArray();
+        writer.writeEndElement();
+        writer.writeEndDocument();
+        return data;
+    }
+}
 
 int Qtilities::Testing::TestExporting::execTest(int argc, char ** argv) {
     return QTest::qExec(this,argc,argv);
@@ -35,10 +91,10 @@ void Qtilities::Testing::TestExporting::testPropertyNameEncoding() {
 
 void Qtilities::Testing::TestExporting::genericTest(IExportable* obj_source, IExportable* obj_import_binary, IExportable* obj_import_xml, Qtilities::ExportVersion write_version, Qtilities::ExportVersion read_version, const QString& file_name) {
     QDataStream::Version data_stream_write_version;
-    if (write_version == Qtilities::Qtilities_1_0 || write_version == Qtilities::Qtilities_1_1 || write_version == Qtilities::Qtilities_1_2)
+    if (write_version == Qtilities::Qtilities_1_0 || write_version == Qtilities::Qtilities_1_1 || write_version == Qtilities::Qtilities_1_2 || write_version == Qtilities::Qtilities_1_5)
         data_stream_write_version =  QDataStream::Qt_4_7;
     QDataStream::Version data_stream_read_version;
-    if (read_version == Qtilities::Qtilities_1_0 || read_version == Qtilities::Qtilities_1_1 || read_version == Qtilities::Qtilities_1_2)
+    if (read_version == Qtilities::Qtilities_1_0 || read_version == Qtilities::Qtilities_1_1 || read_version == Qtilities::Qtilities_1_2 || read_version == Qtilities::Qtilities_1_5)
         data_stream_read_version =  QDataStream::Qt_4_7;
 
     QList<QPointer<QObject> > import_list;
@@ -1139,3 +1195,197 @@ void Testing::TestExporting::testObserverHints_w1_1_r1_1() {
     delete obj_import_binary;
     delete obj_import_xml;
 }
+
+// --------------------------------------------------------------------
+// Test Qtilities_1_5 against Qtilities_1_5
+// That is, exported with Qtilities_1_5 and imported with Qtilities_1_5
+// --------------------------------------------------------------------
+
+void Qtilities::Testing::TestExporting::testObserver_w1_5_r1_5() {
+    TreeNode* obj_source = new TreeNode("Root Node");
+    TreeNode* obj_import_binary = new TreeNode;
+    TreeNode* obj_import_xml = new TreeNode;
+
+    obj_source->enableCategorizedDisplay();
+    obj_source->enableActivityControl(ObserverHints::CheckboxActivityDisplay);
+
+    // Build a tree in which the same strings are repeated often:
+    for (int i = 0; i < 50; ++i)
+        obj_source->addItem(QString("Item %1").arg(i),QtilitiesCategory("TestCategory1::LowerTestLevel","::"));
+    TreeNode* child_node = obj_source->addNode("TestNode1");
+    child_node->addItem("TestChild1",QtilitiesCategory("TestCategory2"));
+    child_node->addItem("TestChild2");
+
+    genericTest(obj_source,obj_import_binary,obj_import_xml,Qtilities::Qtilities_1_5,Qtilities::Qtilities_1_5,"testObserver_w1_5_r1_5");
+
+    // Compare output files:
+    QString file_original_binary = QString("%1/%2.binary").arg(QtilitiesApplication::applicationSessionPath()).arg("testObserver_w1_5_r1_5");
+    QString file_readback_binary = QString("%1/%2_readback.binary").arg(QtilitiesApplication::applicationSessionPath()).arg("testObserver_w1_5_r1_5");
+    QString file_original_xml = QString("%1/%2.xml").arg(QtilitiesApplication::applicationSessionPath()).arg("testObserver_w1_5_r1_5");
+    QString file_readback_xml = QString("%1/%2_readback.xml").arg(QtilitiesApplication::applicationSessionPath()).arg("testObserver_w1_5_r1_5");
+    QVERIFY(FileUtils::compareFiles(file_original_binary,file_readback_binary));
+    QVERIFY(FileUtils::compareFiles(file_original_xml,file_readback_xml));
+    QCOMPARE(obj_import_binary->subjectCount(),obj_source->subjectCount());
+
+    // The compact format must be smaller than the Qtilities_1_2 format:
+    QByteArray binary_1_2;
+    QByteArray binary_1_5;
+    {
+        QDataStream stream(&binary_1_2,QIODevice::WriteOnly);
+        obj_source->setExportVersion(Qtilities::Qtilities_1_2);
+        QVERIFY(obj_source->exportBinary(stream) != IExportable::Failed);
+    }
+    {
+        QDataStream stream(&binary_1_5,QIODevice::WriteOnly);
+        obj_source->setExportVersion(Qtilities::Qtilities_1_5);
+        QVERIFY(obj_source->exportBinary(stream) != IExportable::Failed);
+    }
+    QVERIFY(binary_1_5.size() < binary_1_2.size());
+
+    // Files written with older versions must stay readable:
+    {
+        TreeNode* obj_import_1_2 = new TreeNode;
+        QDataStream stream(&binary_1_2,QIODevice::ReadOnly);
+        QList<QPointer<QObject> > import_list;
+        obj_import_1_2->setExportVersion(Qtilities::Qtilities_1_2);
+        QVERIFY(obj_import_1_2->importBinary(stream,import_list) != IExportable::Failed);
+        QCOMPARE(obj_import_1_2->subjectCount(),obj_source->subjectCount());
+        delete obj_import_1_2;
+    }
+
+    delete obj_source;
+    delete obj_import_binary;
+    delete obj_import_xml;
+}
+
+void Qtilities::Testing::TestExporting::testObserverParallelExport() {
+    // Build a tree with independent subtrees which are large enough to be exported in their own threads,
+    // and a subtree which shares a subject with another subtree which must be exported serially:
+    TreeNode* obj_source = new TreeNode("Root Node");
+    for (int n = 0; n < 4; ++n) {
+        TreeNode* child_node = obj_source->addNode(QString("TestNode%1").arg(n));
+        for (int i = 0; i < 100; ++i)
+            child_node->addItem(QString("TestChild%1_%2").arg(n).arg(i));
+    }
+    TreeNode* shared_node = obj_source->addNode("SharedNode");
+    for (int i = 0; i < 100; ++i)
+        shared_node->addItem(QString("SharedChild%1").arg(i));
+    TreeNode* other_shared_node = obj_source->addNode("OtherSharedNode");
+    TreeItem* shared_item = new TreeItem("SharedItem");
+    shared_node->addItem(shared_item);
+    other_shared_node->addItem(shared_item);
+    obj_source->setExportVersion(Qtilities::Qtilities_1_0);
+
+    // Binary:
+    QByteArray serial_binary;
+    QByteArray parallel_binary;
+    {
+        QDataStream stream(&serial_binary,QIODevice::WriteOnly);
+        QVERIFY(obj_source->exportBinaryExt(stream,ObserverData::ExportData) != IExportable::Failed);
+    }
+    {
+        QDataStream stream(&parallel_binary,QIODevice::WriteOnly);
+        QVERIFY(obj_source->exportBinaryExt(stream,ObserverData::ExportData | ObserverData::ExportParallel) != IExportable::Failed);
+    }
+    QCOMPARE(parallel_binary,serial_binary);
+
+    // XML:
+    QDomDocument serial_doc("QtilitiesTesting");
+    QDomElement serial_root = serial_doc.createElement("QtilitiesTesting");
+    serial_doc.appendChild(serial_root);
+    QVERIFY(obj_source->exportXmlExt(&serial_doc,&serial_root,ObserverData::ExportData) != IExportable::Failed);
+    QDomDocument parallel_doc("QtilitiesTesting");
+    QDomElement parallel_root = parallel_doc.createElement("QtilitiesTesting");
+    parallel_doc.appendChild(parallel_root);
+    QVERIFY(obj_source->exportXmlExt(&parallel_doc,&parallel_root,ObserverData::ExportData | ObserverData::ExportParallel) != IExportable::Failed);
+    QCOMPARE(parallel_doc.toString(2),serial_doc.toString(2));
+
+    delete obj_source;
+}
+
+void Qtilities::Testing::TestExporting::testObserverXmlStream() {
+    // Build a tree with categories, category access modes, hints and properties on the observers and on their subjects:
+    TreeNode* obj_source = new TreeNode("Root Node");
+    obj_source->enableCategorizedDisplay();
+    obj_source->enableActivityControl(ObserverHints::CheckboxActivityDisplay);
+    obj_source->setObserverDescription("Root Description");
+    for (int i = 0; i < 5; ++i) {
+        TreeItem* item = obj_source->addItem(QString("Item %1").arg(i),QtilitiesCategory(QString("Category %1").arg(i % 2)));
+        ObjectManager::setSharedProperty(item,SharedProperty("Shared Property",QVariant(i)));
+        MultiContextProperty multi_context_property("Multi Context Property");
+        multi_context_property.setValue(QVariant(i),1);
+        multi_context_property.setValue(QVariant(i + 1),2);
+        ObjectManager::setMultiContextProperty(item,multi_context_property);
+    }
+    TreeNode* child_node = obj_source->addNode("Child Node",QtilitiesCategory("Category 1"));
+    child_node->enableCategorizedDisplay();
+    child_node->addItem("Child Item 1",QtilitiesCategory("Child Category::Level 2","::"));
+    child_node->addItem("Child Item 2");
+    child_node->setAccessModeScope(Observer::CategorizedScope);
+    child_node->setAccessMode(Observer::ReadOnlyAccess,QtilitiesCategory("Child Category::Level 2","::"));
+    obj_source->setAccessModeScope(Observer::CategorizedScope);
+    obj_source->setAccessMode(Observer::ReadOnlyAccess,QtilitiesCategory("Category 0"));
+
+    QList<ObserverData::ExportItemFlags> flags_list;
+    flags_list << ObserverData::ExportItemFlags(ObserverData::ExportData) << ObserverData::ExportItemFlags(ObserverData::ExportAllItems);
+    foreach (ObserverData::ExportItemFlags export_flags, flags_list) {
+        // Export using the DOM and using the stream writer:
+        QDomDocument dom_doc("QtilitiesTesting");
+        QDomElement dom_root = dom_doc.createElement("QtilitiesTesting");
+        dom_doc.appendChild(dom_root);
+        QCOMPARE(obj_source->exportXmlExt(&dom_doc,&dom_root,export_flags),IExportable::Complete);
+
+        QByteArray stream_data = qti_private_ExportXmlStream(obj_source,export_flags);
+        QVERIFY(!stream_data.isEmpty());
+        QDomDocument stream_doc;
+        QVERIFY(stream_doc.setContent(stream_data));
+        QDomElement stream_root = stream_doc.documentElement();
+
+        // Both must contain the same elements in the same order:
+        QVERIFY(!dom_root.firstChildElement("Categories").isNull());
+        QVERIFY(!dom_root.firstChildElement("Data").isNull());
+        QString mismatch;
+        QVERIFY2(qti_private_CompareElements(dom_root,stream_root,&mismatch),qPrintable(mismatch));
+
+        // Import the stream output using the DOM import and the DOM output using the stream import:
+        TreeNode* obj_import_dom = new TreeNode("Root Node");
+        QList<QPointer<QObject> > import_list;
+        QCOMPARE(obj_import_dom->importXml(&stream_doc,&stream_root,import_list),IExportable::Complete);
+
+        TreeNode* obj_import_stream = new TreeNode("Root Node");
+        QXmlStreamReader reader(dom_doc.toByteArray());
+        QVERIFY(reader.readNextStartElement());
+        QCOMPARE(reader.name().toString(),QString("QtilitiesTesting"));
+        import_list.clear();
+        QCOMPARE(obj_import_stream->importXmlStream(&reader,import_list),IExportable::Complete);
+        QVERIFY(!reader.hasError());
+
+        // Exporting the imported trees again must produce the original export:
+        QList<TreeNode*> imported_trees;
+        imported_trees << obj_import_dom << obj_import_stream;
+        foreach (TreeNode* imported_tree, imported_trees) {
+            QCOMPARE(imported_tree->subjectCount(),obj_source->subjectCount());
+            QCOMPARE(imported_tree->treeCount(),obj_source->treeCount());
+            QCOMPARE(imported_tree->subjectCategories().count(),obj_source->subjectCategories().count());
+
+            QDomDocument readback_doc("QtilitiesTesting");
+            QDomElement readback_root = readback_doc.createElement("QtilitiesTesting");
+            readback_doc.appendChild(readback_root);
+            QCOMPARE(imported_tree->exportXmlExt(&readback_doc,&readback_root,ObserverData::ExportData),IExportable::Complete);
+            QDomDocument expected_doc("QtilitiesTesting");
+            QDomElement expected_root = expected_doc.createElement("QtilitiesTesting");
+            expected_doc.appendChild(expected_root);
+            QCOMPARE(obj_source->exportXmlExt(&expected_doc,&expected_root,ObserverData::ExportData),IExportable::Complete);
+            QVERIFY2(qti_private_CompareElements(expected_root,readback_root,&mismatch),qPrintable(mismatch));
+
+            QDomDocument readback_stream_doc;
+            QVERIFY(readback_stream_doc.setContent(qti_private_ExportXmlStream(imported_tree,ObserverData::ExportData)));
+            QVERIFY2(qti_private_CompareElements(expected_root,readback_stream_doc.documentElement(),&mismatch),qPrintable(mismatch));
+        }
+
+        delete obj_import_dom;
+        delete obj_import_stream;
+    }
+
+    delete obj_source;
+}
@@ -83,6 +83,25 @@ namespace Qtilities {
             // --------------------------------------------------------------------
             void testObserverHints_w1_1_r1_1();
 
+            // --------------------------------------------------------------------
+            // Test Qtilities_1_5 against Qtilities_1_5
+            // That is, exported with Qtilities_1_5 and imported with Qtilities_1_5
+            //
+            // We only test the classes for which the exporting changed.
+            // --------------------------------------------------------------------
+            void testObserver_w1_5_r1_5();
+
+            // --------------------------------------------------------------------
+            // Test that parallel exports produce the same output as serial exports.
+            // --------------------------------------------------------------------
+            void testObserverParallelExport();
+
+            // --------------------------------------------------------------------
+            // Test that streaming XML exports produce the same elements, in the same
+            // order, as DOM exports and that both can be imported by either import.
+            // --------------------------------------------------------------------
+            void testObserverXmlStream();
+
         private:
             void genericTest(IExportable* obj_source,IExportable* obj_import_binary,IExportable* obj_import_xml,Qtilities::ExportVersion write_version, Qtilities::ExportVersion read_version, const QString& file_name);
         };
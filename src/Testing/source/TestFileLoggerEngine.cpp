@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestFileLoggerEngine.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+#include <LoggerEngines>
+using namespace Qtilities::Logging;
+
+namespace {
+    // Returns the path of an empty directory in which the log files of a test are created.
+    QString qti_private_CleanLogDir(const QString& dir_name) {
+        QDir dir(QDir::tempPath() + "/" + dir_name);
+        if (dir.exists()) {
+            foreach (const QString& entry, dir.entryList(QDir::Files))
+                dir.remove(entry);
+        } else
+            dir.mkpath(dir.absolutePath());
+        return dir.absolutePath();
+    }
+
+    // Returns the contents of file_name, or an empty array if it can't be read.
+    QByteArray qti_private_ReadFile(const QString& file_name) {
+        QFile file(file_name);
+        if (!file.open(QIODevice::ReadOnly))
+            return QByteArray();
+        return file.readAll();
+    }
+
+    // Returns a log message of 100 characters.
+    QString qti_private_LogMessage(int number) {
+        return QString("Message %1 ").arg(number).leftJustified(100,'x');
+    }
+}
+
+int Qtilities::Testing::TestFileLoggerEngine::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestFileLoggerEngine::testSizeRotation() {
+    const QString file_name = qti_private_CleanLogDir("qtilities_file_logger_size") + "/rotation.log";
+
+    FileLoggerEngine* engine = new FileLoggerEngine;
+    engine->setFileName(file_name);
+    engine->setRotationSize(256);
+    engine->setArchiveNaming(FileLoggerEngine::NumberedArchives);
+    engine->setArchiveCompressionEnabled(false);
+    engine->setArchiveRetentionCount(2);
+    QVERIFY(engine->rotationEnabled());
+    QVERIFY(engine->initialize());
+
+    // Every segment holds a few messages, thus more segments are rotated than the retention count allows:
+    for (int i = 0; i < 10; ++i)
+        engine->logMessage(qti_private_LogMessage(i),Logger::Info);
+    // Finalizing waits until all rotated segments are archived:
+    engine->finalize();
+
+    QVERIFY(QFile::exists(file_name + ".1"));
+    QVERIFY(QFile::exists(file_name + ".2"));
+    QVERIFY(!QFile::exists(file_name + ".3"));
+    QByteArray contents = qti_private_ReadFile(file_name);
+    QVERIFY(contents.contains(qti_private_LogMessage(9).toUtf8()));
+    QVERIFY(!contents.contains(qti_private_LogMessage(0).toUtf8()));
+    QVERIFY(QDir(QFileInfo(file_name).path()).entryList(QStringList() << "*.pending",QDir::Files).isEmpty());
+
+    // The log file of the previous session becomes the newest archive when the engine is initialized again:
+    QVERIFY(engine->initialize());
+    engine->finalize();
+    contents = qti_private_ReadFile(file_name + ".1");
+    QVERIFY(contents.contains(qti_private_LogMessage(9).toUtf8()));
+    QVERIFY(!qti_private_ReadFile(file_name).contains(qti_private_LogMessage(9).toUtf8()));
+    QVERIFY(!QFile::exists(file_name + ".3"));
+
+    delete engine;
+}
+
+void Qtilities::Testing::TestFileLoggerEngine::testCompressedDatedArchives() {
+    const QString log_dir = qti_private_CleanLogDir("qtilities_file_logger_dated");
+    const QString file_name = log_dir + "/dated.log";
+
+    FileLoggerEngine* engine = new FileLoggerEngine;
+    engine->setFileName(file_name);
+    engine->setRotationInterval(FileLoggerEngine::DailyRotation);
+    engine->setArchiveNaming(FileLoggerEngine::DatedArchives);
+    engine->setArchiveCompressionEnabled(true);
+    QVERIFY(engine->initialize());
+
+    engine->logMessage(qti_private_LogMessage(0),Logger::Info);
+    engine->rotate();
+    engine->logMessage(qti_private_LogMessage(1),Logger::Info);
+    engine->rotate();
+    engine->logMessage(qti_private_LogMessage(2),Logger::Info);
+    engine->finalize();
+
+    // Both rotated segments are compressed, segments started within the same second get unique names:
+    QStringList archives = QDir(log_dir).entryList(QStringList() << "dated.log.*",QDir::Files,QDir::Name);
+    QCOMPARE(archives.count(), 2);
+    QRegExp archive_pattern("dated\\.log\\.\\d{8}-\\d{6}(-\\d+)?\\.gz");
+    foreach (const QString& archive, archives) {
+        QVERIFY(archive_pattern.exactMatch(archive));
+        const QByteArray compressed = qti_private_ReadFile(log_dir + "/" + archive);
+        QVERIFY(compressed.size() > 2);
+        QCOMPARE((unsigned char) compressed.at(0), (unsigned char) 0x1f);
+        QCOMPARE((unsigned char) compressed.at(1), (unsigned char) 0x8b);
+    }
+
+    // Only the last segment remains in the log file:
+    const QByteArray contents = qti_private_ReadFile(file_name);
+    QVERIFY(contents.contains(qti_private_LogMessage(2).toUtf8()));
+    QVERIFY(!contents.contains(qti_private_LogMessage(1).toUtf8()));
+
+    delete engine;
+}
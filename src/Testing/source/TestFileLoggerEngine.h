@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_FILE_LOGGER_ENGINE_H
+#define TEST_FILE_LOGGER_ENGINE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Logging::FileLoggerEngine log rotation.
+        class TESTING_SHARED_EXPORT TestFileLoggerEngine: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("FileLoggerEngine"); }
+
+        private slots:
+            //! Tests size based rotation into numbered archives, the retention count and archiving the log file of a previous session.
+            void testSizeRotation();
+            //! Tests that explicitly rotated segments are archived into dated, compressed archives.
+            void testCompressedDatedArchives();
+        };
+    }
+}
+
+#endif // TEST_FILE_LOGGER_ENGINE_H
@@ -45,3 +45,22 @@ void Qtilities::Testing::TestFileSetInfo::testGetHash() {
     int hash2 = fsi.fileSetHash();
     QVERIFY(hash1 != hash2);
 }
+
+void Qtilities::Testing::TestFileSetInfo::testFileHash() {
+    QString file_name_a = QApplication::applicationDirPath() + "/test_hash_a.txt";
+    QString file_name_b = QApplication::applicationDirPath() + "/test_hash_b.txt";
+    QVERIFY(FileUtils::writeTextFile(file_name_a,"a"));
+    QVERIFY(FileUtils::writeTextFile(file_name_b,"b"));
+
+    // Known XXH64 value for "a":
+    bool ok;
+    QCOMPARE(FileUtils::fileHash(file_name_a,FileUtils::FastHash,&ok).toHex(),QByteArray("d24ec4f1a98c6e5b"));
+    QVERIFY(ok);
+    QVERIFY(!FileUtils::compareFiles(file_name_a,file_name_b));
+    QVERIFY(FileUtils::compareFiles(file_name_a,file_name_a));
+
+    QMap<QString,QByteArray> hashes = FileUtils::fileHashes(QStringList() << file_name_a << file_name_b);
+    QCOMPARE(hashes.count(),2);
+    QCOMPARE(hashes.value(file_name_a),FileUtils::fileHash(file_name_a));
+    QVERIFY(hashes.value(file_name_a) != hashes.value(file_name_b));
+}
@@ -42,6 +42,7 @@ namespace Qtilities {
 
         private slots:
             void testGetHash();
+            void testFileHash();
         };
     }
 }
@@ -0,0 +1,154 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestFileSystemStatCache.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include "../../CoreGui/source/FileSystemStatCache_p.h"
+
+#include <QThread>
+
+namespace {
+    QString qti_private_TestPath() {
+        return QtilitiesApplication::applicationSessionPath() + "/TestFileSystemStatCache";
+    }
+
+    // Queries the cache repeatedly from a thread other than the one the cache lives in:
+    class FileSystemStatCacheQueryThread : public QThread {
+    public:
+        FileSystemStatCacheQueryThread(FileSystemStatCache* cache, const QStringList& existing_paths, const QStringList& missing_paths) :
+            cache(cache),
+            existing_paths(existing_paths),
+            missing_paths(missing_paths),
+            wrong_results(0) {}
+
+        FileSystemStatCache* cache;
+        QStringList existing_paths;
+        QStringList missing_paths;
+        int wrong_results;
+
+    protected:
+        void run() {
+            for (int i = 0; i < 200; ++i) {
+                foreach (const QString& path, existing_paths) {
+                    if (!cache->exists(path))
+                        ++wrong_results;
+                }
+                foreach (const QString& path, missing_paths) {
+                    if (cache->exists(path))
+                        ++wrong_results;
+                }
+            }
+        }
+    };
+}
+
+int Qtilities::Testing::TestFileSystemStatCache::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestFileSystemStatCache::testInvalidate() {
+    const QString dir_path = qti_private_TestPath() + "/Invalidate";
+    const QString file_path = dir_path + "/file.txt";
+    FileUtils::removeDir(dir_path);
+    QVERIFY(QDir().mkpath(dir_path));
+
+    FileSystemStatCache cache;
+    QVERIFY(cache.exists(dir_path));
+    QVERIFY(cache.isDir(dir_path));
+    QVERIFY(!cache.exists(file_path));
+    QVERIFY(!cache.isDir(file_path));
+    QVERIFY(!cache.exists(QString()));
+
+    // Files we create ourselves are visible as soon as their entries are invalidated, without waiting for the directory change:
+    QVERIFY(FileUtils::writeTextFile(file_path,"Test"));
+    cache.invalidate(file_path);
+    QVERIFY(cache.exists(file_path));
+    QVERIFY(!cache.isDir(file_path));
+
+    // Different spellings of the same path use the same entry:
+    QVERIFY(QFile::remove(file_path));
+    cache.invalidate(dir_path + "/./file.txt");
+    QVERIFY(!cache.exists(file_path));
+
+    FileUtils::removeDir(dir_path);
+}
+
+void Qtilities::Testing::TestFileSystemStatCache::testDirectoryChanged() {
+    const QString dir_path = qti_private_TestPath() + "/DirectoryChanged";
+    const QString file_path = dir_path + "/file.txt";
+    FileUtils::removeDir(dir_path);
+    QVERIFY(QDir().mkpath(dir_path));
+
+    FileSystemStatCache cache;
+    QVERIFY(!cache.exists(file_path));
+
+    // The change is picked up once the platform reports it, give it a few seconds:
+    QVERIFY(FileUtils::writeTextFile(file_path,"Test"));
+    for (int i = 0; i < 50 && !cache.exists(file_path); ++i)
+        QTest::qWait(100);
+    QVERIFY(cache.exists(file_path));
+
+    QVERIFY(QFile::remove(file_path));
+    for (int i = 0; i < 50 && cache.exists(file_path); ++i)
+        QTest::qWait(100);
+    QVERIFY(!cache.exists(file_path));
+
+    FileUtils::removeDir(dir_path);
+}
+
+void Qtilities::Testing::TestFileSystemStatCache::testThreadedQueries() {
+    const QString dir_path = qti_private_TestPath() + "/Threads";
+    FileUtils::removeDir(dir_path);
+    QVERIFY(QDir().mkpath(dir_path));
+    QStringList existing_paths;
+    QStringList missing_paths;
+    for (int i = 0; i < 20; ++i) {
+        existing_paths << QString("%1/existing_%2.txt").arg(dir_path).arg(i);
+        QVERIFY(FileUtils::writeTextFile(existing_paths.last(),"Test"));
+        missing_paths << QString("%1/missing_%2.txt").arg(dir_path).arg(i);
+    }
+
+    // Other threads read the entries cached by this thread, while this thread keeps adding and dropping them:
+    FileSystemStatCache cache;
+    QList<FileSystemStatCacheQueryThread*> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads << new FileSystemStatCacheQueryThread(&cache,existing_paths,missing_paths);
+        threads.last()->start();
+    }
+    int wrong_results = 0;
+    for (int i = 0; i < 200; ++i) {
+        foreach (const QString& path, existing_paths) {
+            if (!cache.exists(path))
+                ++wrong_results;
+            if (i % 2 == 0)
+                cache.invalidate(path);
+        }
+        foreach (const QString& path, missing_paths) {
+            if (cache.exists(path))
+                ++wrong_results;
+        }
+    }
+    foreach (FileSystemStatCacheQueryThread* thread, threads) {
+        thread->wait();
+        wrong_results += thread->wrong_results;
+    }
+    qDeleteAll(threads);
+    QCOMPARE(wrong_results,0);
+
+    // The shared instance is created once:
+    QVERIFY(FileSystemStatCache::instance());
+    QCOMPARE(FileSystemStatCache::instance(),FileSystemStatCache::instance());
+
+    FileUtils::removeDir(dir_path);
+}
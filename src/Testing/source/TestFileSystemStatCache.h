@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_FILE_SYSTEM_STAT_CACHE_H
+#define TEST_FILE_SYSTEM_STAT_CACHE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of the internal Qtilities::CoreGui::FileSystemStatCache class.
+        class TESTING_SHARED_EXPORT TestFileSystemStatCache: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("FileSystemStatCache"); }
+
+        private slots:
+            //! Tests exists() and isDir() on files and directories, and invalidating entries.
+            void testInvalidate();
+            //! Tests that entries are dropped when their directory changes.
+            void testDirectoryChanged();
+            //! Tests querying and invalidating the cache from multiple threads at the same time.
+            void testThreadedQueries();
+        };
+    }
+}
+
+#endif // TEST_FILE_SYSTEM_STAT_CACHE_H
@@ -19,6 +19,14 @@
 #include <QtilitiesCoreGui>
 using namespace QtilitiesCoreGui;
 
+#include <QEventLoop>
+#include <QThread>
+
+namespace {
+    //! The argument which is passed to child processes, followed by the name of the test to run.
+    const char* const qti_private_CHILD_TEST_ARGUMENT = "-qti-test";
+}
+
 struct Qtilities::Testing::TestFrontendPrivateData {
     ObserverWidget          tests_observer_widget;
     ActivityPolicyFilter*   tests_activity_filter;
@@ -33,6 +41,21 @@ struct Qtilities::Testing::TestFrontendPrivateData {
     QAction*                actionInvertSelection;
     QAction*                actionSetAllActive;
     QAction*                actionSetAllInactive;
+
+    //! See setParallelExecution().
+    bool                    parallel_execution;
+    //! See setMaximumProcessCount().
+    int                     maximum_process_count;
+    //! The name of the test to run when started as a child process, empty otherwise.
+    QString                 child_test_name;
+    //! The tests waiting for a child process during parallel execution.
+    QList<QPointer<QObject> > pending_tests;
+    //! The running child processes and their tests.
+    QHash<QProcess*,QPointer<QObject> > running_tests;
+    //! Runs until all child processes finished.
+    QEventLoop*             process_loop;
+    //! The number of tests executed, used to show the progress of parallel execution.
+    int                     test_count;
 };
 
 Qtilities::Testing::TestFrontend::TestFrontend(int argc, char ** argv, QWidget *parent) :
@@ -46,6 +69,14 @@ Qtilities::Testing::TestFrontend::TestFrontend(int argc, char ** argv, QWidget *
     d->error_count = 0;
     d->success_count = 0;
     d->multiple_tests = false;
+    d->parallel_execution = false;
+    d->maximum_process_count = qMax(1,QThread::idealThreadCount());
+    d->process_loop = 0;
+    d->test_count = 0;
+    for (int i = 0; i < argc - 1; ++i) {
+        if (qstrcmp(argv[i],qti_private_CHILD_TEST_ARGUMENT) == 0)
+            d->child_test_name = QString::fromLocal8Bit(argv[i+1]);
+    }
     setWindowTitle(tr("Application Tester"));
 
     d->tests_activity_filter = d->tests_observer.enableActivityControl(ObserverHints::CheckboxActivityDisplay,ObserverHints::CheckboxTriggered);
@@ -108,6 +139,41 @@ int Testing::TestFrontend::numberOfFailedTests() const {
     return d->error_count;
 }
 
+void Qtilities::Testing::TestFrontend::setParallelExecution(bool parallel) {
+    d->parallel_execution = parallel;
+    ui->chkParallelExecution->setChecked(parallel);
+}
+
+bool Qtilities::Testing::TestFrontend::parallelExecution() const {
+    return d->parallel_execution;
+}
+
+void Qtilities::Testing::TestFrontend::setMaximumProcessCount(int count) {
+    d->maximum_process_count = qMax(1,count);
+}
+
+int Qtilities::Testing::TestFrontend::maximumProcessCount() const {
+    return d->maximum_process_count;
+}
+
+bool Qtilities::Testing::TestFrontend::isChildProcess() const {
+    return !d->child_test_name.isEmpty();
+}
+
+int Qtilities::Testing::TestFrontend::executeChildProcess() {
+    for (int i = 0; i < d->tests_observer.subjectCount(); ++i) {
+        QObject* obj = d->tests_observer.subjectAt(i);
+        ITestable* test = qobject_cast<ITestable*> (obj);
+        if (test && obj->objectName() == d->child_test_name) {
+            // The child test argument is not passed on, QTest does not know it:
+            return test->execTest(1,d->argv);
+        }
+    }
+
+    fprintf(stderr,"No registered test is named \"%s\".\n",qPrintable(d->child_test_name));
+    return -1;
+}
+
 void Qtilities::Testing::TestFrontend::on_btnExecute_clicked() {
     d->success_count = 0;
     d->error_count = 0;
@@ -131,20 +197,10 @@ void Qtilities::Testing::TestFrontend::on_btnExecute_clicked() {
 
     // Execute the tests:
     QList<QObject*> active_tests = d->tests_activity_filter->activeSubjects();
-    for (int i = 0; i < active_tests.count(); ++i) {
-        ITestable* test = qobject_cast<ITestable*> (active_tests.at(i));
-        if (test) {
-            if (test->execTest(d->argc,d->argv) == 0) {
-                SharedProperty property(qti_prop_DECORATION,QVariant(QIcon(qti_icon_SUCCESS_12x12)));
-                ObjectManager::setSharedProperty(active_tests.at(i), property);
-                ++d->success_count;
-            } else {
-                SharedProperty property(qti_prop_DECORATION,QVariant(QIcon(qti_icon_ERROR_12x12)));
-                ObjectManager::setSharedProperty(active_tests.at(i), property);
-                ++d->error_count;
-            }
-        }
-    }
+    if (d->parallel_execution)
+        executeInChildProcesses(active_tests);
+    else
+        executeInProcess(active_tests);
 
     QApplication::restoreOverrideCursor();
     time(&end);
@@ -153,6 +209,109 @@ void Qtilities::Testing::TestFrontend::on_btnExecute_clicked() {
     d->multiple_tests = true;
 }
 
+void Qtilities::Testing::TestFrontend::on_chkParallelExecution_toggled(bool checked) {
+    d->parallel_execution = checked;
+}
+
+void Qtilities::Testing::TestFrontend::executeInProcess(const QList<QObject*>& active_tests) {
+    for (int i = 0; i < active_tests.count(); ++i) {
+        ITestable* test = qobject_cast<ITestable*> (active_tests.at(i));
+        if (test)
+            recordTestResult(active_tests.at(i),test->execTest(d->argc,d->argv) == 0);
+    }
+}
+
+void Qtilities::Testing::TestFrontend::executeInChildProcesses(const QList<QObject*>& active_tests) {
+    d->pending_tests.clear();
+    for (int i = 0; i < active_tests.count(); ++i) {
+        if (qobject_cast<ITestable*> (active_tests.at(i)))
+            d->pending_tests << active_tests.at(i);
+    }
+    d->test_count = d->pending_tests.count();
+    if (d->test_count == 0)
+        return;
+
+    // The event loop runs while the processes run, thus tests can't be started again before they finished:
+    ui->btnExecute->setEnabled(false);
+    QEventLoop process_loop;
+    d->process_loop = &process_loop;
+    startPendingTestProcesses();
+    // Processes which could not be started finish immediately:
+    if (!d->running_tests.isEmpty())
+        process_loop.exec();
+    d->process_loop = 0;
+    ui->btnExecute->setEnabled(true);
+}
+
+void Qtilities::Testing::TestFrontend::startPendingTestProcesses() {
+    while (!d->pending_tests.isEmpty() && d->running_tests.count() < d->maximum_process_count) {
+        QPointer<QObject> test = d->pending_tests.takeFirst();
+        if (!test) {
+            --d->test_count;
+            continue;
+        }
+
+        QProcess* process = new QProcess(this);
+        process->setProcessChannelMode(QProcess::MergedChannels);
+        connect(process,SIGNAL(finished(int,QProcess::ExitStatus)),SLOT(handleTestProcessFinished(int,QProcess::ExitStatus)));
+        connect(process,SIGNAL(error(QProcess::ProcessError)),SLOT(handleTestProcessError(QProcess::ProcessError)));
+        d->running_tests[process] = test;
+        process->start(QCoreApplication::applicationFilePath(),QStringList() << QLatin1String(qti_private_CHILD_TEST_ARGUMENT) << test->objectName());
+    }
+
+    if (d->running_tests.isEmpty() && d->process_loop)
+        d->process_loop->quit();
+}
+
+void Qtilities::Testing::TestFrontend::handleTestProcessFinished(int exit_code, QProcess::ExitStatus exit_status) {
+    QProcess* process = qobject_cast<QProcess*> (sender());
+    if (process)
+        finishTestProcess(process,exit_status == QProcess::NormalExit && exit_code == 0);
+}
+
+void Qtilities::Testing::TestFrontend::handleTestProcessError(QProcess::ProcessError error) {
+    // Processes which crashed also emit finished(), processes which could not be started do not:
+    QProcess* process = qobject_cast<QProcess*> (sender());
+    if (process && error == QProcess::FailedToStart)
+        finishTestProcess(process,false);
+}
+
+void Qtilities::Testing::TestFrontend::finishTestProcess(QProcess* process, bool passed) {
+    if (!d->running_tests.contains(process))
+        return;
+
+    QPointer<QObject> test = d->running_tests.take(process);
+    QString test_name = test ? test->objectName() : QString();
+
+    // The output of each test is written in one block so that the output of tests running at the same time is not interleaved:
+    QByteArray output = process->readAll();
+    if (process->error() == QProcess::FailedToStart)
+        output = QString("Failed to start the test process: %1\n").arg(process->errorString()).toLocal8Bit();
+    else if (process->exitStatus() == QProcess::CrashExit)
+        output.append("The test process crashed.\n");
+    fprintf(stdout,"********* %s (child process) *********\n%s",qPrintable(test_name),output.constData());
+    fflush(stdout);
+    process->deleteLater();
+
+    if (test)
+        recordTestResult(test,passed);
+    ui->txtResults->setText(QString(tr("Testing in progress: %1 of %2 tests completed...")).arg(d->success_count + d->error_count).arg(d->test_count));
+
+    startPendingTestProcesses();
+}
+
+void Qtilities::Testing::TestFrontend::recordTestResult(QObject* test, bool passed) {
+    if (passed) {
+        SharedProperty property(qti_prop_DECORATION,QVariant(QIcon(qti_icon_SUCCESS_12x12)));
+        ObjectManager::setSharedProperty(test, property);
+        ++d->success_count;
+    } else {
+        SharedProperty property(qti_prop_DECORATION,QVariant(QIcon(qti_icon_ERROR_12x12)));
+        ObjectManager::setSharedProperty(test, property);
+        ++d->error_count;
+    }
+}
+
 void Qtilities::Testing::TestFrontend::on_btnShowLog_clicked()
 {
     if (!d->log_widget) {
@@ -13,6 +13,7 @@
 #define TESTFRONTEND_H
 
 #include <QWidget>
+#include <QProcess>
 
 #include <Observer>
 #include <QtilitiesCategory>
@@ -81,6 +82,23 @@ testFrontend.show();
 
         \image html class_testfrontend_screenshot.jpg "Test Frontend With Some Tests"
 
+        \section testfrontend_parallel Parallel execution
+
+        Tests share the global %Qtilities objects, for example OBJECT_MANAGER and the logger, thus tests can't run at the same time in a single process. When
+        parallel execution is enabled using setParallelExecution(), every active test is run in its own child process instead, with up to maximumProcessCount()
+        processes at the same time. The child processes run the application again with the \p -qti-test argument followed by the name of the test. The application
+        must check for this using isChildProcess() after registering its tests, and run the requested test using executeChildProcess():
+
+\code
+if (testFrontend.isChildProcess())
+    return testFrontend.executeChildProcess();
+testFrontend.setParallelExecution(true);
+testFrontend.show();
+\endcode
+
+        The output of each child process is written to the standard output of the front-end in one block when the process finishes, prefixed with the name
+        of its test, and the results are merged in the front-end as the processes finish.
+
         <i>This class was added in %Qtilities v1.0.</i>
           */
         class TESTING_SHARED_EXPORT TestFrontend : public QWidget
@@ -100,11 +118,60 @@ testFrontend.show();
             //! Returns the number of tests with errors from the last on_btnExecute_clicked() call.
             int numberOfFailedTests() const;
 
+            //! Sets if the active tests are executed in parallel child processes. False by default.
+            /*!
+              \sa \ref testfrontend_parallel
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setParallelExecution(bool parallel);
+            //! Indicates if the active tests are executed in parallel child processes.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool parallelExecution() const;
+            //! Sets the maximum number of child processes running at the same time during parallel execution. QThread::idealThreadCount() by default.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            void setMaximumProcessCount(int count);
+            //! Gets the maximum number of child processes running at the same time during parallel execution.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int maximumProcessCount() const;
+            //! Indicates if the application was started as a child process to run a single test, see \ref testfrontend_parallel.
+            /*!
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            bool isChildProcess() const;
+            //! Runs the test requested from a child process.
+            /*!
+              \returns The exit code of the test, or -1 when no registered test has the requested name.
+
+              <i>This function was added in %Qtilities v1.5.</i>
+              */
+            int executeChildProcess();
+
         private slots:
             void on_btnExecute_clicked();
             void on_btnShowLog_clicked();
+            void on_chkParallelExecution_toggled(bool checked);
+            void handleTestProcessFinished(int exit_code, QProcess::ExitStatus exit_status);
+            void handleTestProcessError(QProcess::ProcessError error);
 
         private:
+            //! Runs the active tests one after another in this process.
+            void executeInProcess(const QList<QObject*>& active_tests);
+            //! Runs the active tests in child processes, returns when all processes finished.
+            void executeInChildProcesses(const QList<QObject*>& active_tests);
+            //! Starts child processes for pending tests until maximumProcessCount() processes are running.
+            void startPendingTestProcesses();
+            //! Records the result of a test and updates its decoration.
+            void recordTestResult(QObject* test, bool passed);
+            //! Handles a finished test process, \p passed indicates if the test passed.
+            void finishTestProcess(QProcess* process, bool passed);
+
             Ui::TestFrontend *ui;
             TestFrontendPrivateData* d;
         };
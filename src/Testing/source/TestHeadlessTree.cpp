@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestHeadlessTree.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QDomDocument>
+
+int Qtilities::Testing::TestHeadlessTree::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestHeadlessTree::testBuildTree() {
+    HeadlessTreeNode* root = new HeadlessTreeNode("Root");
+    HeadlessTreeNode* node = root->addNode("Node");
+    QVERIFY(node);
+    QPointer<HeadlessTreeItem> item1 = node->addItem("Item 1");
+    HeadlessTreeItem* item2 = node->addItem("Item 2",QtilitiesCategory("Category"));
+    root->addItems(QStringList() << "Item 3" << "Item 4");
+
+    QCOMPARE(root->subjectNames(), QStringList() << "Node" << "Item 3" << "Item 4");
+    QCOMPARE(node->subjectCount(), 2);
+    QVERIFY(node->displayHints());
+    QCOMPARE(node->subjectCategoryInContext(item2), QtilitiesCategory("Category"));
+    QVERIFY(node->setSubjectCategory(item1,QtilitiesCategory("Other")));
+    QCOMPARE(node->subjectNamesByCategory(QtilitiesCategory("Other")), QStringList() << "Item 1");
+    QVERIFY(!root->setSubjectCategory(item1,QtilitiesCategory("Other")));
+
+    // Formatting is kept without interpreting it:
+    HeadlessTreeFormatting formatting;
+    QVERIFY(formatting.isEmpty());
+    formatting.setAttribute("ToolTip","Item Tip");
+    QMap<QString,QString> font;
+    font["Family"] = "Arial";
+    formatting.setElement("Font",font);
+    item2->setFormatting(formatting);
+    QCOMPARE(item2->formatting().attribute("ToolTip"), QString("Item Tip"));
+    QCOMPARE(item2->formatting().element("Font").value("Family"), QString("Arial"));
+    formatting.setAttribute("ToolTip",QString());
+    QCOMPARE(formatting.attributeNames(), QStringList());
+    formatting.setElement("Font",QMap<QString,QString>());
+    QVERIFY(formatting.isEmpty());
+
+    node->addValueItems(QStringList() << "Value 1" << "Value 2");
+    QCOMPARE(node->valueItems(), QStringList() << "Value 1" << "Value 2");
+    node->clearValueItems();
+    QVERIFY(node->valueItems().isEmpty());
+
+    // Items created by the node are owned by it:
+    delete root;
+    QVERIFY(!item1);
+}
+
+void Qtilities::Testing::TestHeadlessTree::testXmlExchange() {
+    HeadlessTreeNode* source = new HeadlessTreeNode("Root Node");
+    HeadlessTreeFormatting formatting;
+    formatting.setAttribute("ToolTip","Root Tip");
+    source->setFormatting(formatting);
+    source->addValueItems(QStringList() << "Value 1" << "Value 2");
+    source->addItem("Item 1");
+    HeadlessTreeNode* child_node = source->addNode("Node 1");
+    child_node->addItem("Item 2");
+    child_node->addItem("Item 3");
+
+    QDomDocument doc("QtilitiesTesting");
+    QDomElement root = doc.createElement("QtilitiesTesting");
+    doc.appendChild(root);
+    QDomElement rootItem = doc.createElement("object_node");
+    root.appendChild(rootItem);
+    QCOMPARE(source->exportXmlExt(&doc,&rootItem,ObserverData::ExportAllItems), IExportable::Complete);
+
+    // The export is loaded by a headless node:
+    HeadlessTreeNode* headless_import = new HeadlessTreeNode("Root Node");
+    QList<QPointer<QObject> > import_list;
+    QCOMPARE(headless_import->importXml(&doc,&rootItem,import_list), IExportable::Complete);
+    QCOMPARE(headless_import->formatting().attribute("ToolTip"), QString("Root Tip"));
+    QCOMPARE(headless_import->valueItems(), source->valueItems());
+    QCOMPARE(headless_import->subjectNames(), source->subjectNames());
+    QCOMPARE(headless_import->treeCount(), source->treeCount());
+
+    // And by a GUI node, which interprets the formatting:
+    TreeNode* gui_import = new TreeNode("Root Node");
+    import_list.clear();
+    QCOMPARE(gui_import->importXml(&doc,&rootItem,import_list), IExportable::Complete);
+    QCOMPARE(gui_import->getToolTip(), QString("Root Tip"));
+    QCOMPARE(gui_import->valueItems(), source->valueItems());
+    QCOMPARE(gui_import->subjectNames(), source->subjectNames());
+    QCOMPARE(gui_import->treeCount(), source->treeCount());
+
+    delete source;
+    delete headless_import;
+    delete gui_import;
+}
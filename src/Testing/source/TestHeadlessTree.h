@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_HEADLESS_TREE_H
+#define TEST_HEADLESS_TREE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::HeadlessTreeNode and Qtilities::Core::HeadlessTreeItem.
+        class TESTING_SHARED_EXPORT TestHeadlessTree: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("HeadlessTree"); }
+
+        private slots:
+            //! Tests building a tree of headless items and nodes, including categories, value items and ownership.
+            void testBuildTree();
+            //! Tests that headless trees are exported in the format of TreeNode, thus they can be loaded by headless and GUI nodes.
+            void testXmlExchange();
+        };
+    }
+}
+
+#endif // TEST_HEADLESS_TREE_H
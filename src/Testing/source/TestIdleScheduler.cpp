@@ -0,0 +1,210 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestIdleScheduler.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QTimerEvent>
+
+namespace {
+    // A job which records its steps in a shared log, using its name:
+    class IdleSchedulerTestJob : public IdleJob {
+    public:
+        IdleSchedulerTestJob(const QString& name, int step_count, QStringList* log, int* deleted_count = 0) :
+            name(name),
+            remaining_steps(step_count),
+            log(log),
+            deleted_count(deleted_count),
+            step_msecs(0) {}
+        ~IdleSchedulerTestJob() {
+            if (deleted_count)
+                ++(*deleted_count);
+        }
+
+        bool runStep() {
+            if (log)
+                log->append(name);
+            if (step_msecs > 0) {
+                QElapsedTimer timer;
+                timer.start();
+                while (timer.elapsed() < step_msecs) {}
+            }
+            return --remaining_steps > 0;
+        }
+
+        QString name;
+        int remaining_steps;
+        QStringList* log;
+        int* deleted_count;
+        //! The time for which each step keeps the thread busy.
+        int step_msecs;
+    };
+
+    // Records the number of steps which ran when the event loop got control:
+    class IdleSchedulerStepCounter : public QObject {
+    public:
+        IdleSchedulerStepCounter(const QStringList* log) : log(log), steps_at_event(-1) {}
+
+        const QStringList* log;
+        int steps_at_event;
+
+    protected:
+        void timerEvent(QTimerEvent* event) {
+            if (steps_at_event == -1)
+                steps_at_event = log->count();
+            killTimer(event->timerId());
+        }
+    };
+}
+
+int Qtilities::Testing::TestIdleScheduler::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestIdleScheduler::testPriorities() {
+    IdleScheduler scheduler;
+    QStringList log;
+    int deleted_count = 0;
+    scheduler.schedule(new IdleSchedulerTestJob("Low",1,&log,&deleted_count),IdleScheduler::LowPriority);
+    scheduler.schedule(new IdleSchedulerTestJob("NormalA",2,&log,&deleted_count));
+    scheduler.schedule(new IdleSchedulerTestJob("NormalB",2,&log,&deleted_count));
+    scheduler.schedule(new IdleSchedulerTestJob("High",1,&log,&deleted_count),IdleScheduler::HighPriority);
+    QCOMPARE(scheduler.pendingJobCount(),4);
+
+    scheduler.runPendingJobs();
+    QCOMPARE(log,QStringList() << "High" << "NormalA" << "NormalB" << "NormalA" << "NormalB" << "Low");
+    QCOMPARE(scheduler.pendingJobCount(),0);
+    QCOMPARE(deleted_count,4);
+
+    // Jobs also run from the event loop:
+    log.clear();
+    scheduler.schedule(new IdleSchedulerTestJob("Event Loop",3,&log,&deleted_count));
+    QTest::qWait(50);
+    QCOMPARE(log,QStringList() << "Event Loop" << "Event Loop" << "Event Loop");
+    QCOMPARE(scheduler.pendingJobCount(),0);
+}
+
+void Qtilities::Testing::TestIdleScheduler::testCancel() {
+    IdleScheduler scheduler;
+    QStringList log;
+    int deleted_count = 0;
+
+    IdleSchedulerTestJob kept_job("Kept",1,&log,&deleted_count);
+    kept_job.setAutoDelete(false);
+    IdleSchedulerTestJob* cancelled_job = new IdleSchedulerTestJob("Cancelled",1,&log,&deleted_count);
+    IdleSchedulerTestJob* moved_job = new IdleSchedulerTestJob("Moved",1,&log,&deleted_count);
+    scheduler.schedule(&kept_job);
+    scheduler.schedule(cancelled_job);
+    scheduler.schedule(moved_job,IdleScheduler::LowPriority);
+    QVERIFY(scheduler.isScheduled(cancelled_job));
+
+    // Scheduling a job again changes its priority:
+    scheduler.schedule(moved_job,IdleScheduler::HighPriority);
+    QCOMPARE(scheduler.pendingJobCount(),3);
+
+    QVERIFY(scheduler.cancel(cancelled_job));
+    QCOMPARE(deleted_count,1);
+    QVERIFY(!scheduler.cancel(cancelled_job));
+    QVERIFY(scheduler.cancel(&kept_job));
+    QCOMPARE(deleted_count,1);
+    QVERIFY(!scheduler.isScheduled(&kept_job));
+
+    scheduler.runPendingJobs();
+    QCOMPARE(log,QStringList() << "Moved");
+    QCOMPARE(deleted_count,2);
+}
+
+void Qtilities::Testing::TestIdleScheduler::testScheduleInvoke() {
+    IdleScheduler scheduler;
+    QTimer timer;
+    timer.setInterval(60000);
+
+    // Calls are coalesced while they are pending:
+    QVERIFY(scheduler.scheduleInvoke(&timer,"start"));
+    QVERIFY(!scheduler.scheduleInvoke(&timer,"start"));
+    QVERIFY(scheduler.scheduleInvoke(&timer,"stop",IdleScheduler::LowPriority));
+    QCOMPARE(scheduler.pendingJobCount(),2);
+    QVERIFY(!timer.isActive());
+
+    scheduler.runPendingJobs();
+    QVERIFY(!timer.isActive());
+    QCOMPARE(scheduler.pendingJobCount(),0);
+
+    // The call can be scheduled again once it ran:
+    QVERIFY(scheduler.scheduleInvoke(&timer,"start"));
+    scheduler.runPendingJobs();
+    QVERIFY(timer.isActive());
+    timer.stop();
+
+    // Pending calls are cancelled using cancelInvokes():
+    QVERIFY(scheduler.scheduleInvoke(&timer,"start"));
+    scheduler.cancelInvokes(&timer);
+    QCOMPARE(scheduler.pendingJobCount(),0);
+    scheduler.runPendingJobs();
+    QVERIFY(!timer.isActive());
+
+    // Calls on receivers which were destroyed are dropped:
+    QTimer* deleted_timer = new QTimer;
+    QVERIFY(scheduler.scheduleInvoke(deleted_timer,"start"));
+    delete deleted_timer;
+    scheduler.runPendingJobs();
+    QCOMPARE(scheduler.pendingJobCount(),0);
+}
+
+void Qtilities::Testing::TestIdleScheduler::testFrameBudget() {
+    IdleScheduler scheduler;
+    scheduler.setFrameBudget(5);
+    QCOMPARE(scheduler.frameBudget(),5);
+
+    const int step_count = 40;
+    QStringList log;
+    IdleSchedulerTestJob* job = new IdleSchedulerTestJob("Step",step_count,&log);
+    job->step_msecs = 2;
+    scheduler.schedule(job);
+
+    IdleSchedulerStepCounter counter(&log);
+    counter.startTimer(0);
+
+    QElapsedTimer timeout;
+    timeout.start();
+    while (scheduler.pendingJobCount() > 0 && timeout.elapsed() < 10000)
+        QTest::qWait(10);
+    QCOMPARE(log.count(),step_count);
+
+    // The event loop got control while the job still had steps left:
+    QVERIFY(counter.steps_at_event >= 0);
+    QVERIFY(counter.steps_at_event < step_count);
+}
+
+void Qtilities::Testing::TestIdleScheduler::testYieldToEventLoop() {
+    IdleScheduler scheduler;
+    scheduler.setFrameBudget(1000);
+    QVERIFY(!scheduler.isYielding());
+
+    QStringList log;
+    scheduler.schedule(new IdleSchedulerTestJob("Job",1,&log));
+
+    // The first yield processes events, which does not run the job. Yields within the frame budget do nothing:
+    QVERIFY(scheduler.yieldToEventLoop());
+    QVERIFY(log.isEmpty());
+    QCOMPARE(scheduler.pendingJobCount(),1);
+    QVERIFY(!scheduler.yieldToEventLoop());
+    QVERIFY(!scheduler.isYielding());
+
+    // The job runs once control returns to the event loop:
+    QTest::qWait(50);
+    QCOMPARE(log,QStringList() << "Job");
+    QCOMPARE(scheduler.pendingJobCount(),0);
+}
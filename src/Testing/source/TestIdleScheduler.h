@@ -0,0 +1,58 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_IDLE_SCHEDULER_H
+#define TEST_IDLE_SCHEDULER_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::IdleScheduler.
+        class TESTING_SHARED_EXPORT TestIdleScheduler: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("IdleScheduler"); }
+
+        private slots:
+            //! Tests that jobs run in the order of their priorities, and that jobs with the same priority take turns.
+            void testPriorities();
+            //! Tests cancelling jobs, rescheduling them with a different priority and automatic deletion.
+            void testCancel();
+            //! Tests that pending calls made using scheduleInvoke() are coalesced and dropped when their receiver is destroyed.
+            void testScheduleInvoke();
+            //! Tests that jobs return control to the event loop once their frame budget is used.
+            void testFrameBudget();
+            //! Tests that yieldToEventLoop() is rate limited and that jobs do not run while it processes events.
+            void testYieldToEventLoop();
+        };
+    }
+}
+
+#endif // TEST_IDLE_SCHEDULER_H
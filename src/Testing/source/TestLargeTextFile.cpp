@@ -0,0 +1,169 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestLargeTextFile.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include "../../CoreGui/source/LargeTextFile_p.h"
+
+namespace {
+    QString qti_private_TestPath() {
+        return QtilitiesApplication::applicationSessionPath() + "/TestLargeTextFile";
+    }
+
+    bool qti_private_WriteFile(const QString& file_name, const QByteArray& contents) {
+        QFile file(file_name);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            return false;
+        return file.write(contents) == contents.size();
+    }
+
+    // The offsets at which the lines of contents start, computed without an index. A newline at the end does not start a new line:
+    QList<int> qti_private_LineStarts(const QByteArray& contents) {
+        QList<int> line_starts;
+        line_starts << 0;
+        for (int i = 0; i < contents.size(); ++i) {
+            if (contents.at(i) == '\n' && i + 1 < contents.size())
+                line_starts << i + 1;
+        }
+        return line_starts;
+    }
+
+    QString qti_private_ExpectedText(const QByteArray& contents, const QList<int>& line_starts, int first_line, int end_line) {
+        int start = first_line < line_starts.count() ? line_starts.at(first_line) : contents.size();
+        int end = end_line < line_starts.count() ? line_starts.at(end_line) : contents.size();
+        QString text = QString::fromUtf8(contents.mid(start,end - start));
+        text.remove(QLatin1Char('\r'));
+        return text;
+    }
+
+    QByteArray qti_private_NumberedLines(int count, const QByteArray& line_ending) {
+        QByteArray contents;
+        for (int i = 0; i < count; ++i)
+            contents += "Line " + QByteArray::number(i) + line_ending;
+        return contents;
+    }
+}
+
+int Qtilities::Testing::TestLargeTextFile::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestLargeTextFile::testLines() {
+    QFETCH(QByteArray, contents);
+
+    QVERIFY(QDir().mkpath(qti_private_TestPath()));
+    const QString file_name = qti_private_TestPath() + "/Lines.txt";
+    QVERIFY(qti_private_WriteFile(file_name,contents));
+
+    LargeTextFile file(file_name);
+    QVERIFY(file.open());
+    QCOMPARE(file.size(),(qint64) contents.size());
+    QVERIFY(!file.hasChanged());
+
+    QList<int> line_starts = qti_private_LineStarts(contents);
+    QCOMPARE(file.lineCount(),line_starts.count());
+    for (int line = 0; line < line_starts.count(); ++line) {
+        QCOMPARE(file.lineStart(line),(qint64) line_starts.at(line));
+        QCOMPARE(file.text(line,line + 1),qti_private_ExpectedText(contents,line_starts,line,line + 1));
+    }
+    QCOMPARE(file.lineStart(line_starts.count()),(qint64) contents.size());
+    QCOMPARE(file.text(0,file.lineCount()),qti_private_ExpectedText(contents,line_starts,0,line_starts.count()));
+
+    // Ranges which start and end between indexed lines:
+    int count = line_starts.count();
+    QCOMPARE(file.text(count / 3,count - count / 3),qti_private_ExpectedText(contents,line_starts,count / 3,count - count / 3));
+    QCOMPARE(file.text(count,count + 10),QString());
+
+    QVERIFY(QFile::remove(file_name));
+}
+
+void Qtilities::Testing::TestLargeTextFile::testLines_data() {
+    QTest::addColumn<QByteArray>("contents");
+
+    const int many_lines = LargeTextFile::line_index_interval * 5 + 7;
+    QTest::newRow("Empty file") << QByteArray();
+    QTest::newRow("Single newline") << QByteArray("\n");
+    QTest::newRow("No trailing newline") << QByteArray("First\nSecond\nThird");
+    QTest::newRow("Empty lines") << QByteArray("\n\n\nText\n\n");
+    QTest::newRow("CRLF line endings") << qti_private_NumberedLines(many_lines,"\r\n");
+    QTest::newRow("Many lines") << qti_private_NumberedLines(many_lines,"\n");
+    QTest::newRow("Exact multiple of index interval") << qti_private_NumberedLines(LargeTextFile::line_index_interval * 2,"\n");
+    QTest::newRow("Long lines") << QByteArray(200 * 1024,'a') + "\n" + QByteArray(100 * 1024,'b') + "\n" + qti_private_NumberedLines(many_lines,"\n") + QByteArray(70 * 1024,'c');
+    QTest::newRow("UTF-8") << QByteArray("Gr\xc3\xbc\xc3\x9f" "e\r\nNaud\xc3\xa9\n");
+}
+
+void Qtilities::Testing::TestLargeTextFile::testTruncatedFile() {
+    QVERIFY(QDir().mkpath(qti_private_TestPath()));
+    const QString file_name = qti_private_TestPath() + "/Truncated.txt";
+    QByteArray contents = qti_private_NumberedLines(LargeTextFile::line_index_interval * 10,"\n");
+    QVERIFY(qti_private_WriteFile(file_name,contents));
+
+    LargeTextFile file(file_name);
+    QVERIFY(file.open());
+    int line_count = file.lineCount();
+
+    // Truncate the file while it is open. Reads must not crash and only return what is left of the file:
+    int truncated_size = contents.size() / 2;
+    QVERIFY(QFile::resize(file_name,truncated_size));
+    QVERIFY(file.hasChanged());
+    QCOMPARE(file.text(0,line_count),QString::fromUtf8(contents.left(truncated_size)));
+    QCOMPARE(file.text(line_count - 3,line_count),QString());
+    QVERIFY(file.read(contents.size() - 10,10).isEmpty());
+    QVERIFY(file.lineStart(line_count - 1) <= file.size());
+
+    // Opening the file again indexes what is left of it:
+    LargeTextFile reopened(file_name);
+    QVERIFY(reopened.open());
+    QVERIFY(!reopened.hasChanged());
+    QCOMPARE(reopened.lineCount(),qti_private_LineStarts(contents.left(truncated_size)).count());
+
+    QVERIFY(QFile::remove(file_name));
+    QVERIFY(file.hasChanged());
+    QVERIFY(file.text(0,line_count).isEmpty());
+}
+
+void Qtilities::Testing::TestLargeTextFile::testCodeEditorLargeFileMode() {
+    QVERIFY(QDir().mkpath(qti_private_TestPath()));
+    const QString file_name = qti_private_TestPath() + "/Editor.txt";
+    QByteArray contents = qti_private_NumberedLines(5000,"\r\n");
+    QVERIFY(qti_private_WriteFile(file_name,contents));
+
+    CodeEditorWidget editor(CodeEditorWidget::ActionNoHints,CodeEditorWidget::Editor);
+    editor.setLargeFileThreshold(contents.size() + 1);
+    QVERIFY(editor.loadFile(file_name));
+    QVERIFY(!editor.isLargeFileMode());
+    QCOMPARE(editor.codeEditor()->blockCount(),5001);
+
+    // Only the first window of lines is shown in large file mode:
+    editor.setLargeFileThreshold(contents.size());
+    QVERIFY(editor.loadFile(file_name));
+    QVERIFY(editor.isLargeFileMode());
+    QVERIFY(editor.codeEditor()->isReadOnly());
+    QList<int> line_starts = qti_private_LineStarts(contents);
+    QString expected = qti_private_ExpectedText(contents,line_starts,0,2000);
+    expected.chop(1);
+    QCOMPARE(editor.codeEditor()->toPlainText(),expected);
+
+    // Loading a small file leaves large file mode:
+    const QString small_file_name = qti_private_TestPath() + "/Small.txt";
+    QVERIFY(qti_private_WriteFile(small_file_name,"Small"));
+    QVERIFY(editor.loadFile(small_file_name));
+    QVERIFY(!editor.isLargeFileMode());
+    QVERIFY(!editor.codeEditor()->isReadOnly());
+    QCOMPARE(editor.codeEditor()->toPlainText(),QString("Small"));
+
+    editor.closeFile();
+    QVERIFY(QFile::remove(file_name));
+    QVERIFY(QFile::remove(small_file_name));
+}
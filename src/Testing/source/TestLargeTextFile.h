@@ -0,0 +1,55 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_LARGE_TEXT_FILE_H
+#define TEST_LARGE_TEXT_FILE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of the internal Qtilities::CoreGui::LargeTextFile class and CodeEditorWidget's large file mode.
+        class TESTING_SHARED_EXPORT TestLargeTextFile: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("LargeTextFile"); }
+
+        private slots:
+            //! Tests the line count and the text of every line against the contents of the file.
+            void testLines();
+            void testLines_data();
+            //! Tests that reading a file which was truncated after it was opened returns less data.
+            void testTruncatedFile();
+            //! Tests that CodeEditorWidget shows a window of a file above its large file threshold.
+            void testCodeEditorLargeFileMode();
+        };
+    }
+}
+
+#endif // TEST_LARGE_TEXT_FILE_H
@@ -0,0 +1,69 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestLogTags.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+#include <SessionLogStore>
+using namespace Qtilities::Logging;
+
+int Qtilities::Testing::TestLogTags::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestLogTags::testEnabledLogTags() {
+    const Logger::MessageType previous_log_level = Log->globalLogLevel();
+    const Logger::LogTags previous_tags = Log->enabledLogTags();
+    const bool store_was_enabled = Log->sessionLogStoreEnabled();
+
+    // The session log store receives all tagged messages allowed by the global log level:
+    Log->setGlobalLogLevel(Logger::Trace);
+    if (!store_was_enabled)
+        Log->setSessionLogStoreEnabled(true,1000);
+    Log->setEnabledLogTags(Logger::TreeModelLogTag | Logger::FirstUserLogTag);
+    QCOMPARE((int) Log->enabledLogTags(), (int) (Logger::TreeModelLogTag | Logger::FirstUserLogTag));
+
+    QVERIFY(Logger::isTagLogged(Logger::TreeModelLogTag,Logger::Trace));
+    QVERIFY(Logger::isTagLogged(Logger::FirstUserLogTag,Logger::Debug));
+    QVERIFY(!Logger::isTagLogged(Logger::ObserverLogTag,Logger::Trace));
+
+    LOG_TAG_TRACE(Logger::TreeModelLogTag,"Log Tag Test Message 1");
+    LOG_TAG_TRACE(Logger::ObserverLogTag,"Log Tag Test Message 2");
+    LOG_TAG_DEBUG(Logger::FirstUserLogTag,"Log Tag Test Message 3");
+
+    // Tagged messages are subject to the global log level:
+    Log->setGlobalLogLevel(Logger::Info);
+    QVERIFY(!Logger::isTagLogged(Logger::TreeModelLogTag,Logger::Trace));
+    LOG_TAG_TRACE(Logger::TreeModelLogTag,"Log Tag Test Message 4");
+    Log->flushMessages();
+
+    LogQuery query;
+    query.text = "log tag test message";
+    QStringList messages;
+    foreach (const LogStoreEntry& entry, Log->sessionLogStore()->query(query))
+        messages << entry.message;
+    QCOMPARE(messages, QStringList() << "[Tag 16] Log Tag Test Message 3" << "[TreeModel] Log Tag Test Message 1");
+
+    Log->setEnabledLogTags(previous_tags);
+    Log->setGlobalLogLevel(previous_log_level);
+    if (!store_was_enabled)
+        Log->setSessionLogStoreEnabled(false);
+}
+
+void Qtilities::Testing::TestLogTags::testLogTagNames() {
+    QCOMPARE(Log->logTagToString(Logger::CoreLogTag), QString("Core"));
+    QCOMPARE(Log->logTagToString(Logger::TreeModelLogTag), QString("TreeModel"));
+    QCOMPARE(Log->logTagToString(Logger::LoggingLogTag), QString("Logging"));
+    QCOMPARE(Log->logTagToString(Logger::FirstUserLogTag), QString("Tag 16"));
+    QCOMPARE(Log->logTagToString((Logger::LogTag) (Logger::FirstUserLogTag << 2)), QString("Tag 18"));
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_LOG_TAGS_H
+#define TEST_LOG_TAGS_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of the tagged logging macros of Qtilities::Logging::Logger.
+        class TESTING_SHARED_EXPORT TestLogTags: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("LogTags"); }
+
+        private slots:
+            //! Tests that only tagged messages of enabled tags are logged, prefixed with the name of their tag.
+            void testEnabledLogTags();
+            //! Tests the names of the predefined and user tags.
+            void testLogTagNames();
+        };
+    }
+}
+
+#endif // TEST_LOG_TAGS_H
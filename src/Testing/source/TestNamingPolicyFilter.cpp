@@ -98,6 +98,33 @@ void Qtilities::Testing::TestNamingPolicyFilter::testRejectUniquenessResolutionP
     QCOMPARE(node.subjectCount(), 2);
 }
 
+void Qtilities::Testing::TestNamingPolicyFilter::testUniquenessAfterRenameAndDetach() {
+    TreeNode node;
+    node.enableNamingControl(ObserverHints::ReadOnlyNames,NamingPolicyFilter::ProhibitDuplicateNames,NamingPolicyFilter::Reject);
+
+    TreeItem* itemA = node.addItem("A");
+    TreeItem* itemB = node.addItem("B");
+    QCOMPARE(node.subjectCount(), 2);
+
+    // Duplicate names are case insensitive for ProhibitDuplicateNames:
+    node.addItem("b");
+    QCOMPARE(node.subjectCount(), 2);
+
+    // After renaming B, its old name must be available and its new name must be taken:
+    node.setMultiContextPropertyValue(itemB,qti_prop_NAME,QString("C"));
+    QCOMPARE(itemB->objectName(), QString("C"));
+    node.addItem("c");
+    QCOMPARE(node.subjectCount(), 2);
+    node.addItem("B");
+    QCOMPARE(node.subjectCount(), 3);
+
+    // After detaching A, its name must be available:
+    QVERIFY(node.detachSubject(itemA));
+    QCOMPARE(node.subjectCount(), 2);
+    node.addItem("A");
+    QCOMPARE(node.subjectCount(), 3);
+}
+
 void Qtilities::Testing::TestNamingPolicyFilter::testAutoRenameUniquenessResolutionPolicy() {
     TreeNode node;
     node.enableNamingControl(ObserverHints::ReadOnlyNames,NamingPolicyFilter::ProhibitDuplicateNames,NamingPolicyFilter::AutoRename);
@@ -48,6 +48,8 @@ namespace Qtilities {
             void testSetUniquenessPolicies();
             //! Tests NamingPolicyFilter::Reject for uniqueness of subject names.
             void testRejectUniquenessResolutionPolicy();
+            //! Tests that duplicate names are detected after subjects were renamed and detached.
+            void testUniquenessAfterRenameAndDetach();
             //! Tests NamingPolicyFilter::AutoRename for uniqueness of subject names.
             void testAutoRenameUniquenessResolutionPolicy();
             //! Tests NamingPolicyFilter::ResolutionPolicy for validity of subject names.
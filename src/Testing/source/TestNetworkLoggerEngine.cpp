@@ -0,0 +1,96 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestNetworkLoggerEngine.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+#include <NetworkLoggerEngine>
+using namespace Qtilities::Logging;
+
+#include <QElapsedTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+int Qtilities::Testing::TestNetworkLoggerEngine::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestNetworkLoggerEngine::testTcpGelfDelivery() {
+    QTcpServer collector;
+    QVERIFY(collector.listen(QHostAddress::LocalHost));
+
+    NetworkLoggerEngine* engine = new NetworkLoggerEngine;
+    engine->setEndpoint("127.0.0.1",collector.serverPort());
+    engine->setProtocol(NetworkLoggerEngine::TcpProtocol);
+    engine->setRecordFormat(NetworkLoggerEngine::GelfFormat);
+    engine->setFlushInterval(10);
+    QVERIFY(engine->initialize());
+
+    engine->logMessage("Network Test Message",Logger::Warning);
+
+    // Wait for the records of the worker thread, which are terminated with a null byte:
+    QByteArray received;
+    QTcpSocket* connection = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while (!received.contains('\0') && timer.elapsed() < 10000) {
+        QTest::qWait(10);
+        if (!connection && collector.hasPendingConnections())
+            connection = collector.nextPendingConnection();
+        if (connection)
+            received += connection->readAll();
+    }
+    QVERIFY(received.contains('\0'));
+
+    const QByteArray record = received.left(received.indexOf('\0'));
+    QVERIFY(record.startsWith("{\"version\":\"1.1\""));
+    QVERIFY(record.contains("\"short_message\":\"Network Test Message\""));
+    QVERIFY(record.contains("\"level\":4"));
+    QVERIFY(record.endsWith('}'));
+
+    engine->finalize();
+    QCOMPARE(engine->sentRecordCount(), (quint64) 1);
+    QCOMPARE(engine->droppedRecordCount(), (quint64) 0);
+    delete engine;
+}
+
+void Qtilities::Testing::TestNetworkLoggerEngine::testQueueLimit() {
+    // A port on which nothing is listening:
+    QTcpServer closed_collector;
+    QVERIFY(closed_collector.listen(QHostAddress::LocalHost));
+    const quint16 closed_port = closed_collector.serverPort();
+    closed_collector.close();
+
+    NetworkLoggerEngine* engine = new NetworkLoggerEngine;
+    engine->setEndpoint("127.0.0.1",closed_port);
+    engine->setQueueLimit(4096);
+    engine->setQueueFullPolicy(NetworkLoggerEngine::DropNewestRecords);
+    engine->setReconnectDelays(1000,1000);
+    QVERIFY(engine->initialize());
+
+    // Each record is larger than 256 bytes, thus the queue can not hold all of them:
+    const QString message = QString("Queued Message ").leftJustified(256,'x');
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < 100; ++i)
+        engine->logMessage(message,Logger::Info);
+    // Logging only queues records, it never waits for the network:
+    QVERIFY(timer.elapsed() < 2000);
+
+    QVERIFY(engine->queuedBytes() <= engine->queueLimit());
+    QVERIFY(engine->droppedRecordCount() > 0);
+    QCOMPARE(engine->sentRecordCount(), (quint64) 0);
+
+    engine->finalize();
+    delete engine;
+}
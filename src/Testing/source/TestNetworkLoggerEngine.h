@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_NETWORK_LOGGER_ENGINE_H
+#define TEST_NETWORK_LOGGER_ENGINE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Logging::NetworkLoggerEngine.
+        class TESTING_SHARED_EXPORT TestNetworkLoggerEngine: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("NetworkLoggerEngine"); }
+
+        private slots:
+            //! Tests that records are delivered to a TCP collector as null terminated GELF objects.
+            void testTcpGelfDelivery();
+            //! Tests that logging does not block while the collector is unreachable, and that the queue stays bounded by dropping records.
+            void testQueueLimit();
+        };
+    }
+}
+
+#endif // TEST_NETWORK_LOGGER_ENGINE_H
@@ -0,0 +1,115 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestObjectHandle.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+int Qtilities::Testing::TestObjectHandle::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestObjectHandle::testObjectHandle() {
+    ObjectHandle null_handle;
+    QVERIFY(null_handle.isNull());
+    QVERIFY(!null_handle.object());
+    QVERIFY(ObjectHandle(0).isNull());
+
+    QObject* obj = new QObject;
+    QVERIFY(OBJECT_MANAGER->findObjectHandle(obj).isNull());
+    ObjectHandle handle(obj);
+    QVERIFY(!handle.isNull());
+    QCOMPARE(handle.object(), obj);
+    QVERIFY(OBJECT_MANAGER->findObjectHandle(obj) == handle);
+
+    // All handles of an object are equal, and copies are plain values:
+    ObjectHandle second_handle(obj);
+    QVERIFY(second_handle == handle);
+    ObjectHandle copied_handle(handle.id(),handle.generation());
+    QCOMPARE(copied_handle.object(), obj);
+    QCOMPARE(qHash(copied_handle), qHash(handle));
+
+    delete obj;
+    QVERIFY(!handle.isNull());
+    QVERIFY(!handle.object());
+    QVERIFY(!copied_handle.object());
+
+    // Handles of destroyed objects never resolve to new objects, even when those use the same slot:
+    QList<QObject*> new_objects;
+    QList<ObjectHandle> new_handles;
+    for (int i = 0; i < 10; ++i) {
+        new_objects << new QObject;
+        new_handles << ObjectHandle(new_objects.last());
+    }
+    QVERIFY(!handle.object());
+    for (int i = 0; i < new_handles.count(); ++i) {
+        QVERIFY(new_handles.at(i) != handle);
+        QCOMPARE(OBJECT_MANAGER->handleObject(new_handles.at(i)), new_objects.at(i));
+    }
+    qDeleteAll(new_objects);
+}
+
+void Qtilities::Testing::TestObjectHandle::testObjectHandleList() {
+    QObject* obj1 = new QObject;
+    QObject* obj2 = new QObject;
+    QObject* obj3 = new QObject;
+
+    ObjectHandleList list(QList<QObject*>() << obj1 << 0 << obj2 << obj3);
+    QCOMPARE(list.count(), 4);
+    QVERIFY(list.at(1).isNull());
+    QCOMPARE(list.object(2), obj2);
+    QCOMPARE(list.indexOf(obj3), 3);
+    QVERIFY(list.contains(obj1));
+    QVERIFY(!list.contains(this));
+
+    // Lists constructed from guarded pointers are equal to lists constructed from plain pointers:
+    ObjectHandleList safe_list(QList<QPointer<QObject> >() << obj1 << 0 << obj2 << obj3);
+    QVERIFY(safe_list == list);
+    ObjectHandleList copied_list = list;
+    QVERIFY(copied_list == list);
+    QVERIFY(ObjectHandleList(QList<QObject*>() << obj1) != list);
+
+    delete obj2;
+    QCOMPARE(list.objects(), QList<QObject*>() << obj1 << obj3);
+    QList<QPointer<QObject> > guarded_list = list.toSafeList();
+    QCOMPARE(guarded_list.count(), 4);
+    QVERIFY(!guarded_list.at(2));
+    QCOMPARE(guarded_list.at(3).data(), obj3);
+    QCOMPARE(OBJECT_MANAGER->handleObjects(list.handles()), QList<QObject*>() << obj1 << 0 << 0 << obj3);
+
+    delete obj1;
+    delete obj3;
+    QVERIFY(list.objects().isEmpty());
+    QVERIFY(ObjectHandleList().isEmpty());
+}
+
+void Qtilities::Testing::TestObjectHandle::testActiveObjectHandles() {
+    const QString meta_type = "TestObjectHandleMetaType";
+    QObject* obj1 = new QObject;
+    QObject* obj2 = new QObject;
+
+    OBJECT_MANAGER->setMetaTypeActiveObjects(ObjectHandleList(QList<QObject*>() << obj1 << obj2),meta_type);
+    ObjectHandleList active_handles = OBJECT_MANAGER->metaTypeActiveObjectHandles(meta_type);
+    QCOMPARE(active_handles.objects(), QList<QObject*>() << obj1 << obj2);
+    QCOMPARE(OBJECT_MANAGER->metaTypeActiveObjects(meta_type).count(), 2);
+
+    // The other overloads store the same handles:
+    OBJECT_MANAGER->setMetaTypeActiveObjects(QList<QObject*>() << obj2,meta_type);
+    QVERIFY(OBJECT_MANAGER->metaTypeActiveObjectHandles(meta_type) == ObjectHandleList(QList<QObject*>() << obj2));
+
+    delete obj2;
+    QVERIFY(OBJECT_MANAGER->metaTypeActiveObjectHandles(meta_type).objects().isEmpty());
+    QVERIFY(OBJECT_MANAGER->metaTypeActiveObjectHandles("TestObjectHandleUnknownMetaType").isEmpty());
+
+    OBJECT_MANAGER->setMetaTypeActiveObjects(QList<QObject*>(),meta_type);
+    delete obj1;
+}
@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_OBJECT_HANDLE_H
+#define TEST_OBJECT_HANDLE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::ObjectHandle and Qtilities::Core::ObjectHandleList.
+        class TESTING_SHARED_EXPORT TestObjectHandle: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("ObjectHandle"); }
+
+        private slots:
+            //! Tests that handles compare by value and resolve to null once their object was destroyed, also when its slot is reused.
+            void testObjectHandle();
+            //! Tests construction, lookup and resolution of object handle lists.
+            void testObjectHandleList();
+            //! Tests active objects which are set and read back as object handles.
+            void testActiveObjectHandles();
+        };
+    }
+}
+
+#endif // TEST_OBJECT_HANDLE_H
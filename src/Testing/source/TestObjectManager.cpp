@@ -190,3 +190,186 @@ void Qtilities::Testing::TestObjectManager::testCompareDynamicPropertiesDiff() {
 void Qtilities::Testing::TestObjectManager::testMoveSubjects() {
 
 }
+
+void Qtilities::Testing::TestObjectManager::testRegisteredInterfaces() {
+    // Other tests might have registered tasks, thus we compare against the tasks found before:
+    const int initial_count = OBJECT_MANAGER->registeredInterfaces<ITask>().count();
+    QCOMPARE(OBJECT_MANAGER->registeredInterfaces("com.Qtilities.Core.ITask/1.0").count(), initial_count);
+
+    Task* task1 = new Task("Registered Task 1");
+    Task* task2 = new Task("Registered Task 2");
+    OBJECT_MANAGER->registerObject(task1);
+    OBJECT_MANAGER->registerObject(task2);
+
+    QList<ITask*> tasks = OBJECT_MANAGER->registeredInterfaces<ITask>();
+    QCOMPARE(tasks.count(), initial_count + 2);
+    QCOMPARE(tasks.at(initial_count), static_cast<ITask*> (task1));
+    QCOMPARE(tasks.at(initial_count + 1), static_cast<ITask*> (task2));
+    QCOMPARE(OBJECT_MANAGER->registeredInterfaces("com.Qtilities.Core.ITask/1.0").count(), initial_count + 2);
+
+    // Objects which do not implement the interface are not returned:
+    QObject* obj = new QObject;
+    OBJECT_MANAGER->registerObject(obj);
+    QCOMPARE(OBJECT_MANAGER->registeredInterfaces<ITask>().count(), initial_count + 2);
+
+    OBJECT_MANAGER->removeObject(task1);
+    tasks = OBJECT_MANAGER->registeredInterfaces<ITask>();
+    QCOMPARE(tasks.count(), initial_count + 1);
+    QVERIFY(!tasks.contains(task1));
+
+    delete task2;
+    QCOMPARE(OBJECT_MANAGER->registeredInterfaces<ITask>().count(), initial_count);
+    QCOMPARE(OBJECT_MANAGER->registeredInterfaces("com.Qtilities.Core.ITask/1.0").count(), initial_count);
+
+    OBJECT_MANAGER->removeObject(obj);
+    delete obj;
+    delete task1;
+}
+
+void Qtilities::Testing::TestObjectManager::testMetaTypeActiveObjectsDelta() {
+    const QString meta_type("TestMetaTypeActiveObjectsDelta");
+    QObject* obj1 = new QObject;
+    QObject* obj2 = new QObject;
+    QObject* obj3 = new QObject;
+
+    QSignalSpy changed_spy(OBJECT_MANAGER,SIGNAL(metaTypeActiveObjectsChanged(QList<QPointer<QObject> >,QString)));
+    QSignalSpy delta_spy(OBJECT_MANAGER,SIGNAL(metaTypeActiveObjectsDelta(QList<QPointer<QObject> >,QList<QPointer<QObject> >,QString)));
+
+    OBJECT_MANAGER->setMetaTypeActiveObjects(QList<QObject*>() << obj1 << obj2,meta_type);
+    QCOMPARE(changed_spy.count(), 1);
+    QCOMPARE(delta_spy.count(), 1);
+    QList<QPointer<QObject> > added = delta_spy.at(0).at(0).value<QList<QPointer<QObject> > >();
+    QList<QPointer<QObject> > removed = delta_spy.at(0).at(1).value<QList<QPointer<QObject> > >();
+    QCOMPARE(added.count(), 2);
+    QCOMPARE(removed.count(), 0);
+
+    // Setting the same objects again does not notify listeners:
+    OBJECT_MANAGER->setMetaTypeActiveObjects(QList<QObject*>() << obj1 << obj2,meta_type);
+    QCOMPARE(changed_spy.count(), 1);
+    QCOMPARE(delta_spy.count(), 1);
+
+    OBJECT_MANAGER->setMetaTypeActiveObjects(QList<QObject*>() << obj2 << obj3,meta_type);
+    QCOMPARE(changed_spy.count(), 2);
+    QCOMPARE(delta_spy.count(), 2);
+    added = delta_spy.at(1).at(0).value<QList<QPointer<QObject> > >();
+    removed = delta_spy.at(1).at(1).value<QList<QPointer<QObject> > >();
+    QCOMPARE(added.count(), 1);
+    QCOMPARE(removed.count(), 1);
+    QCOMPARE(added.front().data(), obj3);
+    QCOMPARE(removed.front().data(), obj1);
+    QCOMPARE(delta_spy.at(1).at(2).toString(), meta_type);
+
+    // A different order changes the full list, but not the delta:
+    OBJECT_MANAGER->setMetaTypeActiveObjects(QList<QObject*>() << obj3 << obj2,meta_type);
+    QCOMPARE(changed_spy.count(), 3);
+    QCOMPARE(delta_spy.count(), 2);
+
+    OBJECT_MANAGER->setMetaTypeActiveObjects(QList<QObject*>(),meta_type);
+    delete obj1;
+    delete obj2;
+    delete obj3;
+}
+
+void Qtilities::Testing::TestObjectManager::testSubscribeToInterface() {
+    ObjectManagerTestSubscriber* subscriber = new ObjectManagerTestSubscriber;
+    ObjectManagerTestSubscriber* list_subscriber = new ObjectManagerTestSubscriber;
+
+    // Methods which do not exist or which take other arguments are rejected:
+    QVERIFY(!OBJECT_MANAGER->subscribeToInterface<ITask>(0,SLOT(handleObjectAdded(QObject*))));
+    QVERIFY(!OBJECT_MANAGER->subscribeToInterface<ITask>(subscriber,SLOT(handleMissingMethod(QObject*))));
+    QVERIFY(!OBJECT_MANAGER->subscribeToInterface<ITask>(subscriber,SLOT(handleInvalidArgument(int))));
+
+    QVERIFY(OBJECT_MANAGER->subscribeToInterface<ITask>(subscriber,SLOT(handleObjectAdded(QObject*)),SLOT(handleObjectRemoved(QObject*)),false));
+    QVERIFY(OBJECT_MANAGER->subscribeToInterface("com.Qtilities.Core.ITask/1.0",list_subscriber,"handleObjectsAdded(QList<QObject*>)","handleObjectsRemoved(QList<QObject*>)",false));
+
+    // Objects which do not implement the interface are not reported:
+    QObject* obj = new QObject;
+    OBJECT_MANAGER->registerObject(obj);
+    QCOMPARE(subscriber->added_calls, 0);
+    QCOMPARE(list_subscriber->added_calls, 0);
+
+    Task* task1 = new Task("Subscribed Task 1");
+    Task* task2 = new Task("Subscribed Task 2");
+    OBJECT_MANAGER->registerObject(task1);
+    OBJECT_MANAGER->registerObject(task2);
+    QCOMPARE(subscriber->added_objects, QList<QObject*>() << task1 << task2);
+    QCOMPARE(list_subscriber->added_objects, QList<QObject*>() << task1 << task2);
+    QCOMPARE(list_subscriber->added_calls, 2);
+
+    // Removed and deleted objects are reported:
+    OBJECT_MANAGER->removeObject(task1);
+    QCOMPARE(subscriber->removed_objects, QList<QObject*>() << task1);
+    delete task2;
+    QCOMPARE(subscriber->removed_objects, QList<QObject*>() << task1 << task2);
+    QCOMPARE(list_subscriber->removed_objects, QList<QObject*>() << task1 << task2);
+    OBJECT_MANAGER->removeObject(obj);
+    QCOMPARE(subscriber->removed_calls, 2);
+
+    // Unsubscribed receivers are not notified anymore:
+    OBJECT_MANAGER->unsubscribeFromInterface("com.Qtilities.Core.ITask/1.0",subscriber);
+    OBJECT_MANAGER->registerObject(task1);
+    QCOMPARE(subscriber->added_calls, 2);
+    QCOMPARE(list_subscriber->added_calls, 3);
+
+    // Subscriptions end when their receivers are destroyed:
+    delete list_subscriber;
+    OBJECT_MANAGER->removeObject(task1);
+    QCOMPARE(subscriber->removed_calls, 2);
+
+    delete subscriber;
+    delete task1;
+    delete obj;
+}
+
+void Qtilities::Testing::TestObjectManager::testNotificationBatching() {
+    ObjectManagerTestSubscriber* batched_subscriber = new ObjectManagerTestSubscriber;
+    ObjectManagerTestSubscriber* immediate_subscriber = new ObjectManagerTestSubscriber;
+    QVERIFY(OBJECT_MANAGER->subscribeToInterface<ITask>(batched_subscriber,SLOT(handleObjectsAdded(QList<QObject*>)),SLOT(handleObjectsRemoved(QList<QObject*>))));
+    QVERIFY(OBJECT_MANAGER->subscribeToInterface<ITask>(immediate_subscriber,SLOT(handleObjectAdded(QObject*)),SLOT(handleObjectRemoved(QObject*)),false));
+
+    Task* task1 = new Task("Batched Task 1");
+    Task* task2 = new Task("Batched Task 2");
+    Task* task3 = new Task("Batched Task 3");
+
+    // Batches are nested, batched subscribers are notified once when the outer batch ends:
+    OBJECT_MANAGER->startNotificationBatch();
+    OBJECT_MANAGER->startNotificationBatch();
+    OBJECT_MANAGER->registerObject(task1);
+    OBJECT_MANAGER->registerObject(task2);
+    OBJECT_MANAGER->registerObject(task3);
+    QCOMPARE(immediate_subscriber->added_calls, 3);
+    QCOMPARE(batched_subscriber->added_calls, 0);
+
+    // Objects which are registered and removed again during the batch are not reported to batched subscribers:
+    OBJECT_MANAGER->removeObject(task3);
+    QCOMPARE(immediate_subscriber->removed_calls, 1);
+    OBJECT_MANAGER->endNotificationBatch();
+    QCOMPARE(batched_subscriber->added_calls, 0);
+    OBJECT_MANAGER->endNotificationBatch();
+    QCOMPARE(batched_subscriber->added_calls, 1);
+    QCOMPARE(batched_subscriber->added_objects, QList<QObject*>() << task1 << task2);
+    QCOMPARE(batched_subscriber->removed_calls, 0);
+
+    // Removals are batched in the same way:
+    OBJECT_MANAGER->startNotificationBatch();
+    OBJECT_MANAGER->removeObject(task1);
+    delete task2;
+    QCOMPARE(batched_subscriber->removed_calls, 0);
+    QCOMPARE(immediate_subscriber->removed_calls, 3);
+    OBJECT_MANAGER->endNotificationBatch();
+    QCOMPARE(batched_subscriber->removed_calls, 1);
+    QCOMPARE(batched_subscriber->removed_objects, QList<QObject*>() << task1 << task2);
+
+    // Pending notifications are not delivered to receivers which unsubscribed during the batch:
+    OBJECT_MANAGER->startNotificationBatch();
+    OBJECT_MANAGER->registerObject(task1);
+    OBJECT_MANAGER->unsubscribeFromInterface("com.Qtilities.Core.ITask/1.0",batched_subscriber);
+    OBJECT_MANAGER->endNotificationBatch();
+    QCOMPARE(batched_subscriber->added_calls, 1);
+
+    OBJECT_MANAGER->removeObject(task1);
+    delete batched_subscriber;
+    delete immediate_subscriber;
+    delete task1;
+    delete task3;
+}
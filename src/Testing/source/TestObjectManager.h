@@ -21,6 +21,31 @@ namespace Qtilities {
     namespace Testing {
         using namespace Interfaces;
 
+        //! Records the notifications received through the interface subscriptions tested by TestObjectManager.
+        class ObjectManagerTestSubscriber: public QObject
+        {
+            Q_OBJECT
+
+        public:
+            ObjectManagerTestSubscriber(QObject* parent = 0) : QObject(parent), added_calls(0), removed_calls(0) {}
+
+            //! The objects which were reported as added, in the order in which they were reported.
+            QList<QObject*> added_objects;
+            //! The objects which were reported as removed, in the order in which they were reported.
+            QList<QObject*> removed_objects;
+            //! The number of times an added method was called.
+            int added_calls;
+            //! The number of times a removed method was called.
+            int removed_calls;
+
+        public slots:
+            void handleObjectAdded(QObject* obj) { ++added_calls; added_objects << obj; }
+            void handleObjectRemoved(QObject* obj) { ++removed_calls; removed_objects << obj; }
+            void handleObjectsAdded(QList<QObject*> objects) { ++added_calls; added_objects << objects; }
+            void handleObjectsRemoved(QList<QObject*> objects) { ++removed_calls; removed_objects << objects; }
+            void handleInvalidArgument(int value) { Q_UNUSED(value) }
+        };
+
         //! Allows testing of Qtilities::Core::ObjectManager.
         class TESTING_SHARED_EXPORT TestObjectManager: public QObject, public ITestable
         {
@@ -49,6 +74,14 @@ namespace Qtilities {
             void testCompareDynamicPropertiesDiff();
             //! Tests moving of subjects between observers using ObjectManager::moveSubjects().
             void testMoveSubjects();
+            //! Tests that ObjectManager::registeredInterfaces() follows objects being registered, removed and deleted.
+            void testRegisteredInterfaces();
+            //! Tests that ObjectManager::setMetaTypeActiveObjects() ignores unchanged active objects and reports the objects which changed.
+            void testMetaTypeActiveObjectsDelta();
+            //! Tests that ObjectManager::subscribeToInterface() only notifies subscribers about objects implementing their interface.
+            void testSubscribeToInterface();
+            //! Tests that batched interface subscribers are notified once when the outer notification batch ends.
+            void testNotificationBatching();
         };
     }
 }
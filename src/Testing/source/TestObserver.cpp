@@ -14,6 +14,15 @@
 #include <QtilitiesCoreGui>
 using namespace QtilitiesCoreGui;
 
+namespace {
+    // Returns the selection passed to Observer::layoutChanged(), as recorded by a QSignalSpy.
+    QList<QPointer<QObject> > qti_private_SpySelection(const QVariant& argument) {
+        if (!argument.isValid())
+            return QList<QPointer<QObject> >();
+        return *static_cast<const QList<QPointer<QObject> >*>(argument.constData());
+    }
+}
+
 int Qtilities::Testing::TestObserver::execTest(int argc, char ** argv) {
     return QTest::qExec(this,argc,argv);
 }
@@ -197,6 +206,41 @@ void Qtilities::Testing::TestObserver::testOwnershipOwnedByParent() {
     LOG_INFO("TestObserver::testOwnershipOwnedByParent() end.");
 }
 
+void Qtilities::Testing::TestObserver::testSubjectMetadataInContext() {
+    Observer* observerA = new Observer("Observer A");
+    Observer* observerB = new Observer("Observer B");
+    observerA->toggleSubjectEventFiltering(false);
+
+    QObject* object1 = new QObject();
+    object1->setObjectName("Object 1");
+    observerA->attachSubject(object1,Observer::ManualOwnership);
+    observerB->attachSubject(object1,Observer::ObserverScopeOwnership);
+
+    // Ownership is shared between contexts:
+    QVERIFY(observerA->subjectOwnershipInContext(object1) == Observer::ObserverScopeOwnership);
+    QVERIFY(observerB->subjectOwnershipInContext(object1) == Observer::ObserverScopeOwnership);
+
+    // Categories are set per context through ObjectManager:
+    MultiContextProperty category_property(qti_prop_CATEGORY_MAP);
+    category_property.setValue(qVariantFromValue(QtilitiesCategory("Category A")),observerA->observerID());
+    ObjectManager::setMultiContextProperty(object1,category_property);
+    QCOMPARE(observerA->subjectCategoryInContext(object1).toString(),QString("Category A"));
+    QVERIFY(!observerB->subjectCategoryInContext(object1).isValid());
+
+    // Aliases set directly on the object are picked up by observers filtering subject events:
+    MultiContextProperty alias_property(qti_prop_ALIAS_MAP);
+    alias_property.setValue(QString("Alias B"),observerB->observerID());
+    object1->setProperty(qti_prop_ALIAS_MAP,qVariantFromValue(alias_property));
+    QCOMPARE(observerB->subjectNameInContext(object1),QString("Alias B"));
+    QCOMPARE(observerA->subjectNameInContext(object1),QString("Object 1"));
+
+    object1->setProperty(qti_prop_ALIAS_MAP,QVariant());
+    QCOMPARE(observerB->subjectNameInContext(object1),QString("Object 1"));
+
+    delete observerA;
+    delete observerB;
+}
+
 void Qtilities::Testing::TestObserver::testTreeCount() {
     // Example tree using tree node classes to simplify test:
     TreeNode* rootNode = new TreeNode("Root");
@@ -209,6 +253,20 @@ void Qtilities::Testing::TestObserver::testTreeCount() {
     parentNode2->addItem("Child 5");
 
     QCOMPARE(rootNode->treeCount(), 7);
+
+    // The count must follow changes deeper in the tree:
+    TreeNode* parentNode3 = parentNode2->addNode("Parent 3");
+    parentNode3->addItem("Child 6");
+    QCOMPARE(parentNode2->treeCount(), 5);
+    QCOMPARE(rootNode->treeCount(), 9);
+
+    // Subjects attached to more than one parent are counted once for every parent:
+    parentNode1->attachSubject(parentNode3);
+    QCOMPARE(rootNode->treeCount(), 11);
+
+    parentNode2->detachSubject(parentNode3);
+    QCOMPARE(rootNode->treeCount(), 9);
+    QCOMPARE(parentNode2->treeCount(), 3);
 }
 
 void Qtilities::Testing::TestObserver::testTreeAt() {
@@ -223,6 +281,19 @@ void Qtilities::Testing::TestObserver::testTreeAt() {
     TreeItem* item = parentNode2->addItem("Child 5");
 
     QCOMPARE(rootNode->treeAt(6), item);
+    QCOMPARE(rootNode->treeAt(0), (QObject*) parentNode1);
+    QCOMPARE(rootNode->treeAt(3), (QObject*) parentNode2);
+    QVERIFY(rootNode->treeAt(7) == 0);
+    QVERIFY(rootNode->treeAt(-1) == 0);
+
+    // Every position must match the iteration order of treeChildren():
+    TreeNode* parentNode3 = parentNode1->addNode("Parent 3");
+    parentNode3->addItem("Child 6");
+    parentNode3->addItem("Child 7");
+    QList<QObject*> children = rootNode->treeChildren();
+    QCOMPARE(children.count(), rootNode->treeCount());
+    for (int i = 0; i < children.count(); ++i)
+        QCOMPARE(rootNode->treeAt(i), children.at(i));
 }
 
 void Qtilities::Testing::TestObserver::testTreeContains() {
@@ -267,6 +338,129 @@ void Qtilities::Testing::TestObserver::testTreeChildren() {
     QCOMPARE(items_verify.count(), 5);
 }
 
+void Qtilities::Testing::TestObserver::testViewRefreshSync() {
+    Observer observer;
+    QVERIFY(!observer.viewRefreshCoalescingEnabled());
+    QSignalSpy layout_spy(&observer,SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
+    QSignalSpy data_spy(&observer,SIGNAL(dataChanged(Observer*)));
+
+    observer.refreshViewsLayout();
+    QCOMPARE(layout_spy.count(),1);
+    observer.refreshViewsData();
+    QCOMPARE(data_spy.count(),1);
+
+    // During processing cycles views are only refreshed when forced:
+    observer.startProcessingCycle();
+    observer.refreshViewsLayout();
+    observer.refreshViewsData();
+    QCOMPARE(layout_spy.count(),1);
+    QCOMPARE(data_spy.count(),1);
+    observer.refreshViewsLayout(QList<QPointer<QObject> >(),true);
+    observer.refreshViewsData(true);
+    QCOMPARE(layout_spy.count(),2);
+    QCOMPARE(data_spy.count(),2);
+    observer.endProcessingCycle(false);
+
+    // Nothing is delivered later on:
+    QCoreApplication::processEvents();
+    QCOMPARE(layout_spy.count(),2);
+    QCOMPARE(data_spy.count(),2);
+}
+
+void Qtilities::Testing::TestObserver::testViewRefreshCoalescing() {
+    qRegisterMetaType<QList<QPointer<QObject> > >("QList<QPointer<QObject> >");
+
+    Observer observer;
+    QObject* obj1 = new QObject;
+    QObject* obj2 = new QObject;
+    QVERIFY(observer.attachSubject(obj1,Observer::ObserverScopeOwnership));
+    QVERIFY(observer.attachSubject(obj2,Observer::ObserverScopeOwnership));
+    observer.toggleViewRefreshCoalescing(true);
+    QVERIFY(observer.viewRefreshCoalescingEnabled());
+    QCoreApplication::processEvents();
+
+    QSignalSpy layout_spy(&observer,SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
+    QSignalSpy data_spy(&observer,SIGNAL(dataChanged(Observer*)));
+
+    // All refreshes are delivered once when control returns to the event loop:
+    observer.refreshViewsLayout(QList<QPointer<QObject> >() << obj1);
+    observer.refreshViewsLayout(QList<QPointer<QObject> >() << obj2 << obj1);
+    observer.refreshViewsData();
+    observer.refreshViewsData();
+    QCOMPARE(layout_spy.count(),0);
+    QCOMPARE(data_spy.count(),0);
+    QCoreApplication::processEvents();
+    QCOMPARE(layout_spy.count(),1);
+    QCOMPARE(data_spy.count(),1);
+
+    // The layout change carries the union of the requested selections:
+    QList<QPointer<QObject> > selection = qti_private_SpySelection(layout_spy.at(0).at(0));
+    QCOMPARE(selection.count(),2);
+    QVERIFY(selection.contains(obj1));
+    QVERIFY(selection.contains(obj2));
+
+    // A forced refresh delivers the pending refreshes immediately:
+    observer.refreshViewsData();
+    observer.refreshViewsLayout(QList<QPointer<QObject> >(),true);
+    QCOMPARE(layout_spy.count(),2);
+    QCOMPARE(data_spy.count(),2);
+    QCoreApplication::processEvents();
+    QCOMPARE(layout_spy.count(),2);
+    QCOMPARE(data_spy.count(),2);
+
+    // Disabling coalescing delivers the pending refreshes immediately:
+    observer.refreshViewsData();
+    QCOMPARE(data_spy.count(),2);
+    observer.toggleViewRefreshCoalescing(false);
+    QCOMPARE(data_spy.count(),3);
+    observer.refreshViewsData();
+    QCOMPARE(data_spy.count(),4);
+    QCoreApplication::processEvents();
+    QCOMPARE(data_spy.count(),4);
+}
+
+void Qtilities::Testing::TestObserver::testViewRefreshDuringProcessingCycle() {
+    qRegisterMetaType<QList<QPointer<QObject> > >("QList<QPointer<QObject> >");
+
+    Observer observer;
+    QObject* obj = new QObject;
+    QVERIFY(observer.attachSubject(obj,Observer::ObserverScopeOwnership));
+    observer.toggleViewRefreshCoalescing(true);
+    QCoreApplication::processEvents();
+
+    QSignalSpy layout_spy(&observer,SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
+    QSignalSpy data_spy(&observer,SIGNAL(dataChanged(Observer*)));
+
+    // A refresh which is pending when a processing cycle starts is not delivered by handleQueuedViewRefreshes() during the cycle:
+    observer.refreshViewsLayout(QList<QPointer<QObject> >() << obj);
+    observer.startProcessingCycle();
+    QCoreApplication::processEvents();
+    QCOMPARE(layout_spy.count(),0);
+    // Refreshes requested during the cycle are ignored, the end of the cycle refreshes the views:
+    observer.refreshViewsData();
+
+    // Instead, it is delivered with the layout change at the end of the cycle:
+    observer.endProcessingCycle();
+    QCOMPARE(layout_spy.count(),1);
+    QCOMPARE(data_spy.count(),0);
+    QList<QPointer<QObject> > selection = qti_private_SpySelection(layout_spy.at(0).at(0));
+    QCOMPARE(selection.count(),1);
+    QVERIFY(selection.contains(obj));
+    QCoreApplication::processEvents();
+    QCOMPARE(layout_spy.count(),1);
+
+    // When the cycle ends without broadcasting, pending refreshes are delivered by the event loop:
+    observer.refreshViewsData();
+    observer.startProcessingCycle();
+    QCoreApplication::processEvents();
+    QCOMPARE(data_spy.count(),0);
+    observer.endProcessingCycle(false);
+    QCOMPARE(data_spy.count(),0);
+    QCoreApplication::processEvents();
+    QCOMPARE(data_spy.count(),1);
+    QCOMPARE(layout_spy.count(),1);
+}
+
 //void Qtilities::Testing::TestObserver::testCountModificationStateChanges() {
 //    TreeNode node("testCountModificationStateChangesNode");
 //    QSignalSpy spy(&node, SIGNAL(modificationStateChanged(bool)));
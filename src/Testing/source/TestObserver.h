@@ -68,6 +68,8 @@ namespace Qtilities {
             void testOwnershipObserverScope();
             //! A test which tests the different Observer::OwnedBySubjectOwnership ownership.
             void testOwnershipOwnedByParent();
+            //! Tests that subjectOwnershipInContext(), subjectCategoryInContext() and subjectNameInContext() follow property changes on subjects.
+            void testSubjectMetadataInContext();
 
             // -----------------------------
             // Tests for access function for objects in complete tree under an observer.
@@ -81,6 +83,16 @@ namespace Qtilities {
             //! A test which tests treeChildren() function.
             void testTreeChildren();
 
+            // -----------------------------
+            // View refresh tests.
+            // -----------------------------
+            //! Tests that refreshViewsLayout() and refreshViewsData() notify views immediately by default.
+            void testViewRefreshSync();
+            //! Tests that refreshes are merged into a single emission when view refresh coalescing is enabled.
+            void testViewRefreshCoalescing();
+            //! Tests coalesced refreshes which are pending while a processing cycle is active.
+            void testViewRefreshDuringProcessingCycle();
+
             // -----------------------------
             // Modification state tests.
             // -----------------------------
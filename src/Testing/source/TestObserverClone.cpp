@@ -0,0 +1,128 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestObserverClone.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+int Qtilities::Testing::TestObserverClone::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestObserverClone::testCloneTree() {
+    TreeNode* root = new TreeNode("Root");
+    root->enableCategorizedDisplay();
+    TreeNode* nodeA = root->addNode("A");
+    nodeA->enableCategorizedDisplay();
+    nodeA->addItem("A1",QtilitiesCategory("Category A"));
+    TreeItem* shared = nodeA->addItem("Shared");
+    TreeNode* nodeB = root->addNode("B");
+    nodeB->addValueItem("Value");
+    QVERIFY(nodeB->attachSubject(shared));
+    QCOMPARE(Observer::parentCount(shared), 2);
+    const int source_tree_count = root->treeCount();
+
+    bool complete = false;
+    TreeNode* clone_root = qobject_cast<TreeNode*> (root->cloneTree(&complete));
+    QVERIFY(complete);
+    QVERIFY(clone_root);
+    QVERIFY(clone_root != root);
+    QVERIFY(!clone_root->parent());
+    QCOMPARE(clone_root->objectName(), QString("Root"));
+    QCOMPARE(clone_root->subjectNames(), root->subjectNames());
+    QCOMPARE(clone_root->treeCount(), source_tree_count);
+
+    TreeNode* clone_a = qobject_cast<TreeNode*> (clone_root->subjectReference("A"));
+    TreeNode* clone_b = qobject_cast<TreeNode*> (clone_root->subjectReference("B"));
+    QVERIFY(clone_a);
+    QVERIFY(clone_b);
+    QVERIFY(clone_a != nodeA);
+    QCOMPARE(clone_a->subjectNames(), nodeA->subjectNames());
+
+    // Categories are keyed to the clone of the observer:
+    TreeItem* clone_a1 = qobject_cast<TreeItem*> (clone_a->subjectReference("A1"));
+    QVERIFY(clone_a1);
+    QCOMPARE(clone_a1->getCategory(clone_a), QtilitiesCategory("Category A"));
+    QVERIFY(clone_a->hasCategory(QtilitiesCategory("Category A")));
+
+    // Node specific data is copied in initializeClone():
+    QCOMPARE(clone_b->valueItems(), QStringList() << "Value");
+
+    // The shared subject is cloned once and attached to both clones of its parents:
+    QObject* clone_shared = clone_a->subjectReference("Shared");
+    QVERIFY(clone_shared);
+    QVERIFY(clone_shared != shared);
+    QCOMPARE(clone_b->subjectReference("Shared"), clone_shared);
+    QCOMPARE(Observer::parentCount(clone_shared), 2);
+    QCOMPARE(Observer::parentCount(shared), 2);
+
+    // The clone is independent of the source tree:
+    clone_a->addItem("Clone Only");
+    QCOMPARE(nodeA->subjectCount(), 2);
+    QPointer<QObject> guarded_clone_a1 = clone_a1;
+    delete root;
+    QVERIFY(guarded_clone_a1);
+    QCOMPARE(clone_a->subjectCount(), 3);
+    QCOMPARE(clone_root->subjectNames(), QStringList() << "A" << "B");
+
+    // Clones are owned by the scope of their observers:
+    delete clone_root;
+    QVERIFY(!guarded_clone_a1);
+}
+
+void Qtilities::Testing::TestObserverClone::testCloneSubjects() {
+    TreeNode* source = new TreeNode("Source");
+    source->enableCategorizedDisplay();
+    TreeItem* itemX = source->addItem("X",QtilitiesCategory("Category X"));
+    source->addItem("Y");
+    TreeNode* nodeZ = source->addNode("Z");
+    nodeZ->addItem("Z1");
+    TreeNode* target = new TreeNode("Target");
+    target->enableCategorizedDisplay();
+    TreeItem* not_subject = new TreeItem("Not A Subject");
+
+    bool complete = false;
+    QList<QPointer<QObject> > clones = source->cloneSubjects(target,QList<QObject*>() << itemX << nodeZ << not_subject << itemX,&complete);
+    QVERIFY(complete);
+    QCOMPARE(clones.count(), 2);
+    QVERIFY(clones.at(0));
+    QVERIFY(clones.at(1));
+    QVERIFY(clones.at(0) != itemX);
+    QCOMPARE(clones.at(0)->objectName(), QString("X"));
+    QCOMPARE(target->subjectNames(), QStringList() << "X" << "Z");
+    QCOMPARE(source->subjectNames(), QStringList() << "X" << "Y" << "Z");
+
+    // The categories of the source observer move to the target:
+    TreeItem* clone_x = qobject_cast<TreeItem*> (clones.at(0));
+    QVERIFY(clone_x);
+    QCOMPARE(clone_x->getCategory(target), QtilitiesCategory("Category X"));
+
+    // Observers are cloned with their subjects:
+    TreeNode* clone_z = qobject_cast<TreeNode*> (clones.at(1));
+    QVERIFY(clone_z);
+    QVERIFY(clone_z != nodeZ);
+    QCOMPARE(clone_z->subjectNames(), QStringList() << "Z1");
+    QVERIFY(clone_z->subjectReference("Z1") != nodeZ->subjectReference("Z1"));
+
+    // All subjects are cloned when no subjects are specified:
+    TreeNode* all_target = new TreeNode("All Target");
+    clones = source->cloneSubjects(all_target,QList<QObject*>(),&complete);
+    QVERIFY(complete);
+    QCOMPARE(clones.count(), 3);
+    QCOMPARE(all_target->subjectNames(), source->subjectNames());
+
+    delete source;
+    QCOMPARE(target->treeCount(), 3);
+    delete target;
+    delete all_target;
+    delete not_subject;
+}
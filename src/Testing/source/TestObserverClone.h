@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_OBSERVER_CLONE_H
+#define TEST_OBSERVER_CLONE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::Observer::cloneTree() and Qtilities::Core::Observer::cloneSubjects().
+        class TESTING_SHARED_EXPORT TestObserverClone: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("ObserverClone"); }
+
+        private slots:
+            //! Tests cloning of a complete tree, including shared subjects and their categories.
+            void testCloneTree();
+            //! Tests cloning of selected subjects into a different observer.
+            void testCloneSubjects();
+        };
+    }
+}
+
+#endif // TEST_OBSERVER_CLONE_H
@@ -85,3 +85,43 @@ void Qtilities::Testing::TestObserverRelationalTable::testCompare() {
     //LOG_INFO("TestObserverRelationalTable::testCompare() end:");
 }
 
+void Qtilities::Testing::TestObserverRelationalTable::testEntryLookups() {
+    TreeNode* observerA = new TreeNode("Observer A");
+    TreeNode* parentNode1 = observerA->addNode("Parent 1");
+    TreeNode* parentNode2 = observerA->addNode("Parent 2");
+    parentNode1->addItem("Child 1");
+    parentNode2->addItem("Child 2");
+    TreeItem* shared_item = parentNode2->addItem("Child 3");
+    parentNode1->addItem(shared_item);
+
+    ObserverRelationalTable table(observerA);
+    QCOMPARE(table.count(),6);
+
+    // Lookups must find the same entries as iterating over the table:
+    for (int i = 0; i < table.count(); ++i) {
+        RelationalTableEntry* entry = table.entryAt(i);
+        QVERIFY(entry);
+        QCOMPARE(table.entryWithVisitorID(entry->visitorID()),entry);
+        if (entry->sessionID() != -1)
+            QCOMPARE(table.entryWithSessionID(entry->sessionID()),entry);
+    }
+    QVERIFY(!table.entryWithVisitorID(100));
+
+    // Session ID lookups must stay valid when entries change, as happens during relationship construction:
+    RelationalTableEntry* entry = table.entryWithSessionID(parentNode2->observerID());
+    QVERIFY(entry);
+    QVERIFY(!table.entryWithPreviousSessionID(parentNode2->observerID()));
+    entry->setPreviousSessionID(entry->sessionID());
+    entry->setSessionID(parentNode2->observerID() + 1000);
+    QCOMPARE(table.entryWithPreviousSessionID(parentNode2->observerID()),entry);
+    QCOMPARE(table.entryWithSessionID(parentNode2->observerID() + 1000),entry);
+    QVERIFY(!table.entryWithSessionID(parentNode2->observerID()));
+
+    // Copies must have their own indexes:
+    ObserverRelationalTable table_copy(table);
+    QVERIFY(table_copy.compare(table));
+    QVERIFY(table_copy.entryWithVisitorID(entry->visitorID()) != entry);
+    QCOMPARE(table_copy.entryWithVisitorID(entry->visitorID())->name(),entry->name());
+
+    delete observerA;
+}
@@ -49,6 +49,8 @@ namespace Qtilities {
             void testVisitorIDs();
             //! Tests table comparison.
             void testCompare();
+            //! Tests the indexed entry lookups.
+            void testEntryLookups();
         };
     }
 }
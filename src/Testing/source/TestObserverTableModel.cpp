@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestObserverTableModel.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+namespace {
+    // Fetches all rows of model, as a view would while it scrolls:
+    void qti_private_FetchAll(QAbstractItemModel* model) {
+        while (model->canFetchMore(QModelIndex()))
+            model->fetchMore(QModelIndex());
+    }
+}
+
+int Qtilities::Testing::TestObserverTableModel::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestObserverTableModel::testChildCountRefresh() {
+    Observer observer("Table Observer");
+    observer.useDisplayHints();
+    observer.displayHints()->setItemViewColumnHint(ObserverHints::ColumnAllHints);
+    Observer* child = new Observer("Child Observer");
+    observer.attachSubject(child,Observer::ObserverScopeOwnership);
+    observer.attachSubject(new QObject,Observer::ObserverScopeOwnership);
+
+    ObserverTableModel model;
+    QVERIFY(model.setObserverContext(&observer));
+    qti_private_FetchAll(&model);
+    QCOMPARE(model.rowCount(),2);
+
+    int column = model.columnPosition(AbstractObserverItemModel::ColumnChildCount);
+    QModelIndex child_index = model.index(observer.subjectPosition(child),column);
+    QCOMPARE(model.data(child_index,Qt::DisplayRole).toInt(),0);
+
+    QSignalSpy data_changed_spy(&model,SIGNAL(dataChanged(QModelIndex,QModelIndex)));
+    child->attachSubject(new QObject,Observer::ObserverScopeOwnership);
+    child->attachSubject(new QObject,Observer::ObserverScopeOwnership);
+    QVERIFY(data_changed_spy.count() > 0);
+    QCOMPARE(model.data(child_index,Qt::DisplayRole).toInt(),2);
+
+    // Changes further down the tree are counted as well:
+    Observer* grand_child = new Observer("Grand Child Observer");
+    child->attachSubject(grand_child,Observer::ObserverScopeOwnership);
+    grand_child->attachSubject(new QObject,Observer::ObserverScopeOwnership);
+    QCOMPARE(model.data(child_index,Qt::DisplayRole).toInt(),child->treeCount());
+
+    child->detachAll();
+    QCOMPARE(model.data(child_index,Qt::DisplayRole).toInt(),0);
+}
+
+void Qtilities::Testing::TestObserverTableModel::testAccessModeRefresh() {
+    Observer observer("Table Observer");
+    observer.useDisplayHints();
+    observer.displayHints()->setItemViewColumnHint(ObserverHints::ColumnAllHints);
+    Observer* child = new Observer("Child Observer");
+    observer.attachSubject(child,Observer::ObserverScopeOwnership);
+
+    ObserverTableModel model;
+    QVERIFY(model.setObserverContext(&observer));
+    qti_private_FetchAll(&model);
+
+    QModelIndex access_index = model.index(0,model.columnPosition(AbstractObserverItemModel::ColumnAccess));
+    QVERIFY(model.data(access_index,Qt::DecorationRole).isNull());
+
+    child->setAccessMode(Observer::ReadOnlyAccess);
+    QVERIFY(!model.data(access_index,Qt::DecorationRole).isNull());
+
+    // The name column is not affected and stays cached:
+    QModelIndex name_index = model.index(0,model.columnPosition(AbstractObserverItemModel::ColumnName));
+    QCOMPARE(model.data(name_index,Qt::DisplayRole).toString(),QString("Child Observer"));
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_OBSERVER_TABLE_MODEL_H
+#define TEST_OBSERVER_TABLE_MODEL_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::CoreGui::ObserverTableModel.
+        class TESTING_SHARED_EXPORT TestObserverTableModel: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("ObserverTableModel"); }
+
+        private slots:
+            //! Tests that the cached child count of a row is refreshed when the number of subjects in its child observer changes.
+            void testChildCountRefresh();
+            //! Tests that the cached access column of a row is refreshed when the access mode of its child observer changes.
+            void testAccessModeRefresh();
+        };
+    }
+}
+
+#endif // TEST_OBSERVER_TABLE_MODEL_H
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestObserverTreeDiff.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+namespace {
+    // A tree with two child observers, of which the subjects are not owned by the observers.
+    struct ObserverTreeDiffTestTree {
+        ObserverTreeDiffTestTree() : root("Diff Root") {
+            a = new Observer("Observer A");
+            b = new Observer("Observer B");
+            root.attachSubject(a,Observer::ObserverScopeOwnership);
+            root.attachSubject(b,Observer::ObserverScopeOwnership);
+            for (int i = 0; i < 4; ++i) {
+                objects << new QObject;
+                objects.last()->setObjectName(QString("Object %1").arg(i + 1));
+            }
+            a->attachSubject(objects.at(0),Observer::ManualOwnership);
+            a->attachSubject(objects.at(1),Observer::ManualOwnership);
+            b->attachSubject(objects.at(2),Observer::ManualOwnership);
+        }
+        ~ObserverTreeDiffTestTree() {
+            root.deleteAll();
+            qDeleteAll(objects);
+        }
+
+        // Inserts object 4 into A, moves object 1 from A to B, renames object 2 in A and removes object 3 from B:
+        void edit() {
+            a->attachSubject(objects.at(3),Observer::ManualOwnership);
+            a->detachSubject(objects.at(0));
+            b->attachSubject(objects.at(0),Observer::ManualOwnership);
+            MultiContextProperty instance_names(qti_prop_ALIAS_MAP);
+            instance_names.setValue(QString("Renamed Object 2"),a->observerID());
+            ObjectManager::setMultiContextProperty(objects.at(1),instance_names);
+            b->detachSubject(objects.at(2));
+        }
+
+        Observer root;
+        Observer* a;
+        Observer* b;
+        QList<QObject*> objects;
+    };
+}
+
+int Qtilities::Testing::TestObserverTreeDiff::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestObserverTreeDiff::testCompute() {
+    ObserverTreeDiffTestTree tree;
+    ObserverSnapshot before = tree.root.treeSnapshot();
+    QVERIFY(ObserverTreeDiff::compute(before,tree.root.treeSnapshot()).isEmpty());
+
+    tree.edit();
+    ObserverTreeDiff diff = ObserverTreeDiff::compute(before,tree.root.treeSnapshot());
+    QCOMPARE(diff.count(), 4);
+
+    // Edits are ordered as they are applied:
+    ObserverTreeEdit insert = diff.editAt(0);
+    QVERIFY(insert.type == ObserverTreeEdit::InsertSubject);
+    QCOMPARE(insert.subject, tree.objects.at(3));
+    QCOMPARE(insert.observer_id, tree.a->observerID());
+    QCOMPARE(insert.ownership, (int) Observer::ManualOwnership);
+
+    // The subject detached from A and attached to B is reported as a single move:
+    ObserverTreeEdit move = diff.editAt(1);
+    QVERIFY(move.type == ObserverTreeEdit::MoveSubject);
+    QCOMPARE(move.subject, tree.objects.at(0));
+    QCOMPARE(move.source_observer_id, tree.a->observerID());
+    QCOMPARE(move.observer_id, tree.b->observerID());
+
+    ObserverTreeEdit rename = diff.editAt(2);
+    QVERIFY(rename.type == ObserverTreeEdit::RenameSubject);
+    QCOMPARE(rename.subject, tree.objects.at(1));
+    QCOMPARE(rename.old_name, QString("Object 2"));
+    QCOMPARE(rename.name, QString("Renamed Object 2"));
+
+    ObserverTreeEdit remove = diff.editAt(3);
+    QVERIFY(remove.type == ObserverTreeEdit::RemoveSubject);
+    QCOMPARE(remove.subject, tree.objects.at(2));
+    QCOMPARE(remove.observer_id, tree.b->observerID());
+}
+
+void Qtilities::Testing::TestObserverTreeDiff::testInvertedApply() {
+    ObserverTreeDiffTestTree tree;
+    ObserverSnapshot before = tree.root.treeSnapshot();
+    tree.edit();
+    ObserverSnapshot after = tree.root.treeSnapshot();
+    ObserverTreeDiff diff = ObserverTreeDiff::compute(before,after);
+
+    QString error_msg;
+    QVERIFY2(diff.inverted().apply(&error_msg),qPrintable(error_msg));
+    QVERIFY(ObserverTreeDiff::compute(before,tree.root.treeSnapshot()).isEmpty());
+    QVERIFY(tree.a->contains(tree.objects.at(0)));
+    QVERIFY(!tree.b->contains(tree.objects.at(0)));
+    QVERIFY(!tree.a->contains(tree.objects.at(3)));
+    QVERIFY(tree.b->contains(tree.objects.at(2)));
+    QCOMPARE(tree.a->subjectNameInContext(tree.objects.at(1)), QString("Object 2"));
+
+    // Applying the diff again redoes the edits:
+    QVERIFY2(diff.apply(&error_msg),qPrintable(error_msg));
+    QVERIFY(ObserverTreeDiff::compute(after,tree.root.treeSnapshot()).isEmpty());
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_OBSERVER_TREE_DIFF_H
+#define TEST_OBSERVER_TREE_DIFF_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::ObserverTreeDiff.
+        class TESTING_SHARED_EXPORT TestObserverTreeDiff: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("ObserverTreeDiff"); }
+
+        private slots:
+            //! Tests that ObserverTreeDiff::compute() reports insertions, moves, renames and removals, and nothing for unchanged trees.
+            void testCompute();
+            //! Tests that applying the inverted diff restores the tree in which the diff was computed.
+            void testInvertedApply();
+        };
+    }
+}
+
+#endif // TEST_OBSERVER_TREE_DIFF_H
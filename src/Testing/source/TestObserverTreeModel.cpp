@@ -0,0 +1,178 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestObserverTreeModel.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QElapsedTimer>
+
+namespace {
+    // Builds a tree model of root in the GUI thread, thus the model is up to date when observer changes were received:
+    void qti_private_BuildTreeModel(ObserverTreeModel* model, TreeNode* root) {
+        model->disableThreadedBuilding();
+        QSignalSpy build_spy(model,SIGNAL(treeModelBuildEnded()));
+        model->setObserverContext(root);
+        if (build_spy.isEmpty())
+            model->refresh();
+    }
+
+    // Waits until model emitted treeModelBuildEnded() count times. Returns false if the builds did not end within ten seconds.
+    bool qti_private_WaitForBuilds(const QSignalSpy& build_spy, int count) {
+        QElapsedTimer timer;
+        timer.start();
+        while (build_spy.count() < count && timer.elapsed() < 10000)
+            QTest::qWait(10);
+        return build_spy.count() >= count;
+    }
+
+    // Returns the names of all rows of model underneath parent in depth first order, prefixed with their depth.
+    // Children which are built lazily are fetched first.
+    QStringList qti_private_ModelNames(QAbstractItemModel* model, int name_column, const QModelIndex& parent = QModelIndex(), int depth = 0) {
+        if (model->canFetchMore(parent))
+            model->fetchMore(parent);
+
+        QStringList names;
+        for (int row = 0; row < model->rowCount(parent); ++row) {
+            names << QString(depth,'-') + model->index(row,name_column,parent).data().toString();
+            names << qti_private_ModelNames(model,name_column,model->index(row,0,parent),depth + 1);
+        }
+        return names;
+    }
+
+    // Returns the index of the first row named name underneath parent, without fetching children.
+    QModelIndex qti_private_FindIndex(const QAbstractItemModel* model, int name_column, const QString& name, const QModelIndex& parent = QModelIndex()) {
+        for (int row = 0; row < model->rowCount(parent); ++row) {
+            if (model->index(row,name_column,parent).data().toString() == name)
+                return model->index(row,0,parent);
+            QModelIndex index = qti_private_FindIndex(model,name_column,name,model->index(row,0,parent));
+            if (index.isValid())
+                return index;
+        }
+        return QModelIndex();
+    }
+}
+
+int Qtilities::Testing::TestObserverTreeModel::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestObserverTreeModel::testRebuilds() {
+    TreeNode* root = new TreeNode("Model Root");
+    QList<TreeNode*> nodes;
+    for (int i = 0; i < 5; ++i) {
+        nodes << root->addNode(QString("Node %1").arg(i));
+        for (int j = 0; j < 20; ++j)
+            nodes.last()->addItem(QString("Item %1.%2").arg(i).arg(j));
+    }
+
+    ObserverTreeModel model;
+    qti_private_BuildTreeModel(&model,root);
+    const int name_column = model.columnPosition(AbstractObserverItemModel::ColumnName);
+    QStringList names = qti_private_ModelNames(&model,name_column);
+    QCOMPARE(names.filter("Item 4.19").count(), 1);
+
+    // Every change rebuilds the tree, replacing the items and the arena of the previous build:
+    QList<TreeItem*> extra_items;
+    for (int i = 0; i < 20; ++i)
+        extra_items << nodes.at(i % 5)->addItem(QString("Extra %1").arg(i));
+    for (int i = 0; i < extra_items.count(); i += 2)
+        delete extra_items.at(i);
+    delete nodes.at(4);
+
+    names = qti_private_ModelNames(&model,name_column);
+    QCOMPARE(names.filter("Extra").count(), 10);
+    QVERIFY(names.filter("Item 4.").isEmpty());
+
+    ObserverTreeModel new_model;
+    qti_private_BuildTreeModel(&new_model,root);
+    QCOMPARE(names, qti_private_ModelNames(&new_model,name_column));
+
+    // Children which are built lazily are allocated separately from the arena of the tree, and can be released before the tree is rebuilt:
+    ObserverTreeModel lazy_model;
+    lazy_model.toggleLazyInit(true);
+    qti_private_BuildTreeModel(&lazy_model,root);
+    QCOMPARE(qti_private_ModelNames(&lazy_model,name_column), names);
+    QModelIndex node_index = qti_private_FindIndex(&lazy_model,name_column,"Node 1");
+    QVERIFY(node_index.isValid());
+    QVERIFY(lazy_model.releaseChildren(node_index));
+    QCOMPARE(lazy_model.rowCount(node_index), 0);
+
+    nodes.at(1)->addItem("Item After Release");
+    QCOMPARE(qti_private_ModelNames(&lazy_model,name_column), qti_private_ModelNames(&new_model,name_column));
+    QCOMPARE(qti_private_ModelNames(&new_model,name_column).filter("Item After Release").count(), 1);
+
+    delete root;
+}
+
+void Qtilities::Testing::TestObserverTreeModel::testParallelBuild() {
+    TreeNode* root = new TreeNode("Model Root");
+    QList<TreeNode*> nodes;
+    for (int i = 0; i < 8; ++i) {
+        nodes << root->addNode(QString("Node %1").arg(i));
+        for (int j = 0; j < 10; ++j)
+            nodes.last()->addItem(QString("Item %1.%2").arg(i).arg(j));
+        TreeNode* sub_node = nodes.last()->addNode(QString("Sub Node %1").arg(i));
+        for (int j = 0; j < 5; ++j)
+            sub_node->addItem(QString("Sub Item %1.%2").arg(i).arg(j));
+    }
+
+    // Subjects with multiple parents appear in several subtrees, which are built by different threads:
+    TreeItem* shared_item = nodes.at(0)->addItem("Shared Item");
+    TreeNode* shared_node = nodes.at(1)->addNode("Shared Node");
+    shared_node->addItems(QStringList() << "Shared Child 1" << "Shared Child 2");
+    for (int i = 2; i < 8; i += 2) {
+        QVERIFY(nodes.at(i)->addItem(shared_item));
+        QVERIFY(nodes.at(i + 1)->addNode(shared_node));
+    }
+
+    ObserverTreeModel serial_model;
+    qti_private_BuildTreeModel(&serial_model,root);
+    const int name_column = serial_model.columnPosition(AbstractObserverItemModel::ColumnName);
+    const QStringList names = qti_private_ModelNames(&serial_model,name_column);
+    QCOMPARE(names.filter("Shared Item").count(), 4);
+    QCOMPARE(names.filter("Shared Child 2").count(), 4);
+
+    ObserverTreeModel parallel_model;
+    parallel_model.setParallelBuildThreshold(2);
+    QCOMPARE(parallel_model.parallelBuildThreshold(), 2);
+    qti_private_BuildTreeModel(&parallel_model,root);
+    QCOMPARE(qti_private_ModelNames(&parallel_model,name_column), names);
+
+    // The subtrees can also be built in parallel from the worker thread of the model:
+    ObserverTreeModel threaded_model;
+    threaded_model.setParallelBuildThreshold(2);
+    QVERIFY(threaded_model.threadedBuildingEnabled());
+    QSignalSpy build_spy(&threaded_model,SIGNAL(treeModelBuildEnded()));
+    threaded_model.setObserverContext(root);
+    QVERIFY(qti_private_WaitForBuilds(build_spy,1));
+    QCOMPARE(qti_private_ModelNames(&threaded_model,name_column), names);
+
+    // Rebuilds after changes to the tree stay in the order of a serial build:
+    delete nodes.at(5);
+    nodes.at(2)->addItem("New Item");
+    const QStringList changed_names = qti_private_ModelNames(&serial_model,name_column);
+    QVERIFY(changed_names.filter("Node 5").isEmpty());
+    QCOMPARE(changed_names.filter("Shared Child 1").count(), 3);
+    QCOMPARE(changed_names.filter("New Item").count(), 1);
+    QCOMPARE(qti_private_ModelNames(&parallel_model,name_column), changed_names);
+
+    // The changes can be built by a single build when the first build was cancelled:
+    QVERIFY(qti_private_WaitForBuilds(build_spy,2));
+    QElapsedTimer timer;
+    timer.start();
+    while (qti_private_ModelNames(&threaded_model,name_column) != changed_names && timer.elapsed() < 10000)
+        QTest::qWait(10);
+    QCOMPARE(qti_private_ModelNames(&threaded_model,name_column), changed_names);
+
+    delete root;
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_OBSERVER_TREE_MODEL_H
+#define TEST_OBSERVER_TREE_MODEL_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::CoreGui::ObserverTreeModel.
+        class TESTING_SHARED_EXPORT TestObserverTreeModel: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("ObserverTreeModel"); }
+
+        private slots:
+            //! Tests that repeated rebuilds, which release the item arena of the previous build, result in the same tree as a new model.
+            void testRebuilds();
+            //! Tests that trees built in parallel, serially and in a worker thread are identical, including subjects with multiple parents.
+            void testParallelBuild();
+        };
+    }
+}
+
+#endif // TEST_OBSERVER_TREE_MODEL_H
@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestObserverTreeModelProxyFilter.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QElapsedTimer>
+
+namespace {
+    // Builds a tree model of root in the GUI thread, thus the model is up to date when observer changes were received:
+    void qti_private_BuildTreeModel(ObserverTreeModel* model, TreeNode* root) {
+        model->disableThreadedBuilding();
+        QSignalSpy build_spy(model,SIGNAL(treeModelBuildEnded()));
+        model->setObserverContext(root);
+        if (build_spy.isEmpty())
+            model->refresh();
+    }
+
+    // Waits until the proxy finished searching. Returns false if the search did not finish within ten seconds.
+    bool qti_private_WaitForSearch(ObserverTreeModelProxyFilter* proxy) {
+        QElapsedTimer timer;
+        timer.start();
+        while (proxy->isSearching() && timer.elapsed() < 10000)
+            QTest::qWait(10);
+        return !proxy->isSearching();
+    }
+
+    // Returns the names of all rows shown by model underneath parent.
+    QStringList qti_private_ShownNames(const QAbstractItemModel* model, int name_column, const QModelIndex& parent = QModelIndex()) {
+        QStringList names;
+        for (int row = 0; row < model->rowCount(parent); ++row) {
+            names << model->index(row,name_column,parent).data().toString();
+            names << qti_private_ShownNames(model,name_column,model->index(row,0,parent));
+        }
+        return names;
+    }
+}
+
+int Qtilities::Testing::TestObserverTreeModelProxyFilter::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestObserverTreeModelProxyFilter::testSearchExpression() {
+    TreeNode* root = new TreeNode("Search Root");
+    TreeNode* fruit = root->addNode("Fruit");
+    fruit->addItem("Apple");
+    fruit->addItem("Banana");
+    root->addItem("Mango");
+    root->addItem("Orange");
+
+    ObserverTreeModel model;
+    qti_private_BuildTreeModel(&model,root);
+    ObserverTreeModelProxyFilter proxy;
+    proxy.setSourceModel(&model);
+    const int name_column = model.columnPosition(AbstractObserverItemModel::ColumnName);
+    QVERIFY(qti_private_ShownNames(&proxy,name_column).contains("Apple"));
+
+    // The expression is matched in a worker thread:
+    QSignalSpy finished_spy(&proxy,SIGNAL(searchFinished()));
+    proxy.setSearchExpression(QRegExp("an",Qt::CaseInsensitive,QRegExp::FixedString));
+    QVERIFY(proxy.isSearching());
+    QVERIFY(qti_private_WaitForSearch(&proxy));
+    QCOMPARE(finished_spy.count(), 1);
+
+    // Matching items are shown along with their ancestors:
+    QStringList names = qti_private_ShownNames(&proxy,name_column);
+    QVERIFY(names.contains("Fruit"));
+    QVERIFY(names.contains("Banana"));
+    QVERIFY(names.contains("Mango"));
+    QVERIFY(names.contains("Orange"));
+    QVERIFY(!names.contains("Apple"));
+
+    // A different expression replaces the matches:
+    proxy.setSearchExpression(QRegExp("app*",Qt::CaseInsensitive,QRegExp::Wildcard));
+    QVERIFY(qti_private_WaitForSearch(&proxy));
+    names = qti_private_ShownNames(&proxy,name_column);
+    QVERIFY(names.contains("Apple"));
+    QVERIFY(!names.contains("Banana"));
+    QVERIFY(!names.contains("Mango"));
+
+    // Clearing the search shows all rows right away:
+    proxy.setSearchExpression(QRegExp());
+    QVERIFY(!proxy.isSearching());
+    QCOMPARE(finished_spy.count(), 3);
+    names = qti_private_ShownNames(&proxy,name_column);
+    QVERIFY(names.contains("Apple"));
+    QVERIFY(names.contains("Banana"));
+    QVERIFY(names.contains("Orange"));
+
+    delete root;
+}
+
+void Qtilities::Testing::TestObserverTreeModelProxyFilter::testRemoveWhileSearching() {
+    TreeNode* root = new TreeNode("Search Root");
+    TreeNode* fruit = root->addNode("Fruit");
+    fruit->addItem("Apple");
+    fruit->addItem("Banana");
+    TreeItem* mango = root->addItem("Mango");
+    root->addItem("Orange");
+
+    ObserverTreeModel model;
+    qti_private_BuildTreeModel(&model,root);
+    ObserverTreeModelProxyFilter proxy;
+    proxy.setSourceModel(&model);
+    const int name_column = model.columnPosition(AbstractObserverItemModel::ColumnName);
+
+    // The item is removed after the search started, but before its matches arrived:
+    proxy.setSearchExpression(QRegExp("an",Qt::CaseInsensitive,QRegExp::FixedString));
+    QVERIFY(proxy.isSearching());
+    delete mango;
+    QVERIFY(qti_private_WaitForSearch(&proxy));
+
+    QStringList names = qti_private_ShownNames(&proxy,name_column);
+    QVERIFY(!names.contains("Mango"));
+    QVERIFY(names.contains("Banana"));
+    QVERIFY(names.contains("Orange"));
+    QVERIFY(!names.contains("Apple"));
+
+    // Items added in place of the removed item are only shown when they match:
+    root->addItem("Cherry");
+    root->addItem("Mandarin");
+    QVERIFY(qti_private_WaitForSearch(&proxy));
+    names = qti_private_ShownNames(&proxy,name_column);
+    QVERIFY(!names.contains("Cherry"));
+    QVERIFY(names.contains("Mandarin"));
+    QVERIFY(names.contains("Orange"));
+
+    delete root;
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_OBSERVER_TREE_MODEL_PROXY_FILTER_H
+#define TEST_OBSERVER_TREE_MODEL_PROXY_FILTER_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of the threaded search in Qtilities::CoreGui::ObserverTreeModelProxyFilter.
+        class TESTING_SHARED_EXPORT TestObserverTreeModelProxyFilter: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("ObserverTreeModelProxyFilter"); }
+
+        private slots:
+            //! Tests that setSearchExpression() shows the matching items and their ancestors once the search finished.
+            void testSearchExpression();
+            //! Tests that items which are removed while a search is running are not matched.
+            void testRemoveWhileSearching();
+        };
+    }
+}
+
+#endif // TEST_OBSERVER_TREE_MODEL_PROXY_FILTER_H
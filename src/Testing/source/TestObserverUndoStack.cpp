@@ -0,0 +1,135 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestObserverUndoStack.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+namespace {
+    // Creates objects named Object 1 to Object count, which are not owned by the observers they are attached to.
+    QList<QObject*> qti_private_CreateObjects(int count) {
+        QList<QObject*> objects;
+        for (int i = 0; i < count; ++i) {
+            objects << new QObject;
+            objects.last()->setObjectName(QString("Object %1").arg(i + 1));
+        }
+        return objects;
+    }
+}
+
+int Qtilities::Testing::TestObserverUndoStack::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestObserverUndoStack::testUndoRedo() {
+    Observer root("Undo Root");
+    QList<QObject*> objects = qti_private_CreateObjects(4);
+    ObserverUndoStack* undo_stack = new ObserverUndoStack(&root);
+    QVERIFY(!undo_stack->canUndo());
+    QVERIFY(!undo_stack->checkpoint());
+
+    root.attachSubject(objects.at(0),Observer::ManualOwnership);
+    QVERIFY(undo_stack->checkpoint());
+    QCOMPARE(undo_stack->count(), 1);
+    QCOMPARE(undo_stack->undoText(), QString("Attach \"Object 1\""));
+
+    // Changes made before the event loop runs again form a single step:
+    root.attachSubject(objects.at(1),Observer::ManualOwnership);
+    root.attachSubject(objects.at(2),Observer::ManualOwnership);
+    QCoreApplication::processEvents();
+    QCOMPARE(undo_stack->count(), 2);
+    QCOMPARE(undo_stack->index(), 2);
+    QCOMPARE(undo_stack->stepDiff(1).count(), 2);
+    QCOMPARE(undo_stack->editCount(), 3);
+
+    QSignalSpy index_spy(undo_stack,SIGNAL(indexChanged(int)));
+    QVERIFY(undo_stack->undo());
+    QCOMPARE(root.subjectCount(), 1);
+    QVERIFY(root.contains(objects.at(0)));
+    QVERIFY(undo_stack->canRedo());
+    QVERIFY(undo_stack->undo());
+    QCOMPARE(root.subjectCount(), 0);
+    QVERIFY(!undo_stack->canUndo());
+    QCOMPARE(index_spy.count(), 2);
+
+    // Undoing is not recorded as a new step:
+    QCoreApplication::processEvents();
+    QCOMPARE(undo_stack->count(), 2);
+
+    QVERIFY(undo_stack->redo());
+    QCOMPARE(root.subjectCount(), 1);
+    QCOMPARE(undo_stack->index(), 1);
+
+    // A new change replaces the steps which could be redone:
+    root.attachSubject(objects.at(3),Observer::ManualOwnership);
+    QVERIFY(undo_stack->checkpoint());
+    QCOMPARE(undo_stack->count(), 2);
+    QVERIFY(!undo_stack->canRedo());
+    QCOMPARE(undo_stack->editCount(), 2);
+
+    delete undo_stack;
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::TestObserverUndoStack::testProcessingCycleStep() {
+    Observer root("Undo Root");
+    QList<QObject*> objects = qti_private_CreateObjects(2);
+    ObserverUndoStack* undo_stack = new ObserverUndoStack(&root);
+
+    root.startProcessingCycle();
+    root.attachSubject(objects.at(0),Observer::ManualOwnership);
+    QCoreApplication::processEvents();
+    root.attachSubject(objects.at(1),Observer::ManualOwnership);
+    QCoreApplication::processEvents();
+    QCOMPARE(undo_stack->count(), 0);
+
+    root.endProcessingCycle();
+    QCoreApplication::processEvents();
+    QCOMPARE(undo_stack->count(), 1);
+    QCOMPARE(undo_stack->stepDiff(0).count(), 2);
+
+    QVERIFY(undo_stack->undo());
+    QCOMPARE(root.subjectCount(), 0);
+
+    delete undo_stack;
+    qDeleteAll(objects);
+}
+
+void Qtilities::Testing::TestObserverUndoStack::testLimits() {
+    Observer root("Undo Root");
+    QList<QObject*> objects = qti_private_CreateObjects(4);
+    ObserverUndoStack* undo_stack = new ObserverUndoStack(&root);
+    undo_stack->setStepLimit(2);
+
+    for (int i = 0; i < 3; ++i) {
+        root.attachSubject(objects.at(i),Observer::ManualOwnership);
+        QVERIFY(undo_stack->checkpoint());
+    }
+    QCOMPARE(undo_stack->count(), 2);
+    QCOMPARE(undo_stack->index(), 2);
+    QCOMPARE(undo_stack->undoText(), QString("Attach \"Object 3\""));
+    QCOMPARE(undo_stack->text(0), QString("Attach \"Object 2\""));
+
+    // The newest step is kept, even when it has more edits than the limit:
+    undo_stack->setStepLimit(0);
+    root.detachSubject(objects.at(0));
+    root.attachSubject(objects.at(3),Observer::ManualOwnership);
+    QVERIFY(undo_stack->checkpoint());
+    QCOMPARE(undo_stack->count(), 3);
+    undo_stack->setEditLimit(1);
+    QCOMPARE(undo_stack->count(), 1);
+    QCOMPARE(undo_stack->editCount(), 2);
+    QCOMPARE(undo_stack->undoText(), QString("Change 2 Items"));
+
+    delete undo_stack;
+    qDeleteAll(objects);
+}
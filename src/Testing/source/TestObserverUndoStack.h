@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_OBSERVER_UNDO_STACK_H
+#define TEST_OBSERVER_UNDO_STACK_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::ObserverUndoStack.
+        class TESTING_SHARED_EXPORT TestObserverUndoStack: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("ObserverUndoStack"); }
+
+        private slots:
+            //! Tests recording, undoing and redoing steps, and that changes made in one pass of the event loop form a single step.
+            void testUndoRedo();
+            //! Tests that changes made inside a processing cycle on the root observer are recorded when the cycle ends.
+            void testProcessingCycleStep();
+            //! Tests that setStepLimit() and setEditLimit() discard the oldest steps.
+            void testLimits();
+        };
+    }
+}
+
+#endif // TEST_OBSERVER_UNDO_STACK_H
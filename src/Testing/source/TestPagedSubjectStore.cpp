@@ -0,0 +1,131 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestPagedSubjectStore.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+namespace {
+    // Opens store in a new backing file and appends count tree items named "Record N" to it.
+    bool qti_private_FillStore(PagedSubjectStore* store, const QString& file_name, int count) {
+        if (!store->open(QDir::tempPath() + "/" + file_name))
+            return false;
+        for (int i = 0; i < count; ++i) {
+            if (store->appendSubject(new TreeItem(QString("Record %1").arg(i))) != i)
+                return false;
+        }
+        return true;
+    }
+}
+
+int Qtilities::Testing::TestPagedSubjectStore::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestPagedSubjectStore::testResidentRecords() {
+    Observer obs("Paged Observer");
+    PagedSubjectStore store(&obs);
+    store.setMaximumResidentCount(3);
+    QVERIFY(qti_private_FillStore(&store,"qtilities_paged_resident.pages",20));
+    QVERIFY(store.isOpen());
+
+    // Records are not attached to the observer when they are added:
+    QCOMPARE(store.recordCount(), 20);
+    QCOMPARE(store.recordName(7), QString("Record 7"));
+    QCOMPARE(store.residentCount(), 0);
+    QCOMPARE(obs.subjectCount(), 0);
+
+    // Subjects which are not exportable are rejected:
+    QObject* plain_object = new QObject;
+    QCOMPARE(store.appendSubject(plain_object), -1);
+    delete plain_object;
+
+    QSignalSpy materialized_spy(&store,SIGNAL(recordMaterialized(int,QObject*)));
+    QSignalSpy evicted_spy(&store,SIGNAL(recordEvicted(int)));
+
+    QObject* locked_subject = store.lockRecord(0);
+    QVERIFY(locked_subject);
+    QCOMPARE(locked_subject->objectName(), QString("Record 0"));
+    QVERIFY(obs.contains(locked_subject));
+    QVERIFY(store.isRecordLocked(0));
+    QCOMPARE(store.recordOfSubject(locked_subject), 0);
+
+    for (int i = 1; i < 10; ++i)
+        QVERIFY(store.referenceRecord(i));
+    QCOMPARE(materialized_spy.count(), 10);
+    QCOMPARE(evicted_spy.count(), 7);
+    QCOMPARE(store.residentCount(), 3);
+    QCOMPARE(obs.subjectCount(), 3);
+    QVERIFY(store.isRecordResident(0));
+    QVERIFY(store.isRecordResident(8));
+    QVERIFY(store.isRecordResident(9));
+    QVERIFY(!store.isRecordResident(7));
+
+    // Referencing a resident record makes it the most recently used record:
+    QVERIFY(store.referenceRecord(8));
+    QVERIFY(store.referenceRecord(2));
+    QVERIFY(store.isRecordResident(8));
+    QVERIFY(!store.isRecordResident(9));
+    QCOMPARE(store.referenceRecord(2)->objectName(), QString("Record 2"));
+
+    store.evictUnlockedRecords();
+    QCOMPARE(store.residentCount(), 1);
+    QVERIFY(store.isRecordResident(0));
+
+    store.unlockRecord(0);
+    QVERIFY(!store.isRecordLocked(0));
+    store.evictUnlockedRecords();
+    QCOMPARE(store.residentCount(), 0);
+    QCOMPARE(obs.subjectCount(), 0);
+
+    store.close();
+    QVERIFY(!store.isOpen());
+    QCOMPARE(store.recordCount(), 0);
+}
+
+void Qtilities::Testing::TestPagedSubjectStore::testWriteBack() {
+    Observer obs("Paged Observer");
+    PagedSubjectStore store(&obs);
+    QVERIFY(qti_private_FillStore(&store,"qtilities_paged_write_back.pages",5));
+
+    // Modified subjects are stored again when they are evicted:
+    QObject* subject = store.referenceRecord(3);
+    QVERIFY(subject);
+    subject->setObjectName("Renamed Record 3");
+    IModificationNotifier* mod_iface = qobject_cast<IModificationNotifier*> (subject);
+    QVERIFY(mod_iface);
+    mod_iface->setModificationState(true);
+    store.evictUnlockedRecords();
+    QVERIFY(!store.isRecordResident(3));
+    QCOMPARE(store.recordName(3), QString("Renamed Record 3"));
+    QCOMPARE(store.referenceRecord(3)->objectName(), QString("Renamed Record 3"));
+
+    // Changes can also be stored explicitly:
+    subject = store.lockRecord(1);
+    subject->setObjectName("Stored Record 1");
+    QVERIFY(store.storeRecord(1));
+    QCOMPARE(store.recordName(1), QString("Stored Record 1"));
+    QVERIFY(!store.storeRecord(4));
+
+    // Records of subjects which are detached by other parts of the application remain in the store:
+    subject = store.referenceRecord(2);
+    QVERIFY(subject);
+    obs.detachSubject(subject);
+    QVERIFY(!store.isRecordResident(2));
+    QCOMPARE(store.recordCount(), 5);
+    subject = store.referenceRecord(2);
+    QVERIFY(subject);
+    QCOMPARE(subject->objectName(), QString("Record 2"));
+    QCOMPARE(store.recordOfSubject(subject), 2);
+
+    store.unlockRecord(1);
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_PAGED_SUBJECT_STORE_H
+#define TEST_PAGED_SUBJECT_STORE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::PagedSubjectStore.
+        class TESTING_SHARED_EXPORT TestPagedSubjectStore: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("PagedSubjectStore"); }
+
+        private slots:
+            //! Tests that records are materialized on demand, that locked records stay resident and that unlocked records are evicted in least recently used order.
+            void testResidentRecords();
+            //! Tests that modified subjects are written back when they are evicted, and that records survive subjects which are detached elsewhere.
+            void testWriteBack();
+        };
+    }
+}
+
+#endif // TEST_PAGED_SUBJECT_STORE_H
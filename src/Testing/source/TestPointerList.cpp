@@ -0,0 +1,170 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestPointerList.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+namespace {
+    // Checks that all access functions of list agree with the expected objects.
+    bool qti_private_ListMatches(const PointerList& list, const QList<QObject*>& expected) {
+        if (list.count() != expected.count() || list.toQList() != expected)
+            return false;
+        for (int i = 0; i < expected.count(); ++i) {
+            if (list.at(i) != expected.at(i) || list.indexOf(expected.at(i)) != i)
+                return false;
+        }
+        return true;
+    }
+}
+
+int Qtilities::Testing::TestPointerList::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestPointerList::testAppendRemove() {
+    PointerList list;
+    QObject* obj1 = new QObject;
+    QObject* obj2 = new QObject;
+    QObject* obj3 = new QObject;
+    QObject* obj4 = new QObject;
+
+    list.append(obj1);
+    list.append(obj2);
+    list.append(obj3);
+    list.append(obj4);
+    QVERIFY(qti_private_ListMatches(list,QList<QObject*>() << obj1 << obj2 << obj3 << obj4));
+
+    // Objects are only added once:
+    list.append(obj2);
+    QVERIFY(qti_private_ListMatches(list,QList<QObject*>() << obj1 << obj2 << obj3 << obj4));
+
+    list.removeOne(obj2);
+    QVERIFY(qti_private_ListMatches(list,QList<QObject*>() << obj1 << obj3 << obj4));
+    QCOMPARE(list.indexOf(obj2),-1);
+    // Removing an object which is not in the list does nothing:
+    list.removeOne(obj2);
+    QCOMPARE(list.count(),3);
+
+    list.removeAt(2);
+    QVERIFY(qti_private_ListMatches(list,QList<QObject*>() << obj1 << obj3));
+    list.removeAt(0);
+    QVERIFY(qti_private_ListMatches(list,QList<QObject*>() << obj3));
+
+    // Objects can be appended again after they were removed:
+    list.append(obj2);
+    list.append(obj1);
+    QVERIFY(qti_private_ListMatches(list,QList<QObject*>() << obj3 << obj2 << obj1));
+
+    // Removed objects are not monitored anymore, deleted objects are removed:
+    list.removeOne(obj1);
+    QSignalSpy spy(&list,SIGNAL(objectDestroyed(QObject*)));
+    delete obj1;
+    QCOMPARE(spy.count(),0);
+    delete obj3;
+    QCOMPARE(spy.count(),1);
+    QVERIFY(qti_private_ListMatches(list,QList<QObject*>() << obj2));
+
+    list.deleteAll();
+    QCOMPARE(list.count(),0);
+    QVERIFY(list.toQList().isEmpty());
+    delete obj4;
+}
+
+void Qtilities::Testing::TestPointerList::testDeletionDuringIteration() {
+    PointerList list;
+    QSignalSpy spy(&list,SIGNAL(objectDestroyed(QObject*)));
+    QList<QObject*> expected;
+    for (int i = 0; i < 20; ++i) {
+        QObject* obj = new QObject;
+        list.append(obj);
+        expected << obj;
+    }
+
+    // Delete every second object while iterating over a copy of the list:
+    QList<QObject*> objects = list.toQList();
+    for (int i = 0; i < objects.count(); i += 2) {
+        expected.removeOne(objects.at(i));
+        delete objects.at(i);
+        QVERIFY(qti_private_ListMatches(list,expected));
+    }
+    QCOMPARE(spy.count(),10);
+
+    // Delete objects while iterating over positions, the list shrinks while it is used:
+    int i = 0;
+    bool delete_object = true;
+    while (i < list.count()) {
+        QObject* obj = list.at(i);
+        if (delete_object) {
+            expected.removeOne(obj);
+            delete obj;
+        } else {
+            ++i;
+        }
+        delete_object = !delete_object;
+        QVERIFY(qti_private_ListMatches(list,expected));
+    }
+    QCOMPARE(list.count(),5);
+
+    // Objects which delete other objects in the list:
+    QObject* parent = new QObject;
+    QObject* child1 = new QObject(parent);
+    QObject* child2 = new QObject(parent);
+    list.append(child1);
+    list.append(parent);
+    list.append(child2);
+    delete parent;
+    QVERIFY(qti_private_ListMatches(list,expected));
+
+    parent = new QObject;
+    list.append(parent);
+    list.append(new QObject(parent));
+    list.deleteAll();
+    QCOMPARE(list.count(),0);
+}
+
+void Qtilities::Testing::TestPointerList::testCompaction() {
+    PointerList list;
+    QList<QObject*> expected;
+    for (int i = 0; i < 200; ++i) {
+        QObject* obj = new QObject;
+        list.append(obj);
+        expected << obj;
+    }
+
+    // Remove objects at scattered positions, the empty slots left behind are compacted once they outnumber the objects:
+    for (int i = 0; i < 150; ++i) {
+        const int position = (i * 7) % expected.count();
+        QObject* obj = expected.takeAt(position);
+        if (i % 3 == 0)
+            list.removeAt(position);
+        else if (i % 3 == 1)
+            list.removeOne(obj);
+        delete obj;
+        QVERIFY(qti_private_ListMatches(list,expected));
+    }
+
+    // Objects appended after the compaction:
+    for (int i = 0; i < 10; ++i) {
+        QObject* obj = new QObject;
+        list.append(obj);
+        expected << obj;
+    }
+    QVERIFY(qti_private_ListMatches(list,expected));
+
+    // Removing the last objects:
+    while (!expected.isEmpty()) {
+        delete expected.takeLast();
+        QVERIFY(qti_private_ListMatches(list,expected));
+    }
+    QCOMPARE(list.count(),0);
+}
@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_POINTER_LIST_H
+#define TEST_POINTER_LIST_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::PointerList.
+        class TESTING_SHARED_EXPORT TestPointerList: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("PointerList"); }
+
+        private slots:
+            //! Tests append(), removeOne(), removeAt(), indexOf() and at().
+            void testAppendRemove();
+            //! Tests deleting objects while iterating over the list.
+            void testDeletionDuringIteration();
+            //! Tests that positions stay correct when empty slots are compacted.
+            void testCompaction();
+        };
+    }
+}
+
+#endif // TEST_POINTER_LIST_H
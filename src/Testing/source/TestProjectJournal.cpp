@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestProjectJournal.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QtilitiesProjectManagement>
+using namespace QtilitiesProjectManagement;
+
+Qtilities::Testing::ProjectJournalTestItem::ProjectJournalTestItem(const QString& name, QObject* parent) : QObject(parent), import_count(0), item_name(name), is_modified(false) {
+    setObjectName(name);
+}
+
+bool Qtilities::Testing::ProjectJournalTestItem::newProjectItem() {
+    value.clear();
+    return true;
+}
+
+bool Qtilities::Testing::ProjectJournalTestItem::closeProjectItem(ITask* task) {
+    Q_UNUSED(task)
+    value.clear();
+    return true;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Testing::ProjectJournalTestItem::exportBinary(QDataStream& stream) const {
+    if (!value.isEmpty())
+        stream << value;
+    return IExportable::Complete;
+}
+
+Qtilities::Core::Interfaces::IExportable::ExportResultFlags Qtilities::Testing::ProjectJournalTestItem::importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list) {
+    Q_UNUSED(import_list)
+    ++import_count;
+    value.clear();
+    if (!stream.atEnd())
+        stream >> value;
+    return stream.status() == QDataStream::Ok ? IExportable::Complete : IExportable::Failed;
+}
+
+void Qtilities::Testing::ProjectJournalTestItem::setModificationState(bool new_state, IModificationNotifier::NotificationTargets notification_targets, bool force_notifications) {
+    const bool changed = is_modified != new_state;
+    is_modified = new_state;
+    if ((notification_targets & IModificationNotifier::NotifyListeners) && (changed || force_notifications))
+        emit modificationStateChanged(new_state);
+}
+
+int Qtilities::Testing::TestProjectJournal::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestProjectJournal::testReplayEmptyRecord() {
+    const bool incremental_saving = PROJECT_MANAGER->incrementalProjectSaving();
+    const bool use_file_locks = PROJECT_MANAGER->useProjectFileLocks();
+    PROJECT_MANAGER->setIncrementalProjectSaving(true);
+    PROJECT_MANAGER->setUseProjectFileLocks(false);
+
+    QDir().mkpath(QtilitiesApplication::applicationSessionPath() + "/TestProjectJournal");
+    const QString project_file = QtilitiesApplication::applicationSessionPath() + "/TestProjectJournal/testReplayEmptyRecord." + PROJECT_MANAGER->projectTypeSuffix(IExportable::Binary);
+    const QString journal_file = project_file + "." + qti_def_SUFFIX_PROJECT_JOURNAL;
+    QFile::remove(project_file);
+    QFile::remove(journal_file);
+
+    ProjectJournalTestItem source_empty_item("Empty Item");
+    ProjectJournalTestItem source_value_item("Value Item");
+    Project* source_project = new Project;
+    source_project->addProjectItem(&source_empty_item);
+    source_project->addProjectItem(&source_value_item);
+
+    // The first save writes the complete project:
+    source_empty_item.value = "Saved Value";
+    source_value_item.value = "Saved Value";
+    QVERIFY(source_project->saveProject(project_file));
+    QVERIFY(!QFile::exists(journal_file));
+
+    // The second save appends both items to the journal, where the first item saves nothing:
+    source_empty_item.value.clear();
+    source_empty_item.setModificationState(true);
+    source_value_item.value = "Journal Value";
+    source_value_item.setModificationState(true);
+    QVERIFY(source_project->saveProject(project_file));
+    QVERIFY(QFile::exists(journal_file));
+
+    ProjectJournalTestItem loaded_empty_item("Empty Item");
+    ProjectJournalTestItem loaded_value_item("Value Item");
+    Project* loaded_project = new Project;
+    loaded_project->addProjectItem(&loaded_empty_item);
+    loaded_project->addProjectItem(&loaded_value_item);
+    QVERIFY(loaded_project->loadProject(project_file));
+
+    // Both items are imported from the project file, after which the journal replaces their values:
+    QCOMPARE(loaded_empty_item.import_count,2);
+    QVERIFY(loaded_empty_item.value.isEmpty());
+    QCOMPARE(loaded_value_item.import_count,2);
+    QCOMPARE(loaded_value_item.value,QString("Journal Value"));
+
+    // The files are removed first, thus closing the projects does not compact the journal:
+    QVERIFY(QFile::remove(journal_file));
+    QVERIFY(QFile::remove(project_file));
+    delete loaded_project;
+    delete source_project;
+
+    PROJECT_MANAGER->setIncrementalProjectSaving(incremental_saving);
+    PROJECT_MANAGER->setUseProjectFileLocks(use_file_locks);
+}
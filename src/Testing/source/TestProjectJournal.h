@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_PROJECT_JOURNAL_H
+#define TEST_PROJECT_JOURNAL_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <IProjectItem>
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+        using namespace Qtilities::ProjectManagement::Interfaces;
+
+        //! A project item used by TestProjectJournal which saves a single string value.
+        /*!
+          Nothing is saved when the value is empty, thus the item is only used with an empty value where it is saved on its own, as in the project journal.
+          */
+        class ProjectJournalTestItem: public QObject, public IProjectItem
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::ProjectManagement::Interfaces::IProjectItem)
+
+        public:
+            ProjectJournalTestItem(const QString& name, QObject* parent = 0);
+
+            //! The value saved by the item.
+            QString value;
+            //! The number of times importBinary() was called.
+            int import_count;
+
+            // --------------------------------------------
+            // IProjectItem Implementation
+            // --------------------------------------------
+            QString projectItemName() const { return item_name; }
+            bool newProjectItem();
+            bool closeProjectItem(ITask* task = 0);
+
+            // --------------------------------
+            // IExportable Implementation
+            // --------------------------------
+            ExportModeFlags supportedFormats() const { return IExportable::Binary; }
+            IExportable::ExportResultFlags exportBinary(QDataStream& stream) const;
+            IExportable::ExportResultFlags importBinary(QDataStream& stream, QList<QPointer<QObject> >& import_list);
+
+            // --------------------------------
+            // IModificationNotifier Implementation
+            // --------------------------------
+            bool isModified() const { return is_modified; }
+        public slots:
+            void setModificationState(bool new_state, IModificationNotifier::NotificationTargets notification_targets = IModificationNotifier::NotifyListeners, bool force_notifications = false);
+        signals:
+            void modificationStateChanged(bool is_modified) const;
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+        private:
+            QString item_name;
+            bool is_modified;
+        };
+
+        //! Allows testing of the project journal written when Qtilities::ProjectManagement::ProjectManager saves projects incrementally.
+        class TESTING_SHARED_EXPORT TestProjectJournal: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("ProjectJournal"); }
+
+        private slots:
+            //! Tests that project items which save nothing do not prevent the records after them in the journal from being replayed.
+            void testReplayEmptyRecord();
+        };
+    }
+}
+
+#endif // TEST_PROJECT_JOURNAL_H
@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestQtilitiesProcess.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+#include "../../Core/source/QtilitiesProcess_p.h"
+
+#include <QElapsedTimer>
+
+namespace {
+    // Sets the chunks of a buffer directly, append() would merge small chunks into one chunk.
+    void qti_private_SetChunks(QtilitiesProcessLastRunBuffer& buffer, const QList<QByteArray>& chunks) {
+        buffer.clear();
+        buffer.chunks = chunks;
+        for (int i = 0; i < chunks.count(); ++i) {
+            buffer.size += chunks.at(i).size();
+            buffer.line_count += chunks.at(i).count('\n');
+        }
+    }
+}
+
+int Qtilities::Testing::TestQtilitiesProcess::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestQtilitiesProcess::testLastRunBufferLineLimit() {
+    // The line "yyzz" starts in the first chunk and ends in the second chunk:
+    QtilitiesProcessLastRunBuffer buffer;
+    qti_private_SetChunks(buffer,QList<QByteArray>() << QByteArray("x\nyy") << QByteArray("zz\nw\n"));
+    QCOMPARE(buffer.line_count,(qint64) 3);
+    buffer.maximum_line_count = 1;
+    buffer.enforceLimits();
+    QCOMPARE(buffer.toByteArray(),QByteArray("w\n"));
+    QCOMPARE(buffer.line_count,(qint64) 1);
+    QCOMPARE(buffer.size,(qint64) 2);
+
+    // The same through append(), where the first chunk is full:
+    QtilitiesProcessLastRunBuffer appended_buffer;
+    appended_buffer.maximum_line_count = 1;
+    const QByteArray long_line(QtilitiesProcessLastRunBuffer::chunk_size - 2,'y');
+    appended_buffer.append(QByteArray("x\n") + long_line);
+    QCOMPARE(appended_buffer.chunks.count(),1);
+    appended_buffer.append("zz\nw\n");
+    QCOMPARE(appended_buffer.toByteArray(),QByteArray("w\n"));
+    QCOMPARE(appended_buffer.line_count,(qint64) 1);
+
+    // Removing lines which end exactly at the end of a chunk:
+    qti_private_SetChunks(buffer,QList<QByteArray>() << QByteArray("a\nb\n") << QByteArray("c\nd"));
+    buffer.maximum_line_count = 1;
+    buffer.enforceLimits();
+    QCOMPARE(buffer.toByteArray(),QByteArray("c\nd"));
+    QCOMPARE(buffer.line_count,(qint64) 1);
+}
+
+void Qtilities::Testing::TestQtilitiesProcess::testLastRunBufferSizeLimit() {
+    QtilitiesProcessLastRunBuffer buffer;
+    qti_private_SetChunks(buffer,QList<QByteArray>() << QByteArray("x\nyy") << QByteArray("zz\nw\n"));
+    buffer.maximum_size = 3;
+    buffer.enforceLimits();
+    QCOMPARE(buffer.toByteArray(),QByteArray("\nw\n"));
+    QCOMPARE(buffer.size,(qint64) 3);
+    QCOMPARE(buffer.line_count,(qint64) 2);
+
+    // Both limits together:
+    qti_private_SetChunks(buffer,QList<QByteArray>() << QByteArray("x\nyy") << QByteArray("zz\nw\n"));
+    buffer.maximum_size = 6;
+    buffer.maximum_line_count = 1;
+    buffer.enforceLimits();
+    QCOMPARE(buffer.toByteArray(),QByteArray("w\n"));
+    QCOMPARE(buffer.size,(qint64) 2);
+    QCOMPARE(buffer.line_count,(qint64) 1);
+
+    // Appending more data keeps the buffer within its limits:
+    buffer.append("abc\n");
+    QCOMPARE(buffer.toByteArray(),QByteArray("abc\n"));
+    QVERIFY(buffer.size <= buffer.maximum_size);
+}
+
+void Qtilities::Testing::TestQtilitiesProcess::testLastRunBufferSpill() {
+    QtilitiesProcessLastRunBuffer buffer;
+    buffer.spill_enabled = true;
+    qti_private_SetChunks(buffer,QList<QByteArray>() << QByteArray("x\nyy") << QByteArray("zz\nw\n"));
+    buffer.maximum_line_count = 1;
+    buffer.enforceLimits();
+    QCOMPARE(buffer.size,(qint64) 2);
+    QCOMPARE(buffer.spilled_size,(qint64) 7);
+    QCOMPARE(buffer.totalSize(),(qint64) 9);
+    QCOMPARE(buffer.toByteArray(),QByteArray("x\nyyzz\nw\n"));
+
+    buffer.clear();
+    QCOMPARE(buffer.totalSize(),(qint64) 0);
+    QVERIFY(buffer.toByteArray().isEmpty());
+}
+
+void Qtilities::Testing::TestQtilitiesProcess::testRescheduledBufferReads() {
+    const int line_count = 2000;
+    QString program;
+    QStringList arguments;
+#ifdef Q_OS_WIN
+    program = "cmd";
+    arguments << "/c" << QString("for /L %i in (1,1,%1) do @echo %i").arg(line_count);
+#else
+    program = "/bin/sh";
+    arguments << "-c" << QString("i=1; while [ $i -le %1 ]; do echo $i; i=$((i+1)); done").arg(line_count);
+#endif
+
+    // Only a few lines are read at a time, the rest of the buffer is read in high priority calls on the idle scheduler:
+    QtilitiesProcess process("Rescheduled Reads",false);
+    process.setGuiRefreshFrequency(10);
+    process.setLastRunBufferEnabled(true);
+    process.setProcessInfoMessagesEnabled(false);
+    QVERIFY(process.startProcess(program,arguments));
+
+    QElapsedTimer timeout;
+    timeout.start();
+    while (process.state() == ITask::TaskBusy && timeout.elapsed() < 30000)
+        QTest::qWait(10);
+    QVERIFY(process.state() != ITask::TaskBusy);
+
+    QStringList lines;
+    foreach (const QString& line, QString::fromLocal8Bit(process.lastRunBuffer()).split(QRegExp("[\\r\\n]+"),QString::SkipEmptyParts))
+        lines << line.trimmed();
+    QCOMPARE(lines.count(),line_count);
+    for (int i = 0; i < lines.count(); ++i)
+        QCOMPARE(lines.at(i),QString::number(i + 1));
+}
@@ -0,0 +1,56 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_QTILITIES_PROCESS_H
+#define TEST_QTILITIES_PROCESS_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::QtilitiesProcess.
+        class TESTING_SHARED_EXPORT TestQtilitiesProcess: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("QtilitiesProcess"); }
+
+        private slots:
+            //! Tests the line limit of the last run buffer when lines span chunk boundaries.
+            void testLastRunBufferLineLimit();
+            //! Tests the size limit of the last run buffer when lines span chunk boundaries.
+            void testLastRunBufferSizeLimit();
+            //! Tests that data removed from the last run buffer is kept when spilling is enabled.
+            void testLastRunBufferSpill();
+            //! Tests that output read in parts, with the rest of the buffer read in calls scheduled on the idle scheduler, is complete and in order.
+            void testRescheduledBufferReads();
+        };
+    }
+}
+
+#endif // TEST_QTILITIES_PROCESS_H
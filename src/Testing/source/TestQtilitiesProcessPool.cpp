@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestQtilitiesProcessPool.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+#include <QElapsedTimer>
+
+namespace {
+    // Sets up a command which waits for the given number of seconds before it exits.
+    void qti_private_WaitCommand(int seconds, QString* program, QStringList* arguments) {
+#ifdef Q_OS_WIN
+        *program = "cmd";
+        *arguments << "/c" << QString("ping -n %1 127.0.0.1 > nul").arg(seconds + 1);
+#else
+        *program = "/bin/sh";
+        *arguments << "-c" << QString("sleep %1").arg(seconds);
+#endif
+    }
+
+    // Waits until the pool has no running or queued processes.
+    bool qti_private_WaitForPool(QtilitiesProcessPool& pool, int timeout_msecs = 30000) {
+        QElapsedTimer timeout;
+        timeout.start();
+        while ((pool.runningCount() > 0 || pool.pendingCount() > 0) && timeout.elapsed() < timeout_msecs)
+            QTest::qWait(10);
+        return pool.runningCount() == 0 && pool.pendingCount() == 0;
+    }
+}
+
+int Qtilities::Testing::TestQtilitiesProcessPool::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestQtilitiesProcessPool::testQueueing() {
+    QString program;
+    QStringList arguments;
+    qti_private_WaitCommand(1,&program,&arguments);
+
+    QtilitiesProcessPool pool("Queueing Pool");
+    pool.setMaximumConcurrentProcesses(1);
+    QSignalSpy sub_task_spy(pool.poolTask(),SIGNAL(subTaskCompleted(int,QString,Logger::MessageType)));
+    QSignalSpy finished_spy(&pool,SIGNAL(allProcessesFinished()));
+
+    QtilitiesProcess first_process("First Process",false);
+    QtilitiesProcess low_priority_process("Low Priority Process",false);
+    QtilitiesProcess high_priority_process("High Priority Process",false);
+    QVERIFY(pool.enqueue(&first_process,program,arguments));
+    QVERIFY(pool.enqueue(&low_priority_process,program,arguments,0));
+    QVERIFY(pool.enqueue(&high_priority_process,program,arguments,5));
+    QVERIFY(!pool.enqueue(&low_priority_process,program,arguments));
+    QVERIFY(!pool.enqueue(0,program,arguments));
+
+    QCOMPARE(pool.runningCount(),1);
+    QCOMPARE(pool.pendingCount(),2);
+    QCOMPARE(first_process.state(),ITask::TaskBusy);
+    QCOMPARE(pool.poolTask()->numberOfSubTasks(),3);
+
+    // Adding processes to the busy pool task notifies its views, without completing sub tasks:
+    QCOMPARE(sub_task_spy.count(),2);
+    QCOMPARE(sub_task_spy.at(0).at(0).toInt(),0);
+    QCOMPARE(sub_task_spy.at(1).at(0).toInt(),0);
+
+    // The process with the higher priority is started next:
+    QElapsedTimer timeout;
+    timeout.start();
+    while (first_process.state() == ITask::TaskBusy && timeout.elapsed() < 30000)
+        QTest::qWait(10);
+    QVERIFY(first_process.state() != ITask::TaskBusy);
+    QCOMPARE(high_priority_process.state(),ITask::TaskBusy);
+    QCOMPARE(low_priority_process.state(),ITask::TaskNotStarted);
+    QCOMPARE(pool.poolTask()->currentProgress(),1);
+
+    QVERIFY(qti_private_WaitForPool(pool));
+    QCOMPARE(low_priority_process.state(),ITask::TaskCompleted);
+    QCOMPARE(pool.poolTask()->state(),ITask::TaskCompleted);
+    QCOMPARE(finished_spy.count(),1);
+}
+
+void Qtilities::Testing::TestQtilitiesProcessPool::testConcurrencyLimit() {
+    QString program;
+    QStringList arguments;
+    qti_private_WaitCommand(1,&program,&arguments);
+
+    QtilitiesProcessPool pool("Concurrency Pool");
+    pool.setMaximumConcurrentProcesses(2);
+    QCOMPARE(pool.maximumConcurrentProcesses(),2);
+
+    QList<QtilitiesProcess*> processes;
+    for (int i = 0; i < 5; ++i) {
+        processes << new QtilitiesProcess(QString("Process %1").arg(i),false);
+        QVERIFY(pool.enqueue(processes.last(),program,arguments));
+    }
+    QCOMPARE(pool.runningCount(),2);
+    QCOMPARE(pool.pendingCount(),3);
+
+    int maximum_running = 0;
+    QElapsedTimer timeout;
+    timeout.start();
+    while ((pool.runningCount() > 0 || pool.pendingCount() > 0) && timeout.elapsed() < 30000) {
+        maximum_running = qMax(maximum_running,pool.runningCount());
+        QTest::qWait(10);
+    }
+    QCOMPARE(pool.runningCount(),0);
+    QCOMPARE(pool.pendingCount(),0);
+    QCOMPARE(maximum_running,2);
+    QCOMPARE(pool.poolTask()->currentProgress(),5);
+    for (int i = 0; i < processes.count(); ++i)
+        QCOMPARE(processes.at(i)->state(),ITask::TaskCompleted);
+
+    qDeleteAll(processes);
+}
+
+void Qtilities::Testing::TestQtilitiesProcessPool::testStopAll() {
+    QString program;
+    QStringList arguments;
+    qti_private_WaitCommand(30,&program,&arguments);
+
+    QtilitiesProcessPool pool("Stopped Pool");
+    pool.setMaximumConcurrentProcesses(1);
+    QSignalSpy process_finished_spy(&pool,SIGNAL(processFinished(Qtilities::Core::QtilitiesProcess*)));
+
+    QtilitiesProcess running_process("Running Process",false);
+    QtilitiesProcess queued_process("Queued Process",false);
+    QVERIFY(pool.enqueue(&running_process,program,arguments));
+    QVERIFY(pool.enqueue(&queued_process,program,arguments));
+    QCOMPARE(running_process.state(),ITask::TaskBusy);
+
+    // Stopping the pool task stops the pool:
+    pool.poolTask()->stop();
+    QCOMPARE(pool.pendingCount(),0);
+    QVERIFY(pool.poolTask()->state() != ITask::TaskBusy);
+    QVERIFY(qti_private_WaitForPool(pool,10000));
+    QVERIFY(running_process.state() != ITask::TaskBusy);
+    QCOMPARE(queued_process.state(),ITask::TaskNotStarted);
+    QVERIFY(queued_process.parentTask() == 0);
+    QCOMPARE(process_finished_spy.count(),1);
+
+    // Processes removed from the pool can be queued again:
+    QVERIFY(!pool.dequeue(&queued_process));
+    QVERIFY(pool.enqueue(&queued_process,program,arguments));
+    QCOMPARE(queued_process.state(),ITask::TaskBusy);
+    pool.stopAll();
+    QVERIFY(qti_private_WaitForPool(pool,10000));
+}
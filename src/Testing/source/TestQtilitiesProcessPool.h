@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_QTILITIES_PROCESS_POOL_H
+#define TEST_QTILITIES_PROCESS_POOL_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::QtilitiesProcessPool.
+        class TESTING_SHARED_EXPORT TestQtilitiesProcessPool: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("QtilitiesProcessPool"); }
+
+        private slots:
+            //! Tests that queued processes are started by priority and that the pool task reports the progress of the pool.
+            void testQueueing();
+            //! Tests that no more than maximumConcurrentProcesses() processes run at the same time.
+            void testConcurrencyLimit();
+            //! Tests that stopAll() stops the running processes and removes the queued processes.
+            void testStopAll();
+        };
+    }
+}
+
+#endif // TEST_QTILITIES_PROCESS_POOL_H
@@ -0,0 +1,165 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestSessionLogStore.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+#include <SessionLogStore>
+using namespace Qtilities::Logging;
+
+namespace {
+    // Adds a message with a single content to store.
+    void qti_private_AddMessage(SessionLogStore* store, const QString& engine_name, Logger::MessageType message_type, const QString& message, int task_id = -1) {
+        store->addMessage(engine_name,message_type,QList<QVariant>() << message,task_id);
+    }
+
+    // Returns the messages of entries.
+    QStringList qti_private_Messages(const QList<LogStoreEntry>& entries) {
+        QStringList messages;
+        foreach (const LogStoreEntry& entry, entries)
+            messages << entry.message;
+        return messages;
+    }
+}
+
+int Qtilities::Testing::TestSessionLogStore::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestSessionLogStore::testQuery() {
+    SessionLogStore store(1000);
+    qti_private_AddMessage(&store,QString(),Logger::Info,"Application started");
+    qti_private_AddMessage(&store,"Network",Logger::Warning,"Connection Refused by host",3);
+    qti_private_AddMessage(&store,"Network",Logger::Error,"Connection timed out",3);
+    qti_private_AddMessage(&store,"Storage",Logger::Error,"Disk full");
+    store.addMessage(QString(),Logger::Info,QList<QVariant>() << "Loaded" << 42 << "plugins",5);
+    QCOMPARE(store.count(), 5);
+    QCOMPARE(store.totalCount(), qint64(5));
+    QCOMPARE(store.engineNames(), QStringList() << "Network" << "Storage");
+    QCOMPARE(store.taskIds(), QList<int>() << 3 << 5);
+
+    // The default query returns all messages, newest first:
+    QList<LogStoreEntry> entries = store.query(LogQuery());
+    QCOMPARE(qti_private_Messages(entries), QStringList() << "Loaded 42 plugins" << "Disk full" << "Connection timed out" << "Connection Refused by host" << "Application started");
+    QCOMPARE(entries.front().sequence, qint64(4));
+    QCOMPARE(entries.front().task_id, 5);
+    QVERIFY(entries.front().timestamp >= entries.back().timestamp);
+
+    LogQuery query;
+    query.message_types = Logger::Error;
+    QCOMPARE(qti_private_Messages(store.query(query)), QStringList() << "Disk full" << "Connection timed out");
+
+    query = LogQuery();
+    query.engine_name = "Network";
+    entries = store.query(query);
+    QCOMPARE(entries.count(), 2);
+    QCOMPARE(entries.back().message_type, Logger::Warning);
+    QCOMPARE(entries.back().engine_name, QString("Network"));
+
+    query = LogQuery();
+    query.task_id = 3;
+    query.message_types = Logger::Warning;
+    QCOMPARE(qti_private_Messages(store.query(query)), QStringList() << "Connection Refused by host");
+
+    // Text is matched case insensitive, through the trigram index or by scanning for short text:
+    query = LogQuery();
+    query.text = "connection re";
+    QCOMPARE(qti_private_Messages(store.query(query)), QStringList() << "Connection Refused by host");
+    query.text = "ed";
+    QCOMPARE(store.query(query).count(), 4);
+    query.text = "not logged";
+    QVERIFY(store.query(query).isEmpty());
+
+    query = LogQuery();
+    query.pattern = QRegExp("^Connection .* (out|host)$");
+    QCOMPARE(store.query(query).count(), 2);
+    query.max_results = 1;
+    QCOMPARE(qti_private_Messages(store.query(query)), QStringList() << "Connection timed out");
+
+    // Messages are never newer than the current time:
+    query = LogQuery();
+    query.from = QDateTime::currentDateTime().addSecs(1);
+    QVERIFY(store.query(query).isEmpty());
+    query.from = QDateTime::currentDateTime().addSecs(-60);
+    query.to = QDateTime::currentDateTime().addSecs(1);
+    QCOMPARE(store.query(query).count(), 5);
+
+    store.clear();
+    QCOMPARE(store.count(), 0);
+    QVERIFY(store.query(LogQuery()).isEmpty());
+    QVERIFY(store.engineNames().isEmpty());
+}
+
+void Qtilities::Testing::TestSessionLogStore::testCapacity() {
+    SessionLogStore store(100);
+    QCOMPARE(store.capacity(), 100);
+
+    // Enough messages are added to overwrite the store many times, which compacts the indexes:
+    for (int i = 0; i < 3000; ++i)
+        qti_private_AddMessage(&store,QString("Engine %1").arg(i % 3),i % 2 ? Logger::Warning : Logger::Info,QString("Message %1").arg(i,4,10,QChar('0')),i % 7);
+    QCOMPARE(store.count(), 100);
+    QCOMPARE(store.totalCount(), qint64(3000));
+
+    LogQuery query;
+    query.max_results = 0;
+    QList<LogStoreEntry> entries = store.query(query);
+    QCOMPARE(entries.count(), 100);
+    QCOMPARE(entries.front().message, QString("Message 2999"));
+    QCOMPARE(entries.back().message, QString("Message 2900"));
+    QCOMPARE(entries.back().sequence, qint64(2900));
+
+    // Overwritten messages are not found through any of the indexes:
+    query.text = "Message 0042";
+    QVERIFY(store.query(query).isEmpty());
+    query.text = "Message 2942";
+    QCOMPARE(store.query(query).count(), 1);
+
+    query = LogQuery();
+    query.max_results = 0;
+    query.message_types = Logger::Warning;
+    query.engine_name = "Engine 1";
+    query.task_id = 2;
+    entries = store.query(query);
+    // Messages 2900 to 2999 which are odd, have i % 3 == 1 and i % 7 == 2, thus i % 42 == 37:
+    QCOMPARE(qti_private_Messages(entries), QStringList() << "Message 2977" << "Message 2935");
+}
+
+void Qtilities::Testing::TestSessionLogStore::testLoggerIntegration() {
+    const bool was_enabled = Log->sessionLogStoreEnabled();
+    if (!was_enabled)
+        Log->setSessionLogStoreEnabled(true,1000);
+    QVERIFY(Log->sessionLogStore());
+
+    Log->setCurrentTaskId(123456);
+    QCOMPARE(Log->currentTaskId(), 123456);
+    Log->logMessage(QString(),Logger::Warning,"Session Log Store Test Message");
+    Log->setCurrentTaskId(-1);
+    Log->logMessage(QString(),Logger::Warning,"Session Log Store Test Message Without Task");
+    // Messages which are dispatched asynchronously are added to the store when they are dispatched:
+    Log->flushMessages();
+
+    LogQuery query;
+    query.task_id = 123456;
+    QList<LogStoreEntry> entries = Log->sessionLogStore()->query(query);
+    QCOMPARE(qti_private_Messages(entries), QStringList() << "Session Log Store Test Message");
+    QCOMPARE(entries.front().message_type, Logger::Warning);
+
+    query = LogQuery();
+    query.text = "session log store test message";
+    QCOMPARE(Log->sessionLogStore()->query(query).count(), 2);
+
+    if (!was_enabled) {
+        Log->setSessionLogStoreEnabled(false);
+        QVERIFY(!Log->sessionLogStore());
+    }
+}
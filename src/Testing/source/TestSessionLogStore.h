@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_SESSION_LOG_STORE_H
+#define TEST_SESSION_LOG_STORE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Logging::SessionLogStore.
+        class TESTING_SHARED_EXPORT TestSessionLogStore: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("SessionLogStore"); }
+
+        private slots:
+            //! Tests queries by message type, engine, task, text, pattern and time range.
+            void testQuery();
+            //! Tests that only the newest messages are kept once the store is full.
+            void testCapacity();
+            //! Tests that messages logged through the logger are added to the store with the task ID of the logging thread.
+            void testLoggerIntegration();
+        };
+    }
+}
+
+#endif // TEST_SESSION_LOG_STORE_H
@@ -0,0 +1,157 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestSettingsStore.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+#include <SettingsStore>
+using namespace Qtilities::Logging;
+
+#include <QSettings>
+
+namespace {
+    // Returns the store of an empty settings file. Stores live until the application exits, thus a store used by an earlier run of the test is emptied:
+    SettingsStore* qti_private_EmptyStore(const QString& name) {
+        QDir().mkpath(QtilitiesApplication::applicationSessionPath() + "/TestSettingsStore");
+        const QString file_name = QtilitiesApplication::applicationSessionPath() + "/TestSettingsStore/" + name + ".ini";
+        SettingsStore* settings = SettingsStore::store(file_name);
+        settings->sync();
+        QFile::remove(file_name);
+        settings->reload();
+        return settings;
+    }
+
+    // The keys in the file of settings, read without using the store:
+    QStringList qti_private_FileKeys(SettingsStore* settings) {
+        QSettings file_settings(settings->fileName(),QSettings::IniFormat);
+        QStringList keys = file_settings.allKeys();
+        keys.sort();
+        return keys;
+    }
+
+    QVariant qti_private_FileValue(SettingsStore* settings, const QString& key) {
+        QSettings file_settings(settings->fileName(),QSettings::IniFormat);
+        return file_settings.value(key);
+    }
+}
+
+int Qtilities::Testing::TestSettingsStore::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestSettingsStore::testGroupsSavedToFile() {
+    SettingsStore* settings = qti_private_EmptyStore("Groups");
+    QVERIFY(settings->allKeys().isEmpty());
+
+    settings->setValue("Group/first",1);
+    settings->setValue("Group/Sub/second","Second");
+    settings->setValue("Other/third",3.5);
+    QCOMPARE(settings->childKeys("Group"),QStringList() << "first");
+    settings->sync();
+    QVERIFY(!settings->hasPendingWrites());
+    QCOMPARE(qti_private_FileKeys(settings),QStringList() << "Group/Sub/second" << "Group/first" << "Other/third");
+    QCOMPARE(qti_private_FileValue(settings,"Group/first").toInt(),1);
+    QCOMPARE(qti_private_FileValue(settings,"Group/Sub/second").toString(),QString("Second"));
+    QCOMPARE(qti_private_FileValue(settings,"Other/third").toDouble(),3.5);
+
+    // Removing a group removes all keys in it, including sub groups, and reports every removed key:
+    QSignalSpy value_changed_spy(settings,SIGNAL(valueChanged(QString,QVariant)));
+    settings->remove("Group");
+    QCOMPARE(value_changed_spy.count(),2);
+    for (int i = 0; i < value_changed_spy.count(); ++i) {
+        QVERIFY(value_changed_spy.at(i).at(0).toString().startsWith("Group/"));
+        QVERIFY(!value_changed_spy.at(i).at(1).value<QVariant>().isValid());
+    }
+    QVERIFY(!settings->contains("Group/first"));
+    QVERIFY(!settings->contains("Group/Sub/second"));
+    settings->sync();
+    QCOMPARE(qti_private_FileKeys(settings),QStringList() << "Other/third");
+
+    // Keys set after their group was removed in the same write are kept:
+    settings->setWriteDelay(60000);
+    settings->remove("Other");
+    settings->setValue("Other/fourth",4);
+    QVERIFY(settings->hasPendingWrites());
+    settings->sync();
+    QCOMPARE(qti_private_FileKeys(settings),QStringList() << "Other/fourth");
+    QCOMPARE(qti_private_FileValue(settings,"Other/fourth").toInt(),4);
+    settings->setWriteDelay(500);
+}
+
+void Qtilities::Testing::TestSettingsStore::testReloadNotifications() {
+    // Values are strings since that is how they are read back from ini files:
+    SettingsStore* settings = qti_private_EmptyStore("Reload");
+    settings->setValue("Values/changed","1");
+    settings->setValue("Values/removed","2");
+    settings->setValue("Values/unchanged","3");
+    settings->sync();
+
+    // Change the file outside of the store:
+    {
+        QSettings file_settings(settings->fileName(),QSettings::IniFormat);
+        file_settings.setValue("Values/changed","10");
+        file_settings.remove("Values/removed");
+        file_settings.setValue("Values/added","20");
+        file_settings.sync();
+    }
+    QCOMPARE(settings->value("Values/changed").toString(),QString("1"));
+
+    QSignalSpy value_changed_spy(settings,SIGNAL(valueChanged(QString,QVariant)));
+    settings->reload();
+    QMap<QString,QVariant> notifications;
+    for (int i = 0; i < value_changed_spy.count(); ++i)
+        notifications[value_changed_spy.at(i).at(0).toString()] = value_changed_spy.at(i).at(1).value<QVariant>();
+    QCOMPARE(value_changed_spy.count(),3);
+    QCOMPARE(notifications.keys(),QStringList() << "Values/added" << "Values/changed" << "Values/removed");
+    QCOMPARE(notifications.value("Values/added").toString(),QString("20"));
+    QCOMPARE(notifications.value("Values/changed").toString(),QString("10"));
+    QVERIFY(!notifications.value("Values/removed").isValid());
+
+    QCOMPARE(settings->value("Values/changed").toString(),QString("10"));
+    QVERIFY(!settings->contains("Values/removed"));
+    QCOMPARE(settings->value("Values/unchanged").toString(),QString("3"));
+
+    // Reloading an unchanged file does not notify anything:
+    value_changed_spy.clear();
+    settings->reload();
+    QCOMPARE(value_changed_spy.count(),0);
+}
+
+void Qtilities::Testing::TestSettingsStore::testSyncAll() {
+    SettingsStore* first = qti_private_EmptyStore("SyncAllFirst");
+    SettingsStore* second = qti_private_EmptyStore("SyncAllSecond");
+    first->setWriteDelay(60000);
+    second->setWriteDelay(60000);
+
+    first->setValue("Pending/value","First");
+    second->setValue("Pending/value","Second");
+    second->remove("Pending/missing");
+    QVERIFY(first->hasPendingWrites());
+    QVERIFY(second->hasPendingWrites());
+    QVERIFY(qti_private_FileKeys(first).isEmpty());
+    QVERIFY(qti_private_FileKeys(second).isEmpty());
+
+    // syncAll() is registered as a post routine of the application, thus this is what happens to pending writes at exit:
+    SettingsStore::syncAll();
+    QVERIFY(!first->hasPendingWrites());
+    QVERIFY(!second->hasPendingWrites());
+    QCOMPARE(qti_private_FileValue(first,"Pending/value").toString(),QString("First"));
+    QCOMPARE(qti_private_FileValue(second,"Pending/value").toString(),QString("Second"));
+
+    // The scheduled flushes find nothing left to save:
+    QTest::qWait(50);
+    QCOMPARE(qti_private_FileKeys(first),QStringList() << "Pending/value");
+
+    first->setWriteDelay(500);
+    second->setWriteDelay(500);
+}
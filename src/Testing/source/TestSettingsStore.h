@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_SETTINGS_STORE_H
+#define TEST_SETTINGS_STORE_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Logging::SettingsStore.
+        class TESTING_SHARED_EXPORT TestSettingsStore: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("SettingsStore"); }
+
+        private slots:
+            //! Tests setting and removing groups, and reading the saved file using a new QSettings object after sync().
+            void testGroupsSavedToFile();
+            //! Tests the valueChanged() notifications of reload() after the file was changed outside the store.
+            void testReloadNotifications();
+            //! Tests that pending writes are saved by syncAll(), which is also called when the application exits.
+            void testSyncAll();
+        };
+    }
+}
+
+#endif // TEST_SETTINGS_STORE_H
@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestStartupProfiler.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+namespace {
+    // The profiler records the startup of the application running the tests, thus only the spans in the test category are inspected.
+    const char * const qti_private_TEST_CATEGORY = "TestStartupProfiler";
+
+    QList<StartupProfileSpan> qti_private_TestSpans() {
+        QList<StartupProfileSpan> test_spans;
+        const QList<StartupProfileSpan> spans = StartupProfiler::instance()->spans();
+        for (int i = 0; i < spans.count(); ++i) {
+            if (spans.at(i).category == qti_private_TEST_CATEGORY)
+                test_spans << spans.at(i);
+        }
+        return test_spans;
+    }
+}
+
+int Qtilities::Testing::TestStartupProfiler::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestStartupProfiler::testRecordSpans() {
+    StartupProfiler* profiler = StartupProfiler::instance();
+    const bool is_enabled = profiler->isEnabled();
+    profiler->setEnabled(true);
+    const int span_count = qti_private_TestSpans().count();
+
+    profiler->recordSpan("Direct Span",qti_private_TEST_CATEGORY,100,350);
+    // Spans which end before they start are recorded with no duration:
+    profiler->recordSpan("Reversed Span",qti_private_TEST_CATEGORY,500,400);
+    const qint64 scope_start = profiler->elapsed();
+    {
+        StartupProfileScope scope("Scoped Span",qti_private_TEST_CATEGORY);
+        QTest::qSleep(5);
+    }
+
+    QList<StartupProfileSpan> spans = qti_private_TestSpans().mid(span_count);
+    QCOMPARE(spans.count(),3);
+    QCOMPARE(spans.at(0).name,QString("Direct Span"));
+    QCOMPARE(spans.at(0).start,Q_INT64_C(100));
+    QCOMPARE(spans.at(0).duration,Q_INT64_C(250));
+    QCOMPARE(spans.at(0).thread_id,(quint64) (quintptr) QThread::currentThreadId());
+    QCOMPARE(spans.at(1).duration,Q_INT64_C(0));
+    QCOMPARE(spans.at(2).name,QString("Scoped Span"));
+    QVERIFY(spans.at(2).start >= scope_start);
+    QVERIFY(spans.at(2).duration >= 5000);
+
+    profiler->setEnabled(false);
+    QVERIFY(!profiler->isEnabled());
+    profiler->recordSpan("Disabled Span",qti_private_TEST_CATEGORY,0,10);
+    {
+        StartupProfileScope scope("Disabled Scope",qti_private_TEST_CATEGORY);
+    }
+    QCOMPARE(qti_private_TestSpans().count(),span_count + 3);
+
+    profiler->setEnabled(is_enabled);
+}
+
+void Qtilities::Testing::TestStartupProfiler::testMaximumSpans() {
+    StartupProfiler* profiler = StartupProfiler::instance();
+    const bool is_enabled = profiler->isEnabled();
+    const int maximum_spans = profiler->maximumSpans();
+    profiler->setEnabled(true);
+
+    const int span_count = profiler->spans().count();
+    profiler->setMaximumSpans(span_count + 1);
+    QCOMPARE(profiler->maximumSpans(),span_count + 1);
+    profiler->recordSpan("Kept Span",qti_private_TEST_CATEGORY,0,10);
+    profiler->recordSpan("Discarded Span",qti_private_TEST_CATEGORY,10,20);
+    QCOMPARE(profiler->spans().count(),span_count + 1);
+    QCOMPARE(profiler->spans().last().name,QString("Kept Span"));
+
+    profiler->setMaximumSpans(maximum_spans);
+    profiler->setEnabled(is_enabled);
+}
+
+void Qtilities::Testing::TestStartupProfiler::testExportTrace() {
+    StartupProfiler* profiler = StartupProfiler::instance();
+    const bool is_enabled = profiler->isEnabled();
+    profiler->setEnabled(true);
+    profiler->recordSpan("Exported \"Span\" \\ with\nbreak",qti_private_TEST_CATEGORY,1000,1500);
+
+    QDir().mkpath(QtilitiesApplication::applicationSessionPath() + "/TestStartupProfiler");
+    const QString file_name = QtilitiesApplication::applicationSessionPath() + "/TestStartupProfiler/startup_profile.json";
+    QVERIFY(profiler->exportTrace(file_name));
+    QFile file(file_name);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QString contents = QString::fromUtf8(file.readAll());
+    file.close();
+    QFile::remove(file_name);
+
+    QVERIFY(contents.startsWith("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    QVERIFY(contents.endsWith("]}\n"));
+    QVERIFY(contents.contains("\"name\":\"thread_name\",\"ph\":\"M\""));
+    QVERIFY(contents.contains("{\"name\":\"Exported \\\"Span\\\" \\\\ with\\u000abreak\",\"cat\":\"TestStartupProfiler\",\"ph\":\"X\",\"ts\":1000,\"dur\":500,"));
+    QCOMPARE(contents.count("\"ph\":\"X\""),profiler->spans().count());
+
+    // Files which cannot be written are reported:
+    QVERIFY(!profiler->exportTrace(QtilitiesApplication::applicationSessionPath() + "/TestStartupProfiler/missing/startup_profile.json"));
+
+    profiler->setEnabled(is_enabled);
+}
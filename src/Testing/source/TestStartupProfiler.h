@@ -0,0 +1,54 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_STARTUP_PROFILER_H
+#define TEST_STARTUP_PROFILER_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::Core::StartupProfiler.
+        class TESTING_SHARED_EXPORT TestStartupProfiler: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("StartupProfiler"); }
+
+        private slots:
+            //! Tests recording spans directly and through StartupProfileScope, and that nothing is recorded while the profiler is disabled.
+            void testRecordSpans();
+            //! Tests that spans recorded once maximumSpans() is reached are discarded.
+            void testMaximumSpans();
+            //! Tests the trace written by exportTrace().
+            void testExportTrace();
+        };
+    }
+}
+
+#endif // TEST_STARTUP_PROFILER_H
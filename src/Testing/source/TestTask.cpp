@@ -14,6 +14,33 @@
 #include <QtilitiesCore>
 using namespace QtilitiesCore;
 
+namespace {
+    //! A job which completes a number of sub tasks.
+    class SubTaskJob : public TaskExecutorJob {
+    public:
+        SubTaskJob(int sub_tasks) : TaskExecutorJob(), sub_tasks(sub_tasks) {}
+
+        ITask::TaskResult execute() {
+            for (int i = 0; i < sub_tasks; ++i) {
+                if (!waitWhilePaused())
+                    return ITask::TaskFailed;
+                addCompletedSubTasks();
+            }
+            return ITask::TaskSuccessful;
+        }
+
+        int sub_tasks;
+    };
+
+    //! A job which fails.
+    class FailingJob : public TaskExecutorJob {
+    public:
+        ITask::TaskResult execute() {
+            return ITask::TaskFailed;
+        }
+    };
+}
+
 int Qtilities::Testing::TestTask::execTest(int argc, char ** argv) {
     return QTest::qExec(this,argc,argv);
 }
@@ -40,3 +67,142 @@ void Qtilities::Testing::TestTask::testBusyState() {
     QCOMPARE(task.state(), ITask::TaskCompleted);
     QCOMPARE(task.result(), ITask::TaskFailed);
 }
+
+void Qtilities::Testing::TestTask::testTaskExecutor() {
+    Task task("Executor Task");
+    TaskExecutor executor;
+    QVERIFY(executor.submit(&task,new SubTaskJob(10),10));
+    QCOMPARE(task.state(), ITask::TaskBusy);
+    // A task can only run one job at a time:
+    QVERIFY(!executor.submit(&task,new SubTaskJob(10),10));
+
+    QVERIFY(executor.waitForDone(10000));
+    QCOMPARE(executor.activeJobCount(), 0);
+    QCOMPARE(task.state(), ITask::TaskCompleted);
+    QCOMPARE(task.result(), ITask::TaskSuccessful);
+    QCOMPARE(task.currentProgress(), 10);
+}
+
+void Qtilities::Testing::TestTask::testTaskExecutorConcurrencyLimit() {
+    Task task("Executor Task");
+    TaskExecutor executor;
+    executor.setMaximumConcurrentJobs(task.taskType(),0);
+    QVERIFY(executor.submit(&task,new SubTaskJob(1)));
+    QCOMPARE(executor.pendingJobCount(), 1);
+    QCOMPARE(task.state(), ITask::TaskNotStarted);
+
+    executor.setMaximumConcurrentJobs(task.taskType(),1);
+    QCOMPARE(executor.pendingJobCount(), 0);
+    QVERIFY(executor.waitForDone(10000));
+    QCOMPARE(task.state(), ITask::TaskCompleted);
+}
+
+void Qtilities::Testing::TestTask::testTaskGraph() {
+    TaskExecutor executor;
+    TaskGraph graph("Graph",&executor);
+    int generate = graph.addNode(new Task("Generate"),new SubTaskJob(1));
+    int compile = graph.addNode(new Task("Compile"),new FailingJob);
+    int link = graph.addNode(new Task("Link"),new SubTaskJob(1));
+    int document = graph.addNode(new Task("Document"),new SubTaskJob(1));
+    QVERIFY(graph.addDependency(compile,generate));
+    QVERIFY(graph.addDependency(link,compile));
+    QVERIFY(graph.addDependency(document,generate));
+    // Cycles are not allowed:
+    QVERIFY(!graph.addDependency(generate,link));
+
+    QList<int> order = graph.topologicalOrder();
+    QCOMPARE(order.count(), 4);
+    QVERIFY(order.indexOf(generate) < order.indexOf(compile));
+    QVERIFY(order.indexOf(compile) < order.indexOf(link));
+
+    QSignalSpy spy(&graph,SIGNAL(graphFinished(bool)));
+    QVERIFY(graph.start());
+    QVERIFY(executor.waitForDone(10000));
+
+    QCOMPARE(graph.nodeState(generate), TaskGraph::NodeSucceeded);
+    QCOMPARE(graph.nodeState(compile), TaskGraph::NodeFailed);
+    QCOMPARE(graph.nodeState(link), TaskGraph::NodeSkipped);
+    QCOMPARE(graph.nodeState(document), TaskGraph::NodeSucceeded);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toBool(), false);
+    QCOMPARE(graph.graphTask()->result(), ITask::TaskFailed);
+}
+
+void Qtilities::Testing::TestTask::testMessageRing() {
+    TaskMessageRing ring(3,8);
+    // The capacity is rounded up to a power of two:
+    QCOMPARE(ring.capacity(), 4);
+    for (int i = 1; i <= 6; ++i)
+        ring.append(QString("Message %1").arg(i),i == 6 ? Logger::Error : Logger::Info);
+
+    QList<TaskMessageRing::Message> messages = ring.messages();
+    QCOMPARE(messages.count(), 4);
+    QCOMPARE(messages.first().sequence, (quint32) 3);
+    // Messages are truncated to the maximum message size:
+    QCOMPARE(messages.first().message, QString("Message "));
+    QCOMPARE(messages.last().type, Logger::Error);
+
+    QCOMPARE(ring.messagesSince(5).count(), 1);
+    QCOMPARE(ring.messages(2).count(), 2);
+    ring.clear();
+    QCOMPARE(ring.messages().count(), 0);
+    ring.append("After Clear");
+    QCOMPARE(ring.messagesSince(0).count(), 1);
+
+    Task task("Ring Task");
+    task.enableMessageRing();
+    task.setLoggerForwardingEnabled(false);
+    task.setLastErrorMessagesStackSize(2);
+    task.startTask();
+    task.logError("Error 1");
+    task.logError("Error 2");
+    task.logError("Error 3");
+    QCOMPARE(task.lastErrorMessages(), QStringList() << "Error 3" << "Error 2");
+    QCOMPARE(task.messageRing()->messages().count(), 3);
+    task.completeTask();
+}
+
+void Qtilities::Testing::TestTask::testTaskTrace() {
+    TASK_MANAGER->clearTaskTrace();
+    TASK_MANAGER->setTaskTracingEnabled(true);
+
+    Task parent_task("Trace Parent");
+    Task task("Trace \"Task\"");
+    task.setParentTask(&parent_task);
+    task.startTask(2);
+    task.addCompletedSubTasks(1);
+    task.pauseTask();
+    task.resumeTask();
+    task.addCompletedSubTasks(1);
+    task.completeTask();
+    TASK_MANAGER->setTaskTracingEnabled(false);
+
+    // Events are not recorded once tracing is disabled:
+    task.startTask();
+    task.completeTask();
+
+    QList<TaskTraceEvent> events = TASK_MANAGER->taskTraceEvents();
+    QCOMPARE(events.count(), 6);
+    QCOMPARE(events.at(0).event_type, TaskTraceEvent::TaskStarted);
+    QCOMPARE(events.at(0).parent_task_name, QString("Trace Parent"));
+    QCOMPARE(events.at(1).event_type, TaskTraceEvent::TaskSubTasksCompleted);
+    QCOMPARE(events.at(2).event_type, TaskTraceEvent::TaskPaused);
+    QCOMPARE(events.at(3).event_type, TaskTraceEvent::TaskResumed);
+    QCOMPARE(events.at(5).event_type, TaskTraceEvent::TaskCompleted);
+    QVERIFY(events.at(5).timestamp >= events.at(0).timestamp);
+
+    QString file_name = QDir::tempPath() + "/qtilities_task_trace.json";
+    QVERIFY(TASK_MANAGER->exportTaskTrace(file_name));
+    QFile file(file_name);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QString contents = QString::fromUtf8(file.readAll());
+    file.close();
+    QFile::remove(file_name);
+    QVERIFY(contents.startsWith("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    QVERIFY(contents.contains("\"name\":\"Trace \\\"Task\\\"\""));
+    QCOMPARE(contents.count("\"ph\":\"b\""), 2);
+    QCOMPARE(contents.count("\"ph\":\"e\""), 2);
+
+    TASK_MANAGER->clearTaskTrace();
+    QCOMPARE(TASK_MANAGER->taskTraceEvents().count(), 0);
+}
@@ -43,6 +43,16 @@ namespace Qtilities {
         private slots:
             //! Tests related to the busy state of the task.
             void testBusyState();
+            //! Tests running a job using Qtilities::Core::TaskExecutor.
+            void testTaskExecutor();
+            //! Tests the limits set using Qtilities::Core::TaskExecutor::setMaximumConcurrentJobs().
+            void testTaskExecutorConcurrencyLimit();
+            //! Tests the scheduling and failure propagation of Qtilities::Core::TaskGraph.
+            void testTaskGraph();
+            //! Tests Qtilities::Core::TaskMessageRing and the last error messages of a task.
+            void testMessageRing();
+            //! Tests the task trace recorded by Qtilities::Core::TaskManager.
+            void testTaskTrace();
         };
     }
 }
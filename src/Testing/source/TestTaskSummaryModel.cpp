@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestTaskSummaryModel.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QElapsedTimer>
+
+namespace {
+    // Waits until model has row_count rows. Returns false if it did not have them within ten seconds.
+    bool qti_private_WaitForRows(const TaskSummaryModel& model, int row_count) {
+        QElapsedTimer timer;
+        timer.start();
+        while (model.rowCount() != row_count && timer.elapsed() < 10000)
+            QTest::qWait(10);
+        return model.rowCount() == row_count;
+    }
+}
+
+int Qtilities::Testing::TestTaskSummaryModel::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestTaskSummaryModel::testRefreshBatching() {
+    TaskSummaryModel model;
+    model.setRefreshInterval(50);
+    QCOMPARE(model.refreshInterval(), 50);
+
+    Task task1("Summary Task 1");
+    Task task2("Summary Task 2");
+    model.addTask(&task1);
+    model.addTask(&task2);
+    QVERIFY(model.containsTask(task1.taskID()));
+    QCOMPARE(model.displayedTaskCount(), 0);
+
+    // Displayed tasks are only added to the rows during the next refresh, the newest task at the top:
+    model.setTaskDisplayed(task1.taskID(),true);
+    model.setTaskDisplayed(task2.taskID(),true);
+    QVERIFY(model.isTaskDisplayed(task1.taskID()));
+    QCOMPARE(model.rowCount(), 0);
+    QVERIFY(qti_private_WaitForRows(model,2));
+    QCOMPARE(model.index(0).data(TaskSummaryModel::TaskIdRole).toInt(), task2.taskID());
+    QCOMPARE(model.index(1).data().toString(), QString("Summary Task 1"));
+
+    // Thousands of notifications are applied to the rows in a single update:
+    QSignalSpy data_changed_spy(&model,SIGNAL(dataChanged(QModelIndex,QModelIndex)));
+    task1.startTask(1000);
+    for (int i = 0; i < 1000; ++i)
+        task1.addCompletedSubTasks(1);
+    QCOMPARE(data_changed_spy.count(), 0);
+    QTest::qWait(200);
+    QCOMPARE(data_changed_spy.count(), 1);
+    QCOMPARE(model.index(1).data(TaskSummaryModel::ProgressRole).toInt(), task1.currentProgress());
+    QCOMPARE(model.index(1).data(TaskSummaryModel::SubTaskCountRole).toInt(), 1000);
+    QCOMPARE(model.index(1).data(TaskSummaryModel::StateRole).toInt(), (int) ITask::TaskBusy);
+
+    // Changes to tasks which are not displayed do not cause updates:
+    model.setTaskDisplayed(task2.taskID(),false);
+    model.refresh();
+    QCOMPARE(model.rowCount(), 1);
+    data_changed_spy.clear();
+    task2.startTask(10);
+    QTest::qWait(200);
+    QCOMPARE(data_changed_spy.count(), 0);
+    task1.completeTask(ITask::TaskSuccessful);
+    task2.completeTask(ITask::TaskSuccessful);
+}
+
+void Qtilities::Testing::TestTaskSummaryModel::testFinishedTasks() {
+    TaskSummaryModel model;
+    QVERIFY(model.aggregateFinishedTasks());
+
+    Task successful_task("Successful Task");
+    Task failed_task("Failed Task");
+    Task busy_task("Busy Task");
+    Task* deleted_task = new Task("Deleted Task");
+    QList<Task*> tasks;
+    tasks << &successful_task << &failed_task << &busy_task << deleted_task;
+    foreach (Task* task, tasks) {
+        model.addTask(task);
+        model.setTaskDisplayed(task->taskID(),true);
+        task->startTask();
+    }
+    model.refresh();
+    QCOMPARE(model.rowCount(), 4);
+
+    // The rows of deleted tasks are removed immediately:
+    const int deleted_task_id = deleted_task->taskID();
+    delete deleted_task;
+    QCOMPARE(model.rowCount(), 3);
+    QVERIFY(!model.containsTask(deleted_task_id));
+
+    // Only tasks which finished are counted when they are no longer displayed:
+    successful_task.completeTask(ITask::TaskSuccessful);
+    failed_task.completeTask(ITask::TaskFailed);
+    model.setTaskDisplayed(successful_task.taskID(),false);
+    model.setTaskDisplayed(failed_task.taskID(),false);
+    model.setTaskDisplayed(busy_task.taskID(),false);
+    model.refresh();
+    QCOMPARE(model.finishedTaskCount(), 2);
+    QCOMPARE(model.displayedTaskCount(), 0);
+    QCOMPARE(model.rowCount(), 1);
+    QModelIndex summary_index = model.index(0);
+    QVERIFY(summary_index.data(TaskSummaryModel::SummaryRowRole).toBool());
+    QCOMPARE(summary_index.data(TaskSummaryModel::TaskIdRole).toInt(), -1);
+    const QString summary_text = summary_index.data().toString();
+    QVERIFY(summary_text.contains("2 finished tasks"));
+    QVERIFY(summary_text.contains("1 successful"));
+    QVERIFY(summary_text.contains("1 failed"));
+
+    model.clearFinishedTasks();
+    model.refresh();
+    QCOMPARE(model.finishedTaskCount(), 0);
+    QCOMPARE(model.rowCount(), 0);
+
+    // Without aggregation finished tasks disappear:
+    model.setAggregateFinishedTasks(false);
+    model.setTaskDisplayed(successful_task.taskID(),true);
+    model.refresh();
+    QCOMPARE(model.rowCount(), 1);
+    model.setTaskDisplayed(successful_task.taskID(),false);
+    model.refresh();
+    QCOMPARE(model.rowCount(), 0);
+    QCOMPARE(model.finishedTaskCount(), 0);
+
+    busy_task.completeTask(ITask::TaskSuccessful);
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_TASK_SUMMARY_MODEL_H
+#define TEST_TASK_SUMMARY_MODEL_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::CoreGui::TaskSummaryModel.
+        class TESTING_SHARED_EXPORT TestTaskSummaryModel: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("TaskSummaryModel"); }
+
+        private slots:
+            //! Tests that rows are added and task changes are applied once per refresh interval instead of once per notification.
+            void testRefreshBatching();
+            //! Tests that finished tasks which are no longer displayed are counted in the summary row.
+            void testFinishedTasks();
+        };
+    }
+}
+
+#endif // TEST_TASK_SUMMARY_MODEL_H
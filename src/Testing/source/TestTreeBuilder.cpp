@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestTreeBuilder.h"
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QBuffer>
+
+namespace {
+    // A row source which generates count rows, alternating between the "Even" and "Odd" categories.
+    class qti_private_CountingRowSource : public TreeBuilder::RowSource {
+    public:
+        qti_private_CountingRowSource(int count) : d_count(count), d_next(0) {}
+
+        bool readRow(TreeBuilder::Row& row) {
+            if (d_next == d_count)
+                return false;
+            row.name = QString("Row %1").arg(d_next);
+            row.category = QtilitiesCategory(d_next % 2 ? "Odd" : "Even");
+            ++d_next;
+            return true;
+        }
+
+    private:
+        int d_count;
+        int d_next;
+    };
+}
+
+int Qtilities::Testing::TestTreeBuilder::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestTreeBuilder::testStreamedRows() {
+    qRegisterMetaType<QList<QPointer<QObject> > >("QList<QPointer<QObject> >");
+
+    TreeNode node("Builder Node");
+    node.enableCategorizedDisplay();
+    QSignalSpy layout_spy(&node,SIGNAL(layoutChanged(QList<QPointer<QObject> >)));
+
+    TreeBuilder builder(&node);
+    QCOMPARE(builder.treeNode(), &node);
+    qti_private_CountingRowSource source(100);
+    QCOMPARE(builder.addRows(&source), 100);
+
+    // Lines are split into names and categories, empty lines are skipped:
+    QByteArray csv("Bolt M8,Hardware::Bolts\n\n  Nut M8 , Hardware::Nuts \nWasher\n");
+    QBuffer device(&csv);
+    QCOMPARE(builder.addRows(&device), 3);
+    QCOMPARE(builder.rowCount(), 103);
+    QCOMPARE(builder.categoryCount(), 5);
+
+    QString reject_msg;
+    QList<TreeItem*> items = builder.finish(&reject_msg);
+    QVERIFY(reject_msg.isEmpty());
+    QCOMPARE(items.count(), 103);
+    QCOMPARE(node.subjectCount(), 103);
+    QCOMPARE(layout_spy.count(), 1);
+
+    // Items are grouped by category in the order in which the categories were seen:
+    QCOMPARE(items.at(0)->objectName(), QString("Row 0"));
+    QCOMPARE(items.at(1)->objectName(), QString("Row 2"));
+    QCOMPARE(items.at(50)->objectName(), QString("Row 1"));
+    QCOMPARE(node.subjectCategoryInContext(items.at(50)), QtilitiesCategory("Odd"));
+    QCOMPARE(node.subjectNamesByCategory(QtilitiesCategory("Even")).count(), 50);
+    QCOMPARE(node.subjectNamesByCategory(QtilitiesCategory("Hardware::Bolts","::")), QStringList() << "Bolt M8");
+    QCOMPARE(node.subjectNamesByCategory(QtilitiesCategory("Hardware::Nuts","::")), QStringList() << "Nut M8");
+    QVERIFY(!node.subjectCategoryInContext(items.last()).isValid());
+    QCOMPARE(items.last()->objectName(), QString("Washer"));
+}
+
+void Qtilities::Testing::TestTreeBuilder::testFinish() {
+    TreeNode* node = new TreeNode("Builder Node");
+    node->addItem("Existing Item");
+
+    QPointer<TreeItem> item;
+    {
+        TreeBuilder builder(node);
+        builder.addRows(QStringList() << "Item 1" << "Item 2",QtilitiesCategory("Category"));
+        builder.addRow("Item 3");
+        QCOMPARE(node->subjectCount(), 1);
+
+        builder.clear();
+        QCOMPARE(builder.rowCount(), 0);
+        QCOMPARE(builder.categoryCount(), 0);
+        QVERIFY(builder.finish().isEmpty());
+        QCOMPARE(node->subjectCount(), 1);
+
+        // The builder is empty after finish() and can be used again:
+        builder.addRow("Item 4");
+        QCOMPARE(builder.finish().count(), 1);
+        QCOMPARE(builder.rowCount(), 0);
+        builder.addRow("Item 5");
+        QList<TreeItem*> items = builder.finish();
+        QCOMPARE(items.count(), 1);
+        item = items.first();
+
+        // Rows which are not finished are discarded:
+        builder.addRow("Discarded Item");
+    }
+    QCOMPARE(node->subjectNames(), QStringList() << "Existing Item" << "Item 4" << "Item 5");
+
+    // TreeNode::addItems() uses the builder:
+    node->addItems(QStringList() << "Item 6" << "Item 7",QtilitiesCategory("Category"));
+    QCOMPARE(node->subjectNamesByCategory(QtilitiesCategory("Category")), QStringList() << "Item 6" << "Item 7");
+
+    delete node;
+    QVERIFY(!item);
+}
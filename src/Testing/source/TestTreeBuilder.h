@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_TREE_BUILDER_H
+#define TEST_TREE_BUILDER_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of Qtilities::CoreGui::TreeBuilder.
+        class TESTING_SHARED_EXPORT TestTreeBuilder: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("TreeBuilder"); }
+
+        private slots:
+            //! Tests that rows from a row source and a text device are attached as categorized items with a single layout change.
+            void testStreamedRows();
+            //! Tests that the builder does not change the node until finish() is called, and that it can be reused afterwards.
+            void testFinish();
+        };
+    }
+}
+
+#endif // TEST_TREE_BUILDER_H
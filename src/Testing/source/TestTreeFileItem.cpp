@@ -21,3 +21,21 @@ int Qtilities::Testing::TestTreeFileItem::execTest(int argc, char ** argv) {
 void Qtilities::Testing::TestTreeFileItem::testMe() {
 
 }
+
+void Qtilities::Testing::TestTreeFileItem::testExists() {
+    const QString file_path = QtilitiesApplication::applicationSessionPath() + "/testTreeFileItemExists.txt";
+    QFile::remove(file_path);
+
+    TreeFileItem item(file_path);
+    QVERIFY(!item.exists());
+
+    // Changes are reported directly, without waiting for file system notifications:
+    QVERIFY(FileUtils::writeTextFile(file_path,"Test"));
+    QVERIFY(item.exists());
+    QVERIFY(QFile::remove(file_path));
+    QVERIFY(!item.exists());
+    QVERIFY(FileUtils::writeTextFile(file_path,"Test"));
+    QVERIFY(item.exists());
+
+    QVERIFY(QFile::remove(file_path));
+}
@@ -43,6 +43,8 @@ namespace Qtilities {
         private slots:
             //! Tests operator overload: ==
             void testMe();
+            //! Tests that exists() reflects files which are created and removed immediately.
+            void testExists();
         };
     }
 }
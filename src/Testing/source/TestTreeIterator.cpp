@@ -371,3 +371,43 @@ void Testing::TestTreeIterator::testIterationForwardMultipleParentsC() {
 //    }
 }
 
+void Testing::TestTreeIterator::testStackIterationMultipleParents() {
+    TreeNode* rootNode = new TreeNode("Root");
+    TreeNode* parentNode1 = rootNode->addNode("Parent 1");
+    TreeNode* parentNode2 = rootNode->addNode("Parent 2");
+    parentNode1->addItem("Child 1");
+    TreeItem* shared_item = parentNode2->addItem("Shared");
+    parentNode2->addItem("Child 2");
+    parentNode1->attachSubject(shared_item);
+
+    QStringList expected;
+    expected << "Root" << "Parent 1" << "Child 1" << "Shared" << "Parent 2" << "Shared" << "Child 2";
+
+    // Iterate forward:
+    TreeIterator itr(rootNode,TreeIterator::StackIteration);
+    QStringList testList;
+    testList << itr.current()->objectName();
+    while (itr.hasNext())
+        testList << itr.next()->objectName();
+    QCOMPARE(testList, expected);
+    QVERIFY(!itr.next());
+    QCOMPARE(itr.current()->objectName(), QString("Child 2"));
+
+    // Iterate backwards:
+    testList.clear();
+    testList.prepend(itr.current()->objectName());
+    while (itr.hasPrevious())
+        testList.prepend(itr.previous()->objectName());
+    QCOMPARE(testList, expected);
+    QCOMPARE(itr.current(), rootNode);
+    QCOMPARE(itr.last()->objectName(), QString("Child 2"));
+
+    // Stack iteration must not leave any iterator properties on the subjects:
+    QVERIFY(!ObjectManager::propertyExists(shared_item,qti_prop_TREE_ITERATOR_SOURCE_OBS));
+
+    QCOMPARE(rootNode->treeCount(), 6);
+    QCOMPARE(rootNode->treeChildren().count(), 6);
+    QVERIFY(!ObjectManager::propertyExists(shared_item,qti_prop_TREE_ITERATOR_SOURCE_OBS));
+
+    delete rootNode;
+}
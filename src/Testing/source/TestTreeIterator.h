@@ -60,6 +60,8 @@ namespace Qtilities {
             void testIterationBackwardComplexA();
             //! Tests forward interation through a tree with items that appear in more than once tree.
             void testIterationForwardMultipleParentsC();
+            //! Tests TreeIterator::StackIteration through a tree with a subject which has multiple parents.
+            void testStackIterationMultipleParents();
         };
     }
 }
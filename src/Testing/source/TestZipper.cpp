@@ -0,0 +1,415 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "TestZipper.h"
+
+#include <QtilitiesCore>
+using namespace QtilitiesCore;
+
+#include <QBuffer>
+#include <QElapsedTimer>
+
+namespace {
+    // Exposes executeCommand(), thus any program can stand in for 7za:
+    class ZipperCommandRunner : public Zipper {
+    public:
+        ZipperCommandRunner(const QString& program) : Zipper(program) {}
+        bool runCommand(const QStringList& arguments, QStringList* errorMsgs = 0) {
+            return executeCommand(arguments,errorMsgs);
+        }
+    };
+
+    QString qti_private_TestPath(const QString& name) {
+        return QtilitiesCoreApplication::applicationSessionPath() + "/TestZipper/" + name;
+    }
+
+    bool qti_private_WriteFile(const QString& file_path, const QByteArray& data) {
+        QDir().mkpath(QFileInfo(file_path).absolutePath());
+        QFile file(file_path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            return false;
+        return file.write(data) == data.size();
+    }
+
+    QByteArray qti_private_ReadFile(const QString& file_path) {
+        QFile file(file_path);
+        if (!file.open(QIODevice::ReadOnly))
+            return QByteArray();
+        return file.readAll();
+    }
+
+    // Text which deflate compresses well, larger than the 64 KiB which fits in a single stored deflate block.
+    QByteArray qti_private_TextData() {
+        QByteArray data;
+        for (int i = 0; i < 5000; ++i)
+            data.append(QString("Line %1 of the text which is compressed by the zipper.\n").arg(i).toLatin1());
+        return data;
+    }
+
+    // Pseudo random data larger than 64 KiB, which does not become smaller when it is deflated and is therefore stored.
+    QByteArray qti_private_RandomData() {
+        QByteArray data;
+        data.resize(100 * 1024);
+        quint32 seed = 12345;
+        for (int i = 0; i < data.size(); ++i) {
+            seed = seed * 1103515245 + 12345;
+            data[i] = (char) (seed >> 16);
+        }
+        return data;
+    }
+
+    // The files zipped by the tests, relative to the source folder:
+    QMap<QString,QByteArray> qti_private_SourceFiles() {
+        QMap<QString,QByteArray> files;
+        files["empty.txt"] = QByteArray();
+        files["small.txt"] = QByteArray("Hello Qtilities");
+        files["Folder/text.txt"] = qti_private_TextData();
+        files["Folder/random.bin"] = qti_private_RandomData();
+        return files;
+    }
+
+    bool qti_private_CreateSourceFolder(const QString& folder_path) {
+        FileUtils::removeDir(folder_path);
+        QMap<QString,QByteArray> files = qti_private_SourceFiles();
+        QMapIterator<QString,QByteArray> itr(files);
+        while (itr.hasNext()) {
+            itr.next();
+            if (!qti_private_WriteFile(folder_path + "/" + itr.key(),itr.value()))
+                return false;
+        }
+        return true;
+    }
+
+    // Reads the compression method of each entry from the central directory of an archive without a comment.
+    QMap<QString,quint16> qti_private_EntryMethods(const QString& file_path) {
+        QMap<QString,quint16> methods;
+        QFile file(file_path);
+        if (!file.open(QIODevice::ReadOnly) || file.size() < 22)
+            return methods;
+        QDataStream stream(&file);
+        stream.setByteOrder(QDataStream::LittleEndian);
+
+        quint32 signature, directory_size, directory_offset;
+        quint16 entry_count;
+        file.seek(file.size() - 22);
+        stream >> signature;
+        stream.skipRawData(6);
+        stream >> entry_count >> directory_size >> directory_offset;
+        if (signature != 0x06054b50)
+            return methods;
+
+        file.seek(directory_offset);
+        for (int i = 0; i < entry_count; ++i) {
+            quint16 method, name_length, extra_length, comment_length;
+            stream >> signature;
+            stream.skipRawData(6);
+            stream >> method;
+            stream.skipRawData(16);
+            stream >> name_length >> extra_length >> comment_length;
+            stream.skipRawData(12);
+            QByteArray name = file.read(name_length);
+            stream.skipRawData(extra_length + comment_length);
+            if (signature != 0x02014b50)
+                return QMap<QString,quint16>();
+            methods[QString::fromUtf8(name.constData(),name.size())] = method;
+        }
+        return methods;
+    }
+}
+
+int Qtilities::Testing::TestZipper::execTest(int argc, char ** argv) {
+    return QTest::qExec(this,argc,argv);
+}
+
+void Qtilities::Testing::TestZipper::testRoundTrip_data() {
+    QTest::addColumn<int>("Mode");
+    QTest::newRow("CompressMode") << (int) Zipper::CompressMode;
+    QTest::newRow("CopyMode") << (int) Zipper::CopyMode;
+}
+
+void Qtilities::Testing::TestZipper::testRoundTrip() {
+    QFETCH(int, Mode);
+
+    const QString source_path = qti_private_TestPath("RoundTripSource");
+    const QString destination_path = qti_private_TestPath("RoundTripDestination");
+    const QString archive = qti_private_TestPath("RoundTrip.zip");
+    QVERIFY(qti_private_CreateSourceFolder(source_path));
+    FileUtils::removeDir(destination_path);
+
+    Zipper zipper(QString());
+    zipper.setBackend(Zipper::InProcessBackend);
+    QStringList errors;
+    QVERIFY(zipper.zipFolder(source_path + "/*",archive,(Zipper::ZipMode) Mode,&errors));
+    QVERIFY(errors.isEmpty());
+
+    // Check the entries in the archive:
+    QMap<QString,QByteArray> files = qti_private_SourceFiles();
+    bool ok;
+    QStringList entries = zipper.archiveEntries(archive,&ok);
+    QVERIFY(ok);
+    QCOMPARE(entries.count(),files.count() + 1);
+    QVERIFY(entries.contains("Folder/"));
+    foreach (const QString& file_name, files.keys())
+        QVERIFY(entries.contains(file_name));
+
+    // Only compressible files are deflated in CompressMode, everything else is stored:
+    QMap<QString,quint16> methods = qti_private_EntryMethods(archive);
+    QCOMPARE(methods.count(),entries.count());
+    QCOMPARE(methods["empty.txt"],(quint16) 0);
+    QCOMPARE(methods["Folder/random.bin"],(quint16) 0);
+    if (Mode == Zipper::CompressMode) {
+        QCOMPARE(methods["Folder/text.txt"],(quint16) 8);
+        QVERIFY(QFileInfo(archive).size() < files["Folder/text.txt"].size() + files["Folder/random.bin"].size());
+    } else {
+        QCOMPARE(methods["Folder/text.txt"],(quint16) 0);
+        QVERIFY(QFileInfo(archive).size() > files["Folder/text.txt"].size() + files["Folder/random.bin"].size());
+    }
+
+    // Extract the archive and compare the extracted files:
+    QVERIFY(zipper.unzipFolder(archive,destination_path,QStringList(),&errors));
+    QVERIFY(errors.isEmpty());
+    QMapIterator<QString,QByteArray> itr(files);
+    while (itr.hasNext()) {
+        itr.next();
+        const QString file_path = destination_path + "/" + itr.key();
+        QVERIFY(QFileInfo(file_path).isFile());
+        QCOMPARE(QFileInfo(file_path).size(),(qint64) itr.value().size());
+        QVERIFY(qti_private_ReadFile(file_path) == itr.value());
+    }
+
+    FileUtils::removeDir(source_path);
+    FileUtils::removeDir(destination_path);
+    QFile::remove(archive);
+}
+
+void Qtilities::Testing::TestZipper::testExtractEntry() {
+    const QString source_path = qti_private_TestPath("ExtractEntrySource");
+    const QString archive = qti_private_TestPath("ExtractEntry.zip");
+    QVERIFY(qti_private_CreateSourceFolder(source_path));
+
+    Zipper zipper(QString());
+    zipper.setBackend(Zipper::InProcessBackend);
+    QVERIFY(zipper.zipFolder(source_path + "/*",archive));
+
+    QMap<QString,QByteArray> files = qti_private_SourceFiles();
+    QMapIterator<QString,QByteArray> itr(files);
+    while (itr.hasNext()) {
+        itr.next();
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY(zipper.extractEntry(archive,itr.key(),&buffer));
+        QVERIFY(data == itr.value());
+    }
+
+    // Entries which do not exist, and devices which are not writable:
+    QStringList errors;
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    QVERIFY(!zipper.extractEntry(archive,"missing.txt",&buffer,&errors));
+    QCOMPARE(errors.count(),1);
+    QVERIFY(data.isEmpty());
+    QBuffer read_only_buffer;
+    read_only_buffer.open(QIODevice::ReadOnly);
+    QVERIFY(!zipper.extractEntry(archive,"small.txt",&read_only_buffer));
+
+    FileUtils::removeDir(source_path);
+    QFile::remove(archive);
+}
+
+void Qtilities::Testing::TestZipper::testCorruptArchive() {
+    const QString source_path = qti_private_TestPath("CorruptSource");
+    const QString destination_path = qti_private_TestPath("CorruptDestination");
+    QVERIFY(qti_private_CreateSourceFolder(source_path));
+
+    Zipper zipper(QString());
+    zipper.setBackend(Zipper::InProcessBackend);
+
+    // Corrupt the data of a deflated entry and of a stored entry. Each archive contains a single entry, thus its data follows the
+    // local header, which is 30 bytes long followed by the entry name:
+    QStringList file_names;
+    file_names << "text.txt" << "random.bin";
+    foreach (const QString& file_name, file_names) {
+        const QString archive = qti_private_TestPath("Corrupt.zip");
+        QVERIFY(zipper.zipFiles(QStringList(source_path + "/Folder/" + file_name),archive));
+
+        QByteArray archive_data = qti_private_ReadFile(archive);
+        const int data_position = 30 + file_name.size();
+        QVERIFY(archive_data.size() > data_position + 1000);
+        archive_data[data_position + 1000] = (char) ~archive_data.at(data_position + 1000);
+        QVERIFY(qti_private_WriteFile(archive,archive_data));
+
+        // The central directory is still valid, thus the entries can be listed but not extracted:
+        bool ok;
+        QCOMPARE(zipper.archiveEntries(archive,&ok),QStringList(file_name));
+        QVERIFY(ok);
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        QStringList errors;
+        QVERIFY(!zipper.extractEntry(archive,file_name,&buffer,&errors));
+        QCOMPARE(errors.count(),1);
+        QVERIFY(data.isEmpty());
+
+        FileUtils::removeDir(destination_path);
+        errors.clear();
+        QVERIFY(!zipper.unzipFolder(archive,destination_path,QStringList(),&errors));
+        QCOMPARE(errors.count(),1);
+        QVERIFY(!QFile::exists(destination_path + "/" + file_name));
+        QFile::remove(archive);
+    }
+
+    FileUtils::removeDir(source_path);
+    FileUtils::removeDir(destination_path);
+}
+
+void Qtilities::Testing::TestZipper::testTruncatedArchive() {
+    const QString source_path = qti_private_TestPath("TruncatedSource");
+    const QString destination_path = qti_private_TestPath("TruncatedDestination");
+    const QString archive = qti_private_TestPath("Truncated.zip");
+    QVERIFY(qti_private_CreateSourceFolder(source_path));
+
+    Zipper zipper(QString());
+    zipper.setBackend(Zipper::InProcessBackend);
+    QVERIFY(zipper.zipFolder(source_path + "/*",archive));
+    const QByteArray archive_data = qti_private_ReadFile(archive);
+
+    // Truncate the archive in the central directory, in the data of the entries and right after the signature of the first entry:
+    QList<int> sizes;
+    sizes << archive_data.size() - 10 << archive_data.size() / 2 << 4;
+    foreach (int size, sizes) {
+        QVERIFY(qti_private_WriteFile(archive,archive_data.left(size)));
+
+        bool ok = true;
+        QStringList errors;
+        QVERIFY(zipper.archiveEntries(archive,&ok,&errors).isEmpty());
+        QVERIFY(!ok);
+        QCOMPARE(errors.count(),1);
+
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY(!zipper.extractEntry(archive,"small.txt",&buffer));
+        QVERIFY(data.isEmpty());
+
+        FileUtils::removeDir(destination_path);
+        QVERIFY(!zipper.unzipFolder(archive,destination_path));
+    }
+
+    FileUtils::removeDir(source_path);
+    FileUtils::removeDir(destination_path);
+    QFile::remove(archive);
+}
+
+void Qtilities::Testing::TestZipper::testCompressedDevice() {
+    // Write data spanning many blocks, followed by an empty stream:
+    const QByteArray text = qti_private_TextData();
+    const QByteArray random = qti_private_RandomData();
+    QByteArray compressed_data;
+    {
+        QBuffer buffer(&compressed_data);
+        buffer.open(QIODevice::WriteOnly);
+        CompressedDevice compressed(&buffer);
+        compressed.setBlockSize(16 * 1024);
+        QVERIFY(compressed.open(QIODevice::WriteOnly));
+        QDataStream stream(&compressed);
+        stream << text << random << QByteArray() << QString("Last");
+        compressed.close();
+    }
+    QVERIFY(compressed_data.size() < text.size() + random.size());
+
+    {
+        QBuffer buffer(&compressed_data);
+        buffer.open(QIODevice::ReadOnly);
+        QVERIFY(CompressedDevice::isCompressed(&buffer));
+        QCOMPARE(buffer.pos(),(qint64) 0);
+        CompressedDevice compressed(&buffer);
+        QVERIFY(compressed.open(QIODevice::ReadOnly));
+        QDataStream stream(&compressed);
+        QByteArray read_text, read_random, read_empty;
+        QString read_last;
+        stream >> read_text >> read_random >> read_empty >> read_last;
+        QCOMPARE(stream.status(),QDataStream::Ok);
+        QVERIFY(read_text == text);
+        QVERIFY(read_random == random);
+        QVERIFY(read_empty.isEmpty());
+        QCOMPARE(read_last,QString("Last"));
+        QVERIFY(compressed.read(1).isEmpty());
+    }
+
+    // An empty stream only contains the signature and the terminating block:
+    QByteArray empty_data;
+    {
+        QBuffer buffer(&empty_data);
+        buffer.open(QIODevice::WriteOnly);
+        CompressedDevice compressed(&buffer);
+        QVERIFY(compressed.open(QIODevice::WriteOnly));
+        compressed.close();
+    }
+    QCOMPARE(empty_data.size(),8);
+    {
+        QBuffer buffer(&empty_data);
+        buffer.open(QIODevice::ReadOnly);
+        CompressedDevice compressed(&buffer);
+        QVERIFY(compressed.open(QIODevice::ReadOnly));
+        QVERIFY(compressed.readAll().isEmpty());
+    }
+
+    // Truncated compressed data can't be read completely:
+    QByteArray truncated_data = compressed_data.left(compressed_data.size() / 2);
+    {
+        QBuffer buffer(&truncated_data);
+        buffer.open(QIODevice::ReadOnly);
+        CompressedDevice compressed(&buffer);
+        QVERIFY(compressed.open(QIODevice::ReadOnly));
+        QDataStream stream(&compressed);
+        QByteArray read_text, read_random;
+        stream >> read_text >> read_random;
+        QVERIFY(stream.status() != QDataStream::Ok);
+        QVERIFY(!compressed.errorString().isEmpty());
+    }
+
+    // Data which was not written by a compressed device is rejected:
+    QByteArray plain_data("Not compressed");
+    {
+        QBuffer buffer(&plain_data);
+        buffer.open(QIODevice::ReadOnly);
+        QVERIFY(!CompressedDevice::isCompressed(&buffer));
+        CompressedDevice compressed(&buffer);
+        QVERIFY(!compressed.open(QIODevice::ReadOnly));
+        QVERIFY(!compressed.open(QIODevice::ReadWrite));
+    }
+}
+
+void Qtilities::Testing::TestZipper::testExecuteCommand() {
+#ifdef Q_OS_WIN
+    ZipperCommandRunner runner("cmd");
+    QStringList arguments = QStringList() << "/c" << "exit 0";
+#else
+    ZipperCommandRunner runner("/bin/sh");
+    QStringList arguments = QStringList() << "-c" << "exit 0";
+#endif
+    QElapsedTimer timer;
+    timer.start();
+    QStringList errors;
+    QVERIFY(runner.runCommand(arguments,&errors));
+    QVERIFY(errors.isEmpty());
+    // The command returns well within the time for which the task of a process which is no longer running is waited for:
+    QVERIFY(timer.elapsed() < 5000);
+
+    // The same process can run the next command:
+    QVERIFY(runner.runCommand(arguments,&errors));
+
+    ZipperCommandRunner missing_runner(qti_private_TestPath("missing_7za_executable"));
+    QVERIFY(!missing_runner.runCommand(QStringList() << "l",&errors));
+    QVERIFY(!errors.isEmpty());
+}
@@ -0,0 +1,61 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef TEST_ZIPPER_H
+#define TEST_ZIPPER_H
+
+#include "Testing_global.h"
+#include "ITestable.h"
+
+#include <QtTest/QtTest>
+
+namespace Qtilities {
+    namespace Testing {
+        using namespace Interfaces;
+
+        //! Allows testing of the in-process archive support of Qtilities::Core::Zipper and of Qtilities::Core::CompressedDevice.
+        class TESTING_SHARED_EXPORT TestZipper: public QObject, public ITestable
+        {
+            Q_OBJECT
+            Q_INTERFACES(Qtilities::Testing::Interfaces::ITestable)
+
+        public:
+            // --------------------------------
+            // IObjectBase Implementation
+            // --------------------------------
+            QObject* objectBase() { return this; }
+            const QObject* objectBase() const { return this; }
+
+            // --------------------------------
+            // ITestable Implementation
+            // --------------------------------
+            int execTest(int argc = 0, char ** argv = 0);
+            QString testName() const { return tr("Zipper"); }
+
+        private slots:
+            //! Tests zipping and unzipping folders with stored and deflated entries, empty files and files larger than 64 KiB.
+            void testRoundTrip_data();
+            void testRoundTrip();
+            //! Tests extracting single entries from an archive.
+            void testExtractEntry();
+            //! Tests reading archives of which the data is corrupt.
+            void testCorruptArchive();
+            //! Tests reading archives which were truncated.
+            void testTruncatedArchive();
+            //! Tests compressing and decompressing streams using CompressedDevice.
+            void testCompressedDevice();
+            //! Tests that commands run through the external backend process return once the process finished, or when it failed to start.
+            void testExecuteCommand();
+        };
+    }
+}
+
+#endif // TEST_ZIPPER_H
@@ -0,0 +1,44 @@
+# ***************************************************************************
+# Copyright (c) 2009-2013, Jaco Naude
+#
+# See http://jpnaude.github.io/Qtilities/page_licensing.html for licensing details.
+#
+# ***************************************************************************
+#
+# Runs the Qtilities benchmarks from the command line.
+#
+#****************************************************************************
+QTILITIES += testing
+DEFINES += QTILITIES_TESTING
+include(../../Qtilities.pri)
+
+QT += core gui xml
+
+greaterThan(QT_MAJOR_VERSION, 4) {
+QT += widgets \
+      printsupport \
+      testlib
+}
+lessThan(QT_MAJOR_VERSION, 5) {
+    CONFIG += qtestlib
+}
+
+TARGET    = QtilitiesBenchmarks
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+DESTDIR = $$QTILITIES_BIN/Tools/QtilitiesBenchmarks
+
+# ------------------------------
+# Temp Output Paths
+# ------------------------------
+OBJECTS_DIR     = $$QTILITIES_TEMP/QtilitiesBenchmarks
+MOC_DIR         = $$QTILITIES_TEMP/QtilitiesBenchmarks
+RCC_DIR         = $$QTILITIES_TEMP/QtilitiesBenchmarks
+UI_DIR          = $$QTILITIES_TEMP/QtilitiesBenchmarks
+
+# --------------------------
+# Application Files
+# --------------------------
+SOURCES += main.cpp
@@ -0,0 +1,55 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include <QApplication>
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QtilitiesTesting>
+using namespace QtilitiesTesting;
+
+// Usage: QtilitiesBenchmarks [-results <csv file>] [QTest arguments]
+// All QTest arguments are supported, for example "-xml -o results.xml" writes the QTest results in a machine readable format and
+// "benchmarkExport" only runs the export benchmarks.
+int main(int argc, char *argv[])
+{
+    QtilitiesApplication a(argc, argv);
+    QtilitiesApplication::setOrganizationName("Jaco Naude");
+    QtilitiesApplication::setOrganizationDomain("Qtilities");
+    QtilitiesApplication::setApplicationName("Qtilities Benchmarks");
+    QtilitiesApplication::setApplicationVersion(QtilitiesApplication::qtilitiesVersionString());
+
+    Log->setLoggerSettingsEnabled(false);
+    LOG_INITIALIZE();
+    // Logging must not influence the results:
+    Log->setGlobalLogLevel(Logger::Warning);
+    Log->setIsQtMessageHandler(false);
+    Log->toggleQtMsgEngine(false);
+    Log->toggleConsoleEngine(false);
+
+    BenchmarkTests benchmarkTests;
+
+    // Remove our own arguments before passing the rest to QTest:
+    QStringList arguments = a.arguments();
+    int results_index = arguments.indexOf("-results");
+    if (results_index != -1) {
+        if (results_index + 1 >= arguments.count()) {
+            QTextStream(stderr) << "Usage: QtilitiesBenchmarks [-results <csv file>] [QTest arguments]" << endl;
+            return 1;
+        }
+        benchmarkTests.setResultsFile(arguments.at(results_index + 1));
+        arguments.removeAt(results_index + 1);
+        arguments.removeAt(results_index);
+    }
+
+    return QTest::qExec(&benchmarkTests,arguments);
+}
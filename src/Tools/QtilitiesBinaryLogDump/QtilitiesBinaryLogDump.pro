@@ -0,0 +1,35 @@
+# ***************************************************************************
+# Copyright (c) 2009-2013, Jaco Naude
+#
+# See http://jpnaude.github.io/Qtilities/page_licensing.html for licensing details.
+#
+# ***************************************************************************
+#
+# Converts ring files written by the BinaryLoggerEngine to formatted logs.
+#
+#****************************************************************************
+QTILITIES += logging
+include(../../Qtilities.pri)
+
+QT       += core
+QT       -= gui
+
+TARGET    = QtilitiesBinaryLogDump
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+DESTDIR = $$QTILITIES_BIN/Tools/QtilitiesBinaryLogDump
+
+# ------------------------------
+# Temp Output Paths
+# ------------------------------
+OBJECTS_DIR     = $$QTILITIES_TEMP/QtilitiesBinaryLogDump
+MOC_DIR         = $$QTILITIES_TEMP/QtilitiesBinaryLogDump
+RCC_DIR         = $$QTILITIES_TEMP/QtilitiesBinaryLogDump
+UI_DIR          = $$QTILITIES_TEMP/QtilitiesBinaryLogDump
+
+# --------------------------
+# Application Files
+# --------------------------
+SOURCES += main.cpp
@@ -0,0 +1,70 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+
+#include <QtilitiesLogging>
+using namespace QtilitiesLogging;
+
+#include <stdio.h>
+
+// Usage: QtilitiesBinaryLogDump <ring file> [formatting engine] [output file]
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("Qtilities Binary Log Dump");
+
+    QStringList arguments = QCoreApplication::arguments();
+    QTextStream err(stderr);
+    if (arguments.count() < 2 || arguments.count() > 4) {
+        err << "Usage: QtilitiesBinaryLogDump <ring file> [formatting engine] [output file]" << endl;
+        err << "Formats the records in a ring file written by the BinaryLoggerEngine. The default formatting engine is \"" << qti_def_FORMATTING_ENGINE_DEFAULT << "\"." << endl;
+        return 1;
+    }
+
+    Log->setLoggerSettingsEnabled(false);
+    LOG_INITIALIZE();
+    Log->toggleQtMsgEngine(false);
+    Log->toggleConsoleEngine(false);
+
+    QString engine_name = arguments.count() > 2 ? arguments.at(2) : QString(qti_def_FORMATTING_ENGINE_DEFAULT);
+    AbstractFormattingEngine* formatting_engine = Log->formattingEngineReference(engine_name);
+    if (!formatting_engine) {
+        err << "Unknown formatting engine: " << engine_name << ". Available engines: " << Log->availableFormattingEnginesInFactory().join(", ") << endl;
+        return 1;
+    }
+
+    QString errorMsg;
+    QString formatted = BinaryLoggerEngine::formatRingFile(arguments.at(1),formatting_engine,&errorMsg);
+    if (!errorMsg.isEmpty()) {
+        err << errorMsg << endl;
+        if (formatted.isEmpty())
+            return 1;
+    }
+
+    if (arguments.count() > 3) {
+        QFile file(arguments.at(3));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            err << "Failed to open output file: " << file.errorString() << endl;
+            return 1;
+        }
+        QTextStream out(&file);
+        out << formatted;
+    } else {
+        QTextStream out(stdout);
+        out << formatted;
+    }
+
+    return 0;
+}
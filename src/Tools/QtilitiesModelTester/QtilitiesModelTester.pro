@@ -26,6 +26,9 @@ CONFIG   -= app_bundle
 TEMPLATE = app
 DESTDIR = $$QTILITIES_BIN/Tools/QtilitiesModelTester
 
+# The stress test uses GetProcessMemoryInfo() to measure the memory used per node:
+win32:LIBS += -lpsapi
+
 # ------------------------------
 # Temp Output Paths
 # ------------------------------
@@ -42,9 +45,11 @@ RC_FILE = rc_file.rc
 
 SOURCES         += \
     dynamictreemodel.cpp \
+    modelstresstest.cpp \
     modeltest.cpp \
 
 HEADERS         += \
     dynamictreemodel.h \
+    modelstresstest.h \
     modeltest.h \
 
@@ -40,6 +40,17 @@ using namespace QtilitiesCoreGui;
 using namespace QtilitiesTesting;
 
 #include "modeltest.h"
+#include "modelstresstest.h"
+
+// Usage: QtilitiesModelTester [-stress [-sizes <n1,n2,...>] [-churn <operations>] [-seed <seed>] [-results <csv file>]]
+// Without -stress the tree model of a small tree is checked for correctness using ModelTest. With -stress the tree is grown
+// to the given sizes, 10000,100000,1000000 by default, and the scalability of the model is measured, see ModelStressTest.
+static QString stressArgument(const QStringList& arguments, const QString& name, const QString& default_value) {
+    int index = arguments.indexOf(name);
+    if (index == -1 || index + 1 >= arguments.count())
+        return default_value;
+    return arguments.at(index + 1);
+}
 
 int main(int argc, char *argv[])
 {
@@ -57,6 +68,31 @@ int main(int argc, char *argv[])
     Log->setLoggerSessionConfigPath(QtilitiesApplication::applicationSessionPath());
     LOG_INITIALIZE();
 
+    QStringList arguments = a.arguments();
+    if (arguments.contains("-stress")) {
+        // Logging must not influence the results:
+        Log->setGlobalLogLevel(Logger::Warning);
+
+        QList<int> sizes;
+        QStringList size_strings = stressArgument(arguments,"-sizes","10000,100000,1000000").split(",",QString::SkipEmptyParts);
+        foreach (const QString& size_string, size_strings) {
+            bool ok;
+            int size = size_string.trimmed().toInt(&ok);
+            if (!ok || size <= 0 || (!sizes.isEmpty() && size <= sizes.last())) {
+                QTextStream(stderr) << "The stress test sizes must be increasing positive numbers: " << size_string << endl;
+                return 1;
+            }
+            sizes << size;
+        }
+
+        ModelStressTest stress_test(observer_widget);
+        stress_test.setChurnOperations(stressArgument(arguments,"-churn","1000").toInt());
+        stress_test.setSeed(stressArgument(arguments,"-seed","1").toUInt());
+        stress_test.setResultsFile(stressArgument(arguments,"-results",QString()));
+        observer_widget->show();
+        return stress_test.run(sizes);
+    }
+
     TreeNode* rootNodeCategorized = new TreeNode("Root");
     rootNodeCategorized->enableCategorizedDisplay();
     // TODO: This breaks the toolbar for some reason... Looks like a display issue since it only happens in QTabWidget:
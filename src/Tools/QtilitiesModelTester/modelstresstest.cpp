@@ -0,0 +1,333 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include "modelstresstest.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QTextStream>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+namespace {
+    //! The number of children every node gets while the tree grows, of which the first qti_private_STRESS_NODES_PER_NODE are nodes.
+    const int qti_private_STRESS_CHILDREN_PER_NODE = 10;
+    const int qti_private_STRESS_NODES_PER_NODE = 3;
+    //! The number of churn operations applied before waiting for the model to show them.
+    const int qti_private_STRESS_CHURN_BATCH_SIZE = 100;
+    //! The time allowed for a single rebuild of the model.
+    const int qti_private_STRESS_BUILD_TIMEOUT = 600000;
+    //! The interval at which the event loop is expected to respond while the model rebuilds.
+    const int qti_private_STRESS_RESPONSIVENESS_INTERVAL = 10;
+
+    //! Returns the current memory usage of the process in KB, or -1 when it is not known on the platform.
+    qint64 qti_private_CurrentMemoryUsage() {
+        #if defined(Q_OS_LINUX)
+        QFile file("/proc/self/status");
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            return -1;
+        QByteArray line = file.readLine();
+        while (!line.isEmpty()) {
+            if (line.startsWith("VmRSS:"))
+                return line.mid(6).trimmed().split(' ').first().toLongLong();
+            line = file.readLine();
+        }
+        return -1;
+        #elif defined(Q_OS_WIN)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(),&counters,sizeof(counters)))
+            return (qint64) counters.WorkingSetSize / 1024;
+        return -1;
+        #else
+        return -1;
+        #endif
+    }
+
+    //! Returns a random index in [0, count), also for counts larger than RAND_MAX on platforms where it is small.
+    int qti_private_RandomIndex(int count) {
+        const quint32 value = ((quint32) qrand() << 16) ^ (quint32) qrand();
+        return (int) (value % (quint32) count);
+    }
+}
+
+ModelStressTest::ModelStressTest(ObserverWidget* observer_widget, QObject* parent) : QObject(parent),
+    d_observer_widget(observer_widget),
+    d_subject_count(0),
+    d_fill_index(0),
+    d_fill_count(0),
+    d_name_counter(0),
+    d_churn_operations(1000),
+    d_seed(1),
+    d_first_signal_nsecs(-1),
+    d_build_ended_nsecs(-1),
+    d_build_ended(false),
+    d_last_tick_nsecs(0),
+    d_max_stall_nsecs(0)
+{
+    d_root = new TreeNode("Stress Root");
+    d_nodes << d_root;
+
+    d_observer_widget->setObserverContext(d_root);
+    d_observer_widget->initialize();
+
+    // Changes are coalesced into builds in a worker thread, which is how large trees should be shown:
+    ObserverTreeModel* tree_model = d_observer_widget->treeModel();
+    tree_model->enableThreadedBuilding();
+    connect(tree_model,SIGNAL(modelAboutToBeReset()),SLOT(handleModelSignal()));
+    connect(tree_model,SIGNAL(layoutAboutToBeChanged()),SLOT(handleModelSignal()));
+    connect(tree_model,SIGNAL(rowsAboutToBeInserted(QModelIndex,int,int)),SLOT(handleModelSignal()));
+    connect(tree_model,SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)),SLOT(handleModelSignal()));
+    connect(tree_model,SIGNAL(dataChanged(QModelIndex,QModelIndex)),SLOT(handleModelSignal()));
+    connect(tree_model,SIGNAL(treeModelBuildEnded()),SLOT(handleBuildEnded()));
+
+    d_responsiveness_timer.setInterval(qti_private_STRESS_RESPONSIVENESS_INTERVAL);
+    connect(&d_responsiveness_timer,SIGNAL(timeout()),SLOT(handleResponsivenessTick()));
+}
+
+ModelStressTest::~ModelStressTest() {
+    delete d_root;
+}
+
+void ModelStressTest::setResultsFile(const QString& file_name) {
+    d_results_file = file_name;
+}
+
+void ModelStressTest::setChurnOperations(int operations) {
+    d_churn_operations = qMax(0,operations);
+}
+
+void ModelStressTest::setSeed(uint seed) {
+    d_seed = seed;
+}
+
+int ModelStressTest::run(const QList<int>& sizes) {
+    qsrand(d_seed);
+    d_responsiveness_clock.start();
+    d_responsiveness_timer.start();
+
+    for (int s = 0; s < sizes.count(); ++s) {
+        Result result;
+        d_max_stall_nsecs = 0;
+
+        // Grow the tree:
+        const qint64 memory_before = qti_private_CurrentMemoryUsage();
+        const int subjects_before = d_subject_count;
+        QElapsedTimer timer;
+        timer.start();
+        d_root->startTreeProcessingCycle();
+        grow(sizes.at(s));
+        result.grow_msecs = timer.elapsed();
+        result.nodes = d_subject_count;
+
+        // The rebuild is measured from the moment the tree announces its changes until the model shows the new tree:
+        startMeasurement();
+        d_root->endTreeProcessingCycle();
+        d_observer_widget->treeModel()->recordObserverChange();
+        if (!waitForBuild(qti_private_STRESS_BUILD_TIMEOUT)) {
+            QTextStream(stderr) << "The tree model did not finish rebuilding " << d_subject_count << " nodes within " << qti_private_STRESS_BUILD_TIMEOUT << " ms." << endl;
+            return 1;
+        }
+        result.rebuild_msecs = d_build_ended_nsecs / 1000000;
+
+        const qint64 memory_after = qti_private_CurrentMemoryUsage();
+        if (memory_before >= 0 && memory_after >= 0 && d_subject_count > subjects_before)
+            result.memory_per_node_bytes = ((memory_after - memory_before) * 1024) / (d_subject_count - subjects_before);
+
+        // Apply the churn in batches:
+        int batches = 0;
+        double latency_sum = 0;
+        double rebuild_sum = 0;
+        while (result.churn_operations < d_churn_operations) {
+            const int batch_size = qMin(qti_private_STRESS_CHURN_BATCH_SIZE,d_churn_operations - result.churn_operations);
+            for (int i = 0; i < batch_size; ++i)
+                applyRandomChurn();
+            result.churn_operations += batch_size;
+
+            startMeasurement();
+            d_observer_widget->treeModel()->recordObserverChange();
+            if (!waitForBuild(qti_private_STRESS_BUILD_TIMEOUT)) {
+                QTextStream(stderr) << "The tree model did not finish rebuilding after churn within " << qti_private_STRESS_BUILD_TIMEOUT << " ms." << endl;
+                return 1;
+            }
+
+            const double latency = (d_first_signal_nsecs >= 0 ? d_first_signal_nsecs : d_build_ended_nsecs) / 1000000.0;
+            latency_sum += latency;
+            result.max_signal_latency_msecs = qMax(result.max_signal_latency_msecs,latency);
+            rebuild_sum += d_build_ended_nsecs / 1000000.0;
+            ++batches;
+        }
+        if (batches > 0) {
+            result.mean_signal_latency_msecs = latency_sum / batches;
+            result.mean_churn_rebuild_msecs = rebuild_sum / batches;
+        }
+        result.max_event_loop_stall_msecs = d_max_stall_nsecs / 1000000.0;
+        result.nodes = d_subject_count;
+
+        printResult(result);
+        recordResult(result);
+    }
+
+    d_responsiveness_timer.stop();
+    return 0;
+}
+
+void ModelStressTest::handleModelSignal() {
+    if (d_first_signal_nsecs < 0 && d_measurement_timer.isValid())
+        d_first_signal_nsecs = d_measurement_timer.nsecsElapsed();
+}
+
+void ModelStressTest::handleBuildEnded() {
+    if (d_build_ended || !d_measurement_timer.isValid())
+        return;
+    d_build_ended = true;
+    d_build_ended_nsecs = d_measurement_timer.nsecsElapsed();
+}
+
+void ModelStressTest::handleResponsivenessTick() {
+    const qint64 now = d_responsiveness_clock.nsecsElapsed();
+    const qint64 stall = now - d_last_tick_nsecs - (qint64) qti_private_STRESS_RESPONSIVENESS_INTERVAL * 1000000;
+    if (stall > d_max_stall_nsecs)
+        d_max_stall_nsecs = stall;
+    d_last_tick_nsecs = now;
+}
+
+void ModelStressTest::grow(int target_size) {
+    while (d_subject_count < target_size) {
+        // Nodes are filled in the order in which they were created, thus the tree grows breadth first:
+        TreeNode* parent = d_nodes.at(d_fill_index);
+        if (d_fill_count < qti_private_STRESS_NODES_PER_NODE) {
+            TreeNode* node = parent->addNode(QString("Node %1").arg(++d_name_counter));
+            if (node)
+                d_nodes << node;
+        } else {
+            TreeItem* item = new TreeItem(QString("Item %1").arg(++d_name_counter));
+            if (parent->addItem(item)) {
+                d_items << item;
+                d_item_parents << parent;
+            } else {
+                delete item;
+            }
+        }
+        ++d_subject_count;
+
+        if (++d_fill_count == qti_private_STRESS_CHILDREN_PER_NODE) {
+            d_fill_count = 0;
+            ++d_fill_index;
+        }
+    }
+}
+
+void ModelStressTest::applyRandomChurn() {
+    int operation = qrand() % 4;
+    if (d_items.isEmpty())
+        operation = 0;
+
+    if (operation == 0) {
+        // Insert:
+        TreeNode* parent = d_nodes.at(qti_private_RandomIndex(d_nodes.count()));
+        TreeItem* item = new TreeItem(QString("Churn %1").arg(++d_name_counter));
+        if (parent->addItem(item)) {
+            d_items << item;
+            d_item_parents << parent;
+            ++d_subject_count;
+        } else {
+            delete item;
+        }
+        return;
+    }
+
+    const int index = qti_private_RandomIndex(d_items.count());
+    TreeItem* item = d_items.at(index);
+    TreeNode* parent = d_item_parents.at(index);
+    if (operation == 1) {
+        // Remove, the item is deleted since it goes out of scope:
+        d_items[index] = d_items.last();
+        d_item_parents[index] = d_item_parents.last();
+        d_items.removeLast();
+        d_item_parents.removeLast();
+        parent->removeItem(item);
+        --d_subject_count;
+    } else if (operation == 2) {
+        // Rename:
+        item->setName(QString("Renamed %1").arg(++d_name_counter),parent);
+    } else {
+        // Move, the item is attached to its new parent first, thus it stays in scope:
+        TreeNode* new_parent = d_nodes.at(qti_private_RandomIndex(d_nodes.count()));
+        if (new_parent != parent && new_parent->addItem(item)) {
+            parent->removeItem(item);
+            d_item_parents[index] = new_parent;
+        }
+    }
+}
+
+bool ModelStressTest::waitForBuild(int timeout_msecs) {
+    QElapsedTimer wait_timer;
+    wait_timer.start();
+    // The responsiveness timer wakes the event loop up regularly, thus the timeout is checked:
+    while (!d_build_ended && wait_timer.elapsed() < timeout_msecs)
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+    return d_build_ended;
+}
+
+void ModelStressTest::startMeasurement() {
+    d_first_signal_nsecs = -1;
+    d_build_ended_nsecs = -1;
+    d_build_ended = false;
+    // The event loop was blocked by the changes made by the test itself, which must not count as a stall:
+    d_last_tick_nsecs = d_responsiveness_clock.nsecsElapsed();
+    d_measurement_timer.start();
+}
+
+void ModelStressTest::printResult(const Result& result) const {
+    QTextStream out(stdout);
+    out << "Nodes: " << result.nodes << endl;
+    out << "  Grow time: " << result.grow_msecs << " ms" << endl;
+    out << "  Rebuild time: " << result.rebuild_msecs << " ms" << endl;
+    if (result.memory_per_node_bytes >= 0)
+        out << "  Memory per node: " << result.memory_per_node_bytes << " bytes" << endl;
+    else
+        out << "  Memory per node: Unknown on this platform" << endl;
+    out << "  Churn operations: " << result.churn_operations << endl;
+    out << "  Signal latency (mean / max): " << QString::number(result.mean_signal_latency_msecs,'f',3) << " / " << QString::number(result.max_signal_latency_msecs,'f',3) << " ms" << endl;
+    out << "  Rebuild time after churn (mean): " << QString::number(result.mean_churn_rebuild_msecs,'f',3) << " ms" << endl;
+    out << "  Longest event loop stall: " << QString::number(result.max_event_loop_stall_msecs,'f',3) << " ms" << endl;
+}
+
+void ModelStressTest::recordResult(const Result& result) const {
+    if (d_results_file.isEmpty())
+        return;
+
+    QFile file(d_results_file);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        QTextStream(stderr) << "Failed to open stress test results file: " << file.errorString() << endl;
+        return;
+    }
+
+    QTextStream out(&file);
+    if (file.size() == 0)
+        out << "qtilities_version,qt_version,timestamp,nodes,grow_msecs,rebuild_msecs,memory_per_node_bytes,churn_operations,mean_signal_latency_msecs,max_signal_latency_msecs,mean_churn_rebuild_msecs,max_event_loop_stall_msecs\n";
+    out << QtilitiesCoreApplication::qtilitiesVersionString() << ","
+        << qVersion() << ","
+        << QDateTime::currentDateTime().toString(Qt::ISODate) << ","
+        << result.nodes << ","
+        << result.grow_msecs << ","
+        << result.rebuild_msecs << ","
+        << result.memory_per_node_bytes << ","
+        << result.churn_operations << ","
+        << QString::number(result.mean_signal_latency_msecs,'f',3) << ","
+        << QString::number(result.max_signal_latency_msecs,'f',3) << ","
+        << QString::number(result.mean_churn_rebuild_msecs,'f',3) << ","
+        << QString::number(result.max_event_loop_stall_msecs,'f',3) << "\n";
+}
@@ -0,0 +1,108 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#ifndef MODELSTRESSTEST_H
+#define MODELSTRESSTEST_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QTimer>
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+//! Grows an observer tree shown in an ObserverWidget geometrically and measures how the tree model scales.
+/*!
+  For every target size the tree is grown to that size, after which the rebuild time of the tree model and the memory used per node
+  are measured. Random churn is then applied to the tree in batches, where every batch inserts, removes, renames and moves items.
+  For every batch the latency until the model signals the change, the time until the rebuilt tree is shown and the longest time
+  the event loop was blocked are measured.
+
+  Results are printed and appended to a CSV file when one is set using setResultsFile(), thus the scaling curves of different
+  releases can be compared.
+  */
+class ModelStressTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ModelStressTest(ObserverWidget* observer_widget, QObject* parent = 0);
+    ~ModelStressTest();
+
+    //! Sets the CSV file to which a result line is appended for every target size.
+    void setResultsFile(const QString& file_name);
+    //! Sets the number of churn operations applied at every target size. The default is 1000.
+    void setChurnOperations(int operations);
+    //! Sets the seed used for the random churn, thus runs can be repeated. The default is 1.
+    void setSeed(uint seed);
+
+    //! Runs the stress test for the given target sizes, which must be increasing. Returns 0 on success.
+    int run(const QList<int>& sizes);
+
+private slots:
+    void handleModelSignal();
+    void handleBuildEnded();
+    void handleResponsivenessTick();
+
+private:
+    struct Result {
+        Result() : nodes(0), grow_msecs(0), rebuild_msecs(0), memory_per_node_bytes(-1), churn_operations(0),
+            mean_signal_latency_msecs(0), max_signal_latency_msecs(0), mean_churn_rebuild_msecs(0), max_event_loop_stall_msecs(0) {}
+
+        int nodes;
+        qint64 grow_msecs;
+        qint64 rebuild_msecs;
+        qint64 memory_per_node_bytes;
+        int churn_operations;
+        double mean_signal_latency_msecs;
+        double max_signal_latency_msecs;
+        double mean_churn_rebuild_msecs;
+        double max_event_loop_stall_msecs;
+    };
+
+    //! Adds subjects to the tree until it contains \p target_size subjects.
+    void grow(int target_size);
+    //! Applies a single random insert, remove, rename or move operation.
+    void applyRandomChurn();
+    //! Waits until the model finished rebuilding, returns false when the build did not end within the timeout.
+    bool waitForBuild(int timeout_msecs);
+    //! Marks the start of a measurement, after which model signals and build completion are timed.
+    void startMeasurement();
+    void printResult(const Result& result) const;
+    void recordResult(const Result& result) const;
+
+    ObserverWidget*         d_observer_widget;
+    TreeNode*               d_root;
+    QList<TreeNode*>        d_nodes;
+    QList<TreeItem*>        d_items;
+    QList<TreeNode*>        d_item_parents;
+    int                     d_subject_count;
+    int                     d_fill_index;
+    int                     d_fill_count;
+    int                     d_name_counter;
+
+    QString                 d_results_file;
+    int                     d_churn_operations;
+    uint                    d_seed;
+
+    QElapsedTimer           d_measurement_timer;
+    qint64                  d_first_signal_nsecs;
+    qint64                  d_build_ended_nsecs;
+    bool                    d_build_ended;
+
+    QTimer                  d_responsiveness_timer;
+    QElapsedTimer           d_responsiveness_clock;
+    qint64                  d_last_tick_nsecs;
+    qint64                  d_max_stall_nsecs;
+};
+
+#endif // MODELSTRESSTEST_H
@@ -0,0 +1,55 @@
+/****************************************************************************
+**
+** Copyright (c) 2009-2013, Jaco Naudé
+**
+** This file is part of Qtilities.
+**
+** For licensing information, please see
+** http://jpnaude.github.io/Qtilities/page_licensing.html
+**
+****************************************************************************/
+
+#include <QApplication>
+
+#include <QtilitiesCoreGui>
+using namespace QtilitiesCoreGui;
+
+#include <QtilitiesTesting>
+using namespace QtilitiesTesting;
+
+// Usage: QtilitiesObserverBenchmarks [-results <csv or json file>] [QTest arguments]
+// Results are written as JSON lines when the results file has a .json extension, and as CSV otherwise.
+// All QTest arguments are supported, for example "benchmarkAttach:10000 naming" only runs the attach benchmark on 10000 subjects with a naming policy filter.
+int main(int argc, char *argv[])
+{
+    QtilitiesApplication a(argc, argv);
+    QtilitiesApplication::setOrganizationName("Jaco Naude");
+    QtilitiesApplication::setOrganizationDomain("Qtilities");
+    QtilitiesApplication::setApplicationName("Qtilities Observer Benchmarks");
+    QtilitiesApplication::setApplicationVersion(QtilitiesApplication::qtilitiesVersionString());
+
+    Log->setLoggerSettingsEnabled(false);
+    LOG_INITIALIZE();
+    // Logging must not influence the results:
+    Log->setGlobalLogLevel(Logger::Warning);
+    Log->setIsQtMessageHandler(false);
+    Log->toggleQtMsgEngine(false);
+    Log->toggleConsoleEngine(false);
+
+    ObserverBenchmarks observerBenchmarks;
+
+    // Remove our own arguments before passing the rest to QTest:
+    QStringList arguments = a.arguments();
+    int results_index = arguments.indexOf("-results");
+    if (results_index != -1) {
+        if (results_index + 1 >= arguments.count()) {
+            QTextStream(stderr) << "Usage: QtilitiesObserverBenchmarks [-results <csv or json file>] [QTest arguments]" << endl;
+            return 1;
+        }
+        observerBenchmarks.setResultsFile(arguments.at(results_index + 1));
+        arguments.removeAt(results_index + 1);
+        arguments.removeAt(results_index);
+    }
+
+    return QTest::qExec(&observerBenchmarks,arguments);
+}
@@ -106,8 +106,99 @@ int main(int argc, char *argv[])
 
     TestFileSetInfo* testFileSetInfo = new TestFileSetInfo;
     testFrontend.addTest(testFileSetInfo,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestCborStream* testCborStream = new TestCborStream;
+    testFrontend.addTest(testCborStream,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestQtilitiesProcess* testQtilitiesProcess = new TestQtilitiesProcess;
+    testFrontend.addTest(testQtilitiesProcess,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestPointerList* testPointerList = new TestPointerList;
+    testFrontend.addTest(testPointerList,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestDeferredImport* testDeferredImport = new TestDeferredImport;
+    testFrontend.addTest(testDeferredImport,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestZipper* testZipper = new TestZipper;
+    testFrontend.addTest(testZipper,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestFileSystemStatCache* testFileSystemStatCache = new TestFileSystemStatCache;
+    testFrontend.addTest(testFileSystemStatCache,QtilitiesCategory("Qtilities::CoreGui","::"));
+
+    TestLargeTextFile* testLargeTextFile = new TestLargeTextFile;
+    testFrontend.addTest(testLargeTextFile,QtilitiesCategory("Qtilities::CoreGui","::"));
+
+    TestDeferredPluginMode* testDeferredPluginMode = new TestDeferredPluginMode;
+    testFrontend.addTest(testDeferredPluginMode,QtilitiesCategory("Qtilities::ExtensionSystem","::"));
+
+    TestObserverTableModel* testObserverTableModel = new TestObserverTableModel;
+    testFrontend.addTest(testObserverTableModel,QtilitiesCategory("Qtilities::CoreGui","::"));
+
+    TestSettingsStore* testSettingsStore = new TestSettingsStore;
+    testFrontend.addTest(testSettingsStore,QtilitiesCategory("Qtilities::Logging","::"));
+
+    TestIdleScheduler* testIdleScheduler = new TestIdleScheduler;
+    testFrontend.addTest(testIdleScheduler,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestProjectJournal* testProjectJournal = new TestProjectJournal;
+    testFrontend.addTest(testProjectJournal,QtilitiesCategory("Qtilities::ProjectManagement","::"));
+
+    TestQtilitiesProcessPool* testQtilitiesProcessPool = new TestQtilitiesProcessPool;
+    testFrontend.addTest(testQtilitiesProcessPool,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestStartupProfiler* testStartupProfiler = new TestStartupProfiler;
+    testFrontend.addTest(testStartupProfiler,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestObserverTreeModelProxyFilter* testObserverTreeModelProxyFilter = new TestObserverTreeModelProxyFilter;
+    testFrontend.addTest(testObserverTreeModelProxyFilter,QtilitiesCategory("Qtilities::CoreGui","::"));
+
+    TestObserverTreeDiff* testObserverTreeDiff = new TestObserverTreeDiff;
+    testFrontend.addTest(testObserverTreeDiff,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestObserverUndoStack* testObserverUndoStack = new TestObserverUndoStack;
+    testFrontend.addTest(testObserverUndoStack,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestNetworkLoggerEngine* testNetworkLoggerEngine = new TestNetworkLoggerEngine;
+    testFrontend.addTest(testNetworkLoggerEngine,QtilitiesCategory("Qtilities::Logging","::"));
+
+    TestFileLoggerEngine* testFileLoggerEngine = new TestFileLoggerEngine;
+    testFrontend.addTest(testFileLoggerEngine,QtilitiesCategory("Qtilities::Logging","::"));
+
+    TestSessionLogStore* testSessionLogStore = new TestSessionLogStore;
+    testFrontend.addTest(testSessionLogStore,QtilitiesCategory("Qtilities::Logging","::"));
+
+    TestLogTags* testLogTags = new TestLogTags;
+    testFrontend.addTest(testLogTags,QtilitiesCategory("Qtilities::Logging","::"));
+
+    TestHeadlessTree* testHeadlessTree = new TestHeadlessTree;
+    testFrontend.addTest(testHeadlessTree,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestObserverTreeModel* testObserverTreeModel = new TestObserverTreeModel;
+    testFrontend.addTest(testObserverTreeModel,QtilitiesCategory("Qtilities::CoreGui","::"));
+
+    TestPagedSubjectStore* testPagedSubjectStore = new TestPagedSubjectStore;
+    testFrontend.addTest(testPagedSubjectStore,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestTaskSummaryModel* testTaskSummaryModel = new TestTaskSummaryModel;
+    testFrontend.addTest(testTaskSummaryModel,QtilitiesCategory("Qtilities::CoreGui","::"));
+
+    TestTreeBuilder* testTreeBuilder = new TestTreeBuilder;
+    testFrontend.addTest(testTreeBuilder,QtilitiesCategory("Qtilities::CoreGui","::"));
+
+    TestObjectHandle* testObjectHandle = new TestObjectHandle;
+    testFrontend.addTest(testObjectHandle,QtilitiesCategory("Qtilities::Core","::"));
+
+    TestObserverClone* testObserverClone = new TestObserverClone;
+    testFrontend.addTest(testObserverClone,QtilitiesCategory("Qtilities::Core","::"));
     #endif
 
+    // When started by the frontend to run a single test in a child process, only that test is run:
+    if (testFrontend.isChildProcess())
+        return testFrontend.executeChildProcess();
+    // Use -parallel to run every test in its own process, with one process per core:
+    if (a.arguments().contains(QLatin1String("-parallel")))
+        testFrontend.setParallelExecution(true);
+
     // ---------------------------------------------
     // Show the testing frontend:
     // ---------------------------------------------
@@ -17,3 +17,6 @@ CONFIG     += ordered
 SUBDIRS    += \
     QtilitiesTester \
     QtilitiesModelTester \
+    QtilitiesBinaryLogDump \
+    QtilitiesBenchmarks \
+    QtilitiesObserverBenchmarks \